@@ -0,0 +1,84 @@
+#include "benchmark/benchmark_api.h"
+#include "emucore.h"
+#include "eminline.h"
+#include "attotime.h"
+
+static void BM_attotime_add(benchmark::State& state) {
+	attotime value = attotime::zero;
+	const attotime step = attotime::from_hz(3579545);
+	while (state.KeepRunning()) {
+		value += step;
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_attotime_add);
+
+static void BM_attotime_subtract(benchmark::State& state) {
+	attotime value = attotime::from_seconds(1000);
+	const attotime step = attotime::from_hz(60);
+	while (state.KeepRunning()) {
+		value -= step;
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_attotime_subtract);
+
+static void BM_attotime_compare(benchmark::State& state) {
+	attotime a = attotime::from_hz(60);
+	const attotime b = attotime::from_hz(59);
+	const attotime step(0, 1);
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(a < b);
+		a += step;
+	}
+}
+BENCHMARK(BM_attotime_compare);
+
+static void BM_attotime_multiply(benchmark::State& state) {
+	const attotime period = attotime::from_hz(3579545);
+	u32 factor = 1;
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(period * factor);
+		factor += 7;
+	}
+}
+BENCHMARK(BM_attotime_multiply);
+
+static void BM_attotime_divide(benchmark::State& state) {
+	const attotime frame = attotime::from_seconds(3) + attotime::from_hz(60);
+	u32 divisor = 1;
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(frame / divisor);
+		divisor += 3;
+	}
+}
+BENCHMARK(BM_attotime_divide);
+
+static void BM_attotime_as_double(benchmark::State& state) {
+	attotime value = attotime::from_hz(60);
+	const attotime step(0, 1);
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(value.as_double());
+		value += step;
+	}
+}
+BENCHMARK(BM_attotime_as_double);
+
+static void BM_attotime_from_hz(benchmark::State& state) {
+	u32 frequency = 1;
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(attotime::from_hz(frequency));
+		frequency += 13;
+	}
+}
+BENCHMARK(BM_attotime_from_hz);
+
+static void BM_attotime_as_ticks(benchmark::State& state) {
+	attotime value = attotime::from_seconds(12) + attotime::from_hz(60);
+	const attotime step = attotime::from_hz(3579545);
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(value.as_ticks(3579545));
+		value += step;
+	}
+}
+BENCHMARK(BM_attotime_as_ticks);
@@ -0,0 +1,78 @@
+#include "benchmark/benchmark_api.h"
+#include "delegate.h"
+#include <functional>
+
+namespace {
+
+struct delegate_bench_base
+{
+	virtual ~delegate_bench_base() { }
+	virtual int step(int value) { return value + 1; }
+};
+
+struct delegate_bench_other
+{
+	virtual ~delegate_bench_other() { }
+	int other_step(int value) { return value + m_other; }
+	int m_other = 1;
+};
+
+// second base makes pointers to its members carry a this adjustment
+struct delegate_bench_target : delegate_bench_base, delegate_bench_other
+{
+	virtual int step(int value) override { return value + m_delta; }
+	int plain_step(int value) { return value + m_delta; }
+	int m_delta = 1;
+};
+
+int delegate_bench_static(delegate_bench_target *target, int value) { return value + target->m_delta; }
+
+template <typename T>
+void run_dispatch(benchmark::State &state, T const &cb)
+{
+	int value = 0;
+	while (state.KeepRunning())
+		value = cb(value);
+	benchmark::DoNotOptimize(value);
+}
+
+} // anonymous namespace
+
+static void BM_delegate_member(benchmark::State& state) {
+	delegate_bench_target target;
+	run_dispatch(state, delegate<int (int)>(&delegate_bench_target::plain_step, &target));
+}
+BENCHMARK(BM_delegate_member);
+
+static void BM_delegate_virtual(benchmark::State& state) {
+	delegate_bench_target target;
+	run_dispatch(state, delegate<int (int)>(&delegate_bench_base::step, static_cast<delegate_bench_base *>(&target)));
+}
+BENCHMARK(BM_delegate_virtual);
+
+static void BM_delegate_second_base(benchmark::State& state) {
+	delegate_bench_target target;
+	run_dispatch(state, delegate<int (int)>(&delegate_bench_target::other_step, &target));
+}
+BENCHMARK(BM_delegate_second_base);
+
+static void BM_delegate_static(benchmark::State& state) {
+	delegate_bench_target target;
+	run_dispatch(state, delegate<int (int)>(&delegate_bench_static, &target));
+}
+BENCHMARK(BM_delegate_static);
+
+static void BM_delegate_std_function(benchmark::State& state) {
+	delegate_bench_target target;
+	run_dispatch(state, delegate<int (int)>(std::function<int (int)>([&target] (int value) { return value + target.m_delta; })));
+}
+BENCHMARK(BM_delegate_std_function);
+
+// baseline: what a caller holding a member function pointer pays
+static void BM_delegate_baseline_mfp(benchmark::State& state) {
+	delegate_bench_target target;
+	int (delegate_bench_target::*volatile mfp)(int) = &delegate_bench_target::plain_step;
+	int (delegate_bench_target::*const func)(int) = mfp;
+	run_dispatch(state, [&target, func] (int value) { return (target.*func)(value); });
+}
+BENCHMARK(BM_delegate_baseline_mfp);
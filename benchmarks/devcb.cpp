@@ -0,0 +1,79 @@
+#include "benchmark/benchmark_api.h"
+#include "emu.h"
+
+// the shape of a resolved write line callback: a delegate to a member
+// function with devcb's exclusive-or and mask folded into a lambda
+struct devcb_line_sink
+{
+	void write(int state) { m_count += state; }
+	int m_count = 0;
+};
+
+static auto make_line_chain(devcb_line_sink &sink)
+{
+	delegate<void (int)> cb(&devcb_line_sink::write, &sink);
+	return [cb, exor = 1U, mask = 1U] (address_space &space, offs_t offset, int data, unsigned mem_mask) { cb((data ^ exor) & mask); };
+}
+
+using devcb_line_signature = void (address_space &, offs_t, int, unsigned);
+
+static void BM_devcb_std_function(benchmark::State& state) {
+	devcb_line_sink sink;
+	std::function<devcb_line_signature> const func(make_line_chain(sink));
+	address_space &space(*reinterpret_cast<address_space *>(&sink)); // never dereferenced
+	int data = 0;
+	while (state.KeepRunning()) {
+		func(space, 0, data, 1U);
+		data ^= 1;
+	}
+	benchmark::DoNotOptimize(sink.m_count);
+}
+BENCHMARK(BM_devcb_std_function);
+
+static void BM_devcb_thunk(benchmark::State& state) {
+	devcb_line_sink sink;
+	emu::detail::devcb_thunk<devcb_line_signature> const func(make_line_chain(sink));
+	address_space &space(*reinterpret_cast<address_space *>(&sink)); // never dereferenced
+	int data = 0;
+	while (state.KeepRunning()) {
+		func(space, 0, data, 1U);
+		data ^= 1;
+	}
+	benchmark::DoNotOptimize(sink.m_count);
+}
+BENCHMARK(BM_devcb_thunk);
+
+// the old dispatch loop over every bound function against a first
+// callback called directly, for the usual case of a single binding
+static void BM_devcb_function_vector(benchmark::State& state) {
+	devcb_line_sink sink;
+	std::vector<std::function<devcb_line_signature> > funcs;
+	funcs.emplace_back(make_line_chain(sink));
+	address_space &space(*reinterpret_cast<address_space *>(&sink)); // never dereferenced
+	int data = 0;
+	while (state.KeepRunning()) {
+		auto it(funcs.cbegin());
+		(*it)(space, 0, data, 1U);
+		while (funcs.cend() != ++it)
+			(*it)(space, 0, data, 1U);
+		data ^= 1;
+	}
+	benchmark::DoNotOptimize(sink.m_count);
+}
+BENCHMARK(BM_devcb_function_vector);
+
+static void BM_devcb_thunk_first(benchmark::State& state) {
+	devcb_line_sink sink;
+	emu::detail::devcb_thunk<devcb_line_signature> const first(make_line_chain(sink));
+	std::vector<emu::detail::devcb_thunk<devcb_line_signature> > others;
+	address_space &space(*reinterpret_cast<address_space *>(&sink)); // never dereferenced
+	int data = 0;
+	while (state.KeepRunning()) {
+		first(space, 0, data, 1U);
+		for (auto const &f : others)
+			f(space, 0, data, 1U);
+		data ^= 1;
+	}
+	benchmark::DoNotOptimize(sink.m_count);
+}
+BENCHMARK(BM_devcb_thunk_first);
@@ -0,0 +1,112 @@
+#include "benchmark/benchmark_api.h"
+#include "emu.h"
+
+// 16x16 4bpp packed tiles, as used by most sprite hardware
+static const gfx_layout layout16x16x4 =
+{
+	16, 16,
+	256,
+	4,
+	{ STEP4(0,1) },
+	{ STEP16(0,4) },
+	{ STEP16(0,16*4) },
+	16*16*4
+};
+
+struct drawgfx_fixture
+{
+	drawgfx_fixture()
+		: source(256 * 16 * 16 / 2)
+		, gfx(nullptr, layout16x16x4, &source[0], 0, 16, 0)
+		, dest16(320, 240)
+		, dest32(320, 240)
+		, priority(320, 240)
+		, cliprect(0, 319, 0, 239)
+	{
+		// pseudo-random pixels with plenty of transparent pen 0
+		u32 seed = 0x12345678;
+		for (u8 &data : source)
+		{
+			seed = seed * 1103515245 + 12345;
+			data = ((seed >> 16) & 0x77) & ((seed >> 8) & 0xff);
+		}
+		priority.fill(0);
+	}
+
+	std::vector<u8> source;
+	gfx_element gfx;
+	bitmap_ind16 dest16;
+	bitmap_rgb32 dest32;
+	bitmap_ind8 priority;
+	rectangle cliprect;
+};
+
+static void BM_drawgfx_transpen_ind16(benchmark::State& state) {
+	drawgfx_fixture f;
+	u32 code = 0;
+	while (state.KeepRunning()) {
+		f.gfx.transpen_raw(f.dest16, f.cliprect, code, 0x100, code & 1, code & 2, (code * 37) % 320 - 8, (code * 53) % 240 - 8, 0);
+		code++;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_drawgfx_transpen_ind16);
+
+static void BM_drawgfx_transpen_rgb32(benchmark::State& state) {
+	drawgfx_fixture f;
+	u32 code = 0;
+	while (state.KeepRunning()) {
+		f.gfx.transpen_raw(f.dest32, f.cliprect, code, 0x100, code & 1, code & 2, (code * 37) % 320 - 8, (code * 53) % 240 - 8, 0);
+		code++;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_drawgfx_transpen_rgb32);
+
+static void BM_drawgfx_zoom_transpen_ind16(benchmark::State& state) {
+	drawgfx_fixture f;
+	u32 code = 0;
+	while (state.KeepRunning()) {
+		f.gfx.zoom_transpen_raw(f.dest16, f.cliprect, code, 0x100, code & 1, code & 2, (code * 37) % 320 - 16, (code * 53) % 240 - 16, 0x18000, 0x18000, 0);
+		code++;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_drawgfx_zoom_transpen_ind16);
+
+static void BM_pdrawgfx_transpen_ind16(benchmark::State& state) {
+	drawgfx_fixture f;
+	u32 code = 0;
+	while (state.KeepRunning()) {
+		f.gfx.prio_transpen_raw(f.dest16, f.cliprect, code, 0x100, code & 1, code & 2, (code * 37) % 320 - 8, (code * 53) % 240 - 8, f.priority, 0xf0, 0);
+		code++;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_pdrawgfx_transpen_ind16);
+
+static void BM_pdrawgfx_transpen_rgb32(benchmark::State& state) {
+	drawgfx_fixture f;
+	u32 code = 0;
+	while (state.KeepRunning()) {
+		f.gfx.prio_transpen_raw(f.dest32, f.cliprect, code, 0x100, code & 1, code & 2, (code * 37) % 320 - 8, (code * 53) % 240 - 8, f.priority, 0xf0, 0);
+		code++;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_pdrawgfx_transpen_rgb32);
+
+static void BM_copybitmap_trans_ind16(benchmark::State& state) {
+	drawgfx_fixture f;
+	bitmap_ind16 source(512, 256);
+	for (int y = 0; y < source.height(); y++)
+		for (int x = 0; x < source.width(); x++)
+			source.pix16(y, x) = ((x ^ y) & 7) ? (x + y) : 0;
+	int scroll = 0;
+	while (state.KeepRunning()) {
+		copybitmap_trans(f.dest16, source, 0, 0, -scroll, 0, f.cliprect, 0);
+		scroll = (scroll + 1) & 0xff;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_copybitmap_trans_ind16);
@@ -0,0 +1,48 @@
+#include "benchmark/benchmark_api.h"
+#include "hash.h"
+#include "hashing.h"
+#include <vector>
+
+// a ROM-sized buffer of noise
+static std::vector<uint8_t> make_hash_data(std::size_t length)
+{
+	std::vector<uint8_t> data(length);
+	uint32_t seed = 0x12345678;
+	for (uint8_t &byte : data)
+	{
+		seed = seed * 1103515245 + 12345;
+		byte = uint8_t(seed >> 16);
+	}
+	return data;
+}
+
+static void BM_hashing_crc32(benchmark::State& state) {
+	const std::vector<uint8_t> data = make_hash_data(state.range(0));
+	while (state.KeepRunning()) {
+		util::crc32_t crc = util::crc32_creator::simple(&data[0], data.size());
+		benchmark::DoNotOptimize(crc);
+	}
+	state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_hashing_crc32)->Arg(64)->Arg(4096)->Arg(1 << 20)->Arg(16 << 20);
+
+static void BM_hashing_sha1(benchmark::State& state) {
+	const std::vector<uint8_t> data = make_hash_data(state.range(0));
+	while (state.KeepRunning()) {
+		util::sha1_t sha1 = util::sha1_creator::simple(&data[0], data.size());
+		benchmark::DoNotOptimize(sha1);
+	}
+	state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_hashing_sha1)->Arg(64)->Arg(4096)->Arg(1 << 20)->Arg(16 << 20);
+
+static void BM_hashing_collection(benchmark::State& state) {
+	const std::vector<uint8_t> data = make_hash_data(state.range(0));
+	util::hash_collection hashes;
+	while (state.KeepRunning()) {
+		hashes.compute(&data[0], data.size(), util::hash_collection::HASH_TYPES_CRC_SHA1);
+		benchmark::DoNotOptimize(hashes);
+	}
+	state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_hashing_collection)->Arg(4096)->Arg(1 << 20)->Arg(16 << 20);
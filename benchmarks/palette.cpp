@@ -0,0 +1,62 @@
+#include "benchmark/benchmark_api.h"
+#include "osdcomm.h"
+#include "palette.h"
+#include <vector>
+
+static void BM_palette_entry_set_color(benchmark::State& state) {
+	palette_t *palette = palette_t::alloc(state.range(0), 3);
+	uint32_t index = 0;
+	uint32_t color = 0;
+	while (state.KeepRunning()) {
+		palette->entry_set_color(index, rgb_t(pal5bit(color >> 10), pal5bit(color >> 5), pal5bit(color)));
+		index = (index + 1) % state.range(0);
+		color += 0x421;
+	}
+	state.SetItemsProcessed(state.iterations());
+	palette->deref();
+}
+BENCHMARK(BM_palette_entry_set_color)->Arg(256)->Arg(0x2000);
+
+static void BM_palette_full_update(benchmark::State& state) {
+	const uint32_t entries = state.range(0);
+	palette_t *palette = palette_t::alloc(entries, 3);
+	std::vector<uint16_t> paletteram(entries);
+	for (uint32_t i = 0; i < entries; i++)
+		paletteram[i] = i * 0x1234;
+	while (state.KeepRunning()) {
+		for (uint32_t i = 0; i < entries; i++) {
+			const uint16_t data = paletteram[i]++;
+			palette->entry_set_color(i, rgb_t(pal5bit(data >> 10), pal5bit(data >> 5), pal5bit(data)));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * entries);
+	palette->deref();
+}
+BENCHMARK(BM_palette_full_update)->Arg(256)->Arg(0x2000);
+
+static void BM_palette_group_set_brightness(benchmark::State& state) {
+	palette_t *palette = palette_t::alloc(state.range(0), 3);
+	float brightness = 0.0f;
+	while (state.KeepRunning()) {
+		palette->group_set_brightness(1, brightness);
+		brightness = (brightness >= 1.0f) ? 0.0f : (brightness + 0.01f);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	palette->deref();
+}
+BENCHMARK(BM_palette_group_set_brightness)->Arg(256)->Arg(0x2000);
+
+static void BM_palette_client_dirty_list(benchmark::State& state) {
+	palette_t *palette = palette_t::alloc(state.range(0));
+	palette_client client(*palette);
+	uint32_t index = 0;
+	while (state.KeepRunning()) {
+		for (int i = 0; i < 16; i++)
+			palette->entry_set_color((index + i * 17) % state.range(0), rgb_t(index, i, index ^ i));
+		uint32_t mindirty, maxdirty;
+		benchmark::DoNotOptimize(client.dirty_list(mindirty, maxdirty));
+		index++;
+	}
+	palette->deref();
+}
+BENCHMARK(BM_palette_client_dirty_list)->Arg(256)->Arg(0x2000);
@@ -0,0 +1,56 @@
+#include "benchmark/benchmark_api.h"
+#include "emu.h"
+#include <vector>
+
+// one update's worth of input at the source rate, plus room for the filter's history and lookahead
+struct resampler_fixture
+{
+	resampler_fixture(u32 source_rate, u32 dest_rate)
+		: resampler(source_rate, dest_rate)
+		, step((u64(source_rate) << sound_resampler::FRAC_BITS) / dest_rate)
+		, count(dest_rate / 50)
+		, source(source_rate / 50 + 2 * resampler.taps())
+		, dest(count)
+	{
+		u32 seed = 0x12345678;
+		for (stream_sample_t &sample : source)
+		{
+			seed = seed * 1103515245 + 12345;
+			sample = s16(seed >> 16);
+		}
+	}
+
+	sound_resampler resampler;
+	u32 step;
+	u32 count;
+	std::vector<stream_sample_t> source;
+	std::vector<stream_sample_t> dest;
+};
+
+static void BM_resampler_linear(benchmark::State& state) {
+	resampler_fixture fixture(state.range(0), state.range(1));
+	while (state.KeepRunning()) {
+		sound_resampler::resample_linear(&fixture.source[fixture.resampler.history()], 0, fixture.step, &fixture.dest[0], fixture.count, 0x100);
+		benchmark::DoNotOptimize(fixture.dest[0]);
+	}
+	state.SetItemsProcessed(state.iterations() * fixture.count);
+}
+BENCHMARK(BM_resampler_linear)->Args({ 44100, 48000 })->Args({ 3579545 / 64, 48000 })->Args({ 3579545 / 8, 48000 });
+
+static void BM_resampler_sinc(benchmark::State& state) {
+	resampler_fixture fixture(state.range(0), state.range(1));
+	while (state.KeepRunning()) {
+		fixture.resampler.resample(&fixture.source[fixture.resampler.history()], 0, fixture.step, &fixture.dest[0], fixture.count, 0x100);
+		benchmark::DoNotOptimize(fixture.dest[0]);
+	}
+	state.SetItemsProcessed(state.iterations() * fixture.count);
+}
+BENCHMARK(BM_resampler_sinc)->Args({ 44100, 48000 })->Args({ 3579545 / 64, 48000 })->Args({ 3579545 / 8, 48000 });
+
+static void BM_resampler_build(benchmark::State& state) {
+	while (state.KeepRunning()) {
+		sound_resampler resampler(state.range(0), state.range(1));
+		benchmark::DoNotOptimize(resampler.taps());
+	}
+}
+BENCHMARK(BM_resampler_build)->Args({ 44100, 48000 })->Args({ 3579545 / 8, 48000 });
@@ -0,0 +1,1791 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    2100drc.cpp
+
+    Universal machine language-based ADSP-21xx recompiler.
+
+    Compiled code works directly on the live register state, so memory
+    handlers that look at the I registers or the PC see the same values
+    they would under the interpreter.  Register moves, the ALU and MAC,
+    the barrel shifter's shifts, DAG addressing with modulo buffers and
+    bit reversal, jumps, calls and returns are compiled natively, as is
+    the end-of-loop test of a DO loop.  Other instructions are run by
+    calling back into the interpreter's instruction switch; IDLE, RTI and
+    anything that can change the interrupt state leave compiled code so
+    that the interpreter can run them and take any interrupt.
+
+    With -drc_validate each instruction is compiled on its own and run
+    twice: once compiled, recording its memory accesses, and once by the
+    interpreter, replaying them.  Any difference in the resulting state
+    is logged.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "adsp2100.h"
+#include "2100fe.h"
+
+#include "emuopts.h"
+#include "cpu/drcumlsh.h"
+
+
+namespace {
+
+// exit codes from compiled code
+enum
+{
+	EXECUTE_OUT_OF_CYCLES = 0,
+	EXECUTE_MISSING_CODE,
+	EXECUTE_INTERPRET,
+	EXECUTE_VALIDATE,
+	EXECUTE_RESET_CACHE
+};
+
+constexpr size_t DRC_CACHE_SIZE = 8 * 1024 * 1024;
+
+// frontend window, in instructions
+constexpr u32 COMPILE_BACKWARDS = 32;
+constexpr u32 COMPILE_FORWARDS = 128;
+constexpr u32 COMPILE_MAX_SEQUENCE = 64;
+
+// address generators for memory accesses
+enum
+{
+	DAG_DATA1,
+	DAG_DATA2,
+	DAG_PROGRAM
+};
+
+// status bits; these are private to 2100ops.hxx
+constexpr uint32_t SSTAT_PC_EMPTY = 0x01;
+constexpr uint32_t SSTAT_PC_OVER = 0x02;
+constexpr uint32_t MSTAT_REVERSE = 0x02;
+constexpr uint32_t MSTAT_SATURATE = 0x08;
+
+} // anonymous namespace
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+// state tracked while compiling a block
+struct adsp21xx_device::compiler_state
+{
+	uint32_t cycles;            // cycles not yet subtracted from the count
+	uml::code_label labelnum;   // next local label number
+	bool pcsynced;              // PC and PPC have been stored for this instruction
+	bool dynamicpc;             // the next PC is in I9 rather than following on
+	bool checkdirty;            // the instruction may have changed the memory map
+};
+
+
+// everything an instruction can change, for checking compiled code against the interpreter
+struct adsp21xx_device::drc_snapshot
+{
+	uint32_t pc, ppc, loop, loop_condition, cntr;
+	uint32_t astat, sstat, mstat, mstat_prev, astat_clear, idle;
+	adsp_core core, alt;
+	uint32_t i[8], l[8], lmask[8], base[8];
+	int32_t m[8];
+	uint8_t px;
+	uint32_t loop_stack[LOOP_STACK_DEPTH], cntr_stack[CNTR_STACK_DEPTH], pc_stack[PC_STACK_DEPTH];
+	uint16_t stat_stack[STAT_STACK_DEPTH][3];
+	int32_t pc_sp, cntr_sp, stat_sp, loop_sp;
+	int icount;
+
+	void capture(const adsp21xx_device &adsp)
+	{
+		pc = adsp.m_pc;
+		ppc = adsp.m_ppc;
+		loop = adsp.m_loop;
+		loop_condition = adsp.m_loop_condition;
+		cntr = adsp.m_cntr;
+		astat = adsp.m_astat;
+		sstat = adsp.m_sstat;
+		mstat = adsp.m_mstat;
+		mstat_prev = adsp.m_mstat_prev;
+		astat_clear = adsp.m_astat_clear;
+		idle = adsp.m_idle;
+		core = adsp.m_core;
+		alt = adsp.m_alt;
+		std::copy(std::begin(adsp.m_i), std::end(adsp.m_i), std::begin(i));
+		std::copy(std::begin(adsp.m_m), std::end(adsp.m_m), std::begin(m));
+		std::copy(std::begin(adsp.m_l), std::end(adsp.m_l), std::begin(l));
+		std::copy(std::begin(adsp.m_lmask), std::end(adsp.m_lmask), std::begin(lmask));
+		std::copy(std::begin(adsp.m_base), std::end(adsp.m_base), std::begin(base));
+		px = adsp.m_px;
+		std::copy(std::begin(adsp.m_loop_stack), std::end(adsp.m_loop_stack), std::begin(loop_stack));
+		std::copy(std::begin(adsp.m_cntr_stack), std::end(adsp.m_cntr_stack), std::begin(cntr_stack));
+		std::copy(std::begin(adsp.m_pc_stack), std::end(adsp.m_pc_stack), std::begin(pc_stack));
+		memcpy(stat_stack, adsp.m_stat_stack, sizeof(stat_stack));
+		pc_sp = adsp.m_pc_sp;
+		cntr_sp = adsp.m_cntr_sp;
+		stat_sp = adsp.m_stat_sp;
+		loop_sp = adsp.m_loop_sp;
+		icount = adsp.m_icount;
+	}
+
+	void restore(adsp21xx_device &adsp) const
+	{
+		adsp.m_pc = pc;
+		adsp.m_ppc = ppc;
+		adsp.m_loop = loop;
+		adsp.m_loop_condition = loop_condition;
+		adsp.m_cntr = cntr;
+		adsp.m_astat = astat;
+		adsp.m_sstat = sstat;
+		adsp.m_mstat = mstat;
+		adsp.m_mstat_prev = mstat_prev;
+		adsp.m_astat_clear = astat_clear;
+		adsp.m_idle = idle;
+		adsp.m_core = core;
+		adsp.m_alt = alt;
+		std::copy(std::begin(i), std::end(i), std::begin(adsp.m_i));
+		std::copy(std::begin(m), std::end(m), std::begin(adsp.m_m));
+		std::copy(std::begin(l), std::end(l), std::begin(adsp.m_l));
+		std::copy(std::begin(lmask), std::end(lmask), std::begin(adsp.m_lmask));
+		std::copy(std::begin(base), std::end(base), std::begin(adsp.m_base));
+		adsp.m_px = px;
+		std::copy(std::begin(loop_stack), std::end(loop_stack), std::begin(adsp.m_loop_stack));
+		std::copy(std::begin(cntr_stack), std::end(cntr_stack), std::begin(adsp.m_cntr_stack));
+		std::copy(std::begin(pc_stack), std::end(pc_stack), std::begin(adsp.m_pc_stack));
+		memcpy(adsp.m_stat_stack, stat_stack, sizeof(stat_stack));
+		adsp.m_pc_sp = pc_sp;
+		adsp.m_cntr_sp = cntr_sp;
+		adsp.m_stat_sp = stat_sp;
+		adsp.m_loop_sp = loop_sp;
+		adsp.m_icount = icount;
+	}
+
+	// describe how this state differs from the interpreter's
+	std::string differences(const drc_snapshot &interp) const
+	{
+		std::string result;
+		auto const check = [&result] (const char *name, uint64_t compiled, uint64_t interpreted)
+		{
+			if (compiled != interpreted)
+				result += util::string_format(" %s=%X/%X", name, compiled, interpreted);
+		};
+		auto const check_core = [&check] (const char *bank, const adsp_core &compiled, const adsp_core &interpreted)
+		{
+			static const struct { const char *name; adsp_reg16 adsp_core::*reg; } regs[] =
+			{
+				{ "AX0", &adsp_core::ax0 }, { "AX1", &adsp_core::ax1 }, { "AY0", &adsp_core::ay0 }, { "AY1", &adsp_core::ay1 },
+				{ "AR", &adsp_core::ar }, { "AF", &adsp_core::af }, { "MX0", &adsp_core::mx0 }, { "MX1", &adsp_core::mx1 },
+				{ "MY0", &adsp_core::my0 }, { "MY1", &adsp_core::my1 }, { "MF", &adsp_core::mf }, { "SI", &adsp_core::si },
+				{ "SE", &adsp_core::se }, { "SB", &adsp_core::sb }
+			};
+			for (auto const &reg : regs)
+				check(util::string_format("%s%s", reg.name, bank).c_str(), (compiled.*reg.reg).u, (interpreted.*reg.reg).u);
+			check(util::string_format("MR%s", bank).c_str(), compiled.mr.mr, interpreted.mr.mr);
+			check(util::string_format("SR%s", bank).c_str(), compiled.sr.sr, interpreted.sr.sr);
+		};
+
+		check("PC", pc, interp.pc);
+		check("PPC", ppc, interp.ppc);
+		check("LOOP", loop, interp.loop);
+		check("LOOPCOND", loop_condition, interp.loop_condition);
+		check("CNTR", cntr, interp.cntr);
+		check("ASTAT", astat, interp.astat);
+		check("SSTAT", sstat, interp.sstat);
+		check("MSTAT", mstat, interp.mstat);
+		check("MSTATPREV", mstat_prev, interp.mstat_prev);
+		check("ASTATCLR", astat_clear, interp.astat_clear);
+		check("IDLE", idle, interp.idle);
+		check_core("", core, interp.core);
+		check_core("_SEC", alt, interp.alt);
+		for (int n = 0; n < 8; n++)
+		{
+			check(util::string_format("I%d", n).c_str(), i[n], interp.i[n]);
+			check(util::string_format("M%d", n).c_str(), uint32_t(m[n]), uint32_t(interp.m[n]));
+			check(util::string_format("L%d", n).c_str(), l[n], interp.l[n]);
+			check(util::string_format("LMASK%d", n).c_str(), lmask[n], interp.lmask[n]);
+			check(util::string_format("BASE%d", n).c_str(), base[n], interp.base[n]);
+		}
+		check("PX", px, interp.px);
+		for (int n = 0; n < LOOP_STACK_DEPTH; n++)
+			check(util::string_format("LOOPSTK%d", n).c_str(), loop_stack[n], interp.loop_stack[n]);
+		for (int n = 0; n < CNTR_STACK_DEPTH; n++)
+			check(util::string_format("CNTRSTK%d", n).c_str(), cntr_stack[n], interp.cntr_stack[n]);
+		for (int n = 0; n < PC_STACK_DEPTH; n++)
+			check(util::string_format("PCSTK%d", n).c_str(), pc_stack[n], interp.pc_stack[n]);
+		for (int n = 0; n < STAT_STACK_DEPTH; n++)
+			for (int w = 0; w < 3; w++)
+				check(util::string_format("STATSTK%d.%d", n, w).c_str(), stat_stack[n][w], interp.stat_stack[n][w]);
+		check("PCSP", uint32_t(pc_sp), uint32_t(interp.pc_sp));
+		check("CNTRSP", uint32_t(cntr_sp), uint32_t(interp.cntr_sp));
+		check("STATSP", uint32_t(stat_sp), uint32_t(interp.stat_sp));
+		check("LOOPSP", uint32_t(loop_sp), uint32_t(interp.loop_sp));
+		check("ICOUNT", uint32_t(icount), uint32_t(interp.icount));
+		return result;
+	}
+};
+
+
+
+/***************************************************************************
+    SETUP
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_init - set up the recompiler if it's
+    allowed
+-------------------------------------------------*/
+
+void adsp21xx_device::drc_init()
+{
+	// the debugger needs to see every instruction
+	if (!allow_drc() || (machine().debug_flags & DEBUG_FLAG_ENABLED))
+		return;
+
+	m_drc_validate = machine().options().drc_validate();
+
+	// PCs are 14 bits, but hash all 16 so that nothing outside the program space aliases
+	m_drc_cache = std::make_unique<drc_cache>(DRC_CACHE_SIZE);
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drc_cache, 0, 1, 16, 0);
+	m_drcfe = std::make_unique<adsp21xx_frontend>(*this, COMPILE_BACKWARDS, COMPILE_FORWARDS, m_drc_validate ? 1 : COMPILE_MAX_SEQUENCE);
+
+	m_drcuml->symbol_add(&m_pc, sizeof(m_pc), "pc");
+	m_drcuml->symbol_add(&m_icount, sizeof(m_icount), "icount");
+	m_drcuml->symbol_add(&m_astat, sizeof(m_astat), "astat");
+	m_drcuml->symbol_add(&m_mstat, sizeof(m_mstat), "mstat");
+	m_drcuml->symbol_add(&m_cntr, sizeof(m_cntr), "cntr");
+	m_drcuml->symbol_add(&m_loop, sizeof(m_loop), "loop");
+	m_drcuml->symbol_add(&m_core, sizeof(m_core), "core");
+	m_drcuml->symbol_add(&m_i[0], sizeof(m_i), "i");
+	m_drcuml->symbol_add(&m_m[0], sizeof(m_m), "m");
+	m_drcuml->symbol_add(&m_l[0], sizeof(m_l), "l");
+	m_drcuml->symbol_add(&m_base[0], sizeof(m_base), "base");
+	m_drcuml->symbol_add(&m_pc_stack[0], sizeof(m_pc_stack), "pc_stack");
+	m_drcuml->symbol_add(&m_pc_sp, sizeof(m_pc_sp), "pc_sp");
+
+	m_drc_entry = m_drcuml->handle_alloc("entry");
+	m_drc_nocode = m_drcuml->handle_alloc("nocode");
+	m_drc_out_of_cycles = m_drcuml->handle_alloc("out_of_cycles");
+	m_drc_reset_cache = m_drcuml->handle_alloc("reset_cache");
+	drc_flush_cache();
+
+	// map changes and bank switches can swap code out from under compiled blocks
+	auto invalidate = [this] (read_or_write mode) { m_drc_cache_dirty = true; };
+	m_program->add_change_notifier(invalidate);
+	m_program->add_bank_notifier(invalidate);
+}
+
+
+/*-------------------------------------------------
+    drc_flush_cache - empty the cache and
+    regenerate the static code
+-------------------------------------------------*/
+
+void adsp21xx_device::drc_flush_cache()
+{
+	m_drcuml->reset();
+	m_drc_cache_dirty = false;
+
+	try
+	{
+		// look up the block for the current PC
+		drcuml_block &entry(m_drcuml->begin_block(4));
+		UML_HANDLE(entry, *m_drc_entry);                                        // handle  entry
+		UML_LOAD(entry, I0, &m_pc, 0, SIZE_DWORD, SCALE_x4);                    // load    i0,pc
+		UML_HASHJMP(entry, 0, I0, *m_drc_nocode);                               // hashjmp 0,i0,nocode
+		entry.end();
+
+		// exits that leave the PC where the handler was given it
+		auto const exit_handler = [this] (uml::code_handle &handle, int code)
+		{
+			drcuml_block &block(m_drcuml->begin_block(4));
+			UML_HANDLE(block, handle);                                          // handle  handle
+			UML_GETEXP(block, I0);                                              // getexp  i0
+			UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x4);               // store   pc,i0
+			UML_EXIT(block, code);                                              // exit    code
+			block.end();
+		};
+		exit_handler(*m_drc_nocode, EXECUTE_MISSING_CODE);
+		exit_handler(*m_drc_out_of_cycles, EXECUTE_OUT_OF_CYCLES);
+		exit_handler(*m_drc_reset_cache, EXECUTE_RESET_CACHE);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unrecoverable error generating ADSP-21xx static code\n");
+	}
+}
+
+
+/*-------------------------------------------------
+    drc_check_loops - tell the frontend about the
+    ends of the loops on the loop stack, flushing
+    code compiled without them
+-------------------------------------------------*/
+
+void adsp21xx_device::drc_check_loops()
+{
+	if (m_loop_sp > 0)
+	{
+		// only the innermost loop's start is reliably on top of the PC stack
+		m_drcfe->add_loop(m_loop, m_pc_stack[(m_pc_sp > 0) ? (m_pc_sp - 1) : 0]);
+		for (int n = 0; n < m_loop_sp - 1; n++)
+			m_drcfe->add_loop(m_loop_stack[n] >> 4, BRANCH_TARGET_DYNAMIC);
+	}
+
+	if (m_drcfe->take_new_loops())
+		drc_flush_cache();
+}
+
+
+
+/***************************************************************************
+    EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    execute_run_drc - run compiled code until the
+    cycles run out
+-------------------------------------------------*/
+
+void adsp21xx_device::execute_run_drc()
+{
+	drc_snapshot before;
+
+	// loops may have been started by the interpreter or a state load
+	drc_check_loops();
+
+	do
+	{
+		if (m_drc_cache_dirty)
+			drc_flush_cache();
+
+		if (m_drc_validate)
+		{
+			m_ppc = m_pc;
+			before.capture(*this);
+			m_drc_accesses.clear();
+		}
+
+		switch (m_drcuml->execute(*m_drc_entry))
+		{
+		case EXECUTE_MISSING_CODE:
+			drc_compile_block(m_pc);
+			break;
+
+		case EXECUTE_INTERPRET:
+			m_ppc = m_pc;
+			execute_one();
+			drc_check_loops();
+			break;
+
+		case EXECUTE_VALIDATE:
+			drc_validate(before);
+			break;
+
+		case EXECUTE_RESET_CACHE:
+			drc_flush_cache();
+			break;
+		}
+	} while (m_icount > 0);
+}
+
+
+/*-------------------------------------------------
+    drc_validate - run the instruction compiled
+    code just ran through the interpreter and
+    compare the results
+-------------------------------------------------*/
+
+void adsp21xx_device::drc_validate(const drc_snapshot &before)
+{
+	drc_snapshot compiled;
+	compiled.capture(*this);
+
+	// rerun from the same state, feeding the interpreter the data compiled code saw
+	before.restore(*this);
+	m_drc_replay_index = 0;
+	m_drc_replay_failed = false;
+	m_drc_replay = true;
+	m_ppc = m_pc;
+	execute_one();
+	m_drc_replay = false;
+
+	drc_snapshot interpreted;
+	interpreted.capture(*this);
+
+	// the interpreter's result stands either way
+	std::string differences = compiled.differences(interpreted);
+	if (m_drc_replay_failed || (m_drc_replay_index != m_drc_accesses.size()))
+		differences += " (memory accesses differ)";
+	if (!differences.empty())
+	{
+		m_drc_divergences++;
+		logerror("%04X: recompiled code differs from the interpreter:%s\n", before.pc, differences);
+	}
+}
+
+
+/*-------------------------------------------------
+    drc_replay - return the result of the next
+    memory access compiled code made, checking
+    that the interpreter is making the same one
+-------------------------------------------------*/
+
+uint32_t adsp21xx_device::drc_replay(uint32_t kind, uint32_t addr, uint32_t data)
+{
+	if (m_drc_replay_index >= m_drc_accesses.size())
+	{
+		m_drc_replay_failed = true;
+		return 0;
+	}
+
+	const drc_access &access = m_drc_accesses[m_drc_replay_index++];
+	bool const write = (kind == DRC_DATA_WRITE) || (kind == DRC_PROGRAM_WRITE);
+	if ((access.kind != kind) || (access.addr != addr) || (write && (access.data != data)))
+		m_drc_replay_failed = true;
+	return access.data;
+}
+
+
+/*-------------------------------------------------
+    cfunc_record_access - make a memory access for
+    compiled code in validation mode and record it
+-------------------------------------------------*/
+
+void adsp21xx_device::cfunc_record_access(void *param)
+{
+	auto &adsp = *reinterpret_cast<adsp21xx_device *>(param);
+	uint32_t const addr = adsp.m_drc_access_addr;
+	uint32_t data = adsp.m_drc_access_data;
+
+	switch (adsp.m_drc_access_kind)
+	{
+	case DRC_DATA_READ:
+		data = adsp.m_data->read_word(addr);
+		break;
+
+	case DRC_DATA_WRITE:
+		data &= 0xffff;
+		adsp.m_data->write_word(addr, data);
+		break;
+
+	case DRC_PROGRAM_READ:
+		data = adsp.m_program->read_dword(addr);
+		break;
+
+	case DRC_PROGRAM_WRITE:
+		adsp.m_program->write_dword(addr, data);
+		break;
+	}
+
+	adsp.m_drc_access_data = data;
+	adsp.m_drc_accesses.push_back(drc_access{ adsp.m_drc_access_kind, addr, data });
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_opcode_is_native - return true if the
+    given instruction is compiled rather than
+    handed to the interpreter's switch
+-------------------------------------------------*/
+
+bool adsp21xx_device::drc_opcode_is_native(uint32_t op) const
+{
+	switch ((op >> 16) & 0xff)
+	{
+		case 0x00: case 0x03: case 0x08: case 0x09: case 0x0a: case 0x0b:
+			return true;
+
+		case 0x0d:
+		{
+			// register moves, other than to and from group 3 and the invalid group 1 and 2 registers
+			uint32_t const groups = (op >> 8) & 15;
+			if (((groups & 3) == 3) || ((groups >> 2) == 3))
+				return false;
+			return ((groups >> 2) == 0) || ((((op >> 4) & 15) >> 2) != 3);
+		}
+
+		case 0x0e: case 0x0f: case 0x10: case 0x11: case 0x12: case 0x13:
+			// shifts, but not NORM, EXP or EXPADJ
+			return ((op >> 11) & 15) < 8;
+
+		case 0x18: case 0x19: case 0x1a: case 0x1b:
+		case 0x1c: case 0x1d: case 0x1e: case 0x1f:
+			return true;
+
+		case 0x20: case 0x21: case 0x24: case 0x25:
+			// not the ADSP-218x's MAC with X squared
+			return (m_chip_type < CHIP_TYPE_ADSP2181) || ((op & 0x0018f0) != 0x000010);
+
+		case 0x22: case 0x23: case 0x26: case 0x27:
+			// not the ADSP-218x's ALU with a constant
+			return (m_chip_type < CHIP_TYPE_ADSP2181) || !(op & 0x000010);
+
+		case 0x2a: case 0x2b:
+			return (m_chip_type < CHIP_TYPE_ADSP2181) || ((op & 0x0000ff) != 0x0000aa);
+
+		case 0x28: case 0x29: case 0x2c: case 0x2d: case 0x2e: case 0x2f:
+		case 0x30: case 0x31: case 0x32: case 0x33:
+		case 0x80: case 0x81: case 0x82: case 0x83:
+			return true;
+
+		case 0x34: case 0x35: case 0x36: case 0x37:
+		case 0x38: case 0x39: case 0x3a: case 0x3b:
+		case 0x84: case 0x85: case 0x86: case 0x87:
+		case 0x88: case 0x89: case 0x8a: case 0x8b:
+			// group 1 and 2 writes, other than DMOVLAY and the invalid registers
+			return ((op & 15) >> 2) != 3;
+
+		default:
+			// immediate loads, memory accesses with and without a computation, and dual reads
+			return ((op >> 16) >= 0x40) && !(((op >> 16) >= 0x8c) && ((op >> 16) <= 0x8f)) && !(((op >> 16) >= 0x9c) && ((op >> 16) <= 0x9f));
+	}
+}
+
+
+/*-------------------------------------------------
+    drc_compile_block - compile a block starting
+    at the given PC
+-------------------------------------------------*/
+
+void adsp21xx_device::drc_compile_block(offs_t pc)
+{
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	// describing a DO can reveal a loop end that code compiled earlier doesn't test for
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+	while (m_drcfe->take_new_loops())
+	{
+		drc_flush_cache();
+		desclist = m_drcfe->describe_code(pc);
+	}
+
+	bool override = false;
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			drcuml_block &block(m_drcuml->begin_block(16384));
+			compiler_state compiler = { 0, 1, false, false, false };
+			const opcode_desc *seqlast;
+
+			for (const opcode_desc *seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				if (m_drcuml->logging())
+					block.append_comment("-------------------------");                     // comment
+
+				// determine the last instruction in this sequence
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				// if we don't have a hash for this PC, or if we are overriding all, add one
+				if (override || !m_drcuml->hash_exists(0, seqhead->pc))
+					UML_HASH(block, 0, seqhead->pc);                                            // hash    0,seqhead->pc
+
+				// if this is the first sequence, we're recompiling after the code changed
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, 0, seqhead->pc);                                            // hash    0,seqhead->pc
+				}
+
+				// otherwise, redispatch to the existing code
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                                 // label   seqhead->pc
+					UML_HASHJMP(block, 0, seqhead->pc, *m_drc_nocode);                          // hashjmp 0,seqhead->pc,nocode
+					continue;
+				}
+
+				// make sure we're running what we compiled
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					if (curdesc->userflags & adsp21xx_frontend::USERFLAG_INTERPRET)
+						continue;
+					UML_LOAD(block, I0, m_program->get_read_ptr(curdesc->pc), 0, SIZE_DWORD, SCALE_x4); // load    i0,<opcode>
+					UML_CMP(block, I0, curdesc->opptr.l[0]);                                    // cmp     i0,op
+					UML_EXHc(block, COND_NE, *m_drc_nocode, seqhead->pc);                       // exh     nocode,seqhead->pc,ne
+				}
+
+				// label this instruction, if it may be jumped to locally
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                                 // label   seqhead->pc
+
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, compiler, curdesc);
+
+				// go on to the next instruction, falling through if it follows
+				uint32_t const nextpc = (seqlast->flags & OPFLAG_RETURN_TO_START) ? pc : (seqlast->pc + 1);
+				if (!m_drc_validate && (seqlast->next() != nullptr) && (seqlast->next()->pc == nextpc))
+					generate_update_cycles(block, compiler, nextpc);
+				else
+					generate_branch(block, compiler, nullptr, nextpc);
+			}
+
+			block.end();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			drc_flush_cache();
+		}
+	}
+
+	g_profiler.stop();
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	using namespace uml;
+
+	uint32_t const op = desc->opptr.l[0];
+
+	// leave anything the interpreter must see to it; in validation mode that includes fallbacks
+	if ((desc->userflags & adsp21xx_frontend::USERFLAG_INTERPRET) || (m_drc_validate && !drc_opcode_is_native(op)))
+	{
+		generate_update_cycles(block, compiler, desc->pc);
+		UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x4);                            // store   pc,desc->pc
+		UML_EXIT(block, EXECUTE_INTERPRET);                                                     // exit    EXECUTE_INTERPRET
+		return;
+	}
+
+	compiler.cycles += desc->cycles;
+	compiler.pcsynced = false;
+	compiler.dynamicpc = false;
+	compiler.checkdirty = false;
+
+	// the end of a loop is tested before the instruction runs
+	if (desc->userflags & adsp21xx_frontend::USERFLAG_LOOP_END)
+		generate_loop_end(block, compiler, desc);
+
+	if (!generate_opcode(block, compiler, desc))
+	{
+		generate_sync_pc(block, compiler, desc);
+		UML_STORE(block, &m_drc_op, 0, op, SIZE_DWORD, SCALE_x4);                              // store   drc_op,op
+		UML_CALLC(block, &cfunc_fallback, this);                                               // callc   cfunc_fallback,this
+		compiler.checkdirty = true;
+	}
+
+	uml::parameter const nextpc = compiler.dynamicpc ? uml::parameter(uml::I9) : uml::parameter(desc->pc + 1);
+	if (compiler.checkdirty && !m_drc_validate)
+		generate_check_dirty(block, compiler, nextpc);
+
+	// after the end of a loop, go back to the start unless it's done
+	if (compiler.dynamicpc)
+	{
+		uml::code_label const fallthrough = compiler.labelnum++;
+		UML_CMP(block, I9, desc->pc + 1);                                                       // cmp     i9,desc->pc+1
+		UML_JMPc(block, COND_E, fallthrough);                                                   // je      fallthrough
+		compiler_state taken = compiler;
+		generate_branch(block, taken, desc, I9);
+		compiler.labelnum = taken.labelnum;
+		UML_LABEL(block, fallthrough);                                                          // fallthrough:
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_update_cycles - subtract the cycles
+    used since the last update, leaving compiled
+    code for the given PC if they've run out
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc)
+{
+	if (compiler.cycles > 0)
+	{
+		UML_LOAD(block, I0, &m_icount, 0, SIZE_DWORD, SCALE_x4);                               // load    i0,icount
+		UML_SUB(block, I0, I0, compiler.cycles);                                                // sub     i0,i0,cycles
+		UML_STORE(block, &m_icount, 0, I0, SIZE_DWORD, SCALE_x4);                              // store   icount,i0
+
+		// in validation mode, each instruction exits anyway
+		if (!m_drc_validate)
+		{
+			UML_CMP(block, I0, 0);                                                              // cmp     i0,0
+			UML_EXHc(block, COND_LE, *m_drc_out_of_cycles, pc);                                 // exh     out_of_cycles,pc,le
+		}
+	}
+	compiler.cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_branch - go to the given PC, jumping
+    within the block where possible
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, const uml::parameter &target)
+{
+	generate_update_cycles(block, compiler, target);
+
+	if (m_drc_validate)
+	{
+		UML_STORE(block, &m_pc, 0, target, SIZE_DWORD, SCALE_x4);                              // store   pc,target
+		UML_EXIT(block, EXECUTE_VALIDATE);                                                      // exit    EXECUTE_VALIDATE
+		return;
+	}
+
+	if (desc && (desc->flags & OPFLAG_INTRABLOCK_BRANCH) && (desc->targetpc != BRANCH_TARGET_DYNAMIC))
+	{
+		if (target.is_immediate())
+		{
+			if (target.immediate() == desc->targetpc)
+			{
+				UML_JMP(block, desc->targetpc | 0x80000000);                                    // jmp     targetpc
+				return;
+			}
+		}
+		else
+		{
+			UML_CMP(block, target, desc->targetpc);                                             // cmp     target,targetpc
+			UML_JMPc(block, COND_E, desc->targetpc | 0x80000000);                               // je      targetpc
+		}
+	}
+	UML_HASHJMP(block, 0, target, *m_drc_nocode);                                               // hashjmp 0,target,nocode
+}
+
+
+/*-------------------------------------------------
+    generate_check_dirty - leave compiled code if
+    the memory map changed under it
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_check_dirty(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc)
+{
+	uml::code_label const clean = compiler.labelnum++;
+	UML_LOAD(block, I0, &m_drc_cache_dirty, 0, SIZE_BYTE, SCALE_x1);                           // load    i0,cache_dirty,byte
+	UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+	UML_JMPc(block, COND_E, clean);                                                             // je      clean
+	compiler_state dirty = compiler;
+	generate_update_cycles(block, dirty, pc);
+	UML_EXH(block, *m_drc_reset_cache, pc);                                                     // exh     reset_cache,pc
+	UML_LABEL(block, clean);                                                                    // clean:
+}
+
+
+/*-------------------------------------------------
+    generate_sync_pc - store the PC and previous
+    PC for anything outside compiled code that
+    may look at them
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_sync_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	if (compiler.pcsynced)
+		return;
+
+	// the end of a loop has already stored a dynamic PC
+	if (!compiler.dynamicpc)
+		UML_STORE(block, &m_pc, 0, desc->pc + 1, SIZE_DWORD, SCALE_x4);                        // store   pc,desc->pc+1
+	UML_STORE(block, &m_ppc, 0, desc->pc, SIZE_DWORD, SCALE_x4);                               // store   ppc,desc->pc
+	compiler.pcsynced = true;
+}
+
+
+/*-------------------------------------------------
+    generate_condition - skip to the given label
+    unless the condition is true
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_condition(drcuml_block &block, compiler_state &compiler, uint32_t condition, uml::code_label skip)
+{
+	// condition 15 is always true
+	if (condition == 15)
+		return;
+
+	// CE decrements the counter, popping the counter stack when it expires
+	if (condition == 14)
+	{
+		uml::code_label const counting = compiler.labelnum++;
+		UML_LOAD(block, I0, &m_cntr, 0, SIZE_DWORD, SCALE_x4);                                 // load    i0,cntr
+		UML_SUB(block, I0, I0, 1);                                                              // sub     i0,i0,1
+		UML_STORE(block, &m_cntr, 0, I0, SIZE_DWORD, SCALE_x4);                                // store   cntr,i0
+		UML_CMP(block, I0, 0);                                                                  // cmp     i0,0
+		UML_JMPc(block, COND_G, counting);                                                      // jg      counting
+		UML_CALLC(block, &cfunc_cntr_stack_pop, this);                                          // callc   cfunc_cntr_stack_pop,this
+		UML_JMP(block, skip);                                                                   // jmp     skip
+		UML_LABEL(block, counting);                                                             // counting:
+		return;
+	}
+
+	UML_LOAD(block, I0, &m_astat, 0, SIZE_DWORD, SCALE_x4);                                    // load    i0,astat
+	UML_LOAD(block, I0, &m_condition_table[condition << 8], I0, SIZE_BYTE, SCALE_x1);          // load    i0,condition_table[condition],i0,byte
+	UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+	UML_JMPc(block, COND_E, skip);                                                              // je      skip
+}
+
+
+/*-------------------------------------------------
+    generate_loop_end - test for the end of a DO
+    loop, leaving the next PC in I9
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_loop_end(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const table = compiler.labelnum++;
+	uml::code_label const again = compiler.labelnum++;
+	uml::code_label const done = compiler.labelnum++;
+	uml::code_label const skip = compiler.labelnum++;
+
+	// outer loops can share this PC without being the one on top of the stack
+	UML_MOV(block, I9, desc->pc + 1);                                                           // mov     i9,desc->pc+1
+	UML_LOAD(block, I0, &m_loop, 0, SIZE_DWORD, SCALE_x4);                                     // load    i0,loop
+	UML_CMP(block, I0, desc->pc);                                                               // cmp     i0,desc->pc
+	UML_JMPc(block, COND_NE, skip);                                                             // jne     skip
+
+	// the loop condition isn't known until run time
+	UML_LOAD(block, I0, &m_loop_condition, 0, SIZE_DWORD, SCALE_x4);                           // load    i0,loop_condition
+	UML_CMP(block, I0, 14);                                                                     // cmp     i0,14
+	UML_JMPc(block, COND_NE, table);                                                            // jne     table
+	UML_LOAD(block, I0, &m_cntr, 0, SIZE_DWORD, SCALE_x4);                                     // load    i0,cntr
+	UML_SUB(block, I0, I0, 1);                                                                  // sub     i0,i0,1
+	UML_STORE(block, &m_cntr, 0, I0, SIZE_DWORD, SCALE_x4);                                    // store   cntr,i0
+	UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+	UML_JMPc(block, COND_G, again);                                                             // jg      again
+	UML_CALLC(block, &cfunc_cntr_stack_pop, this);                                              // callc   cfunc_cntr_stack_pop,this
+	UML_JMP(block, done);                                                                       // jmp     done
+
+	UML_LABEL(block, table);                                                                    // table:
+	UML_SHL(block, I0, I0, 8);                                                                  // shl     i0,i0,8
+	UML_LOAD(block, I1, &m_astat, 0, SIZE_DWORD, SCALE_x4);                                    // load    i1,astat
+	UML_OR(block, I0, I0, I1);                                                                  // or      i0,i0,i1
+	UML_LOAD(block, I0, &m_condition_table[0], I0, SIZE_BYTE, SCALE_x1);                       // load    i0,condition_table,i0,byte
+	UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+	UML_JMPc(block, COND_E, done);                                                              // je      done
+
+	// keep looping from the start on top of the PC stack
+	UML_LABEL(block, again);                                                                    // again:
+	UML_LOAD(block, I0, &m_pc_sp, 0, SIZE_DWORD, SCALE_x4);                                    // load    i0,pc_sp
+	UML_SUB(block, I0, I0, 1);                                                                  // sub     i0,i0,1
+	UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+	UML_MOVc(block, COND_L, I0, 0);                                                             // mov     i0,0,l
+	UML_LOAD(block, I9, &m_pc_stack[0], I0, SIZE_DWORD, SCALE_x4);                             // load    i9,pc_stack,i0
+	UML_JMP(block, skip);                                                                       // jmp     skip
+
+	// or drop out, popping the loop and PC stacks
+	UML_LABEL(block, done);                                                                     // done:
+	UML_CALLC(block, &cfunc_loop_exit, this);                                                   // callc   cfunc_loop_exit,this
+
+	UML_LABEL(block, skip);                                                                     // skip:
+	UML_STORE(block, &m_pc, 0, I9, SIZE_DWORD, SCALE_x4);                                      // store   pc,i9
+	compiler.dynamicpc = true;
+}
+
+
+/*-------------------------------------------------
+    generate_pc_push - push a value on the PC
+    stack
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_pc_push(drcuml_block &block, compiler_state &compiler, uint32_t value)
+{
+	uml::code_label const overflow = compiler.labelnum++;
+	uml::code_label const done = compiler.labelnum++;
+
+	UML_LOAD(block, I0, &m_pc_sp, 0, SIZE_DWORD, SCALE_x4);                                    // load    i0,pc_sp
+	UML_CMP(block, I0, PC_STACK_DEPTH);                                                         // cmp     i0,PC_STACK_DEPTH
+	UML_JMPc(block, COND_GE, overflow);                                                         // jge     overflow
+	UML_STORE(block, &m_pc_stack[0], I0, value, SIZE_DWORD, SCALE_x4);                         // store   pc_stack,i0,value
+	UML_ADD(block, I0, I0, 1);                                                                  // add     i0,i0,1
+	UML_STORE(block, &m_pc_sp, 0, I0, SIZE_DWORD, SCALE_x4);                                   // store   pc_sp,i0
+	UML_LOAD(block, I5, &m_sstat, 0, SIZE_DWORD, SCALE_x4);                                    // load    i5,sstat
+	UML_AND(block, I5, I5, ~SSTAT_PC_EMPTY);                                                    // and     i5,i5,~PC_EMPTY
+	UML_STORE(block, &m_sstat, 0, I5, SIZE_DWORD, SCALE_x4);                                   // store   sstat,i5
+	UML_JMP(block, done);                                                                       // jmp     done
+
+	UML_LABEL(block, overflow);                                                                 // overflow:
+	UML_LOAD(block, I5, &m_sstat, 0, SIZE_DWORD, SCALE_x4);                                    // load    i5,sstat
+	UML_OR(block, I5, I5, SSTAT_PC_OVER);                                                       // or      i5,i5,PC_OVER
+	UML_STORE(block, &m_sstat, 0, I5, SIZE_DWORD, SCALE_x4);                                   // store   sstat,i5
+	UML_LABEL(block, done);                                                                     // done:
+}
+
+
+/*-------------------------------------------------
+    generate_read_reg - load a register from
+    group 0, 1 or 2
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_read_reg(drcuml_block &block, uint32_t group, uint32_t regnum, const uml::parameter &dst)
+{
+	if (group == 0)
+		UML_LOADS(block, dst, m_read0_ptr[regnum], 0, SIZE_WORD, SCALE_x2);                    // loads   dst,reg,word
+	else
+		UML_LOAD(block, dst, (group == 1) ? m_read1_ptr[regnum] : m_read2_ptr[regnum], 0, SIZE_DWORD, SCALE_x4); // load    dst,reg
+}
+
+
+/*-------------------------------------------------
+    generate_write_reg - store a value to a
+    register in group 0, 1 or 2, as write_reg0,
+    write_reg1 and write_reg2 do
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_write_reg(drcuml_block &block, uint32_t group, uint32_t regnum, uml::parameter src)
+{
+	if (group == 0)
+	{
+		switch (regnum)
+		{
+			case 0x09:
+				// SE is 8 bits, sign extended
+				UML_SEXT(block, I5, src, SIZE_BYTE);                                            // sext    i5,src,byte
+				UML_STORE(block, &m_core.se.s, 0, I5, SIZE_WORD, SCALE_x2);                    // store   se,i5,word
+				break;
+
+			case 0x0c:
+				// MR1 sign extends into MR2
+				UML_STORE(block, &m_core.mr.mrx.mr1.s, 0, src, SIZE_WORD, SCALE_x2);           // store   mr1,src,word
+				UML_SEXT(block, I5, src, SIZE_WORD);                                            // sext    i5,src,word
+				UML_SAR(block, I5, I5, 15);                                                     // sar     i5,i5,15
+				UML_STORE(block, &m_core.mr.mrx.mr2.s, 0, I5, SIZE_WORD, SCALE_x2);            // store   mr2,i5,word
+				break;
+
+			case 0x0d:
+				// MR2 is 8 bits, sign extended
+				UML_SEXT(block, I5, src, SIZE_BYTE);                                            // sext    i5,src,byte
+				UML_STORE(block, &m_core.mr.mrx.mr2.s, 0, I5, SIZE_WORD, SCALE_x2);            // store   mr2,i5,word
+				break;
+
+			default:
+				UML_STORE(block, m_read0_ptr[regnum], 0, src, SIZE_WORD, SCALE_x2);            // store   reg,src,word
+				break;
+		}
+		return;
+	}
+
+	int const index = (regnum & 3) + ((group == 2) ? 4 : 0);
+	switch (regnum >> 2)
+	{
+		case 0:
+			UML_AND(block, I5, src, 0x3fff);                                                    // and     i5,src,0x3fff
+			UML_STORE(block, &m_i[index], 0, I5, SIZE_DWORD, SCALE_x4);                        // store   i[index],i5
+			UML_LOAD(block, I6, &m_lmask[index], 0, SIZE_DWORD, SCALE_x4);                     // load    i6,lmask[index]
+			UML_AND(block, I6, I5, I6);                                                         // and     i6,i5,i6
+			UML_STORE(block, &m_base[index], 0, I6, SIZE_DWORD, SCALE_x4);                     // store   base[index],i6
+			break;
+
+		case 1:
+			UML_SHL(block, I5, src, 18);                                                        // shl     i5,src,18
+			UML_SAR(block, I5, I5, 18);                                                         // sar     i5,i5,18
+			UML_STORE(block, &m_m[index], 0, I5, SIZE_DWORD, SCALE_x4);                        // store   m[index],i5
+			break;
+
+		case 2:
+			UML_AND(block, I5, src, 0x3fff);                                                    // and     i5,src,0x3fff
+			UML_STORE(block, &m_l[index], 0, I5, SIZE_DWORD, SCALE_x4);                        // store   l[index],i5
+			UML_LOAD(block, I6, &m_mask_table[0], I5, SIZE_WORD, SCALE_x2);                    // load    i6,mask_table,i5,word
+			UML_STORE(block, &m_lmask[index], 0, I6, SIZE_DWORD, SCALE_x4);                    // store   lmask[index],i6
+			UML_LOAD(block, I5, &m_i[index], 0, SIZE_DWORD, SCALE_x4);                         // load    i5,i[index]
+			UML_AND(block, I6, I5, I6);                                                         // and     i6,i5,i6
+			UML_STORE(block, &m_base[index], 0, I6, SIZE_DWORD, SCALE_x4);                     // store   base[index],i6
+			break;
+
+		default:
+			// DMOVLAY and invalid registers are left to the interpreter
+			throw emu_fatalerror("ADSP-21xx recompiler: unexpected write to register group %d register %X\n", group, regnum);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_modify - post-modify an I register
+    held in I4 with an M register, wrapping at
+    the end of its circular buffer
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_modify(drcuml_block &block, compiler_state &compiler, uint32_t ireg, uint32_t mreg)
+{
+	uml::code_label const below = compiler.labelnum++;
+	uml::code_label const done = compiler.labelnum++;
+
+	UML_LOAD(block, I5, &m_m[mreg], 0, SIZE_DWORD, SCALE_x4);                                  // load    i5,m[mreg]
+	UML_ADD(block, I4, I4, I5);                                                                 // add     i4,i4,i5
+	UML_AND(block, I4, I4, 0x3fff);                                                             // and     i4,i4,0x3fff
+	UML_LOAD(block, I5, &m_base[ireg], 0, SIZE_DWORD, SCALE_x4);                               // load    i5,base[ireg]
+	UML_LOAD(block, I6, &m_l[ireg], 0, SIZE_DWORD, SCALE_x4);                                  // load    i6,l[ireg]
+	UML_CMP(block, I4, I5);                                                                     // cmp     i4,i5
+	UML_JMPc(block, COND_B, below);                                                             // jb      below
+	UML_ADD(block, I5, I5, I6);                                                                 // add     i5,i5,i6
+	UML_CMP(block, I4, I5);                                                                     // cmp     i4,i5
+	UML_JMPc(block, COND_B, done);                                                              // jb      done
+	UML_SUB(block, I4, I4, I6);                                                                 // sub     i4,i4,i6
+	UML_JMP(block, done);                                                                       // jmp     done
+	UML_LABEL(block, below);                                                                    // below:
+	UML_ADD(block, I4, I4, I6);                                                                 // add     i4,i4,i6
+	UML_LABEL(block, done);                                                                     // done:
+	UML_STORE(block, &m_i[ireg], 0, I4, SIZE_DWORD, SCALE_x4);                                 // store   i[ireg],i4
+}
+
+
+/*-------------------------------------------------
+    generate_memory_read - read from the address
+    in I1 into I0
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_memory_read(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t kind)
+{
+	generate_sync_pc(block, compiler, desc);
+
+	if (m_drc_validate)
+	{
+		UML_STORE(block, &m_drc_access_kind, 0, kind, SIZE_DWORD, SCALE_x4);                   // store   access_kind,kind
+		UML_STORE(block, &m_drc_access_addr, 0, I1, SIZE_DWORD, SCALE_x4);                     // store   access_addr,i1
+		UML_CALLC(block, &cfunc_record_access, this);                                           // callc   cfunc_record_access,this
+		UML_LOAD(block, I0, &m_drc_access_data, 0, SIZE_DWORD, SCALE_x4);                      // load    i0,access_data
+	}
+	else if (kind == DRC_PROGRAM_READ)
+		UML_READ(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);                                     // read    i0,i1,dword,program
+	else
+		UML_READ(block, I0, I1, SIZE_WORD, SPACE_DATA);                                         // read    i0,i1,word,data
+}
+
+
+/*-------------------------------------------------
+    generate_memory_write - write I2 to the
+    address in I1
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_memory_write(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t kind)
+{
+	generate_sync_pc(block, compiler, desc);
+
+	if (kind == DRC_PROGRAM_WRITE)
+		UML_AND(block, I2, I2, 0xffffff);                                                       // and     i2,i2,0xffffff
+	else
+		UML_AND(block, I2, I2, 0xffff);                                                         // and     i2,i2,0xffff
+
+	if (m_drc_validate)
+	{
+		UML_STORE(block, &m_drc_access_kind, 0, kind, SIZE_DWORD, SCALE_x4);                   // store   access_kind,kind
+		UML_STORE(block, &m_drc_access_addr, 0, I1, SIZE_DWORD, SCALE_x4);                     // store   access_addr,i1
+		UML_STORE(block, &m_drc_access_data, 0, I2, SIZE_DWORD, SCALE_x4);                     // store   access_data,i2
+		UML_CALLC(block, &cfunc_record_access, this);                                           // callc   cfunc_record_access,this
+	}
+	else if (kind == DRC_PROGRAM_WRITE)
+		UML_WRITE(block, I1, I2, SIZE_DWORD, SPACE_PROGRAM);                                    // write   i1,i2,dword,program
+	else
+		UML_WRITE(block, I1, I2, SIZE_WORD, SPACE_DATA);                                        // write   i1,i2,word,data
+
+	// a write may have switched banks
+	compiler.checkdirty = true;
+}
+
+
+/*-------------------------------------------------
+    generate_dag_address - put the address for a
+    DAG access in I1, keeping the unmodified I
+    register in I4
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_dag_address(drcuml_block &block, compiler_state &compiler, uint32_t dag, uint32_t ireg)
+{
+	UML_LOAD(block, I4, &m_i[ireg], 0, SIZE_DWORD, SCALE_x4);                                  // load    i4,i[ireg]
+	UML_MOV(block, I1, I4);                                                                     // mov     i1,i4
+
+	// DAG1 can bit-reverse its addresses
+	if (dag == DAG_DATA1)
+	{
+		uml::code_label const forward = compiler.labelnum++;
+		UML_LOAD(block, I5, &m_mstat, 0, SIZE_DWORD, SCALE_x4);                                // load    i5,mstat
+		UML_TEST(block, I5, MSTAT_REVERSE);                                                     // test    i5,MSTAT_REVERSE
+		UML_JMPc(block, COND_Z, forward);                                                       // jz      forward
+		UML_AND(block, I1, I4, 0x3fff);                                                         // and     i1,i4,0x3fff
+		UML_LOAD(block, I1, &m_reverse_table[0], I1, SIZE_WORD, SCALE_x2);                     // load    i1,reverse_table,i1,word
+		UML_LABEL(block, forward);                                                              // forward:
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_dag_read - read through a DAG into
+    I0, as data_read_dag1, data_read_dag2 and
+    pgm_read_dag2 do
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_dag_read(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t dag, uint32_t op)
+{
+	uint32_t const bank = (dag == DAG_DATA1) ? 0 : 4;
+	uint32_t const ireg = bank + ((op >> 2) & 3);
+	uint32_t const mreg = bank + (op & 3);
+
+	generate_dag_address(block, compiler, dag, ireg);
+	if (dag == DAG_PROGRAM)
+	{
+		// the low 8 bits of a program word go to PX
+		generate_memory_read(block, compiler, desc, DRC_PROGRAM_READ);
+		UML_STORE(block, &m_px, 0, I0, SIZE_BYTE, SCALE_x1);                                   // store   px,i0,byte
+		UML_SHR(block, I0, I0, 8);                                                              // shr     i0,i0,8
+	}
+	else
+		generate_memory_read(block, compiler, desc, DRC_DATA_READ);
+	generate_modify(block, compiler, ireg, mreg);
+}
+
+
+/*-------------------------------------------------
+    generate_dag_write - write I2 through a DAG,
+    as data_write_dag1, data_write_dag2 and
+    pgm_write_dag2 do
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_dag_write(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t dag, uint32_t op)
+{
+	uint32_t const bank = (dag == DAG_DATA1) ? 0 : 4;
+	uint32_t const ireg = bank + ((op >> 2) & 3);
+	uint32_t const mreg = bank + (op & 3);
+
+	generate_dag_address(block, compiler, dag, ireg);
+	if (dag == DAG_PROGRAM)
+	{
+		// PX supplies the low 8 bits of a program word
+		UML_SHL(block, I2, I2, 8);                                                              // shl     i2,i2,8
+		UML_LOAD(block, I5, &m_px, 0, SIZE_BYTE, SCALE_x1);                                    // load    i5,px,byte
+		UML_OR(block, I2, I2, I5);                                                              // or      i2,i2,i5
+		generate_memory_write(block, compiler, desc, DRC_PROGRAM_WRITE);
+	}
+	else
+		generate_memory_write(block, compiler, desc, DRC_DATA_WRITE);
+	generate_modify(block, compiler, ireg, mreg);
+}
+
+
+/*-------------------------------------------------
+    generate_compute - generate an ALU or MAC
+    operation of the given type
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_compute(drcuml_block &block, compiler_state &compiler, uint32_t type, uint32_t op)
+{
+	switch (type)
+	{
+		case 0: generate_mac(block, compiler, op, false);               break;
+		case 1: generate_alu(block, compiler, op, &m_core.ar, true);    break;
+		case 2: generate_mac(block, compiler, op, true);                break;
+		case 3: generate_alu(block, compiler, op, &m_core.af, false);   break;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_alu - generate an ALU operation, as
+    alu_op_ar and alu_op_af do
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_alu(drcuml_block &block, compiler_state &compiler, uint32_t op, void *dst, bool saturate)
+{
+	using namespace uml;
+
+	uint32_t const subop = (op >> 13) & 15;
+
+	// flag helpers working on the result in I0 and ASTAT in I3
+	auto const clear_flags = [&block, this] ()
+	{
+		UML_LOAD(block, I4, &m_astat_clear, 0, SIZE_DWORD, SCALE_x4);                          // load    i4,astat_clear
+		UML_AND(block, I3, I3, I4);                                                             // and     i3,i3,i4
+	};
+	auto const calc_nz = [&block] ()
+	{
+		UML_ROLAND(block, I4, I0, 18, NFLAG);                                                   // roland  i4,i0,18,NFLAG
+		UML_OR(block, I3, I3, I4);                                                              // or      i3,i3,i4
+		UML_TEST(block, I0, 0xffff);                                                            // test    i0,0xffff
+		UML_SETc(block, COND_Z, I4);                                                            // setz    i4
+		UML_OR(block, I3, I3, I4);                                                              // or      i3,i3,i4
+	};
+	auto const calc_vc = [&block] (uml::parameter const &s, uml::parameter const &d, bool sub)
+	{
+		UML_XOR(block, I4, s, d);                                                               // xor     i4,s,d
+		UML_XOR(block, I4, I4, I0);                                                             // xor     i4,i4,i0
+		UML_SHR(block, I5, I0, 1);                                                              // shr     i5,i0,1
+		UML_XOR(block, I4, I4, I5);                                                             // xor     i4,i4,i5
+		UML_ROLAND(block, I4, I4, 19, VFLAG);                                                   // roland  i4,i4,19,VFLAG
+		UML_OR(block, I3, I3, I4);                                                              // or      i3,i3,i4
+		UML_ROLAND(block, I4, I0, 19, CFLAG);                                                   // roland  i4,i0,19,CFLAG
+		if (sub)
+			UML_XOR(block, I4, I4, CFLAG);                                                      // xor     i4,i4,CFLAG
+		UML_OR(block, I3, I3, I4);                                                              // or      i3,i3,i4
+	};
+	auto const flag_if_equal = [&block] (uml::parameter const &reg, uint32_t value, uint32_t flag)
+	{
+		UML_MOV(block, I4, 0);                                                                  // mov     i4,0
+		UML_CMP(block, reg, value);                                                             // cmp     reg,value
+		UML_MOVc(block, COND_E, I4, flag);                                                      // mov     i4,flag,e
+		UML_OR(block, I3, I3, I4);                                                              // or      i3,i3,i4
+	};
+
+	UML_LOAD(block, I3, &m_astat, 0, SIZE_DWORD, SCALE_x4);                                    // load    i3,astat
+	if ((subop != 0x00) && (subop != 0x01) && (subop != 0x04) && (subop != 0x05) && (subop != 0x08))
+		UML_LOAD(block, I1, m_alu_xregs[(op >> 8) & 7], 0, SIZE_WORD, SCALE_x2);               // load    i1,xop,word
+	if ((subop != 0x0b) && (subop != 0x0f))
+		UML_LOAD(block, I2, m_alu_yregs[(op >> 11) & 3], 0, SIZE_WORD, SCALE_x2);              // load    i2,yop,word
+	if ((subop == 0x02) || (subop == 0x06) || (subop == 0x0a))
+		UML_ROLAND(block, I7, I3, 29, 1);                                                       // roland  i7,i3,29,1
+
+	switch (subop)
+	{
+		case 0x00:
+			// Y
+			UML_MOV(block, I0, I2);                                                             // mov     i0,i2
+			clear_flags();
+			calc_nz();
+			break;
+
+		case 0x01:
+			// Y + 1
+			UML_ADD(block, I0, I2, 1);                                                          // add     i0,i2,1
+			clear_flags();
+			calc_nz();
+			flag_if_equal(I2, 0x7fff, VFLAG);
+			flag_if_equal(I2, 0xffff, CFLAG);
+			break;
+
+		case 0x02:
+			// X + Y + C
+			UML_ADD(block, I2, I2, I7);                                                         // add     i2,i2,i7
+			UML_ADD(block, I0, I1, I2);                                                         // add     i0,i1,i2
+			clear_flags();
+			calc_nz();
+			calc_vc(I1, I2, false);
+			break;
+
+		case 0x03:
+			// X + Y
+			UML_ADD(block, I0, I1, I2);                                                         // add     i0,i1,i2
+			clear_flags();
+			calc_nz();
+			calc_vc(I1, I2, false);
+			break;
+
+		case 0x04:
+			// NOT Y
+			UML_XOR(block, I0, I2, 0xffff);                                                     // xor     i0,i2,0xffff
+			clear_flags();
+			calc_nz();
+			break;
+
+		case 0x05:
+			// -Y
+			UML_SUB(block, I0, 0, I2);                                                          // sub     i0,0,i2
+			clear_flags();
+			calc_nz();
+			flag_if_equal(I2, 0x8000, VFLAG);
+			flag_if_equal(I2, 0x0000, CFLAG);
+			break;
+
+		case 0x06:
+			// X - Y + C - 1
+			UML_SUB(block, I0, I1, I2);                                                         // sub     i0,i1,i2
+			UML_ADD(block, I0, I0, I7);                                                         // add     i0,i0,i7
+			UML_SUB(block, I0, I0, 1);                                                          // sub     i0,i0,1
+			clear_flags();
+			calc_nz();
+			calc_vc(I1, I2, true);
+			break;
+
+		case 0x07:
+			// X - Y
+			UML_SUB(block, I0, I1, I2);                                                         // sub     i0,i1,i2
+			clear_flags();
+			calc_nz();
+			calc_vc(I1, I2, true);
+			break;
+
+		case 0x08:
+			// Y - 1
+			UML_SUB(block, I0, I2, 1);                                                          // sub     i0,i2,1
+			clear_flags();
+			calc_nz();
+			flag_if_equal(I2, 0x8000, VFLAG);
+			flag_if_equal(I2, 0x0000, CFLAG);
+			break;
+
+		case 0x09:
+			// Y - X
+			UML_SUB(block, I0, I2, I1);                                                         // sub     i0,i2,i1
+			clear_flags();
+			calc_nz();
+			calc_vc(I2, I1, true);
+			break;
+
+		case 0x0a:
+			// Y - X + C - 1
+			UML_SUB(block, I0, I2, I1);                                                         // sub     i0,i2,i1
+			UML_ADD(block, I0, I0, I7);                                                         // add     i0,i0,i7
+			UML_SUB(block, I0, I0, 1);                                                          // sub     i0,i0,1
+			clear_flags();
+			calc_nz();
+			calc_vc(I2, I1, true);
+			break;
+
+		case 0x0b:
+			// NOT X
+			UML_XOR(block, I0, I1, 0xffff);                                                     // xor     i0,i1,0xffff
+			clear_flags();
+			calc_nz();
+			break;
+
+		case 0x0c:
+			// X AND Y
+			UML_AND(block, I0, I1, I2);                                                         // and     i0,i1,i2
+			clear_flags();
+			calc_nz();
+			break;
+
+		case 0x0d:
+			// X OR Y
+			UML_OR(block, I0, I1, I2);                                                          // or      i0,i1,i2
+			clear_flags();
+			calc_nz();
+			break;
+
+		case 0x0e:
+			// X XOR Y
+			UML_XOR(block, I0, I1, I2);                                                         // xor     i0,i1,i2
+			clear_flags();
+			calc_nz();
+			break;
+
+		case 0x0f:
+			// ABS X
+			UML_SEXT(block, I5, I1, SIZE_WORD);                                                 // sext    i5,i1,word
+			UML_SAR(block, I5, I5, 31);                                                         // sar     i5,i5,31
+			UML_XOR(block, I0, I1, I5);                                                         // xor     i0,i1,i5
+			UML_SUB(block, I0, I0, I5);                                                         // sub     i0,i0,i5
+			clear_flags();
+			flag_if_equal(I1, 0x0000, ZFLAG);
+			flag_if_equal(I1, 0x8000, NFLAG | VFLAG);
+			UML_ROLAND(block, I4, I1, 21, SFLAG);                                               // roland  i4,i1,21,SFLAG
+			UML_OR(block, I3, I3, I4);                                                          // or      i3,i3,i4
+			break;
+	}
+
+	// AR saturates on overflow in saturation mode
+	if (saturate)
+	{
+		uml::code_label const nosat = compiler.labelnum++;
+		UML_LOAD(block, I4, &m_mstat, 0, SIZE_DWORD, SCALE_x4);                                // load    i4,mstat
+		UML_TEST(block, I4, MSTAT_SATURATE);                                                    // test    i4,MSTAT_SATURATE
+		UML_JMPc(block, COND_Z, nosat);                                                         // jz      nosat
+		UML_TEST(block, I3, VFLAG);                                                             // test    i3,VFLAG
+		UML_JMPc(block, COND_Z, nosat);                                                         // jz      nosat
+		UML_MOV(block, I0, 0x7fff);                                                             // mov     i0,0x7fff
+		UML_TEST(block, I3, CFLAG);                                                             // test    i3,CFLAG
+		UML_MOVc(block, COND_NZ, I0, 0x8000);                                                   // mov     i0,0x8000,nz
+		UML_LABEL(block, nosat);                                                                // nosat:
+	}
+
+	UML_STORE(block, dst, 0, I0, SIZE_WORD, SCALE_x2);                                         // store   dst,i0,word
+	UML_STORE(block, &m_astat, 0, I3, SIZE_DWORD, SCALE_x4);                                   // store   astat,i3
+}
+
+
+/*-------------------------------------------------
+    generate_mac - generate a MAC operation, as
+    mac_op_mr and mac_op_mf do
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_mac(drcuml_block &block, compiler_state &compiler, uint32_t op, bool to_mf)
+{
+	uint32_t const subop = (op >> 13) & 15;
+	if (subop == 0)
+		return;
+
+	// subops 1-3 round a signed product; 4-7, 8-b and c-f are the plain, MR + and MR - forms
+	bool const round = subop < 4;
+	uint32_t const type = round ? 0 : (subop & 3);
+	uint32_t const accumulate = round ? (subop - 1) : ((subop >> 2) - 1);
+
+	if (type < 2)
+		UML_LOADS(block, I1, m_mac_xregs[(op >> 8) & 7], 0, SIZE_WORD, SCALE_x2);              // loads   i1,xop,word
+	else
+		UML_LOAD(block, I1, m_mac_xregs[(op >> 8) & 7], 0, SIZE_WORD, SCALE_x2);               // load    i1,xop,word
+	if ((type == 0) || (type == 2))
+		UML_LOADS(block, I2, m_mac_yregs[(op >> 11) & 3], 0, SIZE_WORD, SCALE_x2);             // loads   i2,yop,word
+	else
+		UML_LOAD(block, I2, m_mac_yregs[(op >> 11) & 3], 0, SIZE_WORD, SCALE_x2);              // load    i2,yop,word
+
+	// the 32-bit product is shifted left in fractional mode
+	UML_MULU(block, I0, I6, I1, I2);                                                            // mulu    i0,i6,i1,i2
+	UML_LOAD(block, I4, &m_mstat, 0, SIZE_DWORD, SCALE_x4);                                    // load    i4,mstat
+	UML_ROLAND(block, I4, I4, 28, 1);                                                           // roland  i4,i4,28,1
+	UML_XOR(block, I4, I4, 1);                                                                  // xor     i4,i4,1
+	UML_SHL(block, I0, I0, I4);                                                                 // shl     i0,i0,i4
+	if (round)
+		UML_AND(block, I5, I0, 0xffff);                                                         // and     i5,i0,0xffff
+	UML_DSEXT(block, I0, I0, SIZE_DWORD);                                                       // dsext   i0,i0,dword
+
+	if (accumulate)
+	{
+		UML_DLOAD(block, I6, &m_core.mr.mr, 0, SIZE_QWORD, SCALE_x8);                          // dload   i6,mr
+		if (accumulate == 1)
+			UML_DADD(block, I0, I6, I0);                                                        // dadd    i0,i6,i0
+		else
+			UML_DSUB(block, I0, I6, I0);                                                        // dsub    i0,i6,i0
+	}
+
+	// round to nearest, and to even on a tie
+	if (round)
+	{
+		uml::code_label const nottie = compiler.labelnum++;
+		UML_DADD(block, I0, I0, 0x8000);                                                        // dadd    i0,i0,0x8000
+		UML_CMP(block, I5, 0x8000);                                                             // cmp     i5,0x8000
+		UML_JMPc(block, COND_NE, nottie);                                                       // jne     nottie
+		UML_DAND(block, I0, I0, ~uint64_t(0x10000));                                            // dand    i0,i0,~0x10000
+		UML_LABEL(block, nottie);                                                               // nottie:
+	}
+
+	if (to_mf)
+	{
+		UML_SHR(block, I0, I0, 16);                                                             // shr     i0,i0,16
+		UML_STORE(block, &m_core.mf.u, 0, I0, SIZE_WORD, SCALE_x2);                            // store   mf,i0,word
+	}
+	else
+	{
+		// MV is set unless bits 31-39 are all the same
+		UML_DSTORE(block, &m_core.mr.mr, 0, I0, SIZE_QWORD, SCALE_x8);                         // dstore  mr,i0
+		UML_DSHR(block, I4, I0, 31);                                                            // dshr    i4,i0,31
+		UML_ADD(block, I4, I4, 1);                                                              // add     i4,i4,1
+		UML_AND(block, I4, I4, 0x1ff);                                                          // and     i4,i4,0x1ff
+		UML_CMP(block, I4, 1);                                                                  // cmp     i4,1
+		UML_SETc(block, COND_A, I4);                                                            // seta    i4
+		UML_SHL(block, I4, I4, 6);                                                              // shl     i4,i4,6
+		UML_LOAD(block, I3, &m_astat, 0, SIZE_DWORD, SCALE_x4);                                // load    i3,astat
+		UML_AND(block, I3, I3, ~uint32_t(MVFLAG));                                              // and     i3,i3,~MVFLAG
+		UML_OR(block, I3, I3, I4);                                                              // or      i3,i3,i4
+		UML_STORE(block, &m_astat, 0, I3, SIZE_DWORD, SCALE_x4);                               // store   astat,i3
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_shift - generate an LSHIFT or ASHIFT,
+    by SE or an immediate, as shift_op and
+    shift_op_imm do
+-------------------------------------------------*/
+
+void adsp21xx_device::generate_shift(drcuml_block &block, compiler_state &compiler, uint32_t op, bool immediate)
+{
+	uint32_t const subop = (op >> 11) & 15;
+	bool const arithmetic = subop & 4;
+	bool const high = !(subop & 2);
+	bool const combine = subop & 1;
+	assert(subop < 8);
+
+	if (arithmetic)
+		UML_LOADS(block, I1, m_shift_xregs[(op >> 8) & 7], 0, SIZE_WORD, SCALE_x2);            // loads   i1,xop,word
+	else
+		UML_LOAD(block, I1, m_shift_xregs[(op >> 8) & 7], 0, SIZE_WORD, SCALE_x2);             // load    i1,xop,word
+	if (high)
+		UML_SHL(block, I1, I1, 16);                                                             // shl     i1,i1,16
+
+	if (immediate)
+	{
+		// positive counts shift left, negative ones right, and anything past 31 empties the register
+		int32_t const sc = int8_t(op);
+		if (sc > 0)
+		{
+			if (sc < 32)
+				UML_SHL(block, I0, I1, sc);                                                     // shl     i0,i1,sc
+			else
+				UML_MOV(block, I0, 0);                                                          // mov     i0,0
+		}
+		else if (arithmetic)
+			UML_SAR(block, I0, I1, std::min(-sc, 31));                                          // sar     i0,i1,-sc
+		else if (-sc < 32)
+			UML_SHR(block, I0, I1, -sc);                                                        // shr     i0,i1,-sc
+		else
+			UML_MOV(block, I0, 0);                                                              // mov     i0,0
+	}
+	else
+	{
+		uml::code_label const right = compiler.labelnum++;
+		uml::code_label const done = compiler.labelnum++;
+
+		UML_LOADS(block, I5, &m_core.se.s, 0, SIZE_WORD, SCALE_x2);                            // loads   i5,se,word
+		UML_SEXT(block, I5, I5, SIZE_BYTE);                                                     // sext    i5,i5,byte
+		UML_MOV(block, I0, 0);                                                                  // mov     i0,0
+		UML_CMP(block, I5, 0);                                                                  // cmp     i5,0
+		UML_JMPc(block, COND_LE, right);                                                        // jle     right
+		UML_CMP(block, I5, 32);                                                                 // cmp     i5,32
+		UML_JMPc(block, COND_GE, done);                                                         // jge     done
+		UML_SHL(block, I0, I1, I5);                                                             // shl     i0,i1,i5
+		UML_JMP(block, done);                                                                   // jmp     done
+
+		UML_LABEL(block, right);                                                                // right:
+		UML_SUB(block, I5, 0, I5);                                                              // sub     i5,0,i5
+		if (arithmetic)
+		{
+			UML_CMP(block, I5, 31);                                                             // cmp     i5,31
+			UML_MOVc(block, COND_G, I5, 31);                                                    // mov     i5,31,g
+			UML_SAR(block, I0, I1, I5);                                                         // sar     i0,i1,i5
+		}
+		else
+		{
+			UML_CMP(block, I5, 32);                                                             // cmp     i5,32
+			UML_JMPc(block, COND_GE, done);                                                     // jge     done
+			UML_SHR(block, I0, I1, I5);                                                         // shr     i0,i1,i5
+		}
+		UML_LABEL(block, done);                                                                 // done:
+	}
+
+	if (combine)
+	{
+		UML_LOAD(block, I4, &m_core.sr.sr, 0, SIZE_DWORD, SCALE_x4);                           // load    i4,sr
+		UML_OR(block, I0, I0, I4);                                                              // or      i0,i0,i4
+	}
+	UML_STORE(block, &m_core.sr.sr, 0, I0, SIZE_DWORD, SCALE_x4);                              // store   sr,i0
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a single
+    instruction; returns false if it should be
+    run by the interpreter's switch instead
+-------------------------------------------------*/
+
+bool adsp21xx_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	using namespace uml;
+
+	uint32_t const op = desc->opptr.l[0];
+	if (!drc_opcode_is_native(op))
+		return false;
+
+	// branch to a target, optionally pushing the return address
+	auto const jump = [this, &block, &compiler, desc] (uml::parameter const &target, bool call, bool busy)
+	{
+		compiler_state taken = compiler;
+		if (call)
+			generate_pc_push(block, taken, desc->pc + 1);
+
+		// a jump to itself waits for an interrupt, which can only come at the end of the timeslice
+		if (busy)
+		{
+			UML_STORE(block, &m_icount, 0, 0, SIZE_DWORD, SCALE_x4);                            // store   icount,0
+			taken.cycles = 1;
+		}
+		generate_branch(block, taken, desc, target);
+		compiler.labelnum = taken.labelnum;
+	};
+
+	uml::code_label const skip = compiler.labelnum++;
+	switch ((op >> 16) & 0xff)
+	{
+		case 0x00:
+		case 0x08:
+			// NOP
+			break;
+
+		case 0x03:
+			// call or jump on flag in
+			UML_LOAD(block, I0, &m_flagin, 0, SIZE_BYTE, SCALE_x1);                             // load    i0,flagin,byte
+			UML_CMP(block, I0, 0);                                                              // cmp     i0,0
+			UML_JMPc(block, (op & 0x000002) ? COND_E : COND_NE, skip);                          // jcc     skip
+			jump(((op >> 4) & 0x0fff) | ((op << 10) & 0x3000), op & 0x000001, false);
+			UML_LABEL(block, skip);                                                             // skip:
+			break;
+
+		case 0x09:
+		{
+			// modify address register
+			uint32_t const bank = (op >> 2) & 4;
+			uint32_t const ireg = bank + ((op >> 2) & 3);
+			UML_LOAD(block, I4, &m_i[ireg], 0, SIZE_DWORD, SCALE_x4);                          // load    i4,i[ireg]
+			generate_modify(block, compiler, ireg, bank + (op & 3));
+			break;
+		}
+
+		case 0x0a:
+		{
+			// conditional return; RTI is left to the interpreter
+			uml::code_label const popped = compiler.labelnum++;
+			generate_condition(block, compiler, op & 15, skip);
+			UML_LOAD(block, I0, &m_pc_sp, 0, SIZE_DWORD, SCALE_x4);                            // load    i0,pc_sp
+			UML_CMP(block, I0, 0);                                                              // cmp     i0,0
+			UML_JMPc(block, COND_LE, popped);                                                   // jle     popped
+			UML_SUB(block, I0, I0, 1);                                                          // sub     i0,i0,1
+			UML_STORE(block, &m_pc_sp, 0, I0, SIZE_DWORD, SCALE_x4);                           // store   pc_sp,i0
+			UML_CMP(block, I0, 0);                                                              // cmp     i0,0
+			UML_JMPc(block, COND_NE, popped);                                                   // jne     popped
+			UML_LOAD(block, I5, &m_sstat, 0, SIZE_DWORD, SCALE_x4);                            // load    i5,sstat
+			UML_OR(block, I5, I5, SSTAT_PC_EMPTY);                                              // or      i5,i5,PC_EMPTY
+			UML_STORE(block, &m_sstat, 0, I5, SIZE_DWORD, SCALE_x4);                           // store   sstat,i5
+			UML_LABEL(block, popped);                                                           // popped:
+			UML_LOAD(block, I9, &m_pc_stack[0], I0, SIZE_DWORD, SCALE_x4);                     // load    i9,pc_stack,i0
+			jump(I9, false, false);
+			UML_LABEL(block, skip);                                                             // skip:
+			break;
+		}
+
+		case 0x0b:
+			// conditional jump or call through I4-I7
+			generate_condition(block, compiler, op & 15, skip);
+			UML_LOAD(block, I9, &m_i[4 + ((op >> 6) & 3)], 0, SIZE_DWORD, SCALE_x4);           // load    i9,i[4+n]
+			UML_AND(block, I9, I9, 0x3fff);                                                     // and     i9,i9,0x3fff
+			jump(I9, op & 0x000010, false);
+			UML_LABEL(block, skip);                                                             // skip:
+			break;
+
+		case 0x0d:
+		{
+			// internal data move
+			uint32_t const groups = (op >> 8) & 15;
+			generate_read_reg(block, groups & 3, op & 15, I0);
+			generate_write_reg(block, groups >> 2, (op >> 4) & 15, I0);
+			break;
+		}
+
+		case 0x0e:
+			// conditional shift
+			generate_condition(block, compiler, op & 15, skip);
+			generate_shift(block, compiler, op, false);
+			UML_LABEL(block, skip);                                                             // skip:
+			break;
+
+		case 0x0f:
+			// shift immediate
+			generate_shift(block, compiler, op, true);
+			break;
+
+		case 0x10:
+			// shift with internal data register move
+			generate_shift(block, compiler, op, false);
+			generate_read_reg(block, 0, op & 15, I0);
+			generate_write_reg(block, 0, (op >> 4) & 15, I0);
+			break;
+
+		case 0x11: case 0x12: case 0x13:
+		{
+			// shift with memory read/write
+			uint32_t const dag = (((op >> 16) & 0xff) == 0x11) ? DAG_PROGRAM : (((op >> 16) & 0xff) == 0x12) ? DAG_DATA1 : DAG_DATA2;
+			if (op & 0x008000)
+			{
+				generate_read_reg(block, 0, (op >> 4) & 15, I2);
+				generate_dag_write(block, compiler, desc, dag, op);
+				generate_shift(block, compiler, op, false);
+			}
+			else
+			{
+				generate_shift(block, compiler, op, false);
+				generate_dag_read(block, compiler, desc, dag, op);
+				generate_write_reg(block, 0, (op >> 4) & 15, I0);
+			}
+			break;
+		}
+
+		case 0x18: case 0x19: case 0x1a: case 0x1b:
+		{
+			// conditional jump (immediate addr)
+			uint32_t const target = (op >> 4) & 0x3fff;
+			generate_condition(block, compiler, op & 15, skip);
+			jump(target, false, target == desc->pc);
+			UML_LABEL(block, skip);                                                             // skip:
+			break;
+		}
+
+		case 0x1c: case 0x1d: case 0x1e: case 0x1f:
+			// conditional call (immediate addr)
+			generate_condition(block, compiler, op & 15, skip);
+			jump((op >> 4) & 0x3fff, true, false);
+			UML_LABEL(block, skip);                                                             // skip:
+			break;
+
+		case 0x20: case 0x21: case 0x22: case 0x23:
+		case 0x24: case 0x25: case 0x26: case 0x27:
+			// conditional ALU or MAC
+			generate_condition(block, compiler, op & 15, skip);
+			generate_compute(block, compiler, (op >> 17) & 3, op);
+			UML_LABEL(block, skip);                                                             // skip:
+			break;
+
+		case 0x28: case 0x29: case 0x2a: case 0x2b:
+		case 0x2c: case 0x2d: case 0x2e: case 0x2f:
+			// ALU or MAC with internal data register move
+			generate_read_reg(block, 0, op & 15, I8);
+			generate_compute(block, compiler, (op >> 17) & 3, op);
+			generate_write_reg(block, 0, (op >> 4) & 15, I8);
+			break;
+
+		case 0x30: case 0x31: case 0x32: case 0x33:
+		case 0x34: case 0x35: case 0x36: case 0x37:
+		case 0x38: case 0x39: case 0x3a: case 0x3b:
+			// load non-data register immediate
+			generate_write_reg(block, (op >> 18) & 3, op & 15, uint32_t(int32_t(op << 14) >> 18));
+			break;
+
+		case 0x80: case 0x81: case 0x82: case 0x83:
+		case 0x84: case 0x85: case 0x86: case 0x87:
+		case 0x88: case 0x89: case 0x8a: case 0x8b:
+			// read data memory (immediate addr)
+			UML_MOV(block, I1, (op >> 4) & 0x3fff);                                             // mov     i1,addr
+			generate_memory_read(block, compiler, desc, DRC_DATA_READ);
+			generate_write_reg(block, (op >> 18) & 3, op & 15, I0);
+			break;
+
+		case 0x90: case 0x91: case 0x92: case 0x93:
+		case 0x94: case 0x95: case 0x96: case 0x97:
+		case 0x98: case 0x99: case 0x9a: case 0x9b:
+			// write data memory (immediate addr)
+			generate_read_reg(block, (op >> 18) & 3, op & 15, I2);
+			UML_MOV(block, I1, (op >> 4) & 0x3fff);                                             // mov     i1,addr
+			generate_memory_write(block, compiler, desc, DRC_DATA_WRITE);
+			break;
+
+		default:
+			if ((op >> 16) < 0x50)
+			{
+				// load data register immediate
+				generate_write_reg(block, 0, op & 15, (op >> 4) & 0xffff);
+			}
+			else if ((op >> 16) < 0x80)
+			{
+				// ALU or MAC with a memory read or write
+				static const uint32_t dags[4] = { DAG_PROGRAM, DAG_PROGRAM, DAG_DATA1, DAG_DATA2 };
+				uint32_t const dag = dags[(op >> 20) & 3];
+				if (op & 0x080000)
+				{
+					generate_read_reg(block, 0, (op >> 4) & 15, I2);
+					generate_dag_write(block, compiler, desc, dag, op);
+					generate_compute(block, compiler, (op >> 17) & 3, op);
+				}
+				else
+				{
+					generate_compute(block, compiler, (op >> 17) & 3, op);
+					generate_dag_read(block, compiler, desc, dag, op);
+					generate_write_reg(block, 0, (op >> 4) & 15, I0);
+				}
+			}
+			else if ((op >> 16) < 0xc0)
+			{
+				// data memory write (immediate) through DAG1 or DAG2
+				UML_MOV(block, I2, (op >> 4) & 0xffff);                                         // mov     i2,data
+				generate_dag_write(block, compiler, desc, ((op >> 16) < 0xb0) ? DAG_DATA1 : DAG_DATA2, op);
+			}
+			else
+			{
+				// ALU or MAC with data and program memory reads
+				static adsp_reg16 adsp_core::*const xdst[4] = { &adsp_core::ax0, &adsp_core::ax1, &adsp_core::mx0, &adsp_core::mx1 };
+				static adsp_reg16 adsp_core::*const ydst[4] = { &adsp_core::ay0, &adsp_core::ay1, &adsp_core::my0, &adsp_core::my1 };
+				generate_compute(block, compiler, (op >> 17) & 1, op);
+				generate_dag_read(block, compiler, desc, DAG_DATA1, op);
+				UML_STORE(block, &(m_core.*xdst[(op >> 18) & 3]), 0, I0, SIZE_WORD, SCALE_x2);  // store   xdst,i0,word
+				generate_dag_read(block, compiler, desc, DAG_PROGRAM, op >> 4);
+				UML_STORE(block, &(m_core.*ydst[(op >> 20) & 3]), 0, I0, SIZE_WORD, SCALE_x2);  // store   ydst,i0,word
+			}
+			break;
+	}
+	return true;
+}
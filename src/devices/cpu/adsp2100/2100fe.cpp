@@ -0,0 +1,203 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    2100fe.cpp
+
+    Front-end for the ADSP-21xx recompiler.
+
+    The end of a DO loop isn't visible in the instruction stream, so the
+    frontend keeps a map of the loop ends it has been told about, either
+    by describing a DO instruction or by the backend finding one already
+    on the loop stack.  Each instruction that ends a loop is described
+    as a conditional branch back to the start of the loop.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "2100fe.h"
+
+
+/***************************************************************************
+    FRONTEND
+***************************************************************************/
+
+/*-------------------------------------------------
+    adsp21xx_frontend - constructor
+-------------------------------------------------*/
+
+adsp21xx_frontend::adsp21xx_frontend(adsp21xx_device &adsp, u32 window_start, u32 window_end, u32 max_sequence)
+	: drc_frontend(adsp, window_start, window_end, max_sequence)
+	, m_adsp(adsp)
+	, m_loop_start(0x4000, NO_LOOP)
+	, m_new_loops(false)
+{
+}
+
+
+/*-------------------------------------------------
+    loop_start - return the start of the loop
+    ending at the given PC, or
+    BRANCH_TARGET_DYNAMIC if it isn't known
+-------------------------------------------------*/
+
+offs_t adsp21xx_frontend::loop_start(offs_t pc) const
+{
+	u16 const start = m_loop_start[pc];
+	return (start < UNKNOWN_START) ? start : BRANCH_TARGET_DYNAMIC;
+}
+
+
+/*-------------------------------------------------
+    add_loop - note a loop ending at the given PC
+-------------------------------------------------*/
+
+void adsp21xx_frontend::add_loop(offs_t endpc, offs_t startpc)
+{
+	if (endpc >= m_loop_start.size())
+		return;
+
+	u16 &entry = m_loop_start[endpc];
+	u16 const start = (startpc < UNKNOWN_START) ? u16(startpc) : UNKNOWN_START;
+	if (entry == NO_LOOP)
+	{
+		entry = start;
+		m_new_loops = true;
+	}
+
+	// loops sharing an end with different starts just lose the static target
+	else if (entry != start)
+		entry = UNKNOWN_START;
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool adsp21xx_frontend::describe(opcode_desc &desc, opcode_desc const *prev)
+{
+	desc.length = 1;
+	desc.cycles = 1;
+
+	// code that isn't in host memory can't be checksummed, so leave it to the interpreter
+	if ((desc.pc >= m_loop_start.size()) || !m_adsp.m_program->get_read_ptr(desc.pc))
+	{
+		desc.userflags |= USERFLAG_INTERPRET;
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	u32 const op = m_adsp.m_cache->read_dword(desc.pc);
+	desc.opptr.l[0] = op;
+
+	bool interpret = false;
+	switch ((op >> 16) & 0xff)
+	{
+		case 0x02:
+			// IDLE waits for an interrupt
+			if (op & 0x8000)
+				interpret = true;
+			break;
+
+		case 0x03:
+			// call or jump on flag in
+			describe_branch(desc, 0, ((op >> 4) & 0x0fff) | ((op << 10) & 0x3000));
+			break;
+
+		case 0x04:
+			// popping the status stack can unmask an interrupt
+			if ((op & 3) == 3)
+				interpret = true;
+			break;
+
+		case 0x0a:
+			// RTI also pops the status stack
+			if (op & 0x10)
+				interpret = true;
+			else
+				describe_branch(desc, op & 15, BRANCH_TARGET_DYNAMIC);
+			break;
+
+		case 0x0b:
+			// indirect jump or call
+			describe_branch(desc, op & 15, BRANCH_TARGET_DYNAMIC);
+			break;
+
+		case 0x0d:
+			// register moves into IMASK, ICNTL or IFC can take an interrupt
+			if ((((op >> 8) & 15) >= 0x0c) && writes_irq_register((op >> 4) & 15))
+				interpret = true;
+			break;
+
+		case 0x11:
+			// program memory writes can change the code that follows
+			if (op & 0x8000)
+				desc.flags |= OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x14: case 0x15: case 0x16: case 0x17:
+			// DO until
+			add_loop((op >> 4) & 0x3fff, desc.pc + 1);
+			break;
+
+		case 0x18: case 0x19: case 0x1a: case 0x1b:
+		case 0x1c: case 0x1d: case 0x1e: case 0x1f:
+			// conditional jump or call
+			describe_branch(desc, op & 15, (op >> 4) & 0x3fff);
+			break;
+
+		case 0x58: case 0x59: case 0x5a: case 0x5b:
+		case 0x5c: case 0x5d: case 0x5e: case 0x5f:
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x3c: case 0x3d: case 0x3e: case 0x3f:
+		case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+			// immediate and memory loads of IMASK, ICNTL or IFC
+			if (writes_irq_register(op & 15))
+				interpret = true;
+			break;
+	}
+
+	// the last instruction of a loop branches back to the start unless the loop is done
+	if (is_loop_end(desc.pc))
+	{
+		if (interpret || (desc.flags & OPFLAG_IS_BRANCH))
+		{
+			desc.flags &= ~(OPFLAG_IS_BRANCH | OPFLAG_END_SEQUENCE);
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			interpret = true;
+		}
+		else
+		{
+			desc.userflags |= USERFLAG_LOOP_END;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.targetpc = loop_start(desc.pc);
+		}
+	}
+
+	if (interpret)
+	{
+		desc.userflags |= USERFLAG_INTERPRET;
+		desc.flags |= OPFLAG_END_SEQUENCE;
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_branch - describe a jump, call or
+    return with the given condition
+-------------------------------------------------*/
+
+void adsp21xx_frontend::describe_branch(opcode_desc &desc, u32 condition, offs_t target)
+{
+	// condition 15 is always true
+	if (condition == 15)
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+	else
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+	desc.targetpc = target;
+}
@@ -0,0 +1,56 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    2100fe.h
+
+    Front-end for the ADSP-21xx recompiler.
+
+***************************************************************************/
+
+#ifndef MAME_CPU_ADSP2100_2100FE_H
+#define MAME_CPU_ADSP2100_2100FE_H
+
+#pragma once
+
+#include "adsp2100.h"
+#include "cpu/drcfe.h"
+
+#include <vector>
+
+
+class adsp21xx_frontend : public drc_frontend
+{
+public:
+	// flags for opcode_desc::userflags
+	static constexpr u32 USERFLAG_INTERPRET = 0x0001;   // instruction must be run by the interpreter
+	static constexpr u32 USERFLAG_LOOP_END  = 0x0002;   // instruction ends a DO loop
+
+	// construction/destruction
+	adsp21xx_frontend(adsp21xx_device &adsp, u32 window_start, u32 window_end, u32 max_sequence);
+
+	// DO loops
+	bool is_loop_end(offs_t pc) const { return (pc < m_loop_start.size()) && (m_loop_start[pc] != NO_LOOP); }
+	offs_t loop_start(offs_t pc) const;
+	void add_loop(offs_t endpc, offs_t startpc);
+	bool take_new_loops() { bool const result = m_new_loops; m_new_loops = false; return result; }
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, opcode_desc const *prev) override;
+
+private:
+	static constexpr u16 NO_LOOP = 0xffff;
+	static constexpr u16 UNKNOWN_START = 0xfffe;
+
+	// internal helpers
+	static bool writes_irq_register(u32 regnum) { return (regnum == 0x3) || (regnum == 0x4) || (regnum == 0xc); }
+	void describe_branch(opcode_desc &desc, u32 condition, offs_t target);
+
+	adsp21xx_device &   m_adsp;
+	std::vector<u16>    m_loop_start;       // start of the loop ending at each PC, if any
+	bool                m_new_loops;        // a loop end has been added since the last check
+};
+
+
+#endif // MAME_CPU_ADSP2100_2100FE_H
@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -178,10 +181,15 @@ enum
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+class adsp21xx_frontend;
+
+
 // ======================> adsp21xx_device
 
 class adsp21xx_device : public cpu_device
 {
+	friend class adsp21xx_frontend;
+
 public:
 	virtual ~adsp21xx_device();
 
@@ -213,6 +221,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 
 	// device_execute_interface overrides
 	virtual uint32_t execute_min_cycles() const override;
@@ -290,6 +299,62 @@ protected:
 	virtual bool generate_irq(int which, int indx = 0) = 0;
 	virtual void check_irqs() = 0;
 
+	// execution
+	inline void execute_op(uint32_t op);
+	void execute_one();
+
+	// recompiler (2100drc.cpp)
+	struct compiler_state;
+	struct drc_snapshot;
+	enum drc_access_kind : uint32_t
+	{
+		DRC_DATA_READ,
+		DRC_DATA_WRITE,
+		DRC_PROGRAM_READ,
+		DRC_PROGRAM_WRITE
+	};
+	struct drc_access
+	{
+		uint32_t kind;
+		uint32_t addr;
+		uint32_t data;
+	};
+
+	void drc_init();
+	void drc_flush_cache();
+	void drc_check_loops();
+	void execute_run_drc();
+	void drc_validate(const drc_snapshot &before);
+	uint32_t drc_replay(uint32_t kind, uint32_t addr, uint32_t data);
+	bool drc_opcode_is_native(uint32_t op) const;
+	void drc_compile_block(offs_t pc);
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, const uml::parameter &target);
+	void generate_check_dirty(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc);
+	void generate_sync_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_loop_end(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_condition(drcuml_block &block, compiler_state &compiler, uint32_t condition, uml::code_label skip);
+	void generate_pc_push(drcuml_block &block, compiler_state &compiler, uint32_t value);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_read_reg(drcuml_block &block, uint32_t group, uint32_t regnum, const uml::parameter &dst);
+	void generate_write_reg(drcuml_block &block, uint32_t group, uint32_t regnum, uml::parameter src);
+	void generate_modify(drcuml_block &block, compiler_state &compiler, uint32_t ireg, uint32_t mreg);
+	void generate_memory_read(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t kind);
+	void generate_memory_write(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t kind);
+	void generate_dag_address(drcuml_block &block, compiler_state &compiler, uint32_t dag, uint32_t ireg);
+	void generate_dag_read(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t dag, uint32_t op);
+	void generate_dag_write(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t dag, uint32_t op);
+	void generate_compute(drcuml_block &block, compiler_state &compiler, uint32_t type, uint32_t op);
+	void generate_alu(drcuml_block &block, compiler_state &compiler, uint32_t op, void *dst, bool saturate);
+	void generate_mac(drcuml_block &block, compiler_state &compiler, uint32_t op, bool to_mf);
+	void generate_shift(drcuml_block &block, compiler_state &compiler, uint32_t op, bool immediate);
+
+	static void cfunc_fallback(void *param);
+	static void cfunc_loop_exit(void *param);
+	static void cfunc_cntr_stack_pop(void *param);
+	static void cfunc_record_access(void *param);
+
 	// internal state
 	static const int PC_STACK_DEPTH     = 16;
 	static const int CNTR_STACK_DEPTH   = 4;
@@ -444,6 +509,26 @@ protected:
 	devcb_write_line        m_timer_fired_cb;          // callback for timer fired
 	devcb_write_line        m_dmovlay_cb;          // callback for DMOVLAY instruction
 
+	// recompiler state
+	std::unique_ptr<drc_cache>          m_drc_cache;
+	std::unique_ptr<drcuml_state>       m_drcuml;
+	std::unique_ptr<adsp21xx_frontend>  m_drcfe;
+	uml::code_handle *      m_drc_entry;
+	uml::code_handle *      m_drc_nocode;
+	uml::code_handle *      m_drc_out_of_cycles;
+	uml::code_handle *      m_drc_reset_cache;
+	uint8_t                 m_drc_cache_dirty;
+	bool                    m_drc_validate;         // check each compiled instruction against the interpreter
+	uint32_t                m_drc_op;               // opcode for cfunc_fallback
+	uint32_t                m_drc_access_kind;      // memory access for cfunc_record_access
+	uint32_t                m_drc_access_addr;
+	uint32_t                m_drc_access_data;
+	std::vector<drc_access> m_drc_accesses;         // accesses made by the instruction being validated
+	size_t                  m_drc_replay_index;
+	bool                    m_drc_replay;           // the interpreter is replaying recorded accesses
+	bool                    m_drc_replay_failed;
+	uint32_t                m_drc_divergences;
+
 	// debugging
 #if ADSP_TRACK_HOTSPOTS
 	uint32_t              m_pcbucket[0x4000];
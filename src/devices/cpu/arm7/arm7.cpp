@@ -75,6 +75,7 @@ arm7_cpu_device::arm7_cpu_device(const machine_config &mconfig, device_type type
 	, m_pc(0)
 {
 	memset(m_r, 0x00, sizeof(m_r));
+	m_impstate.fastram_select = 0;
 	uint32_t arch = ARM9_COPRO_ID_ARCH_V4;
 	if (m_archFlags & ARCHFLAG_T)
 		arch = ARM9_COPRO_ID_ARCH_V4T;
@@ -1567,6 +1568,19 @@ void arm7_cpu_device::arm7_dt_w_callback(uint32_t insn, uint32_t *prn)
 /***************************************************************************
  * Default Memory Handlers
  ***************************************************************************/
+
+// find the host word backing a physical address in a fast RAM region, if any
+inline uint32_t *arm7_cpu_device::fastram_word(offs_t addr, bool write) const
+{
+	for (uint32_t ramnum = 0; ramnum < m_impstate.fastram_select; ramnum++)
+	{
+		const fast_ram_info &ram = m_impstate.fastram[ramnum];
+		if (addr >= ram.start && addr <= ram.end && (!write || !ram.readonly))
+			return (uint32_t *)ram.base + ((addr - ram.start) >> 2);
+	}
+	return nullptr;
+}
+
 void arm7_cpu_device::arm7_cpu_write32(uint32_t addr, uint32_t data)
 {
 	if( COPRO_CTRL & COPRO_CTRL_MMU_EN )
@@ -1578,6 +1592,11 @@ void arm7_cpu_device::arm7_cpu_write32(uint32_t addr, uint32_t data)
 	}
 
 	addr &= ~3;
+	if (uint32_t *word = fastram_word(addr, true))
+	{
+		*word = data;
+		return;
+	}
 	m_program->write_dword(addr, data);
 }
 
@@ -1593,6 +1612,12 @@ void arm7_cpu_device::arm7_cpu_write16(uint32_t addr, uint16_t data)
 	}
 
 	addr &= ~1;
+	if (uint32_t *word = fastram_word(addr, true))
+	{
+		int const shift = 8 * ((m_endian == ENDIANNESS_LITTLE) ? (addr & 2) : (~addr & 2));
+		*word = (*word & ~(0xffff << shift)) | (uint32_t(data) << shift);
+		return;
+	}
 	m_program->write_word(addr, data);
 }
 
@@ -1606,6 +1631,12 @@ void arm7_cpu_device::arm7_cpu_write8(uint32_t addr, uint8_t data)
 		}
 	}
 
+	if (uint32_t *word = fastram_word(addr, true))
+	{
+		int const shift = 8 * ((m_endian == ENDIANNESS_LITTLE) ? (addr & 3) : (~addr & 3));
+		*word = (*word & ~(0xff << shift)) | (uint32_t(data) << shift);
+		return;
+	}
 	m_program->write_byte(addr, data);
 }
 
@@ -1621,15 +1652,13 @@ uint32_t arm7_cpu_device::arm7_cpu_read32(uint32_t addr)
 		}
 	}
 
-	if (addr & 3)
-	{
+	if (uint32_t const *word = fastram_word(addr, false))
+		result = *word;
+	else
 		result = m_program->read_dword(addr & ~3);
+
+	if (addr & 3)
 		result = (result >> (8 * (addr & 3))) | (result << (32 - (8 * (addr & 3))));
-	}
-	else
-	{
-		result = m_program->read_dword(addr);
-	}
 
 	return result;
 }
@@ -1646,7 +1675,10 @@ uint32_t arm7_cpu_device::arm7_cpu_read16(uint32_t addr)
 		}
 	}
 
-	result = m_program->read_word(addr & ~1);
+	if (uint32_t const *word = fastram_word(addr, false))
+		result = uint16_t(*word >> (8 * ((m_endian == ENDIANNESS_LITTLE) ? (addr & 2) : (~addr & 2))));
+	else
+		result = m_program->read_word(addr & ~1);
 
 	if (addr & 1)
 	{
@@ -1666,6 +1698,9 @@ uint8_t arm7_cpu_device::arm7_cpu_read8(uint32_t addr)
 		}
 	}
 
+	if (uint32_t const *word = fastram_word(addr, false))
+		return uint8_t(*word >> (8 * ((m_endian == ENDIANNESS_LITTLE) ? (addr & 3) : (~addr & 3))));
+
 	// Handle through normal 8 bit handler (for 32 bit cpu)
 	return m_program->read_byte(addr);
 }
@@ -55,6 +55,9 @@ public:
 
 	void set_high_vectors() { m_vectorbase = 0xffff0000; }
 
+	// fast RAM: data accesses to these ranges bypass the address space and go straight to the host pointer
+	void add_fastram(offs_t start, offs_t end, bool readonly, void *base) { arm7drc_add_fastram(start, end, readonly, base); }
+
 protected:
 	enum
 	{
@@ -242,6 +245,7 @@ protected:
 	virtual uint32_t arm7_cpu_read32(uint32_t addr);
 	virtual uint32_t arm7_cpu_read16(uint32_t addr);
 	virtual uint8_t arm7_cpu_read8(uint32_t addr);
+	inline uint32_t *fastram_word(offs_t addr, bool write) const;
 
 	// Coprocessor support
 	DECLARE_WRITE32_MEMBER( arm7_do_callback );
@@ -222,6 +222,7 @@ union drcbec_instruction
 	int64_t *             pint64;
 	float *             pfloat;
 	double *            pdouble;
+	drcuml_vreg *       pvreg;
 	void                (*cfunc)(void *);
 	drcuml_machine_state *state;
 	const code_handle * handle;
@@ -397,6 +398,13 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, uint32_
 				if (opcode == OP_FFRINT || opcode == OP_FFRFLT)
 					psize[1] = 1 << inst.param(2).size();
 
+				// vector opcodes have 32-bit parameters; their lane size doesn't fit
+				// in the opcode, so it is stored in an extra word after the parameters
+				bool const vector = (opcode >= OP_VLOAD && opcode <= OP_VSHUF);
+				if (vector)
+					for (int pnum = 0; pnum < inst.numparams(); pnum++)
+						psize[pnum] = 4;
+
 				// pre-expand opcodes that encode size/scale in them
 				if (opcode == OP_LOAD)
 					opcode = (opcode_t)(OP_LOAD1 + inst.param(3).size() * 4 + inst.param(3).scale());
@@ -433,14 +441,17 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, uint32_
 				int immedwords = (immedbytes + sizeof(drcbec_instruction) - 1) / sizeof(drcbec_instruction);
 
 				// first item is the opcode, size, condition flags and length
-				(dst++)->i = MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), inst.numparams() + immedwords);
+				int const extrawords = vector ? 1 : 0;
+				(dst++)->i = MAKE_OPCODE_FULL(opcode, vector ? 4 : inst.size(), inst.condition(), inst.flags(), inst.numparams() + extrawords + immedwords);
 
 				// immediates start after parameters
-				void *immed = dst + inst.numparams();
+				void *immed = dst + inst.numparams() + extrawords;
 
 				// output each of the parameters
 				for (int pnum = 0; pnum < inst.numparams(); pnum++)
 					output_parameter(&dst, &immed, psize[pnum], inst.param(pnum));
+				if (vector)
+					(dst++)->i = inst.size();
 
 				// point past the end of the immediates
 				dst += immedwords;
@@ -2105,6 +2116,45 @@ int drcbe_c::execute(code_handle &entry)
 				*inst[0].pint64 = d2u(FDPARAM1);
 				break;
 
+
+			// ----------------------- Vector Operations -----------------------
+
+			case MAKE_OPCODE_SHORT(OP_VLOAD, 4, 0):     // VLOAD   dst,base,index
+				memcpy(inst[0].pvreg, inst[1].puint8 + 16 * PARAM2, 16);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VSTORE, 4, 0):    // VSTORE  base,index,src
+				memcpy(inst[0].puint8 + 16 * PARAM1, inst[2].pvreg, 16);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VMOV, 4, 0):      // VMOV    dst,src
+				*inst[0].pvreg = *inst[1].pvreg;
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VAND, 4, 0):      // VAND    dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VOR, 4, 0):       // VOR     dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VXOR, 4, 0):      // VXOR    dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VADD, 4, 0):      // VADD    dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VSUB, 4, 0):      // VSUB    dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VADDS, 4, 0):     // VADDS   dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VSUBS, 4, 0):     // VSUBS   dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VADDUS, 4, 0):    // VADDUS  dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VSUBUS, 4, 0):    // VSUBUS  dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VMULL, 4, 0):     // VMULL   dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VMULH, 4, 0):     // VMULH   dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VMULHU, 4, 0):    // VMULHU  dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VCMPEQ, 4, 0):    // VCMPEQ  dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VCMPGT, 4, 0):    // VCMPGT  dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VFADD, 4, 0):     // VFADD   dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VFSUB, 4, 0):     // VFSUB   dst,src1,src2
+			case MAKE_OPCODE_SHORT(OP_VFMUL, 4, 0):     // VFMUL   dst,src1,src2
+				drc_vector_execute(opcode_t(OPCODE_GET_SHORT(opcode) >> 2), inst[3].i, *inst[0].pvreg, *inst[1].pvreg, *inst[2].pvreg, 0);
+				break;
+
+			case MAKE_OPCODE_SHORT(OP_VSHUF, 4, 0):     // VSHUF   dst,src,lanes
+				drc_vector_execute(OP_VSHUF, inst[3].i, *inst[0].pvreg, *inst[1].pvreg, *inst[1].pvreg, PARAM2);
+				break;
+
 			default:
 				fatalerror("Unexpected opcode!\n");
 		}
@@ -2161,6 +2211,11 @@ void drcbe_c::output_parameter(drcbec_instruction **dstptr, void **immedptr, int
 				(dst++)->pdouble = &m_state.f[param.freg() - REG_F0].d;
 			break;
 
+		// vector registers point to the whole register
+		case parameter::PTYPE_VECTOR_REGISTER:
+			(dst++)->pvreg = &m_state.v[param.vreg() - REG_V0];
+			break;
+
 		// convert mapvars to immediates
 		case parameter::PTYPE_MAPVAR:
 			temp_param = m_map.get_last_value(param.mapvar());
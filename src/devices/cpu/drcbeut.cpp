@@ -11,6 +11,9 @@
 #include "emu.h"
 #include "drcbeut.h"
 
+#include <limits>
+#include <type_traits>
+
 using namespace uml;
 
 
@@ -45,6 +48,17 @@ drc_hash_table::drc_hash_table(drc_cache &cache, uint32_t modes, uint8_t addrbit
 		m_emptyl2(nullptr)
 {
 	reset();
+	m_cache.add_evict_notifier(this, drc_evict_delegate(&drc_hash_table::evict, this));
+}
+
+
+//-------------------------------------------------
+//  ~drc_hash_table - destructor
+//-------------------------------------------------
+
+drc_hash_table::~drc_hash_table()
+{
+	m_cache.remove_evict_notifier(this);
 }
 
 
@@ -56,7 +70,7 @@ drc_hash_table::drc_hash_table(drc_cache &cache, uint32_t modes, uint8_t addrbit
 bool drc_hash_table::reset()
 {
 	// allocate an empty l2 hash table
-	m_emptyl2 = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits);
+	m_emptyl2 = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits, true);
 	if (m_emptyl2 == nullptr)
 		return false;
 
@@ -65,7 +79,7 @@ bool drc_hash_table::reset()
 		m_emptyl2[entry] = m_nocodeptr;
 
 	// allocate an empty l1 hash table
-	m_emptyl1 = (drccodeptr **)m_cache.alloc_temporary(sizeof(drccodeptr *) << m_l1bits);
+	m_emptyl1 = (drccodeptr **)m_cache.alloc_temporary(sizeof(drccodeptr *) << m_l1bits, true);
 	if (m_emptyl1 == nullptr)
 		return false;
 
@@ -163,7 +177,7 @@ bool drc_hash_table::set_codeptr(uint32_t mode, uint32_t pc, drccodeptr code)
 	assert(mode < m_modes);
 	if (m_base[mode] == m_emptyl1)
 	{
-		drccodeptr **newtable = (drccodeptr **)m_cache.alloc_temporary(sizeof(drccodeptr *) << m_l1bits);
+		drccodeptr **newtable = (drccodeptr **)m_cache.alloc_temporary(sizeof(drccodeptr *) << m_l1bits, true);
 		if (newtable == nullptr)
 			return false;
 		memcpy(newtable, m_emptyl1, sizeof(drccodeptr *) << m_l1bits);
@@ -174,7 +188,7 @@ bool drc_hash_table::set_codeptr(uint32_t mode, uint32_t pc, drccodeptr code)
 	uint32_t l1 = (pc >> m_l1shift) & m_l1mask;
 	if (m_base[mode][l1] == m_emptyl2)
 	{
-		drccodeptr *newtable = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits);
+		drccodeptr *newtable = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits, true);
 		if (newtable == nullptr)
 			return false;
 		memcpy(newtable, m_emptyl2, sizeof(drccodeptr) << m_l2bits);
@@ -188,6 +202,26 @@ bool drc_hash_table::set_codeptr(uint32_t mode, uint32_t pc, drccodeptr code)
 }
 
 
+//-------------------------------------------------
+//  evict - point any entries for code in an
+//  evicted range back at the default codeptr
+//-------------------------------------------------
+
+void drc_hash_table::evict(drccodeptr start, drccodeptr end)
+{
+	for (int modenum = 0; modenum < m_modes; modenum++)
+		if (m_base[modenum] != m_emptyl1)
+			for (int l1entry = 0; l1entry < (1 << m_l1bits); l1entry++)
+				if (m_base[modenum][l1entry] != m_emptyl2)
+					for (int l2entry = 0; l2entry < (1 << m_l2bits); l2entry++)
+					{
+						drccodeptr &entry = m_base[modenum][l1entry][l2entry];
+						if (entry >= start && entry < end)
+							entry = m_nocodeptr;
+					}
+}
+
+
 
 //**************************************************************************
 //  DRC MAP VARIABLES
@@ -243,8 +277,8 @@ void drc_map_variables::block_end(drcuml_block &block)
 	if (m_entry_list.first() == nullptr)
 		return;
 
-	// begin "code generation" aligned to an 8-byte boundary
-	drccodeptr *top = m_cache.begin_codegen(sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(uint32_t) * m_entry_list.count());
+	// begin "code generation" aligned to an 8-byte boundary; this must land in the same region as the code
+	drccodeptr *top = m_cache.begin_codegen(sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(uint32_t) * m_entry_list.count(), false);
 	if (top == nullptr)
 		block.abort();
 	uint32_t *dest = (uint32_t *)(((uintptr_t)*top + 7) & ~7);
@@ -356,7 +390,7 @@ uint32_t drc_map_variables::get_value(drccodeptr codebase, uint32_t mapvar) cons
 
 	// get an aligned pointer to start scanning
 	uint64_t *curscan = (uint64_t *)(((uintptr_t)codebase | 7) + 1);
-	uint64_t *endscan = (uint64_t *)m_cache.top();
+	uint64_t *endscan = (uint64_t *)m_cache.region_top(codebase);
 
 	// look for the signature
 	while (curscan < endscan && *curscan++ != m_uniquevalue) {};
@@ -577,3 +611,160 @@ void drc_label_list::oob_callback(drccodeptr *codeptr, void *param1, void *param
 	label_fixup *fixup = reinterpret_cast<label_fixup *>(param1);
 	fixup->m_callback(param2, fixup->m_label->m_codeptr);
 }
+
+
+
+//**************************************************************************
+//  VECTOR OPERATIONS
+//**************************************************************************
+
+namespace {
+
+//-------------------------------------------------
+//  lanewise - apply an operation to each pair of
+//  source lanes
+//-------------------------------------------------
+
+template <typename T, std::size_t N, typename F>
+inline void lanewise(T (&dst)[N], const T (&src1)[N], const T (&src2)[N], F &&func)
+{
+	for (std::size_t lane = 0; lane < N; lane++)
+		dst[lane] = T(func(src1[lane], src2[lane]));
+}
+
+template <typename F>
+inline void lanewise(uint32_t lanesize, drcuml_vreg &dst, const drcuml_vreg &src1, const drcuml_vreg &src2, F &&func)
+{
+	switch (lanesize)
+	{
+		case 1: lanewise(dst.b, src1.b, src2.b, func); break;
+		case 2: lanewise(dst.h, src1.h, src2.h, func); break;
+		case 4: lanewise(dst.w, src1.w, src2.w, func); break;
+		case 8: lanewise(dst.d, src1.d, src2.d, func); break;
+	}
+}
+
+
+//-------------------------------------------------
+//  saturating_lanewise - apply an operation to
+//  8- or 16-bit lanes, clamping the result to the
+//  signed or unsigned range of the lane
+//-------------------------------------------------
+
+template <bool Signed, typename T, std::size_t N, typename F>
+inline void saturating_lanewise(T (&dst)[N], const T (&src1)[N], const T (&src2)[N], F &&func)
+{
+	using S = std::conditional_t<Signed, std::make_signed_t<T>, T>;
+	for (std::size_t lane = 0; lane < N; lane++)
+	{
+		int32_t const result = func(int32_t(S(src1[lane])), int32_t(S(src2[lane])));
+		dst[lane] = T(S(std::min<int32_t>(std::max<int32_t>(result, std::numeric_limits<S>::min()), std::numeric_limits<S>::max())));
+	}
+}
+
+template <bool Signed, typename F>
+inline void saturating_lanewise(uint32_t lanesize, drcuml_vreg &dst, const drcuml_vreg &src1, const drcuml_vreg &src2, F &&func)
+{
+	if (lanesize == 1)
+		saturating_lanewise<Signed>(dst.b, src1.b, src2.b, func);
+	else
+		saturating_lanewise<Signed>(dst.h, src1.h, src2.h, func);
+}
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  drc_vector_execute - execute a vector opcode
+//  other than a load or store
+//-------------------------------------------------
+
+void drc_vector_execute(uml::opcode_t opcode, uint32_t lanesize, drcuml_vreg &dst, const drcuml_vreg &src1, const drcuml_vreg &src2, uint32_t lanes)
+{
+	// build the result separately in case the destination is also a source
+	drcuml_vreg result;
+	switch (opcode)
+	{
+		case OP_VMOV:
+			result = src1;
+			break;
+
+		case OP_VAND:
+			lanewise(result.d, src1.d, src2.d, [] (uint64_t a, uint64_t b) { return a & b; });
+			break;
+
+		case OP_VOR:
+			lanewise(result.d, src1.d, src2.d, [] (uint64_t a, uint64_t b) { return a | b; });
+			break;
+
+		case OP_VXOR:
+			lanewise(result.d, src1.d, src2.d, [] (uint64_t a, uint64_t b) { return a ^ b; });
+			break;
+
+		case OP_VADD:
+			lanewise(lanesize, result, src1, src2, [] (auto a, auto b) { return a + b; });
+			break;
+
+		case OP_VSUB:
+			lanewise(lanesize, result, src1, src2, [] (auto a, auto b) { return a - b; });
+			break;
+
+		case OP_VADDS:
+			saturating_lanewise<true>(lanesize, result, src1, src2, [] (int32_t a, int32_t b) { return a + b; });
+			break;
+
+		case OP_VSUBS:
+			saturating_lanewise<true>(lanesize, result, src1, src2, [] (int32_t a, int32_t b) { return a - b; });
+			break;
+
+		case OP_VADDUS:
+			saturating_lanewise<false>(lanesize, result, src1, src2, [] (int32_t a, int32_t b) { return a + b; });
+			break;
+
+		case OP_VSUBUS:
+			saturating_lanewise<false>(lanesize, result, src1, src2, [] (int32_t a, int32_t b) { return a - b; });
+			break;
+
+		case OP_VMULL:
+			lanewise(result.h, src1.h, src2.h, [] (uint16_t a, uint16_t b) { return uint32_t(a) * uint32_t(b); });
+			break;
+
+		case OP_VMULH:
+			lanewise(result.h, src1.h, src2.h, [] (uint16_t a, uint16_t b) { return (int32_t(int16_t(a)) * int32_t(int16_t(b))) >> 16; });
+			break;
+
+		case OP_VMULHU:
+			lanewise(result.h, src1.h, src2.h, [] (uint16_t a, uint16_t b) { return (uint32_t(a) * uint32_t(b)) >> 16; });
+			break;
+
+		case OP_VCMPEQ:
+			lanewise(lanesize, result, src1, src2, [] (auto a, auto b) { return (a == b) ? ~uint64_t(0) : 0; });
+			break;
+
+		case OP_VCMPGT:
+			lanewise(lanesize, result, src1, src2, [] (auto a, auto b) { return (std::make_signed_t<decltype(a)>(a) > std::make_signed_t<decltype(b)>(b)) ? ~uint64_t(0) : 0; });
+			break;
+
+		case OP_VFADD:
+			lanewise(result.s, src1.s, src2.s, [] (float a, float b) { return a + b; });
+			break;
+
+		case OP_VFSUB:
+			lanewise(result.s, src1.s, src2.s, [] (float a, float b) { return a - b; });
+			break;
+
+		case OP_VFMUL:
+			lanewise(result.s, src1.s, src2.s, [] (float a, float b) { return a * b; });
+			break;
+
+		// each nibble of the lanes value selects the source of one 16-bit lane, lowest lane first
+		case OP_VSHUF:
+			for (int lane = 0; lane < 8; lane++)
+				result.h[lane] = src1.h[(lanes >> (4 * lane)) & 7];
+			break;
+
+		default:
+			fatalerror("Unexpected vector opcode\n");
+	}
+	dst = result;
+}
@@ -28,6 +28,7 @@ class drc_hash_table
 public:
 	// construction/destruction
 	drc_hash_table(drc_cache &cache, uint32_t modes, uint8_t addrbits, uint8_t ignorebits);
+	~drc_hash_table();
 
 	// getters
 	drccodeptr ***base() const { return m_base; }
@@ -53,6 +54,9 @@ public:
 	bool code_exists(uint32_t mode, uint32_t pc) { return get_codeptr(mode, pc) != m_nocodeptr; }
 
 private:
+	// eviction
+	void evict(drccodeptr start, drccodeptr end);
+
 	// internal state
 	drc_cache &     m_cache;                // cache where allocations come from
 	uint32_t          m_modes;                // number of modes supported
@@ -163,4 +167,11 @@ private:
 };
 
 
+// ======================> drc_vector_execute
+
+// portable lane-by-lane implementation of the vector opcodes, for back-ends
+// that don't generate native code for them; may be called by generated code
+void drc_vector_execute(uml::opcode_t opcode, uint32_t lanesize, drcuml_vreg &dst, const drcuml_vreg &src1, const drcuml_vreg &src2, uint32_t lanes);
+
+
 #endif /* __DRCBEUT_H__ */
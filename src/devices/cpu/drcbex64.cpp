@@ -223,6 +223,7 @@ const uint32_t PTYPE_M    = 1 << parameter::PTYPE_MEMORY;
 const uint32_t PTYPE_I    = 1 << parameter::PTYPE_IMMEDIATE;
 const uint32_t PTYPE_R    = 1 << parameter::PTYPE_INT_REGISTER;
 const uint32_t PTYPE_F    = 1 << parameter::PTYPE_FLOAT_REGISTER;
+const uint32_t PTYPE_V    = 1 << parameter::PTYPE_VECTOR_REGISTER;
 //const uint32_t PTYPE_MI   = PTYPE_M | PTYPE_I;
 //const uint32_t PTYPE_RI   = PTYPE_R | PTYPE_I;
 const uint32_t PTYPE_MR   = PTYPE_M | PTYPE_R;
@@ -281,10 +282,19 @@ static const uint8_t int_register_map[REG_I_COUNT] =
 #ifdef X64_WINDOWS_ABI
 	REG_RBX, REG_RSI, REG_RDI, REG_R12, REG_R13, REG_R14, REG_R15
 #else
-	REG_RBX, REG_R12, REG_R13, REG_R14, REG_R15
+	// on AMD x64 ABI, R8-R10 aren't needed for any of our calls, but C functions can
+	// clobber them, so they are saved to the machine state around each call
+	REG_RBX, REG_R12, REG_R13, REG_R14, REG_R15, REG_R8, REG_R9, REG_R10
 #endif
 };
 
+// first UML integer register that is mapped to a register not preserved across C calls
+#ifdef X64_WINDOWS_ABI
+static constexpr int VOLATILE_IREG_START = REG_I_COUNT;
+#else
+static constexpr int VOLATILE_IREG_START = 5;
+#endif
+
 static uint8_t float_register_map[REG_F_COUNT] =
 {
 #ifdef X64_WINDOWS_ABI
@@ -422,7 +432,30 @@ const drcbe_x64::opcode_table_entry drcbe_x64::s_opcode_table_source[] =
 	{ uml::OP_FRECIP,  &drcbe_x64::op_frecip },     // FRECIP  dst,src1
 	{ uml::OP_FRSQRT,  &drcbe_x64::op_frsqrt },     // FRSQRT  dst,src1
 	{ uml::OP_FCOPYI,  &drcbe_x64::op_fcopyi },     // FCOPYI  dst,src
-	{ uml::OP_ICOPYF,  &drcbe_x64::op_icopyf }      // ICOPYF  dst,src
+	{ uml::OP_ICOPYF,  &drcbe_x64::op_icopyf },     // ICOPYF  dst,src
+
+	// Vector Operations
+	{ uml::OP_VLOAD,   &drcbe_x64::op_vload },      // VLOAD   dst,base,index
+	{ uml::OP_VSTORE,  &drcbe_x64::op_vstore },     // VSTORE  base,index,src
+	{ uml::OP_VMOV,    &drcbe_x64::op_vmov },       // VMOV    dst,src
+	{ uml::OP_VAND,    &drcbe_x64::op_vbinary },    // VAND    dst,src1,src2
+	{ uml::OP_VOR,     &drcbe_x64::op_vbinary },    // VOR     dst,src1,src2
+	{ uml::OP_VXOR,    &drcbe_x64::op_vbinary },    // VXOR    dst,src1,src2
+	{ uml::OP_VADD,    &drcbe_x64::op_vbinary },    // VADD    dst,src1,src2
+	{ uml::OP_VSUB,    &drcbe_x64::op_vbinary },    // VSUB    dst,src1,src2
+	{ uml::OP_VADDS,   &drcbe_x64::op_vbinary },    // VADDS   dst,src1,src2
+	{ uml::OP_VSUBS,   &drcbe_x64::op_vbinary },    // VSUBS   dst,src1,src2
+	{ uml::OP_VADDUS,  &drcbe_x64::op_vbinary },    // VADDUS  dst,src1,src2
+	{ uml::OP_VSUBUS,  &drcbe_x64::op_vbinary },    // VSUBUS  dst,src1,src2
+	{ uml::OP_VMULL,   &drcbe_x64::op_vbinary },    // VMULL   dst,src1,src2
+	{ uml::OP_VMULH,   &drcbe_x64::op_vbinary },    // VMULH   dst,src1,src2
+	{ uml::OP_VMULHU,  &drcbe_x64::op_vbinary },    // VMULHU  dst,src1,src2
+	{ uml::OP_VCMPEQ,  &drcbe_x64::op_vbinary },    // VCMPEQ  dst,src1,src2
+	{ uml::OP_VCMPGT,  &drcbe_x64::op_vbinary },    // VCMPGT  dst,src1,src2
+	{ uml::OP_VFADD,   &drcbe_x64::op_vbinary },    // VFADD   dst,src1,src2
+	{ uml::OP_VFSUB,   &drcbe_x64::op_vbinary },    // VFSUB   dst,src1,src2
+	{ uml::OP_VFMUL,   &drcbe_x64::op_vbinary },    // VFMUL   dst,src1,src2
+	{ uml::OP_VSHUF,   &drcbe_x64::op_vshuf }       // VSHUF   dst,src,lanes
 };
 
 
@@ -476,6 +509,12 @@ drcbe_x64::be_parameter::be_parameter(drcbe_x64 &drcbe, const parameter &param,
 				*this = make_memory(&drcbe.m_state.f[param.freg() - REG_F0]);
 			break;
 
+		// vector registers always live in memory
+		case parameter::PTYPE_VECTOR_REGISTER:
+			assert(allowed & PTYPE_V);
+			*this = make_memory(&drcbe.m_state.v[param.vreg() - REG_V0]);
+			break;
+
 		// everything else is unexpected
 		default:
 			fatalerror("Unexpected parameter type\n");
@@ -580,6 +619,7 @@ inline int drcbe_x64::get_base_register_and_offset(x86code *&dst, void *target,
 
 inline void drcbe_x64::emit_smart_call_r64(x86code *&dst, x86code *target, uint8_t reg)
 {
+	emit_save_volatile_iregs(dst);
 	int64_t delta = target - (dst + 5);
 	if (short_immediate(delta))
 		emit_call(dst, target);                                                         // call  target
@@ -588,6 +628,7 @@ inline void drcbe_x64::emit_smart_call_r64(x86code *&dst, x86code *target, uint8
 		emit_mov_r64_imm(dst, reg, (uintptr_t)target);                                       // mov   reg,target
 		emit_call_r64(dst, reg);                                                        // call  reg
 	}
+	emit_restore_volatile_iregs(dst);
 }
 
 
@@ -598,11 +639,39 @@ inline void drcbe_x64::emit_smart_call_r64(x86code *&dst, x86code *target, uint8
 
 inline void drcbe_x64::emit_smart_call_m64(x86code *&dst, x86code **target)
 {
+	emit_save_volatile_iregs(dst);
 	int64_t delta = *target - (dst + 5);
 	if (short_immediate(delta))
 		emit_call(dst, *target);                                                        // call  *target
 	else
 		emit_call_m64(dst, MABS(target));                                               // call  [target]
+	emit_restore_volatile_iregs(dst);
+}
+
+
+//-------------------------------------------------
+//  emit_save_volatile_iregs - store UML integer
+//  registers that a C call could clobber
+//-------------------------------------------------
+
+inline void drcbe_x64::emit_save_volatile_iregs(x86code *&dst)
+{
+	for (int regnum = VOLATILE_IREG_START; regnum < REG_I_COUNT; regnum++)
+		if (int_register_map[regnum] != 0)
+			emit_mov_m64_r64(dst, MABS(&m_state.r[regnum]), int_register_map[regnum]);   // mov   [r[regnum]],reg
+}
+
+
+//-------------------------------------------------
+//  emit_restore_volatile_iregs - reload UML
+//  integer registers after a C call
+//-------------------------------------------------
+
+inline void drcbe_x64::emit_restore_volatile_iregs(x86code *&dst)
+{
+	for (int regnum = VOLATILE_IREG_START; regnum < REG_I_COUNT; regnum++)
+		if (int_register_map[regnum] != 0)
+			emit_mov_r64_m64(dst, int_register_map[regnum], MABS(&m_state.r[regnum]));   // mov   reg,[r[regnum]]
 }
 
 
@@ -823,7 +892,7 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, uint3
 	x86code *dst = base;
 
 	// generate code
-	const char *blockname = nullptr;
+	std::string blockname;
 	for (int inum = 0; inum < numinst; inum++)
 	{
 		const instruction &inst = instlist[inum];
@@ -837,12 +906,12 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, uint3
 		}
 
 		// extract a blockname
-		if (blockname == nullptr)
+		if (blockname.empty())
 		{
 			if (inst.opcode() == OP_HANDLE)
 				blockname = inst.param(0).handle().string();
 			else if (inst.opcode() == OP_HASH)
-				blockname = string_format("Code: mode=%d PC=%08X", (uint32_t)inst.param(0).immediate(), (offs_t)inst.param(1).immediate()).c_str();
+				blockname = string_format("Code: mode=%d PC=%08X", (uint32_t)inst.param(0).immediate(), (offs_t)inst.param(1).immediate());
 		}
 
 		// generate code
@@ -855,7 +924,10 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, uint3
 
 	// log it
 	if (m_log != nullptr)
-		x86log_disasm_code_range(m_log, (blockname == nullptr) ? "Unknown block" : blockname, base, m_cache.top());
+		x86log_disasm_code_range(m_log, blockname.empty() ? "Unknown block" : blockname.c_str(), base, m_cache.top());
+
+	// name it for profilers
+	m_drcuml.perf_map_add(base, m_cache.top(), blockname.empty() ? "Unknown block" : blockname.c_str());
 
 	// tell all of our utility objects that the block is finished
 	m_hash.block_end(block);
@@ -3388,6 +3460,14 @@ void drcbe_x64::op_save(x86code *&dst, const instruction &inst)
 			emit_mov_m64_r64(dst, MBD(REG_RCX, regoffs + 8 * regnum), REG_RAX);
 		}
 	}
+
+	// copy vector registers
+	regoffs = offsetof(drcuml_machine_state, v);
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.v); regnum++)
+	{
+		emit_movdqa_r128_m128(dst, REG_XMM0, MABS(&m_state.v[regnum]));
+		emit_movdqu_m128_r128(dst, MBD(REG_RCX, regoffs + 16 * regnum), REG_XMM0);
+	}
 }
 
 
@@ -3433,6 +3513,14 @@ void drcbe_x64::op_restore(x86code *&dst, const instruction &inst)
 		}
 	}
 
+	// copy vector registers
+	regoffs = offsetof(drcuml_machine_state, v);
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.v); regnum++)
+	{
+		emit_movdqu_r128_m128(dst, REG_XMM0, MBD(REG_RCX, regoffs + 16 * regnum));
+		emit_movdqa_m128_r128(dst, MABS(&m_state.v[regnum]), REG_XMM0);
+	}
+
 	// copy fmod and exp
 	emit_movzx_r32_m8(dst, REG_EAX, MBD(REG_RCX, offsetof(drcuml_machine_state, fmod)));// movzx eax,state->fmod
 	emit_and_r32_imm(dst, REG_EAX, 3);                                                  // and   eax,3
@@ -6969,3 +7057,211 @@ void drcbe_x64::op_icopyf(x86code *&dst, const instruction &inst)
 }
 
 } // namespace drc
+
+
+
+/***************************************************************************
+    VECTOR OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_vload - process a VLOAD opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vload(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_V);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+
+	// determine the pointer base
+	int32_t baseoffs;
+	int basereg = get_base_register_and_offset(dst, basep.memory(), REG_RDX, baseoffs);
+
+	// the source may not be aligned, but vector registers always are
+	if (indp.is_immediate())
+		emit_movdqu_r128_m128(dst, REG_XMM0, MBD(basereg, baseoffs + 16*indp.immediate()));  // movdqu xmm0,[basep + 16*indp]
+	else
+	{
+		emit_mov_r32_p32(dst, REG_ECX, indp);                                               // mov    ecx,indp
+		emit_shl_r32_imm(dst, REG_ECX, 4);                                                  // shl    ecx,4
+		emit_movdqu_r128_m128(dst, REG_XMM0, MBISD(basereg, REG_ECX, 1, baseoffs));         // movdqu xmm0,[basep + 16*indp]
+	}
+	emit_movdqa_m128_r128(dst, MABS(dstp.memory()), REG_XMM0);                             // movdqa [dstp],xmm0
+}
+
+
+//-------------------------------------------------
+//  op_vstore - process a VSTORE opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vstore(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_V);
+
+	// determine the pointer base
+	int32_t baseoffs;
+	int basereg = get_base_register_and_offset(dst, basep.memory(), REG_RDX, baseoffs);
+
+	emit_movdqa_r128_m128(dst, REG_XMM0, MABS(srcp.memory()));                             // movdqa xmm0,[srcp]
+	if (indp.is_immediate())
+		emit_movdqu_m128_r128(dst, MBD(basereg, baseoffs + 16*indp.immediate()), REG_XMM0);  // movdqu [basep + 16*indp],xmm0
+	else
+	{
+		emit_mov_r32_p32(dst, REG_ECX, indp);                                               // mov    ecx,indp
+		emit_shl_r32_imm(dst, REG_ECX, 4);                                                  // shl    ecx,4
+		emit_movdqu_m128_r128(dst, MBISD(basereg, REG_ECX, 1, baseoffs), REG_XMM0);         // movdqu [basep + 16*indp],xmm0
+	}
+}
+
+
+//-------------------------------------------------
+//  op_vmov - process a VMOV opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vmov(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_V);
+	be_parameter srcp(*this, inst.param(1), PTYPE_V);
+
+	if (dstp != srcp)
+	{
+		emit_movdqa_r128_m128(dst, REG_XMM0, MABS(srcp.memory()));                         // movdqa xmm0,[srcp]
+		emit_movdqa_m128_r128(dst, MABS(dstp.memory()), REG_XMM0);                         // movdqa [dstp],xmm0
+	}
+}
+
+
+//-------------------------------------------------
+//  op_vbinary - process a lane-wise vector
+//  opcode with two sources
+//-------------------------------------------------
+
+void drcbe_x64::op_vbinary(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_V);
+	be_parameter src1p(*this, inst.param(1), PTYPE_V);
+	be_parameter src2p(*this, inst.param(2), PTYPE_V);
+
+	// pick the SSE2 instruction for the opcode and lane size
+	void (*emit_op)(x86code *&, uint8_t, x86_memref);
+	int const lane = (inst.size() == 1) ? 0 : (inst.size() == 2) ? 1 : (inst.size() == 4) ? 2 : 3;
+	switch (inst.opcode())
+	{
+		case OP_VAND:   emit_op = emit_pand_r128_m128;      break;
+		case OP_VOR:    emit_op = emit_por_r128_m128;       break;
+		case OP_VXOR:   emit_op = emit_pxor_r128_m128;      break;
+		case OP_VADD:   emit_op = (lane == 0) ? emit_paddb_r128_m128 : (lane == 1) ? emit_paddw_r128_m128 : (lane == 2) ? emit_paddd_r128_m128 : emit_paddq_r128_m128; break;
+		case OP_VSUB:   emit_op = (lane == 0) ? emit_psubb_r128_m128 : (lane == 1) ? emit_psubw_r128_m128 : (lane == 2) ? emit_psubd_r128_m128 : emit_psubq_r128_m128; break;
+		case OP_VADDS:  emit_op = (lane == 0) ? emit_paddsb_r128_m128 : emit_paddsw_r128_m128;     break;
+		case OP_VSUBS:  emit_op = (lane == 0) ? emit_psubsb_r128_m128 : emit_psubsw_r128_m128;     break;
+		case OP_VADDUS: emit_op = (lane == 0) ? emit_paddusb_r128_m128 : emit_paddusw_r128_m128;   break;
+		case OP_VSUBUS: emit_op = (lane == 0) ? emit_psubusb_r128_m128 : emit_psubusw_r128_m128;   break;
+		case OP_VMULL:  emit_op = emit_pmullw_r128_m128;    break;
+		case OP_VMULH:  emit_op = emit_pmulhw_r128_m128;    break;
+		case OP_VMULHU: emit_op = emit_pmulhuw_r128_m128;   break;
+		case OP_VCMPEQ: emit_op = (lane == 0) ? emit_pcmpeqb_r128_m128 : (lane == 1) ? emit_pcmpeqw_r128_m128 : emit_pcmpeqd_r128_m128; break;
+		case OP_VCMPGT: emit_op = (lane == 0) ? emit_pcmpgtb_r128_m128 : (lane == 1) ? emit_pcmpgtw_r128_m128 : emit_pcmpgtd_r128_m128; break;
+		case OP_VFADD:  emit_op = emit_addps_r128_m128;     break;
+		case OP_VFSUB:  emit_op = emit_subps_r128_m128;     break;
+		case OP_VFMUL:  emit_op = emit_mulps_r128_m128;     break;
+		default:        fatalerror("Unexpected vector opcode\n");
+	}
+
+	// vector registers are aligned, so the second source can be used directly
+	emit_movdqa_r128_m128(dst, REG_XMM0, MABS(src1p.memory()));                             // movdqa xmm0,[src1p]
+	(*emit_op)(dst, REG_XMM0, MABS(src2p.memory()));                                        // op     xmm0,[src2p]
+	emit_movdqa_m128_r128(dst, MABS(dstp.memory()), REG_XMM0);                             // movdqa [dstp],xmm0
+}
+
+
+//-------------------------------------------------
+//  op_vshuf - process a VSHUF opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vshuf(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 2);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_V);
+	be_parameter srcp(*this, inst.param(1), PTYPE_V);
+	be_parameter lanesp(*this, inst.param(2), PTYPE_I);
+
+	// decode the lane selectors and look for patterns SSE2 can shuffle directly
+	uint8_t select[8];
+	bool splat = true, halves = true;
+	for (int lane = 0; lane < 8; lane++)
+	{
+		select[lane] = (lanesp.immediate() >> (4 * lane)) & 7;
+		splat = splat && (select[lane] == select[0]);
+		halves = halves && ((select[lane] < 4) == (lane < 4));
+	}
+
+	// a single lane copied to all of them
+	if (splat)
+	{
+		emit_movdqa_r128_m128(dst, REG_XMM0, MABS(srcp.memory()));                         // movdqa  xmm0,[srcp]
+		if (select[0] < 4)
+		{
+			emit_pshuflw_r128_r128_imm(dst, REG_XMM0, REG_XMM0, select[0] * 0x55);           // pshuflw xmm0,xmm0,select
+			emit_pshufd_r128_r128_imm(dst, REG_XMM0, REG_XMM0, 0x00);                       // pshufd  xmm0,xmm0,0x00
+		}
+		else
+		{
+			emit_pshufhw_r128_r128_imm(dst, REG_XMM0, REG_XMM0, (select[0] - 4) * 0x55);     // pshufhw xmm0,xmm0,select
+			emit_pshufd_r128_r128_imm(dst, REG_XMM0, REG_XMM0, 0xaa);                       // pshufd  xmm0,xmm0,0xaa
+		}
+	}
+
+	// each half of the register shuffled within itself
+	else if (halves)
+	{
+		uint8_t const lo = select[0] | (select[1] << 2) | (select[2] << 4) | (select[3] << 6);
+		uint8_t const hi = (select[4] - 4) | ((select[5] - 4) << 2) | ((select[6] - 4) << 4) | ((select[7] - 4) << 6);
+		emit_movdqa_r128_m128(dst, REG_XMM0, MABS(srcp.memory()));                         // movdqa  xmm0,[srcp]
+		if (lo != 0xe4)
+			emit_pshuflw_r128_r128_imm(dst, REG_XMM0, REG_XMM0, lo);                        // pshuflw xmm0,xmm0,lo
+		if (hi != 0xe4)
+			emit_pshufhw_r128_r128_imm(dst, REG_XMM0, REG_XMM0, hi);                        // pshufhw xmm0,xmm0,hi
+	}
+
+	// anything else is assembled one lane at a time
+	else
+	{
+		for (int lane = 0; lane < 8; lane++)
+		{
+			emit_movzx_r32_m16(dst, REG_EAX, MABS((uint16_t *)srcp.memory() + select[lane]));  // movzx   eax,[srcp + 2*select]
+			emit_pinsrw_r128_r32_imm(dst, REG_XMM0, REG_EAX, lane);                         // pinsrw  xmm0,eax,lane
+		}
+	}
+	emit_movdqa_m128_r128(dst, MABS(dstp.memory()), REG_XMM0);                             // movdqa  [dstp],xmm0
+}
@@ -120,6 +120,8 @@ private:
 	int get_base_register_and_offset(x86code *&dst, void *target, uint8_t reg, int32_t &offset);
 	void emit_smart_call_r64(x86code *&dst, x86code *target, uint8_t reg);
 	void emit_smart_call_m64(x86code *&dst, x86code **target);
+	void emit_save_volatile_iregs(x86code *&dst);
+	void emit_restore_volatile_iregs(x86code *&dst);
 
 	void fixup_label(void *parameter, drccodeptr labelcodeptr);
 	void fixup_exception(drccodeptr *codeptr, void *param1, void *param2);
@@ -211,6 +213,12 @@ private:
 	void op_fcopyi(x86code *&dst, const uml::instruction &inst);
 	void op_icopyf(x86code *&dst, const uml::instruction &inst);
 
+	void op_vload(x86code *&dst, const uml::instruction &inst);
+	void op_vstore(x86code *&dst, const uml::instruction &inst);
+	void op_vmov(x86code *&dst, const uml::instruction &inst);
+	void op_vbinary(x86code *&dst, const uml::instruction &inst);
+	void op_vshuf(x86code *&dst, const uml::instruction &inst);
+
 	// 32-bit code emission helpers
 	void emit_mov_r32_p32(x86code *&dst, uint8_t reg, const be_parameter &param);
 	void emit_movsx_r64_p32(x86code *&dst, uint8_t reg, const be_parameter &param);
@@ -119,6 +119,7 @@ const uint32_t PTYPE_M    = 1 << parameter::PTYPE_MEMORY;
 const uint32_t PTYPE_I    = 1 << parameter::PTYPE_IMMEDIATE;
 const uint32_t PTYPE_R    = 1 << parameter::PTYPE_INT_REGISTER;
 const uint32_t PTYPE_F    = 1 << parameter::PTYPE_FLOAT_REGISTER;
+const uint32_t PTYPE_V    = 1 << parameter::PTYPE_VECTOR_REGISTER;
 //const uint32_t PTYPE_MI   = PTYPE_M | PTYPE_I;
 //const uint32_t PTYPE_RI   = PTYPE_R | PTYPE_I;
 const uint32_t PTYPE_MR   = PTYPE_M | PTYPE_R;
@@ -285,6 +286,29 @@ const drcbe_x86::opcode_table_entry drcbe_x86::s_opcode_table_source[] =
 	{ uml::OP_FRSQRT,  &drcbe_x86::op_frsqrt },     // FRSQRT  dst,src1
 	{ uml::OP_FCOPYI,  &drcbe_x86::op_fcopyi },     // FCOPYI  dst,src
 	{ uml::OP_ICOPYF,  &drcbe_x86::op_icopyf },     // ICOPYF  dst,src
+
+	// Vector Operations
+	{ uml::OP_VLOAD,   &drcbe_x86::op_vload },      // VLOAD   dst,base,index
+	{ uml::OP_VSTORE,  &drcbe_x86::op_vstore },     // VSTORE  base,index,src
+	{ uml::OP_VMOV,    &drcbe_x86::op_vmov },       // VMOV    dst,src
+	{ uml::OP_VAND,    &drcbe_x86::op_vbinary },    // VAND    dst,src1,src2
+	{ uml::OP_VOR,     &drcbe_x86::op_vbinary },    // VOR     dst,src1,src2
+	{ uml::OP_VXOR,    &drcbe_x86::op_vbinary },    // VXOR    dst,src1,src2
+	{ uml::OP_VADD,    &drcbe_x86::op_vbinary },    // VADD    dst,src1,src2
+	{ uml::OP_VSUB,    &drcbe_x86::op_vbinary },    // VSUB    dst,src1,src2
+	{ uml::OP_VADDS,   &drcbe_x86::op_vbinary },    // VADDS   dst,src1,src2
+	{ uml::OP_VSUBS,   &drcbe_x86::op_vbinary },    // VSUBS   dst,src1,src2
+	{ uml::OP_VADDUS,  &drcbe_x86::op_vbinary },    // VADDUS  dst,src1,src2
+	{ uml::OP_VSUBUS,  &drcbe_x86::op_vbinary },    // VSUBUS  dst,src1,src2
+	{ uml::OP_VMULL,   &drcbe_x86::op_vbinary },    // VMULL   dst,src1,src2
+	{ uml::OP_VMULH,   &drcbe_x86::op_vbinary },    // VMULH   dst,src1,src2
+	{ uml::OP_VMULHU,  &drcbe_x86::op_vbinary },    // VMULHU  dst,src1,src2
+	{ uml::OP_VCMPEQ,  &drcbe_x86::op_vbinary },    // VCMPEQ  dst,src1,src2
+	{ uml::OP_VCMPGT,  &drcbe_x86::op_vbinary },    // VCMPGT  dst,src1,src2
+	{ uml::OP_VFADD,   &drcbe_x86::op_vbinary },    // VFADD   dst,src1,src2
+	{ uml::OP_VFSUB,   &drcbe_x86::op_vbinary },    // VFSUB   dst,src1,src2
+	{ uml::OP_VFMUL,   &drcbe_x86::op_vbinary },    // VFMUL   dst,src1,src2
+	{ uml::OP_VSHUF,   &drcbe_x86::op_vbinary },    // VSHUF   dst,src,lanes
 };
 
 
@@ -334,6 +358,12 @@ drcbe_x86::be_parameter::be_parameter(drcbe_x86 &drcbe, const parameter &param,
 			*this = make_memory(&drcbe.m_state.f[param.freg() - REG_F0]);
 			break;
 
+		// vector registers always live in memory
+		case parameter::PTYPE_VECTOR_REGISTER:
+			assert(allowed & PTYPE_V);
+			*this = make_memory(&drcbe.m_state.v[param.vreg() - REG_V0]);
+			break;
+
 		// everything else is unexpected
 		default:
 			fatalerror("Unexpected parameter type\n");
@@ -698,6 +728,15 @@ void drcbe_x86::reset()
 		emit_mov_r32_m32(dst, REG_EAX, MABS(&m_state.f[regnum].s.h));
 		emit_mov_m32_r32(dst, MBD(REG_ECX, regoffsh), REG_EAX);
 	}
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.v); regnum++)
+	{
+		uintptr_t regoffs = (uintptr_t)&((drcuml_machine_state *)nullptr)->v[regnum];
+		for (int word = 0; word < 4; word++)
+		{
+			emit_mov_r32_m32(dst, REG_EAX, MABS(&m_state.v[regnum].w[word]));
+			emit_mov_m32_r32(dst, MBD(REG_ECX, regoffs + 4 * word), REG_EAX);
+		}
+	}
 	emit_ret(dst);                                                                      // ret
 	if (m_log != nullptr && !m_logged_common)
 		x86log_disasm_code_range(m_log, "save", m_save, dst);
@@ -727,6 +766,15 @@ void drcbe_x86::reset()
 		emit_mov_r32_m32(dst, REG_EAX, MBD(REG_ECX, regoffsh));
 		emit_mov_m32_r32(dst, MABS(&m_state.f[regnum].s.h), REG_EAX);
 	}
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.v); regnum++)
+	{
+		uintptr_t regoffs = (uintptr_t)&((drcuml_machine_state *)nullptr)->v[regnum];
+		for (int word = 0; word < 4; word++)
+		{
+			emit_mov_r32_m32(dst, REG_EAX, MBD(REG_ECX, regoffs + 4 * word));
+			emit_mov_m32_r32(dst, MABS(&m_state.v[regnum].w[word]), REG_EAX);
+		}
+	}
 	emit_movzx_r32_m8(dst, REG_EAX, MBD(REG_ECX, offsetof(drcuml_machine_state, fmod)));// movzx eax,state->fmod
 	emit_and_r32_imm(dst, REG_EAX, 3);                                                  // and    eax,3
 	emit_mov_m8_r8(dst, MABS(&m_state.fmod), REG_AL);                               // mov    [fmod],al
@@ -784,7 +832,7 @@ void drcbe_x86::generate(drcuml_block &block, const instruction *instlist, uint3
 	x86code *dst = base;
 
 	// generate code
-	const char *blockname = nullptr;
+	std::string blockname;
 	for (int inum = 0; inum < numinst; inum++)
 	{
 		const instruction &inst = instlist[inum];
@@ -798,12 +846,12 @@ void drcbe_x86::generate(drcuml_block &block, const instruction *instlist, uint3
 		}
 
 		// extract a blockname
-		if (blockname == nullptr)
+		if (blockname.empty())
 		{
 			if (inst.opcode() == OP_HANDLE)
 				blockname = inst.param(0).handle().string();
 			else if (inst.opcode() == OP_HASH)
-				blockname = string_format("Code: mode=%d PC=%08X", (uint32_t)inst.param(0).immediate(), (offs_t)inst.param(1).immediate()).c_str();
+				blockname = string_format("Code: mode=%d PC=%08X", (uint32_t)inst.param(0).immediate(), (offs_t)inst.param(1).immediate());
 		}
 
 		// generate code
@@ -816,7 +864,10 @@ void drcbe_x86::generate(drcuml_block &block, const instruction *instlist, uint3
 
 	// log it
 	if (m_log != nullptr)
-		x86log_disasm_code_range(m_log, (blockname == nullptr) ? "Unknown block" : blockname, base, m_cache.top());
+		x86log_disasm_code_range(m_log, blockname.empty() ? "Unknown block" : blockname.c_str(), base, m_cache.top());
+
+	// name it for profilers
+	m_drcuml.perf_map_add(base, m_cache.top(), blockname.empty() ? "Unknown block" : blockname.c_str());
 
 	// tell all of our utility objects that the block is finished
 	m_hash.block_end(block);
@@ -6610,6 +6661,128 @@ void drcbe_x86::op_icopyf(x86code *&dst, const instruction &inst)
 
 
 
+
+//**************************************************************************
+//  VECTOR OPERATIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  op_vload - process a VLOAD opcode
+//-------------------------------------------------
+
+void drcbe_x86::op_vload(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_V);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+
+	// no SSE here, so copy a word at a time
+	if (!indp.is_immediate())
+	{
+		emit_mov_r32_p32(dst, REG_ECX, indp);                                           // mov   ecx,indp
+		emit_shl_r32_imm(dst, REG_ECX, 4);                                              // shl   ecx,4
+	}
+	for (int word = 0; word < 4; word++)
+	{
+		if (indp.is_immediate())
+			emit_mov_r32_m32(dst, REG_EAX, MABS(basep.memory(16*indp.immediate() + 4*word)));   // mov   eax,[basep + 16*indp + 4*word]
+		else
+			emit_mov_r32_m32(dst, REG_EAX, MABSI(basep.memory(4*word), REG_ECX, 1));          // mov   eax,[basep + ecx + 4*word]
+		emit_mov_m32_r32(dst, MABS(dstp.memory(4*word)), REG_EAX);                      // mov   [dstp + 4*word],eax
+	}
+}
+
+
+//-------------------------------------------------
+//  op_vstore - process a VSTORE opcode
+//-------------------------------------------------
+
+void drcbe_x86::op_vstore(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_V);
+
+	// no SSE here, so copy a word at a time
+	if (!indp.is_immediate())
+	{
+		emit_mov_r32_p32(dst, REG_ECX, indp);                                           // mov   ecx,indp
+		emit_shl_r32_imm(dst, REG_ECX, 4);                                              // shl   ecx,4
+	}
+	for (int word = 0; word < 4; word++)
+	{
+		emit_mov_r32_m32(dst, REG_EAX, MABS(srcp.memory(4*word)));                      // mov   eax,[srcp + 4*word]
+		if (indp.is_immediate())
+			emit_mov_m32_r32(dst, MABS(basep.memory(16*indp.immediate() + 4*word)), REG_EAX);   // mov   [basep + 16*indp + 4*word],eax
+		else
+			emit_mov_m32_r32(dst, MABSI(basep.memory(4*word), REG_ECX, 1), REG_EAX);          // mov   [basep + ecx + 4*word],eax
+	}
+}
+
+
+//-------------------------------------------------
+//  op_vmov - process a VMOV opcode
+//-------------------------------------------------
+
+void drcbe_x86::op_vmov(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_V);
+	be_parameter srcp(*this, inst.param(1), PTYPE_V);
+
+	if (dstp != srcp)
+		for (int word = 0; word < 4; word++)
+		{
+			emit_mov_r32_m32(dst, REG_EAX, MABS(srcp.memory(4*word)));                  // mov   eax,[srcp + 4*word]
+			emit_mov_m32_r32(dst, MABS(dstp.memory(4*word)), REG_EAX);                  // mov   [dstp + 4*word],eax
+		}
+}
+
+
+//-------------------------------------------------
+//  op_vbinary - process the remaining vector
+//  opcodes with a call to the portable helper
+//-------------------------------------------------
+
+void drcbe_x86::op_vbinary(x86code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters; VSHUF takes a lane pattern in place of the second source
+	bool const shuffle = (inst.opcode() == OP_VSHUF);
+	be_parameter dstp(*this, inst.param(0), PTYPE_V);
+	be_parameter src1p(*this, inst.param(1), PTYPE_V);
+	be_parameter src2p(*this, inst.param(shuffle ? 1 : 2), PTYPE_V);
+
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 20), shuffle ? inst.param(2).immediate() : 0);   // mov   [esp+20],lanes
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 16), (uintptr_t)src2p.memory());                 // mov   [esp+16],src2p
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 12), (uintptr_t)src1p.memory());                 // mov   [esp+12],src1p
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 8), (uintptr_t)dstp.memory());                   // mov   [esp+8],dstp
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 4), inst.size());                                // mov   [esp+4],size
+	emit_mov_m32_imm(dst, MBD(REG_ESP, 0), inst.opcode());                              // mov   [esp],opcode
+	emit_call(dst, (x86code *)&drc_vector_execute);                                     // call  drc_vector_execute
+}
+
+
 //**************************************************************************
 //  MISCELLAENOUS FUNCTIONS
 //**************************************************************************
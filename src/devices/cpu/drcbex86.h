@@ -213,6 +213,11 @@ private:
 	void op_fcopyi(x86code *&dst, const uml::instruction &inst);
 	void op_icopyf(x86code *&dst, const uml::instruction &inst);
 
+	void op_vload(x86code *&dst, const uml::instruction &inst);
+	void op_vstore(x86code *&dst, const uml::instruction &inst);
+	void op_vmov(x86code *&dst, const uml::instruction &inst);
+	void op_vbinary(x86code *&dst, const uml::instruction &inst);
+
 	// 32-bit code emission helpers
 	void emit_mov_r32_p32(x86code *&dst, uint8_t reg, const be_parameter &param);
 	void emit_mov_r32_p32_keepflags(x86code *&dst, uint8_t reg, const be_parameter &param);
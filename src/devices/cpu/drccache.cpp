@@ -38,10 +38,23 @@ drc_cache::drc_cache(size_t bytes)
 		m_top(m_base),
 		m_end(m_near + bytes),
 		m_codegen(nullptr),
-		m_size(bytes)
+		m_size(bytes),
+		m_current(0),
+		m_flushes(0),
+		m_evictions(0),
+		m_evicted_bytes(0)
 {
 	memset(m_free, 0, sizeof(m_free));
 	memset(m_nearfree, 0, sizeof(m_nearfree));
+
+	// carve the code area into regions; the last one also loses whatever permanent allocations take
+	size_t const regionsize = ((m_end - m_base) / REGION_COUNT) & ~(CACHE_ALIGNMENT - 1);
+	for (int index = 0; index < REGION_COUNT; index++)
+	{
+		m_region[index].m_base = m_base + index * regionsize;
+		m_region[index].m_top = m_region[index].m_base;
+		m_region[index].m_pinned = false;
+	}
 }
 
 
@@ -66,11 +79,133 @@ void drc_cache::flush()
 	// can't flush in the middle of codegen
 	assert(m_codegen == nullptr);
 
-	// just reset the top back to the base and re-seed
+	if (code_used() != 0)
+		m_flushes++;
+
+	// just reset every region back to empty and start again from the base
+	for (region &curregion : m_region)
+	{
+		curregion.m_top = curregion.m_base;
+		curregion.m_pinned = false;
+	}
+	m_current = 0;
 	m_top = m_base;
 }
 
 
+//-------------------------------------------------
+//  region_top - return the top of allocated
+//  space in the region containing a pointer
+//-------------------------------------------------
+
+drccodeptr drc_cache::region_top(const void *ptr) const
+{
+	return region_fill(region_index(ptr));
+}
+
+
+//-------------------------------------------------
+//  code_used - return the number of bytes of the
+//  code area holding live allocations
+//-------------------------------------------------
+
+size_t drc_cache::code_used() const
+{
+	size_t result = 0;
+	for (int index = 0; index < REGION_COUNT; index++)
+		result += region_fill(index) - m_region[index].m_base;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  pin - prevent the region containing a pointer
+//  from being evicted until the next flush
+//-------------------------------------------------
+
+void drc_cache::pin(const void *ptr)
+{
+	assert(static_cast<const uint8_t *>(ptr) >= m_base && static_cast<const uint8_t *>(ptr) < m_end);
+	m_region[region_index(ptr)].m_pinned = true;
+}
+
+
+//-------------------------------------------------
+//  add_evict_notifier - register a callback to be
+//  told when a range of code is evicted
+//-------------------------------------------------
+
+void drc_cache::add_evict_notifier(void *owner, drc_evict_delegate callback)
+{
+	m_notifiers.emplace_back(evict_notifier{ owner, callback });
+}
+
+
+//-------------------------------------------------
+//  remove_evict_notifier - remove any callbacks
+//  registered for an owner
+//-------------------------------------------------
+
+void drc_cache::remove_evict_notifier(void *owner)
+{
+	m_notifiers.erase(
+			std::remove_if(m_notifiers.begin(), m_notifiers.end(), [owner] (evict_notifier const &notifier) { return notifier.m_owner == owner; }),
+			m_notifiers.end());
+}
+
+
+//-------------------------------------------------
+//  region_index - return the index of the region
+//  containing a pointer
+//-------------------------------------------------
+
+int drc_cache::region_index(const void *ptr) const
+{
+	int index = REGION_COUNT - 1;
+	while ((index > 0) && (static_cast<const uint8_t *>(ptr) < m_region[index].m_base))
+		index--;
+	return index;
+}
+
+
+//-------------------------------------------------
+//  next_region - move allocation to the oldest
+//  region that can be evicted and has room for
+//  the given number of bytes
+//-------------------------------------------------
+
+bool drc_cache::next_region(size_t bytes)
+{
+	assert(m_codegen == nullptr);
+
+	for (int step = 1; step < REGION_COUNT; step++)
+	{
+		int const index = (m_current + step) % REGION_COUNT;
+		region &target = m_region[index];
+		if (target.m_pinned || ((target.m_base + bytes) >= region_end(index)))
+			continue;
+
+		// retire the current region and take over the target
+		m_region[m_current].m_top = m_top;
+		drccodeptr const evictend = target.m_top;
+		m_current = index;
+		m_top = target.m_base;
+
+		// tell everyone what went away
+		if (evictend > target.m_base)
+		{
+			for (evict_notifier &notifier : m_notifiers)
+				notifier.m_callback(target.m_base, evictend);
+			m_evictions++;
+			m_evicted_bytes += evictend - target.m_base;
+		}
+		target.m_top = target.m_base;
+		return true;
+	}
+	return false;
+}
+
+
 //-------------------------------------------------
 //  alloc - allocate permanent memory from the
 //  cache
@@ -94,7 +229,7 @@ void *drc_cache::alloc(size_t bytes)
 
 	// if no space, we just fail
 	drccodeptr ptr = (drccodeptr)ALIGN_PTR_DOWN(m_end - bytes);
-	if (m_top > ptr)
+	if (region_fill(REGION_COUNT - 1) > ptr)
 		return nullptr;
 
 	// otherwise update the end of the cache
@@ -140,18 +275,20 @@ void *drc_cache::alloc_near(size_t bytes)
 //  from the cache
 //-------------------------------------------------
 
-void *drc_cache::alloc_temporary(size_t bytes)
+void *drc_cache::alloc_temporary(size_t bytes, bool pin)
 {
 	// can't allocate in the middle of codegen
 	assert(m_codegen == nullptr);
 
-	// if no space, we just fail
-	drccodeptr ptr = m_top;
-	if (ptr + bytes >= m_end)
+	// if no space here or in any region we can evict, we just fail
+	if (((m_top + bytes) >= region_end(m_current)) && !next_region(bytes))
 		return nullptr;
 
 	// otherwise, update the cache top
+	drccodeptr ptr = m_top;
 	m_top = (drccodeptr)ALIGN_PTR_UP(ptr + bytes);
+	if (pin)
+		m_region[m_current].m_pinned = true;
 	return ptr;
 }
 
@@ -184,15 +321,14 @@ void drc_cache::dealloc(void *memory, size_t bytes)
 //  begin_codegen - begin code generation
 //-------------------------------------------------
 
-drccodeptr *drc_cache::begin_codegen(uint32_t reserve_bytes)
+drccodeptr *drc_cache::begin_codegen(uint32_t reserve_bytes, bool allow_evict)
 {
 	// can't restart in the middle of codegen
 	assert(m_codegen == nullptr);
 	assert(m_ooblist.first() == nullptr);
 
-	// if still no space, we just fail
-	drccodeptr ptr = m_top;
-	if (ptr + reserve_bytes >= m_end)
+	// if no space here, move on to the next region if allowed; if still no space, we just fail
+	if (((m_top + reserve_bytes) >= region_end(m_current)) && (!allow_evict || !next_region(reserve_bytes)))
 		return nullptr;
 
 	// otherwise, return a pointer to the cache top
@@ -6,6 +6,19 @@
 
     Universal dynamic recompiler cache management.
 
+    The cache only lives for the current session.  Generated code holds
+    absolute host addresses (CPU state allocated near the cache, code
+    handles, C helper functions and memory accessors), none of which are
+    stable from one run to the next, so blocks cannot be saved to disk
+    and reloaded without a relocation scheme covering every backend.
+
+    The code area is split into a ring of regions.  When the current
+    region fills up, allocation moves on to the oldest region that
+    doesn't hold anything pinned (static code, code handles or hash
+    tables), and anything compiled there is evicted; interested parties
+    are told which range went away so they can drop references to it.
+    A full flush is only needed once every other region is pinned.
+
 ***************************************************************************/
 
 #pragma once
@@ -36,6 +49,9 @@ typedef uint8_t *drccodeptr;
 // helper template for oob codegen
 typedef delegate<void (drccodeptr *, void *, void *)> drc_oob_delegate;
 
+// called with the range of code being evicted
+typedef delegate<void (drccodeptr, drccodeptr)> drc_evict_delegate;
+
 
 // drc_cache
 class drc_cache
@@ -54,16 +70,29 @@ public:
 	bool contains_pointer(const void *ptr) const { return ((const drccodeptr)ptr >= m_near && (const drccodeptr)ptr < m_near + m_size); }
 	bool contains_near_pointer(const void *ptr) const { return ((const drccodeptr)ptr >= m_near && (const drccodeptr)ptr < m_neartop); }
 	bool generating_code() const { return (m_codegen != nullptr); }
+	drccodeptr region_top(const void *ptr) const;
+
+	// statistics
+	size_t code_size() const { return m_end - m_base; }
+	size_t code_used() const;
+	uint32_t flushes() const { return m_flushes; }
+	uint32_t evictions() const { return m_evictions; }
+	uint64_t evicted_bytes() const { return m_evicted_bytes; }
 
 	// memory management
 	void flush();
 	void *alloc(size_t bytes);
 	void *alloc_near(size_t bytes);
-	void *alloc_temporary(size_t bytes);
+	void *alloc_temporary(size_t bytes, bool pin = false);
 	void dealloc(void *memory, size_t bytes);
+	void pin(const void *ptr);
+
+	// eviction notification
+	void add_evict_notifier(void *owner, drc_evict_delegate callback);
+	void remove_evict_notifier(void *owner);
 
 	// codegen helpers
-	drccodeptr *begin_codegen(uint32_t reserve_bytes);
+	drccodeptr *begin_codegen(uint32_t reserve_bytes, bool allow_evict = true);
 	drccodeptr end_codegen();
 	void request_oob_codegen(drc_oob_delegate callback, void *param1 = nullptr, void *param2 = nullptr);
 
@@ -71,8 +100,9 @@ private:
 	// largest block of code that can be generated at once
 	static const size_t CODEGEN_MAX_BYTES = 131072;
 
-	// minimum alignment, in bytes (must be power of 2)
-	static const size_t CACHE_ALIGNMENT = alignof(std::max_align_t);
+	// minimum alignment, in bytes (must be power of 2); at least 16 so vector
+	// registers in near state can be moved with aligned SSE loads and stores
+	static const size_t CACHE_ALIGNMENT = (alignof(std::max_align_t) > 16) ? alignof(std::max_align_t) : 16;
 
 	// largest permanent allocation we allow
 	static const size_t MAX_PERMANENT_ALLOC = 1024;
@@ -80,6 +110,15 @@ private:
 	// size of "near" area at the base of the cache
 	static const size_t NEAR_CACHE_SIZE = 131072;
 
+	// number of regions the code area is split into
+	static const int REGION_COUNT = 8;
+
+	// region management
+	int region_index(const void *ptr) const;
+	drccodeptr region_end(int index) const { return (index == (REGION_COUNT - 1)) ? m_end : m_region[index + 1].m_base; }
+	drccodeptr region_fill(int index) const { return (index == m_current) ? m_top : m_region[index].m_top; }
+	bool next_region(size_t bytes);
+
 	// core parameters
 	drccodeptr          m_near;             // pointer to the near part of the cache
 	drccodeptr          m_neartop;          // top of the near part of the cache
@@ -89,6 +128,29 @@ private:
 	drccodeptr          m_codegen;          // start of generated code
 	size_t              m_size;             // size of the cache in bytes
 
+	// code regions
+	struct region
+	{
+		drccodeptr      m_base;             // start of the region
+		drccodeptr      m_top;              // top of allocated space, if not current
+		bool            m_pinned;           // holds something that can't be evicted
+	};
+	region              m_region[REGION_COUNT]; // the regions, in address order
+	int                 m_current;          // region m_top is allocating from
+
+	// eviction notifiers
+	struct evict_notifier
+	{
+		void *              m_owner;        // who to remove it for
+		drc_evict_delegate  m_callback;     // callback function
+	};
+	std::vector<evict_notifier> m_notifiers; // list of eviction notifiers
+
+	// statistics
+	uint32_t            m_flushes;          // number of full flushes
+	uint32_t            m_evictions;        // number of regions evicted
+	uint64_t            m_evicted_bytes;    // total bytes of code evicted
+
 	// oob management
 	struct oob_handler
 	{
@@ -17,6 +17,7 @@
 
 #include "emu.h"
 #include "drcfe.h"
+#include "drccache.h"
 
 
 namespace {
@@ -26,6 +27,7 @@ namespace {
 //**************************************************************************
 
 constexpr u32 MAX_STACK_DEPTH = 100;
+constexpr u32 MAX_TRACE_WINDOWS = 4;
 
 
 
@@ -60,7 +62,10 @@ drc_frontend::drc_frontend(device_t &cpu, u32 window_start, u32 window_end, u32
 	, m_program(m_cpudevice.space(AS_PROGRAM))
 	, m_pageshift(m_cpudevice.space_config(AS_PROGRAM)->page_shift())
 	, m_desc_array(window_end + window_start + 2, nullptr)
+	, m_cache(nullptr)
+	, m_trace_threshold(0)
 {
+	m_windows.reserve(MAX_TRACE_WINDOWS);
 }
 
 
@@ -86,21 +91,114 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 	// release any descriptions we've accumulated
 	release_descriptions();
 
+	// describe the primary window around the start PC
+	u32 const windowsize = m_window_start + m_window_end + 2;
+	std::vector<offs_t> hotexits;
+	m_windows.clear();
+	m_windows.push_back(code_window{
+			startpc,
+			startpc - (std::min)(m_window_start, startpc),
+			startpc + (std::min)(m_window_end, 0xffffffff - startpc),
+			&m_desc_array[0] });
+	describe_window(m_windows.back(), hotexits);
+
+	// then add a forward window for each hot exit until we run out of room
+	for (size_t exitnum = 0; (exitnum < hotexits.size()) && (m_windows.size() < MAX_TRACE_WINDOWS); exitnum++)
+	{
+		offs_t const targetpc = hotexits[exitnum];
+		if (find_description(targetpc) != nullptr)
+			continue;
+		m_windows.push_back(code_window{
+				targetpc,
+				targetpc,
+				targetpc + (std::min)(m_window_end, 0xffffffff - targetpc),
+				&m_desc_array[m_windows.size() * windowsize] });
+		describe_window(m_windows.back(), hotexits);
+	}
+	if (m_windows.size() > 1)
+		link_windows();
+
+	// now build the list of descriptions in order
+	// first from startpc -> maxpc, then from minpc -> startpc
+	code_window const &primary = m_windows[0];
+	build_sequence(startpc - primary.minpc, primary.maxpc - primary.minpc, OPFLAG_REDISPATCH);
+	build_sequence(0, startpc - primary.minpc, OPFLAG_RETURN_TO_START);
+
+	// followed by any trace windows, which have nothing before their start
+	for (size_t windownum = 1; windownum < m_windows.size(); windownum++)
+	{
+		int const base = windownum * windowsize;
+		build_sequence(base, base + (m_windows[windownum].maxpc - m_windows[windownum].minpc), OPFLAG_REDISPATCH);
+	}
+	return m_desc_live_list.first();
+}
+
+
+//-------------------------------------------------
+//  enable_traces - start counting static exits,
+//  and extend descriptions through exits that
+//  have been taken at least threshold times
+//-------------------------------------------------
+
+void drc_frontend::enable_traces(drc_cache &cache, u32 threshold)
+{
+	m_cache = &cache;
+	m_trace_threshold = threshold;
+	m_desc_array.resize((m_window_start + m_window_end + 2) * MAX_TRACE_WINDOWS, nullptr);
+}
+
+
+//-------------------------------------------------
+//  exit_counter - return the counter a backend
+//  should increment when branching to targetpc
+//  through the hash table, or nullptr if traces
+//  are disabled or there's no room for one
+//-------------------------------------------------
+
+u32 *drc_frontend::exit_counter(offs_t targetpc)
+{
+	if (m_trace_threshold == 0)
+		return nullptr;
+
+	auto const found = m_exit_counters.find(targetpc);
+	if (found != m_exit_counters.end())
+		return found->second;
+
+	// counters are permanent so they survive cache flushes
+	u32 *const counter = reinterpret_cast<u32 *>(m_cache->alloc_near(sizeof(u32)));
+	if (counter != nullptr)
+	{
+		*counter = 0;
+		m_exit_counters.emplace(targetpc, counter);
+	}
+	return counter;
+}
+
+
+//-------------------------------------------------
+//  describe_window - walk the code reachable
+//  from the start of a window without leaving it,
+//  noting any hot static exits
+//-------------------------------------------------
+
+void drc_frontend::describe_window(code_window &window, std::vector<offs_t> &hotexits)
+{
 	// add the initial PC to the stack
 	pc_stack_entry pcstack[MAX_STACK_DEPTH];
 	pc_stack_entry *pcstackptr = &pcstack[0];
 	pcstackptr->srcpc = 0;
-	pcstackptr->targetpc = startpc;
+	pcstackptr->targetpc = window.startpc;
 	pcstackptr++;
 
 	// loop while we still have a stack
-	offs_t const minpc = startpc - (std::min)(m_window_start, startpc);
-	offs_t const maxpc = startpc + (std::min)(m_window_end, 0xffffffff - startpc);
+	offs_t const minpc = window.minpc;
+	offs_t const maxpc = window.maxpc;
+	opcode_desc **const descs = window.descs;
 	while (pcstackptr != &pcstack[0])
 	{
 		// if we've already hit this PC, just mark it a branch target and continue
 		pc_stack_entry *const curstack = --pcstackptr;
-		opcode_desc *curdesc = m_desc_array[curstack->targetpc - minpc];
+		opcode_desc *curdesc = find_description(curstack->targetpc);
 		if (curdesc != nullptr)
 		{
 			curdesc->flags |= OPFLAG_IS_BRANCH_TARGET;
@@ -113,11 +211,11 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 			continue;
 		}
 
-		// loop until we exit the block
-		for (offs_t curpc = curstack->targetpc; curpc >= minpc && curpc < maxpc && m_desc_array[curpc - minpc] == nullptr; curpc += m_desc_array[curpc - minpc]->length)
+		// loop until we exit the block, or reach code another window already described
+		for (offs_t curpc = curstack->targetpc; curpc >= minpc && curpc < maxpc && find_description(curpc) == nullptr; curpc += descs[curpc - minpc]->length)
 		{
 			// allocate a new description and describe this instruction
-			m_desc_array[curpc - minpc] = curdesc = describe_one(curpc, curdesc);
+			descs[curpc - minpc] = curdesc = describe_one(curpc, curdesc);
 
 			// first instruction in a sequence is always a branch target
 			if (curpc == curstack->targetpc)
@@ -128,7 +226,7 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 				break;
 
 			// if we are the first instruction in the whole window, we must validate the TLB
-			if (curpc == startpc && m_pageshift != 0)
+			if (curpc == window.startpc && m_pageshift != 0)
 				curdesc->flags |= OPFLAG_VALIDATE_TLB | OPFLAG_CAN_CAUSE_EXCEPTION;
 
 			// if we are a branch within the block range, add the branch target to our stack
@@ -140,17 +238,59 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 				pcstackptr++;
 			}
 
+			// otherwise, remember it if it's a hot exit we could follow
+			else if ((curdesc->flags & OPFLAG_IS_BRANCH) && curdesc->targetpc != BRANCH_TARGET_DYNAMIC && m_trace_threshold != 0)
+			{
+				auto const found = m_exit_counters.find(curdesc->targetpc);
+				if (found != m_exit_counters.end() && *found->second >= m_trace_threshold)
+					hotexits.push_back(curdesc->targetpc);
+			}
+
 			// if we're done, we're done
 			if (curdesc->flags & OPFLAG_END_SEQUENCE)
 				break;
 		}
 	}
+}
 
-	// now build the list of descriptions in order
-	// first from startpc -> maxpc, then from minpc -> startpc
-	build_sequence(startpc - minpc, maxpc - minpc, OPFLAG_REDISPATCH);
-	build_sequence(minpc - minpc, startpc - minpc, OPFLAG_RETURN_TO_START);
-	return m_desc_live_list.first();
+
+//-------------------------------------------------
+//  find_description - find the description of
+//  the instruction at a PC in any window
+//-------------------------------------------------
+
+opcode_desc *drc_frontend::find_description(offs_t pc) const
+{
+	for (code_window const &window : m_windows)
+		if (pc >= window.minpc && pc < window.maxpc && window.descs[pc - window.minpc] != nullptr)
+			return window.descs[pc - window.minpc];
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  link_windows - turn static branches between
+//  windows into intrablock branches
+//-------------------------------------------------
+
+void drc_frontend::link_windows()
+{
+	for (code_window const &window : m_windows)
+		for (offs_t offset = 0; offset < window.maxpc - window.minpc; offset++)
+		{
+			opcode_desc *const curdesc = window.descs[offset];
+			if (curdesc == nullptr || !(curdesc->flags & OPFLAG_IS_BRANCH) || (curdesc->flags & OPFLAG_INTRABLOCK_BRANCH) || curdesc->targetpc == BRANCH_TARGET_DYNAMIC)
+				continue;
+
+			opcode_desc *const targetdesc = find_description(curdesc->targetpc);
+			if (targetdesc != nullptr)
+			{
+				curdesc->flags |= OPFLAG_INTRABLOCK_BRANCH;
+				targetdesc->flags |= OPFLAG_IS_BRANCH_TARGET;
+				if (m_pageshift != 0 && ((curdesc->pc ^ targetdesc->pc) >> m_pageshift) != 0)
+					targetdesc->flags |= OPFLAG_VALIDATE_TLB | OPFLAG_CAN_CAUSE_EXCEPTION;
+			}
+		}
 }
 
 
@@ -27,12 +27,23 @@
     walkthrough is finished, these descriptions are assembled together into
     a linked list and returned for further processing by the backend.
 
+    If trace formation is enabled, the backend counts how often each
+    static branch out of a block is taken. A code window that becomes
+    hot is described in extra windows starting at the hot targets, so
+    the likely path is compiled inline. The other paths still leave
+    through the hash table.
+
 ***************************************************************************/
 #ifndef MAME_CPU_DRCFE_H
 #define MAME_CPU_DRCFE_H
 
 #pragma once
 
+#include <unordered_map>
+
+
+class drc_cache;
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -134,12 +145,29 @@ public:
 	// describe a block
 	opcode_desc const *describe_code(offs_t startpc);
 
+	// trace formation
+	void enable_traces(drc_cache &cache, u32 threshold);
+	u32 trace_threshold() const { return m_trace_threshold; }
+	u32 *exit_counter(offs_t targetpc);
+
 protected:
 	// required overrides
 	virtual bool describe(opcode_desc &desc, opcode_desc const *prev) = 0;
 
 private:
+	// a range of code being described
+	struct code_window
+	{
+		offs_t          startpc;                // first PC described
+		offs_t          minpc;                  // lowest PC in the window
+		offs_t          maxpc;                  // PC just past the window
+		opcode_desc **  descs;                  // descriptions in PC order, indexed from minpc
+	};
+
 	// internal helpers
+	void describe_window(code_window &window, std::vector<offs_t> &hotexits);
+	opcode_desc *find_description(offs_t pc) const;
+	void link_windows();
 	opcode_desc *describe_one(offs_t curpc, opcode_desc const *prevdesc, bool in_delay_slot = false);
 	void build_sequence(int start, int end, u32 endflag);
 	void accumulate_required_backwards(opcode_desc &desc, u32 *reqmask);
@@ -159,6 +187,12 @@ private:
 	simple_list<opcode_desc> m_desc_live_list;      // list of live descriptions
 	fixed_allocator<opcode_desc> m_desc_allocator;  // fixed allocator for descriptions
 	std::vector<opcode_desc *> m_desc_array;        // array of descriptions in PC order
+	std::vector<code_window> m_windows;             // windows in the current description
+
+	// trace formation
+	drc_cache *         m_cache;                    // cache holding exit counters
+	u32                 m_trace_threshold;          // exits before a target is hot, or 0 if disabled
+	std::unordered_map<offs_t, u32 *> m_exit_counters; // counters for static exits, by target PC
 };
 
 #endif // MAME_CPU_DRCFE_H
@@ -10,9 +10,6 @@
 
     Future improvements/changes:
 
-    * UML optimizer:
-        - constant folding
-
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
         - checks behavior of all opcodes
@@ -35,10 +32,14 @@
 #include "drcuml.h"
 
 #include "emuopts.h"
+#include "debugger.h"
+#include "debug/debugcmd.h"
+#include "debug/debugcon.h"
 #include "drcbec.h"
 #include "drcbex86.h"
 #include "drcbex64.h"
 
+#include <algorithm>
 #include <fstream>
 
 
@@ -130,6 +131,9 @@ drcbe_interface::~drcbe_interface()
 //  DRCUML STATE
 //**************************************************************************
 
+std::vector<drcuml_state *> drcuml_state::s_profiled;
+
+
 //-------------------------------------------------
 //  drcuml_state - constructor
 //-------------------------------------------------
@@ -146,7 +150,64 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 	, m_blocklist()
 	, m_handlelist()
 	, m_symlist()
+	, m_passes(0)
+	, m_workqueue(device.machine().options().drc_async() ? osd_work_queue_alloc(0) : nullptr)
+	, m_workitem(nullptr)
+	, m_instbefore(0)
+	, m_instafter(0)
+	, m_profile(device.machine().options().drc_profile())
+	, m_perfmap(device.machine().options().drc_perf_map()
+			? new std::ofstream(util::string_format("/tmp/perf-%d.map", osd_getpid()), std::ios::out | std::ios::app)
+			: nullptr)
 {
+	if (m_perfmap && !*m_perfmap)
+	{
+		osd_printf_warning("%s: unable to open perf map file\n", device.tag());
+		m_perfmap.reset();
+	}
+
+	// profiled states on the same machine share one debugger command
+	if (m_profile)
+	{
+		running_machine &machine(device.machine());
+		bool const first(std::find_if(
+				s_profiled.begin(),
+				s_profiled.end(),
+				[&machine] (drcuml_state const *state) { return &state->device().machine() == &machine; }) == s_profiled.end());
+		s_profiled.push_back(this);
+		if (first && (machine.debug_flags & DEBUG_FLAG_ENABLED))
+		{
+			machine.debugger().console().register_command("drcprofile", CMDFLAG_NONE, 0, 0, 2,
+					[&machine] (int ref, std::vector<std::string> const &params) { profile_command(machine, params); });
+		}
+	}
+
+	// parse the list of optimizations to apply
+	std::string const passes(device.machine().options().drc_optimize());
+	std::string::size_type start = 0;
+	while (start < passes.length())
+	{
+		std::string::size_type end = passes.find(',', start);
+		if (end == std::string::npos)
+			end = passes.length();
+		std::string const name(passes.substr(start, end - start));
+		start = end + 1;
+
+		if (name == "all")
+			m_passes = PASS_ALL;
+		else if (name == "none")
+			m_passes = 0;
+		else if (name == "constprop")
+			m_passes |= PASS_CONSTPROP;
+		else if (name == "copyprop")
+			m_passes |= PASS_COPYPROP;
+		else if (name == "loadelim")
+			m_passes |= PASS_LOADELIM;
+		else if (name == "deadstore")
+			m_passes |= PASS_DEADSTORE;
+		else if (!name.empty())
+			osd_printf_warning("Unknown DRC optimization '%s'\n", name.c_str());
+	}
 }
 
 
@@ -156,6 +217,22 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 
 drcuml_state::~drcuml_state()
 {
+	compile_wait();
+	if (m_workqueue)
+		osd_work_queue_free(m_workqueue);
+
+	if (m_instbefore != 0)
+		osd_printf_verbose("%s: UML optimization reduced %llu instructions to %llu (%.1f%%)\n", m_device.tag(), (unsigned long long)m_instbefore, (unsigned long long)m_instafter, 100.0 * double(m_instafter) / double(m_instbefore));
+	osd_printf_verbose("%s: DRC cache %u/%u KB in use, %u full flushes, %u region evictions (%u KB)\n",
+			m_device.tag(),
+			u32(m_cache.code_used() >> 10), u32(m_cache.code_size() >> 10),
+			m_cache.flushes(), m_cache.evictions(), u32(m_cache.evicted_bytes() >> 10));
+
+	if (m_profile)
+	{
+		osd_printf_verbose("%s", profile_report(20).c_str());
+		s_profiled.erase(std::remove(s_profiled.begin(), s_profiled.end(), this), s_profiled.end());
+	}
 }
 
 
@@ -176,8 +253,9 @@ void drcuml_state::reset()
 		for (uml::code_handle &handle : m_handlelist)
 			*handle.codeptr_addr() = nullptr;
 
-		// call the backend to reset
+		// call the backend to reset; its glue code must never be evicted
 		m_beintf->reset();
+		m_cache.pin(m_cache.base());
 
 		// do a one-time validation if requested
 #if 0
@@ -199,6 +277,155 @@ void drcuml_state::reset()
 }
 
 
+//-------------------------------------------------
+//  compile_async - run a compilation job in the
+//  background, or immediately if that's not
+//  possible
+//-------------------------------------------------
+
+void drcuml_state::compile_async(std::function<void ()> const &job)
+{
+	assert(!compiling());
+
+	m_workjob = job;
+	if (m_workqueue)
+		m_workitem = osd_work_item_queue(m_workqueue, &drcuml_state::compile_thread, this, 0);
+	if (!m_workitem)
+	{
+		m_workjob();
+		m_workjob = nullptr;
+	}
+}
+
+
+//-------------------------------------------------
+//  compile_wait - wait for any background
+//  compilation to finish
+//-------------------------------------------------
+
+void drcuml_state::compile_wait()
+{
+	if (!m_workitem)
+		return;
+
+	while (!osd_work_item_wait(m_workitem, osd_ticks_per_second()))
+	{
+	}
+	osd_work_item_release(m_workitem);
+	m_workitem = nullptr;
+	m_workjob = nullptr;
+}
+
+
+//-------------------------------------------------
+//  compile_thread - worker callback for
+//  background compilation
+//-------------------------------------------------
+
+void *drcuml_state::compile_thread(void *param, int threadid)
+{
+	drcuml_state &drcuml(*reinterpret_cast<drcuml_state *>(param));
+	drcuml.m_workjob();
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  profile_counter - return the execution counter
+//  for a block entry point, or nullptr if there's
+//  no room left for one
+//-------------------------------------------------
+
+u64 *drcuml_state::profile_counter(u32 mode, u32 pc)
+{
+	auto const found(m_profcounters.find(std::make_pair(mode, pc)));
+	if (found != m_profcounters.end())
+		return found->second;
+
+	// counters live in the near cache so they survive flushes and the back-end can address them directly
+	u64 *const counter(reinterpret_cast<u64 *>(m_cache.alloc_near(sizeof(u64))));
+	if (counter)
+	{
+		*counter = 0;
+		m_profcounters.emplace(std::make_pair(mode, pc), counter);
+	}
+	return counter;
+}
+
+
+//-------------------------------------------------
+//  profile_report - describe the most frequently
+//  executed block entry points
+//-------------------------------------------------
+
+std::string drcuml_state::profile_report(u32 count) const
+{
+	// sort entry points by descending execution count
+	std::vector<std::pair<u64, std::pair<u32, u32> > > sorted;
+	u64 total(0);
+	sorted.reserve(m_profcounters.size());
+	for (auto const &entry : m_profcounters)
+	{
+		sorted.emplace_back(*entry.second, entry.first);
+		total += *entry.second;
+	}
+	std::sort(sorted.begin(), sorted.end(), [] (auto const &a, auto const &b) { return a.first > b.first; });
+
+	std::string result(util::string_format("%s: %u entry points, %u block executions\n", m_device.tag(), sorted.size(), total));
+	for (u32 index = 0; (index < count) && (index < sorted.size()); index++)
+	{
+		result.append(util::string_format("  mode=%d PC=%08X %12u %5.1f%%\n",
+				sorted[index].second.first, sorted[index].second.second,
+				sorted[index].first, total ? (100.0 * double(sorted[index].first) / double(total)) : 0.0));
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  profile_command - handle the drcprofile
+//  debugger command
+//-------------------------------------------------
+
+void drcuml_state::profile_command(running_machine &machine, std::vector<std::string> const &params)
+{
+	debugger_commands &commands(machine.debugger().commands());
+
+	u64 count(20);
+	if (!params.empty() && !commands.validate_number_parameter(params[0], count))
+		return;
+
+	device_t *cpu(nullptr);
+	if ((params.size() > 1) && !commands.validate_cpu_parameter(params[1].c_str(), cpu))
+		return;
+
+	for (drcuml_state *state : s_profiled)
+	{
+		if ((&state->device().machine() == &machine) && (!cpu || (&state->device() == cpu)))
+		{
+			// don't walk the counters while a background job may be adding to them
+			state->compile_wait();
+			machine.debugger().console().printf("%s", state->profile_report(u32(std::min<u64>(count, ~u32(0)))));
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  perf_map_add - name a range of generated code
+//  for perf(1)
+//-------------------------------------------------
+
+void drcuml_state::perf_map_add(drccodeptr base, drccodeptr end, char const *name)
+{
+	if (!m_perfmap || (end <= base))
+		return;
+
+	util::stream_format(*m_perfmap, "%x %x drc:%s:%s\n", uintptr_t(base), uintptr_t(end - base), m_device.tag(), name);
+	m_perfmap->flush();
+}
+
+
 //-------------------------------------------------
 //  begin_block - begin a new code block
 //-------------------------------------------------
@@ -339,7 +566,20 @@ void drcuml_block::end()
 	assert(m_inuse);
 
 	// optimize the resulting code first
+	u32 const before(count_instructions());
 	optimize();
+	u32 const passes(m_drcuml.passes());
+	if (passes & (drcuml_state::PASS_CONSTPROP | drcuml_state::PASS_COPYPROP | drcuml_state::PASS_LOADELIM))
+		propagate(passes);
+	if (passes & drcuml_state::PASS_DEADSTORE)
+		eliminate_dead_stores();
+	compact();
+	u32 const after(count_instructions());
+	if (m_drcuml.profiling())
+		insert_profile_counters();
+	m_drcuml.count_optimized(before, after);
+	if (m_drcuml.logging() && (after != before))
+		m_drcuml.log_printf("; optimized from %u to %u instructions\n", before, after);
 
 	// if we have a logfile, generate a disassembly of the block
 	if (m_drcuml.logging())
@@ -348,11 +588,53 @@ void drcuml_block::end()
 	// generate the code via the back-end
 	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
 
+	// code handles can be jumped to directly, so blocks that define them can't be evicted
+	for (u32 inum = 0; inum < m_nextinst; inum++)
+		if (m_inst[inum].opcode() == uml::OP_HANDLE)
+			m_drcuml.cache().pin(m_inst[inum].param(0).handle().codeptr());
+
 	// block is no longer in use
 	m_inuse = false;
 }
 
 
+//-------------------------------------------------
+//  insert_profile_counters - count executions by
+//  incrementing a counter after each hash entry
+//  point; these run before any of the block's own
+//  code, so clobbering the flags is harmless
+//-------------------------------------------------
+
+void drcuml_block::insert_profile_counters()
+{
+	u32 hashes(0);
+	for (u32 inum = 0; inum < m_nextinst; inum++)
+		if (m_inst[inum].opcode() == uml::OP_HASH)
+			hashes++;
+	if (hashes == 0)
+		return;
+
+	// work backwards so everything can be moved up in place
+	if (m_inst.size() < (m_nextinst + hashes))
+		m_inst.resize(m_nextinst + hashes);
+	u32 dest(m_nextinst + hashes);
+	for (u32 inum = m_nextinst; inum-- > 0; )
+	{
+		uml::instruction const &inst(m_inst[inum]);
+		if (inst.opcode() == uml::OP_HASH)
+		{
+			u64 *const counter(m_drcuml.profile_counter(inst.param(0).immediate(), inst.param(1).immediate()));
+			if (counter)
+				m_inst[--dest].dadd(uml::mem(counter), uml::mem(counter), 1);
+			else
+				m_inst[--dest].nop();
+		}
+		m_inst[--dest] = m_inst[inum];
+	}
+	m_nextinst += hashes;
+}
+
+
 //-------------------------------------------------
 //  abort - abort a code block in progress
 //-------------------------------------------------
@@ -431,6 +713,316 @@ void drcuml_block::optimize()
 }
 
 
+//-------------------------------------------------
+//  propagate - replace integer register and
+//  memory operands with values already known to
+//  be in them, within each straight-line run of
+//  code
+//-------------------------------------------------
+
+void drcuml_block::propagate(u32 passes)
+{
+	// an immediate or register known to match an integer register, valid for accesses up to the given size
+	struct known_register { uml::parameter value; u8 size; };
+
+	// an immediate or register known to match a memory location of the given size
+	struct known_memory { void *base; u8 size; uml::parameter value; };
+
+	auto const truncate = [] (u64 value, u8 size) { return (size >= 8) ? value : (value & ((u64(1) << (size * 8)) - 1)); };
+
+	known_register regs[uml::REG_I_COUNT] = { };
+	std::vector<known_memory> mem;
+
+	auto const forget_all = [&regs, &mem] ()
+	{
+		for (known_register &known : regs)
+			known.value = uml::parameter();
+		mem.clear();
+	};
+
+	auto const forget_register = [&regs, &mem] (uml::parameter const &reg)
+	{
+		regs[reg.ireg() - uml::REG_I0].value = uml::parameter();
+		for (known_register &known : regs)
+			if (known.value == reg)
+				known.value = uml::parameter();
+		mem.erase(std::remove_if(mem.begin(), mem.end(), [&reg] (known_memory const &known) { return known.value == reg; }), mem.end());
+	};
+
+	auto const forget_memory = [&mem] (void *base, u8 size)
+	{
+		u8 const *const start(reinterpret_cast<u8 const *>(base));
+		mem.erase(
+				std::remove_if(
+					mem.begin(),
+					mem.end(),
+					[start, size] (known_memory const &known)
+					{
+						u8 const *const knownstart(reinterpret_cast<u8 const *>(known.base));
+						return (knownstart < (start + size)) && (start < (knownstart + known.size));
+					}),
+				mem.end());
+	};
+
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		uml::instruction &inst(m_inst[instnum]);
+
+		// substitute known values into pure inputs
+		bool changed(false);
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			if (!inst.param_is_input(pnum) || inst.param_is_output(pnum))
+				continue;
+
+			uml::parameter const &param(inst.param(pnum));
+			u8 const size(inst.param_size(pnum));
+			uml::parameter replacement;
+			bool allowed(false);
+			if (param.is_int_register())
+			{
+				known_register const &known(regs[param.ireg() - uml::REG_I0]);
+				if (size <= known.size)
+				{
+					replacement = known.value;
+					allowed = (passes & (replacement.is_immediate() ? drcuml_state::PASS_CONSTPROP : drcuml_state::PASS_COPYPROP)) != 0;
+				}
+			}
+			else if (param.is_memory() && !inst.param_is_pointer(pnum) && (passes & drcuml_state::PASS_LOADELIM))
+			{
+				for (known_memory const &known : mem)
+				{
+					if ((known.base == param.memory()) && (known.size == size))
+					{
+						replacement = known.value;
+						allowed = true;
+						break;
+					}
+				}
+			}
+
+			if (allowed && (replacement.type() != uml::parameter::PTYPE_NONE) && inst.param_allows(pnum, replacement.type()))
+			{
+				inst.set_param(pnum, replacement.is_immediate() ? uml::parameter(truncate(replacement.immediate(), size)) : replacement);
+				changed = true;
+			}
+		}
+		if (changed)
+			inst.simplify();
+
+		switch (inst.opcode())
+		{
+			// code can arrive here from elsewhere, or registers may be changed by code we can't see
+			case uml::OP_HANDLE:
+			case uml::OP_HASH:
+			case uml::OP_LABEL:
+			case uml::OP_DEBUG:
+			case uml::OP_HASHJMP:
+			case uml::OP_EXH:
+			case uml::OP_CALLH:
+			case uml::OP_CALLC:
+			case uml::OP_RESTORE:
+				forget_all();
+				continue;
+
+			// only a label can follow an unconditional exit
+			case uml::OP_JMP:
+			case uml::OP_EXIT:
+			case uml::OP_RET:
+				if (inst.condition() == uml::COND_ALWAYS)
+					forget_all();
+				continue;
+
+			// memory accesses and indexed stores may write anywhere
+			case uml::OP_READ:
+			case uml::OP_READM:
+			case uml::OP_WRITE:
+			case uml::OP_WRITEM:
+			case uml::OP_FREAD:
+			case uml::OP_FWRITE:
+			case uml::OP_STORE:
+			case uml::OP_FSTORE:
+			case uml::OP_VSTORE:
+			case uml::OP_SAVE:
+				mem.clear();
+				break;
+
+			default:
+				break;
+		}
+
+		// anything written is no longer known
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			if (inst.param_is_output(pnum))
+			{
+				uml::parameter const &param(inst.param(pnum));
+				if (param.is_int_register())
+					forget_register(param);
+				else if (param.is_memory() && !inst.param_is_pointer(pnum))
+					forget_memory(param.memory(), inst.param_size(pnum));
+			}
+		}
+
+		// an unconditional move tells us what the destination holds
+		if ((inst.opcode() == uml::OP_MOV) && (inst.condition() == uml::COND_ALWAYS))
+		{
+			uml::parameter const &dst(inst.param(0));
+			uml::parameter const &src(inst.param(1));
+			u8 const size(inst.size());
+			if (dst.is_int_register())
+			{
+				if (src.is_immediate())
+					regs[dst.ireg() - uml::REG_I0] = known_register{ uml::parameter(truncate(src.immediate(), size)), size };
+				else if (src.is_int_register() && (src != dst))
+					regs[dst.ireg() - uml::REG_I0] = known_register{ src, size };
+				else if (src.is_memory())
+					mem.push_back(known_memory{ src.memory(), size, dst });
+			}
+			else if (dst.is_memory())
+			{
+				if (src.is_immediate())
+					mem.push_back(known_memory{ dst.memory(), size, uml::parameter(truncate(src.immediate(), size)) });
+				else if (src.is_int_register())
+					mem.push_back(known_memory{ dst.memory(), size, src });
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  eliminate_dead_stores - turn integer register
+//  writes that are overwritten before being read
+//  into NOPs
+//-------------------------------------------------
+
+void drcuml_block::eliminate_dead_stores()
+{
+	// track which halves of each register may still be read
+	constexpr u8 LIVE_LOW = 0x01;
+	constexpr u8 LIVE_HIGH = 0x02;
+	constexpr u8 LIVE_ALL = LIVE_LOW | LIVE_HIGH;
+	u8 live[uml::REG_I_COUNT];
+	std::fill(std::begin(live), std::end(live), LIVE_ALL);
+
+	// work backwards, assuming everything is live at the end of the block
+	for (int instnum = m_nextinst - 1; instnum >= 0; instnum--)
+	{
+		uml::instruction &inst(m_inst[instnum]);
+		bool removable(false);
+		switch (inst.opcode())
+		{
+			// anything can be read once control leaves straight-line code
+			case uml::OP_HANDLE:
+			case uml::OP_HASH:
+			case uml::OP_LABEL:
+			case uml::OP_DEBUG:
+			case uml::OP_EXIT:
+			case uml::OP_HASHJMP:
+			case uml::OP_JMP:
+			case uml::OP_EXH:
+			case uml::OP_CALLH:
+			case uml::OP_RET:
+			case uml::OP_CALLC:
+			case uml::OP_SAVE:
+				std::fill(std::begin(live), std::end(live), LIVE_ALL);
+				continue;
+
+			// operations with no side effects beyond their outputs
+			case uml::OP_LOAD:
+			case uml::OP_LOADS:
+			case uml::OP_MOV:
+			case uml::OP_SEXT:
+			case uml::OP_ROLAND:
+			case uml::OP_ROLINS:
+			case uml::OP_ADD:
+			case uml::OP_ADDC:
+			case uml::OP_SUB:
+			case uml::OP_SUBB:
+			case uml::OP_MULU:
+			case uml::OP_MULS:
+			case uml::OP_AND:
+			case uml::OP_OR:
+			case uml::OP_XOR:
+			case uml::OP_LZCNT:
+			case uml::OP_TZCNT:
+			case uml::OP_BSWAP:
+			case uml::OP_SHL:
+			case uml::OP_SHR:
+			case uml::OP_SAR:
+			case uml::OP_ROL:
+			case uml::OP_ROLC:
+			case uml::OP_ROR:
+			case uml::OP_RORC:
+			case uml::OP_ICOPYF:
+				removable = (inst.condition() == uml::COND_ALWAYS) && (inst.flags() == 0);
+				break;
+
+			default:
+				break;
+		}
+
+		// an instruction writing only registers nobody reads can go
+		bool anyoutput(false), anylive(false);
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			if (inst.param_is_output(pnum))
+			{
+				uml::parameter const &param(inst.param(pnum));
+				anyoutput = true;
+				if (!param.is_int_register() || live[param.ireg() - uml::REG_I0])
+					anylive = true;
+			}
+		}
+		if (removable && anyoutput && !anylive)
+		{
+			inst.nop();
+			continue;
+		}
+
+		// unconditional writes end the lifetime of what they overwrite, reads start it
+		if (inst.condition() == uml::COND_ALWAYS)
+		{
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			{
+				uml::parameter const &param(inst.param(pnum));
+				if (inst.param_is_output(pnum) && !inst.param_is_input(pnum) && param.is_int_register())
+					live[param.ireg() - uml::REG_I0] &= (inst.param_size(pnum) >= 8) ? 0 : ~LIVE_LOW;
+			}
+		}
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			uml::parameter const &param(inst.param(pnum));
+			if (inst.param_is_input(pnum) && param.is_int_register())
+				live[param.ireg() - uml::REG_I0] |= (inst.param_size(pnum) >= 8) ? LIVE_ALL : LIVE_LOW;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  compact - remove NOPs from the block
+//-------------------------------------------------
+
+void drcuml_block::compact()
+{
+	auto const end(std::remove_if(m_inst.begin(), m_inst.begin() + m_nextinst, [] (uml::instruction const &inst) { return inst.opcode() == uml::OP_NOP; }));
+	m_nextinst = end - m_inst.begin();
+}
+
+
+//-------------------------------------------------
+//  count_instructions - count the instructions in
+//  the block that generate code
+//-------------------------------------------------
+
+u32 drcuml_block::count_instructions() const
+{
+	return std::count_if(m_inst.begin(), m_inst.begin() + m_nextinst, [] (uml::instruction const &inst) { return (inst.opcode() != uml::OP_COMMENT) && (inst.opcode() != uml::OP_MAPVAR) && (inst.opcode() != uml::OP_NOP); });
+}
+
+
 //-------------------------------------------------
 //  disassemble - disassemble a block of
 //  instructions to the log
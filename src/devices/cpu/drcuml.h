@@ -17,6 +17,7 @@
 
 #include <iostream>
 #include <list>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -61,9 +62,21 @@ union drcuml_freg
 };
 
 
+// a 128-bit vector register; lane n is always at index n in host memory order
+union alignas(16) drcuml_vreg
+{
+	u8                      b[16];                  // 8-bit lanes
+	u16                     h[8];                   // 16-bit lanes
+	u32                     w[4];                   // 32-bit lanes
+	u64                     d[2];                   // 64-bit lanes
+	float                   s[4];                   // single-precision lanes
+};
+
+
 // the collected machine state of a system
 struct drcuml_machine_state
 {
+	drcuml_vreg             v[uml::REG_V_COUNT];    // vector registers
 	drcuml_ireg             r[uml::REG_I_COUNT];    // integer registers
 	drcuml_freg             f[uml::REG_F_COUNT];    // floating-point registers
 	u32                     exp;                    // exception parameter register
@@ -113,6 +126,11 @@ public:
 private:
 	// internal helpers
 	void optimize();
+	void propagate(u32 passes);
+	void eliminate_dead_stores();
+	void compact();
+	void insert_profile_counters();
+	u32 count_instructions() const;
 	void disassemble();
 	char const *get_comment_text(uml::instruction const &inst, std::string &comment);
 
@@ -158,6 +176,16 @@ protected:
 class drcuml_state
 {
 public:
+	// optimization passes applied to each block before code generation
+	enum : u32
+	{
+		PASS_CONSTPROP  = 0x01,                 // replace registers holding known constants with immediates
+		PASS_COPYPROP   = 0x02,                 // replace registers copied from another register with the original
+		PASS_LOADELIM   = 0x04,                 // reuse values already loaded from or stored to memory
+		PASS_DEADSTORE  = 0x08,                 // remove register writes that are never read
+		PASS_ALL        = 0x0f
+	};
+
 	// construction/destruction
 	drcuml_state(device_t &device, drc_cache &cache, u32 flags, int modes, int addrbits, int ignorebits);
 	~drcuml_state();
@@ -165,6 +193,7 @@ public:
 	// getters
 	device_t &device() const { return m_device; }
 	drc_cache &cache() const { return m_cache; }
+	u32 passes() const { return m_passes; }
 
 	// reset the state
 	void reset();
@@ -196,7 +225,27 @@ public:
 	void log_flush() { if (logging()) m_umllog->flush(); }
 	bool logging_native() const { return m_beintf->logging(); }
 
+	// optimization statistics
+	void count_optimized(u32 before, u32 after) { m_instbefore += before; m_instafter += after; }
+
+	// background compilation; the owner must not execute or generate code while a job is running
+	bool async() const { return m_workqueue != nullptr; }
+	bool compiling() const { return m_workitem != nullptr; }
+	void compile_async(std::function<void ()> const &job);
+	void compile_wait();
+
+	// per-block execution counting
+	bool profiling() const { return m_profile; }
+	u64 *profile_counter(u32 mode, u32 pc);
+	std::string profile_report(u32 count) const;
+
+	// perf(1) symbol map output
+	void perf_map_add(drccodeptr base, drccodeptr end, char const *name);
+
 private:
+	static void *compile_thread(void *param, int threadid);
+	static void profile_command(running_machine &machine, std::vector<std::string> const &params);
+
 	// symbol class
 	class symbol
 	{
@@ -228,6 +277,17 @@ private:
 	std::list<drcuml_block>                 m_blocklist;        // list of active blocks
 	std::list<uml::code_handle>             m_handlelist;       // list of active handles
 	std::list<symbol>                       m_symlist;          // list of symbols
+	u32                                     m_passes;           // PASS_* optimizations to apply
+	osd_work_queue *                        m_workqueue;        // queue for background compilation
+	osd_work_item *                         m_workitem;         // background compilation in progress
+	std::function<void ()>                  m_workjob;          // what it's doing
+	u64                                     m_instbefore;       // instructions generated before optimization
+	u64                                     m_instafter;        // instructions remaining after optimization
+	bool const                              m_profile;          // count block executions
+	std::map<std::pair<u32, u32>, u64 *>    m_profcounters;     // counter for each mode/PC, kept across flushes
+	std::unique_ptr<std::ostream>           m_perfmap;          // perf(1) symbol map, if enabled
+
+	static std::vector<drcuml_state *>      s_profiled;         // every state with profiling enabled
 };
 
 
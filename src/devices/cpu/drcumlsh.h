@@ -31,7 +31,7 @@
 #define UML_NOP(block)                                      do { using namespace uml; block.append().nop(); } while (0)
 #define UML_DEBUG(block, pc)                                do { using namespace uml; block.append().debug(pc); } while (0)
 #define UML_EXIT(block, param)                              do { using namespace uml; block.append().exit(param); } while (0)
-#define UML_EXITc(block, cond, param)                       do { using namespace uml; block.append().exit(param, cond); } while (0)
+#define UML_EXITc(block, cond, param)                       do { using namespace uml; block.append().exit(cond, param); } while (0)
 #define UML_HASHJMP(block, mode, pc, handle)                do { using namespace uml; block.append().hashjmp(mode, pc, handle); } while (0)
 #define UML_JMP(block, label)                               do { using namespace uml; block.append().jmp(label); } while (0)
 #define UML_JMPc(block, cond, label)                        do { using namespace uml; block.append().jmp(cond, label); } while (0)
@@ -186,4 +186,28 @@
 #define UML_ICOPYFD(block, dst, src)                        do { using namespace uml; block.append().icopyfd(dst, src); } while (0)
 
 
+/* ----- 128-bit Vector Operations ----- */
+#define UML_VLOAD(block, dst, base, index)                  do { using namespace uml; block.append().vload(dst, base, index); } while (0)
+#define UML_VSTORE(block, base, index, src)                 do { using namespace uml; block.append().vstore(base, index, src); } while (0)
+#define UML_VMOV(block, dst, src)                           do { using namespace uml; block.append().vmov(dst, src); } while (0)
+#define UML_VAND(block, dst, src1, src2)                    do { using namespace uml; block.append().vand(dst, src1, src2); } while (0)
+#define UML_VOR(block, dst, src1, src2)                     do { using namespace uml; block.append().vor(dst, src1, src2); } while (0)
+#define UML_VXOR(block, dst, src1, src2)                    do { using namespace uml; block.append().vxor(dst, src1, src2); } while (0)
+#define UML_VADD(block, lane, dst, src1, src2)              do { using namespace uml; block.append().vadd(lane, dst, src1, src2); } while (0)
+#define UML_VSUB(block, lane, dst, src1, src2)              do { using namespace uml; block.append().vsub(lane, dst, src1, src2); } while (0)
+#define UML_VADDS(block, lane, dst, src1, src2)             do { using namespace uml; block.append().vadds(lane, dst, src1, src2); } while (0)
+#define UML_VSUBS(block, lane, dst, src1, src2)             do { using namespace uml; block.append().vsubs(lane, dst, src1, src2); } while (0)
+#define UML_VADDUS(block, lane, dst, src1, src2)            do { using namespace uml; block.append().vaddus(lane, dst, src1, src2); } while (0)
+#define UML_VSUBUS(block, lane, dst, src1, src2)            do { using namespace uml; block.append().vsubus(lane, dst, src1, src2); } while (0)
+#define UML_VMULL(block, dst, src1, src2)                   do { using namespace uml; block.append().vmull(dst, src1, src2); } while (0)
+#define UML_VMULH(block, dst, src1, src2)                   do { using namespace uml; block.append().vmulh(dst, src1, src2); } while (0)
+#define UML_VMULHU(block, dst, src1, src2)                  do { using namespace uml; block.append().vmulhu(dst, src1, src2); } while (0)
+#define UML_VCMPEQ(block, lane, dst, src1, src2)            do { using namespace uml; block.append().vcmpeq(lane, dst, src1, src2); } while (0)
+#define UML_VCMPGT(block, lane, dst, src1, src2)            do { using namespace uml; block.append().vcmpgt(lane, dst, src1, src2); } while (0)
+#define UML_VFADD(block, dst, src1, src2)                   do { using namespace uml; block.append().vfadd(dst, src1, src2); } while (0)
+#define UML_VFSUB(block, dst, src1, src2)                   do { using namespace uml; block.append().vfsub(dst, src1, src2); } while (0)
+#define UML_VFMUL(block, dst, src1, src2)                   do { using namespace uml; block.append().vfmul(dst, src1, src2); } while (0)
+#define UML_VSHUF(block, dst, src, lanes)                   do { using namespace uml; block.append().vshuf(dst, src, lanes); } while (0)
+
+
 #endif // MAME_CPU_DRCUMLSH_H
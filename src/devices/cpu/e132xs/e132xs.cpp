@@ -1984,6 +1984,45 @@ void hyperstone_device::execute_run()
 	}
 }
 
+//-------------------------------------------------
+//  execute_fallback_op - run a single opcode the
+//  recompiler leaves to the interpreter
+//-------------------------------------------------
+
+void hyperstone_device::execute_fallback_op()
+{
+	OP = m_core->arg0;
+	m_instruction_length = 1 << ILC_SHIFT;
+
+	switch (m_op >> 8)
+	{
+		case 0x1c: hyperstone_sums<GLOBAL, GLOBAL>(); break;
+		case 0x1d: hyperstone_sums<GLOBAL, LOCAL>(); break;
+		case 0x1e: hyperstone_sums<LOCAL, GLOBAL>(); break;
+		case 0x1f: hyperstone_sums<LOCAL, LOCAL>(); break;
+		case 0x2c: hyperstone_adds<GLOBAL, GLOBAL>(); break;
+		case 0x2d: hyperstone_adds<GLOBAL, LOCAL>(); break;
+		case 0x2e: hyperstone_adds<LOCAL, GLOBAL>(); break;
+		case 0x2f: hyperstone_adds<LOCAL, LOCAL>(); break;
+		case 0x5c: hyperstone_negs<GLOBAL, GLOBAL>(); break;
+		case 0x5d: hyperstone_negs<GLOBAL, LOCAL>(); break;
+		case 0x5e: hyperstone_negs<LOCAL, GLOBAL>(); break;
+		case 0x5f: hyperstone_negs<LOCAL, LOCAL>(); break;
+		case 0x6c: hyperstone_addsi<GLOBAL, SIMM>(); break;
+		case 0x6d: hyperstone_addsi<GLOBAL, LIMM>(); break;
+		case 0x6e: hyperstone_addsi<LOCAL, SIMM>(); break;
+		case 0x6f: hyperstone_addsi<LOCAL, LIMM>(); break;
+		case 0x84: hyperstone_sardi<N_LO>(); break;
+		case 0x85: hyperstone_sardi<N_HI>(); break;
+		case 0x8c: case 0x8d: hyperstone_reserved(); break;
+		case 0xac: case 0xad: case 0xae: case 0xaf: hyperstone_reserved(); break;
+		case 0xce: hyperstone_extend(); break;
+		case 0xcf: hyperstone_do(); break;
+		default:
+			fatalerror("PC=%08X: No interpreter fallback for op %04X\n", PC - 2, OP);
+	}
+}
+
 DEFINE_DEVICE_TYPE(E116T,      e116t_device,      "e116t",      "hyperstone E1-16T")
 DEFINE_DEVICE_TYPE(E116XT,     e116xt_device,     "e116xt",     "hyperstone E1-16XT")
 DEFINE_DEVICE_TYPE(E116XS,     e116xs_device,     "e116xs",     "hyperstone E1-16XS")
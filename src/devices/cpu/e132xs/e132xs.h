@@ -120,6 +120,7 @@ public:
 	inline void ccfunc_print();
 	inline void ccfunc_total_cycles();
 	inline void ccfunc_standard_irq_callback();
+	void execute_fallback_op();
 
 #if E132XS_LOG_DRC_REGS || E132XS_LOG_INTERPRETER_REGS
 	void dump_registers();
@@ -505,6 +506,7 @@ private:
 	void generate_int(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t addr);
 	void generate_exception(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t addr);
 	void generate_software(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_interpreter_fallback(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
 
 	template <reg_bank DST_GLOBAL, reg_bank SRC_GLOBAL> void generate_chk(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
 	template <reg_bank DST_GLOBAL, reg_bank SRC_GLOBAL> void generate_movd(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
@@ -73,6 +73,11 @@ static void cfunc_unimplemented(void *param)
 	((hyperstone_device *)param)->ccfunc_unimplemented();
 }
 
+static void cfunc_execute_fallback_op(void *param)
+{
+	((hyperstone_device *)param)->execute_fallback_op();
+}
+
 static void cfunc_adjust_timer_interrupt(void *param)
 {
 	((hyperstone_device *)param)->adjust_timer_interrupt();
@@ -283,6 +283,18 @@ void hyperstone_device::generate_exception(drcuml_block &block, compiler_state &
 	fatalerror(" ");
 }
 
+void hyperstone_device::generate_interpreter_fallback(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// the interpreter charges its own cycles
+	UML_MOV(block, I7, 0);
+	UML_MOV(block, mem(&m_core->arg0), desc->opptr.w[0]);
+	UML_CALLC(block, cfunc_execute_fallback_op, this);
+
+	// a delayed PC or a trap leaves the PC somewhere other than the next opcode, so go through the hash table
+	UML_CMP(block, DRC_PC, desc->pc + desc->length);
+	UML_SETc(block, uml::COND_NE, mem(&m_core->delay_slot_taken));
+}
+
 void hyperstone_device::generate_software(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
 	UML_MOV(block, I7, mem(&m_core->clock_cycles_6));
@@ -922,9 +934,7 @@ void hyperstone_device::generate_sum(drcuml_block &block, compiler_state &compil
 template <hyperstone_device::reg_bank DST_GLOBAL, hyperstone_device::reg_bank SRC_GLOBAL>
 void hyperstone_device::generate_sums(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
-	printf("Unimplemented: generate_sums (%08x)\n", desc->pc);
-	fflush(stdout);
-	fatalerror(" ");
+	generate_interpreter_fallback(block, compiler, desc);
 }
 
 
@@ -1176,9 +1186,7 @@ void hyperstone_device::generate_add(drcuml_block &block, compiler_state &compil
 template <hyperstone_device::reg_bank DST_GLOBAL, hyperstone_device::reg_bank SRC_GLOBAL>
 void hyperstone_device::generate_adds(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
-	printf("Unimplemented: generate_adds (%08x)\n", desc->pc);
-	fflush(stdout);
-	fatalerror(" ");
+	generate_interpreter_fallback(block, compiler, desc);
 }
 
 
@@ -1671,9 +1679,7 @@ void hyperstone_device::generate_neg(drcuml_block &block, compiler_state &compil
 template <hyperstone_device::reg_bank DST_GLOBAL, hyperstone_device::reg_bank SRC_GLOBAL>
 void hyperstone_device::generate_negs(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
-	printf("Unimplemented: generate_negs (%08x)\n", desc->pc);
-	fflush(stdout);
-	fatalerror(" ");
+	generate_interpreter_fallback(block, compiler, desc);
 }
 
 
@@ -2207,9 +2213,7 @@ void hyperstone_device::generate_addi(drcuml_block &block, compiler_state &compi
 template <hyperstone_device::reg_bank DST_GLOBAL, hyperstone_device::imm_size IMM_LONG>
 void hyperstone_device::generate_addsi(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
-	printf("Unimplemented: generate_addsi (%08x)\n", desc->pc);
-	fflush(stdout);
-	fatalerror(" ");
+	generate_interpreter_fallback(block, compiler, desc);
 }
 
 
@@ -2704,9 +2708,7 @@ void hyperstone_device::generate_shri(drcuml_block &block, compiler_state &compi
 template <hyperstone_device::shift_type HI_N>
 void hyperstone_device::generate_sardi(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
-	printf("Unimplemented: generate_sardi (%08x)\n", desc->pc);
-	fflush(stdout);
-	fatalerror(" ");
+	generate_interpreter_fallback(block, compiler, desc);
 }
 
 
@@ -4994,11 +4996,23 @@ void hyperstone_device::generate_trap_op(drcuml_block &block, compiler_state &co
 
 void hyperstone_device::generate_extend(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
-	UML_MOV(block, I7, mem(&m_core->clock_cycles_1));
-
 	uint16_t op = desc->opptr.w[0];
 
 	uint16_t func = m_pr16(desc->pc + 2);
+	switch (func)
+	{
+		case EMUL: case EMUL_N: case EMULU: case EMULS:
+		case EMAC: case EMSUB: case EMACD: case EMSUBD:
+		case EHMAC:
+			break;
+
+		default:
+			generate_interpreter_fallback(block, compiler, desc);
+			return;
+	}
+
+	UML_MOV(block, I7, mem(&m_core->clock_cycles_1));
+
 	UML_ADD(block, DRC_PC, DRC_PC, 2);
 
 	generate_check_delay_pc(block, compiler, desc);
@@ -5087,77 +5101,17 @@ void hyperstone_device::generate_extend(drcuml_block &block, compiler_state &com
 			UML_STORE(block, (void *)m_core->global_regs, 15, I0, SIZE_DWORD, SCALE_x4);
 			break;
 		}
-
-		// signed half-word multiply/add, double word product sum
-		case EHMACD:
-		{
-			printf("Unimplemented extended opcode, EHMACD, PC = %08x\n", desc->pc);
-			fatalerror(" ");
-			break;
-		}
-
-		// half-word complex multiply
-		case EHCMULD:
-		{
-			printf("Unimplemented extended opcode, EHCMULD, PC = %08x\n", desc->pc);
-			fatalerror(" ");
-			break;
-		}
-
-		// half-word complex multiply/add
-		case EHCMACD:
-		{
-			printf("Unimplemented extended opcode, EHCMACD, PC = %08x\n", desc->pc);
-			fatalerror(" ");
-			break;
-		}
-
-		// half-word (complex) add/substract
-		// Ls is not used and should denote the same register as Ld
-		case EHCSUMD:
-		{
-			printf("Unimplemented extended opcode, EHCSUMD, PC = %08x\n", desc->pc);
-			fatalerror(" ");
-			break;
-		}
-
-		// half-word (complex) add/substract with fixed point adjustment
-		// Ls is not used and should denote the same register as Ld
-		case EHCFFTD:
-		{
-			printf("Unimplemented extended opcode, EHCFFTD, PC = %08x\n", desc->pc);
-			fatalerror(" ");
-			break;
-		}
-
-		// half-word (complex) add/substract with fixed point adjustment and shift
-		// Ls is not used and should denote the same register as Ld
-		case EHCFFTSD:
-		{
-			printf("Unimplemented extended opcode, EHCFFTSD, PC = %08x\n", desc->pc);
-			fatalerror(" ");
-			break;
-		}
-
-		default:
-			printf("Unknown extended opcode (%04x), PC = %08x\n", func, desc->pc);
-			fatalerror(" ");
-			break;
 	}
 }
 
 
 void hyperstone_device::generate_reserved(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
-	printf("Unimplemented: generate_reserved (%08x)\n", desc->pc);
-	fflush(stdout);
-	fatalerror(" ");
+	generate_interpreter_fallback(block, compiler, desc);
 }
 
 void hyperstone_device::generate_do(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
-	printf("Unimplemented: generate_do (%08x)\n", desc->pc);
-	fflush(stdout);
-	fatalerror(" ");
+	generate_interpreter_fallback(block, compiler, desc);
 }
 
@@ -19,12 +19,15 @@
 */
 
 #include "emu.h"
+#include "emuopts.h"
 #include "i386.h"
 #include "i386priv.h"
 #include "x87priv.h"
 #include "cycles.h"
 #include "i386ops.h"
 
+#include "cpu/drcumlsh.h"
+
 #include "debugger.h"
 #include "debug/debugcpu.h"
 
@@ -56,6 +59,7 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 	, device_vtlb_interface(mconfig, *this, AS_PROGRAM)
 	, m_program_config("program", ENDIANNESS_LITTLE, program_data_width, program_addr_width, 0, 32, 12)
 	, m_io_config("io", ENDIANNESS_LITTLE, io_data_width, 16, 0)
+	, m_x87_default_mode(x87_mode::SOFT)
 	, m_smiact(*this)
 	, m_ferr_handler(*this)
 {
@@ -273,6 +277,52 @@ bool i386_device::i386_translate_address(int intention, offs_t *address, vtlb_en
 	return ret;
 }
 
+//-------------------------------------------------
+//  code_page_ptr - return the host memory backing
+//  a physical page, or nullptr if any of it goes
+//  through a handler or tap
+//-------------------------------------------------
+
+const uint8_t *i386_device::code_page_ptr(uint32_t page)
+{
+	// every bus unit has to be part of the same contiguous block of memory
+	uint32_t const unit = m_program->data_width() / 8;
+	const uint8_t *start = (const uint8_t *)m_program->get_read_ptr(page);
+	if (!start)
+		return nullptr;
+	for (uint32_t offset = unit; offset < 0x1000; offset += unit)
+		if ((const uint8_t *)m_program->get_read_ptr(page + offset) != start + offset)
+			return nullptr;
+	return start;
+}
+
+
+//-------------------------------------------------
+//  fetch_page_miss - look up the host memory
+//  backing a physical code page
+//-------------------------------------------------
+
+void i386_device::fetch_page_miss(fetch_page_entry &entry, uint32_t page)
+{
+	entry.page = page;
+	entry.base = code_page_ptr(page);
+}
+
+
+//-------------------------------------------------
+//  fetch_pages_flush - forget all cached code
+//  page pointers
+//-------------------------------------------------
+
+void i386_device::fetch_pages_flush()
+{
+	for (fetch_page_entry &entry : m_fetch_pages)
+	{
+		entry.page = 1;
+		entry.base = nullptr;
+	}
+}
+
 //#define TEST_TLB
 
 bool i386_device::translate_address(int pl, int type, uint32_t *address, uint32_t *error)
@@ -3038,6 +3088,7 @@ void i386_device::report_invalid_modrm(const char* opcode, uint8_t modrm)
 #include "pentops.hxx"
 #include "x87ops.hxx"
 #include "cpuidmsrs.hxx"
+#include "i386drc.hxx"
 
 
 void i386_device::i386_decode_opcode()
@@ -3371,13 +3422,35 @@ void i386_device::i386_common_init()
 		m_pr8  = [cache](offs_t address) -> u8  { return cache->read_byte(address);  };
 		m_pr16 = [cache](offs_t address) -> u16 { return cache->read_word(address);  };
 		m_pr32 = [cache](offs_t address) -> u32 { return cache->read_dword(address); };
+		m_fetch_xor8 = BYTE_XOR_LE(0);
+		m_fetch_xor16 = 0;
 	} else {
 		auto cache = m_program->cache<2, 0, ENDIANNESS_LITTLE>();
 		m_pr8  = [cache](offs_t address) -> u8  { return cache->read_byte(address);  };
 		m_pr16 = [cache](offs_t address) -> u16 { return cache->read_word(address);  };
 		m_pr32 = [cache](offs_t address) -> u32 { return cache->read_dword(address); };
+		m_fetch_xor8 = BYTE4_XOR_LE(0);
+		m_fetch_xor16 = WORD_XOR_LE(0);
 	}
 
+	// any change to the memory map or bank switch may move or remove the pages we point at
+	fetch_pages_flush();
+	auto flush = [this] (read_or_write mode) { fetch_pages_flush(); };
+	m_program->add_change_notifier(flush);
+	m_program->add_bank_notifier(flush);
+
+	// the x87 option overrides whatever the driver asked for
+	const char *const x87 = machine().options().x87();
+	if (!strcmp(x87, "soft"))
+		m_x87_mode = x87_mode::SOFT;
+	else if (!strcmp(x87, "host"))
+		m_x87_mode = x87_mode::HOST;
+	else if (!strcmp(x87, "validate"))
+		m_x87_mode = x87_mode::VALIDATE;
+	else
+		m_x87_mode = m_x87_default_mode;
+	m_x87_divergences = 0;
+
 	m_io = &space(AS_IO);
 	m_smi = false;
 	m_debugger_temp = 0;
@@ -3480,6 +3553,7 @@ void i386_device::i386_common_init()
 	m_ferr_handler(0);
 
 	set_icountptr(m_cycles);
+	drc_init();
 }
 
 void i386_device::device_start()
@@ -3929,6 +4003,12 @@ void i386_device::device_reset()
 	CHANGE_PC(m_eip);
 }
 
+void i386_device::device_stop()
+{
+	if (m_x87_divergences != 0)
+		osd_printf_warning("%s: %llu x87 results differed between the host FPU and softfloat\n", tag(), (unsigned long long)m_x87_divergences);
+}
+
 void i386_device::pentium_smi()
 {
 	uint32_t smram_state = m_smbase + 0xfe00;
@@ -4102,6 +4182,8 @@ void i386_device::execute_run()
 	while( m_cycles > 0 )
 	{
 		i386_check_irq_line();
+		if (m_drcuml && !m_drcuml->compiling() && drc_usable() && drc_execute())
+			continue;
 		m_operand_size = m_sreg[CS].d;
 		m_xmm_operand_size = 0;
 		m_address_size = m_sreg[CS].d;
@@ -4143,6 +4225,10 @@ void i386_device::execute_run()
 			i386_trap_with_error(e&0xffffffff,0,0,e>>32);
 		}
 	}
+
+	// background compilation always finishes by the end of the timeslice so runs are reproducible
+	if (m_drcuml)
+		m_drcuml->compile_wait();
 	m_tsc += (cycles - m_cycles);
 }
 
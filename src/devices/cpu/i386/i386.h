@@ -14,9 +14,12 @@
 
 #include "debug/debugcpu.h"
 #include "divtlb.h"
+#include "cpu/drcuml.h"
 
 #include "i386dasm.h"
 
+#include <unordered_set>
+
 #define INPUT_LINE_A20      1
 #define INPUT_LINE_SMI      2
 
@@ -32,9 +35,18 @@ public:
 	// construction/destruction
 	i386_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
 
+	// x87 arithmetic implementations
+	enum class x87_mode
+	{
+		SOFT,       // softfloat only
+		HOST,       // host FPU where it gives the same result
+		VALIDATE    // both, logging any difference
+	};
+
 	// configuration helpers
 	auto smiact() { return m_smiact.bind(); }
 	auto ferr() { return m_ferr_handler.bind(); }
+	void set_x87_mode(x87_mode mode) { m_x87_default_mode = mode; }
 
 	uint64_t debug_segbase(symbol_table &table, int params, const uint64_t *param);
 	uint64_t debug_seglimit(symbol_table &table, int params, const uint64_t *param);
@@ -47,6 +59,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 	virtual void device_debug_setup() override;
 
 	// device_execute_interface overrides
@@ -286,6 +299,18 @@ protected:
 	address_space *m_io;
 	uint32_t m_a20_mask;
 
+	// host pointers for recently fetched-from physical pages, so opcode
+	// fetches from RAM and ROM skip the memory system entirely
+	static constexpr int FETCH_PAGES = 64;
+	struct fetch_page_entry
+	{
+		uint32_t page;                          // physical page address, or 1 if unused
+		const uint8_t *base;                    // host pointer to the page, or nullptr if it isn't plain memory
+	};
+	fetch_page_entry m_fetch_pages[FETCH_PAGES];
+	uint8_t m_fetch_xor8;                       // byte lane swizzle within a bus word
+	uint8_t m_fetch_xor16;                      // word lane swizzle within a bus word
+
 	int m_cpuid_max_input_value_eax; // Highest CPUID standard function available
 	uint32_t m_cpuid_id0, m_cpuid_id1, m_cpuid_id2;
 	uint32_t m_cpu_version;
@@ -302,6 +327,9 @@ protected:
 	uint64_t m_x87_data_ptr;
 	uint64_t m_x87_inst_ptr;
 	uint16_t m_x87_opcode;
+	x87_mode m_x87_default_mode;
+	x87_mode m_x87_mode;
+	uint64_t m_x87_divergences;
 
 	i386_modrm_func m_opcode_table_x87_d8[256];
 	i386_modrm_func m_opcode_table_x87_d9[256];
@@ -363,6 +391,27 @@ protected:
 
 	uint64_t m_debugger_temp;
 
+	// state mirrored into the DRC cache for the duration of a compiled block
+	struct drc_state
+	{
+		uint32_t reg[8];        // general registers
+		uint32_t eip;           // instruction pointer
+		uint32_t pc;            // linear address of the instruction pointer
+		int32_t cycles;         // cycles remaining
+		uint32_t cs_base;       // code segment base the block was entered with
+		uint32_t cpl;           // current privilege level
+		uint32_t cr0;           // control register 0
+		uint32_t CF, OF, SF, ZF, AF, PF;    // arithmetic flags, one per word
+	};
+
+	std::unique_ptr<drc_cache> m_drc_cache;     // DRC code cache, if recompiling
+	std::unique_ptr<drcuml_state> m_drcuml;     // DRC UML generator state
+	drc_state *m_drc;                           // mirrored state, in the near cache
+	uml::code_handle *m_drc_entry;              // entry point
+	uml::code_handle *m_drc_nocode;             // exit for code not yet compiled
+	int m_drc_misses;                           // consecutive misses at the current PC
+	std::unordered_set<uint32_t> m_drc_interpret; // EIPs whose blocks only exit to the interpreter
+
 	void register_state_i386();
 	void register_state_i386_x87();
 	void register_state_i386_x87_xmm();
@@ -372,6 +421,10 @@ protected:
 	inline bool translate_address(int pl, int type, uint32_t *address, uint32_t *error);
 	inline void CHANGE_PC(uint32_t pc);
 	inline void NEAR_BRANCH(int32_t offs);
+	inline const uint8_t *fetch_page(uint32_t address);
+	const uint8_t *code_page_ptr(uint32_t page);
+	void fetch_page_miss(fetch_page_entry &entry, uint32_t page);
+	void fetch_pages_flush();
 	inline uint8_t FETCH();
 	inline uint16_t FETCH16();
 	inline uint32_t FETCH32();
@@ -1326,6 +1379,12 @@ protected:
 	int x87_check_exceptions();
 	inline void x87_write_cw(uint16_t cw);
 	void x87_reset();
+	floatx80 x87_soft_add(floatx80 a, floatx80 b);
+	floatx80 x87_soft_sub(floatx80 a, floatx80 b);
+	floatx80 x87_soft_mul(floatx80 a, floatx80 b);
+	floatx80 x87_soft_div(floatx80 a, floatx80 b);
+	floatx80 x87_soft_arith(int op, floatx80 a, floatx80 b);
+	floatx80 x87_host_arith(int op, floatx80 a, floatx80 b);
 	floatx80 x87_add(floatx80 a, floatx80 b);
 	floatx80 x87_sub(floatx80 a, floatx80 b);
 	floatx80 x87_mul(floatx80 a, floatx80 b);
@@ -1487,6 +1546,13 @@ protected:
 	void zero_state();
 	void i386_set_a20_line(int state);
 
+	// dynamic recompiler
+	void drc_init();
+	void drc_flush_cache();
+	bool drc_usable() const;
+	bool drc_execute();
+	void drc_compile_block(uint32_t eip);
+
 };
 
 
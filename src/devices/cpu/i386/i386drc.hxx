@@ -0,0 +1,626 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    i386drc.hxx
+
+    Dynamic recompiler for 32-bit protected mode code.
+
+    Only straight-line runs of register-to-register integer instructions
+    and near branches are recompiled.  Anything else ends the block and
+    is handed to the interpreter one instruction at a time, so compiled
+    code never accesses memory through the address space and can't
+    fault.  x87, segment loads, memory operands and prefixed
+    instructions all go through the interpreter for now.
+
+    Blocks are hashed by EIP.  Each block checks on entry that the code
+    segment base, privilege level, paging state, TLB entry for the code
+    page and the code bytes themselves still match what it was compiled
+    from, and asks to be recompiled if not.  This catches self-modifying
+    code and page table changes without hooking every write.
+
+***************************************************************************/
+
+namespace {
+
+// exit codes from compiled code
+enum
+{
+	EXECUTE_OUT_OF_CYCLES = 0,
+	EXECUTE_CONTINUE,
+	EXECUTE_MISSING_CODE,
+	EXECUTE_INTERPRET
+};
+
+constexpr size_t DRC_CACHE_SIZE = 8 * 1024 * 1024;
+constexpr int DRC_MAX_INSTRUCTIONS = 64;
+
+// arithmetic flags, for working out which ones each instruction must store
+enum : uint8_t
+{
+	DRC_CF = 0x01,
+	DRC_OF = 0x02,
+	DRC_SF = 0x04,
+	DRC_ZF = 0x08,
+	DRC_AF = 0x10,
+	DRC_PF = 0x20,
+	DRC_ALL_FLAGS = 0x3f
+};
+
+// a decoded instruction
+struct drc_insn
+{
+	enum kind_t : uint8_t { NOP, MOV, ADD, OR, AND, SUB, XOR, CMP, TEST, INC, DEC, JMP, JCC };
+
+	kind_t kind;
+	uint8_t dst;            // destination register
+	uint8_t src;            // source register when not immediate
+	bool immediate;         // source is an immediate
+	uint32_t value;         // immediate value, or branch target EIP
+	uint8_t condition;      // condition code for JCC
+	uint8_t length;         // length in bytes
+	int cycles;             // cycles taken, including the branch if any
+	int nobranch_cycles;    // cycles taken by a JCC that falls through
+	uint8_t flags;          // flags that must be stored
+
+	uint8_t written() const
+	{
+		switch (kind)
+		{
+		case ADD: case SUB: case CMP:           return DRC_ALL_FLAGS;
+		case INC: case DEC:                     return DRC_ALL_FLAGS & ~DRC_CF;
+		case AND: case OR: case XOR: case TEST: return DRC_CF | DRC_OF | DRC_SF | DRC_ZF | DRC_PF;
+		default:                                return 0;
+		}
+	}
+	bool logical() const { return (kind == AND) || (kind == OR) || (kind == XOR) || (kind == TEST); }
+};
+
+} // anonymous namespace
+
+
+
+/***************************************************************************
+    SETUP
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_init - set up the recompiler if it's
+    allowed
+-------------------------------------------------*/
+
+void i386_device::drc_init()
+{
+	m_drc = nullptr;
+	m_drc_entry = nullptr;
+	m_drc_nocode = nullptr;
+	m_drc_misses = 0;
+
+	// the debugger needs to see every instruction
+	if (!allow_drc() || (machine().debug_flags & DEBUG_FLAG_ENABLED))
+		return;
+
+	m_drc_cache = std::make_unique<drc_cache>(DRC_CACHE_SIZE + sizeof(drc_state));
+	m_drc = reinterpret_cast<drc_state *>(m_drc_cache->alloc_near(sizeof(drc_state)));
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drc_cache, 0, 1, 32, 0);
+
+	m_drcuml->symbol_add(&m_drc->reg[0], sizeof(m_drc->reg), "reg");
+	m_drcuml->symbol_add(&m_drc->eip, sizeof(m_drc->eip), "eip");
+	m_drcuml->symbol_add(&m_drc->pc, sizeof(m_drc->pc), "pc");
+	m_drcuml->symbol_add(&m_drc->cycles, sizeof(m_drc->cycles), "cycles");
+
+	m_drc_entry = m_drcuml->handle_alloc("entry");
+	m_drc_nocode = m_drcuml->handle_alloc("nocode");
+	drc_flush_cache();
+
+	// blocks check their code through host pointers taken when they were compiled, so
+	// they can't see a map change or bank switch; throw everything away instead
+	auto flush = [this] (read_or_write mode) { m_drcuml->compile_wait(); drc_flush_cache(); };
+	m_program->add_change_notifier(flush);
+	m_program->add_bank_notifier(flush);
+}
+
+
+/*-------------------------------------------------
+    drc_flush_cache - empty the cache and
+    regenerate the static code
+-------------------------------------------------*/
+
+void i386_device::drc_flush_cache()
+{
+	m_drcuml->reset();
+	m_drc_interpret.clear();
+
+	try
+	{
+		// look up the block for the current EIP
+		drcuml_block &entry(m_drcuml->begin_block(4));
+		UML_HANDLE(entry, *m_drc_entry);                                        // handle  entry
+		UML_HASHJMP(entry, 0, mem(&m_drc->eip), *m_drc_nocode);                 // hashjmp 0,<eip>,nocode
+		entry.end();
+
+		// or ask for it to be compiled
+		drcuml_block &nocode(m_drcuml->begin_block(4));
+		UML_HANDLE(nocode, *m_drc_nocode);                                      // handle  nocode
+		UML_EXIT(nocode, EXECUTE_MISSING_CODE);                                 // exit    EXECUTE_MISSING_CODE
+		nocode.end();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unrecoverable error generating i386 static code\n");
+	}
+}
+
+
+
+/***************************************************************************
+    EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_usable - return true if the current mode
+    is one compiled code can run in
+-------------------------------------------------*/
+
+bool i386_device::drc_usable() const
+{
+	return PROTECTED_MODE && !V8086_MODE && m_sreg[CS].d && !m_TF && !m_delayed_interrupt_enable;
+}
+
+
+/*-------------------------------------------------
+    drc_execute - run compiled code from the
+    current EIP; returns false if the caller
+    should interpret an instruction instead
+-------------------------------------------------*/
+
+bool i386_device::drc_execute()
+{
+	// don't pay for entering and leaving compiled code just to be told to interpret
+	if (m_drc_interpret.find(m_eip) != m_drc_interpret.end())
+		return false;
+
+	// mirror the state compiled code works on into the near cache
+	drc_state &state(*m_drc);
+	std::copy(std::begin(m_reg.d), std::end(m_reg.d), std::begin(state.reg));
+	state.eip = m_eip;
+	state.pc = m_pc;
+	state.cycles = m_cycles;
+	state.cs_base = m_sreg[CS].base;
+	state.cpl = m_CPL;
+	state.cr0 = m_cr[0];
+	state.CF = m_CF;
+	state.OF = m_OF;
+	state.SF = m_SF;
+	state.ZF = m_ZF;
+	state.AF = m_AF;
+	state.PF = m_PF;
+
+	int const result = m_drcuml->execute(*m_drc_entry);
+
+	std::copy(std::begin(state.reg), std::end(state.reg), std::begin(m_reg.d));
+	m_eip = state.eip;
+	m_pc = state.pc;
+	m_cycles = state.cycles;
+	m_CF = state.CF;
+	m_OF = state.OF;
+	m_SF = state.SF;
+	m_ZF = state.ZF;
+	m_AF = state.AF;
+	m_PF = state.PF;
+
+	switch (result)
+	{
+	case EXECUTE_MISSING_CODE:
+		// a stale TLB entry is the usual reason for a block refusing to run, so refill it first
+		if (++m_drc_misses == 1)
+		{
+			uint32_t address = m_pc, error;
+			if (translate_address(m_CPL, TRANSLATE_FETCH, &address, &error))
+				return true;
+		}
+		else if (m_drc_misses == 2)
+		{
+			drc_compile_block(m_eip);
+			return true;
+		}
+
+		// give up and let the interpreter deal with it, including any fault
+		m_drc_misses = 0;
+		return false;
+
+	case EXECUTE_INTERPRET:
+		// only a block with nothing compiled exits this way, and it stays that way until the cache is flushed
+		m_drc_interpret.insert(m_eip);
+		m_drc_misses = 0;
+		return false;
+
+	default:
+		m_drc_misses = 0;
+		return true;
+	}
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_compile_block - compile a block starting
+    at the given EIP in the current code segment
+-------------------------------------------------*/
+
+void i386_device::drc_compile_block(uint32_t eip)
+{
+	using namespace uml;
+
+	uint32_t const cs_base = m_sreg[CS].base;
+	uint32_t const linear = cs_base + eip;
+	bool const paging = (m_cr[0] & 0x80000000) != 0;
+
+	// find the code page in host memory; without one there's nothing to checksum
+	uint8_t const *code = nullptr;
+	vtlb_entry tlbentry = 0;
+	uint32_t physical = linear, error;
+	if (translate_address(m_CPL, TRANSLATE_FETCH, &physical, &error))
+	{
+		physical &= m_a20_mask;
+		if (paging)
+			tlbentry = vtlb_table()[linear >> 12];
+#ifdef LSB_FIRST
+		code = code_page_ptr(physical & ~0xfff);
+#endif
+	}
+
+	// decode as much as we can handle, stopping at a branch or the end of the page
+	std::vector<drc_insn> insns;
+	uint32_t const start = physical & 0xfff;
+	uint32_t offset = start;
+	while (code && (insns.size() < DRC_MAX_INSTRUCTIONS))
+	{
+		uint32_t const avail = 0x1000 - offset;
+		auto const byte = [code, offset] (uint32_t n) -> uint8_t { return code[offset + n]; };
+		auto const dword = [&byte] (uint32_t n) -> uint32_t { return byte(n) | (byte(n + 1) << 8) | (byte(n + 2) << 16) | (uint32_t(byte(n + 3)) << 24); };
+		static const drc_insn::kind_t alu[8] = { drc_insn::ADD, drc_insn::OR, drc_insn::NOP, drc_insn::NOP, drc_insn::AND, drc_insn::SUB, drc_insn::XOR, drc_insn::CMP };
+
+		drc_insn insn = { drc_insn::NOP, 0, 0, false, 0, 0, 0, 0, 0, 0 };
+		uint8_t const op = byte(0);
+		bool valid = false;
+		if ((op < 0x40) && (alu[(op >> 3) & 7] != drc_insn::NOP) && (((op & 7) == 1) || ((op & 7) == 3)) && (avail >= 2) && (byte(1) >= 0xc0))
+		{
+			// ALU r/m32,r32 and r32,r/m32
+			uint8_t const modrm = byte(1);
+			insn.kind = alu[(op >> 3) & 7];
+			insn.dst = ((op & 7) == 1) ? (modrm & 7) : ((modrm >> 3) & 7);
+			insn.src = ((op & 7) == 1) ? ((modrm >> 3) & 7) : (modrm & 7);
+			insn.length = 2;
+			insn.cycles = m_cycle_table_pm[(insn.kind == drc_insn::CMP) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG];
+			valid = true;
+		}
+		else if ((op < 0x40) && (alu[(op >> 3) & 7] != drc_insn::NOP) && ((op & 7) == 5) && (avail >= 5))
+		{
+			// ALU EAX,imm32
+			insn.kind = alu[(op >> 3) & 7];
+			insn.dst = EAX;
+			insn.immediate = true;
+			insn.value = dword(1);
+			insn.length = 5;
+			insn.cycles = m_cycle_table_pm[(insn.kind == drc_insn::CMP) ? CYCLES_CMP_IMM_ACC : CYCLES_ALU_IMM_ACC];
+			valid = true;
+		}
+		else if (((op == 0x81) || (op == 0x83)) && (avail >= ((op == 0x81) ? 6 : 3)) && (byte(1) >= 0xc0) && (alu[(byte(1) >> 3) & 7] != drc_insn::NOP))
+		{
+			// ALU r32,imm32 and r32,imm8
+			uint8_t const modrm = byte(1);
+			insn.kind = alu[(modrm >> 3) & 7];
+			insn.dst = modrm & 7;
+			insn.immediate = true;
+			insn.value = (op == 0x81) ? dword(2) : uint32_t(int32_t(int8_t(byte(2))));
+			insn.length = (op == 0x81) ? 6 : 3;
+			insn.cycles = m_cycle_table_pm[(insn.kind == drc_insn::CMP) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG];
+			valid = true;
+		}
+		else if ((op == 0x85) && (avail >= 2) && (byte(1) >= 0xc0))
+		{
+			// TEST r/m32,r32
+			insn.kind = drc_insn::TEST;
+			insn.dst = byte(1) & 7;
+			insn.src = (byte(1) >> 3) & 7;
+			insn.length = 2;
+			insn.cycles = m_cycle_table_pm[CYCLES_TEST_REG_REG];
+			valid = true;
+		}
+		else if ((op == 0xa9) && (avail >= 5))
+		{
+			// TEST EAX,imm32
+			insn.kind = drc_insn::TEST;
+			insn.dst = EAX;
+			insn.immediate = true;
+			insn.value = dword(1);
+			insn.length = 5;
+			insn.cycles = m_cycle_table_pm[CYCLES_TEST_IMM_ACC];
+			valid = true;
+		}
+		else if (((op == 0x89) || (op == 0x8b)) && (avail >= 2) && (byte(1) >= 0xc0))
+		{
+			// MOV r/m32,r32 and r32,r/m32
+			uint8_t const modrm = byte(1);
+			insn.kind = drc_insn::MOV;
+			insn.dst = (op == 0x89) ? (modrm & 7) : ((modrm >> 3) & 7);
+			insn.src = (op == 0x89) ? ((modrm >> 3) & 7) : (modrm & 7);
+			insn.length = 2;
+			insn.cycles = m_cycle_table_pm[CYCLES_MOV_REG_REG];
+			valid = true;
+		}
+		else if ((op >= 0xb8) && (op <= 0xbf) && (avail >= 5))
+		{
+			// MOV r32,imm32
+			insn.kind = drc_insn::MOV;
+			insn.dst = op & 7;
+			insn.immediate = true;
+			insn.value = dword(1);
+			insn.length = 5;
+			insn.cycles = m_cycle_table_pm[CYCLES_MOV_IMM_REG];
+			valid = true;
+		}
+		else if ((op >= 0x40) && (op <= 0x4f))
+		{
+			// INC r32 and DEC r32
+			insn.kind = (op < 0x48) ? drc_insn::INC : drc_insn::DEC;
+			insn.dst = op & 7;
+			insn.length = 1;
+			insn.cycles = m_cycle_table_pm[(op < 0x48) ? CYCLES_INC_REG : CYCLES_DEC_REG];
+			valid = true;
+		}
+		else if (op == 0x90)
+		{
+			insn.kind = drc_insn::NOP;
+			insn.length = 1;
+			insn.cycles = m_cycle_table_pm[CYCLES_NOP];
+			valid = true;
+		}
+		else if (((op == 0xeb) && (avail >= 2)) || ((op == 0xe9) && (avail >= 5)))
+		{
+			// JMP rel8 and rel32
+			insn.kind = drc_insn::JMP;
+			insn.length = (op == 0xeb) ? 2 : 5;
+			insn.value = eip + (offset - start) + insn.length + ((op == 0xeb) ? uint32_t(int32_t(int8_t(byte(1)))) : dword(1));
+			insn.cycles = m_cycle_table_pm[(op == 0xeb) ? CYCLES_JMP_SHORT : CYCLES_JMP];
+			valid = true;
+		}
+		else if ((op >= 0x70) && (op <= 0x7f) && (avail >= 2))
+		{
+			// Jcc rel8
+			insn.kind = drc_insn::JCC;
+			insn.condition = op & 0x0f;
+			insn.length = 2;
+			insn.value = eip + (offset - start) + 2 + uint32_t(int32_t(int8_t(byte(1))));
+			insn.cycles = m_cycle_table_pm[CYCLES_JCC_DISP8];
+			insn.nobranch_cycles = m_cycle_table_pm[CYCLES_JCC_DISP8_NOBRANCH];
+			valid = true;
+		}
+		else if ((op == 0x0f) && (avail >= 6) && (byte(1) >= 0x80) && (byte(1) <= 0x8f))
+		{
+			// Jcc rel32
+			insn.kind = drc_insn::JCC;
+			insn.condition = byte(1) & 0x0f;
+			insn.length = 6;
+			insn.value = eip + (offset - start) + 6 + dword(2);
+			insn.cycles = m_cycle_table_pm[CYCLES_JCC_FULL_DISP];
+			insn.nobranch_cycles = m_cycle_table_pm[CYCLES_JCC_FULL_DISP_NOBRANCH];
+			valid = true;
+		}
+
+		if (!valid)
+			break;
+		insns.push_back(insn);
+		offset += insn.length;
+		if ((insn.kind == drc_insn::JMP) || (insn.kind == drc_insn::JCC) || (offset >= 0x1000))
+			break;
+	}
+
+	// only store flags that aren't overwritten later in the block
+	uint8_t live = DRC_ALL_FLAGS;
+	for (auto it = insns.rbegin(); it != insns.rend(); ++it)
+	{
+		it->flags = it->written() & live;
+		live &= ~it->written();
+	}
+
+	// snapshot everything code generation needs, so that it can run on another thread
+	uint32_t const cpl = m_CPL;
+	uint32_t const cr0paging = m_cr[0] & 0x80000000;
+	std::vector<uint32_t> checksums;
+	for (uint32_t check = start & ~3; code && (check < offset); check += 4)
+	{
+		uint32_t expected;
+		memcpy(&expected, code + check, sizeof(expected));
+		checksums.push_back(expected);
+	}
+
+	auto const generate = [this, eip, cs_base, linear, paging, tlbentry, code, start, offset, cpl, cr0paging, insns, checksums] ()
+	{
+		bool succeeded = false;
+		while (!succeeded)
+		{
+			try
+			{
+				drcuml_block &block(m_drcuml->begin_block(64 + insns.size() * 16 + (offset - start)));
+				UML_HASH(block, 0, eip);                                                        // hash    0,eip
+
+				// nothing we can compile here, so go straight to the interpreter
+				if (insns.empty())
+				{
+					UML_EXIT(block, EXECUTE_INTERPRET);                                         // exit    EXECUTE_INTERPRET
+					block.end();
+					succeeded = true;
+					continue;
+				}
+
+				// make sure we're running what we compiled
+				UML_CMP(block, mem(&m_drc->cs_base), cs_base);                                  // cmp     [cs_base],cs_base
+				UML_EXITc(block, COND_NE, EXECUTE_MISSING_CODE);                                // exit    EXECUTE_MISSING_CODE,ne
+				UML_CMP(block, mem(&m_drc->cpl), cpl);                                          // cmp     [cpl],cpl
+				UML_EXITc(block, COND_NE, EXECUTE_MISSING_CODE);                                // exit    EXECUTE_MISSING_CODE,ne
+				UML_AND(block, I0, mem(&m_drc->cr0), 0x80000000);                               // and     i0,[cr0],0x80000000
+				UML_CMP(block, I0, cr0paging);                                                  // cmp     i0,paging
+				UML_EXITc(block, COND_NE, EXECUTE_MISSING_CODE);                                // exit    EXECUTE_MISSING_CODE,ne
+				if (paging)
+				{
+					UML_LOAD(block, I0, vtlb_table(), linear >> 12, SIZE_DWORD, SCALE_x4);      // load    i0,vtlb_table,linear >> 12,dword
+					UML_CMP(block, I0, tlbentry);                                               // cmp     i0,tlbentry
+					UML_EXITc(block, COND_NE, EXECUTE_MISSING_CODE);                            // exit    EXECUTE_MISSING_CODE,ne
+				}
+				for (uint32_t index = 0; index < checksums.size(); index++)
+				{
+					UML_LOAD(block, I0, code + (start & ~3) + (index * 4), 0, SIZE_DWORD, SCALE_x1); // load    i0,code,0,dword
+					UML_CMP(block, I0, checksums[index]);                                       // cmp     i0,expected
+					UML_EXITc(block, COND_NE, EXECUTE_MISSING_CODE);                            // exit    EXECUTE_MISSING_CODE,ne
+				}
+
+				// leave the block for the given EIP, chaining straight to its code if we have cycles left
+				auto const branch = [this, &block, cs_base] (uint32_t target, int cycles)
+				{
+					UML_MOV(block, mem(&m_drc->eip), target);                                   // mov     [eip],target
+					UML_MOV(block, mem(&m_drc->pc), cs_base + target);                          // mov     [pc],cs_base + target
+					UML_SUB(block, mem(&m_drc->cycles), mem(&m_drc->cycles), cycles);           // sub     [cycles],[cycles],cycles
+					UML_EXITc(block, COND_LE, EXECUTE_OUT_OF_CYCLES);                           // exit    EXECUTE_OUT_OF_CYCLES,le
+					UML_HASHJMP(block, 0, target, *m_drc_nocode);                               // hashjmp 0,target,nocode
+				};
+
+				uint32_t pc = eip;
+				int cycles = 0;
+				for (drc_insn const &insn : insns)
+				{
+					uml::parameter const dst(mem(&m_drc->reg[insn.dst]));
+					uml::parameter const src(insn.immediate ? uml::parameter(insn.value) : mem(&m_drc->reg[insn.src]));
+					pc += insn.length;
+
+					switch (insn.kind)
+					{
+					case drc_insn::NOP:
+						break;
+
+					case drc_insn::MOV:
+						UML_MOV(block, dst, src);                                               // mov     dst,src
+						break;
+
+					case drc_insn::ADD:
+					case drc_insn::SUB:
+					case drc_insn::CMP:
+					case drc_insn::INC:
+					case drc_insn::DEC:
+						UML_MOV(block, I0, dst);                                                // mov     i0,dst
+						UML_MOV(block, I1, ((insn.kind == drc_insn::INC) || (insn.kind == drc_insn::DEC)) ? uml::parameter(1) : src);
+						if ((insn.kind == drc_insn::ADD) || (insn.kind == drc_insn::INC))
+							UML_ADD(block, I2, I0, I1);                                         // add     i2,i0,i1
+						else
+							UML_SUB(block, I2, I0, I1);                                         // sub     i2,i0,i1
+						break;
+
+					case drc_insn::AND:
+					case drc_insn::TEST:
+						UML_AND(block, I2, dst, src);                                           // and     i2,dst,src
+						break;
+
+					case drc_insn::OR:
+						UML_OR(block, I2, dst, src);                                            // or      i2,dst,src
+						break;
+
+					case drc_insn::XOR:
+						UML_XOR(block, I2, dst, src);                                           // xor     i2,dst,src
+						break;
+
+					case drc_insn::JMP:
+						branch(insn.value, cycles + insn.cycles);
+						break;
+
+					case drc_insn::JCC:
+						{
+							// work out the condition into i0, then fall through if it's false
+							static const uint8_t condflags[8] = { DRC_OF, DRC_CF, DRC_ZF, DRC_CF | DRC_ZF, DRC_SF, DRC_PF, 0, 0 };
+							uint8_t const test = insn.condition >> 1;
+							if (test == 1)
+								UML_MOV(block, I0, mem(&m_drc->CF));                            // mov     i0,[cf]
+							else if (test == 3)
+								UML_OR(block, I0, mem(&m_drc->CF), mem(&m_drc->ZF));            // or      i0,[cf],[zf]
+							else if (test >= 6)
+								UML_XOR(block, I0, mem(&m_drc->SF), mem(&m_drc->OF));           // xor     i0,[sf],[of]
+							else
+								UML_MOV(block, I0, mem((condflags[test] == DRC_OF) ? &m_drc->OF : (condflags[test] == DRC_ZF) ? &m_drc->ZF : (condflags[test] == DRC_SF) ? &m_drc->SF : &m_drc->PF));
+							if (test == 7)
+								UML_OR(block, I0, I0, mem(&m_drc->ZF));                         // or      i0,i0,[zf]
+
+							code_label const skip = 1;
+							UML_TEST(block, I0, I0);                                            // test    i0,i0
+							UML_JMPc(block, (insn.condition & 1) ? COND_NZ : COND_Z, skip);     // jmp     skip,!cond
+							branch(insn.value, cycles + insn.cycles);
+							UML_LABEL(block, skip);                                             // skip:
+							branch(pc, cycles + insn.nobranch_cycles);
+						}
+						break;
+					}
+
+					// store the result and whatever flags are still needed
+					if ((insn.kind != drc_insn::NOP) && (insn.kind != drc_insn::MOV) && (insn.kind != drc_insn::JMP) && (insn.kind != drc_insn::JCC))
+					{
+						if (insn.flags & (DRC_CF | DRC_OF | DRC_SF | DRC_ZF))
+							UML_GETFLGS(block, I3, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);          // getflgs i3,CVZS
+						if ((insn.kind != drc_insn::CMP) && (insn.kind != drc_insn::TEST))
+							UML_MOV(block, dst, I2);                                            // mov     dst,i2
+						if (insn.flags & DRC_CF)
+						{
+							if (insn.logical())
+								UML_MOV(block, mem(&m_drc->CF), 0);                             // mov     [cf],0
+							else
+								UML_AND(block, mem(&m_drc->CF), I3, FLAG_C);                    // and     [cf],i3,C
+						}
+						if (insn.flags & DRC_OF)
+						{
+							if (insn.logical())
+								UML_MOV(block, mem(&m_drc->OF), 0);                             // mov     [of],0
+							else
+								UML_ROLAND(block, mem(&m_drc->OF), I3, 31, 1);                  // roland  [of],i3,31,1
+						}
+						if (insn.flags & DRC_ZF)
+							UML_ROLAND(block, mem(&m_drc->ZF), I3, 30, 1);                      // roland  [zf],i3,30,1
+						if (insn.flags & DRC_SF)
+							UML_ROLAND(block, mem(&m_drc->SF), I3, 29, 1);                      // roland  [sf],i3,29,1
+						if (insn.flags & DRC_PF)
+						{
+							UML_AND(block, I4, I2, 0xff);                                       // and     i4,i2,0xff
+							UML_LOAD(block, mem(&m_drc->PF), i386_parity_table, I4, SIZE_DWORD, SCALE_x4);
+						}
+						if (insn.flags & DRC_AF)
+						{
+							UML_XOR(block, I4, I2, I0);                                         // xor     i4,i2,i0
+							UML_XOR(block, I4, I4, I1);                                         // xor     i4,i4,i1
+							UML_ROLAND(block, mem(&m_drc->AF), I4, 28, 1);                      // roland  [af],i4,28,1
+						}
+					}
+					cycles += insn.cycles;
+				}
+
+				// ran off the end of what we could compile
+				drc_insn const &last(insns.back());
+				if ((last.kind != drc_insn::JMP) && (last.kind != drc_insn::JCC))
+					branch(pc, cycles);
+
+				block.end();
+				succeeded = true;
+			}
+			catch (drcuml_block::abort_compilation &)
+			{
+				drc_flush_cache();
+			}
+		}
+	};
+
+	// in asynchronous mode the interpreter carries on until the job is finished
+	if (m_drcuml->async())
+		m_drcuml->compile_async(generate);
+	else
+		generate();
+}
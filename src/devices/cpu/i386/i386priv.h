@@ -378,6 +378,14 @@ void i386_device::NEAR_BRANCH(int32_t offs)
 	m_pc += offs;
 }
 
+const uint8_t *i386_device::fetch_page(uint32_t address)
+{
+	fetch_page_entry &entry = m_fetch_pages[(address >> 12) & (FETCH_PAGES - 1)];
+	if (entry.page != (address & ~0xfff))
+		fetch_page_miss(entry, address & ~0xfff);
+	return entry.base;
+}
+
 uint8_t i386_device::FETCH()
 {
 	uint8_t value;
@@ -386,7 +394,9 @@ uint8_t i386_device::FETCH()
 	if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
 		PF_THROW(error);
 
-	value = m_pr8(address & m_a20_mask);
+	address &= m_a20_mask;
+	const uint8_t *base = fetch_page(address);
+	value = base ? base[(address & 0xfff) ^ m_fetch_xor8] : m_pr8(address);
 #ifdef DEBUG_MISSING_OPCODE
 	m_opcode_bytes[m_opcode_bytes_length] = value;
 	m_opcode_bytes_length = (m_opcode_bytes_length + 1) & 15;
@@ -407,7 +417,8 @@ uint16_t i386_device::FETCH16()
 		if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
 			PF_THROW(error);
 		address &= m_a20_mask;
-		value = m_pr16(address);
+		const uint8_t *base = fetch_page(address);
+		value = base ? *(const uint16_t *)&base[(address & 0xfff) ^ m_fetch_xor16] : m_pr16(address);
 		m_eip += 2;
 		m_pc += 2;
 	}
@@ -428,7 +439,15 @@ uint32_t i386_device::FETCH32()
 			PF_THROW(error);
 
 		address &= m_a20_mask;
-		value = m_pr32(address);
+		const uint8_t *base = fetch_page(address);
+		if (base)
+		{
+			uint32_t const offset = address & 0xfff;
+			value = *(const uint16_t *)&base[offset ^ m_fetch_xor16];
+			value |= *(const uint16_t *)&base[(offset + 2) ^ m_fetch_xor16] << 16;
+		}
+		else
+			value = m_pr32(address);
 		m_eip += 4;
 		m_pc += 4;
 	}
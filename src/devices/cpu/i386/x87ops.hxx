@@ -197,7 +197,7 @@ void i386_device::x87_reset()
  *
  *************************************/
 
-floatx80 i386_device::x87_add(floatx80 a, floatx80 b)
+floatx80 i386_device::x87_soft_add(floatx80 a, floatx80 b)
 {
 	floatx80 result = { 0 };
 
@@ -227,7 +227,7 @@ floatx80 i386_device::x87_add(floatx80 a, floatx80 b)
 	return result;
 }
 
-floatx80 i386_device::x87_sub(floatx80 a, floatx80 b)
+floatx80 i386_device::x87_soft_sub(floatx80 a, floatx80 b)
 {
 	floatx80 result = { 0 };
 
@@ -257,7 +257,7 @@ floatx80 i386_device::x87_sub(floatx80 a, floatx80 b)
 	return result;
 }
 
-floatx80 i386_device::x87_mul(floatx80 a, floatx80 b)
+floatx80 i386_device::x87_soft_mul(floatx80 a, floatx80 b)
 {
 	floatx80 val = { 0 };
 
@@ -288,7 +288,7 @@ floatx80 i386_device::x87_mul(floatx80 a, floatx80 b)
 }
 
 
-floatx80 i386_device::x87_div(floatx80 a, floatx80 b)
+floatx80 i386_device::x87_soft_div(floatx80 a, floatx80 b)
 {
 	floatx80 val = { 0 };
 
@@ -318,6 +318,130 @@ floatx80 i386_device::x87_div(floatx80 a, floatx80 b)
 }
 
 
+floatx80 i386_device::x87_soft_arith(int op, floatx80 a, floatx80 b)
+{
+	switch (op)
+	{
+		case X87_HOST_ADD:  return x87_soft_add(a, b);
+		case X87_HOST_SUB:  return x87_soft_sub(a, b);
+		case X87_HOST_MUL:  return x87_soft_mul(a, b);
+		default:            return x87_soft_div(a, b);
+	}
+}
+
+floatx80 i386_device::x87_host_arith(int op, floatx80 a, floatx80 b)
+{
+	int8 const saved_flags = float_exception_flags;
+	float_exception_flags = 0;
+
+	// the host is only ever left in round-to-nearest
+	floatx80 result = { 0 };
+	bool handled = false, inexact = false;
+	if (((m_x87_cw >> X87_CW_RC_SHIFT) & X87_CW_RC_MASK) == X87_CW_RC_NEAREST)
+	{
+		switch ((m_x87_cw >> X87_CW_PC_SHIFT) & X87_CW_PC_MASK)
+		{
+			case X87_CW_PC_SINGLE:
+			{
+#if X87_HOST_NARROW
+				float32 a32 = floatx80_to_float32(a);
+				float32 b32 = floatx80_to_float32(b);
+				float fa, fb, fr;
+				memcpy(&fa, &a32, sizeof(fa));
+				memcpy(&fb, &b32, sizeof(fb));
+				if (x87_host_compute(op, fa, fb, fr, inexact))
+				{
+					float32 r32;
+					memcpy(&r32, &fr, sizeof(r32));
+					result = float32_to_floatx80(r32);
+					handled = true;
+				}
+#endif
+				break;
+			}
+			case X87_CW_PC_DOUBLE:
+			{
+#if X87_HOST_NARROW
+				float64 a64 = floatx80_to_float64(a);
+				float64 b64 = floatx80_to_float64(b);
+				double da, db, dr;
+				memcpy(&da, &a64, sizeof(da));
+				memcpy(&db, &b64, sizeof(db));
+				if (x87_host_compute(op, da, db, dr, inexact))
+				{
+					float64 r64;
+					memcpy(&r64, &dr, sizeof(r64));
+					result = float64_to_floatx80(r64);
+					handled = true;
+				}
+#endif
+				break;
+			}
+			case X87_CW_PC_EXTEND:
+			{
+#if X87_HOST_EXTENDED
+				long double lr;
+				if (floatx80_is_host_safe(a) && floatx80_is_host_safe(b) && x87_host_compute(op, fx80_to_host(a), fx80_to_host(b), lr, inexact))
+				{
+					result = host_to_fx80(lr);
+					handled = true;
+				}
+#endif
+				break;
+			}
+		}
+	}
+
+	int8 const host_flags = float_exception_flags | (inexact ? float_flag_inexact : 0);
+	if (handled && (m_x87_mode == x87_mode::HOST))
+	{
+		float_exception_flags = saved_flags | host_flags;
+		return result;
+	}
+
+	// fall back to softfloat, checking the host result against it if asked to
+	float_exception_flags = 0;
+	floatx80 const soft = x87_soft_arith(op, a, b);
+	if (handled && ((result.high != soft.high) || (result.low != soft.low) || (host_flags != float_exception_flags)))
+	{
+		static char const *const names[] = { "add", "sub", "mul", "div" };
+		m_x87_divergences++;
+		logerror("x87 %s divergence (CW:%04x): %04x:%016x, %04x:%016x = host %04x:%016x flags %02x, soft %04x:%016x flags %02x\n",
+				names[op], m_x87_cw, a.high, a.low, b.high, b.low, result.high, result.low, host_flags, soft.high, soft.low, float_exception_flags);
+	}
+	float_exception_flags |= saved_flags;
+	return soft;
+}
+
+floatx80 i386_device::x87_add(floatx80 a, floatx80 b)
+{
+	if (m_x87_mode != x87_mode::SOFT)
+		return x87_host_arith(X87_HOST_ADD, a, b);
+	return x87_soft_add(a, b);
+}
+
+floatx80 i386_device::x87_sub(floatx80 a, floatx80 b)
+{
+	if (m_x87_mode != x87_mode::SOFT)
+		return x87_host_arith(X87_HOST_SUB, a, b);
+	return x87_soft_sub(a, b);
+}
+
+floatx80 i386_device::x87_mul(floatx80 a, floatx80 b)
+{
+	if (m_x87_mode != x87_mode::SOFT)
+		return x87_host_arith(X87_HOST_MUL, a, b);
+	return x87_soft_mul(a, b);
+}
+
+floatx80 i386_device::x87_div(floatx80 a, floatx80 b)
+{
+	if (m_x87_mode != x87_mode::SOFT)
+		return x87_host_arith(X87_HOST_DIV, a, b);
+	return x87_soft_div(a, b);
+}
+
+
 /*************************************
  *
  * Instructions
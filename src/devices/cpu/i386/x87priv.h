@@ -5,6 +5,9 @@
 #ifndef __X87PRIV_H__
 #define __X87PRIV_H__
 
+#include <cfenv>
+#include <cfloat>
+#include <cstring>
 #include <math.h>
 
 
@@ -150,6 +153,90 @@ static inline floatx80 double_to_fx80(double in)
 	return float64_to_floatx80(*(uint64_t*)&in);
 }
 
+/*************************************
+ *
+ * Host FPU support
+ *
+ *************************************/
+
+// x86 hosts with a 64-bit long double mantissa use the same 80-bit format
+#if (defined(__i386__) || defined(__x86_64__)) && (LDBL_MANT_DIG == 64)
+#define X87_HOST_EXTENDED       1
+#else
+#define X87_HOST_EXTENDED       0
+#endif
+
+// single and double results are only exact if the host doesn't evaluate them wider
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+#define X87_HOST_NARROW         1
+#else
+#define X87_HOST_NARROW         0
+#endif
+
+enum
+{
+	X87_HOST_ADD,
+	X87_HOST_SUB,
+	X87_HOST_MUL,
+	X87_HOST_DIV
+};
+
+static inline bool floatx80_is_host_safe(floatx80 fx)
+{
+	// zeroes, or normal numbers with the explicit integer bit set
+	int const exp = fx.high & 0x7fff;
+	if (exp == 0)
+		return fx.low == 0;
+	return (exp != 0x7fff) && (fx.low & 0x8000000000000000U);
+}
+
+#if X87_HOST_EXTENDED
+static inline long double fx80_to_host(floatx80 fx)
+{
+	long double result = 0;
+	memcpy(&result, &fx.low, 8);
+	memcpy((uint8_t *)&result + 8, &fx.high, 2);
+	return result;
+}
+
+static inline floatx80 host_to_fx80(long double in)
+{
+	floatx80 result;
+	memcpy(&result.low, &in, 8);
+	memcpy(&result.high, (uint8_t *)&in + 8, 2);
+	return result;
+}
+#endif
+
+template <typename T>
+static inline bool x87_host_compute(int op, T a, T b, T &result, bool &inexact)
+{
+	// leave denormals, infinities and NaNs to softfloat
+	int const ca = std::fpclassify(a), cb = std::fpclassify(b);
+	if (((ca != FP_NORMAL) && (ca != FP_ZERO)) || ((cb != FP_NORMAL) && (cb != FP_ZERO)))
+		return false;
+
+	std::feclearexcept(FE_ALL_EXCEPT);
+	volatile T value;
+	switch (op)
+	{
+		case X87_HOST_ADD:  value = a + b;  break;
+		case X87_HOST_SUB:  value = a - b;  break;
+		case X87_HOST_MUL:  value = a * b;  break;
+		default:            value = a / b;  break;
+	}
+	result = value;
+
+	// anything beyond an inexact result needs softfloat's exception handling
+	if (std::fetestexcept(FE_ALL_EXCEPT & ~FE_INEXACT))
+		return false;
+	int const cr = std::fpclassify(result);
+	if ((cr != FP_NORMAL) && (cr != FP_ZERO))
+		return false;
+	inexact = std::fetestexcept(FE_INEXACT) != 0;
+	return true;
+}
+
 floatx80 i386_device::READ80(uint32_t ea)
 {
 	floatx80 t;
@@ -40,6 +40,9 @@ void deco16_device::device_start()
 
 	init();
 
+	if(!cache_disabled)
+		mintf->enable_pages();
+
 	io = &space(AS_IO);
 }
 
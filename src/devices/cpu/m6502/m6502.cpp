@@ -38,6 +38,10 @@ void m6502_device::device_start()
 		mintf = std::make_unique<mi_default_normal>();
 
 	init();
+
+	// the default interface has no side effects, so plain memory can be accessed directly
+	if(!cache_disabled)
+		mintf->enable_pages();
 }
 
 void m6502_device::init()
@@ -477,7 +481,7 @@ void m6502_device::prefetch()
 	sync = true;
 	sync_w(ASSERT_LINE);
 	NPC = PC;
-	IR = mintf->read_sync(PC);
+	IR = read_sync(PC);
 	sync = false;
 	sync_w(CLEAR_LINE);
 
@@ -493,7 +497,7 @@ void m6502_device::prefetch_noirq()
 	sync = true;
 	sync_w(ASSERT_LINE);
 	NPC = PC;
-	IR = mintf->read_sync(PC);
+	IR = read_sync(PC);
 	sync = false;
 	sync_w(CLEAR_LINE);
 	PC++;
@@ -513,6 +517,65 @@ std::unique_ptr<util::disasm_interface> m6502_device::create_disassembler()
 	return std::make_unique<m6502_disassembler>();
 }
 
+m6502_device::memory_interface::memory_interface() : pages_enabled(false)
+{
+	// with nothing to look up, every access goes to the handlers
+	std::fill(std::begin(read_pages), std::end(read_pages), nullptr);
+	std::fill(std::begin(sync_pages), std::end(sync_pages), nullptr);
+	std::fill(std::begin(write_pages), std::end(write_pages), nullptr);
+	std::fill(std::begin(page_resolved), std::end(page_resolved), true);
+}
+
+void m6502_device::memory_interface::enable_pages()
+{
+	// the debugger has to see every access, so leave it all on the handlers
+	if(program->device().machine().debug_flags & DEBUG_FLAG_ENABLED)
+		return;
+
+	// start again whenever the address map changes or a bank switches
+	auto invalidate = [this](read_or_write mode) { invalidate_pages(); };
+	program->add_change_notifier(invalidate);
+	program->add_bank_notifier(invalidate);
+	if(sprogram != program) {
+		sprogram->add_change_notifier(invalidate);
+		sprogram->add_bank_notifier(invalidate);
+	}
+
+	pages_enabled = true;
+	invalidate_pages();
+}
+
+void m6502_device::memory_interface::invalidate_pages()
+{
+	if(!pages_enabled)
+		return;
+	std::fill(std::begin(read_pages), std::end(read_pages), nullptr);
+	std::fill(std::begin(sync_pages), std::end(sync_pages), nullptr);
+	std::fill(std::begin(write_pages), std::end(write_pages), nullptr);
+	std::fill(std::begin(page_resolved), std::end(page_resolved), false);
+}
+
+void m6502_device::memory_interface::resolve_page(int page)
+{
+	// a page is only usable if every byte of it is in one contiguous block of host memory,
+	// so a handler or tap anywhere in it keeps the whole page on the normal path
+	offs_t const base = page << 8;
+	auto page_ptr = [base](auto const &get) -> uint8_t * {
+		uint8_t *const start = static_cast<uint8_t *>(get(base));
+		if(!start)
+			return nullptr;
+		for(offs_t offset = 1; offset <= 0xff; offset++)
+			if(get(base | offset) != start + offset)
+				return nullptr;
+		return start;
+	};
+
+	read_pages[page] = page_ptr([this](offs_t adr) { return program->get_read_ptr(adr); });
+	sync_pages[page] = page_ptr([this](offs_t adr) { return sprogram->get_read_ptr(adr); });
+	write_pages[page] = page_ptr([this](offs_t adr) { return program->get_write_ptr(adr); });
+	page_resolved[page] = true;
+}
+
 uint8_t m6502_device::memory_interface::read_9(uint16_t adr)
 {
 	return read(adr);
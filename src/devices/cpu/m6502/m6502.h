@@ -37,7 +37,22 @@ protected:
 		address_space *program, *sprogram;
 		memory_access_cache<0, 0, ENDIANNESS_LITTLE> *cache, *scache;
 
+		// host pointers for 256-byte pages that are plain memory, looked up
+		// on first use; only interfaces without side effects enable them
+		const uint8_t *read_pages[0x100], *sync_pages[0x100];
+		uint8_t *write_pages[0x100];
+		bool page_resolved[0x100];
+		bool pages_enabled;
+
+		memory_interface();
 		virtual ~memory_interface() {}
+		void enable_pages();
+		void invalidate_pages();
+		void resolve_page(int page);
+
+		const uint8_t *read_page(uint16_t adr) { int const page = adr >> 8; if(!page_resolved[page]) resolve_page(page); return read_pages[page]; }
+		const uint8_t *sync_page(uint16_t adr) { int const page = adr >> 8; if(!page_resolved[page]) resolve_page(page); return sync_pages[page]; }
+		uint8_t *write_page(uint16_t adr) { int const page = adr >> 8; if(!page_resolved[page]) resolve_page(page); return write_pages[page]; }
 		virtual uint8_t read(uint16_t adr) = 0;
 		virtual uint8_t read_9(uint16_t adr);
 		virtual uint8_t read_sync(uint16_t adr) = 0;
@@ -124,13 +139,14 @@ protected:
 	bool nmi_state, irq_state, apu_irq_state, v_state;
 	bool irq_taken, sync, cache_disabled, inhibit_interrupts;
 
-	uint8_t read(uint16_t adr) { return mintf->read(adr); }
+	uint8_t read(uint16_t adr) { const uint8_t *page = mintf->read_page(adr); return page ? page[adr & 0xff] : mintf->read(adr); }
 	uint8_t read_9(uint16_t adr) { return mintf->read_9(adr); }
-	void write(uint16_t adr, uint8_t val) { mintf->write(adr, val); }
+	void write(uint16_t adr, uint8_t val) { uint8_t *page = mintf->write_page(adr); if(page) page[adr & 0xff] = val; else mintf->write(adr, val); }
 	void write_9(uint16_t adr, uint8_t val) { mintf->write_9(adr, val); }
-	uint8_t read_arg(uint16_t adr) { return mintf->read_arg(adr); }
-	uint8_t read_pc() { return mintf->read_arg(PC++); }
-	uint8_t read_pc_noinc() { return mintf->read_arg(PC); }
+	uint8_t read_sync(uint16_t adr) { const uint8_t *page = mintf->sync_page(adr); return page ? page[adr & 0xff] : mintf->read_sync(adr); }
+	uint8_t read_arg(uint16_t adr) { const uint8_t *page = mintf->read_page(adr); return page ? page[adr & 0xff] : mintf->read_arg(adr); }
+	uint8_t read_pc() { return read_arg(PC++); }
+	uint8_t read_pc_noinc() { return read_arg(PC); }
 	void prefetch();
 	void prefetch_noirq();
 	void set_nz(uint8_t v);
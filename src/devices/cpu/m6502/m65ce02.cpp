@@ -50,6 +50,9 @@ void m65ce02_device::device_start()
 		mintf = std::make_unique<mi_default_normal>();
 
 	init();
+
+	if(!cache_disabled)
+		mintf->enable_pages();
 }
 
 void m65ce02_device::device_reset()
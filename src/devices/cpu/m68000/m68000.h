@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "cpu/drcuml.h"
+
 // SoftFloat 2 lacks an include guard
 #ifndef softfloat_h
 #define softfloat_h 1
@@ -298,6 +300,23 @@ protected:
 	uint32_t m_ic_data[M68K_IC_SIZE];      /* instruction cache content data */
 	bool   m_ic_valid[M68K_IC_SIZE];     /* instruction cache valid flags */
 
+	/* recompiler state, kept near the code cache */
+	struct drc_state
+	{
+		uint32_t dar[16];
+		uint32_t pc;
+		uint32_t ppc;
+		int32_t  cycles;
+		uint32_t x_flag, n_flag, not_z_flag, v_flag, c_flag;
+	};
+
+	std::unique_ptr<drc_cache>    m_drc_cache;
+	std::unique_ptr<drcuml_state> m_drcuml;
+	drc_state *m_drc;
+	uml::code_handle *m_drc_entry;
+	uml::code_handle *m_drc_nocode;
+	int m_drc_misses;
+
 
 
 	/* 68307 / 68340 internal address map */
@@ -323,6 +342,13 @@ protected:
 	void init_cpu_scc68070(void);
 	void init_cpu_coldfire(void);
 
+	/* recompiler (m68kdrc.hxx) */
+	void drc_init();
+	void drc_flush_cache();
+	bool drc_usable() const;
+	bool drc_execute();
+	void drc_compile_block(uint32_t pc);
+
 
 	void m68ki_exception_interrupt(uint32_t int_level);
 
@@ -95,7 +95,7 @@ static unsigned char m68ki_cycles[NUM_CPU_TYPES][0x10000]; /* Cycles used by CPU
 /* This is used to generate the opcode handler jump table */
 struct opcode_handler_struct
 {
-	opcode_handler_ptr opcode_handler;   /* handler function */
+	opcode_handler_ptr opcode_handler[NUM_CPU_TYPES]; /* handler function for each cpu type */
 	unsigned int  mask;                  /* mask on opcode */
 	unsigned int  match;                 /* what to match after masking */
 	unsigned char cycles[NUM_CPU_TYPES]; /* cycles each cpu type takes */
@@ -138,7 +138,7 @@ void m68000_base_device::m68ki_set_one(unsigned short opcode, const opcode_handl
 	for(int i=0; i<NUM_CPU_TYPES; i++)
 		if(s->cycles[i] != 0xff) {
 			m68ki_cycles[i][opcode] = s->cycles[i];
-			m68ki_instruction_jump_table[i][opcode] = s->opcode_handler;
+			m68ki_instruction_jump_table[i][opcode] = s->opcode_handler[i];
 		}
 }
 
@@ -154,7 +154,7 @@ static const opcode_handler_struct m68k_opcode_handler_table[] =
 XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
 M68KMAKE_TABLE_FOOTER
 
-	{nullptr, 0, 0, {0, 0, 0, 0, 0}}
+	{{nullptr}, 0, 0, {0, 0, 0, 0, 0}}
 };
 
 
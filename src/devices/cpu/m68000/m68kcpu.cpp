@@ -29,6 +29,8 @@ static const char copyright_notice[] =
 #include "m68000.h"
 #include "m68kdasm.h"
 
+#include "cpu/drcumlsh.h"
+
 /* ======================================================================== */
 /* ================================= DATA ================================= */
 /* ======================================================================== */
@@ -797,6 +799,10 @@ void m68000_base_device::execute_run()
 		/* Main loop.  Keep going until we run out of clock cycles */
 		while (m_remaining_cycles > 0)
 		{
+			/* Run compiled code where we can */
+			if (m_drcuml && drc_usable() && drc_execute())
+				continue;
+
 			/* Set tracing accodring to T1. (T0 is done inside instruction) */
 			m68ki_trace_t1(); /* auto-disable (see m68kcpu.h) */
 
@@ -994,6 +1000,7 @@ void m68000_base_device::init_cpu_common(void)
 	set_icountptr(m_remaining_cycles);
 	m_remaining_cycles = 0;
 
+	drc_init();
 }
 
 void m68000_base_device::device_reset()
@@ -2621,3 +2628,6 @@ void mcf5206e_device::device_start()
 {
 	init_cpu_coldfire();
 }
+
+
+#include "m68kdrc.hxx"
@@ -232,6 +232,38 @@ inline uint32_t CPU_TYPE_IS_010_LESS() const    { return ((m_cpu_type) & (CPU_TY
 
 inline uint32_t CPU_TYPE_IS_000() const         { return ((m_cpu_type) == CPU_TYPE_000 || (m_cpu_type) == CPU_TYPE_008); }
 
+/* CPU types sharing each opcode jump table */
+static constexpr uint32_t m68ki_cpu_table_types(int table)
+{
+	return (table == 0) ? (CPU_TYPE_000 | CPU_TYPE_008) :
+			(table == 1) ? (CPU_TYPE_010 | CPU_TYPE_SCC070) :
+			(table == 2) ? (CPU_TYPE_EC020 | CPU_TYPE_020) :
+			(table == 3) ? (CPU_TYPE_EC030 | CPU_TYPE_030) :
+			(table == 4) ? (CPU_TYPE_EC040 | CPU_TYPE_LC040 | CPU_TYPE_040) :
+			(table == 5) ? CPU_TYPE_FSCPU32 :
+			CPU_TYPE_COLDFIRE;
+}
+
+/* Type checks for opcode handlers specialised on their jump table; these
+   are compile-time constants unless the types sharing the table disagree */
+template <int CpuTable> inline uint32_t m68ki_cpu_type_is(uint32_t types) const
+{
+	constexpr uint32_t table_types = m68ki_cpu_table_types(CpuTable);
+	return ((table_types & types) == table_types) ? 1 : !(table_types & types) ? 0 : (m_cpu_type & types);
+}
+
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_COLDFIRE() const    { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_COLDFIRE); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_040_PLUS() const    { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_040 | CPU_TYPE_EC040); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_030_PLUS() const    { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_030 | CPU_TYPE_EC030 | CPU_TYPE_040 | CPU_TYPE_EC040); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_020_PLUS() const    { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_020 | CPU_TYPE_030 | CPU_TYPE_EC030 | CPU_TYPE_040 | CPU_TYPE_EC040 | CPU_TYPE_FSCPU32 | CPU_TYPE_COLDFIRE); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_020_VARIANT() const { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_EC020 | CPU_TYPE_020 | CPU_TYPE_FSCPU32); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_EC020_PLUS() const  { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_EC020 | CPU_TYPE_020 | CPU_TYPE_030 | CPU_TYPE_EC030 | CPU_TYPE_040 | CPU_TYPE_EC040 | CPU_TYPE_FSCPU32 | CPU_TYPE_COLDFIRE); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_EC020_LESS() const  { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_000 | CPU_TYPE_008 | CPU_TYPE_010 | CPU_TYPE_EC020); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_010() const         { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_010); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_010_PLUS() const    { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_010 | CPU_TYPE_EC020 | CPU_TYPE_020 | CPU_TYPE_EC030 | CPU_TYPE_030 | CPU_TYPE_040 | CPU_TYPE_EC040 | CPU_TYPE_FSCPU32 | CPU_TYPE_COLDFIRE); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_010_LESS() const    { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_000 | CPU_TYPE_008 | CPU_TYPE_010); }
+template <int CpuTable> inline uint32_t CPU_TYPE_IS_000() const         { return m68ki_cpu_type_is<CpuTable>(CPU_TYPE_000 | CPU_TYPE_008); }
+
 
 /* Initiates trace checking before each instruction (t1) */
 inline void m68ki_trace_t1() { m_tracing = m_t1_flag; }
@@ -0,0 +1,545 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    m68kdrc.hxx
+
+    Dynamic recompiler for the 68000 family.
+
+    Only straight-line runs of register-to-register long word integer
+    instructions and Bcc/BRA are recompiled.  Anything else ends the
+    block and is handed back to the Musashi interpreter, so compiled
+    code never accesses memory through the address space and can't
+    raise a bus or address error.  Cycle counts come from the same
+    per-opcode tables the interpreter uses.
+
+    Blocks are hashed by PC and check on entry that the code bytes they
+    were compiled from are unchanged, which catches self-modifying code
+    and bank switches that keep the same host memory.  The recompiler is
+    bypassed while an MMU is enabled or trace mode is active.
+
+***************************************************************************/
+
+namespace {
+
+// exit codes from compiled code
+enum
+{
+	EXECUTE_OUT_OF_CYCLES = 0,
+	EXECUTE_CONTINUE,
+	EXECUTE_MISSING_CODE,
+	EXECUTE_INTERPRET
+};
+
+constexpr size_t DRC_CACHE_SIZE = 8 * 1024 * 1024;
+constexpr int DRC_MAX_INSTRUCTIONS = 64;
+
+// condition code flags, for working out which ones each instruction must store
+enum : uint8_t
+{
+	DRC_XF = 0x01,
+	DRC_NF = 0x02,
+	DRC_ZF = 0x04,
+	DRC_VF = 0x08,
+	DRC_CF = 0x10,
+	DRC_ALL_FLAGS = 0x1f
+};
+
+// a decoded instruction
+struct drc_insn
+{
+	enum kind_t : uint8_t { NOP, MOVE, MOVEA, ADD, ADDA, SUB, SUBA, CMP, AND, OR, EOR, TST, BRA, BCC };
+
+	kind_t kind;
+	uint8_t dst;            // destination register, 0-15 as in m_dar
+	uint8_t src;            // source register when not immediate
+	bool immediate;         // source is an immediate
+	uint32_t value;         // immediate value, or branch target PC
+	uint8_t condition;      // condition code for BCC
+	uint8_t length;         // length in bytes
+	int cycles;             // cycles taken, including the branch if any
+	int nobranch_cycles;    // cycles taken by a BCC that falls through
+	uint8_t flags;          // flags that must be stored
+
+	uint8_t written() const
+	{
+		switch (kind)
+		{
+		case ADD: case SUB:                                     return DRC_ALL_FLAGS;
+		case CMP: case MOVE: case AND: case OR: case EOR: case TST: return DRC_ALL_FLAGS & ~DRC_XF;
+		default:                                                return 0;
+		}
+	}
+	bool arithmetic() const { return (kind == ADD) || (kind == SUB) || (kind == CMP); }
+};
+
+} // anonymous namespace
+
+
+
+/***************************************************************************
+    SETUP
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_init - set up the recompiler if it's
+    allowed
+-------------------------------------------------*/
+
+void m68000_base_device::drc_init()
+{
+	m_drc = nullptr;
+	m_drc_entry = nullptr;
+	m_drc_nocode = nullptr;
+	m_drc_misses = 0;
+
+	// the debugger needs to see every instruction
+	if (!allow_drc() || (machine().debug_flags & DEBUG_FLAG_ENABLED))
+		return;
+
+	m_drc_cache = std::make_unique<drc_cache>(DRC_CACHE_SIZE + sizeof(drc_state));
+	m_drc = reinterpret_cast<drc_state *>(m_drc_cache->alloc_near(sizeof(drc_state)));
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drc_cache, 0, 1, 32, 1);
+
+	m_drcuml->symbol_add(&m_drc->dar[0], sizeof(m_drc->dar), "dar");
+	m_drcuml->symbol_add(&m_drc->pc, sizeof(m_drc->pc), "pc");
+	m_drcuml->symbol_add(&m_drc->cycles, sizeof(m_drc->cycles), "cycles");
+
+	m_drc_entry = m_drcuml->handle_alloc("entry");
+	m_drc_nocode = m_drcuml->handle_alloc("nocode");
+	drc_flush_cache();
+
+	// blocks read their code through host pointers taken when they were compiled,
+	// so throw everything away when the map changes or a bank switches
+	auto flush = [this] (read_or_write mode) { drc_flush_cache(); };
+	m_oprogram->add_change_notifier(flush);
+	m_oprogram->add_bank_notifier(flush);
+}
+
+
+/*-------------------------------------------------
+    drc_flush_cache - empty the cache and
+    regenerate the static code
+-------------------------------------------------*/
+
+void m68000_base_device::drc_flush_cache()
+{
+	m_drcuml->reset();
+
+	try
+	{
+		// look up the block for the current PC
+		drcuml_block &entry(m_drcuml->begin_block(4));
+		UML_HANDLE(entry, *m_drc_entry);                                        // handle  entry
+		UML_HASHJMP(entry, 0, mem(&m_drc->pc), *m_drc_nocode);                  // hashjmp 0,<pc>,nocode
+		entry.end();
+
+		// or ask for it to be compiled
+		drcuml_block &nocode(m_drcuml->begin_block(4));
+		UML_HANDLE(nocode, *m_drc_nocode);                                      // handle  nocode
+		UML_EXIT(nocode, EXECUTE_MISSING_CODE);                                 // exit    EXECUTE_MISSING_CODE
+		nocode.end();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unrecoverable error generating 68000 static code\n");
+	}
+}
+
+
+
+/***************************************************************************
+    EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_usable - return true if the current state
+    is one compiled code can run in
+-------------------------------------------------*/
+
+bool m68000_base_device::drc_usable() const
+{
+	return !m_pmmu_enabled && !m_hmmu_enabled && !m_t1_flag && !m_t0_flag && !m_stopped && !m_address_error && !(m_pc & 1);
+}
+
+
+/*-------------------------------------------------
+    drc_execute - run compiled code from the
+    current PC; returns false if the caller
+    should interpret an instruction instead
+-------------------------------------------------*/
+
+bool m68000_base_device::drc_execute()
+{
+	// mirror the state compiled code works on into the near cache
+	drc_state &state(*m_drc);
+	std::copy(std::begin(m_dar), std::end(m_dar), std::begin(state.dar));
+	state.pc = m_pc;
+	state.ppc = m_ppc;
+	state.cycles = m_remaining_cycles;
+	state.x_flag = m_x_flag;
+	state.n_flag = m_n_flag;
+	state.not_z_flag = m_not_z_flag;
+	state.v_flag = m_v_flag;
+	state.c_flag = m_c_flag;
+
+	int const result = m_drcuml->execute(*m_drc_entry);
+
+	std::copy(std::begin(state.dar), std::end(state.dar), std::begin(m_dar));
+	m_pc = state.pc;
+	m_ppc = state.ppc;
+	m_remaining_cycles = state.cycles;
+	m_x_flag = state.x_flag;
+	m_n_flag = state.n_flag;
+	m_not_z_flag = state.not_z_flag;
+	m_v_flag = state.v_flag;
+	m_c_flag = state.c_flag;
+
+	switch (result)
+	{
+	case EXECUTE_MISSING_CODE:
+		// compile it once; if it still won't run, let the interpreter have it
+		if (++m_drc_misses == 1)
+		{
+			drc_compile_block(m_pc);
+			return true;
+		}
+		m_drc_misses = 0;
+		return false;
+
+	case EXECUTE_INTERPRET:
+		m_drc_misses = 0;
+		return false;
+
+	default:
+		m_drc_misses = 0;
+		return true;
+	}
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_compile_block - compile a block starting
+    at the given PC
+-------------------------------------------------*/
+
+void m68000_base_device::drc_compile_block(uint32_t pc)
+{
+	using namespace uml;
+
+	// find the code page in host memory; without one there's nothing to checksum
+	offs_t const address = pc & m_oprogram->addrmask();
+	// every bus unit of the page has to be in the same block, so a handler or tap anywhere in it rules it out
+	uint8_t const *code = (pc & 1) ? nullptr : reinterpret_cast<uint8_t const *>(m_oprogram->get_read_ptr(address & ~0xfff));
+	uint32_t const unit = m_oprogram->data_width() / 8;
+	for (uint32_t offset = unit; code && (offset < 0x1000); offset += unit)
+		if (m_oprogram->get_read_ptr((address & ~0xfff) + offset) != (code + offset))
+			code = nullptr;
+
+	// fetch a big-endian word the way the bus lays it out in host memory
+	int const width = m_oprogram->data_width();
+	auto const word = [code, width] (uint32_t offset) -> uint16_t
+	{
+		if (width == 8)
+			return (code[offset] << 8) | code[offset + 1];
+		return *reinterpret_cast<uint16_t const *>(code + ((width == 32) ? WORD_XOR_BE(offset) : offset));
+	};
+
+	// decode as much as we can handle, stopping at a branch or the end of the page
+	std::vector<drc_insn> insns;
+	uint32_t const start = address & 0xfff;
+	uint32_t offset = start;
+	while (code && (insns.size() < DRC_MAX_INSTRUCTIONS) && ((offset + 2) <= 0x1000))
+	{
+		uint32_t const avail = 0x1000 - offset;
+		uint16_t const op = word(offset);
+		uint32_t const insnpc = pc + (offset - start);
+
+		drc_insn insn = { drc_insn::NOP, 0, 0, false, 0, 0, 2, m_cyc_instruction[op], 0, 0 };
+		bool valid = true;
+
+		// the mask keeps Dy and Ay sources together; AND, OR and EOR only take Dy, since An is
+		// illegal for AND and OR and the EOR pattern with An is CMPM
+		switch (op & 0xf1f0)
+		{
+		case 0x2000:    insn.kind = drc_insn::MOVE;     break;  // MOVE.L Ry,Dx
+		case 0x2040:    insn.kind = drc_insn::MOVEA;    break;  // MOVEA.L Ry,Ax
+		case 0xd080:    insn.kind = drc_insn::ADD;      break;  // ADD.L Ry,Dx
+		case 0xd1c0:    insn.kind = drc_insn::ADDA;     break;  // ADDA.L Ry,Ax
+		case 0x9080:    insn.kind = drc_insn::SUB;      break;  // SUB.L Ry,Dx
+		case 0x91c0:    insn.kind = drc_insn::SUBA;     break;  // SUBA.L Ry,Ax
+		case 0xb080:    insn.kind = drc_insn::CMP;      break;  // CMP.L Ry,Dx
+		case 0xc080:    insn.kind = drc_insn::AND;      valid = ((op & 0xf1f8) == 0xc080);  break;  // AND.L Dy,Dx
+		case 0x8080:    insn.kind = drc_insn::OR;       valid = ((op & 0xf1f8) == 0x8080);  break;  // OR.L Dy,Dx
+		case 0xb180:    insn.kind = drc_insn::EOR;      valid = ((op & 0xf1f8) == 0xb180);  break;  // EOR.L Dx,Dy
+		case 0x5080:    insn.kind = (op & 8) ? drc_insn::ADDA : drc_insn::ADD; break;   // ADDQ.L #q,Ry
+		case 0x5180:    insn.kind = (op & 8) ? drc_insn::SUBA : drc_insn::SUB; break;   // SUBQ.L #q,Ry
+		default:        valid = false;                  break;
+		}
+
+		if (valid)
+		{
+			if ((op & 0xf000) == 0x5000)
+			{
+				insn.dst = op & 0x0f;
+				insn.immediate = true;
+				insn.value = (((op >> 9) - 1) & 7) + 1;
+			}
+			else if (insn.kind == drc_insn::EOR)
+			{
+				insn.dst = op & 7;
+				insn.src = (op >> 9) & 7;
+			}
+			else
+			{
+				insn.dst = ((op >> 9) & 7) | (((insn.kind == drc_insn::MOVEA) || (insn.kind == drc_insn::ADDA) || (insn.kind == drc_insn::SUBA)) ? 8 : 0);
+				insn.src = op & 0x0f;
+			}
+		}
+		else if ((op & 0xf100) == 0x7000)
+		{
+			// MOVEQ #imm,Dx
+			insn.kind = drc_insn::MOVE;
+			insn.dst = (op >> 9) & 7;
+			insn.immediate = true;
+			insn.value = uint32_t(int32_t(int8_t(op & 0xff)));
+			valid = true;
+		}
+		else if ((op & 0xfff8) == 0x4a80)
+		{
+			// TST.L Dy
+			insn.kind = drc_insn::TST;
+			insn.dst = op & 7;
+			valid = true;
+		}
+		else if (op == 0x4e71)
+		{
+			valid = true;
+		}
+		else if (((op & 0xf000) == 0x6000) && ((op & 0x0f00) != 0x0100))
+		{
+			// BRA and Bcc with byte, word or (68020 and up) long displacements
+			uint32_t disp = uint32_t(int32_t(int8_t(op & 0xff)));
+			if (((op & 0xff) == 0x00) && (avail >= 4))
+			{
+				disp = uint32_t(int32_t(int16_t(word(offset + 2))));
+				insn.length = 4;
+				insn.nobranch_cycles = insn.cycles + int32_t(m_cyc_bcc_notake_w);
+				valid = true;
+			}
+			else if (((op & 0xff) == 0xff) && CPU_TYPE_IS_EC020_PLUS() && (avail >= 6))
+			{
+				disp = (uint32_t(word(offset + 2)) << 16) | word(offset + 4);
+				insn.length = 6;
+				insn.nobranch_cycles = insn.cycles;
+				valid = true;
+			}
+			else if (((op & 0xff) != 0x00) && ((op & 0xff) != 0xff))
+			{
+				insn.nobranch_cycles = insn.cycles + int32_t(m_cyc_bcc_notake_b);
+				valid = true;
+			}
+			insn.kind = (op & 0x0f00) ? drc_insn::BCC : drc_insn::BRA;
+			insn.condition = (op >> 8) & 0x0f;
+			insn.value = insnpc + 2 + disp;
+
+			// leave odd targets and idle loops to the interpreter
+			if ((insn.value & 1) || (insn.value == insnpc))
+				valid = false;
+		}
+
+		if (!valid)
+			break;
+		insns.push_back(insn);
+		offset += insn.length;
+		if ((insn.kind == drc_insn::BRA) || (insn.kind == drc_insn::BCC))
+			break;
+	}
+
+	// only store flags that aren't overwritten later in the block
+	uint8_t live = DRC_ALL_FLAGS;
+	for (auto it = insns.rbegin(); it != insns.rend(); ++it)
+	{
+		it->flags = it->written() & live;
+		live &= ~it->written();
+	}
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			drcuml_block &block(m_drcuml->begin_block(64 + insns.size() * 16 + (offset - start)));
+			UML_HASH(block, 0, pc);                                                         // hash    0,pc
+
+			// nothing we can compile here, so go straight to the interpreter
+			if (insns.empty())
+			{
+				UML_EXIT(block, EXECUTE_INTERPRET);                                         // exit    EXECUTE_INTERPRET
+				block.end();
+				succeeded = true;
+				continue;
+			}
+
+			// make sure we're running what we compiled
+			for (uint32_t check = start & ~3; check < offset; check += 4)
+			{
+				uint32_t expected;
+				memcpy(&expected, code + check, sizeof(expected));
+				UML_LOAD(block, I0, code + check, 0, SIZE_DWORD, SCALE_x1);                 // load    i0,code,0,dword
+				UML_CMP(block, I0, expected);                                               // cmp     i0,expected
+				UML_EXITc(block, uml::COND_NE, EXECUTE_MISSING_CODE);                       // exit    EXECUTE_MISSING_CODE,ne
+			}
+
+			// leave the block for the given PC, chaining straight to its code if we have cycles left
+			auto const branch = [this, &block] (uint32_t target, uint32_t ppc, int cycles)
+			{
+				UML_MOV(block, mem(&m_drc->pc), target);                                    // mov     [pc],target
+				UML_MOV(block, mem(&m_drc->ppc), ppc);                                      // mov     [ppc],ppc
+				UML_SUB(block, mem(&m_drc->cycles), mem(&m_drc->cycles), cycles);           // sub     [cycles],[cycles],cycles
+				UML_EXITc(block, uml::COND_LE, EXECUTE_OUT_OF_CYCLES);                      // exit    EXECUTE_OUT_OF_CYCLES,le
+				UML_HASHJMP(block, 0, target, *m_drc_nocode);                               // hashjmp 0,target,nocode
+			};
+
+			uint32_t insnpc = pc;
+			int cycles = 0;
+			for (drc_insn const &insn : insns)
+			{
+				uml::parameter const dst(mem(&m_drc->dar[insn.dst]));
+				uml::parameter const src(insn.immediate ? uml::parameter(insn.value) : mem(&m_drc->dar[insn.src]));
+				uint32_t const nextpc = insnpc + insn.length;
+
+				switch (insn.kind)
+				{
+				case drc_insn::NOP:
+					break;
+
+				case drc_insn::MOVE:
+					UML_MOV(block, I2, src);                                                // mov     i2,src
+					break;
+
+				case drc_insn::MOVEA:
+					UML_MOV(block, dst, src);                                               // mov     dst,src
+					break;
+
+				case drc_insn::ADDA:
+					UML_ADD(block, dst, dst, src);                                          // add     dst,dst,src
+					break;
+
+				case drc_insn::SUBA:
+					UML_SUB(block, dst, dst, src);                                          // sub     dst,dst,src
+					break;
+
+				case drc_insn::ADD:
+					UML_ADD(block, I2, dst, src);                                           // add     i2,dst,src
+					break;
+
+				case drc_insn::SUB:
+				case drc_insn::CMP:
+					UML_SUB(block, I2, dst, src);                                           // sub     i2,dst,src
+					break;
+
+				case drc_insn::AND:
+					UML_AND(block, I2, dst, src);                                           // and     i2,dst,src
+					break;
+
+				case drc_insn::OR:
+					UML_OR(block, I2, dst, src);                                            // or      i2,dst,src
+					break;
+
+				case drc_insn::EOR:
+					UML_XOR(block, I2, dst, src);                                           // xor     i2,dst,src
+					break;
+
+				case drc_insn::TST:
+					UML_MOV(block, I2, dst);                                                // mov     i2,dst
+					break;
+
+				case drc_insn::BRA:
+					branch(insn.value, insnpc, cycles + insn.cycles);
+					break;
+
+				case drc_insn::BCC:
+					{
+						// work out the positive sense of the condition (LS, CS, EQ, VS, MI, LT, LE) into i0
+						uint8_t const test = insn.condition >> 1;
+						if ((test == 1) || (test == 2))
+							UML_ROLAND(block, I0, mem(&m_drc->c_flag), 24, 1);              // roland  i0,[c_flag],24,1
+						else if (test == 4)
+							UML_ROLAND(block, I0, mem(&m_drc->v_flag), 25, 1);              // roland  i0,[v_flag],25,1
+						else if (test >= 5)
+							UML_ROLAND(block, I0, mem(&m_drc->n_flag), 25, 1);              // roland  i0,[n_flag],25,1
+						if (test >= 6)
+						{
+							UML_ROLAND(block, I1, mem(&m_drc->v_flag), 25, 1);              // roland  i1,[v_flag],25,1
+							UML_XOR(block, I0, I0, I1);                                     // xor     i0,i0,i1
+						}
+						if ((test == 1) || (test == 3) || (test == 7))
+						{
+							UML_CMP(block, mem(&m_drc->not_z_flag), 0);                     // cmp     [not_z_flag],0
+							UML_SETc(block, uml::COND_E, (test == 3) ? I0 : I1);            // set     i0/i1,e
+							if (test != 3)
+								UML_OR(block, I0, I0, I1);                                  // or      i0,i0,i1
+						}
+
+						code_label const skip = 1;
+						UML_TEST(block, I0, I0);                                            // test    i0,i0
+						UML_JMPc(block, (insn.condition & 1) ? uml::COND_Z : uml::COND_NZ, skip); // jmp     skip,!cond
+						branch(insn.value, insnpc, cycles + insn.cycles);
+						UML_LABEL(block, skip);                                             // skip:
+						branch(nextpc, insnpc, cycles + insn.nobranch_cycles);
+					}
+					break;
+				}
+
+				// store the result and the condition codes that are still needed
+				if ((insn.kind != drc_insn::NOP) && (insn.kind != drc_insn::MOVEA) && (insn.kind != drc_insn::ADDA) && (insn.kind != drc_insn::SUBA) && (insn.kind != drc_insn::BRA) && (insn.kind != drc_insn::BCC))
+				{
+					if (insn.arithmetic() && (insn.flags & (DRC_XF | DRC_VF | DRC_CF)))
+						UML_GETFLGS(block, I3, FLAG_C | FLAG_V);                            // getflgs i3,CV
+					if ((insn.kind != drc_insn::CMP) && (insn.kind != drc_insn::TST))
+						UML_MOV(block, dst, I2);                                            // mov     dst,i2
+					if (insn.flags & DRC_NF)
+						UML_SHR(block, mem(&m_drc->n_flag), I2, 24);                        // shr     [n_flag],i2,24
+					if (insn.flags & DRC_ZF)
+						UML_MOV(block, mem(&m_drc->not_z_flag), I2);                        // mov     [not_z_flag],i2
+					if (insn.flags & DRC_VF)
+					{
+						if (insn.arithmetic())
+							UML_ROLAND(block, mem(&m_drc->v_flag), I3, 6, 0x80);            // roland  [v_flag],i3,6,0x80
+						else
+							UML_MOV(block, mem(&m_drc->v_flag), 0);                         // mov     [v_flag],0
+					}
+					if (insn.flags & DRC_CF)
+					{
+						if (insn.arithmetic())
+							UML_ROLAND(block, mem(&m_drc->c_flag), I3, 8, 0x100);           // roland  [c_flag],i3,8,0x100
+						else
+							UML_MOV(block, mem(&m_drc->c_flag), 0);                         // mov     [c_flag],0
+					}
+					if (insn.flags & DRC_XF)
+						UML_ROLAND(block, mem(&m_drc->x_flag), I3, 8, 0x100);               // roland  [x_flag],i3,8,0x100
+				}
+				cycles += insn.cycles;
+				insnpc = nextpc;
+			}
+
+			// ran off the end of what we could compile
+			drc_insn const &last(insns.back());
+			if ((last.kind != drc_insn::BRA) && (last.kind != drc_insn::BCC))
+				branch(insnpc, insnpc - last.length, cycles);
+
+			block.end();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			drc_flush_cache();
+		}
+	}
+}
@@ -117,6 +117,10 @@ static const char g_version[] = "4.90";
 #define ID_OPHANDLER_CC         ID_BASE "_CC"
 #define ID_OPHANDLER_NOT_CC     ID_BASE "_NOT_CC"
 
+/* Handlers that test the CPU type are specialised for each jump table */
+#define ID_CPU_TYPE_CHECK       "CPU_TYPE_IS_"
+#define ID_CPU_TABLE_PARAM      "CpuTable"
+
 
 #ifndef DECL_SPEC
 #define DECL_SPEC
@@ -187,6 +191,7 @@ struct opcode_struct
 	char cpu_mode[NUM_CPUS];              /* User or supervisor mode */
 	char cpus[NUM_CPUS+1];                /* Allowed CPUs */
 	unsigned char cycles[NUM_CPUS];       /* cycles for 000, 010, 020, 030, 040 */
+	char specialised;                     /* Handler is a template on the jump table it is called from */
 };
 
 
@@ -230,9 +235,10 @@ static opcode_struct* find_opcode(char* name, int size, char* spec_proc, char* s
 //opcode_struct* find_illegal_opcode(void);
 static int extract_opcode_info(char* src, char* name, int* size, char* spec_proc, char* spec_ea);
 static void add_replace_string(replace_struct* replace, const char* search_str, const char* replace_str);
-static void write_body(FILE* filep, body_struct* body, replace_struct* replace);
+static int body_checks_cpu_type(body_struct* body);
+static void write_body(FILE* filep, body_struct* body, replace_struct* replace, int specialised);
 static void get_base_name(char* base_name, opcode_struct* op);
-static void write_function_name(FILE* filep, char* base_name);
+static void write_function_name(FILE* filep, char* base_name, int specialised);
 static void add_opcode_output_table_entry(opcode_struct* op, char* name);
 static int DECL_SPEC compare_nof_true_bits(const void* aptr, const void* bptr);
 static void print_opcode_output_table(FILE* filep);
@@ -735,8 +741,19 @@ static void add_replace_string(replace_struct* replace, const char* search_str,
 	strcpy(replace->replace[replace->length++][1], replace_str);
 }
 
+/* Check whether a function body tests the CPU type */
+static int body_checks_cpu_type(body_struct* body)
+{
+	int i;
+
+	for(i=0;i<body->length;i++)
+		if(strstr(body->body[i], ID_CPU_TYPE_CHECK) != nullptr)
+			return 1;
+	return 0;
+}
+
 /* Write a function body while replacing any selected strings */
-static void write_body(FILE* filep, body_struct* body, replace_struct* replace)
+static void write_body(FILE* filep, body_struct* body, replace_struct* replace, int specialised)
 {
 	int i;
 	int j;
@@ -769,6 +786,22 @@ static void write_body(FILE* filep, body_struct* body, replace_struct* replace)
 			if(!found)
 				error_exit("Unknown " ID_BASE " directive [%s]", output);
 		}
+		/* Point CPU type checks at the jump table this copy is for */
+		if(specialised)
+		{
+			for(ptr = strstr(output, ID_CPU_TYPE_CHECK); ptr != nullptr; ptr = strstr(ptr, ID_CPU_TYPE_CHECK))
+			{
+				ptr = strchr(ptr, '(');
+				if(ptr == nullptr)
+					break;
+				if(strlen(output) + strlen("<" ID_CPU_TABLE_PARAM ">") > MAX_LINE_LENGTH)
+					error_exit("Line too long specialising [%s]", output);
+				strcpy(temp_buff, ptr);
+				strcpy(ptr, "<" ID_CPU_TABLE_PARAM ">");
+				strcat(ptr, temp_buff);
+				ptr += strlen("<" ID_CPU_TABLE_PARAM ">(");
+			}
+		}
 		fprintf(filep, "%s\n", output);
 	}
 	fprintf(filep, "\n\n");
@@ -787,8 +820,13 @@ static void get_base_name(char* base_name, opcode_struct* op)
 }
 
 /* Write the name of an opcode handler function */
-static void write_function_name(FILE* filep, char* base_name)
+static void write_function_name(FILE* filep, char* base_name, int specialised)
 {
+	if(specialised)
+	{
+		fprintf(filep, "template <int " ID_CPU_TABLE_PARAM ">\n");
+		fprintf(g_prototype_file, "template <int " ID_CPU_TABLE_PARAM "> ");
+	}
 	fprintf(filep, "void m68000_base_device::%s()\n", base_name);
 	fprintf(g_prototype_file, "void %s();\n", base_name);
 }
@@ -836,8 +874,21 @@ static void write_table_entry(FILE* filep, opcode_struct* op)
 {
 	int i;
 
-	fprintf(filep, "\t{%-28s, 0x%04x, 0x%04x, {",
-		op->name, op->op_mask, op->op_match);
+	/* One handler per jump table, so CPU type checks can be resolved when compiling */
+	fprintf(filep, "\t{{");
+	for(i=0;i<NUM_CPUS;i++)
+	{
+		if(op->cycles[i] == 0xff)
+			fprintf(filep, "nullptr");
+		else if(op->specialised)
+			fprintf(filep, "%s<%d>", op->name, i);
+		else
+			fprintf(filep, "%s", op->name);
+		if(i < NUM_CPUS-1)
+			fprintf(filep, ", ");
+	}
+
+	fprintf(filep, "}, 0x%04x, 0x%04x, {", op->op_mask, op->op_match);
 
 	for(i=0;i<NUM_CPUS;i++)
 	{
@@ -873,9 +924,10 @@ static void generate_opcode_handler(FILE* filep, body_struct* body, replace_stru
 
 	/* Set the opcode structure and write the tables, prototypes, etc */
 	set_opcode_struct(opinfo, op, ea_mode);
+	op->specialised = body_checks_cpu_type(body);
 	get_base_name(str, op);
 	add_opcode_output_table_entry(op, str);
-	write_function_name(filep, str);
+	write_function_name(filep, str, op->specialised);
 
 	/* Add any replace strings needed */
 	if(ea_mode != EA_MODE_NONE)
@@ -895,7 +947,7 @@ static void generate_opcode_handler(FILE* filep, body_struct* body, replace_stru
 	}
 
 	/* Now write the function body with the selected replace strings */
-	write_body(filep, body, replace);
+	write_body(filep, body, replace, op->specialised);
 	g_num_functions++;
 	free(op);
 }
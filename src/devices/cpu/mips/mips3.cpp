@@ -10,6 +10,7 @@
 
 #include "emu.h"
 #include "debugger.h"
+#include "emuopts.h"
 #include "mips3.h"
 #include "mips3com.h"
 #include "mips3dsm.h"
@@ -165,6 +166,12 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, c_icache_size(0)
 	, c_dcache_size(0)
 	, m_fastram_select(0)
+	, m_autoram_select(0)
+	, m_autoram_probes(0)
+	, m_autoram_resets(0)
+	, m_autoram_address(0)
+	, m_fastram_hits(0)
+	, m_fastram_misses(0)
 	, m_debugger_temp(0)
 	, m_drc_cache(DRC_CACHE_SIZE + sizeof(internal_mips3_state) + 0x80000)
 	, m_drcuml(nullptr)
@@ -201,6 +208,7 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 		m_exception_norecover[i] = nullptr;
 	}
 	memset(m_fastram, 0, sizeof(m_fastram));
+	memset(m_autoram, 0, sizeof(m_autoram));
 	memset(m_hotspot, 0, sizeof(m_hotspot));
 
 	// configure the virtual TLB
@@ -220,6 +228,9 @@ device_memory_interface::space_config_vector mips3_device::memory_space_config()
 
 void mips3_device::device_stop()
 {
+	if (m_drcoptions & MIPS3DRC_FASTRAM_STATS)
+		logerror("fast RAM: %d hits, %d misses, %d ranges found, %d resets\n", m_fastram_hits, m_fastram_misses, m_autoram_select, m_autoram_resets);
+
 	if (m_drcfe != nullptr)
 	{
 		m_drcfe = nullptr;
@@ -428,6 +439,13 @@ void mips3_device::device_start()
 	/* set up the endianness */
 	m_program->accessors(m_memory);
 
+	/* let the recompiler find RAM behind the memory system by itself; its fast paths assume 32-bit organized memory */
+	if (m_isdrc && m_data_bits == 32 && (machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+	{
+		m_autoram_probed = std::make_unique<uint8_t []>(size_t(1) << (32 - MIPS3_MIN_PAGE_SHIFT));
+		m_program->add_change_notifier([this] (read_or_write mode) { autoram_reset(); });
+	}
+
 	/* allocate a timer for the compare interrupt */
 	m_compare_int_timer = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(mips3_device::compare_int_callback), this));
 
@@ -480,6 +498,8 @@ void mips3_device::device_start()
 
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<mips3_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	if (machine().options().drc_trace_threshold() > 0)
+		m_drcfe->enable_traces(m_drc_cache, machine().options().drc_trace_threshold());
 
 	/* allocate memory for cache-local state and initialize it */
 	memcpy(m_fpmode, fpmode_source, sizeof(fpmode_source));
@@ -236,6 +236,8 @@ enum {
 };
 
 #define MIPS3_MAX_FASTRAM       3
+#define MIPS3_MAX_AUTORAM       4
+#define MIPS3_MAX_AUTORAM_RESETS 16
 #define MIPS3_MAX_HOTSPOTS      16
 
 /***************************************************************************
@@ -446,8 +448,7 @@ protected:
 	mips3_tlb_entry m_tlb[MIPS3_MAX_TLB_ENTRIES];
 
 	/* fast RAM */
-	uint32_t        m_fastram_select;
-	struct {
+	struct fastram_info {
 		offs_t      start;                      /* start of the RAM block */
 		offs_t      end;                        /* end of the RAM block */
 		bool        readonly;                   /* true if read-only */
@@ -455,7 +456,19 @@ protected:
 		uint8_t *   offset_base8;               /* base in memory where the RAM lives, 8-bit pointer, with the start offset pre-applied */
 		uint16_t *  offset_base16;              /* base in memory where the RAM lives, 16-bit pointer, with the start offset pre-applied  */
 		uint32_t *  offset_base32;              /* base in memory where the RAM lives, 32-bit pointer, with the start offset pre-applied  */
-	}               m_fastram[MIPS3_MAX_FASTRAM];
+	};
+	uint32_t        m_fastram_select;
+	fastram_info    m_fastram[MIPS3_MAX_FASTRAM];
+
+	/* fast RAM found by probing pages the memory accessors passed to the memory system */
+	uint32_t        m_autoram_select;
+	fastram_info    m_autoram[MIPS3_MAX_AUTORAM];
+	std::unique_ptr<uint8_t []> m_autoram_probed;  /* one byte per physical page, nonzero once probed */
+	uint32_t        m_autoram_probes;           /* number of pages marked in m_autoram_probed */
+	uint32_t        m_autoram_resets;           /* number of times a memory map change discarded the probes */
+	offs_t          m_autoram_address;          /* physical address handed to func_autoram_probe */
+	uint64_t        m_fastram_hits;             /* accessor calls satisfied from fast RAM (MIPS3DRC_FASTRAM_STATS) */
+	uint64_t        m_fastram_misses;           /* accessor calls passed to the memory system (MIPS3DRC_FASTRAM_STATS) */
 
 	uint32_t        m_debugger_temp;
 
@@ -588,6 +601,7 @@ public:
 	void func_printf_exception();
 	void func_printf_debug();
 	void func_printf_probe();
+	void func_autoram_probe();
 	void func_unimplemented();
 private:
 	/* internal compiler state */
@@ -607,12 +621,15 @@ private:
 	void static_generate_tlb_mismatch();
 	void static_generate_exception(uint8_t exception, int recover, const char *name);
 	void static_generate_memory_accessor(int mode, int size, int iswrite, int ismasked, const char *name, uml::code_handle *&handleptr);
+	void autoram_probe(offs_t address);
+	void autoram_reset();
 
 	void generate_update_mode(drcuml_block &block);
 	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception);
 	void generate_checksum_block(drcuml_block &block, compiler_state &compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
 	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
 	void generate_delay_slot_and_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint8_t linkreg);
+	void generate_trace_exit(drcuml_block &block, offs_t targetpc);
 
 	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
 	bool generate_special(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
@@ -964,6 +981,7 @@ COMPILER-SPECIFIC OPTIONS
 #define MIPS3DRC_FLUSH_PC           0x0010          /* flush the PC value before each memory access */
 #define MIPS3DRC_CHECK_OVERFLOWS    0x0020          /* actually check overflows on add/sub instructions */
 #define MIPS3DRC_ACCURATE_DIVZERO   0x0040          /* load correct values into HI/LO on integer divide-by-zero */
+#define MIPS3DRC_FASTRAM_STATS      0x0080          /* count fast RAM hits and misses in the memory accessors */
 
 #define MIPS3DRC_COMPATIBLE_OPTIONS (MIPS3DRC_STRICT_VERIFY | MIPS3DRC_STRICT_COP1 | MIPS3DRC_STRICT_COP0 | MIPS3DRC_STRICT_COP2 | MIPS3DRC_FLUSH_PC)
 #define MIPS3DRC_FASTEST_OPTIONS    (0)
@@ -437,6 +437,12 @@ void mips3_device::tlb_write_common(int tlbindex)
 		/* remap this TLB entry */
 		tlb_map_entry(tlbindex);
 
+		/* look for RAM behind both halves up front, so the recompiler can reach it directly */
+		if (m_autoram_probed)
+			for (int which = 0; which < 2; which++)
+				if ((entry->entry_lo[which] & 2) && ((entry->entry_lo[which] >> 6) & m_pfnmask) < (1 << (32 - MIPS3_MIN_PAGE_SHIFT)))
+					autoram_probe(((entry->entry_lo[which] >> 6) & m_pfnmask) << MIPS3_MIN_PAGE_SHIFT);
+
 		/* log the two halves once they are in */
 		tlb_entry_log_half(entry, tlbindex, 0);
 		tlb_entry_log_half(entry, tlbindex, 1);
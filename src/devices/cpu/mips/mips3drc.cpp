@@ -73,6 +73,7 @@
 static void cfunc_printf_exception(void *param);
 static void cfunc_get_cycles(void *param);
 static void cfunc_printf_probe(void *param);
+static void cfunc_autoram_probe(void *param);
 
 
 /***************************************************************************
@@ -189,6 +190,124 @@ void mips3_device::add_fastram(offs_t start, offs_t end, uint8_t readonly, void
 }
 
 
+/*-------------------------------------------------
+    autoram_probe - look for host memory behind
+    a physical page that the memory accessors
+    handed to the memory system, and add it as a
+    fast RAM range if there is some
+-------------------------------------------------*/
+
+void mips3_device::autoram_probe(offs_t address)
+{
+	offs_t const page = address >> MIPS3_MIN_PAGE_SHIFT;
+	if (!m_autoram_probed || m_autoram_probed[page])
+		return;
+	m_autoram_probed[page] = 1;
+	m_autoram_probes++;
+	if (m_autoram_select >= ARRAY_LENGTH(m_autoram))
+		return;
+
+	/* reads must hit host memory; if writes land somewhere else, only reads go direct */
+	offs_t const start = address & ~(MIPS3_MIN_PAGE_SIZE - 1);
+	uint8_t *const base = (uint8_t *)m_program->get_read_ptr(start);
+	if (base == nullptr)
+		return;
+	bool const readonly = (m_program->get_write_ptr(start) != base);
+
+	/* banks can switch without the memory map changing, so their memory can't be baked in */
+	std::vector<std::pair<uintptr_t, uintptr_t>> banked;
+	for (auto &bank : machine().memory().banks())
+		if (bank.second->base() && (bank.second->references_space(*m_program, read_or_write::READ) || bank.second->references_space(*m_program, read_or_write::WRITE)))
+		{
+			uintptr_t const bankbase = uintptr_t(bank.second->base());
+			banked.emplace_back(bankbase, bankbase + (bank.second->addrend() - bank.second->addrstart()));
+		}
+
+	/* a page only counts if both ends of it are contiguous with the starting page and outside any bank */
+	auto const backed = [this, start, base, readonly, &banked] (offs_t pagestart) -> bool
+	{
+		for (offs_t addr : { pagestart, offs_t(pagestart + MIPS3_MIN_PAGE_SIZE - 1) })
+		{
+			uintptr_t const expected = uintptr_t(base) + (int64_t(addr) - int64_t(start));
+			if (uintptr_t(m_program->get_read_ptr(addr)) != expected)
+				return false;
+			for (auto const &window : banked)
+				if (expected >= window.first && expected <= window.second)
+					return false;
+			if (!readonly && uintptr_t(m_program->get_write_ptr(addr)) != expected)
+				return false;
+		}
+		return true;
+	};
+	if (!backed(start))
+		return;
+
+	/* grow the range in both directions as far as the host memory stays contiguous */
+	offs_t first = start;
+	offs_t last = start + MIPS3_MIN_PAGE_SIZE - 1;
+	while (first != 0 && backed(first - MIPS3_MIN_PAGE_SIZE))
+		first -= MIPS3_MIN_PAGE_SIZE;
+	while (last != 0xffffffff && backed(last + 1))
+		last += MIPS3_MIN_PAGE_SIZE;
+	for (offs_t p = first >> MIPS3_MIN_PAGE_SHIFT; p <= (last >> MIPS3_MIN_PAGE_SHIFT); p++)
+		if (!m_autoram_probed[p])
+		{
+			m_autoram_probed[p] = 1;
+			m_autoram_probes++;
+		}
+
+	uint8_t *const rambase = base - (start - first);
+	fastram_info &ram = m_autoram[m_autoram_select++];
+	ram.start = first;
+	ram.end = last;
+	ram.readonly = readonly;
+	ram.base = rambase;
+	ram.offset_base8 = rambase - first;
+	ram.offset_base16 = (uint16_t*)(rambase - first);
+	ram.offset_base32 = (uint32_t*)(rambase - first);
+
+	// Set cache to dirty so that the accessors are regenerated with the new range
+	m_drc_cache_dirty = true;
+}
+
+
+/*-------------------------------------------------
+    func_autoram_probe - probe the page the memory
+    accessors left in m_autoram_address
+-------------------------------------------------*/
+
+void mips3_device::func_autoram_probe()
+{
+	autoram_probe(m_autoram_address);
+}
+
+
+/*-------------------------------------------------
+    autoram_reset - forget every probed page after
+    the memory map changes
+-------------------------------------------------*/
+
+void mips3_device::autoram_reset()
+{
+	if (!m_autoram_probed || m_autoram_probes == 0 || m_autoram_resets >= MIPS3_MAX_AUTORAM_RESETS)
+		return;
+
+	/* a machine that keeps remapping would spend all its time recompiling; mark everything probed instead */
+	bool const disable = (++m_autoram_resets >= MIPS3_MAX_AUTORAM_RESETS);
+	memset(m_autoram_probed.get(), disable ? 1 : 0, size_t(1) << (32 - MIPS3_MIN_PAGE_SHIFT));
+	m_autoram_probes = 0;
+
+	if (m_autoram_select != 0)
+	{
+		m_autoram_select = 0;
+
+		// Set cache to dirty so that re-mapping occurs, and don't keep running the stale accessors
+		m_drc_cache_dirty = true;
+		abort_timeslice();
+	}
+}
+
+
 /*-------------------------------------------------
     mips3drc_add_hotspot - add a new hotspot
 -------------------------------------------------*/
@@ -417,6 +536,11 @@ static void cfunc_mips3com_tlbp(void *param)
 	((mips3_device *)param)->mips3com_tlbp();
 }
 
+static void cfunc_autoram_probe(void *param)
+{
+	((mips3_device *)param)->func_autoram_probe();
+}
+
 /*-------------------------------------------------
     cfunc_get_cycles - compute the total number
     of cycles executed so far
@@ -791,7 +915,6 @@ void mips3_device::static_generate_memory_accessor(int mode, int size, int iswri
 	uml::code_handle &exception_addrerr = *m_exception[iswrite ? EXCEPTION_ADDRSTORE : EXCEPTION_ADDRLOAD];
 	int tlbmiss = 0;
 	int label = 1;
-	int ramnum;
 
 	/* begin generating */
 	drcuml_block &block(m_drcuml->begin_block(1024));
@@ -826,93 +949,121 @@ void mips3_device::static_generate_memory_accessor(int mode, int size, int iswri
 	UML_JMPc(block, COND_Z, tlbmiss = label++);                                     // jmp     tlbmiss,z
 	UML_ROLINS(block, I0, I3, 0, 0xfffff000);                   // rolins  i0,i3,0,0xfffff000
 
-	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
-		for (ramnum = 0; ramnum < m_fastram_select; ramnum++)
-			if (!(iswrite && m_fastram[ramnum].readonly))
+	/* fast RAM registered by the driver, then any found behind the memory system */
+	auto const generate_fastram = [&] (const fastram_info &ram)
+	{
+		if (iswrite && ram.readonly)
+			return;
+
+		void *fastbase = (uint8_t *)ram.base - ram.start;
+		uint32_t skip = label++;
+		if (ram.end != 0xffffffff)
+		{
+			UML_CMP(block, I0, ram.end);   // cmp     i0,end
+			UML_JMPc(block, COND_A, skip);                                      // ja      skip
+		}
+		if (ram.start != 0x00000000)
+		{
+			UML_CMP(block, I0, ram.start);// cmp     i0,fastram_start
+			UML_JMPc(block, COND_B, skip);                                      // jb      skip
+		}
+		if (m_drcoptions & MIPS3DRC_FASTRAM_STATS)
+			UML_DADD(block, mem(&m_fastram_hits), mem(&m_fastram_hits), 1);    // dadd    [fastram_hits],[fastram_hits],1
+		if (!iswrite)
+		{
+			if (size == 1)
 			{
-				void *fastbase = (uint8_t *)m_fastram[ramnum].base - m_fastram[ramnum].start;
-				uint32_t skip = label++;
-				if (m_fastram[ramnum].end != 0xffffffff)
-				{
-					UML_CMP(block, I0, m_fastram[ramnum].end);   // cmp     i0,end
-					UML_JMPc(block, COND_A, skip);                                      // ja      skip
-				}
-				if (m_fastram[ramnum].start != 0x00000000)
-				{
-					UML_CMP(block, I0, m_fastram[ramnum].start);// cmp     i0,fastram_start
-					UML_JMPc(block, COND_B, skip);                                      // jb      skip
-				}
-				if (!iswrite)
+				UML_XOR(block, I0, I0, m_bigendian ? BYTE4_XOR_BE(0) : BYTE4_XOR_LE(0));
+																				// xor     i0,i0,bytexor
+				UML_LOAD(block, I0, fastbase, I0, SIZE_BYTE, SCALE_x1);             // load    i0,fastbase,i0,byte
+			}
+			else if (size == 2)
+			{
+				UML_XOR(block, I0, I0, m_bigendian ? WORD_XOR_BE(0) : WORD_XOR_LE(0));
+																				// xor     i0,i0,wordxor
+				UML_LOAD(block, I0, fastbase, I0, SIZE_WORD, SCALE_x1);         // load    i0,fastbase,i0,word_x1
+			}
+			else if (size == 4)
+			{
+				UML_LOAD(block, I0, fastbase, I0, SIZE_DWORD, SCALE_x1);            // load    i0,fastbase,i0,dword_x1
+			}
+			else if (size == 8)
+			{
+				UML_DLOAD(block, I0, fastbase, I0, SIZE_QWORD, SCALE_x1);           // dload   i0,fastbase,i0,qword_x1
+				UML_DROR(block, I0, I0, 32 * (m_bigendian ? BYTE_XOR_BE(0) : BYTE_XOR_LE(0)));
+																				// dror    i0,i0,32*bytexor
+			}
+			UML_RET(block);                                                     // ret
+		}
+		else
+		{
+			if (size == 1)
+			{
+				UML_XOR(block, I0, I0, m_bigendian ? BYTE4_XOR_BE(0) : BYTE4_XOR_LE(0));
+																				// xor     i0,i0,bytexor
+				UML_STORE(block, fastbase, I0, I1, SIZE_BYTE, SCALE_x1);// store   fastbase,i0,i1,byte
+			}
+			else if (size == 2)
+			{
+				UML_XOR(block, I0, I0, m_bigendian ? WORD_XOR_BE(0) : WORD_XOR_LE(0));
+																				// xor     i0,i0,wordxor
+				UML_STORE(block, fastbase, I0, I1, SIZE_WORD, SCALE_x1);// store   fastbase,i0,i1,word_x1
+			}
+			else if (size == 4)
+			{
+				if (ismasked)
 				{
-					if (size == 1)
-					{
-						UML_XOR(block, I0, I0, m_bigendian ? BYTE4_XOR_BE(0) : BYTE4_XOR_LE(0));
-																						// xor     i0,i0,bytexor
-						UML_LOAD(block, I0, fastbase, I0, SIZE_BYTE, SCALE_x1);             // load    i0,fastbase,i0,byte
-					}
-					else if (size == 2)
-					{
-						UML_XOR(block, I0, I0, m_bigendian ? WORD_XOR_BE(0) : WORD_XOR_LE(0));
-																						// xor     i0,i0,wordxor
-						UML_LOAD(block, I0, fastbase, I0, SIZE_WORD, SCALE_x1);         // load    i0,fastbase,i0,word_x1
-					}
-					else if (size == 4)
-					{
-						UML_LOAD(block, I0, fastbase, I0, SIZE_DWORD, SCALE_x1);            // load    i0,fastbase,i0,dword_x1
-					}
-					else if (size == 8)
-					{
-						UML_DLOAD(block, I0, fastbase, I0, SIZE_QWORD, SCALE_x1);           // dload   i0,fastbase,i0,qword_x1
-						UML_DROR(block, I0, I0, 32 * (m_bigendian ? BYTE_XOR_BE(0) : BYTE_XOR_LE(0)));
-																						// dror    i0,i0,32*bytexor
-					}
-					UML_RET(block);                                                     // ret
+					UML_LOAD(block, I3, fastbase, I0, SIZE_DWORD, SCALE_x1);        // load    i3,fastbase,i0,dword_x1
+					UML_ROLINS(block, I3, I1, 0, I2);       // rolins  i3,i1,0,i2
+					UML_STORE(block, fastbase, I0, I3, SIZE_DWORD, SCALE_x1);       // store   fastbase,i0,i3,dword_x1
 				}
 				else
+					UML_STORE(block, fastbase, I0, I1, SIZE_DWORD, SCALE_x1);       // store   fastbase,i0,i1,dword_x1
+			}
+			else if (size == 8)
+			{
+				UML_DROR(block, I1, I1, 32 * (m_bigendian ? BYTE_XOR_BE(0) : BYTE_XOR_LE(0)));
+																				// dror    i1,i1,32*bytexor
+				if (ismasked)
 				{
-					if (size == 1)
-					{
-						UML_XOR(block, I0, I0, m_bigendian ? BYTE4_XOR_BE(0) : BYTE4_XOR_LE(0));
-																						// xor     i0,i0,bytexor
-						UML_STORE(block, fastbase, I0, I1, SIZE_BYTE, SCALE_x1);// store   fastbase,i0,i1,byte
-					}
-					else if (size == 2)
-					{
-						UML_XOR(block, I0, I0, m_bigendian ? WORD_XOR_BE(0) : WORD_XOR_LE(0));
-																						// xor     i0,i0,wordxor
-						UML_STORE(block, fastbase, I0, I1, SIZE_WORD, SCALE_x1);// store   fastbase,i0,i1,word_x1
-					}
-					else if (size == 4)
-					{
-						if (ismasked)
-						{
-							UML_LOAD(block, I3, fastbase, I0, SIZE_DWORD, SCALE_x1);        // load    i3,fastbase,i0,dword_x1
-							UML_ROLINS(block, I3, I1, 0, I2);       // rolins  i3,i1,0,i2
-							UML_STORE(block, fastbase, I0, I3, SIZE_DWORD, SCALE_x1);       // store   fastbase,i0,i3,dword_x1
-						}
-						else
-							UML_STORE(block, fastbase, I0, I1, SIZE_DWORD, SCALE_x1);       // store   fastbase,i0,i1,dword_x1
-					}
-					else if (size == 8)
-					{
-						UML_DROR(block, I1, I1, 32 * (m_bigendian ? BYTE_XOR_BE(0) : BYTE_XOR_LE(0)));
-																						// dror    i1,i1,32*bytexor
-						if (ismasked)
-						{
-							UML_DROR(block, I2, I2, 32 * (m_bigendian ? BYTE_XOR_BE(0) : BYTE_XOR_LE(0)));
-																						// dror    i2,i2,32*bytexor
-							UML_DLOAD(block, I3, fastbase, I0, SIZE_QWORD, SCALE_x1);       // dload   i3,fastbase,i0,qword_x1
-							UML_DROLINS(block, I3, I1, 0, I2);      // drolins i3,i1,0,i2
-							UML_DSTORE(block, fastbase, I0, I3, SIZE_QWORD, SCALE_x1);  // dstore  fastbase,i0,i3,qword_x1
-						}
-						else
-							UML_DSTORE(block, fastbase, I0, I1, SIZE_QWORD, SCALE_x1);  // dstore  fastbase,i0,i1,qword_x1
-					}
-					UML_RET(block);                                                     // ret
+					UML_DROR(block, I2, I2, 32 * (m_bigendian ? BYTE_XOR_BE(0) : BYTE_XOR_LE(0)));
+																				// dror    i2,i2,32*bytexor
+					UML_DLOAD(block, I3, fastbase, I0, SIZE_QWORD, SCALE_x1);       // dload   i3,fastbase,i0,qword_x1
+					UML_DROLINS(block, I3, I1, 0, I2);      // drolins i3,i1,0,i2
+					UML_DSTORE(block, fastbase, I0, I3, SIZE_QWORD, SCALE_x1);  // dstore  fastbase,i0,i3,qword_x1
 				}
-
-				UML_LABEL(block, skip);                                             // skip:
+				else
+					UML_DSTORE(block, fastbase, I0, I1, SIZE_QWORD, SCALE_x1);  // dstore  fastbase,i0,i1,qword_x1
 			}
+			UML_RET(block);                                                     // ret
+		}
+
+		UML_LABEL(block, skip);                                             // skip:
+	};
+
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+	{
+		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+			generate_fastram(m_fastram[ramnum]);
+		for (int ramnum = 0; ramnum < m_autoram_select; ramnum++)
+			generate_fastram(m_autoram[ramnum]);
+	}
+
+	if (m_drcoptions & MIPS3DRC_FASTRAM_STATS)
+		UML_DADD(block, mem(&m_fastram_misses), mem(&m_fastram_misses), 1);    // dadd    [fastram_misses],[fastram_misses],1
+
+	/* the first time a physical page gets here, see whether it is really RAM */
+	if (m_autoram_probed)
+	{
+		int probed;
+		UML_SHR(block, I3, I0, MIPS3_MIN_PAGE_SHIFT);                         // shr     i3,i0,12
+		UML_LOAD(block, I3, m_autoram_probed.get(), I3, SIZE_BYTE, SCALE_x1); // load    i3,[autoram_probed],i3,byte
+		UML_CMP(block, I3, 0);                                                // cmp     i3,0
+		UML_JMPc(block, COND_NE, probed = label++);                           // jne     probed
+		UML_MOV(block, mem(&m_autoram_address), I0);                          // mov     [autoram_address],i0
+		UML_CALLC(block, cfunc_autoram_probe, this);                          // callc   autoram_probe,mips3
+		UML_LABEL(block, probed);                                             // probed:
+	}
 
 	switch (size)
 	{
@@ -1293,8 +1444,11 @@ void mips3_device::generate_delay_slot_and_branch(drcuml_block &block, compiler_
 		if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
 			UML_JMP(block, desc->targetpc | 0x80000000);                            // jmp     desc->targetpc | 0x80000000
 		else
+		{
+			generate_trace_exit(block, desc->targetpc);                             // <count exit>
 			UML_HASHJMP(block, m_core->mode, desc->targetpc, *m_nocode);
 																					// hashjmp <mode>,desc->targetpc,nocode
+		}
 	}
 	else
 	{
@@ -1313,6 +1467,24 @@ void mips3_device::generate_delay_slot_and_branch(drcuml_block &block, compiler_
 }
 
 
+/*-------------------------------------------------
+    generate_trace_exit - count a static exit from
+    the block, and recompile its target as a trace
+    once it has been taken often enough
+-------------------------------------------------*/
+
+void mips3_device::generate_trace_exit(drcuml_block &block, offs_t targetpc)
+{
+	uint32_t *counter = m_drcfe->exit_counter(targetpc);
+	if (counter != nullptr)
+	{
+		UML_ADD(block, mem(counter), mem(counter), 1);                              // add     [counter],[counter],1
+		UML_CMP(block, mem(counter), m_drcfe->trace_threshold());                   // cmp     [counter],threshold
+		UML_EXHc(block, COND_E, *m_nocode, targetpc);                               // exh     nocode,targetpc,e
+	}
+}
+
+
 /*-------------------------------------------------
     generate_opcode - generate code for a specific
     opcode
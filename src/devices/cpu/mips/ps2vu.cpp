@@ -11,6 +11,7 @@
 
 #include "emu.h"
 #include "ps2vu.h"
+#include "ps2vufe.h"
 
 #include "video/ps2gif.h"
 #include "vudasm.h"
@@ -52,6 +53,19 @@ sonyvu_device::sonyvu_device(
 	, m_start_pc(0)
 	, m_running(false)
 	, m_icount(0)
+	, m_drc_entry(nullptr)
+	, m_drc_nocode(nullptr)
+	, m_drc_out_of_cycles(nullptr)
+	, m_drc_program_dirty(true)
+	, m_drc_mode(0)
+	, m_drc_op(0)
+	, m_drc_branch_pc(0)
+	, m_drc_program{}
+	, m_drc_program_clock(0)
+{
+}
+
+sonyvu_device::~sonyvu_device()
 {
 }
 
@@ -150,6 +164,8 @@ void sonyvu_device::device_start()
 		snprintf(regname, 6, "VI%02d", i);
 		state_add(SONYVU_VI00 + i, regname, m_vcr[i]);
 	}
+
+	drc_init();
 }
 
 void sonyvu_device::device_reset()
@@ -177,6 +193,14 @@ void sonyvu_device::device_reset()
 	m_v[3] = 1.0f;
 
 	m_running = false;
+
+	m_drc_program_dirty = true;
+}
+
+void sonyvu_device::device_post_load()
+{
+	// micro memory comes back with the rest of the state
+	m_drc_program_dirty = true;
 }
 
 device_memory_interface::space_config_vector sonyvu_device::memory_space_config() const
@@ -359,6 +383,12 @@ std::unique_ptr<util::disasm_interface> sonyvu_device::create_disassembler()
 
 void sonyvu_device::execute_run()
 {
+	if (m_drcuml)
+	{
+		execute_run_drc();
+		return;
+	}
+
 	while (m_icount > 0)
 	{
 		if (!m_running)
@@ -367,29 +397,46 @@ void sonyvu_device::execute_run()
 			return;
 		}
 
-		debugger_instruction_hook(m_pc);
+		execute_one();
+	}
+}
 
-		const uint64_t op = m_micro_mem[(m_pc & m_mem_mask) >> 3];
-		m_pc += 8;
-		if (m_delay_pc != ~0)
-		{
-			m_pc = m_delay_pc;
-			m_delay_pc = ~0;
-		}
+void sonyvu_device::execute_one()
+{
+	debugger_instruction_hook(m_pc);
 
-		execute_upper((uint32_t)(op >> 32));
-		if (op & OP_UPPER_I)
-		{
-			uint32_t lower_op = (uint32_t)op;
-			m_i = *reinterpret_cast<float*>(&lower_op);
-		}
-		else
-		{
-			execute_lower((uint32_t)op);
-		}
+	const uint64_t op = m_micro_mem[(m_pc & m_mem_mask) >> 3];
+	m_pc += 8;
+	if (m_delay_pc != ~0)
+	{
+		m_pc = m_delay_pc;
+		m_delay_pc = ~0;
+	}
 
-		m_icount--;
+	execute_upper((uint32_t)(op >> 32));
+	if (op & OP_UPPER_I)
+	{
+		uint32_t lower_op = (uint32_t)op;
+		m_i = *reinterpret_cast<float*>(&lower_op);
+	}
+	else
+	{
+		execute_lower((uint32_t)op);
 	}
+
+	m_icount--;
+}
+
+void sonyvu_device::cfunc_upper(void *param)
+{
+	auto &vu = *reinterpret_cast<sonyvu_device *>(param);
+	vu.execute_upper(vu.m_drc_op);
+}
+
+void sonyvu_device::cfunc_lower(void *param)
+{
+	auto &vu = *reinterpret_cast<sonyvu_device *>(param);
+	vu.execute_lower(vu.m_drc_op);
 }
 
 void sonyvu_device::execute_upper(const uint32_t op)
@@ -1033,6 +1080,7 @@ void sonyvu_device::write_vu_mem(uint32_t address, uint32_t data)
 void sonyvu_device::write_micro_mem(uint32_t address, uint64_t data)
 {
 	m_micro_mem[(address & m_mem_mask) >> 3] = data;
+	m_drc_program_dirty = true;
 }
 
 void sonyvu1_device::execute_xgkick(uint32_t rs)
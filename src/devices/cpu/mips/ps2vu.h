@@ -19,6 +19,8 @@ class sonyvu1_device;
 
 #include "video/ps2gs.h"
 #include "ps2vif1.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
 
 enum
 {
@@ -75,11 +77,15 @@ enum
 	SONYVU1_P = SONYVU0_VPU_STAT
 };
 
+class sonyvu_frontend;
+
 class sonyvu_device : public cpu_device
 {
+	friend class sonyvu_frontend;
+
 public:
 	// construction/destruction
-	virtual ~sonyvu_device() {}
+	virtual ~sonyvu_device();
 
 	void write_vu_mem(uint32_t address, uint32_t data);
 	void write_micro_mem(uint32_t address, uint64_t data);
@@ -112,6 +118,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_post_load() override;
 
 	// device_execute_interface overrides
 	virtual uint32_t execute_min_cycles() const override { return 1; }
@@ -131,6 +138,7 @@ protected:
 	// device_disasm_interface overrides
 	virtual std::unique_ptr<util::disasm_interface> create_disassembler() override;
 
+	void execute_one();
 	void execute_upper(const uint32_t op);
 	void execute_lower(const uint32_t op);
 
@@ -138,6 +146,26 @@ protected:
 
 	static int16_t immediate_s11(const uint32_t op);
 
+	// recompiler (ps2vudrc.cpp)
+	static constexpr int DRC_PROGRAMS = 4;
+	struct compiler_state;
+	void drc_init();
+	void drc_flush_cache();
+	void drc_select_program();
+	void execute_run_drc();
+	void drc_compile_block(offs_t pc);
+	bool drc_delay_slot_native(const opcode_desc *desc) const;
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, const uml::parameter &target);
+	void generate_delayed_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_broadcast_product(drcuml_block &block, int rs, int rt, int bc);
+	void generate_masked_store(drcuml_block &block, void *base, const uml::parameter &index, int dest);
+	bool generate_upper(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_lower(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	static void cfunc_upper(void *param);
+	static void cfunc_lower(void *param);
+
 	// address spaces
 	const address_space_config m_micro_config;
 	const address_space_config m_vu_config;
@@ -172,6 +200,26 @@ protected:
 	bool            m_running;
 
 	int             m_icount;
+
+	// recompiler state
+	std::unique_ptr<drc_cache>          m_drc_cache;
+	std::unique_ptr<drcuml_state>       m_drcuml;
+	std::unique_ptr<sonyvu_frontend>    m_drcfe;
+	uml::code_handle *  m_drc_entry;
+	uml::code_handle *  m_drc_nocode;
+	uml::code_handle *  m_drc_out_of_cycles;
+	bool                m_drc_program_dirty;    // micro memory has been written since the program was identified
+	uint32_t            m_drc_mode;             // hash mode compiled code for the current program lives in
+	uint32_t            m_drc_op;               // half of a pair for cfunc_upper and cfunc_lower
+	uint32_t            m_drc_branch_pc;        // where a branch goes after its delay slot
+
+	// programs seen in micro memory, each compiled in its own hash mode
+	struct
+	{
+		uint32_t        crc;                    // CRC of micro memory when the program was loaded
+		uint32_t        used;                   // when the program was last selected
+	} m_drc_program[DRC_PROGRAMS];
+	uint32_t            m_drc_program_clock;
 };
 
 class sonyvu1_device : public sonyvu_device
@@ -0,0 +1,710 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    ps2vudrc.cpp
+
+    Universal machine language-based PlayStation 2 VU recompiler.
+
+    Compiled code works directly on the live register file and data
+    memory.  Each upper/lower pair is compiled as a unit, upper first as
+    the interpreter runs them, and the vector operations the interpreter
+    implements (MADDbc, MADDAbc and MULAbc) work on all four fields at
+    once with the UML vector opcodes, merging the result into the
+    destination through a field mask.  The integer operations, LQI,
+    SQI, MTIR, MFIR and all of the branches are compiled natively;
+    anything else calls the interpreter's handler for its half of the
+    pair.  The interpreter doesn't model FMAC or FDIV latencies or the E
+    bit yet, so compiled code doesn't either.
+
+    XGKICK stalls by stepping the PC back while the GIF is busy, so it
+    leaves compiled code for the interpreter to run.
+
+    Micro memory is mostly rewritten wholesale by MPG uploads through
+    VIF1.  Each program seen is identified by a CRC of micro memory and
+    compiled in its own hash mode, so switching back to a program that
+    was loaded before picks up the code already compiled for it.  Every
+    sequence checks its opcodes on entry, so code left behind by a
+    program that has since been replaced is recompiled rather than run.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "ps2vu.h"
+#include "ps2vufe.h"
+
+#include "cpu/drcumlsh.h"
+
+
+namespace {
+
+// exit codes from compiled code
+enum
+{
+	EXECUTE_OUT_OF_CYCLES = 0,
+	EXECUTE_MISSING_CODE,
+	EXECUTE_INTERPRET
+};
+
+constexpr size_t DRC_CACHE_SIZE = 8 * 1024 * 1024;
+
+// frontend window, in bytes of micro memory
+constexpr u32 COMPILE_BACKWARDS = 128 * 8;
+constexpr u32 COMPILE_FORWARDS = 512 * 8;
+constexpr u32 COMPILE_MAX_SEQUENCE = 64;
+
+// per-field masks for each value of an instruction's dest field, x in the top bit
+constexpr uint32_t field_mask(int dest, int field) { return BIT(dest, 3 - field) ? ~uint32_t(0) : 0; }
+
+#define FIELD_MASKS(dest) { field_mask(dest, 0), field_mask(dest, 1), field_mask(dest, 2), field_mask(dest, 3) }
+alignas(16) const uint32_t s_field_masks[16][4] =
+{
+	FIELD_MASKS(0),  FIELD_MASKS(1),  FIELD_MASKS(2),  FIELD_MASKS(3),
+	FIELD_MASKS(4),  FIELD_MASKS(5),  FIELD_MASKS(6),  FIELD_MASKS(7),
+	FIELD_MASKS(8),  FIELD_MASKS(9),  FIELD_MASKS(10), FIELD_MASKS(11),
+	FIELD_MASKS(12), FIELD_MASKS(13), FIELD_MASKS(14), FIELD_MASKS(15)
+};
+#undef FIELD_MASKS
+
+} // anonymous namespace
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+// state tracked while compiling a block
+struct sonyvu_device::compiler_state
+{
+	uint32_t cycles;            // cycles not yet subtracted from the count
+	uml::code_label labelnum;   // next local label number
+	uint32_t mode;              // hash mode the block is compiled in
+};
+
+
+
+/***************************************************************************
+    SETUP
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_init - set up the recompiler if it's
+    allowed
+-------------------------------------------------*/
+
+void sonyvu_device::drc_init()
+{
+	// the debugger needs to see every instruction
+	if (!allow_drc() || (machine().debug_flags & DEBUG_FLAG_ENABLED))
+		return;
+
+	// compiled code only ever starts at aligned PCs inside micro memory
+	m_drc_cache = std::make_unique<drc_cache>(DRC_CACHE_SIZE);
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drc_cache, 0, DRC_PROGRAMS, 16, 3);
+	m_drcfe = std::make_unique<sonyvu_frontend>(*this, COMPILE_BACKWARDS, COMPILE_FORWARDS, COMPILE_MAX_SEQUENCE);
+
+	m_drcuml->symbol_add(&m_pc, sizeof(m_pc), "pc");
+	m_drcuml->symbol_add(&m_icount, sizeof(m_icount), "icount");
+	m_drcuml->symbol_add(&m_vfr[0][0], sizeof(m_vfr), "vf");
+	m_drcuml->symbol_add(&m_vcr[0], sizeof(m_vcr), "vi");
+	m_drcuml->symbol_add(&m_acc[0], sizeof(m_acc), "acc");
+	m_drcuml->symbol_add(&m_i, sizeof(m_i), "i");
+
+	m_drc_entry = m_drcuml->handle_alloc("entry");
+	m_drc_nocode = m_drcuml->handle_alloc("nocode");
+	m_drc_out_of_cycles = m_drcuml->handle_alloc("out_of_cycles");
+
+	drc_flush_cache();
+}
+
+
+/*-------------------------------------------------
+    drc_flush_cache - empty the cache and
+    regenerate the static code
+-------------------------------------------------*/
+
+void sonyvu_device::drc_flush_cache()
+{
+	m_drcuml->reset();
+
+	try
+	{
+		// look up the block for the current PC in the current program's mode
+		drcuml_block &entry(m_drcuml->begin_block(4));
+		UML_HANDLE(entry, *m_drc_entry);                                        // handle  entry
+		UML_LOAD(entry, I0, &m_pc, 0, SIZE_DWORD, SCALE_x4);                    // load    i0,pc
+		UML_HASHJMP(entry, mem(&m_drc_mode), I0, *m_drc_nocode);                // hashjmp <mode>,i0,nocode
+		entry.end();
+
+		// exits that leave the PC where the handler was given it
+		auto const exit_handler = [this] (uml::code_handle &handle, int code)
+		{
+			drcuml_block &block(m_drcuml->begin_block(4));
+			UML_HANDLE(block, handle);                                          // handle  handle
+			UML_GETEXP(block, I0);                                              // getexp  i0
+			UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x4);               // store   pc,i0
+			UML_EXIT(block, code);                                              // exit    code
+			block.end();
+		};
+		exit_handler(*m_drc_nocode, EXECUTE_MISSING_CODE);
+		exit_handler(*m_drc_out_of_cycles, EXECUTE_OUT_OF_CYCLES);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unrecoverable error generating VU static code\n");
+	}
+}
+
+
+/*-------------------------------------------------
+    drc_select_program - find the hash mode for
+    the program in micro memory, taking over the
+    least recently used one if it's new
+-------------------------------------------------*/
+
+void sonyvu_device::drc_select_program()
+{
+	m_drc_program_dirty = false;
+	uint32_t const crc = util::crc32_creator::simple(&m_micro_mem[0], m_micro_mem.bytes());
+
+	int slot = -1;
+	for (int index = 0; (index < DRC_PROGRAMS) && (slot < 0); index++)
+		if (m_drc_program[index].used && (m_drc_program[index].crc == crc))
+			slot = index;
+
+	if (slot < 0)
+	{
+		slot = 0;
+		for (int index = 1; index < DRC_PROGRAMS; index++)
+			if (m_drc_program[index].used < m_drc_program[slot].used)
+				slot = index;
+		m_drc_program[slot].crc = crc;
+	}
+
+	m_drc_program[slot].used = ++m_drc_program_clock;
+	m_drc_mode = slot;
+}
+
+
+
+/***************************************************************************
+    EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    execute_run_drc - run compiled code until the
+    cycles run out
+-------------------------------------------------*/
+
+void sonyvu_device::execute_run_drc()
+{
+	while (m_icount > 0)
+	{
+		if (!m_running)
+		{
+			m_icount = 0;
+			return;
+		}
+
+		if (m_drc_program_dirty)
+			drc_select_program();
+
+		// a delay slot left pending or a PC compiled code can't start from is the interpreter's
+		if ((m_delay_pc != ~uint32_t(0)) || (m_pc & 7) || (m_pc > m_mem_mask))
+		{
+			execute_one();
+			continue;
+		}
+
+		switch (m_drcuml->execute(*m_drc_entry))
+		{
+		case EXECUTE_MISSING_CODE:
+			drc_compile_block(m_pc);
+			break;
+
+		case EXECUTE_INTERPRET:
+			execute_one();
+			break;
+		}
+	}
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_compile_block - compile a block starting
+    at the given PC
+-------------------------------------------------*/
+
+void sonyvu_device::drc_compile_block(offs_t pc)
+{
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+	uint32_t const mode = m_drc_mode;
+
+	bool override = false;
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			drcuml_block &block(m_drcuml->begin_block(8192));
+			compiler_state compiler = { 0, 1, mode };
+			const opcode_desc *seqlast;
+
+			for (const opcode_desc *seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				if (m_drcuml->logging())
+					block.append_comment("-------------------------");                     // comment
+
+				// determine the last instruction in this sequence
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				// if we don't have a hash for this PC, or if we are overriding all, add one
+				if (override || !m_drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                         // hash    mode,seqhead->pc
+
+				// if this is the first sequence, we're recompiling after the program changed
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, mode, seqhead->pc);                                         // hash    mode,seqhead->pc
+				}
+
+				// otherwise, redispatch to the existing code
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                                 // label   seqhead->pc
+					UML_HASHJMP(block, mode, seqhead->pc, *m_drc_nocode);                       // hashjmp mode,seqhead->pc,nocode
+					continue;
+				}
+
+				// make sure micro memory still holds what we compiled, delay slots included
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					for (const opcode_desc *checkdesc = curdesc; checkdesc != nullptr; checkdesc = (checkdesc == curdesc) ? curdesc->delay.first() : checkdesc->next())
+					{
+						if (checkdesc->userflags & sonyvu_frontend::USERFLAG_INTERPRET)
+							continue;
+						UML_DLOAD(block, I0, &m_micro_mem[checkdesc->pc >> 3], 0, SIZE_QWORD, SCALE_x8); // dload   i0,<opcode>
+						UML_DCMP(block, I0, checkdesc->opptr.q[0]);                            // dcmp    i0,op
+						UML_EXHc(block, COND_NE, *m_drc_nocode, seqhead->pc);                   // exh     nocode,seqhead->pc,ne
+					}
+				}
+
+				// label this instruction, if it may be jumped to locally
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                                 // label   seqhead->pc
+
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, compiler, curdesc);
+
+				// go on to the next pair, falling through if it follows
+				uint32_t const nextpc = (seqlast->flags & OPFLAG_RETURN_TO_START) ? pc : (seqlast->pc + 8);
+				if ((seqlast->next() != nullptr) && (seqlast->next()->pc == nextpc))
+					generate_update_cycles(block, compiler, nextpc);
+				else
+					generate_branch(block, compiler, nullptr, nextpc);
+			}
+
+			block.end();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			drc_flush_cache();
+		}
+	}
+
+	g_profiler.stop();
+}
+
+
+/*-------------------------------------------------
+    drc_delay_slot_native - return true if the
+    delay slot of a branch can be compiled
+-------------------------------------------------*/
+
+bool sonyvu_device::drc_delay_slot_native(const opcode_desc *desc) const
+{
+	const opcode_desc *const slot = desc->delay.first();
+	return slot && !(slot->userflags & sonyvu_frontend::USERFLAG_INTERPRET);
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single pair in a sequence
+-------------------------------------------------*/
+
+void sonyvu_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// leave anything the interpreter must see to it
+	if ((desc->userflags & sonyvu_frontend::USERFLAG_INTERPRET) || ((desc->delayslots > 0) && !drc_delay_slot_native(desc)))
+	{
+		generate_update_cycles(block, compiler, desc->pc);
+		UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x4);                            // store   pc,desc->pc
+		UML_EXIT(block, EXECUTE_INTERPRET);                                                     // exit    EXECUTE_INTERPRET
+		return;
+	}
+
+	compiler.cycles += desc->cycles;
+	uint64_t const op = desc->opptr.q[0];
+
+	// the upper instruction runs first, so the lower one sees its results
+	if (!generate_upper(block, compiler, desc))
+	{
+		UML_STORE(block, &m_pc, 0, desc->pc + 8, SIZE_DWORD, SCALE_x4);                        // store   pc,desc->pc+8
+		UML_STORE(block, &m_drc_op, 0, uint32_t(op >> 32), SIZE_DWORD, SCALE_x4);              // store   drc_op,upper
+		UML_CALLC(block, &cfunc_upper, this);                                                   // callc   cfunc_upper,this
+	}
+
+	if (op & OP_UPPER_I)
+		UML_STORE(block, &m_i, 0, uint32_t(op), SIZE_DWORD, SCALE_x4);                         // store   i,lower
+	else if (desc->delayslots > 0)
+		generate_delayed_branch(block, compiler, desc);
+	else if (!generate_lower(block, compiler, desc))
+	{
+		UML_STORE(block, &m_pc, 0, desc->pc + 8, SIZE_DWORD, SCALE_x4);                        // store   pc,desc->pc+8
+		UML_STORE(block, &m_drc_op, 0, uint32_t(op), SIZE_DWORD, SCALE_x4);                    // store   drc_op,lower
+		UML_CALLC(block, &cfunc_lower, this);                                                   // callc   cfunc_lower,this
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_update_cycles - subtract the cycles
+    used since the last update, leaving compiled
+    code for the given PC if they've run out
+-------------------------------------------------*/
+
+void sonyvu_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc)
+{
+	if (compiler.cycles > 0)
+	{
+		UML_LOAD(block, I0, &m_icount, 0, SIZE_DWORD, SCALE_x4);                               // load    i0,icount
+		UML_SUB(block, I0, I0, compiler.cycles);                                                // sub     i0,i0,cycles
+		UML_STORE(block, &m_icount, 0, I0, SIZE_DWORD, SCALE_x4);                              // store   icount,i0
+		UML_CMP(block, I0, 0);                                                                  // cmp     i0,0
+		UML_EXHc(block, COND_LE, *m_drc_out_of_cycles, pc);                                     // exh     out_of_cycles,pc,le
+	}
+	compiler.cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_branch - go to the given PC, jumping
+    within the block where possible
+-------------------------------------------------*/
+
+void sonyvu_device::generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, const uml::parameter &target)
+{
+	generate_update_cycles(block, compiler, target);
+
+	if (desc && (desc->flags & OPFLAG_INTRABLOCK_BRANCH) && (desc->targetpc != BRANCH_TARGET_DYNAMIC))
+	{
+		if (target.is_immediate())
+		{
+			if (target.immediate() == desc->targetpc)
+			{
+				UML_JMP(block, desc->targetpc | 0x80000000);                                    // jmp     targetpc
+				return;
+			}
+		}
+		else
+		{
+			UML_CMP(block, target, desc->targetpc);                                             // cmp     target,targetpc
+			UML_JMPc(block, COND_E, desc->targetpc | 0x80000000);                               // je      targetpc
+		}
+	}
+	UML_HASHJMP(block, compiler.mode, target, *m_drc_nocode);                                   // hashjmp mode,target,nocode
+}
+
+
+/*-------------------------------------------------
+    generate_delayed_branch - generate code for a
+    branch and the pair in its delay slot
+-------------------------------------------------*/
+
+void sonyvu_device::generate_delayed_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	using namespace uml;
+
+	uint32_t const op = uint32_t(desc->opptr.q[0]);
+	uint32_t const opcode = (op >> 25) & 0x7f;
+	int const rs = (op >> 11) & 31;
+	int const rt = (op >> 16) & 31;
+	uml::code_label const nottaken = compiler.labelnum++;
+
+	// BAL and JALR link past the delay slot, before JALR reads its target
+	if (((opcode == 0x21) || (opcode == 0x25)) && rt)
+		UML_STORE(block, &m_vcr[rt], 0, desc->pc + 16, SIZE_DWORD, SCALE_x4);                  // store   vi[rt],desc->pc+16
+
+	// decide where to go before the slot runs, as the interpreter does
+	switch (opcode)
+	{
+		case 0x24: case 0x25: // JR, JALR
+			UML_LOAD(block, I0, &m_vcr[rs], 0, SIZE_DWORD, SCALE_x4);                          // load    i0,vi[rs]
+			UML_AND(block, I0, I0, m_mem_mask);                                                 // and     i0,i0,mem_mask
+			UML_STORE(block, &m_drc_branch_pc, 0, I0, SIZE_DWORD, SCALE_x4);                   // store   branch_pc,i0
+			break;
+
+		case 0x28: case 0x29: // IBEQ, IBNE
+			UML_STORE(block, &m_drc_branch_pc, 0, desc->pc + 16, SIZE_DWORD, SCALE_x4);        // store   branch_pc,desc->pc+16
+			UML_LOAD(block, I0, &m_vcr[rs], 0, SIZE_DWORD, SCALE_x4);                          // load    i0,vi[rs]
+			UML_LOAD(block, I1, &m_vcr[rt], 0, SIZE_DWORD, SCALE_x4);                          // load    i1,vi[rt]
+			UML_CMP(block, I0, I1);                                                             // cmp     i0,i1
+			UML_JMPc(block, (opcode == 0x28) ? COND_NE : COND_E, nottaken);           // jne/je  nottaken
+			UML_STORE(block, &m_drc_branch_pc, 0, desc->targetpc, SIZE_DWORD, SCALE_x4);       // store   branch_pc,targetpc
+			UML_LABEL(block, nottaken);                                                         // nottaken:
+			break;
+
+		case 0x2c: case 0x2d: case 0x2e: case 0x2f: // IBLTZ, IBGTZ, IBLEZ, IBGEZ
+		{
+			static const condition_t skip[4] = { COND_GE, COND_LE, COND_G, COND_L };
+			UML_STORE(block, &m_drc_branch_pc, 0, desc->pc + 16, SIZE_DWORD, SCALE_x4);        // store   branch_pc,desc->pc+16
+			UML_LOAD(block, I0, &m_vcr[rs], 0, SIZE_DWORD, SCALE_x4);                          // load    i0,vi[rs]
+			UML_SEXT(block, I0, I0, SIZE_WORD);                                                 // sext    i0,i0,word
+			UML_CMP(block, I0, 0);                                                              // cmp     i0,0
+			UML_JMPc(block, skip[opcode & 3], nottaken);                                        // j<!cond> nottaken
+			UML_STORE(block, &m_drc_branch_pc, 0, desc->targetpc, SIZE_DWORD, SCALE_x4);       // store   branch_pc,targetpc
+			UML_LABEL(block, nottaken);                                                         // nottaken:
+			break;
+		}
+	}
+
+	generate_sequence_instruction(block, compiler, desc->delay.first());
+
+	if ((opcode == 0x20) || (opcode == 0x21))
+		generate_branch(block, compiler, desc, desc->targetpc);
+	else
+	{
+		UML_LOAD(block, I9, &m_drc_branch_pc, 0, SIZE_DWORD, SCALE_x4);                        // load    i9,branch_pc
+		generate_branch(block, compiler, desc, I9);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_broadcast_product - leave the product
+    of VF[rs] and one field of VF[rt] in V0
+-------------------------------------------------*/
+
+void sonyvu_device::generate_broadcast_product(drcuml_block &block, int rs, int rt, int bc)
+{
+	// copy both halfwords of the bc field to every field
+	uint32_t lanes = 0;
+	for (int lane = 0; lane < 8; lane++)
+		lanes |= uint32_t(bc * 2 + (lane & 1)) << (lane * 4);
+
+	UML_VLOAD(block, V0, m_vfr[rs], 0);                                                         // vload   v0,vf[rs]
+	UML_VLOAD(block, V1, m_vfr[rt], 0);                                                         // vload   v1,vf[rt]
+	UML_VSHUF(block, V1, V1, lanes);                                                            // vshuf   v1,v1,bc
+	UML_VFMUL(block, V0, V0, V1);                                                               // vfmul   v0,v0,v1
+}
+
+
+/*-------------------------------------------------
+    generate_masked_store - store the fields of V0
+    selected by an instruction's dest field,
+    leaving the others as they were
+-------------------------------------------------*/
+
+void sonyvu_device::generate_masked_store(drcuml_block &block, void *base, const uml::parameter &index, int dest)
+{
+	if (dest == 0)
+		return;
+
+	if (dest != 15)
+	{
+		UML_VLOAD(block, V1, base, index);                                                      // vload   v1,base,index
+		UML_VLOAD(block, V2, s_field_masks, dest);                                              // vload   v2,field_masks,dest
+		UML_VXOR(block, V0, V0, V1);                                                            // vxor    v0,v0,v1
+		UML_VAND(block, V0, V0, V2);                                                            // vand    v0,v0,v2
+		UML_VXOR(block, V0, V0, V1);                                                            // vxor    v0,v0,v1
+	}
+	UML_VSTORE(block, base, index, V0);                                                         // vstore  base,index,v0
+}
+
+
+/*-------------------------------------------------
+    generate_upper - generate code for the upper
+    instruction of a pair, returning false if the
+    interpreter should run it
+-------------------------------------------------*/
+
+bool sonyvu_device::generate_upper(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t const op = uint32_t(desc->opptr.q[0] >> 32);
+	int const rs = (op >> 11) & 31;
+	int const rt = (op >> 16) & 31;
+	int const rd = (op >> 6) & 31;
+	int const dest = (op >> 21) & 15;
+	int const bc = op & 3;
+
+	switch (op & 0x3f)
+	{
+		case 0x08: case 0x09: case 0x0a: case 0x0b: // MADDbc
+			if (rd)
+			{
+				// the interpreter writes one field at a time, so later fields see a broadcast field it overwrote
+				if ((rd == rt) && BIT(dest, 3 - bc) && (dest & ((1 << (3 - bc)) - 1)))
+					return false;
+				generate_broadcast_product(block, rs, rt, bc);
+				UML_VLOAD(block, V1, m_acc, 0);                                                 // vload   v1,acc
+				UML_VFADD(block, V0, V1, V0);                                                   // vfadd   v0,v1,v0
+				generate_masked_store(block, m_vfr[rd], 0, dest);
+			}
+			return true;
+
+		case 0x3c: case 0x3d: case 0x3e: case 0x3f:
+			switch (((op & 0x3c0) >> 4) | (op & 3))
+			{
+				case 0x08: case 0x09: case 0x0a: case 0x0b: // MADDAbc
+					if (rd)
+					{
+						generate_broadcast_product(block, rs, rt, bc);
+						UML_VLOAD(block, V1, m_acc, 0);                                         // vload   v1,acc
+						UML_VFADD(block, V0, V1, V0);                                           // vfadd   v0,v1,v0
+						generate_masked_store(block, m_acc, 0, dest);
+					}
+					return true;
+
+				case 0x18: case 0x19: case 0x1a: case 0x1b: // MULAbc
+					generate_broadcast_product(block, rs, rt, bc);
+					generate_masked_store(block, m_acc, 0, dest);
+					return true;
+
+				case 0x2f: // NOP
+					return true;
+			}
+			break;
+	}
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_lower - generate code for the lower
+    instruction of a pair, returning false if the
+    interpreter should run it
+-------------------------------------------------*/
+
+bool sonyvu_device::generate_lower(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	using namespace uml;
+
+	uint32_t const op = uint32_t(desc->opptr.q[0]);
+	int const rd = (op >> 6) & 31;
+	int const rs = (op >> 11) & 31;
+	int const rt = (op >> 16) & 31;
+	int const dest = (op >> 21) & 15;
+	int const fsf = (op >> 21) & 3;
+
+	// the interpreter doesn't bound quadword addresses by the size of data memory; compiled code wraps within it
+	uint32_t const qwmask = (m_mem_mask >> 2) & ((m_vu_mem.bytes() >> 4) - 1);
+
+	switch ((op >> 25) & 0x7f)
+	{
+		case 0x08: // IADDIU
+			if (rt)
+			{
+				UML_LOAD(block, I0, &m_vcr[rs], 0, SIZE_DWORD, SCALE_x4);                      // load    i0,vi[rs]
+				UML_ADD(block, I0, I0, op & 0x7ff);                                             // add     i0,i0,imm
+				UML_AND(block, I0, I0, 0xffff);                                                 // and     i0,i0,0xffff
+				UML_STORE(block, &m_vcr[rt], 0, I0, SIZE_DWORD, SCALE_x4);                     // store   vi[rt],i0
+			}
+			return true;
+
+		case 0x40: // SPECIAL
+			if ((op & 0x3c) == 0x3c)
+			{
+				switch (((op & 0x7c0) >> 4) | (op & 3))
+				{
+					case 0x30: // NOP; MOVE isn't implemented
+						return (rs == 0) && (rt == 0) && (dest == 0);
+
+					case 0x34: // LQI
+						if (rt)
+						{
+							UML_LOAD(block, I0, &m_vcr[rs], 0, SIZE_DWORD, SCALE_x4);          // load    i0,vi[rs]
+							UML_AND(block, I1, I0, qwmask);                                     // and     i1,i0,qwmask
+							UML_VLOAD(block, V0, &m_vu_mem[0], I1);                             // vload   v0,vu_mem,i1
+							generate_masked_store(block, m_vfr[rt], 0, dest);
+							UML_ADD(block, I0, I0, 1);                                          // add     i0,i0,1
+							UML_AND(block, I0, I0, 0xffff);                                     // and     i0,i0,0xffff
+							UML_STORE(block, &m_vcr[rs], 0, I0, SIZE_DWORD, SCALE_x4);         // store   vi[rs],i0
+						}
+						return true;
+
+					case 0x35: // SQI
+						if (rt)
+						{
+							UML_LOAD(block, I0, &m_vcr[rt], 0, SIZE_DWORD, SCALE_x4);          // load    i0,vi[rt]
+							UML_AND(block, I1, I0, qwmask);                                     // and     i1,i0,qwmask
+							UML_VLOAD(block, V0, m_vfr[rs], 0);                                 // vload   v0,vf[rs]
+							generate_masked_store(block, &m_vu_mem[0], I1, dest);
+							UML_ADD(block, I0, I0, 1);                                          // add     i0,i0,1
+							UML_AND(block, I0, I0, 0xffff);                                     // and     i0,i0,0xffff
+							UML_STORE(block, &m_vcr[rt], 0, I0, SIZE_DWORD, SCALE_x4);         // store   vi[rt],i0
+						}
+						return true;
+
+					case 0x3c: // MTIR
+						if (rt)
+						{
+							UML_LOAD(block, I0, &m_vfr[rs][fsf], 0, SIZE_DWORD, SCALE_x4);     // load    i0,vf[rs][fsf]
+							UML_AND(block, I0, I0, 0xffff);                                     // and     i0,i0,0xffff
+							UML_STORE(block, &m_vcr[rt], 0, I0, SIZE_DWORD, SCALE_x4);         // store   vi[rt],i0
+						}
+						return true;
+
+					case 0x3d: // MFIR
+						if (rt)
+						{
+							UML_LOAD(block, I0, &m_vcr[rs], 0, SIZE_DWORD, SCALE_x4);          // load    i0,vi[rs]
+							UML_SEXT(block, I0, I0, SIZE_WORD);                                 // sext    i0,i0,word
+							for (int field = 0; field < 4; field++)
+								if (BIT(dest, 3 - field))
+									UML_STORE(block, &m_vfr[rt][field], 0, I0, SIZE_DWORD, SCALE_x4); // store   vf[rt][field],i0
+						}
+						return true;
+				}
+			}
+			else
+			{
+				switch (op & 0x3f)
+				{
+					case 0x30: // IADD
+					case 0x31: // ISUB
+					case 0x34: // IAND
+					case 0x35: // IOR
+						if (rd)
+						{
+							UML_LOAD(block, I0, &m_vcr[rs], 0, SIZE_DWORD, SCALE_x4);          // load    i0,vi[rs]
+							UML_LOAD(block, I1, &m_vcr[rt], 0, SIZE_DWORD, SCALE_x4);          // load    i1,vi[rt]
+							switch (op & 0x3f)
+							{
+								case 0x30: UML_ADD(block, I0, I0, I1); break;                   // add     i0,i0,i1
+								case 0x31: UML_SUB(block, I0, I0, I1); break;                   // sub     i0,i0,i1
+								case 0x34: UML_AND(block, I0, I0, I1); break;                   // and     i0,i0,i1
+								case 0x35: UML_OR(block, I0, I0, I1); break;                    // or      i0,i0,i1
+							}
+							UML_AND(block, I0, I0, 0xffff);                                     // and     i0,i0,0xffff
+							UML_STORE(block, &m_vcr[rd], 0, I0, SIZE_DWORD, SCALE_x4);         // store   vi[rd],i0
+						}
+						return true;
+				}
+			}
+			break;
+	}
+	return false;
+}
@@ -0,0 +1,119 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    ps2vufe.cpp
+
+    Front-end for the PlayStation 2 VU recompiler.
+
+    Each description covers a whole upper/lower instruction pair, since
+    the two halves issue together and the interpreter steps them as one.
+    Branches live in the lower half and always have a single delay slot.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "ps2vufe.h"
+
+
+/***************************************************************************
+    FRONTEND
+***************************************************************************/
+
+/*-------------------------------------------------
+    sonyvu_frontend - constructor
+-------------------------------------------------*/
+
+sonyvu_frontend::sonyvu_frontend(sonyvu_device &vu, u32 window_start, u32 window_end, u32 max_sequence)
+	: drc_frontend(vu, window_start, window_end, max_sequence)
+	, m_vu(vu)
+{
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction pair
+-------------------------------------------------*/
+
+bool sonyvu_frontend::describe(opcode_desc &desc, opcode_desc const *prev)
+{
+	desc.length = 8;
+	desc.cycles = 1;
+
+	// misaligned PCs and ones past the end of micro memory are left to the interpreter
+	offs_t const index = (desc.pc & m_vu.m_mem_mask) >> 3;
+	if ((desc.pc & 7) || (desc.pc > m_vu.m_mem_mask) || (index >= (m_vu.m_micro_mem.bytes() >> 3)))
+	{
+		desc.userflags |= USERFLAG_INTERPRET;
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	uint64_t const op = m_vu.m_micro_mem[index];
+	desc.opptr.q[0] = op;
+
+	// with the I bit set, the lower word is an immediate for the I register
+	bool interpret = false;
+	if (!(op & sonyvu_device::OP_UPPER_I))
+	{
+		uint32_t const lower = uint32_t(op);
+		offs_t const target = (desc.pc + 8 + sonyvu_device::immediate_s11(lower) * 8) & m_vu.m_mem_mask;
+		switch ((lower >> 25) & 0x7f)
+		{
+			case 0x20: case 0x21:   // B, BAL
+				describe_branch(desc, false, target);
+				break;
+
+			case 0x24: case 0x25:   // JR, JALR
+				describe_branch(desc, false, BRANCH_TARGET_DYNAMIC);
+				break;
+
+			case 0x28: case 0x29:   // IBEQ, IBNE
+			case 0x2c: case 0x2d:   // IBLTZ, IBGTZ
+			case 0x2e: case 0x2f:   // IBLEZ, IBGEZ
+				describe_branch(desc, true, target);
+				break;
+
+			case 0x40:
+				// XGKICK stalls by stepping the PC back until the GIF is free
+				if (((lower & 0x3c) == 0x3c) && ((((lower & 0x7c0) >> 4) | (lower & 3)) == 0x6c))
+					interpret = true;
+				break;
+		}
+	}
+
+	// the interpreter takes a branch in a delay slot relative to the first branch's target
+	if ((desc.flags & OPFLAG_IN_DELAY_SLOT) && (desc.flags & OPFLAG_IS_BRANCH))
+	{
+		desc.flags &= ~(OPFLAG_IS_BRANCH | OPFLAG_END_SEQUENCE);
+		desc.targetpc = BRANCH_TARGET_DYNAMIC;
+		desc.delayslots = 0;
+		interpret = true;
+	}
+
+	if (interpret)
+	{
+		desc.userflags |= USERFLAG_INTERPRET;
+		desc.flags |= OPFLAG_END_SEQUENCE;
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_branch - describe a branch or jump
+-------------------------------------------------*/
+
+void sonyvu_frontend::describe_branch(opcode_desc &desc, bool conditional, offs_t target)
+{
+	if (conditional)
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+	else
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH;
+	desc.targetpc = target;
+
+	// the pair after a branch runs before it's taken
+	desc.delayslots = 1;
+	desc.flags |= OPFLAG_END_SEQUENCE;
+}
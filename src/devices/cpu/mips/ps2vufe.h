@@ -0,0 +1,41 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    ps2vufe.h
+
+    Front-end for the PlayStation 2 VU recompiler.
+
+***************************************************************************/
+
+#ifndef MAME_CPU_MIPS_PS2VUFE_H
+#define MAME_CPU_MIPS_PS2VUFE_H
+
+#pragma once
+
+#include "ps2vu.h"
+#include "cpu/drcfe.h"
+
+
+class sonyvu_frontend : public drc_frontend
+{
+public:
+	// flags for opcode_desc::userflags
+	static constexpr u32 USERFLAG_INTERPRET = 0x0001;   // pair must be run by the interpreter
+
+	// construction/destruction
+	sonyvu_frontend(sonyvu_device &vu, u32 window_start, u32 window_end, u32 max_sequence);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, opcode_desc const *prev) override;
+
+private:
+	// internal helpers
+	void describe_branch(opcode_desc &desc, bool conditional, offs_t target);
+
+	sonyvu_device &     m_vu;
+};
+
+
+#endif // MAME_CPU_MIPS_PS2VUFE_H
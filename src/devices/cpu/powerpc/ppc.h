@@ -662,6 +662,7 @@ protected:
 	void generate_fp_flags(drcuml_block &block, const opcode_desc *desc, int updatefprf);
 	void generate_branch(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc, int source, uint8_t link);
 	void generate_branch_bo(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc, uint32_t bo, uint32_t bi, int source, int link);
+	void generate_trace_exit(drcuml_block &block, offs_t targetpc);
 	bool generate_opcode(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc);
 	bool generate_instruction_13(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc);
 	bool generate_instruction_1f(drcuml_block &block, compiler_state *compiler, const opcode_desc *desc);
@@ -12,6 +12,7 @@
 #include "ppccom.h"
 #include "ppcfe.h"
 #include "ppc_dasm.h"
+#include "emuopts.h"
 
 /***************************************************************************
     DEBUGGING
@@ -890,6 +891,8 @@ void ppc_device::device_start()
 
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	if (machine().options().drc_trace_threshold() > 0)
+		m_drcfe->enable_traces(m_cache, machine().options().drc_trace_threshold());
 
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
@@ -1897,16 +1897,32 @@ void ppc_device::generate_shift_flags(drcuml_block &block, const opcode_desc *de
 
 void ppc_device::generate_fp_flags(drcuml_block &block, const opcode_desc *desc, int updatefprf)
 {
+	uint32_t op = desc->opptr.l[0];
+	int updatecr = (op & M_RC) != 0;
+
+	/* modify inputs based on required flags */
+	if (!DISABLE_FLAG_OPTIMIZATIONS)
+	{
+		if (!(desc->regreq[3] & (frontend::REGFLAG_FPSCR(3) | frontend::REGFLAG_FPSCR(4))))
+			updatefprf = false;
+		if (!(desc->regreq[2] & frontend::REGFLAG_CR(1)))
+			updatecr = 0;
+	}
+
 	/* for now, only handle the FPRF field */
 	if (updatefprf)
 	{
-		int regnum = G_RD(desc->opptr.l[0]);
+		int regnum = G_RD(op);
 		if (m_fdregmap[regnum].is_float_register())
 			UML_FDMOV(block, mem(&m_core->f[regnum]), freg(m_fdregmap[regnum].freg() - REG_F0));
 
-		UML_MOV(block, mem(&m_core->param0), G_RD(desc->opptr.l[0]));
+		UML_MOV(block, mem(&m_core->param0), G_RD(op));
 		UML_CALLC(block, (c_function)cfunc_ppccom_update_fprf, this);
 	}
+
+	/* record forms copy FX/FEX/VX/OX into CR1 */
+	if (updatecr)
+		UML_ROLAND(block, CR32(1), FPSCR32, 4, 0x0f);                              // roland  [cr1],fpscr,4,0x0f
 }
 
 /*-------------------------------------------------
@@ -1937,8 +1953,11 @@ void ppc_device::generate_branch(drcuml_block &block, compiler_state *compiler,
 		if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
 			UML_JMP(block, desc->targetpc | 0x80000000);                                    // jmp     desc->targetpc | 0x80000000
 		else
+		{
+			generate_trace_exit(block, desc->targetpc);                                     // <count exit>
 			UML_HASHJMP(block, m_core->mode, desc->targetpc, *m_nocode);
 																							// hashjmp <mode>,desc->targetpc,nocode
+		}
 	}
 	else
 	{
@@ -1981,6 +2000,24 @@ void ppc_device::generate_branch_bo(drcuml_block &block, compiler_state *compile
 }
 
 
+/*-------------------------------------------------
+    generate_trace_exit - count a static exit from
+    the block, and recompile its target as a trace
+    once it has been taken often enough
+-------------------------------------------------*/
+
+void ppc_device::generate_trace_exit(drcuml_block &block, offs_t targetpc)
+{
+	uint32_t *counter = m_drcfe->exit_counter(targetpc);
+	if (counter != nullptr)
+	{
+		UML_ADD(block, mem(counter), mem(counter), 1);                                  // add     [counter],[counter],1
+		UML_CMP(block, mem(counter), m_drcfe->trace_threshold());                       // cmp     [counter],threshold
+		UML_EXHc(block, COND_E, *m_nocode, targetpc);                                   // exh     nocode,targetpc,e
+	}
+}
+
+
 /*-------------------------------------------------
     generate_opcode - generate code for a specific
     opcode
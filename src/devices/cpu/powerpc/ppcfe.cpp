@@ -45,6 +45,7 @@
 
 #define FPSCR_USED(desc, x)         do { (desc).regin[3] |= REGFLAG_FPSCR(x); } while (0)
 #define FPSCR_MODIFIED(desc, x)     do { (desc).regout[3] |= REGFLAG_FPSCR(x); } while (0)
+#define FPRF_MODIFIED(desc)         do { (desc).regout[3] |= REGFLAG_FPSCR(3) | REGFLAG_FPSCR(4); } while (0)
 
 
 
@@ -1183,7 +1184,7 @@ bool ppc_device::frontend::describe_3b(uint32_t op, opcode_desc &desc, const opc
 				desc.cycles = 18;   // 603
 			else
 				desc.cycles = 17;   // ???
-			FPSCR_MODIFIED(desc, 4);
+			FPRF_MODIFIED(desc);
 			return true;
 
 		case 0x14:  // FSUBSx
@@ -1193,7 +1194,7 @@ bool ppc_device::frontend::describe_3b(uint32_t op, opcode_desc &desc, const opc
 			FPR_MODIFIED(desc, G_RD(op));
 			if (op & M_RC)
 				CR_MODIFIED(desc, 1);
-			FPSCR_MODIFIED(desc, 4);
+			FPRF_MODIFIED(desc);
 			return true;
 
 		case 0x19:  // FMULSx - not the same form as FSUB/FADD!
@@ -1202,7 +1203,7 @@ bool ppc_device::frontend::describe_3b(uint32_t op, opcode_desc &desc, const opc
 			FPR_MODIFIED(desc, G_RD(op));
 			if (op & M_RC)
 				CR_MODIFIED(desc, 1);
-			FPSCR_MODIFIED(desc, 4);
+			FPRF_MODIFIED(desc);
 			return true;
 
 		case 0x16:  // FSQRTSx
@@ -1211,7 +1212,7 @@ bool ppc_device::frontend::describe_3b(uint32_t op, opcode_desc &desc, const opc
 			FPR_MODIFIED(desc, G_RD(op));
 			if (op & M_RC)
 				CR_MODIFIED(desc, 1);
-			FPSCR_MODIFIED(desc, 4);
+			FPRF_MODIFIED(desc);
 			return true;
 
 		case 0x1c:  // FMSUBSx
@@ -1224,7 +1225,7 @@ bool ppc_device::frontend::describe_3b(uint32_t op, opcode_desc &desc, const opc
 			FPR_MODIFIED(desc, G_RD(op));
 			if (op & M_RC)
 				CR_MODIFIED(desc, 1);
-			FPSCR_MODIFIED(desc, 4);
+			FPRF_MODIFIED(desc);
 			return true;
 	}
 
@@ -1262,7 +1263,7 @@ bool ppc_device::frontend::describe_3f(uint32_t op, opcode_desc &desc, const opc
 					desc.cycles = 33;   // 603
 				else
 					desc.cycles = 31;   // ???
-				FPSCR_MODIFIED(desc, 4);
+				FPRF_MODIFIED(desc);
 				return true;
 
 			case 0x19:  // FMULx
@@ -1272,7 +1273,7 @@ bool ppc_device::frontend::describe_3f(uint32_t op, opcode_desc &desc, const opc
 				if (op & M_RC)
 					CR_MODIFIED(desc, 1);
 				desc.cycles = 2;    // 601/603
-				FPSCR_MODIFIED(desc, 4);
+				FPRF_MODIFIED(desc);
 				return true;
 
 			case 0x14:  // FSUBx
@@ -1282,7 +1283,7 @@ bool ppc_device::frontend::describe_3f(uint32_t op, opcode_desc &desc, const opc
 				FPR_MODIFIED(desc, G_RD(op));
 				if (op & M_RC)
 					CR_MODIFIED(desc, 1);
-				FPSCR_MODIFIED(desc, 4);
+				FPRF_MODIFIED(desc);
 				return true;
 
 			case 0x16:  // FSQRTx
@@ -1291,7 +1292,7 @@ bool ppc_device::frontend::describe_3f(uint32_t op, opcode_desc &desc, const opc
 				FPR_MODIFIED(desc, G_RD(op));
 				if (op & M_RC)
 					CR_MODIFIED(desc, 1);
-				FPSCR_MODIFIED(desc, 4);
+				FPRF_MODIFIED(desc);
 				return true;
 
 			case 0x17:  // FSELx
@@ -1315,7 +1316,7 @@ bool ppc_device::frontend::describe_3f(uint32_t op, opcode_desc &desc, const opc
 				if (op & M_RC)
 					CR_MODIFIED(desc, 1);
 				desc.cycles = 2;    // 601/603
-				FPSCR_MODIFIED(desc, 4);
+				FPRF_MODIFIED(desc);
 				return true;
 		}
 	}
@@ -1338,7 +1339,7 @@ bool ppc_device::frontend::describe_3f(uint32_t op, opcode_desc &desc, const opc
 			case 0x00c: // FRSPx
 			case 0x00e: // FCTIWx
 			case 0x00f: // FCTIWZx
-				FPSCR_MODIFIED(desc, 4);
+				FPRF_MODIFIED(desc);
 			case 0x028: // FNEGx
 			case 0x048: // FMRx
 			case 0x088: // FNABSx
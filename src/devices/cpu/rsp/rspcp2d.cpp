@@ -2918,6 +2918,48 @@ void rsp_device::cop2_drc::vrsqh()
 }
 
 
+/*-------------------------------------------------
+    generate_vector_logical - generate inline code
+    for the vector logical opcodes (VAND through
+    VNXOR)
+-------------------------------------------------*/
+
+void rsp_device::cop2_drc::generate_vector_logical(drcuml_block &block, uint32_t op)
+{
+	// build the element pattern for the second source
+	uint32_t lanes = 0;
+	for (int i = 0; i < 8; i++)
+		lanes |= VEC_EL_2(EL, i) << (4 * i);
+
+	UML_VLOAD(block, V0, &m_v[0], VS1REG);                                      // vload   v0,m_v,vs1reg
+	UML_VLOAD(block, V1, &m_v[0], VS2REG);                                      // vload   v1,m_v,vs2reg
+	if (lanes != 0x76543210)
+		UML_VSHUF(block, V1, V1, lanes);                                        // vhshuf  v1,v1,lanes
+
+	switch (op & 0x3f)
+	{
+		case 0x28: case 0x29: UML_VAND(block, V0, V0, V1); break;               // vand    v0,v0,v1
+		case 0x2a: case 0x2b: UML_VOR(block, V0, V0, V1);  break;               // vor     v0,v0,v1
+		case 0x2c: case 0x2d: UML_VXOR(block, V0, V0, V1); break;               // vxor    v0,v0,v1
+	}
+
+	// the odd opcodes invert the result
+	if (op & 1)
+	{
+		UML_VCMPEQ(block, SIZE_WORD, V1, V1, V1);                               // vhcmpeq v1,v1,v1
+		UML_VXOR(block, V0, V0, V1);                                            // vxor    v0,v0,v1
+	}
+	UML_VSTORE(block, &m_v[0], VDREG, V0);                                      // vstore  m_v,vdreg,v0
+
+	// the result also lands in the low word of each accumulator lane
+	for (int i = 0; i < 8; i++)
+	{
+		UML_LOAD(block, I0, &m_v[VDREG].s[0], i, SIZE_WORD, SCALE_x2);          // load    i0,m_v[vdreg].s,i,word
+		UML_STORE(block, &m_accum[0].w[1], i, I0, SIZE_WORD, SCALE_x8);         // store   m_accum.w[1],i,i0,word
+	}
+}
+
+
 /*-------------------------------------------------
     generate_vector_opcode - generate code for a
     vector opcode
@@ -3085,33 +3127,12 @@ bool rsp_device::cop2_drc::generate_vector_opcode(drcuml_block &block, rsp_devic
 			return true;
 
 		case 0x28:      /* VAND */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, &cop2_drc::cfunc_vand, this);
-			return true;
-
 		case 0x29:      /* VNAND */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, &cop2_drc::cfunc_vnand, this);
-			return true;
-
 		case 0x2a:      /* VOR */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, &cop2_drc::cfunc_vor, this);
-			return true;
-
 		case 0x2b:      /* VNOR */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, &cop2_drc::cfunc_vnor, this);
-			return true;
-
 		case 0x2c:      /* VXOR */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, &cop2_drc::cfunc_vxor, this);
-			return true;
-
 		case 0x2d:      /* VNXOR */
-			UML_MOV(block, mem(&m_rspcop2_state->op), desc->opptr.l[0]);        // mov     [arg0],desc->opptr.l
-			UML_CALLC(block, &cop2_drc::cfunc_vnxor, this);
+			generate_vector_logical(block, op);
 			return true;
 
 		case 0x30:      /* VRCP */
@@ -174,6 +174,7 @@ public:
 
 private:
 	virtual bool generate_vector_opcode(drcuml_block &block, rsp_device::compiler_state &compiler, const opcode_desc *desc) override;
+	void generate_vector_logical(drcuml_block &block, uint32_t op);
 };
 
 #endif // MAME_CPU_RSP_RSPCP2D_H
@@ -177,6 +177,7 @@ sh2_device::sh2_device(const machine_config &mconfig, device_type type, const ch
 	, m_decrypted_program_config("decrypted_opcodes", ENDIANNESS_BIG, 32, addrlines, 0)
 	, m_is_slave(0)
 	, m_drcfe(nullptr)
+	, m_fastram_dirty(true)
 	, m_debugger_temp(0)
 {
 	m_cpu_type = cpu_type;
@@ -388,6 +389,8 @@ void sh2_device::execute_run()
 {
 	if ( m_isdrc )
 	{
+		if (m_fastram_dirty)
+			fastram_discover();
 		execute_run_drc();
 		return;
 	}
@@ -537,6 +540,10 @@ void sh2_device::device_start()
 	m_wtcsr = 0;
 
 	drc_start();
+
+	/* rescan for fast RAM whenever handlers are installed or removed */
+	if (m_isdrc)
+		m_program->add_change_notifier([this](read_or_write mode) { m_fastram_dirty = true; });
 }
 
 
@@ -879,6 +886,91 @@ void sh2_device::generate_update_cycles(drcuml_block &block, compiler_state &com
 	compiler.cycles = 0;
 }
 
+/*------------------------------------------------------------------
+    fastram_discover - find plain RAM and ROM in
+    the external address range, so the memory
+    accessors can reach it without going through
+    the handlers
+------------------------------------------------------------------*/
+
+static constexpr int SH2_MAX_AUTO_FASTRAM = 8;
+
+void sh2_device::fastram_discover()
+{
+	static constexpr offs_t PAGE_SIZE = 0x1000;
+	std::vector<auto_fastram> found;
+
+	m_fastram_dirty = false;
+
+	/* the debugger has to see every access, so leave it all on the slow path */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+	{
+		/* banks can switch in the middle of a block, so their memory can't be baked in */
+		std::vector<std::pair<const uint8_t *, const uint8_t *>> banked;
+		for (auto &bank : machine().memory().banks())
+			if (bank.second->base() && (bank.second->references_space(*m_program, read_or_write::READ) || bank.second->references_space(*m_program, read_or_write::WRITE)))
+			{
+				const uint8_t *base = (const uint8_t *)bank.second->base();
+				banked.emplace_back(base, base + (bank.second->addrend() - bank.second->addrstart()));
+			}
+
+		/* walk the area the AM mask leaves reachable a page at a time, merging contiguous pages */
+		offs_t const limit = std::min<offs_t>(m_program->addrmask(), SH12_AM & 0x3fffffff);
+		for (offs_t page = 0; page < limit; page += PAGE_SIZE)
+		{
+			const uint8_t *rstart = (const uint8_t *)m_program->get_read_ptr(page);
+			const uint8_t *rend = (const uint8_t *)m_program->get_read_ptr(page + PAGE_SIZE - 1);
+			if (!rstart || rend != rstart + PAGE_SIZE - 4)
+				continue;
+			if (std::find_if(banked.begin(), banked.end(), [rstart](auto const &window) { return rstart >= window.first && rstart <= window.second; }) != banked.end())
+				continue;
+
+			const uint8_t *wstart = (const uint8_t *)m_program->get_write_ptr(page);
+			const uint8_t *wend = (const uint8_t *)m_program->get_write_ptr(page + PAGE_SIZE - 1);
+			bool const readonly = (wstart != rstart) || (wend != rend);
+
+			if (!found.empty() && found.back().end == page - 1 && found.back().readonly == readonly && (const uint8_t *)found.back().base + (page - found.back().start) == rstart)
+				found.back().end = page + PAGE_SIZE - 1;
+			else
+				found.push_back(auto_fastram{ page, page + PAGE_SIZE - 1, 0, readonly, (void *)rstart });
+		}
+
+		/* fold runs of identical mirrors into one masked block */
+		std::vector<auto_fastram> folded;
+		for (auto const &block : found)
+		{
+			offs_t const length = block.end - block.start + 1;
+			if (!folded.empty())
+			{
+				auto_fastram &last = folded.back();
+				offs_t const lastlength = last.mask ? (last.mask + 1) : (last.end - last.start + 1);
+				if (last.end == block.start - 1 && last.base == block.base && last.readonly == block.readonly && lastlength == length &&
+						(length & (length - 1)) == 0 && (last.start & (length - 1)) == 0)
+				{
+					last.end = block.end;
+					last.mask = length - 1;
+					continue;
+				}
+			}
+			folded.push_back(block);
+		}
+
+		/* the biggest blocks go first, and the chain stays short for everything else */
+		std::stable_sort(folded.begin(), folded.end(), [](auto const &a, auto const &b) { return (a.end - a.start) > (b.end - b.start); });
+		if (folded.size() > SH2_MAX_AUTO_FASTRAM)
+			folded.resize(SH2_MAX_AUTO_FASTRAM);
+		found = std::move(folded);
+	}
+
+	/* only regenerate the accessors if something moved */
+	if (found != m_auto_fastram)
+	{
+		m_auto_fastram = std::move(found);
+		m_cache_dirty = true;
+	}
+}
+
+
 /*------------------------------------------------------------------
     static_generate_memory_accessor
 ------------------------------------------------------------------*/
@@ -909,11 +1001,18 @@ void sh2_device::static_generate_memory_accessor(int size, int iswrite, const ch
 
 	UML_LABEL(block, label++);              // label:
 
+	/* driver-supplied blocks first, then whatever the address map scan found */
+	std::vector<auto_fastram> fastram;
 	for (auto & elem : m_fastram)
+		if (elem.base != nullptr)
+			fastram.push_back(auto_fastram{ elem.start, elem.end, 0, elem.readonly, elem.base });
+	fastram.insert(fastram.end(), m_auto_fastram.begin(), m_auto_fastram.end());
+
+	for (auto & elem : fastram)
 	{
-		if (elem.base != nullptr && (!iswrite || !elem.readonly))
+		if (!iswrite || !elem.readonly)
 		{
-			void *fastbase = (uint8_t *)elem.base - elem.start;
+			void *fastbase = elem.mask ? elem.base : (uint8_t *)elem.base - elem.start;
 			uint32_t skip = label++;
 			if (elem.end != 0xffffffff)
 			{
@@ -925,6 +1024,8 @@ void sh2_device::static_generate_memory_accessor(int size, int iswrite, const ch
 				UML_CMP(block, I0, elem.start);// cmp     i0,fastram_start
 				UML_JMPc(block, COND_B, skip);                                      // jb      skip
 			}
+			if (elem.mask)
+				UML_AND(block, I0, I0, elem.mask);                                  // and     i0,i0,mask
 
 			if (!iswrite)
 			{
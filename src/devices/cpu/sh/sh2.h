@@ -160,6 +160,20 @@ private:
 
 	std::unique_ptr<sh2_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
 
+	/* fast RAM found by scanning the address map */
+	struct auto_fastram
+	{
+		offs_t          start;                      /* first address covered */
+		offs_t          end;                        /* last address covered */
+		offs_t          mask;                       /* mirror mask applied to the address, or 0 if not mirrored */
+		bool            readonly;                   /* true if writes take the slow path */
+		void *          base;                       /* host memory for the block */
+
+		bool operator==(const auto_fastram &that) const { return start == that.start && end == that.end && mask == that.mask && readonly == that.readonly && base == that.base; }
+	};
+	std::vector<auto_fastram> m_auto_fastram;
+	bool m_fastram_dirty;                                        /* address map changed since the last scan */
+
 	uint32_t m_debugger_temp;
 
 	virtual uint8_t RB(offs_t A) override;
@@ -192,6 +206,7 @@ private:
 	virtual void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception) override;
 	virtual void static_generate_entry_point() override;
 	virtual void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle *&handleptr) override;
+	void fastram_discover();
 
 };
 
@@ -821,12 +821,25 @@ inline void sh34_base_device::PREFM(const uint16_t opcode)
 			addr = addr & 0xFFFFFFE0;
 		}
 
-		for (a = 0;a < 4;a++)
+		if (m_sq_ram)
 		{
-			// shouldn't be causing a memory read, should store sq writes in registers.
-			m_program->write_qword(dest, m_program->read_qword(addr));
-			addr += 8;
-			dest += 8;
+			// take the queue straight from its backing RAM rather than through the read handlers
+			const uint64_t *sq_data = &m_sq_ram[(addr & 0x20) >> 3];
+			for (a = 0;a < 4;a++)
+			{
+				m_program->write_qword(dest, sq_data[a]);
+				dest += 8;
+			}
+		}
+		else
+		{
+			for (a = 0;a < 4;a++)
+			{
+				// shouldn't be causing a memory read, should store sq writes in registers.
+				m_program->write_qword(dest, m_program->read_qword(addr));
+				addr += 8;
+				dest += 8;
+			}
 		}
 	}
 }
@@ -1980,6 +1993,9 @@ void sh4_base_device::device_start()
 {
 	sh34_base_device::device_start();
 
+	// the store queues are plain RAM in the internal map, so PREF can flush them without a read per qword
+	m_sq_ram = static_cast<uint64_t *>(m_program->get_write_ptr(0xe0000000));
+
 	int i;
 	for (i = 0;i < 64;i++)
 	{
@@ -2045,6 +2061,7 @@ void sh34_base_device::device_start()
 
 	m_internal = &space(AS_PROGRAM);
 	m_program = &space(AS_PROGRAM);
+	m_sq_ram = nullptr;
 	m_io = &space(AS_IO);
 	if (m_program->endianness() == ENDIANNESS_LITTLE)
 	{
@@ -2914,10 +2931,17 @@ static void cfunc_PREFM(void *param) { ((sh34_base_device *)param)->func_PREFM()
 
 bool sh34_base_device::generate_group_0_PREFM(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
+	// only a store queue address does anything; a plain cache prefetch is a no-op here
+	UML_AND(block, I0, R32(Rn), 0xfc000000);
+	UML_CMP(block, I0, 0xe0000000);
+	UML_JMPc(block, COND_NE, compiler.labelnum);
+
 	save_fast_iregs(block);
 	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
 	UML_CALLC(block, cfunc_PREFM, this);
 	load_fast_iregs(block);
+
+	UML_LABEL(block, compiler.labelnum++);  // labelnum:
 	return true;
 }
 
@@ -3838,15 +3862,19 @@ bool sh34_base_device::generate_group_15_op1111_0x13_FCNVDS(drcuml_block &block,
 	return true;
 }
 
-void sh34_base_device::func_FIPR() { FIPR(m_sh2_state->arg0); }
-static void cfunc_FIPR(void *param) { ((sh34_base_device *)param)->func_FIPR(); };
-
 bool sh34_base_device::generate_group_15_op1111_0x13_FIPR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FIPR, this);
-	load_fast_iregs(block);
+	const int n = Rn & 12;
+	const int m = (Rn & 3) << 2;
+
+	// sum the products in the same order as the interpreter so the rounding matches
+	UML_FSMUL(block, F0, FPS32(n), FPS32(m));
+	for (int a = 1; a < 4; a++)
+	{
+		UML_FSMUL(block, F1, FPS32(n + a), FPS32(m + a));
+		UML_FSADD(block, F0, F0, F1);
+	}
+	UML_FSMOV(block, FPS32(n + 3), F0);
 	return true;
 }
 
@@ -3905,15 +3933,25 @@ bool sh34_base_device::generate_group_15_op1111_0x13_op1111_0xf13_FRCHG(drcuml_b
 	return true;
 }
 
-void sh34_base_device::func_FTRV() { FTRV(m_sh2_state->arg0); }
-static void cfunc_FTRV(void *param) { ((sh34_base_device *)param)->func_FTRV(); };
-
 bool sh34_base_device::generate_group_15_op1111_0x13_op1111_0xf13_FTRV(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FTRV, this);
-	load_fast_iregs(block);
+	const int n = Rn & 12;
+
+	// FVn = XMTRX * FVn: each row of XF scaled by one element of FVn, accumulated in row order
+	UML_VLOAD(block, V1, m_sh2_state->m_fr, n >> 2);
+	UML_VXOR(block, V0, V0, V0);
+	for (int j = 0; j < 4; j++)
+	{
+		uint32_t lanes = 0;
+		for (int lane = 0; lane < 8; lane++)
+			lanes |= uint32_t(j * 2 + (lane & 1)) << (lane * 4);
+
+		UML_VSHUF(block, V2, V1, lanes);
+		UML_VLOAD(block, V3, m_sh2_state->m_xf, j);
+		UML_VFMUL(block, V3, V3, V2);
+		UML_VFADD(block, V0, V0, V3);
+	}
+	UML_VSTORE(block, m_sh2_state->m_fr, n >> 2, V0);
 	return true;
 }
 
@@ -231,11 +231,9 @@ public:
 	void func_FMAC();
 	void func_FABS();
 	void func_FLDS();
-	void func_FTRV();
 	void func_FSTS();
 	void func_FSSCA();
 	void func_FCNVSD();
-	void func_FIPR();
 	void func_FSRRA();
 	void func_FSQRT();
 	void func_FCNVDS();
@@ -380,6 +378,9 @@ protected:
 	/* This MMU simulation is good for the simple remap used on Naomi GD-ROM SQ access *ONLY* */
 	uint8_t m_sh4_mmu_enabled;
 
+	// backing RAM of the two store queues, for flushing them without read handlers
+	uint64_t *m_sq_ram;
+
 	// sh3 internal
 	uint32_t  m_sh3internal_upper[0x3000/4];
 	uint32_t  m_sh3internal_lower[0x1000];
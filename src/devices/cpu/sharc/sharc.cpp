@@ -458,6 +458,9 @@ void adsp21062_device::device_start()
 
 	build_opcode_table();
 
+	std::fill(std::begin(m_compute_fallbacks), std::end(m_compute_fallbacks), 0);
+	std::fill(std::begin(m_shiftimm_fallbacks), std::end(m_shiftimm_fallbacks), 0);
+
 	// init UML generator
 	uint32_t umlflags = 0;
 	m_drcuml = std::make_unique<drcuml_state>(*this, m_cache, umlflags, 1, 24, 0);
@@ -926,6 +929,25 @@ void adsp21062_device::device_reset()
 }
 
 
+void adsp21062_device::device_stop()
+{
+	// list whatever the recompiler still leaves to the interpreter
+	static char const *const units[] = { "ALU", "multiplier", "shifter", "unit 3" };
+	for (int i = 0; i < ARRAY_LENGTH(m_compute_fallbacks); i++)
+	{
+		if (m_compute_fallbacks[i] == 0)
+			continue;
+		if (i & 0x400)
+			logerror("compute fallback: multifunction %02X, %u times\n", i & 0x3f, m_compute_fallbacks[i]);
+		else
+			logerror("compute fallback: %s %02X, %u times\n", units[(i >> 8) & 3], i & 0xff, m_compute_fallbacks[i]);
+	}
+	for (int i = 0; i < ARRAY_LENGTH(m_shiftimm_fallbacks); i++)
+		if (m_shiftimm_fallbacks[i] != 0)
+			logerror("shift immediate fallback: %02X, %u times\n", i, m_shiftimm_fallbacks[i]);
+}
+
+
 void adsp21062_device::execute_set_input(int irqline, int state)
 {
 	if (irqline >= 0 && irqline <= 2)
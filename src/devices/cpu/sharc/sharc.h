@@ -113,8 +113,8 @@ public:
 	void sharc_cfunc_statusstack_overflow();
 	void sharc_cfunc_statusstack_underflow();
 
-	void sharc_cfunc_unimplemented_compute();
-	void sharc_cfunc_unimplemented_shiftimm();
+	void sharc_cfunc_compute_fallback();
+	void sharc_cfunc_shiftimm_fallback();
 	void sharc_cfunc_write_snoop();
 
 	void enable_recompiler();
@@ -208,6 +208,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 
 	// device_execute_interface overrides
 	virtual uint32_t execute_min_cycles() const override { return 8; }
@@ -462,6 +463,12 @@ private:
 
 	bool m_enable_drc;
 
+	// compute and immediate shift operations the recompiler handed to the interpreter,
+	// indexed by compute_fallback_index and by shift operation
+	uint32_t m_compute_fallbacks[0x440];
+	uint32_t m_shiftimm_fallbacks[0x40];
+	static int compute_fallback_index(uint32_t opcode) { return (opcode & 0x400000) ? (0x400 | ((opcode >> 16) & 0x3f)) : ((opcode >> 12) & 0x3ff); }
+
 	inline void CHANGE_PC(uint32_t newpc);
 	inline void CHANGE_PC_DELAYED(uint32_t newpc);
 	void sharc_iop_delayed_w(uint32_t reg, uint32_t data, int cycles);
@@ -628,7 +635,10 @@ private:
 	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, bool last_delayslot);
 	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception);
 	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void generate_unimplemented_compute(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_compute_fallback(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_shift_imm_fallback(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int data, int shiftop, int rn, int rx);
+	void pack_astat_drc();
+	void unpack_astat_drc();
 	void generate_compute(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
 	void generate_if_condition(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int condition, int skip_label);
 	void generate_do_condition(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int condition, int skip_label, ASTAT_DRC &astat);
@@ -154,16 +154,16 @@ static void cfunc_statusstack_underflow(void *param)
 	sharc->sharc_cfunc_statusstack_underflow();
 }
 
-static void cfunc_unimplemented_compute(void *param)
+static void cfunc_compute_fallback(void *param)
 {
 	adsp21062_device *sharc = (adsp21062_device *)param;
-	sharc->sharc_cfunc_unimplemented_compute();
+	sharc->sharc_cfunc_compute_fallback();
 }
 
-static void cfunc_unimplemented_shiftimm(void *param)
+static void cfunc_shiftimm_fallback(void *param)
 {
 	adsp21062_device *sharc = (adsp21062_device *)param;
-	sharc->sharc_cfunc_unimplemented_shiftimm();
+	sharc->sharc_cfunc_shiftimm_fallback();
 }
 
 void adsp21062_device::sharc_cfunc_unimplemented()
@@ -172,16 +172,58 @@ void adsp21062_device::sharc_cfunc_unimplemented()
 	fatalerror("PC=%08X: Unimplemented op %04X%08X\n", m_core->pc, (uint32_t)(op >> 32), (uint32_t)(op));
 }
 
-void adsp21062_device::sharc_cfunc_unimplemented_compute()
+// the interpreter keeps ASTAT packed, the recompiler keeps one word per flag
+void adsp21062_device::pack_astat_drc()
 {
-	uint64_t op = m_core->arg64;
-	fatalerror("PC=%08X: Unimplemented compute %04X%08X\n", m_core->pc, (uint32_t)(op >> 32), (uint32_t)(op));
+	ASTAT_DRC const &a = m_core->astat_drc;
+	m_core->astat = (m_core->astat & (FLG0 | FLG1 | FLG2 | FLG3)) |
+			(a.az << AZ_SHIFT) | (a.av << AV_SHIFT) | (a.an << AN_SHIFT) | (a.ac << AC_SHIFT) |
+			(a.as << AS_SHIFT) | (a.ai << AI_SHIFT) | (a.mn << MN_SHIFT) | (a.mv << MV_SHIFT) |
+			(a.mu << MU_SHIFT) | (a.mi << MI_SHIFT) | (a.af << AF_SHIFT) | (a.sv << SV_SHIFT) |
+			(a.sz << SZ_SHIFT) | (a.ss << SS_SHIFT) | (a.btf << BTF_SHIFT) | (a.cacc << 24);
 }
 
-void adsp21062_device::sharc_cfunc_unimplemented_shiftimm()
+void adsp21062_device::unpack_astat_drc()
 {
-	uint64_t op = m_core->arg64;
-	fatalerror("PC=%08X: Unimplemented shiftimm %04X%08X\n", m_core->pc, (uint32_t)(op >> 32), (uint32_t)(op));
+	ASTAT_DRC &a = m_core->astat_drc;
+	uint32_t const astat = m_core->astat;
+	a.az = BIT(astat, AZ_SHIFT);
+	a.av = BIT(astat, AV_SHIFT);
+	a.an = BIT(astat, AN_SHIFT);
+	a.ac = BIT(astat, AC_SHIFT);
+	a.as = BIT(astat, AS_SHIFT);
+	a.ai = BIT(astat, AI_SHIFT);
+	a.mn = BIT(astat, MN_SHIFT);
+	a.mv = BIT(astat, MV_SHIFT);
+	a.mu = BIT(astat, MU_SHIFT);
+	a.mi = BIT(astat, MI_SHIFT);
+	a.af = BIT(astat, AF_SHIFT);
+	a.sv = BIT(astat, SV_SHIFT);
+	a.sz = BIT(astat, SZ_SHIFT);
+	a.ss = BIT(astat, SS_SHIFT);
+	a.btf = BIT(astat, BTF_SHIFT);
+	a.cacc = astat >> 24;
+}
+
+void adsp21062_device::sharc_cfunc_compute_fallback()
+{
+	uint32_t const opcode = uint32_t(m_core->arg64) & 0x7fffff;
+	m_compute_fallbacks[compute_fallback_index(opcode)]++;
+
+	pack_astat_drc();
+	COMPUTE(opcode);
+	unpack_astat_drc();
+}
+
+void adsp21062_device::sharc_cfunc_shiftimm_fallback()
+{
+	uint32_t const args = m_core->arg0;
+	int const shiftop = (args >> 16) & 0x3f;
+	m_shiftimm_fallbacks[shiftop]++;
+
+	pack_astat_drc();
+	SHIFT_OPERATION_IMM(shiftop, args & 0xfff, (args >> 24) & 0xf, (args >> 28) & 0xf);
+	unpack_astat_drc();
 }
 
 void adsp21062_device::sharc_cfunc_pcstack_overflow()
@@ -3358,11 +3400,22 @@ bool adsp21062_device::generate_opcode(drcuml_block &block, compiler_state &comp
 	return false;
 }
 
-void adsp21062_device::generate_unimplemented_compute(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+void adsp21062_device::generate_compute_fallback(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
 {
+	save_fast_iregs(block);
 	UML_MOV(block, mem(&m_core->pc), desc->pc);
 	UML_DMOV(block, mem(&m_core->arg64), desc->opptr.q[0]);
-	UML_CALLC(block, cfunc_unimplemented_compute, this);
+	UML_CALLC(block, cfunc_compute_fallback, this);
+	load_fast_iregs(block);
+}
+
+void adsp21062_device::generate_shift_imm_fallback(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int data, int shiftop, int rn, int rx)
+{
+	save_fast_iregs(block);
+	UML_MOV(block, mem(&m_core->pc), desc->pc);
+	UML_MOV(block, mem(&m_core->arg0), (data & 0xfff) | (shiftop << 16) | (rn << 24) | (rx << 28));
+	UML_CALLC(block, cfunc_shiftimm_fallback, this);
+	load_fast_iregs(block);
 }
 
 void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
@@ -3392,7 +3445,31 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 		{
 			case 0x00:          // Rn = MRxx
 			{
-				generate_unimplemented_compute(block, compiler, desc);
+				int ai = rs;
+				switch (ai)
+				{
+					case 0x00:  // MR0F
+						UML_DMOV(block, I0, MRF);
+						break;
+					case 0x01:  // MR1F
+						UML_DSHR(block, I0, MRF, 32);
+						break;
+					case 0x04:  // MR0B
+						UML_DMOV(block, I0, MRB);
+						break;
+					case 0x05:  // MR1B
+						UML_DSHR(block, I0, MRB, 32);
+						break;
+
+					default:    // MR2F, MR2B
+						generate_compute_fallback(block, compiler, desc);
+						return;
+				}
+				UML_MOV(block, REG(rn), I0);
+				if (MN_CALC_REQUIRED) UML_MOV(block, ASTAT_MN, 0);
+				if (MV_CALC_REQUIRED) UML_MOV(block, ASTAT_MV, 0);
+				if (MU_CALC_REQUIRED) UML_MOV(block, ASTAT_MU, 0);
+				if (MI_CALC_REQUIRED) UML_MOV(block, ASTAT_MI, 0);
 				return;
 			}
 
@@ -3424,7 +3501,7 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 
 					case 0x02:  // MR2F
 					case 0x06:  // MR2B
-						generate_unimplemented_compute(block, compiler, desc);
+						generate_compute_fallback(block, compiler, desc);
 						return;
 				}
 				return;
@@ -3445,17 +3522,17 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 			case 0x14:          // Rm = MRF - R3-0 * R7-4 (SSFR),   Ra = R11-8 + R15-12
 			case 0x15:          // Rm = MRF - R3-0 * R7-4 (SSFR),   Ra = R11-8 - R15-12
 			case 0x16:          // Rm = MRF - R3-0 * R7-4 (SSFR),   Ra = (R11-8 + R15-12) / 2
-				generate_unimplemented_compute(block, compiler, desc);
+				generate_compute_fallback(block, compiler, desc);
 				return;
 
 			case 0x1c:          // Fm = F3-0 * F7-4,   Fa = (F11-8 + F15-12) / 2
-				generate_unimplemented_compute(block, compiler, desc);
+				generate_compute_fallback(block, compiler, desc);
 				return;
 
 			case 0x20: case 0x21: case 0x22: case 0x23: case 0x24: case 0x25: case 0x26: case 0x27:
 			case 0x28: case 0x29: case 0x2a: case 0x2b: case 0x2c: case 0x2d: case 0x2e: case 0x2f:
 				// Rm = R3-0 * R7-4 (SSFR),   Ra = R11-8 + R15-12,   Rs = R11-8 - R15-12
-				generate_unimplemented_compute(block, compiler, desc);
+				generate_compute_fallback(block, compiler, desc);
 				return;
 
 			case 0x30: case 0x31: case 0x32: case 0x33: case 0x34: case 0x35: case 0x36: case 0x37:
@@ -3788,7 +3865,7 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 				return;
 
 			default:
-				generate_unimplemented_compute(block, compiler, desc);
+				generate_compute_fallback(block, compiler, desc);
 				return;
 		}
 	}
@@ -3817,7 +3894,7 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 					case 0xa5:      // Fn = RND Fx
 					case 0xad:      // Rn = MANT Fx
 					case 0xcd:      // Rn = TRUNC Fx
-						generate_unimplemented_compute(block, compiler, desc);
+						generate_compute_fallback(block, compiler, desc);
 						return;
 
 					case 0x01:      // Rn = Rx + Ry
@@ -4388,7 +4465,7 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 					}
 
 					default:
-						generate_unimplemented_compute(block, compiler, desc);
+						generate_compute_fallback(block, compiler, desc);
 						return;
 				}
 				break;
@@ -4550,7 +4627,7 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 					case 0x1d:      // MRF = RND MRF (S)
 					case 0x1e:      // MRB = RND MRB (U)
 					case 0x1f:      // MRB = RND MRB (S)
-						generate_unimplemented_compute(block, compiler, desc);
+						generate_compute_fallback(block, compiler, desc);
 						return;
 
 					case 0x14:      // MRF = 0
@@ -4611,7 +4688,7 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 						return;
 
 					default:
-						generate_unimplemented_compute(block, compiler, desc);
+						generate_compute_fallback(block, compiler, desc);
 						return;
 				}
 				break;
@@ -4632,7 +4709,7 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 					case 0x8c:      // Rn = LEFTO Rx
 					case 0x90:      // Rn = FPACK Fx
 					case 0x94:      // Fn = FUNPACK Rx
-						generate_unimplemented_compute(block, compiler, desc);
+						generate_compute_fallback(block, compiler, desc);
 						return;
 
 					case 0x00:      // Rn = LSHIFT Rx BY Ry | <data8>
@@ -4827,14 +4904,14 @@ void adsp21062_device::generate_compute(drcuml_block &block, compiler_state &com
 					}
 
 					default:
-						generate_unimplemented_compute(block, compiler, desc);
+						generate_compute_fallback(block, compiler, desc);
 						return;
 				}
 				break;
 			}
 
 			default:
-				generate_unimplemented_compute(block, compiler, desc);
+				generate_compute_fallback(block, compiler, desc);
 				return;
 		}
 	}
@@ -5149,9 +5226,7 @@ void adsp21062_device::generate_shift_imm(drcuml_block &block, compiler_state &c
 		case 0x11:      // FDEP Rx BY <bit6>:<len6>
 		case 0x13:      // FDEP Rx BY <bit6>:<len6> (SE)
 		case 0x1b:      // Rn = Rn OR FDEP Rx BY <bit6>:<len6> (SE)
-			UML_MOV(block, mem(&m_core->pc), desc->pc);
-			UML_DMOV(block, mem(&m_core->arg64), desc->opptr.q[0]);
-			UML_CALLC(block, cfunc_unimplemented_shiftimm, this);
+			generate_shift_imm_fallback(block, compiler, desc, data, shiftop, rn, rx);
 			break;
 
 		case 0x00:      // LSHIFT Rx BY <data8>
@@ -5302,9 +5377,7 @@ void adsp21062_device::generate_shift_imm(drcuml_block &block, compiler_state &c
 			return;
 
 		default:
-			UML_MOV(block, mem(&m_core->pc), desc->pc);
-			UML_DMOV(block, mem(&m_core->arg64), desc->opptr.q[0]);
-			UML_CALLC(block, cfunc_unimplemented_compute, this);
+			generate_shift_imm_fallback(block, compiler, desc, data, shiftop, rn, rx);
 			return;
 	}
 }
@@ -0,0 +1,1422 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    32031drc.cpp
+
+    Universal machine language-based TMS320C3x recompiler.
+
+    Compiled code works directly on the live register file, so anything
+    outside it sees the same state it would under the interpreter.
+    Integer loads, stores and arithmetic, register pushes and pops,
+    direct and indirect addressing (including circular buffers), the
+    parallel load and store pairs, branches, calls and returns, and the
+    RPTB and RPTS repeat loops are compiled natively.  Floating point
+    values move between registers and memory natively as well, but
+    floating point arithmetic still calls the interpreter's handlers:
+    their truncation and rounding follow the C3x's 40-bit format, which
+    host doubles can't reproduce exactly (the same reason the USE_FP
+    paths in 32031ops.hxx are disabled).
+
+    The interpreter runs the three instructions after a delayed branch
+    without checking for the end of a repeat block or taking interrupts,
+    and so does compiled code.  IDLE, traps, RETI and anything that
+    loads ST, IE, IF or IOF leave compiled code so that the interpreter
+    can run them and take any interrupt they expose.
+
+    The on-chip RAM blocks are accessed directly from compiled code;
+    drivers can add other RAM with add_fastram().
+
+***************************************************************************/
+
+#include "emu.h"
+#include "tms32031.h"
+#include "32031fe.h"
+
+#include "cpu/drcumlsh.h"
+
+
+namespace {
+
+// exit codes from compiled code
+enum
+{
+	EXECUTE_OUT_OF_CYCLES = 0,
+	EXECUTE_MISSING_CODE,
+	EXECUTE_INTERPRET,
+	EXECUTE_RESET_CACHE
+};
+
+constexpr size_t DRC_CACHE_SIZE = 8 * 1024 * 1024;
+
+// frontend window, in instructions
+constexpr u32 COMPILE_BACKWARDS = 128;
+constexpr u32 COMPILE_FORWARDS = 512;
+constexpr u32 COMPILE_MAX_SEQUENCE = 64;
+
+// register file indexes and status bits; these are private to tms32031.cpp
+enum
+{
+	TMR_AR0 = 8,
+	TMR_DP = 16,
+	TMR_IR0,
+	TMR_IR1,
+	TMR_BK,
+	TMR_SP,
+	TMR_ST,
+	TMR_RS = 25,
+	TMR_RE,
+	TMR_RC
+};
+
+constexpr uint32_t CFLAG = 0x0001;
+constexpr uint32_t VFLAG = 0x0002;
+constexpr uint32_t ZFLAG = 0x0004;
+constexpr uint32_t NFLAG = 0x0008;
+constexpr uint32_t UFFLAG = 0x0010;
+constexpr uint32_t OVMFLAG = 0x0080;
+constexpr uint32_t RMFLAG = 0x0100;
+
+// the low bits of most two-operand instructions' table index
+enum
+{
+	MODE_REG,
+	MODE_DIR,
+	MODE_IND,
+	MODE_IMM
+};
+
+// indirect addressing modes below bit reversal are compiled
+constexpr bool indirect_is_native(uint32_t modebyte) { return ((modebyte >> 3) & 31) <= 0x18; }
+
+} // anonymous namespace
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+// state tracked while compiling a block
+struct tms3203x_device::compiler_state
+{
+	uint32_t cycles;            // cycles not yet subtracted from the count
+	uml::code_label labelnum;   // next local label number
+	bool pcsynced;              // PC has been stored for this instruction
+	bool checkdirty;            // the instruction may have changed the memory map
+	bool dirtypending;          // a delay slot may have changed the memory map
+};
+
+
+
+/***************************************************************************
+    SETUP
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_init - set up the recompiler if it's
+    allowed
+-------------------------------------------------*/
+
+void tms3203x_device::drc_init()
+{
+	// the debugger needs to see every instruction
+	if (!allow_drc() || (machine().debug_flags & DEBUG_FLAG_ENABLED))
+		return;
+
+	// PCs are 24 bits, but register branches can leave anything in the upper byte
+	m_drc_cache = std::make_unique<drc_cache>(DRC_CACHE_SIZE);
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drc_cache, 0, 1, 32, 0);
+	m_drcfe = std::make_unique<tms3203x_frontend>(*this, COMPILE_BACKWARDS, COMPILE_FORWARDS, COMPILE_MAX_SEQUENCE);
+
+	m_drcuml->symbol_add(&m_pc, sizeof(m_pc), "pc");
+	m_drcuml->symbol_add(&m_icount, sizeof(m_icount), "icount");
+	m_drcuml->symbol_add(&m_r[0], sizeof(m_r), "r");
+	m_drcuml->symbol_add(&m_bkmask, sizeof(m_bkmask), "bkmask");
+	m_drcuml->symbol_add(&m_delayed, sizeof(m_delayed), "delayed");
+	m_drcuml->symbol_add(&m_irq_pending, sizeof(m_irq_pending), "irq_pending");
+
+	m_drc_entry = m_drcuml->handle_alloc("entry");
+	m_drc_nocode = m_drcuml->handle_alloc("nocode");
+	m_drc_out_of_cycles = m_drcuml->handle_alloc("out_of_cycles");
+	m_drc_reset_cache = m_drcuml->handle_alloc("reset_cache");
+	m_drc_read = m_drcuml->handle_alloc("read");
+	m_drc_write = m_drcuml->handle_alloc("write");
+
+	// the on-chip RAM blocks are plain RAM
+	offs_t const ramstart = (m_chip_type == CHIP_TYPE_TMS32032) ? 0x87fe00 : 0x809800;
+	offs_t const ramend = (m_chip_type == CHIP_TYPE_TMS32032) ? 0x87ffff : 0x809fff;
+	void *const rambase = m_program->get_write_ptr(ramstart);
+	if (rambase)
+		add_fastram(ramstart, ramend, false, rambase);
+
+	drc_flush_cache();
+
+	// map changes and bank switches can swap code out from under compiled blocks
+	auto invalidate = [this] (read_or_write mode) { m_drc_cache_dirty = true; };
+	m_program->add_change_notifier(invalidate);
+	m_program->add_bank_notifier(invalidate);
+}
+
+
+/*-------------------------------------------------
+    add_fastram - let compiled code access a block
+    of RAM directly
+-------------------------------------------------*/
+
+void tms3203x_device::add_fastram(offs_t start, offs_t end, bool readonly, void *base)
+{
+	if (m_fastram_select < ARRAY_LENGTH(m_fastram))
+	{
+		m_fastram[m_fastram_select].start = start;
+		m_fastram[m_fastram_select].end = end;
+		m_fastram[m_fastram_select].readonly = readonly;
+		m_fastram[m_fastram_select].base = reinterpret_cast<uint32_t *>(base);
+		m_fastram_select++;
+
+		// the memory accessors are rebuilt with the cache
+		m_drc_cache_dirty = true;
+	}
+}
+
+
+/*-------------------------------------------------
+    drc_flush_cache - empty the cache and
+    regenerate the static code
+-------------------------------------------------*/
+
+void tms3203x_device::drc_flush_cache()
+{
+	m_drcuml->reset();
+	m_drc_cache_dirty = false;
+
+	try
+	{
+		// look up the block for the current PC
+		drcuml_block &entry(m_drcuml->begin_block(4));
+		UML_HANDLE(entry, *m_drc_entry);                                        // handle  entry
+		UML_LOAD(entry, I0, &m_pc, 0, SIZE_DWORD, SCALE_x4);                    // load    i0,pc
+		UML_HASHJMP(entry, 0, I0, *m_drc_nocode);                               // hashjmp 0,i0,nocode
+		entry.end();
+
+		// exits that leave the PC where the handler was given it
+		auto const exit_handler = [this] (uml::code_handle &handle, int code)
+		{
+			drcuml_block &block(m_drcuml->begin_block(4));
+			UML_HANDLE(block, handle);                                          // handle  handle
+			UML_GETEXP(block, I0);                                              // getexp  i0
+			UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x4);               // store   pc,i0
+			UML_EXIT(block, code);                                              // exit    code
+			block.end();
+		};
+		exit_handler(*m_drc_nocode, EXECUTE_MISSING_CODE);
+		exit_handler(*m_drc_out_of_cycles, EXECUTE_OUT_OF_CYCLES);
+		exit_handler(*m_drc_reset_cache, EXECUTE_RESET_CACHE);
+
+		generate_memory_accessors();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unrecoverable error generating TMS320C3x static code\n");
+	}
+}
+
+
+/*-------------------------------------------------
+    drc_check_repeat - tell the frontend about an
+    active repeat block, flushing code compiled
+    without it
+-------------------------------------------------*/
+
+void tms3203x_device::drc_check_repeat()
+{
+	if (m_r[TMR_ST].i32[0] & RMFLAG)
+		m_drcfe->add_repeat(m_r[TMR_RE].i32[0] + 1, m_r[TMR_RS].i32[0]);
+
+	if (m_drcfe->take_new_repeats())
+		drc_flush_cache();
+}
+
+
+
+/***************************************************************************
+    EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    execute_run_drc - run compiled code until the
+    cycles run out
+-------------------------------------------------*/
+
+void tms3203x_device::execute_run_drc()
+{
+	// repeats may have been started by the interpreter or a state load
+	drc_check_repeat();
+
+	do
+	{
+		if (m_drc_cache_dirty)
+			drc_flush_cache();
+
+		switch (m_drcuml->execute(*m_drc_entry))
+		{
+		case EXECUTE_MISSING_CODE:
+			drc_compile_block(m_pc);
+			break;
+
+		case EXECUTE_INTERPRET:
+			if (!check_repeat())
+				execute_one();
+			drc_check_repeat();
+			break;
+
+		case EXECUTE_RESET_CACHE:
+			drc_flush_cache();
+			break;
+		}
+	} while (m_icount > 0);
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_memory_accessors - generate the
+    subroutines compiled code reads and writes
+    memory through; the address is in I1, data
+    to write in I2, and data read is returned in
+    I0
+-------------------------------------------------*/
+
+void tms3203x_device::generate_memory_accessors()
+{
+	drcuml_block &read(m_drcuml->begin_block(1024));
+	UML_HANDLE(read, *m_drc_read);                                              // handle  read
+	UML_AND(read, I1, I1, 0xffffff);                                            // and     i1,i1,0xffffff
+	for (uint32_t ramnum = 0; ramnum < m_fastram_select; ramnum++)
+	{
+		uml::code_label const skip = ramnum + 1;
+		UML_CMP(read, I1, m_fastram[ramnum].end);                               // cmp     i1,end
+		UML_JMPc(read, COND_A, skip);                                           // ja      skip
+		UML_CMP(read, I1, m_fastram[ramnum].start);                             // cmp     i1,start
+		UML_JMPc(read, COND_B, skip);                                           // jb      skip
+		UML_LOAD(read, I0, m_fastram[ramnum].base - m_fastram[ramnum].start, I1, SIZE_DWORD, SCALE_x4); // load    i0,base,i1
+		UML_RET(read);                                                          // ret
+		UML_LABEL(read, skip);                                                  // skip:
+	}
+	UML_READ(read, I0, I1, SIZE_DWORD, SPACE_PROGRAM);                          // read    i0,i1,dword,program
+	UML_RET(read);                                                              // ret
+	read.end();
+
+	drcuml_block &write(m_drcuml->begin_block(1024));
+	UML_HANDLE(write, *m_drc_write);                                            // handle  write
+	UML_AND(write, I1, I1, 0xffffff);                                           // and     i1,i1,0xffffff
+	for (uint32_t ramnum = 0; ramnum < m_fastram_select; ramnum++)
+	{
+		if (m_fastram[ramnum].readonly)
+			continue;
+		uml::code_label const skip = ramnum + 1;
+		UML_CMP(write, I1, m_fastram[ramnum].end);                              // cmp     i1,end
+		UML_JMPc(write, COND_A, skip);                                          // ja      skip
+		UML_CMP(write, I1, m_fastram[ramnum].start);                            // cmp     i1,start
+		UML_JMPc(write, COND_B, skip);                                          // jb      skip
+		UML_STORE(write, m_fastram[ramnum].base - m_fastram[ramnum].start, I1, I2, SIZE_DWORD, SCALE_x4); // store   base,i1,i2
+		UML_RET(write);                                                         // ret
+		UML_LABEL(write, skip);                                                 // skip:
+	}
+	UML_WRITE(write, I1, I2, SIZE_DWORD, SPACE_PROGRAM);                        // write   i1,i2,dword,program
+	UML_RET(write);                                                             // ret
+	write.end();
+}
+
+
+/*-------------------------------------------------
+    drc_compile_block - compile a block starting
+    at the given PC
+-------------------------------------------------*/
+
+void tms3203x_device::drc_compile_block(offs_t pc)
+{
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	// describing an RPTB or RPTS reveals a block end that code compiled earlier doesn't test for
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+	while (m_drcfe->take_new_repeats())
+	{
+		drc_flush_cache();
+		desclist = m_drcfe->describe_code(pc);
+	}
+
+	bool override = false;
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			drcuml_block &block(m_drcuml->begin_block(16384));
+			compiler_state compiler = { 0, 1, false, false, false };
+			const opcode_desc *seqlast;
+
+			for (const opcode_desc *seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				if (m_drcuml->logging())
+					block.append_comment("-------------------------");                     // comment
+
+				// determine the last instruction in this sequence
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				// if we don't have a hash for this PC, or if we are overriding all, add one
+				if (override || !m_drcuml->hash_exists(0, seqhead->pc))
+					UML_HASH(block, 0, seqhead->pc);                                            // hash    0,seqhead->pc
+
+				// if this is the first sequence, we're recompiling after the code changed
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, 0, seqhead->pc);                                            // hash    0,seqhead->pc
+				}
+
+				// otherwise, redispatch to the existing code
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                                 // label   seqhead->pc
+					UML_HASHJMP(block, 0, seqhead->pc, *m_drc_nocode);                          // hashjmp 0,seqhead->pc,nocode
+					continue;
+				}
+
+				// make sure we're running what we compiled, delay slots included
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					for (const opcode_desc *checkdesc = curdesc; checkdesc != nullptr; checkdesc = (checkdesc == curdesc) ? curdesc->delay.first() : checkdesc->next())
+					{
+						if (checkdesc->userflags & tms3203x_frontend::USERFLAG_INTERPRET)
+							continue;
+						UML_LOAD(block, I0, m_program->get_read_ptr(checkdesc->pc), 0, SIZE_DWORD, SCALE_x4); // load    i0,<opcode>
+						UML_CMP(block, I0, checkdesc->opptr.l[0]);                              // cmp     i0,op
+						UML_EXHc(block, COND_NE, *m_drc_nocode, seqhead->pc);                   // exh     nocode,seqhead->pc,ne
+					}
+				}
+
+				// label this instruction, if it may be jumped to locally
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                                 // label   seqhead->pc
+
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, compiler, curdesc);
+
+				// go on to the next instruction, falling through if it follows
+				uint32_t const nextpc = (seqlast->flags & OPFLAG_RETURN_TO_START) ? pc : (seqlast->pc + 1);
+				if ((seqlast->next() != nullptr) && (seqlast->next()->pc == nextpc))
+					generate_update_cycles(block, compiler, nextpc);
+				else
+					generate_branch(block, compiler, nullptr, nextpc);
+			}
+
+			block.end();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			drc_flush_cache();
+		}
+	}
+
+	g_profiler.stop();
+}
+
+
+/*-------------------------------------------------
+    drc_delay_slots_native - return true if the
+    delay slots of a delayed branch can all be
+    compiled
+-------------------------------------------------*/
+
+bool tms3203x_device::drc_delay_slots_native(const opcode_desc *desc) const
+{
+	int slots = 0;
+	for (const opcode_desc *slot = desc->delay.first(); slot != nullptr; slot = slot->next(), slots++)
+		if (slot->userflags & tms3203x_frontend::USERFLAG_INTERPRET)
+			return false;
+	return slots == 3;
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void tms3203x_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// leave anything the interpreter must see to it
+	if ((desc->userflags & tms3203x_frontend::USERFLAG_INTERPRET) || ((desc->delayslots > 0) && !drc_delay_slots_native(desc)))
+	{
+		generate_update_cycles(block, compiler, desc->pc);
+		UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x4);                            // store   pc,desc->pc
+		UML_EXIT(block, EXECUTE_INTERPRET);                                                     // exit    EXECUTE_INTERPRET
+		return;
+	}
+
+	// the end of a repeat block is tested before the instruction after it runs
+	if (desc->userflags & tms3203x_frontend::USERFLAG_REPEAT_END)
+		generate_repeat_end(block, compiler, desc);
+
+	compiler.cycles += desc->cycles;
+	compiler.pcsynced = false;
+	compiler.checkdirty = false;
+
+	if (desc->delayslots > 0)
+	{
+		generate_delayed_branch(block, compiler, desc);
+		return;
+	}
+
+	if (!generate_opcode(block, compiler, desc))
+	{
+		generate_sync_pc(block, compiler, desc);
+		UML_STORE(block, &m_drc_op, 0, desc->opptr.l[0], SIZE_DWORD, SCALE_x4);                // store   drc_op,op
+		UML_CALLC(block, &cfunc_fallback, this);                                               // callc   cfunc_fallback,this
+		compiler.checkdirty = true;
+	}
+
+	// a delayed branch can't be left part way through, so its slots check when it's taken
+	if (compiler.checkdirty)
+	{
+		if (desc->flags & OPFLAG_IN_DELAY_SLOT)
+			compiler.dirtypending = true;
+		else
+			generate_check_dirty(block, compiler, desc->pc + 1);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_update_cycles - subtract the cycles
+    used since the last update, leaving compiled
+    code for the given PC if they've run out
+-------------------------------------------------*/
+
+void tms3203x_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc)
+{
+	if (compiler.cycles > 0)
+	{
+		UML_LOAD(block, I0, &m_icount, 0, SIZE_DWORD, SCALE_x4);                               // load    i0,icount
+		UML_SUB(block, I0, I0, compiler.cycles);                                                // sub     i0,i0,cycles
+		UML_STORE(block, &m_icount, 0, I0, SIZE_DWORD, SCALE_x4);                              // store   icount,i0
+		UML_CMP(block, I0, 0);                                                                  // cmp     i0,0
+		UML_EXHc(block, COND_LE, *m_drc_out_of_cycles, pc);                                     // exh     out_of_cycles,pc,le
+	}
+	compiler.cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_branch - go to the given PC, jumping
+    within the block where possible
+-------------------------------------------------*/
+
+void tms3203x_device::generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, const uml::parameter &target)
+{
+	generate_update_cycles(block, compiler, target);
+
+	if (desc && (desc->flags & OPFLAG_INTRABLOCK_BRANCH) && (desc->targetpc != BRANCH_TARGET_DYNAMIC))
+	{
+		if (target.is_immediate())
+		{
+			if (target.immediate() == desc->targetpc)
+			{
+				UML_JMP(block, desc->targetpc | 0x80000000);                                    // jmp     targetpc
+				return;
+			}
+		}
+		else
+		{
+			UML_CMP(block, target, desc->targetpc);                                             // cmp     target,targetpc
+			UML_JMPc(block, COND_E, desc->targetpc | 0x80000000);                               // je      targetpc
+		}
+	}
+	UML_HASHJMP(block, 0, target, *m_drc_nocode);                                               // hashjmp 0,target,nocode
+}
+
+
+/*-------------------------------------------------
+    generate_check_dirty - leave compiled code if
+    the memory map changed under it
+-------------------------------------------------*/
+
+void tms3203x_device::generate_check_dirty(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc)
+{
+	uml::code_label const clean = compiler.labelnum++;
+	UML_LOAD(block, I0, &m_drc_cache_dirty, 0, SIZE_BYTE, SCALE_x1);                           // load    i0,cache_dirty,byte
+	UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+	UML_JMPc(block, COND_E, clean);                                                             // je      clean
+	compiler_state dirty = compiler;
+	generate_update_cycles(block, dirty, pc);
+	UML_EXH(block, *m_drc_reset_cache, pc);                                                     // exh     reset_cache,pc
+	UML_LABEL(block, clean);                                                                    // clean:
+}
+
+
+/*-------------------------------------------------
+    generate_sync_pc - store the PC for anything
+    outside compiled code that may look at it
+-------------------------------------------------*/
+
+void tms3203x_device::generate_sync_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	if (compiler.pcsynced)
+		return;
+
+	UML_STORE(block, &m_pc, 0, desc->pc + 1, SIZE_DWORD, SCALE_x4);                            // store   pc,desc->pc+1
+	compiler.pcsynced = true;
+}
+
+
+/*-------------------------------------------------
+    generate_repeat_end - go back to the start of
+    a repeat block if the instruction before this
+    one ended it and RC hasn't run out
+-------------------------------------------------*/
+
+void tms3203x_device::generate_repeat_end(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	using namespace uml;
+
+	uml::code_label const done = compiler.labelnum++;
+	uml::code_label const skip = compiler.labelnum++;
+
+	// several blocks can end here, so check it's the active one
+	UML_LOAD(block, I0, &m_r[TMR_ST].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i0,st
+	UML_TEST(block, I0, RMFLAG);                                                                // test    i0,RM
+	UML_JMPc(block, COND_Z, skip);                                                              // jz      skip
+	UML_LOAD(block, I0, &m_r[TMR_RE].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i0,re
+	UML_CMP(block, I0, desc->pc - 1);                                                           // cmp     i0,desc->pc-1
+	UML_JMPc(block, COND_NE, skip);                                                             // jne     skip
+
+	// count down, going back to the start until RC goes negative
+	UML_LOAD(block, I0, &m_r[TMR_RC].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i0,rc
+	UML_SUB(block, I0, I0, 1);                                                                  // sub     i0,i0,1
+	UML_STORE(block, &m_r[TMR_RC].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);                        // store   rc,i0
+	UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+	UML_JMPc(block, COND_L, done);                                                              // jl      done
+	UML_LOAD(block, I9, &m_r[TMR_RS].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i9,rs
+	compiler_state taken = compiler;
+	generate_branch(block, taken, desc, I9);
+	compiler.labelnum = taken.labelnum;
+
+	// the block is done; an RPTS held off interrupts until now
+	UML_LABEL(block, done);                                                                     // done:
+	UML_LOAD(block, I0, &m_r[TMR_ST].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i0,st
+	UML_AND(block, I0, I0, ~RMFLAG);                                                            // and     i0,i0,~RM
+	UML_STORE(block, &m_r[TMR_ST].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);                        // store   st,i0
+	UML_LOAD(block, I0, &m_delayed, 0, SIZE_BYTE, SCALE_x1);                                   // load    i0,delayed,byte
+	UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+	UML_JMPc(block, COND_E, skip);                                                              // je      skip
+	UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x4);                                // store   pc,desc->pc
+	UML_CALLC(block, &cfunc_end_delay, this);                                                   // callc   cfunc_end_delay,this
+	UML_LOAD(block, I9, &m_pc, 0, SIZE_DWORD, SCALE_x4);                                       // load    i9,pc
+	UML_CMP(block, I9, desc->pc);                                                               // cmp     i9,desc->pc
+	UML_JMPc(block, COND_E, skip);                                                              // je      skip
+	compiler_state interrupted = compiler;
+	generate_branch(block, interrupted, nullptr, I9);
+	compiler.labelnum = interrupted.labelnum;
+
+	UML_LABEL(block, skip);                                                                     // skip:
+}
+
+
+/*-------------------------------------------------
+    generate_condition - skip to the given label
+    unless the condition is true; only I5 is
+    used
+-------------------------------------------------*/
+
+void tms3203x_device::generate_condition(drcuml_block &block, compiler_state &compiler, uint32_t condition, uml::code_label skip)
+{
+	// condition 0 is always true
+	if (condition == 0)
+		return;
+
+	UML_LOAD(block, I5, &m_r[TMR_ST].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i5,st
+	UML_AND(block, I5, I5, 0x7f);                                                               // and     i5,i5,0x7f
+	UML_LOAD(block, I5, &s_condition_table[0], I5, SIZE_DWORD, SCALE_x4);                      // load    i5,condition_table,i5
+	UML_TEST(block, I5, 1 << condition);                                                        // test    i5,1 << condition
+	UML_JMPc(block, COND_Z, skip);                                                              // jz      skip
+}
+
+
+/*-------------------------------------------------
+    generate_decrement_ar - decrement the low 24
+    bits of the AR register a DBcond counts with,
+    leaving the new count in I4
+-------------------------------------------------*/
+
+void tms3203x_device::generate_decrement_ar(drcuml_block &block, uint32_t op)
+{
+	uint32_t *const ar = &m_r[TMR_AR0 + ((op >> 22) & 7)].i32[0];
+	UML_LOAD(block, I3, ar, 0, SIZE_DWORD, SCALE_x4);                                          // load    i3,ar
+	UML_SUB(block, I4, I3, 1);                                                                  // sub     i4,i3,1
+	UML_AND(block, I4, I4, 0xffffff);                                                           // and     i4,i4,0xffffff
+	UML_AND(block, I3, I3, 0xff000000);                                                         // and     i3,i3,0xff000000
+	UML_OR(block, I3, I3, I4);                                                                  // or      i3,i3,i4
+	UML_STORE(block, ar, 0, I3, SIZE_DWORD, SCALE_x4);                                         // store   ar,i3
+}
+
+
+/*-------------------------------------------------
+    generate_delayed_branch - generate code for a
+    delayed branch and its three delay slots
+-------------------------------------------------*/
+
+void tms3203x_device::generate_delayed_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	using namespace uml;
+
+	uint32_t const op = desc->opptr.l[0];
+	uint32_t const index = op >> 21;
+	uml::code_label const nottaken = compiler.labelnum++;
+	uml::code_label const noirq = compiler.labelnum++;
+
+	// decide where to go before the slots run, as the interpreter does
+	UML_STORE(block, &m_drc_branch_pc, 0, desc->pc + 4, SIZE_DWORD, SCALE_x4);                 // store   branch_pc,desc->pc+4
+	if (index >= 0x360)
+	{
+		generate_decrement_ar(block, op);
+		UML_TEST(block, I4, 0x800000);                                                          // test    i4,0x800000
+		UML_JMPc(block, COND_NZ, nottaken);                                                     // jnz     nottaken
+	}
+	if (index >= 0x340)
+		generate_condition(block, compiler, (op >> 16) & 31, nottaken);
+	if ((index == 0x341) || ((index & 0x3f0) == 0x360))
+	{
+		UML_LOAD(block, I0, &m_r[op & 31].i32[0], 0, SIZE_DWORD, SCALE_x4);                    // load    i0,r[op & 31]
+		UML_STORE(block, &m_drc_branch_pc, 0, I0, SIZE_DWORD, SCALE_x4);                       // store   branch_pc,i0
+	}
+	else
+		UML_STORE(block, &m_drc_branch_pc, 0, desc->targetpc, SIZE_DWORD, SCALE_x4);           // store   branch_pc,targetpc
+	UML_LABEL(block, nottaken);                                                                 // nottaken:
+
+	// interrupts wait until the branch is taken
+	UML_STORE(block, &m_delayed, 0, 1, SIZE_BYTE, SCALE_x1);                                   // store   delayed,1,byte
+	for (const opcode_desc *slot = desc->delay.first(); slot != nullptr; slot = slot->next())
+		generate_sequence_instruction(block, compiler, slot);
+	UML_STORE(block, &m_delayed, 0, 0, SIZE_BYTE, SCALE_x1);                                   // store   delayed,0,byte
+
+	UML_LOAD(block, I0, &m_irq_pending, 0, SIZE_BYTE, SCALE_x1);                               // load    i0,irq_pending,byte
+	UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+	UML_JMPc(block, COND_E, noirq);                                                             // je      noirq
+	UML_LOAD(block, I0, &m_drc_branch_pc, 0, SIZE_DWORD, SCALE_x4);                            // load    i0,branch_pc
+	UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x4);                                      // store   pc,i0
+	UML_CALLC(block, &cfunc_end_delay, this);                                                   // callc   cfunc_end_delay,this
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x4);                                       // load    i0,pc
+	UML_STORE(block, &m_drc_branch_pc, 0, I0, SIZE_DWORD, SCALE_x4);                           // store   branch_pc,i0
+	UML_LABEL(block, noirq);                                                                    // noirq:
+
+	UML_LOAD(block, I9, &m_drc_branch_pc, 0, SIZE_DWORD, SCALE_x4);                            // load    i9,branch_pc
+	if (compiler.dirtypending)
+	{
+		generate_check_dirty(block, compiler, I9);
+		compiler.dirtypending = false;
+	}
+	generate_branch(block, compiler, desc, I9);
+}
+
+
+/*-------------------------------------------------
+    generate_read - read the word addressed by I1
+    into I0
+-------------------------------------------------*/
+
+void tms3203x_device::generate_read(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	generate_sync_pc(block, compiler, desc);
+	UML_CALLH(block, *m_drc_read);                                                              // callh   read
+	compiler.checkdirty = true;
+}
+
+
+/*-------------------------------------------------
+    generate_write - write I2 to the word
+    addressed by I1
+-------------------------------------------------*/
+
+void tms3203x_device::generate_write(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	generate_sync_pc(block, compiler, desc);
+	UML_CALLH(block, *m_drc_write);                                                             // callh   write
+	compiler.checkdirty = true;
+}
+
+
+/*-------------------------------------------------
+    generate_direct - compute a direct address
+    into I1
+-------------------------------------------------*/
+
+void tms3203x_device::generate_direct(drcuml_block &block, uint32_t op)
+{
+	UML_LOAD(block, I1, &m_r[TMR_DP].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i1,dp
+	UML_AND(block, I1, I1, 0xff);                                                               // and     i1,i1,0xff
+	UML_SHL(block, I1, I1, 16);                                                                 // shl     i1,i1,16
+	UML_OR(block, I1, I1, op & 0xffff);                                                         // or      i1,i1,op & 0xffff
+}
+
+
+/*-------------------------------------------------
+    generate_indirect - compute an indirect
+    address into I1, updating the AR register;
+    a deferred update is left in I7 for the
+    caller to store, and true is returned
+-------------------------------------------------*/
+
+bool tms3203x_device::generate_indirect(drcuml_block &block, compiler_state &compiler, uint32_t op, uint32_t modebyte, bool implied1, bool deferred)
+{
+	using namespace uml;
+
+	uint32_t const mode = (modebyte >> 3) & 31;
+	uint32_t *const ar = &m_r[TMR_AR0 + (modebyte & 7)].i32[0];
+	assert(indirect_is_native(modebyte));
+
+	UML_LOAD(block, I3, ar, 0, SIZE_DWORD, SCALE_x4);                                          // load    i3,ar
+	if (mode == 0x18)
+	{
+		UML_MOV(block, I1, I3);                                                                 // mov     i1,i3
+		return false;
+	}
+
+	// the displacement is an immediate, IR0 or IR1
+	uml::parameter disp = implied1 ? 1 : (op & 0xff);
+	if (mode >= 0x08)
+	{
+		UML_LOAD(block, I6, &m_r[(mode >= 0x10) ? TMR_IR1 : TMR_IR0].i32[0], 0, SIZE_DWORD, SCALE_x4); // load    i6,ir
+		disp = I6;
+	}
+
+	uml::parameter update = I4;
+	switch (mode & 7)
+	{
+		case 0:
+			UML_ADD(block, I1, I3, disp);                                                       // add     i1,i3,disp
+			return false;
+
+		case 1:
+			UML_SUB(block, I1, I3, disp);                                                       // sub     i1,i3,disp
+			return false;
+
+		case 2:
+			UML_ADD(block, I1, I3, disp);                                                       // add     i1,i3,disp
+			update = I1;
+			break;
+
+		case 3:
+			UML_SUB(block, I1, I3, disp);                                                       // sub     i1,i3,disp
+			update = I1;
+			break;
+
+		case 4:
+			UML_MOV(block, I1, I3);                                                             // mov     i1,i3
+			UML_ADD(block, I4, I3, disp);                                                       // add     i4,i3,disp
+			break;
+
+		case 5:
+			UML_MOV(block, I1, I3);                                                             // mov     i1,i3
+			UML_SUB(block, I4, I3, disp);                                                       // sub     i4,i3,disp
+			break;
+
+		case 6:
+		case 7:
+		{
+			// circular addressing wraps the bits under BK's mask
+			code_label const inrange = compiler.labelnum++;
+			UML_MOV(block, I1, I3);                                                             // mov     i1,i3
+			UML_LOAD(block, I4, &m_bkmask, 0, SIZE_DWORD, SCALE_x4);                           // load    i4,bkmask
+			UML_LOAD(block, I0, &m_r[TMR_BK].i32[0], 0, SIZE_DWORD, SCALE_x4);                 // load    i0,bk
+			UML_AND(block, I5, I3, I4);                                                         // and     i5,i3,i4
+			if ((mode & 7) == 6)
+			{
+				UML_ADD(block, I5, I5, disp);                                                   // add     i5,i5,disp
+				UML_CMP(block, I5, I0);                                                         // cmp     i5,i0
+				UML_JMPc(block, COND_B, inrange);                                               // jb      inrange
+				UML_SUB(block, I5, I5, I0);                                                     // sub     i5,i5,i0
+			}
+			else
+			{
+				UML_SUB(block, I5, I5, disp);                                                   // sub     i5,i5,disp
+				UML_CMP(block, I5, 0);                                                          // cmp     i5,0
+				UML_JMPc(block, COND_GE, inrange);                                              // jge     inrange
+				UML_ADD(block, I5, I5, I0);                                                     // add     i5,i5,i0
+			}
+			UML_LABEL(block, inrange);                                                          // inrange:
+			UML_AND(block, I5, I5, I4);                                                         // and     i5,i5,i4
+			UML_XOR(block, I4, I4, 0xffffffff);                                                 // xor     i4,i4,~0
+			UML_AND(block, I4, I3, I4);                                                         // and     i4,i3,i4
+			UML_OR(block, I4, I4, I5);                                                          // or      i4,i4,i5
+			break;
+		}
+	}
+
+	if (deferred)
+	{
+		UML_MOV(block, I7, update);                                                             // mov     i7,update
+		return true;
+	}
+	UML_STORE(block, ar, 0, update, SIZE_DWORD, SCALE_x4);                                     // store   ar,update
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_source - fetch the source operand of
+    a two-operand integer instruction into I0
+-------------------------------------------------*/
+
+void tms3203x_device::generate_source(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t op, bool sign_extend)
+{
+	switch ((op >> 21) & 3)
+	{
+		case MODE_REG:
+			UML_LOAD(block, I0, &m_r[op & 31].i32[0], 0, SIZE_DWORD, SCALE_x4);                // load    i0,r[op & 31]
+			break;
+
+		case MODE_DIR:
+			generate_direct(block, op);
+			generate_read(block, compiler, desc);
+			break;
+
+		case MODE_IND:
+			generate_indirect(block, compiler, op, op >> 8, false, false);
+			generate_read(block, compiler, desc);
+			break;
+
+		case MODE_IMM:
+			UML_MOV(block, I0, sign_extend ? uint32_t(int16_t(op)) : (op & 0xffff));           // mov     i0,imm
+			break;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_status - merge the UML flags in I4
+    into ST, replacing the given status bits and
+    latching overflow into LV
+-------------------------------------------------*/
+
+void tms3203x_device::generate_status(drcuml_block &block, uint32_t flags)
+{
+	UML_LOAD(block, I5, &m_r[TMR_ST].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i5,st
+	UML_AND(block, I5, I5, ~flags);                                                             // and     i5,i5,~flags
+	UML_OR(block, I5, I5, I4);                                                                  // or      i5,i5,i4
+	if (flags & VFLAG)
+	{
+		UML_AND(block, I6, I4, VFLAG);                                                          // and     i6,i4,V
+		UML_SHL(block, I6, I6, 4);                                                              // shl     i6,i6,4
+		UML_OR(block, I5, I5, I6);                                                              // or      i5,i5,i6
+	}
+	UML_STORE(block, &m_r[TMR_ST].i32[0], 0, I5, SIZE_DWORD, SCALE_x4);                        // store   st,i5
+}
+
+
+/*-------------------------------------------------
+    generate_int_flags - set N and Z from the
+    integer result in the given register
+-------------------------------------------------*/
+
+void tms3203x_device::generate_int_flags(drcuml_block &block, const uml::parameter &result)
+{
+	// the UML zero and sign flags are in the same bits as ST's
+	UML_TEST(block, result, result);                                                            // test    result,result
+	UML_GETFLGS(block, I4, FLAG_Z | FLAG_S);                                                    // getflgs i4,ZS
+	generate_status(block, NFLAG | ZFLAG | VFLAG | UFFLAG);
+}
+
+
+/*-------------------------------------------------
+    generate_float_flags - set N and Z from a
+    floating point register
+-------------------------------------------------*/
+
+void tms3203x_device::generate_float_flags(drcuml_block &block, uint32_t regnum)
+{
+	// zero is an exponent of -128
+	UML_LOAD(block, I3, &m_r[regnum].i32[1], 0, SIZE_DWORD, SCALE_x4);                         // load    i3,exponent
+	UML_AND(block, I3, I3, 0xff);                                                               // and     i3,i3,0xff
+	UML_CMP(block, I3, 0x80);                                                                   // cmp     i3,0x80
+	UML_SETc(block, COND_E, I4);                                                                // sete    i4
+	UML_SHL(block, I4, I4, 2);                                                                  // shl     i4,i4,2
+	UML_LOAD(block, I3, &m_r[regnum].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i3,mantissa
+	UML_SHR(block, I3, I3, 28);                                                                 // shr     i3,i3,28
+	UML_AND(block, I3, I3, NFLAG);                                                              // and     i3,i3,N
+	UML_OR(block, I4, I4, I3);                                                                  // or      i4,i4,i3
+	generate_status(block, NFLAG | ZFLAG | VFLAG | UFFLAG);
+}
+
+
+/*-------------------------------------------------
+    generate_long_to_float - unpack the memory
+    format float in I0 into a register
+-------------------------------------------------*/
+
+void tms3203x_device::generate_long_to_float(drcuml_block &block, uint32_t regnum)
+{
+	UML_SHL(block, I3, I0, 8);                                                                  // shl     i3,i0,8
+	UML_STORE(block, &m_r[regnum].i32[0], 0, I3, SIZE_DWORD, SCALE_x4);                        // store   mantissa,i3
+	UML_SAR(block, I3, I0, 24);                                                                 // sar     i3,i0,24
+	UML_STORE(block, &m_r[regnum].i32[1], 0, I3, SIZE_DWORD, SCALE_x4);                        // store   exponent,i3
+}
+
+
+/*-------------------------------------------------
+    generate_float_to_long - pack a register into
+    the memory format in I2
+-------------------------------------------------*/
+
+void tms3203x_device::generate_float_to_long(drcuml_block &block, uint32_t regnum)
+{
+	UML_LOAD(block, I3, &m_r[regnum].i32[1], 0, SIZE_DWORD, SCALE_x4);                         // load    i3,exponent
+	UML_SHL(block, I3, I3, 24);                                                                 // shl     i3,i3,24
+	UML_LOAD(block, I2, &m_r[regnum].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i2,mantissa
+	UML_SHR(block, I2, I2, 8);                                                                  // shr     i2,i2,8
+	UML_OR(block, I2, I2, I3);                                                                  // or      i2,i2,i3
+}
+
+
+/*-------------------------------------------------
+    generate_short_float - store a 16-bit
+    immediate float, converting it at compile
+    time
+-------------------------------------------------*/
+
+void tms3203x_device::generate_short_float(drcuml_block &block, uint32_t regnum, uint32_t op)
+{
+	tmsreg value;
+	if ((op & 0xffff) == 0x8000)
+		value = tmsreg(0, -128);
+	else
+		value = tmsreg(op << 20, int16_t(op) >> 12);
+	UML_STORE(block, &m_r[regnum].i32[0], 0, value.i32[0], SIZE_DWORD, SCALE_x4);              // store   mantissa,value
+	UML_STORE(block, &m_r[regnum].i32[1], 0, value.i32[1], SIZE_DWORD, SCALE_x4);              // store   exponent,value
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a single
+    instruction, returning false if it should
+    be left to the interpreter's handler
+-------------------------------------------------*/
+
+bool tms3203x_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	using namespace uml;
+
+	uint32_t const op = desc->opptr.l[0];
+	uint32_t const index = op >> 21;
+	uint32_t const dreg = (op >> 16) & 31;
+	uint32_t *const dst = &m_r[dreg].i32[0];
+
+	// anything with an addressing mode the compiler doesn't handle goes to the interpreter
+	if ((index < 0x200) && ((index & 3) == MODE_IND) && !indirect_is_native(op >> 8))
+		return false;
+
+	if (index >= 0x600)
+		return generate_parallel(block, compiler, desc);
+
+	if (index >= 0x200 && index < 0x300)
+	{
+		// LDFcond and LDIcond; the conditions the table doesn't cover are illegal
+		uint32_t const condition = (op >> 23) & 31;
+		uint32_t const mode = index & 3;
+		if ((condition == 11) || (condition > 20))
+			return false;
+		if ((mode == MODE_IND) && !indirect_is_native(op >> 8))
+			return false;
+
+		code_label const skip = compiler.labelnum++;
+		code_label const done = compiler.labelnum++;
+		generate_sync_pc(block, compiler, desc);
+		if (index < 0x280)
+		{
+			// floating point loads only read memory if the condition is true
+			uint32_t const freg = dreg & 7;
+			generate_condition(block, compiler, condition, skip);
+			switch (mode)
+			{
+				case MODE_REG:
+					UML_LOAD(block, I0, &m_r[op & 7].i32[0], 0, SIZE_DWORD, SCALE_x4);         // load    i0,mantissa
+					UML_LOAD(block, I3, &m_r[op & 7].i32[1], 0, SIZE_DWORD, SCALE_x4);         // load    i3,exponent
+					UML_STORE(block, &m_r[freg].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);          // store   mantissa,i0
+					UML_STORE(block, &m_r[freg].i32[1], 0, I3, SIZE_DWORD, SCALE_x4);          // store   exponent,i3
+					break;
+
+				case MODE_DIR:
+					generate_direct(block, op);
+					generate_read(block, compiler, desc);
+					generate_long_to_float(block, freg);
+					break;
+
+				case MODE_IND:
+					generate_indirect(block, compiler, op, op >> 8, false, false);
+					generate_read(block, compiler, desc);
+					generate_long_to_float(block, freg);
+					break;
+
+				case MODE_IMM:
+					generate_short_float(block, freg, op);
+					break;
+			}
+			UML_JMP(block, done);                                                               // jmp     done
+
+			// the address register is still updated when the load isn't made
+			UML_LABEL(block, skip);                                                             // skip:
+			if ((mode == MODE_IND) && (condition != 0))
+				generate_indirect(block, compiler, op, op >> 8, false, false);
+			UML_LABEL(block, done);                                                             // done:
+		}
+		else
+		{
+			// integer loads always read memory
+			if (mode == MODE_DIR || mode == MODE_IND)
+				generate_source(block, compiler, desc, op, true);
+			generate_condition(block, compiler, condition, skip);
+			if (mode == MODE_REG || mode == MODE_IMM)
+				generate_source(block, compiler, desc, op, true);
+			UML_STORE(block, dst, 0, I0, SIZE_DWORD, SCALE_x4);                                // store   dst,i0
+			UML_LABEL(block, skip);                                                             // skip:
+		}
+		return true;
+	}
+
+	switch (index)
+	{
+		case 0x10: case 0x11: case 0x12: case 0x13:     // ADDI
+		case 0xc0: case 0xc1: case 0xc2: case 0xc3:     // SUBI
+		{
+			code_label const nosat = compiler.labelnum++;
+			generate_source(block, compiler, desc, op, true);
+			UML_LOAD(block, I3, dst, 0, SIZE_DWORD, SCALE_x4);                                 // load    i3,dst
+			if (index < 0x20)
+				UML_ADD(block, I5, I3, I0);                                                     // add     i5,i3,i0
+			else
+				UML_SUB(block, I5, I3, I0);                                                     // sub     i5,i3,i0
+			UML_GETFLGS(block, I4, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);                          // getflgs i4,CVZS
+
+			// overflow saturates in overflow mode, but the flags come from the wrapped result
+			UML_TEST(block, I4, VFLAG);                                                         // test    i4,V
+			UML_JMPc(block, COND_Z, nosat);                                                     // jz      nosat
+			UML_LOAD(block, I6, &m_r[TMR_ST].i32[0], 0, SIZE_DWORD, SCALE_x4);                 // load    i6,st
+			UML_TEST(block, I6, OVMFLAG);                                                       // test    i6,OVM
+			UML_JMPc(block, COND_Z, nosat);                                                     // jz      nosat
+			UML_SAR(block, I5, I3, 31);                                                         // sar     i5,i3,31
+			UML_XOR(block, I5, I5, 0x7fffffff);                                                 // xor     i5,i5,0x7fffffff
+			UML_LABEL(block, nosat);                                                            // nosat:
+			UML_STORE(block, dst, 0, I5, SIZE_DWORD, SCALE_x4);                                // store   dst,i5
+			if (dreg < 8)
+				generate_status(block, NFLAG | ZFLAG | CFLAG | VFLAG | UFFLAG);
+			return true;
+		}
+
+		case 0x24: case 0x25: case 0x26: case 0x27:     // CMPI
+			generate_source(block, compiler, desc, op, true);
+			UML_LOAD(block, I3, dst, 0, SIZE_DWORD, SCALE_x4);                                 // load    i3,dst
+			UML_CMP(block, I3, I0);                                                             // cmp     i3,i0
+			UML_GETFLGS(block, I4, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);                          // getflgs i4,CVZS
+			generate_status(block, NFLAG | ZFLAG | CFLAG | VFLAG | UFFLAG);
+			return true;
+
+		case 0x14: case 0x15: case 0x16: case 0x17:     // AND
+		case 0x18: case 0x19: case 0x1a: case 0x1b:     // ANDN
+		case 0x80: case 0x81: case 0x82: case 0x83:     // OR
+		case 0xd4: case 0xd5: case 0xd6: case 0xd7:     // XOR
+			generate_source(block, compiler, desc, op, false);
+			UML_LOAD(block, I3, dst, 0, SIZE_DWORD, SCALE_x4);                                 // load    i3,dst
+			switch (index & ~3)
+			{
+				case 0x14:
+					UML_AND(block, I3, I3, I0);                                                 // and     i3,i3,i0
+					break;
+
+				case 0x18:
+					UML_XOR(block, I0, I0, 0xffffffff);                                         // xor     i0,i0,~0
+					UML_AND(block, I3, I3, I0);                                                 // and     i3,i3,i0
+					break;
+
+				case 0x80:
+					UML_OR(block, I3, I3, I0);                                                  // or      i3,i3,i0
+					break;
+
+				case 0xd4:
+					UML_XOR(block, I3, I3, I0);                                                 // xor     i3,i3,i0
+					break;
+			}
+			UML_STORE(block, dst, 0, I3, SIZE_DWORD, SCALE_x4);                                // store   dst,i3
+			if (dreg < 8)
+				generate_int_flags(block, I3);
+			return true;
+
+		case 0x38: case 0x39: case 0x3a: case 0x3b:     // LDF
+		{
+			uint32_t const freg = dreg & 7;
+			switch (index & 3)
+			{
+				case MODE_REG:
+					UML_LOAD(block, I0, &m_r[op & 7].i32[0], 0, SIZE_DWORD, SCALE_x4);         // load    i0,mantissa
+					UML_LOAD(block, I3, &m_r[op & 7].i32[1], 0, SIZE_DWORD, SCALE_x4);         // load    i3,exponent
+					UML_STORE(block, &m_r[freg].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);          // store   mantissa,i0
+					UML_STORE(block, &m_r[freg].i32[1], 0, I3, SIZE_DWORD, SCALE_x4);          // store   exponent,i3
+					break;
+
+				case MODE_DIR:
+				case MODE_IND:
+					generate_source(block, compiler, desc, op, false);
+					generate_long_to_float(block, freg);
+					break;
+
+				case MODE_IMM:
+					generate_short_float(block, freg, op);
+					break;
+			}
+			generate_float_flags(block, freg);
+			return true;
+		}
+
+		case 0x40: case 0x41: case 0x42: case 0x43:     // LDI
+			generate_source(block, compiler, desc, op, true);
+			UML_STORE(block, dst, 0, I0, SIZE_DWORD, SCALE_x4);                                // store   dst,i0
+			if (dreg < 8)
+				generate_int_flags(block, I0);
+			return true;
+
+		case 0x64:                                      // NOP
+			return true;
+
+		case 0x66:                                      // NOP with an address update
+			generate_indirect(block, compiler, op, op >> 8, false, false);
+			generate_read(block, compiler, desc);
+			return true;
+
+		case 0x71:                                      // POP
+		case 0x75:                                      // POPF
+			UML_LOAD(block, I1, &m_r[TMR_SP].i32[0], 0, SIZE_DWORD, SCALE_x4);                 // load    i1,sp
+			UML_SUB(block, I3, I1, 1);                                                          // sub     i3,i1,1
+			UML_STORE(block, &m_r[TMR_SP].i32[0], 0, I3, SIZE_DWORD, SCALE_x4);                // store   sp,i3
+			generate_read(block, compiler, desc);
+			if (index == 0x71)
+			{
+				UML_STORE(block, dst, 0, I0, SIZE_DWORD, SCALE_x4);                            // store   dst,i0
+				if (dreg < 8)
+					generate_int_flags(block, I0);
+			}
+			else
+			{
+				generate_long_to_float(block, dreg & 7);
+				generate_float_flags(block, dreg & 7);
+			}
+			return true;
+
+		case 0x79:                                      // PUSH
+		case 0x7d:                                      // PUSHF
+			UML_LOAD(block, I1, &m_r[TMR_SP].i32[0], 0, SIZE_DWORD, SCALE_x4);                 // load    i1,sp
+			UML_ADD(block, I1, I1, 1);                                                          // add     i1,i1,1
+			UML_STORE(block, &m_r[TMR_SP].i32[0], 0, I1, SIZE_DWORD, SCALE_x4);                // store   sp,i1
+			if (index == 0x79)
+				UML_LOAD(block, I2, dst, 0, SIZE_DWORD, SCALE_x4);                             // load    i2,src
+			else
+				generate_float_to_long(block, dreg & 7);
+			generate_write(block, compiler, desc);
+			return true;
+
+		case 0x9c: case 0x9d: case 0x9e: case 0x9f:     // RPTS
+			generate_source(block, compiler, desc, op, false);
+			UML_STORE(block, &m_r[TMR_RC].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);                // store   rc,i0
+			UML_STORE(block, &m_r[TMR_RS].i32[0], 0, desc->pc + 1, SIZE_DWORD, SCALE_x4);      // store   rs,desc->pc+1
+			UML_STORE(block, &m_r[TMR_RE].i32[0], 0, desc->pc + 1, SIZE_DWORD, SCALE_x4);      // store   re,desc->pc+1
+			UML_LOAD(block, I0, &m_r[TMR_ST].i32[0], 0, SIZE_DWORD, SCALE_x4);                 // load    i0,st
+			UML_OR(block, I0, I0, RMFLAG);                                                      // or      i0,i0,RM
+			UML_STORE(block, &m_r[TMR_ST].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);                // store   st,i0
+
+			// interrupts are held off until the repeat is done
+			UML_STORE(block, &m_delayed, 0, 1, SIZE_BYTE, SCALE_x1);                           // store   delayed,1,byte
+			compiler.cycles += 3 * 2;
+			return true;
+
+		case 0xa1: case 0xa2:                           // STF
+		case 0xa9: case 0xaa:                           // STI
+			if (index & 1)
+				generate_direct(block, op);
+			else
+				generate_indirect(block, compiler, op, op >> 8, false, false);
+			if (index < 0xa8)
+				generate_float_to_long(block, dreg & 7);
+			else
+				UML_LOAD(block, I2, dst, 0, SIZE_DWORD, SCALE_x4);                             // load    i2,src
+			generate_write(block, compiler, desc);
+			return true;
+
+		case 0x300: case 0x301: case 0x302: case 0x303:     // BR
+		case 0x304: case 0x305: case 0x306: case 0x307:
+			compiler.cycles += 3 * 2;
+			generate_branch(block, compiler, desc, desc->targetpc);
+			return true;
+
+		case 0x310: case 0x311: case 0x312: case 0x313:     // CALL
+		case 0x314: case 0x315: case 0x316: case 0x317:
+			generate_call(block, compiler, desc);
+			compiler.cycles += 3 * 2;
+			generate_check_dirty(block, compiler, desc->targetpc);
+			generate_branch(block, compiler, desc, desc->targetpc);
+			compiler.checkdirty = false;
+			return true;
+
+		case 0x320: case 0x321: case 0x322: case 0x323:     // RPTB
+		case 0x324: case 0x325: case 0x326: case 0x327:
+			UML_STORE(block, &m_r[TMR_RS].i32[0], 0, desc->pc + 1, SIZE_DWORD, SCALE_x4);      // store   rs,desc->pc+1
+			UML_STORE(block, &m_r[TMR_RE].i32[0], 0, op & 0xffffff, SIZE_DWORD, SCALE_x4);     // store   re,op & 0xffffff
+			UML_LOAD(block, I0, &m_r[TMR_ST].i32[0], 0, SIZE_DWORD, SCALE_x4);                 // load    i0,st
+			UML_OR(block, I0, I0, RMFLAG);                                                      // or      i0,i0,RM
+			UML_STORE(block, &m_r[TMR_ST].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);                // store   st,i0
+			compiler.cycles += 3 * 2;
+			return true;
+
+		case 0x340: case 0x350:                             // Bcond
+		case 0x360: case 0x362: case 0x364: case 0x366:     // DBcond
+		case 0x368: case 0x36a: case 0x36c: case 0x36e:
+		case 0x370: case 0x372: case 0x374: case 0x376:
+		case 0x378: case 0x37a: case 0x37c: case 0x37e:
+		case 0x380: case 0x390:                             // CALLcond
+		case 0x3c4:                                         // RETScond
+		{
+			code_label const skip = compiler.labelnum++;
+			if (index >= 0x360 && index < 0x380)
+			{
+				generate_decrement_ar(block, op);
+				UML_TEST(block, I4, 0x800000);                                                  // test    i4,0x800000
+				UML_JMPc(block, COND_NZ, skip);                                                 // jnz     skip
+			}
+			generate_condition(block, compiler, (op >> 16) & 31, skip);
+
+			// the target is the register named in the low bits, or static
+			compiler_state taken = compiler;
+			uml::parameter target = desc->targetpc;
+			if (index == 0x3c4)
+			{
+				UML_LOAD(block, I1, &m_r[TMR_SP].i32[0], 0, SIZE_DWORD, SCALE_x4);             // load    i1,sp
+				UML_SUB(block, I3, I1, 1);                                                      // sub     i3,i1,1
+				UML_STORE(block, &m_r[TMR_SP].i32[0], 0, I3, SIZE_DWORD, SCALE_x4);            // store   sp,i3
+				generate_read(block, taken, desc);
+				UML_MOV(block, I9, I0);                                                         // mov     i9,i0
+				target = I9;
+			}
+			else if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+			{
+				UML_LOAD(block, I9, &m_r[op & 31].i32[0], 0, SIZE_DWORD, SCALE_x4);            // load    i9,r[op & 31]
+				target = I9;
+			}
+			if (index >= 0x380 && index < 0x3c0)
+				generate_call(block, taken, desc);
+			taken.cycles += 3 * 2;
+			if (taken.checkdirty)
+				generate_check_dirty(block, taken, target);
+			generate_branch(block, taken, desc, target);
+			compiler.labelnum = taken.labelnum;
+			UML_LABEL(block, skip);                                                             // skip:
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_call - push the return address for
+    a call
+-------------------------------------------------*/
+
+void tms3203x_device::generate_call(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	UML_LOAD(block, I1, &m_r[TMR_SP].i32[0], 0, SIZE_DWORD, SCALE_x4);                         // load    i1,sp
+	UML_ADD(block, I1, I1, 1);                                                                  // add     i1,i1,1
+	UML_STORE(block, &m_r[TMR_SP].i32[0], 0, I1, SIZE_DWORD, SCALE_x4);                        // store   sp,i1
+	UML_MOV(block, I2, desc->pc + 1);                                                           // mov     i2,desc->pc+1
+	generate_write(block, compiler, desc);
+}
+
+
+/*-------------------------------------------------
+    generate_parallel - generate code for the
+    parallel load and store pairs
+-------------------------------------------------*/
+
+bool tms3203x_device::generate_parallel(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t const op = desc->opptr.l[0];
+	uint32_t const index = op >> 21;
+	bool const stores = (index < 0x620);
+	bool const loads = (index >= 0x620) && (index < 0x640);
+	bool const ldst = (index >= 0x6c0) && (index < 0x6e0);
+	if (!stores && !loads && !ldst)
+		return false;
+	if (!indirect_is_native(op >> 8) || !indirect_is_native(op))
+		return false;
+
+	// the first address register update is held until both accesses are done
+	uint32_t *const firstar = &m_r[TMR_AR0 + (((ldst ? op : (op >> 8)) & 7))].i32[0];
+	bool const isfloat = !(index & 0x10);
+	bool deferred;
+	if (stores)
+	{
+		// STF || STF and STI || STI
+		deferred = generate_indirect(block, compiler, op, op >> 8, true, true);
+		if (isfloat)
+			generate_float_to_long(block, (op >> 16) & 7);
+		else
+			UML_LOAD(block, I2, &m_r[(op >> 16) & 7].i32[0], 0, SIZE_DWORD, SCALE_x4);        // load    i2,src
+		generate_write(block, compiler, desc);
+		generate_indirect(block, compiler, op, op, true, false);
+		if (isfloat)
+			generate_float_to_long(block, (op >> 22) & 7);
+		else
+			UML_LOAD(block, I2, &m_r[(op >> 22) & 7].i32[0], 0, SIZE_DWORD, SCALE_x4);        // load    i2,src
+		generate_write(block, compiler, desc);
+	}
+	else if (loads)
+	{
+		// LDF || LDF and LDI || LDI
+		deferred = generate_indirect(block, compiler, op, op >> 8, true, true);
+		generate_read(block, compiler, desc);
+		if (isfloat)
+			generate_long_to_float(block, (op >> 19) & 7);
+		else
+			UML_STORE(block, &m_r[(op >> 19) & 7].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);       // store   dst,i0
+		generate_indirect(block, compiler, op, op, true, false);
+		generate_read(block, compiler, desc);
+		if (isfloat)
+			generate_long_to_float(block, (op >> 22) & 7);
+		else
+			UML_STORE(block, &m_r[(op >> 22) & 7].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);       // store   dst,i0
+	}
+	else
+	{
+		// LDF || STF and LDI || STI read the register being stored first
+		if (isfloat)
+			generate_float_to_long(block, (op >> 16) & 7);
+		else
+			UML_LOAD(block, I2, &m_r[(op >> 16) & 7].i32[0], 0, SIZE_DWORD, SCALE_x4);        // load    i2,src
+		deferred = generate_indirect(block, compiler, op, op, true, true);
+		generate_read(block, compiler, desc);
+		if (isfloat)
+			generate_long_to_float(block, (op >> 22) & 7);
+		else
+			UML_STORE(block, &m_r[(op >> 22) & 7].i32[0], 0, I0, SIZE_DWORD, SCALE_x4);       // store   dst,i0
+		generate_indirect(block, compiler, op, op >> 8, true, false);
+		generate_write(block, compiler, desc);
+	}
+
+	if (deferred)
+		UML_STORE(block, firstar, 0, I7, SIZE_DWORD, SCALE_x4);                                // store   ar,i7
+	return true;
+}
@@ -0,0 +1,279 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    32031fe.cpp
+
+    Front-end for the TMS320C3x recompiler.
+
+    The end of a repeat block isn't marked in the instruction stream, so
+    the frontend keeps a map of the block ends it has been told about,
+    either by describing an RPTB or RPTS or by the backend finding a
+    repeat already active.  The interpreter checks for the end of a
+    block before fetching the next instruction, so the instruction that
+    follows each block is described as a conditional branch back to the
+    start of the block, taken before it runs.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "32031fe.h"
+
+
+/***************************************************************************
+    FRONTEND
+***************************************************************************/
+
+/*-------------------------------------------------
+    tms3203x_frontend - constructor
+-------------------------------------------------*/
+
+tms3203x_frontend::tms3203x_frontend(tms3203x_device &tms, u32 window_start, u32 window_end, u32 max_sequence)
+	: drc_frontend(tms, window_start, window_end, max_sequence)
+	, m_tms(tms)
+	, m_new_repeats(false)
+{
+}
+
+
+/*-------------------------------------------------
+    repeat_start - return the start of the repeat
+    block ending before the given PC, or
+    BRANCH_TARGET_DYNAMIC if it isn't known
+-------------------------------------------------*/
+
+offs_t tms3203x_frontend::repeat_start(offs_t pc) const
+{
+	auto const found = m_repeat_start.find(pc);
+	return (found != m_repeat_start.end()) ? found->second : BRANCH_TARGET_DYNAMIC;
+}
+
+
+/*-------------------------------------------------
+    add_repeat - note a repeat block ending before
+    the given PC
+-------------------------------------------------*/
+
+void tms3203x_frontend::add_repeat(offs_t nextpc, offs_t startpc)
+{
+	auto const inserted = m_repeat_start.emplace(nextpc, startpc);
+	if (inserted.second)
+		m_new_repeats = true;
+
+	// blocks sharing an end with different starts just lose the static target
+	else if (inserted.first->second != startpc)
+		inserted.first->second = BRANCH_TARGET_DYNAMIC;
+}
+
+
+/*-------------------------------------------------
+    writes_special_register - return true if the
+    instruction loads a register that has side
+    effects when written
+-------------------------------------------------*/
+
+bool tms3203x_frontend::writes_special_register(u32 op)
+{
+	switch (op >> 21)
+	{
+		// stores, pushes and RPTS name a source rather than a destination
+		case 0x79: case 0x7d:
+		case 0x9c: case 0x9d: case 0x9e: case 0x9f:
+		case 0xa1: case 0xa2: case 0xa5: case 0xa6:
+		case 0xa9: case 0xaa: case 0xad: case 0xae:
+			return false;
+	}
+
+	// BK, ST, IE, IF, IOF and the repeat registers; SP is just a register
+	u32 const dreg = (op >> 16) & 31;
+	return (dreg >= 19) && (dreg != 20);
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool tms3203x_frontend::describe(opcode_desc &desc, opcode_desc const *prev)
+{
+	desc.length = 1;
+	desc.cycles = 2;
+
+	// code that isn't in host memory can't be checksummed, so leave it to the interpreter
+	if (!m_tms.m_program->get_read_ptr(desc.pc))
+	{
+		desc.userflags |= USERFLAG_INTERPRET;
+		desc.flags |= OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	u32 const op = m_tms.m_cache->read_dword(desc.pc);
+	desc.opptr.l[0] = op;
+
+	bool interpret = false;
+	bool repeat = false;
+	u32 const index = op >> 21;
+	if (index < 0x200)
+	{
+		switch (index)
+		{
+			case 0x30: case 0x31: case 0x32: case 0x33:     // IDLE waits for an interrupt
+			case 0x3d: case 0x3e: case 0x45: case 0x46:     // interlocked loads
+			case 0xa5: case 0xa6: case 0xad: case 0xae:     // interlocked stores
+			case 0xb0:                                      // SIGI
+			case 0xd9: case 0xda:                           // IACK
+				interpret = true;
+				break;
+
+			case 0x9c: case 0x9d: case 0x9e: case 0x9f:
+				// RPTS repeats the next instruction
+				add_repeat(desc.pc + 2, desc.pc + 1);
+				repeat = true;
+				break;
+		}
+
+		// loading ST, IE or IF can take an interrupt
+		if (writes_special_register(op))
+			interpret = true;
+	}
+	else if (index < 0x300)
+	{
+		// conditional integer loads of the special registers
+		if (index >= 0x280 && writes_special_register(op))
+			interpret = true;
+	}
+	else
+	{
+		u32 const condition = (op >> 16) & 31;
+		switch (index)
+		{
+			case 0x300: case 0x301: case 0x302: case 0x303:
+			case 0x304: case 0x305: case 0x306: case 0x307:
+			case 0x310: case 0x311: case 0x312: case 0x313:
+			case 0x314: case 0x315: case 0x316: case 0x317:
+				// BR and CALL
+				describe_branch(desc, false, op & 0xffffff, false);
+				break;
+
+			case 0x308: case 0x309: case 0x30a: case 0x30b:
+			case 0x30c: case 0x30d: case 0x30e: case 0x30f:
+				// BRD
+				describe_branch(desc, false, op & 0xffffff, true);
+				break;
+
+			case 0x320: case 0x321: case 0x322: case 0x323:
+			case 0x324: case 0x325: case 0x326: case 0x327:
+				// RPTB
+				add_repeat((op & 0xffffff) + 1, desc.pc + 1);
+				repeat = true;
+				break;
+
+			case 0x340: case 0x341:
+				// Bcond and BcondD to a register
+				describe_branch(desc, condition != 0, BRANCH_TARGET_DYNAMIC, index & 1);
+				break;
+
+			case 0x350:
+				describe_branch(desc, condition != 0, desc.pc + 1 + s16(op), false);
+				break;
+
+			case 0x351:
+				describe_branch(desc, condition != 0, desc.pc + 3 + s16(op), true);
+				break;
+
+			case 0x360: case 0x361: case 0x362: case 0x363:
+			case 0x364: case 0x365: case 0x366: case 0x367:
+			case 0x368: case 0x369: case 0x36a: case 0x36b:
+			case 0x36c: case 0x36d: case 0x36e: case 0x36f:
+				// DBcond and DBcondD to a register
+				describe_branch(desc, true, BRANCH_TARGET_DYNAMIC, index & 1);
+				break;
+
+			case 0x370: case 0x371: case 0x372: case 0x373:
+			case 0x374: case 0x375: case 0x376: case 0x377:
+			case 0x378: case 0x379: case 0x37a: case 0x37b:
+			case 0x37c: case 0x37d: case 0x37e: case 0x37f:
+				describe_branch(desc, true, desc.pc + ((index & 1) ? 3 : 1) + s16(op), index & 1);
+				break;
+
+			case 0x380:
+				describe_branch(desc, condition != 0, BRANCH_TARGET_DYNAMIC, false);
+				break;
+
+			case 0x390:
+				describe_branch(desc, condition != 0, desc.pc + 1 + s16(op), false);
+				break;
+
+			case 0x3c4:
+				// RETScond
+				describe_branch(desc, condition != 0, BRANCH_TARGET_DYNAMIC, false);
+				break;
+
+			case 0x330:     // SWI
+			case 0x3a0:     // TRAPcond
+			case 0x3c0:     // RETIcond sets GIE
+				interpret = true;
+				break;
+		}
+	}
+
+	// the delay slots run straight through in the interpreter, so anything unusual there is its job
+	if (desc.flags & OPFLAG_IN_DELAY_SLOT)
+	{
+		if (interpret || repeat || (desc.flags & OPFLAG_IS_BRANCH))
+		{
+			desc.flags &= ~(OPFLAG_IS_BRANCH | OPFLAG_END_SEQUENCE);
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 0;
+			interpret = true;
+		}
+	}
+
+	// the end of a repeat block is checked before the next instruction runs
+	else if (is_repeat_end(desc.pc))
+	{
+		if (interpret || (desc.flags & OPFLAG_IS_BRANCH))
+		{
+			desc.flags &= ~(OPFLAG_IS_BRANCH | OPFLAG_END_SEQUENCE);
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 0;
+			interpret = true;
+		}
+		else
+		{
+			desc.userflags |= USERFLAG_REPEAT_END;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.targetpc = repeat_start(desc.pc);
+		}
+	}
+
+	if (interpret)
+	{
+		desc.userflags |= USERFLAG_INTERPRET;
+		desc.flags |= OPFLAG_END_SEQUENCE;
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_branch - describe a branch, call or
+    return
+-------------------------------------------------*/
+
+void tms3203x_frontend::describe_branch(opcode_desc &desc, bool conditional, offs_t target, bool delayed)
+{
+	if (conditional)
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+	else
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+	desc.targetpc = target;
+
+	// the three instructions after a delayed branch run before it's taken
+	if (delayed)
+	{
+		desc.delayslots = 3;
+		desc.flags |= OPFLAG_END_SEQUENCE;
+	}
+}
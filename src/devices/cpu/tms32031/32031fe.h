@@ -0,0 +1,53 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    32031fe.h
+
+    Front-end for the TMS320C3x recompiler.
+
+***************************************************************************/
+
+#ifndef MAME_CPU_TMS32031_32031FE_H
+#define MAME_CPU_TMS32031_32031FE_H
+
+#pragma once
+
+#include "tms32031.h"
+#include "cpu/drcfe.h"
+
+#include <unordered_map>
+
+
+class tms3203x_frontend : public drc_frontend
+{
+public:
+	// flags for opcode_desc::userflags
+	static constexpr u32 USERFLAG_INTERPRET  = 0x0001;  // instruction must be run by the interpreter
+	static constexpr u32 USERFLAG_REPEAT_END = 0x0002;  // instruction follows the end of a repeat block
+
+	// construction/destruction
+	tms3203x_frontend(tms3203x_device &tms, u32 window_start, u32 window_end, u32 max_sequence);
+
+	// repeat blocks, keyed by the PC after the end of the block
+	bool is_repeat_end(offs_t pc) const { return m_repeat_start.find(pc) != m_repeat_start.end(); }
+	offs_t repeat_start(offs_t pc) const;
+	void add_repeat(offs_t nextpc, offs_t startpc);
+	bool take_new_repeats() { bool const result = m_new_repeats; m_new_repeats = false; return result; }
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, opcode_desc const *prev) override;
+
+private:
+	// internal helpers
+	static bool writes_special_register(u32 op);
+	void describe_branch(opcode_desc &desc, bool conditional, offs_t target, bool delayed);
+
+	tms3203x_device &                   m_tms;
+	std::unordered_map<offs_t, offs_t>  m_repeat_start;     // start of the repeat block ending before each PC
+	bool                                m_new_repeats;      // a repeat block has been added since the last check
+};
+
+
+#endif // MAME_CPU_TMS32031_32031FE_H
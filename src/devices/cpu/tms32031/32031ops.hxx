@@ -143,7 +143,7 @@ const uint32_t C_NLUF = 1 << 18;
 const uint32_t C_LUF = 1 << 19;
 const uint32_t C_ZUF = 1 << 20;
 
-const uint32_t condition_table[0x80] =
+const uint32_t tms3203x_device::s_condition_table[0x80] =
 {
 /* ------- */   1 | C_HI | C_HS | C_NE | C_GT | C_GE | C_NV | C_NUF | C_NLV | C_NLUF,
 /* ------C */   1 | C_LO | C_LS | C_NE | C_GT | C_GE | C_NV | C_NUF | C_NLV | C_NLUF,
@@ -297,7 +297,7 @@ const uint32_t condition_table[0x80] =
 
 inline bool tms3203x_device::condition(int which)
 {
-	return (condition_table[IREG(TMR_ST) & (LUFFLAG | LVFLAG | UFFLAG | NFLAG | ZFLAG | VFLAG | CFLAG)] >> (which & 31)) & 1;
+	return (s_condition_table[IREG(TMR_ST) & (LUFFLAG | LVFLAG | UFFLAG | NFLAG | ZFLAG | VFLAG | CFLAG)] >> (which & 31)) & 1;
 }
 
 
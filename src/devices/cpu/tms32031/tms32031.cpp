@@ -10,6 +10,7 @@
 
 #include "emu.h"
 #include "tms32031.h"
+#include "32031fe.h"
 #include "dis32031.h"
 #include "debugger.h"
 
@@ -295,10 +296,21 @@ tms3203x_device::tms3203x_device(const machine_config &mconfig, device_type type
 		m_xf0_cb(*this),
 		m_xf1_cb(*this),
 		m_iack_cb(*this),
-		m_holda_cb(*this)
+		m_holda_cb(*this),
+		m_drc_entry(nullptr),
+		m_drc_nocode(nullptr),
+		m_drc_out_of_cycles(nullptr),
+		m_drc_reset_cache(nullptr),
+		m_drc_read(nullptr),
+		m_drc_write(nullptr),
+		m_drc_cache_dirty(0),
+		m_drc_op(0),
+		m_drc_branch_pc(0),
+		m_fastram_select(0)
 {
 	// initialize remaining state
 	memset(&m_r, 0, sizeof(m_r));
+	memset(m_fastram, 0, sizeof(m_fastram));
 
 	// set our instruction counter
 	set_icountptr(m_icount);
@@ -457,6 +469,9 @@ void tms3203x_device::device_start()
 	state_add(TMS3203X_RS,      "RS",        m_r[TMR_RS].i32[0]);
 	state_add(TMS3203X_RE,      "RE",        m_r[TMR_RE].i32[0]);
 	state_add(TMS3203X_RC,      "RC",        m_r[TMR_RC].i32[0]);
+
+	// set up the recompiler if it's allowed
+	drc_init();
 }
 
 
@@ -482,6 +497,9 @@ void tms3203x_device::device_reset()
 
 	// reset internal stuff
 	m_delayed = m_irq_pending = m_is_idling = false;
+
+	// the boot loader mapping may have changed under the recompiled code
+	m_drc_cache_dirty = true;
 }
 
 
@@ -697,6 +715,36 @@ void tms3203x_device::check_irqs()
 }
 
 
+//-------------------------------------------------
+//  check_repeat - handle reaching the end of a
+//  repeat block; returns true if the PC was at
+//  the end of the block
+//-------------------------------------------------
+
+bool tms3203x_device::check_repeat()
+{
+	if (!(IREG(TMR_ST) & RMFLAG) || m_pc != IREG(TMR_RE) + 1)
+		return false;
+
+	if ((int32_t)--IREG(TMR_RC) >= 0)
+		m_pc = IREG(TMR_RS);
+	else
+	{
+		IREG(TMR_ST) &= ~RMFLAG;
+		if (m_delayed)
+		{
+			m_delayed = false;
+			if (m_irq_pending)
+			{
+				m_irq_pending = false;
+				check_irqs();
+			}
+		}
+	}
+	return true;
+}
+
+
 //-------------------------------------------------
 //  execute_min_cycles - return minimum number of
 //  cycles it takes for one instruction to execute
@@ -812,30 +860,20 @@ void tms3203x_device::execute_run()
 		return;
 	}
 
+	// run recompiled code if we can
+	if (m_drcuml)
+	{
+		execute_run_drc();
+		return;
+	}
+
 	// non-debug case
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
 	{
 		while (m_icount > 0)
 		{
-			if ((IREG(TMR_ST) & RMFLAG) && m_pc == IREG(TMR_RE) + 1)
-			{
-				if ((int32_t)--IREG(TMR_RC) >= 0)
-					m_pc = IREG(TMR_RS);
-				else
-				{
-					IREG(TMR_ST) &= ~RMFLAG;
-					if (m_delayed)
-					{
-						m_delayed = false;
-						if (m_irq_pending)
-						{
-							m_irq_pending = false;
-							check_irqs();
-						}
-					}
-				}
+			if (check_repeat())
 				continue;
-			}
 
 			execute_one();
 		}
@@ -849,25 +887,8 @@ void tms3203x_device::execute_run()
 			// watch for out-of-range stack pointers
 			if (IREG(TMR_SP) & 0xff000000)
 				machine().debug_break();
-			if ((IREG(TMR_ST) & RMFLAG) && m_pc == IREG(TMR_RE) + 1)
-			{
-				if ((int32_t)--IREG(TMR_RC) >= 0)
-					m_pc = IREG(TMR_RS);
-				else
-				{
-					IREG(TMR_ST) &= ~RMFLAG;
-					if (m_delayed)
-					{
-						m_delayed = false;
-						if (m_irq_pending)
-						{
-							m_irq_pending = false;
-							check_irqs();
-						}
-					}
-				}
+			if (check_repeat())
 				continue;
-			}
 
 			debugger_instruction_hook(m_pc);
 			execute_one();
@@ -905,3 +926,37 @@ WRITE32_MEMBER(tms3203x_device::primary_bus_control_w)
 //**************************************************************************
 
 #include "32031ops.hxx"
+
+
+//**************************************************************************
+//  RECOMPILER CALLBACKS
+//**************************************************************************
+
+//-------------------------------------------------
+//  cfunc_fallback - run an instruction the
+//  recompiler doesn't generate code for
+//-------------------------------------------------
+
+void tms3203x_device::cfunc_fallback(void *param)
+{
+	auto &tms = *reinterpret_cast<tms3203x_device *>(param);
+	(tms.*s_tms32031ops[tms.m_drc_op >> 21])(tms.m_drc_op);
+}
+
+
+//-------------------------------------------------
+//  cfunc_end_delay - finish a delayed branch or
+//  RPTS, taking any interrupt that was held off
+//  while it ran
+//-------------------------------------------------
+
+void tms3203x_device::cfunc_end_delay(void *param)
+{
+	auto &tms = *reinterpret_cast<tms3203x_device *>(param);
+	tms.m_delayed = false;
+	if (tms.m_irq_pending)
+	{
+		tms.m_irq_pending = false;
+		tms.check_irqs();
+	}
+}
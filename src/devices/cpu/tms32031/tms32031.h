@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -43,6 +46,9 @@ const int TMS3203X_DINT1    = 11;       // DMA 1 interrupt (32032 only)
 const int TMS3203X_MCBL     = 12;       // Microcomputer/boot loader mode
 const int TMS3203X_HOLD     = 13;       // Primary bus interface hold signal
 
+// recompiler
+const int TMS3203X_MAX_FASTRAM  = 4;    // RAM blocks the recompiler can access directly
+
 // register enumeration
 enum
 {
@@ -91,10 +97,15 @@ enum
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+class tms3203x_frontend;
+
+
 // ======================> tms3203x_device
 
 class tms3203x_device : public cpu_device
 {
+	friend class tms3203x_frontend;
+
 	struct tmsreg
 	{
 		// constructors
@@ -135,6 +146,9 @@ public:
 	static uint32_t float_to_fp(float fval);
 	static uint32_t double_to_fp(double dval);
 
+	// recompiler configuration
+	void add_fastram(offs_t start, offs_t end, bool readonly, void *base);
+
 protected:
 	enum
 	{
@@ -182,10 +196,46 @@ protected:
 
 	// misc helpers
 	void check_irqs();
+	bool check_repeat();
 	void execute_one();
 	void update_special(int dreg);
 	bool condition(int which);
 
+	// recompiler (32031drc.cpp)
+	struct compiler_state;
+	void drc_init();
+	void drc_flush_cache();
+	void drc_check_repeat();
+	void execute_run_drc();
+	void drc_compile_block(offs_t pc);
+	bool drc_delay_slots_native(const opcode_desc *desc) const;
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, const uml::parameter &target);
+	void generate_check_dirty(drcuml_block &block, compiler_state &compiler, const uml::parameter &pc);
+	void generate_sync_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_repeat_end(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_condition(drcuml_block &block, compiler_state &compiler, uint32_t condition, uml::code_label skip);
+	void generate_decrement_ar(drcuml_block &block, uint32_t op);
+	void generate_delayed_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_memory_accessors();
+	void generate_read(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_write(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_direct(drcuml_block &block, uint32_t op);
+	bool generate_indirect(drcuml_block &block, compiler_state &compiler, uint32_t op, uint32_t modebyte, bool implied1, bool deferred);
+	void generate_source(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t op, bool sign_extend);
+	void generate_status(drcuml_block &block, uint32_t flags);
+	void generate_int_flags(drcuml_block &block, const uml::parameter &result);
+	void generate_float_flags(drcuml_block &block, uint32_t regnum);
+	void generate_long_to_float(drcuml_block &block, uint32_t regnum);
+	void generate_float_to_long(drcuml_block &block, uint32_t regnum);
+	void generate_short_float(drcuml_block &block, uint32_t regnum, uint32_t op);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_call(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_parallel(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	static void cfunc_fallback(void *param);
+	static void cfunc_end_delay(void *param);
+
 	// floating point helpers
 	void int2float(tmsreg &srcdst);
 	void float2int(tmsreg &srcdst, bool setflags);
@@ -779,8 +829,33 @@ protected:
 	devcb_write8        m_iack_cb;
 	devcb_write_line    m_holda_cb;
 
+	// recompiler state
+	std::unique_ptr<drc_cache>          m_drc_cache;
+	std::unique_ptr<drcuml_state>       m_drcuml;
+	std::unique_ptr<tms3203x_frontend>  m_drcfe;
+	uml::code_handle *  m_drc_entry;
+	uml::code_handle *  m_drc_nocode;
+	uml::code_handle *  m_drc_out_of_cycles;
+	uml::code_handle *  m_drc_reset_cache;
+	uml::code_handle *  m_drc_read;
+	uml::code_handle *  m_drc_write;
+	uint8_t             m_drc_cache_dirty;
+	uint32_t            m_drc_op;               // opcode for cfunc_fallback
+	uint32_t            m_drc_branch_pc;        // where a delayed branch goes after its delay slots
+
+	// fast RAM
+	uint32_t            m_fastram_select;
+	struct
+	{
+		offs_t          start;                  // first word of the RAM block
+		offs_t          end;                    // last word of the RAM block
+		bool            readonly;               // true if read-only
+		uint32_t *      base;                   // base in memory where the RAM lives
+	}                   m_fastram[TMS3203X_MAX_FASTRAM];
+
 	// tables
 	static void (tms3203x_device::*const s_tms32031ops[])(uint32_t op);
+	static const uint32_t s_condition_table[0x80];
 	static uint32_t (tms3203x_device::*const s_indirect_d[0x20])(uint32_t, uint8_t);
 	static uint32_t (tms3203x_device::*const s_indirect_1[0x20])(uint32_t, uint8_t);
 	static uint32_t (tms3203x_device::*const s_indirect_1_def[0x20])(uint32_t, uint8_t, uint32_t *&);
@@ -204,6 +204,62 @@ int tms340x0_device::compute_pixblt_b_cycles(int left_partials, int right_partia
 }
 
 
+/*******************************************************************
+
+    Replace and transparent replace ops on plain memory are done a
+    word at a time through host pointers instead of a pixel at a
+    time through the memory system.  Source and destination words
+    are still read and written in the same order as the per-pixel
+    loops, so overlapping blits come out the same.
+
+*******************************************************************/
+
+uint16_t *tms340x0_device::vram_ptr(uint32_t wordaddr, uint32_t words, bool write)
+{
+	offs_t const start = wordaddr << 4;
+	offs_t const end = ((wordaddr + words) << 4) - 1;
+
+	/* the whole range must be RAM for both reading and writing */
+	uint16_t *const ptr = static_cast<uint16_t *>(m_cache->read_ptr(start, end));
+	if (!write || !ptr)
+		return ptr;
+	return (m_cache->write_ptr(start, end) == ptr) ? ptr : nullptr;
+}
+
+/* mask covering the pixels in a word that are non-zero */
+template <int BitsPerPixel>
+static inline uint16_t opaque_pixels(uint16_t word)
+{
+	uint32_t bits = word;
+	for (int shift = 1; shift < BitsPerPixel; shift <<= 1)
+		bits |= bits >> shift;
+	return (bits & (0xffff / ((1 << BitsPerPixel) - 1))) * ((1 << BitsPerPixel) - 1);
+}
+
+/* replace the masked pixels of a destination word, skipping zero pixels if transparent */
+template <int BitsPerPixel, int Transparent>
+static inline uint16_t merge_pixels(uint16_t dstword, uint16_t srcword, uint16_t mask)
+{
+	if (Transparent)
+		mask &= opaque_pixels<BitsPerPixel>(srcword);
+	return (dstword & ~mask) | (srcword & mask);
+}
+
+/* expand one bit per pixel into a mask of whole pixels */
+template <int BitsPerPixel>
+static inline uint16_t expand_pixels(uint32_t bits, int count)
+{
+	if (BitsPerPixel == 1)
+		return bits;
+
+	uint16_t result = 0;
+	for (int x = 0; x < count; x++)
+		if (BIT(bits, x))
+			result |= ((1 << BitsPerPixel) - 1) << (x * BitsPerPixel);
+	return result;
+}
+
+
 /* Shift register handling */
 void tms340x0_device::memory_w(address_space &space, offs_t offset,uint16_t data)
 {
@@ -1033,6 +1089,60 @@ void FUNCTION_NAME(tms340x0_device::pixblt)(int src_is_linear, int dst_is_linear
 			uint8_t dstbit = daddr & 15;
 			uint32_t srcword, dstword = 0;
 
+#if !PIXEL_OP_REQUIRES_SOURCE
+			/* replace ops on plain memory can work a word at a time */
+			if (word_write == &tms340x0_device::memory_w)
+			{
+				uint32_t const srcwords = (srcbit + dx * BITS_PER_PIXEL + 15) >> 4;
+				uint32_t const dstwords = (dstbit + dx * BITS_PER_PIXEL + 15) >> 4;
+				uint16_t const *const src = vram_ptr(srcwordaddr, srcwords, false);
+				uint16_t *const dst = src ? vram_ptr(dstwordaddr, dstwords, true) : nullptr;
+				if (dst)
+				{
+					int const endbit = (dstbit + dx * BITS_PER_PIXEL) & 15;
+					uint16_t window[4] = { 0, 0, 0, 0 };
+					int loaded = 0;
+
+					for (uint32_t word = 0; word < dstwords; word++)
+					{
+						/* fetch source words up to the first pixel of the next destination word */
+						int const lastbit = (word + 1 < dstwords) ? (word + 1) * 16 - dstbit + srcbit + BITS_PER_PIXEL - 1 : srcbit + dx * BITS_PER_PIXEL - 1;
+						for ( ; loaded <= (lastbit >> 4); loaded++)
+							window[loaded & 3] = src[loaded];
+
+						/* shift the source bits into line with the destination word */
+						int const offset = word * 16 - dstbit + srcbit;
+						int const first = offset >> 4;
+						uint16_t const pixels = (window[first & 3] | (window[(first + 1) & 3] << 16)) >> (offset & 15);
+
+						/* mask off the partial pixels at either end */
+						uint16_t mask = 0xffff;
+						if (word == 0)
+							mask &= 0xffff << dstbit;
+						if (word + 1 == dstwords && endbit != 0)
+							mask &= (1 << endbit) - 1;
+						dst[word] = merge_pixels<BITS_PER_PIXEL, TRANSPARENCY>(dst[word], pixels, mask);
+					}
+
+					/* count the accesses the per-pixel loop makes */
+					readwrites += srcwords + dstwords + (endbit != 0) + (TRANSPARENCY ? dstwords : (dstbit != 0));
+
+					/* update for next row */
+					if (!yreverse)
+					{
+						saddr += SPTCH();
+						daddr += DPTCH();
+					}
+					else
+					{
+						saddr -= SPTCH();
+						daddr -= DPTCH();
+					}
+					continue;
+				}
+			}
+#endif
+
 			/* fetch the initial source word */
 			srcword = (this->*word_read)(*m_program, srcwordaddr++ << 4);
 			readwrites++;
@@ -1662,6 +1772,52 @@ void FUNCTION_NAME(tms340x0_device::pixblt_b)(int dst_is_linear)
 			swordaddr = saddr >> 4;
 			dwordaddr = daddr >> 4;
 
+#if !PIXEL_OP_REQUIRES_SOURCE
+			/* replace ops on plain memory can work a word at a time */
+			if (word_write == &tms340x0_device::memory_w)
+			{
+				uint32_t const dstwords = (left_partials != 0) + full_words + (right_partials != 0);
+				uint16_t const *src = vram_ptr(swordaddr, 1 + ((saddr & 15) + dx) / 16, false);
+				uint16_t *const dst = src ? vram_ptr(dwordaddr, dstwords, true) : nullptr;
+				if (dst)
+				{
+					int srcbit = saddr & 15;
+					srcword = *src++;
+
+					for (uint32_t word = 0; word < dstwords; word++)
+					{
+						int const shift = (word == 0) ? (daddr & 15) : 0;
+						int const count = (word == 0 && left_partials != 0) ? left_partials : (word + 1 == dstwords && right_partials != 0) ? right_partials : PIXELS_PER_WORD;
+
+						/* gather a bit per pixel, fetching the next source word as soon as one runs out */
+						uint32_t bits = 0;
+						for (int got = 0; got < count; )
+						{
+							int const take = std::min(count - got, 16 - srcbit);
+							bits |= ((srcword >> srcbit) & ((1 << take) - 1)) << got;
+							got += take;
+							srcbit += take;
+							if (srcbit == 16)
+							{
+								srcword = *src++;
+								srcbit = 0;
+							}
+						}
+
+						/* expand to COLOR1 and COLOR0 pixels */
+						pixel = expand_pixels<BITS_PER_PIXEL>(bits, count) << shift;
+						dstmask = ((1 << (count * BITS_PER_PIXEL)) - 1) << shift;
+						dst[word] = merge_pixels<BITS_PER_PIXEL, TRANSPARENCY>(dst[word], (COLOR1() & pixel) | (COLOR0() & ~pixel), dstmask);
+					}
+
+					/* update for next row */
+					saddr += SPTCH();
+					daddr += DPTCH();
+					continue;
+				}
+			}
+#endif
+
 			/* fetch the initial source word */
 			srcword = (this->*word_read)(*m_program, swordaddr++ << 4);
 			srcmask = 1 << (saddr & 15);
@@ -1875,6 +2031,42 @@ void FUNCTION_NAME(tms340x0_device::fill)(int dst_is_linear)
 			/* compute cycles */
 			m_gfxcycles += compute_fill_cycles(left_partials, right_partials, full_words, PIXEL_OP_TIMING);
 
+#if !PIXEL_OP_REQUIRES_SOURCE
+			/* replace ops on plain memory can work a word at a time */
+			if (word_write == &tms340x0_device::memory_w)
+			{
+				uint16_t *dst = vram_ptr(dwordaddr, (left_partials != 0) + full_words + (right_partials != 0), true);
+				if (dst)
+				{
+					uint16_t const color = COLOR1();
+
+					if (left_partials != 0)
+					{
+						dstmask = ((1 << (left_partials * BITS_PER_PIXEL)) - 1) << (daddr & 15);
+						*dst = merge_pixels<BITS_PER_PIXEL, TRANSPARENCY>(*dst, color, dstmask);
+						dst++;
+					}
+
+					if (!TRANSPARENCY || opaque_pixels<BITS_PER_PIXEL>(color) == 0xffff)
+						std::fill_n(dst, full_words, color);
+					else
+						for (words = 0; words < full_words; words++)
+							dst[words] = merge_pixels<BITS_PER_PIXEL, TRANSPARENCY>(dst[words], color, 0xffff);
+					dst += full_words;
+
+					if (right_partials != 0)
+					{
+						dstmask = (1 << (right_partials * BITS_PER_PIXEL)) - 1;
+						*dst = merge_pixels<BITS_PER_PIXEL, TRANSPARENCY>(*dst, color, dstmask);
+					}
+
+					/* update for next row */
+					daddr += DPTCH();
+					continue;
+				}
+			}
+#endif
+
 			/* handle the left partial word */
 			if (left_partials != 0)
 			{
@@ -930,6 +930,7 @@ protected:
 	int compute_fill_cycles(int left_partials, int right_partials, int full_words, int op_timing);
 	int compute_pixblt_cycles(int left_partials, int right_partials, int full_words, int op_timing);
 	int compute_pixblt_b_cycles(int left_partials, int right_partials, int full_words, int rows, int op_timing, int bpp);
+	uint16_t *vram_ptr(uint32_t wordaddr, uint32_t words, bool write);
 	void memory_w(address_space &space, offs_t offset,uint16_t data);
 	uint16_t memory_r(address_space &space, offs_t offset);
 	void shiftreg_w(address_space &space, offs_t offset, uint16_t data);
@@ -215,6 +215,29 @@ opcode_info const instruction::s_opcode_info_table[OP_MAX] =
 	OPINFO2(FRSQRT,  "f#rsqrt",  4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY))
 	OPINFO2(FCOPYI,  "f#copyi",  4|8, false, NONE, NONE, NONE, PINFO(OUT, OP, FRM), PINFO(IN, OP, IRM))
 	OPINFO2(ICOPYF,  "icopyf#",  4|8, false, NONE, NONE, NONE, PINFO(OUT, OP, IRM), PINFO(IN, OP, FRM))
+
+	// Vector Operations
+	OPINFO3(VLOAD,   "vload",    4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, PTR), PINFO(IN, 4, IANY))
+	OPINFO3(VSTORE,  "vstore",   4,   false, NONE, NONE, ALL,  PINFO(IN, OP, PTR), PINFO(IN, 4, IANY), PINFO(IN, OP, VREG))
+	OPINFO2(VMOV,    "vmov",     4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VAND,    "vand",     4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VOR,     "vor",      4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VXOR,    "vxor",     4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VADD,    "v!add",    1|2|4|8, false, NONE, NONE, ALL, PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VSUB,    "v!sub",    1|2|4|8, false, NONE, NONE, ALL, PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VADDS,   "v!adds",   1|2, false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VSUBS,   "v!subs",   1|2, false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VADDUS,  "v!addus",  1|2, false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VSUBUS,  "v!subus",  1|2, false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VMULL,   "v!mull",   2,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VMULH,   "v!mulh",   2,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VMULHU,  "v!mulhu",  2,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VCMPEQ,  "v!cmpeq",  1|2|4, false, NONE, NONE, ALL, PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VCMPGT,  "v!cmpgt",  1|2|4, false, NONE, NONE, ALL, PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VFADD,   "vfadd",    4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VFSUB,   "vfsub",    4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VFMUL,   "vfmul",    4,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, OP, VREG))
+	OPINFO3(VSHUF,   "v!shuf",   2,   false, NONE, NONE, ALL,  PINFO(OUT, OP, VREG), PINFO(IN, OP, VREG), PINFO(IN, 4, IMM))
 };
 
 
@@ -836,6 +859,77 @@ u8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  param_is_input - return true if a parameter
+//  is read by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_input(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_IN) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_is_output - return true if a parameter
+//  is written by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_output(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_OUT) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_is_pointer - return true if a memory
+//  parameter is a base pointer or state block
+//  rather than a simple operand
+//-------------------------------------------------
+
+bool uml::instruction::param_is_pointer(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].typemask & (PTYPES_PTR | PTYPES_STATE) & ~PTYPES_MEM) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_allows - return true if a parameter may
+//  be of the given type
+//-------------------------------------------------
+
+bool uml::instruction::param_allows(int paramnum, parameter::parameter_type type) const
+{
+	assert(paramnum < m_numparams);
+	return ((s_opcode_info_table[m_opcode].param[paramnum].typemask >> type) & 1) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_size - return the size in bytes of a
+//  parameter's value
+//-------------------------------------------------
+
+u8 uml::instruction::param_size(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	switch (s_opcode_info_table[m_opcode].param[paramnum].size)
+	{
+		case PSIZE_4:   return 4;
+		case PSIZE_8:   return 8;
+		case PSIZE_P1:  return 1 << m_param[0].size();
+		case PSIZE_P2:  return 1 << m_param[1].size();
+		case PSIZE_P3:  return 1 << m_param[2].size();
+		case PSIZE_P4:  return 1 << m_param[3].size();
+		default:
+		case PSIZE_OP:  return m_size;
+	}
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
@@ -943,6 +1037,11 @@ std::string uml::instruction::disasm(drcuml_state *drcuml) const
 			util::stream_format(buffer, "f%d", param.freg() - REG_F0);
 			break;
 
+		// vector registers
+		case parameter::PTYPE_VECTOR_REGISTER:
+			util::stream_format(buffer, "v%d", param.vreg() - REG_V0);
+			break;
+
 		// map variables
 		case parameter::PTYPE_MAPVAR:
 			util::stream_format(buffer, "m%d", param.mapvar() - MAPVAR_M0);
@@ -221,6 +221,29 @@ namespace uml
 		OP_FCOPYI,                  // FCOPYI  dst,src
 		OP_ICOPYF,                  // ICOPYF  dst,src
 
+		// vector operations
+		OP_VLOAD,                   // VLOAD   dst,base,index
+		OP_VSTORE,                  // VSTORE  base,index,src
+		OP_VMOV,                    // VMOV    dst,src
+		OP_VAND,                    // VAND    dst,src1,src2
+		OP_VOR,                     // VOR     dst,src1,src2
+		OP_VXOR,                    // VXOR    dst,src1,src2
+		OP_VADD,                    // VADD    dst,src1,src2
+		OP_VSUB,                    // VSUB    dst,src1,src2
+		OP_VADDS,                   // VADDS   dst,src1,src2
+		OP_VSUBS,                   // VSUBS   dst,src1,src2
+		OP_VADDUS,                  // VADDUS  dst,src1,src2
+		OP_VSUBUS,                  // VSUBUS  dst,src1,src2
+		OP_VMULL,                   // VMULL   dst,src1,src2
+		OP_VMULH,                   // VMULH   dst,src1,src2
+		OP_VMULHU,                  // VMULHU  dst,src1,src2
+		OP_VCMPEQ,                  // VCMPEQ  dst,src1,src2
+		OP_VCMPGT,                  // VCMPGT  dst,src1,src2
+		OP_VFADD,                   // VFADD   dst,src1,src2
+		OP_VFSUB,                   // VFSUB   dst,src1,src2
+		OP_VFMUL,                   // VFMUL   dst,src1,src2
+		OP_VSHUF,                   // VSHUF   dst,src,lanes
+
 		OP_MAX
 	};
 
@@ -405,6 +428,14 @@ namespace uml
 		// setters
 		void set_flags(u8 flags) { m_flags = flags; }
 		void set_mapvar(int paramnum, u32 value) { assert(paramnum < m_numparams); assert(m_param[paramnum].is_mapvar()); m_param[paramnum] = value; }
+		void set_param(int paramnum, parameter const &param) { assert(paramnum < m_numparams); assert(param_allows(paramnum, param.type())); m_param[paramnum] = param; }
+
+		// parameter information
+		bool param_is_input(int paramnum) const;
+		bool param_is_output(int paramnum) const;
+		bool param_is_pointer(int paramnum) const;
+		bool param_allows(int paramnum, parameter::parameter_type type) const;
+		u8 param_size(int paramnum) const;
 
 		// misc
 		std::string disasm(drcuml_state *drcuml = nullptr) const;
@@ -571,6 +602,29 @@ namespace uml
 		void fdcopyi(parameter dst, parameter src) { configure(OP_FCOPYI, 8, dst, src); }
 		void icopyfd(parameter dst, parameter src) { configure(OP_ICOPYF, 8, dst, src); }
 
+		// 128-bit vector operations; the size is the width of each lane
+		void vload(parameter dst, void const *base, parameter index) { configure(OP_VLOAD, 4, dst, parameter::make_memory(base), index); }
+		void vstore(void *base, parameter index, parameter src) { configure(OP_VSTORE, 4, parameter::make_memory(base), index, src); }
+		void vmov(parameter dst, parameter src) { configure(OP_VMOV, 4, dst, src); }
+		void vand(parameter dst, parameter src1, parameter src2) { configure(OP_VAND, 4, dst, src1, src2); }
+		void vor(parameter dst, parameter src1, parameter src2) { configure(OP_VOR, 4, dst, src1, src2); }
+		void vxor(parameter dst, parameter src1, parameter src2) { configure(OP_VXOR, 4, dst, src1, src2); }
+		void vadd(operand_size lane, parameter dst, parameter src1, parameter src2) { configure(OP_VADD, 1 << lane, dst, src1, src2); }
+		void vsub(operand_size lane, parameter dst, parameter src1, parameter src2) { configure(OP_VSUB, 1 << lane, dst, src1, src2); }
+		void vadds(operand_size lane, parameter dst, parameter src1, parameter src2) { configure(OP_VADDS, 1 << lane, dst, src1, src2); }
+		void vsubs(operand_size lane, parameter dst, parameter src1, parameter src2) { configure(OP_VSUBS, 1 << lane, dst, src1, src2); }
+		void vaddus(operand_size lane, parameter dst, parameter src1, parameter src2) { configure(OP_VADDUS, 1 << lane, dst, src1, src2); }
+		void vsubus(operand_size lane, parameter dst, parameter src1, parameter src2) { configure(OP_VSUBUS, 1 << lane, dst, src1, src2); }
+		void vmull(parameter dst, parameter src1, parameter src2) { configure(OP_VMULL, 2, dst, src1, src2); }
+		void vmulh(parameter dst, parameter src1, parameter src2) { configure(OP_VMULH, 2, dst, src1, src2); }
+		void vmulhu(parameter dst, parameter src1, parameter src2) { configure(OP_VMULHU, 2, dst, src1, src2); }
+		void vcmpeq(operand_size lane, parameter dst, parameter src1, parameter src2) { configure(OP_VCMPEQ, 1 << lane, dst, src1, src2); }
+		void vcmpgt(operand_size lane, parameter dst, parameter src1, parameter src2) { configure(OP_VCMPGT, 1 << lane, dst, src1, src2); }
+		void vfadd(parameter dst, parameter src1, parameter src2) { configure(OP_VFADD, 4, dst, src1, src2); }
+		void vfsub(parameter dst, parameter src1, parameter src2) { configure(OP_VFSUB, 4, dst, src1, src2); }
+		void vfmul(parameter dst, parameter src1, parameter src2) { configure(OP_VFMUL, 4, dst, src1, src2); }
+		void vshuf(parameter dst, parameter src, u32 lanes) { configure(OP_VSHUF, 2, dst, src, lanes); }
+
 		// constants
 		static constexpr int MAX_PARAMS = 4;
 
@@ -26,6 +26,8 @@
 uint32_t v60_device::ReadAM()
 {
 	m_modm = m_modm?1:0;
+	if (m_dec_insn)
+		return decode_operand(AMT_READ);
 	m_modval = OpRead8(m_modadd);
 	return (this->*s_AMTable1[m_modm][m_modval >> 5])();
 }
@@ -33,6 +35,8 @@ uint32_t v60_device::ReadAM()
 uint32_t v60_device::BitReadAM()
 {
 	m_modm = m_modm?1:0;
+	if (m_dec_insn)
+		return decode_operand(AMT_BITREAD);
 	m_modval = OpRead8(m_modadd);
 	return (this->*s_BAMTable1[m_modm][m_modval >> 5])();
 }
@@ -53,6 +57,8 @@ uint32_t v60_device::BitReadAM()
 uint32_t v60_device::ReadAMAddress()
 {
 	m_modm = m_modm?1:0;
+	if (m_dec_insn)
+		return decode_operand(AMT_ADDRESS);
 	m_modval = OpRead8(m_modadd);
 	return (this->*s_AMTable2[m_modm][m_modval >> 5])();
 }
@@ -60,6 +66,8 @@ uint32_t v60_device::ReadAMAddress()
 uint32_t v60_device::BitReadAMAddress()
 {
 	m_modm = m_modm?1:0;
+	if (m_dec_insn)
+		return decode_operand(AMT_BITADDRESS);
 	m_modval = OpRead8(m_modadd);
 	return (this->*s_BAMTable2[m_modm][m_modval >> 5])();
 }
@@ -78,6 +86,8 @@ uint32_t v60_device::BitReadAMAddress()
 uint32_t v60_device::WriteAM()
 {
 	m_modm = m_modm?1:0;
+	if (m_dec_insn)
+		return decode_operand(AMT_WRITE);
 	m_modval = OpRead8(m_modadd);
 	return (this->*s_AMTable3[m_modm][m_modval >> 5])();
 }
@@ -0,0 +1,465 @@
+// license:BSD-3-Clause
+// copyright-holders:Farfetch'd, R. Belmont
+// Decoded block cache
+// *******************
+//
+// Straight-line runs of instructions are kept as blocks, each instruction
+// with its opcode handler and the addressing modes it has decoded.  An
+// addressing mode is resolved through the AM tables once, and the common
+// ones (register, register indirect, autoincrement and decrement,
+// displacement, PC displacement, direct address and immediate) become
+// micro-ops with their displacement or immediate already read.  The rest
+// keep the resolved mode function, which skips the table walk.
+//
+// Operands are decoded the first time the opcode handler asks for them,
+// so the handlers themselves are unchanged.  Pages of RAM holding decoded
+// code get a write tap, and a write there frees the blocks decoded from
+// the page.  Bank switches and state loads discard everything.  Writes
+// that bypass the address space, such as a driver copying code straight
+// into a share, aren't seen.
+
+namespace {
+
+constexpr int DECODE_PAGE_BITS = 10;
+constexpr int DECODE_MAX_INSN_BYTES = 32;
+constexpr size_t DECODE_MAX_BLOCK = 32;
+constexpr size_t DECODE_MAX_BLOCKS = 32768;
+
+} // anonymous namespace
+
+
+const v60_device::am_decoder v60_device::s_am_decoders[AMT_COUNT] =
+{
+	{ s_AMTable1,  s_AMTable1_G7,  s_AMTable1_G6,  s_AMTable1_G7a },
+	{ s_BAMTable1, s_BAMTable1_G7, s_BAMTable1_G6, s_BAMTable1_G7a },
+	{ s_AMTable2,  s_AMTable2_G7,  s_AMTable2_G6,  s_AMTable2_G7a },
+	{ s_BAMTable2, s_BAMTable2_G7, s_BAMTable2_G6, s_BAMTable2_G7a },
+	{ s_AMTable3,  s_AMTable3_G7,  s_AMTable3_G6,  s_AMTable3_G7a }
+};
+
+const v60_device::am_micro_op v60_device::s_am_micro_ops[] =
+{
+	{ AMT_READ,     &v60_device::am1Register,          AMD_REGISTER,        0 },
+	{ AMT_READ,     &v60_device::am1RegisterIndirect,  AMD_REG_INDIRECT,    0 },
+	{ AMT_READ,     &v60_device::am1Autoincrement,     AMD_AUTOINC,         0 },
+	{ AMT_READ,     &v60_device::am1Autodecrement,     AMD_AUTODEC,         0 },
+	{ AMT_READ,     &v60_device::am1Displacement8,     AMD_DISPLACEMENT,    1 },
+	{ AMT_READ,     &v60_device::am1Displacement16,    AMD_DISPLACEMENT,    2 },
+	{ AMT_READ,     &v60_device::am1Displacement32,    AMD_DISPLACEMENT,    4 },
+	{ AMT_READ,     &v60_device::am1PCDisplacement8,   AMD_PC_DISPLACEMENT, 1 },
+	{ AMT_READ,     &v60_device::am1PCDisplacement16,  AMD_PC_DISPLACEMENT, 2 },
+	{ AMT_READ,     &v60_device::am1PCDisplacement32,  AMD_PC_DISPLACEMENT, 4 },
+	{ AMT_READ,     &v60_device::am1DirectAddress,     AMD_DIRECT,          4 },
+	{ AMT_READ,     &v60_device::am1Immediate,         AMD_IMMEDIATE,       0 },
+	{ AMT_READ,     &v60_device::am1ImmediateQuick,    AMD_IMMEDIATE,       0 },
+
+	{ AMT_ADDRESS,  &v60_device::am2Register,          AMD_REGISTER,        0 },
+	{ AMT_ADDRESS,  &v60_device::am2RegisterIndirect,  AMD_REG_INDIRECT,    0 },
+	{ AMT_ADDRESS,  &v60_device::am2Autoincrement,     AMD_AUTOINC,         0 },
+	{ AMT_ADDRESS,  &v60_device::am2Autodecrement,     AMD_AUTODEC,         0 },
+	{ AMT_ADDRESS,  &v60_device::am2Displacement8,     AMD_DISPLACEMENT,    1 },
+	{ AMT_ADDRESS,  &v60_device::am2Displacement16,    AMD_DISPLACEMENT,    2 },
+	{ AMT_ADDRESS,  &v60_device::am2Displacement32,    AMD_DISPLACEMENT,    4 },
+	{ AMT_ADDRESS,  &v60_device::am2PCDisplacement8,   AMD_PC_DISPLACEMENT, 1 },
+	{ AMT_ADDRESS,  &v60_device::am2PCDisplacement16,  AMD_PC_DISPLACEMENT, 2 },
+	{ AMT_ADDRESS,  &v60_device::am2PCDisplacement32,  AMD_PC_DISPLACEMENT, 4 },
+	{ AMT_ADDRESS,  &v60_device::am2DirectAddress,     AMD_DIRECT,          4 },
+	{ AMT_ADDRESS,  &v60_device::am2Immediate,         AMD_IMMEDIATE,       0 },
+	{ AMT_ADDRESS,  &v60_device::am2ImmediateQuick,    AMD_IMMEDIATE,       0 },
+
+	{ AMT_WRITE,    &v60_device::am3Register,          AMD_REGISTER,        0 },
+	{ AMT_WRITE,    &v60_device::am3RegisterIndirect,  AMD_REG_INDIRECT,    0 },
+	{ AMT_WRITE,    &v60_device::am3Autoincrement,     AMD_AUTOINC,         0 },
+	{ AMT_WRITE,    &v60_device::am3Autodecrement,     AMD_AUTODEC,         0 },
+	{ AMT_WRITE,    &v60_device::am3Displacement8,     AMD_DISPLACEMENT,    1 },
+	{ AMT_WRITE,    &v60_device::am3Displacement16,    AMD_DISPLACEMENT,    2 },
+	{ AMT_WRITE,    &v60_device::am3Displacement32,    AMD_DISPLACEMENT,    4 },
+	{ AMT_WRITE,    &v60_device::am3PCDisplacement8,   AMD_PC_DISPLACEMENT, 1 },
+	{ AMT_WRITE,    &v60_device::am3PCDisplacement16,  AMD_PC_DISPLACEMENT, 2 },
+	{ AMT_WRITE,    &v60_device::am3PCDisplacement32,  AMD_PC_DISPLACEMENT, 4 },
+	{ AMT_WRITE,    &v60_device::am3DirectAddress,     AMD_DIRECT,          4 }
+};
+
+
+/*
+  Blocks
+*/
+
+void v60_device::decode_invalidate()
+{
+	if (m_dec_flush)
+	{
+		m_dec_blocks.clear();
+		m_dec_pages.clear();
+		m_dec_flush = false;
+	}
+	else
+	{
+		for (offs_t page : m_dec_written)
+		{
+			auto const found = m_dec_pages.find(page);
+			if (found == m_dec_pages.end())
+				continue;
+			for (offs_t start : found->second)
+				m_dec_blocks.erase(start);
+			m_dec_pages.erase(found);
+		}
+	}
+	m_dec_written.clear();
+
+	// links into freed blocks are no longer followed
+	m_dec_generation++;
+}
+
+v60_device::decoded_block &v60_device::decode_find_block(decoded_block *prev)
+{
+	if (prev && (prev->link_generation == m_dec_generation) && (prev->link_pc == PC))
+		return *prev->link;
+
+	if (m_dec_blocks.size() >= DECODE_MAX_BLOCKS)
+	{
+		m_dec_flush = true;
+		decode_invalidate();
+		prev = nullptr;
+	}
+
+	auto const inserted = m_dec_blocks.emplace(PC, decoded_block());
+	decoded_block &block = inserted.first->second;
+	if (inserted.second)
+	{
+		block.start = PC;
+		block.link_pc = 0;
+		block.link = nullptr;
+		block.link_generation = 0;
+	}
+
+	if (prev)
+	{
+		prev->link_pc = PC;
+		prev->link = &block;
+		prev->link_generation = m_dec_generation;
+	}
+	return block;
+}
+
+void v60_device::decode_execute_block(decoded_block &block)
+{
+	for (size_t index = 0; m_icount > 0; index++)
+	{
+		// extend the block the first time execution runs off its end
+		if (index == block.insns.size())
+		{
+			if (index == DECODE_MAX_BLOCK)
+				return;
+			decode_add_page(block, PC);
+			decode_add_page(block, PC + DECODE_MAX_INSN_BYTES - 1);
+
+			decoded_insn insn;
+			insn.pc = PC;
+			insn.handler = s_OpCodeTable[OpRead8(PC)];
+			insn.operands = 0;
+			block.insns.push_back(insn);
+		}
+
+		decoded_insn &insn = block.insns[index];
+		if (insn.pc != PC)
+			return;
+
+		m_PPC = PC;
+		debugger_instruction_hook(PC);
+		m_icount -= 8;  /* fix me -- this is just an average */
+		m_dec_insn = &insn;
+		uint32_t const inc = (this->*insn.handler)();
+		m_dec_insn = nullptr;
+		PC += inc;
+		if (m_irq_line != CLEAR_LINE)
+			v60_try_irq();
+
+		// the block may have been freed under us; anything but falling through leaves it
+		if (m_dec_flush || !m_dec_written.empty())
+			return;
+		if (!inc || (PC != insn.pc + inc))
+			return;
+	}
+}
+
+void v60_device::decode_add_page(decoded_block &block, offs_t address)
+{
+	offs_t const page = (address & m_program->addrmask()) >> DECODE_PAGE_BITS;
+	std::vector<offs_t> &starts = m_dec_pages[page];
+	if (starts.empty() || (starts.back() != block.start))
+		starts.push_back(block.start);
+
+	// ROM can't change, so it needs no tap; anything else might be RAM, and a bank switch can make it so later
+	if (m_dec_tapped.count(page))
+		return;
+	offs_t const start = page << DECODE_PAGE_BITS;
+	offs_t const end = start + (1 << DECODE_PAGE_BITS) - 1;
+	if (m_program->get_read_ptr(start) && !m_program->get_write_ptr(start))
+		return;
+
+	m_dec_tapped.insert(page);
+	m_dec_installing = true;
+	if (m_program->data_width() == 16)
+		m_program->install_write_tap(start, end, "v60_decode", [this, page] (offs_t offset, u16 &data, u16 mem_mask) { decode_code_written(page); });
+	else
+		m_program->install_write_tap(start, end, "v60_decode", [this, page] (offs_t offset, u32 &data, u32 mem_mask) { decode_code_written(page); });
+	m_dec_installing = false;
+}
+
+void v60_device::decode_code_written(offs_t page)
+{
+	// taps stay after their blocks are freed, so only pages holding code count
+	if ((m_dec_written.empty() || (m_dec_written.back() != page)) && m_dec_pages.count(page))
+		m_dec_written.push_back(page);
+}
+
+
+/*
+  Operands
+*/
+
+uint32_t v60_device::decode_operand(uint8_t table)
+{
+	decoded_insn &insn = *m_dec_insn;
+	for (int opnum = 0; opnum < insn.operands; opnum++)
+	{
+		decoded_operand const &op = insn.operand[opnum];
+		if ((op.modadd == m_modadd) && (op.table == table) && (op.modm == m_modm) && (op.moddim == m_moddim))
+			return decode_run_operand(op);
+	}
+
+	decoded_operand op;
+	decode_describe_operand(op, table);
+	if (insn.operands < ARRAY_LENGTH(insn.operand))
+		insn.operand[insn.operands++] = op;
+	return decode_run_operand(op);
+}
+
+void v60_device::decode_describe_operand(decoded_operand &op, uint8_t table)
+{
+	op.modadd = m_modadd;
+	op.table = table;
+	op.modm = m_modm;
+	op.moddim = m_moddim;
+	op.modval = OpRead8(m_modadd);
+	op.modval2 = 0;
+	op.kind = AMD_LEAF;
+	op.length = 0;
+	op.value = 0;
+
+	// walk the tables as the group functions would
+	am_decoder const &decoder = s_am_decoders[table];
+	op.leaf = decoder.top[op.modm][op.modval >> 5];
+	if (!op.modm && ((op.modval >> 5) == 7))
+		op.leaf = decoder.group7[op.modval & 0x1f];
+	else if (op.modm && ((op.modval >> 5) == 6))
+	{
+		op.modval2 = OpRead8(m_modadd + 1);
+		if ((op.modval2 >> 5) != 7)
+			op.leaf = decoder.group6[op.modval2 >> 5];
+		else if (op.modval2 & 0x10)
+			op.leaf = decoder.group7a[op.modval2 & 0xf];
+
+		// otherwise leave the group function to report the bad mode
+	}
+
+	// only the operand sizes the micro-ops cover
+	if (op.moddim > ((table == AMT_ADDRESS) ? 3 : 2))
+		return;
+
+	for (am_micro_op const &micro : s_am_micro_ops)
+	{
+		if ((micro.table != table) || (micro.leaf != op.leaf))
+			continue;
+
+		switch (micro.kind)
+		{
+		case AMD_DISPLACEMENT:
+		case AMD_PC_DISPLACEMENT:
+			switch (micro.size)
+			{
+			case 1: op.value = (int8_t)OpRead8(m_modadd + 1); break;
+			case 2: op.value = (int16_t)OpRead16(m_modadd + 1); break;
+			case 4: op.value = OpRead32(m_modadd + 1); break;
+			}
+			op.length = 1 + micro.size;
+			break;
+
+		case AMD_DIRECT:
+			op.value = OpRead32(m_modadd + 1);
+			op.length = 5;
+			break;
+
+		case AMD_IMMEDIATE:
+			if (micro.leaf == ((table == AMT_READ) ? &v60_device::am1ImmediateQuick : &v60_device::am2ImmediateQuick))
+			{
+				op.value = op.modval & 0xf;
+				op.length = 1;
+			}
+			else
+			{
+				// am1Immediate has no other sizes
+				if (op.moddim > 2)
+					return;
+				switch (op.moddim)
+				{
+				case 0: op.value = OpRead8(m_modadd + 1); op.length = 2; break;
+				case 1: op.value = OpRead16(m_modadd + 1); op.length = 3; break;
+				case 2: op.value = OpRead32(m_modadd + 1); op.length = 5; break;
+				}
+			}
+			break;
+
+		default:
+			op.length = 1;
+			break;
+		}
+		op.kind = micro.kind;
+		return;
+	}
+}
+
+uint32_t v60_device::decode_read(uint8_t dim, offs_t address)
+{
+	switch (dim)
+	{
+	case 0:
+		return m_program->read_byte(address);
+	case 1:
+		return m_program->read_word_unaligned(address);
+	default:
+		return m_program->read_dword_unaligned(address);
+	}
+}
+
+void v60_device::decode_write(uint8_t dim, offs_t address)
+{
+	switch (dim)
+	{
+	case 0:
+		m_program->write_byte(address, m_modwritevalb);
+		break;
+	case 1:
+		m_program->write_word_unaligned(address, m_modwritevalh);
+		break;
+	default:
+		m_program->write_dword_unaligned(address, m_modwritevalw);
+		break;
+	}
+}
+
+uint32_t v60_device::decode_run_operand(const decoded_operand &op)
+{
+	// the handlers may look at the mode bytes afterwards
+	m_modval = op.modval;
+	m_modval2 = op.modval2;
+	if (op.kind == AMD_LEAF)
+		return (this->*op.leaf)();
+
+	uint32_t &reg = m_reg[op.modval & 0x1f];
+	uint8_t const dim = op.moddim;
+	switch (op.table)
+	{
+	case AMT_READ:
+		switch (op.kind)
+		{
+		case AMD_REGISTER:
+			m_amout = (dim == 0) ? (uint8_t)reg : (dim == 1) ? (uint16_t)reg : reg;
+			break;
+		case AMD_REG_INDIRECT:
+			m_amout = decode_read(dim, reg);
+			break;
+		case AMD_AUTOINC:
+			m_amout = decode_read(dim, reg);
+			reg += 1 << dim;
+			break;
+		case AMD_AUTODEC:
+			reg -= 1 << dim;
+			m_amout = decode_read(dim, reg);
+			break;
+		case AMD_DISPLACEMENT:
+			m_amout = decode_read(dim, reg + op.value);
+			break;
+		case AMD_PC_DISPLACEMENT:
+			m_amout = decode_read(dim, PC + op.value);
+			break;
+		case AMD_DIRECT:
+			m_amout = decode_read(dim, op.value);
+			break;
+		case AMD_IMMEDIATE:
+			m_amout = op.value;
+			break;
+		}
+		break;
+
+	case AMT_ADDRESS:
+		// immediates leave m_amflag alone, as am1Immediate does
+		if (op.kind != AMD_IMMEDIATE)
+			m_amflag = 0;
+		switch (op.kind)
+		{
+		case AMD_REGISTER:
+			m_amflag = 1;
+			m_amout = op.modval & 0x1f;
+			break;
+		case AMD_REG_INDIRECT:
+			m_amout = reg;
+			break;
+		case AMD_AUTOINC:
+			m_amout = reg;
+			reg += 1 << dim;
+			break;
+		case AMD_AUTODEC:
+			reg -= 1 << dim;
+			m_amout = reg;
+			break;
+		case AMD_DISPLACEMENT:
+			m_amout = reg + op.value;
+			break;
+		case AMD_PC_DISPLACEMENT:
+			m_amout = PC + op.value;
+			break;
+		case AMD_DIRECT:
+		case AMD_IMMEDIATE:
+			m_amout = op.value;
+			break;
+		}
+		break;
+
+	case AMT_WRITE:
+		switch (op.kind)
+		{
+		case AMD_REGISTER:
+			if (dim == 0)
+				SETREG8(reg, m_modwritevalb);
+			else if (dim == 1)
+				SETREG16(reg, m_modwritevalh);
+			else
+				reg = m_modwritevalw;
+			break;
+		case AMD_REG_INDIRECT:
+			decode_write(dim, reg);
+			break;
+		case AMD_AUTOINC:
+			decode_write(dim, reg);
+			reg += 1 << dim;
+			break;
+		case AMD_AUTODEC:
+			reg -= 1 << dim;
+			decode_write(dim, reg);
+			break;
+		case AMD_DISPLACEMENT:
+			decode_write(dim, reg + op.value);
+			break;
+		case AMD_PC_DISPLACEMENT:
+			decode_write(dim, PC + op.value);
+			break;
+		case AMD_DIRECT:
+			decode_write(dim, op.value);
+			break;
+		}
+		break;
+	}
+	return op.length;
+}
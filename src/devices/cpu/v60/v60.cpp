@@ -365,6 +365,9 @@ uint32_t v60_device::opUNHANDLED()
 // Opcode jump table
 #include "optable.hxx"
 
+// Decoded block cache
+#include "decode.hxx"
+
 void v60_device::device_start()
 {
 	m_stall_io = 0;
@@ -409,6 +412,11 @@ void v60_device::device_start()
 	m_modwritevalw = 0;
 	m_moddim = 0;
 
+	m_dec_insn = nullptr;
+	m_dec_generation = 1;
+	m_dec_flush = false;
+	m_dec_installing = false;
+
 	m_program = &space(AS_PROGRAM);
 	if (m_program->data_width() == 16)
 	{
@@ -427,6 +435,11 @@ void v60_device::device_start()
 
 	m_io = &space(AS_IO);
 
+	// map changes and bank switches can put different code under decoded blocks
+	auto flush = [this] (read_or_write mode) { if (!m_dec_installing) m_dec_flush = true; };
+	m_program->add_change_notifier(flush);
+	m_program->add_bank_notifier(flush);
+
 	save_item(NAME(m_reg));
 	save_item(NAME(m_irq_line));
 	save_item(NAME(m_nmi_line));
@@ -539,6 +552,15 @@ void v60_device::device_reset()
 	_OV   = 0;
 	_S    = 0;
 	_Z    = 0;
+
+	m_dec_flush = true;
+}
+
+
+void v60_device::device_post_load()
+{
+	// memory was restored without going through the write taps
+	m_dec_flush = true;
 }
 
 
@@ -604,15 +626,16 @@ void v60_device::execute_run()
 	if (m_irq_line != CLEAR_LINE)
 		v60_try_irq();
 
+	decoded_block *block = nullptr;
 	while (m_icount > 0)
 	{
-		uint32_t inc;
-		m_PPC = PC;
-		debugger_instruction_hook(PC);
-		m_icount -= 8;  /* fix me -- this is just an average */
-		inc = (this->*s_OpCodeTable[OpRead8(PC)])();
-		PC += inc;
-		if (m_irq_line != CLEAR_LINE)
-			v60_try_irq();
+		if (m_dec_flush || !m_dec_written.empty())
+		{
+			decode_invalidate();
+			block = nullptr;
+		}
+
+		block = &decode_find_block(block);
+		decode_execute_block(*block);
 	}
 }
@@ -5,6 +5,10 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 
 enum
 {
@@ -94,6 +98,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_post_load() override;
 
 	// device_execute_interface overrides
 	virtual uint32_t execute_min_cycles() const override { return 1; }
@@ -197,6 +202,89 @@ private:
 
 	uint32_t m_debugger_temp;
 
+	// decoded block cache (decode.hxx)
+	enum : uint8_t
+	{
+		AMT_READ,                   // ReadAM
+		AMT_BITREAD,                // BitReadAM
+		AMT_ADDRESS,                // ReadAMAddress
+		AMT_BITADDRESS,             // BitReadAMAddress
+		AMT_WRITE,                  // WriteAM
+		AMT_COUNT
+	};
+
+	enum : uint8_t
+	{
+		AMD_LEAF,                   // call the resolved addressing mode function
+		AMD_REGISTER,               // Rn
+		AMD_REG_INDIRECT,           // [Rn]
+		AMD_AUTOINC,                // [Rn+]
+		AMD_AUTODEC,                // [-Rn]
+		AMD_DISPLACEMENT,           // disp[Rn]
+		AMD_PC_DISPLACEMENT,        // disp[PC]
+		AMD_DIRECT,                 // /addr
+		AMD_IMMEDIATE               // #imm, including the quick form
+	};
+
+	struct am_decoder
+	{
+		const am_func (*top)[8];    // indexed by m_modm and the top three bits of the mode
+		const am_func *group7;      // m_modm = 0, mode 7
+		const am_func *group6;      // m_modm = 1, mode 6, indexed by the second byte
+		const am_func *group7a;     // group 6 entry 7
+	};
+
+	struct am_micro_op
+	{
+		uint8_t     table;          // AMT_*
+		am_func     leaf;           // addressing mode function it replaces
+		uint8_t     kind;           // AMD_*
+		uint8_t     size;           // displacement bytes
+	};
+
+	struct decoded_operand
+	{
+		uint32_t    modadd;         // address of the addressing mode byte
+		uint8_t     table;          // AMT_* decoder that was asked for it
+		uint8_t     modm;
+		uint8_t     moddim;
+		uint8_t     kind;           // AMD_* micro-op
+		uint8_t     modval;
+		uint8_t     modval2;
+		uint8_t     length;         // bytes of the operand, for anything but AMD_LEAF
+		uint32_t    value;          // displacement, address or immediate
+		am_func     leaf;           // for AMD_LEAF
+	};
+
+	struct decoded_insn
+	{
+		offs_t      pc;
+		am_func     handler;        // opcode handler
+		uint8_t     operands;       // operands decoded so far
+		decoded_operand operand[3];
+	};
+
+	struct decoded_block
+	{
+		offs_t      start;
+		std::vector<decoded_insn> insns;    // straight-line run from start
+		offs_t      link_pc;        // where execution last left the block
+		decoded_block *link;        // block at link_pc
+		uint32_t    link_generation;    // m_dec_generation when link was set
+	};
+
+	static const am_decoder s_am_decoders[AMT_COUNT];
+	static const am_micro_op s_am_micro_ops[];
+
+	std::unordered_map<offs_t, decoded_block> m_dec_blocks;         // by start PC
+	std::unordered_map<offs_t, std::vector<offs_t>> m_dec_pages;    // start PCs of the blocks decoded from each page
+	std::unordered_set<offs_t> m_dec_tapped;                        // pages with a write tap
+	std::vector<offs_t> m_dec_written;                              // code pages written since the last check
+	decoded_insn *      m_dec_insn;                                 // instruction being executed
+	uint32_t            m_dec_generation;                           // bumped whenever blocks are freed
+	bool                m_dec_flush;                                // discard every block before the next one runs
+	bool                m_dec_installing;                           // ignore our own tap installation
+
 
 	inline void v60SaveStack();
 	inline void v60ReloadStack();
@@ -769,6 +857,17 @@ private:
 	void v60_do_irq(int vector);
 	void v60_try_irq();
 
+	void decode_invalidate();
+	decoded_block &decode_find_block(decoded_block *prev);
+	void decode_execute_block(decoded_block &block);
+	void decode_add_page(decoded_block &block, offs_t address);
+	void decode_code_written(offs_t page);
+	uint32_t decode_operand(uint8_t table);
+	void decode_describe_operand(decoded_operand &op, uint8_t table);
+	uint32_t decode_run_operand(const decoded_operand &op);
+	uint32_t decode_read(uint8_t dim, offs_t address);
+	void decode_write(uint8_t dim, offs_t address);
+
 };
 
 
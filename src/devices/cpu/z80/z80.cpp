@@ -425,6 +425,7 @@ inline void z80_device::leave_halt()
  ***************************************************************/
 inline uint8_t z80_device::in(uint16_t port)
 {
+	idle_loop_dirty();
 	return m_io->read_byte(port);
 }
 
@@ -433,6 +434,7 @@ inline uint8_t z80_device::in(uint16_t port)
  ***************************************************************/
 inline void z80_device::out(uint16_t port, uint8_t value)
 {
+	idle_loop_dirty();
 	m_io->write_byte(port, value);
 }
 
@@ -441,6 +443,9 @@ inline void z80_device::out(uint16_t port, uint8_t value)
  ***************************************************************/
 inline uint8_t z80_device::rm(uint16_t addr)
 {
+	// handlers can have side effects or change value by themselves, so only memory reads keep a loop idle
+	if (idle_loop_enabled() && !arg_page(addr))
+		idle_loop_dirty();
 	return m_program->read_byte(addr);
 }
 
@@ -458,6 +463,7 @@ inline void z80_device::rm16(uint16_t addr, PAIR &r)
  ***************************************************************/
 inline void z80_device::wm(uint16_t addr, uint8_t value)
 {
+	idle_loop_dirty();
 	m_program->write_byte(addr, value);
 }
 
@@ -479,10 +485,14 @@ inline uint8_t z80_device::rop()
 {
 	unsigned pc = PCD;
 	PC++;
-	uint8_t res = m_opcodes_cache->read_byte(pc);
-	m_icount -= 2;
-	m_refresh_cb((m_i << 8) | (m_r2 & 0x80) | ((m_r-1) & 0x7f), 0x00, 0xff);
-	m_icount += 2;
+	const uint8_t *page = op_page(pc);
+	uint8_t res = page ? page[pc & 0xff] : m_opcodes_cache->read_byte(pc);
+	if (m_refresh_enabled)
+	{
+		m_icount -= 2;
+		m_refresh_cb((m_i << 8) | (m_r2 & 0x80) | ((m_r-1) & 0x7f), 0x00, 0xff);
+		m_icount += 2;
+	}
 	return res;
 }
 
@@ -496,13 +506,17 @@ inline uint8_t z80_device::arg()
 {
 	unsigned pc = PCD;
 	PC++;
-	return m_cache->read_byte(pc);
+	const uint8_t *page = arg_page(pc);
+	return page ? page[pc & 0xff] : m_cache->read_byte(pc);
 }
 
 inline uint16_t z80_device::arg16()
 {
 	unsigned pc = PCD;
 	PC += 2;
+	const uint8_t *page = arg_page(pc);
+	if (page && ((pc & 0xff) != 0xff))
+		return page[pc & 0xff] | (page[(pc & 0xff) + 1] << 8);
 	return m_cache->read_byte(pc) | (m_cache->read_byte((pc+1)&0xffff) << 8);
 }
 
@@ -540,13 +554,28 @@ inline void z80_device::push(PAIR &r)
 	wm16(SPD, r);
 }
 
+/***************************************************************
+ * Report a taken backward branch to the idle loop detector
+ ***************************************************************/
+inline void z80_device::idle_branch()
+{
+	// the alternate set can count while the main one stands still, so it's part of the state;
+	// rotate it so that swapping the sets changes the signature
+	uint64_t const regs = (uint64_t(AF) << 48) | (uint64_t(BC) << 32) | (uint64_t(DE) << 16) | HL;
+	uint64_t const alt = (uint64_t(m_af2.w.l) << 48) | (uint64_t(m_bc2.w.l) << 32) | (uint64_t(m_de2.w.l) << 16) | m_hl2.w.l;
+	idle_loop_branch(PCD, regs ^ ((alt << 8) | (alt >> 56)) ^ (uint64_t(IX) << 8) ^ (uint64_t(IY) << 24) ^ (uint64_t(SP) << 40) ^ (uint64_t(m_i) << 4));
+}
+
 /***************************************************************
  * JP
  ***************************************************************/
 inline void z80_device::jp(void)
 {
+	uint16_t const from = PC;
 	PCD = arg16();
 	WZ = PCD;
+	if (PC < from)
+		idle_branch();
 }
 
 /***************************************************************
@@ -556,8 +585,11 @@ inline void z80_device::jp_cond(bool cond)
 {
 	if (cond)
 	{
+		uint16_t const from = PC;
 		PCD = arg16();
 		WZ = PCD;
+		if (PC < from)
+			idle_branch();
 	}
 	else
 	{
@@ -573,6 +605,8 @@ inline void z80_device::jr()
 	int8_t a = (int8_t)arg(); /* arg() also increments PC */
 	PC += a;                  /* so don't do PC += arg() */
 	WZ = PC;
+	if (a < 0)
+		idle_branch();
 }
 
 /***************************************************************
@@ -3411,6 +3445,17 @@ void z80_device::device_start()
 	m_opcodes_cache = m_opcodes->cache<0, 0, ENDIANNESS_LITTLE>();
 	m_io = &space(AS_IO);
 
+	// start again whenever the address map changes or a bank switches
+	auto invalidate = [this](read_or_write mode) { invalidate_pages(); };
+	m_program->add_change_notifier(invalidate);
+	m_program->add_bank_notifier(invalidate);
+	if (m_opcodes != m_program)
+	{
+		m_opcodes->add_change_notifier(invalidate);
+		m_opcodes->add_bank_notifier(invalidate);
+	}
+	invalidate_pages();
+
 	IX = IY = 0xffff; /* IX and IY are FFFF after a reset! */
 	F = ZF;           /* Zero flag is set */
 
@@ -3457,10 +3502,38 @@ void z80_device::device_start()
 	m_cc_ex = cc_ex;
 
 	m_irqack_cb.resolve_safe();
+	m_refresh_enabled = !m_refresh_cb.isnull();
 	m_refresh_cb.resolve_safe();
 	m_halt_cb.resolve_safe();
 }
 
+void z80_device::invalidate_pages()
+{
+	std::fill(std::begin(m_op_pages), std::end(m_op_pages), nullptr);
+	std::fill(std::begin(m_arg_pages), std::end(m_arg_pages), nullptr);
+	std::fill(std::begin(m_page_resolved), std::end(m_page_resolved), false);
+}
+
+void z80_device::resolve_page(int page)
+{
+	// a page is only usable if every byte of it is in one contiguous block of host memory,
+	// so a handler or tap anywhere in it keeps the whole page on the normal path
+	offs_t const base = page << 8;
+	auto page_ptr = [base](address_space &space) -> const uint8_t * {
+		uint8_t const *const start = static_cast<uint8_t const *>(space.get_read_ptr(base));
+		if (!start)
+			return nullptr;
+		for (offs_t offset = 1; offset <= 0xff; offset++)
+			if (space.get_read_ptr(base | offset) != start + offset)
+				return nullptr;
+		return start;
+	};
+
+	m_op_pages[page] = page_ptr(*m_opcodes);
+	m_arg_pages[page] = page_ptr(*m_program);
+	m_page_resolved[page] = true;
+}
+
 void nsc800_device::device_start()
 {
 	z80_device::device_start();
@@ -3706,7 +3779,8 @@ z80_device::z80_device(const machine_config &mconfig, device_type type, const ch
 	m_io_config("io", ENDIANNESS_LITTLE, 8, 16, 0),
 	m_irqack_cb(*this),
 	m_refresh_cb(*this),
-	m_halt_cb(*this)
+	m_halt_cb(*this),
+	m_refresh_enabled(false)
 {
 }
 
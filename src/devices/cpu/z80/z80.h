@@ -161,6 +161,7 @@ protected:
 	void push(PAIR &r);
 	void jp(void);
 	void jp_cond(bool cond);
+	void idle_branch();
 	void jr();
 	void jr_cond(bool cond, uint8_t opcode);
 	void call();
@@ -232,6 +233,11 @@ protected:
 	void take_interrupt();
 	void take_nmi();
 
+	void invalidate_pages();
+	void resolve_page(int page);
+	const uint8_t *op_page(uint16_t adr) { int const page = adr >> 8; if (!m_page_resolved[page]) resolve_page(page); return m_op_pages[page]; }
+	const uint8_t *arg_page(uint16_t adr) { int const page = adr >> 8; if (!m_page_resolved[page]) resolve_page(page); return m_arg_pages[page]; }
+
 	// address spaces
 	const address_space_config m_program_config;
 	const address_space_config m_opcodes_config;
@@ -244,6 +250,13 @@ protected:
 	devcb_write_line m_irqack_cb;
 	devcb_write8 m_refresh_cb;
 	devcb_write_line m_halt_cb;
+	bool m_refresh_enabled;
+
+	// host pointers for 256-byte pages of plain opcode/argument memory,
+	// looked up on first use and flushed when the address map or a bank changes
+	const uint8_t *m_op_pages[0x100];
+	const uint8_t *m_arg_pages[0x100];
+	bool m_page_resolved[0x100];
 
 	PAIR            m_prvpc;
 	PAIR            m_pc;
@@ -289,6 +289,9 @@ void floppy_image_device::set_rpm(float _rpm)
 
 void floppy_image_device::setup_write(floppy_image_format_t *_output_format)
 {
+	// the whole image gets rewritten in the new format
+	if(image)
+		image->load_all_tracks();
 	output_format = _output_format;
 	commit_image();
 }
@@ -298,6 +301,13 @@ void floppy_image_device::commit_image()
 	image_dirty = false;
 	if(!output_format || !output_format->supports_save())
 		return;
+
+	// tracks generated on demand can be written back in place, otherwise
+	// pull in the rest before the file gets truncated
+	if(image->write_back_tracks())
+		return;
+	image->load_all_tracks();
+
 	io_generic io;
 	// Do _not_ remove this cast otherwise the pointer will be incorrect when used by the ioprocs.
 	io.file = (device_image_interface *)this;
@@ -450,6 +460,7 @@ image_init_result floppy_image_device::call_load()
 	}
 
 	image = global_alloc(floppy_image(tracks, sides, form_factor));
+	image->enable_deferred_loading();
 	if (!best_format->load(&io, form_factor, image))
 	{
 		seterror(IMAGE_ERROR_UNSUPPORTED, "Incompatible image format or corrupted data");
@@ -824,6 +835,7 @@ void floppy_image_device::write_flux(const attotime &start, const attotime &end,
 		trans_pos[i] = find_position(base, transitions[i]);
 
 	std::vector<uint32_t> &buf = image->get_buffer(cyl, ss, subcyl);
+	image->mark_track_dirty(cyl, ss, subcyl);
 
 	int index;
 	if(!buf.empty())
@@ -970,6 +982,8 @@ void floppy_image_device::set_write_splice(const attotime &when)
 		image_dirty = true;
 		attotime base;
 		int splice_pos = find_position(base, when);
+		image->get_buffer(cyl, ss, subcyl);
+		image->mark_track_dirty(cyl, ss, subcyl);
 		image->set_write_splice_position(cyl, ss, splice_pos, subcyl);
 	}
 }
@@ -1118,8 +1132,9 @@ void floppy_sound_device::device_start()
 	m_spin_samplepos = m_step_samplepos = m_seek_samplepos = 0;
 	m_spin_playback_sample = m_step_playback_sample = QUIET;
 
-	// Read audio samples. The samples are stored in the list m_samples.
-	m_loaded = load_samples();
+	// Read audio samples. The samples are stored in the list m_samples,
+	// decoded up front since the stream update reads them directly.
+	m_loaded = load_samples(true);
 
 	// If we don't have all samples, don't allocate a stream or access sample data.
 	if (m_loaded)
@@ -53,6 +53,7 @@ harddisk_image_device::harddisk_image_device(const machine_config &mconfig, devi
 		device_image_interface(mconfig, *this),
 		m_chd(nullptr),
 		m_hard_disk_handle(nullptr),
+		m_flush_timer(nullptr),
 		m_device_image_load(device_image_load_delegate()),
 		m_device_image_unload(device_image_func_delegate()),
 		m_interface(nullptr)
@@ -101,6 +102,12 @@ void harddisk_image_device::device_start()
 	{
 		m_hard_disk_handle = nullptr;
 	}
+
+	// cached writes go out every second in the background, and all of them before a save state
+	m_flush_timer = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(harddisk_image_device::flush_timer), this));
+	m_flush_timer->adjust(attotime::from_seconds(1), 0, attotime::from_seconds(1));
+	machine().save().register_presave(save_prepost_delegate(FUNC(harddisk_image_device::flush_cache), this));
+	setup_write_cache();
 }
 
 void harddisk_image_device::device_stop()
@@ -267,7 +274,10 @@ image_init_result harddisk_image_device::internal_load_hd()
 		/* open the hard disk file */
 		m_hard_disk_handle = hard_disk_open(m_chd);
 		if (m_hard_disk_handle != nullptr)
+		{
+			setup_write_cache();
 			return image_init_result::PASS;
+		}
 	}
 
 	/* if we had an error, close out the CHD */
@@ -294,3 +304,36 @@ chd_file *harddisk_image_device::get_chd_file()
 		result = hard_disk_get_chd(hd_file);
 	return result;
 }
+
+/*-------------------------------------------------
+    setup_write_cache - hold writes in memory as
+    the options ask
+-------------------------------------------------*/
+
+void harddisk_image_device::setup_write_cache()
+{
+	if (m_hard_disk_handle != nullptr)
+		hard_disk_set_write_cache(m_hard_disk_handle, std::max(machine().options().hd_write_cache(), 0) * 1024 * 1024);
+}
+
+/*-------------------------------------------------
+    flush_cache - write all cached sectors out
+    before a save state
+-------------------------------------------------*/
+
+void harddisk_image_device::flush_cache()
+{
+	if (m_hard_disk_handle != nullptr && !hard_disk_flush(m_hard_disk_handle))
+		logerror("Error writing cached sectors to the CHD\n");
+}
+
+/*-------------------------------------------------
+    flush_timer - start writing cached sectors
+    out in the background
+-------------------------------------------------*/
+
+TIMER_CALLBACK_MEMBER(harddisk_image_device::flush_timer)
+{
+	if (m_hard_disk_handle != nullptr && !hard_disk_flush(m_hard_disk_handle, false))
+		logerror("Error writing cached sectors to the CHD\n");
+}
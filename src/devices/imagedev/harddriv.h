@@ -62,11 +62,15 @@ protected:
 	virtual void device_stop() override;
 
 	image_init_result internal_load_hd();
+	void setup_write_cache();
+	void flush_cache();
+	TIMER_CALLBACK_MEMBER(flush_timer);
 
 	chd_file        *m_chd;
 	chd_file        m_origchd;              /* handle to the original CHD */
 	chd_file        m_diffchd;              /* handle to the diff CHD */
 	hard_disk_file  *m_hard_disk_handle;
+	emu_timer       *m_flush_timer;         /* writes cached sectors out in the background */
 
 	device_image_load_delegate      m_device_image_load;
 	device_image_func_delegate      m_device_image_unload;
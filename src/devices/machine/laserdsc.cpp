@@ -73,6 +73,8 @@ laserdisc_device::laserdisc_device(const machine_config &mconfig, device_type ty
 		m_readresult(CHDERR_NONE),
 		m_chdtracks(0),
 		m_work_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO)),
+		m_prefetch_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO)),
+		m_prefetch_filling(-1),
 		m_audiosquelch(0),
 		m_videosquelch(0),
 		m_fieldnum(0),
@@ -109,6 +111,7 @@ laserdisc_device::laserdisc_device(const machine_config &mconfig, device_type ty
 laserdisc_device::~laserdisc_device()
 {
 	osd_work_queue_free(m_work_queue);
+	osd_work_queue_free(m_prefetch_queue);
 }
 
 
@@ -240,7 +243,10 @@ void laserdisc_device::device_stop()
 {
 	// make sure all async operations have completed
 	if (m_disc != nullptr)
+	{
 		osd_work_queue_wait(m_work_queue, osd_ticks_per_second() * 10);
+		osd_work_queue_wait(m_prefetch_queue, osd_ticks_per_second() * 10);
+	}
 
 	// free any textures and palettes
 	if (m_videotex != nullptr)
@@ -985,9 +991,88 @@ void laserdisc_device::read_track_data()
 //-------------------------------------------------
 
 void *laserdisc_device::read_async_static(void *param, int threadid)
+{
+	reinterpret_cast<laserdisc_device *>(param)->read_async();
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  read_async - read the queued hunk, from the
+//  prefetched fields if they have it, and keep
+//  the next run decoding ahead of it
+//-------------------------------------------------
+
+void laserdisc_device::read_async()
+{
+	// look for the hunk in a batch that isn't being refilled
+	int batchnum = -1;
+	{
+		std::lock_guard<std::mutex> lock(m_prefetch_lock);
+		for (int index = 0; index < ARRAY_LENGTH(m_prefetch); index++)
+			if (index != m_prefetch_filling && m_queued_hunknum - m_prefetch[index].m_first < m_prefetch[index].m_count)
+				batchnum = index;
+	}
+
+	// copy it out if so, otherwise decode it directly
+	uint32_t nexthunk = m_queued_hunknum + 1;
+	if (batchnum != -1)
+	{
+		prefetch_batch &batch = m_prefetch[batchnum];
+		uint32_t const hunkbytes = m_disc->hunk_bytes();
+		const uint8_t *raw = &batch.m_data[(m_queued_hunknum - batch.m_first) * hunkbytes];
+		m_readresult = (avhuff_decoder::copy_raw_data(raw, hunkbytes, m_avhuff_config) == AVHERR_NONE) ? CHDERR_NONE : CHDERR_DECOMPRESSION_ERROR;
+		nexthunk = batch.m_first + batch.m_count;
+	}
+	else
+		m_readresult = m_disc->read_hunk(m_queued_hunknum, nullptr);
+
+	// start on whatever follows unless the other batch already has it
+	int const other = (batchnum == -1) ? 0 : (batchnum ^ 1);
+	std::lock_guard<std::mutex> lock(m_prefetch_lock);
+	if (m_prefetch_filling == -1 && (m_prefetch[other].m_count == 0 || m_prefetch[other].m_first != nexthunk))
+		start_prefetch(nexthunk, other);
+}
+
+
+//-------------------------------------------------
+//  start_prefetch - begin decoding a run of
+//  fields into a batch; called with the prefetch
+//  lock held
+//-------------------------------------------------
+
+void laserdisc_device::start_prefetch(uint32_t hunknum, int batchnum)
+{
+	// prefetching needs its own decoders, which only compressed discs have
+	if (!m_disc->compressed() || hunknum >= m_disc->hunk_count())
+		return;
+
+	prefetch_batch &batch = m_prefetch[batchnum];
+	batch.m_first = hunknum;
+	batch.m_count = 0;
+	m_prefetch_filling = batchnum;
+	osd_work_item_queue(m_prefetch_queue, prefetch_async_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  prefetch_async_static - work item callback
+//  that decodes a batch on all processors
+//-------------------------------------------------
+
+void *laserdisc_device::prefetch_async_static(void *param, int threadid)
 {
 	laserdisc_device &ld = *reinterpret_cast<laserdisc_device *>(param);
-	ld.m_readresult = ld.m_disc->read_hunk(ld.m_queued_hunknum, nullptr);
+	prefetch_batch &batch = ld.m_prefetch[ld.m_prefetch_filling];
+
+	// the decoders read_hunks uses aren't configured, so they produce raw data
+	uint32_t const count = (std::min<uint32_t>)(PREFETCH_FIELDS, ld.m_disc->hunk_count() - batch.m_first);
+	batch.m_data.resize(PREFETCH_FIELDS * ld.m_disc->hunk_bytes());
+	chd_error err = ld.m_disc->read_hunks(batch.m_first, count, &batch.m_data[0]);
+
+	std::lock_guard<std::mutex> lock(ld.m_prefetch_lock);
+	batch.m_count = (err == CHDERR_NONE) ? count : 0;
+	ld.m_prefetch_filling = -1;
 	return nullptr;
 }
 
@@ -18,6 +18,8 @@
 #include "vbiparse.h"
 #include "avhuff.h"
 
+#include <mutex>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -315,6 +317,18 @@ private:
 		int32_t               m_lastfield;            // last absolute field number
 	};
 
+	// a run of fields decoded ahead of the playhead, in raw avhuff form
+	struct prefetch_batch
+	{
+		prefetch_batch() : m_first(0), m_count(0) { }
+
+		std::vector<uint8_t>  m_data;                 // raw data for each field
+		uint32_t              m_first;                // first hunk in the run
+		uint32_t              m_count;                // number of valid hunks
+	};
+
+	static constexpr uint32_t PREFETCH_FIELDS = 8;
+
 	// internal helpers
 	void init_disc();
 	void init_video();
@@ -326,6 +340,9 @@ private:
 	frame_data &current_frame();
 	void read_track_data();
 	static void *read_async_static(void *param, int threadid);
+	void read_async();
+	void start_prefetch(uint32_t hunknum, int batchnum);
+	static void *prefetch_async_static(void *param, int threadid);
 	void process_track_data();
 	void config_load(config_type cfg_type, util::xml::data_node const *parentnode);
 	void config_save(config_type cfg_type, util::xml::data_node *parentnode);
@@ -354,6 +371,10 @@ private:
 	// async operations
 	osd_work_queue *    m_work_queue;           // work queue
 	uint32_t              m_queued_hunknum;       // queued hunk
+	osd_work_queue *    m_prefetch_queue;       // work queue for decoding ahead
+	std::mutex          m_prefetch_lock;        // guards the prefetch batch bounds
+	prefetch_batch      m_prefetch[2];          // one batch being read from, one being filled
+	int                 m_prefetch_filling;     // index of the batch being filled, or -1
 
 	// core states
 	uint8_t               m_audiosquelch;         // audio squelch state: bit 0 = audio 1, bit 1 = audio 2
@@ -18,9 +18,12 @@
 #include "netlist/devices/net_lib.h"
 
 #include "netlist/plib/palloc.h"
+#include "netlist/plib/pdynlib.h"
 
 #include "debugger.h"
+#include "debug/debugcon.h"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <string>
@@ -45,6 +48,9 @@ DEFINE_DEVICE_TYPE(NETLIST_ANALOG_OUTPUT, netlist_mame_analog_output_device, "nl
 DEFINE_DEVICE_TYPE(NETLIST_STREAM_OUTPUT, netlist_mame_stream_output_device, "nl_stream_out", "Netlist Stream Output")
 
 
+// solvers compiled in from netlist/generated/static_solvers.cpp
+extern const plib::dynlib_static_sym nl_static_solver_syms[];
+
 // ----------------------------------------------------------------------------------------
 // Special netlist extension devices  ....
 // ----------------------------------------------------------------------------------------
@@ -443,8 +449,7 @@ void netlist_mame_analog_input_device::write(const double val)
 {
 	if (is_sound_device())
 	{
-		update_to_current_time();
-		m_param->setTo(val * m_mult + m_offset);
+		queue_input(val * m_mult + m_offset, (*m_param)());
 	}
 	else
 	{
@@ -453,34 +458,49 @@ void netlist_mame_analog_input_device::write(const double val)
 	}
 }
 
+void netlist_mame_analog_input_device::apply_queued(double value)
+{
+	m_param->setTo(value);
+}
+
 void netlist_mame_int_input_device::write(const uint32_t val)
 {
 	const uint32_t v = (val >> m_shift) & m_mask;
-	if (v != (*m_param)())
+	if (is_sound_device())
+		queue_input(v, (*m_param)());
+	else if (v != (*m_param)())
 		synchronize(0, v);
 }
 
 void netlist_mame_logic_input_device::write(const uint32_t val)
 {
 	const uint32_t v = (val >> m_shift) & 1;
-	if (v != (*m_param)())
+	if (is_sound_device())
+		queue_input(v, (*m_param)());
+	else if (v != (*m_param)())
 		synchronize(0, v);
 }
 
 void netlist_mame_int_input_device::device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr)
 {
-	if (is_sound_device())
-		update_to_current_time();
 	m_param->setTo(param);
 }
 
 void netlist_mame_logic_input_device::device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr)
 {
-	if (is_sound_device())
-		update_to_current_time();
 	m_param->setTo(param);
 }
 
+void netlist_mame_int_input_device::apply_queued(double value)
+{
+	m_param->setTo(int(value));
+}
+
+void netlist_mame_logic_input_device::apply_queued(double value)
+{
+	m_param->setTo(value != 0.0);
+}
+
 void netlist_mame_ram_pointer_device::device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr)
 {
 	m_data = (*m_param)();
@@ -831,6 +851,7 @@ void netlist_mame_device::device_start()
 	//printf("clock is %d\n", clock());
 
 	m_netlist = global_alloc(netlist_mame_t(*this, "netlist"));
+	m_netlist->set_static_solver_lib(nl_static_solver_syms);
 
 	// register additional devices
 
@@ -874,9 +895,69 @@ void netlist_mame_device::device_start()
 	m_old = netlist::netlist_time::zero();
 	m_rem = netlist::netlist_time::zero();
 
+	/* one command serves all netlists; the first one registers it */
+	if (machine().debug_flags & DEBUG_FLAG_ENABLED)
+	{
+		netlist_mame_device *first = nullptr;
+		for (device_t &d : device_iterator(machine().root_device()))
+			if ((first = dynamic_cast<netlist_mame_device *>(&d)) != nullptr)
+				break;
+		if (first == this)
+		{
+			using namespace std::placeholders;
+			machine().debugger().console().register_command("nlstats", CMDFLAG_NONE, 0, 0, 2, std::bind(&netlist_mame_device::debug_stats, this, _1, _2));
+		}
+	}
+
 	LOGDEVCALLS("device_start exit\n");
 }
 
+netlist::netlist_stats_t netlist_mame_device::stats() const
+{
+	return m_netlist->stats();
+}
+
+void netlist_mame_device::reset_stats()
+{
+	m_netlist->reset_stats();
+}
+
+//-------------------------------------------------
+//  debug_stats - "nlstats [<tag>[,reset]]": show
+//  the statistics of one or all netlists, then
+//  optionally reset them
+//-------------------------------------------------
+
+void netlist_mame_device::debug_stats(int ref, const std::vector<std::string> &params)
+{
+	debugger_console &con = machine().debugger().console();
+	bool const reset = (params.size() > 1 && params[1] == "reset");
+	bool found = false;
+
+	for (device_t &d : device_iterator(machine().root_device()))
+	{
+		netlist_mame_device *nl = dynamic_cast<netlist_mame_device *>(&d);
+		if (nl == nullptr || (!params.empty() && params[0] != d.tag() && params[0] != d.basetag()))
+			continue;
+		found = true;
+
+		netlist::netlist_stats_t const s = nl->stats();
+		con.printf("%s: %.6f s emulated, %.6f s host\n", d.tag(), nl->netlist().time().as_double(), s.host_time);
+		con.printf("  queue pushes %u, pops %u, net updates %u, device updates %u\n",
+				s.queue_pushes, s.queue_pops, s.net_updates, s.device_updates);
+		for (auto &ms : s.solvers)
+			con.printf("  %s: %u nets, %u calls, %u solves, %u NR loops (%u fails), %u iterations (%u fails, %u stagnated), %u time step changes, %.6f s\n",
+					ms.name.c_str(), ms.nets, ms.calls, ms.calculations,
+					ms.newton_raphson, ms.nr_fails, ms.iterative_total,
+					ms.iterative_fail, ms.iterative_stagnated, ms.timestep_changes, ms.host_time);
+		if (reset)
+			nl->reset_stats();
+	}
+
+	if (!found && !params.empty())
+		con.printf("No netlist device %s\n", params[0].c_str());
+}
+
 void netlist_mame_device::device_clock_changed()
 {
 	m_div = netlist::netlist_time::from_hz(clock());
@@ -1146,6 +1227,36 @@ void netlist_mame_sound_device::device_start()
 
 }
 
+void netlist_mame_sound_device::device_pre_save()
+{
+	// anything still queued would be lost with the state, so bring the netlist up to now first
+	m_stream->update();
+	for (auto &e : m_input_queue)
+		e.input->apply_queued(e.value);
+	m_input_queue.clear();
+
+	netlist_mame_device::device_pre_save();
+}
+
+void netlist_mame_sound_device::queue_input(netlist_mame_sub_interface &input, double value, double current)
+{
+	// a write only matters if it changes what the input will be once the queue is drained
+	for (auto it = m_input_queue.rbegin(); it != m_input_queue.rend(); ++it)
+		if (it->input == &input)
+		{
+			current = it->value;
+			break;
+		}
+	if (value == current)
+		return;
+
+	// CPUs can run ahead of each other, so keep the queue sorted rather than appending
+	const attotime time = machine().time();
+	auto pos = std::upper_bound(m_input_queue.begin(), m_input_queue.end(), time,
+			[] (const attotime &t, const input_event &e) { return t < e.time; });
+	m_input_queue.insert(pos, input_event{ time, &input, value });
+}
+
 void netlist_mame_sound_device::nl_register_devices()
 {
 	setup().factory().register_device<nld_sound_out>("NETDEV_SOUND_OUT", "nld_sound_out", "+CHAN");
@@ -1168,15 +1279,34 @@ void netlist_mame_sound_device::sound_stream_update(sound_stream &stream, stream
 		m_in->m_buffer[i] = inputs[i];
 	}
 
-	netlist::netlist_time cur(netlist().time());
+	const netlist::netlist_time start(netlist().time());
+	const netlist::netlist_time end(start + m_div * samples);
 
-	netlist().process_queue(m_div * samples);
+	// run the netlist in one go between queued input changes, applying each at its own time
+	if (!m_input_queue.empty())
+	{
+		const attotime stream_start = stream.sample_time();
+		auto e = m_input_queue.begin();
+		for ( ; e != m_input_queue.end(); ++e)
+		{
+			netlist::netlist_time t(start);
+			if (e->time > stream_start)
+				t += netlist::netlist_time::from_double((e->time - stream_start).as_double());
+			if (t > end)
+				break;
+			if (t > netlist().time())
+				netlist().process_queue(t - netlist().time());
+			e->input->apply_queued(e->value);
+		}
+		m_input_queue.erase(m_input_queue.begin(), e);
+	}
 
-	cur += (m_div * samples);
+	if (end > netlist().time())
+		netlist().process_queue(end - netlist().time());
 
 	for (int i=0; i < m_num_outputs; i++)
 	{
-		m_out[i]->sound_update(cur);
-		m_out[i]->buffer_reset(cur);
+		m_out[i]->sound_update(end);
+		m_out[i]->buffer_reset(end);
 	}
 }
@@ -12,9 +12,11 @@
 #define MAME_MACHINE_NETLIST_H
 
 #include "netlist/nl_time.h"
+#include "netlist/netlist_types.h"
 
 class nld_sound_out;
 class nld_sound_in;
+class netlist_mame_sub_interface;
 
 namespace netlist {
 	class setup_t;
@@ -115,6 +117,10 @@ public:
 
 	static void register_memregion_source(netlist::setup_t &setup, const char *name);
 
+	// runtime statistics, also shown by the "nlstats" debugger command
+	netlist::netlist_stats_t stats() const;
+	void reset_stats();
+
 	int m_icount;
 
 protected:
@@ -137,6 +143,7 @@ protected:
 
 private:
 	void save_state();
+	void debug_stats(int ref, const std::vector<std::string> &params);
 
 	/* timing support here - so sound can hijack it ... */
 	netlist::netlist_time        m_rem;
@@ -219,6 +226,8 @@ public:
 
 	inline sound_stream *get_stream() { return m_stream; }
 
+	// timestamp a change to one of our inputs, applied by the next stream update
+	void queue_input(netlist_mame_sub_interface &input, double value, double current);
 
 	// device_sound_interface overrides
 	virtual void sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples) override;
@@ -229,14 +238,23 @@ protected:
 
 	// device_t overrides
 	virtual void device_start() override;
+	virtual void device_pre_save() override;
 
 private:
+	struct input_event
+	{
+		attotime time;
+		netlist_mame_sub_interface *input;
+		double value;
+	};
+
 	static constexpr int MAX_OUT = 10;
 	nld_sound_out *m_out[MAX_OUT];
 	nld_sound_in *m_in;
 	sound_stream *m_stream;
 	int m_num_inputs;
 	int m_num_outputs;
+	std::vector<input_event> m_input_queue;   // input changes not yet reached by the stream, in time order
 
 };
 
@@ -262,11 +280,14 @@ public:
 
 	inline bool is_sound_device() const { return bool(m_sound); }
 
-	inline void update_to_current_time() { m_sound->get_stream()->update(); }
-
 	void set_mult_offset(const double mult, const double offset);
 
+	// apply a value queued by queue_input once the netlist reaches its time
+	virtual void apply_queued(double value) { }
+
 protected:
+	inline void queue_input(double value, double current) { m_sound->queue_input(*this, value, current); }
+
 	double m_offset;
 	double m_mult;
 
@@ -307,6 +328,9 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 
+	// netlist_mame_sub_interface overrides
+	virtual void apply_queued(double value) override;
+
 private:
 	netlist::param_double_t *m_param;
 	bool   m_auto_port;
@@ -401,6 +425,9 @@ protected:
 	virtual void device_start() override;
 	virtual void device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr) override;
 
+	// netlist_mame_sub_interface overrides
+	virtual void apply_queued(double value) override;
+
 private:
 	netlist::param_int_t *m_param;
 	uint32_t m_mask;
@@ -440,6 +467,9 @@ protected:
 	virtual void device_start() override;
 	virtual void device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr) override;
 
+	// netlist_mame_sub_interface overrides
+	virtual void apply_queued(double value) override;
+
 private:
 	netlist::param_logic_t *m_param;
 	uint32_t m_shift;
@@ -60,6 +60,72 @@ void AICADSP::init()
 	memset(this,0,sizeof(*this));
 	RBL=0x8000;
 	Stopped=1;
+	Dirty=1;
+}
+
+void AICADSP::compile()
+{
+	instruction decoded[128];
+	for(int step=0;step<LastStep;++step)
+	{
+		uint16_t *IPtr=MPRO+step*8;
+		instruction &op=decoded[step];
+
+		op.TRA=(IPtr[0]>>9)&0x7F;
+		op.TWT=(IPtr[0]>>8)&0x01;
+		op.TWA=(IPtr[0]>>1)&0x7F;
+
+		op.XSEL=(IPtr[2]>>15)&0x01;
+		op.YSEL=(IPtr[2]>>13)&0x03;
+		op.IRA=(IPtr[2]>>7)&0x3F;
+		op.IWT=(IPtr[2]>>6)&0x01;
+		op.IWA=(IPtr[2]>>1)&0x1F;
+
+		op.TABLE=(IPtr[4]>>15)&0x01;
+		op.MWT=(IPtr[4]>>14)&0x01;
+		op.MRD=(IPtr[4]>>13)&0x01;
+		op.EWT=(IPtr[4]>>12)&0x01;
+		op.EWA=(IPtr[4]>>8)&0x0F;
+		op.ADRL=(IPtr[4]>>7)&0x01;
+		op.FRCL=(IPtr[4]>>6)&0x01;
+		op.SHIFT=(IPtr[4]>>4)&0x03;
+		op.YRL=(IPtr[4]>>3)&0x01;
+		op.NEGB=(IPtr[4]>>2)&0x01;
+		op.ZERO=(IPtr[4]>>1)&0x01;
+		op.BSEL=(IPtr[4]>>0)&0x01;
+
+		op.NOFL=(IPtr[6]>>15)&1;        //????
+		op.COEF=step;
+
+		op.MASA=(IPtr[6]>>9)&0x1f;  //???
+		op.ADREB=(IPtr[6]>>8)&0x1;
+		op.NXADR=(IPtr[6]>>7)&0x1;
+
+		//memory only allowed on odd? DoA inserts NOPs on even
+		if(!(step&1))
+			op.MRD=op.MWT=false;
+	}
+
+	// Every step overwrites ACC, and one with an out of range IRA reuses the
+	// INPUTS of the step before; its other results only go where its flags
+	// say.  Working backwards, a step that writes nothing and whose ACC and
+	// INPUTS the next step ignores can't affect the output, so it's left out.
+	bool live[128];
+	bool acc_read=false,inputs_read=false;
+	for(int step=LastStep-1;step>=0;--step)
+	{
+		instruction const &op=decoded[step];
+		bool const uses_shifted=op.TWT || op.FRCL || op.MWT || op.EWT || (op.ADRL && op.SHIFT==3);
+		live[step]=acc_read || inputs_read || uses_shifted || op.IWT || op.YRL || op.ADRL || op.MRD;
+		acc_read=live[step] && (uses_shifted || (!op.ZERO && op.BSEL));
+		inputs_read=live[step] && op.IRA>0x31;
+	}
+
+	ProgramLength=0;
+	for(int step=0;step<LastStep;++step)
+		if(live[step])
+			Program[ProgramLength++]=decoded[step];
+	Dirty=0;
 }
 
 void AICADSP::step()
@@ -75,153 +141,83 @@ void AICADSP::step()
 	int32_t Y_REG=0;      //24 bit
 	uint32_t ADDR;
 	uint32_t ADRS_REG=0;  //13 bit
-	int step;
 
 	if(Stopped)
 		return;
 
+	if(Dirty)
+		compile();
+
 	memset(EFREG,0,2*16);
-#if 0
-	int dump=0;
-	FILE *f=nullptr;
-	if(dump)
-		f=fopen("dsp.txt","wt");
-#endif
-	for(step=0;step</*128*/LastStep;++step)
+	for(int i=0;i<ProgramLength;++i)
 	{
-		uint16_t *IPtr=MPRO+step*8;
-
-//      if(IPtr[0]==0 && IPtr[1]==0 && IPtr[2]==0 && IPtr[3]==0)
-//          break;
-
-		uint32_t TRA=(IPtr[0]>>9)&0x7F;
-		uint32_t TWT=(IPtr[0]>>8)&0x01;
-		uint32_t TWA=(IPtr[0]>>1)&0x7F;
-
-		uint32_t XSEL=(IPtr[2]>>15)&0x01;
-		uint32_t YSEL=(IPtr[2]>>13)&0x03;
-		uint32_t IRA=(IPtr[2]>>7)&0x3F;
-		uint32_t IWT=(IPtr[2]>>6)&0x01;
-		uint32_t IWA=(IPtr[2]>>1)&0x1F;
-
-		uint32_t TABLE=(IPtr[4]>>15)&0x01;
-		uint32_t MWT=(IPtr[4]>>14)&0x01;
-		uint32_t MRD=(IPtr[4]>>13)&0x01;
-		uint32_t EWT=(IPtr[4]>>12)&0x01;
-		uint32_t EWA=(IPtr[4]>>8)&0x0F;
-		uint32_t ADRL=(IPtr[4]>>7)&0x01;
-		uint32_t FRCL=(IPtr[4]>>6)&0x01;
-		uint32_t SHIFT=(IPtr[4]>>4)&0x03;
-		uint32_t YRL=(IPtr[4]>>3)&0x01;
-		uint32_t NEGB=(IPtr[4]>>2)&0x01;
-		uint32_t ZERO=(IPtr[4]>>1)&0x01;
-		uint32_t BSEL=(IPtr[4]>>0)&0x01;
-
-		uint32_t NOFL=(IPtr[6]>>15)&1;        //????
-		uint32_t COEF=step;
-
-		uint32_t MASA=(IPtr[6]>>9)&0x1f;  //???
-		uint32_t ADREB=(IPtr[6]>>8)&0x1;
-		uint32_t NXADR=(IPtr[6]>>7)&0x1;
-
+		instruction const &op=Program[i];
 		int64_t v;
 
 		//operations are done at 24 bit precision
-#if 0
-		if(MASA)
-			int a=1;
-		if(NOFL)
-			int a=1;
-
-//      int dump=0;
 
-		if(f)
-		{
-#define DUMP(v) fprintf(f," " #v ": %04X",v);
-
-			fprintf(f,"%d: ",step);
-			DUMP(ACC);
-			DUMP(SHIFTED);
-			DUMP(X);
-			DUMP(Y);
-			DUMP(B);
-			DUMP(INPUTS);
-			DUMP(MEMVAL);
-			DUMP(FRC_REG);
-			DUMP(Y_REG);
-			DUMP(ADDR);
-			DUMP(ADRS_REG);
-			fprintf(f,"\n");
-		}
-#endif
 		//INPUTS RW
-		assert(IRA<0x32);
-		if(IRA<=0x1f)
-			INPUTS=MEMS[IRA];
-		else if(IRA<=0x2F)
-			INPUTS=MIXS[IRA-0x20]<<4;  //MIXS is 20 bit
-		else if(IRA<=0x31)
-			INPUTS=EXTS[IRA-0x30]<<8;  //EXTS is 16 bit
+		assert(op.IRA<0x32);
+		if(op.IRA<=0x1f)
+			INPUTS=MEMS[op.IRA];
+		else if(op.IRA<=0x2F)
+			INPUTS=MIXS[op.IRA-0x20]<<4;  //MIXS is 20 bit
+		else if(op.IRA<=0x31)
+			INPUTS=EXTS[op.IRA-0x30]<<8;  //EXTS is 16 bit
 
 		INPUTS<<=8;
 		INPUTS>>=8;
-		//if(INPUTS&0x00800000)
-		//  INPUTS|=0xFF000000;
 
-		if(IWT)
+		if(op.IWT)
 		{
-			MEMS[IWA]=MEMVAL;  //MEMVAL was selected in previous MRD
-			if(IRA==IWA)
+			MEMS[op.IWA]=MEMVAL;  //MEMVAL was selected in previous MRD
+			if(op.IRA==op.IWA)
 				INPUTS=MEMVAL;
 		}
 
 		//Operand sel
 		//B
-		if(!ZERO)
+		if(!op.ZERO)
 		{
-			if(BSEL)
+			if(op.BSEL)
 				B=ACC;
 			else
 			{
-				B=TEMP[(TRA+DEC)&0x7F];
+				B=TEMP[(op.TRA+DEC)&0x7F];
 				B<<=8;
 				B>>=8;
-				//if(B&0x00800000)
-				//  B|=0xFF000000;  //Sign extend
 			}
-			if(NEGB)
+			if(op.NEGB)
 				B=0-B;
 		}
 		else
 			B=0;
 
 		//X
-		if(XSEL)
+		if(op.XSEL)
 			X=INPUTS;
 		else
 		{
-			X=TEMP[(TRA+DEC)&0x7F];
+			X=TEMP[(op.TRA+DEC)&0x7F];
 			X<<=8;
 			X>>=8;
-			//if(X&0x00800000)
-			//  X|=0xFF000000;
 		}
 
 		//Y
-		if(YSEL==0)
+		if(op.YSEL==0)
 			Y=FRC_REG;
-		else if(YSEL==1)
-			Y=this->COEF[COEF<<1]>>3;    //COEF is 16 bits
-		else if(YSEL==2)
+		else if(op.YSEL==1)
+			Y=COEF[op.COEF<<1]>>3;    //COEF is 16 bits
+		else if(op.YSEL==2)
 			Y=(Y_REG>>11)&0x1FFF;
-		else if(YSEL==3)
+		else if(op.YSEL==3)
 			Y=(Y_REG>>4)&0x0FFF;
 
-		if(YRL)
+		if(op.YRL)
 			Y_REG=INPUTS;
 
 		//Shifter
-		if(SHIFT==0)
+		if(op.SHIFT==0)
 		{
 			SHIFTED=ACC;
 			if(SHIFTED>0x007FFFFF)
@@ -229,7 +225,7 @@ void AICADSP::step()
 			if(SHIFTED<(-0x00800000))
 				SHIFTED=-0x00800000;
 		}
-		else if(SHIFT==1)
+		else if(op.SHIFT==1)
 		{
 			SHIFTED=ACC*2;
 			if(SHIFTED>0x007FFFFF)
@@ -237,95 +233,81 @@ void AICADSP::step()
 			if(SHIFTED<(-0x00800000))
 				SHIFTED=-0x00800000;
 		}
-		else if(SHIFT==2)
+		else if(op.SHIFT==2)
 		{
 			SHIFTED=ACC*2;
 			SHIFTED<<=8;
 			SHIFTED>>=8;
-			//SHIFTED&=0x00FFFFFF;
-			//if(SHIFTED&0x00800000)
-			//  SHIFTED|=0xFF000000;
 		}
-		else if(SHIFT==3)
+		else if(op.SHIFT==3)
 		{
 			SHIFTED=ACC;
 			SHIFTED<<=8;
 			SHIFTED>>=8;
-			//SHIFTED&=0x00FFFFFF;
-			//if(SHIFTED&0x00800000)
-			//  SHIFTED|=0xFF000000;
 		}
 
 		//ACCUM
 		Y<<=19;
 		Y>>=19;
-		//if(Y&0x1000)
-		//  Y|=0xFFFFF000;
 
 		v=(((int64_t) X*(int64_t) Y)>>12);
 		ACC=(int) v+B;
 
-		if(TWT)
-			TEMP[(TWA+DEC)&0x7F]=SHIFTED;
+		if(op.TWT)
+			TEMP[(op.TWA+DEC)&0x7F]=SHIFTED;
 
-		if(FRCL)
+		if(op.FRCL)
 		{
-			if(SHIFT==3)
+			if(op.SHIFT==3)
 				FRC_REG=SHIFTED&0x0FFF;
 			else
 				FRC_REG=(SHIFTED>>11)&0x1FFF;
 		}
 
-		if(MRD || MWT)
-		//if(0)
+		if(op.MRD || op.MWT)
 		{
-			ADDR=MADRS[MASA<<1];
-			if(!TABLE)
+			ADDR=MADRS[op.MASA<<1];
+			if(!op.TABLE)
 				ADDR+=DEC;
-			if(ADREB)
+			if(op.ADREB)
 				ADDR+=ADRS_REG&0x0FFF;
-			if(NXADR)
+			if(op.NXADR)
 				ADDR++;
-			if(!TABLE)
+			if(!op.TABLE)
 				ADDR&=RBL-1;
 			else
 				ADDR&=0xFFFF;
-			//ADDR<<=1;
-			//ADDR+=RBP<<13;
-			//MEMVAL=AICARAM[ADDR>>1];
 			ADDR+=RBP<<10;
-			if(MRD && (step&1)) //memory only allowed on odd? DoA inserts NOPs on even
+			if(op.MRD)
 			{
-				if(NOFL)
+				if(op.NOFL)
 					MEMVAL=AICARAM[ADDR]<<8;
 				else
 					MEMVAL=UNPACK(AICARAM[ADDR]);
 			}
-			if(MWT && (step&1))
+			if(op.MWT)
 			{
-				if(NOFL)
+				if(op.NOFL)
 					AICARAM[ADDR]=SHIFTED>>8;
 				else
 					AICARAM[ADDR]=PACK(SHIFTED);
 			}
 		}
 
-		if(ADRL)
+		if(op.ADRL)
 		{
-			if(SHIFT==3)
+			if(op.SHIFT==3)
 				ADRS_REG=(SHIFTED>>12)&0xFFF;
 			else
 				ADRS_REG=(INPUTS>>16);
 		}
 
-		if(EWT)
-			EFREG[EWA]+=SHIFTED>>8;
+		if(op.EWT)
+			EFREG[op.EWA]+=SHIFTED>>8;
 
 	}
 	--DEC;
 	memset(MIXS,0,4*16);
-//  if(f)
-//      fclose(f);
 }
 
 void AICADSP::setsample(int32_t sample,int SEL,int MXL)
@@ -348,4 +330,5 @@ void AICADSP::start()
 			break;
 	}
 	LastStep=i+1;
+	Dirty=1;
 }
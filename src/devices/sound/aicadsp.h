@@ -12,6 +12,7 @@ struct AICADSP
 	void setsample(int32_t sample, int32_t SEL, int32_t MXL);
 	void step();
 	void start();
+	void invalidate() { Dirty=1; }
 
 //Config
 	uint16_t *AICARAM;
@@ -37,6 +38,19 @@ struct AICADSP
 
 	int Stopped;
 	int LastStep;
+
+//program, decoded from MPRO so step() doesn't pick the fields apart every sample
+	struct instruction
+	{
+		uint8_t TRA,TWA,IRA,IWA,EWA,COEF,MASA,YSEL,SHIFT;
+		bool TWT,XSEL,IWT,TABLE,MWT,MRD,EWT,ADRL,FRCL,YRL,NEGB,ZERO,BSEL,NOFL,ADREB,NXADR;
+	};
+	instruction Program[128];
+	int ProgramLength;
+	int Dirty;    //MPRO or LastStep changed since the last compile()
+
+private:
+	void compile();
 };
 
 #endif // MAME_SOUND_AICADSP_H
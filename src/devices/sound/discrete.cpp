@@ -40,8 +40,11 @@
 
 #include "wavwrite.h"
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
+#include <map>
+#include <numeric>
 
 
 /* for_each collides with c++ standard libraries - include it here */
@@ -85,6 +88,17 @@ DEFINE_DEVICE_TYPE(DISCRETE, discrete_sound_device, "discrete", "Discrete Sound"
 
 #define USE_DISCRETE_TASKS          (1)
 
+/*
+ * Netlists without DISCRETE_TASK_START/END are split into tasks
+ * along their data dependencies: each independent chain of nodes
+ * becomes a task, chains too small to be worth one are bundled,
+ * and the outputs together with whatever mixes chains run in a
+ * final task.
+ */
+
+#define USE_DISCRETE_AUTO_TASKS     (1)
+#define MIN_NODES_PER_AUTO_TASK     (4)
+
 /*************************************
  *
  *  Internal classes
@@ -95,14 +109,16 @@ struct output_buffer
 {
 	double                      *node_buf;
 	const double                *source;
-	volatile double             *ptr;
+	double                      *ptr;
 	int                         node_num;
 };
 
 struct input_buffer
 {
-	volatile const double       *ptr;               /* pointer into linked_outbuf.nodebuf */
-	output_buffer *             linked_outbuf;      /* what output are we connected to ? */
+	const double                *ptr;               /* pointer into the producing task's output_buffer.node_buf */
+	const double                *node_buf;          /* start of that buffer */
+	const double                **input;            /* node input to redirect here */
+	const double                *source;            /* what that input pointed at before */
 	double                      buffer;             /* input[] will point here */
 };
 
@@ -113,12 +129,6 @@ public:
 	virtual ~discrete_task(void) { }
 
 	inline void step_nodes(void);
-	inline bool lock_threadid(int32_t threadid)
-	{
-		int expected = -1;
-		return m_threadid.compare_exchange_weak(expected, threadid, std::memory_order_release,std::memory_order_relaxed);
-	}
-	inline void unlock(void) { m_threadid = -1; }
 
 	//const linked_list_entry *list;
 	node_step_list_t        step_list;
@@ -130,16 +140,20 @@ public:
 
 
 	discrete_task(discrete_device &pdev)
-	: task_group(0), m_device(pdev), m_threadid(-1), m_samples(0)
+	: task_group(0), m_device(pdev), m_producers(0),
+		m_samples(0), m_slice(0), m_slices(0), m_allocated_slices(0),
+		m_ready_time(0), m_run_time(0), m_wait_time(0), m_slices_run(0)
 {
 		source_list.clear();
 		step_list.clear();
 		m_buffers.clear();
+		m_consumers.clear();
 	}
 
 protected:
 	static void *task_callback(void *param, int threadid);
-	inline bool process(void);
+	void process(void);
+	inline void release(int slice);
 
 	void check(discrete_task *dest_task);
 	void prepare_for_queue(int samples);
@@ -147,10 +161,22 @@ protected:
 	vector_t<output_buffer>      m_buffers;
 	discrete_device &                   m_device;
 
-private:
-	std::atomic<int32_t>      m_threadid;
-	volatile int            m_samples;
+	/* tasks reading our buffers, and the number of tasks whose buffers we read */
+	vector_t<discrete_task *>   m_consumers;
+	int                     m_producers;
 
+private:
+	int                     m_samples;
+	int                     m_slice;            /* next slice to step */
+	int                     m_slices;
+	std::unique_ptr<std::atomic<int>[]> m_pending;  /* per slice: producers still to finish it, plus our own previous slice */
+	int                     m_allocated_slices;
+
+	/* profiling */
+	osd_ticks_t             m_ready_time;
+	osd_ticks_t             m_run_time;
+	osd_ticks_t             m_wait_time;
+	int                     m_slices_run;
 };
 
 
@@ -218,58 +244,80 @@ inline void discrete_task::step_nodes(void)
 
 void *discrete_task::task_callback(void *param, int threadid)
 {
-	task_list_t *list = (task_list_t *) param;
-	do
-	{
-		for_each(discrete_task **, task, list)
-		{
-			/* try to lock */
-			if ((*task)->lock_threadid(threadid))
-			{
-				if (!(*task)->process())
-					return nullptr;
-				(*task)->unlock();
-			}
-		}
-	} while (1);
-
+	((discrete_task *) param)->process();
 	return nullptr;
 }
 
-bool discrete_task::process(void)
-{
-	int samples = std::min(int(m_samples), MAX_SAMPLES_PER_TASK_SLICE);
+/*
+ * A task steps its samples in slices.  Each slice waits on the
+ * tasks whose buffers it reads and on the task's own previous slice;
+ * whoever finishes the last of these queues it, so no worker ever
+ * spins on a task that isn't ready.
+ */
 
-	/* check dependencies */
-	for_each(input_buffer *, sn, &source_list)
+void discrete_task::process(void)
+{
+	osd_ticks_t start = 0;
+	if (UNEXPECTED(m_device.profiling()))
 	{
-		int avail;
-
-		avail = sn->linked_outbuf->ptr - sn->ptr;
-		assert_always(avail >= 0, "task_callback: available samples are negative");
-		if (avail < samples)
-			samples = avail;
+		start = get_profile_ticks();
+		m_wait_time += start - m_ready_time;
 	}
 
-	m_samples -= samples;
-	assert_always(m_samples >=0, "task_callback: task_samples got negative");
-	while (samples > 0)
+	for (;;)
 	{
-		/* step */
-		step_nodes();
-		samples--;
+		int const slice = m_slice++;
+		int samples = std::min(m_samples - slice * MAX_SAMPLES_PER_TASK_SLICE, MAX_SAMPLES_PER_TASK_SLICE);
+		while (samples > 0)
+		{
+			/* step */
+			step_nodes();
+			samples--;
+		}
+
+		/* hand the slice on to the tasks reading it */
+		for_each(discrete_task **, consumer, &m_consumers)
+			(*consumer)->release(slice);
+
+		if (UNEXPECTED(m_device.profiling()))
+		{
+			osd_ticks_t const now = get_profile_ticks();
+			m_run_time += now - start;
+			m_slices_run++;
+			start = now;
+		}
+
+		/* carry straight on if our producers are already through the next slice; otherwise the last of them queues it */
+		if (m_slice >= m_slices || m_pending[m_slice].fetch_sub(1, std::memory_order_acq_rel) != 1)
+			break;
 	}
-	if (m_samples == 0)
+}
+
+inline void discrete_task::release(int slice)
+{
+	if (m_pending[slice].fetch_sub(1, std::memory_order_acq_rel) == 1)
 	{
-		/* return and keep the task locked so it is not picked up by other worker threads */
-		return false;
+		if (UNEXPECTED(m_device.profiling()))
+			m_ready_time = get_profile_ticks();
+		osd_work_item_queue(m_device.m_queue, task_callback, (void *) this, WORK_ITEM_FLAG_AUTO_RELEASE);
 	}
-	return true;
 }
 
 void discrete_task::prepare_for_queue(int samples)
 {
 	m_samples = samples;
+	m_slice = 0;
+	m_slices = (samples + MAX_SAMPLES_PER_TASK_SLICE - 1) / MAX_SAMPLES_PER_TASK_SLICE;
+
+	/* set up the dependency counts */
+	if (m_slices > m_allocated_slices)
+	{
+		m_pending = std::make_unique<std::atomic<int>[]>(m_slices);
+		m_allocated_slices = m_slices;
+	}
+	for (int slice = 0; slice < m_slices; slice++)
+		m_pending[slice].store(m_producers + (slice ? 1 : 0), std::memory_order_relaxed);
+
 	/* set up task buffers */
 	for_each(output_buffer *, ob, &m_buffers)
 		ob->ptr = ob->node_buf;
@@ -277,7 +325,7 @@ void discrete_task::prepare_for_queue(int samples)
 	/* initialize sources */
 	for_each(input_buffer *, sn, &source_list)
 	{
-		sn->ptr = sn->linked_outbuf->node_buf;
+		sn->ptr = sn->node_buf;
 	}
 }
 
@@ -333,18 +381,27 @@ void discrete_task::check(discrete_task *dest_task)
 						}
 						m_device.discrete_log("dso_task_start - buffering %d(%d) in task %p group %d referenced by %d group %d", NODE_INDEX(inputnode_num), NODE_CHILD_NODE_NUM(inputnode_num), this, task_group, dest_node->index(), dest_task->task_group);
 
-						/* register into source list */
+						/* register into source list; link_tasks points the input at it once the list stops growing */
 						//source = auto_alloc(device->machine(), discrete_source_node);
 						//source.task = this;
 						//source.output_node = i;
-						source.linked_outbuf = pbuf;
+						source.node_buf = pbuf->node_buf;
+						source.input = &dest_node->m_input[inputnum];
+						source.source = dest_node->m_input[inputnum];
 						source.buffer = 0.0; /* please compiler */
 						source.ptr = nullptr;
 						dest_task->source_list.add(source);
 
-						/* point the input to a buffered location */
-						dest_node->m_input[inputnum] = &dest_task->source_list[dest_task->source_list.count()-1].buffer; // was copied!   &source.buffer;
-
+						/* dest_task now waits on us */
+						bool known = false;
+						for_each(discrete_task **, consumer, &m_consumers)
+							if (*consumer == dest_task)
+								known = true;
+						if (!known)
+						{
+							m_consumers.add(dest_task);
+							dest_task->m_producers++;
+						}
 					}
 				}
 			}
@@ -455,11 +512,18 @@ void discrete_base_node::resolve_input_nodes(void)
 
 const double *discrete_device::node_output_ptr(int onode)
 {
-	const discrete_base_node *node;
+	discrete_base_node *node;
 	node = discrete_find_node(onode);
 
 	if (node != nullptr)
 	{
+		/* a dependency the input lists don't show - remember it for partitioning */
+		if (m_resetting_node != nullptr && m_resetting_node != node)
+		{
+			auto const link = std::make_pair(m_resetting_node, node);
+			if (std::find(m_hidden_links.begin(), m_hidden_links.end(), link) == m_hidden_links.end())
+				m_hidden_links.push_back(link);
+		}
 		return &(node->m_output[NODE_CHILD_NODE_NUM(onode)]);
 	}
 	else
@@ -654,20 +718,23 @@ void discrete_device::display_profiling(void)
 	util::stream_format(std::cout, "Total Samples  : %16d\n", m_total_samples);
 	tresh = total / count;
 	util::stream_format(std::cout, "Threshold (mean): %16d\n", tresh / m_total_samples );
-	for_each(discrete_base_node **, node, &m_node_list)
-	{
-		discrete_step_interface *step;
-		if ((*node)->interface(step))
-			if (step->run_time > tresh)
-				util::stream_format(std::cout, "%3d: %20s %8.2f %10.2f\n", (*node)->index(), (*node)->module_name(), double(step->run_time) / double(total) * 100.0, double(step->run_time) / double(m_total_samples));
-	}
 
-	/* Task information */
+	/* Task information, followed by the nodes above the threshold (or all nodes with DISCRETE_PROFILING=2) */
 	for_each(discrete_task **, task, &task_list)
 	{
 		tt =  step_list_run_time((*task)->step_list);
 
-		util::stream_format(std::cout, "Task(%d): %8.2f %15.2f\n", (*task)->task_group, tt / double(total) * 100.0, tt / double(m_total_samples));
+		util::stream_format(std::cout, "Task(%d): %8.2f %15.2f  nodes %3d  depends on %d  slices %8d  waited %10.2f/slice  ran %10.2f/slice\n",
+				(*task)->task_group, tt / double(total) * 100.0, tt / double(m_total_samples),
+				(*task)->step_list.count(), (*task)->m_producers, (*task)->m_slices_run,
+				double((*task)->m_wait_time) / double(std::max((*task)->m_slices_run, 1)),
+				double((*task)->m_run_time) / double(std::max((*task)->m_slices_run, 1)));
+
+		for_each(discrete_step_interface **, step, &(*task)->step_list)
+			if (m_profiling > 1 || (*step)->run_time > tresh)
+				util::stream_format(std::cout, "%3d: %20s %8.2f %10.2f %8.2f\n", (*step)->self->index(), (*step)->self->module_name(),
+						double((*step)->run_time) / double(total) * 100.0, double((*step)->run_time) / double(m_total_samples),
+						double((*step)->run_time) / std::max(tt, 1.0) * 100.0);
 	}
 
 	util::stream_format(std::cout, "Average samples/double->update: %8.2f\n", double(m_total_samples) / double(m_total_stream_updates));
@@ -793,10 +860,183 @@ void discrete_device::init_nodes(const sound_block_list_t &block_list)
 
 	if (!has_tasks)
 	{
+		/* let device_start work out the tasks from the node graph */
+		m_auto_tasks = USE_DISCRETE_TASKS && USE_DISCRETE_AUTO_TASKS;
 	}
 }
 
 
+/*************************************
+ *
+ *  Automatic task partitioning
+ *
+ *************************************/
+
+void discrete_device::partition_tasks(void)
+{
+	int const count = m_node_list.count();
+	std::map<const discrete_base_node *, int> position;
+	for (int i = 0; i < count; i++)
+		position[m_node_list[i]] = i;
+
+	/* links between stepping nodes; feedback and lookups through custom data force both ends into one task */
+	struct task_link { int consumer, producer; bool tied; };
+	std::vector<task_link> links;
+	std::vector<bool> steps(count, false);
+	for (int i = 0; i < count; i++)
+	{
+		discrete_step_interface *step;
+		steps[i] = m_node_list[i]->interface(step);
+	}
+	auto const add_link = [&] (const discrete_base_node *consumer, const discrete_base_node *producer, bool hidden)
+	{
+		auto const c = position.find(consumer), p = position.find(producer);
+		if (c != position.end() && p != position.end() && steps[c->second] && steps[p->second] && c->second != p->second)
+			links.push_back(task_link{ c->second, p->second, hidden || p->second > c->second });
+	};
+	for (int i = 0; i < count; i++)
+	{
+		discrete_base_node *node = m_node_list[i];
+		for (int inputnum = 0; inputnum < node->active_inputs(); inputnum++)
+			if IS_VALUE_A_NODE(node->input_node(inputnum))
+				add_link(node, discrete_find_node(node->input_node(inputnum)), false);
+	}
+	for (auto const &link : m_hidden_links)
+		add_link(link.first, link.second, true);
+
+	/* chains are union-find sets; outputs and nodes mixing two chains go to the final task */
+	std::vector<int> parent(count);
+	std::iota(parent.begin(), parent.end(), 0);
+	std::vector<bool> final(count, false);
+	auto const root = [&parent] (int n) { while (parent[n] != n) n = parent[n] = parent[parent[n]]; return n; };
+
+	for (int i = 0; i < count; i++)
+	{
+		if (!steps[i])
+			continue;
+
+		discrete_sound_output_interface *output;
+		bool mixes = m_node_list[i]->interface(output);
+		int chain = -1;
+		for (task_link const &link : links)
+			if (link.consumer == i && !link.tied)
+			{
+				if (final[link.producer] || (chain >= 0 && chain != root(link.producer)))
+					mixes = true;
+				else
+					chain = root(link.producer);
+			}
+		if (mixes)
+			final[i] = true;
+		else if (chain >= 0)
+			parent[root(i)] = chain;
+	}
+
+	/* settle the tied links, and anything reading the final task joins it */
+	for (bool changed = true; changed; )
+	{
+		changed = false;
+		for (task_link const &link : links)
+		{
+			if (link.tied && final[link.consumer] != final[link.producer])
+			{
+				final[link.consumer] = true;
+				final[link.producer] = true;
+				changed = true;
+			}
+			else if (link.tied && !final[link.consumer] && root(link.consumer) != root(link.producer))
+			{
+				parent[root(link.consumer)] = root(link.producer);
+				changed = true;
+			}
+			else if (!link.tied && final[link.producer] && !final[link.consumer])
+			{
+				final[link.consumer] = true;
+				changed = true;
+			}
+		}
+	}
+
+	/* one task per chain, bundling small ones, in netlist order */
+	std::vector<int> chain_size(count, 0);
+	for (int i = 0; i < count; i++)
+		if (steps[i] && !final[i])
+			chain_size[root(i)]++;
+
+	std::map<int, int> chain_task;
+	std::vector<int> task_of(count, -1);
+	int chain_tasks = 0;
+	int open_size = MIN_NODES_PER_AUTO_TASK;
+	bool has_final = false;
+	for (int i = 0; i < count; i++)
+	{
+		if (!steps[i])
+			continue;
+		if (final[i])
+		{
+			has_final = true;
+			continue;
+		}
+		auto found = chain_task.find(root(i));
+		if (found == chain_task.end())
+		{
+			if (open_size >= MIN_NODES_PER_AUTO_TASK)
+			{
+				chain_tasks++;
+				open_size = 0;
+			}
+			open_size += chain_size[root(i)];
+			found = chain_task.emplace(root(i), chain_tasks - 1).first;
+		}
+		task_of[i] = found->second;
+	}
+
+	/* chains run first as group 0, the final task after them as group 1 */
+	task_list.clear();
+	int const tasks = std::max(chain_tasks + (has_final ? 1 : 0), 1);
+	for (int t = 0; t < tasks; t++)
+	{
+		discrete_task *task = auto_alloc_clear(machine(), <discrete_task>(*this));
+		task->task_group = (t < chain_tasks) ? 0 : 1;
+		task_list.add(task);
+	}
+	for (int i = 0; i < count; i++)
+	{
+		discrete_step_interface *step;
+		if (m_node_list[i]->interface(step))
+			task_list[final[i] ? (tasks - 1) : task_of[i]]->step_list.add(step);
+	}
+
+	for_each(discrete_task **, task, &task_list)
+		discrete_log("partition_tasks() - task %p group %d with %d nodes", (void *) *task, (*task)->task_group, (*task)->step_list.count());
+}
+
+void discrete_device::link_tasks(void)
+{
+	/* buffer the outputs each task reads from lower groups */
+	for_each(discrete_task **, task, &task_list)
+	{
+		for_each(discrete_task **, dest_task, &task_list)
+		{
+			if ((*task)->task_group > (*dest_task)->task_group)
+				(*dest_task)->check((*task));
+		}
+	}
+
+	/* now the source lists are complete, point the inputs at them */
+	for_each(discrete_task **, task, &task_list)
+		for_each(input_buffer *, sn, &(*task)->source_list)
+			*sn->input = &sn->buffer;
+}
+
+void discrete_device::unlink_tasks(void)
+{
+	for_each(discrete_task **, task, &task_list)
+		for_each(input_buffer *, sn, &(*task)->source_list)
+			*sn->input = sn->source;
+}
+
+
 /*************************************
  *
  *  node_description implementation
@@ -834,6 +1074,8 @@ discrete_device::discrete_device(const machine_config &mconfig, device_type type
 		m_sample_time(0),
 		m_neg_sample_time(0),
 		m_indexed_node(nullptr),
+		m_auto_tasks(false),
+		m_resetting_node(nullptr),
 		m_disclogfile(nullptr),
 		m_queue(nullptr),
 		m_profiling(0),
@@ -916,14 +1158,9 @@ void discrete_device::device_start()
 	}
 
 	/* Now set up tasks */
-	for_each(discrete_task **, task, &task_list)
-	{
-		for_each(discrete_task **, dest_task, &task_list)
-		{
-			if ((*task)->task_group > (*dest_task)->task_group)
-				(*dest_task)->check((*task));
-		}
-	}
+	if (m_auto_tasks)
+		partition_tasks();
+	link_tasks();
 }
 
 void discrete_device::device_stop()
@@ -1006,13 +1243,24 @@ void discrete_device::device_reset()
 	update_to_current_time();
 
 	/* loop over all nodes */
+	size_t const hidden_links = m_hidden_links.size();
 	for_each (discrete_base_node **, node, &m_node_list)
 	{
 		/* Fimxe : node_level */
 		(*node)->m_output[0] = 0;
 
+		m_resetting_node = *node;
 		(*node)->reset();
 	}
+	m_resetting_node = nullptr;
+
+	/* nodes that looked up other nodes' outputs must share their tasks */
+	if (m_auto_tasks && m_hidden_links.size() != hidden_links)
+	{
+		unlink_tasks();
+		partition_tasks();
+		link_tasks();
+	}
 }
 
 void discrete_sound_device::device_reset()
@@ -1035,20 +1283,26 @@ void discrete_device::process(int samples)
 		return;
 
 	/* Setup tasks */
+	osd_ticks_t const now = m_profiling ? get_profile_ticks() : 0;
 	for_each(discrete_task **, task, &task_list)
 	{
-		/* unlock the thread */
-		(*task)->unlock();
-
 		(*task)->prepare_for_queue(samples);
+		(*task)->m_ready_time = now;
 	}
 
-	for_each(discrete_task **, task, &task_list)
+	if (task_list.count() == 1)
+	{
+		/* a lone task has nothing to wait for - skip the queue */
+		task_list[0]->process();
+	}
+	else
 	{
-		/* Fire a work item for each task */
-		osd_work_item_queue(m_queue, discrete_task::task_callback, (void *) &task_list, WORK_ITEM_FLAG_AUTO_RELEASE);
+		/* Fire a work item for each task not waiting on another; the rest are queued as their inputs complete */
+		for_each(discrete_task **, task, &task_list)
+			if ((*task)->m_producers == 0)
+				osd_work_item_queue(m_queue, discrete_task::task_callback, (void *) *task, WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(m_queue, osd_ticks_per_second()*10);
 	}
-	osd_work_queue_wait(m_queue, osd_ticks_per_second()*10);
 
 	if (m_profiling)
 	{
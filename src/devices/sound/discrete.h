@@ -4264,6 +4264,7 @@ typedef vector_t<discrete_sound_output_interface *> node_output_list_t;
 class discrete_device : public device_t
 {
 	//friend class discrete_base_node;
+	friend class discrete_task;
 
 protected:
 	// construction/destruction
@@ -4336,12 +4337,20 @@ private:
 	void discrete_sanity_check(const sound_block_list_t &block_list);
 	void display_profiling(void);
 	void init_nodes(const sound_block_list_t &block_list);
+	void partition_tasks(void);
+	void link_tasks(void);
+	void unlink_tasks(void);
 
 	/* internal node tracking */
 	discrete_base_node **   m_indexed_node;
 
 	/* tasks */
 	task_list_t             task_list;      /* discrete_task_context * */
+	bool                    m_auto_tasks;   /* tasks come from partitioning the node graph */
+
+	/* outputs that nodes look up through their custom data while resetting, as (reader, node read) */
+	discrete_base_node *    m_resetting_node;
+	std::vector<std::pair<discrete_base_node *, discrete_base_node *>> m_hidden_links;
 
 	/* debugging statistics */
 	FILE *                  m_disclogfile;
@@ -84,6 +84,7 @@ Ensoniq OTIS - ES5505                                            Ensoniq OTTO -
 
 #include "emu.h"
 #include "es5506.h"
+#include "voicemix.h"
 
 #if ES5506_MAKE_WAVS
 #include "sound/wavwrite.h"
@@ -255,6 +256,7 @@ void es5506_device::device_start()
 
 	/* allocate memory */
 	m_scratch = make_unique_clear<int32_t[]>(2 * MAX_SAMPLE_CHUNK);
+	m_voice_mix = make_unique_clear<int32_t[]>(3 * MAX_SAMPLE_CHUNK);
 
 	/* register save */
 	save_item(NAME(m_sample_rate));
@@ -398,6 +400,7 @@ void es5505_device::device_start()
 
 	/* allocate memory */
 	m_scratch = make_unique_clear<int32_t[]>(2 * MAX_SAMPLE_CHUNK);
+	m_voice_mix = make_unique_clear<int32_t[]>(3 * MAX_SAMPLE_CHUNK);
 
 	/* register save */
 	save_item(NAME(m_sample_rate));
@@ -812,6 +815,10 @@ void es550x_device::generate_ulaw(es550x_voice *voice, uint16_t *base, int32_t *
 	uint32_t accum = voice->accum & voice->accum_mask;
 	int32_t lvol = m_volume_lookup[voice->lvol >> 4];
 	int32_t rvol = m_volume_lookup[voice->rvol >> 4];
+	int32_t *mix = m_voice_mix.get();
+	int32_t *lvols = mix + MAX_SAMPLE_CHUNK;
+	int32_t *rvols = lvols + MAX_SAMPLE_CHUNK;
+	bool const ramping = voice->ecount != 0;
 
 	/* pre-add the bank offset */
 	base += voice->exbank;
@@ -849,9 +856,13 @@ reverse:
 					rvol = m_volume_lookup[voice->rvol >> 4];
 				}
 
-				/* apply volumes and add */
-				*lbuffer++ += (val1 * lvol) >> 11;
-				*rbuffer++ += (val1 * rvol) >> 11;
+				/* queue for mixing, with the volumes if they ramp */
+				*mix++ = val1;
+				if (ramping)
+				{
+					*lvols++ = lvol;
+					*rvols++ = rvol;
+				}
 
 				/* check for loop end */
 				check_for_end_forward(voice, accum);
@@ -887,9 +898,13 @@ reverse:
 					rvol = m_volume_lookup[voice->rvol >> 4];
 				}
 
-				/* apply volumes and add */
-				*lbuffer++ += (val1 * lvol) >> 11;
-				*rbuffer++ += (val1 * rvol) >> 11;
+				/* queue for mixing, with the volumes if they ramp */
+				*mix++ = val1;
+				if (ramping)
+				{
+					*lvols++ = lvol;
+					*rvols++ = rvol;
+				}
 
 				/* check for loop end */
 				check_for_end_reverse(voice, accum);
@@ -900,6 +915,7 @@ reverse:
 	/* if we stopped, process any additional envelope */
 alldone:
 	voice->accum = accum;
+	mix_voice(lbuffer, rbuffer, lvol, rvol, ramping, mix - m_voice_mix.get());
 	if (samples > 0)
 		update_envelopes(voice, samples);
 }
@@ -918,6 +934,10 @@ void es550x_device::generate_pcm(es550x_voice *voice, uint16_t *base, int32_t *l
 	uint32_t accum = voice->accum & voice->accum_mask;
 	int32_t lvol = m_volume_lookup[voice->lvol >> 4];
 	int32_t rvol = m_volume_lookup[voice->rvol >> 4];
+	int32_t *mix = m_voice_mix.get();
+	int32_t *lvols = mix + MAX_SAMPLE_CHUNK;
+	int32_t *rvols = lvols + MAX_SAMPLE_CHUNK;
+	bool const ramping = voice->ecount != 0;
 
 	/* pre-add the bank offset */
 	base += voice->exbank;
@@ -951,9 +971,13 @@ reverse:
 					rvol = m_volume_lookup[voice->rvol >> 4];
 				}
 
-				/* apply volumes and add */
-				*lbuffer++ += (val1 * lvol) >> 11;
-				*rbuffer++ += (val1 * rvol) >> 11;
+				/* queue for mixing, with the volumes if they ramp */
+				*mix++ = val1;
+				if (ramping)
+				{
+					*lvols++ = lvol;
+					*rvols++ = rvol;
+				}
 
 				/* check for loop end */
 				check_for_end_forward(voice, accum);
@@ -985,9 +1009,13 @@ reverse:
 					rvol = m_volume_lookup[voice->rvol >> 4];
 				}
 
-				/* apply volumes and add */
-				*lbuffer++ += (val1 * lvol) >> 11;
-				*rbuffer++ += (val1 * rvol) >> 11;
+				/* queue for mixing, with the volumes if they ramp */
+				*mix++ = val1;
+				if (ramping)
+				{
+					*lvols++ = lvol;
+					*rvols++ = rvol;
+				}
 
 				/* check for loop end */
 				check_for_end_reverse(voice, accum);
@@ -998,12 +1026,34 @@ reverse:
 	/* if we stopped, process any additional envelope */
 alldone:
 	voice->accum = accum;
+	mix_voice(lbuffer, rbuffer, lvol, rvol, ramping, mix - m_voice_mix.get());
 	if (samples > 0)
 		update_envelopes(voice, samples);
 }
 
 
 
+/**********************************************************************************************
+
+     mix_voice -- apply volumes to the samples a voice generated and add them to the outputs
+
+***********************************************************************************************/
+
+void es550x_device::mix_voice(int32_t *lbuffer, int32_t *rbuffer, int32_t lvol, int32_t rvol, bool ramping, int samples)
+{
+	int32_t const *const mix = m_voice_mix.get();
+
+	if (ramping)
+	{
+		voice_mixer::add_ramped(lbuffer, mix, mix + MAX_SAMPLE_CHUNK, 11, samples);
+		voice_mixer::add_ramped(rbuffer, mix, mix + 2 * MAX_SAMPLE_CHUNK, 11, samples);
+	}
+	else
+		voice_mixer::add_stereo(lbuffer, rbuffer, mix, lvol, rvol, 11, samples);
+}
+
+
+
 /**********************************************************************************************
 
      generate_samples -- tell each voice to generate samples
@@ -79,6 +79,7 @@ protected:
 	void generate_dummy(es550x_voice *voice, uint16_t *base, int32_t *lbuffer, int32_t *rbuffer, int samples);
 	void generate_ulaw(es550x_voice *voice, uint16_t *base, int32_t *lbuffer, int32_t *rbuffer, int samples);
 	void generate_pcm(es550x_voice *voice, uint16_t *base, int32_t *lbuffer, int32_t *rbuffer, int samples);
+	void mix_voice(int32_t *lbuffer, int32_t *rbuffer, int32_t lvol, int32_t rvol, bool ramping, int samples);
 
 	// internal state
 	sound_stream *m_stream;               /* which stream are we using */
@@ -99,6 +100,7 @@ protected:
 	es550x_voice m_voice[32];             /* the 32 voices */
 
 	std::unique_ptr<int32_t[]>     m_scratch;
+	std::unique_ptr<int32_t[]>     m_voice_mix;  /* a voice's samples for one chunk, then its volumes while they ramp */
 
 	std::unique_ptr<int16_t[]>     m_ulaw_lookup;
 	std::unique_ptr<uint16_t[]>    m_volume_lookup;
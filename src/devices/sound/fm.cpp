@@ -116,6 +116,14 @@
 #define YM2610B_WARNING
 #include "fm.h"
 
+/* the six-channel output mix has an SSE2 path under the same conditions as rgbutil.h */
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define FM_USE_SSE2 1
+#else
+#define FM_USE_SSE2 0
+#endif
+
 
 /* include external DELTA-T unit (when needed) */
 #if (BUILD_YM2608||BUILD_YM2610||BUILD_YM2610B)
@@ -2673,6 +2681,21 @@ void FMsave_state_adpcma(device_t *device,ADPCM_CH *adpcm)
 	}
 }
 #endif /* MAME_EMU_SAVE_H */
+
+#if FM_USE_SSE2
+/* add the six FM channels, halved, to the left and right outputs; pan holds a left and a right mask per channel */
+inline void mix_fm_channels(const int32_t *out_fm, const unsigned int *pan, int &lt, int &rt)
+{
+	__m128i const out03 = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&out_fm[0]), 1);
+	__m128i const out45 = _mm_srai_epi32(_mm_loadl_epi64((const __m128i *)&out_fm[4]), 1);
+	__m128i mix = _mm_and_si128(_mm_unpacklo_epi32(out03, out03), _mm_loadu_si128((const __m128i *)&pan[0]));
+	mix = _mm_add_epi32(mix, _mm_and_si128(_mm_unpackhi_epi32(out03, out03), _mm_loadu_si128((const __m128i *)&pan[4])));
+	mix = _mm_add_epi32(mix, _mm_and_si128(_mm_unpacklo_epi32(out45, out45), _mm_loadu_si128((const __m128i *)&pan[8])));
+	mix = _mm_add_epi32(mix, _mm_srli_si128(mix, 8));
+	lt += _mm_cvtsi128_si32(mix);
+	rt += _mm_cvtsi128_si32(_mm_srli_si128(mix, 4));
+}
+#endif
 } // anonymous namespace
 
 #endif /* (BUILD_YM2608||BUILD_YM2610||BUILD_YM2610B) */
@@ -2826,6 +2849,9 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 			rt =  OPN->out_adpcm[OUTD_RIGHT] + OPN->out_adpcm[OUTD_CENTER];
 			lt += (OPN->out_delta[OUTD_LEFT]  + OPN->out_delta[OUTD_CENTER])>>9;
 			rt += (OPN->out_delta[OUTD_RIGHT] + OPN->out_delta[OUTD_CENTER])>>9;
+#if FM_USE_SSE2
+			mix_fm_channels(out_fm, OPN->pan, lt, rt);    /* shift right verified on real YM2608 */
+#else
 			lt += ((out_fm[0]>>1) & OPN->pan[0]);   /* shift right verified on real YM2608 */
 			rt += ((out_fm[0]>>1) & OPN->pan[1]);
 			lt += ((out_fm[1]>>1) & OPN->pan[2]);
@@ -2838,6 +2864,7 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 			rt += ((out_fm[4]>>1) & OPN->pan[9]);
 			lt += ((out_fm[5]>>1) & OPN->pan[10]);
 			rt += ((out_fm[5]>>1) & OPN->pan[11]);
+#endif
 
 			lt >>= FINAL_SH;
 			rt >>= FINAL_SH;
@@ -3510,6 +3537,9 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 			lt += (OPN->out_delta[OUTD_LEFT]  + OPN->out_delta[OUTD_CENTER])>>9;
 			rt += (OPN->out_delta[OUTD_RIGHT] + OPN->out_delta[OUTD_CENTER])>>9;
 
+#if FM_USE_SSE2
+			mix_fm_channels(out_fm, OPN->pan, lt, rt);    /* the shift right is verified on YM2610 */
+#else
 			lt += ((out_fm[0]>>1) & OPN->pan[0]);   /* the shift right is verified on YM2610 */
 			rt += ((out_fm[0]>>1) & OPN->pan[1]);
 			lt += ((out_fm[1]>>1) & OPN->pan[2]);
@@ -3522,6 +3552,7 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 			rt += ((out_fm[4]>>1) & OPN->pan[9]);
 			lt += ((out_fm[5]>>1) & OPN->pan[10]);
 			rt += ((out_fm[5]>>1) & OPN->pan[11]);
+#endif
 
 
 			lt >>= FINAL_SH;
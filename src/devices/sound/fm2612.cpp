@@ -141,6 +141,14 @@
 #include "2612intf.h"
 #endif /* (BUILD_YM2612||BUILD_YM3438) */
 
+/* the output limit and mix have an SSE2 path under the same conditions as rgbutil.h */
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define FM2612_USE_SSE2 1
+#else
+#define FM2612_USE_SSE2 0
+#endif
+
 
 /* shared function building option */
 #define BUILD_OPN (BUILD_YM2203||BUILD_YM2608||BUILD_YM2610||BUILD_YM2610B||BUILD_YM2612||BUILD_YM3438)
@@ -2179,6 +2187,19 @@ static void init_tables(void)
 /*******************************************************************************/
 
 /* Generate samples for one of the YM2612s */
+#if FM2612_USE_SSE2
+/* clamp four channel outputs to the 14-bit range of the DAC */
+static inline __m128i limit_fm_channels(__m128i out)
+{
+	__m128i const max = _mm_set1_epi32(8191);
+	__m128i const min = _mm_set1_epi32(-8192);
+	__m128i const over = _mm_cmpgt_epi32(out, max);
+	out = _mm_or_si128(_mm_and_si128(over, max), _mm_andnot_si128(over, out));
+	__m128i const under = _mm_cmplt_epi32(out, min);
+	return _mm_or_si128(_mm_and_si128(under, min), _mm_andnot_si128(under, out));
+}
+#endif
+
 void ym2612_update_one(void *chip, FMSAMPLE **buffer, int length)
 {
 	ym2612_state *F2612 = (ym2612_state *)chip;
@@ -2266,6 +2287,17 @@ void ym2612_update_one(void *chip, FMSAMPLE **buffer, int length)
 			advance_eg_channel(OPN, &cch[5]->SLOT[SLOT1]);
 		}
 
+#if FM2612_USE_SSE2
+		/* limit the six channels and mix them; pan holds a left and a right mask per channel */
+		__m128i const out03 = limit_fm_channels(_mm_loadu_si128((const __m128i *)&out_fm[0]));
+		__m128i const out45 = limit_fm_channels(_mm_loadl_epi64((const __m128i *)&out_fm[4]));
+		__m128i mix = _mm_and_si128(_mm_unpacklo_epi32(out03, out03), _mm_loadu_si128((const __m128i *)&OPN->pan[0]));
+		mix = _mm_add_epi32(mix, _mm_and_si128(_mm_unpackhi_epi32(out03, out03), _mm_loadu_si128((const __m128i *)&OPN->pan[4])));
+		mix = _mm_add_epi32(mix, _mm_and_si128(_mm_unpacklo_epi32(out45, out45), _mm_loadu_si128((const __m128i *)&OPN->pan[8])));
+		mix = _mm_add_epi32(mix, _mm_srli_si128(mix, 8));
+		lt = _mm_cvtsi128_si32(mix);
+		rt = _mm_cvtsi128_si32(_mm_srli_si128(mix, 4));
+#else
 		if (out_fm[0] > 8191) out_fm[0] = 8191;
 		else if (out_fm[0] < -8192) out_fm[0] = -8192;
 		if (out_fm[1] > 8191) out_fm[1] = 8191;
@@ -2292,6 +2324,7 @@ void ym2612_update_one(void *chip, FMSAMPLE **buffer, int length)
 		rt += ((out_fm[4]>>0) & OPN->pan[9]);
 		lt += ((out_fm[5]>>0) & OPN->pan[10]);
 		rt += ((out_fm[5]>>0) & OPN->pan[11]);
+#endif
 
 //      Limit( lt, MAXOUT, MINOUT );
 //      Limit( rt, MAXOUT, MINOUT );
@@ -183,6 +183,10 @@ void okim6295_device::sound_stream_update(sound_stream &stream, stream_sample_t
 	// iterate over voices and accumulate sample data
 	for (auto & elem : m_voice)
 		elem.generate_adpcm(*this, outputs[0], samples);
+
+	// with every voice stopped the output stays silent until a voice is started
+	if (std::none_of(std::begin(m_voice), std::end(m_voice), [] (const okim_voice &voice) { return voice.m_playing; }))
+		stream.set_idle();
 }
 
 
@@ -251,8 +255,8 @@ void okim6295_device::write_command(uint8_t command)
 		//if (voicemask != 0 && voicemask != 1 && voicemask != 2 && voicemask != 4 && voicemask != 8)
 		//  popmessage("OKI6295 start %x contact MAMEDEV", voicemask);
 
-		// update the stream
-		m_stream->update();
+		// update the stream, and start calling back again
+		m_stream->wake();
 
 		// determine which voice(s) (voice is set by a 1 bit in the upper 4 bits of the second byte)
 		for (int voicenum = 0; voicenum < OKIM6295_VOICES; voicenum++, voicemask >>= 1)
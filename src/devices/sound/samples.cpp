@@ -12,6 +12,14 @@
     discrete sound circuits where proper low-level simulation isn't
     available.  Also used for tape loops and similar.
 
+    Samples are found at startup but only decoded when first played,
+    and the least recently played are freed again once the decoded data
+    goes over the -sample_cache budget.  With -sample_stream, samples
+    longer than the given number of seconds decode their first chunk
+    when started and the rest on an I/O thread while they play; a
+    channel that catches up with the decoder plays silence until it
+    gets ahead again.
+
     Current limitations
       - Only supports single channel samples!
 
@@ -29,6 +37,8 @@
 
 #include "flac.h"
 
+#include <algorithm>
+
 
 //**************************************************************************
 //  GLOBAL VARIABLES
@@ -39,6 +49,121 @@ DEFINE_DEVICE_TYPE(SAMPLES, samples_device, "samples", "Samples")
 
 
 
+//**************************************************************************
+//  SAMPLE STREAM
+//**************************************************************************
+
+// ======================> samples_device::sample_stream
+
+// an open WAV or FLAC file, decoded in pieces
+class samples_device::sample_stream
+{
+public:
+	// construction/destruction
+	sample_stream(const char *searchpath)
+		: m_file(searchpath, OPEN_FLAG_READ)
+		, m_frequency(0)
+		, m_length(0)
+		, m_bits(16)
+		, m_granularity(1)
+	{
+	}
+
+	// getters
+	uint32_t frequency() const { return m_frequency; }
+	uint32_t length() const { return m_length; }
+
+	// every read but the last must be a multiple of this; 0 means the file must be read in one go
+	uint32_t granularity() const { return m_granularity; }
+
+	//-------------------------------------------------
+	//  open - open a sample file and read as far as
+	//  the start of its data
+	//-------------------------------------------------
+
+	bool open(const std::string &name)
+	{
+		if (m_file.open(name) != osd_file::error::NONE)
+			return false;
+
+		// read the core header and make sure it's a proper file
+		uint8_t buf[4];
+		if (m_file.read(buf, 4) < 4)
+		{
+			osd_printf_warning("Unable to read %s, 0-byte file?\n", m_file.filename());
+			return false;
+		}
+
+		// WAV files are raw data after the header
+		if (memcmp(&buf[0], "RIFF", 4) == 0)
+		{
+			uint32_t bytes;
+			if (!read_wav_header(m_file, m_frequency, m_bits, bytes))
+				return false;
+			m_length = bytes / (m_bits / 8);
+			return true;
+		}
+
+		// FLAC files need a decoder, which can only stop between blocks
+		if (memcmp(&buf[0], "fLaC", 4) == 0)
+		{
+			m_file.seek(0, SEEK_SET);
+			m_flac = std::make_unique<flac_decoder>((util::core_file &)m_file);
+			if (m_flac->channels() != 1 || m_flac->bits_per_sample() != 16)
+				return false;
+			m_frequency = m_flac->sample_rate();
+			m_length = m_flac->total_samples();
+			m_granularity = m_flac->block_size();
+			return true;
+		}
+
+		// if nothing appropriate, emit a warning
+		osd_printf_warning("Unable to read %s, corrupt file?\n", m_file.filename());
+		return false;
+	}
+
+	//-------------------------------------------------
+	//  read - decode the next samples
+	//-------------------------------------------------
+
+	bool read(int16_t *dest, uint32_t count)
+	{
+		if (m_flac)
+			return m_flac->decode_interleaved(dest, count);
+
+		if (m_bits == 8)
+		{
+			// convert 8-bit data to signed samples
+			if (m_file.read(dest, count) != count)
+				return false;
+			uint8_t *tempptr = reinterpret_cast<uint8_t *>(dest);
+			for (int32_t sindex = count - 1; sindex >= 0; sindex--)
+				dest[sindex] = int8_t(tempptr[sindex] ^ 0x80) * 256;
+		}
+		else
+		{
+			// 16-bit data is fine as-is, bar swapping high/low on big-endian systems
+			if (m_file.read(dest, count * 2) != count * 2)
+				return false;
+			if (ENDIANNESS_NATIVE != ENDIANNESS_LITTLE)
+				for (uint32_t sindex = 0; sindex < count; sindex++)
+					dest[sindex] = little_endianize_int16(dest[sindex]);
+		}
+		return true;
+	}
+
+private:
+	// internal state
+	emu_file                        m_file;
+	std::unique_ptr<flac_decoder>   m_flac;
+	uint32_t                        m_frequency;
+	uint32_t                        m_length;       // in samples
+	uint16_t                        m_bits;         // bits per WAV sample
+	uint32_t                        m_granularity;
+};
+
+
+
 //**************************************************************************
 //  LIVE DEVICE
 //**************************************************************************
@@ -57,6 +182,21 @@ samples_device::samples_device(const machine_config &mconfig, device_type type,
 	, device_sound_interface(mconfig, *this)
 	, m_channels(0)
 	, m_names(nullptr)
+	, m_stream_queue(nullptr)
+	, m_trigger_count(0)
+	, m_sample_bytes(0)
+	, m_sample_budget(0)
+	, m_stream_seconds(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~samples_device - destructor; out of line, so
+//  sample_stream is complete here
+//-------------------------------------------------
+
+samples_device::~samples_device()
 {
 }
 
@@ -82,9 +222,13 @@ void samples_device::start(uint8_t channel, uint32_t samplenum, bool loop)
 	channel_t &chan = m_channel[channel];
 	chan.stream->update();
 
+	// decode the sample if it hasn't been played yet or has been freed since
+	acquire_sample(samplenum);
+
 	// update the parameters
 	sample_t &sample = m_sample[samplenum];
 	chan.source = (sample.data.size() > 0) ? &sample.data[0] : nullptr;
+	chan.ready = m_sample_info[samplenum].item ? &m_sample_info[samplenum].ready : nullptr;
 	chan.source_length = sample.data.size();
 	chan.source_num = (chan.source_length > 0) ? samplenum : -1;
 	chan.pos = 0;
@@ -110,6 +254,7 @@ void samples_device::start_raw(uint8_t channel, const int16_t *sampledata, uint3
 
 	// update the parameters
 	chan.source = sampledata;
+	chan.ready = nullptr;
 	chan.source_length = samples;
 	chan.source_num = -1;
 	chan.pos = 0;
@@ -246,6 +391,7 @@ void samples_device::device_start()
 		channel_t &chan = m_channel[channel];
 		chan.stream = stream_alloc(0, 1, machine().sample_rate());
 		chan.source = nullptr;
+		chan.ready = nullptr;
 		chan.source_num = -1;
 		chan.step = 0;
 		chan.loop = 0;
@@ -279,6 +425,25 @@ void samples_device::device_reset()
 }
 
 
+//-------------------------------------------------
+//  device_stop - finish any streaming before the
+//  sample data goes away
+//-------------------------------------------------
+
+void samples_device::device_stop()
+{
+	for (uint32_t samplenum = 0; samplenum < m_sample.size(); samplenum++)
+		if (m_sample_info[samplenum].item)
+			release_sample(samplenum);
+
+	if (m_stream_queue)
+	{
+		osd_work_queue_free(m_stream_queue);
+		m_stream_queue = nullptr;
+	}
+}
+
+
 //-------------------------------------------------
 //  device_post_load - handle updating after a
 //  restore
@@ -293,8 +458,10 @@ void samples_device::device_post_load()
 		channel_t &chan = m_channel[channel];
 		if (chan.source_num >= 0 && chan.source_num < m_sample.size())
 		{
+			acquire_sample(chan.source_num);
 			sample_t &sample = m_sample[chan.source_num];
-			chan.source = &sample.data[0];
+			chan.source = sample.data.empty() ? nullptr : &sample.data[0];
+			chan.ready = m_sample_info[chan.source_num].item ? &m_sample_info[chan.source_num].ready : nullptr;
 			chan.source_length = sample.data.size();
 			if (sample.data.empty())
 				chan.source_num = -1;
@@ -337,9 +504,17 @@ void samples_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 				uint32_t step = chan.step;
 				const int16_t *sample = chan.source;
 				uint32_t sample_length = chan.source_length;
+				uint32_t const ready = chan.ready ? chan.ready->load(std::memory_order_acquire) : sample_length;
 
 				while (samples--)
 				{
+					// if the sample is still streaming in and we've caught up, wait in silence
+					if (ready < sample_length && pos + 1 >= ready)
+					{
+						memset(buffer, 0, (samples + 1) * sizeof(*buffer));
+						break;
+					}
+
 					// do a linear interp on the sample
 					int32_t sample1 = sample[pos];
 					int32_t sample2 = sample[(pos + 1) % sample_length];
@@ -412,10 +587,11 @@ bool samples_device::read_sample(emu_file &file, sample_t &sample)
 
 
 //-------------------------------------------------
-//  read_wav_sample - read a WAV file as a sample
+//  read_wav_header - read a WAV file's header,
+//  leaving the file at the start of the data
 //-------------------------------------------------
 
-bool samples_device::read_wav_sample(emu_file &file, sample_t &sample)
+bool samples_device::read_wav_header(emu_file &file, uint32_t &rate, uint16_t &bits, uint32_t &length)
 {
 	// we already read the opening 'RIFF' tag
 	uint32_t offset = 4;
@@ -445,7 +621,6 @@ bool samples_device::read_wav_sample(emu_file &file, sample_t &sample)
 	}
 
 	// seek until we find a format tag
-	uint32_t length;
 	while (1)
 	{
 		offset += file.read(buf, 4);
@@ -484,7 +659,6 @@ bool samples_device::read_wav_sample(emu_file &file, sample_t &sample)
 	}
 
 	// sample rate
-	uint32_t rate;
 	offset += file.read(&rate, 4);
 	rate = little_endianize_int32(rate);
 
@@ -492,7 +666,6 @@ bool samples_device::read_wav_sample(emu_file &file, sample_t &sample)
 	offset += file.read(buf, 6);
 
 	// bits/sample
-	uint16_t bits;
 	offset += file.read(&bits, 2);
 	bits = little_endianize_int16(bits);
 	if (bits != 8 && bits != 16)
@@ -530,6 +703,20 @@ bool samples_device::read_wav_sample(emu_file &file, sample_t &sample)
 		osd_printf_warning("empty data block (%s)\n", file.filename());
 		return false;
 	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  read_wav_sample - read a WAV file as a sample
+//-------------------------------------------------
+
+bool samples_device::read_wav_sample(emu_file &file, sample_t &sample)
+{
+	uint32_t rate, length;
+	uint16_t bits;
+	if (!read_wav_header(file, rate, bits, length))
+		return false;
 
 	// fill in the sample data
 	sample.frequency = rate;
@@ -591,12 +778,13 @@ bool samples_device::read_flac_sample(emu_file &file, sample_t &sample)
 
 
 //-------------------------------------------------
-//  load_samples - load all the samples in our
-//  attached interface
-//  Returns true when all samples were successfully read, else false
+//  load_samples - find all the samples in our
+//  attached interface, decoding them now only if
+//  preload is set
+//  Returns true when all samples were found, else false
 //-------------------------------------------------
 
-bool samples_device::load_samples()
+bool samples_device::load_samples(bool preload)
 {
 	bool ok = true;
 	// if the user doesn't want to use samples, bail
@@ -608,28 +796,40 @@ bool samples_device::load_samples()
 	samples_iterator iter(*this);
 	const char *altbasename = iter.altbasename();
 
-	// pre-size the array
+	// pre-size the arrays
 	m_sample.resize(iter.count());
+	m_sample_info = std::make_unique<sample_info []>(m_sample.size());
 
-	// load the samples
+	// preloaded samples are pinned, so neither the budget nor streaming applies to them
+	m_sample_budget = size_t(std::max(machine().options().sample_cache(), 0)) << 20;
+	m_stream_seconds = preload ? 0 : std::max(machine().options().sample_stream(), 0);
+	if (m_stream_seconds != 0 && !m_stream_queue)
+		m_stream_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+
+	// find the samples
 	int index = 0;
 	for (const char *samplename = iter.first(); samplename != nullptr; index++, samplename = iter.next())
 	{
-		// attempt to open as FLAC first
+		// attempt to open as FLAC first, then as WAV
 		emu_file file(machine().options().sample_path(), OPEN_FLAG_READ);
-		osd_file::error filerr = file.open(basename, PATH_SEPARATOR, samplename, ".flac");
-		if (filerr != osd_file::error::NONE && altbasename != nullptr)
-			filerr = file.open(altbasename, PATH_SEPARATOR, samplename, ".flac");
-
-		// if not, try as WAV
-		if (filerr != osd_file::error::NONE)
-			filerr = file.open(basename, PATH_SEPARATOR, samplename, ".wav");
-		if (filerr != osd_file::error::NONE && altbasename != nullptr)
-			filerr = file.open(altbasename, PATH_SEPARATOR, samplename, ".wav");
+		osd_file::error filerr = osd_file::error::NOT_FOUND;
+		std::string name;
+		for (const char *extension : { ".flac", ".wav" })
+			for (const char *base : { basename, altbasename })
+				if (base != nullptr && filerr != osd_file::error::NONE)
+				{
+					name = string_format("%s%s%s%s", base, PATH_SEPARATOR, samplename, extension);
+					filerr = file.open(name);
+				}
 
-		// if opened, read it
+		// if opened, remember it for decoding later
 		if (filerr == osd_file::error::NONE)
-			read_sample(file, m_sample[index]);
+		{
+			m_sample_info[index].name = name;
+			m_sample_info[index].pinned = preload;
+			if (preload)
+				acquire_sample(index);
+		}
 		else if (filerr == osd_file::error::NOT_FOUND)
 		{
 			logerror("%s: Sample '%s' NOT FOUND\n", tag(), samplename);
@@ -638,3 +838,154 @@ bool samples_device::load_samples()
 	}
 	return ok;
 }
+
+
+//-------------------------------------------------
+//  acquire_sample - make sure a sample is decoded,
+//  or at least streaming in, and mark it as just
+//  used
+//-------------------------------------------------
+
+bool samples_device::acquire_sample(uint32_t samplenum)
+{
+	sample_info &info = m_sample_info[samplenum];
+	sample_t &sample = m_sample[samplenum];
+	info.last_used = ++m_trigger_count;
+	if (info.loaded)
+		return !sample.data.empty();
+
+	// a file that fails stays loaded but empty, so it only warns once
+	info.loaded = true;
+	if (info.name.empty())
+		return false;
+	auto stream = std::make_unique<sample_stream>(machine().options().sample_path());
+	if (!stream->open(info.name))
+		return false;
+
+	sample.frequency = stream->frequency();
+	sample.data.resize(stream->length());
+	m_sample_bytes += sample.data.size() * sizeof(int16_t);
+	info.length = sample.data.size();
+	info.dest = sample.data.empty() ? nullptr : &sample.data[0];
+
+	// long samples decode their first chunk now and the rest on the I/O thread
+	bool decoded;
+	uint32_t const granularity = stream->granularity();
+	if (m_stream_queue && granularity != 0 && info.length > uint64_t(sample.frequency) * m_stream_seconds)
+	{
+		info.chunk = (STREAM_CHUNK + granularity - 1) / granularity * granularity;
+		uint32_t const first = std::min(info.chunk, info.length);
+		decoded = stream->read(info.dest, first);
+		if (decoded)
+		{
+			info.ready.store(first, std::memory_order_relaxed);
+			info.cancel.store(false, std::memory_order_relaxed);
+			info.stream = std::move(stream);
+			info.item = osd_work_item_queue(m_stream_queue, stream_callback, &info, 0);
+			if (!info.item)
+				stream_callback(&info, 0);
+		}
+	}
+	else
+	{
+		decoded = stream->read(info.dest, info.length);
+		info.ready.store(info.length, std::memory_order_relaxed);
+	}
+
+	if (!decoded)
+	{
+		osd_printf_warning("Unable to decode sample %s\n", info.name.c_str());
+		m_sample_bytes -= sample.data.size() * sizeof(int16_t);
+		std::vector<int16_t>().swap(sample.data);
+		return false;
+	}
+
+	// make room for it by freeing others
+	trim_samples(samplenum);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  release_sample - free a sample's decoded data
+//  so it is decoded again when next played
+//-------------------------------------------------
+
+void samples_device::release_sample(uint32_t samplenum)
+{
+	sample_info &info = m_sample_info[samplenum];
+	if (info.item)
+	{
+		info.cancel.store(true, std::memory_order_relaxed);
+		osd_work_item_wait(info.item, osd_ticks_per_second() * 10);
+		osd_work_item_release(info.item);
+		info.item = nullptr;
+	}
+	info.stream.reset();
+
+	sample_t &sample = m_sample[samplenum];
+	m_sample_bytes -= sample.data.size() * sizeof(int16_t);
+	std::vector<int16_t>().swap(sample.data);
+	info.dest = nullptr;
+	info.loaded = false;
+}
+
+
+//-------------------------------------------------
+//  trim_samples - free the least recently started
+//  samples that aren't playing until the decoded
+//  data fits the budget again
+//-------------------------------------------------
+
+void samples_device::trim_samples(uint32_t keep)
+{
+	while (m_sample_budget != 0 && m_sample_bytes > m_sample_budget)
+	{
+		int32_t oldest = -1;
+		for (uint32_t samplenum = 0; samplenum < m_sample.size(); samplenum++)
+		{
+			sample_info const &info = m_sample_info[samplenum];
+			if (samplenum == keep || info.pinned || m_sample[samplenum].data.empty())
+				continue;
+			if (oldest >= 0 && info.last_used >= m_sample_info[oldest].last_used)
+				continue;
+
+			bool playing = false;
+			for (channel_t const &chan : m_channel)
+				if (chan.source_num == int32_t(samplenum))
+					playing = true;
+			if (!playing)
+				oldest = samplenum;
+		}
+
+		// if everything left is playing, go over budget for now
+		if (oldest < 0)
+			break;
+		release_sample(oldest);
+	}
+}
+
+
+//-------------------------------------------------
+//  stream_callback - decode the rest of a sample
+//  on the I/O thread, publishing each chunk as it
+//  lands
+//-------------------------------------------------
+
+void *samples_device::stream_callback(void *param, int threadid)
+{
+	sample_info &info = *reinterpret_cast<sample_info *>(param);
+	uint32_t done = info.ready.load(std::memory_order_relaxed);
+	while (done < info.length && !info.cancel.load(std::memory_order_relaxed))
+	{
+		uint32_t const count = std::min(info.chunk, info.length - done);
+		if (!info.stream->read(info.dest + done, count))
+			break;
+		done += count;
+		info.ready.store(done, std::memory_order_release);
+	}
+
+	// after an error the rest stays silent rather than stalling the channels playing it
+	info.ready.store(info.length, std::memory_order_release);
+	return nullptr;
+}
@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 
 //**************************************************************************
 //  GLOBAL VARIABLES
@@ -37,6 +40,7 @@ public:
 
 	// construction/destruction
 	samples_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock = 0);
+	virtual ~samples_device();
 
 	// configuration helpers
 	void set_channels(uint8_t channels) { m_channels = channels; }
@@ -90,16 +94,20 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 	virtual void device_post_load() override;
 
 	// device_sound_interface overrides
 	virtual void sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples) override;
 
 	// internal classes
+	class sample_stream;
+
 	struct channel_t
 	{
 		sound_stream *  stream;
 		const int16_t *   source;
+		const std::atomic<uint32_t> *ready; // samples decoded so far, if the source is still streaming in
 		int32_t           source_length;
 		int32_t           source_num;
 		uint32_t          pos;
@@ -110,21 +118,49 @@ protected:
 		bool            paused;
 	};
 
+	// samples are decoded when first played rather than at startup
+	struct sample_info
+	{
+		std::string     name;           // file to reopen, relative to the sample path; empty if missing
+		bool            loaded;         // decoded, or being decoded, into m_sample
+		bool            pinned;         // never freed to stay within the cache budget
+		uint64_t        last_used;      // value of m_trigger_count when last started
+		uint32_t        length;         // total samples, and how many to decode per chunk when streaming
+		uint32_t        chunk;
+		int16_t *       dest;
+		std::atomic<uint32_t> ready;    // samples decoded so far
+		std::atomic<bool> cancel;       // asks the I/O thread to stop early
+		osd_work_item * item;           // work item streaming the rest of the sample in
+		std::unique_ptr<sample_stream> stream;
+	};
+
 	// internal helpers
+	static bool read_wav_header(emu_file &file, uint32_t &rate, uint16_t &bits, uint32_t &length);
 	static bool read_wav_sample(emu_file &file, sample_t &sample);
 	static bool read_flac_sample(emu_file &file, sample_t &sample);
-	bool load_samples();
+	bool load_samples(bool preload = false);
+	bool acquire_sample(uint32_t samplenum);
+	void release_sample(uint32_t samplenum);
+	void trim_samples(uint32_t keep);
+	static void *stream_callback(void *param, int threadid);
 
 	start_cb_delegate m_samples_start_cb; // optional callback
 
 	// internal state
 	std::vector<channel_t>    m_channel;
 	std::vector<sample_t>     m_sample;
+	std::unique_ptr<sample_info []> m_sample_info;
+	osd_work_queue *          m_stream_queue;   // I/O queue for streaming, if enabled
+	uint64_t                  m_trigger_count;
+	size_t                    m_sample_bytes;   // decoded data currently held
+	size_t                    m_sample_budget;  // limit on that before old samples are freed, or 0
+	uint32_t                  m_stream_seconds; // samples longer than this are streamed, or 0
 
 	// internal constants
 	static constexpr uint8_t FRAC_BITS = 24;
 	static constexpr uint32_t FRAC_ONE = 1 << FRAC_BITS;
 	static constexpr uint32_t FRAC_MASK = FRAC_ONE - 1;
+	static constexpr uint32_t STREAM_CHUNK = 32768;
 };
 
 // iterator, since lots of people are interested in these devices
@@ -298,6 +298,9 @@ void scsp_device::device_post_load()
 	for (int slot = 0; slot < 32; slot++)
 		Compute_LFO(&m_Slots[slot]);
 
+	// the DSP program is recompiled from the restored MPRO
+	m_DSP.Invalidate();
+
 	m_stream->set_output_gain(0, MVOL() / 15.0);
 	m_stream->set_output_gain(1, MVOL() / 15.0);
 }
@@ -1008,6 +1011,7 @@ void scsp_device::w16(uint32_t addr, uint16_t val)
 		else if (addr < 0xC00)
 		{
 			*((uint16_t *) (m_DSP.MPRO + (addr - 0x800) / 2)) = val;
+			m_DSP.Invalidate();
 
 			if (addr == 0xBF0)
 			{
@@ -63,6 +63,71 @@ void SCSPDSP::Init()
 	std::memset(this, 0, sizeof(*this));
 	RBL = (8*1024); // Initial RBL is 0
 	Stopped = true;
+	Dirty = true;
+}
+
+void SCSPDSP::Compile()
+{
+	Instruction decoded[128];
+	for (int step = 0; step < LastStep; ++step)
+	{
+		uint16_t const *const IPtr = MPRO + (step * 4);
+		Instruction &op = decoded[step];
+
+		op.TRA   = (IPtr[0] >>  8) & 0x7F;
+		op.TWT   = (IPtr[0] >>  7) & 0x01;
+		op.TWA   = (IPtr[0] >>  0) & 0x7F;
+
+		op.XSEL  = (IPtr[1] >> 15) & 0x01;
+		op.YSEL  = (IPtr[1] >> 13) & 0x03;
+		op.IRA   = (IPtr[1] >>  6) & 0x3F;
+		op.IWT   = (IPtr[1] >>  5) & 0x01;
+		op.IWA   = (IPtr[1] >>  0) & 0x1F;
+
+		op.TABLE = (IPtr[2] >> 15) & 0x01;
+		op.MWT   = (IPtr[2] >> 14) & 0x01;
+		op.MRD   = (IPtr[2] >> 13) & 0x01;
+		op.EWT   = (IPtr[2] >> 12) & 0x01;
+		op.EWA   = (IPtr[2] >>  8) & 0x0F;
+		op.ADRL  = (IPtr[2] >>  7) & 0x01;
+		op.FRCL  = (IPtr[2] >>  6) & 0x01;
+		op.SHIFT = (IPtr[2] >>  4) & 0x03;
+		op.YRL   = (IPtr[2] >>  3) & 0x01;
+		op.NEGB  = (IPtr[2] >>  2) & 0x01;
+		op.ZERO  = (IPtr[2] >>  1) & 0x01;
+		op.BSEL  = (IPtr[2] >>  0) & 0x01;
+
+		op.NOFL  = (IPtr[3] >> 15) & 0x01;  //????
+		op.COEF  = (IPtr[3] >>  9) & 0x3f;
+
+		op.MASA  = (IPtr[3] >>  2) & 0x1f;  //???
+		op.ADREB = (IPtr[3] >>  1) & 0x01;
+		op.NXADR = (IPtr[3] >>  0) & 0x01;
+
+		//memory only allowed on odd? DoA inserts NOPs on even
+		if (!(step & 1))
+			op.MRD = op.MWT = false;
+	}
+
+	// Every step overwrites ACC, but its other results only go where its flags
+	// say.  Working backwards, a step that writes nothing and whose ACC the
+	// next step ignores can't affect the output, so it's left out; that
+	// covers the zeroed steps most programs are padded with.
+	bool live[128];
+	bool acc_read = false;
+	for (int step = LastStep - 1; step >= 0; --step)
+	{
+		Instruction const &op = decoded[step];
+		bool const uses_shifted = op.TWT || op.FRCL || op.MWT || op.EWT || (op.ADRL && op.SHIFT == 3);
+		live[step] = acc_read || uses_shifted || op.IWT || op.YRL || op.ADRL || op.MRD || op.IRA > 0x31;
+		acc_read = live[step] && (uses_shifted || (!op.ZERO && op.BSEL));
+	}
+
+	ProgramLength = 0;
+	for (int step = 0; step < LastStep; ++step)
+		if (live[step])
+			Program[ProgramLength++] = decoded[step];
+	Dirty = false;
 }
 
 void SCSPDSP::Step()
@@ -70,14 +135,10 @@ void SCSPDSP::Step()
 	if (Stopped)
 		return;
 
-	std::fill(std::begin(EFREG), std::end(EFREG), 0);
+	if (Dirty)
+		Compile();
 
-#if 0
-	int dump=0;
-	FILE *f=nullptr;
-	if(dump)
-		f=fopen("dsp.txt","wt");
-#endif
+	std::fill(std::begin(EFREG), std::end(EFREG), 0);
 
 	int32_t ACC = 0;    //26 bit
 	int32_t MEMVAL = 0;
@@ -85,234 +146,157 @@ void SCSPDSP::Step()
 	int32_t Y_REG = 0;      //24 bit
 	uint32_t ADRS_REG = 0;  //13 bit
 
-	for (int step = 0; step < /*128*/LastStep; ++step)
+	for (int i = 0; i < ProgramLength; ++i)
 	{
-		uint16_t *const IPtr = MPRO + (step * 4);
-
-		//if (!IPtr[0] && !IPtr[1] && !IPtr[2] && !IPtr[3])
-			//break;
-
-		uint32_t const TRA   = (IPtr[0] >>  8) & 0x7F;
-		uint32_t const TWT   = (IPtr[0] >>  7) & 0x01;
-		uint32_t const TWA   = (IPtr[0] >>  0) & 0x7F;
-
-		uint32_t const XSEL  = (IPtr[1] >> 15) & 0x01;
-		uint32_t const YSEL  = (IPtr[1] >> 13) & 0x03;
-		uint32_t const IRA   = (IPtr[1] >>  6) & 0x3F;
-		uint32_t const IWT   = (IPtr[1] >>  5) & 0x01;
-		uint32_t const IWA   = (IPtr[1] >>  0) & 0x1F;
-
-		uint32_t const TABLE = (IPtr[2] >> 15) & 0x01;
-		uint32_t const MWT   = (IPtr[2] >> 14) & 0x01;
-		uint32_t const MRD   = (IPtr[2] >> 13) & 0x01;
-		uint32_t const EWT   = (IPtr[2] >> 12) & 0x01;
-		uint32_t const EWA   = (IPtr[2] >>  8) & 0x0F;
-		uint32_t const ADRL  = (IPtr[2] >>  7) & 0x01;
-		uint32_t const FRCL  = (IPtr[2] >>  6) & 0x01;
-		uint32_t const SHIFT = (IPtr[2] >>  4) & 0x03;
-		uint32_t const YRL   = (IPtr[2] >>  3) & 0x01;
-		uint32_t const NEGB  = (IPtr[2] >>  2) & 0x01;
-		uint32_t const ZERO  = (IPtr[2] >>  1) & 0x01;
-		uint32_t const BSEL  = (IPtr[2] >>  0) & 0x01;
-
-		uint32_t const NOFL  = (IPtr[3] >> 15) & 0x01;  //????
-		uint32_t const COEF  = (IPtr[3] >>  9) & 0x3f;
-
-		uint32_t const MASA  = (IPtr[3] >>  2) & 0x1f;  //???
-		uint32_t const ADREB = (IPtr[3] >>  1) & 0x01;
-		uint32_t const NXADR = (IPtr[3] >>  0) & 0x01;
+		Instruction const &op = Program[i];
 
 		//operations are done at 24 bit precision
-#if 0
-		if (MASA)
-			int a=1;
-		if (NOFL)
-			int a=1;
-
-		//int dump=0;
-
-		if (f)
-		{
-#define DUMP(v) fprintf(f, " " #v ": %04X", v);
-			fprintf(f, "%d: ", step);
-			DUMP(ACC);
-			DUMP(SHIFTED);
-			DUMP(X);
-			DUMP(Y);
-			DUMP(B);
-			DUMP(INPUTS);
-			DUMP(MEMVAL);
-			DUMP(FRC_REG);
-			DUMP(Y_REG);
-			DUMP(ADDR);
-			DUMP(ADRS_REG);
-			fprintf(f, "\n");
-#undef DUMP
-		}
-#endif
 
 		//INPUTS RW
 		// colmns97 hits this
-		//assert(IRA < 0x32);
+		//assert(op.IRA < 0x32);
 		int32_t INPUTS; // 24-bit
-		if (IRA <= 0x1f)
-			INPUTS = MEMS[IRA];
-		else if (IRA <= 0x2F)
-			INPUTS = MIXS[IRA - 0x20] << 4;  //MIXS is 20 bit
-		else if (IRA <= 0x31)
-			INPUTS = EXTS[IRA - 0x30] << 8;  //EXTS is 16 bit
+		if (op.IRA <= 0x1f)
+			INPUTS = MEMS[op.IRA];
+		else if (op.IRA <= 0x2F)
+			INPUTS = MIXS[op.IRA - 0x20] << 4;  //MIXS is 20 bit
+		else if (op.IRA <= 0x31)
+			INPUTS = EXTS[op.IRA - 0x30] << 8;  //EXTS is 16 bit
 		else
 			return;
 
 		INPUTS <<= 8;
 		INPUTS >>= 8;
-		//if(INPUTS & 0x00800000)
-			//INPUTS |= 0xFF000000;
 
-		if (IWT)
+		if (op.IWT)
 		{
-			MEMS[IWA] = MEMVAL;  // MEMVAL was selected in previous MRD
-			if (IRA == IWA)
+			MEMS[op.IWA] = MEMVAL;  // MEMVAL was selected in previous MRD
+			if (op.IRA == op.IWA)
 				INPUTS = MEMVAL;
 		}
 
 		//Operand sel
 		int32_t B; // 26-bit
-		if (!ZERO)
+		if (!op.ZERO)
 		{
-			if (BSEL)
+			if (op.BSEL)
 				B = ACC;
 			else
 			{
-				B = TEMP[(TRA + DEC) & 0x7F];
+				B = TEMP[(op.TRA + DEC) & 0x7F];
 				B <<= 8;
 				B >>= 8;
-				//if (B & 0x00800000)
-					//B |= 0xFF000000;  //Sign extend
 			}
-			if (NEGB)
+			if (op.NEGB)
 				B = 0 - B;
 		}
 		else
 			B = 0;
 
 		int32_t X; // 24-bit
-		if (XSEL)
+		if (op.XSEL)
 			X = INPUTS;
 		else
 		{
-			X = TEMP[(TRA + DEC) & 0x7F];
+			X = TEMP[(op.TRA + DEC) & 0x7F];
 			X <<= 8;
 			X >>= 8;
-			//if (X & 0x00800000)
-				//X |= 0xFF000000;
 		}
 
 		int32_t Y = 0;  //13 bit
-		if (YSEL == 0)
+		if (op.YSEL == 0)
 			Y = FRC_REG;
-		else if (YSEL == 1)
-			Y = this->COEF[COEF] >> 3;   //COEF is 16 bits
-		else if (YSEL == 2)
+		else if (op.YSEL == 1)
+			Y = COEF[op.COEF] >> 3;   //COEF is 16 bits
+		else if (op.YSEL == 2)
 			Y = (Y_REG >> 11) & 0x1FFF;
-		else if (YSEL == 3)
+		else if (op.YSEL == 3)
 			Y = (Y_REG >> 4) & 0x0FFF;
 
-		if (YRL)
+		if (op.YRL)
 			Y_REG = INPUTS;
 
 		//Shifter
 		int32_t SHIFTED = 0;    //24 bit
-		if (SHIFT == 0)
+		if (op.SHIFT == 0)
 			SHIFTED = std::max<int32_t>(std::min<int32_t>(ACC, 0x007FFFFF), -0x00800000);
-		else if (SHIFT == 1)
+		else if (op.SHIFT == 1)
 			SHIFTED = std::max<int32_t>(std::min<int32_t>(ACC * 2, 0x007FFFFF), -0x00800000);
-		else if (SHIFT == 2)
+		else if (op.SHIFT == 2)
 		{
 			SHIFTED = ACC * 2;
 			SHIFTED <<= 8;
 			SHIFTED >>= 8;
-			//SHIFTED &= 0x00FFFFFF;
-			//if (SHIFTED & 0x00800000)
-				//SHIFTED |= 0xFF000000;
 		}
-		else if (SHIFT == 3)
+		else if (op.SHIFT == 3)
 		{
 			SHIFTED = ACC;
 			SHIFTED <<= 8;
 			SHIFTED >>= 8;
-			//SHIFTED &= 0x00FFFFFF;
-			//if (SHIFTED & 0x00800000)
-				//SHIFTED |= 0xFF000000;
 		}
 
 		//ACCUM
 		Y <<= 19;
 		Y >>= 19;
-		//if (Y & 0x1000)
-			//Y |= 0xFFFFF000;
 
 		int64_t const v = (int64_t(X) * int64_t(Y)) >> 12;
 		ACC = int(v + B);
 
-		if (TWT)
-			TEMP[(TWA + DEC) & 0x7F] = SHIFTED;
+		if (op.TWT)
+			TEMP[(op.TWA + DEC) & 0x7F] = SHIFTED;
 
-		if (FRCL)
+		if (op.FRCL)
 		{
-			if (SHIFT == 3)
+			if (op.SHIFT == 3)
 				FRC_REG = SHIFTED & 0x0FFF;
 			else
 				FRC_REG = (SHIFTED >> 11) & 0x1FFF;
 		}
 
-		if (MRD || MWT)
-		//if (0)
+		if (op.MRD || op.MWT)
 		{
-			uint32_t ADDR = MADRS[MASA];
-			if (!TABLE)
+			uint32_t ADDR = MADRS[op.MASA];
+			if (!op.TABLE)
 				ADDR += DEC;
-			if (ADREB)
+			if (op.ADREB)
 				ADDR += ADRS_REG & 0x0FFF;
-			if (NXADR)
+			if (op.NXADR)
 				ADDR++;
-			if (!TABLE)
+			if (!op.TABLE)
 				ADDR &= RBL - 1;
 			else
 				ADDR &= 0xFFFF;
 			ADDR += RBP << 12;
 			ADDR <<= 1;
-			if (MRD && (step & 1)) //memory only allowed on odd? DoA inserts NOPs on even
+			if (op.MRD)
 			{
-				if (NOFL)
+				if (op.NOFL)
 					MEMVAL = space->read_word(ADDR) << 8;
 				else
 					MEMVAL = UNPACK(space->read_word(ADDR));
 			}
-			if (MWT && (step & 1))
+			if (op.MWT)
 			{
-				if (NOFL)
+				if (op.NOFL)
 					space->write_word(ADDR, SHIFTED >> 8);
 				else
 					space->write_word(ADDR, PACK(SHIFTED));
 			}
 		}
 
-		if (ADRL)
+		if (op.ADRL)
 		{
-			if (SHIFT == 3)
+			if (op.SHIFT == 3)
 				ADRS_REG = (SHIFTED >> 12) & 0xFFF;
 			else
 				ADRS_REG = INPUTS >> 16;
 		}
 
-		if (EWT)
-			EFREG[EWA] += SHIFTED >> 8;
+		if (op.EWT)
+			EFREG[op.EWA] += SHIFTED >> 8;
 	}
 	--DEC;
 	std::fill(std::begin(MIXS), std::end(MIXS), 0);
-	//if (f)
-		//fclose(f);
 }
 
 void SCSPDSP::SetSample(int32_t sample, int SEL, int MXL)
@@ -334,4 +318,5 @@ void SCSPDSP::Start()
 			break;
 	}
 	LastStep = i + 1;
+	Dirty = true;
 }
@@ -32,10 +32,24 @@ struct SCSPDSP
 	bool Stopped;
 	int LastStep;
 
+//program, decoded from MPRO so Step() doesn't pick the fields apart every sample
+	struct Instruction
+	{
+		uint8_t TRA, TWA, IRA, IWA, EWA, COEF, MASA, YSEL, SHIFT;
+		bool TWT, XSEL, IWT, TABLE, MWT, MRD, EWT, ADRL, FRCL, YRL, NEGB, ZERO, BSEL, NOFL, ADREB, NXADR;
+	};
+	Instruction Program[128];
+	int ProgramLength;
+	bool Dirty;           //MPRO or LastStep changed since the last Compile()
+
 	void Init();
 	void SetSample(int32_t sample, int32_t SEL, int32_t MXL);
 	void Step();
 	void Start();
+	void Invalidate() { Dirty = true; }
+
+private:
+	void Compile();
 };
 
 #endif // MAME_SOUND_SCSPDSP_H
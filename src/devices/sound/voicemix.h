@@ -0,0 +1,109 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    voicemix.h
+
+    Block mixing for sample-playback chips.  A chip renders one voice
+    for a whole update into a scratch buffer, then adds it to its
+    output accumulators here, several samples at a time.
+
+    The arithmetic is the chips' own: each sample is multiplied by its
+    volume with 32-bit wraparound and shifted right arithmetically, so
+    the results are identical to the scalar loops they replace.
+
+***************************************************************************/
+
+#ifndef MAME_SOUND_VOICEMIX_H
+#define MAME_SOUND_VOICEMIX_H
+
+#pragma once
+
+// vectorise under the same conditions as rgbutil.h
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define VOICEMIX_USE_SSE2   1
+#else
+#define VOICEMIX_USE_SSE2   0
+#endif
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> voice_mixer
+
+class voice_mixer
+{
+public:
+	// dest[i] += (samples[i] * volume) >> shift
+	static void add(s32 *dest, const s32 *samples, s32 volume, int shift, int count)
+	{
+		int i = 0;
+#if VOICEMIX_USE_SSE2
+		__m128i const vol = _mm_set1_epi32(volume);
+		__m128i const sh = _mm_cvtsi32_si128(shift);
+		for ( ; i + 4 <= count; i += 4)
+		{
+			__m128i const product = _mm_sra_epi32(mul32(_mm_loadu_si128((const __m128i *)&samples[i]), vol), sh);
+			_mm_storeu_si128((__m128i *)&dest[i], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&dest[i]), product));
+		}
+#endif
+		for ( ; i < count; i++)
+			dest[i] += (samples[i] * volume) >> shift;
+	}
+
+	// left and right outputs of one voice in a single pass
+	static void add_stereo(s32 *ldest, s32 *rdest, const s32 *samples, s32 lvol, s32 rvol, int shift, int count)
+	{
+		int i = 0;
+#if VOICEMIX_USE_SSE2
+		__m128i const lv = _mm_set1_epi32(lvol);
+		__m128i const rv = _mm_set1_epi32(rvol);
+		__m128i const sh = _mm_cvtsi32_si128(shift);
+		for ( ; i + 4 <= count; i += 4)
+		{
+			__m128i const sample = _mm_loadu_si128((const __m128i *)&samples[i]);
+			__m128i const left = _mm_sra_epi32(mul32(sample, lv), sh);
+			__m128i const right = _mm_sra_epi32(mul32(sample, rv), sh);
+			_mm_storeu_si128((__m128i *)&ldest[i], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&ldest[i]), left));
+			_mm_storeu_si128((__m128i *)&rdest[i], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&rdest[i]), right));
+		}
+#endif
+		for ( ; i < count; i++)
+		{
+			ldest[i] += (samples[i] * lvol) >> shift;
+			rdest[i] += (samples[i] * rvol) >> shift;
+		}
+	}
+
+	// dest[i] += (samples[i] * volumes[i]) >> shift, for voices whose volume ramps
+	static void add_ramped(s32 *dest, const s32 *samples, const s32 *volumes, int shift, int count)
+	{
+		int i = 0;
+#if VOICEMIX_USE_SSE2
+		__m128i const sh = _mm_cvtsi32_si128(shift);
+		for ( ; i + 4 <= count; i += 4)
+		{
+			__m128i const product = _mm_sra_epi32(mul32(_mm_loadu_si128((const __m128i *)&samples[i]), _mm_loadu_si128((const __m128i *)&volumes[i])), sh);
+			_mm_storeu_si128((__m128i *)&dest[i], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&dest[i]), product));
+		}
+#endif
+		for ( ; i < count; i++)
+			dest[i] += (samples[i] * volumes[i]) >> shift;
+	}
+
+private:
+#if VOICEMIX_USE_SSE2
+	// low 32 bits of each lane's product; SSE2 only multiplies the even lanes, so do the odd ones shifted down
+	static __m128i mul32(__m128i a, __m128i b)
+	{
+		__m128i const even = _mm_mul_epu32(a, b);
+		__m128i const odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+		return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+	}
+#endif
+};
+
+#endif // MAME_SOUND_VOICEMIX_H
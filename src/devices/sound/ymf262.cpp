@@ -58,6 +58,14 @@ differences between OPL2 and OPL3 shown in datasheets:
 #include "emu.h"
 #include "ymf262.h"
 
+/* the output mix has an SSE2 path under the same conditions as rgbutil.h; it relies on 16-bit output */
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64) && (OPL3_SAMPLE_BITS==16)
+#include <emmintrin.h>
+#define YMF262_USE_SSE2 1
+#else
+#define YMF262_USE_SSE2 0
+#endif
+
 
 /* output final shift */
 #if (OPL3_SAMPLE_BITS==16)
@@ -120,6 +128,10 @@ namespace {
 /*#define SAVE_SAMPLE*/
 
 #ifdef SAVE_SAMPLE
+/* saving needs the scalar mix's per-sample outputs */
+#undef YMF262_USE_SSE2
+#define YMF262_USE_SSE2 0
+
 static FILE *sample[1];
 	#if 1   /*save to MONO file */
 		#define SAVE_ALL_CHANNELS \
@@ -2615,9 +2627,15 @@ void ymf262_update_one(void *_chip, OPL3SAMPLE **buffers, int length)
 	OPL3SAMPLE  *ch_c = buffers[2];
 	OPL3SAMPLE  *ch_d = buffers[3];
 
+#if YMF262_USE_SSE2
+	__m128i mixed[4];
+#endif
+
 	for( i=0; i < length ; i++ )
 	{
+#if !YMF262_USE_SSE2
 		int a,b,c,d;
+#endif
 
 
 		advance_lfo(chip);
@@ -2687,6 +2705,29 @@ void ymf262_update_one(void *_chip, OPL3SAMPLE **buffers, int length)
 		chan_calc(chip, &chip->P_CH[17]);
 #endif
 
+#if YMF262_USE_SSE2
+		/* the pan masks are four per channel in A,B,C,D order, so one vector accumulates all four outputs */
+		__m128i acc = _mm_and_si128(_mm_set1_epi32(chanout[0]), _mm_loadu_si128((const __m128i *)&chip->pan[0]));
+		for (int ch = 1; ch < 18; ch++)
+			acc = _mm_add_epi32(acc, _mm_and_si128(_mm_set1_epi32(chanout[ch]), _mm_loadu_si128((const __m128i *)&chip->pan[ch * 4])));
+
+		/* limit check: saturate to 16 bits and sign extend back */
+		acc = _mm_packs_epi32(acc, acc);
+		mixed[i & 3] = _mm_srai_epi32(_mm_unpacklo_epi16(acc, acc), 16);
+
+		/* store every four samples to the sound buffers, transposing them to one vector per output */
+		if ((i & 3) == 3)
+		{
+			__m128i const ab01 = _mm_unpacklo_epi32(mixed[0], mixed[1]);
+			__m128i const ab23 = _mm_unpacklo_epi32(mixed[2], mixed[3]);
+			__m128i const cd01 = _mm_unpackhi_epi32(mixed[0], mixed[1]);
+			__m128i const cd23 = _mm_unpackhi_epi32(mixed[2], mixed[3]);
+			_mm_storeu_si128((__m128i *)&ch_a[i - 3], _mm_unpacklo_epi64(ab01, ab23));
+			_mm_storeu_si128((__m128i *)&ch_b[i - 3], _mm_unpackhi_epi64(ab01, ab23));
+			_mm_storeu_si128((__m128i *)&ch_c[i - 3], _mm_unpacklo_epi64(cd01, cd23));
+			_mm_storeu_si128((__m128i *)&ch_d[i - 3], _mm_unpackhi_epi64(cd01, cd23));
+		}
+#else
 		/* accumulator register set #1 */
 		a =  chanout[0] & chip->pan[0];
 		b =  chanout[0] & chip->pan[1];
@@ -2792,7 +2833,21 @@ void ymf262_update_one(void *_chip, OPL3SAMPLE **buffers, int length)
 		ch_c[i] = c;
 		ch_d[i] = d;
 
+#endif
+
 		advance(chip);
 	}
 
+#if YMF262_USE_SSE2
+	/* store the samples left over from the last group of four */
+	for (int j = length & ~3; j < length; j++)
+	{
+		int32_t out[4];
+		_mm_storeu_si128((__m128i *)out, mixed[j & 3]);
+		ch_a[j] = out[0];
+		ch_b[j] = out[1];
+		ch_c[j] = out[2];
+		ch_d[j] = out[3];
+	}
+#endif
 }
@@ -32,6 +32,7 @@
 
 #include "emu.h"
 #include "ymz280b.h"
+#include "voicemix.h"
 
 #if YMZ280B_MAKE_WAVS
 #include "sound/wavwrite.h"
@@ -425,6 +426,8 @@ void ymz280b_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 	/* clear out the accumulator */
 	memset(lacc, 0, samples * sizeof(lacc[0]));
 	memset(racc, 0, samples * sizeof(racc[0]));
+	if (m_voice_mix.size() < samples)
+		m_voice_mix.resize(samples);
 
 	/* loop over voices */
 	for (v = 0; v < 8; v++)
@@ -433,8 +436,7 @@ void ymz280b_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 		int16_t prev = voice->last_sample;
 		int16_t curr = voice->curr_sample;
 		int16_t *curr_data = m_scratch.get();
-		int32_t *ldest = lacc;
-		int32_t *rdest = racc;
+		int32_t *mix = &m_voice_mix[0];
 		uint32_t new_samples, samples_left;
 		uint32_t final_pos;
 		int remaining = samples;
@@ -454,9 +456,7 @@ void ymz280b_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 		/* interpolate */
 		while (remaining > 0 && voice->output_pos < FRAC_ONE)
 		{
-			int interp_sample = (((int32_t)prev * (FRAC_ONE - voice->output_pos)) + ((int32_t)curr * voice->output_pos)) >> FRAC_BITS;
-			*ldest++ += interp_sample * lvol;
-			*rdest++ += interp_sample * rvol;
+			*mix++ = (((int32_t)prev * (FRAC_ONE - voice->output_pos)) + ((int32_t)curr * voice->output_pos)) >> FRAC_BITS;
 			voice->output_pos += voice->output_step;
 			remaining--;
 		}
@@ -465,7 +465,10 @@ void ymz280b_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 		if (voice->output_pos >= FRAC_ONE)
 			voice->output_pos -= FRAC_ONE;
 		else
+		{
+			voice_mixer::add_stereo(lacc, racc, &m_voice_mix[0], lvol, rvol, 0, mix - &m_voice_mix[0]);
 			continue;
+		}
 
 		/* compute how many new samples we need */
 		final_pos = voice->output_pos + remaining * voice->output_step;
@@ -518,9 +521,7 @@ void ymz280b_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 			/* interpolate */
 			while (remaining > 0 && voice->output_pos < FRAC_ONE)
 			{
-				int interp_sample = (((int32_t)prev * (FRAC_ONE - voice->output_pos)) + ((int32_t)curr * voice->output_pos)) >> FRAC_BITS;
-				*ldest++ += interp_sample * lvol;
-				*rdest++ += interp_sample * rvol;
+				*mix++ = (((int32_t)prev * (FRAC_ONE - voice->output_pos)) + ((int32_t)curr * voice->output_pos)) >> FRAC_BITS;
 				voice->output_pos += voice->output_step;
 				remaining--;
 			}
@@ -537,6 +538,9 @@ void ymz280b_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 		/* remember the last samples */
 		voice->last_sample = prev;
 		voice->curr_sample = curr;
+
+		/* apply the volumes and add the voice in */
+		voice_mixer::add_stereo(lacc, racc, &m_voice_mix[0], lvol, rvol, 0, mix - &m_voice_mix[0]);
 	}
 
 	for (v = 0; v < samples; v++)
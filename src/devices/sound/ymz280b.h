@@ -107,6 +107,7 @@ private:
 	double m_master_clock;            /* master clock frequency */
 	sound_stream *m_stream;           /* which stream are we using */
 	std::unique_ptr<int16_t[]> m_scratch;
+	std::vector<int32_t> m_voice_mix;   /* one voice's interpolated samples for an update */
 #if YMZ280B_MAKE_WAVS
 	void *m_wavresample;              /* resampled waveform */
 #endif
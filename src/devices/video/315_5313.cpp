@@ -2526,116 +2526,73 @@ void sega315_5313_device::render_videoline_to_videobuffer(int scanline)
 		/* END */
 
 /* MEGADRIVE_REG0C_SHADOW_HIGLIGHT */
-		/* Low Priority Sprites */
+	/* Low Priority Sprites, High Priority A+B Tiles and High Priority Sprites, merged in a single pass */
+	if (!MEGADRIVE_REG0C_SHADOW_HIGLIGHT)
+	{
 		for (x=0;x<320;x++)
 		{
-			if (!MEGADRIVE_REG0C_SHADOW_HIGLIGHT)
-			{
-				if (m_sprite_renderline[x+128] & 0x40)
-				{
-					m_video_renderline[x] = m_sprite_renderline[x+128]&0x3f;
-					m_video_renderline[x] |= 0x10000; // mark as sprite pixel
-				}
-			}
-			else
-			{   /* Special Shadow / Highlight processing */
+			uint8_t const spritedat = m_sprite_renderline[x+128];
+			uint8_t const highpri = m_highpri_renderline[x];
+			uint32_t dat = m_video_renderline[x];
 
-				if (m_sprite_renderline[x+128] & 0x40)
-				{
-					uint8_t spritedata;
-					spritedata = m_sprite_renderline[x+128]&0x3f;
+			if (spritedat & 0x40)
+				dat = (spritedat & 0x3f) | 0x10000; // mark as sprite pixel
 
-					if ((spritedata==0x0e) || (spritedata==0x1e) || (spritedata==0x2e))
-					{
-						/* BUG in sprite chip, these colours are always normal intensity */
-						m_video_renderline[x] = spritedata | 0x4000;
-						m_video_renderline[x] |= 0x10000; // mark as sprite pixel
-					}
-					else if (spritedata==0x3e)
-					{
-						/* Everything below this is half colour, mark with 0x8000 to mark highlight' */
-						m_video_renderline[x] = m_video_renderline[x]|0x8000; // spiderwebs..
-					}
-					else if (spritedata==0x3f)
-					{
-						/* This is a Shadow operator, but everything below is already low pri, no effect */
-						m_video_renderline[x] = m_video_renderline[x]|0x2000;
+			if ((highpri & 0x80) && (highpri & 0x0f))
+				dat = highpri & 0x3f;
 
-					}
-					else
-					{
-						m_video_renderline[x] = spritedata;
-						m_video_renderline[x] |= 0x10000; // mark as sprite pixel
-					}
+			if (spritedat & 0x80)
+				dat = (spritedat & 0x3f) | 0x10000; // mark as sprite pixel
 
-				}
-			}
+			m_video_renderline[x] = dat;
 		}
-		/* High Priority A+B Tiles */
+	}
+	else
+	{
 		for (x=0;x<320;x++)
 		{
-			if (!MEGADRIVE_REG0C_SHADOW_HIGLIGHT)
-			{
-				/* Normal Processing */
-				int dat;
-				dat = m_highpri_renderline[x];
+			uint8_t const spritedat = m_sprite_renderline[x+128];
+			uint8_t const highpri = m_highpri_renderline[x];
+			uint32_t dat = m_video_renderline[x];
 
-				if (dat&0x80)
-				{
-						if (dat&0x0f) m_video_renderline[x] = m_highpri_renderline[x]&0x3f;
-				}
-			}
-			else
+			/* Special Shadow / Highlight processing */
+			if (spritedat & 0x40)
 			{
-				/* Shadow / Highlight Mode */
-				int dat;
-				dat = m_highpri_renderline[x];
-
-				if (dat&0x80)
-				{
-						if (dat&0x0f) m_video_renderline[x] = (m_highpri_renderline[x]&0x3f) | 0x4000;
-						else m_video_renderline[x] = m_video_renderline[x] | 0x4000; // set 'normal'
-				}
+				uint8_t const spritedata = spritedat & 0x3f;
+
+				if ((spritedata==0x0e) || (spritedata==0x1e) || (spritedata==0x2e))
+					dat = spritedata | 0x4000 | 0x10000; /* BUG in sprite chip, these colours are always normal intensity */
+				else if (spritedata==0x3e)
+					dat |= 0x8000; /* Everything below this is half colour, mark with 0x8000 to mark highlight' */
+				else if (spritedata==0x3f)
+					dat |= 0x2000; /* This is a Shadow operator, but everything below is already low pri, no effect */
+				else
+					dat = spritedata | 0x10000; // mark as sprite pixel
 			}
-		}
 
-		/* High Priority Sprites */
-		for (x=0;x<320;x++)
-		{
-			if (!MEGADRIVE_REG0C_SHADOW_HIGLIGHT)
+			if (highpri & 0x80)
 			{
-				/* Normal */
-				if (m_sprite_renderline[x+128] & 0x80)
-				{
-					m_video_renderline[x] = m_sprite_renderline[x+128]&0x3f;
-					m_video_renderline[x] |= 0x10000; // mark as sprite pixel
-				}
+				if (highpri & 0x0f)
+					dat = (highpri & 0x3f) | 0x4000;
+				else
+					dat |= 0x4000; // set 'normal'
 			}
-			else
+
+			if (spritedat & 0x80)
 			{
-				if (m_sprite_renderline[x+128] & 0x80)
-				{
-					uint8_t spritedata;
-					spritedata = m_sprite_renderline[x+128]&0x3f;
+				uint8_t const spritedata = spritedat & 0x3f;
 
-					if (spritedata==0x3e)
-					{
-						/* set flag 0x8000 to indicate highlight */
-						m_video_renderline[x] = m_video_renderline[x]|0x8000;
-					}
-					else if (spritedata==0x3f)
-					{
-						/* This is a Shadow operator set shadow bit */
-						m_video_renderline[x] = m_video_renderline[x]|0x2000;
-					}
-					else
-					{
-						m_video_renderline[x] = spritedata | 0x4000;
-						m_video_renderline[x] |= 0x10000; // mark as sprite pixel
-					}
-				}
+				if (spritedata==0x3e)
+					dat |= 0x8000; /* set flag 0x8000 to indicate highlight */
+				else if (spritedata==0x3f)
+					dat |= 0x2000; /* This is a Shadow operator set shadow bit */
+				else
+					dat = spritedata | 0x4000 | 0x10000; // mark as sprite pixel
 			}
+
+			m_video_renderline[x] = dat;
 		}
+	}
 }
 
 
@@ -2657,71 +2614,44 @@ void sega315_5313_device::render_videobuffer_to_screenbuffer(int scanline)
 	else
 		lineptr = m_render_line.get();
 
-	for (int x = 0; x < 320; x++)
+	/* palette used for each combination of the sprite, highlight, normal and shadow flags when shadow/highlight is enabled
+	   0 = shadow, 1 = normal, 2 = sprite, 3 = highlight, 4 = not possible; the raw line uses the index as its intensity bits */
+	static const uint8_t shadow_highlight_palette[16] =
 	{
-		uint32_t dat = m_video_renderline[x];
-
-		if (!(dat & 0x20000))
-			m_render_line_raw[x] = 0x100;
-		else
-			m_render_line_raw[x] = 0x000;
-
-
-		if (!MEGADRIVE_REG0C_SHADOW_HIGLIGHT)
+		0, 0, 1, 0, 1, 4, 3, 4,     // verify my handling.. I'm not sure all cases are correct
+		0, 0, 2, 0, 2, 4, 3, 4
+	};
+	uint16_t const *const palettes[4] = {
+			m_palette_lookup_shadow.get(),
+			m_palette_lookup.get(),
+			m_palette_lookup_sprite.get(),
+			m_palette_lookup_highlight.get() };
+
+	if (!MEGADRIVE_REG0C_SHADOW_HIGLIGHT)
+	{
+		for (int x = 0; x < 320; x++)
 		{
-			if (dat & 0x10000)
+			uint32_t const dat = m_video_renderline[x];
+			int const palette = (dat & 0x10000) ? 2 : 1;
+			lineptr[x] = palettes[palette][dat & 0x3f];
+			m_render_line_raw[x] = ((dat & 0x20000) ? 0x000 : 0x100) | (palette << 6) | (dat & 0x3f);
+		}
+	}
+	else
+	{
+		for (int x = 0; x < 320; x++)
+		{
+			uint32_t const dat = m_video_renderline[x];
+			int const palette = shadow_highlight_palette[(dat >> 13) & 0x0f];
+			uint16_t const bg = (dat & 0x20000) ? 0x000 : 0x100;
+			if (palette < 4)
 			{
-				lineptr[x] = m_palette_lookup_sprite[(dat & 0x3f)];
-				m_render_line_raw[x] |= (dat & 0x3f) | 0x080;
+				lineptr[x] = palettes[palette][dat & 0x3f];
+				m_render_line_raw[x] = bg | (palette << 6) | (dat & 0x3f);
 			}
 			else
 			{
-				lineptr[x] = m_palette_lookup[(dat & 0x3f)];
-				m_render_line_raw[x] |= (dat & 0x3f) | 0x040;
-			}
-
-		}
-		else
-		{
-			/* Verify my handling.. I'm not sure all cases are correct */
-			switch (dat & 0x1e000)
-			{
-				case 0x00000: // low priority, no shadow sprite, no highlight = shadow
-				case 0x02000: // low priority, shadow sprite, no highlight = shadow
-				case 0x06000: // normal pri,   shadow sprite, no highlight = shadow?
-				case 0x10000: // (sprite) low priority, no shadow sprite, no highlight = shadow
-				case 0x12000: // (sprite) low priority, shadow sprite, no highlight = shadow
-				case 0x16000: // (sprite) normal pri,   shadow sprite, no highlight = shadow?
-					lineptr[x] = m_palette_lookup_shadow[(dat & 0x3f)];
-					m_render_line_raw[x] |= (dat & 0x3f) | 0x000;
-					break;
-
-				case 0x4000: // normal pri, no shadow sprite, no highlight = normal;
-				case 0x8000: // low pri, highlight sprite = normal;
-					lineptr[x] = m_palette_lookup[(dat & 0x3f)];
-					m_render_line_raw[x] |= (dat & 0x3f) | 0x040;
-					break;
-
-				case 0x14000: // (sprite) normal pri, no shadow sprite, no highlight = normal;
-				case 0x18000: // (sprite) low pri, highlight sprite = normal;
-					lineptr[x] = m_palette_lookup_sprite[(dat & 0x3f)];
-					m_render_line_raw[x] |= (dat & 0x3f) | 0x080;
-					break;
-
-
-				case 0x0c000: // normal pri, highlight set = highlight?
-				case 0x1c000: // (sprite) normal pri, highlight set = highlight?
-					lineptr[x] = m_palette_lookup_highlight[(dat & 0x3f)];
-					m_render_line_raw[x] |= (dat & 0x3f) | 0x0c0;
-					break;
-
-				case 0x0a000: // shadow set, highlight set - not possible
-				case 0x0e000: // shadow set, highlight set, normal set, not possible
-				case 0x1a000: // (sprite)shadow set, highlight set - not possible
-				case 0x1e000: // (sprite)shadow set, highlight set, normal set, not possible
-				default:
-					lineptr[x] = m_render_line_raw[x] |= (machine().rand() & 0x3f);
-					break;
+				lineptr[x] = m_render_line_raw[x] = bg | (machine().rand() & 0x3f);
 			}
 		}
 	}
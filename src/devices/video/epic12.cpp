@@ -5,6 +5,8 @@
 #include "emu.h"
 #include "epic12.h"
 
+#include <algorithm>
+
 
 DEFINE_DEVICE_TYPE(EPIC12, epic12_device, "epic12", "EPIC12 Blitter")
 
@@ -29,6 +31,9 @@ epic12_device::epic12_device(const machine_config &mconfig, const char *tag, dev
 	m_gfx_scroll_0_y_shadowcopy = 0;
 	m_gfx_scroll_1_x_shadowcopy = 0;
 	m_gfx_scroll_1_y_shadowcopy = 0;
+	m_blit_dirty.set(0, -1, 0, -1);
+	std::fill(std::begin(m_blit_mode_blits), std::end(m_blit_mode_blits), 0);
+	std::fill(std::begin(m_blit_mode_pixels), std::end(m_blit_mode_pixels), 0);
 	blit_delay = 0;
 }
 
@@ -105,6 +110,26 @@ void epic12_device::device_reset()
 	m_blitter_busy = 0;
 }
 
+void epic12_device::device_stop()
+{
+	wait_for_blitter();
+
+	// list the blit modes used, busiest first
+	std::vector<int> modes;
+	for (int mode = 0; mode < BLIT_MODES; mode++)
+		if (m_blit_mode_blits[mode])
+			modes.push_back(mode);
+	std::sort(modes.begin(), modes.end(), [this] (int a, int b) { return m_blit_mode_pixels[a] > m_blit_mode_pixels[b]; });
+
+	for (int mode : modes)
+	{
+		if (mode & 0x008)
+			logerror("blit flipx %d tinted %d trans %d s_mode %d d_mode %d: %u blits, %u pixels\n", mode & 1, (mode >> 1) & 1, (mode >> 2) & 1, (mode >> 4) & 7, (mode >> 7) & 7, m_blit_mode_blits[mode], m_blit_mode_pixels[mode]);
+		else
+			logerror("blit flipx %d tinted %d trans %d unblended: %u blits, %u pixels\n", mode & 1, (mode >> 1) & 1, (mode >> 2) & 1, m_blit_mode_blits[mode], m_blit_mode_pixels[mode]);
+	}
+}
+
 // todo, get these into the device class without ruining performance
 uint8_t epic12_device::colrtable[0x20][0x40];
 uint8_t epic12_device::colrtable_rev[0x20][0x40];
@@ -137,17 +162,23 @@ inline uint16_t epic12_device::COPY_NEXT_WORD(address_space &space, offs_t *addr
 
 inline void epic12_device::gfx_upload_shadow_copy(address_space &space, offs_t *addr)
 {
-	uint32_t x,y, dimx,dimy;
-	COPY_NEXT_WORD(space, addr);
-	COPY_NEXT_WORD(space, addr);
+	uint32_t x,y, dst_x_start,dst_y_start, dimx,dimy;
 	COPY_NEXT_WORD(space, addr);
 	COPY_NEXT_WORD(space, addr);
 	COPY_NEXT_WORD(space, addr);
 	COPY_NEXT_WORD(space, addr);
+	dst_x_start = COPY_NEXT_WORD(space, addr) & 0x1fff;
+	dst_y_start = COPY_NEXT_WORD(space, addr) & 0x0fff;
 
 	dimx = (COPY_NEXT_WORD(space, addr) & 0x1fff) + 1;
 	dimy = (COPY_NEXT_WORD(space, addr) & 0x0fff) + 1;
 
+	// rows that run off the right edge carry on into the next row
+	if (dst_x_start + dimx > 0x2000)
+		mark_blit_dirty(rectangle(0, 0x2000-1, dst_y_start, dst_y_start + dimy));
+	else
+		mark_blit_dirty(rectangle(dst_x_start, dst_x_start + dimx - 1, dst_y_start, dst_y_start + dimy - 1));
+
 	for (y = 0; y < dimy; y++)
 	{
 		for (x = 0; x < dimx; x++)
@@ -310,13 +341,17 @@ inline void epic12_device::gfx_draw_shadow_copy(address_space &space, offs_t *ad
 	COPY_NEXT_WORD(space, addr);
 	COPY_NEXT_WORD(space, addr);
 	COPY_NEXT_WORD(space, addr);
-	COPY_NEXT_WORD(space, addr); // uint16_t dst_x_start  =   COPY_NEXT_WORD(space, addr);
-	COPY_NEXT_WORD(space, addr); // uint16_t dst_y_start  =   COPY_NEXT_WORD(space, addr);
+	uint16_t dst_x_start  =   COPY_NEXT_WORD(space, addr);
+	uint16_t dst_y_start  =   COPY_NEXT_WORD(space, addr);
 	uint16_t w        =   COPY_NEXT_WORD(space, addr);
 	uint16_t h        =   COPY_NEXT_WORD(space, addr);
 	COPY_NEXT_WORD(space, addr);
 	COPY_NEXT_WORD(space, addr);
 
+	// the draw is clipped inside this, so it bounds what the blit can change
+	const int x = (dst_x_start & 0x7fff) - (dst_x_start & 0x8000);
+	const int y = (dst_y_start & 0x7fff) - (dst_y_start & 0x8000);
+	mark_blit_dirty(rectangle(x, x + (w & 0x1fff), y, y + (h & 0x0fff)));
 
 
 	// todo, calcualte clipping.
@@ -397,6 +432,11 @@ inline void epic12_device::gfx_draw(offs_t *addr)
 	if ((s_mode==0 && s_alpha==0x1f) && (d_mode==4 && d_alpha==0x1f))
 		blend = 0;
 
+	// count what each mode is used for, so the busy ones can be found and specialised
+	const int mode = (flipx ? 0x001 : 0) | (tinted ? 0x002 : 0) | (trans ? 0x004 : 0) | (blend ? (0x008 | (s_mode << 4) | (d_mode << 7)) : 0);
+	m_blit_mode_blits[mode]++;
+	m_blit_mode_pixels[mode] += dimx * dimy;
+
 	if (tinted)
 	{
 		if (!flipx)
@@ -546,6 +586,7 @@ void epic12_device::gfx_create_shadow_copy(address_space &space)
 {
 	offs_t addr = m_gfx_addr & 0x1fffffff;
 	m_clip.set(m_gfx_scroll_1_x_shadowcopy, m_gfx_scroll_1_x_shadowcopy + 320-1, m_gfx_scroll_1_y_shadowcopy, m_gfx_scroll_1_y_shadowcopy + 240-1);
+	m_blit_dirty.set(0, -1, 0, -1);
 
 	while (1)
 	{
@@ -711,15 +752,7 @@ WRITE32_MEMBER( epic12_device::gfx_exec_w )
 		{
 			//g_profiler.start(PROFILER_USER1);
 			// make sure we've not already got a request running
-			if (m_blitter_request)
-			{
-				int result;
-				do
-				{
-					result = osd_work_item_wait(m_blitter_request, 1000);
-				} while (result==0);
-				osd_work_item_release(m_blitter_request);
-			}
+			wait_for_blitter();
 
 			blit_delay = 0;
 			gfx_create_shadow_copy(space); // create a copy of the blit list so we can safely thread it.
@@ -750,15 +783,7 @@ WRITE32_MEMBER( epic12_device::gfx_exec_w_unsafe )
 		{
 			//g_profiler.start(PROFILER_USER1);
 			// make sure we've not already got a request running
-			if (m_blitter_request)
-			{
-				int result;
-				do
-				{
-					result = osd_work_item_wait(m_blitter_request, 1000);
-				} while (result==0);
-				osd_work_item_release(m_blitter_request);
-			}
+			wait_for_blitter();
 
 			if (blit_delay)
 			{
@@ -779,20 +804,65 @@ WRITE32_MEMBER( epic12_device::gfx_exec_w_unsafe )
 }
 
 
-void epic12_device::draw_screen(bitmap_rgb32 &bitmap, const rectangle &cliprect )
+void epic12_device::wait_for_blitter()
 {
-	if (!m_is_unsafe)
+	if (m_blitter_request)
 	{
-		if (m_blitter_request)
+		int result;
+		do
 		{
-			int result;
-			do
-			{
-				result = osd_work_item_wait(m_blitter_request, 1000);
-			} while (result==0);
-			osd_work_item_release(m_blitter_request);
-		}
+			result = osd_work_item_wait(m_blitter_request, 1000);
+		} while (result==0);
+		osd_work_item_release(m_blitter_request);
+		m_blitter_request = nullptr;
 	}
+}
+
+
+void epic12_device::mark_blit_dirty(rectangle rect)
+{
+	rect &= m_bitmaps->cliprect();
+	if (rect.empty())
+		return;
+
+	if (m_blit_dirty.empty())
+		m_blit_dirty = rect;
+	else
+		m_blit_dirty |= rect;
+}
+
+
+// does [start, start + length) taken modulo size share any position with [low, high]?
+static inline bool wrapped_span_overlaps(int start, int length, int size, int low, int high)
+{
+	if (length >= size)
+		return true;
+
+	const int end = start + length - 1;
+	if (end < size)
+		return (start <= high) && (end >= low);
+	return (start <= high) || ((end - size) >= low);
+}
+
+
+bool epic12_device::blit_dirty_visible(const rectangle &cliprect) const
+{
+	if (!m_blitter_request || m_blit_dirty.empty())
+		return false;
+
+	// the screen shows the VRAM at scroll 0, wrapping round its edges
+	const int src_x = (cliprect.min_x + m_gfx_scroll_0_x) & 0x1fff;
+	const int src_y = (cliprect.min_y + m_gfx_scroll_0_y) & 0x0fff;
+	return wrapped_span_overlaps(src_x, cliprect.width(), 0x2000, m_blit_dirty.min_x, m_blit_dirty.max_x)
+		&& wrapped_span_overlaps(src_y, cliprect.height(), 0x1000, m_blit_dirty.min_y, m_blit_dirty.max_y);
+}
+
+
+void epic12_device::draw_screen(bitmap_rgb32 &bitmap, const rectangle &cliprect )
+{
+	// only wait for the blit list if it can draw somewhere we're about to show
+	if (!m_is_unsafe && blit_dirty_visible(cliprect))
+		wait_for_blitter();
 
 	int scroll_0_x, scroll_0_y;
 //  int scroll_1_x, scroll_1_y;
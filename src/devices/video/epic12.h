@@ -819,11 +819,22 @@ protected:
 
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 
 	TIMER_CALLBACK_MEMBER( blitter_delay_callback );
 
+	void wait_for_blitter();
+	void mark_blit_dirty(rectangle rect);
+	bool blit_dirty_visible(const rectangle &cliprect) const;
+
 	osd_work_queue *m_work_queue;
 	osd_work_item *m_blitter_request;
+	rectangle m_blit_dirty; // VRAM the queued blit list can write to (thread safe mode)
+
+	// blits and pixels drawn by each mode: flipx, tinted, trans, blend, then s_mode and d_mode when blended
+	enum { BLIT_MODES = 0x400 };
+	uint64_t m_blit_mode_blits[BLIT_MODES];
+	uint64_t m_blit_mode_pixels[BLIT_MODES];
 
 	// blit timing
 	emu_timer *m_blitter_delay_timer;
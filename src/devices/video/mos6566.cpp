@@ -865,9 +865,6 @@ void mos6566_device::execute_run()
 {
 	do
 	{
-		uint8_t cpu_cycles = m_cpu->total_cycles() & 0xff;
-		uint8_t vic_cycles = total_cycles() & 0xff;
-
 		m_phi0 = 0;
 
 		m_aec_delay <<= 1;
@@ -1434,7 +1431,8 @@ void mos6566_device::execute_run()
 		m_raster_x += 8;
 		if (m_raster_x == 0x1fc) m_raster_x = 0x004;
 
-		if ((cpu_cycles == vic_cycles) && (m_rdy_cycles > 0))
+		// neither cycle count moves during this iteration, so they're only read when a stall is pending
+		if ((m_rdy_cycles > 0) && ((m_cpu->total_cycles() & 0xff) == (total_cycles() & 0xff)))
 		{
 			m_cpu->spin_until_time(m_cpu->cycles_to_attotime(m_rdy_cycles));
 			m_rdy_cycles = 0;
@@ -1453,9 +1451,6 @@ void mos6569_device::execute_run()
 {
 	do
 	{
-		uint8_t cpu_cycles = m_cpu->total_cycles() & 0xff;
-		uint8_t vic_cycles = total_cycles() & 0xff;
-
 		m_phi0 = 0;
 
 		m_aec_delay <<= 1;
@@ -2003,7 +1998,8 @@ void mos6569_device::execute_run()
 		m_raster_x += 8;
 		if (m_raster_x == 0x1fc) m_raster_x = 0x004;
 
-		if ((cpu_cycles == vic_cycles) && (m_rdy_cycles > 0))
+		// neither cycle count moves during this iteration, so they're only read when a stall is pending
+		if ((m_rdy_cycles > 0) && ((m_cpu->total_cycles() & 0xff) == (total_cycles() & 0xff)))
 		{
 			m_cpu->spin_until_time(m_cpu->cycles_to_attotime(m_rdy_cycles));
 			m_rdy_cycles = 0;
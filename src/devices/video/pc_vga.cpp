@@ -134,7 +134,10 @@ vga_device::vga_device(const machine_config &mconfig, device_type type, const ch
 	: device_t(mconfig, type, tag, owner, clock)
 	, device_video_interface(mconfig, *this)
 	, device_palette_interface(mconfig, *this)
+	, m_render_all(true)
+	, m_render_skip(false)
 {
+	memset(&m_render_state, 0, sizeof(m_render_state));
 }
 
 vga_device::vga_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock)
@@ -446,6 +449,145 @@ uint32_t vga_device::start_addr()
 		return vga.crtc.start_addr << 1;
 }
 
+/*
+    Dirty-line rendering
+
+    VRAM is written by the host, the latches and several accelerators, so
+    rather than trapping every writer, each frame compares VRAM against a
+    shadow copy 256 bytes at a time.  The frame is drawn into a cache that
+    keeps its clean lines, and each mode renderer skips the lines whose
+    VRAM didn't change.  A change of mode, of the registers the renderers
+    use, or of the palette redraws the whole frame.
+*/
+
+static constexpr int VRAM_PAGE_SHIFT = 8;
+
+bitmap_rgb32 &vga_device::begin_render(uint8_t cur_mode, bitmap_rgb32 &bitmap)
+{
+	m_render_all = false;
+
+	if ((m_render_cache.width() != bitmap.width()) || (m_render_cache.height() != bitmap.height()))
+	{
+		m_render_cache.allocate(bitmap.width(), bitmap.height());
+		m_render_all = true;
+	}
+
+	// find the VRAM pages that changed; only the SVGA modes show more than the first 512k
+	size_t const size = vga.memory.size();
+	if (m_vram_shadow.size() != size)
+	{
+		m_vram_shadow = vga.memory;
+		m_vram_dirty.assign((size + (1 << VRAM_PAGE_SHIFT) - 1) >> VRAM_PAGE_SHIFT, 0);
+		m_render_all = true;
+	}
+	else
+	{
+		size_t const limit = (cur_mode >= RGB8_MODE) ? size : std::min<size_t>(size, 0x80000);
+		for (size_t base = 0, page = 0; base < size; base += 1 << VRAM_PAGE_SHIFT, page++)
+		{
+			size_t const length = std::min<size_t>(size - base, 1 << VRAM_PAGE_SHIFT);
+			if (base >= limit)
+				m_vram_dirty[page] = 1; // not compared, so not known to be clean
+			else if (memcmp(&vga.memory[base], &m_vram_shadow[base], length))
+			{
+				memcpy(&m_vram_shadow[base], &vga.memory[base], length);
+				m_vram_dirty[page] = 1;
+			}
+			else
+				m_vram_dirty[page] = 0;
+		}
+	}
+
+	// every character can use any glyph, so a font change redraws the screen
+	if ((cur_mode == TEXT_MODE) && vram_dirty(0x20000, 0, 0x10000, ~0U))
+		m_render_all = true;
+
+	render_state state;
+	memset(&state, 0, sizeof(state));
+	state.mode = cur_mode;
+	state.start_addr = start_addr();
+	state.offset = offset();
+	state.cursor_addr = vga.crtc.cursor_addr;
+	state.crtc_start_addr = vga.crtc.start_addr;
+	state.horz_disp_end = vga.crtc.horz_disp_end;
+	state.vert_disp_end = vga.crtc.vert_disp_end;
+	state.line_compare = vga.crtc.line_compare;
+	state.crtc_offset = vga.crtc.offset;
+	state.maximum_scan_line = vga.crtc.maximum_scan_line;
+	state.scan_doubling = vga.crtc.scan_doubling;
+	state.preset_row_scan = vga.crtc.preset_row_scan;
+	state.cursor_enable = vga.crtc.cursor_enable;
+	state.cursor_scan_start = vga.crtc.cursor_scan_start;
+	state.cursor_scan_end = vga.crtc.cursor_scan_end;
+	state.no_wrap = vga.crtc.no_wrap;
+	state.dw = vga.crtc.dw;
+	state.word_mode = vga.crtc.word_mode;
+	state.char_sel_a = vga.sequencer.char_sel.A;
+	state.char_sel_b = vga.sequencer.char_sel.B;
+	state.seq_clocking = vga.sequencer.data[1];
+	state.seq_memory_mode = vga.sequencer.data[4];
+	state.attr_mode = vga.attribute.data[0x10];
+	state.pel_shift = vga.attribute.pel_shift;
+	if (cur_mode == TEXT_MODE)
+		state.blink = screen().frame_number() & 0x30; // the cursor and blinking characters
+	rectangle const &visarea = screen().visible_area();
+	state.min_x = visarea.min_x;
+	state.max_x = visarea.max_x;
+	state.min_y = visarea.min_y;
+	state.max_y = visarea.max_y;
+	state.width = bitmap.width();
+	state.height = bitmap.height();
+	memcpy(state.pens, vga.pens, sizeof(state.pens));
+	for (int i = 0; i < 0x100; i++)
+		state.palette[i] = pen(i);
+
+	if (memcmp(&state, &m_render_state, sizeof(state)))
+	{
+		memcpy(&m_render_state, &state, sizeof(state));
+		m_render_all = true;
+	}
+
+	m_render_skip = true;
+	return m_render_cache;
+}
+
+void vga_device::end_render(bitmap_rgb32 &bitmap, const rectangle &cliprect)
+{
+	m_render_skip = false;
+	copybitmap(bitmap, m_render_cache, 0, 0, 0, 0, cliprect);
+}
+
+bool vga_device::vram_dirty(uint32_t base, uint32_t start, uint32_t length, uint32_t mask) const
+{
+	if (!length)
+		return false;
+
+	// a span that runs past the wrap mask is checked in two pieces
+	start &= mask;
+	uint32_t const before = mask - start;
+	if (length - 1 > before)
+		return vram_dirty(base, start, before + 1, mask) || vram_dirty(base, 0, std::min(length - before - 1, mask), mask);
+
+	// reads past the end of VRAM were never tracked
+	uint64_t const end = uint64_t(base) + start + length;
+	if (end > m_vram_shadow.size())
+		return true;
+	for (uint32_t page = (base + start) >> VRAM_PAGE_SHIFT; page <= ((end - 1) >> VRAM_PAGE_SHIFT); page++)
+		if (m_vram_dirty[page])
+			return true;
+	return false;
+}
+
+bool vga_device::render_planes_clean(uint32_t start, uint32_t length, uint32_t mask) const
+{
+	if (!m_render_skip || m_render_all)
+		return false;
+	for (int plane = 0; plane < 4; plane++)
+		if (vram_dirty(plane * 0x10000, start, length, mask))
+			return false;
+	return true;
+}
+
 void vga_device::vga_vh_text(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
 	uint8_t ch, attr;
@@ -465,6 +607,9 @@ void vga_device::vga_vh_text(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 	for (addr = vga.crtc.start_addr, line = -vga.crtc.preset_row_scan; line < TEXT_LINES;
 			line += height, addr += (offset()>>1))
 	{
+		if (render_clean(0, addr<<1, TEXT_COLUMNS<<1))
+			continue;
+
 		for (pos = addr, column=0; column<TEXT_COLUMNS; column++, pos++)
 		{
 			ch   = vga.memory[(pos<<1) + 0];
@@ -536,6 +681,9 @@ void vga_device::vga_vh_ega(bitmap_rgb32 &bitmap,  const rectangle &cliprect)
 	for (addr=EGA_START_ADDRESS, pos=0, line=0; line<LINES;
 			line += height, addr += offset())
 	{
+		if (render_planes_clean(addr, EGA_COLUMNS+1, 0xffff))
+			continue;
+
 		for(yi=0;yi<height;yi++)
 		{
 			bitmapline = &bitmap.pix32(line + yi);
@@ -598,6 +746,8 @@ void vga_device::vga_vh_vga(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 					curr_addr = 0;
 					pel_shift = 0;
 				}
+				if (render_planes_clean(curr_addr, VGA_COLUMNS+1, addrmask))
+					continue;
 				bitmapline = &bitmap.pix32(line + yi);
 				for (pos=curr_addr, c=0, column=0; column<VGA_COLUMNS+1; column++, c+=8, pos++)
 				{
@@ -624,6 +774,8 @@ void vga_device::vga_vh_vga(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 					curr_addr = addr;
 				if((line + yi) == (vga.crtc.line_compare & mask_comp))
 					curr_addr = 0;
+				if (render_clean(0, curr_addr, (VGA_COLUMNS+1)<<3, addrmask))
+					continue;
 				bitmapline = &bitmap.pix32(line + yi);
 				//addr %= 0x80000;
 				for (pos=curr_addr, c=0, column=0; column<VGA_COLUMNS+1; column++, c+=0x10, pos+=0x8)
@@ -657,6 +809,8 @@ void vga_device::vga_vh_cga(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 	for(y=0;y<LINES;y++)
 	{
 		addr = ((y & 1) * 0x2000) + (((y & ~1) >> 1) * width/4);
+		if (render_clean(0, addr, width/4))
+			continue;
 
 		for(x=0;x<width;x+=4)
 		{
@@ -692,6 +846,8 @@ void vga_device::vga_vh_mono(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 	for(y=0;y<LINES;y++)
 	{
 		addr = ((y & 1) * 0x2000) + (((y & ~1) >> 1) * width/8);
+		if (render_clean(0, addr, width/8))
+			continue;
 
 		for(x=0;x<width;x+=8)
 		{
@@ -746,6 +902,8 @@ void svga_device::svga_vh_rgb8(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 					curr_addr = 0;
 				bitmapline = &bitmap.pix32(line + yi);
 				addr %= vga.svga_intf.vram_size;
+				if (render_clean(0, curr_addr, VGA_COLUMNS<<3))
+					continue;
 				for (pos=curr_addr, c=0, column=0; column<VGA_COLUMNS; column++, c+=8, pos+=0x8)
 				{
 					if(pos + 0x08 >= vga.svga_intf.vram_size)
@@ -784,6 +942,8 @@ void svga_device::svga_vh_rgb15(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 	{
 		bitmapline = &bitmap.pix32(line);
 		addr %= vga.svga_intf.vram_size;
+		if (render_clean(0, addr, TGA_COLUMNS<<4))
+			continue;
 		for (pos=addr, c=0, column=0; column<TGA_COLUMNS; column++, c+=8, pos+=0x10)
 		{
 			if(pos + 0x10 >= vga.svga_intf.vram_size)
@@ -828,6 +988,8 @@ void svga_device::svga_vh_rgb16(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 	{
 		bitmapline = &bitmap.pix32(line);
 		addr %= vga.svga_intf.vram_size;
+		if (render_clean(0, addr, TGA_COLUMNS<<4))
+			continue;
 		for (pos=addr, c=0, column=0; column<TGA_COLUMNS; column++, c+=8, pos+=0x10)
 		{
 			if(pos + 0x10 >= vga.svga_intf.vram_size)
@@ -872,6 +1034,8 @@ void svga_device::svga_vh_rgb24(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 	{
 		bitmapline = &bitmap.pix32(line);
 		addr %= vga.svga_intf.vram_size;
+		if (render_clean(0, addr, TGA_COLUMNS*24))
+			continue;
 		for (pos=addr, c=0, column=0; column<TGA_COLUMNS; column++, c+=8, pos+=24)
 		{
 			if(pos + 24 >= vga.svga_intf.vram_size)
@@ -913,6 +1077,8 @@ void svga_device::svga_vh_rgb32(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 	{
 		bitmapline = &bitmap.pix32(line);
 		addr %= vga.svga_intf.vram_size;
+		if (render_clean(0, addr, TGA_COLUMNS<<5))
+			continue;
 		for (pos=addr, c=0, column=0; column<TGA_COLUMNS; column++, c+=8, pos+=0x20)
 		{
 			if(pos + 0x20 >= vga.svga_intf.vram_size)
@@ -1094,15 +1260,22 @@ uint8_t svga_device::get_video_depth()
 uint32_t vga_device::screen_update(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
 	uint8_t cur_mode = pc_vga_choosevideomode();
+	if (cur_mode == SCREEN_OFF)
+	{
+		bitmap.fill(black_pen(), cliprect);
+		return 0;
+	}
+
+	bitmap_rgb32 &cache = begin_render(cur_mode, bitmap);
 	switch(cur_mode)
 	{
-		case SCREEN_OFF:   bitmap.fill  (black_pen(), cliprect);break;
-		case TEXT_MODE:    vga_vh_text  (bitmap, cliprect); break;
-		case VGA_MODE:     vga_vh_vga   (bitmap, cliprect); break;
-		case EGA_MODE:     vga_vh_ega   (bitmap, cliprect); break;
-		case CGA_MODE:     vga_vh_cga   (bitmap, cliprect); break;
-		case MONO_MODE:    vga_vh_mono  (bitmap, cliprect); break;
+		case TEXT_MODE:    vga_vh_text  (cache, cliprect); break;
+		case VGA_MODE:     vga_vh_vga   (cache, cliprect); break;
+		case EGA_MODE:     vga_vh_ega   (cache, cliprect); break;
+		case CGA_MODE:     vga_vh_cga   (cache, cliprect); break;
+		case MONO_MODE:    vga_vh_mono  (cache, cliprect); break;
 	}
+	end_render(bitmap, cliprect);
 
 	return 0;
 }
@@ -1110,21 +1283,27 @@ uint32_t vga_device::screen_update(screen_device &screen, bitmap_rgb32 &bitmap,
 uint32_t svga_device::screen_update(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
 	uint8_t cur_mode = pc_vga_choosevideomode();
+	if (cur_mode == SCREEN_OFF)
+	{
+		bitmap.fill(black_pen(), cliprect);
+		return 0;
+	}
 
+	bitmap_rgb32 &cache = begin_render(cur_mode, bitmap);
 	switch(cur_mode)
 	{
-		case SCREEN_OFF:   bitmap.fill  (black_pen(), cliprect);break;
-		case TEXT_MODE:    vga_vh_text  (bitmap, cliprect); break;
-		case VGA_MODE:     vga_vh_vga   (bitmap, cliprect); break;
-		case EGA_MODE:     vga_vh_ega   (bitmap, cliprect); break;
-		case CGA_MODE:     vga_vh_cga   (bitmap, cliprect); break;
-		case MONO_MODE:    vga_vh_mono  (bitmap, cliprect); break;
-		case RGB8_MODE:    svga_vh_rgb8 (bitmap, cliprect); break;
-		case RGB15_MODE:   svga_vh_rgb15(bitmap, cliprect); break;
-		case RGB16_MODE:   svga_vh_rgb16(bitmap, cliprect); break;
-		case RGB24_MODE:   svga_vh_rgb24(bitmap, cliprect); break;
-		case RGB32_MODE:   svga_vh_rgb32(bitmap, cliprect); break;
+		case TEXT_MODE:    vga_vh_text  (cache, cliprect); break;
+		case VGA_MODE:     vga_vh_vga   (cache, cliprect); break;
+		case EGA_MODE:     vga_vh_ega   (cache, cliprect); break;
+		case CGA_MODE:     vga_vh_cga   (cache, cliprect); break;
+		case MONO_MODE:    vga_vh_mono  (cache, cliprect); break;
+		case RGB8_MODE:    svga_vh_rgb8 (cache, cliprect); break;
+		case RGB15_MODE:   svga_vh_rgb15(cache, cliprect); break;
+		case RGB16_MODE:   svga_vh_rgb16(cache, cliprect); break;
+		case RGB24_MODE:   svga_vh_rgb24(cache, cliprect); break;
+		case RGB32_MODE:   svga_vh_rgb32(cache, cliprect); break;
 	}
+	end_render(bitmap, cliprect);
 
 	return 0;
 }
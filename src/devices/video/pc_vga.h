@@ -84,6 +84,11 @@ protected:
 	void gc_reg_write(uint8_t index,uint8_t data);
 	virtual uint16_t offset();
 	virtual uint32_t start_addr();
+	bitmap_rgb32 &begin_render(uint8_t cur_mode, bitmap_rgb32 &bitmap);
+	void end_render(bitmap_rgb32 &bitmap, const rectangle &cliprect);
+	bool vram_dirty(uint32_t base, uint32_t start, uint32_t length, uint32_t mask) const;
+	bool render_clean(uint32_t base, uint32_t start, uint32_t length, uint32_t mask = ~0U) const { return m_render_skip && !m_render_all && !vram_dirty(base, start, length, mask); }
+	bool render_planes_clean(uint32_t start, uint32_t length, uint32_t mask) const;
 	inline uint8_t vga_latch_write(int offs, uint8_t data);
 	inline uint8_t rotate_right(uint8_t val) { return (val >> vga.gc.rotate_count) | (val << (8 - vga.gc.rotate_count)); }
 	inline uint8_t vga_logical_op(uint8_t data, uint8_t plane, uint8_t mask)
@@ -233,6 +238,26 @@ protected:
 		struct { uint8_t reg; } oak;
 	} vga;
 
+	// everything besides VRAM that the mode renderers draw from; a change redraws every line
+	struct render_state
+	{
+		uint32_t mode, start_addr, offset, cursor_addr, crtc_start_addr;
+		uint16_t horz_disp_end, vert_disp_end, line_compare, crtc_offset;
+		uint8_t maximum_scan_line, scan_doubling, preset_row_scan, cursor_enable, cursor_scan_start, cursor_scan_end;
+		uint8_t no_wrap, dw, word_mode, char_sel_a, char_sel_b, seq_clocking, seq_memory_mode, attr_mode, pel_shift;
+		uint32_t blink;
+		int32_t min_x, max_x, min_y, max_y, width, height;
+		uint32_t pens[16];
+		uint32_t palette[0x100];
+	};
+
+	bitmap_rgb32 m_render_cache;        // the last frame drawn, of which clean lines are kept
+	std::vector<uint8_t> m_vram_shadow; // VRAM as of the last frame drawn
+	std::vector<uint8_t> m_vram_dirty;  // one flag per VRAM page, set if it changed since
+	render_state m_render_state;
+	bool m_render_all;
+	bool m_render_skip;
+
 	emu_timer *m_vblank_timer;
 };
 
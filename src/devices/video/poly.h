@@ -40,7 +40,9 @@
 #include "screen.h"
 
 #include <limits.h>
+#include <algorithm>
 #include <atomic>
+#include <thread>
 
 
 //**************************************************************************
@@ -132,10 +134,12 @@ private:
 	// number of profiling ticks before we consider a wait "long"
 	static constexpr osd_ticks_t POLY_LOG_WAIT_THRESHOLD = 1000;
 
-	static constexpr int SCANLINES_PER_BUCKET = 32;
+	static constexpr int SCANLINES_PER_BUCKET = 32;          // most scanlines in one unit; buckets may be shorter
+	static constexpr int MIN_SCANLINES_PER_BUCKET = 8;
 	static constexpr int CACHE_LINE_SIZE      = 64;          // this is a general guess
-	static constexpr int TOTAL_BUCKETS        = (512 / SCANLINES_PER_BUCKET);
+	static constexpr int TOTAL_BUCKETS        = (512 / MIN_SCANLINES_PER_BUCKET);
 	static constexpr int UNITS_PER_POLY       = (100 / SCANLINES_PER_BUCKET);
+	static constexpr int BUCKETS_PER_THREAD   = 4;           // shorten buckets until each thread has this many to pick from
 
 	// polygon_info describes a single polygon, which includes the poly_params
 	struct polygon_info
@@ -188,6 +192,8 @@ private:
 		poly_array(running_machine &machine, poly_manager &manager)
 			: m_manager(manager),
 				m_base(make_unique_clear<uint8_t[]>(k_itemsize * _Count)),
+				m_start(0),
+				m_end(_Count),
 				m_next(0),
 				m_max(0),
 				m_waits(0) { }
@@ -200,6 +206,7 @@ private:
 
 		// getters
 		int count() const { return m_next; }
+		int used() const { return m_next - m_start; }
 		int max() const { return m_max; }
 		int waits() const { return m_waits; }
 		int itemsize() const { return k_itemsize; }
@@ -207,15 +214,17 @@ private:
 		int indexof(_Type &item) const { int result = (reinterpret_cast<uint8_t *>(&item) - m_base.get()) / k_itemsize; assert(result >= 0 && result < _Count); return result; }
 
 		// operations
-		void reset() { m_next = 0; }
-		_Type &next() { if (m_next > m_max) m_max = m_next; assert(m_next < _Count); return *new(m_base.get() + m_next++ * k_itemsize) _Type; }
+		void reset(int start, int end) { m_start = m_next = start; m_end = end; }
+		_Type &next() { if (m_next > m_max) m_max = m_next; assert(m_next < m_end); return *new(m_base.get() + m_next++ * k_itemsize) _Type; }
 		_Type &last() const { return (*this)[m_next - 1]; }
-		void wait_for_space(int count = 1) { while ((m_next + count) >= _Count) { m_waits++; m_manager.wait(""); }  }
+		void wait_for_space(int count = 1) { while ((m_next + count) >= m_end) { m_waits++; m_manager.next_batch(); }  }
 
 	private:
 		// internal state
 		poly_manager &      m_manager;
 		std::unique_ptr<uint8_t[]>             m_base;
+		int                 m_start;
+		int                 m_end;
 		int                 m_next;
 		int                 m_max;
 		int                 m_waits;
@@ -241,7 +250,7 @@ private:
 	{
 		// wait for space in the polygon and unit arrays
 		m_polygon.wait_for_space();
-		m_unit.wait_for_space((maxy - miny) / SCANLINES_PER_BUCKET + 2);
+		m_unit.wait_for_space((maxy - miny) / m_bucket_lines + 2);
 
 		// return and initialize the next one
 		polygon_info &polygon = m_polygon.next();
@@ -251,6 +260,30 @@ private:
 		return polygon;
 	}
 
+	// buckets and batches
+	uint32_t bucket_of(int32_t scanline) const { return ((uint32_t)scanline >> m_bucket_shift) % TOTAL_BUCKETS; }
+	int batch_of(uint32_t unitnum) const { return (unitnum >= m_unit.allocated() / 2) ? 1 : 0; }
+	void link_unit(work_unit &unit, uint32_t unit_index, uint32_t bucketnum)
+	{
+		// chain behind the last unit in the same bucket, noting links into the previous batch
+		uint16_t &bucket = m_unit_bucket[bucketnum];
+		unit.previtem = bucket;
+		bucket = unit_index;
+		if ((m_queue != nullptr) && (unit.previtem != 0xffff) && (batch_of(unit.previtem) != m_batch))
+			m_batch_links[m_batch]++;
+	}
+	void queue_units(uint32_t startunit)
+	{
+		uint32_t const count = m_unit.count() - startunit;
+		if ((m_queue != nullptr) && (count != 0))
+		{
+			m_batch_pending[m_batch] += count;
+			osd_work_item_queue_multiple(m_queue, work_item_callback, count, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+		}
+	}
+	void reset_arrays(int batch);
+	void next_batch();
+
 	static void *work_item_callback(void *param, int threadid);
 	void presave() { wait("pre-save"); }
 
@@ -268,8 +301,16 @@ private:
 	uint8_t const         m_flags;                    // flags
 
 	// buckets
+	uint8_t               m_bucket_shift;             // log2 of the scanlines per bucket
+	int32_t               m_bucket_lines;             // scanlines per bucket
 	uint16_t              m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
 
+	// batches: with a work queue each array is split in two halves, and new
+	// work goes into one half while the other one drains
+	int                   m_batch;                    // half currently being filled
+	std::atomic<uint32_t> m_batch_pending[2];         // units queued but not finished, per half
+	std::atomic<uint32_t> m_batch_links[2];           // units linked into the other half that haven't looked at their predecessors yet
+
 	// statistics
 	uint32_t              m_tiles;                    // number of tiles queued
 	uint32_t              m_triangles;                // number of triangles queued
@@ -278,6 +319,10 @@ private:
 #if KEEP_POLY_STATISTICS
 	uint32_t              m_conflicts[WORK_MAX_THREADS]; // number of conflicts found, per thread
 	uint32_t              m_resolved[WORK_MAX_THREADS];   // number of conflicts resolved, per thread
+	uint32_t              m_units_run[WORK_MAX_THREADS];  // number of units processed, per thread
+	osd_ticks_t           m_busy_ticks[WORK_MAX_THREADS]; // time spent processing units, per thread
+	uint32_t              m_batch_switches;           // number of times a full half was handed over
+	uint32_t              m_batch_stalls;             // number of those that had to wait for the other half
 #endif
 };
 
@@ -309,6 +354,9 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 	, m_object(machine, *this)
 	, m_unit(machine, *this)
 	, m_flags(flags)
+	, m_bucket_shift(0)
+	, m_bucket_lines(SCANLINES_PER_BUCKET)
+	, m_batch(0)
 	, m_tiles(0)
 	, m_triangles(0)
 	, m_quads(0)
@@ -317,13 +365,30 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 #if KEEP_POLY_STATISTICS
 	memset(m_conflicts, 0, sizeof(m_conflicts));
 	memset(m_resolved, 0, sizeof(m_resolved));
+	memset(m_units_run, 0, sizeof(m_units_run));
+	memset(m_busy_ticks, 0, sizeof(m_busy_ticks));
+	m_batch_switches = m_batch_stalls = 0;
 #endif
 
 	// create the work queue
 	if (!(flags & FLAG_NO_WORK_QUEUE))
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
-	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
+	// shorten the buckets when the screen doesn't have enough of them to go around the threads
+	if (m_queue != nullptr)
+	{
+		screen_device *const sizing = (screen != nullptr) ? screen : screen_device_iterator(machine.root_device()).first();
+		int const threads = std::min<int>(std::max<int>(std::thread::hardware_concurrency(), 1), WORK_MAX_THREADS);
+		int const height = (sizing != nullptr) ? sizing->height() : 0;
+		while ((m_bucket_lines > MIN_SCANLINES_PER_BUCKET) && (height < m_bucket_lines * threads * BUCKETS_PER_THREAD))
+			m_bucket_lines /= 2;
+	}
+	while ((1 << m_bucket_shift) < m_bucket_lines)
+		m_bucket_shift++;
+
+	m_batch_pending[0] = m_batch_pending[1] = 0;
+	m_batch_links[0] = m_batch_links[1] = 0;
+	reset_arrays(0);
 
 	// request a pre-save callback for synchronization
 	machine.save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
@@ -356,6 +421,16 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::~poly_manager()
 		printf("Total pixels   = %d\n", (uint32_t)m_pixels);
 
 	printf("Conflicts:   %d resolved, %d total\n", resolved, conflicts);
+	printf("Buckets:     %d scanlines each\n", m_bucket_lines);
+	printf("Batches:     %d switches, %d stalled\n", m_batch_switches, m_batch_stalls);
+
+	// per-thread utilization
+	osd_ticks_t busy = 0;
+	for (int i = 0; i < ARRAY_LENGTH(m_busy_ticks); i++)
+		busy += m_busy_ticks[i];
+	for (int i = 0; i < ARRAY_LENGTH(m_units_run); i++)
+		if (m_units_run[i] != 0)
+			printf("Thread %2d:   %7d units, %5.1f%% of busy time\n", i, m_units_run[i], busy ? 100.0 * double(m_busy_ticks[i]) / double(busy) : 0.0);
 	printf("Units:       %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_unit.max(), m_unit.allocated(), m_unit.waits(), m_unit.itemsize(), m_unit.allocated() * m_unit.itemsize());
 	printf("Polygons:    %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_polygon.max(), m_polygon.allocated(), m_polygon.waits(), m_polygon.itemsize(), m_polygon.allocated() * m_polygon.itemsize());
 	printf("Object data: %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_object.max(), m_object.allocated(), m_object.waits(), m_object.itemsize(), m_object.allocated() * m_object.itemsize());
@@ -375,20 +450,24 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::~poly_manager()
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::work_item_callback(void *param, int threadid)
 {
+	bool chained = false;
 	while (1)
 	{
 		work_unit &unit = *(work_unit *)param;
 		polygon_info &polygon = *unit.polygon;
+		poly_manager &owner = *polygon.m_owner;
+		uint32_t const unitnum = owner.m_unit.indexof(unit);
 		int count = unit.count_next & 0xffff;
 		uint32_t orig_count_next;
 
-		// if our previous item isn't done yet, enqueue this item to the end and proceed
-		if (unit.previtem != 0xffff)
+		// if our previous item isn't done yet, enqueue this item to the end and proceed;
+		// units reached by following a chain already know their predecessor is done
+		if (!chained && unit.previtem != 0xffff)
 		{
-			work_unit &prevunit = polygon.m_owner->m_unit[unit.previtem];
+			work_unit &prevunit = owner.m_unit[unit.previtem];
+			bool deferred = false;
 			if (prevunit.count_next != 0)
 			{
-				uint32_t unitnum = polygon.m_owner->m_unit.indexof(unit);
 				uint32_t new_count_next;
 
 				// attempt to atomically swap in this new value
@@ -400,31 +479,51 @@ void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::work_item_cal
 
 #if KEEP_POLY_STATISTICS
 				// track resolved conflicts
-				polygon.m_owner->m_conflicts[threadid]++;
+				owner.m_conflicts[threadid]++;
 				if (orig_count_next != 0)
-					polygon.m_owner->m_resolved[threadid]++;
+					owner.m_resolved[threadid]++;
 #endif
-				// if we succeeded, skip out early so we can do other work
-				if (orig_count_next != 0)
-					break;
+				deferred = (orig_count_next != 0);
 			}
+
+			// past this point we never look at the predecessor again, so the other half may be recycled
+			if ((owner.m_queue != nullptr) && (owner.batch_of(unit.previtem) != owner.batch_of(unitnum)))
+				owner.m_batch_links[owner.batch_of(unitnum)]--;
+
+			// if we succeeded, skip out early so we can do other work
+			if (deferred)
+				break;
 		}
 
+#if KEEP_POLY_STATISTICS
+		osd_ticks_t const start = get_profile_ticks();
+#endif
+
 		// iterate over extents
 		for (int curscan = 0; curscan < count; curscan++)
 			polygon.m_callback(unit.scanline + curscan, unit.extent[curscan], *polygon.m_object, threadid);
 
+#if KEEP_POLY_STATISTICS
+		owner.m_busy_ticks[threadid] += get_profile_ticks() - start;
+		owner.m_units_run[threadid]++;
+#endif
+
 		// set our count to 0 and re-fetch the original count value
 		do
 		{
 			orig_count_next = unit.count_next;
 		} while (!unit.count_next.compare_exchange_weak(orig_count_next, 0, std::memory_order_release, std::memory_order_relaxed));
 
-		// if we have no more work to do, do nothing
+		// count the unit as finished only once we're done touching it
 		orig_count_next >>= 16;
+		if (owner.m_queue != nullptr)
+			owner.m_batch_pending[owner.batch_of(unitnum)]--;
+
+		// if we have no more work to do, do nothing
 		if (orig_count_next == 0)
 			break;
-		param = &polygon.m_owner->m_unit[orig_count_next];
+		param = &owner.m_unit[orig_count_next];
+		chained = true;
 	}
 	return nullptr;
 }
@@ -461,19 +560,85 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	}
 
 	// reset the state
-	m_polygon.reset();
-	m_unit.reset();
 	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
+	reset_arrays(0);
+}
+
+
+//-------------------------------------------------
+//  reset_arrays - start filling one half of the
+//  arrays (or all of them, without a work queue)
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::reset_arrays(int batch)
+{
+	auto const reset = [this, batch] ()
+	{
+		m_batch = batch;
+		if (m_queue == nullptr)
+		{
+			m_polygon.reset(0, m_polygon.allocated());
+			m_object.reset(0, m_object.allocated());
+			m_unit.reset(0, m_unit.allocated());
+		}
+		else
+		{
+			// unit 0 can't be the target of a chain link, so the first half starts at 1
+			int const polyhalf = m_polygon.allocated() / 2;
+			int const objecthalf = m_object.allocated() / 2;
+			int const unithalf = m_unit.allocated() / 2;
+			m_polygon.reset(batch * polyhalf, (batch + 1) * polyhalf);
+			m_object.reset(batch * objecthalf, (batch + 1) * objecthalf);
+			m_unit.reset(batch ? unithalf : 1, batch ? m_unit.allocated() : unithalf);
+		}
+	};
 
 	// we need to preserve the last object data that was supplied
-	if (m_object.count() > 0)
+	if (m_object.used() > 0)
 	{
 		_ObjectData temp = object_data_last();
-		m_object.reset();
+		reset();
 		m_object.next() = temp;
 	}
 	else
-		m_object.reset();
+		reset();
+}
+
+
+//-------------------------------------------------
+//  next_batch - called when one of the arrays is
+//  full; hand the current half over to the work
+//  queue and continue in the other one
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::next_batch()
+{
+	// without a queue, everything runs when we wait
+	if (m_queue == nullptr)
+	{
+		wait("array full");
+		return;
+	}
+
+	// the other half has to be finished, and nothing in this half may still
+	// be about to check on a predecessor there, before we overwrite it
+	int const next = m_batch ^ 1;
+#if KEEP_POLY_STATISTICS
+	m_batch_switches++;
+	if ((m_batch_pending[next] != 0) || (m_batch_links[m_batch] != 0))
+		m_batch_stalls++;
+#endif
+	while ((m_batch_pending[next] != 0) || (m_batch_links[m_batch] != 0))
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() / 10000);
+
+	// bucket chains that end in the other half are all done
+	for (uint16_t &bucket : m_unit_bucket)
+		if ((bucket != 0xffff) && (batch_of(bucket) == next))
+			bucket = 0xffff;
+
+	reset_arrays(next);
 }
 
 
@@ -573,19 +738,18 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_til
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v2yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = ((uint32_t)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
+		uint32_t bucketnum = bucket_of(curscan);
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - (uint32_t)curscan % SCANLINES_PER_BUCKET;
+		scaninc = m_bucket_lines - ((uint32_t)curscan & (m_bucket_lines - 1));
 
 		// fill in the work unit basics
 		unit.polygon = &polygon;
 		unit.count_next = std::min(v2yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		link_unit(unit, unit_index, bucketnum);
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -611,8 +775,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_til
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_tiles++;
@@ -731,19 +894,18 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = ((uint32_t)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
+		uint32_t bucketnum = bucket_of(curscan);
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - (uint32_t)curscan % SCANLINES_PER_BUCKET;
+		scaninc = m_bucket_lines - ((uint32_t)curscan & (m_bucket_lines - 1));
 
 		// fill in the work unit basics
 		unit.polygon = &polygon;
 		unit.count_next = std::min(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		link_unit(unit, unit_index, bucketnum);
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -799,8 +961,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_triangles++;
@@ -864,19 +1025,18 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = ((uint32_t)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
+		uint32_t bucketnum = bucket_of(curscan);
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - (uint32_t)curscan % SCANLINES_PER_BUCKET;
+		scaninc = m_bucket_lines - ((uint32_t)curscan & (m_bucket_lines - 1));
 
 		// fill in the work unit basics
 		unit.polygon = &polygon;
 		unit.count_next = std::min(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		link_unit(unit, unit_index, bucketnum);
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -915,8 +1075,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tri
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the object
 	m_triangles++;
@@ -1039,19 +1198,18 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_pol
 	int32_t scaninc = 1;
 	for (int32_t curscan = minyclip; curscan < maxyclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = ((uint32_t)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
+		uint32_t bucketnum = bucket_of(curscan);
 		uint32_t unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - (uint32_t)curscan % SCANLINES_PER_BUCKET;
+		scaninc = m_bucket_lines - ((uint32_t)curscan & (m_bucket_lines - 1));
 
 		// fill in the work unit basics
 		unit.polygon = &polygon;
 		unit.count_next = std::min(maxyclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		link_unit(unit, unit_index, bucketnum);
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -1114,8 +1272,7 @@ uint32_t poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_pol
 	}
 
 	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_quads++;
@@ -64,6 +64,29 @@ void psxgpu_device::device_start()
 	{
 		psx_gpu_init( 2 );
 	}
+
+	/* the debug viewer and logging expect to run on the emulation thread */
+	m_drawing = false;
+	m_draw_queue = nullptr;
+	if( !PSXGPU_DEBUG_VIEWER && VERBOSE_LEVEL == 0 )
+	{
+		m_draw_queue = osd_work_queue_alloc( WORK_QUEUE_FLAG_IO );
+	}
+}
+
+void psxgpu_device::device_stop()
+{
+	if( m_draw_queue != nullptr )
+	{
+		wait_for_drawing();
+		osd_work_queue_free( m_draw_queue );
+		m_draw_queue = nullptr;
+	}
+}
+
+void psxgpu_device::device_pre_save()
+{
+	wait_for_drawing();
 }
 
 void psxgpu_device::device_reset()
@@ -609,7 +632,7 @@ void psxgpu_device::psx_gpu_init( int n_gputype )
 	}
 
 	save_pointer(NAME(p_vram), width * height );
-	save_item(NAME(m_packet.n_entry));
+	save_item(NAME(m_gp0_packet.n_entry));
 	save_item(NAME(n_gpu_buffer_offset));
 	save_item(NAME(n_vramx));
 	save_item(NAME(n_vramy));
@@ -663,6 +686,8 @@ uint32_t psxgpu_device::update_screen(screen_device &screen, bitmap_rgb32 &bitma
 	int n_overscantop;
 	int n_overscanleft;
 
+	wait_for_drawing();
+
 #if PSXGPU_DEBUG_VIEWER
 	if( DebugMeshDisplay( bitmap, cliprect ) )
 	{
@@ -828,24 +853,17 @@ f  e| d  c| b| a  9| 8  7| 6  5| 4| 3  2  1  0
     |iy|ix|ty|     |   tp|  abr|ty|         tx
 */
 
-void psxgpu_device::decode_tpage( uint32_t tpage )
+void psxgpu_device::tpage_status( uint32_t tpage )
 {
 	if( m_n_gputype == 2 )
 	{
 		n_gpustatus = ( n_gpustatus & 0xffff7800 ) | ( tpage & 0x7ff ) | ( ( tpage & 0x800 ) << 4 );
 
-		m_n_tx = ( tpage & 0x0f ) << 6;
-		m_n_ty = ( ( tpage & 0x10 ) << 4 ) | ( ( tpage & 0x800 ) >> 2 );
-		n_abr = ( tpage & 0x60 ) >> 5;
-		n_tp = ( tpage & 0x180 ) >> 7;
-		n_ix = ( tpage & 0x1000 ) >> 12;
-		n_iy = ( tpage & 0x2000 ) >> 13;
-		n_ti = 0;
 		if( ( tpage & ~0x39ff ) != 0 )
 		{
 			verboselog( *this, 1, "not handled: draw mode %08x\n", tpage & ~0x39ff );
 		}
-		if( n_tp == 3 )
+		if( ( ( tpage & 0x180 ) >> 7 ) == 3 )
 		{
 			verboselog( *this, 0, "not handled: tp == 3\n" );
 		}
@@ -855,28 +873,46 @@ void psxgpu_device::decode_tpage( uint32_t tpage )
 		// TODO: confirm status bits on real type 1 gpu
 		n_gpustatus = ( n_gpustatus & 0xffffe000 ) | ( tpage & 0x1fff );
 
-		m_n_tx = ( tpage & 0x0f ) << 6;
-		m_n_ty = ( ( tpage & 0x60 ) << 3 );
-		n_abr = ( tpage & 0x180 ) >> 7;
-		n_tp = ( tpage & 0x600 ) >> 9;
-		n_ti = ( tpage & 0x2000 ) >> 13;
-		n_ix = 0;
-		n_iy = 0;
 		if( ( tpage & ~0x27ef ) != 0 )
 		{
 			verboselog( *this, 1, "not handled: draw mode %08x\n", tpage & ~0x27ef );
 		}
-		if( n_tp == 3 )
+		if( ( ( tpage & 0x600 ) >> 9 ) == 3 )
 		{
 			verboselog( *this, 0, "not handled: tp == 3\n" );
 		}
-		else if( n_tp == 2 && n_ti != 0 )
+		else if( ( ( tpage & 0x600 ) >> 9 ) == 2 && ( tpage & 0x2000 ) != 0 )
 		{
 			verboselog( *this, 0, "not handled: interleaved 15 bit texture\n" );
 		}
 	}
 }
 
+/* drawing state only, this can run on the drawing thread; tpage_status does the status register */
+void psxgpu_device::decode_tpage( uint32_t tpage )
+{
+	if( m_n_gputype == 2 )
+	{
+		m_n_tx = ( tpage & 0x0f ) << 6;
+		m_n_ty = ( ( tpage & 0x10 ) << 4 ) | ( ( tpage & 0x800 ) >> 2 );
+		n_abr = ( tpage & 0x60 ) >> 5;
+		n_tp = ( tpage & 0x180 ) >> 7;
+		n_ix = ( tpage & 0x1000 ) >> 12;
+		n_iy = ( tpage & 0x2000 ) >> 13;
+		n_ti = 0;
+	}
+	else
+	{
+		m_n_tx = ( tpage & 0x0f ) << 6;
+		m_n_ty = ( ( tpage & 0x60 ) << 3 );
+		n_abr = ( tpage & 0x180 ) >> 7;
+		n_tp = ( tpage & 0x600 ) >> 9;
+		n_ti = ( tpage & 0x2000 ) >> 13;
+		n_ix = 0;
+		n_iy = 0;
+	}
+}
+
 #define SPRITESETUP \
 	int n_dv; \
 	if( n_iy != 0 ) \
@@ -2753,6 +2789,256 @@ void psxgpu_device::MoveImage()
 	}
 }
 
+void psxgpu_device::draw_command( const PACKET &packet )
+{
+	m_packet = packet;
+
+	switch( m_packet.n_entry[ 0 ] >> 24 )
+	{
+	case 0x02:
+		FrameBufferRectangleDraw();
+		break;
+	case 0x20:
+	case 0x21:
+	case 0x22:
+	case 0x23:
+		FlatPolygon( 3 );
+		break;
+	case 0x24:
+	case 0x25:
+	case 0x26:
+	case 0x27:
+		FlatTexturedPolygon( 3 );
+		break;
+	case 0x28:
+	case 0x29:
+	case 0x2a:
+	case 0x2b:
+		FlatPolygon( 4 );
+		break;
+	case 0x2c:
+	case 0x2d:
+	case 0x2e:
+	case 0x2f:
+		FlatTexturedPolygon( 4 );
+		break;
+	case 0x30:
+	case 0x31:
+	case 0x32:
+	case 0x33:
+		GouraudPolygon( 3 );
+		break;
+	case 0x34:
+	case 0x35:
+	case 0x36:
+	case 0x37:
+		GouraudTexturedPolygon( 3 );
+		break;
+	case 0x38:
+	case 0x39:
+	case 0x3a:
+	case 0x3b:
+		GouraudPolygon( 4 );
+		break;
+	case 0x3c:
+	case 0x3d:
+	case 0x3e:
+	case 0x3f:
+		GouraudTexturedPolygon( 4 );
+		break;
+	case 0x40:
+	case 0x41:
+	case 0x42:
+	case 0x43:
+	case 0x48:
+	case 0x4a:
+	case 0x4c:
+	case 0x4e:
+		MonochromeLine();
+		break;
+	case 0x50:
+	case 0x51:
+	case 0x52:
+	case 0x53:
+	case 0x58:
+	case 0x5a:
+	case 0x5c:
+	case 0x5e:
+		GouraudLine();
+		break;
+	case 0x60:
+	case 0x61:
+	case 0x62:
+	case 0x63:
+		FlatRectangle();
+		break;
+	case 0x64:
+	case 0x65:
+	case 0x66:
+	case 0x67:
+		FlatTexturedRectangle();
+		break;
+	case 0x68:
+	case 0x69:
+	case 0x6a:
+	case 0x6b:
+		Dot();
+		break;
+	case 0x6c:
+	case 0x6d:
+	case 0x6e:
+	case 0x6f:
+		TexturedDot();
+		break;
+	case 0x70:
+	case 0x71:
+	case 0x72:
+	case 0x73:
+		FlatRectangle8x8();
+		break;
+	case 0x74:
+	case 0x75:
+	case 0x76:
+	case 0x77:
+		Sprite8x8();
+		break;
+	case 0x78:
+	case 0x79:
+	case 0x7a:
+	case 0x7b:
+		FlatRectangle16x16();
+		break;
+	case 0x7c:
+	case 0x7d:
+	case 0x7e:
+	case 0x7f:
+		Sprite16x16();
+		break;
+	case 0x80:
+		MoveImage();
+		break;
+	case 0xe1:
+		decode_tpage( m_packet.n_entry[ 0 ] & 0xffffff );
+		break;
+	case 0xe2:
+		n_twy = ( ( ( m_packet.n_entry[ 0 ] >> 15 ) & 0x1f ) << 3 );
+		n_twx = ( ( ( m_packet.n_entry[ 0 ] >> 10 ) & 0x1f ) << 3 );
+		n_twh = 255 - ( ( ( m_packet.n_entry[ 0 ] >> 5 ) & 0x1f ) << 3 );
+		n_tww = 255 - ( ( m_packet.n_entry[ 0 ] & 0x1f ) << 3 );
+		verboselog( *this, 1, "%02x: texture window %u,%u %u,%u\n", m_packet.n_entry[ 0 ] >> 24,
+			n_twx, n_twy, n_tww, n_twh );
+		break;
+	case 0xe3:
+		n_drawarea_x1 = m_packet.n_entry[ 0 ] & 1023;
+		if( m_n_gputype == 2 )
+		{
+			n_drawarea_y1 = ( m_packet.n_entry[ 0 ] >> 10 ) & 1023;
+		}
+		else
+		{
+			n_drawarea_y1 = ( m_packet.n_entry[ 0 ] >> 12 ) & 1023;
+		}
+		verboselog( *this, 1, "%02x: drawing area top left %d,%d\n", m_packet.n_entry[ 0 ] >> 24,
+			n_drawarea_x1, n_drawarea_y1 );
+		break;
+	case 0xe4:
+		n_drawarea_x2 = m_packet.n_entry[ 0 ] & 1023;
+		if( m_n_gputype == 2 )
+		{
+			n_drawarea_y2 = ( m_packet.n_entry[ 0 ] >> 10 ) & 1023;
+		}
+		else
+		{
+			n_drawarea_y2 = ( m_packet.n_entry[ 0 ] >> 12 ) & 1023;
+		}
+		verboselog( *this, 1, "%02x: drawing area bottom right %d,%d\n", m_packet.n_entry[ 0 ] >> 24,
+			n_drawarea_x2, n_drawarea_y2 );
+		break;
+	case 0xe5:
+		n_drawoffset_x = SINT11( m_packet.n_entry[ 0 ] & 2047 );
+		if( m_n_gputype == 2 )
+		{
+			n_drawoffset_y = SINT11( ( m_packet.n_entry[ 0 ] >> 11 ) & 2047 );
+		}
+		else
+		{
+			n_drawoffset_y = SINT11( ( m_packet.n_entry[ 0 ] >> 12 ) & 2047 );
+		}
+		verboselog( *this, 1, "%02x: drawing offset %d,%d\n", m_packet.n_entry[ 0 ] >> 24,
+			n_drawoffset_x, n_drawoffset_y );
+		break;
+	case 0xe6:
+		m_draw_stp = BIT( m_packet.n_entry[ 0 ], 0 );
+		m_check_stp = BIT( m_packet.n_entry[ 0 ], 1 );
+		break;
+	}
+}
+
+/*
+ * Drawing commands and the drawing state they use (texture page, texture window,
+ * drawing area and offset, mask bits) belong to a single drawing thread, which runs
+ * them in the order they were written. The emulation thread only waits for it when
+ * it reads vram or that state: for cpu to and from vram transfers, gpu info reads,
+ * resets, screen updates and saving.
+ */
+void psxgpu_device::queue_command()
+{
+	if( m_draw_queue == nullptr )
+	{
+		draw_command( m_gp0_packet );
+		return;
+	}
+
+	if( !m_draw_batch )
+	{
+		m_draw_batch = std::make_unique<draw_batch>();
+		m_draw_batch->gpu = this;
+		m_draw_batch->packets.reserve( DRAW_BATCH_SIZE );
+	}
+
+	m_draw_batch->packets.push_back( m_gp0_packet );
+	m_drawing = true;
+
+	if( m_draw_batch->packets.size() >= DRAW_BATCH_SIZE )
+	{
+		submit_commands();
+	}
+}
+
+void psxgpu_device::submit_commands()
+{
+	if( m_draw_batch && !m_draw_batch->packets.empty() )
+	{
+		draw_batch *batch = m_draw_batch.release();
+		if( osd_work_item_queue( m_draw_queue, draw_batch_callback, batch, WORK_ITEM_FLAG_AUTO_RELEASE ) == nullptr )
+		{
+			osd_work_queue_wait( m_draw_queue, osd_ticks_per_second() * 100 );
+			draw_batch_callback( batch, 0 );
+		}
+	}
+}
+
+void psxgpu_device::wait_for_drawing()
+{
+	if( m_drawing )
+	{
+		submit_commands();
+		osd_work_queue_wait( m_draw_queue, osd_ticks_per_second() * 100 );
+		m_drawing = false;
+	}
+}
+
+void *psxgpu_device::draw_batch_callback( void *param, int threadid )
+{
+	std::unique_ptr<draw_batch> batch( reinterpret_cast<draw_batch *>( param ) );
+
+	for( const PACKET &packet : batch->packets )
+	{
+		batch->gpu->draw_command( packet );
+	}
+	return nullptr;
+}
+
 void psxgpu_device::dma_write( uint32_t *p_n_psxram, uint32_t n_address, int32_t n_size )
 {
 	gpu_write( &p_n_psxram[ n_address / 4 ], n_size );
@@ -2760,13 +3046,15 @@ void psxgpu_device::dma_write( uint32_t *p_n_psxram, uint32_t n_address, int32_t
 
 void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 {
+	int32_t n_size_start = n_size;
+
 	while( n_size > 0 )
 	{
 		uint32_t data = *( p_ram );
 
 		verboselog( *this, 2, "PSX Packet #%u %08x\n", n_gpu_buffer_offset, data );
-		m_packet.n_entry[ n_gpu_buffer_offset ] = data;
-		switch( m_packet.n_entry[ 0 ] >> 24 )
+		m_gp0_packet.n_entry[ n_gpu_buffer_offset ] = data;
+		switch( m_gp0_packet.n_entry[ 0 ] >> 24 )
 		{
 		case 0x00:
 			verboselog( *this, 1, "not handled: GPU Command 0x00: (%08x)\n", data );
@@ -2781,9 +3069,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: frame buffer rectangle %u,%u %u,%u\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 1 ] & 0xffff, m_packet.n_entry[ 1 ] >> 16, m_packet.n_entry[ 2 ] & 0xffff, m_packet.n_entry[ 2 ] >> 16 );
-				FrameBufferRectangleDraw();
+				verboselog( *this, 1, "%02x: frame buffer rectangle %u,%u %u,%u\n", m_gp0_packet.n_entry[ 0 ] >> 24,
+					m_gp0_packet.n_entry[ 1 ] & 0xffff, m_gp0_packet.n_entry[ 1 ] >> 16, m_gp0_packet.n_entry[ 2 ] & 0xffff, m_gp0_packet.n_entry[ 2 ] >> 16 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2797,8 +3085,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: monochrome 3 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				FlatPolygon( 3 );
+				verboselog( *this, 1, "%02x: monochrome 3 point polygon\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2812,8 +3100,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: textured 3 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				FlatTexturedPolygon( 3 );
+				verboselog( *this, 1, "%02x: textured 3 point polygon\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				tpage_status( m_gp0_packet.n_entry[ 4 ] >> 16 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2827,8 +3116,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: monochrome 4 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				FlatPolygon( 4 );
+				verboselog( *this, 1, "%02x: monochrome 4 point polygon\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2842,8 +3131,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: textured 4 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				FlatTexturedPolygon( 4 );
+				verboselog( *this, 1, "%02x: textured 4 point polygon\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				tpage_status( m_gp0_packet.n_entry[ 4 ] >> 16 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2857,8 +3147,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud 3 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudPolygon( 3 );
+				verboselog( *this, 1, "%02x: gouraud 3 point polygon\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2872,8 +3162,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud textured 3 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudTexturedPolygon( 3 );
+				verboselog( *this, 1, "%02x: gouraud textured 3 point polygon\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				tpage_status( m_gp0_packet.n_entry[ 5 ] >> 16 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2887,8 +3178,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud 4 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudPolygon( 4 );
+				verboselog( *this, 1, "%02x: gouraud 4 point polygon\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2902,8 +3193,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud textured 4 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudTexturedPolygon( 4 );
+				verboselog( *this, 1, "%02x: gouraud textured 4 point polygon\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				tpage_status( m_gp0_packet.n_entry[ 5 ] >> 16 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2917,8 +3209,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: monochrome line\n", m_packet.n_entry[ 0 ] >> 24 );
-				MonochromeLine();
+				verboselog( *this, 1, "%02x: monochrome line\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2932,12 +3224,12 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: monochrome polyline\n", m_packet.n_entry[ 0 ] >> 24 );
-				MonochromeLine();
-				if( ( m_packet.n_entry[ 3 ] & 0xf000f000 ) != 0x50005000 )
+				verboselog( *this, 1, "%02x: monochrome polyline\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				queue_command();
+				if( ( m_gp0_packet.n_entry[ 3 ] & 0xf000f000 ) != 0x50005000 )
 				{
-					m_packet.n_entry[ 1 ] = m_packet.n_entry[ 2 ];
-					m_packet.n_entry[ 2 ] = m_packet.n_entry[ 3 ];
+					m_gp0_packet.n_entry[ 1 ] = m_gp0_packet.n_entry[ 2 ];
+					m_gp0_packet.n_entry[ 2 ] = m_gp0_packet.n_entry[ 3 ];
 					n_gpu_buffer_offset = 3;
 				}
 				else
@@ -2956,8 +3248,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud line\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudLine();
+				verboselog( *this, 1, "%02x: gouraud line\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -2966,20 +3258,20 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 		case 0x5c:
 		case 0x5e:
 			if( n_gpu_buffer_offset < 5 &&
-				( n_gpu_buffer_offset != 4 || ( m_packet.n_entry[ 4 ] & 0xf000f000 ) != 0x50005000 ) )
+				( n_gpu_buffer_offset != 4 || ( m_gp0_packet.n_entry[ 4 ] & 0xf000f000 ) != 0x50005000 ) )
 			{
 				n_gpu_buffer_offset++;
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud polyline\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudLine();
-				if( ( m_packet.n_entry[ 4 ] & 0xf000f000 ) != 0x50005000 )
+				verboselog( *this, 1, "%02x: gouraud polyline\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				queue_command();
+				if( ( m_gp0_packet.n_entry[ 4 ] & 0xf000f000 ) != 0x50005000 )
 				{
-					m_packet.n_entry[ 0 ] = ( m_packet.n_entry[ 0 ] & 0xff000000 ) | ( m_packet.n_entry[ 2 ] & 0x00ffffff );
-					m_packet.n_entry[ 1 ] = m_packet.n_entry[ 3 ];
-					m_packet.n_entry[ 2 ] = m_packet.n_entry[ 4 ];
-					m_packet.n_entry[ 3 ] = m_packet.n_entry[ 5 ];
+					m_gp0_packet.n_entry[ 0 ] = ( m_gp0_packet.n_entry[ 0 ] & 0xff000000 ) | ( m_gp0_packet.n_entry[ 2 ] & 0x00ffffff );
+					m_gp0_packet.n_entry[ 1 ] = m_gp0_packet.n_entry[ 3 ];
+					m_gp0_packet.n_entry[ 2 ] = m_gp0_packet.n_entry[ 4 ];
+					m_gp0_packet.n_entry[ 3 ] = m_gp0_packet.n_entry[ 5 ];
 					n_gpu_buffer_offset = 4;
 				}
 				else
@@ -2999,10 +3291,10 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			else
 			{
 				verboselog( *this, 1, "%02x: rectangle %d,%d %d,%d\n",
-					m_packet.n_entry[ 0 ] >> 24,
-					(int16_t)( m_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_packet.n_entry[ 1 ] >> 16 ),
-					(int16_t)( m_packet.n_entry[ 2 ] & 0xffff ), (int16_t)( m_packet.n_entry[ 2 ] >> 16 ) );
-				FlatRectangle();
+					m_gp0_packet.n_entry[ 0 ] >> 24,
+					(int16_t)( m_gp0_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_gp0_packet.n_entry[ 1 ] >> 16 ),
+					(int16_t)( m_gp0_packet.n_entry[ 2 ] & 0xffff ), (int16_t)( m_gp0_packet.n_entry[ 2 ] >> 16 ) );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3017,11 +3309,11 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			else
 			{
 				verboselog( *this, 1, "%02x: sprite %d,%d %u,%u %08x, %08x\n",
-					m_packet.n_entry[ 0 ] >> 24,
-					(int16_t)( m_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_packet.n_entry[ 1 ] >> 16 ),
-					m_packet.n_entry[ 3 ] & 0xffff, m_packet.n_entry[ 3 ] >> 16,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 2 ] );
-				FlatTexturedRectangle();
+					m_gp0_packet.n_entry[ 0 ] >> 24,
+					(int16_t)( m_gp0_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_gp0_packet.n_entry[ 1 ] >> 16 ),
+					m_gp0_packet.n_entry[ 3 ] & 0xffff, m_gp0_packet.n_entry[ 3 ] >> 16,
+					m_gp0_packet.n_entry[ 0 ], m_gp0_packet.n_entry[ 2 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3036,10 +3328,10 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			else
 			{
 				verboselog( *this, 1, "%02x: dot %d,%d %08x\n",
-					m_packet.n_entry[ 0 ] >> 24,
-					(int16_t)( m_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_packet.n_entry[ 1 ] >> 16 ),
-					m_packet.n_entry[ 0 ] & 0xffffff );
-				Dot();
+					m_gp0_packet.n_entry[ 0 ] >> 24,
+					(int16_t)( m_gp0_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_gp0_packet.n_entry[ 1 ] >> 16 ),
+					m_gp0_packet.n_entry[ 0 ] & 0xffffff );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3054,10 +3346,10 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			else
 			{
 				verboselog(*this, 1, "%02x: textured dot %d,%d %08x\n",
-					m_packet.n_entry[ 0 ] >> 24,
-					(int16_t)( m_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_packet.n_entry[ 1 ] >> 16 ),
-					m_packet.n_entry[ 0 ] & 0xffffff );
-				TexturedDot();
+					m_gp0_packet.n_entry[ 0 ] >> 24,
+					(int16_t)( m_gp0_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_gp0_packet.n_entry[ 1 ] >> 16 ),
+					m_gp0_packet.n_entry[ 0 ] & 0xffffff );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3072,9 +3364,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: 16x16 rectangle %08x %08x\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ] );
-				FlatRectangle8x8();
+				verboselog( *this, 1, "%02x: 16x16 rectangle %08x %08x\n", m_gp0_packet.n_entry[ 0 ] >> 24,
+					m_gp0_packet.n_entry[ 0 ], m_gp0_packet.n_entry[ 1 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3088,9 +3380,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: 8x8 sprite %08x %08x %08x\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ], m_packet.n_entry[ 2 ] );
-				Sprite8x8();
+				verboselog( *this, 1, "%02x: 8x8 sprite %08x %08x %08x\n", m_gp0_packet.n_entry[ 0 ] >> 24,
+					m_gp0_packet.n_entry[ 0 ], m_gp0_packet.n_entry[ 1 ], m_gp0_packet.n_entry[ 2 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3105,9 +3397,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: 16x16 rectangle %08x %08x\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ] );
-				FlatRectangle16x16();
+				verboselog( *this, 1, "%02x: 16x16 rectangle %08x %08x\n", m_gp0_packet.n_entry[ 0 ] >> 24,
+					m_gp0_packet.n_entry[ 0 ], m_gp0_packet.n_entry[ 1 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3121,9 +3413,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: 16x16 sprite %08x %08x %08x\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ], m_packet.n_entry[ 2 ] );
-				Sprite16x16();
+				verboselog( *this, 1, "%02x: 16x16 sprite %08x %08x %08x\n", m_gp0_packet.n_entry[ 0 ] >> 24,
+					m_gp0_packet.n_entry[ 0 ], m_gp0_packet.n_entry[ 1 ], m_gp0_packet.n_entry[ 2 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3134,8 +3426,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "move image in frame buffer %08x %08x %08x %08x\n", m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ], m_packet.n_entry[ 2 ], m_packet.n_entry[ 3 ] );
-				MoveImage();
+				verboselog( *this, 1, "move image in frame buffer %08x %08x %08x %08x\n", m_gp0_packet.n_entry[ 0 ], m_gp0_packet.n_entry[ 1 ], m_gp0_packet.n_entry[ 2 ], m_gp0_packet.n_entry[ 3 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3146,25 +3438,28 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
+				/* the image goes straight into vram, after anything already queued */
+				wait_for_drawing();
+
 				for( int n_pixel = 0; n_pixel < 2; n_pixel++ )
 				{
 					verboselog( *this, 2, "send image to framebuffer ( pixel %u,%u = %u )\n",
-						( n_vramx + m_packet.n_entry[ 1 ] ) & 1023,
-						( n_vramy + ( m_packet.n_entry[ 1 ] >> 16 ) ) & 1023,
+						( n_vramx + m_gp0_packet.n_entry[ 1 ] ) & 1023,
+						( n_vramy + ( m_gp0_packet.n_entry[ 1 ] >> 16 ) ) & 1023,
 						data & 0xffff );
 
-					uint16_t *p_vram = p_p_vram[ ( n_vramy + ( m_packet.n_entry[ 1 ] >> 16 ) ) & 1023 ] + ( ( n_vramx + m_packet.n_entry[ 1 ] ) & 1023 );
+					uint16_t *p_vram = p_p_vram[ ( n_vramy + ( m_gp0_packet.n_entry[ 1 ] >> 16 ) ) & 1023 ] + ( ( n_vramx + m_gp0_packet.n_entry[ 1 ] ) & 1023 );
 					WRITE_PIXEL( data & 0xffff )
 					n_vramx++;
-					if( n_vramx >= ( m_packet.n_entry[ 2 ] & 0xffff ) )
+					if( n_vramx >= ( m_gp0_packet.n_entry[ 2 ] & 0xffff ) )
 					{
 						n_vramx = 0;
 						n_vramy++;
-						if( n_vramy >= ( m_packet.n_entry[ 2 ] >> 16 ) )
+						if( n_vramy >= ( m_gp0_packet.n_entry[ 2 ] >> 16 ) )
 						{
-							verboselog( *this, 1, "%02x: send image to framebuffer %u,%u %u,%u\n", m_packet.n_entry[ 0 ] >> 24,
-								m_packet.n_entry[ 1 ] & 0xffff, ( m_packet.n_entry[ 1 ] >> 16 ),
-								m_packet.n_entry[ 2 ] & 0xffff, ( m_packet.n_entry[ 2 ] >> 16 ) );
+							verboselog( *this, 1, "%02x: send image to framebuffer %u,%u %u,%u\n", m_gp0_packet.n_entry[ 0 ] >> 24,
+								m_gp0_packet.n_entry[ 1 ] & 0xffff, ( m_gp0_packet.n_entry[ 1 ] >> 16 ),
+								m_gp0_packet.n_entry[ 2 ] & 0xffff, ( m_gp0_packet.n_entry[ 2 ] >> 16 ) );
 							n_gpu_buffer_offset = 0;
 							n_vramx = 0;
 							n_vramy = 0;
@@ -3182,75 +3477,35 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: copy image from frame buffer\n", m_packet.n_entry[ 0 ] >> 24 );
+				verboselog( *this, 1, "%02x: copy image from frame buffer\n", m_gp0_packet.n_entry[ 0 ] >> 24 );
+				wait_for_drawing();
 				n_gpustatus |= ( 1L << 0x1b );
 			}
 			break;
 		case 0xe1:
-			verboselog( *this, 1, "%02x: draw mode %06x\n", m_packet.n_entry[ 0 ] >> 24,
-				m_packet.n_entry[ 0 ] & 0xffffff );
-			decode_tpage( m_packet.n_entry[ 0 ] & 0xffffff );
+			verboselog( *this, 1, "%02x: draw mode %06x\n", m_gp0_packet.n_entry[ 0 ] >> 24,
+				m_gp0_packet.n_entry[ 0 ] & 0xffffff );
+			tpage_status( m_gp0_packet.n_entry[ 0 ] & 0xffffff );
+			queue_command();
 			break;
 		case 0xe2:
-			n_twy = ( ( ( m_packet.n_entry[ 0 ] >> 15 ) & 0x1f ) << 3 );
-			n_twx = ( ( ( m_packet.n_entry[ 0 ] >> 10 ) & 0x1f ) << 3 );
-			n_twh = 255 - ( ( ( m_packet.n_entry[ 0 ] >> 5 ) & 0x1f ) << 3 );
-			n_tww = 255 - ( ( m_packet.n_entry[ 0 ] & 0x1f ) << 3 );
-			verboselog( *this, 1, "%02x: texture window %u,%u %u,%u\n", m_packet.n_entry[ 0 ] >> 24,
-				n_twx, n_twy, n_tww, n_twh );
-			break;
 		case 0xe3:
-			n_drawarea_x1 = m_packet.n_entry[ 0 ] & 1023;
-			if( m_n_gputype == 2 )
-			{
-				n_drawarea_y1 = ( m_packet.n_entry[ 0 ] >> 10 ) & 1023;
-			}
-			else
-			{
-				n_drawarea_y1 = ( m_packet.n_entry[ 0 ] >> 12 ) & 1023;
-			}
-			verboselog( *this, 1, "%02x: drawing area top left %d,%d\n", m_packet.n_entry[ 0 ] >> 24,
-				n_drawarea_x1, n_drawarea_y1 );
-			break;
 		case 0xe4:
-			n_drawarea_x2 = m_packet.n_entry[ 0 ] & 1023;
-			if( m_n_gputype == 2 )
-			{
-				n_drawarea_y2 = ( m_packet.n_entry[ 0 ] >> 10 ) & 1023;
-			}
-			else
-			{
-				n_drawarea_y2 = ( m_packet.n_entry[ 0 ] >> 12 ) & 1023;
-			}
-			verboselog( *this, 1, "%02x: drawing area bottom right %d,%d\n", m_packet.n_entry[ 0 ] >> 24,
-				n_drawarea_x2, n_drawarea_y2 );
-			break;
 		case 0xe5:
-			n_drawoffset_x = SINT11( m_packet.n_entry[ 0 ] & 2047 );
-			if( m_n_gputype == 2 )
-			{
-				n_drawoffset_y = SINT11( ( m_packet.n_entry[ 0 ] >> 11 ) & 2047 );
-			}
-			else
-			{
-				n_drawoffset_y = SINT11( ( m_packet.n_entry[ 0 ] >> 12 ) & 2047 );
-			}
-			verboselog( *this, 1, "%02x: drawing offset %d,%d\n", m_packet.n_entry[ 0 ] >> 24,
-				n_drawoffset_x, n_drawoffset_y );
+			queue_command();
 			break;
 		case 0xe6:
-			m_draw_stp = BIT( data, 0 );
-			m_check_stp = BIT( data, 1 );
 			// TODO: confirm status bits on real type 1 gpu
 			n_gpustatus &= ~( 3L << 0xb );
 			n_gpustatus |= ( data & 0x03 ) << 0xb;
-			verboselog( *this, 1, "mask setting %d\n", m_packet.n_entry[ 0 ] & 3 );
+			verboselog( *this, 1, "mask setting %d\n", m_gp0_packet.n_entry[ 0 ] & 3 );
+			queue_command();
 			break;
 		default:
 #if defined( MAME_DEBUG )
-			popmessage( "unknown GPU packet %08x", m_packet.n_entry[ 0 ] );
+			popmessage( "unknown GPU packet %08x", m_gp0_packet.n_entry[ 0 ] );
 #endif
-			verboselog( *this, 0, "unknown GPU packet %08x (%08x)\n", m_packet.n_entry[ 0 ], data );
+			verboselog( *this, 0, "unknown GPU packet %08x (%08x)\n", m_gp0_packet.n_entry[ 0 ], data );
 #if ( STOP_ON_ERROR )
 			n_gpu_buffer_offset = 1;
 #endif
@@ -3259,6 +3514,12 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 		p_ram++;
 		n_size--;
 	}
+
+	/* let the drawing thread start on a dma block straight away */
+	if( n_size_start > 1 )
+	{
+		submit_commands();
+	}
 }
 
 WRITE32_MEMBER( psxgpu_device::write )
@@ -3337,6 +3598,9 @@ WRITE32_MEMBER( psxgpu_device::write )
 			n_lightgun_y = 0;
 			break;
 		case 0x10:
+			/* the drawing area and offset belong to the drawing thread */
+			wait_for_drawing();
+
 			switch( data & 0xff )
 			{
 			case 0x03:
@@ -3417,18 +3681,20 @@ void psxgpu_device::gpu_read( uint32_t *p_ram, int32_t n_size )
 		{
 			PAIR data;
 
+			wait_for_drawing();
+
 			verboselog( *this, 2, "copy image from frame buffer ( %d, %d )\n", n_vramx, n_vramy );
 			data.d = 0;
 			for( int n_pixel = 0; n_pixel < 2; n_pixel++ )
 			{
 				data.w.l = data.w.h;
-				data.w.h = *( p_p_vram[ ( n_vramy + ( m_packet.n_entry[ 1 ] >> 16 ) ) & 0x3ff ] + ( ( n_vramx + ( m_packet.n_entry[ 1 ] & 0xffff ) ) & 0x3ff ) );
+				data.w.h = *( p_p_vram[ ( n_vramy + ( m_gp0_packet.n_entry[ 1 ] >> 16 ) ) & 0x3ff ] + ( ( n_vramx + ( m_gp0_packet.n_entry[ 1 ] & 0xffff ) ) & 0x3ff ) );
 				n_vramx++;
-				if( n_vramx >= ( m_packet.n_entry[ 2 ] & 0xffff ) )
+				if( n_vramx >= ( m_gp0_packet.n_entry[ 2 ] & 0xffff ) )
 				{
 					n_vramx = 0;
 					n_vramy++;
-					if( n_vramy >= ( m_packet.n_entry[ 2 ] >> 16 ) )
+					if( n_vramy >= ( m_gp0_packet.n_entry[ 2 ] >> 16 ) )
 					{
 						verboselog( *this, 1, "copy image from frame buffer end\n" );
 						n_gpustatus &= ~( 1L << 0x1b );
@@ -3493,6 +3759,7 @@ void psxgpu_device::vblank(screen_device &screen, bool vblank_state)
 void psxgpu_device::gpu_reset()
 {
 	verboselog( *this, 1, "reset gpu\n" );
+	wait_for_drawing();
 	n_gpu_buffer_offset = 0;
 	n_gpustatus = 0x14802000;
 	n_drawarea_x1 = 0;
@@ -50,6 +50,8 @@ protected:
 	psxgpu_device(const machine_config &mconfig, device_type type, const char *tag, device_t *owner, uint32_t clock);
 
 	virtual void device_start() override;
+	virtual void device_stop() override;
+	virtual void device_pre_save() override;
 	virtual void device_post_load() override;
 	virtual void device_reset() override;
 	virtual void device_config_complete() override;
@@ -61,6 +63,7 @@ protected:
 
 private:
 	static constexpr unsigned DEBUG_COORDS = 10;
+	static constexpr unsigned DRAW_BATCH_SIZE = 64;
 
 	struct psx_gpu_debug
 	{
@@ -197,7 +200,14 @@ private:
 		} TexturedDot;
 	};
 
+	struct draw_batch
+	{
+		psxgpu_device *gpu;
+		std::vector<PACKET> packets;
+	};
+
 	void updatevisiblearea();
+	void tpage_status( uint32_t tpage );
 	void decode_tpage( uint32_t tpage );
 	void FlatPolygon( int n_points );
 	void FlatTexturedPolygon( int n_points );
@@ -215,6 +225,11 @@ private:
 	void Dot();
 	void TexturedDot();
 	void MoveImage();
+	void draw_command( const PACKET &packet );
+	void queue_command();
+	void submit_commands();
+	void wait_for_drawing();
+	static void *draw_batch_callback( void *param, int threadid );
 	void psx_gpu_init( int n_gputype );
 	void gpu_reset();
 	void gpu_read( uint32_t *p_ram, int32_t n_size );
@@ -259,7 +274,12 @@ private:
 	bool m_draw_stp;
 	bool m_check_stp;
 
-	PACKET m_packet;
+	PACKET m_packet;        // command being drawn
+	PACKET m_gp0_packet;    // command being received
+
+	osd_work_queue *m_draw_queue;
+	std::unique_ptr<draw_batch> m_draw_batch;
+	bool m_drawing;
 
 	uint16_t *p_p_vram[ 1024 ];
 
@@ -1022,38 +1022,52 @@ void snes_ppu_device::update_line_mode7( uint16_t curline, uint8_t layer, uint8_
 	x0 = ((ma * MODE7_CLIP(hs - xc)) & ~0x3f) + ((mb * mosaic_y[sy]) & ~0x3f) + ((mb * MODE7_CLIP(vs - yc)) & ~0x3f) + (xc << 8);
 	y0 = ((mc * MODE7_CLIP(hs - xc)) & ~0x3f) + ((md * mosaic_y[sy]) & ~0x3f) + ((md * MODE7_CLIP(vs - yc)) & ~0x3f) + (yc << 8);
 
-	for (sx = 0; sx < 256; sx++, xpos += xdir)
+	/* Fetch the whole line first, so the repeat mode is only checked once */
+	uint8_t colours[256];
+	switch (m_mode7.repeat)
 	{
-		tx = (x0 + (ma * mosaic_x[sx])) >> 8;
-		ty = (y0 + (mc * mosaic_x[sx])) >> 8;
-
-		switch (m_mode7.repeat)
-		{
-			case 0x00:  /* Repeat if outside screen area */
-			case 0x01:  /* Repeat if outside screen area */
-				tx &= 0x3ff;
-				ty &= 0x3ff;
+		case 0x00:  /* Repeat if outside screen area */
+		case 0x01:  /* Repeat if outside screen area */
+			for (sx = 0; sx < 256; sx++)
+			{
+				tx = ((x0 + (ma * mosaic_x[sx])) >> 8) & 0x3ff;
+				ty = ((y0 + (mc * mosaic_x[sx])) >> 8) & 0x3ff;
 				tiled = m_vram[((((tx >> 3) & 0x7f) + (((ty >> 3) & 0x7f) * 128)) * 2) % SNES_VRAM_SIZE] << 7;
-				colour = m_vram[(tiled + ((tx & 0x07) * 2) + ((ty & 0x07) * 16) + 1) % SNES_VRAM_SIZE];
-				break;
-			case 0x02:  /* Single colour backdrop screen if outside screen area */
+				colours[sx] = m_vram[(tiled + ((tx & 0x07) * 2) + ((ty & 0x07) * 16) + 1) % SNES_VRAM_SIZE];
+			}
+			break;
+		case 0x02:  /* Single colour backdrop screen if outside screen area */
+			for (sx = 0; sx < 256; sx++)
+			{
+				tx = (x0 + (ma * mosaic_x[sx])) >> 8;
+				ty = (y0 + (mc * mosaic_x[sx])) >> 8;
 				if ((tx >= 0) && (tx < 1024) && (ty >= 0) && (ty < 1024))
 				{
 					tiled = m_vram[((((tx >> 3) & 0x7f) + (((ty >> 3) & 0x7f) * 128)) * 2) % SNES_VRAM_SIZE] << 7;
-					colour = m_vram[(tiled + ((tx & 0x07) * 2) + ((ty & 0x07) * 16) + 1) % SNES_VRAM_SIZE];
+					colours[sx] = m_vram[(tiled + ((tx & 0x07) * 2) + ((ty & 0x07) * 16) + 1) % SNES_VRAM_SIZE];
 				}
 				else
-					colour = 0;
-				break;
-			case 0x03:  /* Character 0x00 repeat if outside screen area */
+					colours[sx] = 0;
+			}
+			break;
+		case 0x03:  /* Character 0x00 repeat if outside screen area */
+			for (sx = 0; sx < 256; sx++)
+			{
+				tx = (x0 + (ma * mosaic_x[sx])) >> 8;
+				ty = (y0 + (mc * mosaic_x[sx])) >> 8;
 				if ((tx >= 0) && (tx < 1024) && (ty >= 0) && (ty < 1024))
 					tiled = m_vram[((((tx >> 3) & 0x7f) + (((ty >> 3) & 0x7f) * 128)) * 2) % SNES_VRAM_SIZE] << 7;
 				else
 					tiled = 0;
 
-				colour = m_vram[(tiled + ((tx & 0x07) * 2) + ((ty & 0x07) * 16) + 1) % SNES_VRAM_SIZE];
-				break;
-		}
+				colours[sx] = m_vram[(tiled + ((tx & 0x07) * 2) + ((ty & 0x07) * 16) + 1) % SNES_VRAM_SIZE];
+			}
+			break;
+	}
+
+	for (sx = 0; sx < 256; sx++, xpos += xdir)
+	{
+		colour = colours[sx];
 
 		/* The last bit is for priority in EXTBG mode (used only for BG2) */
 		if (layer == SNES_BG2)
@@ -1853,13 +1867,10 @@ void snes_ppu_device::refresh_scanline( bitmap_rgb32 &bitmap, uint16_t curline )
 		memset(m_scanlines[SNES_SUBSCREEN].blend_exception, 0, SNES_SCR_WIDTH);
 
 		/* Draw back colour */
+		uint16_t const sub_back = (m_mode == 5 || m_mode == 6 || m_pseudo_hires) ? m_cgram[0] : m_cgram[FIXED_COLOUR];
 		for (ii = 0; ii < SNES_SCR_WIDTH; ii++)
 		{
-			if (m_mode == 5 || m_mode == 6 || m_pseudo_hires)
-				m_scanlines[SNES_SUBSCREEN].buffer[ii] = m_cgram[0];
-			else
-				m_scanlines[SNES_SUBSCREEN].buffer[ii] = m_cgram[FIXED_COLOUR];
-
+			m_scanlines[SNES_SUBSCREEN].buffer[ii] = sub_back;
 			m_scanlines[SNES_MAINSCREEN].buffer[ii] = m_cgram[0];
 		}
 
@@ -1895,11 +1906,17 @@ void snes_ppu_device::refresh_scanline( bitmap_rgb32 &bitmap, uint16_t curline )
 
 		fade = m_screen_brightness;
 
+		/* brightness is fixed for the line, so scale each 5-bit component once */
+		uint8_t faded[32];
+		for (x = 0; x < 32; x++)
+			faded[x] = pal5bit((x * fade) >> 4);
+
+		int const hires = (m_mode != 5 && m_mode != 6 && !m_pseudo_hires) ? 0 : 1;
+		uint32_t *const dest = &bitmap.pix32(curline);
+
 		for (x = 0; x < SNES_SCR_WIDTH; x++)
 		{
-			int r, g, b, hires;
 			uint16_t tmp_col[2];
-			hires = (m_mode != 5 && m_mode != 6 && !m_pseudo_hires) ? 0 : 1;
 
 			/* in hires, the first pixel (of 512) is subscreen pixel, then the first mainscreen pixel follows, and so on... */
 			if (!hires)
@@ -1910,12 +1927,7 @@ void snes_ppu_device::refresh_scanline( bitmap_rgb32 &bitmap, uint16_t curline )
 				if (!scanline1->blend_exception[x] && m_layer[scanline1->layer[x]].color_math)
 					draw_blend(x, &c, m_prevent_color_math, m_clip_to_black, 0);
 
-				r = ((c & 0x1f) * fade) >> 4;
-				g = (((c & 0x3e0) >> 5) * fade) >> 4;
-				b = (((c & 0x7c00) >> 10) * fade) >> 4;
-
-				bitmap.pix32(curline, x * 2 + 0) = rgb_t(pal5bit(r), pal5bit(g), pal5bit(b));
-				bitmap.pix32(curline, x * 2 + 1) = rgb_t(pal5bit(r), pal5bit(g), pal5bit(b));
+				dest[x * 2 + 0] = dest[x * 2 + 1] = rgb_t(faded[c & 0x1f], faded[(c & 0x3e0) >> 5], faded[(c & 0x7c00) >> 10]);
 			}
 			else
 			{
@@ -1949,11 +1961,7 @@ void snes_ppu_device::refresh_scanline( bitmap_rgb32 &bitmap, uint16_t curline )
 				else
 					c = tmp_col[0];
 
-				r = ((c & 0x1f) * fade) >> 4;
-				g = (((c & 0x3e0) >> 5) * fade) >> 4;
-				b = (((c & 0x7c00) >> 10) * fade) >> 4;
-
-				bitmap.pix32(curline, x * 2 + 0) = rgb_t(pal5bit(r), pal5bit(g), pal5bit(b));
+				dest[x * 2 + 0] = rgb_t(faded[c & 0x1f], faded[(c & 0x3e0) >> 5], faded[(c & 0x7c00) >> 10]);
 				prev_colour = tmp_col[0];
 
 				/* average the second pixel if required, or draw it directly*/
@@ -1962,11 +1970,7 @@ void snes_ppu_device::refresh_scanline( bitmap_rgb32 &bitmap, uint16_t curline )
 				else
 					c = tmp_col[1];
 
-				r = ((c & 0x1f) * fade) >> 4;
-				g = (((c & 0x3e0) >> 5) * fade) >> 4;
-				b = (((c & 0x7c00) >> 10) * fade) >> 4;
-
-				bitmap.pix32(curline, x * 2 + 1) = rgb_t(pal5bit(r), pal5bit(g), pal5bit(b));
+				dest[x * 2 + 1] = rgb_t(faded[c & 0x1f], faded[(c & 0x3e0) >> 5], faded[(c & 0x7c00) >> 10]);
 				prev_colour = tmp_col[1];
 			}
 		}
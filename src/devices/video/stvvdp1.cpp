@@ -208,6 +208,9 @@ void saturn_state::stv_clear_framebuffer( int which_framebuffer )
 				m_vdp1.framebuffer[ which_framebuffer ][((x&511)+(y&511)*512)] = m_vdp1.ewdr;
 	}
 
+	if ( which_framebuffer == m_vdp1.framebuffer_current_display )
+		stv_vdp2_render_dirty();
+
 	if ( VDP1_LOG ) logerror( "Clearing %d framebuffer\n", m_vdp1.framebuffer_current_draw );
 //  memset( m_vdp1.framebuffer[ which_framebuffer ], m_vdp1.ewdr, 1024 * 256 * sizeof(uint16_t) * 2 );
 }
@@ -217,6 +220,9 @@ void saturn_state::stv_prepare_framebuffers( void )
 {
 	int i,rowsize;
 
+	/* the displayed sprites change with the buffer pointers */
+	stv_vdp2_render_dirty();
+
 	rowsize = m_vdp1.framebuffer_width;
 	if ( m_vdp1.framebuffer_current_draw == 0 )
 	{
@@ -290,7 +296,10 @@ void saturn_state::stv_set_framebuffer_config( void )
 
 WRITE16_MEMBER( saturn_state::saturn_vdp1_regs_w )
 {
+	uint16_t const old_data = m_vdp1_regs[offset];
 	COMBINE_DATA(&m_vdp1_regs[offset]);
+	if (m_vdp1_regs[offset] != old_data)
+		stv_vdp2_render_dirty();
 
 	switch(offset)
 	{
@@ -111,6 +111,13 @@ In other words,the first three types uses the offset and not the color allocated
 #include "emu.h"
 #include "includes/saturn.h" // FIXME: this is a dependency from devices on MAME
 
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define STVVDP2_USE_SSE2    1
+#else
+#define STVVDP2_USE_SSE2    0
+#endif
+
 
 #define DEBUG_MODE 0
 #define TEST_FUNCTIONS 0
@@ -2374,6 +2381,81 @@ static inline uint32_t stv_add_blend(uint32_t a, uint32_t b)
 	);
 }
 
+/* stv_add_blend of one pen over a run of pixels: a saturating add with alpha forced on */
+static inline void stv_add_blend_run(uint32_t *dest, uint32_t pen, int count)
+{
+	int x = 0;
+#if STVVDP2_USE_SSE2
+	__m128i const add = _mm_set1_epi32(pen & 0x00ffffff);
+	__m128i const alpha = _mm_set1_epi32(0xff000000);
+	for ( ; x + 4 <= count; x += 4)
+	{
+		__m128i const d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(dest + x));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), _mm_or_si128(_mm_adds_epu8(d, add), alpha));
+	}
+#endif
+	for ( ; x < count; x++)
+		dest[x] = stv_add_blend(dest[x], pen);
+}
+
+/* a run of decoded cell pixels through a transparent pen; source steps by xinc */
+static inline void stv_transpen_run(uint32_t *dest, const uint8_t *source, int xinc, int count, const pen_t *pal, int transparent_color)
+{
+	int x = 0;
+#if STVVDP2_USE_SSE2
+	/* cells are mostly whole groups of transparent or opaque pixels */
+	if (xinc == 1 && transparent_color >= 0 && transparent_color <= 0xff)
+	{
+		__m128i const trans = _mm_set1_epi8(char(transparent_color));
+		for ( ; x + 8 <= count; x += 8)
+		{
+			int const mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(source + x)), trans)) & 0xff;
+			if (mask == 0xff)
+				continue;
+			for (int i = 0; i < 8; i++)
+				if (!BIT(mask, i))
+					dest[x + i] = pal[source[x + i]];
+		}
+	}
+#endif
+	for ( ; x < count; x++)
+	{
+		int c = source[x * xinc];
+		if (c != transparent_color)
+			dest[x] = pal[c];
+	}
+}
+
+/* as above, but alpha blended the way alpha_blend_r32 does it */
+static inline void stv_alpha_run(uint32_t *dest, const uint8_t *source, int xinc, int count, const pen_t *pal, int transparent_color, uint8_t alpha)
+{
+	int x = 0;
+#if STVVDP2_USE_SSE2
+	/* each channel is (s * alpha + d * (256 - alpha)) >> 8, which fits in 16 bits */
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const level = _mm_set1_epi16(alpha);
+	__m128i const inverse = _mm_set1_epi16(256 - alpha);
+	__m128i const rgb = _mm_set1_epi32(0x00ffffff);
+	for ( ; x + 4 <= count; x += 4)
+	{
+		int const c0 = source[(x + 0) * xinc], c1 = source[(x + 1) * xinc], c2 = source[(x + 2) * xinc], c3 = source[(x + 3) * xinc];
+		__m128i const keep = _mm_set_epi32(-(c3 == transparent_color), -(c2 == transparent_color), -(c1 == transparent_color), -(c0 == transparent_color));
+		__m128i const s = _mm_set_epi32(int(pal[c3]), int(pal[c2]), int(pal[c1]), int(pal[c0]));
+		__m128i const d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(dest + x));
+		__m128i const lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), level), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inverse));
+		__m128i const hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), level), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverse));
+		__m128i const blended = _mm_and_si128(_mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)), rgb);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), _mm_or_si128(_mm_andnot_si128(keep, blended), _mm_and_si128(keep, d)));
+	}
+#endif
+	for ( ; x < count; x++)
+	{
+		int c = source[x * xinc];
+		if (c != transparent_color)
+			dest[x] = alpha_blend_r32(dest[x], pal[c], alpha);
+	}
+}
+
 
 void saturn_state::stv_vdp2_compute_color_offset( int *r, int *g, int *b, int cor )
 {
@@ -3125,6 +3207,8 @@ void saturn_state::stv_vdp2_drawgfx_alpha(bitmap_rgb32 &dest_bmp,const rectangle
 	if (ex > sx)
 	{
 		int x, y;
+		/* with no window on the layer, rows go through the run helpers */
+		bool const windowed = stv2_current_tilemap.window_control.enabled[0] || stv2_current_tilemap.window_control.enabled[1];
 
 		{
 			for (y = sy; y < ey; y++)
@@ -3132,6 +3216,12 @@ void saturn_state::stv_vdp2_drawgfx_alpha(bitmap_rgb32 &dest_bmp,const rectangle
 				const uint8_t *source = source_base + y_index*gfx->rowbytes();
 				uint32_t *dest = &dest_bmp.pix32(y);
 				int x_index = x_index_base;
+				if (!windowed)
+				{
+					stv_alpha_run(dest + sx, source + x_index, xinc, ex - sx, pal, transparent_color, alpha);
+					y_index += yinc;
+					continue;
+				}
 				for (x = sx; x < ex; x++)
 				{
 					if(stv_vdp2_window_process(x,y))
@@ -3202,6 +3292,8 @@ void saturn_state::stv_vdp2_drawgfx_transpen(bitmap_rgb32 &dest_bmp,const rectan
 	if (ex > sx)
 	{
 		int x, y;
+		/* with no window on the layer, rows go through the run helpers */
+		bool const windowed = stv2_current_tilemap.window_control.enabled[0] || stv2_current_tilemap.window_control.enabled[1];
 
 		{
 			for (y = sy; y < ey; y++)
@@ -3209,6 +3301,12 @@ void saturn_state::stv_vdp2_drawgfx_transpen(bitmap_rgb32 &dest_bmp,const rectan
 				const uint8_t *source = source_base + y_index*gfx->rowbytes();
 				uint32_t *dest = &dest_bmp.pix32(y);
 				int x_index = x_index_base;
+				if (!windowed)
+				{
+					stv_transpen_run(dest + sx, source + x_index, xinc, ex - sx, pal, transparent_color);
+					y_index += yinc;
+					continue;
+				}
 				for (x = sx; x < ex; x++)
 				{
 					if(stv_vdp2_window_process(x,y))
@@ -4377,10 +4475,10 @@ void saturn_state::stv_vdp2_check_tilemap_with_linescroll(bitmap_rgb32 &bitmap,
 
 void saturn_state::stv_vdp2_draw_line(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
-	int x,y;
+	int y;
 	uint8_t* gfxdata = m_vdp2.gfx_decode.get();
 	uint32_t base_offs,base_mask;
-	uint32_t pix;
+	uint16_t pen;
 	uint8_t interlace;
 
 	interlace = (STV_VDP2_LSMD == 3)+1;
@@ -4395,15 +4493,9 @@ void saturn_state::stv_vdp2_draw_line(bitmap_rgb32 &bitmap, const rectangle &cli
 			if(STV_VDP2_LCCLMD)
 				base_offs += (y / interlace) << 1;
 
-			for(x=cliprect.left();x<=cliprect.right();x++)
-			{
-				uint16_t pen;
-
-				pen = (gfxdata[base_offs+0]<<8)|gfxdata[base_offs+1];
-				pix = bitmap.pix32(y, x);
-
-				bitmap.pix32(y, x) = stv_add_blend(m_palette->pen(pen & 0x7ff),pix);
-			}
+			/* the colour is the same across the whole line */
+			pen = (gfxdata[base_offs+0]<<8)|gfxdata[base_offs+1];
+			stv_add_blend_run(&bitmap.pix32(y, cliprect.left()), m_palette->pen(pen & 0x7ff), cliprect.width());
 		}
 	}
 }
@@ -5860,10 +5952,13 @@ READ32_MEMBER ( saturn_state::saturn_vdp2_vram_r )
 WRITE32_MEMBER ( saturn_state::saturn_vdp2_vram_w )
 {
 	uint8_t* gfxdata = m_vdp2.gfx_decode.get();
+	uint32_t old_data = m_vdp2_vram[offset];
 
 	COMBINE_DATA(&m_vdp2_vram[offset]);
 
 	data = m_vdp2_vram[offset];
+	if (data != old_data)
+		stv_vdp2_render_dirty();
 	/* put in gfx region for easy decoding */
 	gfxdata[offset*4+0] = (data & 0xff000000) >> 24;
 	gfxdata[offset*4+1] = (data & 0x00ff0000) >> 16;
@@ -6006,7 +6101,10 @@ WRITE32_MEMBER ( saturn_state::saturn_vdp2_cram_w )
 	cmode0 = (STV_VDP2_CRMD & 3) == 0;
 
 	offset &= (0xfff) >> (2);
+	uint32_t old_data = m_vdp2_cram[offset];
 	COMBINE_DATA(&m_vdp2_cram[offset]);
+	if (m_vdp2_cram[offset] != old_data)
+		stv_vdp2_render_dirty();
 
 	switch( STV_VDP2_CRMD )
 	{
@@ -6106,7 +6204,10 @@ void saturn_state::refresh_palette_data( void )
 
 WRITE16_MEMBER ( saturn_state::saturn_vdp2_regs_w )
 {
+	uint16_t old_data = m_vdp2_regs[offset];
 	COMBINE_DATA(&m_vdp2_regs[offset]);
+	if (m_vdp2_regs[offset] != old_data)
+		stv_vdp2_render_dirty();
 
 	if(m_vdp2.old_crmd != STV_VDP2_CRMD)
 	{
@@ -6324,6 +6425,7 @@ void saturn_state::stv_vdp2_state_save_postload( void )
 	memset( &stv_vdp2_layer_data_placement, 0, sizeof(stv_vdp2_layer_data_placement));
 
 	refresh_palette_data();
+	stv_vdp2_render_dirty();
 }
 
 void saturn_state::stv_vdp2_exit ( void )
@@ -6340,6 +6442,7 @@ int saturn_state::stv_vdp2_start ( void )
 	m_vdp2_vram = make_unique_clear<uint32_t[]>(0x100000/4 );
 	m_vdp2_cram = make_unique_clear<uint32_t[]>(0x080000/4 );
 	m_vdp2.gfx_decode = std::make_unique<uint8_t[]>(0x100000 );
+	m_vdp2.render_serial = 1;
 
 //  m_gfxdecode->gfx(0)->granularity()=4;
 //  m_gfxdecode->gfx(1)->granularity()=4;
@@ -6430,6 +6533,9 @@ void saturn_state::stv_vdp2_dynamic_res_change( void )
 		m_screen->configure(hblank_period, vblank_period, visarea, refresh );
 	}
 //  m_screen->set_visible_area(0*8, horz_res-1,0*8, vert_res-1);
+
+	/* the screen bitmaps may have been reallocated */
+	stv_vdp2_render_dirty();
 }
 
 /*This is for calculating the rgb brightness*/
@@ -7202,8 +7308,59 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 	stv_sprite_priorities_usage_valid = 1;
 }
 
+void saturn_state::stv_vdp2_render_dirty( void )
+{
+	/* on wraparound forget every line rather than risk matching a very old one */
+	if (++m_vdp2.render_serial == 0)
+	{
+		m_vdp2.render_serial = 1;
+		for (stv_vdp2_line_cache &line : m_vdp2_line_cache)
+			line.serial = 0;
+	}
+}
+
+bool saturn_state::stv_vdp2_lines_cached( const rectangle &cliprect )
+{
+	if (int(m_vdp2_line_cache.size()) != m_tmpbitmap.height())
+	{
+		m_vdp2_line_cache.assign(m_tmpbitmap.height(), stv_vdp2_line_cache{ 0, 0, 0, 0 });
+		return false;
+	}
+	if (cliprect.top() < 0 || cliprect.bottom() >= int(m_vdp2_line_cache.size()))
+		return false;
+
+	/* the composite is only reused when each line was drawn with the same cliprect and state */
+	for (int y = cliprect.top(); y <= cliprect.bottom(); y++)
+	{
+		const stv_vdp2_line_cache &line = m_vdp2_line_cache[y];
+		if (line.serial != m_vdp2.render_serial || line.top != cliprect.top() || line.left != cliprect.left() || line.right != cliprect.right())
+			return false;
+	}
+	return true;
+}
+
+void saturn_state::stv_vdp2_cache_lines( const rectangle &cliprect )
+{
+	/* mosaic can spill past the bottom of the cliprect, so lines outside it are no longer trusted */
+	for (int y = 0; y < int(m_vdp2_line_cache.size()); y++)
+	{
+		stv_vdp2_line_cache &line = m_vdp2_line_cache[y];
+		if (y >= cliprect.top() && y <= cliprect.bottom())
+			line = stv_vdp2_line_cache{ m_vdp2.render_serial, cliprect.top(), cliprect.left(), cliprect.right() };
+		else
+			line.serial = 0;
+	}
+}
+
 uint32_t saturn_state::screen_update_stv_vdp2(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
+	/* nothing the layers and sprites read has been written since these lines were drawn */
+	if (stv_vdp2_lines_cached(cliprect))
+	{
+		copybitmap(bitmap, m_tmpbitmap, 0, 0, 0, 0, cliprect);
+		return 0;
+	}
+
 	stv_vdp2_fade_effects();
 
 	stv_vdp2_draw_back(m_tmpbitmap,cliprect);
@@ -7228,6 +7385,8 @@ uint32_t saturn_state::screen_update_stv_vdp2(screen_device &screen, bitmap_rgb3
 		}
 	}
 
+	stv_vdp2_cache_lines(cliprect);
+
 	copybitmap(bitmap, m_tmpbitmap, 0, 0, 0, 0, cliprect);
 
 	#if 0
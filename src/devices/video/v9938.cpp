@@ -131,6 +131,7 @@ v99x8_device::v99x8_device(const machine_config &mconfig, device_type type, cons
 	m_button_state(0),
 	m_vdp_ops_count(0),
 	m_vdp_engine(nullptr),
+	m_vram_direct(nullptr),
 	m_pal_ntsc(0)
 {
 	set_addrmap(AS_DATA, address_map_constructor(FUNC(v99x8_device::memmap), this));
@@ -603,6 +604,11 @@ void v99x8_device::device_start()
 	// Video RAM is allocated as an own address space
 	m_vram_space = &space(AS_DATA);
 
+	// the command engine works on VRAM directly when it is one contiguous block of RAM
+	m_vram_direct = reinterpret_cast<uint8_t *>(m_vram_space->get_write_ptr(0));
+	if (m_vram_direct && (reinterpret_cast<uint8_t *>(m_vram_space->get_write_ptr(0x2ffff)) != (m_vram_direct + 0x2ffff)))
+		m_vram_direct = nullptr;
+
 	// allocate VRAM
 	assert(m_vram_size > 0);
 
@@ -2171,6 +2177,22 @@ static const int lmmm_timing[8]={
 	964,  1257, 964,  977
 };
 
+/** cmd_vram_read()/cmd_vram_write() **********************/
+/** Access VRAM from the command engine                      **/
+/*************************************************************/
+inline uint8_t v99x8_device::cmd_vram_read(int addr)
+{
+	return m_vram_direct ? m_vram_direct[addr] : m_vram_space->read_byte(addr);
+}
+
+inline void v99x8_device::cmd_vram_write(int addr, uint8_t data)
+{
+	if (m_vram_direct)
+		m_vram_direct[addr] = data;
+	else
+		m_vram_space->write_byte(addr, data);
+}
+
 /** VDPVRMP() **********************************************/
 /** Calculate addr of a pixel in vram                       **/
 /*************************************************************/
@@ -2192,7 +2214,7 @@ inline int v99x8_device::VDPVRMP(uint8_t M,int MX,int X,int Y)
 /*************************************************************/
 inline uint8_t v99x8_device::VDPpoint5(int MXS, int SX, int SY)
 {
-	return (m_vram_space->read_byte(VDP_VRMP5(MXS, SX, SY)) >>
+	return (cmd_vram_read(VDP_VRMP5(MXS, SX, SY)) >>
 		(((~SX)&1)<<2)
 		)&15;
 }
@@ -2202,7 +2224,7 @@ inline uint8_t v99x8_device::VDPpoint5(int MXS, int SX, int SY)
 /*************************************************************/
 inline uint8_t v99x8_device::VDPpoint6(int MXS, int SX, int SY)
 {
-	return (m_vram_space->read_byte(VDP_VRMP6(MXS, SX, SY)) >>
+	return (cmd_vram_read(VDP_VRMP6(MXS, SX, SY)) >>
 		(((~SX)&3)<<1)
 		)&3;
 }
@@ -2212,7 +2234,7 @@ inline uint8_t v99x8_device::VDPpoint6(int MXS, int SX, int SY)
 /*************************************************************/
 inline uint8_t v99x8_device::VDPpoint7(int MXS, int SX, int SY)
 {
-	return (m_vram_space->read_byte(VDP_VRMP7(MXS, SX, SY)) >>
+	return (cmd_vram_read(VDP_VRMP7(MXS, SX, SY)) >>
 		(((~SX)&1)<<2)
 		)&15;
 }
@@ -2222,7 +2244,7 @@ inline uint8_t v99x8_device::VDPpoint7(int MXS, int SX, int SY)
 /*************************************************************/
 inline uint8_t v99x8_device::VDPpoint8(int MXS, int SX, int SY)
 {
-	return m_vram_space->read_byte(VDP_VRMP8(MXS, SX, SY));
+	return cmd_vram_read(VDP_VRMP8(MXS, SX, SY));
 }
 
 /** VDPpoint() ************************************************/
@@ -2247,9 +2269,7 @@ inline uint8_t v99x8_device::VDPpoint(uint8_t SM, int MXS, int SX, int SY)
 /*************************************************************/
 inline void v99x8_device::VDPpsetlowlevel(int addr, uint8_t CL, uint8_t M, uint8_t OP)
 {
-	// If this turns out to be too slow, get a pointer to the address space
-	// and work directly on it.
-	uint8_t val = m_vram_space->read_byte(addr);
+	uint8_t val = cmd_vram_read(addr);
 	switch (OP)
 	{
 	case 0: val = (val & M) | CL; break;
@@ -2266,7 +2286,7 @@ inline void v99x8_device::VDPpsetlowlevel(int addr, uint8_t CL, uint8_t M, uint8
 		LOGMASKED(LOG_WARN, "Invalid operation %d in pset\n", OP);
 	}
 
-	m_vram_space->write_byte(addr, val);
+	cmd_vram_write(addr, val);
 }
 
 /** VDPpset5() ***********************************************/
@@ -2658,15 +2678,65 @@ void v99x8_device::hmmv_engine()
 	delta = get_vdp_timing_value(hmmv_timing);
 	cnt = m_vdp_ops_count;
 
-	switch (m_mode) {
+	// In GRAPHIC4/5 a row is a run of consecutive bytes, so each stretch of the
+	// row that fits in the time budget is filled in one go. The loop state and
+	// cycle count end up exactly where the byte-at-a-time loop would leave them.
+	if (m_vram_direct && ((m_mode == V9938_MODE_GRAPHIC4) || (m_mode == V9938_MODE_GRAPHIC5)))
+	{
+		int const MX = (m_mode == V9938_MODE_GRAPHIC4) ? 256 : 512;
+		int const SH = (m_mode == V9938_MODE_GRAPHIC4) ? 1 : 2;
+		for (;;)
+		{
+			int const allowed = (cnt > 0) ? ((cnt - 1) / delta) : 0;
+			if (!allowed)
+			{
+				cnt -= delta;
+				break;
+			}
+
+			// count the bytes left in this row, up to the budget
+			int n = 1, x = ADX;
+			bool row_end;
+			for (;; n++)
+			{
+				if ((n == ANX) || ((x += TX) & MX)) { row_end = true; break; }
+				if (n == allowed) { row_end = false; break; }
+			}
+
+			int const last = ADX + (n - 1) * TX;
+			if ((ADX >= 0) && (ADX < MX) && (last >= 0) && (last < MX))
+			{
+				int const base = (!MXD) ? ((DY & 1023) << 7) : (EXPMEM_OFFSET + ((DY & 511) << 7));
+				memset(m_vram_direct + base + (std::min(ADX, last) >> SH), CL, n);
+			}
+			else
+			{
+				for (int i = 0, ax = ADX; i < n; i++, ax += TX)
+					cmd_vram_write(VDP_VRMP(m_mode - V9938_MODE_GRAPHIC4, MXD, ax, DY), CL);
+			}
+			cnt -= n * delta;
+
+			if (row_end) {
+				if (!(--NY&1023) || (DY+=TY)==-1)
+					break;
+				ADX=DX;
+				ANX=NX;
+			}
+			else {
+				ANX-=n;
+				ADX+=n*TX;
+			}
+		}
+	}
+	else switch (m_mode) {
 	default:
-	case V9938_MODE_GRAPHIC4: pre_loop m_vram_space->write_byte(VDP_VRMP5(MXD, ADX, DY), CL); post__x_y(256)
+	case V9938_MODE_GRAPHIC4: pre_loop cmd_vram_write(VDP_VRMP5(MXD, ADX, DY), CL); post__x_y(256)
 		break;
-	case V9938_MODE_GRAPHIC5: pre_loop m_vram_space->write_byte(VDP_VRMP6(MXD, ADX, DY), CL); post__x_y(512)
+	case V9938_MODE_GRAPHIC5: pre_loop cmd_vram_write(VDP_VRMP6(MXD, ADX, DY), CL); post__x_y(512)
 		break;
-	case V9938_MODE_GRAPHIC6: pre_loop m_vram_space->write_byte(VDP_VRMP7(MXD, ADX, DY), CL); post__x_y(512)
+	case V9938_MODE_GRAPHIC6: pre_loop cmd_vram_write(VDP_VRMP7(MXD, ADX, DY), CL); post__x_y(512)
 		break;
-	case V9938_MODE_GRAPHIC7: pre_loop m_vram_space->write_byte(VDP_VRMP8(MXD, ADX, DY), CL); post__x_y(256)
+	case V9938_MODE_GRAPHIC7: pre_loop cmd_vram_write(VDP_VRMP8(MXD, ADX, DY), CL); post__x_y(256)
 		break;
 	}
 
@@ -2713,15 +2783,71 @@ void v99x8_device::hmmm_engine()
 	delta = get_vdp_timing_value(hmmm_timing);
 	cnt = m_vdp_ops_count;
 
-	switch (m_mode) {
+	// GRAPHIC4/5 rows are copied a run at a time, as in hmmv_engine(); runs whose
+	// source overlaps bytes already written keep the byte-at-a-time order
+	if (m_vram_direct && ((m_mode == V9938_MODE_GRAPHIC4) || (m_mode == V9938_MODE_GRAPHIC5)))
+	{
+		int const MX = (m_mode == V9938_MODE_GRAPHIC4) ? 256 : 512;
+		int const step = (TX > 0) ? 1 : -1;
+		for (;;)
+		{
+			int const allowed = (cnt > 0) ? ((cnt - 1) / delta) : 0;
+			if (!allowed)
+			{
+				cnt -= delta;
+				break;
+			}
+
+			int n = 1, xs = ASX, xd = ADX;
+			bool row_end;
+			for (;; n++)
+			{
+				if ((n == ANX) || ((xs += TX) & MX) || ((xd += TX) & MX)) { row_end = true; break; }
+				if (n == allowed) { row_end = false; break; }
+			}
+
+			int const lasts = ASX + (n - 1) * TX;
+			int const lastd = ADX + (n - 1) * TX;
+			int const s = VDP_VRMP(m_mode - V9938_MODE_GRAPHIC4, MXS, ASX, SY);
+			int const d = VDP_VRMP(m_mode - V9938_MODE_GRAPHIC4, MXD, ADX, DY);
+			int const ahead = (d - s) * step;
+			if ((ASX >= 0) && (ASX < MX) && (lasts >= 0) && (lasts < MX) &&
+				(ADX >= 0) && (ADX < MX) && (lastd >= 0) && (lastd < MX) &&
+				((ahead <= 0) || (ahead >= n)))
+			{
+				int const lo = (step > 0) ? 0 : (n - 1);
+				memmove(m_vram_direct + d - lo, m_vram_direct + s - lo, n);
+			}
+			else
+			{
+				for (int i = 0, as = ASX, ad = ADX; i < n; i++, as += TX, ad += TX)
+					cmd_vram_write(VDP_VRMP(m_mode - V9938_MODE_GRAPHIC4, MXD, ad, DY), cmd_vram_read(VDP_VRMP(m_mode - V9938_MODE_GRAPHIC4, MXS, as, SY)));
+			}
+			cnt -= n * delta;
+
+			if (row_end) {
+				if (!(--NY&1023) || (SY+=TY)==-1 || (DY+=TY)==-1)
+					break;
+				ASX=SX;
+				ADX=DX;
+				ANX=NX;
+			}
+			else {
+				ANX-=n;
+				ASX+=n*TX;
+				ADX+=n*TX;
+			}
+		}
+	}
+	else switch (m_mode) {
 	default:
-	case V9938_MODE_GRAPHIC4: pre_loop m_vram_space->write_byte(VDP_VRMP5(MXD, ADX, DY), m_vram_space->read_byte(VDP_VRMP5(MXS, ASX, SY))); post_xxyy(256)
+	case V9938_MODE_GRAPHIC4: pre_loop cmd_vram_write(VDP_VRMP5(MXD, ADX, DY), cmd_vram_read(VDP_VRMP5(MXS, ASX, SY))); post_xxyy(256)
 		break;
-	case V9938_MODE_GRAPHIC5: pre_loop m_vram_space->write_byte(VDP_VRMP6(MXD, ADX, DY), m_vram_space->read_byte(VDP_VRMP6(MXS, ASX, SY))); post_xxyy(512)
+	case V9938_MODE_GRAPHIC5: pre_loop cmd_vram_write(VDP_VRMP6(MXD, ADX, DY), cmd_vram_read(VDP_VRMP6(MXS, ASX, SY))); post_xxyy(512)
 		break;
-	case V9938_MODE_GRAPHIC6: pre_loop m_vram_space->write_byte(VDP_VRMP7(MXD, ADX, DY), m_vram_space->read_byte(VDP_VRMP7(MXS, ASX, SY))); post_xxyy(512)
+	case V9938_MODE_GRAPHIC6: pre_loop cmd_vram_write(VDP_VRMP7(MXD, ADX, DY), cmd_vram_read(VDP_VRMP7(MXS, ASX, SY))); post_xxyy(512)
 		break;
-	case V9938_MODE_GRAPHIC7: pre_loop m_vram_space->write_byte(VDP_VRMP8(MXD, ADX, DY), m_vram_space->read_byte(VDP_VRMP8(MXS, ASX, SY))); post_xxyy(256)
+	case V9938_MODE_GRAPHIC7: pre_loop cmd_vram_write(VDP_VRMP8(MXD, ADX, DY), cmd_vram_read(VDP_VRMP8(MXS, ASX, SY))); post_xxyy(256)
 		break;
 	}
 
@@ -2773,15 +2899,62 @@ void v99x8_device::ymmm_engine()
 	delta = get_vdp_timing_value(ymmm_timing);
 	cnt = m_vdp_ops_count;
 
-	switch (m_mode) {
+	// GRAPHIC4/5 rows are copied a run at a time, as in hmmv_engine()
+	if (m_vram_direct && ((m_mode == V9938_MODE_GRAPHIC4) || (m_mode == V9938_MODE_GRAPHIC5)))
+	{
+		int const MX = (m_mode == V9938_MODE_GRAPHIC4) ? 256 : 512;
+		int const step = (TX > 0) ? 1 : -1;
+		for (;;)
+		{
+			int const allowed = (cnt > 0) ? ((cnt - 1) / delta) : 0;
+			if (!allowed)
+			{
+				cnt -= delta;
+				break;
+			}
+
+			int n = 1, x = ADX;
+			bool row_end;
+			for (;; n++)
+			{
+				if ((x += TX) & MX) { row_end = true; break; }
+				if (n == allowed) { row_end = false; break; }
+			}
+
+			int const last = ADX + (n - 1) * TX;
+			if ((ADX >= 0) && (ADX < MX) && (last >= 0) && (last < MX))
+			{
+				// source and destination are distinct rows or the very same bytes
+				int const lo = (step > 0) ? 0 : (n - 1);
+				int const s = VDP_VRMP(m_mode - V9938_MODE_GRAPHIC4, MXD, ADX, SY);
+				int const d = VDP_VRMP(m_mode - V9938_MODE_GRAPHIC4, MXD, ADX, DY);
+				memmove(m_vram_direct + d - lo, m_vram_direct + s - lo, n);
+			}
+			else
+			{
+				for (int i = 0, ax = ADX; i < n; i++, ax += TX)
+					cmd_vram_write(VDP_VRMP(m_mode - V9938_MODE_GRAPHIC4, MXD, ax, DY), cmd_vram_read(VDP_VRMP(m_mode - V9938_MODE_GRAPHIC4, MXD, ax, SY)));
+			}
+			cnt -= n * delta;
+
+			if (row_end) {
+				if (!(--NY&1023) || (SY+=TY)==-1 || (DY+=TY)==-1)
+					break;
+				ADX=DX;
+			}
+			else
+				ADX+=n*TX;
+		}
+	}
+	else switch (m_mode) {
 	default:
-	case V9938_MODE_GRAPHIC4: pre_loop m_vram_space->write_byte(VDP_VRMP5(MXD, ADX, DY), m_vram_space->read_byte(VDP_VRMP5(MXD, ADX, SY))); post__xyy(256)
+	case V9938_MODE_GRAPHIC4: pre_loop cmd_vram_write(VDP_VRMP5(MXD, ADX, DY), cmd_vram_read(VDP_VRMP5(MXD, ADX, SY))); post__xyy(256)
 		break;
-	case V9938_MODE_GRAPHIC5: pre_loop m_vram_space->write_byte(VDP_VRMP6(MXD, ADX, DY), m_vram_space->read_byte(VDP_VRMP6(MXD, ADX, SY))); post__xyy(512)
+	case V9938_MODE_GRAPHIC5: pre_loop cmd_vram_write(VDP_VRMP6(MXD, ADX, DY), cmd_vram_read(VDP_VRMP6(MXD, ADX, SY))); post__xyy(512)
 		break;
-	case V9938_MODE_GRAPHIC6: pre_loop m_vram_space->write_byte(VDP_VRMP7(MXD, ADX, DY), m_vram_space->read_byte(VDP_VRMP7(MXD, ADX, SY))); post__xyy(512)
+	case V9938_MODE_GRAPHIC6: pre_loop cmd_vram_write(VDP_VRMP7(MXD, ADX, DY), cmd_vram_read(VDP_VRMP7(MXD, ADX, SY))); post__xyy(512)
 		break;
-	case V9938_MODE_GRAPHIC7: pre_loop m_vram_space->write_byte(VDP_VRMP8(MXD, ADX, DY), m_vram_space->read_byte(VDP_VRMP8(MXD, ADX, SY))); post__xyy(256)
+	case V9938_MODE_GRAPHIC7: pre_loop cmd_vram_write(VDP_VRMP8(MXD, ADX, DY), cmd_vram_read(VDP_VRMP8(MXD, ADX, SY))); post__xyy(256)
 		break;
 	}
 
@@ -2817,7 +2990,7 @@ void v99x8_device::ymmm_engine()
 void v99x8_device::hmmc_engine()
 {
 	if ((m_stat_reg[2]&0x80)!=0x80) {
-		m_vram_space->write_byte(VDP_VRMP(((m_mode >= 5) && (m_mode <= 8)) ? (m_mode-5) : 0, m_mmc.MXD, m_mmc.ADX, m_mmc.DY), m_cont_reg[44]);
+		cmd_vram_write(VDP_VRMP(((m_mode >= 5) && (m_mode <= 8)) ? (m_mode-5) : 0, m_mmc.MXD, m_mmc.ADX, m_mmc.DY), m_cont_reg[44]);
 		m_vdp_ops_count -= get_vdp_timing_value(hmmv_timing);
 		m_stat_reg[2]|=0x80;
 
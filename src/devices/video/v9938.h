@@ -151,6 +151,9 @@ private:
 
 	void interrupt_start_vblank();
 
+	uint8_t cmd_vram_read(int addr);
+	void cmd_vram_write(int addr, uint8_t data);
+
 	int VDPVRMP(uint8_t M, int MX, int X, int Y);
 
 	uint8_t VDPpoint5(int MXS, int SX, int SY);
@@ -231,6 +234,7 @@ private:
 	} m_mmc;
 	int  m_vdp_ops_count;
 	void (v99x8_device::*m_vdp_engine)();
+	uint8_t *m_vram_direct;
 
 	struct v99x8_mode
 	{
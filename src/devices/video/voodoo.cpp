@@ -143,6 +143,7 @@ bits(7:4) and bit(24)), X, and Y:
 
 
 #include "emu.h"
+#include "emuopts.h"
 #include "voodoo.h"
 #include "vooddefs.h"
 
@@ -544,6 +545,7 @@ void voodoo_device::tmu_state::init(uint8_t vdt, tmu_shared_state &share, voodoo
 	mask = tmem - 1;
 	reg = r;
 	regdirty = true;
+	clear_pending();
 	bilinear_mask = (vdt >= TYPE_VOODOO_2) ? 0xff : 0xf0;
 
 	/* mark the NCC tables dirty and configure their registers */
@@ -1378,6 +1380,22 @@ void voodoo_device::tmu_state::recompute_texture_params()
 		lodoffset[lod] = base & mask;
 	}
 
+	/* compute the span of RAM the rasterizers can fetch from; LOD 0 is the largest, so */
+	/* sizing every LOD like it stays conservative; anything that wraps claims all of RAM */
+	texstart = mask + 1;
+	texend = 0;
+	for (lod = 0; lod <= 8; lod++)
+	{
+		uint32_t size = (((wmask >> lod) + 1) * ((hmask >> lod) + 1)) << bppscale;
+		texstart = std::min(texstart, lodoffset[lod]);
+		texend = std::max(texend, lodoffset[lod] + size);
+	}
+	if (texend > mask + 1)
+	{
+		texstart = 0;
+		texend = mask + 1;
+	}
+
 	/* set the NCC lookup appropriately */
 	texel[1] = texel[9] = ncc[TEXMODE_NCC_TABLE_SELECT(reg[textureMode].u)].texel;
 
@@ -1416,6 +1434,10 @@ inline int32_t voodoo_device::tmu_state::prepare()
 	if (regdirty)
 		recompute_texture_params();
 
+	/* the triangle about to be queued reads this texture until the next wait */
+	pending_start = std::min(pending_start, texstart);
+	pending_end = std::max(pending_end, texend);
+
 	/* compute (ds^2 + dt^2) in both X and Y as 28.36 numbers */
 	texdx = int64_t(dsdx >> 14) * int64_t(dsdx >> 14) + int64_t(dtdx >> 14) * int64_t(dtdx >> 14);
 	texdy = int64_t(dsdy >> 14) * int64_t(dsdy >> 14) + int64_t(dtdy >> 14) * int64_t(dtdy >> 14);
@@ -3434,12 +3456,12 @@ int32_t voodoo_device::texture_w(voodoo_device *vd, offs_t offset, uint32_t data
 	if (TEXLOD_TDIRECT_WRITE(t->reg[tLOD].u))
 		fatalerror("Texture direct write!\n");
 
-	/* wait for any outstanding work to finish */
-	poly_wait(vd->poly, "Texture write");
-
-	/* update texture info if dirty */
+	/* update texture info if dirty; in-flight triangles read it live */
 	if (t->regdirty)
+	{
+		texture_wait(vd);
 		t->recompute_texture_params();
+	}
 
 	/* swizzle the data */
 	if (TEXLOD_TDATA_SWIZZLE(t->reg[tLOD].u))
@@ -3484,9 +3506,13 @@ int32_t voodoo_device::texture_w(voodoo_device *vd, offs_t offset, uint32_t data
 			if (LOG_TEXTURE_RAM) vd->logerror("Texture 8-bit w: offset=%X data=%08X\n", offset*4, data);
 		}
 
+		/* only wait for outstanding work if it may read what we overwrite */
+		tbaseaddr &= t->mask;
+		if (t->is_pending(tbaseaddr))
+			texture_wait(vd);
+
 		/* write the four bytes in little-endian order */
 		dest = t->ram;
-		tbaseaddr &= t->mask;
 		dest[BYTE4_XOR_LE(tbaseaddr + 0)] = (data >> 0) & 0xff;
 		dest[BYTE4_XOR_LE(tbaseaddr + 1)] = (data >> 8) & 0xff;
 		dest[BYTE4_XOR_LE(tbaseaddr + 2)] = (data >> 16) & 0xff;
@@ -3524,9 +3550,13 @@ int32_t voodoo_device::texture_w(voodoo_device *vd, offs_t offset, uint32_t data
 			if (LOG_TEXTURE_RAM) vd->logerror("Texture 16-bit w: offset=%X data=%08X\n", offset*4, data);
 		}
 
+		/* only wait for outstanding work if it may read what we overwrite */
+		tbaseaddr &= t->mask;
+		if (t->is_pending(tbaseaddr))
+			texture_wait(vd);
+
 		/* write the two words in little-endian order */
 		dest = (uint16_t *)t->ram;
-		tbaseaddr &= t->mask;
 		tbaseaddr >>= 1;
 		dest[BYTE_XOR_LE(tbaseaddr + 0)] = (data >> 0) & 0xffff;
 		dest[BYTE_XOR_LE(tbaseaddr + 1)] = (data >> 16) & 0xffff;
@@ -3536,6 +3566,19 @@ int32_t voodoo_device::texture_w(voodoo_device *vd, offs_t offset, uint32_t data
 }
 
 
+/*-------------------------------------------------
+    texture_wait - drain queued triangles before
+    texture RAM they may read is overwritten
+-------------------------------------------------*/
+
+void voodoo_device::texture_wait(voodoo_device *vd)
+{
+	poly_wait(vd->poly, "Texture write");
+	for (tmu_state &t : vd->tmu)
+		t.clear_pending();
+}
+
+
 
 /*************************************
  *
@@ -5169,6 +5212,10 @@ void voodoo_device::device_start()
 	for (info = predef_raster_table; info->callback; info++)
 		add_rasterizer(this, info);
 
+	/* optionally report the modes that miss it when we exit */
+	if (machine().options().profile_rasterizers()[0] != 0)
+		machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&voodoo_device::write_rasterizer_profile, this));
+
 	/* set up the PCI FIFO */
 	pci.fifo.base = pci.fifo_mem;
 	pci.fifo.size = 64*2;
@@ -5879,6 +5926,61 @@ void voodoo_device::dump_rasterizer_stats(voodoo_device *vd)
 	}
 }
 
+/*-------------------------------------------------
+    write_rasterizer_profile - write every mode
+    that fell back to a generic rasterizer, busiest
+    first, as entries ready to paste into
+    voodoo_rast.hxx
+-------------------------------------------------*/
+
+void voodoo_device::write_rasterizer_profile()
+{
+	/* all Voodoos go into one file, so only the first one writes it */
+	std::vector<voodoo_device *> voodoos;
+	for (device_t &scan : device_iterator(machine().root_device()))
+	{
+		voodoo_device *const voodoo = dynamic_cast<voodoo_device *>(&scan);
+		if (voodoo != nullptr)
+			voodoos.push_back(voodoo);
+	}
+	if (voodoos.empty() || voodoos.front() != this)
+		return;
+
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	osd_file::error const filerr = file.open(machine().options().profile_rasterizers());
+	if (filerr != osd_file::error::NONE)
+	{
+		osd_printf_error("Unable to open rasterizer profile file %s\n", machine().options().profile_rasterizers());
+		return;
+	}
+
+	for (voodoo_device *voodoo : voodoos)
+	{
+		/* collect the generic entries that actually drew something */
+		std::vector<const raster_info *> misses;
+		for (int hash = 0; hash < RASTER_HASH_SIZE; hash++)
+			for (const raster_info *cur = voodoo->raster_hash[hash]; cur; cur = cur->next)
+				if (cur->is_generic && cur->hits != 0)
+					misses.push_back(cur);
+		std::sort(misses.begin(), misses.end(), [] (const raster_info *a, const raster_info *b) { return a->hits > b->hits; });
+
+		file.printf("/* %s ----> fbzColorPath alphaMode   fogMode,    fbzMode,    texMode0,   texMode1  */\n", machine().system().name);
+		file.printf("/* '%s': %d modes missed the precompiled table */\n", voodoo->tag(), int(misses.size()));
+		for (const raster_info *cur : misses)
+			file.printf("RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) /* %10d %10d */\n",
+				cur->eff_color_path,
+				cur->eff_alpha_mode,
+				cur->eff_fog_mode,
+				cur->eff_fbz_mode,
+				cur->eff_tex_mode_0,
+				cur->eff_tex_mode_1,
+				cur->polys,
+				cur->hits);
+		file.printf("\n");
+	}
+}
+
+
 voodoo_device::voodoo_device(const machine_config &mconfig, device_type type, const char *tag, device_t *owner, uint32_t clock, uint8_t vdt)
 	: device_t(mconfig, type, tag, owner, clock)
 	, m_fbmem(0)
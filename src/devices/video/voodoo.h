@@ -1600,6 +1600,8 @@ protected:
 	{
 		class stw_t;
 		void recompute_texture_params();
+		void clear_pending() { pending_start = ~0; pending_end = 0; }
+		bool is_pending(uint32_t addr) const { return addr < pending_end && addr + 4 > pending_start; }
 		void init(uint8_t vdt, tmu_shared_state &share, voodoo_reg *r, void *memory, int tmem);
 		int32_t prepare();
 		static int32_t new_log2(double &value, const int &offset);
@@ -1625,6 +1627,8 @@ protected:
 		uint32_t            mask;                   // mask to apply to pointers
 		voodoo_reg *        reg;                    // pointer to our register base
 		uint32_t            regdirty;               // true if the LOD/mode/base registers have changed
+		uint32_t            texstart, texend;       // range of RAM the current texture can read
+		uint32_t            pending_start, pending_end; // range of RAM read by queued triangles
 
 		uint32_t            texaddr_mask;           // mask for texture address
 		uint8_t             texaddr_shift;          // shift for texture address
@@ -1827,6 +1831,7 @@ protected:
 	static int32_t swapbuffer(voodoo_device *vd, uint32_t data);
 	static int32_t lfb_w(voodoo_device *vd, offs_t offset, uint32_t data, uint32_t mem_mask);
 	static int32_t texture_w(voodoo_device *vd, offs_t offset, uint32_t data);
+	static void texture_wait(voodoo_device *vd);
 	int32_t lfb_direct_w(offs_t offset, uint32_t data, uint32_t mem_mask);
 	static int32_t banshee_2d_w(voodoo_device *vd, offs_t offset, uint32_t data);
 	void stall_cpu(int state, attotime current_time);
@@ -1842,6 +1847,7 @@ protected:
 	static raster_info *add_rasterizer(voodoo_device *vd, const raster_info *cinfo);
 	static raster_info *find_rasterizer(voodoo_device *vd, int texcount);
 	static void dump_rasterizer_stats(voodoo_device *vd);
+	void write_rasterizer_profile();
 
 	void accumulate_statistics(const stats_block &block);
 	void update_statistics(bool accumulate);
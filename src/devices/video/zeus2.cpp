@@ -1676,9 +1676,9 @@ void zeus2_renderer::zeus2_draw_quad(const uint32_t *databuffer, uint32_t texdat
 	int logextra = 0;
 
 	int intScale = m_state->m_zeusbase[0x66] - 0x8e;
-	float fScale = pow(2.0f, intScale);
+	float fScale = ldexp(1.0f, intScale);
 	int intUVScale = m_state->m_zeusbase[0x68] - 0x9d;
-	float uvScale = pow(2.0f, intUVScale);
+	float uvScale = ldexp(1.0f, intUVScale);
 	for (int i = 0; i < 4; i++)
 	{
 		float x = vert[i].x;
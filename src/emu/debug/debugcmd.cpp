@@ -279,6 +279,13 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 	m_console.register_command("mapi",      CMDFLAG_NONE, AS_IO, 1, 1, std::bind(&debugger_commands::execute_map, this, _1, _2));
 	m_console.register_command("mapo",      CMDFLAG_NONE, AS_OPCODES, 1, 1, std::bind(&debugger_commands::execute_map, this, _1, _2));
 	m_console.register_command("memdump",   CMDFLAG_NONE, 0, 0, 1, std::bind(&debugger_commands::execute_memdump, this, _1, _2));
+#ifdef MAME_MEMORY_HEATMAP
+	m_console.register_command("heatmap",   CMDFLAG_NONE, AS_PROGRAM, 0, 2, std::bind(&debugger_commands::execute_heatmap, this, _1, _2));
+	m_console.register_command("heatmapd",  CMDFLAG_NONE, AS_DATA, 0, 2, std::bind(&debugger_commands::execute_heatmap, this, _1, _2));
+	m_console.register_command("heatmapi",  CMDFLAG_NONE, AS_IO, 0, 2, std::bind(&debugger_commands::execute_heatmap, this, _1, _2));
+	m_console.register_command("heatmapo",  CMDFLAG_NONE, AS_OPCODES, 0, 2, std::bind(&debugger_commands::execute_heatmap, this, _1, _2));
+	m_console.register_command("heatmapclear", CMDFLAG_NONE, 0, 0, 0, std::bind(&debugger_commands::execute_heatmapclear, this, _1, _2));
+#endif
 
 	m_console.register_command("symlist",   CMDFLAG_NONE, 0, 0, 1, std::bind(&debugger_commands::execute_symlist, this, _1, _2));
 
@@ -2819,6 +2826,8 @@ void debugger_commands::execute_trace_internal(int ref, const std::vector<std::s
 	const char *action = nullptr;
 	bool detect_loops = true;
 	bool logerror = false;
+	bool binary = false;
+	bool memory = false;
 	device_t *cpu;
 	FILE *f = nullptr;
 	const char *mode;
@@ -2842,6 +2851,10 @@ void debugger_commands::execute_trace_internal(int ref, const std::vector<std::s
 				detect_loops = false;
 			else if (!core_stricmp(flag.c_str(), "logerror"))
 				logerror = true;
+			else if (!core_stricmp(flag.c_str(), "binary"))
+				binary = true;
+			else if (!core_stricmp(flag.c_str(), "mem"))
+				memory = true;
 			else
 			{
 				m_console.printf("Invalid flag '%s'\n", flag.c_str());
@@ -2849,18 +2862,23 @@ void debugger_commands::execute_trace_internal(int ref, const std::vector<std::s
 			}
 		}
 	}
+	if (memory && !binary)
+	{
+		m_console.printf("The 'mem' flag needs a binary trace\n");
+		return;
+	}
 	if (!debug_command_parameter_command(action = (params.size() > 3) ? params[3].c_str() : nullptr))
 		return;
 
 	/* open the file */
 	if (core_stricmp(filename.c_str(), "off") != 0)
 	{
-		mode = "w";
+		mode = binary ? "wb" : "w";
 
 		/* opening for append? */
 		if ((filename[0] == '>') && (filename[1] == '>'))
 		{
-			mode = "a";
+			mode = binary ? "ab" : "a";
 			filename = filename.substr(2);
 		}
 
@@ -2873,7 +2891,7 @@ void debugger_commands::execute_trace_internal(int ref, const std::vector<std::s
 	}
 
 	/* do it */
-	cpu->debug()->trace(f, trace_over, detect_loops, logerror, action);
+	cpu->debug()->trace(f, trace_over, detect_loops, logerror, action, binary, memory);
 	if (f)
 		m_console.printf("Tracing CPU '%s' to file %s\n", cpu->tag(), filename.c_str());
 	else
@@ -3189,6 +3207,11 @@ void debugger_commands::execute_memdump(int ref, const std::vector<std::string>
 					bool octal = sp.is_octal();
 					int nc = octal ? (sp.addr_width() + 2) / 3 : (sp.addr_width() + 3) / 4;
 
+					u32 tables = 0;
+					size_t bytes = 0;
+					sp.dispatch_footprint(tables, bytes);
+					fprintf(file, "  device %s space %s: %u dispatch tables, %u bytes\n\n", memory.device().tag(), sp.name(), tables, unsigned(bytes));
+
 					std::vector<memory_entry> entries[2];
 					sp.dump_maps(entries[0], entries[1]);
 					for (int mode = 0; mode < 2; mode ++)
@@ -3211,6 +3234,64 @@ void debugger_commands::execute_memdump(int ref, const std::vector<std::string>
 }
 
 
+#ifdef MAME_MEMORY_HEATMAP
+
+/*-------------------------------------------------
+    execute_heatmap - execute the heatmap command
+-------------------------------------------------*/
+
+void debugger_commands::execute_heatmap(int ref, const std::vector<std::string> &params)
+{
+	address_space *space;
+	if (!validate_cpu_space_parameter(params.empty() ? nullptr : params[0].c_str(), ref, space))
+		return;
+
+	u64 count = 20;
+	if (params.size() > 1 && !validate_number_parameter(params[1], count))
+		return;
+
+	memory_heatmap &heatmap = space->heatmap();
+	std::vector<memory_heatmap::handler_stats> const handlers = heatmap.handlers();
+	if (handlers.empty())
+	{
+		m_console.printf("No accesses counted in %s space of '%s'\n", space->name(), space->device().tag());
+		return;
+	}
+
+	m_console.printf("  #  R/W %*s-%-*s %12s %10s  Handler\n", space->addrchars(), "Start", space->addrchars(), "End", "Count", "Est ns");
+	for (size_t index = 0; (index < handlers.size()) && (index < count); index++)
+	{
+		memory_heatmap::handler_stats const &stats = handlers[index];
+		m_console.printf("%3u  %s   %0*X-%0*X %12u %10u  %s\n",
+				unsigned(index + 1), stats.write ? "W" : "R",
+				space->addrchars(), stats.start, space->addrchars(), stats.end,
+				stats.count, memory_heatmap::ticks_to_ns(stats.ticks), stats.name);
+	}
+
+	std::vector<std::pair<offs_t, u64>> const pages = heatmap.pages();
+	m_console.printf("Busiest pages:\n");
+	for (size_t index = 0; (index < pages.size()) && (index < count); index++)
+		m_console.printf("%3u  %0*X %12u\n", unsigned(index + 1), space->addrchars(), space->byte_to_address(pages[index].first), pages[index].second);
+}
+
+
+/*-------------------------------------------------
+    execute_heatmapclear - execute the heatmapclear
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_heatmapclear(int ref, const std::vector<std::string> &params)
+{
+	for (device_memory_interface &memory : memory_interface_iterator(m_machine.root_device()))
+		for (int spacenum = 0; spacenum < memory.max_space_count(); spacenum++)
+			if (memory.has_space(spacenum))
+				memory.space(spacenum).heatmap().clear();
+	m_console.printf("Cleared memory access counts\n");
+}
+
+#endif // MAME_MEMORY_HEATMAP
+
+
 /*-------------------------------------------------
     execute_symlist - execute the symlist command
 -------------------------------------------------*/
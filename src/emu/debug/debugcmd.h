@@ -156,6 +156,10 @@ private:
 	void execute_source(int ref, const std::vector<std::string> &params);
 	void execute_map(int ref, const std::vector<std::string> &params);
 	void execute_memdump(int ref, const std::vector<std::string> &params);
+#ifdef MAME_MEMORY_HEATMAP
+	void execute_heatmap(int ref, const std::vector<std::string> &params);
+	void execute_heatmapclear(int ref, const std::vector<std::string> &params);
+#endif
 	void execute_symlist(int ref, const std::vector<std::string> &params);
 	void execute_softreset(int ref, const std::vector<std::string> &params);
 	void execute_hardreset(int ref, const std::vector<std::string> &params);
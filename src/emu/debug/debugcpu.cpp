@@ -25,6 +25,13 @@
 #include "osdepend.h"
 #include "xmlfile.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <zlib.h>
+
 
 const size_t debugger_cpu::NUM_TEMP_VARIABLES = 10;
 
@@ -39,6 +46,7 @@ debugger_cpu::debugger_cpu(running_machine &machine)
 	, m_visiblecpu(nullptr)
 	, m_breakcpu(nullptr)
 	, m_symtable(nullptr)
+	, m_installing_taps(false)
 	, m_vblank_occurred(false)
 	, m_execution_state(exec_state::STOPPED)
 	, m_stop_when_not_device(nullptr)
@@ -114,7 +122,8 @@ void debugger_cpu::configure_memory(symbol_table &table)
 		&m_machine,
 		std::bind(&debugger_cpu::expression_validate, this, _1, _2, _3),
 		std::bind(&debugger_cpu::expression_read_memory, this, _1, _2, _3, _4, _5, _6),
-		std::bind(&debugger_cpu::expression_write_memory, this, _1, _2, _3, _4, _5, _6, _7));
+		std::bind(&debugger_cpu::expression_write_memory, this, _1, _2, _3, _4, _5, _6, _7),
+		std::bind(&debugger_cpu::expression_resolve, this, _1, _2, _3));
 }
 
 /*-------------------------------------------------
@@ -1034,6 +1043,72 @@ void debugger_cpu::expression_write_memory_region(const char *rgntag, offs_t add
 }
 
 
+/*-------------------------------------------------
+    expression_resolve - bind a named logical or
+    physical space once, so compiled expressions
+    don't look the device up on every access;
+    anything else, including references to the
+    visible CPU, stays on the slow path
+-------------------------------------------------*/
+
+expression_memory *debugger_cpu::expression_resolve(void *param, const char *name, expression_space spacenum)
+{
+	bool translate;
+	int spaceindex;
+	switch (spacenum)
+	{
+	case EXPSPACE_PROGRAM_LOGICAL:
+	case EXPSPACE_DATA_LOGICAL:
+	case EXPSPACE_IO_LOGICAL:
+	case EXPSPACE_SPACE3_LOGICAL:
+		translate = true;
+		spaceindex = AS_PROGRAM + (spacenum - EXPSPACE_PROGRAM_LOGICAL);
+		break;
+
+	case EXPSPACE_PROGRAM_PHYSICAL:
+	case EXPSPACE_DATA_PHYSICAL:
+	case EXPSPACE_IO_PHYSICAL:
+	case EXPSPACE_SPACE3_PHYSICAL:
+		translate = false;
+		spaceindex = AS_PROGRAM + (spacenum - EXPSPACE_PROGRAM_PHYSICAL);
+		break;
+
+	default:
+		return nullptr;
+	}
+
+	device_t *device = (name != nullptr) ? expression_get_device(name) : nullptr;
+	device_memory_interface *memory;
+	if (device == nullptr || !device->interface(memory) || !memory->has_space(spaceindex))
+		return nullptr;
+
+	// share one binding between every expression using the same space
+	address_space &space = memory->space(spaceindex);
+	std::unique_ptr<bound_space> &binding = m_bound_spaces[std::make_pair(&space, translate)];
+	if (!binding)
+		binding = std::make_unique<bound_space>(*this, space, translate);
+	return binding.get();
+}
+
+
+/*-------------------------------------------------
+    bound_space - access a resolved space with
+    the same semantics as the named path
+-------------------------------------------------*/
+
+u64 debugger_cpu::bound_space::read(u32 address, int size, bool disable_se)
+{
+	auto dis = m_cpu.m_machine.disable_side_effects(disable_se);
+	return m_cpu.read_memory(m_space, address, size, m_translate);
+}
+
+void debugger_cpu::bound_space::write(u32 address, int size, u64 value, bool disable_se)
+{
+	auto dis = m_cpu.m_machine.disable_side_effects(disable_se);
+	m_cpu.write_memory(m_space, address, value, size, m_translate);
+}
+
+
 /*-------------------------------------------------
     expression_validate - validate that the
     provided expression references an
@@ -1324,7 +1399,11 @@ device_debug::device_debug(device_t &device)
 		for (int i=0; i != count; i++)
 			if (m_memory->has_space(i)) {
 				address_space &space = m_memory->space(i);
-				m_notifiers.push_back(space.add_change_notifier([this, &space](read_or_write mode) { reinstall(space, mode); }));
+				m_notifiers.push_back(space.add_change_notifier([this, &space](read_or_write mode) {
+							// other debugger taps don't disturb ours
+							if (!m_device.machine().debugger().cpu().installing_taps())
+								reinstall(space, mode);
+						}));
 			}
 			else
 				m_notifiers.push_back(-1);
@@ -1422,33 +1501,55 @@ void device_debug::write_tracking(address_space &space, offs_t address, u64 data
 
 void device_debug::reinstall(address_space &space, read_or_write mode)
 {
+	debugger_cpu &debugcpu = m_device.machine().debugger().cpu();
+	bool const was_installing = debugcpu.installing_taps();
+	debugcpu.set_installing_taps(true);
+
 	int id = space.spacenum();
 	if (u32(mode) & u32(read_or_write::READ))
 	{
 		if (m_phr[id])
 			m_phr[id]->remove();
-		if (!m_hotspots.empty())
+		if (!m_hotspots.empty() || trace_memory())
 			switch (space.data_width())
 			{
-			case  8: m_phr[id] = space.install_read_tap(0, space.addrmask(), "hotspot", [this, &space](offs_t address, u8  &, u8 ) { hotspot_check(space, address); }, m_phr[id]); break;
-			case 16: m_phr[id] = space.install_read_tap(0, space.addrmask(), "hotspot", [this, &space](offs_t address, u16 &, u16) { hotspot_check(space, address); }, m_phr[id]); break;
-			case 32: m_phr[id] = space.install_read_tap(0, space.addrmask(), "hotspot", [this, &space](offs_t address, u32 &, u32) { hotspot_check(space, address); }, m_phr[id]); break;
-			case 64: m_phr[id] = space.install_read_tap(0, space.addrmask(), "hotspot", [this, &space](offs_t address, u64 &, u64) { hotspot_check(space, address); }, m_phr[id]); break;
+			case  8: m_phr[id] = space.install_read_tap(0, space.addrmask(), "debug_read", [this, &space](offs_t address, u8  &data, u8  mem_mask) { read_tap(space, address, data, mem_mask); }, m_phr[id]); break;
+			case 16: m_phr[id] = space.install_read_tap(0, space.addrmask(), "debug_read", [this, &space](offs_t address, u16 &data, u16 mem_mask) { read_tap(space, address, data, mem_mask); }, m_phr[id]); break;
+			case 32: m_phr[id] = space.install_read_tap(0, space.addrmask(), "debug_read", [this, &space](offs_t address, u32 &data, u32 mem_mask) { read_tap(space, address, data, mem_mask); }, m_phr[id]); break;
+			case 64: m_phr[id] = space.install_read_tap(0, space.addrmask(), "debug_read", [this, &space](offs_t address, u64 &data, u64 mem_mask) { read_tap(space, address, data, mem_mask); }, m_phr[id]); break;
 			}
 	}
 	if (u32(mode) & u32(read_or_write::WRITE))
 	{
 		if (m_phw[id])
 			m_phw[id]->remove();
-		if (m_track_mem)
+		if (m_track_mem || trace_memory())
 			switch (space.data_width())
 			{
-			case  8: m_phw[id] = space.install_read_tap(0, space.addrmask(), "track_mem", [this, &space](offs_t address, u8  &data, u8 ) { write_tracking(space, address, data); }, m_phw[id]); break;
-			case 16: m_phw[id] = space.install_read_tap(0, space.addrmask(), "track_mem", [this, &space](offs_t address, u16 &data, u16) { write_tracking(space, address, data); }, m_phw[id]); break;
-			case 32: m_phw[id] = space.install_read_tap(0, space.addrmask(), "track_mem", [this, &space](offs_t address, u32 &data, u32) { write_tracking(space, address, data); }, m_phw[id]); break;
-			case 64: m_phw[id] = space.install_read_tap(0, space.addrmask(), "track_mem", [this, &space](offs_t address, u64 &data, u64) { write_tracking(space, address, data); }, m_phw[id]); break;
+			case  8: m_phw[id] = space.install_write_tap(0, space.addrmask(), "debug_write", [this, &space](offs_t address, u8  &data, u8  mem_mask) { write_tap(space, address, data, mem_mask); }, m_phw[id]); break;
+			case 16: m_phw[id] = space.install_write_tap(0, space.addrmask(), "debug_write", [this, &space](offs_t address, u16 &data, u16 mem_mask) { write_tap(space, address, data, mem_mask); }, m_phw[id]); break;
+			case 32: m_phw[id] = space.install_write_tap(0, space.addrmask(), "debug_write", [this, &space](offs_t address, u32 &data, u32 mem_mask) { write_tap(space, address, data, mem_mask); }, m_phw[id]); break;
+			case 64: m_phw[id] = space.install_write_tap(0, space.addrmask(), "debug_write", [this, &space](offs_t address, u64 &data, u64 mem_mask) { write_tap(space, address, data, mem_mask); }, m_phw[id]); break;
 			}
 	}
+
+	debugcpu.set_installing_taps(was_installing);
+}
+
+void device_debug::read_tap(address_space &space, offs_t address, u64 data, u64 mem_mask)
+{
+	if (!m_hotspots.empty())
+		hotspot_check(space, address);
+	if (trace_memory())
+		m_trace->access(space.spacenum(), address, data, mem_mask, false);
+}
+
+void device_debug::write_tap(address_space &space, offs_t address, u64 data, u64 mem_mask)
+{
+	if (m_track_mem)
+		write_tracking(space, address, data);
+	if (trace_memory())
+		m_trace->access(space.spacenum(), address, data, mem_mask, true);
 }
 
 void device_debug::reinstall_all(read_or_write mode)
@@ -2393,14 +2494,19 @@ u32 device_debug::compute_opcode_crc32(offs_t pc) const
 //  trace - trace execution of a given device
 //-------------------------------------------------
 
-void device_debug::trace(FILE *file, bool trace_over, bool detect_loops, bool logerror, const char *action)
+void device_debug::trace(FILE *file, bool trace_over, bool detect_loops, bool logerror, const char *action, bool binary, bool memory)
 {
 	// delete any existing tracers
+	bool const had_taps = trace_memory();
 	m_trace = nullptr;
 
 	// if we have a new file, make a new tracer
 	if (file != nullptr)
-		m_trace = std::make_unique<tracer>(*this, *file, trace_over, detect_loops, logerror, action);
+		m_trace = std::make_unique<tracer>(*this, *file, trace_over, detect_loops, logerror, action, binary, memory && (m_memory != nullptr));
+
+	// memory accesses are recorded through the same taps as hotspots and tracking
+	if (had_taps || trace_memory())
+		reinstall_all(read_or_write::READWRITE);
 }
 
 
@@ -2858,7 +2964,8 @@ device_debug::watchpoint::watchpoint(device_debug* debugInterface,
 
 	install(read_or_write::READWRITE);
 	m_notifier = m_space.add_change_notifier([this](read_or_write mode) {
-												 if (m_enabled)
+												 // taps going in or out elsewhere leave ours in place
+												 if (m_enabled && !m_debugInterface->m_device.machine().debugger().cpu().installing_taps())
 												 {
 													 install(mode);
 												 }
@@ -2867,11 +2974,15 @@ device_debug::watchpoint::watchpoint(device_debug* debugInterface,
 
 device_debug::watchpoint::~watchpoint()
 {
+	debugger_cpu &debugcpu = m_debugInterface->m_device.machine().debugger().cpu();
+	bool const was_installing = debugcpu.installing_taps();
+	debugcpu.set_installing_taps(true);
 	m_space.remove_change_notifier(m_notifier);
 	if (m_phr)
 		m_phr->remove();
 	if (m_phw)
 		m_phw->remove();
+	debugcpu.set_installing_taps(was_installing);
 }
 
 void device_debug::watchpoint::setEnabled(bool value)
@@ -2883,12 +2994,16 @@ void device_debug::watchpoint::setEnabled(bool value)
 			install(read_or_write::READWRITE);
 		else
 		{
+			debugger_cpu &debugcpu = m_debugInterface->m_device.machine().debugger().cpu();
+			bool const was_installing = debugcpu.installing_taps();
+			debugcpu.set_installing_taps(true);
 			m_installing = true;
 			if(m_phr)
 				m_phr->remove();
 			if(m_phw)
 				m_phw->remove();
 			m_installing = false;
+			debugcpu.set_installing_taps(was_installing);
 		}
 	}
 }
@@ -2897,6 +3012,9 @@ void device_debug::watchpoint::install(read_or_write mode)
 {
 	if (m_installing)
 		return;
+	debugger_cpu &debugcpu = m_debugInterface->m_device.machine().debugger().cpu();
+	bool const was_installing = debugcpu.installing_taps();
+	debugcpu.set_installing_taps(true);
 	m_installing = true;
 	if ((u32(mode) & u32(read_or_write::READ)) && m_phr)
 		m_phr->remove();
@@ -2979,6 +3097,7 @@ void device_debug::watchpoint::install(read_or_write mode)
 		break;
 	}
 	m_installing = false;
+	debugcpu.set_installing_taps(was_installing);
 }
 
 void device_debug::watchpoint::triggered(read_or_write type, offs_t address, u64 data, u64 mem_mask)
@@ -3123,13 +3242,210 @@ bool device_debug::registerpoint::hit()
 //  TRACER
 //**************************************************************************
 
+//-------------------------------------------------
+//  binary trace format
+//
+//  Binary traces are a gzip stream of records,
+//  each starting with a u8 type, with all values
+//  little-endian:
+//   HEADER       char[8] "MAMETRAC", u8 version,
+//                s8 program space address shift,
+//                u8 program space address width,
+//                string tag, string shortname,
+//                u16 count, then per register:
+//                string name, u8 hex digits
+//   INSTRUCTION  u32 pc, u8 count, opcode bytes
+//   REGISTER     u16 register, u64 new value
+//   READ/WRITE   u8 space, u32 address, u64 data,
+//                u64 mem_mask
+//   LOOPS        u32 instructions skipped
+//   TEXT         u32 length, characters
+//  Strings are a u16 length and the characters.
+//  Register records give the values on reaching
+//  the next instruction.  src/tools/unidasm turns
+//  a trace back into text with -trace.
+//-------------------------------------------------
+
+namespace {
+
+enum : u8
+{
+	TRACE_HEADER = 0,
+	TRACE_INSTRUCTION,
+	TRACE_REGISTER,
+	TRACE_READ,
+	TRACE_WRITE,
+	TRACE_LOOPS,
+	TRACE_TEXT
+};
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  compressor - collects binary trace records and
+//  compresses them to the file on a background
+//  thread
+//-------------------------------------------------
+
+class device_debug::tracer::compressor
+{
+public:
+	compressor(FILE &file);
+	~compressor();
+
+	void put(u64 value, int bytes) { while (bytes-- > 0) { m_buffer.push_back(u8(value)); value >>= 8; } }
+	void put(const void *data, size_t length) { m_buffer.insert(m_buffer.end(), reinterpret_cast<const u8 *>(data), reinterpret_cast<const u8 *>(data) + length); }
+	void put(const std::string &string) { put(string.length(), 2); put(string.c_str(), string.length()); }
+	void commit() { if (m_buffer.size() >= CHUNK_SIZE) submit(false); }
+	void submit(bool flush);
+
+private:
+	static constexpr size_t CHUNK_SIZE = 1 << 20;   // bytes collected before handing off
+	static constexpr size_t MAX_PENDING = 16;       // chunks queued before emulation waits
+
+	struct chunk
+	{
+		std::vector<u8>     data;
+		bool                flush;
+	};
+
+	void writer_thread();
+
+	FILE &                          m_file;         // file we're writing
+	std::vector<u8>                 m_buffer;       // records being collected
+	std::deque<chunk>               m_pending;      // chunks waiting to be compressed
+	std::vector<std::vector<u8> >   m_spare;        // compressed chunks, for reuse
+	std::mutex                      m_mutex;        // guards everything above but m_buffer
+	std::condition_variable         m_ready;        // chunks pending or stopping
+	std::condition_variable         m_space;        // room in the pending queue
+	bool                            m_stopping;     // no more chunks will come
+	std::thread                     m_thread;       // compression thread
+};
+
+
+device_debug::tracer::compressor::compressor(FILE &file)
+	: m_file(file)
+	, m_stopping(false)
+{
+	m_buffer.reserve(CHUNK_SIZE + 256);
+	m_thread = std::thread([this] () { writer_thread(); });
+}
+
+
+device_debug::tracer::compressor::~compressor()
+{
+	if (!m_buffer.empty())
+		submit(false);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_ready.notify_one();
+	m_thread.join();
+}
+
+
+//-------------------------------------------------
+//  submit - hand the collected records to the
+//  compression thread, waiting if it's too far
+//  behind
+//-------------------------------------------------
+
+void device_debug::tracer::compressor::submit(bool flush)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_space.wait(lock, [this] () { return m_pending.size() < MAX_PENDING; });
+		m_pending.emplace_back(chunk{ std::move(m_buffer), flush });
+		if (!m_spare.empty())
+		{
+			m_buffer = std::move(m_spare.back());
+			m_spare.pop_back();
+		}
+		else
+		{
+			m_buffer = std::vector<u8>();
+			m_buffer.reserve(CHUNK_SIZE + 256);
+		}
+	}
+	m_ready.notify_one();
+}
+
+
+//-------------------------------------------------
+//  writer_thread - compress chunks to the file
+//  until told to stop
+//-------------------------------------------------
+
+void device_debug::tracer::compressor::writer_thread()
+{
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	bool const ok = deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+
+	std::vector<u8> output(CHUNK_SIZE / 4);
+	auto const compress = [this, &stream, &output] (int mode)
+	{
+		do
+		{
+			stream.next_out = &output[0];
+			stream.avail_out = output.size();
+			deflate(&stream, mode);
+			fwrite(&output[0], 1, output.size() - stream.avail_out, &m_file);
+		}
+		while (stream.avail_out == 0);
+	};
+
+	while (true)
+	{
+		chunk current;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_ready.wait(lock, [this] () { return m_stopping || !m_pending.empty(); });
+			if (m_pending.empty())
+				break;
+			current = std::move(m_pending.front());
+			m_pending.pop_front();
+		}
+		m_space.notify_one();
+
+		if (ok)
+		{
+			stream.next_in = current.data.empty() ? nullptr : &current.data[0];
+			stream.avail_in = current.data.size();
+			compress(current.flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+			if (current.flush)
+				fflush(&m_file);
+		}
+
+		current.data.clear();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_spare.emplace_back(std::move(current.data));
+	}
+
+	if (ok)
+	{
+		stream.next_in = nullptr;
+		stream.avail_in = 0;
+		compress(Z_FINISH);
+		deflateEnd(&stream);
+	}
+	fflush(&m_file);
+}
+
+
 //-------------------------------------------------
 //  tracer - constructor
 //-------------------------------------------------
 
-device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, bool detect_loops, bool logerror, const char *action)
+device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, bool detect_loops, bool logerror, const char *action, bool binary, bool memory)
 	: m_debug(debug)
 	, m_file(file)
+	, m_memory(binary && memory)
+	, m_recording(false)
+	, m_first(true)
 	, m_action((action != nullptr) ? action : "")
 	, m_detect_loops(detect_loops)
 	, m_logerror(logerror)
@@ -3139,6 +3455,12 @@ device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, b
 	, m_trace_over_target(~0)
 {
 	memset(m_history, 0, sizeof(m_history));
+
+	if (binary)
+	{
+		m_compressor = std::make_unique<compressor>(file);
+		binary_header();
+	}
 }
 
 
@@ -3148,11 +3470,57 @@ device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, b
 
 device_debug::tracer::~tracer()
 {
-	// make sure we close the file if we can
+	// finish any compressed stream, then close the file if we can
+	m_compressor.reset();
 	fclose(&m_file);
 }
 
 
+//-------------------------------------------------
+//  binary_header - describe the device and its
+//  registers at the start of a binary trace
+//-------------------------------------------------
+
+void device_debug::tracer::binary_header()
+{
+	device_t &device = m_debug.device();
+	device_memory_interface *const memory = m_debug.m_memory;
+	address_space *const space = (memory && memory->has_space(AS_PROGRAM)) ? &memory->space(AS_PROGRAM) : nullptr;
+
+	// the PC goes in every instruction record, so only keep the real registers
+	std::vector<std::pair<std::string, u8> > names;
+	if (m_debug.m_state)
+	{
+		for (auto const &entry : m_debug.m_state->state_entries())
+		{
+			if ((entry->index() >= 0) && entry->visible() && !entry->divider())
+			{
+				int digits = 1;
+				while ((digits < 16) && (entry->datamask() >> (digits * 4)))
+					digits++;
+				m_registers.push_back(entry->index());
+				names.emplace_back(entry->symbol(), digits);
+			}
+		}
+	}
+	m_register_values.resize(m_registers.size(), 0);
+
+	m_compressor->put(TRACE_HEADER, 1);
+	m_compressor->put("MAMETRAC", 8);
+	m_compressor->put(1, 1);
+	m_compressor->put(space ? space->addr_shift() : 0, 1);
+	m_compressor->put(space ? space->logaddr_width() : 32, 1);
+	m_compressor->put(std::string(device.tag()));
+	m_compressor->put(std::string(device.shortname()));
+	m_compressor->put(names.size(), 2);
+	for (auto const &name : names)
+	{
+		m_compressor->put(name.first);
+		m_compressor->put(name.second, 1);
+	}
+}
+
+
 //-------------------------------------------------
 //  update - log to the tracefile the data for a
 //  given instruction
@@ -3160,6 +3528,9 @@ device_debug::tracer::~tracer()
 
 void device_debug::tracer::update(offs_t pc)
 {
+	// accesses only belong in the trace when their instruction is there too
+	m_recording = false;
+
 	// are we in trace over mode and in a subroutine?
 	if (m_trace_over && m_trace_over_target != ~0)
 	{
@@ -3185,7 +3556,17 @@ void device_debug::tracer::update(offs_t pc)
 
 		// if we just finished looping, indicate as much
 		if (m_loops != 0)
-			fprintf(&m_file, "\n   (loops for %d instructions)\n\n", m_loops);
+		{
+			if (m_compressor)
+			{
+				m_compressor->put(TRACE_LOOPS, 1);
+				m_compressor->put(m_loops, 4);
+			}
+			else
+			{
+				fprintf(&m_file, "\n   (loops for %d instructions)\n\n", m_loops);
+			}
+		}
 		m_loops = 0;
 	}
 
@@ -3194,13 +3575,22 @@ void device_debug::tracer::update(offs_t pc)
 		m_debug.m_device.machine().debugger().console().execute_command(m_action, false);
 
 	debug_disasm_buffer buffer(m_debug.device());
-	std::string instruction;
-	offs_t next_pc, size;
 	u32 dasmresult;
-	buffer.disassemble(pc, instruction, next_pc, size, dasmresult);
+	if (m_compressor)
+	{
+		// binary traces leave the disassembly for later
+		dasmresult = buffer.disassemble_info(pc);
+		binary_update(pc, buffer, dasmresult);
+	}
+	else
+	{
+		std::string instruction;
+		offs_t next_pc, size;
+		buffer.disassemble(pc, instruction, next_pc, size, dasmresult);
 
-	// output the result
-	fprintf(&m_file, "%s: %s\n", buffer.pc_to_string(pc).c_str(), instruction.c_str());
+		// output the result
+		fprintf(&m_file, "%s: %s\n", buffer.pc_to_string(pc).c_str(), instruction.c_str());
+	}
 
 	// do we need to step the trace over this instruction?
 	if (m_trace_over && (dasmresult & util::disasm_interface::SUPPORTED) != 0 && (dasmresult & util::disasm_interface::STEP_OVER) != 0)
@@ -3218,7 +3608,59 @@ void device_debug::tracer::update(offs_t pc)
 	// log this PC
 	m_nextdex = (m_nextdex + 1) % TRACE_LOOPS;
 	m_history[m_nextdex] = pc;
-	fflush(&m_file);
+	if (m_compressor)
+		m_recording = m_memory;
+	else
+		fflush(&m_file);
+}
+
+
+//-------------------------------------------------
+//  binary_update - record the registers that
+//  changed and the instruction about to execute
+//-------------------------------------------------
+
+void device_debug::tracer::binary_update(offs_t pc, debug_disasm_buffer &buffer, u32 dasmresult)
+{
+	for (size_t reg = 0; reg < m_registers.size(); reg++)
+	{
+		u64 const value = m_debug.m_state->state_int(m_registers[reg]);
+		if (m_first || (value != m_register_values[reg]))
+		{
+			m_register_values[reg] = value;
+			m_compressor->put(TRACE_REGISTER, 1);
+			m_compressor->put(reg, 2);
+			m_compressor->put(value, 8);
+		}
+	}
+	m_first = false;
+
+	buffer.data_get(pc, dasmresult & util::disasm_interface::LENGTHMASK, true, m_opcodes);
+	size_t const length = std::min<size_t>(m_opcodes.size(), 0xff);
+	m_compressor->put(TRACE_INSTRUCTION, 1);
+	m_compressor->put(pc, 4);
+	m_compressor->put(length, 1);
+	m_compressor->put(m_opcodes.empty() ? nullptr : &m_opcodes[0], length);
+	m_compressor->commit();
+}
+
+
+//-------------------------------------------------
+//  access - record a memory access made by the
+//  last traced instruction
+//-------------------------------------------------
+
+void device_debug::tracer::access(int spacenum, offs_t address, u64 data, u64 mem_mask, bool write)
+{
+	if (!m_recording)
+		return;
+
+	m_compressor->put(write ? TRACE_WRITE : TRACE_READ, 1);
+	m_compressor->put(spacenum, 1);
+	m_compressor->put(address, 4);
+	m_compressor->put(data, 8);
+	m_compressor->put(mem_mask, 8);
+	m_compressor->commit();
 }
 
 
@@ -3228,6 +3670,25 @@ void device_debug::tracer::update(offs_t pc)
 
 void device_debug::tracer::vprintf(const char *format, va_list va)
 {
+	if (m_compressor)
+	{
+		// binary traces carry text as a record of its own
+		va_list copy;
+		va_copy(copy, va);
+		int const length = vsnprintf(nullptr, 0, format, copy);
+		va_end(copy);
+		if (length <= 0)
+			return;
+
+		std::vector<char> text(length + 1);
+		vsnprintf(&text[0], text.size(), format, va);
+		m_compressor->put(TRACE_TEXT, 1);
+		m_compressor->put(length, 4);
+		m_compressor->put(&text[0], length);
+		m_compressor->commit();
+		return;
+	}
+
 	// pass through to the file
 	vfprintf(&m_file, format, va);
 	fflush(&m_file);
@@ -3241,7 +3702,10 @@ void device_debug::tracer::vprintf(const char *format, va_list va)
 
 void device_debug::tracer::flush()
 {
-	fflush(&m_file);
+	if (m_compressor)
+		m_compressor->submit(true);
+	else
+		fflush(&m_file);
 }
 
 
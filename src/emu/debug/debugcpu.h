@@ -15,6 +15,7 @@
 
 #include "express.h"
 
+#include <map>
 #include <set>
 
 
@@ -32,6 +33,8 @@ constexpr int COMMENT_VERSION       = 1;
 
 typedef int (*debug_instruction_hook_func)(device_t &device, offs_t curpc);
 
+class debug_disasm_buffer;
+
 
 // ======================> device_debug
 
@@ -272,7 +275,7 @@ public:
 	void track_mem_data_clear() { m_track_mem_set.clear(); }
 
 	// tracing
-	void trace(FILE *file, bool trace_over, bool detect_loops, bool logerror, const char *action);
+	void trace(FILE *file, bool trace_over, bool detect_loops, bool logerror, const char *action, bool binary = false, bool memory = false);
 	void trace_printf(const char *fmt, ...) ATTR_PRINTF(2,3);
 	void trace_flush() { if (m_trace != nullptr) m_trace->flush(); }
 
@@ -297,6 +300,9 @@ private:
 	void reinstall_all(read_or_write mode);
 	void reinstall(address_space &space, read_or_write mode);
 	void write_tracking(address_space &space, offs_t address, u64 data);
+	void read_tap(address_space &space, offs_t address, u64 data, u64 mem_mask);
+	void write_tap(address_space &space, offs_t address, u64 data, u64 mem_mask);
+	bool trace_memory() const { return m_trace && m_trace->memory(); }
 
 	// symbol get/set callbacks
 	static u64 get_current_pc(symbol_table &table);
@@ -345,19 +351,33 @@ private:
 	class tracer
 	{
 	public:
-		tracer(device_debug &debug, FILE &file, bool trace_over, bool detect_loops, bool logerror, const char *action);
+		tracer(device_debug &debug, FILE &file, bool trace_over, bool detect_loops, bool logerror, const char *action, bool binary, bool memory);
 		~tracer();
 
 		void update(offs_t pc);
+		void access(int spacenum, offs_t address, u64 data, u64 mem_mask, bool write);
 		void vprintf(const char *format, va_list va);
 		void flush();
 		bool logerror() const { return m_logerror; }
+		bool memory() const { return m_memory; }
 
 	private:
 		static const int TRACE_LOOPS = 64;
 
+		class compressor;
+
+		void binary_header();
+		void binary_update(offs_t pc, debug_disasm_buffer &buffer, u32 dasmresult);
+
 		device_debug &      m_debug;                    // reference to our owner
 		FILE &              m_file;                     // tracing file for this CPU
+		std::unique_ptr<compressor> m_compressor;       // background writer for binary traces
+		std::vector<int>    m_registers;                // state indices recorded in binary traces
+		std::vector<u64>    m_register_values;          // last recorded register values
+		std::vector<u8>     m_opcodes;                  // scratch buffer for opcode bytes
+		bool                m_memory;                   // whether or not memory accesses are recorded
+		bool                m_recording;                // last instruction was recorded, so its accesses are too
+		bool                m_first;                    // no registers recorded yet
 		std::string         m_action;                   // action to perform during a trace
 		offs_t              m_history[TRACE_LOOPS];     // history of recent PCs
 		bool                m_detect_loops;             // whether or not we should detect loops
@@ -556,6 +576,7 @@ public:
 
 	// getters
 	bool within_instruction_hook() const { return m_within_instruction_hook; }
+	bool installing_taps() const { return m_installing_taps; }
 	bool memory_modified() const { return m_memory_modified; }
 	exec_state execution_state() const { return m_execution_state; }
 	device_t *live_cpu() { return m_livecpu; }
@@ -567,6 +588,7 @@ public:
 	void set_visible_cpu(device_t * visiblecpu) { m_visiblecpu = visiblecpu; }
 	void set_break_cpu(device_t * breakcpu) { m_breakcpu = breakcpu; }
 	void set_within_instruction(bool within_instruction) { m_within_instruction_hook = within_instruction; }
+	void set_installing_taps(bool installing) { m_installing_taps = installing; }
 	void set_memory_modified(bool memory_modified) { m_memory_modified = memory_modified; }
 	void set_execution_stopped() { m_execution_state = exec_state::STOPPED; }
 	void set_execution_running() { m_execution_state = exec_state::RUNNING; }
@@ -585,6 +607,21 @@ public:
 private:
 	static const size_t NUM_TEMP_VARIABLES;
 
+	// a named address space resolved for compiled expressions
+	class bound_space : public expression_memory
+	{
+	public:
+		bound_space(debugger_cpu &cpu, address_space &space, bool translate) : m_cpu(cpu), m_space(space), m_translate(translate) { }
+
+		virtual u64 read(u32 address, int size, bool disable_se) override;
+		virtual void write(u32 address, int size, u64 value, bool disable_se) override;
+
+	private:
+		debugger_cpu &      m_cpu;
+		address_space &     m_space;
+		bool                m_translate;
+	};
+
 	/* expression handlers */
 	u64 expression_read_memory(void *param, const char *name, expression_space space, u32 address, int size, bool disable_se);
 	u64 expression_read_program_direct(address_space &space, int opcode, offs_t address, int size);
@@ -593,6 +630,7 @@ private:
 	void expression_write_program_direct(address_space &space, int opcode, offs_t address, int size, u64 data);
 	void expression_write_memory_region(const char *rgntag, offs_t address, int size, u64 data);
 	expression_error::error_code expression_validate(void *param, const char *name, expression_space space);
+	expression_memory *expression_resolve(void *param, const char *name, expression_space space);
 	device_t* expression_get_device(const char *tag);
 
 	/* variable getters/setters */
@@ -613,6 +651,7 @@ private:
 	std::unique_ptr<symbol_table> m_symtable;           // global symbol table
 
 	bool        m_within_instruction_hook;
+	bool        m_installing_taps;              // debugger taps going in or out, which leave other taps alone
 	bool        m_vblank_occurred;
 	bool        m_memory_modified;
 
@@ -630,6 +669,8 @@ private:
 	osd_ticks_t m_last_periodic_update_time;
 
 	bool        m_comments_loaded;
+
+	std::map<std::pair<address_space *, bool>, std::unique_ptr<bound_space>> m_bound_spaces;
 };
 
 #endif // MAME_EMU_DEBUG_DEBUGCPU_H
@@ -94,6 +94,7 @@ static const help_item static_help_list[] =
 		"  pcatmemd <address>[,<CPU>] -- query which PC wrote to a given data memory address for the current CPU\n"
 		"  pcatmemi <address>[,<CPU>] -- query which PC wrote to a given I/O memory address for the current CPU\n"
 		"                                (Note: you can also query this info by right clicking in a memory window\n"
+		"  drcprofile [<count>[,<CPU>]] -- list the most executed DRC blocks (requires -drc_profile)\n"
 		"  rewind[rw] -- go back in time by loading the most recent rewind state"
 		"  statesave[ss] <filename> -- save a state file for the current driver\n"
 		"  stateload[sl] <filename> -- load a state file for the current driver\n"
@@ -125,6 +126,8 @@ static const help_item static_help_list[] =
 		"  mapd <address> -- map logical data address to physical address and bank\n"
 		"  mapi <address> -- map logical I/O address to physical address and bank\n"
 		"  memdump [<filename>] -- dump the current memory map to <filename>\n"
+		"  heatmap[{d|i|o}] [<CPU>[,<count>]] -- list the most accessed handlers and pages\n"
+		"  heatmapclear -- reset memory access counts\n"
 	},
 	{
 		"execution",
@@ -428,6 +431,25 @@ static const help_item static_help_list[] =
 		"trackpc 1, 0, 1\n"
 		"  Continue tracking pc on CPU 0, but clear existing track info.\n"
 	},
+	{
+		"drcprofile",
+		"\n"
+		"  drcprofile [<count>[,<CPU>]]\n"
+		"\n"
+		"The drcprofile command lists the recompiled code entry points that have been executed most often, "
+		"along with how often each was entered and its share of all entries.  Counting only happens when "
+		"MAME is started with -drc_profile.  The optional first argument gives the number of entry points to "
+		"list, and defaults to 20.  The second argument is a CPU selector; if no CPU is specified, every CPU "
+		"with a profiled recompiler is listed.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"drcprofile\n"
+		"  List the 20 most executed entry points for each recompiling CPU.\n"
+		"\n"
+		"drcprofile 50,maincpu\n"
+		"  List the 50 most executed entry points for the CPU tagged 'maincpu'.\n"
+	},
 	{
 		"trackmem",
 		"\n"
@@ -857,7 +879,7 @@ static const help_item static_help_list[] =
 	{
 		"trace",
 		"\n"
-		"  trace {<filename>|OFF}[,<CPU>[,[noloop|logerror][,<action>]]]\n"
+		"  trace {<filename>|OFF}[,<CPU>[,[noloop|logerror|binary|mem][,<action>]]]\n"
 		"\n"
 		"Starts or stops tracing of the execution of the specified <CPU>. If <CPU> is omitted, "
 		"the currently active CPU is specified. When enabling tracing, specify the filename in the "
@@ -865,7 +887,9 @@ static const help_item static_help_list[] =
 		"<detectloops> should be either true or false. If 'noloop' is omitted, the trace "
 		"will have loops detected and condensed to a single line. If 'noloop' is specified, the trace "
 		"will contain every opcode as it is executed. If 'logerror' is specified, logerror output "
-		"will augment the trace.  If you "
+		"will augment the trace. If 'binary' is specified, the trace is written as compressed binary "
+		"records of the PC, opcode bytes and changed registers, which 'unidasm -trace' turns back into "
+		"text; adding 'mem' also records the memory accesses each traced instruction makes.  If you "
 		"wish to log additional information on each trace, you can append an <action> parameter which "
 		"is a command that is executed before each trace is logged. Generally, this is used to include "
 		"a 'tracelog' command. Note that you may need to embed the action within braces { } in order "
@@ -889,6 +913,9 @@ static const help_item static_help_list[] =
 		"trace starswep.tr,0,logerror|noloop\n"
 		"  Begin tracing the execution of CPU #0, logging output (along with logerror output) to starswep.tr, with loop detection disabled.\n"
 		"\n"
+		"trace starswep.trb,0,binary|mem\n"
+		"  Begin tracing the execution of CPU #0, logging compressed binary records with memory accesses to starswep.trb.\n"
+		"\n"
 		"trace >>pigskin.tr\n"
 		"  Begin tracing the currently active CPU, appending log output to pigskin.tr.\n"
 		"\n"
@@ -1281,6 +1308,32 @@ static const help_item static_help_list[] =
 		"memdump\n"
 		"  Dumps memory to memdump.log.\n"
 	},
+	{
+		"heatmap",
+		"\n"
+		"  heatmap[{d|i|o}] [<CPU>[,<count>]]\n"
+		"\n"
+		"Lists the handlers in an address space ranked by the number of accesses, with their address "
+		"range and an estimate of the host time spent in them, followed by the most accessed 4K pages. "
+		"'heatmap' uses program space, 'heatmapd' data space, 'heatmapi' I/O space and 'heatmapo' "
+		"opcodes space. <count> limits the number of lines and defaults to 20. Only available in builds "
+		"with MAME_MEMORY_HEATMAP defined.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"heatmap\n"
+		"  Lists the 20 busiest handlers in the current CPU's program space.\n"
+		"\n"
+		"heatmapi 1,50\n"
+		"  Lists the 50 busiest handlers in CPU #1's I/O space.\n"
+	},
+	{
+		"heatmapclear",
+		"\n"
+		"  heatmapclear\n"
+		"\n"
+		"Resets the memory access counts for every address space.\n"
+	},
 	{
 		"comlist",
 		"\n"
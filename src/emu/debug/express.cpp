@@ -101,6 +101,19 @@ enum
 	TVL_EXECUTEFUNC
 };
 
+// instruction opcodes for compiled expressions
+enum
+{
+	EXOP_PUSH,          // push a constant, or a placeholder for a symbol
+	EXOP_LOAD,          // replace a slot with the value of its symbol or memory
+	EXOP_UNARY,         // apply a unary operator to the top slot
+	EXOP_BINARY,        // combine the top two slots
+	EXOP_INCDEC,        // increment or decrement the symbol or memory on top
+	EXOP_ASSIGN,        // store the top slot, possibly combined, into the one below
+	EXOP_COMMA,         // discard the slot below the top
+	EXOP_CALL           // call the function below the parameters
+};
+
 
 
 //**************************************************************************
@@ -370,7 +383,8 @@ symbol_table::symbol_table(void *globalref, symbol_table *parent)
 		m_memory_param(nullptr),
 		m_memory_valid(nullptr),
 		m_memory_read(nullptr),
-		m_memory_write(nullptr)
+		m_memory_write(nullptr),
+		m_memory_resolve(nullptr)
 {
 }
 
@@ -379,12 +393,13 @@ symbol_table::symbol_table(void *globalref, symbol_table *parent)
 //  add - add a new u64 pointer symbol
 //-------------------------------------------------
 
-void symbol_table::configure_memory(void *param, valid_func valid, read_func read, write_func write)
+void symbol_table::configure_memory(void *param, valid_func valid, read_func read, write_func write, resolve_func resolve)
 {
 	m_memory_param = param;
 	m_memory_valid = valid;
 	m_memory_read = read;
 	m_memory_write = write;
+	m_memory_resolve = resolve;
 }
 
 
@@ -529,6 +544,28 @@ void symbol_table::set_memory_value(const char *name, expression_space space, u3
 }
 
 
+//-------------------------------------------------
+//  resolve_memory - look up a named memory
+//  reference once so that it can be accessed
+//  directly; returns nullptr if the owner can't
+//  resolve it ahead of time
+//-------------------------------------------------
+
+expression_memory *symbol_table::resolve_memory(const char *name, expression_space space)
+{
+	// walk up the table hierarchy to find the owner
+	for (symbol_table *symtable = this; symtable != nullptr; symtable = symtable->m_parent)
+		if (symtable->m_memory_valid != nullptr)
+		{
+			expression_error::error_code err = symtable->m_memory_valid(symtable->m_memory_param, name, space);
+			if (err != expression_error::NO_SUCH_MEMORY_SPACE && symtable->m_memory_resolve != nullptr)
+				return symtable->m_memory_resolve(symtable->m_memory_param, name, space);
+			return nullptr;
+		}
+	return nullptr;
+}
+
+
 
 //**************************************************************************
 //  PARSED EXPRESSION
@@ -567,6 +604,9 @@ void parsed_expression::parse(const char *expression)
 
 	// convert the infix order to postfix order
 	infix_to_postfix();
+
+	// and flatten that for execution
+	compile();
 }
 
 
@@ -578,8 +618,12 @@ void parsed_expression::copy(const parsed_expression &src)
 {
 	m_symtable = src.m_symtable;
 	m_original_string.assign(src.m_original_string);
+	m_program.clear();
 	if (!m_original_string.empty())
+	{
 		parse_string_into_tokens();
+		compile();
+	}
 }
 
 
@@ -1655,6 +1699,443 @@ u64 parsed_expression::execute_tokens()
 
 
 
+//-------------------------------------------------
+//  apply_unary/apply_binary - the arithmetic
+//  shared by compiled programs and folding
+//-------------------------------------------------
+
+static inline u64 apply_unary(u8 optype, u64 value)
+{
+	switch (optype)
+	{
+		case TVL_COMPLEMENT:        return !value;
+		case TVL_NOT:               return ~value;
+		case TVL_UMINUS:            return -value;
+		default:                    return value;
+	}
+}
+
+static inline u64 apply_binary(u8 optype, u64 a, u64 b)
+{
+	switch (optype)
+	{
+		case TVL_MULTIPLY:          return a * b;
+		case TVL_DIVIDE:            return a / b;
+		case TVL_MODULO:            return a % b;
+		case TVL_ADD:               return a + b;
+		case TVL_SUBTRACT:          return a - b;
+		case TVL_LSHIFT:            return a << b;
+		case TVL_RSHIFT:            return a >> b;
+		case TVL_LESS:              return a < b;
+		case TVL_LESSOREQUAL:       return a <= b;
+		case TVL_GREATER:           return a > b;
+		case TVL_GREATEROREQUAL:    return a >= b;
+		case TVL_EQUAL:             return a == b;
+		case TVL_NOTEQUAL:          return a != b;
+		case TVL_BAND:              return a & b;
+		case TVL_BXOR:              return a ^ b;
+		case TVL_BOR:               return a | b;
+		case TVL_LAND:              return a && b;
+		case TVL_LOR:               return a || b;
+		default:                    return b;
+	}
+}
+
+
+//-------------------------------------------------
+//  compile - flatten the postfix tokens into a
+//  program over a plain value stack, working out
+//  up front which operands get read and written;
+//  anything that would fail is left to the token
+//  executor so its errors come out as before
+//-------------------------------------------------
+
+void parsed_expression::compile()
+{
+	// what each stack slot holds at this point in the program
+	struct slot
+	{
+		enum { RVAL, SYMBOL, MEMORY }   kind;
+		symbol_entry *                  symbol;
+		const parse_token *             memory;
+		int                             offset;
+		bool                            constant;
+		u64                             value;
+	};
+
+	m_program.clear();
+	m_stack.clear();
+
+	std::vector<slot> slots;
+	size_t maxdepth = 0;
+
+	auto const emit = [this] (u8 opcode, u8 optype, int offset) -> instruction &
+	{
+		m_program.emplace_back(instruction{ opcode, optype, 0, 0, offset, 0, nullptr, nullptr, nullptr });
+		return m_program.back();
+	};
+
+	auto const push = [&slots, &maxdepth] (slot const &entry)
+	{
+		slots.push_back(entry);
+		maxdepth = std::max(maxdepth, slots.size());
+	};
+
+	auto const peek = [&slots] (unsigned depth, int offset) -> slot &
+	{
+		if (slots.size() <= depth)
+			throw expression_error(expression_error::STACK_UNDERFLOW, offset);
+		return slots[slots.size() - 1 - depth];
+	};
+
+	// named memory can usually be looked up now rather than on every access
+	auto const resolve = [this] (const parse_token *memory) -> expression_memory *
+	{
+		if ((m_symtable == nullptr) || (memory->string() == nullptr))
+			return nullptr;
+		return m_symtable->resolve_memory(memory->string(), memory->memory_space());
+	};
+
+	// read a symbol or memory slot into a plain value
+	auto const rval = [&peek, &emit, &resolve] (unsigned depth, int offset)
+	{
+		slot &entry = peek(depth, offset);
+		if (entry.kind == slot::RVAL)
+			return;
+
+		// functions used as values are a fatal error, which the tokens can report
+		if ((entry.kind == slot::SYMBOL) && entry.symbol->is_function())
+			throw expression_error(expression_error::NOT_RVAL, entry.offset);
+
+		instruction &load = emit(EXOP_LOAD, 0, entry.offset);
+		load.depth = depth;
+		load.symbol = (entry.kind == slot::SYMBOL) ? entry.symbol : nullptr;
+		load.memory = (entry.kind == slot::MEMORY) ? entry.memory : nullptr;
+		load.bound = (entry.kind == slot::MEMORY) ? resolve(entry.memory) : nullptr;
+		entry.kind = slot::RVAL;
+	};
+
+	// point an instruction at the symbol or memory it writes
+	auto const lval = [&peek, &resolve] (instruction &inst, unsigned depth, int offset)
+	{
+		slot &entry = peek(depth, offset);
+		if ((entry.kind == slot::SYMBOL) && entry.symbol->is_lval())
+			inst.symbol = entry.symbol;
+		else if (entry.kind == slot::MEMORY)
+		{
+			inst.memory = entry.memory;
+			inst.bound = resolve(entry.memory);
+		}
+		else
+			throw expression_error(expression_error::NOT_LVAL, entry.offset);
+	};
+
+	try
+	{
+		for (parse_token &token : m_tokenlist)
+		{
+			// numbers, symbols and memory references just get pushed
+			if (token.is_number())
+			{
+				emit(EXOP_PUSH, 0, token.offset()).value = token.value();
+				push(slot{ slot::RVAL, nullptr, nullptr, token.offset(), true, token.value() });
+				continue;
+			}
+			else if (token.is_symbol())
+			{
+				emit(EXOP_PUSH, 0, token.offset());
+				push(slot{ slot::SYMBOL, token.symbol(), nullptr, token.offset(), false, 0 });
+				continue;
+			}
+			else if (token.is_memory())
+			{
+				emit(EXOP_PUSH, 0, token.offset()).value = token.address();
+				push(slot{ slot::MEMORY, nullptr, &token, token.offset(), false, 0 });
+				continue;
+			}
+			else if (!token.is_operator())
+			{
+				throw expression_error(expression_error::NOT_RVAL, token.offset());
+			}
+
+			u8 const optype = token.optype();
+			switch (optype)
+			{
+				case TVL_PREINCREMENT:
+				case TVL_PREDECREMENT:
+				case TVL_POSTINCREMENT:
+				case TVL_POSTDECREMENT:
+				{
+					instruction inst{ EXOP_INCDEC, optype, 0, 0, token.offset(), 0, nullptr, nullptr, nullptr };
+					lval(inst, 0, token.offset());
+					m_program.push_back(inst);
+					slot &entry = slots.back();
+					entry.kind = slot::RVAL;
+					entry.constant = false;
+					break;
+				}
+
+				case TVL_COMPLEMENT:
+				case TVL_NOT:
+				case TVL_UPLUS:
+				case TVL_UMINUS:
+				{
+					rval(0, token.offset());
+					slot &entry = slots.back();
+					if (entry.constant)
+					{
+						// fold it into the constant's push
+						entry.value = apply_unary(optype, entry.value);
+						m_program.back().value = entry.value;
+					}
+					else if (optype != TVL_UPLUS)
+					{
+						emit(EXOP_UNARY, optype, entry.offset);
+					}
+					break;
+				}
+
+				case TVL_MULTIPLY:
+				case TVL_DIVIDE:
+				case TVL_MODULO:
+				case TVL_ADD:
+				case TVL_SUBTRACT:
+				case TVL_LSHIFT:
+				case TVL_RSHIFT:
+				case TVL_LESS:
+				case TVL_LESSOREQUAL:
+				case TVL_GREATER:
+				case TVL_GREATEROREQUAL:
+				case TVL_EQUAL:
+				case TVL_NOTEQUAL:
+				case TVL_BAND:
+				case TVL_BXOR:
+				case TVL_BOR:
+				case TVL_LAND:
+				case TVL_LOR:
+				{
+					rval(0, token.offset());
+					rval(1, token.offset());
+					slot const right = slots.back();
+					slots.pop_back();
+					slot &left = slots.back();
+					bool const divide = (optype == TVL_DIVIDE) || (optype == TVL_MODULO);
+					if (left.constant && right.constant && (!divide || (right.value != 0)))
+					{
+						// both pushes are the last two instructions, so fold them into one
+						m_program.pop_back();
+						left.value = apply_binary(optype, left.value, right.value);
+						m_program.back().value = left.value;
+					}
+					else
+					{
+						emit(EXOP_BINARY, optype, right.offset);
+						left.constant = false;
+					}
+					left.offset = std::min(left.offset, right.offset);
+					break;
+				}
+
+				case TVL_ASSIGN:
+				case TVL_ASSIGNMULTIPLY:
+				case TVL_ASSIGNDIVIDE:
+				case TVL_ASSIGNMODULO:
+				case TVL_ASSIGNADD:
+				case TVL_ASSIGNSUBTRACT:
+				case TVL_ASSIGNLSHIFT:
+				case TVL_ASSIGNRSHIFT:
+				case TVL_ASSIGNBAND:
+				case TVL_ASSIGNBXOR:
+				case TVL_ASSIGNBOR:
+				{
+					static const u8 s_operation[] = { TVL_ASSIGN, TVL_MULTIPLY, TVL_DIVIDE, TVL_MODULO, TVL_ADD, TVL_SUBTRACT, TVL_LSHIFT, TVL_RSHIFT, TVL_BAND, TVL_BXOR, TVL_BOR };
+					rval(0, token.offset());
+					instruction inst{ EXOP_ASSIGN, s_operation[optype - TVL_ASSIGN], 0, 0, slots.back().offset, 0, nullptr, nullptr, nullptr };
+					lval(inst, 1, token.offset());
+					m_program.push_back(inst);
+					slot const right = slots.back();
+					slots.pop_back();
+					slot &left = slots.back();
+					left.kind = slot::RVAL;
+					left.constant = false;
+					left.offset = (optype == TVL_ASSIGN) ? right.offset : std::min(left.offset, right.offset);
+					break;
+				}
+
+				case TVL_COMMA:
+					if (!token.is_function_separator())
+					{
+						rval(0, token.offset());
+						rval(1, token.offset());
+						emit(EXOP_COMMA, optype, token.offset());
+						slot const right = slots.back();
+						slots.pop_back();
+						slots.back() = right;
+						slots.back().constant = false;
+					}
+					break;
+
+				case TVL_MEMORYAT:
+				{
+					rval(0, token.offset());
+					slot &entry = slots.back();
+					entry.kind = slot::MEMORY;
+					entry.memory = &token;
+					entry.constant = false;
+					break;
+				}
+
+				case TVL_EXECUTEFUNC:
+				{
+					// parameters run down the stack to the function symbol
+					unsigned count = 0;
+					while (true)
+					{
+						if (count == MAX_FUNCTION_PARAMS)
+							throw expression_error(expression_error::INVALID_PARAM_COUNT, token.offset());
+						if (slots.size() <= count)
+							throw expression_error(expression_error::INVALID_PARAM_COUNT, token.offset());
+						slot &entry = peek(count, token.offset());
+						if ((entry.kind == slot::SYMBOL) && entry.symbol->is_function())
+							break;
+						rval(count++, token.offset());
+					}
+					instruction &call = emit(EXOP_CALL, optype, token.offset());
+					call.count = count;
+					call.symbol = peek(count, token.offset()).symbol;
+					slots.resize(slots.size() - count);
+					slots.back() = slot{ slot::RVAL, nullptr, nullptr, token.offset(), false, 0 };
+					break;
+				}
+
+				default:
+					throw expression_error(expression_error::SYNTAX, token.offset());
+			}
+		}
+
+		// the result must be the only thing left
+		rval(0, 0);
+		if (slots.size() != 1)
+			throw expression_error(expression_error::SYNTAX, 0);
+	}
+	catch (expression_error const &)
+	{
+		m_program.clear();
+		return;
+	}
+
+	m_stack.resize(maxdepth);
+}
+
+
+//-------------------------------------------------
+//  execute_program - run a compiled expression
+//-------------------------------------------------
+
+u64 parsed_expression::execute_program()
+{
+	u64 *const base = &m_stack[0];
+	u64 *sp = base;
+
+	for (const instruction &inst : m_program)
+	{
+		switch (inst.opcode)
+		{
+			case EXOP_PUSH:
+				*sp++ = inst.value;
+				break;
+
+			case EXOP_LOAD:
+			{
+				u64 &target = sp[-1 - inst.depth];
+				target = get_lval(inst, target);
+				break;
+			}
+
+			case EXOP_UNARY:
+				sp[-1] = apply_unary(inst.optype, sp[-1]);
+				break;
+
+			case EXOP_BINARY:
+			{
+				u64 const right = *--sp;
+				if ((right == 0) && ((inst.optype == TVL_DIVIDE) || (inst.optype == TVL_MODULO)))
+					throw expression_error(expression_error::DIVIDE_BY_ZERO, inst.offset);
+				sp[-1] = apply_binary(inst.optype, sp[-1], right);
+				break;
+			}
+
+			case EXOP_INCDEC:
+			{
+				u64 &target = sp[-1];
+				u64 const value = get_lval(inst, target);
+				bool const increment = (inst.optype == TVL_PREINCREMENT) || (inst.optype == TVL_POSTINCREMENT);
+				u64 const result = increment ? (value + 1) : (value - 1);
+				set_lval(inst, target, result);
+				target = ((inst.optype == TVL_PREINCREMENT) || (inst.optype == TVL_PREDECREMENT)) ? result : value;
+				break;
+			}
+
+			case EXOP_ASSIGN:
+			{
+				u64 const right = *--sp;
+				u64 &target = sp[-1];
+				u64 result = right;
+				if (inst.optype != TVL_ASSIGN)
+				{
+					if ((right == 0) && ((inst.optype == TVL_DIVIDE) || (inst.optype == TVL_MODULO)))
+						throw expression_error(expression_error::DIVIDE_BY_ZERO, inst.offset);
+					result = apply_binary(inst.optype, get_lval(inst, target), right);
+				}
+				set_lval(inst, target, result);
+				target = result;
+				break;
+			}
+
+			case EXOP_COMMA:
+				sp--;
+				sp[-1] = sp[0];
+				break;
+
+			case EXOP_CALL:
+				sp -= inst.count;
+				sp[-1] = downcast<function_symbol_entry *>(inst.symbol)->execute(inst.count, sp);
+				break;
+		}
+	}
+
+	return base[0];
+}
+
+
+//-------------------------------------------------
+//  get_lval/set_lval - access the symbol or
+//  memory a compiled instruction refers to
+//-------------------------------------------------
+
+u64 parsed_expression::get_lval(const instruction &inst, u64 address)
+{
+	if (inst.symbol != nullptr)
+		return inst.symbol->value();
+	else if (inst.bound != nullptr)
+		return inst.bound->read(u32(address), 1 << inst.memory->memory_size(), inst.memory->memory_side_effects());
+	else if (m_symtable != nullptr)
+		return m_symtable->memory_value(inst.memory->string(), inst.memory->memory_space(), u32(address), 1 << inst.memory->memory_size(), inst.memory->memory_side_effects());
+	return 0;
+}
+
+void parsed_expression::set_lval(const instruction &inst, u64 address, u64 value)
+{
+	if (inst.symbol != nullptr)
+		inst.symbol->set_value(value);
+	else if (inst.bound != nullptr)
+		inst.bound->write(u32(address), 1 << inst.memory->memory_size(), value, inst.memory->memory_side_effects());
+	else if (m_symtable != nullptr)
+		m_symtable->set_memory_value(inst.memory->string(), inst.memory->memory_space(), u32(address), 1 << inst.memory->memory_size(), value, inst.memory->memory_side_effects());
+}
+
+
+
 //**************************************************************************
 //  PARSE TOKEN
 //**************************************************************************
@@ -18,6 +18,7 @@
 #include <deque>
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 
 
@@ -99,6 +100,21 @@ private:
 };
 
 
+// ======================> expression_memory
+
+// an expression_memory is a named memory reference resolved ahead of time,
+// so compiled expressions can skip the name lookup on every access
+class expression_memory
+{
+public:
+	virtual ~expression_memory() { }
+
+	// memory access
+	virtual u64 read(u32 address, int size, bool disable_se) = 0;
+	virtual void write(u32 address, int size, u64 value, bool disable_se) = 0;
+};
+
+
 // ======================> symbol_entry
 
 // symbol_entry describes a symbol in a symbol table
@@ -160,6 +176,7 @@ public:
 	typedef std::function<expression_error::error_code(void *cbparam, const char *name, expression_space space)> valid_func;
 	typedef std::function<u64(void *cbparam, const char *name, expression_space space, u32 offset, int size, bool disable_se)> read_func;
 	typedef std::function<void(void *cbparam, const char *name, expression_space space, u32 offset, int size, u64 value, bool disable_se)> write_func;
+	typedef std::function<expression_memory *(void *cbparam, const char *name, expression_space space)> resolve_func;
 
 	enum read_write
 	{
@@ -176,7 +193,7 @@ public:
 	void *globalref() const { return m_globalref; }
 
 	// setters
-	void configure_memory(void *param, valid_func valid, read_func read, write_func write);
+	void configure_memory(void *param, valid_func valid, read_func read, write_func write, resolve_func resolve = nullptr);
 
 	// symbol access
 	void add(const char *name, read_write rw, u64 *ptr = nullptr);
@@ -194,6 +211,7 @@ public:
 	expression_error::error_code memory_valid(const char *name, expression_space space);
 	u64 memory_value(const char *name, expression_space space, u32 offset, int size, bool disable_se);
 	void set_memory_value(const char *name, expression_space space, u32 offset, int size, u64 value, bool disable_se);
+	expression_memory *resolve_memory(const char *name, expression_space space);
 
 private:
 	// internal state
@@ -204,6 +222,7 @@ private:
 	valid_func              m_memory_valid;     // validation callback
 	read_func               m_memory_read;      // read callback
 	write_func              m_memory_write;     // write callback
+	resolve_func            m_memory_resolve;   // resolve callback
 };
 
 
@@ -231,7 +250,7 @@ public:
 
 	// execution
 	void parse(const char *string);
-	u64 execute() { return execute_tokens(); }
+	u64 execute() { return m_program.empty() ? execute_tokens() : execute_program(); }
 
 private:
 	// a single token
@@ -287,6 +306,7 @@ private:
 		u64 value() const { assert(m_type == NUMBER); return m_value; }
 		u32 address() const { assert(m_type == MEMORY); return m_value; }
 		symbol_entry *symbol() const { assert(m_type == SYMBOL); return m_symbol; }
+		const char *string() const { return m_string; }
 
 		u8 optype() const { assert(m_type == OPERATOR); return (m_flags & TIN_OPTYPE_MASK) >> TIN_OPTYPE_SHIFT; }
 		u8 precedence() const { assert(m_type == OPERATOR); return (m_flags & TIN_PRECEDENCE_MASK) >> TIN_PRECEDENCE_SHIFT; }
@@ -350,6 +370,20 @@ private:
 		std::string         m_string;                   // copy of the string
 	};
 
+	// a single step of a compiled expression
+	struct instruction
+	{
+		u8                      opcode;             // what to do
+		u8                      optype;             // operator, for arithmetic
+		u8                      depth;              // stack slot below the top, for loads
+		u8                      count;              // number of parameters, for functions
+		int                     offset;             // offset within the string, for errors
+		u64                     value;              // constant value
+		symbol_entry *          symbol;             // symbol being read/written, or function
+		const parse_token *     memory;             // memory access details
+		expression_memory *     bound;              // memory resolved at compile time, if possible
+	};
+
 	// internal helpers
 	void copy(const parsed_expression &src);
 	void print_tokens(FILE *out);
@@ -372,6 +406,12 @@ private:
 	u64 execute_tokens();
 	void execute_function(parse_token &token);
 
+	// compilation helpers
+	void compile();
+	u64 execute_program();
+	u64 get_lval(const instruction &inst, u64 address);
+	void set_lval(const instruction &inst, u64 address, u64 value);
+
 	// constants
 	static const int MAX_FUNCTION_PARAMS = 16;
 
@@ -381,6 +421,8 @@ private:
 	simple_list<parse_token> m_tokenlist;               // token list
 	simple_list<expression_string> m_stringlist;        // string list
 	std::deque<parse_token> m_token_stack;              // token stack (used during execution)
+	std::vector<instruction> m_program;                 // compiled form, or empty to run the tokens
+	std::vector<u64>    m_stack;                        // value stack for the compiled form
 };
 
 #endif // MAME_EMU_DEBUG_EXPRESS_H
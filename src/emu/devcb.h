@@ -124,6 +124,33 @@ template <typename T>
 inline write_line_delegate make_delegate(T &&func, char const *name, char const *tag, rw_device_class_t<write_line_delegate, std::remove_reference_t<T> > *obj)
 { return write_line_delegate(func, name, tag, obj); }
 
+/// \brief Resolved callback
+///
+/// Owns a built callback chain and calls it through a plain function
+/// pointer instantiated for the chain's type, so the delegate call and
+/// any transforms are inlined into one function and a call costs a
+/// single indirect jump with no emptiness check.
+template <typename Signature> class devcb_thunk;
+template <typename Result, typename... Params>
+class devcb_thunk<Result (Params...)>
+{
+public:
+	devcb_thunk() : m_object(nullptr, nullptr), m_call(nullptr) { }
+	template <typename T, typename Enable = std::enable_if_t<!std::is_same<std::decay_t<T>, devcb_thunk>::value> >
+	devcb_thunk(T &&func)
+		: m_object(new std::remove_reference_t<T>(std::forward<T>(func)), [] (void *obj) { delete static_cast<std::remove_reference_t<T> *>(obj); })
+		, m_call([] (void *obj, Params... args) -> Result { return (*static_cast<std::remove_reference_t<T> *>(obj))(args...); })
+	{
+	}
+
+	explicit operator bool() const { return m_call != nullptr; }
+	Result operator()(Params... args) const { return m_call(m_object.get(), args...); }
+
+private:
+	std::unique_ptr<void, void (*)(void *)> m_object;
+	Result (*m_call)(void *, Params...);
+};
+
 } } // namespace emu::detail
 
 
@@ -467,7 +494,7 @@ template <typename Result, std::make_unsigned_t<Result> DefaultMask = std::make_
 class devcb_read : public devcb_read_base
 {
 private:
-	using func_t = std::function<Result (address_space &, offs_t, std::make_unsigned_t<Result>)>;
+	using func_t = emu::detail::devcb_thunk<Result (address_space &, offs_t, std::make_unsigned_t<Result>)>;
 
 	class creator
 	{
@@ -956,7 +983,8 @@ private:
 		bool m_used = false;
 	};
 
-	std::vector<func_t> m_functions;
+	func_t m_first;                         // first callback, called directly
+	std::vector<func_t> m_functions;        // any further callbacks
 	std::vector<typename creator::ptr> m_creators;
 
 public:
@@ -989,8 +1017,8 @@ public:
 	Result operator()(offs_t offset, std::make_unsigned_t<Result> mem_mask = DefaultMask);
 	Result operator()();
 
-	bool isnull() const { return m_functions.empty() && m_creators.empty(); }
-	explicit operator bool() const { return !m_functions.empty(); }
+	bool isnull() const { return !m_first && m_creators.empty(); }
+	explicit operator bool() const { return bool(m_first); }
 };
 
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
@@ -1008,14 +1036,14 @@ typename devcb_read<Result, DefaultMask>::binder devcb_read<Result, DefaultMask>
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 void devcb_read<Result, DefaultMask>::reset()
 {
-	assert(m_functions.empty());
+	assert(!m_first);
 	m_creators.clear();
 }
 
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 void devcb_read<Result, DefaultMask>::validity_check(validity_checker &valid) const
 {
-	assert(m_functions.empty());
+	assert(!m_first);
 	devcb_read_base::validity_check(valid);
 	for (typename std::vector<typename creator::ptr>::const_iterator i = m_creators.begin(); m_creators.end() != i; ++i)
 	{
@@ -1033,11 +1061,15 @@ void devcb_read<Result, DefaultMask>::validity_check(validity_checker &valid) co
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 void devcb_read<Result, DefaultMask>::resolve()
 {
-	assert(m_functions.empty());
+	assert(!m_first);
 	devcb_read_base::resolve();
-	m_functions.reserve(m_creators.size());
-	for (typename creator::ptr const &c : m_creators)
-		m_functions.emplace_back(c->create());
+	if (!m_creators.empty())
+	{
+		m_first = m_creators.front()->create();
+		m_functions.reserve(m_creators.size() - 1);
+		for (auto it = std::next(m_creators.begin()); m_creators.end() != it; ++it)
+			m_functions.emplace_back((*it)->create());
+	}
 	m_creators.clear();
 }
 
@@ -1045,18 +1077,17 @@ template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 void devcb_read<Result, DefaultMask>::resolve_safe(Result dflt)
 {
 	resolve();
-	if (m_functions.empty())
-		m_functions.emplace_back([dflt] (address_space &space, offs_t offset, std::make_unsigned_t<Result> mem_mask) { return dflt; });
+	if (!m_first)
+		m_first = [dflt] (address_space &space, offs_t offset, std::make_unsigned_t<Result> mem_mask) { return dflt; };
 }
 
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 Result devcb_read<Result, DefaultMask>::operator()(address_space &space, offs_t offset, std::make_unsigned_t<Result> mem_mask)
 {
-	assert(m_creators.empty() && !m_functions.empty());
-	typename std::vector<func_t>::const_iterator it(m_functions.begin());
-	std::make_unsigned_t<Result> result((*it)(space, offset, mem_mask));
-	while (m_functions.end() != ++it)
-		result |= (*it)(space, offset, mem_mask);
+	assert(m_creators.empty() && m_first);
+	std::make_unsigned_t<Result> result(m_first(space, offset, mem_mask));
+	for (func_t const &f : m_functions)
+		result |= f(space, offset, mem_mask);
 	return result;
 }
 
@@ -1082,7 +1113,7 @@ template <typename Input, std::make_unsigned_t<Input> DefaultMask = std::make_un
 class devcb_write : public devcb_write_base
 {
 private:
-	using func_t = std::function<void (address_space &, offs_t, Input, std::make_unsigned_t<Input>)>;
+	using func_t = emu::detail::devcb_thunk<void (address_space &, offs_t, Input, std::make_unsigned_t<Input>)>;
 
 	class creator
 	{
@@ -2441,7 +2472,8 @@ private:
 		bool m_used = false;
 	};
 
-	std::vector<func_t> m_functions;
+	func_t m_first;                         // first callback, called directly
+	std::vector<func_t> m_functions;        // any further callbacks
 	std::vector<typename creator::ptr> m_creators;
 
 public:
@@ -2475,8 +2507,8 @@ public:
 	void operator()(offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask = DefaultMask);
 	void operator()(Input data);
 
-	bool isnull() const { return m_functions.empty() && m_creators.empty(); }
-	explicit operator bool() const { return !m_functions.empty(); }
+	bool isnull() const { return !m_first && m_creators.empty(); }
+	explicit operator bool() const { return bool(m_first); }
 };
 
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
@@ -2494,14 +2526,14 @@ typename devcb_write<Input, DefaultMask>::binder devcb_write<Input, DefaultMask>
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::reset()
 {
-	assert(m_functions.empty());
+	assert(!m_first);
 	m_creators.clear();
 }
 
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::validity_check(validity_checker &valid) const
 {
-	assert(m_functions.empty());
+	assert(!m_first);
 	devcb_write_base::validity_check(valid);
 	for (typename creator::ptr const &c : m_creators)
 		c->validity_check(valid);
@@ -2510,11 +2542,15 @@ void devcb_write<Input, DefaultMask>::validity_check(validity_checker &valid) co
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::resolve()
 {
-	assert(m_functions.empty());
+	assert(!m_first);
 	devcb_write_base::resolve();
-	m_functions.reserve(m_creators.size());
-	for (typename creator::ptr const &c : m_creators)
-		m_functions.emplace_back(c->create());
+	if (!m_creators.empty())
+	{
+		m_first = m_creators.front()->create();
+		m_functions.reserve(m_creators.size() - 1);
+		for (auto it = std::next(m_creators.begin()); m_creators.end() != it; ++it)
+			m_functions.emplace_back((*it)->create());
+	}
 	m_creators.clear();
 }
 
@@ -2522,18 +2558,17 @@ template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::resolve_safe()
 {
 	resolve();
-	if (m_functions.empty())
-		m_functions.emplace_back([] (address_space &space, offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask) { });
+	if (!m_first)
+		m_first = [] (address_space &space, offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask) { };
 }
 
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::operator()(address_space &space, offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask)
 {
-	assert(m_creators.empty() && !m_functions.empty());
-	typename std::vector<func_t>::const_iterator it(m_functions.begin());
-	(*it)(space, offset, data, mem_mask);
-	while (m_functions.end() != ++it)
-		(*it)(space, offset, data, mem_mask);
+	assert(m_creators.empty() && m_first);
+	m_first(space, offset, data, mem_mask);
+	for (func_t const &f : m_functions)
+		f(space, offset, data, mem_mask);
 }
 
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
@@ -47,5 +47,11 @@ cpu_device::~cpu_device()
 
 bool cpu_device::allow_drc() const
 {
+	// without a native back-end the recompiler runs on the C back-end, which
+	// is slower than the interpreters, so only use it when explicitly asked to
+#ifndef NATIVE_DRC
+	if (!mconfig().options().drc_use_c())
+		return false;
+#endif
 	return mconfig().options().drc() && !m_force_no_drc;
 }
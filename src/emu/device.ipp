@@ -80,7 +80,7 @@ inline void device_t::logerror(Format &&fmt, Params &&... args) const
 		// dump to the buffer
 		m_string_buffer.clear();
 		m_string_buffer.seekp(0);
-		util::stream_format(m_string_buffer, "[%s] ", tag());
+		m_string_buffer << '[' << tag() << "] ";
 		util::stream_format(m_string_buffer, std::forward<Format>(fmt), std::forward<Params>(args)...);
 		m_string_buffer.put('\0');
 
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "debugger.h"
 #include "screen.h"
 
@@ -32,6 +33,10 @@
 const int TRIGGER_INT           = -2000;
 const int TRIGGER_SUSPENDTIME   = -4000;
 
+// how many identical iterations make an idle loop, and how long one may be
+const u32 IDLE_LOOP_ITERATIONS  = 8;
+const u64 IDLE_LOOP_MAX_CYCLES  = 128;
+
 
 
 //**************************************************************************
@@ -46,6 +51,7 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 	: device_interface(device, "execute")
 	, m_scheduler(nullptr)
 	, m_disabled(false)
+	, m_parallel_group(0)
 	, m_vblank_interrupt_screen(nullptr)
 	, m_timed_interrupt_period(attotime::zero)
 	, m_nextexec(nullptr)
@@ -54,6 +60,15 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 	, m_icountptr(nullptr)
 	, m_cycles_running(0)
 	, m_cycles_stolen(0)
+	, m_insn_counts(nullptr)
+	, m_idle_allowed(true)
+	, m_idle_enabled(false)
+	, m_idle_dirty(false)
+	, m_idle_target(~offs_t(0))
+	, m_idle_signature(0)
+	, m_idle_last(0)
+	, m_idle_period(0)
+	, m_idle_count(0)
 	, m_suspend(0)
 	, m_nextsuspend(0)
 	, m_eatcycles(0)
@@ -65,6 +80,11 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 	, m_divshift(0)
 	, m_cycles_per_second(0)
 	, m_attoseconds_per_cycle(0)
+	, m_stats_timeslices(0)
+	, m_stats_cycles(0)
+	, m_stats_aborts(0)
+	, m_stats_idle_skips(0)
+	, m_stats_idle_cycles(0)
 {
 	memset(&m_localtime, 0, sizeof(m_localtime));
 
@@ -99,6 +119,8 @@ void device_execute_interface::abort_timeslice()
 	if (m_icountptr != nullptr)
 	{
 		int delta = *m_icountptr;
+		if (delta > 0)
+			m_stats_aborts++;
 		m_cycles_stolen += delta;
 		m_cycles_running -= delta;
 		*m_icountptr -= delta;
@@ -106,6 +128,47 @@ void device_execute_interface::abort_timeslice()
 }
 
 
+//-------------------------------------------------
+//  idle_loop_check - watch for a short loop that
+//  keeps going round in the same state without
+//  storing anything or reading anything but
+//  memory, and skip to the end of the timeslice
+//  once it's found
+//-------------------------------------------------
+
+void device_execute_interface::idle_loop_check(offs_t target, u64 signature)
+{
+	u64 const now = total_cycles();
+	u64 const period = now - m_idle_last;
+	m_idle_last = now;
+
+	if ((target == m_idle_target) && (signature == m_idle_signature) && (period == m_idle_period) && !m_idle_dirty && (period <= IDLE_LOOP_MAX_CYCLES))
+	{
+		// nothing the loop reads can change until other devices get to run,
+		// so skip whole iterations to keep it in step for the next timeslice
+		if ((++m_idle_count >= IDLE_LOOP_ITERATIONS) && (*m_icountptr > 0))
+		{
+			u64 const skipped = (u64(*m_icountptr) / period) * period;
+			if (skipped != 0)
+			{
+				eat_cycles(int(skipped));
+				m_idle_last += skipped;
+				m_stats_idle_skips++;
+				m_stats_idle_cycles += skipped;
+			}
+		}
+	}
+	else
+	{
+		m_idle_target = target;
+		m_idle_signature = signature;
+		m_idle_period = period;
+		m_idle_count = 0;
+	}
+	m_idle_dirty = false;
+}
+
+
 //-------------------------------------------------
 //  suspend_resume_changed
 //-------------------------------------------------
@@ -358,6 +421,9 @@ void device_execute_interface::interface_validity_check(validity_checker &valid)
 		osd_printf_error("Timed interrupt handler specified with 0 period\n");
 	else if (m_timed_interrupt.isnull() && m_timed_interrupt_period != attotime::zero)
 		osd_printf_error("No timer interrupt handler specified, but has a non-0 period given\n");
+
+	if (m_parallel_group < 0)
+		osd_printf_error("Parallel execution group %d is invalid; must be 0 (serial) or positive\n", m_parallel_group);
 }
 
 
@@ -380,6 +446,7 @@ void device_execute_interface::interface_pre_start()
 	m_suspend = SUSPEND_REASON_RESET;
 	m_profiler = profile_type(index + PROFILER_DEVICE_FIRST);
 	m_inttrigger = index + TRIGGER_INT;
+	m_idle_enabled = m_idle_allowed && device().machine().options().idle_detect();
 
 	// allocate timers if we need them
 	if (m_timed_interrupt_period != attotime::zero)
@@ -442,6 +509,10 @@ void device_execute_interface::interface_post_reset()
 	for (auto & elem : m_input)
 		elem.reset();
 
+	// forget any loop we were watching
+	m_idle_target = ~offs_t(0);
+	m_idle_count = 0;
+
 	// reconfingure VBLANK interrupts
 	if (m_vblank_interrupt_screen != nullptr)
 	{
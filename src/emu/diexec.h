@@ -81,6 +81,8 @@ enum
 
 #define MCFG_DEVICE_DISABLE() \
 	dynamic_cast<device_execute_interface &>(*device).set_disable();
+#define MCFG_DEVICE_PARALLEL_GROUP(_group) \
+	dynamic_cast<device_execute_interface &>(*device).set_parallel_group(_group);
 #define MCFG_DEVICE_VBLANK_INT_DRIVER(_tag, _class, _func) \
 	dynamic_cast<device_execute_interface &>(*device).set_vblank_int(device_interrupt_delegate(&_class::_func, #_class "::" #_func, DEVICE_SELF, (_class *)nullptr), _tag);
 #define MCFG_DEVICE_VBLANK_INT_DEVICE(_tag, _devtag, _class, _func) \
@@ -119,6 +121,7 @@ typedef device_delegate<int (device_t &, int)> device_irq_acknowledge_delegate;
 class device_execute_interface : public device_interface
 {
 	friend class device_scheduler;
+	friend class instruction_profiler;
 	friend class testcpu_state;
 
 public:
@@ -128,6 +131,7 @@ public:
 
 	// configuration access
 	bool disabled() const { return m_disabled; }
+	int parallel_group() const { return m_parallel_group; }
 	u64 clocks_to_cycles(u64 clocks) const { return execute_clocks_to_cycles(clocks); }
 	u64 cycles_to_clocks(u64 cycles) const { return execute_cycles_to_clocks(cycles); }
 	u32 min_cycles() const { return execute_min_cycles(); }
@@ -140,6 +144,8 @@ public:
 
 	// inline configuration helpers
 	void set_disable() { m_disabled = true; }
+	void set_parallel_group(int group) { m_parallel_group = group; }
+	void set_no_idle_detect() { m_idle_allowed = false; }
 	template <typename Object> void set_vblank_int(Object &&cb, const char *tag)
 	{
 		m_vblank_interrupt = std::forward<Object>(cb);
@@ -259,6 +265,13 @@ protected:
 	// for use by devcpu for now...
 	int current_input_state(unsigned i) const { return m_input[i].m_curstate; }
 	void set_icountptr(int &icount) { assert(!m_icountptr); m_icountptr = &icount; }
+
+	// idle loop detection: cores report taken backward branches with a
+	// signature of their register state, and flag any stores, I/O, or
+	// reads that don't come straight from RAM or ROM
+	bool idle_loop_enabled() const { return m_idle_enabled; }
+	void idle_loop_branch(offs_t target, u64 signature) { if (m_idle_enabled) idle_loop_check(target, signature); }
+	void idle_loop_dirty() { m_idle_dirty = true; }
 	IRQ_CALLBACK_MEMBER(standard_irq_callback_member);
 	int standard_irq_callback(int irqline);
 
@@ -266,8 +279,14 @@ protected:
 	bool debugger_enabled() const { return bool(device().machine().debug_flags & DEBUG_FLAG_ENABLED); }
 	void debugger_instruction_hook(offs_t curpc)
 	{
-		if (device().machine().debug_flags & DEBUG_FLAG_CALL_HOOK)
-			device().debug()->instruction_hook(curpc);
+		int const flags = device().machine().debug_flags;
+		if (flags & (DEBUG_FLAG_CALL_HOOK | DEBUG_FLAG_PROFILE))
+		{
+			if (m_insn_counts)
+				(*m_insn_counts)[curpc]++;
+			if (flags & DEBUG_FLAG_CALL_HOOK)
+				device().debug()->instruction_hook(curpc);
+		}
 	}
 	void debugger_exception_hook(int exception)
 	{
@@ -327,6 +346,7 @@ private:
 
 	// configuration
 	bool                    m_disabled;                 // disabled from executing?
+	int                     m_parallel_group;           // parallel execution group (0 = always serial)
 	device_interrupt_delegate m_vblank_interrupt;       // for interrupts tied to VBLANK
 	const char *            m_vblank_interrupt_screen;  // the screen that causes the VBLANK interrupt
 	device_interrupt_delegate m_timed_interrupt;        // for interrupts not tied to VBLANK
@@ -345,6 +365,17 @@ private:
 	int *                   m_icountptr;                // pointer to the icount
 	int                     m_cycles_running;           // number of cycles we are executing
 	int                     m_cycles_stolen;            // number of cycles we artificially stole
+	std::unordered_map<offs_t, u64> *m_insn_counts;     // executed instruction counts, when profiling
+
+	// idle loop detection
+	bool                    m_idle_allowed;             // not excluded by the driver
+	bool                    m_idle_enabled;             // detection turned on for this device
+	bool                    m_idle_dirty;               // a store, I/O or handler read since the last branch
+	offs_t                  m_idle_target;              // target of the loop being watched
+	u64                     m_idle_signature;           // register state at its last branch
+	u64                     m_idle_last;                // total cycles at its last branch
+	u64                     m_idle_period;              // cycles per iteration
+	u32                     m_idle_count;               // identical iterations seen so far
 
 	// suspend states
 	u32                     m_suspend;                  // suspend reason mask (0 = not suspended)
@@ -364,6 +395,13 @@ private:
 	u32                     m_cycles_per_second;        // cycles per second, adjusted for multipliers
 	attoseconds_t           m_attoseconds_per_cycle;    // attoseconds per adjusted clock cycle
 
+	// scheduler statistics
+	u64                     m_stats_timeslices;         // timeslices executed
+	u64                     m_stats_cycles;             // cycles executed
+	u64                     m_stats_aborts;             // timeslices aborted early
+	u64                     m_stats_idle_skips;         // idle loops fast-forwarded
+	u64                     m_stats_idle_cycles;        // cycles skipped in idle loops
+
 	// callbacks
 	TIMER_CALLBACK_MEMBER(timed_trigger_callback) { trigger(param); }
 
@@ -372,6 +410,7 @@ private:
 	TIMER_CALLBACK_MEMBER(trigger_periodic_interrupt);
 	TIMER_CALLBACK_MEMBER(irq_pulse_clear) { set_input_line(int(param), CLEAR_LINE); }
 	void suspend_resume_changed();
+	void idle_loop_check(offs_t target, u64 signature);
 
 	attoseconds_t minimum_quantum() const;
 
@@ -264,12 +264,50 @@ void device_gfx_interface::decode_gfx(const gfx_decode_entry *gfxdecodeinfo)
 
 		// allocate the graphics
 		m_gfx[curgfx] = std::make_unique<gfx_element>(m_palette, glcopy, (region_base != nullptr) ? region_base + gfx.start : nullptr, xormask, gfx.total_color_codes, gfx.color_codes_start);
+
+		// entries decoding the same ROM the same way (usually just with different colors) share one copy of the pixels
+		if (!GFXENTRY_ISRAM(gfx.flags) && (region_base != nullptr))
+		{
+			bool shared = false;
+			for (u8 othergfx = 0; othergfx < curgfx; othergfx++)
+			{
+				if (m_gfx[othergfx] && m_gfx[curgfx]->decodes_like(*m_gfx[othergfx]))
+				{
+					m_gfx[curgfx]->share_decoded_data(*m_gfx[othergfx]);
+					shared = true;
+					break;
+				}
+			}
+
+			// with -async_start, decode ROM graphics on a worker instead of a tile at a time during the first frames
+			if (!shared && device().machine().phase() == machine_phase::INIT && device().machine().options().async_start())
+				device().machine().defer_start(device(), string_format("gfx %u decode", curgfx), [this, curgfx] () { predecode_gfx(curgfx); });
+		}
 	}
 
 	m_decoded = true;
 }
 
 
+//-------------------------------------------------
+//  predecode_gfx - decode all of one element;
+//  the element may have been replaced or come to
+//  share its pixels with another since it was
+//  queued, and each copy only wants decoding once
+//-------------------------------------------------
+
+void device_gfx_interface::predecode_gfx(u8 index)
+{
+	gfx_element *const element = m_gfx[index].get();
+	if (element == nullptr)
+		return;
+	for (u8 othergfx = 0; othergfx < index; othergfx++)
+		if (m_gfx[othergfx] && element->shares_decoded_data(*m_gfx[othergfx]))
+			return;
+	element->decode_all();
+}
+
+
 //-------------------------------------------------
 //  interface_validity_check - validate graphics
 //  decoding configuration
@@ -209,6 +209,8 @@ protected:
 	virtual void interface_post_start() override;
 
 private:
+	void predecode_gfx(u8 index);
+
 	optional_device<device_palette_interface> m_palette; // configured tag for palette device
 	std::unique_ptr<gfx_element>  m_gfx[MAX_GFX_ELEMENTS];    // array of pointers to graphic sets
 
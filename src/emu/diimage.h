@@ -181,6 +181,7 @@ public:
 	char *fgets(char *buffer, u32 length) { check_for_file(); return m_file->gets(buffer, length); }
 	int image_feof() { check_for_file(); return m_file->eof(); }
 	void *ptr() {check_for_file(); return const_cast<void *>(m_file->buffer()); }
+	const void *mapped_ptr() { check_for_file(); return m_file->map(); }
 	// configuration access
 
 	const std::string &longname() const { return m_longname; }
@@ -28,6 +28,7 @@ device_palette_interface::device_palette_interface(const machine_config &mconfig
 		m_pens(nullptr),
 		m_format(BITMAP_FORMAT_RGB32),
 		m_shadow_table(nullptr),
+		m_shadow_mode(0),
 		m_shadow_group(0),
 		m_hilight_group(0),
 		m_white_pen(0),
@@ -298,6 +299,26 @@ void device_palette_interface::set_shadow_dRGB32(int mode, int dr, int dg, int d
 	stable.db = db;
 	stable.noclip = noclip;
 
+	// the table is regenerated the next time it's looked up, so presets
+	// that get reconfigured every frame but never used cost nothing
+	stable.dirty = true;
+}
+
+
+//-------------------------------------------------
+//  generate_rgb_shadows - regenerate a shadow
+//  table from its delta RGB values
+//-------------------------------------------------
+
+void device_palette_interface::generate_rgb_shadows(int mode) const
+{
+	const shadow_table_data &stable = m_shadow_tables[mode];
+	int const dr = stable.dr;
+	int const dg = stable.dg;
+	int const db = stable.db;
+	bool const noclip = stable.noclip;
+	stable.dirty = false;
+
 	if (VERBOSE)
 		device().popmessage("shadow %d recalc %d %d %d %02x", mode, dr, dg, db, noclip);
 
@@ -429,6 +450,8 @@ void device_palette_interface::allocate_color_tables()
 void device_palette_interface::allocate_shadow_tables()
 {
 	int numentries = m_palette->num_colors();
+	for (shadow_table_data &stable : m_shadow_tables)
+		stable.dirty = false;
 
 	// if we have shadows, allocate shadow tables
 	if (m_shadow_group != 0)
@@ -475,6 +498,7 @@ void device_palette_interface::allocate_shadow_tables()
 	}
 
 	// set the default table
+	m_shadow_mode = 0;
 	m_shadow_table = m_shadow_tables[0].base;
 }
 
@@ -495,6 +519,7 @@ void device_palette_interface::configure_rgb_shadows(int mode, float factor)
 	assert(stable.base != nullptr);
 
 	// regenerate the table
+	stable.dirty = false;
 	int ifactor = int(factor * 256.0f);
 	for (int rgb555 = 0; rgb555 < 32768; rgb555++)
 	{
@@ -51,7 +51,7 @@ public:
 	palette_t *palette() const { return m_palette; }
 	const pen_t &pen(int index) const { return m_pens[index]; }
 	const pen_t *pens() const { return m_pens; }
-	pen_t *shadow_table() const { return m_shadow_table; }
+	pen_t *shadow_table() const { if (m_shadow_tables[m_shadow_mode].dirty) generate_rgb_shadows(m_shadow_mode); return m_shadow_table; }
 	rgb_t pen_color(pen_t pen) const { return m_palette->entry_color(pen); }
 	double pen_contrast(pen_t pen) const { return m_palette->entry_contrast(pen); }
 	pen_t black_pen() const { return m_black_pen; }
@@ -65,8 +65,8 @@ public:
 	void set_pen_green_level(pen_t pen, u8 level) { m_palette->entry_set_green_level(pen, level); }
 	void set_pen_blue_level(pen_t pen, u8 level) { m_palette->entry_set_blue_level(pen, level); }
 	void set_pen_color(pen_t pen, u8 r, u8 g, u8 b) { m_palette->entry_set_color(pen, rgb_t(r, g, b)); }
-	void set_pen_colors(pen_t color_base, const rgb_t *colors, int color_count) { while (color_count--) set_pen_color(color_base++, *colors++); }
-	void set_pen_colors(pen_t color_base, const std::vector<rgb_t> &colors) { for (unsigned int i=0; i != colors.size(); i++) set_pen_color(color_base+i, colors[i]); }
+	void set_pen_colors(pen_t color_base, const rgb_t *colors, int color_count) { m_palette->entry_set_colors(color_base, colors, color_count); }
+	void set_pen_colors(pen_t color_base, const std::vector<rgb_t> &colors) { m_palette->entry_set_colors(color_base, &colors[0], colors.size()); }
 	void set_pen_contrast(pen_t pen, double bright) { m_palette->entry_set_contrast(pen, bright); }
 
 	// indirection (aka colortables)
@@ -79,7 +79,7 @@ public:
 	// shadow config
 	void set_shadow_factor(double factor) { assert(m_shadow_group != 0); m_palette->group_set_contrast(m_shadow_group, factor); }
 	void set_highlight_factor(double factor) { assert(m_hilight_group != 0); m_palette->group_set_contrast(m_hilight_group, factor); }
-	void set_shadow_mode(int mode) { assert(mode >= 0 && mode < MAX_SHADOW_PRESETS); m_shadow_table = m_shadow_tables[mode].base; }
+	void set_shadow_mode(int mode) { assert(mode >= 0 && mode < MAX_SHADOW_PRESETS); m_shadow_mode = mode; m_shadow_table = m_shadow_tables[mode].base; }
 
 protected:
 	// interface-level overrides
@@ -105,12 +105,14 @@ public: // needed by konamigx
 	void set_shadow_dRGB32(int mode, int dr, int dg, int db, bool noclip);
 private:
 	void configure_rgb_shadows(int mode, float factor);
+	void generate_rgb_shadows(int mode) const;
 
 	// internal state
 	palette_t *         m_palette;              // the palette itself
 	const pen_t *       m_pens;                 // remapped palette pen numbers
 	bitmap_format       m_format;               // format assumed for palette data
 	pen_t *             m_shadow_table;         // table for looking up a shadowed pen
+	int                 m_shadow_mode;          // index of the current shadow table
 	u32                 m_shadow_group;         // index of the shadow group, or 0 if none
 	u32                 m_hilight_group;        // index of the hilight group, or 0 if none
 	pen_t               m_white_pen;            // precomputed white pen value
@@ -127,6 +129,7 @@ private:
 		s16                dg;                 // delta green value
 		s16                db;                 // delta blue value
 		bool               noclip;             // clip?
+		mutable bool       dirty;              // deltas changed since the table was generated?
 	};
 	shadow_table_data   m_shadow_tables[MAX_SHADOW_PRESETS]; // array of shadow table data
 
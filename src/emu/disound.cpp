@@ -462,12 +462,13 @@ void device_mixer_interface::sound_stream_update(sound_stream &stream, stream_sa
 	for (int output = 0; output < m_outputs; output++)
 		memset(outputs[output], 0, samples * sizeof(outputs[0][0]));
 
-	// loop over samples
+	// add each input to the appropriate output; whole buffers at a time so the compiler can vectorise
 	const u8 *outmap = &m_outputmap[0];
-	for (int pos = 0; pos < samples; pos++)
+	for (int inp = 0; inp < m_auto_allocated_inputs; inp++)
 	{
-		// for each input, add it to the appropriate output
-		for (int inp = 0; inp < m_auto_allocated_inputs; inp++)
-			outputs[outmap[inp]][pos] += inputs[inp][pos];
+		stream_sample_t *const dest = outputs[outmap[inp]];
+		const stream_sample_t *const src = inputs[inp];
+		for (int pos = 0; pos < samples; pos++)
+			dest[pos] += src[pos];
 	}
 }
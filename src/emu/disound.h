@@ -126,6 +126,9 @@ public:
 	device_mixer_interface(const machine_config &mconfig, device_t &device, int outputs = 1);
 	virtual ~device_mixer_interface();
 
+	// getters
+	sound_stream *mixer_stream() const { return m_mixer_stream; }
+
 protected:
 	// optional operation overrides
 	virtual void interface_pre_start() override;
@@ -10,6 +10,7 @@
 
 #include "emu.h"
 #include "divtlb.h"
+#include "emuopts.h"
 
 
 
@@ -37,7 +38,9 @@ device_vtlb_interface::device_vtlb_interface(const machine_config &mconfig, devi
 		m_dynindex(0),
 		m_pageshift(0),
 		m_addrwidth(0),
-		m_table_base(nullptr)
+		m_table_base(nullptr),
+		m_refcnt_base(nullptr),
+		m_stats()
 {
 }
 
@@ -90,13 +93,14 @@ void device_vtlb_interface::interface_pre_start()
 	m_live.resize(m_fixed + m_dynamic);
 	memset(&m_live[0], 0, m_live.size()*sizeof(m_live[0]));
 
-	// allocate the lookup table
-	m_table.resize((size_t)1 << (m_addrwidth - m_pageshift));
-	memset(&m_table[0], 0, m_table.size() * sizeof(m_table[0]));
-	m_refcnt.resize((size_t)1 << (m_addrwidth - m_pageshift));
-	memset(&m_refcnt[0], 0, m_refcnt.size() * sizeof(m_refcnt[0]));
+	// allocate the lookup table; it can be large, so map it from the OS
+	size_t const entries = (size_t)1 << (m_addrwidth - m_pageshift);
+	bool const huge_pages = device().machine().options().huge_pages();
+	m_table.allocate(entries * sizeof(vtlb_entry), huge_pages);
+	m_refcnt.allocate(entries * sizeof(offs_t), huge_pages);
 	// pointer to first element for quick access
-	m_table_base = &m_table[0];
+	m_table_base = m_table.as<vtlb_entry>();
+	m_refcnt_base = m_refcnt.as<offs_t>();
 
 	// allocate the fixed page count array
 	if (m_fixed > 0)
@@ -115,8 +119,8 @@ void device_vtlb_interface::interface_pre_start()
 void device_vtlb_interface::interface_post_start()
 {
 	device().save_item(NAME(m_live));
-	device().save_item(NAME(m_table));
-	device().save_item(NAME(m_refcnt));
+	device().save_pointer(m_table_base, "m_table", m_table.size() / sizeof(vtlb_entry));
+	device().save_pointer(m_refcnt_base, "m_refcnt", m_refcnt.size() / sizeof(offs_t));
 	if (m_fixed > 0)
 		device().save_item(NAME(m_fixedpages));
 }
@@ -133,6 +137,21 @@ void device_vtlb_interface::interface_pre_reset()
 }
 
 
+//-------------------------------------------------
+//  interface_post_stop - report how hard the
+//  dynamic entries were worked
+//-------------------------------------------------
+
+void device_vtlb_interface::interface_post_stop()
+{
+	if (m_stats.fills != 0)
+		osd_printf_verbose("%s: VTLB %d dynamic entries, %llu fills, %llu evictions, %llu faults, %llu flushes, %llu address flushes\n",
+				device().tag(), m_dynamic,
+				(unsigned long long)m_stats.fills, (unsigned long long)m_stats.evictions, (unsigned long long)m_stats.faults,
+				(unsigned long long)m_stats.flushes, (unsigned long long)m_stats.address_flushes);
+}
+
+
 //**************************************************************************
 //  FILLING
 //**************************************************************************
@@ -145,7 +164,7 @@ void device_vtlb_interface::interface_pre_reset()
 bool device_vtlb_interface::vtlb_fill(offs_t address, int intention)
 {
 	offs_t tableindex = address >> m_pageshift;
-	vtlb_entry entry = m_table[tableindex];
+	vtlb_entry entry = m_table_base[tableindex];
 	offs_t taddress;
 
 #if PRINTF_TLB
@@ -171,8 +190,10 @@ bool device_vtlb_interface::vtlb_fill(offs_t address, int intention)
 #if PRINTF_TLB
 		osd_printf_debug("failed: no translation\n");
 #endif
+		m_stats.faults++;
 		return false;
 	}
+	m_stats.fills++;
 
 	// if this is the first successful translation for this address, allocate a new entry
 	if ((entry & VTLB_FLAGS_MASK) == 0)
@@ -183,10 +204,12 @@ bool device_vtlb_interface::vtlb_fill(offs_t address, int intention)
 		// if an entry already exists at this index, free it
 		if (m_live[liveindex] != 0)
 		{
-			if (m_refcnt[m_live[liveindex] - 1] <= 1)
-				m_table[m_live[liveindex] - 1] = 0;
+			if (m_table_base[m_live[liveindex] - 1] != 0)
+				m_stats.evictions++;
+			if (m_refcnt_base[m_live[liveindex] - 1] <= 1)
+				m_table_base[m_live[liveindex] - 1] = 0;
 			else
-				m_refcnt[m_live[liveindex] - 1]--;
+				m_refcnt_base[m_live[liveindex] - 1]--;
 		}
 
 
@@ -215,7 +238,7 @@ bool device_vtlb_interface::vtlb_fill(offs_t address, int intention)
 
 	// add the intention to the list of valid intentions and store
 	entry |= 1 << (intention & (TRANSLATE_TYPE_MASK | TRANSLATE_USER_MASK));
-	m_table[tableindex] = entry;
+	m_table_base[tableindex] = entry;
 	return true;
 }
 
@@ -241,24 +264,24 @@ void device_vtlb_interface::vtlb_load(int entrynum, int numpages, offs_t address
 	if (m_live[liveindex] != 0)
 	{
 		int oldtableindex = m_live[liveindex] - 1;
-		m_refcnt[oldtableindex]--;
-		if (m_refcnt[oldtableindex] == 0) {
+		m_refcnt_base[oldtableindex]--;
+		if (m_refcnt_base[oldtableindex] == 0) {
 			int pagecount = m_fixedpages[entrynum];
 			for (pagenum = 0; pagenum < pagecount; pagenum++) {
-				m_table[oldtableindex + pagenum] = 0;
+				m_table_base[oldtableindex + pagenum] = 0;
 			}
 		}
 	}
 
 	// claim this new entry
 	m_live[liveindex] = tableindex + 1;
-	m_refcnt[tableindex]++;
+	m_refcnt_base[tableindex]++;
 
 	// store the raw value, making sure the "fixed" flag is set
 	value |= VTLB_FLAG_FIXED;
 	m_fixedpages[entrynum] = numpages;
 	for (pagenum = 0; pagenum < numpages; pagenum++)
-		m_table[tableindex + pagenum] = value + (pagenum << m_pageshift);
+		m_table_base[tableindex + pagenum] = value + (pagenum << m_pageshift);
 }
 
 //-------------------------------------------------
@@ -267,7 +290,7 @@ void device_vtlb_interface::vtlb_load(int entrynum, int numpages, offs_t address
 
 void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry value)
 {
-	vtlb_entry entry = m_table[index];
+	vtlb_entry entry = m_table_base[index];
 
 	if (m_dynamic == 0)
 	{
@@ -276,6 +299,7 @@ void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry v
 #endif
 		return;
 	}
+	m_stats.fills++;
 
 	int liveindex = m_dynindex++ % m_dynamic;
 	// is entry already live?
@@ -283,7 +307,11 @@ void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry v
 	{
 		// if an entry already exists at this index, free it
 		if (m_live[liveindex] != 0)
-			m_table[m_live[liveindex] - 1] = 0;
+		{
+			if (m_table_base[m_live[liveindex] - 1] != 0)
+				m_stats.evictions++;
+			m_table_base[m_live[liveindex] - 1] = 0;
+		}
 
 		// claim this new entry
 		m_live[liveindex] = index + 1;
@@ -295,7 +323,7 @@ void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry v
 #if PRINTF_TLB
 	osd_printf_debug("success (%08X), new entry\n", address);
 #endif
-	m_table[index] = entry;
+	m_table_base[index] = entry;
 }
 
 //**************************************************************************
@@ -312,13 +340,14 @@ void device_vtlb_interface::vtlb_flush_dynamic()
 #if PRINTF_TLB
 	osd_printf_debug("vtlb_flush_dynamic\n");
 #endif
+	m_stats.flushes++;
 
 	// loop over live entries and release them from the table
 	for (int liveindex = 0; liveindex < m_dynamic; liveindex++)
 		if (m_live[liveindex] != 0)
 		{
 			offs_t tableindex = m_live[liveindex] - 1;
-			m_table[tableindex] = 0;
+			m_table_base[tableindex] = 0;
 			m_live[liveindex] = 0;
 		}
 }
@@ -336,9 +365,10 @@ void device_vtlb_interface::vtlb_flush_address(offs_t address)
 #if PRINTF_TLB
 	osd_printf_debug("vtlb_flush_address %08X\n", address);
 #endif
+	m_stats.address_flushes++;
 
 	// free the entry in the table; for speed, we leave the entry in the live array
-	m_table[tableindex] = 0;
+	m_table_base[tableindex] = 0;
 }
 
 
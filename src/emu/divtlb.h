@@ -45,6 +45,16 @@ typedef u32 vtlb_entry;
 class device_vtlb_interface : public device_interface
 {
 public:
+	// counters for judging whether the dynamic entry count suits a workload
+	struct statistics
+	{
+		u64 fills;              // successful dynamic fills
+		u64 faults;             // fills the CPU core could not translate
+		u64 evictions;          // valid dynamic entries replaced to make room
+		u64 flushes;            // full dynamic flushes
+		u64 address_flushes;    // single address flushes
+	};
+
 	// construction/destruction
 	device_vtlb_interface(const machine_config &mconfig, device_t &device, int space);
 	virtual ~device_vtlb_interface();
@@ -64,6 +74,8 @@ public:
 
 	// accessors
 	const vtlb_entry *vtlb_table() const;
+	const statistics &vtlb_stats() const { return m_stats; }
+	void vtlb_reset_stats() { m_stats = statistics(); }
 
 protected:
 	// interface-level overrides
@@ -71,6 +83,7 @@ protected:
 	virtual void interface_pre_start() override;
 	virtual void interface_post_start() override;
 	virtual void interface_pre_reset() override;
+	virtual void interface_post_stop() override;
 
 private:
 	// private state
@@ -82,9 +95,11 @@ private:
 	int                 m_addrwidth;        // logical address bus width
 	std::vector<offs_t> m_live;             // array of live entries by table index
 	std::vector<int>    m_fixedpages;       // number of pages each fixed entry covers
-	std::vector<vtlb_entry> m_table;        // table of entries by address
-	std::vector<offs_t> m_refcnt;           // table of entry reference counts by address
+	large_buffer        m_table;            // table of entries by address
+	large_buffer        m_refcnt;           // table of entry reference counts by address
 	vtlb_entry          *m_table_base;      // pointer to m_table[0]
+	offs_t              *m_refcnt_base;     // pointer to m_refcnt[0]
+	statistics          m_stats;            // fill and flush counters
 };
 
 
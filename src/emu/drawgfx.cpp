@@ -10,6 +10,14 @@
 #include "emu.h"
 #include "drawgfxm.h"
 
+// the row kernels have SSE2 paths under the same conditions as rgbutil.h
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define DRAWGFX_USE_SSE2    1
+#else
+#define DRAWGFX_USE_SSE2    0
+#endif
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -22,6 +30,149 @@ bitmap_ind8 drawgfx_dummy_priority_bitmap;
 
 
 
+/***************************************************************************
+    ROW KERNELS
+***************************************************************************/
+
+/*
+    These draw the leading 16-pixel groups of each row for the most common
+    operations, leaving any remainder to the PIXEL_OP.  A pixel is tested
+    against a set of pens (the transparent pen or pens) and, for the
+    priority versions, its priority against the set of masked priorities;
+    the results match the PIXEL_OP for every pixel.
+*/
+
+namespace {
+
+// a set of up to 32 values, from a bitmask
+class drawgfx_pen_set
+{
+public:
+	// a single transparent pen; pens above 0xff are never matched
+	static drawgfx_pen_set single(u32 pen) { return drawgfx_pen_set((pen <= 0xff) ? (1U << (pen & 0x1f)) : 0, (pen <= 0xff) ? pen : 0); }
+
+	// each set bit of the mask is a value in the set
+	static drawgfx_pen_set mask(u32 mask) { return drawgfx_pen_set(mask, 0); }
+
+#if DRAWGFX_USE_SSE2
+	// return 0xff in each lane whose value is in the set
+	__m128i match(__m128i values) const
+	{
+		__m128i result = _mm_setzero_si128();
+		for (int index = 0; index < m_count; index++)
+			result = _mm_or_si128(result, _mm_cmpeq_epi8(values, _mm_set1_epi8(s8(m_values[index]))));
+		return m_invert ? _mm_xor_si128(result, _mm_set1_epi8(-1)) : result;
+	}
+#endif
+
+private:
+	drawgfx_pen_set(u32 mask, u32 base)
+		: m_count(0)
+		, m_invert(population_count_32(mask) > 16)
+	{
+		// list whichever of the set or clear bits is shorter
+		u32 const bits = m_invert ? ~mask : mask;
+		for (int bit = 0; bit < 32; bit++)
+			if (BIT(bits, bit))
+				m_values[m_count++] = base | bit;
+	}
+
+	u8      m_values[32];
+	int     m_count;
+	bool    m_invert;
+};
+
+#if DRAWGFX_USE_SSE2
+
+// load 16 source pixels in drawing order
+inline __m128i drawgfx_load_source(const u8 *src, u32 done, bool flipx)
+{
+	if (!flipx)
+		return _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + done));
+
+	// flipped rows walk backwards, so load the 16 bytes ending here and reverse them
+	__m128i result = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src - done - 15));
+	result = _mm_shuffle_epi32(result, _MM_SHUFFLE(0, 1, 2, 3));
+	result = _mm_shufflelo_epi16(result, _MM_SHUFFLE(2, 3, 0, 1));
+	result = _mm_shufflehi_epi16(result, _MM_SHUFFLE(2, 3, 0, 1));
+	return _mm_or_si128(_mm_slli_epi16(result, 8), _mm_srli_epi16(result, 8));
+}
+
+// walk the row in groups of 16, calling plot(offset, source, drawmask) for
+// each group with something to draw
+template <typename Plot>
+inline u32 drawgfx_row_groups(u8 *pri, const u8 *src, u32 count, bool flipx, const drawgfx_pen_set &trans, const drawgfx_pen_set *pmask, Plot &&plot)
+{
+	u32 done = 0;
+	for ( ; done + 16 <= count; done += 16)
+	{
+		__m128i const source = drawgfx_load_source(src, done, flipx);
+		__m128i const transparent = trans.match(source);
+		if (_mm_movemask_epi8(transparent) == 0xffff)
+			continue;
+
+		// opaque pixels over a masked priority aren't drawn, but still take priority 31
+		__m128i draw = _mm_xor_si128(transparent, _mm_set1_epi8(-1));
+		if (pmask != nullptr)
+		{
+			__m128i const priority = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pri + done));
+			__m128i const updated = _mm_or_si128(_mm_and_si128(transparent, priority), _mm_andnot_si128(transparent, _mm_set1_epi8(31)));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pri + done), updated);
+			draw = _mm_andnot_si128(pmask->match(_mm_and_si128(priority, _mm_set1_epi8(0x1f))), draw);
+		}
+		plot(done, source, draw);
+	}
+	return done;
+}
+
+// draw a 16bpp row, adding the color base to each pen
+inline u32 drawgfx_row_rebase16(u16 *dest, u8 *pri, const u8 *src, u32 count, bool flipx, const drawgfx_pen_set &trans, const drawgfx_pen_set *pmask, u32 color)
+{
+	__m128i const base = _mm_set1_epi16(s16(color));
+	return drawgfx_row_groups(pri, src, count, flipx, trans, pmask, [dest, base] (u32 offset, __m128i source, __m128i draw)
+	{
+		__m128i const zero = _mm_setzero_si128();
+		__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(source, zero), base);
+		__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(source, zero), base);
+		if (_mm_movemask_epi8(draw) != 0xffff)
+		{
+			__m128i const drawlo = _mm_unpacklo_epi8(draw, draw);
+			__m128i const drawhi = _mm_unpackhi_epi8(draw, draw);
+			lo = _mm_or_si128(_mm_and_si128(drawlo, lo), _mm_andnot_si128(drawlo, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + offset))));
+			hi = _mm_or_si128(_mm_and_si128(drawhi, hi), _mm_andnot_si128(drawhi, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + offset + 8))));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + offset), lo);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + offset + 8), hi);
+	});
+}
+
+// draw a 32bpp row through the palette, optionally alpha blending; the
+// lookups stay scalar, but transparent groups are skipped in one test
+inline u32 drawgfx_row_remap32(u32 *dest, u8 *pri, const u8 *src, u32 count, bool flipx, const drawgfx_pen_set &trans, const drawgfx_pen_set *pmask, const pen_t *paldata, u8 alpha_val)
+{
+	return drawgfx_row_groups(pri, src, count, flipx, trans, pmask, [dest, paldata, alpha_val] (u32 offset, __m128i source, __m128i draw)
+	{
+		u8 pens[16];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pens), source);
+		int const bits = _mm_movemask_epi8(draw);
+		for (int index = 0; index < 16; index++)
+			if (BIT(bits, index))
+				dest[offset + index] = (alpha_val == 0xff) ? paldata[pens[index]] : alpha_blend_r32(dest[offset + index], paldata[pens[index]], alpha_val);
+	});
+}
+
+#else
+
+inline u32 drawgfx_row_rebase16(u16 *dest, u8 *pri, const u8 *src, u32 count, bool flipx, const drawgfx_pen_set &trans, const drawgfx_pen_set *pmask, u32 color) { return 0; }
+inline u32 drawgfx_row_remap32(u32 *dest, u8 *pri, const u8 *src, u32 count, bool flipx, const drawgfx_pen_set &trans, const drawgfx_pen_set *pmask, const pen_t *paldata, u8 alpha_val) { return 0; }
+
+#endif
+
+} // anonymous namespace
+
+
+
+
 /***************************************************************************
     INLINE FUNCTIONS
 ***************************************************************************/
@@ -102,8 +253,8 @@ gfx_element::gfx_element(device_palette_interface *palette, u8 *base, u16 width,
 		m_line_modulo(rowbytes),
 		m_char_modulo(0),
 		m_srcdata(base),
-		m_dirtyseq(1),
 		m_gfxdata(base),
+		m_decoded(std::make_shared<decoded_data>()),
 		m_layout_is_raw(true),
 		m_layout_planes(0),
 		m_layout_xormask(0),
@@ -127,7 +278,6 @@ gfx_element::gfx_element(device_palette_interface *palette, const gfx_layout &gl
 		m_line_modulo(0),
 		m_char_modulo(0),
 		m_srcdata(nullptr),
-		m_dirtyseq(1),
 		m_gfxdata(nullptr),
 		m_layout_is_raw(false),
 		m_layout_planes(0),
@@ -166,7 +316,6 @@ void gfx_element::set_layout(const gfx_layout &gl, const u8 *srcdata)
 		m_layout_planeoffset.clear();
 		m_layout_xoffset.clear();
 		m_layout_yoffset.clear();
-		m_gfxdata_allocated.clear();
 
 		// modulos are determined for us by the layout
 		m_line_modulo = gl.yoffs(0) / 8;
@@ -174,7 +323,6 @@ void gfx_element::set_layout(const gfx_layout &gl, const u8 *srcdata)
 
 		// RAW graphics must have a pointer up front
 		assert(srcdata != nullptr);
-		m_gfxdata = const_cast<u8 *>(srcdata);
 	}
 
 	// decoded graphics case
@@ -195,21 +343,10 @@ void gfx_element::set_layout(const gfx_layout &gl, const u8 *srcdata)
 		// we get to pick our own modulos
 		m_line_modulo = m_origwidth;
 		m_char_modulo = m_line_modulo * m_origheight;
-
-		// allocate memory for the data
-		m_gfxdata_allocated.resize(m_total_elements * m_char_modulo);
-		m_gfxdata = &m_gfxdata_allocated[0];
 	}
 
-	// mark everything dirty
-	m_dirty.resize(m_total_elements);
-	memset(&m_dirty[0], 1, m_total_elements);
-
-	// allocate a pen usage array for entries with 32 pens or less
-	if (m_color_depth <= 32)
-		m_pen_usage.resize(m_total_elements);
-	else
-		m_pen_usage.clear();
+	// allocate memory for the data and mark everything dirty
+	allocate_decoded_data();
 }
 
 
@@ -238,7 +375,10 @@ void gfx_element::set_raw_layout(const u8 *srcdata, u32 width, u32 height, u32 t
 void gfx_element::set_source(const u8 *source)
 {
 	m_srcdata = source;
-	memset(&m_dirty[0], 1, elements());
+	if (m_decoded.use_count() > 1)
+		allocate_decoded_data();
+	else
+		mark_all_dirty();
 	if (m_layout_is_raw) m_gfxdata = const_cast<u8 *>(source);
 }
 
@@ -253,24 +393,102 @@ void gfx_element::set_source_and_total(const u8 *source, u32 total)
 	m_srcdata = source;
 	m_total_elements = total;
 
-	// mark everything dirty
-	m_dirty.resize(m_total_elements);
-	memset(&m_dirty[0], 1, m_total_elements);
+	// allocate memory for the data and mark everything dirty
+	allocate_decoded_data();
+}
 
-	// allocate a pen usage array for entries with 32 pens or less
-	if (m_color_depth <= 32)
-		m_pen_usage.resize(m_total_elements);
+
+//-------------------------------------------------
+//  set_xormask - change the xor mask applied to
+//  each bit offset when decoding
+//-------------------------------------------------
+
+void gfx_element::set_xormask(u32 xormask)
+{
+	m_layout_xormask = xormask;
+
+	// elements sharing our data still want the old decoding
+	if (m_decoded.use_count() > 1)
+		allocate_decoded_data();
+}
+
+
+//-------------------------------------------------
+//  decodes_like - true if another element would
+//  decode to exactly the same pixels as this one
+//-------------------------------------------------
+
+bool gfx_element::decodes_like(const gfx_element &other) const
+{
+	return !m_layout_is_raw && !other.m_layout_is_raw &&
+			(m_srcdata == other.m_srcdata) &&
+			(m_total_elements == other.m_total_elements) &&
+			(m_origwidth == other.m_origwidth) &&
+			(m_origheight == other.m_origheight) &&
+			(m_layout_planes == other.m_layout_planes) &&
+			(m_layout_xormask == other.m_layout_xormask) &&
+			(m_layout_charincrement == other.m_layout_charincrement) &&
+			(m_layout_planeoffset == other.m_layout_planeoffset) &&
+			(m_layout_xoffset == other.m_layout_xoffset) &&
+			(m_layout_yoffset == other.m_layout_yoffset);
+}
+
+
+//-------------------------------------------------
+//  share_decoded_data - use another element's
+//  decoded pixels instead of decoding our own;
+//  changing the source or layout of either one
+//  later gives it private data again
+//-------------------------------------------------
+
+void gfx_element::share_decoded_data(const gfx_element &other)
+{
+	assert(decodes_like(other));
+
+	m_decoded = other.m_decoded;
+	m_gfxdata = other.m_gfxdata;
+}
+
+
+//-------------------------------------------------
+//  allocate_decoded_data - size the decoded data
+//  for the current layout and mark it all dirty
+//-------------------------------------------------
+
+void gfx_element::allocate_decoded_data()
+{
+	// never redecode into data another element is still drawing from
+	if (!m_decoded || (m_decoded.use_count() > 1))
+	{
+		u32 const dirtyseq = m_decoded ? m_decoded->dirtyseq : 1;
+		m_decoded = std::make_shared<decoded_data>();
+		m_decoded->dirtyseq = dirtyseq;
+	}
+	decoded_data &decoded = *m_decoded;
 
 	if (m_layout_is_raw)
 	{
-		m_gfxdata = const_cast<u8 *>(source);
+		decoded.pixels.release();
+		m_gfxdata = const_cast<u8 *>(m_srcdata);
 	}
 	else
 	{
-		// allocate memory for the data
-		m_gfxdata_allocated.resize(m_total_elements * m_char_modulo);
-		m_gfxdata = &m_gfxdata_allocated[0];
+		// large blocks are mapped on demand, so only pages holding
+		// elements that actually get decoded take up memory
+		size_t const bytes = size_t(m_total_elements) * m_char_modulo;
+		if (decoded.pixels.size() != bytes)
+			decoded.pixels.allocate(bytes, false);
+		m_gfxdata = decoded.pixels.data();
 	}
+
+	// mark everything dirty
+	decoded.dirty.assign(m_total_elements, 1);
+
+	// allocate a pen usage array for entries with 32 pens or less
+	if (m_color_depth <= 32)
+		decoded.pen_usage.resize(m_total_elements);
+	else
+		decoded.pen_usage.clear();
 }
 
 
@@ -328,7 +546,8 @@ void gfx_element::decode(u32 code)
 	}
 
 	// (re)compute pen usage
-	if (code < m_pen_usage.size())
+	std::vector<u32> &pen_usage = m_decoded->pen_usage;
+	if (code < pen_usage.size())
 	{
 		// iterate over data, creating a bitmask of live pens
 		const u8 *dp = m_gfxdata + code * m_char_modulo;
@@ -341,11 +560,25 @@ void gfx_element::decode(u32 code)
 		}
 
 		// store the final result
-		m_pen_usage[code] = usage;
+		pen_usage[code] = usage;
 	}
 
 	// no longer dirty
-	m_dirty[code] = 0;
+	m_decoded->dirty[code] = 0;
+}
+
+
+//-------------------------------------------------
+//  decode_all - decode every dirty character up
+//  front instead of on first use
+//-------------------------------------------------
+
+void gfx_element::decode_all()
+{
+	std::vector<u8> const &dirty = m_decoded->dirty;
+	for (u32 code = 0; code < elements() && code < dirty.size(); code++)
+		if (dirty[code])
+			decode(code);
 }
 
 
@@ -408,7 +641,9 @@ void gfx_element::transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	drawgfx_pen_set const trans = drawgfx_pen_set::single(trans_pen);
+	auto const kernel = [&] (u16 *d, NO_PRIORITY *p, const u8 *s, u32 n, bool f) { return drawgfx_row_rebase16(d, nullptr, s, n, f, trans, nullptr, color); };
+	DRAWGFX_CORE_ROWS(u16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY, kernel);
 }
 
 void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -436,7 +671,9 @@ void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	drawgfx_pen_set const trans = drawgfx_pen_set::single(trans_pen);
+	auto const kernel = [&] (u32 *d, NO_PRIORITY *p, const u8 *s, u32 n, bool f) { return drawgfx_row_remap32(d, nullptr, s, n, f, trans, nullptr, paldata, 0xff); };
+	DRAWGFX_CORE_ROWS(u32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY, kernel);
 }
 
 
@@ -503,10 +740,13 @@ void gfx_element::transmask(bitmap_ind16 &dest, const rectangle &cliprect,
 			return opaque(dest, cliprect, code, color, flipx, flipy, destx, desty);
 	}
 
-	// render
+	// render; the row kernel can only test pens that fit in the mask
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_TRANSMASK, NO_PRIORITY);
+	drawgfx_pen_set const trans = drawgfx_pen_set::mask(trans_mask);
+	bool const use_kernel = depth() <= 32;
+	auto const kernel = [&] (u16 *d, NO_PRIORITY *p, const u8 *s, u32 n, bool f) { return use_kernel ? drawgfx_row_rebase16(d, nullptr, s, n, f, trans, nullptr, color) : 0; };
+	DRAWGFX_CORE_ROWS(u16, PIXEL_OP_REBASE_TRANSMASK, NO_PRIORITY, kernel);
 }
 
 void gfx_element::transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -531,10 +771,13 @@ void gfx_element::transmask(bitmap_rgb32 &dest, const rectangle &cliprect,
 			return opaque(dest, cliprect, code, color, flipx, flipy, destx, desty);
 	}
 
-	// render
+	// render; the row kernel can only test pens that fit in the mask
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY);
+	drawgfx_pen_set const trans = drawgfx_pen_set::mask(trans_mask);
+	bool const use_kernel = depth() <= 32;
+	auto const kernel = [&] (u32 *d, NO_PRIORITY *p, const u8 *s, u32 n, bool f) { return use_kernel ? drawgfx_row_remap32(d, nullptr, s, n, f, trans, nullptr, paldata, 0xff) : 0; };
+	DRAWGFX_CORE_ROWS(u32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY, kernel);
 }
 
 
@@ -595,7 +838,9 @@ void gfx_element::alpha(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// get final code and color, and grab lookup tables
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(u32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY);
+	drawgfx_pen_set const trans = drawgfx_pen_set::single(trans_pen);
+	auto const kernel = [&] (u32 *d, NO_PRIORITY *p, const u8 *s, u32 n, bool f) { return drawgfx_row_remap32(d, nullptr, s, n, f, trans, nullptr, paldata, alpha_val); };
+	DRAWGFX_CORE_ROWS(u32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY, kernel);
 }
 
 
@@ -968,7 +1213,10 @@ void gfx_element::prio_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(u16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, u8);
+	drawgfx_pen_set const trans = drawgfx_pen_set::single(trans_pen);
+	drawgfx_pen_set const masked = drawgfx_pen_set::mask(pmask);
+	auto const kernel = [&] (u16 *d, u8 *p, const u8 *s, u32 n, bool f) { return drawgfx_row_rebase16(d, p, s, n, f, trans, &masked, color); };
+	DRAWGFX_CORE_ROWS(u16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, u8, kernel);
 }
 
 void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -998,7 +1246,10 @@ void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(u32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, u8);
+	drawgfx_pen_set const trans = drawgfx_pen_set::single(trans_pen);
+	drawgfx_pen_set const masked = drawgfx_pen_set::mask(pmask);
+	auto const kernel = [&] (u32 *d, u8 *p, const u8 *s, u32 n, bool f) { return drawgfx_row_remap32(d, p, s, n, f, trans, &masked, paldata, 0xff); };
+	DRAWGFX_CORE_ROWS(u32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, u8, kernel);
 }
 
 
@@ -1173,7 +1424,10 @@ void gfx_element::prio_alpha(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(u32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, u8);
+	drawgfx_pen_set const trans = drawgfx_pen_set::single(trans_pen);
+	drawgfx_pen_set const masked = drawgfx_pen_set::mask(pmask);
+	auto const kernel = [&] (u32 *d, u8 *p, const u8 *s, u32 n, bool f) { return drawgfx_row_remap32(d, p, s, n, f, trans, &masked, paldata, alpha_val); };
+	DRAWGFX_CORE_ROWS(u32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, u8, kernel);
 }
 
 
@@ -164,40 +164,47 @@ public:
 	u16 granularity() const { return m_color_granularity; }
 	u32 colors() const { return m_total_colors; }
 	u32 rowbytes() const { return m_line_modulo; }
-	bool has_pen_usage() const { return !m_pen_usage.empty(); }
+	bool has_pen_usage() const { return !m_decoded->pen_usage.empty(); }
 	bool has_palette() const { return m_palette; }
 
 	// used by tilemaps
-	u32 dirtyseq() const { return m_dirtyseq; }
+	u32 dirtyseq() const { return m_decoded->dirtyseq; }
 
 	// setters
 	void set_layout(const gfx_layout &gl, const u8 *srcdata);
 	void set_raw_layout(const u8 *srcdata, u32 width, u32 height, u32 total, u32 linemod, u32 charmod);
 	void set_source(const u8 *source);
 	void set_source_and_total(const u8 *source, u32 total);
-	void set_xormask(u32 xormask) { m_layout_xormask = xormask; }
+	void set_xormask(u32 xormask);
 	void set_palette(device_palette_interface &palette) { m_palette = &palette; }
 	void set_colors(u32 colors) { m_total_colors = colors; }
 	void set_colorbase(u16 colorbase) { m_color_base = colorbase; }
 	void set_granularity(u16 granularity) { m_color_granularity = granularity; }
 	void set_source_clip(u32 xoffs, u32 width, u32 yoffs, u32 height);
 
+	// decoded data sharing
+	bool decodes_like(const gfx_element &other) const;
+	void share_decoded_data(const gfx_element &other);
+	bool shares_decoded_data(const gfx_element &other) const { return m_decoded == other.m_decoded; }
+
 	// operations
-	void mark_dirty(u32 code) { if (code < elements()) { m_dirty[code] = 1; m_dirtyseq++; } }
-	void mark_all_dirty() { memset(&m_dirty[0], 1, elements()); }
+	void mark_dirty(u32 code) { if (code < elements()) { m_decoded->dirty[code] = 1; m_decoded->dirtyseq++; } }
+	void mark_all_dirty() { memset(&m_decoded->dirty[0], 1, elements()); }
+	void decode_all();
 
 	const u8 *get_data(u32 code)
 	{
 		assert(code < elements());
-		if (code < m_dirty.size() && m_dirty[code]) decode(code);
+		std::vector<u8> const &dirty = m_decoded->dirty;
+		if (code < dirty.size() && dirty[code]) decode(code);
 		return m_gfxdata + code * m_char_modulo + m_starty * m_line_modulo + m_startx;
 	}
 
 	u32 pen_usage(u32 code)
 	{
-		assert(code < m_pen_usage.size());
-		if (m_dirty[code]) decode(code);
-		return m_pen_usage[code];
+		assert(code < m_decoded->pen_usage.size());
+		if (m_decoded->dirty[code]) decode(code);
+		return m_decoded->pen_usage[code];
 	}
 
 	// ----- core graphics drawing -----
@@ -267,7 +274,17 @@ public:
 	void alphatable(bitmap_rgb32 &dest, const rectangle &cliprect, u32 code, u32 color, int flipx, int flipy, s32 destx, s32 desty, int fixedalpha ,u8 *alphatable);
 private:
 	// internal helpers
+	// decoded pixels and their bookkeeping, shared by elements that decode the same source the same way
+	struct decoded_data
+	{
+		large_buffer        pixels;             // allocated decoded pixel data, 8bpp
+		std::vector<u8>     dirty;              // dirty array for detecting chars that need decoding
+		std::vector<u32>    pen_usage;          // bitmask of pens that are used (pens 0-31 only)
+		u32                 dirtyseq = 1;       // sequence number; incremented each time a tile is dirtied
+	};
+
 	void decode(u32 code);
+	void allocate_decoded_data();
 
 	// internal state
 	device_palette_interface *m_palette;    // palette used for drawing (optional when used as a pure decoder)
@@ -289,12 +306,9 @@ private:
 	u32             m_line_modulo;          // bytes between each row of data
 	u32             m_char_modulo;          // bytes between each element
 	const u8 *      m_srcdata;              // pointer to the source data for decoding
-	u32             m_dirtyseq;             // sequence number; incremented each time a tile is dirtied
 
 	u8 *            m_gfxdata;              // pointer to decoded pixel data, 8bpp
-	std::vector<u8> m_gfxdata_allocated;    // allocated decoded pixel data, 8bpp
-	std::vector<u8> m_dirty;                // dirty array for detecting chars that need decoding
-	std::vector<u32>  m_pen_usage;      // bitmask of pens that are used (pens 0-31 only)
+	std::shared_ptr<decoded_data> m_decoded; // decoded data, possibly shared with other elements
 
 	bool            m_layout_is_raw;        // raw layout?
 	u8              m_layout_planes;        // bit planes in the layout
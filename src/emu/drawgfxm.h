@@ -53,6 +53,13 @@
 /* special priority type meaning "none" */
 struct NO_PRIORITY { char dummy[3]; };
 
+/* row kernel that leaves every pixel to the PIXEL_OP */
+struct drawgfx_no_row_kernel
+{
+	template <typename PixelType, typename PriorityType>
+	u32 operator()(PixelType *dest, PriorityType *pri, const u8 *src, u32 count, bool flipx) const { return 0; }
+};
+
 extern bitmap_ind8 drawgfx_dummy_priority_bitmap;
 #define DECLARE_NO_PRIORITY bitmap_t &priority = drawgfx_dummy_priority_bitmap;
 
@@ -395,10 +402,15 @@ while (0)
         s32 destx - the top-left X coordinate to render to
         s32 desty - the top-left Y coordinate to render to
         bitmap_t &priority - the priority bitmap (even if PRIORITY_TYPE is NO_PRIORITY, at least needs a dummy)
+
+    DRAWGFX_CORE_ROWS also takes a ROW_KERNEL, called at the start of each row as
+    ROW_KERNEL(destptr, priptr, srcptr, numpixels, flipx); it may draw any number
+    of leading pixels (for example with SIMD) and returns how many it drew, with
+    the PIXEL_OP finishing the rest of the row.
 */
 
 
-#define DRAWGFX_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE)                           \
+#define DRAWGFX_CORE_ROWS(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, ROW_KERNEL)          \
 do {                                                                                \
 	g_profiler.start(PROFILER_DRAWGFX);                                             \
 	do {                                                                            \
@@ -466,9 +478,8 @@ do {
 		/* fetch the source data */                                                 \
 		srcdata = get_data(code);                                                   \
 																					\
-		/* compute how many blocks of 4 pixels we have */                           \
-		u32 numblocks = (destendx + 1 - destx) / 4;                                 \
-		u32 leftovers = (destendx + 1 - destx) - 4 * numblocks;                     \
+		/* compute how many pixels we have per row */                               \
+		u32 numpixels = destendx + 1 - destx;                                       \
 																					\
 		/* adjust srcdata to point to the first source pixel of the row */          \
 		srcdata += srcy * rowbytes() + srcx;                                        \
@@ -484,6 +495,14 @@ do {
 				const u8 *srcptr = srcdata;                                         \
 				srcdata += dy;                                                      \
 																					\
+				/* let the row kernel take as much of the row as it can */          \
+				u32 done = ROW_KERNEL(destptr, priptr, srcptr, numpixels, false);   \
+				srcptr += done;                                                     \
+				destptr += done;                                                    \
+				PRIORITY_ADVANCE(PRIORITY_TYPE, priptr, done);                      \
+				u32 numblocks = (numpixels - done) / 4;                             \
+				u32 leftovers = (numpixels - done) - 4 * numblocks;                 \
+																					\
 				/* iterate over unrolled blocks of 4 */                             \
 				for (curx = 0; curx < numblocks; curx++)                            \
 				{                                                                   \
@@ -519,6 +538,14 @@ do {
 				const u8 *srcptr = srcdata;                                         \
 				srcdata += dy;                                                      \
 																					\
+				/* let the row kernel take as much of the row as it can */          \
+				u32 done = ROW_KERNEL(destptr, priptr, srcptr, numpixels, true);    \
+				srcptr -= done;                                                     \
+				destptr += done;                                                    \
+				PRIORITY_ADVANCE(PRIORITY_TYPE, priptr, done);                      \
+				u32 numblocks = (numpixels - done) / 4;                             \
+				u32 leftovers = (numpixels - done) - 4 * numblocks;                 \
+																					\
 				/* iterate over unrolled blocks of 4 */                             \
 				for (curx = 0; curx < numblocks; curx++)                            \
 				{                                                                   \
@@ -546,6 +573,9 @@ do {
 	g_profiler.stop();                                                              \
 } while (0)
 
+#define DRAWGFX_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE)                           \
+	DRAWGFX_CORE_ROWS(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, drawgfx_no_row_kernel())
+
 
 
 /***************************************************************************
@@ -205,3 +205,132 @@ void resource_pool::clear()
 	while (m_ordered_head != nullptr)
 		remove(m_ordered_head->m_ptr);
 }
+
+
+
+//**************************************************************************
+//  LARGE BUFFER
+//**************************************************************************
+
+//-------------------------------------------------
+//  operator= - take over another buffer
+//-------------------------------------------------
+
+large_buffer &large_buffer::operator=(large_buffer &&that) noexcept
+{
+	if (&that != this)
+	{
+		release();
+		m_heap = std::move(that.m_heap);
+		m_data = that.m_data;
+		m_size = that.m_size;
+		m_mapped = that.m_mapped;
+		that.m_data = nullptr;
+		that.m_size = 0;
+		that.m_mapped = false;
+	}
+	return *this;
+}
+
+
+//-------------------------------------------------
+//  allocate - get zeroed memory, mapping big
+//  blocks from the OS and falling back to the
+//  heap if that fails
+//-------------------------------------------------
+
+void large_buffer::allocate(size_t size, bool huge_pages)
+{
+	release();
+	if (size == 0)
+		return;
+
+	if (size >= LARGE_THRESHOLD)
+	{
+		m_data = reinterpret_cast<osd::u8 *>(osd_alloc_large(size, huge_pages));
+		if (m_data != nullptr)
+		{
+			m_size = size;
+			m_mapped = true;
+			return;
+		}
+	}
+
+	// smaller blocks come from the heap, page-aligned once they cover a page
+	if (size < 4096)
+	{
+		m_heap.reset(new osd::u8[size]());
+		m_data = m_heap.get();
+	}
+	else
+	{
+		m_heap.reset(new osd::u8[size + 0xfff]());
+		m_data = reinterpret_cast<osd::u8 *>((reinterpret_cast<uintptr_t>(m_heap.get()) + 0xfff) & ~uintptr_t(0xfff));
+	}
+	m_size = size;
+}
+
+
+//-------------------------------------------------
+//  release - give the memory back
+//-------------------------------------------------
+
+void large_buffer::release()
+{
+	if (m_mapped)
+		osd_free_large(m_data, m_size);
+	m_heap.reset();
+	m_data = nullptr;
+	m_size = 0;
+	m_mapped = false;
+}
+
+
+
+//**************************************************************************
+//  FRAME ARENA
+//**************************************************************************
+
+//-------------------------------------------------
+//  allocate - carve aligned memory from the
+//  current block, moving on to the next (or a
+//  new) block when it doesn't fit
+//-------------------------------------------------
+
+void *frame_arena::allocate(size_t size, size_t align)
+{
+	while (m_current < m_blocks.size())
+	{
+		auto &block = m_blocks[m_current];
+		uintptr_t const base = reinterpret_cast<uintptr_t>(block.first.get());
+		size_t const start = ((base + m_offset + align - 1) & ~uintptr_t(align - 1)) - base;
+		if (start + size <= block.second)
+		{
+			m_offset = start + size;
+			m_used += size;
+			return block.first.get() + start;
+		}
+		m_current++;
+		m_offset = 0;
+	}
+
+	// oversized requests get a block of their own
+	size_t const blocksize = std::max<size_t>(size_t(BLOCK_SIZE), size + align);
+	m_blocks.emplace_back(std::make_unique<osd::u8 []>(blocksize), blocksize);
+	m_current = m_blocks.size() - 1;
+	m_offset = 0;
+	return allocate(size, align);
+}
+
+
+//-------------------------------------------------
+//  reserved - total size of the blocks held
+//-------------------------------------------------
+
+size_t frame_arena::reserved() const
+{
+	size_t total = 0;
+	for (auto const &block : m_blocks)
+		total += block.second;
+	return total;
+}
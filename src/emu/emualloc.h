@@ -19,6 +19,8 @@
 #include <memory>
 #include <mutex>
 #include <new>
+#include <utility>
+#include <vector>
 
 
 //**************************************************************************
@@ -143,4 +145,102 @@ private:
 };
 
 
+// zero-filled memory for big emulated RAM and lookup tables; blocks of at
+// least LARGE_THRESHOLD bytes are mapped straight from the OS, so they are
+// zeroed lazily on first touch and can be backed by huge pages
+class large_buffer
+{
+public:
+	static constexpr size_t LARGE_THRESHOLD = size_t(1) << 20;
+
+	large_buffer() noexcept : m_data(nullptr), m_size(0), m_mapped(false) { }
+	large_buffer(size_t size, bool huge_pages) : large_buffer() { allocate(size, huge_pages); }
+	large_buffer(large_buffer &&that) noexcept : m_heap(std::move(that.m_heap)), m_data(that.m_data), m_size(that.m_size), m_mapped(that.m_mapped) { that.m_data = nullptr; that.m_size = 0; that.m_mapped = false; }
+	large_buffer &operator=(large_buffer &&that) noexcept;
+	large_buffer(const large_buffer &) = delete;
+	large_buffer &operator=(const large_buffer &) = delete;
+	~large_buffer() { release(); }
+
+	// allocate zeroed memory, page-aligned from 4K up; discards any previous contents
+	void allocate(size_t size, bool huge_pages);
+	void release();
+
+	// getters
+	osd::u8 *data() const { return m_data; }
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	bool mapped() const { return m_mapped; }
+	template <typename T> T *as() const { return reinterpret_cast<T *>(m_data); }
+
+private:
+	std::unique_ptr<osd::u8 []> m_heap;             // backing for smaller blocks
+	osd::u8 *               m_data;                 // start of the usable memory
+	size_t                  m_size;                 // usable size in bytes
+	bool                    m_mapped;               // flag: memory came from osd_alloc_large
+};
+
+
+// bump allocator for short-lived objects that are all discarded together,
+// such as per-frame UI layouts; reset() keeps the blocks for reuse, so a
+// steady-state frame does no heap allocation at all
+class frame_arena
+{
+public:
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+	frame_arena() : m_current(0), m_offset(0), m_used(0) { }
+	frame_arena(const frame_arena &) = delete;
+	frame_arena &operator=(const frame_arena &) = delete;
+
+	// carve out memory; it stays valid until the next reset()
+	void *allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+	// forget everything allocated so far; destructors are not run
+	void reset() { m_current = 0; m_offset = 0; m_used = 0; }
+
+	// getters
+	size_t used() const { return m_used; }
+	size_t reserved() const;
+
+private:
+	std::vector<std::pair<std::unique_ptr<osd::u8 []>, size_t>> m_blocks;
+	size_t                  m_current;              // index of the block being carved
+	size_t                  m_offset;               // offset of the next free byte in it
+	size_t                  m_used;                 // bytes handed out since the last reset
+};
+
+
+// standard allocator drawing from a frame_arena, or from the heap when there
+// is no arena; deallocate is a no-op for arena memory
+template <typename T>
+class frame_arena_allocator
+{
+public:
+	typedef T value_type;
+
+	frame_arena_allocator(frame_arena *arena = nullptr) noexcept : m_arena(arena) { }
+	template <typename U> frame_arena_allocator(const frame_arena_allocator<U> &that) noexcept : m_arena(that.arena()) { }
+
+	T *allocate(size_t count)
+	{
+		if (m_arena)
+			return reinterpret_cast<T *>(m_arena->allocate(count * sizeof(T), alignof(T)));
+		return reinterpret_cast<T *>(::operator new(count * sizeof(T)));
+	}
+	void deallocate(T *ptr, size_t) noexcept
+	{
+		if (!m_arena)
+			::operator delete(ptr);
+	}
+
+	frame_arena *arena() const noexcept { return m_arena; }
+
+	template <typename U> bool operator==(const frame_arena_allocator<U> &that) const noexcept { return m_arena == that.arena(); }
+	template <typename U> bool operator!=(const frame_arena_allocator<U> &that) const noexcept { return m_arena != that.arena(); }
+
+private:
+	frame_arena *m_arena;
+};
+
+
 #endif // MAME_EMU_EMUALLOC_H
@@ -181,6 +181,12 @@ class running_machine;
 namespace emu { namespace detail { struct machine_config_replace; } }
 class machine_config;
 
+// declared in insnprof.h
+class instruction_profiler;
+
+// declared in memtrace.h
+class memory_tracer;
+
 // declared in natkeyboard.h
 class natural_keyboard;
 
@@ -193,6 +199,7 @@ class output_manager;
 // declared in render.h
 class layout_element;
 class layout_view;
+class render_bitmap_allocator;
 class render_container;
 class render_manager;
 class render_target;
@@ -125,6 +125,19 @@ template<int Width, int AddrShift, int Endian> void handler_entry_read<Width, Ad
 	fatalerror("detach called on non-dispatching class\n");
 }
 
+template<int Width, int AddrShift, int Endian> void handler_entry_read<Width, AddrShift, Endian>::compact_dispatch()
+{
+}
+
+template<int Width, int AddrShift, int Endian> bool handler_entry_read<Width, AddrShift, Endian>::uniform_dispatch(handler_entry_read<Width, AddrShift, Endian> *&handler, offs_t &start, offs_t &end) const
+{
+	return false;
+}
+
+template<int Width, int AddrShift, int Endian> void handler_entry_read<Width, AddrShift, Endian>::dispatch_footprint(u32 &tables, size_t &bytes) const
+{
+}
+
 
 template<int Width, int AddrShift, int Endian> void handler_entry_write<Width, AddrShift, Endian>::populate_nomirror(offs_t start, offs_t end, offs_t ostart, offs_t oend, handler_entry_write<Width, AddrShift, Endian> *handler)
 {
@@ -171,6 +184,19 @@ template<int Width, int AddrShift, int Endian> void handler_entry_write<Width, A
 	fatalerror("detach called on non-dispatching class\n");
 }
 
+template<int Width, int AddrShift, int Endian> void handler_entry_write<Width, AddrShift, Endian>::compact_dispatch()
+{
+}
+
+template<int Width, int AddrShift, int Endian> bool handler_entry_write<Width, AddrShift, Endian>::uniform_dispatch(handler_entry_write<Width, AddrShift, Endian> *&handler, offs_t &start, offs_t &end) const
+{
+	return false;
+}
+
+template<int Width, int AddrShift, int Endian> void handler_entry_write<Width, AddrShift, Endian>::dispatch_footprint(u32 &tables, size_t &bytes) const
+{
+}
+
 
 
 /*-------------------------------------------------
@@ -407,6 +433,17 @@ public:
 		refs.check();
 	}
 
+	void compact_dispatch() override {
+		invalidate_caches(read_or_write::READWRITE);
+		m_root_read->compact_dispatch();
+		m_root_write->compact_dispatch();
+	}
+
+	void dispatch_footprint(u32 &tables, size_t &bytes) const override {
+		m_root_read->dispatch_footprint(tables, bytes);
+		m_root_write->dispatch_footprint(tables, bytes);
+	}
+
 	virtual void remove_passthrough(std::unordered_set<handler_entry *> &handlers) override {
 		invalidate_caches(read_or_write::READWRITE);
 		m_root_read->detach(handlers);
@@ -444,11 +481,46 @@ public:
 		return m_root_write->get_ptr(address);
 	}
 
+#ifdef MAME_MEMORY_HEATMAP
+	// native read through the leaf handler, counted
+	NativeType heatmap_read(offs_t offset, NativeType mask)
+	{
+		offs_t start, end;
+		handler_entry_read<Width, AddrShift, Endian> *handler;
+		m_root_read->lookup(offset, start, end, handler);
+
+		osd_ticks_t const begin = osd_ticks();
+		uX result = handler->read(offset, mask);
+		m_heatmap.record(*handler, start, end, address_to_byte(offset), false, osd_ticks() - begin);
+		return result;
+	}
+
+	// native write through the leaf handler, counted
+	void heatmap_write(offs_t offset, NativeType data, NativeType mask)
+	{
+		offs_t start, end;
+		handler_entry_write<Width, AddrShift, Endian> *handler;
+		m_root_write->lookup(offset, start, end, handler);
+
+		osd_ticks_t const begin = osd_ticks();
+		handler->write(offset, data, mask);
+		m_heatmap.record(*handler, start, end, address_to_byte(offset), true, osd_ticks() - begin);
+	}
+#endif
+
 	// native read
 	NativeType read_native(offs_t offset, NativeType mask)
 	{
 		g_profiler.start(PROFILER_MEMREAD);
 
+#ifdef MAME_MEMORY_HEATMAP
+		if (m_heatmap.enabled())
+		{
+			uX result = heatmap_read(offset, mask);
+			g_profiler.stop();
+			return result;
+		}
+#endif
 		uX result = m_root_read->read(offset, mask);
 
 		g_profiler.stop();
@@ -460,6 +532,14 @@ public:
 	{
 		g_profiler.start(PROFILER_MEMREAD);
 
+#ifdef MAME_MEMORY_HEATMAP
+		if (m_heatmap.enabled())
+		{
+			uX result = heatmap_read(offset, uX(0xffffffffffffffffU));
+			g_profiler.stop();
+			return result;
+		}
+#endif
 		uX result = m_root_read->read(offset, uX(0xffffffffffffffffU));
 
 		g_profiler.stop();
@@ -471,6 +551,14 @@ public:
 	{
 		g_profiler.start(PROFILER_MEMWRITE);
 
+#ifdef MAME_MEMORY_HEATMAP
+		if (m_heatmap.enabled())
+		{
+			heatmap_write(offset, data, mask);
+			g_profiler.stop();
+			return;
+		}
+#endif
 		m_root_write->write(offset, data, mask);
 
 		g_profiler.stop();
@@ -481,6 +569,14 @@ public:
 	{
 		g_profiler.start(PROFILER_MEMWRITE);
 
+#ifdef MAME_MEMORY_HEATMAP
+		if (m_heatmap.enabled())
+		{
+			heatmap_write(offset, data, uX(0xffffffffffffffffU));
+			g_profiler.stop();
+			return;
+		}
+#endif
 		m_root_write->write(offset, data, uX(0xffffffffffffffffU));
 
 		g_profiler.stop();
@@ -515,6 +611,89 @@ public:
 	void write_qword_unaligned(offs_t address, u64 data) override { address &= m_addrmask; memory_write_generic<Width, AddrShift, Endian, 3, false>([this](offs_t offset, NativeType data, NativeType mask) { write_native(offset, data, mask); }, address, data, 0xffffffffffffffffU); }
 	void write_qword_unaligned(offs_t address, u64 data, u64 mask) override {address &= m_addrmask;  memory_write_generic<Width, AddrShift, Endian, 3, false>([this](offs_t offset, NativeType data, NativeType mask) { write_native(offset, data, mask); }, address, data, mask); }
 
+	// block transfers: runs of RAM, ROM and banks are copied directly, everything else is dispatched a unit at a time
+	void read_block(offs_t address, offs_t count, void *buffer) override
+	{
+		NativeType *dest = reinterpret_cast<NativeType *>(buffer);
+		address &= m_addrmask & ~NATIVE_MASK;
+		while (count != 0)
+		{
+			offs_t start, end;
+			handler_entry_read<Width, AddrShift, Endian> *handler;
+			m_root_read->lookup(address, start, end, handler);
+			NativeType const *ptr = reinterpret_cast<NativeType const *>(handler->get_ptr(address));
+			offs_t const units = block_span_units(*handler, ptr, address, end, count);
+			if (ptr)
+				memcpy(dest, ptr, units * NATIVE_BYTES);
+			else
+				for (offs_t unit = 0; unit < units; unit++)
+					dest[unit] = read_native((address + unit * NATIVE_STEP) & m_addrmask);
+			dest += units;
+			address = (address + units * NATIVE_STEP) & m_addrmask;
+			count -= units;
+		}
+	}
+
+	void write_block(offs_t address, offs_t count, const void *buffer) override
+	{
+		NativeType const *src = reinterpret_cast<NativeType const *>(buffer);
+		address &= m_addrmask & ~NATIVE_MASK;
+		while (count != 0)
+		{
+			offs_t start, end;
+			handler_entry_write<Width, AddrShift, Endian> *handler;
+			m_root_write->lookup(address, start, end, handler);
+			NativeType *ptr = reinterpret_cast<NativeType *>(handler->get_ptr(address));
+			offs_t const units = block_span_units(*handler, ptr, address, end, count);
+			if (ptr)
+				memcpy(ptr, src, units * NATIVE_BYTES);
+			else
+				for (offs_t unit = 0; unit < units; unit++)
+					write_native((address + unit * NATIVE_STEP) & m_addrmask, src[unit]);
+			src += units;
+			address = (address + units * NATIVE_STEP) & m_addrmask;
+			count -= units;
+		}
+	}
+
+	void copy_block(offs_t dest, offs_t source, offs_t count) override
+	{
+		dest &= m_addrmask & ~NATIVE_MASK;
+		source &= m_addrmask & ~NATIVE_MASK;
+
+		// a destination just past the source has to see each unit as it's written
+		if ((dest > source) && ((u64(dest) - source) < (u64(count) * NATIVE_STEP)))
+		{
+			for ( ; count != 0; count--, dest = (dest + NATIVE_STEP) & m_addrmask, source = (source + NATIVE_STEP) & m_addrmask)
+				write_native(dest, read_native(source));
+			return;
+		}
+
+		NativeType buffer[256];
+		while (count != 0)
+		{
+			offs_t const units = std::min<offs_t>(count, ARRAY_LENGTH(buffer));
+			read_block(source, units, buffer);
+			write_block(dest, units, buffer);
+			source = (source + units * NATIVE_STEP) & m_addrmask;
+			dest = (dest + units * NATIVE_STEP) & m_addrmask;
+			count -= units;
+		}
+	}
+
+	// number of units from address that can be handled in one go by the handler covering address-end
+	template <typename Handler, typename Pointer>
+	offs_t block_span_units(const Handler &handler, Pointer ptr, offs_t address, offs_t end, offs_t count) const
+	{
+		offs_t units = offs_t(std::min<u64>(count, (u64(end) - address) / NATIVE_STEP + 1));
+
+		// mirrored memory can wrap inside a span, so cut it back until it's contiguous
+		if (ptr)
+			while ((units > 1) && (handler.get_ptr(address + (units - 1) * NATIVE_STEP) != ptr + (units - 1)))
+				units = (units + 1) / 2;
+		return units;
+	}
+
 	// static access to these functions
 	static u8 read_byte_static(this_type &space, offs_t address) { address &= space.m_addrmask; return Width == 0 ? space.read_native(address & ~NATIVE_MASK) : memory_read_generic<Width, AddrShift, Endian, 0, true>([&space](offs_t offset, NativeType mask) -> NativeType { return space.read_native(offset, mask); }, address, 0xff); }
 	static u16 read_word_static(this_type &space, offs_t address) { address &= space.m_addrmask; return Width == 1 ? space.read_native(address & ~NATIVE_MASK) : memory_read_generic<Width, AddrShift, Endian, 1, true>([&space](offs_t offset, NativeType mask) -> NativeType { return space.read_native(offset, mask); }, address, 0xffff); }
@@ -713,6 +892,134 @@ private:
 
 
 
+#ifdef MAME_MEMORY_HEATMAP
+
+//**************************************************************************
+//  ACCESS HEATMAP
+//**************************************************************************
+
+//-------------------------------------------------
+//  record - count an access to a handler
+//-------------------------------------------------
+
+void memory_heatmap::record(const handler_entry &handler, offs_t start, offs_t end, offs_t byteaddress, bool write, osd_ticks_t ticks)
+{
+	// handlers are freed when the map changes, so a reused pointer with a different range starts afresh
+	handler_stats &stats = m_handlers[write ? 1 : 0][&handler];
+	if ((stats.count == 0) || (stats.start != start) || (stats.end != end))
+		stats = handler_stats{ handler.name(), start, end, 0, 0, write };
+	stats.count++;
+	stats.ticks += ticks;
+	m_pages[byteaddress >> PAGE_SHIFT]++;
+}
+
+
+//-------------------------------------------------
+//  clear - forget everything counted so far
+//-------------------------------------------------
+
+void memory_heatmap::clear()
+{
+	m_handlers[0].clear();
+	m_handlers[1].clear();
+	m_pages.clear();
+}
+
+
+//-------------------------------------------------
+//  handlers - return handler totals, busiest
+//  first
+//-------------------------------------------------
+
+std::vector<memory_heatmap::handler_stats> memory_heatmap::handlers() const
+{
+	std::vector<handler_stats> result;
+	result.reserve(m_handlers[0].size() + m_handlers[1].size());
+	for (auto const &direction : m_handlers)
+		for (auto const &entry : direction)
+			result.push_back(entry.second);
+	std::sort(result.begin(), result.end(), [] (handler_stats const &a, handler_stats const &b) { return a.count > b.count; });
+	return result;
+}
+
+
+//-------------------------------------------------
+//  pages - return byte addresses of pages with
+//  their access counts, busiest first
+//-------------------------------------------------
+
+std::vector<std::pair<offs_t, u64>> memory_heatmap::pages() const
+{
+	std::vector<std::pair<offs_t, u64>> result;
+	result.reserve(m_pages.size());
+	for (auto const &entry : m_pages)
+		result.emplace_back(entry.first << PAGE_SHIFT, entry.second);
+	std::sort(result.begin(), result.end(), [] (std::pair<offs_t, u64> const &a, std::pair<offs_t, u64> const &b) { return a.second > b.second; });
+	return result;
+}
+
+
+//-------------------------------------------------
+//  ticks_to_ns - convert host ticks to an
+//  estimate in nanoseconds
+//-------------------------------------------------
+
+u64 memory_heatmap::ticks_to_ns(osd_ticks_t ticks)
+{
+	return u64(double(ticks) * 1.0e9 / double(osd_ticks_per_second()));
+}
+
+#endif // MAME_MEMORY_HEATMAP
+
+
+
+//**************************************************************************
+//  DIRTY TRACKING
+//**************************************************************************
+
+//-------------------------------------------------
+//  mark - record a write to a range of bytes
+//-------------------------------------------------
+
+void memory_dirty_map::mark(offs_t byteoffset, size_t length)
+{
+	if ((length == 0) || (byteoffset >= m_bytes))
+		return;
+	size_t const last = (std::min<size_t>(size_t(byteoffset) + length, m_bytes) - 1) >> m_page_bits;
+	for (size_t page = byteoffset >> m_page_bits; page <= last; page++)
+		m_stamps[page] = m_version;
+}
+
+
+//-------------------------------------------------
+//  install_dirty_taps - install write taps that
+//  stamp the pages of a dirty map, with the start
+//  of the range at offset zero of the map
+//-------------------------------------------------
+
+template <typename T>
+static void install_dirty_tap(address_space &space, offs_t addrstart, offs_t addrend, offs_t addrmirror, memory_dirty_map &map)
+{
+	space.install_write_tap(addrstart, addrend, addrmirror, "dirty",
+			std::function<void (offs_t, T &, T)>([&space, &map, addrstart, addrmirror] (offs_t offset, T &data, T mem_mask)
+			{
+				map.mark(space.address_to_byte((offset & ~addrmirror) - addrstart));
+			}));
+}
+
+static void install_dirty_taps(address_space &space, offs_t addrstart, offs_t addrend, offs_t addrmirror, memory_dirty_map &map)
+{
+	switch (space.data_width())
+	{
+	case 8:     install_dirty_tap<u8>(space, addrstart, addrend, addrmirror, map);     break;
+	case 16:    install_dirty_tap<u16>(space, addrstart, addrend, addrmirror, map);    break;
+	case 32:    install_dirty_tap<u32>(space, addrstart, addrend, addrmirror, map);    break;
+	case 64:    install_dirty_tap<u64>(space, addrstart, addrend, addrmirror, map);    break;
+	}
+}
+
+
+
 //**************************************************************************
 //  MEMORY MANAGER
 //**************************************************************************
@@ -859,6 +1166,20 @@ void memory_manager::initialize()
 	for (auto const memory : memories)
 		memory->locate_memory();
 
+	// drop dispatch tables left redundant by mirrors, and report what remains
+	for (auto const memory : memories)
+	{
+		memory->compact_dispatch();
+		for (int spacenum = 0; spacenum < memory->max_space_count(); spacenum++)
+			if (memory->has_space(spacenum))
+			{
+				u32 tables = 0;
+				size_t bytes = 0;
+				memory->space(spacenum).dispatch_footprint(tables, bytes);
+				osd_printf_verbose("Space %s of '%s': %u dispatch tables, %llu bytes\n", memory->space(spacenum).name(), memory->device().tag(), tables, (unsigned long long)bytes);
+			}
+	}
+
 	// disable logging of unmapped access when no one receives it
 	if (!machine().options().log() && !machine().options().oslog() && !(machine().debug_flags & DEBUG_FLAG_ENABLED))
 		for (auto const memory : memories)
@@ -914,6 +1235,35 @@ memory_region *memory_manager::region_containing(const void *memory, offs_t byte
 	return nullptr;
 }
 
+//-------------------------------------------------
+//  track_share - start tracking writes to a
+//  share through every address map entry that
+//  uses it
+//-------------------------------------------------
+
+memory_dirty_map *memory_manager::track_share(const char *tag, u8 page_bits)
+{
+	auto const found = m_sharelist.find(tag);
+	if (found == m_sharelist.end())
+		return nullptr;
+
+	memory_share &share = *found->second;
+	if (!share.m_dirty)
+	{
+		share.m_dirty = std::make_unique<memory_dirty_map>(share.bytes(), page_bits);
+		for (device_memory_interface &memory : memory_interface_iterator(machine().root_device()))
+			for (int spacenum = 0; spacenum < memory.max_space_count(); spacenum++)
+				if (memory.has_space(spacenum) && memory.space(spacenum).map())
+				{
+					address_space &space = memory.space(spacenum);
+					for (address_map_entry &entry : space.map()->m_entrylist)
+						if ((entry.m_share != nullptr) && (entry.m_write.m_type == AMH_RAM) && (entry.m_devbase.subtag(entry.m_share) == tag))
+							install_dirty_taps(space, entry.m_addrstart, entry.m_addrend, entry.m_addrmirror, *share.m_dirty);
+				}
+	}
+	return share.m_dirty.get();
+}
+
 memory_bank *memory_manager::find(const char *tag) const
 {
 	auto bank = m_banklist.find(tag);
@@ -2570,6 +2920,23 @@ void address_space::remove_change_notifier(int id)
 	fatalerror("Unknown notifier id %d, double remove?\n", id);
 }
 
+int address_space::add_bank_notifier(std::function<void (read_or_write)> n)
+{
+	int id = m_notifier_id++;
+	m_bank_notifiers.emplace_back(notifier_t{ n, id });
+	return id;
+}
+
+void address_space::remove_bank_notifier(int id)
+{
+	for(auto i = m_bank_notifiers.begin(); i != m_bank_notifiers.end(); i++)
+		if(i->m_id == id) {
+			m_bank_notifiers.erase(i);
+			return;
+		}
+	fatalerror("Unknown bank notifier id %d, double remove?\n", id);
+}
+
 
 //**************************************************************************
 //  BANKING HELPERS
@@ -2693,18 +3060,8 @@ memory_block::memory_block(address_space &space, offs_t addrstart, offs_t addren
 	// allocate a block if needed
 	if (m_data == nullptr)
 	{
-		if (length < 4096)
-		{
-			m_allocated.resize(length);
-			memset(&m_allocated[0], 0, length);
-			m_data = &m_allocated[0];
-		}
-		else
-		{
-			m_allocated.resize(length + 0xfff);
-			memset(&m_allocated[0], 0, length + 0xfff);
-			m_data = reinterpret_cast<u8 *>((reinterpret_cast<uintptr_t>(&m_allocated[0]) + 0xfff) & ~0xfff);
-		}
+		m_allocated.allocate(length, machine().options().huge_pages());
+		m_data = m_allocated.data();
 	}
 
 	// register for saving, but only if we're not part of a memory region
@@ -2770,6 +3127,29 @@ memory_bank::~memory_bank()
 }
 
 
+//-------------------------------------------------
+//  track_dirty - start tracking writes through
+//  the bank's window
+//-------------------------------------------------
+
+memory_dirty_map &memory_bank::track_dirty(u8 page_bits)
+{
+	if (!m_dirty && !m_reflist.empty())
+	{
+		address_space &first = m_reflist.front()->space();
+		m_dirty = std::make_unique<memory_dirty_map>(first.address_to_byte_end(m_addrend - m_addrstart) + 1, page_bits);
+		for (auto &ref : m_reflist)
+			if (ref->matches(ref->space(), read_or_write::WRITE))
+				install_dirty_taps(ref->space(), m_addrstart, m_addrend, 0, *m_dirty);
+	}
+	else if (!m_dirty)
+	{
+		m_dirty = std::make_unique<memory_dirty_map>(0, page_bits);
+	}
+	return *m_dirty;
+}
+
+
 //-------------------------------------------------
 //  references_space - walk the list of references
 //  to find a match against the provided space
@@ -2815,6 +3195,10 @@ void memory_bank::set_base(void *base)
 		m_curentry = 0;
 	}
 	m_entries[m_curentry] = reinterpret_cast<u8 *>(base);
+	if (m_dirty)
+		m_dirty->mark_all();
+	for (auto &ref : m_reflist)
+		ref->space().bank_switched(ref->readorwrite());
 	for(auto cb : m_alloc_notifier)
 		cb(base);
 	m_alloc_notifier.clear();
@@ -2844,7 +3228,16 @@ void memory_bank::set_entry(int entrynum)
 	if (m_entries[entrynum] == nullptr)
 		throw emu_fatalerror("memory_bank::set_entry called for bank '%s' with invalid bank entry %d", m_tag.c_str(), entrynum);
 
-	m_curentry = entrynum;
+	if (m_curentry != entrynum)
+	{
+		if (m_dirty)
+			m_dirty->mark_all();
+		m_curentry = entrynum;
+
+		// let anyone holding pointers into the old entry know
+		for (auto &ref : m_reflist)
+			ref->space().bank_switched(ref->readorwrite());
+	}
 }
 
 
@@ -2893,7 +3286,7 @@ void memory_bank::configure_entries(int startentry, int numentries, void *base,
 memory_region::memory_region(running_machine &machine, const char *name, u32 length, u8 width, endianness_t endian)
 	: m_machine(machine),
 		m_name(name),
-		m_buffer(length),
+		m_buffer(length, machine.options().huge_pages()),
 		m_endianness(endian),
 		m_bitwidth(width * 8),
 		m_bytewidth(width)
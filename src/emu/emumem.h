@@ -688,6 +688,13 @@ public:
 
 	// Remove a set of passthrough handlers, leaving the lower handler in their place
 	virtual void detach(const std::unordered_set<handler_entry *> &handlers);
+
+	// Fold sub-dispatch tables that send every slot to the same handler back into their parent
+	virtual void compact_dispatch();
+	virtual bool uniform_dispatch(handler_entry_read<Width, AddrShift, Endian> *&handler, offs_t &start, offs_t &end) const;
+
+	// Count the dispatch tables below this handler and the memory they use
+	virtual void dispatch_footprint(u32 &tables, size_t &bytes) const;
 };
 
 
@@ -749,6 +756,13 @@ public:
 
 	// Remove a set of passthrough handlers, leaving the lower handler in their place
 	virtual void detach(const std::unordered_set<handler_entry *> &handlers);
+
+	// Fold sub-dispatch tables that send every slot to the same handler back into their parent
+	virtual void compact_dispatch();
+	virtual bool uniform_dispatch(handler_entry_write<Width, AddrShift, Endian> *&handler, offs_t &start, offs_t &end) const;
+
+	// Count the dispatch tables below this handler and the memory they use
+	virtual void dispatch_footprint(u32 &tables, size_t &bytes) const;
 };
 
 // =====================-> Passthrough handler management structure
@@ -1080,6 +1094,32 @@ public:
 		return m_cache_r->get_ptr(address);
 	}
 
+	// return a pointer to the memory backing the whole of [start, end], or
+	// nullptr if any of it isn't directly accessible through one handler
+	void *read_ptr(offs_t start, offs_t end) {
+		start &= m_addrmask & ~NATIVE_MASK;
+		end &= m_addrmask & ~NATIVE_MASK;
+		check_address_r(start);
+		if(end < start || end > m_addrend_r)
+			return nullptr;
+		NativeType *base = static_cast<NativeType *>(m_cache_r->get_ptr(start));
+		if(base && static_cast<NativeType *>(m_cache_r->get_ptr(end)) != base + ((end - start) >> (Width + AddrShift)))
+			return nullptr;
+		return base;
+	}
+
+	void *write_ptr(offs_t start, offs_t end) {
+		start &= m_addrmask & ~NATIVE_MASK;
+		end &= m_addrmask & ~NATIVE_MASK;
+		check_address_w(start);
+		if(end < start || end > m_addrend_w)
+			return nullptr;
+		NativeType *base = static_cast<NativeType *>(m_cache_w->get_ptr(start));
+		if(base && static_cast<NativeType *>(m_cache_w->get_ptr(end)) != base + ((end - start) >> (Width + AddrShift)))
+			return nullptr;
+		return base;
+	}
+
 	u8 read_byte(offs_t address) { address &= m_addrmask; return Width == 0 ? read_native(address & ~NATIVE_MASK) : memory_read_generic<Width, AddrShift, Endian, 0, true>([this](offs_t offset, NativeType mask) -> NativeType { return read_native(offset, mask); }, address, 0xff); }
 	u16 read_word(offs_t address) { address &= m_addrmask; return Width == 1 ? read_native(address & ~NATIVE_MASK) : memory_read_generic<Width, AddrShift, Endian, 1, true>([this](offs_t offset, NativeType mask) -> NativeType { return read_native(offset, mask); }, address, 0xffff); }
 	u16 read_word(offs_t address, u16 mask) { address &= m_addrmask; return memory_read_generic<Width, AddrShift, Endian, 1, true>([this](offs_t offset, NativeType mask) -> NativeType { return read_native(offset, mask); }, address, mask); }
@@ -1178,6 +1218,54 @@ public:
 };
 
 
+#ifdef MAME_MEMORY_HEATMAP
+
+// ======================> memory_heatmap
+
+// counts accesses to an address space per leaf handler and per 4K page;
+// only built when MAME_MEMORY_HEATMAP is defined
+class memory_heatmap
+{
+public:
+	static constexpr int PAGE_SHIFT = 12;
+
+	// totals for one handler in one direction
+	struct handler_stats
+	{
+		std::string     name;
+		offs_t          start;
+		offs_t          end;
+		u64             count;
+		osd_ticks_t     ticks;
+		bool            write;
+	};
+
+	// construction/destruction
+	memory_heatmap() : m_enabled(true) { }
+
+	// getters/setters
+	bool enabled() const { return m_enabled; }
+	void set_enabled(bool enabled) { m_enabled = enabled; }
+
+	// record an access that took the given number of host ticks
+	void record(const handler_entry &handler, offs_t start, offs_t end, offs_t byteaddress, bool write, osd_ticks_t ticks);
+	void clear();
+
+	// results, busiest first
+	std::vector<handler_stats> handlers() const;
+	std::vector<std::pair<offs_t, u64>> pages() const;
+	static u64 ticks_to_ns(osd_ticks_t ticks);
+
+private:
+	// internal state
+	bool                                                        m_enabled;      // flag: count accesses
+	std::unordered_map<const handler_entry *, handler_stats>    m_handlers[2];  // per-handler totals for reads and writes
+	std::unordered_map<offs_t, u64>                             m_pages;        // access counts per page
+};
+
+#endif // MAME_MEMORY_HEATMAP
+
+
 // ======================> address_space
 
 // address_space holds live information about an address space
@@ -1222,6 +1310,11 @@ public:
 	int add_change_notifier(std::function<void (read_or_write)> n);
 	void remove_change_notifier(int id);
 
+	// notifiers for code holding direct pointers into banks, called when one switches
+	int add_bank_notifier(std::function<void (read_or_write)> n);
+	void remove_bank_notifier(int id);
+	void bank_switched(read_or_write mode) const { for(const auto &n : m_bank_notifiers) n.m_notifier(mode); }
+
 	void invalidate_caches(read_or_write mode) {
 		if(u32(mode) & ~m_in_notification) {
 			u32 old = m_in_notification;
@@ -1234,6 +1327,10 @@ public:
 
 	virtual void validate_reference_counts() const = 0;
 
+	// fold redundant dispatch tables once the map is built, and report what remains
+	virtual void compact_dispatch() = 0;
+	virtual void dispatch_footprint(u32 &tables, size_t &bytes) const = 0;
+
 	virtual void remove_passthrough(std::unordered_set<handler_entry *> &handlers) = 0;
 
 	int data_width() const { return m_config.data_width(); }
@@ -1291,6 +1388,11 @@ public:
 	virtual void write_qword_unaligned(offs_t address, u64 data) = 0;
 	virtual void write_qword_unaligned(offs_t address, u64 data, u64 mask) = 0;
 
+	// block transfers, counted in native bus units and stored in host order
+	virtual void read_block(offs_t address, offs_t count, void *buffer) = 0;
+	virtual void write_block(offs_t address, offs_t count, const void *buffer) = 0;
+	virtual void copy_block(offs_t dest, offs_t source, offs_t count) = 0;
+
 	// address-to-byte conversion helpers
 	offs_t address_to_byte(offs_t address) const { return m_config.addr2byte(address); }
 	offs_t address_to_byte_end(offs_t address) const { return m_config.addr2byte_end(address); }
@@ -1534,6 +1636,10 @@ public:
 	void allocate_memory();
 	void locate_memory();
 
+#ifdef MAME_MEMORY_HEATMAP
+	memory_heatmap &heatmap() { return m_heatmap; }
+#endif
+
 	template<int Width, int AddrShift, int Endian> handler_entry_read_unmapped <Width, AddrShift, Endian> *get_unmap_r() const { return static_cast<handler_entry_read_unmapped <Width, AddrShift, Endian> *>(m_unmap_r); }
 	template<int Width, int AddrShift, int Endian> handler_entry_write_unmapped<Width, AddrShift, Endian> *get_unmap_w() const { return static_cast<handler_entry_write_unmapped<Width, AddrShift, Endian> *>(m_unmap_w); }
 
@@ -1577,9 +1683,13 @@ protected:
 	std::vector<std::unique_ptr<memory_passthrough_handler>> m_mphs;
 
 	std::vector<notifier_t> m_notifiers;        // notifier list for address map change
+	std::vector<notifier_t> m_bank_notifiers;   // notifier list for bank switches
 	int                     m_notifier_id;      // next notifier id
 	u32                     m_in_notification;  // notification(s) currently being done
 	memory_manager &        m_manager;          // reference to the owning manager
+#ifdef MAME_MEMORY_HEATMAP
+	memory_heatmap          m_heatmap;          // access counts for profiling
+#endif
 };
 
 
@@ -1613,7 +1723,69 @@ private:
 	address_space &         m_space;                // which address space are we associated with?
 	offs_t                  m_addrstart, m_addrend; // start/end for verifying a match
 	u8 *                    m_data;                 // pointer to the data for this block
-	std::vector<u8>         m_allocated;            // pointer to the actually allocated block
+	large_buffer            m_allocated;            // the actually allocated block
+};
+
+
+// ======================> memory_dirty_map
+
+// per-page write stamps for a block of memory; each consumer keeps its own
+// checkpoint, so several can follow changes without clearing each other's view
+class memory_dirty_map
+{
+public:
+	static constexpr u8 DEFAULT_PAGE_BITS = 10;
+
+	// construction/destruction
+	memory_dirty_map(size_t bytes, u8 page_bits = DEFAULT_PAGE_BITS)
+		: m_stamps(((bytes + (size_t(1) << page_bits) - 1) >> page_bits), 0),
+			m_bytes(bytes),
+			m_version(1),
+			m_page_bits(page_bits)
+	{ }
+
+	// getters
+	size_t bytes() const { return m_bytes; }
+	size_t pages() const { return m_stamps.size(); }
+	size_t page_bytes() const { return size_t(1) << m_page_bits; }
+	u8 page_bits() const { return m_page_bits; }
+	u32 version() const { return m_version; }
+
+	// record writes
+	void mark(offs_t byteoffset) { if (byteoffset < m_bytes) m_stamps[byteoffset >> m_page_bits] = m_version; }
+	void mark(offs_t byteoffset, size_t length);
+	void mark_all() { std::fill(m_stamps.begin(), m_stamps.end(), m_version); }
+
+	// start a new version; returns the checkpoint a consumer should pass next time
+	u32 checkpoint() { return ++m_version; }
+
+	// has a page been written since the given checkpoint?  checkpoint 0 means "ever"
+	bool dirty(size_t page, u32 since) const { return m_stamps[page] >= since; }
+
+	// call callback(byteoffset, length) for each run of pages written since the given checkpoint
+	template <typename T> void for_each_dirty(u32 since, T &&callback) const
+	{
+		for (size_t page = 0; page < m_stamps.size(); )
+		{
+			if (m_stamps[page] < since)
+			{
+				page++;
+				continue;
+			}
+			size_t const first = page;
+			while ((page < m_stamps.size()) && (m_stamps[page] >= since))
+				page++;
+			size_t const start = first << m_page_bits;
+			callback(start, std::min(page << m_page_bits, m_bytes) - start);
+		}
+	}
+
+private:
+	// internal state
+	std::vector<u32>        m_stamps;               // version of the last write to each page
+	size_t                  m_bytes;                // size of the tracked memory
+	u32                     m_version;              // stamp applied to pages written now
+	u8                      m_page_bits;            // log2 of the page size
 };
 
 
@@ -1633,6 +1805,7 @@ class memory_bank
 
 		// getters
 		address_space &space() const { return m_space; }
+		read_or_write readorwrite() const { return m_readorwrite; }
 
 		// does this reference match the space+read/write combination?
 		bool matches(const address_space &space, read_or_write readorwrite) const
@@ -1657,9 +1830,11 @@ public:
 	int entry() const { return m_curentry; }
 	bool anonymous() const { return m_anonymous; }
 	offs_t addrstart() const { return m_addrstart; }
+	offs_t addrend() const { return m_addrend; }
 	void *base() const { return m_entries.empty() ? nullptr : m_entries[m_curentry]; }
 	const char *tag() const { return m_tag.c_str(); }
 	const char *name() const { return m_name.c_str(); }
+	memory_dirty_map *dirty_map() const { return m_dirty.get(); }
 
 	// compare a range against our range
 	bool matches_exactly(offs_t addrstart, offs_t addrend) const { return (m_addrstart == addrstart && m_addrend == addrend); }
@@ -1680,9 +1855,13 @@ public:
 	void set_entry(int entrynum);
 	void add_notifier(std::function<void (void *)> cb);
 
+	// track writes through the bank's window; switching entries marks the whole window
+	memory_dirty_map &track_dirty(u8 page_bits = memory_dirty_map::DEFAULT_PAGE_BITS);
+
 private:
 	// internal state
 	running_machine &       m_machine;              // need the machine to free our memory
+	std::unique_ptr<memory_dirty_map> m_dirty;      // write tracking, if requested
 	std::vector<u8 *>       m_entries;              // the entries
 	bool                    m_anonymous;            // are we anonymous or explicit?
 	offs_t                  m_addrstart;            // start offset
@@ -1700,6 +1879,8 @@ private:
 // a memory share contains information about shared memory region
 class memory_share
 {
+	friend class memory_manager;
+
 public:
 	// construction/destruction
 	memory_share(u8 width, size_t bytes, endianness_t endianness, void *ptr = nullptr)
@@ -1716,12 +1897,14 @@ public:
 	endianness_t endianness() const { return m_endianness; }
 	u8 bitwidth() const { return m_bitwidth; }
 	u8 bytewidth() const { return m_bytewidth; }
+	memory_dirty_map *dirty_map() const { return m_dirty.get(); }
 
 	// setters
 	void set_ptr(void *ptr) { m_ptr = ptr; }
 
 private:
 	// internal state
+	std::unique_ptr<memory_dirty_map> m_dirty;      // write tracking, if requested
 	void *                  m_ptr;                  // pointer to the memory backing the region
 	size_t                  m_bytes;                // size of the shared region in bytes
 	endianness_t            m_endianness;           // endianness of the memory
@@ -1745,7 +1928,7 @@ public:
 
 	// getters
 	running_machine &machine() const { return m_machine; }
-	u8 *base() { return (m_buffer.size() > 0) ? &m_buffer[0] : nullptr; }
+	u8 *base() { return m_buffer.data(); }
 	u8 *end() { return base() + m_buffer.size(); }
 	u32 bytes() const { return m_buffer.size(); }
 	const char *name() const { return m_name.c_str(); }
@@ -1756,7 +1939,7 @@ public:
 	u8 bytewidth() const { return m_bytewidth; }
 
 	// data access
-	u8 &as_u8(offs_t offset = 0) { return m_buffer[offset]; }
+	u8 &as_u8(offs_t offset = 0) { return base()[offset]; }
 	u16 &as_u16(offs_t offset = 0) { return reinterpret_cast<u16 *>(base())[offset]; }
 	u32 &as_u32(offs_t offset = 0) { return reinterpret_cast<u32 *>(base())[offset]; }
 	u64 &as_u64(offs_t offset = 0) { return reinterpret_cast<u64 *>(base())[offset]; }
@@ -1765,7 +1948,7 @@ private:
 	// internal data
 	running_machine &       m_machine;
 	std::string             m_name;
-	std::vector<u8>         m_buffer;
+	large_buffer            m_buffer;
 	endianness_t            m_endianness;
 	u8                      m_bitwidth;
 	u8                      m_bytewidth;
@@ -1801,6 +1984,9 @@ public:
 	memory_bank *find(address_space &space, offs_t addrstart, offs_t addrend) const;
 	memory_bank *allocate(address_space &space, offs_t addrstart, offs_t addrend, const char *tag = nullptr);
 
+	// write tracking for shares, installed over every address map entry using them
+	memory_dirty_map *track_share(const char *tag, u8 page_bits = memory_dirty_map::DEFAULT_PAGE_BITS);
+
 private:
 	void allocate(device_memory_interface &memory);
 
@@ -1917,12 +2103,32 @@ private:
 template<int Width, int AddrShift, int Endian> typename emu::detail::handler_entry_size<Width>::uX memory_access_cache<Width, AddrShift, Endian>::read_native(offs_t address, typename emu::detail::handler_entry_size<Width>::uX mask)
 {
 	check_address_r(address);
+#ifdef MAME_MEMORY_HEATMAP
+	memory_heatmap &heatmap = m_space.heatmap();
+	if (heatmap.enabled())
+	{
+		osd_ticks_t const start = osd_ticks();
+		typename emu::detail::handler_entry_size<Width>::uX const result = m_cache_r->read(address, mask);
+		heatmap.record(*m_cache_r, m_addrstart_r, m_addrend_r, m_space.address_to_byte(address), false, osd_ticks() - start);
+		return result;
+	}
+#endif
 	return m_cache_r->read(address, mask);
 }
 
 template<int Width, int AddrShift, int Endian> void memory_access_cache<Width, AddrShift, Endian>::write_native(offs_t address, typename emu::detail::handler_entry_size<Width>::uX data, typename emu::detail::handler_entry_size<Width>::uX mask)
 {
 	check_address_w(address);
+#ifdef MAME_MEMORY_HEATMAP
+	memory_heatmap &heatmap = m_space.heatmap();
+	if (heatmap.enabled())
+	{
+		osd_ticks_t const start = osd_ticks();
+		m_cache_w->write(address, data, mask);
+		heatmap.record(*m_cache_w, m_addrstart_w, m_addrend_w, m_space.address_to_byte(address), true, osd_ticks() - start);
+		return;
+	}
+#endif
 	m_cache_w->write(address, data, mask);
 }
 
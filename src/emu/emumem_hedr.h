@@ -30,6 +30,9 @@ public:
 	void populate_passthrough_nomirror(offs_t start, offs_t end, offs_t ostart, offs_t oend, handler_entry_read_passthrough<Width, AddrShift, Endian> *handler, std::vector<mapping> &mappings) override;
 	void populate_passthrough_mirror(offs_t start, offs_t end, offs_t ostart, offs_t oend, offs_t mirror, handler_entry_read_passthrough<Width, AddrShift, Endian> *handler, std::vector<mapping> &mappings) override;
 	void detach(const std::unordered_set<handler_entry *> &handlers) override;
+	void compact_dispatch() override;
+	bool uniform_dispatch(handler_entry_read<Width, AddrShift, Endian> *&handler, offs_t &start, offs_t &end) const override;
+	void dispatch_footprint(u32 &tables, size_t &bytes) const override;
 	void range_cut_before(offs_t address, int start = COUNT);
 	void range_cut_after(offs_t address, int start = -1);
 
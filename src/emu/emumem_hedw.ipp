@@ -482,3 +482,51 @@ template<int HighBits, int Width, int AddrShift, int Endian> void handler_entry_
 			np->detach(handlers);
 	}
 }
+
+template<int HighBits, int Width, int AddrShift, int Endian> void handler_entry_write_dispatch<HighBits, Width, AddrShift, Endian>::compact_dispatch()
+{
+	for(unsigned int i=0; i != COUNT; i++) {
+		if(!m_dispatch[i]->is_dispatch())
+			continue;
+
+		// Compact bottom-up, so that a table whose subtables all fold away can fold in turn
+		m_dispatch[i]->compact_dispatch();
+
+		handler_entry_write<Width, AddrShift, Endian> *handler;
+		offs_t start, end;
+		if(m_dispatch[i]->uniform_dispatch(handler, start, end)) {
+			handler->ref();
+			m_dispatch[i]->unref();
+			m_dispatch[i] = handler;
+			m_ranges[i].set(start, end);
+		}
+	}
+}
+
+template<int HighBits, int Width, int AddrShift, int Endian> bool handler_entry_write_dispatch<HighBits, Width, AddrShift, Endian>::uniform_dispatch(handler_entry_write<Width, AddrShift, Endian> *&handler, offs_t &start, offs_t &end) const
+{
+	// Every slot must reach the same leaf; the mirror instances' ranges then merge into one
+	if(m_dispatch[0]->is_dispatch())
+		return false;
+	start = m_ranges[0].start;
+	end = m_ranges[0].end;
+	for(unsigned int i=1; i != COUNT; i++) {
+		if(m_dispatch[i] != m_dispatch[0])
+			return false;
+		if(m_ranges[i].start < start)
+			start = m_ranges[i].start;
+		if(m_ranges[i].end > end)
+			end = m_ranges[i].end;
+	}
+	handler = m_dispatch[0];
+	return true;
+}
+
+template<int HighBits, int Width, int AddrShift, int Endian> void handler_entry_write_dispatch<HighBits, Width, AddrShift, Endian>::dispatch_footprint(u32 &tables, size_t &bytes) const
+{
+	tables++;
+	bytes += sizeof(*this);
+	for(unsigned int i=0; i != COUNT; i++)
+		if(m_dispatch[i]->is_dispatch())
+			m_dispatch[i]->dispatch_footprint(tables, bytes);
+}
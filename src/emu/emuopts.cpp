@@ -65,14 +65,20 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_AUTOSAVE,                                   "0",         OPTION_BOOLEAN,    "automatically restore state on start and save on exit for supported systems" },
 	{ OPTION_REWIND,                                     "0",         OPTION_BOOLEAN,    "enable rewind savestates" },
 	{ OPTION_REWIND_CAPACITY "(1-2048)",                 "100",       OPTION_INTEGER,    "rewind buffer size in megabytes" },
+	{ OPTION_REWIND_KEYFRAME_INTERVAL "(1-1000)",        "30",        OPTION_INTEGER,    "number of rewind states per full keyframe; others store changed pages only" },
+	{ OPTION_REWIND_COMPRESSION,                         "1",         OPTION_BOOLEAN,    "compress rewind states in the background to fit more of them" },
+	{ OPTION_RUNAHEAD "(0-8)",                           "0",         OPTION_INTEGER,    "number of frames to emulate ahead of the displayed one to hide input latency" },
 	{ OPTION_PLAYBACK ";pb",                             nullptr,     OPTION_STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,     OPTION_STRING,     "record an input file" },
 	{ OPTION_RECORD_TIMECODE,                            "0",         OPTION_BOOLEAN,    "record an input timecode file (requires -record option)" },
 	{ OPTION_EXIT_AFTER_PLAYBACK,                        "0",         OPTION_BOOLEAN,    "close the program at the end of playback" },
+	{ OPTION_PLAYBACK_START,                             "0",         OPTION_FLOAT,      "start playback from the last keyframe at or before this many seconds of emulated time" },
+	{ OPTION_RECORD_KEYFRAME,                            "60",        OPTION_INTEGER,    "seconds of emulated time between save states embedded in recordings (0 = none)" },
 
 	{ OPTION_MNGWRITE,                                   nullptr,     OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   nullptr,     OPTION_STRING,     "optional filename to write an AVI movie of the current session" },
 	{ OPTION_WAVWRITE,                                   nullptr,     OPTION_STRING,     "optional filename to write a WAV file of the current session" },
+	{ OPTION_MOVIE_QUEUE,                                "4",         OPTION_INTEGER,    "number of MNG/AVI frames or snapshots that may wait to be encoded and written on a worker thread (0 writes them on the emulation thread)" },
 	{ OPTION_SNAPNAME,                                   "%g/%i",     OPTION_STRING,     "override of the default snapshot/movie naming; %g == gamename, %i == index" },
 	{ OPTION_SNAPSIZE,                                   "auto",      OPTION_STRING,     "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
 	{ OPTION_SNAPVIEW,                                   "internal",  OPTION_STRING,     "specify snapshot/movie view or 'internal' to use internal pixel-aspect views" },
@@ -85,11 +91,19 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_AUTOFRAMESKIP ";afs",                       "0",         OPTION_BOOLEAN,    "enable automatic frameskip adjustment to maintain emulation speed" },
 	{ OPTION_FRAMESKIP ";fs(0-10)",                      "0",         OPTION_INTEGER,    "set frameskip to fixed value, 0-10 (autoframeskip must be disabled)" },
 	{ OPTION_SECONDS_TO_RUN ";str",                      "0",         OPTION_INTEGER,    "number of emulated seconds to run before automatically exiting" },
+	{ OPTION_BENCH_REPORT,                               nullptr,     OPTION_STRING,     "write a JSON report of host time spent per subsystem to this file on exit" },
+	{ OPTION_PROFILE_FLAMEGRAPH,                         nullptr,     OPTION_STRING,     "profile the whole run and write the sampled stacks to this file in flame graph format on exit" },
 	{ OPTION_THROTTLE,                                   "1",         OPTION_BOOLEAN,    "throttle emulation to keep system running in sync with real time" },
 	{ OPTION_SYNCREFRESH ";srf",                         "0",         OPTION_BOOLEAN,    "enable using the start of VBLANK for throttling instead of the game time" },
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
+	{ OPTION_FRAME_PACING,                               "0",         OPTION_BOOLEAN,    "start each frame as late as its measured cost allows, to cut input-to-present latency" },
+	{ OPTION_VRR,                                        "0",         OPTION_BOOLEAN,    "the display has a variable refresh rate: throttle to the game's refresh instead of syncing to the host's (ignores -syncrefresh)" },
+	{ OPTION_ASYNC_START,                                "0",         OPTION_BOOLEAN,    "run startup work that devices can defer, such as predecoding graphics, on worker threads" },
+	{ OPTION_STARTUP_REPORT,                             "0",         OPTION_BOOLEAN,    "print where the time went while starting the machine" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjust emulation speed to keep the emulated refresh rate slower than the host screen" },
+	{ OPTION_HUGE_PAGES,                                 "0",         OPTION_BOOLEAN,    "back large emulated memory blocks and tables with huge pages where the OS allows it" },
+	{ OPTION_RENDER_BANDS,                               "1",         OPTION_INTEGER,    "split full-frame screen updates, tilemap draws, software rendering and artwork resampling into this many horizontal bands rendered on worker threads" },
 
 	// render options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE RENDER OPTIONS" },
@@ -143,7 +157,10 @@ const options_entry emu_options::s_option_entries[] =
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE SOUND OPTIONS" },
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
+	{ OPTION_SAMPLE_CACHE,                               "64",        OPTION_INTEGER,    "megabytes of decoded samples to keep; the least recently played are freed beyond this (0 = no limit)" },
+	{ OPTION_SAMPLE_STREAM,                              "0",         OPTION_INTEGER,    "decode samples longer than this many seconds in chunks on an I/O thread while they play (0 = never)" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_RESAMPLER,                                  "linear",    OPTION_STRING,     "sample rate converter between sound streams (linear or sinc)" },
 
 	// input options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -183,6 +200,12 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DEBUG ";d",                                 "0",         OPTION_BOOLEAN,    "enable/disable debugger" },
 	{ OPTION_UPDATEINPAUSE,                              "0",         OPTION_BOOLEAN,    "keep calling video updates while in pause" },
 	{ OPTION_DEBUGSCRIPT,                                nullptr,     OPTION_STRING,     "script for debugger" },
+	{ OPTION_MEMTRACE,                                   nullptr,     OPTION_STRING,     "file to record traced memory accesses to" },
+	{ OPTION_MEMTRACE_RANGES,                            nullptr,     OPTION_STRING,     "comma-separated memory ranges to trace, as device:space:start-end[:rw]" },
+	{ OPTION_MEMTRACE_BUFFER,                            "65536",     OPTION_INTEGER,    "number of accesses buffered while tracing memory" },
+	{ OPTION_PROFILE_INSNS,                              nullptr,     OPTION_STRING,     "file to write a per-CPU executed instruction profile to on exit" },
+	{ OPTION_PROFILE_INSNS_TOP,                          "40",        OPTION_INTEGER,    "number of rows in each table of the instruction profile" },
+	{ OPTION_PROFILE_RASTERIZERS,                        nullptr,     OPTION_STRING,     "file to write the 3dfx Voodoo modes that needed the generic rasterizer to on exit" },
 
 	// comm options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE COMM OPTIONS" },
@@ -198,6 +221,14 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC to use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_OPTIMIZE,                               "all",       OPTION_STRING,     "comma-separated DRC UML optimizations to apply (all, none, constprop, copyprop, loadelim, deadstore)" },
+	{ OPTION_DRC_ASYNC,                                  "0",         OPTION_BOOLEAN,    "compile DRC blocks on a worker thread where the CPU core supports it" },
+	{ OPTION_DRC_PERF_MAP,                               "0",         OPTION_BOOLEAN,    "write symbols for DRC code to /tmp/perf-<pid>.map for Linux perf" },
+	{ OPTION_DRC_PROFILE,                                "0",         OPTION_BOOLEAN,    "count executions of each DRC block (see the drcprofile debugger command)" },
+	{ OPTION_DRC_TRACE_THRESHOLD,                        "0",         OPTION_INTEGER,    "times a DRC block exit must be taken before recompiling its target as a trace (0 = never)" },
+	{ OPTION_DRC_VALIDATE,                               "0",         OPTION_BOOLEAN,    "run DRC code one instruction at a time and check it against the interpreter, where the CPU core supports it" },
+	{ OPTION_X87,                                        "auto",      OPTION_STRING,     "x87 arithmetic: auto (driver default), soft, host or validate" },
+	{ OPTION_IDLE_DETECT,                                "0",         OPTION_BOOLEAN,    "skip ahead when a CPU is found spinning in an idle loop" },
 	{ OPTION_BIOS,                                       nullptr,     OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the system information screen at startup" },
@@ -208,11 +239,18 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UI_MOUSE,                                   "1",         OPTION_BOOLEAN,    "display UI mouse cursor" },
 	{ OPTION_LANGUAGE ";lang",                           "English",   OPTION_STRING,     "set UI display language" },
 	{ OPTION_NVRAM_SAVE ";nvwrite",                      "1",         OPTION_BOOLEAN,    "save NVRAM data on exit" },
+	{ OPTION_HD_WRITE_CACHE,                             "16",        OPTION_INTEGER,    "megabytes of hard disk writes to hold before writing them to the CHD (0 = write straight through, safest if MAME crashes)" },
+	{ OPTION_ROMHASH_CACHE,                              "romhash.cache", OPTION_STRING, "file in cfg_directory caching hashes of archived ROMs (empty to disable)" },
+	{ OPTION_ROMHASH_REFRESH,                            "0",         OPTION_BOOLEAN,    "ignore cached ROM hashes and recompute them" },
+	{ OPTION_SOFTLIST_CACHE,                             "softlist",  OPTION_STRING,     "directory in cfg_directory caching parsed software lists (empty to disable)" },
 
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "SCRIPTING OPTIONS" },
 	{ OPTION_AUTOBOOT_COMMAND ";ab",                     nullptr,     OPTION_STRING,     "command to execute after machine boot" },
 	{ OPTION_AUTOBOOT_DELAY,                             "0",         OPTION_INTEGER,    "delay before executing autoboot command (seconds)" },
 	{ OPTION_AUTOBOOT_SCRIPT ";script",                  nullptr,     OPTION_STRING,     "Lua script to execute after machine boot" },
+	{ OPTION_FORK "(0-256)",                             "0",         OPTION_INTEGER,    "split into this many independent instances once the machine has started (0 to disable)" },
+	{ OPTION_FORK_DELAY,                                 "0",         OPTION_INTEGER,    "emulated time to run before splitting into instances (seconds)" },
+	{ OPTION_FORK_SCRIPT,                                nullptr,     OPTION_STRING,     "Lua script each instance executes after the split" },
 	{ OPTION_CONSOLE,                                    "0",         OPTION_BOOLEAN,    "enable emulator Lua console" },
 	{ OPTION_PLUGINS,                                    "1",         OPTION_BOOLEAN,    "enable Lua plugin support" },
 	{ OPTION_PLUGIN,                                     nullptr,     OPTION_STRING,     "list of plugins to enable" },
@@ -222,6 +260,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_HTTP,                                       "0",         OPTION_BOOLEAN,    "enable HTTP server" },
 	{ OPTION_HTTP_PORT,                                  "8080",      OPTION_INTEGER,    "HTTP server port" },
 	{ OPTION_HTTP_ROOT,                                  "web",       OPTION_STRING,     "HTTP server document root" },
+	{ OPTION_HTTP_TELEMETRY,                             "0",         OPTION_INTEGER,    "push telemetry to websocket clients of /api/telemetry every N frames (0 = off)" },
 
 	{ nullptr }
 };
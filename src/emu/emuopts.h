@@ -54,13 +54,19 @@
 #define OPTION_AUTOSAVE             "autosave"
 #define OPTION_REWIND               "rewind"
 #define OPTION_REWIND_CAPACITY      "rewind_capacity"
+#define OPTION_REWIND_KEYFRAME_INTERVAL "rewind_keyframe_interval"
+#define OPTION_REWIND_COMPRESSION   "rewind_compression"
+#define OPTION_RUNAHEAD             "runahead"
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_RECORD_TIMECODE      "record_timecode"
 #define OPTION_EXIT_AFTER_PLAYBACK  "exit_after_playback"
+#define OPTION_PLAYBACK_START       "playback_start"
+#define OPTION_RECORD_KEYFRAME      "record_keyframe"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
 #define OPTION_WAVWRITE             "wavwrite"
+#define OPTION_MOVIE_QUEUE          "movie_queue"
 #define OPTION_SNAPNAME             "snapname"
 #define OPTION_SNAPSIZE             "snapsize"
 #define OPTION_SNAPVIEW             "snapview"
@@ -72,11 +78,19 @@
 #define OPTION_AUTOFRAMESKIP        "autoframeskip"
 #define OPTION_FRAMESKIP            "frameskip"
 #define OPTION_SECONDS_TO_RUN       "seconds_to_run"
+#define OPTION_BENCH_REPORT         "bench_report"
+#define OPTION_PROFILE_FLAMEGRAPH   "profile_flamegraph"
 #define OPTION_THROTTLE             "throttle"
 #define OPTION_SYNCREFRESH          "syncrefresh"
 #define OPTION_SLEEP                "sleep"
+#define OPTION_FRAME_PACING         "frame_pacing"
+#define OPTION_VRR                  "vrr"
+#define OPTION_ASYNC_START          "async_start"
+#define OPTION_STARTUP_REPORT       "startup_report"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_HUGE_PAGES           "huge_pages"
+#define OPTION_RENDER_BANDS         "render_bands"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -124,7 +138,10 @@
 // core sound options
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
+#define OPTION_SAMPLE_CACHE         "sample_cache"
+#define OPTION_SAMPLE_STREAM        "sample_stream"
 #define OPTION_VOLUME               "volume"
+#define OPTION_RESAMPLER            "resampler"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -161,12 +178,26 @@
 #define OPTION_OSLOG                "oslog"
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
 #define OPTION_DEBUGSCRIPT          "debugscript"
+#define OPTION_MEMTRACE             "memtrace"
+#define OPTION_MEMTRACE_RANGES      "memtrace_ranges"
+#define OPTION_MEMTRACE_BUFFER      "memtrace_buffer"
+#define OPTION_PROFILE_INSNS        "profile_insns"
+#define OPTION_PROFILE_INSNS_TOP    "profile_insns_top"
+#define OPTION_PROFILE_RASTERIZERS  "profile_rasterizers"
 
 // core misc options
 #define OPTION_DRC                  "drc"
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_OPTIMIZE         "drc_optimize"
+#define OPTION_DRC_ASYNC            "drc_async"
+#define OPTION_DRC_PERF_MAP         "drc_perf_map"
+#define OPTION_DRC_PROFILE          "drc_profile"
+#define OPTION_DRC_TRACE_THRESHOLD  "drc_trace_threshold"
+#define OPTION_DRC_VALIDATE         "drc_validate"
+#define OPTION_X87                  "x87"
+#define OPTION_IDLE_DETECT          "idle_detect"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -174,6 +205,10 @@
 #define OPTION_UI                   "ui"
 #define OPTION_RAMSIZE              "ramsize"
 #define OPTION_NVRAM_SAVE           "nvram_save"
+#define OPTION_HD_WRITE_CACHE       "hd_write_cache"
+#define OPTION_ROMHASH_CACHE        "romhash_cache"
+#define OPTION_ROMHASH_REFRESH      "romhash_refresh"
+#define OPTION_SOFTLIST_CACHE       "softlist_cache"
 
 // core comm options
 #define OPTION_COMM_LOCAL_HOST      "comm_localhost"
@@ -188,6 +223,9 @@
 #define OPTION_AUTOBOOT_COMMAND     "autoboot_command"
 #define OPTION_AUTOBOOT_DELAY       "autoboot_delay"
 #define OPTION_AUTOBOOT_SCRIPT      "autoboot_script"
+#define OPTION_FORK                 "fork"
+#define OPTION_FORK_DELAY           "fork_delay"
+#define OPTION_FORK_SCRIPT          "fork_script"
 
 #define OPTION_CONSOLE              "console"
 #define OPTION_PLUGINS              "plugins"
@@ -199,6 +237,7 @@
 #define OPTION_HTTP                 "http"
 #define OPTION_HTTP_PORT            "http_port"
 #define OPTION_HTTP_ROOT            "http_root"
+#define OPTION_HTTP_TELEMETRY       "http_telemetry"
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -339,13 +378,19 @@ public:
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
 	int rewind() const { return bool_value(OPTION_REWIND); }
 	int rewind_capacity() const { return int_value(OPTION_REWIND_CAPACITY); }
+	int rewind_keyframe_interval() const { return int_value(OPTION_REWIND_KEYFRAME_INTERVAL); }
+	bool rewind_compression() const { return bool_value(OPTION_REWIND_COMPRESSION); }
+	int runahead() const { return int_value(OPTION_RUNAHEAD); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	bool record_timecode() const { return bool_value(OPTION_RECORD_TIMECODE); }
 	bool exit_after_playback() const { return bool_value(OPTION_EXIT_AFTER_PLAYBACK); }
+	float playback_start() const { return float_value(OPTION_PLAYBACK_START); }
+	int record_keyframe() const { return int_value(OPTION_RECORD_KEYFRAME); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
 	const char *wav_write() const { return value(OPTION_WAVWRITE); }
+	int movie_queue() const { return int_value(OPTION_MOVIE_QUEUE); }
 	const char *snap_name() const { return value(OPTION_SNAPNAME); }
 	const char *snap_size() const { return value(OPTION_SNAPSIZE); }
 	const char *snap_view() const { return value(OPTION_SNAPVIEW); }
@@ -357,11 +402,19 @@ public:
 	bool auto_frameskip() const { return bool_value(OPTION_AUTOFRAMESKIP); }
 	int frameskip() const { return int_value(OPTION_FRAMESKIP); }
 	int seconds_to_run() const { return int_value(OPTION_SECONDS_TO_RUN); }
+	const char *bench_report() const { return value(OPTION_BENCH_REPORT); }
+	const char *profile_flamegraph() const { return value(OPTION_PROFILE_FLAMEGRAPH); }
 	bool throttle() const { return bool_value(OPTION_THROTTLE); }
 	bool sync_refresh() const { return bool_value(OPTION_SYNCREFRESH); }
 	bool sleep() const { return m_sleep; }
+	bool frame_pacing() const { return bool_value(OPTION_FRAME_PACING); }
+	bool vrr() const { return bool_value(OPTION_VRR); }
+	bool async_start() const { return bool_value(OPTION_ASYNC_START); }
+	bool startup_report() const { return bool_value(OPTION_STARTUP_REPORT); }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
+	bool huge_pages() const { return bool_value(OPTION_HUGE_PAGES); }
+	int render_bands() const { return int_value(OPTION_RENDER_BANDS); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -409,7 +462,10 @@ public:
 	// core sound options
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
+	int sample_cache() const { return int_value(OPTION_SAMPLE_CACHE); }
+	int sample_stream() const { return int_value(OPTION_SAMPLE_STREAM); }
 	int volume() const { return int_value(OPTION_VOLUME); }
+	const char *resampler() const { return value(OPTION_RESAMPLER); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -444,12 +500,26 @@ public:
 	bool oslog() const { return bool_value(OPTION_OSLOG); }
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
+	const char *memtrace() const { return value(OPTION_MEMTRACE); }
+	const char *memtrace_ranges() const { return value(OPTION_MEMTRACE_RANGES); }
+	int memtrace_buffer() const { return int_value(OPTION_MEMTRACE_BUFFER); }
+	const char *profile_insns() const { return value(OPTION_PROFILE_INSNS); }
+	int profile_insns_top() const { return int_value(OPTION_PROFILE_INSNS_TOP); }
+	const char *profile_rasterizers() const { return value(OPTION_PROFILE_RASTERIZERS); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	const char *drc_optimize() const { return value(OPTION_DRC_OPTIMIZE); }
+	bool drc_async() const { return bool_value(OPTION_DRC_ASYNC); }
+	bool drc_perf_map() const { return bool_value(OPTION_DRC_PERF_MAP); }
+	bool drc_profile() const { return bool_value(OPTION_DRC_PROFILE); }
+	int drc_trace_threshold() const { return int_value(OPTION_DRC_TRACE_THRESHOLD); }
+	bool drc_validate() const { return bool_value(OPTION_DRC_VALIDATE); }
+	const char *x87() const { return value(OPTION_X87); }
+	bool idle_detect() const { return bool_value(OPTION_IDLE_DETECT); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
@@ -457,6 +527,10 @@ public:
 	ui_option ui() const { return m_ui; }
 	const char *ram_size() const { return value(OPTION_RAMSIZE); }
 	bool nvram_save() const { return bool_value(OPTION_NVRAM_SAVE); }
+	int hd_write_cache() const { return int_value(OPTION_HD_WRITE_CACHE); }
+	const char *romhash_cache() const { return value(OPTION_ROMHASH_CACHE); }
+	bool romhash_refresh() const { return bool_value(OPTION_ROMHASH_REFRESH); }
+	const char *softlist_cache() const { return value(OPTION_SOFTLIST_CACHE); }
 
 	// core comm options
 	const char *comm_localhost() const { return value(OPTION_COMM_LOCAL_HOST); }
@@ -472,6 +546,9 @@ public:
 	const char *autoboot_command() const { return value(OPTION_AUTOBOOT_COMMAND); }
 	int autoboot_delay() const { return int_value(OPTION_AUTOBOOT_DELAY); }
 	const char *autoboot_script() const { return value(OPTION_AUTOBOOT_SCRIPT); }
+	int fork() const { return int_value(OPTION_FORK); }
+	int fork_delay() const { return int_value(OPTION_FORK_DELAY); }
+	const char *fork_script() const { return value(OPTION_FORK_SCRIPT); }
 
 	bool console() const { return bool_value(OPTION_CONSOLE); }
 
@@ -486,6 +563,7 @@ public:
 	bool  http() const { return bool_value(OPTION_HTTP); }
 	short http_port() const { return int_value(OPTION_HTTP_PORT); }
 	const char *http_root() const { return value(OPTION_HTTP_ROOT); }
+	int http_telemetry() const { return int_value(OPTION_HTTP_TELEMETRY); }
 
 	// slots and devices - the values for these are stored outside of the core_options
 	// structure
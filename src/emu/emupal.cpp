@@ -58,12 +58,47 @@ inline void palette_device::update_for_write(offs_t byte_offset, int bytes_modif
 
 	// for each entry modified, fetch the palette data and set the pen color or indirect color
 	offs_t base = byte_offset / bpe;
-	for (int index = 0; index < count; index++)
+	if (count == 1)
 	{
 		if (indirect)
-			set_indirect_color(base + index, m_raw_to_rgb(read_entry(base + index)));
+			set_indirect_color(base, m_raw_to_rgb(read_entry(base)));
 		else
-			set_pen_color(base + index, m_raw_to_rgb(read_entry(base + index)));
+			set_pen_color(base, m_raw_to_rgb(read_entry(base)));
+	}
+	else
+	{
+		update_entries(base, count);
+	}
+}
+
+
+//-------------------------------------------------
+//  update_entries - reconvert a range of palette
+//  RAM entries in one go, for drivers that
+//  rewrite large parts of the palette directly
+//-------------------------------------------------
+
+void palette_device::update_entries(pen_t first, u32 count)
+{
+	// indirect colors have no bulk path
+	if (m_indirect_entries != 0)
+	{
+		for (pen_t index = first; index < first + count; index++)
+			set_indirect_color(index, m_raw_to_rgb(read_entry(index)));
+		return;
+	}
+
+	// convert in chunks and hand each chunk over at once, so the adjusted
+	// colors and client dirty lists are updated once per span
+	rgb_t colors[256];
+	while (count != 0)
+	{
+		u32 const chunk = std::min<u32>(count, ARRAY_LENGTH(colors));
+		for (u32 index = 0; index < chunk; index++)
+			colors[index] = m_raw_to_rgb(read_entry(first + index));
+		set_pen_colors(first, colors, chunk);
+		first += chunk;
+		count -= chunk;
 	}
 }
 
@@ -431,6 +431,9 @@ public:
 	// helper to update palette when data changed
 	void update() { if (!m_init.isnull()) m_init(*this); }
 
+	// reconvert a range of entries after palette RAM was modified directly
+	void update_entries(pen_t first, u32 count);
+
 protected:
 	// device-level overrides
 	virtual void device_start() override;
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "unzip.h"
 #include "fileio.h"
 
@@ -156,6 +157,189 @@ const osd::directory::entry *file_enumerator::next()
 
 
 
+//**************************************************************************
+//  HASH CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  hash_cache - constructor
+//-------------------------------------------------
+
+hash_cache::hash_cache(emu_options &options)
+	: m_searchpath(options.cfg_directory())
+	, m_filename(options.romhash_cache())
+	, m_dirty(false)
+{
+	// a refresh starts from nothing and rewrites the file
+	if (options.romhash_refresh())
+		m_dirty = !m_filename.empty();
+	else
+		load();
+}
+
+
+//-------------------------------------------------
+//  matches - return true if the cache uses the
+//  file the given options ask for
+//-------------------------------------------------
+
+bool hash_cache::matches(emu_options &options) const
+{
+	return (m_searchpath == options.cfg_directory()) && (m_filename == options.romhash_cache());
+}
+
+
+//-------------------------------------------------
+//  find - look up cached hashes for an archive
+//  member; succeeds only if the archive is
+//  unchanged and all requested types are present
+//-------------------------------------------------
+
+bool hash_cache::find(const std::string &archive, const std::string &member, u32 crc, const char *types, util::hash_collection &hashes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_filename.empty())
+		return false;
+
+	archive_entry &entry(current_entry(archive));
+	auto const found = entry.members.find(member);
+	if (found == entry.members.end())
+		return false;
+
+	// the CRC from the archive directory must agree with what we stored
+	util::hash_collection cached;
+	u32 cachedcrc;
+	if (!cached.from_internal_string(found->second.c_str()) || !cached.crc(cachedcrc) || (cachedcrc != crc))
+		return false;
+
+	// make sure we have everything the caller wants
+	std::string const have = cached.hash_types();
+	for (const char *scan = types; *scan != 0; scan++)
+		if (have.find_first_of(*scan) == std::string::npos)
+			return false;
+
+	hashes = cached;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  add - remember the hashes for an archive
+//  member
+//-------------------------------------------------
+
+void hash_cache::add(const std::string &archive, const std::string &member, const util::hash_collection &hashes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_filename.empty())
+		return;
+
+	// names with separators can't be represented in the file
+	if ((archive.find_first_of("\t\r\n") != std::string::npos) || (member.find_first_of("\t\r\n") != std::string::npos))
+		return;
+
+	archive_entry &entry(current_entry(archive));
+	std::string value(hashes.internal_string());
+	std::string &stored(entry.members[member]);
+	if (stored != value)
+	{
+		stored = std::move(value);
+		m_dirty = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  save - write the cache back if it changed
+//-------------------------------------------------
+
+void hash_cache::save()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_dirty || m_filename.empty())
+		return;
+
+	emu_file file(std::string(m_searchpath), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(m_filename) != osd_file::error::NONE)
+		return;
+
+	for (auto const &archive : m_archives)
+		for (auto const &member : archive.second.members)
+			file.printf("%s\t%u\t%d\t%s\t%s\n", archive.first, archive.second.size, archive.second.modified, member.first, member.second);
+	m_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  load - read the cache file
+//-------------------------------------------------
+
+void hash_cache::load()
+{
+	if (m_filename.empty())
+		return;
+
+	emu_file file(std::string(m_searchpath), OPEN_FLAG_READ);
+	if (file.open(m_filename) != osd_file::error::NONE)
+		return;
+
+	char buffer[4096];
+	while (file.gets(buffer, ARRAY_LENGTH(buffer)))
+	{
+		// split into archive, size, modification time, member and hashes
+		std::string line(buffer);
+		while (!line.empty() && ((line.back() == '\n') || (line.back() == '\r')))
+			line.pop_back();
+		std::vector<std::string> fields;
+		std::string::size_type start = 0;
+		for (std::string::size_type tab; (tab = line.find('\t', start)) != std::string::npos; start = tab + 1)
+			fields.emplace_back(line.substr(start, tab - start));
+		fields.emplace_back(line.substr(start));
+		if (fields.size() != 5)
+			continue;
+
+		archive_entry &entry(m_archives[fields[0]]);
+		entry.size = std::strtoull(fields[1].c_str(), nullptr, 10);
+		entry.modified = std::strtoll(fields[2].c_str(), nullptr, 10);
+		entry.members[fields[3]] = std::move(fields[4]);
+	}
+}
+
+
+//-------------------------------------------------
+//  current_entry - get the entry for an archive,
+//  discarding stale hashes the first time it is
+//  seen in this session
+//-------------------------------------------------
+
+hash_cache::archive_entry &hash_cache::current_entry(const std::string &archive)
+{
+	archive_entry &entry(m_archives[archive]);
+	if (!entry.checked)
+	{
+		u64 size = 0;
+		s64 modified = 0;
+		auto const stat = osd_stat(archive);
+		if (stat)
+		{
+			size = stat->size;
+			modified = std::chrono::duration_cast<std::chrono::seconds>(stat->last_modified.time_since_epoch()).count();
+		}
+
+		if ((entry.size != size) || (entry.modified != modified))
+		{
+			m_dirty = m_dirty || !entry.members.empty();
+			entry.members.clear();
+			entry.size = size;
+			entry.modified = modified;
+		}
+		entry.checked = true;
+	}
+	return entry;
+}
+
+
+
 //**************************************************************************
 //  EMU FILE
 //**************************************************************************
@@ -172,6 +356,7 @@ emu_file::emu_file(u32 openflags)
 	, m_openflags(openflags)
 	, m_zipfile(nullptr)
 	, m_ziplength(0)
+	, m_hash_cache(nullptr)
 	, m_remove_on_close(false)
 	, m_restrict_to_mediapath(false)
 {
@@ -188,6 +373,7 @@ emu_file::emu_file(std::string &&searchpath, u32 openflags)
 	, m_openflags(openflags)
 	, m_zipfile(nullptr)
 	, m_ziplength(0)
+	, m_hash_cache(nullptr)
 	, m_remove_on_close(false)
 	, m_restrict_to_mediapath(false)
 {
@@ -243,6 +429,15 @@ util::hash_collection &emu_file::hashes(const char *types)
 	if (needed.empty())
 		return m_hashes;
 
+	// see if the cache knows about this archive member before decompressing it
+	std::string member;
+	if (m_hash_cache && m_zipfile)
+	{
+		if (m_hash_cache->find(m_archive_path, m_zipfile->current_name(), m_zipfile->current_crc(), types, m_hashes))
+			return m_hashes;
+		member = m_zipfile->current_name();
+	}
+
 	// load the ZIP file if needed
 	if (compressed_file_ready())
 		return m_hashes;
@@ -253,6 +448,8 @@ util::hash_collection &emu_file::hashes(const char *types)
 	if (!m_zipdata.empty())
 	{
 		m_hashes.compute(&m_zipdata[0], m_zipdata.size(), needed.c_str());
+		if (!member.empty())
+			m_hash_cache->add(m_archive_path, member, m_hashes);
 		return m_hashes;
 	}
 
@@ -392,6 +589,7 @@ void emu_file::close()
 	m_file.reset();
 
 	m_zipdata.clear();
+	m_archive_path.clear();
 
 	if (m_remove_on_close)
 		osd_file::remove(m_fullpath);
@@ -519,6 +717,22 @@ u32 emu_file::read(void *buffer, u32 length)
 }
 
 
+//-------------------------------------------------
+//  map - get a read-only pointer to the file
+//  data; archived files are already in RAM, plain
+//  files are mapped if the OSD supports it
+//-------------------------------------------------
+
+const void *emu_file::map()
+{
+	// load the ZIP file now if we haven't yet
+	if (compressed_file_ready())
+		return nullptr;
+
+	return m_file ? m_file->map() : nullptr;
+}
+
+
 //-------------------------------------------------
 //  getc - read a character from a file
 //-------------------------------------------------
@@ -705,6 +919,7 @@ osd_file::error emu_file::attempt_zipped()
 			{
 				m_zipfile = std::move(zip);
 				m_ziplength = m_zipfile->current_uncompressed_length();
+				m_archive_path = m_fullpath + suffixes[i];
 
 				// build a hash with just the CRC
 				m_hashes.reset();
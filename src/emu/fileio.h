@@ -16,6 +16,9 @@
 #include "corefile.h"
 #include "hash.h"
 
+#include <mutex>
+#include <unordered_map>
+
 // some systems use macros for getc/putc rather than functions
 #ifdef getc
 #undef getc
@@ -79,6 +82,45 @@ private:
 
 
 
+// ======================> hash_cache
+
+// persistent cache of hashes computed for files inside archives; nothing
+// is written back until save() is called
+class hash_cache
+{
+public:
+	// construction
+	hash_cache(emu_options &options);
+
+	// main interface
+	bool matches(emu_options &options) const;
+	bool find(const std::string &archive, const std::string &member, u32 crc, const char *types, util::hash_collection &hashes);
+	void add(const std::string &archive, const std::string &member, const util::hash_collection &hashes);
+	void save();
+
+private:
+	struct archive_entry
+	{
+		u64                                             size = 0;
+		s64                                             modified = 0;
+		bool                                            checked = false;
+		std::unordered_map<std::string, std::string>    members;
+	};
+
+	// internal helpers
+	void load();
+	archive_entry &current_entry(const std::string &archive);
+
+	// internal state
+	std::string                                         m_searchpath;   // directory holding the cache file
+	std::string                                         m_filename;     // cache file name, empty if disabled
+	std::unordered_map<std::string, archive_entry>      m_archives;     // cached hashes by archive path
+	std::mutex                                          m_mutex;        // protects the above
+	bool                                                m_dirty;        // flag: needs to be written back
+};
+
+
+
 // ======================> emu_file
 
 class emu_file
@@ -103,6 +145,7 @@ public:
 	void remove_on_close() { m_remove_on_close = true; }
 	void set_openflags(u32 openflags) { assert(!m_file); m_openflags = openflags; }
 	void set_restrict_to_mediapath(bool rtmp = true) { m_restrict_to_mediapath = rtmp; }
+	void set_hash_cache(hash_cache *cache) { m_hash_cache = cache; }
 
 	// open/close
 	osd_file::error open(const std::string &name);
@@ -132,6 +175,9 @@ public:
 	int ungetc(int c);
 	char *gets(char *s, int n);
 
+	// read-only pointer to the whole file without copying it, or nullptr
+	const void *map();
+
 	// writing
 	u32 write(const void *buffer, u32 length);
 	int puts(const char *s);
@@ -164,6 +210,8 @@ private:
 	std::unique_ptr<util::archive_file> m_zipfile;  // ZIP file pointer
 	std::vector<u8>         m_zipdata;               // ZIP file data
 	u64                     m_ziplength;             // ZIP file length
+	std::string             m_archive_path;          // path of the archive containing the file
+	hash_cache *            m_hash_cache;            // cache of archived file hashes, if any
 
 	bool                    m_remove_on_close;       // flag: remove the file when closing
 	bool                    m_restrict_to_mediapath; // flag: restrict to paths inside the media-path
@@ -265,6 +265,29 @@ struct websocket_connection_impl : public http_manager::websocket_connection {
 	}
 };
 
+/** Telemetry frames pass from the producer to the server thread through a triple buffer: the producer
+ * always owns one slot and the server thread another, and the third is swapped between them
+ * atomically, so neither side waits or allocates. */
+struct http_manager::telemetry_state {
+	static constexpr size_t FRAME_SIZE = 16384;
+	static constexpr int FRESH = 4;
+
+	struct slot {
+		size_t length;
+		char data[FRAME_SIZE];
+	};
+
+	telemetry_state(asio::io_context &context) : timer(context) { }
+
+	slot slots[3];
+	int producer = 0;                                   // slot being filled, producer thread only
+	std::atomic<int> shared{ 1 };                       // spare slot, with FRESH set if it holds an unsent frame
+	int consumer = 2;                                   // slot last sent, server thread only
+
+	asio::system_timer timer;
+	std::list<websocket_connection_ptr> clients;        // server thread only
+};
+
 http_manager::http_manager(bool active, short port, const char *root)
   : m_active(active), m_io_context(std::make_shared<asio::io_context>()), m_root(root)
 {
@@ -346,6 +369,8 @@ http_manager::~http_manager()
 {
 	if (!m_server) return;
 
+	if (m_telemetry)
+		m_telemetry->timer.cancel();
 	m_server->stop();
 	m_io_context->stop();
 	if (m_server_thread.joinable())
@@ -569,3 +594,57 @@ void http_manager::remove_endpoint(const std::string &path) {
 
 	m_endpoints.erase(path);
 }
+
+void http_manager::enable_telemetry(const std::string &path) {
+	if (!m_active || m_telemetry) return;
+
+	m_telemetry = std::make_unique<telemetry_state>(*m_io_context);
+
+	// connections come and go on the server thread, which is also the only one sending
+	add_endpoint(path,
+			[this](websocket_connection_ptr connection) { m_telemetry->clients.push_back(connection); },
+			nullptr,
+			[this](websocket_connection_ptr connection, int status, const std::string &reason) { m_telemetry->clients.remove(connection); },
+			[this](websocket_connection_ptr connection, const std::error_code &error_code) { m_telemetry->clients.remove(connection); });
+
+	asio::post(*m_io_context, [this]() { poll_telemetry(); });
+}
+
+char *http_manager::telemetry_buffer(size_t &capacity) {
+	if (!m_telemetry) {
+		capacity = 0;
+		return nullptr;
+	}
+
+	capacity = telemetry_state::FRAME_SIZE;
+	return m_telemetry->slots[m_telemetry->producer].data;
+}
+
+void http_manager::commit_telemetry(size_t length) {
+	if (!m_telemetry) return;
+
+	telemetry_state &state = *m_telemetry;
+	state.slots[state.producer].length = std::min(length, telemetry_state::FRAME_SIZE);
+	state.producer = state.shared.exchange(state.producer | telemetry_state::FRESH, std::memory_order_acq_rel) & ~telemetry_state::FRESH;
+}
+
+void http_manager::poll_telemetry() {
+	telemetry_state &state = *m_telemetry;
+
+	// take the spare slot only if the producer has filled it since we last looked
+	if (state.shared.load(std::memory_order_relaxed) & telemetry_state::FRESH) {
+		state.consumer = state.shared.exchange(state.consumer, std::memory_order_acq_rel) & ~telemetry_state::FRESH;
+		telemetry_state::slot const &frame = state.slots[state.consumer];
+		if (!state.clients.empty()) {
+			std::string const payload(frame.data, frame.length);
+			for (websocket_connection_ptr &client : state.clients)
+				client->send_message(payload, 1);
+		}
+	}
+
+	state.timer.expires_after(std::chrono::milliseconds(5));
+	state.timer.async_wait([this](std::error_code const &error) {
+		if (!error)
+			poll_telemetry();
+	});
+}
@@ -154,6 +154,17 @@ public:
 	/** Removes the websocket endpoint at the specified path. */
 	void remove_endpoint(const std::string &path);
 
+	/** Starts pushing telemetry frames to every websocket client connected at the specified path. */
+	void enable_telemetry(const std::string &path);
+
+	/** Returns a preallocated buffer for the next telemetry frame, or nullptr if telemetry is off.
+	 * Only one thread may produce frames; filling the buffer never allocates or blocks. */
+	char *telemetry_buffer(size_t &capacity);
+
+	/** Hands the frame written to the telemetry buffer to the server thread, which sends the
+	 * latest one to each client; clients that fall behind only ever miss frames. */
+	void commit_telemetry(size_t length);
+
 	bool is_active() {
 		return m_active;
 	}
@@ -169,6 +180,9 @@ private:
 
 	bool read_file(std::ostream &os, const std::string &path);
 
+	struct telemetry_state;
+	void poll_telemetry();
+
 	bool m_active;
 
 	std::shared_ptr<asio::io_context>   m_io_context;
@@ -186,6 +200,8 @@ private:
 	std::unordered_map<void *, websocket_connection_ptr> m_connections;  // the keys are really webpp::ws_server::Connection pointers
 	std::mutex                                           m_connections_mutex;
 
+	std::unique_ptr<telemetry_state>                     m_telemetry;
+
 };
 
 
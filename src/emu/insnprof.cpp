@@ -0,0 +1,168 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    insnprof.cpp
+
+    Per-CPU executed instruction profiling.
+
+    Every call a CPU core makes to debugger_instruction_hook is counted
+    by PC, without the debugger having to be active.  When the machine
+    exits, a text report is written with, for each CPU:
+      - the most executed PCs with their disassembly
+      - the most executed 256-address ranges
+      - the instruction mix, by mnemonic
+
+    Disassembly is done when the report is written, so code that was
+    overwritten or banked out by then is shown as it is at exit.  Cores
+    that only call the hook while the debugger is enabled, including
+    the recompilers, are not counted.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "insnprof.h"
+#include "debug/debugbuf.h"
+
+#include <algorithm>
+#include <map>
+
+
+//**************************************************************************
+//  INSTRUCTION PROFILER
+//**************************************************************************
+
+//-------------------------------------------------
+//  instruction_profiler - constructor
+//-------------------------------------------------
+
+instruction_profiler::instruction_profiler(running_machine &machine)
+	: m_machine(machine)
+	, m_stopped(false)
+{
+	// give each executing device somewhere to count into
+	for (device_execute_interface &exec : execute_interface_iterator(machine.root_device()))
+	{
+		m_devices.emplace_back(profiled_device{ &exec, std::make_unique<pc_counts>() });
+		exec.m_insn_counts = m_devices.back().counts.get();
+	}
+
+	machine.debug_flags |= DEBUG_FLAG_PROFILE;
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&instruction_profiler::stop, this));
+}
+
+
+//-------------------------------------------------
+//  ~instruction_profiler - destructor
+//-------------------------------------------------
+
+instruction_profiler::~instruction_profiler()
+{
+	for (profiled_device &profiled : m_devices)
+		profiled.exec->m_insn_counts = nullptr;
+}
+
+
+//-------------------------------------------------
+//  report - write the tables for one device
+//-------------------------------------------------
+
+void instruction_profiler::report(emu_file &file, profiled_device const &profiled) const
+{
+	device_t &device = profiled.exec->device();
+	int const rows = std::max(machine().options().profile_insns_top(), 1);
+
+	// rank the PCs, busiest first
+	std::vector<std::pair<offs_t, u64> > pcs(profiled.counts->begin(), profiled.counts->end());
+	std::sort(pcs.begin(), pcs.end(), [] (auto const &a, auto const &b) { return (a.second > b.second) || ((a.second == b.second) && (a.first < b.first)); });
+	u64 total = 0;
+	for (auto const &pc : pcs)
+		total += pc.second;
+	double const scale = 100.0 / double(total);
+
+	file.printf("'%s' (%s): %u instructions at %u distinct PCs\n", device.tag(), device.shortname(), total, pcs.size());
+
+	// disassembly needs both a disassembler and a program space to read from
+	device_disasm_interface *disasm;
+	device_memory_interface *memory;
+	std::unique_ptr<debug_disasm_buffer> buffer;
+	if (device.interface(disasm) && device.interface(memory) && memory->has_space(AS_PROGRAM))
+		buffer = std::make_unique<debug_disasm_buffer>(device);
+
+	file.printf("\n  Hot PCs:\n");
+	for (int row = 0; (row < rows) && (row < int(pcs.size())); row++)
+	{
+		offs_t const pc = pcs[row].first;
+		if (buffer)
+		{
+			std::string instruction;
+			offs_t next, size;
+			u32 info;
+			buffer->disassemble(pc, instruction, next, size, info);
+			file.printf("  %12u %6.2f%%  %s  %s\n", pcs[row].second, double(pcs[row].second) * scale, buffer->pc_to_string(pc), instruction);
+		}
+		else
+		{
+			file.printf("  %12u %6.2f%%  %X\n", pcs[row].second, double(pcs[row].second) * scale, pc);
+		}
+	}
+
+	// fold into 256-address ranges
+	std::map<offs_t, u64> ranges;
+	for (auto const &pc : pcs)
+		ranges[pc.first & ~offs_t(0xff)] += pc.second;
+	std::vector<std::pair<offs_t, u64> > ranked(ranges.begin(), ranges.end());
+	std::stable_sort(ranked.begin(), ranked.end(), [] (auto const &a, auto const &b) { return a.second > b.second; });
+
+	file.printf("\n  Hot ranges:\n");
+	for (int row = 0; (row < rows) && (row < int(ranked.size())); row++)
+		file.printf("  %12u %6.2f%%  %X-%X\n", ranked[row].second, double(ranked[row].second) * scale, ranked[row].first, ranked[row].first | 0xff);
+
+	// the instruction mix goes by the first word of the disassembly
+	if (buffer)
+	{
+		std::map<std::string, u64> mnemonics;
+		for (auto const &pc : pcs)
+		{
+			std::string instruction;
+			offs_t next, size;
+			u32 info;
+			buffer->disassemble(pc.first, instruction, next, size, info);
+			mnemonics[instruction.substr(0, instruction.find_first_of(" \t"))] += pc.second;
+		}
+		std::vector<std::pair<std::string, u64> > mix(mnemonics.begin(), mnemonics.end());
+		std::stable_sort(mix.begin(), mix.end(), [] (auto const &a, auto const &b) { return a.second > b.second; });
+
+		file.printf("\n  Instruction mix:\n");
+		for (int row = 0; (row < rows) && (row < int(mix.size())); row++)
+			file.printf("  %12u %6.2f%%  %s\n", mix[row].second, double(mix[row].second) * scale, mix[row].first);
+	}
+	file.printf("\n");
+}
+
+
+//-------------------------------------------------
+//  stop - stop counting and write the report
+//-------------------------------------------------
+
+void instruction_profiler::stop()
+{
+	if (m_stopped)
+		return;
+
+	m_stopped = true;
+	machine().debug_flags &= ~DEBUG_FLAG_PROFILE;
+
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	osd_file::error const filerr = file.open(machine().options().profile_insns());
+	if (filerr != osd_file::error::NONE)
+	{
+		osd_printf_error("Unable to open instruction profile file %s\n", machine().options().profile_insns());
+		return;
+	}
+
+	for (profiled_device const &profiled : m_devices)
+		if (!profiled.counts->empty())
+			report(file, profiled);
+}
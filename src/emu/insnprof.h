@@ -0,0 +1,57 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    insnprof.h
+
+    Per-CPU executed instruction profiling.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_INSNPROF_H
+#define MAME_EMU_INSNPROF_H
+
+#pragma once
+
+#include <unordered_map>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> instruction_profiler
+
+// counts every instruction hook call by PC and writes a ranked report on exit
+class instruction_profiler
+{
+public:
+	// per-PC execution counts for one device
+	using pc_counts = std::unordered_map<offs_t, u64>;
+
+	// construction/destruction
+	instruction_profiler(running_machine &machine);
+	~instruction_profiler();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+
+private:
+	// a profiled device
+	struct profiled_device
+	{
+		device_execute_interface *  exec;
+		std::unique_ptr<pc_counts>  counts;
+	};
+
+	// internal helpers
+	void report(emu_file &file, profiled_device const &profiled) const;
+	void stop();
+
+	// internal state
+	running_machine &               m_machine;          // reference to our machine
+	std::vector<profiled_device>    m_devices;          // devices being counted
+	bool                            m_stopped;          // report already written
+};
+
+#endif // MAME_EMU_INSNPROF_H
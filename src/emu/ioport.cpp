@@ -118,6 +118,90 @@ namespace {
 
 const int SPACE_COUNT = 3;
 
+// INP file blocks, after the header: a type byte, a 32-bit little-endian
+// payload length, then the payload
+const u8 INP_BLOCK_FRAME = 'F';         // time, speed, then runs of changed port values
+const u8 INP_BLOCK_KEYFRAME = 'K';      // time, every port value, then a deflated save state
+
+
+
+//**************************************************************************
+//  INP BLOCK ENCODING
+//**************************************************************************
+
+inline void inp_put(std::vector<u8> &block, u32 value)
+{
+	for (int shift = 0; shift < 32; shift += 8)
+		block.push_back(u8(value >> shift));
+}
+
+inline void inp_put(std::vector<u8> &block, u64 value)
+{
+	inp_put(block, u32(value));
+	inp_put(block, u32(value >> 32));
+}
+
+inline void inp_put_varint(std::vector<u8> &block, u32 value)
+{
+	for ( ; value >= 0x80; value >>= 7)
+		block.push_back(u8(value | 0x80));
+	block.push_back(u8(value));
+}
+
+inline u32 inp_get_u32(const u8 *src)
+{
+	return src[0] | (src[1] << 8) | (src[2] << 16) | (u32(src[3]) << 24);
+}
+
+// reads back a block payload; running off the end yields zeroes and sets a flag
+class inp_reader
+{
+public:
+	inp_reader(const std::vector<u8> &block) : m_src(block.data()), m_end(block.data() + block.size()), m_overrun(false) { }
+
+	bool done() const { return m_src >= m_end; }
+	bool overrun() const { return m_overrun; }
+	const u8 *pos() const { return m_src; }
+	size_t remaining() const { return m_end - m_src; }
+
+	u32 get_u32()
+	{
+		if (remaining() < 4)
+			return fail();
+		u32 const result = inp_get_u32(m_src);
+		m_src += 4;
+		return result;
+	}
+
+	u64 get_u64()
+	{
+		u64 const low = get_u32();
+		return low | (u64(get_u32()) << 32);
+	}
+
+	u32 get_varint()
+	{
+		u32 result = 0;
+		for (int shift = 0; shift < 35; shift += 7)
+		{
+			if (done())
+				return fail();
+			u8 const byte = *m_src++;
+			result |= u32(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return result;
+		}
+		return fail();
+	}
+
+private:
+	u32 fail() { m_src = m_end; m_overrun = true; return 0; }
+
+	const u8 *m_src;
+	const u8 *m_end;
+	bool m_overrun;
+};
+
 
 
 //**************************************************************************
@@ -1678,6 +1762,12 @@ ioport_manager::ioport_manager(running_machine &machine)
 		m_timecode_file(machine.options().input_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS),
 		m_timecode_count(0),
 		m_timecode_last_time(attotime::zero),
+		m_playback_stream(false),
+		m_inp_cursor(0),
+		m_record_keyframe_interval(attotime::zero),
+		m_record_next_keyframe(attotime::zero),
+		m_playback_start(attotime::zero),
+		m_playback_keyframe(-1),
 		m_autofire_toggle(false),
 		m_autofire_delay(3)                 // 1 seems too fast for a bunch of games
 {
@@ -2065,6 +2155,7 @@ g_profiler.start(PROFILER_INPUT);
 			if (dynfield.field().type() != IPT_OUTPUT)
 				dynfield.write(newvalue);
 	}
+	record_frame_end();
 
 g_profiler.stop();
 }
@@ -2522,6 +2613,36 @@ bool ioport_manager::playback_read<bool>(bool &result)
 }
 
 
+//-------------------------------------------------
+//  playback_pull - take the next port value of
+//  the current frame
+//-------------------------------------------------
+
+template<typename _Type>
+void ioport_manager::playback_pull(_Type &result)
+{
+	result = _Type((m_inp_cursor < m_inp_values.size()) ? m_inp_values[m_inp_cursor] : 0);
+	m_inp_cursor++;
+}
+
+
+//-------------------------------------------------
+//  playback_read_block - read the next block of
+//  a keyframed file into m_inp_block
+//-------------------------------------------------
+
+bool ioport_manager::playback_read_block(u8 &type)
+{
+	u8 header[5];
+	if (m_playback_file.read(header, sizeof(header)) != sizeof(header))
+		return false;
+	type = header[0];
+	u32 const length = inp_get_u32(&header[1]);
+	m_inp_block.resize(length);
+	return length == 0 || m_playback_file.read(&m_inp_block[0], length) == length;
+}
+
+
 //-------------------------------------------------
 //  playback_init - initialize INP playback
 //-------------------------------------------------
@@ -2550,7 +2671,7 @@ time_t ioport_manager::playback_init()
 		fatalerror("Input file is corrupt or invalid (missing header)\n");
 	if (!header.check_magic())
 		fatalerror("Input file invalid or in an older, unsupported format\n");
-	if (header.get_majversion() != inp_header::MAJVERSION)
+	if (header.get_majversion() != inp_header::MAJVERSION && header.get_majversion() != inp_header::STREAM_MAJVERSION)
 		fatalerror("Input file format version mismatch\n");
 
 	// output info to console
@@ -2565,12 +2686,109 @@ time_t ioport_manager::playback_init()
 	if (sysname != machine().system().name)
 		osd_printf_info("Input file is for machine '%s', not for current machine '%s'\n", sysname.c_str(), machine().system().name);
 
-	// enable compression
-	m_playback_file.compress(FCOMPRESS_MEDIUM);
+	// older files are a single compressed stream; newer ones are blocks that can be skipped over
+	m_playback_stream = (header.get_majversion() == inp_header::STREAM_MAJVERSION);
+	m_inp_values.clear();
+	if (m_playback_stream)
+	{
+		m_playback_file.compress(FCOMPRESS_MEDIUM);
+		if (machine().options().playback_start() > 0)
+			osd_printf_warning("Input file has no keyframes, playing back from the beginning\n");
+	}
+	else if (machine().options().playback_start() > 0)
+	{
+		m_playback_start = attotime::from_double(machine().options().playback_start());
+		playback_find_keyframe();
+	}
 	return basetime;
 }
 
 
+//-------------------------------------------------
+//  playback_find_keyframe - find the last
+//  keyframe at or before the requested start
+//  time; it's loaded at the first checkpoint
+//-------------------------------------------------
+
+void ioport_manager::playback_find_keyframe()
+{
+	// only the block headers and times are read
+	u64 const start = m_playback_file.tell();
+	attotime found = attotime::zero;
+	u8 header[5 + 12];
+	while (m_playback_file.read(header, 5) == 5)
+	{
+		u64 const offset = m_playback_file.tell() - 5;
+		u32 length = inp_get_u32(&header[1]);
+		if (length >= 12)
+		{
+			if (m_playback_file.read(&header[5], 12) != 12)
+				break;
+			length -= 12;
+			attotime const time(inp_get_u32(&header[5]), inp_get_u32(&header[9]) | (u64(inp_get_u32(&header[13])) << 32));
+			if (time > m_playback_start)
+				break;
+			if (header[0] == INP_BLOCK_KEYFRAME)
+			{
+				m_playback_keyframe = offset;
+				found = time;
+			}
+		}
+		m_playback_file.seek(length, SEEK_CUR);
+	}
+	m_playback_file.seek(start, SEEK_SET);
+
+	if (m_playback_keyframe < 0)
+		osd_printf_warning("No keyframe at or before %s, playing back from the beginning\n", m_playback_start.as_string(3));
+	else
+		osd_printf_info("Playing back from keyframe at %s\n", found.as_string(3));
+}
+
+
+//-------------------------------------------------
+//  inp_checkpoint - called by the machine where
+//  it's safe to save or load state: start
+//  playback from the keyframe found at init, and
+//  write a keyframe when one is due
+//-------------------------------------------------
+
+void ioport_manager::inp_checkpoint()
+{
+	// jump to the keyframe, once
+	if (m_playback_keyframe >= 0 && m_playback_file.is_open())
+	{
+		m_playback_file.seek(m_playback_keyframe, SEEK_SET);
+		m_playback_keyframe = -1;
+
+		// the time is in the state, the port values come next
+		u8 type;
+		bool valid = playback_read_block(type) && (type == INP_BLOCK_KEYFRAME);
+		inp_reader reader(m_inp_block);
+		reader.get_u32();
+		reader.get_u64();
+		u32 const count = reader.get_varint();
+		valid = valid && (count <= reader.remaining() / 4);
+		m_inp_values.resize(valid ? count : 0);
+		for (u32 &value : m_inp_values)
+			value = reader.get_u32();
+		if (!valid || reader.overrun() || machine().save().read_buffer(reader.pos(), reader.remaining()) != STATERR_NONE)
+		{
+			playback_end("Corrupt keyframe");
+			return;
+		}
+
+		// restore the ports as they were when it was written
+		m_inp_cursor = 0;
+		for (auto &port : m_portlist)
+			playback_port(*port.second.get());
+	}
+
+	// write a keyframe if it's time for one
+	if (m_record_file.is_open() && m_record_keyframe_interval != attotime::zero && machine().time() >= m_record_next_keyframe)
+		record_keyframe();
+}
+
+
 //-------------------------------------------------
 //  playback_end - end INP playback
 //-------------------------------------------------
@@ -2609,8 +2827,8 @@ void ioport_manager::playback_end(const char *message)
 
 void ioport_manager::playback_frame(const attotime &curtime)
 {
-	// if playing back, fetch the information and verify
-	if (m_playback_file.is_open())
+	// if playing back an older file, fetch the information and verify
+	if (m_playback_file.is_open() && m_playback_stream)
 	{
 		// first the absolute time
 		seconds_t seconds_temp;
@@ -2626,6 +2844,53 @@ void ioport_manager::playback_frame(const attotime &curtime)
 		m_playback_accumulated_speed += playback_read(curspeed);
 		m_playback_accumulated_frames++;
 	}
+
+	// otherwise, skip any keyframes and apply the next frame's changes
+	else if (m_playback_file.is_open())
+	{
+		u8 type;
+		do
+		{
+			if (!playback_read_block(type))
+			{
+				playback_end("End of file");
+				return;
+			}
+		}
+		while (type != INP_BLOCK_FRAME);
+
+		// the time and speed come first
+		inp_reader reader(m_inp_block);
+		u32 const seconds = reader.get_u32();
+		u64 const attoseconds = reader.get_u64();
+		u32 const curspeed = reader.get_u32();
+
+		// then runs of unchanged and changed values
+		size_t index = 0;
+		while (!reader.done())
+		{
+			index += reader.get_varint();
+			u32 const count = reader.get_varint();
+			if (count > reader.remaining() / 4)
+			{
+				playback_end("Corrupt frame");
+				return;
+			}
+			if (m_inp_values.size() < index + count)
+				m_inp_values.resize(index + count, 0);
+			for (u32 i = 0; i < count; i++)
+				m_inp_values[index++] = reader.get_u32();
+		}
+		m_inp_cursor = 0;
+
+		if (reader.overrun())
+			playback_end("Corrupt frame");
+		else if (attotime(seconds, attoseconds) != curtime)
+			playback_end("Out of sync");
+
+		m_playback_accumulated_speed += curspeed;
+		m_playback_accumulated_frames++;
+	}
 }
 
 
@@ -2635,8 +2900,8 @@ void ioport_manager::playback_frame(const attotime &curtime)
 
 void ioport_manager::playback_port(ioport_port &port)
 {
-	// if playing back, fetch information about this port
-	if (m_playback_file.is_open())
+	// if playing back an older file, fetch information about this port
+	if (m_playback_file.is_open() && m_playback_stream)
 	{
 		// read the default value and the digital state
 		playback_read(port.live().defvalue);
@@ -2654,32 +2919,36 @@ void ioport_manager::playback_port(ioport_port &port)
 			playback_read(analog.m_reverse);
 		}
 	}
+
+	// otherwise, take the same values from the current frame
+	else if (m_playback_file.is_open())
+	{
+		playback_pull(port.live().defvalue);
+		playback_pull(port.live().digital);
+		for (analog_field &analog : port.live().analoglist)
+		{
+			playback_pull(analog.m_accum);
+			playback_pull(analog.m_previous);
+			playback_pull(analog.m_sensitivity);
+			playback_pull(analog.m_reverse);
+		}
+	}
 }
 
 
 //-------------------------------------------------
-//  record_write - write a value to the record file
+//  record_block - write m_inp_block to the record
+//  file as a block of the given type
 //-------------------------------------------------
 
-template<typename _Type>
-void ioport_manager::record_write(_Type value)
+void ioport_manager::record_block(u8 type)
 {
-	// protect against nullptr handles if previous reads fail
-	if (!m_record_file.is_open())
-		return;
-
-	// read the value; if we fail, end playback
-	if (m_record_file.write(&value, sizeof(value)) != sizeof(value))
+	u32 const length = m_inp_block.size();
+	u8 const header[5] = { type, u8(length), u8(length >> 8), u8(length >> 16), u8(length >> 24) };
+	if (m_record_file.write(header, sizeof(header)) != sizeof(header) || m_record_file.write(m_inp_block.data(), length) != length)
 		record_end("Out of space");
 }
 
-template<>
-void ioport_manager::record_write<bool>(bool value)
-{
-	u8 byte = u8(value);
-	record_write(byte);
-}
-
 template<typename _Type>
 void ioport_manager::timecode_write(_Type value)
 {
@@ -2733,9 +3002,13 @@ void ioport_manager::record_init()
 
 	// write it
 	header.write(m_record_file);
+	m_inp_previous.clear();
 
-	// enable compression
-	m_record_file.compress(FCOMPRESS_MEDIUM);
+	// keyframes are save states, so only machines that support them get any
+	m_record_keyframe_interval = attotime::zero;
+	if (machine().options().record_keyframe() > 0 && (machine().system().flags & MACHINE_SUPPORTS_SAVE))
+		m_record_keyframe_interval = attotime::from_seconds(machine().options().record_keyframe());
+	m_record_next_keyframe = attotime::zero;
 }
 
 
@@ -2820,11 +3093,13 @@ void ioport_manager::record_frame(const attotime &curtime)
 	if (m_record_file.is_open())
 	{
 		// first the absolute time
-		record_write(curtime.seconds());
-		record_write(curtime.attoseconds());
+		m_inp_block.clear();
+		inp_put(m_inp_block, u32(curtime.seconds()));
+		inp_put(m_inp_block, u64(curtime.attoseconds()));
 
-		// then the current speed
-		record_write(u32(machine().video().speed_percent() * double(1 << 20)));
+		// then the current speed; the port values follow once they're known
+		inp_put(m_inp_block, u32(machine().video().speed_percent() * double(1 << 20)));
+		m_inp_values.clear();
 	}
 
 	if (m_timecode_file.is_open() && machine().video().get_timecode_write())
@@ -2930,24 +3205,87 @@ void ioport_manager::record_port(ioport_port &port)
 	if (m_record_file.is_open())
 	{
 		// store the default value and digital state
-		record_write(port.live().defvalue);
-		record_write(port.live().digital);
+		m_inp_values.push_back(port.live().defvalue);
+		m_inp_values.push_back(port.live().digital);
 
 		// loop over analog ports and save their data
 		for (analog_field &analog : port.live().analoglist)
 		{
 			// store current and previous values
-			record_write(analog.m_accum);
-			record_write(analog.m_previous);
+			m_inp_values.push_back(analog.m_accum);
+			m_inp_values.push_back(analog.m_previous);
 
 			// store configuration information
-			record_write(analog.m_sensitivity);
-			record_write(analog.m_reverse);
+			m_inp_values.push_back(analog.m_sensitivity);
+			m_inp_values.push_back(analog.m_reverse);
 		}
 	}
 }
 
 
+//-------------------------------------------------
+//  record_frame_end - write the frame, keeping
+//  only the port values that changed
+//-------------------------------------------------
+
+void ioport_manager::record_frame_end()
+{
+	if (!m_record_file.is_open())
+		return;
+
+	// runs of (unchanged count, changed count, changed values)
+	size_t const count = m_inp_values.size();
+	m_inp_previous.resize(count, 0);
+	size_t index = 0;
+	while (index < count)
+	{
+		size_t const start = index;
+		while (index < count && m_inp_values[index] == m_inp_previous[index])
+			index++;
+		if (index == count)
+			break;
+		size_t const changed = index;
+		while (index < count && m_inp_values[index] != m_inp_previous[index])
+			index++;
+		inp_put_varint(m_inp_block, changed - start);
+		inp_put_varint(m_inp_block, index - changed);
+		for (size_t i = changed; i < index; i++)
+			inp_put(m_inp_block, m_inp_values[i]);
+	}
+	record_block(INP_BLOCK_FRAME);
+	std::swap(m_inp_values, m_inp_previous);
+}
+
+
+//-------------------------------------------------
+//  record_keyframe - write the port values and
+//  the machine state, so playback can start here
+//-------------------------------------------------
+
+void ioport_manager::record_keyframe()
+{
+	attotime const curtime = machine().time();
+	m_record_next_keyframe = curtime + m_record_keyframe_interval;
+
+	std::vector<u8> state;
+	if (machine().save().write_buffer(state) != STATERR_NONE)
+	{
+		osd_printf_warning("Unable to write a keyframe at %s\n", curtime.as_string(3));
+		return;
+	}
+
+	// the values are as of the last frame, which the next one is relative to
+	m_inp_block.clear();
+	inp_put(m_inp_block, u32(curtime.seconds()));
+	inp_put(m_inp_block, u64(curtime.attoseconds()));
+	inp_put_varint(m_inp_block, m_inp_previous.size());
+	for (u32 value : m_inp_previous)
+		inp_put(m_inp_block, value);
+	m_inp_block.insert(m_inp_block.end(), state.begin(), state.end());
+	record_block(INP_BLOCK_KEYFRAME);
+}
+
+
 
 //**************************************************************************
 //  I/O PORT CONFIGURER
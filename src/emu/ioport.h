@@ -664,8 +664,9 @@ class inp_header
 {
 public:
 	// parameters
-	static constexpr unsigned MAJVERSION = 3;
+	static constexpr unsigned MAJVERSION = 4;
 	static constexpr unsigned MINVERSION = 0;
+	static constexpr unsigned STREAM_MAJVERSION = 3;    // older files: one zlib stream of every port value each frame
 
 	bool read(emu_file &f)
 	{
@@ -1406,6 +1407,9 @@ public:
 	ioport_type token_to_input_type(const char *string, int &player) const;
 	std::string input_type_to_token(ioport_type type, int player);
 
+	// record/playback keyframes, at points where the machine can be saved or loaded
+	void inp_checkpoint();
+
 	// autofire
 	bool get_autofire_toggle() { return m_autofire_toggle; }
 	void set_autofire_toggle(bool toggle) { m_autofire_toggle = toggle; }
@@ -1437,16 +1441,21 @@ private:
 	void save_game_inputs(util::xml::data_node &parentnode);
 
 	template<typename _Type> _Type playback_read(_Type &result);
+	template<typename _Type> void playback_pull(_Type &result);
 	time_t playback_init();
+	void playback_find_keyframe();
+	bool playback_read_block(u8 &type);
 	void playback_end(const char *message = nullptr);
 	void playback_frame(const attotime &curtime);
 	void playback_port(ioport_port &port);
 
-	template<typename _Type> void record_write(_Type value);
 	void record_init();
 	void record_end(const char *message = nullptr);
 	void record_frame(const attotime &curtime);
 	void record_port(ioport_port &port);
+	void record_frame_end();
+	void record_keyframe();
+	void record_block(u8 type);
 
 	template<typename _Type> void timecode_write(_Type value);
 	void timecode_init();
@@ -1478,6 +1487,18 @@ private:
 	int                     m_timecode_count;
 	attotime                m_timecode_last_time;
 
+	// keyframed record/playback: frames are stored as runs of changed port values,
+	// with the machine state embedded every so often so playback can start there
+	bool                    m_playback_stream;      // playing back an older stream-format file
+	std::vector<u32>        m_inp_values;           // port values for the current frame, in port order
+	std::vector<u32>        m_inp_previous;         // values as of the last frame recorded
+	size_t                  m_inp_cursor;           // next value for record_port/playback_port
+	std::vector<u8>         m_inp_block;            // block being built or read
+	attotime                m_record_keyframe_interval; // emulated time between keyframes, zero for none
+	attotime                m_record_next_keyframe; // when the next keyframe is due
+	attotime                m_playback_start;       // when to start playback, zero for the beginning
+	s64                     m_playback_keyframe;    // file offset of the keyframe to start from, or -1
+
 	// autofire
 	bool                    m_autofire_toggle;      // autofire toggle
 	int                     m_autofire_delay;       // autofire delay
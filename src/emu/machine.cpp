@@ -81,7 +81,10 @@
 #include "debug/debugcpu.h"
 #include "dirtc.h"
 #include "image.h"
+#include "memtrace.h"
+#include "insnprof.h"
 #include "network.h"
+#include "osdsync.h"
 #include "romload.h"
 #include "ui/uimain.h"
 #include <time.h>
@@ -122,9 +125,25 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 		m_ui_active(_config.options().ui_active()),
 		m_basename(_config.gamedrv().name),
 		m_sample_rate(_config.options().sample_rate()),
+		m_logfile_queue(nullptr),
+		m_logfile_writing(false),
 		m_saveload_schedule(saveload_schedule::NONE),
 		m_saveload_schedule_time(attotime::zero),
 		m_saveload_searchpath(nullptr),
+		m_last_save_error(STATERR_NONE),
+		m_runahead_frames(0),
+		m_runahead_cost(0),
+		m_fork_count(0),
+		m_instance(-1),
+		m_fork_remaining(0),
+		m_fork_parent(false),
+		m_fork_failed(false),
+		m_telemetry_interval(0),
+		m_telemetry_countdown(0),
+		m_telemetry_ticks(0),
+		m_bench_ticks(0),
+		m_bench_time(attotime::zero),
+		m_startup_ticks(0),
 
 		m_save(*this),
 		m_memory(*this),
@@ -155,6 +174,7 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 
 running_machine::~running_machine()
 {
+	logfile_close();
 }
 
 
@@ -187,6 +207,9 @@ std::string running_machine::describe_context() const
 
 void running_machine::start()
 {
+	m_startup_ticks = osd_ticks();
+	osd_ticks_t mark = m_startup_ticks;
+
 	// initialize basic can't-fail systems here
 	m_configuration = std::make_unique<configuration_manager>(*this);
 	m_input = std::make_unique<input_manager>(*this);
@@ -206,6 +229,8 @@ void running_machine::start()
 	// create the video manager
 	m_video = std::make_unique<video_manager>(*this);
 	m_ui = manager().create_ui(*this);
+	startup_mark("osd and video", mark, osd_ticks());
+	mark = osd_ticks();
 
 	// initialize the base time (needed for doing record/playback)
 	::time(&m_base_time);
@@ -216,6 +241,7 @@ void running_machine::start()
 	time_t newbase = m_ioport.initialize();
 	if (newbase != 0)
 		m_base_time = newbase;
+	startup_mark("input ports", mark, osd_ticks());
 
 	// initialize the streams engine before the sound devices start
 	m_sound = std::make_unique<sound_manager>(*this);
@@ -229,8 +255,12 @@ void running_machine::start()
 	// needs rom bases), and finally initialize CPUs (which needs
 	// complete address spaces).  These operations must proceed in this
 	// order
+	mark = osd_ticks();
 	m_rom_load = make_unique_clear<rom_load_manager>(*this);
+	startup_mark("ROM loading", mark, osd_ticks());
+	mark = osd_ticks();
 	m_memory.initialize();
+	startup_mark("memory maps", mark, osd_ticks());
 
 	// save the random seed or save states might be broken in drivers that use the rand() method
 	save().save_item(NAME(m_rand_seed));
@@ -259,11 +289,21 @@ void running_machine::start()
 	// register callbacks for the devices, then start them
 	add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(&running_machine::reset_all_devices, this));
 	add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&running_machine::stop_all_devices, this));
+
+	// set up instruction profiling before devices can look at the debug flags
+	if (options().profile_insns()[0] != 0)
+		m_insnprof = std::make_unique<instruction_profiler>(*this);
+
 	save().register_presave(save_prepost_delegate(FUNC(running_machine::presave_all_devices), this));
 	start_all_devices();
+	finish_deferred_starts();
 	save().register_postload(save_prepost_delegate(FUNC(running_machine::postload_all_devices), this));
 	manager().load_cheatfiles(*this);
 
+	// install memory tracing taps now that devices have set up their handlers
+	if (options().memtrace()[0] != 0)
+		m_memtrace = std::make_unique<memory_tracer>(*this);
+
 	// if we're coming in with a savegame request, process it now
 	const char *savegame = options().state();
 	if (savegame[0] != 0)
@@ -274,6 +314,9 @@ void running_machine::start()
 		schedule_load("auto");
 
 	manager().update_machine();
+
+	if (options().startup_report())
+		startup_report();
 }
 
 
@@ -299,6 +342,7 @@ int running_machine::run(bool quiet)
 			m_logfile = std::make_unique<emu_file>(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
 			osd_file::error filerr = m_logfile->open("error.log");
 			assert_always(filerr == osd_file::error::NONE, "unable to open log file");
+			m_logfile_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
 
 			using namespace std::placeholders;
 			add_logerror_callback(std::bind(&running_machine::logfile_callback, this, _1));
@@ -338,6 +382,21 @@ int running_machine::run(bool quiet)
 
 		export_http_api();
 
+		// decide whether we can run ahead
+		runahead_start();
+
+		// and whether we'll be splitting into instances
+		fork_start();
+
+		// recordings start from here, so this is a keyframe too
+		m_ioport.inp_checkpoint();
+
+		// benchmarks measure from here, after loading and the first reset
+		if (*options().bench_report())
+			bench_start();
+		if (*options().profile_flamegraph())
+			g_profiler.enable(true);
+
 		m_hard_reset_pending = false;
 
 #if defined(EMSCRIPTEN)
@@ -351,7 +410,9 @@ int running_machine::run(bool quiet)
 			g_profiler.start(PROFILER_EXTRA);
 
 			// execute CPUs if not paused
-			if (!m_paused)
+			if (!m_paused && m_runahead_frames > 0)
+				runahead_frame();
+			else if (!m_paused)
 				m_scheduler.timeslice();
 			// otherwise, just pump video updates through
 			else
@@ -360,19 +421,44 @@ int running_machine::run(bool quiet)
 			// handle save/load
 			if (m_saveload_schedule != saveload_schedule::NONE)
 				handle_saveload();
+			if (m_save.async_write_done())
+				finish_async_save();
+			m_ioport.inp_checkpoint();
+
+			// split into instances, or move on to the next one
+			if (m_fork_count > 0 && !m_exit_pending && this->time() >= m_fork_time)
+				fork_instances();
+			if (m_fork_state && m_exit_pending && m_saveload_schedule == saveload_schedule::NONE)
+				fork_next_instance();
 
 			g_profiler.stop();
 		}
 		m_manager.http()->clear();
+		if (*options().bench_report())
+			bench_report();
+		if (*options().profile_flamegraph() && !g_profiler.write_folded(options().profile_flamegraph()))
+			osd_printf_error("Unable to write profile %s\n", options().profile_flamegraph());
+
+		// the profiler holds on to devices, so it has to stop with the machine
+		g_profiler.enable(false);
+
+		// make sure the last state has been written
+		if (m_save.async_write_pending())
+			finish_async_save();
 
 		// and out via the exit phase
 		m_current_phase = machine_phase::EXIT;
 
-		// save the NVRAM and configuration
+		// save the NVRAM and configuration, unless we split: every instance shares the same files
 		sound().ui_mute(true);
-		if (options().nvram_save())
-			nvram_save();
-		m_configuration->save_settings();
+		if (m_instance < 0 && !m_fork_parent)
+		{
+			if (options().nvram_save())
+				nvram_save();
+			m_configuration->save_settings();
+		}
+		if (m_fork_failed)
+			error = EMU_ERR_FATALERROR;
 	}
 	catch (emu_fatalerror &fatal)
 	{
@@ -416,7 +502,7 @@ int running_machine::run(bool quiet)
 	util::archive_file::cache_clear();
 
 	// close the logfile
-	m_logfile.reset();
+	logfile_close();
 	return error;
 }
 
@@ -885,6 +971,215 @@ void running_machine::call_notifiers(machine_notification which)
 }
 
 
+//-------------------------------------------------
+//  runahead_start - enable run-ahead if it was
+//  requested and is safe for this system
+//-------------------------------------------------
+
+void running_machine::runahead_start()
+{
+	m_runahead_frames = options().runahead();
+	if (m_runahead_frames <= 0)
+		return;
+
+	// every frame is a save and a load, so the system must support save states; ini files turn it off per system
+	const char *reason = nullptr;
+	if (!(system().flags & MACHINE_SUPPORTS_SAVE))
+		reason = "save states are not supported for this system";
+	else if (debug_flags & DEBUG_FLAG_ENABLED)
+		reason = "the debugger is enabled";
+	else if (options().rewind())
+		reason = "rewind is enabled";
+	else if (options().playback()[0] != 0 || options().record()[0] != 0)
+		reason = "inputs are being played back or recorded";
+
+	if (reason != nullptr)
+	{
+		logerror("Run-ahead has been disabled, because %s.\n", reason);
+		m_runahead_frames = 0;
+		return;
+	}
+
+	m_runahead_state = std::make_unique<ram_state>(m_save);
+}
+
+
+//-------------------------------------------------
+//  fork_start - get ready to split into instances
+//  if that was asked for
+//-------------------------------------------------
+
+void running_machine::fork_start()
+{
+	m_fork_count = options().fork();
+	if (m_fork_count <= 0)
+		return;
+
+	if (debug_flags & DEBUG_FLAG_ENABLED)
+	{
+		osd_printf_error("Not splitting into instances, because the debugger is enabled.\n");
+		m_fork_count = 0;
+		return;
+	}
+	m_fork_time = attotime::from_seconds(options().fork_delay());
+}
+
+
+//-------------------------------------------------
+//  fork_instances - split into separate processes
+//  that each carry on from here; where processes
+//  can't be forked, snapshot the state and run the
+//  instances one after another from it
+//-------------------------------------------------
+
+void running_machine::fork_instances()
+{
+	const int count = m_fork_count;
+	m_fork_count = 0;
+
+	// nothing that's half-written in the background should be inherited
+	if (m_save.async_write_pending())
+		finish_async_save();
+	if (m_logfile_queue)
+		osd_work_queue_wait(m_logfile_queue, 10 * osd_ticks_per_second());
+	if (m_logfile)
+		m_logfile->flush();
+
+	const int result = osd_fork_instances(count);
+	if (result >= 0)
+	{
+		m_instance = result;
+		logerror("Running as instance %d of %d\n", m_instance, count);
+		manager().instance_started(*this);
+		return;
+	}
+	else if (result != OSD_FORK_UNSUPPORTED)
+	{
+		// the children did the work; we leave without touching anything they share
+		m_fork_parent = true;
+		m_fork_failed = (result == OSD_FORK_FAILED);
+		if (m_fork_failed)
+			osd_printf_error("At least one instance failed.\n");
+		m_exit_pending = true;
+		m_scheduler.eat_all_cycles();
+		return;
+	}
+
+	// no fork on this platform, so take turns from a snapshot
+	if (!(system().flags & MACHINE_SUPPORTS_SAVE))
+	{
+		osd_printf_error("Can't run instances in turn, because save states are not supported for this system.\n");
+		return;
+	}
+	m_fork_state = std::make_unique<ram_state>(m_save);
+	const save_error error = m_fork_state->save();
+	if (error != STATERR_NONE)
+	{
+		osd_printf_error("Can't run instances in turn, because the state could not be saved (error %d).\n", int(error));
+		m_fork_state.reset();
+		return;
+	}
+	m_instance = 0;
+	m_fork_remaining = count - 1;
+	logerror("Running as instance %d of %d\n", m_instance, count);
+	manager().instance_started(*this);
+}
+
+
+//-------------------------------------------------
+//  fork_next_instance - when taking turns, go back
+//  to the snapshot instead of exiting until every
+//  instance has had its turn
+//-------------------------------------------------
+
+void running_machine::fork_next_instance()
+{
+	if (m_fork_remaining == 0 || m_fork_state->load() != STATERR_NONE)
+	{
+		m_fork_state.reset();
+		return;
+	}
+
+	m_exit_pending = false;
+	m_fork_remaining--;
+	m_instance++;
+	logerror("Running as instance %d\n", m_instance);
+	manager().instance_started(*this);
+}
+
+
+//-------------------------------------------------
+//  runahead_run_frame - run timeslices until the
+//  next frame update, returns false if something
+//  needs the main loop first
+//-------------------------------------------------
+
+bool running_machine::runahead_run_frame()
+{
+	const u64 frame = m_video->frame_update_count();
+	while (m_video->frame_update_count() == frame)
+	{
+		if (m_paused || m_hard_reset_pending || m_exit_pending || m_saveload_schedule != saveload_schedule::NONE)
+			return false;
+		m_scheduler.timeslice();
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  runahead_frame - emulate the real frame with
+//  sound only, save, run the speculative frames
+//  silently, present the last one and restore
+//-------------------------------------------------
+
+void running_machine::runahead_frame()
+{
+	// the real frame: its sound is kept, its video is not
+	m_video->set_output_suppressed(true);
+	if (!runahead_run_frame())
+	{
+		m_video->set_output_suppressed(false);
+		return;
+	}
+
+	// mix everything up to here so the restored streams neither drop nor repeat samples
+	const osd_ticks_t start = osd_ticks();
+	m_sound->flush();
+	const save_error error = m_runahead_state->save();
+	if (error != STATERR_NONE)
+	{
+		logerror("Run-ahead has been disabled, because the state could not be saved (error %d).\n", int(error));
+		m_video->set_output_suppressed(false);
+		m_runahead_frames = 0;
+		return;
+	}
+
+	// the speculative frames make no output at all
+	m_sound->set_output_suppressed(true);
+	bool complete = true;
+	for (int frame = 1; complete && frame < m_runahead_frames; frame++)
+		complete = runahead_run_frame();
+	osd_ticks_t cost = osd_ticks() - start;
+
+	// the last one is presented, which includes throttling, so it isn't counted
+	m_video->set_output_suppressed(false);
+	if (complete)
+		runahead_run_frame();
+	m_sound->set_output_suppressed(false);
+
+	// go back to the end of the real frame
+	const osd_ticks_t load_start = osd_ticks();
+	if (m_runahead_state->load() != STATERR_NONE)
+	{
+		logerror("Run-ahead has been disabled, because the state could not be restored.\n");
+		m_runahead_frames = 0;
+	}
+	cost += osd_ticks() - load_start;
+	m_runahead_cost = (m_runahead_cost * 15 + cost) / 16;
+}
+
+
 //-------------------------------------------------
 //  handle_saveload - attempt to perform a save
 //  or load
@@ -907,60 +1202,23 @@ void running_machine::handle_saveload()
 			else
 				return; // return without cancelling the operation
 		}
+		else if (m_saveload_schedule == saveload_schedule::SAVE)
+		{
+			// capture the state now and let the I/O thread compress and write it
+			save_error const saverr = m_save.write_file_async(m_saveload_searchpath, m_saveload_pending_file);
+			if (saverr != STATERR_NONE)
+				report_saveload(saveload_schedule::SAVE, osd_file::error::NONE, saverr);
+		}
 		else
 		{
-			u32 const openflags = (m_saveload_schedule == saveload_schedule::LOAD) ? OPEN_FLAG_READ : (OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+			// finish writing first in case we are loading the same file
+			if (m_save.async_write_pending())
+				finish_async_save();
 
 			// open the file
-			emu_file file(m_saveload_searchpath, openflags);
+			emu_file file(m_saveload_searchpath, OPEN_FLAG_READ);
 			auto const filerr = file.open(m_saveload_pending_file);
-			if (filerr == osd_file::error::NONE)
-			{
-				const char *const opnamed = (m_saveload_schedule == saveload_schedule::LOAD) ? "loaded" : "saved";
-
-				// read/write the save state
-				save_error saverr = (m_saveload_schedule == saveload_schedule::LOAD) ? m_save.read_file(file) : m_save.write_file(file);
-
-				// handle the result
-				switch (saverr)
-				{
-				case STATERR_ILLEGAL_REGISTRATIONS:
-					popmessage("Error: Unable to %s state due to illegal registrations. See error.log for details.", opname);
-					break;
-
-				case STATERR_INVALID_HEADER:
-					popmessage("Error: Unable to %s state due to an invalid header. Make sure the save state is correct for this machine.", opname);
-					break;
-
-				case STATERR_READ_ERROR:
-					popmessage("Error: Unable to %s state due to a read error (file is likely corrupt).", opname);
-					break;
-
-				case STATERR_WRITE_ERROR:
-					popmessage("Error: Unable to %s state due to a write error. Verify there is enough disk space.", opname);
-					break;
-
-				case STATERR_NONE:
-					if (!(m_system.flags & MACHINE_SUPPORTS_SAVE))
-						popmessage("State successfully %s.\nWarning: Save states are not officially supported for this machine.", opnamed);
-					else
-						popmessage("State successfully %s.", opnamed);
-					break;
-
-				default:
-					popmessage("Error: Unknown error during state %s.", opnamed);
-					break;
-				}
-
-				// close and perhaps delete the file
-				if (saverr != STATERR_NONE && m_saveload_schedule == saveload_schedule::SAVE)
-					file.remove_on_close();
-			}
-			else if (openflags == OPEN_FLAG_READ && filerr == osd_file::error::NOT_FOUND)
-				// attempt to load a non-existent savestate, report empty slot
-				popmessage("Error: No savestate file to load.", opname);
-			else
-				popmessage("Error: Failed to open file for %s operation.", opname);
+			report_saveload(saveload_schedule::LOAD, filerr, (filerr == osd_file::error::NONE) ? m_save.read_file(file) : STATERR_NONE);
 		}
 	}
 
@@ -971,6 +1229,73 @@ void running_machine::handle_saveload()
 }
 
 
+//-------------------------------------------------
+//  finish_async_save - collect the result of a
+//  state written in the background and tell the
+//  user and any listeners about it
+//-------------------------------------------------
+
+void running_machine::finish_async_save()
+{
+	osd_file::error filerr;
+	save_error const saverr = m_save.finish_async_write(filerr, m_last_save_file);
+	m_last_save_error = (filerr == osd_file::error::NONE) ? saverr : STATERR_WRITE_ERROR;
+	report_saveload(saveload_schedule::SAVE, filerr, saverr);
+	call_notifiers(MACHINE_NOTIFY_SAVE_COMPLETE);
+}
+
+
+//-------------------------------------------------
+//  report_saveload - show the outcome of a save
+//  or load operation
+//-------------------------------------------------
+
+void running_machine::report_saveload(saveload_schedule operation, osd_file::error filerr, save_error saverr)
+{
+	const char *const opname = (operation == saveload_schedule::LOAD) ? "load" : "save";
+	const char *const opnamed = (operation == saveload_schedule::LOAD) ? "loaded" : "saved";
+
+	if (filerr == osd_file::error::NONE)
+	{
+		// handle the result
+		switch (saverr)
+		{
+		case STATERR_ILLEGAL_REGISTRATIONS:
+			popmessage("Error: Unable to %s state due to illegal registrations. See error.log for details.", opname);
+			break;
+
+		case STATERR_INVALID_HEADER:
+			popmessage("Error: Unable to %s state due to an invalid header. Make sure the save state is correct for this machine.", opname);
+			break;
+
+		case STATERR_READ_ERROR:
+			popmessage("Error: Unable to %s state due to a read error (file is likely corrupt).", opname);
+			break;
+
+		case STATERR_WRITE_ERROR:
+			popmessage("Error: Unable to %s state due to a write error. Verify there is enough disk space.", opname);
+			break;
+
+		case STATERR_NONE:
+			if (!(m_system.flags & MACHINE_SUPPORTS_SAVE))
+				popmessage("State successfully %s.\nWarning: Save states are not officially supported for this machine.", opnamed);
+			else
+				popmessage("State successfully %s.", opnamed);
+			break;
+
+		default:
+			popmessage("Error: Unknown error during state %s.", opnamed);
+			break;
+		}
+	}
+	else if (operation == saveload_schedule::LOAD && filerr == osd_file::error::NOT_FOUND)
+		// attempt to load a non-existent savestate, report empty slot
+		popmessage("Error: No savestate file to load.", opname);
+	else
+		popmessage("Error: Failed to open file for %s operation.", opname);
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
@@ -998,14 +1323,74 @@ void running_machine::soft_reset(void *ptr, s32 param)
 
 void running_machine::logfile_callback(const char *buffer)
 {
-	if (m_logfile != nullptr)
+	if (m_logfile == nullptr)
+		return;
+
+	// without a writer thread, write it here
+	if (m_logfile_queue == nullptr)
 	{
 		m_logfile->puts(buffer);
 		m_logfile->flush();
+		return;
+	}
+
+	// otherwise append it to the pending text, and kick off the writer if it's idle
+	std::lock_guard<std::mutex> lock(m_logfile_lock);
+	m_logfile_pending.append(buffer);
+	if (!m_logfile_writing)
+	{
+		m_logfile_writing = true;
+		osd_work_item_queue(m_logfile_queue, logfile_write_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+	}
+}
+
+
+//-------------------------------------------------
+//  logfile_write_static - write pending log text
+//  in order until there is none left
+//  (I/O thread)
+//-------------------------------------------------
+
+void *running_machine::logfile_write_static(void *param, int threadid)
+{
+	running_machine &machine(*reinterpret_cast<running_machine *>(param));
+	while (true)
+	{
+		// swap the buffers so both keep their capacity
+		{
+			std::lock_guard<std::mutex> lock(machine.m_logfile_lock);
+			if (machine.m_logfile_pending.empty())
+			{
+				machine.m_logfile_writing = false;
+				return nullptr;
+			}
+			machine.m_logfile_batch.swap(machine.m_logfile_pending);
+		}
+
+		machine.m_logfile->write(machine.m_logfile_batch.data(), machine.m_logfile_batch.size());
+		machine.m_logfile->flush();
+		machine.m_logfile_batch.clear();
 	}
 }
 
 
+//-------------------------------------------------
+//  logfile_close - let the writer finish, then
+//  close the log file
+//-------------------------------------------------
+
+void running_machine::logfile_close()
+{
+	if (m_logfile_queue != nullptr)
+	{
+		osd_work_queue_wait(m_logfile_queue, osd_ticks_per_second() * 100);
+		osd_work_queue_free(m_logfile_queue);
+		m_logfile_queue = nullptr;
+	}
+	m_logfile.reset();
+}
+
+
 //-------------------------------------------------
 //  start_all_devices - start any unstarted devices
 //-------------------------------------------------
@@ -1032,7 +1417,9 @@ void running_machine::start_all_devices()
 
 					// now start the device
 					osd_printf_verbose("Starting %s '%s'\n", device.name(), device.tag());
+					osd_ticks_t begin = osd_ticks();
 					device.start();
+					startup_mark(string_format("start %s '%s'", device.shortname(), device.tag()), begin, osd_ticks());
 				}
 
 				// handle missing dependencies by moving the device to the end
@@ -1053,6 +1440,120 @@ void running_machine::start_all_devices()
 }
 
 
+//-------------------------------------------------
+//  defer_start - queue work a device wants done
+//  before the first reset but not necessarily
+//  inside its own device_start
+//-------------------------------------------------
+
+void running_machine::defer_start(device_t &device, std::string &&what, std::function<void ()> &&task)
+{
+	assert(m_current_phase == machine_phase::INIT);
+	auto item = std::make_unique<deferred_start>();
+	item->what = string_format("%s '%s'", what, device.tag());
+	item->task = std::move(task);
+	item->begin = item->end = 0;
+	m_deferred_starts.push_back(std::move(item));
+}
+
+
+//-------------------------------------------------
+//  run_deferred_start - work queue callback for
+//  a single deferred task
+//-------------------------------------------------
+
+void *running_machine::run_deferred_start(void *param, int threadid)
+{
+	deferred_start &item = *reinterpret_cast<deferred_start *>(param);
+	item.begin = osd_ticks();
+	try
+	{
+		item.task();
+	}
+	catch (...)
+	{
+		item.error = std::current_exception();
+	}
+	item.end = osd_ticks();
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  finish_deferred_starts - run everything queued
+//  by defer_start and wait for it; the tasks only
+//  get launched once every device has started, so
+//  they may rely on anything device_start set up
+//  but not on each other
+//-------------------------------------------------
+
+void running_machine::finish_deferred_starts()
+{
+	if (m_deferred_starts.empty())
+		return;
+
+	osd_ticks_t begin = osd_ticks();
+	osd_work_queue *queue = options().async_start() ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	if (queue != nullptr)
+	{
+		for (auto &item : m_deferred_starts)
+			osd_work_item_queue(queue, &running_machine::run_deferred_start, item.get(), 0);
+		osd_work_queue_wait(queue, osd_ticks_per_second() * 600);
+		osd_work_queue_free(queue);
+	}
+	else
+	{
+		for (auto &item : m_deferred_starts)
+			run_deferred_start(item.get(), 0);
+	}
+	osd_ticks_t end = osd_ticks();
+
+	// record the timeline and rethrow the first failure now that nothing is running
+	std::exception_ptr error;
+	for (auto &item : m_deferred_starts)
+	{
+		startup_mark(std::string("deferred ") + item->what, item->begin, item->end);
+		if (item->error && !error)
+			error = item->error;
+	}
+	startup_mark(string_format("deferred work (%d tasks, wall)", int(m_deferred_starts.size())), begin, end);
+	m_deferred_starts.clear();
+	if (error)
+		std::rethrow_exception(error);
+}
+
+
+//-------------------------------------------------
+//  startup_mark - note how long a startup step
+//  took
+//-------------------------------------------------
+
+void running_machine::startup_mark(std::string &&what, osd_ticks_t begin, osd_ticks_t end)
+{
+	if (options().startup_report())
+		m_startup_timeline.emplace_back(std::move(what), end - begin);
+}
+
+
+//-------------------------------------------------
+//  startup_report - print the slowest startup
+//  steps
+//-------------------------------------------------
+
+void running_machine::startup_report()
+{
+	const double tps = double(osd_ticks_per_second());
+	std::stable_sort(m_startup_timeline.begin(), m_startup_timeline.end(),
+			[] (const std::pair<std::string, osd_ticks_t> &a, const std::pair<std::string, osd_ticks_t> &b) { return a.second > b.second; });
+
+	osd_printf_info("Startup took %.1f ms%s\n", double(osd_ticks() - m_startup_ticks) * 1000.0 / tps, options().async_start() ? " (async_start)" : "");
+	const size_t count = std::min<size_t>(m_startup_timeline.size(), 20);
+	for (size_t i = 0; i < count; i++)
+		osd_printf_info("%10.2f ms  %s\n", double(m_startup_timeline[i].second) * 1000.0 / tps, m_startup_timeline[i].first.c_str());
+	m_startup_timeline.clear();
+}
+
+
 //-------------------------------------------------
 //  reset_all_devices - reset all devices in the
 //  hierarchy
@@ -1250,7 +1751,190 @@ void running_machine::export_http_api()
 			response->set_content_type("application/json");
 			response->set_body(s.GetString());
 		});
+
+		// push telemetry rather than have every monitor poll for it
+		m_telemetry_interval = options().http_telemetry();
+		if (m_telemetry_interval > 0)
+		{
+			m_manager.http()->enable_telemetry("/api/telemetry");
+			m_scheduler.set_statistics_enabled(true);
+			m_telemetry_devices.reserve(execute_interface_iterator(root_device()).count());
+			m_telemetry_countdown = m_telemetry_interval;
+			m_telemetry_ticks = osd_ticks();
+			add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&running_machine::publish_telemetry, this));
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  publish_telemetry - every so many frames,
+//  format a JSON frame straight into the HTTP
+//  server's buffer; nothing here allocates, and
+//  the server thread does the sending
+//-------------------------------------------------
+
+static size_t telemetry_printf(char *buffer, size_t capacity, size_t used, const char *format, ...) ATTR_PRINTF(4,5);
+static size_t telemetry_printf(char *buffer, size_t capacity, size_t used, const char *format, ...)
+{
+	if (used >= capacity)
+		return capacity;
+	va_list args;
+	va_start(args, format);
+	int const written = vsnprintf(buffer + used, capacity - used, format, args);
+	va_end(args);
+	return (written < 0) ? capacity : std::min(capacity, used + size_t(written));
+}
+
+void running_machine::publish_telemetry()
+{
+	if (--m_telemetry_countdown > 0)
+		return;
+	m_telemetry_countdown = m_telemetry_interval;
+
+	size_t capacity;
+	char *const buffer = m_manager.http()->telemetry_buffer(capacity);
+	if (!buffer)
+		return;
+
+	osd_ticks_t const now = osd_ticks();
+	double const frame_ms = 1000.0 * double(now - m_telemetry_ticks) / double(osd_ticks_per_second()) / double(m_telemetry_interval);
+	m_telemetry_ticks = now;
+
+	size_t used = telemetry_printf(buffer, capacity, 0, "{\"frame\":%llu,\"time\":%.6f,\"speed\":%.2f,\"frame_ms\":%.3f",
+			(unsigned long long)video().frame_update_count(), time().as_double(), video().speed_percent() * 100.0, frame_ms);
+
+	// cumulative host seconds by profiler category, when the profiler is running
+	if (g_profiler.enabled())
+	{
+		double const scale = 1.0 / double(osd_ticks_per_second());
+		used = telemetry_printf(buffer, capacity, used, ",\"profile\":{\"video\":%.6f,\"sound\":%.6f,\"input\":%.6f,\"timers\":%.6f,\"idle\":%.6f}",
+				double(g_profiler.ticks(PROFILER_VIDEO)) * scale,
+				double(g_profiler.ticks(PROFILER_SOUND)) * scale,
+				double(g_profiler.ticks(PROFILER_INPUT)) * scale,
+				double(g_profiler.ticks(PROFILER_TIMER_CALLBACK)) * scale,
+				double(g_profiler.ticks(PROFILER_IDLE)) * scale);
+	}
+
+	// cumulative scheduler counters for each executing device
+	m_scheduler.device_statistics(m_telemetry_devices);
+	used = telemetry_printf(buffer, capacity, used, ",\"devices\":[");
+	for (size_t i = 0; i < m_telemetry_devices.size(); i++)
+	{
+		device_scheduler::device_stats const &stats = m_telemetry_devices[i];
+		used = telemetry_printf(buffer, capacity, used, "%s{\"tag\":\"%s\",\"slices\":%llu,\"cycles\":%llu,\"aborts\":%llu,\"idle_cycles\":%llu}",
+				i ? "," : "", stats.device->device().tag(),
+				(unsigned long long)stats.timeslices, (unsigned long long)stats.cycles,
+				(unsigned long long)stats.aborts, (unsigned long long)stats.idle_cycles);
+	}
+	used = telemetry_printf(buffer, capacity, used, "]}");
+
+	// a frame that didn't fit would be broken JSON, so drop it
+	if (used < capacity)
+		m_manager.http()->commit_telemetry(used);
+}
+
+
+//-------------------------------------------------
+//  bench_start - start counting for the
+//  -bench_report summary
+//-------------------------------------------------
+
+void running_machine::bench_start()
+{
+	g_profiler.enable(true);
+	m_scheduler.set_statistics_enabled(true);
+	m_bench_ticks = osd_ticks();
+	m_bench_time = time();
+}
+
+
+//-------------------------------------------------
+//  bench_report - write where the host time went
+//  since bench_start as a JSON object; the
+//  per-subsystem times need a profiling build
+//-------------------------------------------------
+
+void running_machine::bench_report()
+{
+	double const scale = 1.0 / double(osd_ticks_per_second());
+	double const host = double(osd_ticks() - m_bench_ticks) * scale;
+	double const emulated = (time() - m_bench_time).as_double();
+
+	rapidjson::StringBuffer s;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+	writer.StartObject();
+	writer.Key("system");
+	writer.String(system().name);
+	writer.Key("playback");
+	writer.String(options().playback());
+	writer.Key("emulated");
+	writer.Double(emulated);
+	writer.Key("host");
+	writer.Double(host);
+	writer.Key("speed");
+	writer.Double((host > 0.0) ? (emulated * 100.0 / host) : 0.0);
+	writer.Key("peak_rss");
+	writer.Uint64(osd_get_peak_memory());
+
+	if (g_profiler.enabled())
+	{
+		static const struct { profile_type type; const char *name; } categories[] =
+		{
+			{ PROFILER_VIDEO,           "video" },
+			{ PROFILER_SOUND,           "sound" },
+			{ PROFILER_TIMER_CALLBACK,  "timers" },
+			{ PROFILER_INPUT,           "input" },
+			{ PROFILER_BLIT,            "render" },
+			{ PROFILER_DRC_COMPILE,     "drc_compile" },
+			{ PROFILER_MEMREAD,         "memory_read" },
+			{ PROFILER_MEMWRITE,        "memory_write" },
+			{ PROFILER_EXTRA,           "other" },
+			{ PROFILER_IDLE,            "idle" }
+		};
+		writer.Key("profile");
+		writer.StartObject();
+		for (auto const &category : categories)
+		{
+			writer.Key(category.name);
+			writer.Double(double(g_profiler.ticks(category.type)) * scale);
+		}
+		writer.EndObject();
+	}
+
+	// execution time comes from the profiler, the counts from the scheduler
+	m_scheduler.device_statistics(m_telemetry_devices);
+	device_iterator iter(root_device());
+	writer.Key("devices");
+	writer.StartArray();
+	for (device_scheduler::device_stats const &stats : m_telemetry_devices)
+	{
+		writer.StartObject();
+		writer.Key("tag");
+		writer.String(stats.device->device().tag());
+		if (g_profiler.enabled())
+		{
+			writer.Key("host");
+			writer.Double(double(g_profiler.ticks(profile_type(PROFILER_DEVICE_FIRST + iter.indexof(stats.device->device())))) * scale);
+		}
+		writer.Key("cycles");
+		writer.Uint64(stats.cycles);
+		writer.Key("slices");
+		writer.Uint64(stats.timeslices);
+		writer.Key("idle_cycles");
+		writer.Uint64(stats.idle_cycles);
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(options().bench_report()) != osd_file::error::NONE)
+	{
+		osd_printf_error("Unable to write benchmark report %s\n", options().bench_report());
+		return;
 	}
+	file.puts(s.GetString());
 }
 
 //**************************************************************************
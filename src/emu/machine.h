@@ -18,6 +18,7 @@
 #define MAME_EMU_MACHINE_H
 
 #include <functional>
+#include <mutex>
 
 #include <time.h>
 
@@ -44,6 +45,7 @@ enum machine_notification
 	MACHINE_NOTIFY_PAUSE,
 	MACHINE_NOTIFY_RESUME,
 	MACHINE_NOTIFY_EXIT,
+	MACHINE_NOTIFY_SAVE_COMPLETE,
 	MACHINE_NOTIFY_COUNT
 };
 
@@ -51,6 +53,7 @@ enum machine_notification
 // debug flags
 constexpr int DEBUG_FLAG_ENABLED        = 0x00000001;       // debugging is enabled
 constexpr int DEBUG_FLAG_CALL_HOOK      = 0x00000002;       // CPU cores must call instruction hook
+constexpr int DEBUG_FLAG_PROFILE        = 0x00000004;       // instruction hooks are being counted
 constexpr int DEBUG_FLAG_WPR_PROGRAM    = 0x00000010;       // watchpoints are enabled for PROGRAM memory reads
 constexpr int DEBUG_FLAG_WPR_DATA       = 0x00000020;       // watchpoints are enabled for DATA memory reads
 constexpr int DEBUG_FLAG_WPR_IO         = 0x00000040;       // watchpoints are enabled for IO memory reads
@@ -197,6 +200,8 @@ public:
 	const char *basename() const { return m_basename.c_str(); }
 	int sample_rate() const { return m_sample_rate; }
 	bool save_or_load_pending() const { return !m_saveload_pending_file.empty(); }
+	const std::string &last_save_file() const { return m_last_save_file; }
+	save_error last_save_error() const { return m_last_save_error; }
 
 	// RAII-based side effect disable
 	// NOP-ed when passed false, to make it more easily conditional
@@ -234,6 +239,18 @@ public:
 	bool rewind_step();
 	void rewind_invalidate();
 
+	// run-ahead
+	int runahead_frames() const { return m_runahead_frames; }
+	double runahead_cost() const { return double(m_runahead_cost) / double(osd_ticks_per_second()); }
+
+	// instance this process is running after a -fork split, or -1
+	int instance() const { return m_instance; }
+
+	// startup work that can wait until every device has started; with
+	// -async_start the tasks run on worker threads, otherwise one after
+	// another, and either way they're done before the first reset
+	void defer_start(device_t &device, std::string &&what, std::function<void ()> &&task);
+
 	// scheduled operations
 	void schedule_exit();
 	void schedule_hard_reset();
@@ -294,6 +311,16 @@ private:
 	void start();
 	void set_saveload_filename(std::string &&filename);
 	void handle_saveload();
+	void finish_async_save();
+	void runahead_start();
+	void runahead_frame();
+	bool runahead_run_frame();
+	void fork_start();
+	void fork_instances();
+	void fork_next_instance();
+	void publish_telemetry();
+	void bench_start();
+	void bench_report();
 	void soft_reset(void *ptr = nullptr, s32 param = 0);
 	std::string nvram_filename(device_t &device) const;
 	void nvram_load();
@@ -303,9 +330,15 @@ private:
 
 	// internal callbacks
 	void logfile_callback(const char *buffer);
+	static void *logfile_write_static(void *param, int threadid);
+	void logfile_close();
 
 	// internal device helpers
 	void start_all_devices();
+	void finish_deferred_starts();
+	static void *run_deferred_start(void *param, int threadid);
+	void startup_mark(std::string &&what, osd_ticks_t begin, osd_ticks_t end);
+	void startup_report();
 	void reset_all_devices();
 	void stop_all_devices();
 	void presave_all_devices();
@@ -332,6 +365,8 @@ private:
 	std::unique_ptr<image_manager> m_image;            // internal data from image.cpp
 	std::unique_ptr<rom_load_manager> m_rom_load;      // internal data from romload.cpp
 	std::unique_ptr<debugger_manager> m_debugger;      // internal data from debugger.cpp
+	std::unique_ptr<memory_tracer> m_memtrace;         // internal data from memtrace.cpp
+	std::unique_ptr<instruction_profiler> m_insnprof;  // internal data from insnprof.cpp
 
 	// system state
 	machine_phase           m_current_phase;        // current execution phase
@@ -347,6 +382,11 @@ private:
 	std::string             m_basename;             // basename used for game-related paths
 	int                     m_sample_rate;          // the digital audio sample rate
 	std::unique_ptr<emu_file>  m_logfile;              // pointer to the active log file
+	osd_work_queue *        m_logfile_queue;        // I/O queue writing the log file behind the emulation
+	std::mutex              m_logfile_lock;         // protects the pending text and write flag
+	std::string             m_logfile_pending;      // logged text not yet handed to the writer
+	std::string             m_logfile_batch;        // text being written by the writer
+	bool                    m_logfile_writing;      // a write is queued or in progress
 
 	// load/save management
 	enum class saveload_schedule
@@ -355,10 +395,49 @@ private:
 		SAVE,
 		LOAD
 	};
+	void report_saveload(saveload_schedule operation, osd_file::error filerr, save_error saverr);
 	saveload_schedule       m_saveload_schedule;
 	attotime                m_saveload_schedule_time;
 	std::string             m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
+	std::string             m_last_save_file;       // file most recently written in the background
+	save_error              m_last_save_error;      // and how that went
+
+	// run-ahead state
+	int                     m_runahead_frames;      // frames emulated ahead of the presented one, 0 if disabled
+	osd_ticks_t             m_runahead_cost;        // smoothed host ticks run-ahead adds to each frame
+	std::unique_ptr<ram_state> m_runahead_state;    // machine state at the end of the last real frame
+
+	// instance splitting state
+	int                     m_fork_count;           // instances still to be made, 0 once split or if disabled
+	attotime                m_fork_time;            // when to split
+	int                     m_instance;             // this instance, or -1
+	int                     m_fork_remaining;       // instances still to run one after another
+	std::unique_ptr<ram_state> m_fork_state;        // machine state at the split, if instances run one after another
+	bool                    m_fork_parent;          // did we hand everything off to child processes?
+	bool                    m_fork_failed;          // and did any of them fail?
+
+	// telemetry state
+	int                     m_telemetry_interval;   // frames between telemetry pushes, 0 if disabled
+	int                     m_telemetry_countdown;  // frames until the next push
+	osd_ticks_t             m_telemetry_ticks;      // osd_ticks at the last push
+	std::vector<device_scheduler::device_stats> m_telemetry_devices; // scratch for scheduler counters
+
+	// benchmark state
+	osd_ticks_t             m_bench_ticks;          // osd_ticks when the run loop started
+	attotime                m_bench_time;           // emulated time when the run loop started
+
+	// startup state
+	struct deferred_start
+	{
+		std::string             what;               // description for the timeline
+		std::function<void ()>  task;               // the work itself
+		osd_ticks_t             begin, end;         // when it ran
+		std::exception_ptr      error;              // what it threw, if anything
+	};
+	std::vector<std::unique_ptr<deferred_start>> m_deferred_starts; // tasks waiting for finish_deferred_starts
+	std::vector<std::pair<std::string, osd_ticks_t>> m_startup_timeline; // host time by startup step
+	osd_ticks_t             m_startup_ticks;        // osd_ticks when start() began
 
 	// notifier callbacks
 	struct notifier_callback_item
@@ -18,8 +18,28 @@ machine_manager::machine_manager(emu_options& options, osd_interface& osd)
 {
 }
 
+machine_manager::~machine_manager()
+{
+	// write the hashes back while the OSD layer is still up
+	if (m_romhash_cache)
+		m_romhash_cache->save();
+}
+
 void machine_manager::start_http_server()
 {
 	m_http = std::make_unique<http_manager>(options().http(), options().http_port(), options().http_root());
 }
 
+hash_cache &machine_manager::romhash_cache(emu_options &options)
+{
+	// start a new cache if the options now point somewhere else
+	std::lock_guard<std::mutex> lock(m_romhash_mutex);
+	if (m_romhash_cache && !m_romhash_cache->matches(options))
+	{
+		m_romhash_cache->save();
+		m_romhash_cache.reset();
+	}
+	if (!m_romhash_cache)
+		m_romhash_cache = std::make_unique<hash_cache>(options);
+	return *m_romhash_cache;
+}
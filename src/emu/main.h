@@ -16,6 +16,7 @@
 #ifndef MAME_EMU_MAIN_H
 #define MAME_EMU_MAIN_H
 
+#include <mutex>
 #include <thread>
 #include <time.h>
 
@@ -72,7 +73,7 @@ protected:
 	// construction/destruction
 	machine_manager(emu_options& options, osd_interface& osd);
 public:
-	virtual ~machine_manager() { }
+	virtual ~machine_manager();
 
 	osd_interface &osd() const { return m_osd; }
 	emu_options &options() const { return m_options; }
@@ -85,17 +86,22 @@ public:
 	virtual void create_custom(running_machine& machine) { }
 	virtual void load_cheatfiles(running_machine& machine) { }
 	virtual void ui_initialize(running_machine& machine) { }
+	virtual void instance_started(running_machine& machine) { }
 
 	virtual void update_machine() { }
 
 	http_manager *http() { return m_http.get(); }
 	void start_http_server();
 
+	hash_cache &romhash_cache(emu_options &options);
+
 protected:
 	osd_interface &               m_osd;                  // reference to OSD system
 	emu_options &                 m_options;              // reference to options
 	running_machine *             m_machine;
 	std::unique_ptr<http_manager> m_http;
+	std::unique_ptr<hash_cache>   m_romhash_cache;        // hashes of files in archives, once something audits
+	std::mutex                    m_romhash_mutex;        // protects m_romhash_cache
 };
 
 #endif // MAME_EMU_MAIN_H
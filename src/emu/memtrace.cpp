@@ -0,0 +1,355 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    memtrace.cpp
+
+    Memory access tracing via passthrough taps.
+
+    Taps are only installed over the requested ranges, so the rest of
+    the address map runs at full speed.  Each traced access claims a
+    slot in a bounded lock-free ring buffer; a background thread drains
+    the buffer to the trace file.  Accesses arriving while the buffer
+    is full are counted and dropped rather than stalling emulation.
+
+    The file starts with a header:
+        char[8]  "MAMETRCE"
+        u32      version (1)
+        u32      size of each record
+        u32      number of traced spaces
+    followed by one entry per space:
+        u8       data width in bits
+        s8       address shift
+        u16      length of the name
+        char[]   name, as device-tag:space-name
+    and then records in host byte order until the end of the file.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "memtrace.h"
+
+#include <chrono>
+
+
+//**************************************************************************
+//  MEMORY TRACER
+//**************************************************************************
+
+//-------------------------------------------------
+//  memory_tracer - constructor
+//-------------------------------------------------
+
+memory_tracer::memory_tracer(running_machine &machine)
+	: m_machine(machine)
+	, m_mask(0)
+	, m_enqueue_pos(0)
+	, m_dequeue_pos(0)
+	, m_dropped(0)
+	, m_enabled(false)
+	, m_stopping(false)
+{
+	// size the ring buffer to a power of two
+	u64 size = 1;
+	while (size < u64(std::max(machine.options().memtrace_buffer(), 1)))
+		size <<= 1;
+	m_slots = std::make_unique<slot []>(size);
+	for (u64 index = 0; index < size; index++)
+		m_slots[index].sequence.store(index, std::memory_order_relaxed);
+	m_mask = size - 1;
+
+	// open the output file
+	m_file = std::make_unique<emu_file>(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	osd_file::error const filerr = m_file->open(machine.options().memtrace());
+	if (filerr != osd_file::error::NONE)
+	{
+		osd_printf_error("Unable to open memory trace file %s\n", machine.options().memtrace());
+		m_file.reset();
+		return;
+	}
+
+	// install the taps, then describe what we installed
+	parse_ranges(machine.options().memtrace_ranges());
+	if (m_spaces.empty())
+		osd_printf_warning("Memory tracing enabled but no valid ranges were given\n");
+	write_header();
+
+	m_enabled = true;
+	m_writer = std::thread([this] () { writer_thread(); });
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&memory_tracer::stop, this));
+}
+
+
+//-------------------------------------------------
+//  ~memory_tracer - destructor
+//-------------------------------------------------
+
+memory_tracer::~memory_tracer()
+{
+	stop();
+}
+
+
+//-------------------------------------------------
+//  parse_ranges - install taps for each range in
+//  a comma-separated list of
+//  device:space:start-end[:rw] entries
+//-------------------------------------------------
+
+void memory_tracer::parse_ranges(const char *ranges)
+{
+	std::string const spec(ranges);
+	std::string::size_type start = 0;
+	while (start < spec.length())
+	{
+		std::string::size_type end = spec.find(',', start);
+		if (end == std::string::npos)
+			end = spec.length();
+		std::string entry(spec.substr(start, end - start));
+		start = end + 1;
+		if (entry.empty())
+			continue;
+
+		// the access type is optional and defaults to both
+		bool read = true, write = true;
+		std::string::size_type field = entry.find_last_of(':');
+		if ((field != std::string::npos) && (entry.find_first_not_of("rwRW", field + 1) == std::string::npos))
+		{
+			std::string const access(entry.substr(field + 1));
+			read = access.find_first_of("rR") != std::string::npos;
+			write = access.find_first_of("wW") != std::string::npos;
+			entry.resize(field);
+			field = entry.find_last_of(':');
+		}
+
+		// then the address range
+		offs_t addrstart, addrend;
+		if ((field == std::string::npos) || (sscanf(entry.c_str() + field + 1, "%x-%x", &addrstart, &addrend) != 2) || (addrend < addrstart))
+		{
+			osd_printf_error("Invalid memory trace range '%s'\n", entry.c_str());
+			continue;
+		}
+		entry.resize(field);
+
+		// and finally the device and space
+		field = entry.find_last_of(':');
+		if (field == std::string::npos)
+		{
+			osd_printf_error("Invalid memory trace range '%s'\n", entry.c_str());
+			continue;
+		}
+		std::string const spacename(entry.substr(field + 1));
+		entry.resize(field);
+		device_t *const device = machine().root_device().subdevice(entry.empty() ? ":" : entry.c_str());
+		device_memory_interface *memory;
+		if (!device || !device->interface(memory))
+		{
+			osd_printf_error("Memory trace device '%s' not found or has no address spaces\n", entry.c_str());
+			continue;
+		}
+
+		address_space *space = nullptr;
+		for (int spacenum = 0; !space && (spacenum < memory->max_space_count()); spacenum++)
+			if (memory->has_space(spacenum) && (spacename == memory->space(spacenum).name()))
+				space = &memory->space(spacenum);
+		if (!space)
+		{
+			osd_printf_error("Memory trace device '%s' has no space named '%s'\n", entry.c_str(), spacename.c_str());
+			continue;
+		}
+
+		// reuse the space's index if it's already being traced
+		size_t index = 0;
+		while ((index < m_spaces.size()) && (m_spaces[index].space != space))
+			index++;
+		if (index == m_spaces.size())
+		{
+			if (index > 0xff)
+			{
+				osd_printf_error("Too many traced memory spaces\n");
+				continue;
+			}
+			device_state_interface *state;
+			m_spaces.emplace_back(traced_space{ space, device->interface(state) ? state : nullptr });
+		}
+
+		// install taps that match the space's bus width
+		addrstart &= space->addrmask();
+		addrend &= space->addrmask();
+		switch (space->data_width())
+		{
+		case 8:     install<u8>(*space, u8(index), addrstart, addrend, read, write);    break;
+		case 16:    install<u16>(*space, u8(index), addrstart, addrend, read, write);   break;
+		case 32:    install<u32>(*space, u8(index), addrstart, addrend, read, write);   break;
+		case 64:    install<u64>(*space, u8(index), addrstart, addrend, read, write);   break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  install - install read and/or write taps over
+//  a range of a space
+//-------------------------------------------------
+
+template <typename T>
+void memory_tracer::install(address_space &space, u8 index, offs_t start, offs_t end, bool read, bool write)
+{
+	std::function<void (offs_t, T &, T)> const tapr = [this, index] (offs_t offset, T &data, T mem_mask) { record_access(index, offset, data, mem_mask, 0); };
+	std::function<void (offs_t, T &, T)> const tapw = [this, index] (offs_t offset, T &data, T mem_mask) { record_access(index, offset, data, mem_mask, FLAG_WRITE); };
+
+	if (read && write)
+		space.install_readwrite_tap(start, end, "memtrace", tapr, tapw);
+	else if (read)
+		space.install_read_tap(start, end, "memtrace", tapr);
+	else if (write)
+		space.install_write_tap(start, end, "memtrace", tapw);
+}
+
+
+//-------------------------------------------------
+//  record_access - claim a ring buffer slot for
+//  an access; safe to call from several threads
+//-------------------------------------------------
+
+void memory_tracer::record_access(u8 index, offs_t address, u64 data, u64 mem_mask, u8 flags)
+{
+	if (!m_enabled.load(std::memory_order_relaxed))
+		return;
+
+	// claim the next free slot, or give up if the buffer is full
+	u64 pos = m_enqueue_pos.load(std::memory_order_relaxed);
+	slot *target;
+	while (true)
+	{
+		target = &m_slots[pos & m_mask];
+		s64 const diff = s64(target->sequence.load(std::memory_order_acquire) - pos);
+		if (diff == 0)
+		{
+			if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+		{
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+		{
+			pos = m_enqueue_pos.load(std::memory_order_relaxed);
+		}
+	}
+
+	// fill it in and hand it to the writer
+	attotime const now = machine().time();
+	device_state_interface *const state = m_spaces[index].state;
+	record &entry = target->data;
+	entry.attoseconds = now.attoseconds();
+	entry.data = data;
+	entry.mem_mask = mem_mask;
+	entry.seconds = now.seconds();
+	entry.address = address;
+	entry.pc = state ? state->pcbase() : 0;
+	entry.space = index;
+	entry.flags = flags;
+	entry.reserved[0] = entry.reserved[1] = 0;
+	target->sequence.store(pos + 1, std::memory_order_release);
+}
+
+
+//-------------------------------------------------
+//  dequeue - take the oldest completed record
+//  from the ring buffer; writer thread only
+//-------------------------------------------------
+
+bool memory_tracer::dequeue(record &result)
+{
+	slot &source = m_slots[m_dequeue_pos & m_mask];
+	if (source.sequence.load(std::memory_order_acquire) != (m_dequeue_pos + 1))
+		return false;
+
+	result = source.data;
+	source.sequence.store(m_dequeue_pos + m_mask + 1, std::memory_order_release);
+	m_dequeue_pos++;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  write_header - describe the file format and
+//  traced spaces
+//-------------------------------------------------
+
+void memory_tracer::write_header()
+{
+	u32 const header[3] = { 1, u32(sizeof(record)), u32(m_spaces.size()) };
+	m_file->write("MAMETRCE", 8);
+	m_file->write(header, sizeof(header));
+	for (traced_space const &traced : m_spaces)
+	{
+		std::string const name = util::string_format("%s:%s", traced.space->device().tag(), traced.space->name());
+		u8 const width = traced.space->data_width();
+		s8 const shift = traced.space->addr_shift();
+		u16 const length = name.length();
+		m_file->write(&width, sizeof(width));
+		m_file->write(&shift, sizeof(shift));
+		m_file->write(&length, sizeof(length));
+		m_file->write(name.c_str(), length);
+	}
+}
+
+
+//-------------------------------------------------
+//  writer_thread - drain the ring buffer to the
+//  file until asked to stop
+//-------------------------------------------------
+
+void memory_tracer::writer_thread()
+{
+	std::vector<record> batch;
+	batch.reserve(4096);
+	while (true)
+	{
+		// read this before draining so nothing recorded before the stop is lost
+		bool const stopping = m_stopping.load(std::memory_order_acquire);
+
+		record entry;
+		while ((batch.size() < batch.capacity()) && dequeue(entry))
+			batch.push_back(entry);
+
+		if (!batch.empty())
+		{
+			m_file->write(&batch[0], batch.size() * sizeof(batch[0]));
+			batch.clear();
+		}
+		else if (stopping)
+		{
+			break;
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  stop - stop recording, flush what's buffered
+//  and close the file
+//-------------------------------------------------
+
+void memory_tracer::stop()
+{
+	if (!m_writer.joinable())
+		return;
+
+	m_enabled = false;
+	m_stopping.store(true, std::memory_order_release);
+	m_writer.join();
+	m_file.reset();
+
+	if (dropped() != 0)
+		osd_printf_warning("Memory trace dropped %llu accesses; consider a larger -memtrace_buffer\n", (unsigned long long)dropped());
+}
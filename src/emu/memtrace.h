@@ -0,0 +1,92 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+/***************************************************************************
+
+    memtrace.h
+
+    Memory access tracing via passthrough taps.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_MEMTRACE_H
+#define MAME_EMU_MEMTRACE_H
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> memory_tracer
+
+// records accesses to selected address ranges and streams them to a file
+class memory_tracer
+{
+public:
+	// a single recorded access, written to the file as-is
+	struct record
+	{
+		u64     attoseconds;    // emulated time, fractional part
+		u64     data;           // data read or written
+		u64     mem_mask;       // lanes involved in the access
+		u32     seconds;        // emulated time, whole seconds
+		u32     address;        // address within the space
+		u32     pc;             // PC of the space's device, if it has one
+		u8      space;          // index into the space table in the file header
+		u8      flags;          // FLAG_* values
+		u8      reserved[2];
+	};
+
+	static constexpr u8 FLAG_WRITE = 0x01;
+
+	// construction/destruction
+	memory_tracer(running_machine &machine);
+	~memory_tracer();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+	u64 dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+	// a slot in the ring buffer
+	struct slot
+	{
+		std::atomic<u64>    sequence;
+		record              data;
+	};
+
+	// a traced address space
+	struct traced_space
+	{
+		address_space *             space;
+		device_state_interface *    state;
+	};
+
+	// internal helpers
+	void parse_ranges(const char *ranges);
+	template <typename T> void install(address_space &space, u8 index, offs_t start, offs_t end, bool read, bool write);
+	void record_access(u8 index, offs_t address, u64 data, u64 mem_mask, u8 flags);
+	bool dequeue(record &result);
+	void write_header();
+	void writer_thread();
+	void stop();
+
+	// internal state
+	running_machine &           m_machine;          // reference to our machine
+	std::unique_ptr<emu_file>   m_file;             // output file
+	std::vector<traced_space>   m_spaces;           // spaces with taps installed
+	std::unique_ptr<slot []>    m_slots;            // ring buffer
+	u64                         m_mask;             // ring buffer size minus one
+	std::atomic<u64>            m_enqueue_pos;      // next slot to be claimed by a tap
+	u64                         m_dequeue_pos;      // next slot to be written out
+	std::atomic<u64>            m_dropped;          // accesses lost to a full buffer
+	std::atomic<bool>           m_enabled;          // flag: taps should record
+	std::atomic<bool>           m_stopping;         // flag: writer should drain and exit
+	std::thread                 m_writer;           // background file writer
+};
+
+#endif // MAME_EMU_MEMTRACE_H
@@ -23,6 +23,7 @@
 
 #include "emu.h"
 #include "profiler.h"
+#include "screen.h"
 
 
 
@@ -55,15 +56,331 @@ profiler_state g_profiler;
 
 
 //**************************************************************************
-//  DUMMY PROFILER STATE
+//  HELPERS
 //**************************************************************************
 
 //-------------------------------------------------
-//  dummy_profiler_state - constructor
+//  type_name - describe a non-device profile type
 //-------------------------------------------------
 
-dummy_profiler_state::dummy_profiler_state()
+static const char *type_name(profile_type type)
 {
+	static const profile_string names[] =
+	{
+		{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
+		{ PROFILER_MEM_REMAP,        "Memory Remapping" },
+		{ PROFILER_MEMREAD,          "Memory Read" },
+		{ PROFILER_MEMWRITE,         "Memory Write" },
+		{ PROFILER_VIDEO,            "Video Update" },
+		{ PROFILER_DRAWGFX,          "drawgfx" },
+		{ PROFILER_COPYBITMAP,       "copybitmap" },
+		{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
+		{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
+		{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
+		{ PROFILER_BLIT,             "OSD Blitting" },
+		{ PROFILER_SOUND,            "Sound Generation" },
+		{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
+		{ PROFILER_INPUT,            "Input Processing" },
+		{ PROFILER_MOVIE_REC,        "Movie Recording" },
+		{ PROFILER_LOGERROR,         "Error Logging" },
+		{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
+		{ PROFILER_USER1,            "User 1" },
+		{ PROFILER_USER2,            "User 2" },
+		{ PROFILER_USER3,            "User 3" },
+		{ PROFILER_USER4,            "User 4" },
+		{ PROFILER_USER5,            "User 5" },
+		{ PROFILER_USER6,            "User 6" },
+		{ PROFILER_USER7,            "User 7" },
+		{ PROFILER_USER8,            "User 8" },
+		{ PROFILER_PROFILER,         "Profiler" },
+		{ PROFILER_IDLE,             "Idle" }
+	};
+
+	for (auto &name : names)
+		if (name.type == type)
+			return name.string;
+	return nullptr;
+}
+
+
+
+//**************************************************************************
+//  SAMPLING PROFILER STATE
+//**************************************************************************
+
+//-------------------------------------------------
+//  sampling_profiler_state - constructor
+//-------------------------------------------------
+
+sampling_profiler_state::sampling_profiler_state()
+	: m_enabled(false)
+	, m_depth(0)
+	, m_exiting(false)
+	, m_text_time(attotime::never)
+{
+	for (stack_entry &entry : m_stack)
+	{
+		entry.type = PROFILER_TOTAL;
+		entry.name = nullptr;
+		entry.device = nullptr;
+	}
+	for (auto &data : m_data)
+		data = 0;
+}
+
+
+//-------------------------------------------------
+//  ~sampling_profiler_state - destructor
+//-------------------------------------------------
+
+sampling_profiler_state::~sampling_profiler_state()
+{
+	enable(false);
+}
+
+
+//-------------------------------------------------
+//  enable - start or stop sampling
+//-------------------------------------------------
+
+void sampling_profiler_state::enable(bool state)
+{
+	if (state == m_enabled)
+		return;
+
+	if (state)
+	{
+		// scopes already open never get pushed, and their stops find an empty stack
+		m_depth = 0;
+		for (auto &data : m_data)
+			data = 0;
+		m_text_time = attotime::never;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_hot.clear();
+			m_pc_entries.clear();
+			m_exiting = false;
+		}
+		m_enabled = true;
+		m_thread = std::thread([this] () { sampler(); });
+	}
+	else
+	{
+		m_enabled = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_exiting = true;
+		}
+		m_wakeup.notify_all();
+		m_thread.join();
+	}
+}
+
+
+//-------------------------------------------------
+//  text - return the current text in an std::string
+//-------------------------------------------------
+
+const char *sampling_profiler_state::text(running_machine &machine)
+{
+	// we only want to update the text periodically
+	attotime current_time = machine.scheduler().time();
+	if ((m_text_time == attotime::never) || ((current_time - m_text_time).as_double() >= TEXT_UPDATE_TIME))
+	{
+		update_text(machine);
+		m_text_time = current_time;
+	}
+	return m_text.c_str();
+}
+
+
+//-------------------------------------------------
+//  write_folded - write one line per distinct
+//  stack with its sample count
+//-------------------------------------------------
+
+bool sampling_profiler_state::write_folded(const char *filename)
+{
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(filename) != osd_file::error::NONE)
+		return false;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto const &stack : m_folded)
+		file.printf("%s %llu\n", stack.first.c_str(), (unsigned long long)stack.second);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  sampler - body of the sampling thread
+//-------------------------------------------------
+
+void sampling_profiler_state::sampler()
+{
+	osd_ticks_t last = osd_ticks();
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_wakeup.wait_for(lock, std::chrono::milliseconds(1), [this] () { return m_exiting; }))
+	{
+		osd_ticks_t const now = osd_ticks();
+		take_sample(now - last);
+		last = now;
+	}
+}
+
+
+//-------------------------------------------------
+//  take_sample - charge the time since the last
+//  sample to whatever's on the stack now; called
+//  with the lock held
+//-------------------------------------------------
+
+void sampling_profiler_state::take_sample(osd_ticks_t elapsed)
+{
+	unsigned const depth = std::min<unsigned>(m_depth.load(std::memory_order_acquire), STACK_DEPTH);
+
+	// outermost first, the way flame graphs want it
+	std::string stack;
+	int type = PROFILER_EXTRA;
+	device_t *device = nullptr;
+	for (unsigned index = 0; index < depth; index++)
+	{
+		stack_entry const &entry = m_stack[index];
+		type = entry.type.load(std::memory_order_relaxed);
+		const char *name = entry.name.load(std::memory_order_relaxed);
+		device_t *const current = entry.device.load(std::memory_order_relaxed);
+		if (current)
+			device = current;
+		if (!name)
+			name = type_name(profile_type(type));
+		if (!stack.empty())
+			stack.push_back(';');
+		stack.append(name ? name : "?");
+	}
+	if (type < PROFILER_DEVICE_FIRST || type > PROFILER_TOTAL)
+		type = PROFILER_EXTRA;
+	m_data[type].fetch_add(elapsed, std::memory_order_relaxed);
+	if (stack.empty())
+		stack = type_name(PROFILER_EXTRA);
+
+	// then the PC of the device that's executing, if it's where it can be read directly
+	u64 pc;
+	if (device && read_pc(*device, pc))
+	{
+		std::string const location = util::string_format("%s:%X", device->tag(), pc);
+		m_hot[location]++;
+		stack.push_back(';');
+		stack.append(location);
+	}
+	m_folded[stack]++;
+}
+
+
+//-------------------------------------------------
+//  read_pc - read a device's PC from this thread;
+//  only registers that are plain variables will
+//  do, and the read races the emulation, so it
+//  can be a few instructions stale
+//-------------------------------------------------
+
+bool sampling_profiler_state::read_pc(device_t &device, u64 &pc)
+{
+	auto found = m_pc_entries.find(&device);
+	if (found == m_pc_entries.end())
+	{
+		const device_state_entry *pcentry = nullptr;
+		device_state_interface *state;
+		if (device.interface(state))
+			for (auto const &entry : state->state_entries())
+				if (entry->index() == STATE_GENPCBASE && entry->direct())
+					pcentry = entry.get();
+		found = m_pc_entries.emplace(&device, pcentry).first;
+	}
+	const device_state_entry *const entry = found->second;
+	if (!entry)
+		return false;
+
+	void const *const data = entry->dataptr();
+	u64 value;
+	switch (entry->datasize())
+	{
+	case 1: value = *reinterpret_cast<u8 const volatile *>(data); break;
+	case 2: value = *reinterpret_cast<u16 const volatile *>(data); break;
+	case 4: value = *reinterpret_cast<u32 const volatile *>(data); break;
+	case 8: value = *reinterpret_cast<u64 const volatile *>(data); break;
+	default: return false;
+	}
+	pc = value & entry->datamask();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  update_text - summarise the samples since the
+//  last update
+//-------------------------------------------------
+
+void sampling_profiler_state::update_text(running_machine &machine)
+{
+	// the same breakdown as the instrumented profiler, from estimated ticks
+	osd_ticks_t data[PROFILER_TOTAL + 1];
+	u64 total = 0, normalize = 0;
+	for (profile_type curtype = PROFILER_DEVICE_FIRST; curtype < PROFILER_TOTAL; ++curtype)
+	{
+		data[curtype] = m_data[curtype].exchange(0, std::memory_order_relaxed);
+		total += data[curtype];
+		if (curtype < PROFILER_PROFILER)
+			normalize += data[curtype];
+	}
+	if (total == 0 || normalize == 0)
+	{
+		m_text.clear();
+		return;
+	}
+
+	device_iterator iter(machine.root_device());
+	std::ostringstream stream;
+	for (profile_type curtype = PROFILER_DEVICE_FIRST; curtype < PROFILER_TOTAL; ++curtype)
+	{
+		osd_ticks_t const computed = data[curtype];
+		if (computed != 0)
+		{
+			util::stream_format(stream, "%02d%% ", (int)((computed * 100 + total / 2) / total));
+			if (curtype < PROFILER_PROFILER)
+				util::stream_format(stream, "%02d%% ", (int)((computed * 100 + normalize / 2) / normalize));
+			if (curtype >= PROFILER_DEVICE_FIRST && curtype <= PROFILER_DEVICE_MAX)
+				util::stream_format(stream, "'%s'", iter.byindex(curtype - PROFILER_DEVICE_FIRST)->tag());
+			else
+				stream << type_name(curtype);
+			stream << '\n';
+		}
+	}
+
+	// followed by where the executing devices were most often found
+	std::vector<std::pair<std::string, u64>> hot;
+	u64 samples = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		hot.assign(m_hot.begin(), m_hot.end());
+		m_hot.clear();
+	}
+	for (auto const &location : hot)
+		samples += location.second;
+	size_t const count = std::min<size_t>(hot.size(), 8);
+	std::partial_sort(hot.begin(), hot.begin() + count, hot.end(), [] (auto const &a, auto const &b) { return a.second > b.second; });
+	if (count != 0)
+		stream << "Hottest PCs:\n";
+	for (size_t index = 0; index < count; index++)
+		util::stream_format(stream, "%02d%% %s\n", int((hot[index].second * 100 + samples / 2) / samples), hot[index].first);
+
+	// followed by the scheduler statistics, if they're being collected
+	stream << machine.scheduler().statistics_text();
+
+	// and how much the screens are being drawn piecemeal
+	for (screen_device &screen : screen_device_iterator(machine.root_device()))
+		stream << screen.partial_update_text();
+
+	m_text = stream.str();
 }
 
 
@@ -141,37 +458,6 @@ const char *real_profiler_state::text(running_machine &machine)
 
 void real_profiler_state::update_text(running_machine &machine)
 {
-	static const profile_string names[] =
-	{
-		{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
-		{ PROFILER_MEM_REMAP,        "Memory Remapping" },
-		{ PROFILER_MEMREAD,          "Memory Read" },
-		{ PROFILER_MEMWRITE,         "Memory Write" },
-		{ PROFILER_VIDEO,            "Video Update" },
-		{ PROFILER_DRAWGFX,          "drawgfx" },
-		{ PROFILER_COPYBITMAP,       "copybitmap" },
-		{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
-		{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
-		{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
-		{ PROFILER_BLIT,             "OSD Blitting" },
-		{ PROFILER_SOUND,            "Sound Generation" },
-		{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
-		{ PROFILER_INPUT,            "Input Processing" },
-		{ PROFILER_MOVIE_REC,        "Movie Recording" },
-		{ PROFILER_LOGERROR,         "Error Logging" },
-		{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
-		{ PROFILER_USER1,            "User 1" },
-		{ PROFILER_USER2,            "User 2" },
-		{ PROFILER_USER3,            "User 3" },
-		{ PROFILER_USER4,            "User 4" },
-		{ PROFILER_USER5,            "User 5" },
-		{ PROFILER_USER6,            "User 6" },
-		{ PROFILER_USER7,            "User 7" },
-		{ PROFILER_USER8,            "User 8" },
-		{ PROFILER_PROFILER,         "Profiler" },
-		{ PROFILER_IDLE,             "Idle" }
-	};
-
 	// compute the total time for all bits, not including profiler or idle
 	u64 computed = 0;
 	profile_type curtype;
@@ -213,19 +499,45 @@ void real_profiler_state::update_text(running_machine &machine)
 			if (curtype >= PROFILER_DEVICE_FIRST && curtype <= PROFILER_DEVICE_MAX)
 				util::stream_format(stream, "'%s'", iter.byindex(curtype - PROFILER_DEVICE_FIRST)->tag());
 			else
-				for (auto & name : names)
-					if (name.type == curtype)
-					{
-						stream << name.string;
-						break;
-					}
+				stream << type_name(curtype);
 
 			// followed by a carriage return
 			stream << '\n';
 		}
 	}
 
+	// followed by the scheduler statistics, if they're being collected
+	stream << machine.scheduler().statistics_text();
+
+	// and how much the screens are being drawn piecemeal
+	for (screen_device &screen : screen_device_iterator(machine.root_device()))
+		stream << screen.partial_update_text();
+
 	// reset data set to 0
 	memset(m_data, 0, sizeof(m_data));
 	m_text = stream.str();
 }
+
+
+//-------------------------------------------------
+//  write_folded - write the totals so far, one
+//  single-frame stack per type
+//-------------------------------------------------
+
+bool real_profiler_state::write_folded(const char *filename)
+{
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(filename) != osd_file::error::NONE)
+		return false;
+
+	for (profile_type curtype = PROFILER_DEVICE_FIRST; curtype < PROFILER_TOTAL; ++curtype)
+	{
+		if (m_data[curtype] == 0)
+			continue;
+		if (curtype <= PROFILER_DEVICE_MAX)
+			file.printf("device %d %llu\n", int(curtype - PROFILER_DEVICE_FIRST), (unsigned long long)m_data[curtype]);
+		else
+			file.printf("%s %llu\n", type_name(curtype), (unsigned long long)m_data[curtype]);
+	}
+	return true;
+}
@@ -19,6 +19,10 @@
 
     the profiler handles a FILO list so calls may be nested.
 
+    Builds with MAME_PROFILER defined time every scope exactly; the
+    others only keep a stack of scopes that a helper thread samples,
+    which is cheap enough to leave on while playing.
+
 ***************************************************************************/
 
 #ifndef MAME_EMU_PROFILER_H
@@ -26,6 +30,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -91,6 +100,7 @@ public:
 		return m_filoptr != nullptr;
 	}
 	const char *text(running_machine &machine);
+	osd_ticks_t ticks(profile_type type) const { return m_data[type]; }
 
 	// enable/disable
 	void enable(bool state = true)
@@ -102,9 +112,12 @@ public:
 	}
 
 	// start/stop
-	void start(profile_type type) { if (enabled()) real_start(type); }
+	void start(profile_type type, const char *name = nullptr, device_t *device = nullptr) { if (enabled()) real_start(type); }
 	void stop() { if (enabled()) real_stop(); }
 
+	// write the totals as single-frame stacks in flame graph format
+	bool write_folded(const char *filename);
+
 private:
 	void reset(bool enabled);
 	void update_text(running_machine &machine);
@@ -171,24 +184,86 @@ private:
 };
 
 
-// ======================> dummy_profiler_state
+// ======================> sampling_profiler_state
 
-class dummy_profiler_state
+class device_state_entry;
+
+
+// the default profiler: start()/stop() only maintain a small stack of tags,
+// and a helper thread samples it (plus the executing device's PC) every
+// millisecond to estimate where the time goes
+class sampling_profiler_state
 {
 public:
 	// construction/destruction
-	dummy_profiler_state();
+	sampling_profiler_state();
+	~sampling_profiler_state();
 
 	// getters
-	bool enabled() const { return false; }
-	const char *text(running_machine &machine) { return ""; }
+	bool enabled() const { return m_enabled; }
+	const char *text(running_machine &machine);
+	osd_ticks_t ticks(profile_type type) const { return m_data[type].load(std::memory_order_relaxed); }
 
 	// enable/disable
-	void enable(bool state = true) { }
+	void enable(bool state = true);
 
 	// start/stop
-	void start(profile_type type) { }
-	void stop() { }
+	void start(profile_type type, const char *name = nullptr, device_t *device = nullptr) { if (m_enabled) push(type, name, device); }
+	void stop() { if (m_enabled) pop(); }
+
+	// write the sampled stacks in the folded format flame graph tools take
+	bool write_folded(const char *filename);
+
+private:
+	static constexpr unsigned STACK_DEPTH = 32;
+
+	void push(profile_type type, const char *name, device_t *device)
+	{
+		unsigned const depth = m_depth.load(std::memory_order_relaxed);
+		if (depth < STACK_DEPTH)
+		{
+			m_stack[depth].type.store(type, std::memory_order_relaxed);
+			m_stack[depth].name.store(name, std::memory_order_relaxed);
+			m_stack[depth].device.store(device, std::memory_order_relaxed);
+		}
+		m_depth.store(depth + 1, std::memory_order_release);
+	}
+
+	void pop()
+	{
+		unsigned const depth = m_depth.load(std::memory_order_relaxed);
+		if (depth > 0)
+			m_depth.store(depth - 1, std::memory_order_relaxed);
+	}
+
+	void sampler();
+	void take_sample(osd_ticks_t elapsed);
+	bool read_pc(device_t &device, u64 &pc);
+	void update_text(running_machine &machine);
+
+	// a tag on the stack; the sampler reads these without stopping the emulation,
+	// so a sample can now and then see a frame that's just been replaced
+	struct stack_entry
+	{
+		std::atomic<int>            type;
+		std::atomic<const char *>   name;
+		std::atomic<device_t *>     device;
+	};
+
+	// internal state
+	bool                        m_enabled;                  // are tags being pushed?
+	std::atomic<unsigned>       m_depth;                    // tags on the stack, possibly more than fit
+	stack_entry                 m_stack[STACK_DEPTH];       // the stack itself
+	std::atomic<osd_ticks_t>    m_data[PROFILER_TOTAL + 1]; // estimated ticks per innermost type
+	std::thread                 m_thread;                   // sampling thread
+	std::mutex                  m_mutex;                    // protects the following
+	std::condition_variable     m_wakeup;                   // to stop the sampling thread promptly
+	bool                        m_exiting;                  // sampling thread should exit
+	std::unordered_map<std::string, u64> m_folded;          // samples by stack, for flame graphs
+	std::unordered_map<std::string, u64> m_hot;             // samples by device and PC since the last text update
+	std::unordered_map<device_t *, const device_state_entry *> m_pc_entries; // directly readable PCs, or null
+	std::string                 m_text;                     // profiler text
+	attotime                    m_text_time;                // profiler text last update
 };
 
 
@@ -197,7 +272,7 @@ public:
 #ifdef MAME_PROFILER
 typedef real_profiler_state profiler_state;
 #else
-typedef dummy_profiler_state profiler_state;
+typedef sampling_profiler_state profiler_state;
 #endif
 
 
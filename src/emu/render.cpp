@@ -525,6 +525,31 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 }
 
 
+//-------------------------------------------------
+//  reuse_scaled - add a reference to the scaled
+//  bitmap described by a previous get_scaled
+//  result, if it is still current
+//-------------------------------------------------
+
+bool render_texture::reuse_scaled(const render_texinfo &texinfo, render_primitive_list &primlist)
+{
+	// a change of identity has to be passed on by get_scaled
+	if (m_old_id != ~0ULL || texinfo.unique_id != m_id)
+		return false;
+
+	// only scaled bitmaps keep their sequence number from one frame to the next
+	for (scaled_texture &scaled : m_scaled)
+	{
+		if (scaled.bitmap != nullptr && scaled.seqid == texinfo.seqid && &scaled.bitmap->pix32(0) == texinfo.base)
+		{
+			primlist.add_reference(scaled.bitmap);
+			return true;
+		}
+	}
+	return false;
+}
+
+
 //-------------------------------------------------
 //  get_adjusted_palette - return the adjusted
 //  palette for a texture
@@ -681,6 +706,8 @@ void render_container::add_char(float x0, float y0, float height, float aspect,
 	newitem.m_texture = texture;
 	newitem.m_flags = PRIMFLAG_TEXORIENT(ROT0) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA) | PRIMFLAG_PACKABLE;
 	newitem.m_internal = INTERNAL_FLAG_CHAR;
+	newitem.m_font = &font;
+	newitem.m_char = ch;
 }
 
 
@@ -792,6 +819,8 @@ render_container::item &render_container::add_generic(u8 type, float x0, float y
 	newitem->m_internal = 0;
 	newitem->m_width = 0;
 	newitem->m_texture = nullptr;
+	newitem->m_font = nullptr;
+	newitem->m_char = 0;
 
 	// add the item to the container
 	return m_itemlist.append(*newitem);
@@ -938,6 +967,7 @@ template <typename T> render_target::render_target(render_manager &manager, T &&
 	, m_base_orientation(ROT0)
 	, m_maxtexwidth(65536)
 	, m_maxtexheight(65536)
+	, m_element_cache_view(nullptr)
 	, m_transform_container(true)
 {
 	// determine the base layer configuration based on options
@@ -1052,6 +1082,23 @@ void render_target::set_view(int viewindex)
 	layout_view *view = view_by_index(viewindex);
 	if (view)
 	{
+		// elements the new view doesn't show give up their textures and artwork until they're drawn again
+		if (m_curview && m_curview != view)
+		{
+			std::vector<layout_element *> shown;
+			for (item_layer layer = ITEM_LAYER_FIRST; layer < ITEM_LAYER_MAX; ++layer)
+				for (layout_view::item &curitem : view->items(layer))
+					if (curitem.element())
+						shown.push_back(curitem.element());
+			for (item_layer layer = ITEM_LAYER_FIRST; layer < ITEM_LAYER_MAX; ++layer)
+				for (layout_view::item &curitem : m_curview->items(layer))
+					if (curitem.element() && std::find(shown.begin(), shown.end(), curitem.element()) == shown.end())
+					{
+						curitem.element()->release_textures();
+						shown.push_back(curitem.element());
+					}
+		}
+
 		m_curview = view;
 		view->recompute(m_layerconfig);
 	}
@@ -1383,6 +1430,13 @@ render_primitive_list &render_target::get_primitives()
 	if (m_base_view == nullptr)
 		m_base_view = m_curview;
 
+	// cached element primitives belong to the view they were built for
+	if (m_element_cache_view != m_curview)
+	{
+		m_element_cache.clear();
+		m_element_cache_view = m_curview;
+	}
+
 	// switch to the next primitive list
 	render_primitive_list &list = m_primlist[m_listindex];
 	m_listindex = (m_listindex + 1) % ARRAY_LENGTH(m_primlist);
@@ -1438,7 +1492,7 @@ render_primitive_list &render_target::get_primitives()
 					if (curitem.screen() != nullptr)
 						add_container_primitives(list, root_xform, item_xform, curitem.screen()->container(), blendmode);
 					else
-						add_element_primitives(list, item_xform, *curitem.element(), curitem.state(), blendmode);
+						add_element_primitives(list, item_xform, *curitem.element(), curitem.state(), blendmode, m_element_cache[&curitem]);
 				}
 			}
 		}
@@ -2323,19 +2377,44 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 					width = std::min(width, m_maxtexwidth);
 					height = std::min(height, m_maxtexheight);
 
-					curitem.texture()->get_scaled(width, height, prim->texture, list, curitem.flags());
+					// text is drawn from the font's glyph atlas where possible, so a line of it shares one texture
+					render_texture *atlas = nullptr;
+					render_bounds atlas_uv;
+					u32 atlas_seqid = 0;
+					if ((curitem.internal() & INTERNAL_FLAG_CHAR) && m_maxtexwidth >= render_font::ATLAS_SIZE && m_maxtexheight >= render_font::ATLAS_SIZE)
+						atlas = curitem.font()->get_char_atlas_texture(curitem.character(), width, height, atlas_uv, atlas_seqid);
 
-					// set the palette
-					prim->texture.palette = curitem.texture()->get_adjusted_palette(container);
+					if (atlas != nullptr)
+					{
+						// the page only changes when a glyph is added to it, so don't let every use look like new data
+						atlas->get_scaled(render_font::ATLAS_SIZE, render_font::ATLAS_SIZE, prim->texture, list, curitem.flags());
+						prim->texture.seqid = atlas_seqid;
+						prim->texture.palette = atlas->get_adjusted_palette(container);
 
-					// determine UV coordinates
-					prim->texcoords = oriented_texcoords[finalorient];
+						// map the UV coordinates onto the glyph's cell
+						prim->texcoords = oriented_texcoords[finalorient];
+						for (render_texuv *uv : { &prim->texcoords.tl, &prim->texcoords.tr, &prim->texcoords.bl, &prim->texcoords.br })
+						{
+							uv->u = atlas_uv.x0 + uv->u * (atlas_uv.x1 - atlas_uv.x0);
+							uv->v = atlas_uv.y0 + uv->v * (atlas_uv.y1 - atlas_uv.y0);
+						}
+					}
+					else
+					{
+						curitem.texture()->get_scaled(width, height, prim->texture, list, curitem.flags());
+
+						// set the palette
+						prim->texture.palette = curitem.texture()->get_adjusted_palette(container);
+
+						// determine UV coordinates
+						prim->texcoords = oriented_texcoords[finalorient];
+					}
 
 					// apply clipping
 					clipped = render_clip_quad(&prim->bounds, &cliprect, &prim->texcoords);
 
 					// apply the final orientation from the quad flags and then build up the final flags
-					prim->flags |= (curitem.flags() & ~(PRIMFLAG_TEXORIENT_MASK | PRIMFLAG_BLENDMODE_MASK | PRIMFLAG_TEXFORMAT_MASK))
+					prim->flags |= (curitem.flags() & ~(PRIMFLAG_TEXORIENT_MASK | PRIMFLAG_BLENDMODE_MASK | PRIMFLAG_TEXFORMAT_MASK | (atlas ? PRIMFLAG_PACKABLE : 0)))
 						| PRIMFLAG_TEXORIENT(finalorient)
 						| PRIMFLAG_TEXFORMAT(curitem.texture()->format());
 					prim->flags |= blendmode != -1
@@ -2454,7 +2533,7 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 //  for an element in the current state
 //-------------------------------------------------
 
-void render_target::add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_element &element, int state, int blendmode)
+void render_target::add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_element &element, int state, int blendmode, element_cache &cache)
 {
 	// if we're out of range, bail
 	if (state > element.maxstate())
@@ -2466,6 +2545,29 @@ void render_target::add_element_primitives(render_primitive_list &list, const ob
 	render_texture *texture = element.state_texture(state);
 	if (texture != nullptr)
 	{
+		// most items look the same as last frame; if so, reuse the primitive
+		if (cache.texture == texture &&
+				cache.xoffs == xform.xoffs && cache.yoffs == xform.yoffs && cache.xscale == xform.xscale && cache.yscale == xform.yscale &&
+				cache.color.r == xform.color.r && cache.color.g == xform.color.g && cache.color.b == xform.color.b && cache.color.a == xform.color.a &&
+				cache.orientation == xform.orientation && cache.blendmode == blendmode &&
+				cache.targetbounds.x0 == m_bounds.x0 && cache.targetbounds.y0 == m_bounds.y0 && cache.targetbounds.x1 == m_bounds.x1 && cache.targetbounds.y1 == m_bounds.y1 &&
+				cache.maxtexwidth == m_maxtexwidth && cache.maxtexheight == m_maxtexheight &&
+				texture->reuse_scaled(cache.prim.texture, list))
+		{
+			if (!cache.clipped)
+			{
+				render_primitive *prim = list.alloc(render_primitive::QUAD);
+				prim->bounds = cache.prim.bounds;
+				prim->full_bounds = cache.prim.full_bounds;
+				prim->color = cache.prim.color;
+				prim->flags = cache.prim.flags | PRIMFLAG_UNCHANGED_MASK;
+				prim->texture = cache.prim.texture;
+				prim->texcoords = cache.prim.texcoords;
+				list.append(*prim);
+			}
+			return;
+		}
+
 		render_primitive *prim = list.alloc(render_primitive::QUAD);
 
 		// configure the basics
@@ -2498,6 +2600,26 @@ void render_target::add_element_primitives(render_primitive_list &list, const ob
 		prim->texcoords = oriented_texcoords[xform.orientation];
 		bool clipped = render_clip_quad(&prim->bounds, &cliprect, &prim->texcoords);
 
+		// remember what we built for next time
+		cache.texture = texture;
+		cache.xoffs = xform.xoffs;
+		cache.yoffs = xform.yoffs;
+		cache.xscale = xform.xscale;
+		cache.yscale = xform.yscale;
+		cache.color = xform.color;
+		cache.orientation = xform.orientation;
+		cache.blendmode = blendmode;
+		cache.targetbounds = m_bounds;
+		cache.maxtexwidth = m_maxtexwidth;
+		cache.maxtexheight = m_maxtexheight;
+		cache.clipped = clipped;
+		cache.prim.bounds = prim->bounds;
+		cache.prim.full_bounds = prim->full_bounds;
+		cache.prim.color = prim->color;
+		cache.prim.flags = prim->flags;
+		cache.prim.texture = prim->texture;
+		cache.prim.texcoords = prim->texcoords;
+
 		// add to the list or free if we're clipped out
 		list.append_or_return(*prim, clipped);
 	}
@@ -3029,8 +3151,15 @@ render_manager::render_manager(running_machine &machine)
 		m_ui_target(nullptr),
 		m_live_textures(0),
 		m_texture_id(0),
-		m_ui_container(global_alloc(render_container(*this)))
+		m_ui_container(global_alloc(render_container(*this))),
+		m_work_bands(std::max(machine.options().render_bands(), 1)),
+		m_work_queue(nullptr),
+		m_screen_allocator(nullptr)
 {
+	// software rendering and artwork resampling share the screen update band count
+	if (m_work_bands > 1)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// register callbacks
 	machine.configuration().config_register("video", config_load_delegate(&render_manager::config_load, this), config_save_delegate(&render_manager::config_save, this));
 
@@ -3052,6 +3181,9 @@ render_manager::~render_manager()
 
 	// better not be any outstanding textures when we die
 	assert(m_live_textures == 0);
+
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
 }
 
 
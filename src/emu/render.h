@@ -127,6 +127,9 @@ constexpr u32 PRIMFLAG_TYPE_QUAD = 1 << PRIMFLAG_TYPE_SHIFT;
 constexpr int PRIMFLAG_PACKABLE_SHIFT = 21;
 constexpr u32 PRIMFLAG_PACKABLE = 1 << PRIMFLAG_PACKABLE_SHIFT;
 
+constexpr int PRIMFLAG_UNCHANGED_SHIFT = 22;
+constexpr u32 PRIMFLAG_UNCHANGED_MASK = 1 << PRIMFLAG_UNCHANGED_SHIFT;
+
 //**************************************************************************
 //  MACROS
 //**************************************************************************
@@ -149,6 +152,10 @@ constexpr u32 PRIMFLAG_GET_SCREENTEX(u32 x) { return (x & PRIMFLAG_SCREENTEX_MAS
 constexpr u32 PRIMFLAG_TEXWRAP(u32 x)       { return x << PRIMFLAG_TEXWRAP_SHIFT; }
 constexpr u32 PRIMFLAG_GET_TEXWRAP(u32 x)   { return (x & PRIMFLAG_TEXWRAP_MASK) >> PRIMFLAG_TEXWRAP_SHIFT; }
 
+// set on a layout element primitive that is identical to the one its item produced in the previous list
+constexpr u32 PRIMFLAG_UNCHANGED(u32 x)     { return x << PRIMFLAG_UNCHANGED_SHIFT; }
+constexpr u32 PRIMFLAG_GET_UNCHANGED(u32 x) { return (x & PRIMFLAG_UNCHANGED_MASK) >> PRIMFLAG_UNCHANGED_SHIFT; }
+
 constexpr u32 PRIMFLAG_TEXSHADE(u32 x)      { return x << PRIMFLAG_TEXSHADE_SHIFT; }
 constexpr u32 PRIMFLAG_GET_TEXSHADE(u32 x)  { return (x & PRIMFLAG_TEXSHADE_MASK) >> PRIMFLAG_TEXSHADE_SHIFT; }
 
@@ -451,6 +458,7 @@ public:
 private:
 	// internal helpers
 	void get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo, render_primitive_list &primlist, u32 flags = 0);
+	bool reuse_scaled(const render_texinfo &texinfo, render_primitive_list &primlist);
 	const rgb_t *get_adjusted_palette(render_container &container);
 
 	static const int MAX_TEXTURE_SCALES = 16;
@@ -552,7 +560,7 @@ private:
 		friend class simple_list<item>;
 
 	public:
-		item() : m_next(nullptr), m_type(0), m_flags(0), m_internal(0), m_width(0), m_texture(nullptr) { }
+		item() : m_next(nullptr), m_type(0), m_flags(0), m_internal(0), m_width(0), m_texture(nullptr), m_font(nullptr), m_char(0) { }
 
 		// getters
 		item *next() const { return m_next; }
@@ -563,6 +571,8 @@ private:
 		u32 internal() const { return m_internal; }
 		float width() const { return m_width; }
 		render_texture *texture() const { return m_texture; }
+		render_font *font() const { return m_font; }
+		char32_t character() const { return m_char; }
 
 	private:
 		// internal state
@@ -574,6 +584,8 @@ private:
 		u32                 m_internal;         // internal flags
 		float               m_width;            // width of the line (lines only)
 		render_texture *    m_texture;          // pointer to the source texture (quads only)
+		render_font *       m_font;             // font the character comes from (chars only)
+		char32_t            m_char;             // character code (chars only)
 	};
 
 	// generic screen overlay scaler
@@ -648,6 +660,9 @@ public:
 	int maxstate() const { return m_maxstate; }
 	render_texture *state_texture(int state);
 
+	// operations
+	void release_textures();
+
 private:
 	/// \brief An image, rectangle, or disk in an element
 	///
@@ -676,6 +691,7 @@ private:
 
 		// operations
 		virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) = 0;
+		virtual void release_bitmaps() { }
 
 	protected:
 		// helpers
@@ -702,6 +718,7 @@ private:
 	class rect_component;
 	class disk_component;
 	class text_component;
+	class segment_component;
 	class led7seg_component;
 	class led8seg_gts1_component;
 	class led14seg_component;
@@ -1049,6 +1066,21 @@ private:
 	// private classes declared in render.cpp
 	struct object_transform;
 
+	// the last primitive built for a layout element item, and what it was built from
+	struct element_cache
+	{
+		render_texture *    texture = nullptr;  // state texture the primitive was built from
+		float               xoffs, yoffs;       // item transform
+		float               xscale, yscale;
+		render_color        color;
+		int                 orientation;
+		int                 blendmode;
+		render_bounds       targetbounds;       // target bounds and texture limits
+		int                 maxtexwidth, maxtexheight;
+		bool                clipped;            // primitive was clipped out entirely
+		render_primitive    prim;               // the primitive itself
+	};
+
 	// internal helpers
 	enum constructor_impl_t { CONSTRUCTOR_IMPL };
 	template <typename T> render_target(render_manager &manager, T&& layout, u32 flags, constructor_impl_t);
@@ -1060,7 +1092,7 @@ private:
 	bool load_layout_file(const char *dirname, const internal_layout &layout_data, device_t *device = nullptr);
 	bool load_layout_file(device_t &device, const char *dirname, util::xml::data_node const &rootnode);
 	void add_container_primitives(render_primitive_list &list, const object_transform &root_xform, const object_transform &xform, render_container &container, int blendmode);
-	void add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_element &element, int state, int blendmode);
+	void add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_element &element, int state, int blendmode, element_cache &cache);
 	bool map_point_internal(s32 target_x, s32 target_y, render_container *container, float &mapped_x, float &mapped_y, ioport_port *&mapped_input_port, ioport_value &mapped_input_mask);
 
 	// config callbacks
@@ -1107,6 +1139,8 @@ private:
 	int                     m_maxtexwidth;              // maximum width of a texture
 	int                     m_maxtexheight;             // maximum height of a texture
 	simple_list<render_container> m_debug_containers;   // list of debug containers
+	std::unordered_map<const layout_view::item *, element_cache> m_element_cache; // last primitive per element item
+	layout_view *           m_element_cache_view;       // view the element cache was built for
 	s32                     m_clear_extent_count;       // number of clear extents
 	s32                     m_clear_extents[MAX_CLEAR_EXTENTS]; // array of clear extents
 	bool                    m_transform_container;      // determines whether the screen container is transformed by the core renderer,
@@ -1116,6 +1150,20 @@ private:
 };
 
 
+// ======================> render_bitmap_allocator
+
+// lets an OSD renderer provide the memory screens draw into, so it can pass frames to the GPU without copying
+class render_bitmap_allocator
+{
+public:
+	virtual ~render_bitmap_allocator() = default;
+
+	// return nullptr for formats the renderer can't use directly; the memory needn't be cleared
+	virtual void *allocate(texture_format format, size_t bytes) = 0;
+	virtual void release(void *memory) = 0;
+};
+
+
 // ======================> render_manager
 
 // contains machine-global information and operations
@@ -1162,6 +1210,14 @@ public:
 	// reference tracking
 	void invalidate_all(void *refptr);
 
+	// memory for screen bitmaps, used by screens allocated after it's set
+	render_bitmap_allocator *screen_allocator() const { return m_screen_allocator; }
+	void set_screen_allocator(render_bitmap_allocator *allocator) { m_screen_allocator = allocator; }
+
+	// band-parallel software rendering and resampling
+	osd_work_queue *work_queue() const { return m_work_queue; }
+	int work_bands() const { return m_work_bands; }
+
 	// resolve tag lookups
 	void resolve_tags();
 
@@ -1189,6 +1245,12 @@ private:
 	// containers for the UI and for screens
 	render_container *              m_ui_container;     // UI container
 	simple_list<render_container>   m_screen_container_list; // list of containers for the screen
+
+	// band-parallel rendering
+	int                             m_work_bands;       // number of bands to split software rendering into
+	osd_work_queue *                m_work_queue;       // work queue for rendering bands
+
+	render_bitmap_allocator *       m_screen_allocator; // OSD-provided memory for screen bitmaps
 };
 
 #endif  // MAME_EMU_RENDER_H
@@ -11,9 +11,21 @@
 
 #include "emucore.h"
 #include "eminline.h"
+#include "osdcore.h"
 #include "video/rgbutil.h"
 #include "render.h"
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define RENDERSW_USE_SSE2 1
+#else
+#define RENDERSW_USE_SSE2 0
+#endif
+
 
 template<typename _PixelType, int _SrcShiftR, int _SrcShiftG, int _SrcShiftB, int _DstShiftR, int _DstShiftG, int _DstShiftB, bool _NoDestRead = false, bool _BilinearFilter = false>
 class software_renderer
@@ -28,6 +40,19 @@ private:
 		s32 endx, endy;
 	};
 
+	// one horizontal band of a banded draw
+	struct band_params
+	{
+		const render_primitive_list *primlist;
+		_PixelType *dstdata;
+		s32 width, height;
+		u32 pitch;
+		s32 top, bottom;
+	};
+
+	// bands shorter than this cost more to dispatch than they save
+	static constexpr u32 MIN_BAND_HEIGHT = 16;
+
 	// internal helpers
 	static inline bool is_opaque(float alpha) { return (alpha >= (_NoDestRead ? 0.5f : 1.0f)); }
 	static inline bool is_transparent(float alpha) { return (alpha < (_NoDestRead ? 0.5f : 0.0001f)); }
@@ -57,6 +82,60 @@ private:
 			return dest_assemble_rgb(source32_r(pixel), source32_g(pixel), source32_b(pixel));
 	}
 
+#if RENDERSW_USE_SSE2
+	// the vector blends work on four pixels at once, in MAME's own 32-bit layout only
+	static constexpr bool s_vector_blend = !_NoDestRead && (sizeof(_PixelType) == 4) &&
+			(_SrcShiftR == 0) && (_SrcShiftG == 0) && (_SrcShiftB == 0) && (_DstShiftR == 16) && (_DstShiftG == 8) && (_DstShiftB == 0);
+
+	// fetch four texels along a row
+	static inline __m128i get_texels_argb32(const render_texinfo &texture, s32 &curu, s32 &curv, s32 dudx, s32 dvdx)
+	{
+		u32 const pix0 = get_texel_argb32(texture, curu, curv); curu += dudx; curv += dvdx;
+		u32 const pix1 = get_texel_argb32(texture, curu, curv); curu += dudx; curv += dvdx;
+		u32 const pix2 = get_texel_argb32(texture, curu, curv); curu += dudx; curv += dvdx;
+		u32 const pix3 = get_texel_argb32(texture, curu, curv); curu += dudx; curv += dvdx;
+		return _mm_set_epi32(pix3, pix2, pix1, pix0);
+	}
+
+	// (src * ta + dst * (256 - ta)) >> 8 for two pixels unpacked to 16 bits; the sum can't pass 255 * 256
+	static inline __m128i blend_alpha_2(__m128i src, __m128i dst)
+	{
+		__m128i const alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i const invalpha = _mm_sub_epi16(_mm_set1_epi16(0x100), alpha);
+		return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, invalpha)), 8);
+	}
+
+	// (src * ta) >> 8 for two pixels unpacked to 16 bits
+	static inline __m128i scale_alpha_2(__m128i src)
+	{
+		__m128i const alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		return _mm_srli_epi16(_mm_mullo_epi16(src, alpha), 8);
+	}
+
+	// texels with zero alpha leave the destination alone; written pixels have zero alpha like dest_assemble_rgb
+	static inline __m128i merge_blended(__m128i src, __m128i dst, __m128i blended)
+	{
+		__m128i const transparent = _mm_cmpeq_epi32(_mm_srli_epi32(src, 24), _mm_setzero_si128());
+		blended = _mm_and_si128(blended, _mm_set1_epi32(0x00ffffff));
+		return _mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, blended));
+	}
+
+	static inline __m128i blend_alpha_4(__m128i src, __m128i dst)
+	{
+		__m128i const zero = _mm_setzero_si128();
+		__m128i const lo = blend_alpha_2(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+		__m128i const hi = blend_alpha_2(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+		return merge_blended(src, dst, _mm_packus_epi16(lo, hi));
+	}
+
+	static inline __m128i blend_add_4(__m128i src, __m128i dst)
+	{
+		__m128i const zero = _mm_setzero_si128();
+		__m128i const scaled = _mm_packus_epi16(scale_alpha_2(_mm_unpacklo_epi8(src, zero)), scale_alpha_2(_mm_unpackhi_epi8(src, zero)));
+		return merge_blended(src, dst, _mm_adds_epu8(scaled, dst));
+	}
+#endif
+
 
 	//-------------------------------------------------
 	//  ycc_to_rgb - convert YCC to RGB; the YCC pixel
@@ -337,10 +416,16 @@ private:
 	//  draw_line - draw a line or point
 	//-------------------------------------------------
 
-	static void draw_line(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_line(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 top, s32 bottom, u32 pitch)
 	{
-		// internal tables
-		static u32 s_cosine_table[2049];
+		// internal tables; bands may draw lines concurrently, so build it as a thread-safe static
+		static const std::array<u32, 2049> s_cosine_table = [] ()
+		{
+			std::array<u32, 2049> table;
+			for (int entry = 0; entry <= 2048; entry++)
+				table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+			return table;
+		}();
 
 		// compute the start/end coordinates
 		int x1 = int(prim.bounds.x0 * 65536.0f);
@@ -353,11 +438,6 @@ private:
 
 		if (PRIMFLAG_GET_ANTIALIAS(prim.flags))
 		{
-			// build up the cosine table if we haven't yet
-			if (s_cosine_table[0] == 0)
-				for (int entry = 0; entry <= 2048; entry++)
-					s_cosine_table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
-
 			int beam = prim.width * 65536.0f;
 			if (beam < 0x00010000)
 				beam = 0x00010000;
@@ -382,7 +462,7 @@ private:
 					{
 						dx = bwidth;    // init diameter of beam
 						dy = y1 >> 16;
-						if (dy >= 0 && dy < height)
+						if (dy >= top && dy < bottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(0xff & (~y1 >> 8), col));
 						dy++;
 						dx -= 0x10000 - (0xffff & y1); // take off amount plotted
@@ -390,11 +470,11 @@ private:
 						dx >>= 16;                   // adjust to pixel (solid) count
 						while (dx--)                 // plot rest of pixels
 						{
-							if (dy >= 0 && dy < height)
+							if (dy >= top && dy < bottom)
 								draw_aa_pixel(dstdata, pitch, x1, dy, col);
 							dy++;
 						}
-						if (dy >= 0 && dy < height)
+						if (dy >= top && dy < bottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(a1,col));
 					}
 					if (x1 == xx) break;
@@ -414,7 +494,7 @@ private:
 				x1 -= bwidth >> 1; // start back half the width
 				for (;;)
 				{
-					if (y1 >= 0 && y1 < height)
+					if (y1 >= top && y1 < bottom)
 					{
 						dy = bwidth;    // calc diameter of beam
 						dx = x1 >> 16;
@@ -457,7 +537,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (x1 == x2) break;
 					x1 += sx;
@@ -473,7 +553,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (y1 == y2) break;
 					y1 += sy;
@@ -498,7 +578,7 @@ private:
 	//  draw_rect - draw a solid rectangle
 	//-------------------------------------------------
 
-	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch, s32 top, s32 bottom)
 	{
 		render_bounds fpos = prim.bounds;
 		assert(fpos.x0 <= fpos.x1);
@@ -520,6 +600,10 @@ private:
 		if (endy < 0) endy = 0;
 		if (endy >= height) endy = height;
 
+		// and stay within the band
+		starty = std::max(starty, top);
+		endy = std::min(endy, bottom);
+
 		// bail if nothing left
 		if (fpos.x0 > fpos.x1 || fpos.y0 > fpos.y1)
 			return;
@@ -1422,8 +1506,21 @@ private:
 				// no lookup case
 				if (palbase == nullptr)
 				{
+					s32 x = setup.startx;
+#if RENDERSW_USE_SSE2
+					if (s_vector_blend)
+					{
+						for ( ; x + 4 <= endx; x += 4)
+						{
+							__m128i const pix = get_texels_argb32(prim.texture, curu, curv, dudx, dvdx);
+							_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), blend_alpha_4(pix, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest))));
+							dest += 4;
+						}
+					}
+#endif
+
 					// loop over cols
-					for (s32 x = setup.startx; x < endx; x++)
+					for ( ; x < endx; x++)
 					{
 						u32 pix = get_texel_argb32(prim.texture, curu, curv);
 						u32 ta = pix >> 24;
@@ -1691,8 +1788,21 @@ private:
 				// no lookup case
 				if (palbase == nullptr)
 				{
+					s32 x = setup.startx;
+#if RENDERSW_USE_SSE2
+					if (s_vector_blend)
+					{
+						for ( ; x + 4 <= endx; x += 4)
+						{
+							__m128i const pix = get_texels_argb32(prim.texture, curu, curv, dudx, dvdx);
+							_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), blend_add_4(pix, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest))));
+							dest += 4;
+						}
+					}
+#endif
+
 					// loop over cols
-					for (s32 x = setup.startx; x < endx; x++)
+					for ( ; x < endx; x++)
 					{
 						u32 pix = get_texel_argb32(prim.texture, curu, curv);
 						u32 ta = pix >> 24;
@@ -1825,7 +1935,7 @@ private:
 	//  drawing routine
 	//-------------------------------------------------
 
-	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch, s32 top, s32 bottom)
 	{
 		assert(prim.bounds.x0 <= prim.bounds.x1);
 		assert(prim.bounds.y0 <= prim.bounds.y1);
@@ -1872,6 +1982,16 @@ private:
 			setup.startv -= 0x8000;
 		}
 
+		// start rows above the band at the band, stepping U/V as if we had drawn down to it
+		if (setup.starty < top)
+		{
+			setup.startu += (top - setup.starty) * setup.dudy;
+			setup.startv += (top - setup.starty) * setup.dvdy;
+			setup.starty = top;
+		}
+		if (setup.endy > bottom)
+			setup.endy = bottom;
+
 		// render based on the texture coordinates
 		switch (prim.flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 		{
@@ -1926,35 +2046,84 @@ private:
 	}
 
 
-	//**************************************************************************
-	//  PRIMARY ENTRY POINT
-	//**************************************************************************
-
 	//-------------------------------------------------
-	//  draw_primitives - draw a series of primitives
-	//  using a software rasterizer
+	//  draw_band - draw the rows of a series of
+	//  primitives that fall in a band
 	//-------------------------------------------------
 
-public:
-	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
+	static void draw_band(const render_primitive_list &primlist, _PixelType *dstdata, s32 width, s32 height, u32 pitch, s32 top, s32 bottom)
 	{
 		// loop over the list and render each element
 		for (const render_primitive *prim = primlist.first(); prim != nullptr; prim = prim->next())
 			switch (prim->type)
 			{
 				case render_primitive::LINE:
-					draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+					draw_line(*prim, dstdata, width, top, bottom, pitch);
 					break;
 
 				case render_primitive::QUAD:
 					if (!prim->texture.base)
-						draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						draw_rect(*prim, dstdata, width, height, pitch, top, bottom);
 					else
-						setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						setup_and_draw_textured_quad(*prim, dstdata, width, height, pitch, top, bottom);
 					break;
 
 				default:
 					throw emu_fatalerror("Unexpected render_primitive type");
 			}
 	}
+
+	static void *draw_band_callback(void *param, int threadid)
+	{
+		const band_params &band = *reinterpret_cast<const band_params *>(param);
+		draw_band(*band.primlist, band.dstdata, band.width, band.height, band.pitch, band.top, band.bottom);
+		return nullptr;
+	}
+
+
+	//**************************************************************************
+	//  PRIMARY ENTRY POINT
+	//**************************************************************************
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives
+	//  using a software rasterizer
+	//-------------------------------------------------
+
+public:
+	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
+	{
+		draw_band(primlist, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch, 0, height);
+	}
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives
+	//  in horizontal bands on a work queue; every
+	//  band walks the whole list, so the results
+	//  match drawing it in one pass
+	//-------------------------------------------------
+
+	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, u32 width, u32 height, u32 pitch, osd_work_queue *queue, int bands)
+	{
+		u32 const count = (queue != nullptr && bands > 1) ? std::min<u32>(bands, height / MIN_BAND_HEIGHT) : 1;
+		if (count < 2)
+		{
+			draw_primitives(primlist, dstdata, width, height, pitch);
+			return;
+		}
+
+		std::vector<band_params> work(count);
+		for (u32 index = 0; index < count; index++)
+		{
+			work[index].primlist = &primlist;
+			work[index].dstdata = reinterpret_cast<_PixelType *>(dstdata);
+			work[index].width = width;
+			work[index].height = height;
+			work[index].pitch = pitch;
+			work[index].top = height * index / count;
+			work[index].bottom = height * (index + 1) / count;
+		}
+		osd_work_item_queue_multiple(queue, draw_band_callback, count, &work[0], sizeof(work[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+	}
 };
@@ -632,6 +632,9 @@ render_font::~render_font()
 			}
 			delete[] elem;
 		}
+
+	for (auto &page : m_atlas)
+		m_manager.texture_free(page->texture);
 }
 
 
@@ -804,6 +807,88 @@ render_texture *render_font::get_char_texture_and_bounds(float height, float asp
 }
 
 
+//-------------------------------------------------
+//  get_char_atlas_texture - return the atlas page
+//  holding a character scaled to the given size,
+//  and the texture coordinates of the character
+//  within it; returns nullptr if the character
+//  has to be drawn from its own texture
+//-------------------------------------------------
+
+render_texture *render_font::get_char_atlas_texture(char32_t chnum, s32 dwidth, s32 dheight, render_bounds &texcoords, u32 &seqid)
+{
+	// leave a texel of clear space around every glyph so filtering doesn't pick up its neighbours
+	if (dwidth < 1 || dheight < 1 || dwidth + 2 > ATLAS_SIZE || dheight + 2 > ATLAS_SIZE)
+		return nullptr;
+
+	u64 const key = (u64(dheight) << 48) | (u64(dwidth) << 32) | u64(chnum);
+	auto found = m_atlas_glyphs.find(key);
+	if (found == m_atlas_glyphs.end())
+	{
+		glyph &gl = get_char(chnum);
+		if (gl.texture == nullptr)
+			return nullptr;
+
+		// find a page of this height with room left, or start a new one
+		auto const fits = [dwidth, dheight] (atlas_page const &page)
+		{
+			if (page.curx + dwidth + 1 <= ATLAS_SIZE)
+				return true;
+			return page.cury + 2 * (dheight + 1) <= ATLAS_SIZE;
+		};
+		atlas_page *page = nullptr;
+		for (auto &p : m_atlas)
+		{
+			if (p->height == dheight && fits(*p))
+			{
+				page = p.get();
+				break;
+			}
+		}
+		if (page == nullptr)
+		{
+			if (m_atlas.size() >= MAX_ATLAS_PAGES)
+				return nullptr;
+
+			auto newpage = std::make_unique<atlas_page>();
+			newpage->bitmap.allocate(ATLAS_SIZE, ATLAS_SIZE);
+			newpage->bitmap.fill(0);
+			newpage->texture = m_manager.texture_alloc();
+			newpage->texture->set_bitmap(newpage->bitmap, newpage->bitmap.cliprect(), TEXFORMAT_ARGB32);
+			newpage->height = dheight;
+			newpage->curx = newpage->cury = 1;
+			newpage->seqid = 0;
+			page = newpage.get();
+			m_atlas.emplace_back(std::move(newpage));
+		}
+
+		// start a new row if this one is full
+		if (page->curx + dwidth + 1 > ATLAS_SIZE)
+		{
+			page->curx = 1;
+			page->cury += dheight + 1;
+		}
+
+		// scale the glyph straight into its cell
+		rectangle const rect(page->curx, page->curx + dwidth - 1, page->cury, page->cury + dheight - 1);
+		bitmap_argb32 cell(page->bitmap, rect);
+		render_texture::hq_scale(cell, gl.bitmap, gl.bitmap.cliprect(), nullptr);
+		page->curx += dwidth + 1;
+		page->seqid++;
+
+		found = m_atlas_glyphs.emplace(key, atlas_entry{ page, rect }).first;
+	}
+
+	atlas_entry const &entry = found->second;
+	texcoords.x0 = float(entry.rect.left()) * (1.0f / float(ATLAS_SIZE));
+	texcoords.y0 = float(entry.rect.top()) * (1.0f / float(ATLAS_SIZE));
+	texcoords.x1 = float(entry.rect.right() + 1) * (1.0f / float(ATLAS_SIZE));
+	texcoords.y1 = float(entry.rect.bottom() + 1) * (1.0f / float(ATLAS_SIZE));
+	seqid = entry.page->seqid;
+	return entry.page->texture;
+}
+
+
 //-------------------------------------------------
 //  get_scaled_bitmap_and_bounds - return a
 //  scaled bitmap and bounding rect for a char
@@ -13,6 +13,8 @@
 
 #include "render.h"
 
+#include <unordered_map>
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -41,8 +43,12 @@ public:
 
 	// texture/bitmap queries
 	render_texture *get_char_texture_and_bounds(float height, float aspect, char32_t ch, render_bounds &bounds);
+	render_texture *get_char_atlas_texture(char32_t chnum, s32 dwidth, s32 dheight, render_bounds &texcoords, u32 &seqid);
 	void get_scaled_bitmap_and_bounds(bitmap_argb32 &dest, float height, float aspect, char32_t chnum, rectangle &bounds);
 
+	// width and height of a glyph atlas page
+	static constexpr s32 ATLAS_SIZE = 512;
+
 private:
 	// a glyph describes a single glyph
 	class glyph
@@ -69,6 +75,23 @@ private:
 		rgb_t               color;
 	};
 
+	// a page of glyphs scaled to one height and packed into a shared texture
+	struct atlas_page
+	{
+		bitmap_argb32       bitmap;             // the packed glyphs
+		render_texture *    texture;            // texture wrapping the bitmap
+		s32                 height;             // scaled height of every glyph on the page
+		s32                 curx, cury;         // top,left of the next free cell
+		u32                 seqid;              // bumped whenever a glyph is added
+	};
+
+	// where a scaled glyph lives in the atlas
+	struct atlas_entry
+	{
+		atlas_page *        page;
+		rectangle           rect;
+	};
+
 	// internal format
 	enum class format
 	{
@@ -99,6 +122,8 @@ private:
 	std::vector<char>   m_rawdata;          // pointer to the raw data for the font
 	u64                 m_rawsize;          // size of the raw font data
 	std::unique_ptr<osd_font> m_osdfont;    // handle to the OSD font
+	std::vector<std::unique_ptr<atlas_page>> m_atlas;           // glyph atlas pages
+	std::unordered_map<u64, atlas_entry> m_atlas_glyphs;        // scaled glyphs by size and character
 
 	int                 m_height_cmd;       // height of the font, from ascent to descent
 	int                 m_yoffs_cmd;        // y offset from baseline to descent
@@ -107,6 +132,7 @@ private:
 
 	// constants
 	static const u64 CACHED_BDF_HASH_SIZE   = 1024;
+	static constexpr unsigned MAX_ATLAS_PAGES = 16;
 };
 
 void convert_command_glyph(std::string &s);
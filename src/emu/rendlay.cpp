@@ -25,6 +25,7 @@
 #include <cstdio>
 #include <cstring>
 #include <iomanip>
+#include <list>
 #include <locale>
 #include <sstream>
 #include <stdexcept>
@@ -1192,6 +1193,21 @@ render_texture *layout_element::state_texture(int state)
 }
 
 
+//-------------------------------------------------
+//  release_textures - free the state textures and
+//  any decoded artwork; both are recreated the
+//  next time the element is drawn
+//-------------------------------------------------
+
+void layout_element::release_textures()
+{
+	for (texture &elemtex : m_elemtex)
+		elemtex = texture();
+	for (component::ptr const &curcomp : m_complist)
+		curcomp->release_bitmaps();
+}
+
+
 //-------------------------------------------------
 //  element_scale - scale an element by rendering
 //  all the components at the appropriate
@@ -1244,7 +1260,13 @@ protected:
 			load_bitmap();
 
 		bitmap_argb32 destsub(dest, bounds);
-		render_resample_argb_bitmap_hq(destsub, m_bitmap, color());
+		render_resample_argb_bitmap_hq(destsub, m_bitmap, color(), false, machine.render().work_queue(), machine.render().work_bands());
+	}
+
+	virtual void release_bitmaps() override
+	{
+		// draw will load it again if needed
+		m_bitmap.reset();
 	}
 
 private:
@@ -1437,13 +1459,184 @@ private:
 };
 
 
+// LED segments or dots, each lit by one bit of the state
+class layout_element::segment_component : public component
+{
+public:
+	// construction/destruction
+	segment_component(environment &env, util::xml::data_node const &compnode, const char *dirname)
+		: component(env, compnode, dirname)
+	{
+	}
+
+protected:
+	// overrides
+	virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) override
+	{
+		// translucent colours blend with the destination as they resample, so draw those in full
+		if (color().a < 1.0f)
+		{
+			bitmap_argb32 tempbitmap;
+			draw_segments(tempbitmap, state);
+			render_resample_argb_bitmap_hq(dest, tempbitmap, color());
+			return;
+		}
+
+		// start from everything unlit, then add what each lit segment contributes
+		size_masks const &masks = find_masks(machine, dest.width(), dest.height());
+		for (int y = 0; y < dest.height(); y++)
+			std::copy_n(&masks.m_base.pix32(y), dest.width(), &dest.pix32(y));
+		for (int bit = 0; bit < masks.m_segments.size(); bit++)
+			if (BIT(state, bit))
+			{
+				segment_mask const &segment = masks.m_segments[bit];
+				u32 const *src = segment.m_pixels.data();
+				for (int y = segment.m_bounds.top(); y <= segment.m_bounds.bottom(); y++)
+				{
+					u32 *const d = &dest.pix32(y);
+					for (int x = segment.m_bounds.left(); x <= segment.m_bounds.right(); x++, src++)
+					{
+						rgb_t const pix(d[x]), add(*src);
+						d[x] = rgb_t(pix.a(), std::min(pix.r() + add.r(), 0xff), std::min(pix.g() + add.g(), 0xff), std::min(pix.b() + add.b(), 0xff));
+					}
+				}
+			}
+	}
+
+	virtual void release_bitmaps() override
+	{
+		// draw will build them again if needed
+		m_sizes.clear();
+	}
+
+	// draw the segments for a state at the component's own resolution
+	virtual void draw_segments(bitmap_argb32 &tempbitmap, int state) = 0;
+
+private:
+	// what lighting one segment adds at a given size, trimmed to the pixels it touches
+	struct segment_mask
+	{
+		rectangle           m_bounds;
+		std::vector<u32>    m_pixels;
+	};
+
+	// everything needed to compose any state at a given size
+	struct size_masks
+	{
+		int                 m_width;
+		int                 m_height;
+		bitmap_argb32       m_base;                     // all segments unlit
+		std::vector<segment_mask> m_segments;           // one per bit of the state
+	};
+
+	// one segment for the work queue to build
+	struct mask_job
+	{
+		segment_component * m_owner;
+		const bitmap_argb32 *m_unlit;                   // all segments unlit, at the component's own resolution
+		segment_mask *      m_mask;
+		int                 m_bit;
+		int                 m_width;
+		int                 m_height;
+	};
+
+	static constexpr unsigned MAX_MASK_SIZES = 4;       // sizes kept before the least recently used is dropped
+
+	// internal helpers
+	size_masks const &find_masks(running_machine &machine, int width, int height)
+	{
+		for (auto it = m_sizes.begin(); m_sizes.end() != it; ++it)
+		{
+			if (it->m_width == width && it->m_height == height)
+			{
+				m_sizes.splice(m_sizes.begin(), m_sizes, it);
+				return m_sizes.front();
+			}
+		}
+		if (m_sizes.size() >= MAX_MASK_SIZES)
+			m_sizes.pop_back();
+		m_sizes.emplace_front();
+		size_masks &masks = m_sizes.front();
+		masks.m_width = width;
+		masks.m_height = height;
+
+		// every pixel is drawn last by a single segment or by none, so any state is the
+		// unlit drawing plus the difference each of its lit bits makes on its own
+		bitmap_argb32 unlit;
+		draw_segments(unlit, 0);
+		int bits = 0;
+		while ((1 << bits) <= maxstate())
+			bits++;
+		masks.m_segments.resize(bits);
+		std::vector<mask_job> jobs(bits);
+		for (int bit = 0; bit < bits; bit++)
+			jobs[bit] = mask_job{ this, &unlit, &masks.m_segments[bit], bit, width, height };
+
+		// build the segments on the render work queue while the unlit base resamples here
+		osd_work_queue *const queue = machine.render().work_queue();
+		if (queue != nullptr && bits != 0)
+			osd_work_item_queue_multiple(queue, build_mask, bits, &jobs[0], sizeof(jobs[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		masks.m_base.allocate(width, height);
+		render_resample_argb_bitmap_hq(masks.m_base, unlit, color());
+		if (queue != nullptr && bits != 0)
+			osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+		else
+			for (mask_job &job : jobs)
+				build_mask(&job, 0);
+		return masks;
+	}
+
+	static void *build_mask(void *param, int threadid)
+	{
+		mask_job const &job = *reinterpret_cast<mask_job const *>(param);
+
+		// keep only what lighting the segment adds; lit pens are brighter than unlit ones with the same alpha
+		bitmap_argb32 lit;
+		job.m_owner->draw_segments(lit, 1 << job.m_bit);
+		for (int y = 0; y < lit.height(); y++)
+		{
+			u32 *const d = &lit.pix32(y);
+			u32 const *const s = &job.m_unlit->pix32(y);
+			for (int x = 0; x < lit.width(); x++)
+			{
+				rgb_t const on(d[x]), off(s[x]);
+				d[x] = rgb_t(0, std::max(on.r() - off.r(), 0), std::max(on.g() - off.g(), 0), std::max(on.b() - off.b(), 0));
+			}
+		}
+		bitmap_argb32 scaled(job.m_width, job.m_height);
+		render_resample_argb_bitmap_hq(scaled, lit, job.m_owner->color());
+
+		// trim to the pixels it touches
+		rectangle bounds(job.m_width, -1, job.m_height, -1);
+		for (int y = 0; y < scaled.height(); y++)
+			for (int x = 0; x < scaled.width(); x++)
+				if (scaled.pix32(y, x) & 0x00ffffff)
+				{
+					bounds.min_x = std::min(bounds.min_x, x);
+					bounds.max_x = std::max(bounds.max_x, x);
+					bounds.min_y = std::min(bounds.min_y, y);
+					bounds.max_y = std::max(bounds.max_y, y);
+				}
+		job.m_mask->m_bounds = bounds;
+		job.m_mask->m_pixels.clear();
+		if (!bounds.empty())
+			for (int y = bounds.top(); y <= bounds.bottom(); y++)
+				job.m_mask->m_pixels.insert(job.m_mask->m_pixels.end(), &scaled.pix32(y, bounds.left()), &scaled.pix32(y, bounds.right()) + 1);
+		return nullptr;
+	}
+
+	// internal state
+	std::list<size_masks> m_sizes;                      // most recently used first
+};
+
+
 // 7-segment LCD
-class layout_element::led7seg_component : public component
+class layout_element::led7seg_component : public segment_component
 {
 public:
 	// construction/destruction
 	led7seg_component(environment &env, util::xml::data_node const &compnode, const char *dirname)
-		: component(env, compnode, dirname)
+		: segment_component(env, compnode, dirname)
 	{
 	}
 
@@ -1451,7 +1644,7 @@ protected:
 	// overrides
 	virtual int maxstate() const override { return 255; }
 
-	virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) override
+	virtual void draw_segments(bitmap_argb32 &tempbitmap, int state) override
 	{
 		const rgb_t onpen = rgb_t(0xff,0xff,0xff,0xff);
 		const rgb_t offpen = rgb_t(0xff,0x20,0x20,0x20);
@@ -1462,8 +1655,8 @@ protected:
 		int segwidth = 40;
 		int skewwidth = 40;
 
-		// allocate a temporary bitmap for drawing
-		bitmap_argb32 tempbitmap(bmwidth + skewwidth, bmheight);
+		// allocate the bitmap for drawing
+		tempbitmap.allocate(bmwidth + skewwidth, bmheight);
 		tempbitmap.fill(rgb_t(0xff,0x00,0x00,0x00));
 
 		// top bar
@@ -1492,20 +1685,17 @@ protected:
 
 		// decimal point
 		draw_segment_decimal(tempbitmap, bmwidth + segwidth/2, bmheight - segwidth/2, segwidth, BIT(state, 7) ? onpen : offpen);
-
-		// resample to the target size
-		render_resample_argb_bitmap_hq(dest, tempbitmap, color());
 	}
 };
 
 
 // 8-segment fluorescent (Gottlieb System 1)
-class layout_element::led8seg_gts1_component : public component
+class layout_element::led8seg_gts1_component : public segment_component
 {
 public:
 	// construction/destruction
 	led8seg_gts1_component(environment &env, util::xml::data_node const &compnode, const char *dirname)
-		: component(env, compnode, dirname)
+		: segment_component(env, compnode, dirname)
 	{
 	}
 
@@ -1513,7 +1703,7 @@ protected:
 	// overrides
 	virtual int maxstate() const override { return 255; }
 
-	virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) override
+	virtual void draw_segments(bitmap_argb32 &tempbitmap, int state) override
 	{
 		const rgb_t onpen = rgb_t(0xff,0xff,0xff,0xff);
 		const rgb_t offpen = rgb_t(0xff,0x20,0x20,0x20);
@@ -1525,8 +1715,8 @@ protected:
 		int segwidth = 40;
 		int skewwidth = 40;
 
-		// allocate a temporary bitmap for drawing
-		bitmap_argb32 tempbitmap(bmwidth + skewwidth, bmheight);
+		// allocate the bitmap for drawing
+		tempbitmap.allocate(bmwidth + skewwidth, bmheight);
 		tempbitmap.fill(backpen);
 
 		// top bar
@@ -1560,20 +1750,17 @@ protected:
 
 		// apply skew
 		apply_skew(tempbitmap, 40);
-
-		// resample to the target size
-		render_resample_argb_bitmap_hq(dest, tempbitmap, color());
 	}
 };
 
 
 // 14-segment LCD
-class layout_element::led14seg_component : public component
+class layout_element::led14seg_component : public segment_component
 {
 public:
 	// construction/destruction
 	led14seg_component(environment &env, util::xml::data_node const &compnode, const char *dirname)
-		: component(env, compnode, dirname)
+		: segment_component(env, compnode, dirname)
 	{
 	}
 
@@ -1581,7 +1768,7 @@ protected:
 	// overrides
 	virtual int maxstate() const override { return 16383; }
 
-	virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) override
+	virtual void draw_segments(bitmap_argb32 &tempbitmap, int state) override
 	{
 		const rgb_t onpen = rgb_t(0xff, 0xff, 0xff, 0xff);
 		const rgb_t offpen = rgb_t(0xff, 0x20, 0x20, 0x20);
@@ -1592,8 +1779,8 @@ protected:
 		int segwidth = 40;
 		int skewwidth = 40;
 
-		// allocate a temporary bitmap for drawing
-		bitmap_argb32 tempbitmap(bmwidth + skewwidth, bmheight);
+		// allocate the bitmap for drawing
+		tempbitmap.allocate(bmwidth + skewwidth, bmheight);
 		tempbitmap.fill(rgb_t(0xff, 0x00, 0x00, 0x00));
 
 		// top bar
@@ -1672,20 +1859,17 @@ protected:
 
 		// apply skew
 		apply_skew(tempbitmap, 40);
-
-		// resample to the target size
-		render_resample_argb_bitmap_hq(dest, tempbitmap, color());
 	}
 };
 
 
 // 16-segment LCD
-class layout_element::led16seg_component : public component
+class layout_element::led16seg_component : public segment_component
 {
 public:
 	// construction/destruction
 	led16seg_component(environment &env, util::xml::data_node const &compnode, const char *dirname)
-		: component(env, compnode, dirname)
+		: segment_component(env, compnode, dirname)
 	{
 	}
 
@@ -1693,7 +1877,7 @@ protected:
 	// overrides
 	virtual int maxstate() const override { return 65535; }
 
-	virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) override
+	virtual void draw_segments(bitmap_argb32 &tempbitmap, int state) override
 	{
 		const rgb_t onpen = rgb_t(0xff, 0xff, 0xff, 0xff);
 		const rgb_t offpen = rgb_t(0xff, 0x20, 0x20, 0x20);
@@ -1704,8 +1888,8 @@ protected:
 		int segwidth = 40;
 		int skewwidth = 40;
 
-		// allocate a temporary bitmap for drawing
-		bitmap_argb32 tempbitmap(bmwidth + skewwidth, bmheight);
+		// allocate the bitmap for drawing
+		tempbitmap.allocate(bmwidth + skewwidth, bmheight);
 		tempbitmap.fill(rgb_t(0xff, 0x00, 0x00, 0x00));
 
 		// top-left bar
@@ -1794,20 +1978,17 @@ protected:
 
 		// apply skew
 		apply_skew(tempbitmap, 40);
-
-		// resample to the target size
-		render_resample_argb_bitmap_hq(dest, tempbitmap, color());
 	}
 };
 
 
 // 14-segment LCD with semicolon (2 extra segments)
-class layout_element::led14segsc_component : public component
+class layout_element::led14segsc_component : public segment_component
 {
 public:
 	// construction/destruction
 	led14segsc_component(environment &env, util::xml::data_node const &compnode, const char *dirname)
-		: component(env, compnode, dirname)
+		: segment_component(env, compnode, dirname)
 	{
 	}
 
@@ -1815,7 +1996,7 @@ protected:
 	// overrides
 	virtual int maxstate() const override { return 65535; }
 
-	virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) override
+	virtual void draw_segments(bitmap_argb32 &tempbitmap, int state) override
 	{
 		const rgb_t onpen = rgb_t(0xff, 0xff, 0xff, 0xff);
 		const rgb_t offpen = rgb_t(0xff, 0x20, 0x20, 0x20);
@@ -1826,8 +2007,8 @@ protected:
 		int segwidth = 40;
 		int skewwidth = 40;
 
-		// allocate a temporary bitmap for drawing, adding some extra space for the tail
-		bitmap_argb32 tempbitmap(bmwidth + skewwidth, bmheight + segwidth);
+		// allocate the bitmap for drawing, adding some extra space for the tail
+		tempbitmap.allocate(bmwidth + skewwidth, bmheight + segwidth);
 		tempbitmap.fill(rgb_t(0xff, 0x00, 0x00, 0x00));
 
 		// top bar
@@ -1915,20 +2096,17 @@ protected:
 
 		// decimal point
 		draw_segment_decimal(tempbitmap, bmwidth + segwidth/2, bmheight - segwidth/2, segwidth, (state & (1 << 14)) ? onpen : offpen);
-
-		// resample to the target size
-		render_resample_argb_bitmap_hq(dest, tempbitmap, color());
 	}
 };
 
 
 // 16-segment LCD with semicolon (2 extra segments)
-class layout_element::led16segsc_component : public component
+class layout_element::led16segsc_component : public segment_component
 {
 public:
 	// construction/destruction
 	led16segsc_component(environment &env, util::xml::data_node const &compnode, const char *dirname)
-		: component(env, compnode, dirname)
+		: segment_component(env, compnode, dirname)
 	{
 	}
 
@@ -1936,7 +2114,7 @@ protected:
 	// overrides
 	virtual int maxstate() const override { return 262143; }
 
-	virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) override
+	virtual void draw_segments(bitmap_argb32 &tempbitmap, int state) override
 	{
 		const rgb_t onpen = rgb_t(0xff, 0xff, 0xff, 0xff);
 		const rgb_t offpen = rgb_t(0xff, 0x20, 0x20, 0x20);
@@ -1947,8 +2125,8 @@ protected:
 		int segwidth = 40;
 		int skewwidth = 40;
 
-		// allocate a temporary bitmap for drawing
-		bitmap_argb32 tempbitmap(bmwidth + skewwidth, bmheight + segwidth);
+		// allocate the bitmap for drawing
+		tempbitmap.allocate(bmwidth + skewwidth, bmheight + segwidth);
 		tempbitmap.fill(rgb_t(0xff, 0x00, 0x00, 0x00));
 
 		// top-left bar
@@ -2046,20 +2224,17 @@ protected:
 
 		// apply skew
 		apply_skew(tempbitmap, 40);
-
-		// resample to the target size
-		render_resample_argb_bitmap_hq(dest, tempbitmap, color());
 	}
 };
 
 
 // row of dots for a dotmatrix
-class layout_element::dotmatrix_component : public component
+class layout_element::dotmatrix_component : public segment_component
 {
 public:
 	// construction/destruction
 	dotmatrix_component(int dots, environment &env, util::xml::data_node const &compnode, const char *dirname)
-		: component(env, compnode, dirname)
+		: segment_component(env, compnode, dirname)
 		, m_dots(dots)
 	{
 	}
@@ -2068,7 +2243,7 @@ protected:
 	// overrides
 	virtual int maxstate() const override { return (1 << m_dots) - 1; }
 
-	virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) override
+	virtual void draw_segments(bitmap_argb32 &tempbitmap, int state) override
 	{
 		const rgb_t onpen = rgb_t(0xff, 0xff, 0xff, 0xff);
 		const rgb_t offpen = rgb_t(0xff, 0x20, 0x20, 0x20);
@@ -2077,15 +2252,12 @@ protected:
 		int bmheight = 300;
 		int dotwidth = 250;
 
-		// allocate a temporary bitmap for drawing
-		bitmap_argb32 tempbitmap(dotwidth*m_dots, bmheight);
+		// allocate the bitmap for drawing
+		tempbitmap.allocate(dotwidth*m_dots, bmheight);
 		tempbitmap.fill(rgb_t(0xff, 0x00, 0x00, 0x00));
 
 		for (int i = 0; i < m_dots; i++)
 			draw_segment_decimal(tempbitmap, ((dotwidth / 2) + (i * dotwidth)), bmheight / 2, dotwidth, BIT(state, i) ? onpen : offpen);
-
-		// resample to the target size
-		render_resample_argb_bitmap_hq(dest, tempbitmap, color());
 	}
 
 private:
@@ -2189,6 +2361,12 @@ public:
 protected:
 	// overrides
 	virtual int maxstate() const override { return 65535; }
+	virtual void release_bitmaps() override
+	{
+		// symbols with a file are loaded again when they're next drawn
+		for (bitmap_argb32 &bitmap : m_bitmap)
+			bitmap.reset();
+	}
 	virtual void draw(running_machine &machine, bitmap_argb32 &dest, const rectangle &bounds, int state) override
 	{
 		if (m_beltreel)
@@ -15,13 +15,51 @@
 
 #include "jpeglib.h"
 
+#include <algorithm>
+
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define RENDUTIL_USE_SSE2 1
+#else
+#define RENDUTIL_USE_SSE2 0
+#endif
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* bands shorter than this cost more to dispatch than they save */
+static constexpr u32 RESAMPLE_MIN_BAND_HEIGHT = 16;
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* one band of rows of a resample */
+struct resample_band
+{
+	u32 *dest;
+	u32 drowpixels, dwidth, dheight;
+	const u32 *source;
+	u32 srowpixels, swidth, sheight;
+	const render_color *color;
+	u32 dx, dy;
+	u32 ystart, yend;
+	bool average;
+};
+
+
+
 /***************************************************************************
     FUNCTION PROTOTYPES
 ***************************************************************************/
 
 /* utilities */
-static void resample_argb_bitmap_average(u32 *dest, u32 drowpixels, u32 dwidth, u32 dheight, const u32 *source, u32 srowpixels, u32 swidth, u32 sheight, const render_color &color, u32 dx, u32 dy);
-static void resample_argb_bitmap_bilinear(u32 *dest, u32 drowpixels, u32 dwidth, u32 dheight, const u32 *source, u32 srowpixels, u32 swidth, u32 sheight, const render_color &color, u32 dx, u32 dy);
+static void *resample_band_callback(void *param, int threadid);
+static void resample_argb_bitmap_average(u32 *dest, u32 drowpixels, u32 dwidth, u32 dheight, const u32 *source, u32 srowpixels, u32 swidth, u32 sheight, const render_color &color, u32 dx, u32 dy, u32 ystart, u32 yend);
+static void resample_argb_bitmap_bilinear(u32 *dest, u32 drowpixels, u32 dwidth, u32 dheight, const u32 *source, u32 srowpixels, u32 swidth, u32 sheight, const render_color &color, u32 dx, u32 dy, u32 ystart, u32 yend);
 static bool copy_png_alpha_to_bitmap(bitmap_argb32 &bitmap, const png_info &png);
 
 
@@ -32,10 +70,11 @@ static bool copy_png_alpha_to_bitmap(bitmap_argb32 &bitmap, const png_info &png)
 
 /*-------------------------------------------------
     render_resample_argb_bitmap_hq - perform a high
-    quality resampling of a texture
+    quality resampling of a texture, optionally
+    split into bands of rows run on a work queue
 -------------------------------------------------*/
 
-void render_resample_argb_bitmap_hq(bitmap_argb32 &dest, bitmap_argb32 &source, const render_color &color, bool force)
+void render_resample_argb_bitmap_hq(bitmap_argb32 &dest, bitmap_argb32 &source, const render_color &color, bool force, osd_work_queue *queue, int bands)
 {
 	if (dest.width() == 0 || dest.height() == 0)
 		return;
@@ -52,10 +91,54 @@ void render_resample_argb_bitmap_hq(bitmap_argb32 &dest, bitmap_argb32 &source,
 	u32 dy = (sheight << 12) / dheight;
 
 	/* if the source is higher res than the target, use full averaging */
-	if (dx > 0x1000 || dy > 0x1000 || force)
-		resample_argb_bitmap_average(&dest.pix(0), dest.rowpixels(), dwidth, dheight, sbase, source.rowpixels(), swidth, sheight, color, dx, dy);
+	resample_band band;
+	band.dest = &dest.pix(0);
+	band.drowpixels = dest.rowpixels();
+	band.dwidth = dwidth;
+	band.dheight = dheight;
+	band.source = sbase;
+	band.srowpixels = source.rowpixels();
+	band.swidth = swidth;
+	band.sheight = sheight;
+	band.color = &color;
+	band.dx = dx;
+	band.dy = dy;
+	band.ystart = 0;
+	band.yend = dheight;
+	band.average = (dx > 0x1000 || dy > 0x1000 || force);
+
+	/* each band owns its rows of the destination, so they can run concurrently */
+	u32 const count = (queue != nullptr && bands > 1) ? std::min<u32>(bands, dheight / RESAMPLE_MIN_BAND_HEIGHT) : 1;
+	if (count < 2)
+	{
+		resample_band_callback(&band, 0);
+		return;
+	}
+
+	std::vector<resample_band> work(count, band);
+	for (u32 index = 0; index < count; index++)
+	{
+		work[index].ystart = dheight * index / count;
+		work[index].yend = dheight * (index + 1) / count;
+	}
+	osd_work_item_queue_multiple(queue, resample_band_callback, count, &work[0], sizeof(work[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+}
+
+
+/*-------------------------------------------------
+    resample_band_callback - resample one band of
+    rows
+-------------------------------------------------*/
+
+static void *resample_band_callback(void *param, int threadid)
+{
+	const resample_band &band = *reinterpret_cast<const resample_band *>(param);
+	if (band.average)
+		resample_argb_bitmap_average(band.dest, band.drowpixels, band.dwidth, band.dheight, band.source, band.srowpixels, band.swidth, band.sheight, *band.color, band.dx, band.dy, band.ystart, band.yend);
 	else
-		resample_argb_bitmap_bilinear(&dest.pix(0), dest.rowpixels(), dwidth, dheight, sbase, source.rowpixels(), swidth, sheight, color, dx, dy);
+		resample_argb_bitmap_bilinear(band.dest, band.drowpixels, band.dwidth, band.dheight, band.source, band.srowpixels, band.swidth, band.sheight, *band.color, band.dx, band.dy, band.ystart, band.yend);
+	return nullptr;
 }
 
 
@@ -65,7 +148,7 @@ void render_resample_argb_bitmap_hq(bitmap_argb32 &dest, bitmap_argb32 &source,
     all contributing pixels
 -------------------------------------------------*/
 
-static void resample_argb_bitmap_average(u32 *dest, u32 drowpixels, u32 dwidth, u32 dheight, const u32 *source, u32 srowpixels, u32 swidth, u32 sheight, const render_color &color, u32 dx, u32 dy)
+static void resample_argb_bitmap_average(u32 *dest, u32 drowpixels, u32 dwidth, u32 dheight, const u32 *source, u32 srowpixels, u32 swidth, u32 sheight, const render_color &color, u32 dx, u32 dy, u32 ystart, u32 yend)
 {
 	u64 sumscale = u64(dx) * u64(dy);
 	u32 r, g, b, a;
@@ -77,8 +160,13 @@ static void resample_argb_bitmap_average(u32 *dest, u32 drowpixels, u32 dwidth,
 	b = color.b * color.a * 256.0f;
 	a = color.a * 256.0f;
 
+#if RENDUTIL_USE_SSE2
+	/* a row of contributions fits in 32 bits per channel as long as it spans fewer than 4096 source pixels */
+	bool const vector = (dx >> 12) < 4096;
+#endif
+
 	/* loop over the target vertically */
-	for (y = 0; y < dheight; y++)
+	for (y = ystart; y < yend; y++)
 	{
 		u32 starty = y * dy;
 
@@ -92,39 +180,84 @@ static void resample_argb_bitmap_average(u32 *dest, u32 drowpixels, u32 dwidth,
 
 			u32 yremaining = dy;
 
-			/* accumulate all source pixels that contribute to this pixel */
-			for (cury = starty; yremaining; cury += ychunk)
+#if RENDUTIL_USE_SSE2
+			if (vector)
 			{
-				u32 xremaining = dx;
-
-				/* determine the Y contribution, clamping to the amount remaining */
-				ychunk = 0x1000 - (cury & 0xfff);
-				if (ychunk > yremaining)
-					ychunk = yremaining;
-				yremaining -= ychunk;
-
-				/* loop over all source pixels in the X direction */
-				for (curx = startx; xremaining; curx += xchunk)
+				/* weight each row by X, then the row sums by Y in 64 bits; b/r accumulate in even lanes, g/a in odd */
+				__m128i const zero = _mm_setzero_si128();
+				__m128i sumeven = zero, sumodd = zero;
+				for (cury = starty; yremaining; cury += ychunk)
 				{
-					u32 factor;
-
-					/* determine the X contribution, clamping to the amount remaining */
-					xchunk = 0x1000 - (curx & 0xfff);
-					if (xchunk > xremaining)
-						xchunk = xremaining;
-					xremaining -= xchunk;
-
-					/* total contribution = x * y */
-					factor = xchunk * ychunk;
-
-					/* fetch the source pixel */
-					rgb_t pix = source[(cury >> 12) * srowpixels + (curx >> 12)];
+					u32 xremaining = dx;
+					const u32 *srcrow = &source[(cury >> 12) * srowpixels];
+					__m128i rowsum = zero;
+
+					ychunk = 0x1000 - (cury & 0xfff);
+					if (ychunk > yremaining)
+						ychunk = yremaining;
+					yremaining -= ychunk;
+
+					for (curx = startx; xremaining; curx += xchunk)
+					{
+						xchunk = 0x1000 - (curx & 0xfff);
+						if (xchunk > xremaining)
+							xchunk = xremaining;
+						xremaining -= xchunk;
+
+						__m128i const pix = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(srcrow[curx >> 12]), zero), zero);
+						rowsum = _mm_add_epi32(rowsum, _mm_madd_epi16(pix, _mm_set1_epi32(xchunk)));
+					}
+
+					__m128i const yweight = _mm_set1_epi32(ychunk);
+					sumeven = _mm_add_epi64(sumeven, _mm_mul_epu32(rowsum, yweight));
+					sumodd = _mm_add_epi64(sumodd, _mm_mul_epu32(_mm_srli_epi64(rowsum, 32), yweight));
+				}
 
-					/* accumulate the RGBA values */
-					sumr += factor * pix.r();
-					sumg += factor * pix.g();
-					sumb += factor * pix.b();
-					suma += factor * pix.a();
+				u64 sums[4];
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&sums[0]), sumeven);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&sums[2]), sumodd);
+				sumb = sums[0];
+				sumr = sums[1];
+				sumg = sums[2];
+				suma = sums[3];
+			}
+			else
+#endif
+			{
+				/* accumulate all source pixels that contribute to this pixel */
+				for (cury = starty; yremaining; cury += ychunk)
+				{
+					u32 xremaining = dx;
+
+					/* determine the Y contribution, clamping to the amount remaining */
+					ychunk = 0x1000 - (cury & 0xfff);
+					if (ychunk > yremaining)
+						ychunk = yremaining;
+					yremaining -= ychunk;
+
+					/* loop over all source pixels in the X direction */
+					for (curx = startx; xremaining; curx += xchunk)
+					{
+						u32 factor;
+
+						/* determine the X contribution, clamping to the amount remaining */
+						xchunk = 0x1000 - (curx & 0xfff);
+						if (xchunk > xremaining)
+							xchunk = xremaining;
+						xremaining -= xchunk;
+
+						/* total contribution = x * y */
+						factor = xchunk * ychunk;
+
+						/* fetch the source pixel */
+						rgb_t pix = source[(cury >> 12) * srowpixels + (curx >> 12)];
+
+						/* accumulate the RGBA values */
+						sumr += factor * pix.r();
+						sumg += factor * pix.g();
+						sumb += factor * pix.b();
+						suma += factor * pix.a();
+					}
 				}
 			}
 
@@ -156,7 +289,7 @@ static void resample_argb_bitmap_average(u32 *dest, u32 drowpixels, u32 dwidth,
     sampling via a bilinear filter
 -------------------------------------------------*/
 
-static void resample_argb_bitmap_bilinear(u32 *dest, u32 drowpixels, u32 dwidth, u32 dheight, const u32 *source, u32 srowpixels, u32 swidth, u32 sheight, const render_color &color, u32 dx, u32 dy)
+static void resample_argb_bitmap_bilinear(u32 *dest, u32 drowpixels, u32 dwidth, u32 dheight, const u32 *source, u32 srowpixels, u32 swidth, u32 sheight, const render_color &color, u32 dx, u32 dy, u32 ystart, u32 yend)
 {
 	u32 maxx = swidth << 12, maxy = sheight << 12;
 	u32 r, g, b, a;
@@ -168,8 +301,14 @@ static void resample_argb_bitmap_bilinear(u32 *dest, u32 drowpixels, u32 dwidth,
 	b = color.b * color.a * 256.0f;
 	a = color.a * 256.0f;
 
+#if RENDUTIL_USE_SSE2
+	/* the vector path scales in 16 bits and doesn't blend with the destination */
+	bool const vector = (a == 256) && (r <= 256) && (g <= 256) && (b <= 256);
+	__m128i const scale = _mm_set_epi16(0, 0, 0, 0, a, r, g, b);
+#endif
+
 	/* loop over the target vertically */
-	for (y = 0; y < dheight; y++)
+	for (y = ystart; y < yend; y++)
 	{
 		u32 starty = y * dy;
 
@@ -207,6 +346,29 @@ static void resample_argb_bitmap_bilinear(u32 *dest, u32 drowpixels, u32 dwidth,
 			curx &= 0xfff;
 			cury &= 0xfff;
 
+#if RENDUTIL_USE_SSE2
+			if (vector)
+			{
+				/* interleave left and right pixels per channel and weight them by X with madd */
+				__m128i const zero = _mm_setzero_si128();
+				__m128i const xweight = _mm_set1_epi32((curx << 16) | (0x1000 - curx));
+				__m128i const top = _mm_madd_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pix0), _mm_cvtsi32_si128(pix1)), zero), xweight);
+				__m128i const bottom = _mm_madd_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pix2), _mm_cvtsi32_si128(pix3)), zero), xweight);
+
+				/* weight the two rows by Y; the sums fit in 32 bits but the products need 64-bit lanes */
+				__m128i const yweight0 = _mm_set1_epi32(0x1000 - cury);
+				__m128i const yweight1 = _mm_set1_epi32(cury);
+				__m128i const even = _mm_add_epi64(_mm_mul_epu32(top, yweight0), _mm_mul_epu32(bottom, yweight1));
+				__m128i const odd = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(top, 32), yweight0), _mm_mul_epu32(_mm_srli_epi64(bottom, 32), yweight1));
+				__m128i sum = _mm_or_si128(_mm_srli_epi64(even, 24), _mm_slli_epi64(_mm_srli_epi64(odd, 24), 32));
+
+				/* apply scaling and store */
+				sum = _mm_srli_epi16(_mm_mullo_epi16(_mm_packs_epi32(sum, zero), scale), 8);
+				dest[y * drowpixels + x] = _mm_cvtsi128_si32(_mm_packus_epi16(sum, zero));
+				continue;
+			}
+#endif
+
 			/* contributions from pixel 0 (top,left) */
 			factor = (0x1000 - curx) * (0x1000 - cury);
 			sumr = factor * pix0.r();
@@ -0,0 +1,222 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles, MAME contributors
+/***************************************************************************
+
+    resampler.cpp
+
+    Sample rate conversion for sound stream inputs.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "resampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+// the filter loop has an SSE2 path under the same conditions as rgbutil.h
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define RESAMPLER_USE_SSE2  1
+#else
+#define RESAMPLER_USE_SSE2  0
+#endif
+
+
+namespace {
+
+//-------------------------------------------------
+//  bessel_i0 - zeroth order modified Bessel
+//  function of the first kind, for the Kaiser
+//  window
+//-------------------------------------------------
+
+double bessel_i0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 50 && term > sum * 1e-12; k++)
+	{
+		double const half = x / (2.0 * k);
+		term *= half * half;
+		sum += term;
+	}
+	return sum;
+}
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  SOUND RESAMPLER
+//**************************************************************************
+
+//-------------------------------------------------
+//  sound_resampler - constructor; builds the
+//  filter bank for converting between the rates
+//-------------------------------------------------
+
+sound_resampler::sound_resampler(u32 source_rate, u32 dest_rate)
+	: m_source_rate(source_rate)
+	, m_dest_rate(dest_rate)
+{
+	// when downsampling, the cutoff drops to the destination's Nyquist rate and the filter widens to match
+	double const ratio = (dest_rate < source_rate) ? double(dest_rate) / double(source_rate) : 1.0;
+	u32 const taps = 2 * u32(std::ceil(ZERO_CROSSINGS / ratio));
+	m_taps = std::min<u32>((taps + 3) & ~3, MAX_TAPS);
+
+	// lowpass a little under Nyquist so the Kaiser window's transition band stays out of the alias region
+	double const cutoff = 0.91 * ratio;
+	double const beta = 8.0;
+	double const window_scale = 1.0 / bessel_i0(beta);
+	double const half_width = m_taps / 2;
+
+	// tap j of phase p weights the source sample (j - history()) places from the current one
+	m_coefs.resize((PHASES + 1) * m_taps);
+	for (u32 phase = 0; phase <= PHASES; phase++)
+	{
+		float *const row = &m_coefs[phase * m_taps];
+		double sum = 0.0;
+		for (u32 tap = 0; tap < m_taps; tap++)
+		{
+			double const t = double(s32(tap) - s32(history())) - double(phase) / PHASES;
+			double const u = t / half_width;
+			double const window = (std::fabs(u) < 1.0) ? bessel_i0(beta * std::sqrt(1.0 - u * u)) * window_scale : 0.0;
+			double const x = M_PI * cutoff * t;
+			double const sinc = (t == 0.0) ? 1.0 : std::sin(x) / x;
+			row[tap] = float(cutoff * sinc * window);
+			sum += row[tap];
+		}
+
+		// normalise each phase for unity gain at DC
+		for (u32 tap = 0; tap < m_taps; tap++)
+			row[tap] = float(row[tap] / sum);
+	}
+}
+
+
+//-------------------------------------------------
+//  resample - convert through the polyphase
+//  filter bank, taking the nearest phase for
+//  each destination sample
+//-------------------------------------------------
+
+void sound_resampler::resample(const stream_sample_t *source, u32 frac, u32 step, stream_sample_t *dest, u32 count, s64 gain) const
+{
+	u32 const taps = m_taps;
+	float const *const coefs = &m_coefs[0];
+	float const scale = float(gain) * (1.0f / 256.0f);
+
+	source -= history();
+	while (count--)
+	{
+		float const *const row = coefs + ((frac + (1 << (FRAC_BITS - PHASE_BITS - 1))) >> (FRAC_BITS - PHASE_BITS)) * taps;
+#if RESAMPLER_USE_SSE2
+		__m128 sum = _mm_setzero_ps();
+		for (u32 tap = 0; tap < taps; tap += 4)
+		{
+			__m128 const samples = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + tap)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(samples, _mm_loadu_ps(row + tap)));
+		}
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+		float const sample = _mm_cvtss_f32(sum);
+#else
+		float sample = 0.0f;
+		for (u32 tap = 0; tap < taps; tap++)
+			sample += float(source[tap]) * row[tap];
+#endif
+		*dest++ = stream_sample_t(std::lrint(sample * scale));
+
+		// advance
+		frac += step;
+		source += frac >> FRAC_BITS;
+		frac &= FRAC_MASK;
+	}
+}
+
+
+//-------------------------------------------------
+//  resample_linear - the original converter:
+//  point samples with blending at boundaries
+//  when upsampling, box filtering when
+//  downsampling, a straight copy otherwise
+//-------------------------------------------------
+
+void sound_resampler::resample_linear(const stream_sample_t *source, u32 frac, u32 step, stream_sample_t *dest, u32 count, s64 gain)
+{
+	// if we have equal sample rates, we just need to copy, and most inputs are at unity gain
+	if (step == FRAC_ONE && gain == 0x100)
+		std::copy_n(source, count, dest);
+	else if (step == FRAC_ONE)
+	{
+		while (count--)
+		{
+			// compute the sample
+			s64 sample = *source++;
+			*dest++ = (sample * gain) >> 8;
+		}
+	}
+
+	// input is undersampled: point sample except where our sample period covers a boundary
+	else if (step < FRAC_ONE)
+	{
+		while (count != 0)
+		{
+			// fill in with point samples until we hit a boundary
+			int nextfrac;
+			while ((nextfrac = frac + step) < FRAC_ONE && count--)
+			{
+				*dest++ = (source[0] * gain) >> 8;
+				frac = nextfrac;
+			}
+
+			// if we're done, we're done
+			if (s32(count--) < 0)
+				break;
+
+			// compute starting and ending fractional positions
+			int startfrac = frac >> (FRAC_BITS - 12);
+			int endfrac = nextfrac >> (FRAC_BITS - 12);
+
+			// blend between the two samples accordingly
+			s64 sample = (s64(source[0]) * (0x1000 - startfrac) + s64(source[1]) * (endfrac - 0x1000)) / (endfrac - startfrac);
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			frac = nextfrac & FRAC_MASK;
+			source++;
+		}
+	}
+
+	// input is oversampled: sum the energy
+	else
+	{
+		// use 8 bits to allow some extra headroom
+		int smallstep = step >> (FRAC_BITS - 8);
+		while (count--)
+		{
+			s64 remainder = smallstep;
+			int tpos = 0;
+
+			// compute the sample
+			s64 scale = (FRAC_ONE - frac) >> (FRAC_BITS - 8);
+			s64 sample = s64(source[tpos++]) * scale;
+			remainder -= scale;
+			while (remainder > 0x100)
+			{
+				sample += s64(source[tpos++]) * s64(0x100);
+				remainder -= 0x100;
+			}
+			sample += s64(source[tpos]) * remainder;
+			sample /= smallstep;
+
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			frac += step;
+			source += frac >> FRAC_BITS;
+			frac &= FRAC_MASK;
+		}
+	}
+}
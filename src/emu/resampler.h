@@ -0,0 +1,68 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles, MAME contributors
+/***************************************************************************
+
+    resampler.h
+
+    Sample rate conversion for sound stream inputs.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_RESAMPLER_H
+#define MAME_EMU_RESAMPLER_H
+
+#pragma once
+
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> sound_resampler
+
+// converts samples between two fixed rates; positions and steps are in
+// units of 1/FRAC_ONE of a source sample, and gain is 8.8 fixed point
+class sound_resampler
+{
+public:
+	// position fraction resolution, matching sound_stream
+	static constexpr u32 FRAC_BITS              = 22;
+	static constexpr u32 FRAC_ONE               = 1 << FRAC_BITS;
+	static constexpr u32 FRAC_MASK              = FRAC_ONE - 1;
+
+	// construction/destruction
+	sound_resampler(u32 source_rate, u32 dest_rate);
+
+	// getters
+	u32 source_rate() const { return m_source_rate; }
+	u32 dest_rate() const { return m_dest_rate; }
+	u32 taps() const { return m_taps; }
+	u32 history() const { return m_taps / 2 - 1; }
+	u32 lookahead() const { return m_taps / 2; }
+
+	// windowed-sinc conversion through the filter bank; reads history()
+	// samples before the source pointer and lookahead() samples after
+	// the last source position
+	void resample(const stream_sample_t *source, u32 frac, u32 step, stream_sample_t *dest, u32 count, s64 gain) const;
+
+	// point sampling/linear blending when upsampling, box filtering when
+	// downsampling; needs one sample after the last source position
+	static void resample_linear(const stream_sample_t *source, u32 frac, u32 step, stream_sample_t *dest, u32 count, s64 gain);
+
+private:
+	// filter bank resolution
+	static constexpr u32 PHASE_BITS             = 9;
+	static constexpr u32 PHASES                 = 1 << PHASE_BITS;
+	static constexpr u32 ZERO_CROSSINGS         = 8;    // each side, at the output rate when downsampling
+	static constexpr u32 MAX_TAPS               = 256;
+
+	// internal state
+	u32                 m_source_rate;          // rate of the samples read
+	u32                 m_dest_rate;            // rate of the samples written
+	u32                 m_taps;                 // taps per phase, a multiple of 4
+	std::vector<float>  m_coefs;                // PHASES + 1 rows of m_taps coefficients
+};
+
+#endif // MAME_EMU_RESAMPLER_H
@@ -531,35 +531,33 @@ void rom_load_manager::region_post_process(const char *rgntag, bool invert)
 
 
 /*-------------------------------------------------
-    open_rom_file - open a ROM file, searching
-    up the parent and loading by checksum
+    find_rom_file - search for a ROM file up the
+    parent chain and by location, loading by
+    checksum where the archives allow; safe to
+    call from a worker
 -------------------------------------------------*/
 
-int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+std::unique_ptr<emu_file> rom_load_manager::find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, osd_file::error &filerr) const
 {
-	osd_file::error filerr = osd_file::error::NOT_FOUND;
-	u32 romsize = rom_file_size(romp);
+	filerr = osd_file::error::NOT_FOUND;
 	tried_file_names = "";
 
-	/* update status display */
-	display_loading_rom_message(ROM_GETNAME(romp), from_list);
-
 	/* extract CRC to use for searching */
 	u32 crc = 0;
 	bool has_crc = util::hash_collection(ROM_GETHASHDATA(romp)).crc(crc);
 
 	/* attempt reading up the chain through the parents. It automatically also
 	 attempts any kind of load by checksum supported by the archives. */
-	m_file = nullptr;
-	for (int drv = driver_list::find(machine().system()); m_file == nullptr && drv != -1; drv = driver_list::clone(drv)) {
+	std::unique_ptr<emu_file> file;
+	for (int drv = driver_list::find(machine().system()); file == nullptr && drv != -1; drv = driver_list::clone(drv)) {
 		if (tried_file_names.length() != 0)
 			tried_file_names += " ";
 		tried_file_names += driver_list::driver(drv).name;
-		m_file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr);
+		file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr);
 	}
 
 	/* if the region is load by name, load the ROM from there */
-	if (m_file == nullptr && regiontag != nullptr)
+	if (file == nullptr && regiontag != nullptr)
 	{
 		// check if we are dealing with softwarelists. if so, locationtag
 		// is actually a concatenation of: listname + setname + parentname
@@ -608,37 +606,160 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 		if (!is_list)
 		{
 			tried_file_names += " " + tag1;
-			m_file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr);
+			file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr);
 		}
 		else
 		{
 			// try to load from list/setname
-			if ((m_file == nullptr) && (tag2.c_str() != nullptr))
+			if ((file == nullptr) && (tag2.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag2;
-				m_file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr);
 			}
 			// try to load from list/parentname
-			if ((m_file == nullptr) && has_parent && (tag3.c_str() != nullptr))
+			if ((file == nullptr) && has_parent && (tag3.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag3;
-				m_file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr);
 			}
 			// try to load from setname
-			if ((m_file == nullptr) && (tag4.c_str() != nullptr))
+			if ((file == nullptr) && (tag4.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag4;
-				m_file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr);
 			}
 			// try to load from parentname
-			if ((m_file == nullptr) && has_parent && (tag5.c_str() != nullptr))
+			if ((file == nullptr) && has_parent && (tag5.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag5;
-				m_file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr);
 			}
 		}
 	}
 
+	return file;
+}
+
+
+/*-------------------------------------------------
+    prefetch_rom_file - work callback that finds
+    a ROM file and gets it decompressed and hashed
+    ahead of its turn
+-------------------------------------------------*/
+
+void *rom_load_manager::prefetch_rom_file(void *param, int threadid)
+{
+	prefetched_file &prefetch = *reinterpret_cast<prefetched_file *>(param);
+	try
+	{
+		prefetch.file = prefetch.manager->find_rom_file(prefetch.regiontag, prefetch.romp, prefetch.tried_file_names, prefetch.filerr);
+
+		// asking for the hashes we'll verify against pulls the data out of the archive and hashes it here
+		if (prefetch.file != nullptr)
+			prefetch.file->hashes(util::hash_collection(ROM_GETHASHDATA(prefetch.romp)).hash_types().c_str());
+	}
+	catch (...)
+	{
+		prefetch.error = std::current_exception();
+	}
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    start_prefetch - queue every file a region
+    will load onto the I/O queue; the data is
+    still copied into the region in entry order,
+    since interleaved and nibble loads share bytes
+-------------------------------------------------*/
+
+void rom_load_manager::start_prefetch(const char *regiontag, const rom_entry *romp, device_t *device)
+{
+	assert(m_prefetch.empty());
+	m_prefetch_next = 0;
+
+	for ( ; !ROMENTRY_ISREGIONEND(romp); romp++)
+		if (ROMENTRY_ISFILE(romp) && (ROM_GETBIOSFLAGS(romp) == 0 || ROM_GETBIOSFLAGS(romp) == device->system_bios()))
+		{
+			auto prefetch = std::make_unique<prefetched_file>();
+			prefetch->manager = this;
+			prefetch->regiontag = regiontag;
+			prefetch->romp = romp;
+			prefetch->filerr = osd_file::error::NOT_FOUND;
+			prefetch->item = nullptr;
+			m_prefetch.push_back(std::move(prefetch));
+		}
+
+	// a single file gains nothing from a worker
+	if (m_prefetch.size() < 2)
+	{
+		m_prefetch.clear();
+		return;
+	}
+
+	m_prefetch_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO | WORK_QUEUE_FLAG_MULTI);
+	if (m_prefetch_queue == nullptr)
+	{
+		m_prefetch.clear();
+		return;
+	}
+	for (auto &prefetch : m_prefetch)
+		prefetch->item = osd_work_item_queue(m_prefetch_queue, &rom_load_manager::prefetch_rom_file, prefetch.get(), 0);
+}
+
+
+/*-------------------------------------------------
+    finish_prefetch - wait out and release
+    anything left over from start_prefetch
+-------------------------------------------------*/
+
+void rom_load_manager::finish_prefetch()
+{
+	if (m_prefetch_queue != nullptr)
+	{
+		osd_work_queue_wait(m_prefetch_queue, osd_ticks_per_second() * 600);
+		for (auto &prefetch : m_prefetch)
+			if (prefetch->item != nullptr)
+				osd_work_item_release(prefetch->item);
+		osd_work_queue_free(m_prefetch_queue);
+		m_prefetch_queue = nullptr;
+	}
+	m_prefetch.clear();
+	m_prefetch_next = 0;
+}
+
+
+/*-------------------------------------------------
+    open_rom_file - open a ROM file, searching
+    up the parent and loading by checksum
+-------------------------------------------------*/
+
+int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+{
+	osd_file::error filerr = osd_file::error::NOT_FOUND;
+	u32 romsize = rom_file_size(romp);
+
+	/* update status display */
+	display_loading_rom_message(ROM_GETNAME(romp), from_list);
+
+	/* take the file from the prefetch queue if it's been loaded there, otherwise search now */
+	if (m_prefetch_next < m_prefetch.size() && m_prefetch[m_prefetch_next]->romp == romp)
+	{
+		prefetched_file &prefetch = *m_prefetch[m_prefetch_next++];
+		while (!osd_work_item_wait(prefetch.item, osd_ticks_per_second())) { }
+		osd_work_item_release(prefetch.item);
+		prefetch.item = nullptr;
+		if (prefetch.error)
+			std::rethrow_exception(prefetch.error);
+		m_file = std::move(prefetch.file);
+		tried_file_names = std::move(prefetch.tried_file_names);
+		filerr = prefetch.filerr;
+	}
+	else
+	{
+		m_file = find_rom_file(regiontag, romp, tried_file_names, filerr);
+	}
+
 	/* update counters */
 	m_romsloaded++;
 	m_romsloadedsize += romsize;
@@ -854,6 +975,28 @@ void rom_load_manager::copy_rom_data(const rom_entry *romp)
 -------------------------------------------------*/
 
 void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list)
+{
+	/* get the region's files loading in the background */
+	start_prefetch(regiontag, romp, device);
+	try
+	{
+		process_rom_entries_in_order(regiontag, parent_region, romp, device, from_list);
+	}
+	catch (...)
+	{
+		finish_prefetch();
+		throw;
+	}
+	finish_prefetch();
+}
+
+
+/*-------------------------------------------------
+    process_rom_entries_in_order - place a
+    region's entries one after another
+-------------------------------------------------*/
+
+void rom_load_manager::process_rom_entries_in_order(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list)
 {
 	u32 lastflags = 0;
 
@@ -1475,6 +1618,8 @@ void rom_load_manager::process_region_list()
 
 rom_load_manager::rom_load_manager(running_machine &machine)
 	: m_machine(machine)
+	, m_prefetch_queue(nullptr)
+	, m_prefetch_next(0)
 {
 	// figure out which BIOS we are using
 	std::map<std::string, std::string> card_bios;
@@ -395,6 +395,19 @@ class rom_load_manager
 		chd_file            m_diffchd;              /* handle to the diff CHD */
 	};
 
+	// a ROM file searched for, decompressed and hashed on a worker ahead of being copied into its region
+	struct prefetched_file
+	{
+		rom_load_manager *          manager;                // who asked
+		const char *                regiontag;              // location to search besides the parents
+		const rom_entry *           romp;                   // entry the file is for
+		std::unique_ptr<emu_file>   file;                   // the file, if found
+		std::string                 tried_file_names;       // where we looked
+		osd_file::error             filerr;                 // result of the search
+		std::exception_ptr          error;                  // what the search threw, if anything
+		osd_work_item *             item;                   // work item doing the load
+	};
+
 public:
 	// construction/destruction
 	rom_load_manager(running_machine &machine);
@@ -430,12 +443,17 @@ private:
 	void display_loading_rom_message(const char *name, bool from_list);
 	void display_rom_load_results(bool from_list);
 	void region_post_process(const char *rgntag, bool invert);
+	std::unique_ptr<emu_file> find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, osd_file::error &filerr) const;
+	static void *prefetch_rom_file(void *param, int threadid);
+	void start_prefetch(const char *regiontag, const rom_entry *romp, device_t *device);
+	void finish_prefetch();
 	int open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list);
 	int rom_fread(u8 *buffer, int length, const rom_entry *parent_region);
 	int read_rom_data(const rom_entry *parent_region, const rom_entry *romp);
 	void fill_rom_data(const rom_entry *romp);
 	void copy_rom_data(const rom_entry *romp);
 	void process_rom_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list);
+	void process_rom_entries_in_order(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list);
 	chd_error open_disk_diff(emu_options &options, const rom_entry *romp, chd_file &source, chd_file &diff_chd);
 	void process_disk_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, const char *locationtag);
 	void normalize_flags_for_device(const char *rgntag, u8 &width, endianness_t &endian);
@@ -455,6 +473,9 @@ private:
 	u32                 m_romstotalsize;      // total size of ROMs to read
 
 	std::unique_ptr<emu_file>  m_file;               /* current file */
+	osd_work_queue *    m_prefetch_queue;     // I/O queue loading the current region's files
+	std::vector<std::unique_ptr<prefetched_file>> m_prefetch; // files of the current region, in entry order
+	size_t              m_prefetch_next;      // next entry in m_prefetch to be consumed
 	std::vector<std::unique_ptr<open_chd>> m_chd_list;     /* disks */
 
 	memory_region *     m_region;             // info about current region
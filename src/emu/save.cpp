@@ -26,6 +26,8 @@
 #include "emuopts.h"
 #include "coreutil.h"
 
+#include <zlib.h>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -44,6 +46,13 @@
 const int SAVE_VERSION      = 2;
 const int HEADER_SIZE       = 32;
 
+// delta states store only the pages that differ from their keyframe
+const u32 DELTA_PAGE_SIZE   = 1024;
+const u32 DELTA_PAGE_END    = ~u32(0);
+
+// in-memory states are deflated in independent chunks so they can be processed in parallel
+const u32 BUFFER_CHUNK_SIZE = 256 * 1024;
+
 // Available flags
 enum
 {
@@ -62,6 +71,8 @@ enum
 
 save_manager::save_manager(running_machine &machine)
 	: m_machine(machine)
+	, m_async_queue(nullptr)
+	, m_chunk_queue(nullptr)
 	, m_reg_allowed(true)
 	, m_illegal_regs(0)
 {
@@ -69,6 +80,26 @@ save_manager::save_manager(running_machine &machine)
 }
 
 
+//-------------------------------------------------
+//  ~save_manager - destructor
+//-------------------------------------------------
+
+save_manager::~save_manager()
+{
+	// a state that is still being written must make it to disk
+	if (m_async_write)
+	{
+		osd_file::error filerr;
+		std::string filename;
+		finish_async_write(filerr, filename);
+	}
+	if (m_async_queue)
+		osd_work_queue_free(m_async_queue);
+	if (m_chunk_queue)
+		osd_work_queue_free(m_chunk_queue);
+}
+
+
 //-------------------------------------------------
 //  allow_registration - allow/disallow
 //  registrations to happen
@@ -324,6 +355,351 @@ save_error save_manager::write_file(emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  write_buffer - capture the current state as a
+//  little-endian raw size and chunk count, the
+//  compressed size of each chunk, then the state
+//  image (header and data) deflated with zlib in
+//  chunks of BUFFER_CHUNK_SIZE bytes
+//-------------------------------------------------
+
+save_error save_manager::write_buffer(std::vector<u8> &data)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// generate the header
+	size_t totalsize = HEADER_SIZE;
+	for (auto &entry : m_entry_list)
+		totalsize += entry->m_typesize * entry->m_typecount;
+	std::vector<u8> raw(totalsize);
+	u8 *header = &raw[0];
+	memcpy(&header[0], STATE_MAGIC_NUM, 8);
+	header[8] = SAVE_VERSION;
+	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST);
+	strncpy((char *)&header[0x0a], machine().system().name, 0x1c - 0x0a);
+	u32 sig = signature();
+	*(u32 *)&header[0x1c] = little_endianize_int32(sig);
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	// then copy all the data
+	u8 *dest = &raw[HEADER_SIZE];
+	for (auto &entry : m_entry_list)
+	{
+		u32 size = entry->m_typesize * entry->m_typecount;
+		memcpy(dest, entry->m_data, size);
+		dest += size;
+	}
+
+	// deflate the chunks
+	std::vector<buffer_chunk> chunks((raw.size() + BUFFER_CHUNK_SIZE - 1) / BUFFER_CHUNK_SIZE);
+	for (size_t index = 0; index < chunks.size(); index++)
+	{
+		buffer_chunk &chunk = chunks[index];
+		chunk.m_raw = &raw[index * BUFFER_CHUNK_SIZE];
+		chunk.m_rawsize = std::min<size_t>(BUFFER_CHUNK_SIZE, raw.size() - index * BUFFER_CHUNK_SIZE);
+		chunk.m_ok = false;
+	}
+	process_chunks(chunks, compress_chunk);
+
+	// and store them behind the table of contents
+	size_t const tocsize = 8 + 4 * chunks.size();
+	size_t length = tocsize;
+	for (buffer_chunk const &chunk : chunks)
+	{
+		if (!chunk.m_ok)
+			return STATERR_WRITE_ERROR;
+		length += chunk.m_compressed.size();
+	}
+	data.resize(length);
+	*(u32 *)&data[0] = little_endianize_int32(u32(raw.size()));
+	*(u32 *)&data[4] = little_endianize_int32(u32(chunks.size()));
+	dest = &data[tocsize];
+	for (size_t index = 0; index < chunks.size(); index++)
+	{
+		std::vector<u8> const &compressed = chunks[index].m_compressed;
+		*(u32 *)&data[8 + 4 * index] = little_endianize_int32(u32(compressed.size()));
+		memcpy(dest, &compressed[0], compressed.size());
+		dest += compressed.size();
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_buffer - restore a state captured by
+//  write_buffer
+//-------------------------------------------------
+
+save_error save_manager::read_buffer(const u8 *data, size_t length)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// check the table of contents
+	if (length < 8)
+		return STATERR_READ_ERROR;
+	u32 const rawsize = little_endianize_int32(*(u32 const *)&data[0]);
+	u32 const count = little_endianize_int32(*(u32 const *)&data[4]);
+	if (rawsize < HEADER_SIZE || count != (rawsize + BUFFER_CHUNK_SIZE - 1) / BUFFER_CHUNK_SIZE || (length - 8) / 4 < count)
+		return STATERR_READ_ERROR;
+
+	// inflate the chunks
+	std::vector<u8> raw(rawsize);
+	std::vector<buffer_chunk> chunks(count);
+	size_t offset = 8 + 4 * size_t(count);
+	for (u32 index = 0; index < count; index++)
+	{
+		buffer_chunk &chunk = chunks[index];
+		u32 const compsize = little_endianize_int32(*(u32 const *)&data[8 + 4 * index]);
+		if (length - offset < compsize)
+			return STATERR_READ_ERROR;
+		chunk.m_raw = &raw[index * BUFFER_CHUNK_SIZE];
+		chunk.m_rawsize = std::min(BUFFER_CHUNK_SIZE, rawsize - index * BUFFER_CHUNK_SIZE);
+		chunk.m_source = &data[offset];
+		chunk.m_sourcesize = compsize;
+		chunk.m_ok = false;
+		offset += compsize;
+	}
+	process_chunks(chunks, expand_chunk);
+	for (buffer_chunk const &chunk : chunks)
+		if (!chunk.m_ok)
+			return STATERR_READ_ERROR;
+
+	// verify the header and report an error if it doesn't match
+	u32 sig = signature();
+	if (validate_header(&raw[0], machine().system().name, sig, nullptr, "Error: ") != STATERR_NONE)
+		return STATERR_INVALID_HEADER;
+
+	// determine whether or not to flip the data when done
+	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((raw[9] & SS_MSB_FIRST) != 0, (raw[9] & SS_MSB_FIRST) == 0);
+
+	// read all the data, flipping if necessary
+	const u8 *src = &raw[HEADER_SIZE];
+	const u8 *const end = &raw[0] + rawsize;
+	for (auto &entry : m_entry_list)
+	{
+		u32 totalsize = entry->m_typesize * entry->m_typecount;
+		if (u32(end - src) < totalsize)
+			return STATERR_READ_ERROR;
+		memcpy(entry->m_data, src, totalsize);
+		src += totalsize;
+
+		// handle flipping
+		if (flip)
+			entry->flip_data();
+	}
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  process_chunks - run a callback over all the
+//  chunks of an in-memory state, in parallel if
+//  there is more than one
+//-------------------------------------------------
+
+void save_manager::process_chunks(std::vector<buffer_chunk> &chunks, osd_work_callback callback)
+{
+	osd_work_item *item = nullptr;
+	if (chunks.size() > 1)
+	{
+		if (!m_chunk_queue)
+			m_chunk_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		if (m_chunk_queue)
+			item = osd_work_item_queue_multiple(m_chunk_queue, callback, chunks.size(), &chunks[0], sizeof(buffer_chunk), 0);
+	}
+
+	if (item)
+	{
+		osd_work_item_wait(item, osd_ticks_per_second() * 100);
+		osd_work_item_release(item);
+	}
+	else
+	{
+		// no worker available, do it here
+		for (buffer_chunk &chunk : chunks)
+			callback(&chunk, 0);
+	}
+}
+
+
+//-------------------------------------------------
+//  compress_chunk - deflate one chunk of an
+//  in-memory state
+//-------------------------------------------------
+
+void *save_manager::compress_chunk(void *param, int threadid)
+{
+	buffer_chunk &chunk = *reinterpret_cast<buffer_chunk *>(param);
+	uLongf length = compressBound(chunk.m_rawsize);
+	chunk.m_compressed.resize(length);
+	chunk.m_ok = compress2(&chunk.m_compressed[0], &length, chunk.m_raw, chunk.m_rawsize, Z_BEST_SPEED) == Z_OK;
+	chunk.m_compressed.resize(length);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  expand_chunk - inflate one chunk of an
+//  in-memory state
+//-------------------------------------------------
+
+void *save_manager::expand_chunk(void *param, int threadid)
+{
+	buffer_chunk &chunk = *reinterpret_cast<buffer_chunk *>(param);
+	uLongf length = chunk.m_rawsize;
+	chunk.m_ok = uncompress(chunk.m_raw, &length, chunk.m_source, chunk.m_sourcesize) == Z_OK && length == chunk.m_rawsize;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  write_file_async - capture the current state
+//  into memory and queue it to be compressed
+//  and written to the named file
+//-------------------------------------------------
+
+save_error save_manager::write_file_async(const char *searchpath, const std::string &filename)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// only one write at a time
+	if (m_async_write)
+	{
+		osd_file::error filerr;
+		std::string previous;
+		finish_async_write(filerr, previous);
+	}
+	if (!m_async_queue)
+		m_async_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+
+	auto write = std::make_unique<async_write>();
+	write->m_searchpath = searchpath ? searchpath : "";
+	write->m_filename = filename;
+	write->m_filerr = osd_file::error::NONE;
+	write->m_saverr = STATERR_NONE;
+
+	// generate the header
+	size_t totalsize = HEADER_SIZE;
+	for (auto &entry : m_entry_list)
+		totalsize += entry->m_typesize * entry->m_typecount;
+	write->m_data.resize(totalsize);
+	u8 *header = &write->m_data[0];
+	memcpy(&header[0], STATE_MAGIC_NUM, 8);
+	header[8] = SAVE_VERSION;
+	header[9] = NATIVE_ENDIAN_VALUE_LE_BE(0, SS_MSB_FIRST);
+	strncpy((char *)&header[0x0a], machine().system().name, 0x1c - 0x0a);
+	u32 sig = signature();
+	*(u32 *)&header[0x1c] = little_endianize_int32(sig);
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	// then copy all the data
+	u8 *dest = &write->m_data[HEADER_SIZE];
+	for (auto &entry : m_entry_list)
+	{
+		u32 size = entry->m_typesize * entry->m_typecount;
+		memcpy(dest, entry->m_data, size);
+		dest += size;
+	}
+
+	// the rest happens in the background
+	write->m_item = osd_work_item_queue(m_async_queue, async_write_callback, write.get(), 0);
+	if (!write->m_item)
+	{
+		// no worker available, do it here
+		async_write_callback(write.get(), 0);
+	}
+	m_async_write = std::move(write);
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  async_write_done - true if the background
+//  write finished and can be collected
+//-------------------------------------------------
+
+bool save_manager::async_write_done() const
+{
+	return m_async_write && (!m_async_write->m_item || osd_work_item_wait(m_async_write->m_item, 0));
+}
+
+
+//-------------------------------------------------
+//  finish_async_write - wait for the background
+//  write to complete and return its results
+//-------------------------------------------------
+
+save_error save_manager::finish_async_write(osd_file::error &filerr, std::string &filename)
+{
+	if (!m_async_write)
+		return STATERR_NOT_FOUND;
+
+	if (m_async_write->m_item)
+	{
+		osd_work_item_wait(m_async_write->m_item, osd_ticks_per_second() * 100);
+		osd_work_item_release(m_async_write->m_item);
+	}
+
+	filerr = m_async_write->m_filerr;
+	filename = std::move(m_async_write->m_filename);
+	const save_error result = m_async_write->m_saverr;
+	m_async_write.reset();
+	return result;
+}
+
+
+//-------------------------------------------------
+//  async_write_callback - compress and write a
+//  captured state on the I/O thread
+//-------------------------------------------------
+
+void *save_manager::async_write_callback(void *param, int threadid)
+{
+	async_write &write = *reinterpret_cast<async_write *>(param);
+
+	// open the file
+	emu_file file(write.m_searchpath.c_str(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	write.m_filerr = file.open(write.m_filename);
+	if (write.m_filerr != osd_file::error::NONE)
+	{
+		write.m_saverr = STATERR_WRITE_ERROR;
+		return nullptr;
+	}
+
+	// write the header and turn on compression for the rest of the file
+	file.compress(FCOMPRESS_NONE);
+	file.seek(0, SEEK_SET);
+	const u32 datasize = write.m_data.size() - HEADER_SIZE;
+	if (file.write(&write.m_data[0], HEADER_SIZE) != HEADER_SIZE)
+		write.m_saverr = STATERR_WRITE_ERROR;
+	else
+	{
+		file.compress(FCOMPRESS_MEDIUM);
+		if (file.write(&write.m_data[HEADER_SIZE], datasize) != datasize)
+			write.m_saverr = STATERR_WRITE_ERROR;
+	}
+
+	// don't leave a partial state behind
+	if (write.m_saverr != STATERR_NONE)
+		file.remove_on_close();
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -424,10 +800,12 @@ save_manager::state_callback::state_callback(save_prepost_delegate callback)
 ram_state::ram_state(save_manager &save)
 	: m_save(save)
 	, m_data()
+	, m_keyframe(nullptr)
+	, m_rawsize(0)
+	, m_incompressible(false)
 	, m_valid(false)
 	, m_time(m_save.machine().time())
 {
-	m_data.reserve(get_size(save));
 	m_data.clear();
 	m_data.rdbuf()->clear();
 	m_data.seekp(0);
@@ -455,14 +833,34 @@ size_t ram_state::get_size(save_manager &save)
 
 //-------------------------------------------------
 //  save - write the current machine state to the
-//  allocated stream
+//  allocated stream; if a keyframe is given, only
+//  the pages that differ from it are stored
 //-------------------------------------------------
 
-save_error ram_state::save()
+save_error ram_state::save(ram_state *keyframe)
 {
+	// a keyframe must be a full state of the current layout
+	if (keyframe && (!keyframe->expand() || !keyframe->usable_keyframe()))
+		keyframe = nullptr;
+
 	// initialize
 	m_valid = false;
+	m_compressed.clear();
+	m_compressed.shrink_to_fit();
+	m_incompressible = false;
+	if (keyframe && !m_keyframe)
+	{
+		// give back the memory a full state needed
+		m_data.vec(std::vector<char>());
+	}
+	else
+	{
+		m_data.rdbuf()->clear();
+		if (!keyframe)
+			m_data.reserve(get_size(m_save));
+	}
 	m_data.seekp(0);
+	m_keyframe = keyframe;
 
 	// if we have illegal registrations, return an error
 	if (m_save.m_illegal_regs > 0)
@@ -487,11 +885,44 @@ save_error ram_state::save()
 	// call the pre-save functions
 	m_save.dispatch_presave();
 
-	// write all the data
-	for (auto &entry : m_save.m_entry_list)
+	if (!m_keyframe)
 	{
-		u32 totalsize = entry->m_typesize * entry->m_typecount;
-		m_data.write((char *)entry->m_data, totalsize);
+		// write all the data
+		for (auto &entry : m_save.m_entry_list)
+		{
+			u32 totalsize = entry->m_typesize * entry->m_typecount;
+			m_data.write((char *)entry->m_data, totalsize);
+
+			// check for any errors
+			if (!m_data)
+				return STATERR_WRITE_ERROR;
+		}
+	}
+	else
+	{
+		// split each entry into pages and write the ones that changed, tagged with their offset
+		const u8 *base = (const u8 *)m_keyframe->m_data.vec().data() + HEADER_SIZE;
+		u32 offset = 0;
+		for (auto &entry : m_save.m_entry_list)
+		{
+			const u32 totalsize = entry->m_typesize * entry->m_typecount;
+			const u8 *data = (const u8 *)entry->m_data;
+			for (u32 pos = 0; pos < totalsize; pos += DELTA_PAGE_SIZE)
+			{
+				const u32 length = std::min(DELTA_PAGE_SIZE, totalsize - pos);
+				if (memcmp(&data[pos], &base[offset + pos], length) != 0)
+				{
+					const u32 page = offset + pos;
+					m_data.write((const char *)&page, sizeof(page));
+					m_data.write((const char *)&data[pos], length);
+				}
+			}
+			offset += totalsize;
+		}
+
+		// terminate the page list
+		const u32 end = DELTA_PAGE_END;
+		m_data.write((const char *)&end, sizeof(end));
 
 		// check for any errors
 		if (!m_data)
@@ -513,6 +944,10 @@ save_error ram_state::save()
 
 save_error ram_state::load()
 {
+	// bring back the raw data if it was compressed
+	if (!expand())
+		return STATERR_READ_ERROR;
+
 	// initialize
 	m_data.seekg(0);
 
@@ -536,19 +971,57 @@ save_error ram_state::load()
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
-	// read all the data, flipping if necessary
-	for (auto &entry : m_save.m_entry_list)
+	if (!m_keyframe)
 	{
-		u32 totalsize = entry->m_typesize * entry->m_typecount;
-		m_data.read((char *)entry->m_data, totalsize);
+		// read all the data, flipping if necessary
+		for (auto &entry : m_save.m_entry_list)
+		{
+			u32 totalsize = entry->m_typesize * entry->m_typecount;
+			m_data.read((char *)entry->m_data, totalsize);
 
-		// check for any errors
-		if (!m_data)
+			// check for any errors
+			if (!m_data)
+				return STATERR_READ_ERROR;
+
+			// handle flipping
+			if (flip)
+				entry->flip_data();
+		}
+	}
+	else
+	{
+		// the keyframe must still be intact
+		if (!m_keyframe->expand() || !m_keyframe->usable_keyframe())
 			return STATERR_READ_ERROR;
 
-		// handle flipping
-		if (flip)
-			entry->flip_data();
+		// rebuild each entry from the keyframe, then overlay the pages stored here
+		const u8 *base = (const u8 *)m_keyframe->m_data.vec().data() + HEADER_SIZE;
+		u32 offset = 0;
+		u32 page;
+		m_data.read((char *)&page, sizeof(page));
+		for (auto &entry : m_save.m_entry_list)
+		{
+			const u32 totalsize = entry->m_typesize * entry->m_typecount;
+			u8 *data = (u8 *)entry->m_data;
+			memcpy(data, &base[offset], totalsize);
+			while (m_data && page != DELTA_PAGE_END && page < offset + totalsize)
+			{
+				if (page < offset)
+					return STATERR_READ_ERROR;
+				const u32 pos = page - offset;
+				m_data.read((char *)&data[pos], std::min(DELTA_PAGE_SIZE, totalsize - pos));
+				m_data.read((char *)&page, sizeof(page));
+			}
+
+			// check for any errors
+			if (!m_data)
+				return STATERR_READ_ERROR;
+
+			// handle flipping
+			if (flip)
+				entry->flip_data();
+			offset += totalsize;
+		}
 	}
 
 	// call the post-load functions
@@ -558,6 +1031,67 @@ save_error ram_state::load()
 }
 
 
+//-------------------------------------------------
+//  usable_keyframe - true if delta states can be
+//  saved against or loaded from this one
+//-------------------------------------------------
+
+bool ram_state::usable_keyframe() const
+{
+	return !m_keyframe && m_valid && !compressed() && m_data.vec().size() == get_size(m_save);
+}
+
+
+//-------------------------------------------------
+//  compress - deflate the save data and release
+//  the raw buffer; safe to call from a worker
+//  thread while the state is not otherwise used
+//-------------------------------------------------
+
+void ram_state::compress()
+{
+	if (!compressible())
+		return;
+
+	const std::vector<char> &raw = m_data.vec();
+	uLongf length = compressBound(raw.size());
+	std::vector<u8> buffer(length);
+	if (compress2(&buffer[0], &length, (const Bytef *)raw.data(), raw.size(), Z_BEST_SPEED) != Z_OK || length >= raw.size())
+	{
+		m_incompressible = true;
+		return;
+	}
+
+	buffer.resize(length);
+	buffer.shrink_to_fit();
+	m_rawsize = raw.size();
+	m_compressed = std::move(buffer);
+	m_data.vec(std::vector<char>());
+}
+
+
+//-------------------------------------------------
+//  expand - restore the raw save data of a
+//  compressed state, returns false on failure
+//-------------------------------------------------
+
+bool ram_state::expand()
+{
+	if (!compressed())
+		return true;
+
+	std::vector<char> raw(m_rawsize);
+	uLongf length = m_rawsize;
+	if (uncompress((Bytef *)&raw[0], &length, &m_compressed[0], m_compressed.size()) != Z_OK || length != m_rawsize)
+		return false;
+
+	m_data.vec(std::move(raw));
+	m_compressed.clear();
+	m_compressed.shrink_to_fit();
+	return true;
+}
+
+
 //-------------------------------------------------
 //  rewinder - constuctor
 //-------------------------------------------------
@@ -570,7 +1104,25 @@ rewinder::rewinder(save_manager &save)
 	, m_first_invalid_index(REWIND_INDEX_NONE)
 	, m_first_time_warning(true)
 	, m_first_time_note(true)
+	, m_keyframe_interval(std::max(save.machine().options().rewind_keyframe_interval(), 1))
+	, m_compress_queue(nullptr)
+{
+	if (m_enabled && save.machine().options().rewind_compression())
+		m_compress_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+}
+
+
+//-------------------------------------------------
+//  ~rewinder - destructor
+//-------------------------------------------------
+
+rewinder::~rewinder()
 {
+	if (m_compress_queue)
+	{
+		wait_compression();
+		osd_work_queue_free(m_compress_queue);
+	}
 }
 
 
@@ -639,11 +1191,17 @@ bool rewinder::capture()
 		return false;
 	}
 
+	// states can't be touched while they're being compressed
+	wait_compression();
+
 	if (current_index_is_last())
 	{
+		// make room for the new state
+		check_size();
+
 		// we need to create a new state
 		std::unique_ptr<ram_state> state = std::make_unique<ram_state>(m_save);
-		const save_error error = state->save();
+		const save_error error = state->save(keyframe_for(m_state_list.size()));
 
 		// validate the state
 		if (error == STATERR_NONE)
@@ -663,7 +1221,7 @@ bool rewinder::capture()
 
 		// update the existing state
 		ram_state *state = m_state_list.at(m_current_index).get();
-		const save_error error = state->save();
+		const save_error error = state->save(keyframe_for(m_current_index));
 
 		// validate the state
 		if (error != STATERR_NONE)
@@ -674,10 +1232,7 @@ bool rewinder::capture()
 		}
 	}
 
-	// make sure we will fit in
-	if (!check_size())
-		// the list keeps growing
-		m_current_index++;
+	m_current_index++;
 
 	// update first invalid index
 	if (current_index_is_last())
@@ -685,6 +1240,9 @@ bool rewinder::capture()
 	else
 		m_first_invalid_index = m_current_index + 1;
 
+	// compress the new state while emulation goes on
+	queue_compression();
+
 	// success
 	report_error(STATERR_NONE, rewind_operation::SAVE);
 	return true;
@@ -720,7 +1278,9 @@ bool rewinder::step()
 	ram_state *state = m_state_list.at(--m_current_index).get();
 
 	// try to load and report the result
+	wait_compression();
 	const save_error error = state->load();
+	queue_compression();
 	report_error(error, rewind_operation::LOAD);
 
 	if (error == save_error::STATERR_NONE)
@@ -731,64 +1291,121 @@ bool rewinder::step()
 
 
 //-------------------------------------------------
-//  check_size - shrink the state list if it is
-//  about to hit the capacity. returns true if
-//  the list got shrank
+//  keyframe_for - pick the keyframe a state at
+//  the given index should be a delta against, or
+//  nullptr if it should be a full state
 //-------------------------------------------------
 
-bool rewinder::check_size()
+ram_state *rewinder::keyframe_for(s32 index) const
+{
+	if (index <= REWIND_INDEX_FIRST || index > s32(m_state_list.size()))
+		return nullptr;
+
+	// follow the previous state's keyframe
+	ram_state *previous = m_state_list[index - 1].get();
+	if (!previous->m_valid)
+		return nullptr;
+	ram_state *keyframe = previous->keyframe() ? previous->keyframe() : previous;
+
+	// start a new keyframe once enough deltas depend on this one
+	s32 first = index - 1;
+	while (first > REWIND_INDEX_FIRST && m_state_list[first].get() != keyframe)
+		first--;
+	if (m_state_list[first].get() != keyframe || index - first >= m_keyframe_interval)
+		return nullptr;
+
+	return keyframe;
+}
+
+
+//-------------------------------------------------
+//  check_size - drop the oldest keyframe and the
+//  deltas depending on it until a new full state
+//  fits within the capacity
+//-------------------------------------------------
+
+void rewinder::check_size()
 {
 	if (!m_enabled)
-		return false;
+		return;
 
 	// state sizes in bytes
 	const size_t singlesize = ram_state::get_size(m_save);
-	size_t totalsize = m_state_list.size() * singlesize;
+	size_t totalsize = 0;
+	for (auto &state : m_state_list)
+		totalsize += state->size();
 
 	// convert our limit from megabytes
 	const size_t capsize = m_capacity * 1024 * 1024;
 
-	// safety check that shouldn't be allowed to trigger
-	if (totalsize > capsize)
+	// check if capacity will be hit by the newly captured state
+	bool erased = false;
+	while (!m_state_list.empty() && totalsize + singlesize >= capsize)
 	{
-		// states to remove
-		const u32 count = (totalsize - capsize) / singlesize;
+		// the oldest state is always a keyframe, take everything up to the next one with it
+		auto last = m_state_list.begin() + 1;
+		while (last != m_state_list.end() && (*last)->keyframe())
+			++last;
+		for (auto it = m_state_list.begin(); it != last; ++it)
+			totalsize -= (*it)->size();
+
+		const s32 count = last - m_state_list.begin();
+		m_state_list.erase(m_state_list.begin(), last);
+		m_current_index -= count;
+		if (m_first_invalid_index > REWIND_INDEX_NONE)
+			m_first_invalid_index = std::max(m_first_invalid_index - count, s32(REWIND_INDEX_FIRST));
+		erased = true;
+	}
 
-		// drop everything that's beyond capacity
-		m_state_list.erase(m_state_list.begin(), m_state_list.begin() + count);
+	if (erased && m_first_time_note)
+	{
+		m_save.machine().logerror("Rewind note: Capacity has been reached. Old savestates will be erased.\n");
+		m_save.machine().logerror("Capacity: %d bytes. Savestate size: %d bytes. Savestate count: %d.\n",
+			capsize, singlesize, m_state_list.size());
+		m_first_time_note = false;
 	}
+}
 
-	// update before new check
-	totalsize = m_state_list.size() * singlesize;
 
-	// check if capacity will be hit by the newly captured state
-	if (totalsize + singlesize >= capsize)
-	{
-		// check if we have spare states ahead
-		if (!current_index_is_last())
-			// no need to move states around
-			return false;
+//-------------------------------------------------
+//  wait_compression - block until all queued
+//  states have been compressed
+//-------------------------------------------------
 
-		// we can now get the first state and invalidate it
-		std::unique_ptr<ram_state> first(std::move(m_state_list.front()));
-		first->m_valid = false;
+void rewinder::wait_compression()
+{
+	if (m_compress_queue)
+		osd_work_queue_wait(m_compress_queue, osd_ticks_per_second() * 100);
+}
 
-		// move it to the end for future use
-		m_state_list.push_back(std::move(first));
-		m_state_list.erase(m_state_list.begin());
 
-		if (m_first_time_note)
-		{
-			m_save.machine().logerror("Rewind note: Capacity has been reached. Old savestates will be erased.\n");
-			m_save.machine().logerror("Capacity: %d bytes. Savestate size: %d bytes. Savestate count: %d.\n",
-				totalsize, singlesize, m_state_list.size());
-			m_first_time_note = false;
-		}
+//-------------------------------------------------
+//  queue_compression - hand every raw state but
+//  the keyframe new deltas will be taken against
+//  to the background compressor
+//-------------------------------------------------
 
-		return true;
-	}
+void rewinder::queue_compression()
+{
+	if (!m_compress_queue || m_state_list.empty())
+		return;
 
-	return false;
+	const ram_state *newest = m_state_list.back().get();
+	const ram_state *keyframe = newest->keyframe() ? newest->keyframe() : newest;
+	for (auto &state : m_state_list)
+		if (state.get() != keyframe && state->m_valid && state->compressible())
+			osd_work_item_queue(m_compress_queue, compress_callback, state.get(), WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  compress_callback - work queue callback
+//-------------------------------------------------
+
+void *rewinder::compress_callback(void *param, int threadid)
+{
+	reinterpret_cast<ram_state *>(param)->compress();
+	return nullptr;
 }
 
 
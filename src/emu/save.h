@@ -121,6 +121,7 @@ class save_manager
 public:
 	// construction/destruction
 	save_manager(running_machine &machine);
+	~save_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -183,6 +184,16 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// deflated in-memory states, for embedding in other files
+	save_error write_buffer(std::vector<u8> &data);
+	save_error read_buffer(const u8 *data, size_t length);
+
+	// background file writing: the state is captured now, compressed and written on a worker thread
+	save_error write_file_async(const char *searchpath, const std::string &filename);
+	bool async_write_pending() const { return bool(m_async_write); }
+	bool async_write_done() const;
+	save_error finish_async_write(osd_file::error &filerr, std::string &filename);
+
 private:
 	// internal helpers
 	u32 signature() const;
@@ -199,9 +210,38 @@ private:
 		save_prepost_delegate m_func;                 // delegate
 	};
 
+	// state captured for writing in the background
+	struct async_write
+	{
+		std::string       m_searchpath;               // where the file goes
+		std::string       m_filename;                 // name of the file
+		std::vector<u8>   m_data;                     // header and uncompressed save data
+		osd_file::error   m_filerr;                   // result of opening the file
+		save_error        m_saverr;                   // result of writing it
+		osd_work_item *   m_item;                     // work item doing the writing
+	};
+	static void *async_write_callback(void *param, int threadid);
+
+	// piece of an in-memory state, deflated or inflated independently
+	struct buffer_chunk
+	{
+		u8 *              m_raw;                      // uncompressed data
+		u32               m_rawsize;                  // size of uncompressed data
+		const u8 *        m_source;                   // compressed data when reading
+		u32               m_sourcesize;               // size of compressed data when reading
+		std::vector<u8>   m_compressed;               // compressed data when writing
+		bool              m_ok;                       // result of the operation
+	};
+	void process_chunks(std::vector<buffer_chunk> &chunks, osd_work_callback callback);
+	static void *compress_chunk(void *param, int threadid);
+	static void *expand_chunk(void *param, int threadid);
+
 	// internal state
 	running_machine &         m_machine;              // reference to our machine
 	std::unique_ptr<rewinder> m_rewind;               // rewinder
+	osd_work_queue *          m_async_queue;          // I/O queue for background file writes
+	std::unique_ptr<async_write> m_async_write;       // write in progress, if any
+	osd_work_queue *          m_chunk_queue;          // queue for deflating/inflating in-memory states
 	bool                      m_reg_allowed;          // are registrations allowed?
 	s32                       m_illegal_regs;         // number of illegal registrations
 
@@ -215,6 +255,12 @@ class ram_state
 {
 	save_manager &     m_save;                        // reference to save_manager
 	util::vectorstream m_data;                        // save data buffer
+	ram_state *        m_keyframe;                    // full state this one is a delta against, or nullptr
+	std::vector<u8>    m_compressed;                  // deflated save data, replaces m_data when not empty
+	u32                m_rawsize;                     // size of the save data before compression
+	bool               m_incompressible;              // compression did not pay off, keep it raw
+
+	bool usable_keyframe() const;
 
 public:
 	bool               m_valid;                       // can we load this state?
@@ -222,8 +268,14 @@ public:
 
 	ram_state(save_manager &save);
 	static size_t get_size(save_manager &save);
-	save_error save();
+	size_t size() const { return compressed() ? m_compressed.size() : m_data.vec().size(); }
+	ram_state *keyframe() const { return m_keyframe; }
+	bool compressed() const { return !m_compressed.empty(); }
+	bool compressible() const { return !compressed() && !m_incompressible; }
+	save_error save(ram_state *keyframe = nullptr);
 	save_error load();
+	void compress();
+	bool expand();
 };
 
 class rewinder
@@ -235,6 +287,8 @@ class rewinder
 	s32            m_first_invalid_index;             // all states before this one are guarateed to be valid
 	bool           m_first_time_warning;              // keep track of warnings we report
 	bool           m_first_time_note;                 // keep track of notes
+	s32            m_keyframe_interval;               // number of states sharing a single full keyframe
+	osd_work_queue *m_compress_queue;                 // background compression of captured states, or nullptr
 	std::vector<std::unique_ptr<ram_state>> m_state_list; // rewinder's own ram states
 
 	// load/save management
@@ -250,12 +304,17 @@ class rewinder
 		REWIND_INDEX_FIRST
 	};
 
-	bool check_size();
+	ram_state *keyframe_for(s32 index) const;
+	void check_size();
+	void wait_compression();
+	void queue_compression();
+	static void *compress_callback(void *param, int threadid);
 	bool current_index_is_last() { return m_current_index == m_state_list.size() - 1; }
 	void report_error(save_error type, rewind_operation operation);
 
 public:
 	rewinder(save_manager &save);
+	~rewinder();
 	bool enabled() { return m_enabled; }
 	void clamp_capacity();
 	void invalidate();
@@ -36,6 +36,15 @@ enum
 
 
 
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// device executing on the current thread while parallel groups are running
+static thread_local device_execute_interface *s_parallel_executing = nullptr;
+
+
+
 //**************************************************************************
 //  EMU TIMER
 //**************************************************************************
@@ -47,7 +56,9 @@ enum
 emu_timer::emu_timer()
 	: m_machine(nullptr),
 		m_next(nullptr),
-		m_prev(nullptr),
+		m_heap_index(~u32(0)),
+		m_sequence(0),
+		m_heap_expire(attotime::never),
 		m_param(0),
 		m_ptr(nullptr),
 		m_enabled(false),
@@ -80,7 +91,7 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	// ensure the entire timer state is clean
 	m_machine = &machine;
 	m_next = nullptr;
-	m_prev = nullptr;
+	m_heap_index = ~u32(0);
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -112,7 +123,7 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	// ensure the entire timer state is clean
 	m_machine = &device.machine();
 	m_next = nullptr;
-	m_prev = nullptr;
+	m_heap_index = ~u32(0);
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -160,9 +171,8 @@ bool emu_timer::enable(bool enable)
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// move the timer to its new position in the heap
+		machine().scheduler().timer_list_reschedule(*this);
 	}
 	return old;
 }
@@ -194,9 +204,8 @@ void emu_timer::adjust(attotime start_delay, s32 param, const attotime &period)
 	m_expire = m_start + start_delay;
 	m_period = period;
 
-	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move the timer to its new position in the heap
+	scheduler.timer_list_reschedule(*this);
 
 	// if this was inserted as the head, abort the current timeslice and resync
 	if (this == scheduler.first_timer())
@@ -244,7 +253,7 @@ void emu_timer::register_save()
 	if (m_device == nullptr)
 	{
 		name = m_callback.name() ? m_callback.name() : "unnamed";
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != nullptr; curtimer = curtimer->next())
+		for (emu_timer *curtimer : machine().scheduler().m_timer_heap)
 			if (!curtimer->m_temporary && curtimer->m_device == nullptr)
 			{
 				if (curtimer->m_callback.name() != nullptr && m_callback.name() != nullptr && strcmp(curtimer->m_callback.name(), m_callback.name()) == 0)
@@ -258,7 +267,7 @@ void emu_timer::register_save()
 	else
 	{
 		name = string_format("%s/%d", m_device->tag(), m_id);
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != nullptr; curtimer = curtimer->next())
+		for (emu_timer *curtimer : machine().scheduler().m_timer_heap)
 			if (!curtimer->m_temporary && curtimer->m_device != nullptr && curtimer->m_device == m_device && curtimer->m_id == m_id)
 				index++;
 	}
@@ -283,10 +292,8 @@ inline void emu_timer::schedule_next_period()
 	m_start = m_expire;
 	m_expire += m_period;
 
-	// remove and re-insert us
-	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move us to our new position in the heap
+	machine().scheduler().timer_list_reschedule(*this);
 }
 
 
@@ -322,16 +329,23 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_executing_device(nullptr),
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
-	m_timer_list(nullptr),
+	m_timer_sequence(0),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
-	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
+	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000),
+	m_parallel_queue(nullptr),
+	m_parallel_active(false),
+	m_stats_enabled(false),
+	m_stats_start(attotime::zero),
+	m_stats_timeslices(0),
+	m_stats_boosts(0),
+	m_stats_boost_time(attotime::zero),
+	m_stats_timer_ticks(0)
 {
 	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true);
-	m_timer_list->adjust(attotime::never);
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -347,8 +361,12 @@ device_scheduler::device_scheduler(running_machine &machine) :
 device_scheduler::~device_scheduler()
 {
 	// remove all timers
-	while (m_timer_list != nullptr)
-		m_timer_allocator.reclaim(m_timer_list->release());
+	while (!m_timer_heap.empty())
+		m_timer_allocator.reclaim(m_timer_heap.back()->release());
+
+	// release the parallel execution queue
+	if (m_parallel_queue != nullptr)
+		osd_work_queue_free(m_parallel_queue);
 }
 
 
@@ -364,7 +382,8 @@ attotime device_scheduler::time() const
 
 	// if we're executing as a particular CPU, use its local time as a base
 	// otherwise, return the global base time
-	return (m_executing_device != nullptr) ? m_executing_device->local_time() : m_basetime;
+	device_execute_interface *const exec = currently_executing();
+	return (exec != nullptr) ? exec->local_time() : m_basetime;
 }
 
 
@@ -376,7 +395,7 @@ attotime device_scheduler::time() const
 bool device_scheduler::can_save() const
 {
 	// if any live temporary timers exit, fail
-	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = timer->next())
+	for (emu_timer *timer : m_timer_heap)
 		if (timer->m_temporary && !timer->expire().is_never())
 		{
 			machine().logerror("Failed save state attempt due to anonymous timers:\n");
@@ -431,14 +450,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < first_timer()->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (first_timer()->m_expire < target)
+			target = first_timer()->m_expire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string(PRECISION)));
@@ -448,90 +467,181 @@ void device_scheduler::timeslice()
 			apply_suspend_changes();
 
 		// loop over all CPUs
+		bool parallel_pending = !m_parallel_groups.empty();
 		for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
 		{
-			// only process if this CPU is executing or truly halted (not yielding)
-			// and if our target is later than the CPU's current time (coarse check)
-			if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds() >= exec->m_localtime.seconds()))
+			// devices in parallel groups all run together when the first one is reached
+			if (exec->m_parallel_group != 0 && !m_parallel_groups.empty())
 			{
-				// compute how many attoseconds to execute this CPU
-				attoseconds_t delta = target.attoseconds() - exec->m_localtime.attoseconds();
-				if (delta < 0 && target.seconds() > exec->m_localtime.seconds())
-					delta += ATTOSECONDS_PER_SECOND;
-				assert(delta == (target - exec->m_localtime).as_attoseconds());
-
-				if (exec->m_attoseconds_per_cycle == 0)
+				if (parallel_pending)
 				{
-					exec->m_localtime = target;
-				}
-				// if we have enough for at least 1 cycle, do the math
-				else if (delta >= exec->m_attoseconds_per_cycle)
-				{
-					// compute how many cycles we want to execute
-					int ran = exec->m_cycles_running = divu_64x32(u64(delta) >> exec->m_divshift, exec->m_divisor);
-					LOG(("  cpu '%s': %d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running));
-
-					// if we're not suspended, actually execute
-					if (exec->m_suspend == 0)
-					{
-						g_profiler.start(exec->m_profiler);
-
-						// note that this global variable cycles_stolen can be modified
-						// via the call to cpu_execute
-						exec->m_cycles_stolen = 0;
-						m_executing_device = exec;
-						*exec->m_icountptr = exec->m_cycles_running;
-						if (!call_debugger)
-							exec->run();
-						else
-						{
-							exec->debugger_start_cpu_hook(target);
-							exec->run();
-							exec->debugger_stop_cpu_hook();
-						}
-
-						// adjust for any cycles we took back
-						assert(ran >= *exec->m_icountptr);
-						ran -= *exec->m_icountptr;
-						assert(ran >= exec->m_cycles_stolen);
-						ran -= exec->m_cycles_stolen;
-						g_profiler.stop();
-					}
-
-					// account for these cycles
-					exec->m_totalcycles += ran;
-
-					// update the local time for this CPU
-					attotime deltatime;
-					if (ran < exec->m_cycles_per_second)
-						deltatime = attotime(0, exec->m_attoseconds_per_cycle * ran);
-					else
-					{
-						u32 remainder;
-						s32 secs = divu_64x32_rem(ran, exec->m_cycles_per_second, &remainder);
-						deltatime = attotime(secs, u64(remainder) * exec->m_attoseconds_per_cycle);
-					}
-					assert(deltatime >= attotime::zero);
-					exec->m_localtime += deltatime;
-					LOG(("         %d ran, %d total, time = %s\n", ran, s32(exec->m_totalcycles), exec->m_localtime.as_string(PRECISION)));
-
-					// if the new local CPU time is less than our target, move the target up, but not before the base
-					if (exec->m_localtime < target)
-					{
-						target = std::max(exec->m_localtime, m_basetime);
-						LOG(("         (new target)\n"));
-					}
+					execute_parallel_groups(target);
+					parallel_pending = false;
 				}
 			}
+			else
+				execute_device(*exec, target, call_debugger);
 		}
 		m_executing_device = nullptr;
 
 		// update the base time
 		m_basetime = target;
+		m_stats_timeslices++;
 	}
 
 	// execute timers
-	execute_timers();
+	if (!m_stats_enabled)
+		execute_timers();
+	else
+	{
+		osd_ticks_t const start = osd_ticks();
+		execute_timers();
+		m_stats_timer_ticks += osd_ticks() - start;
+	}
+}
+
+
+//-------------------------------------------------
+//  execute_device - run a single device up to
+//  the target time, pulling the target back if
+//  the device stopped early
+//-------------------------------------------------
+
+inline void device_scheduler::execute_device(device_execute_interface &exec, attotime &target, bool call_debugger)
+{
+	// only process if this CPU is executing or truly halted (not yielding)
+	// and if our target is later than the CPU's current time (coarse check)
+	if (EXPECTED((exec.m_suspend == 0 || exec.m_eatcycles) && target.seconds() >= exec.m_localtime.seconds()))
+	{
+		// compute how many attoseconds to execute this CPU
+		attoseconds_t delta = target.attoseconds() - exec.m_localtime.attoseconds();
+		if (delta < 0 && target.seconds() > exec.m_localtime.seconds())
+			delta += ATTOSECONDS_PER_SECOND;
+		assert(delta == (target - exec.m_localtime).as_attoseconds());
+
+		if (exec.m_attoseconds_per_cycle == 0)
+		{
+			exec.m_localtime = target;
+		}
+		// if we have enough for at least 1 cycle, do the math
+		else if (delta >= exec.m_attoseconds_per_cycle)
+		{
+			// compute how many cycles we want to execute
+			int ran = exec.m_cycles_running = divu_64x32(u64(delta) >> exec.m_divshift, exec.m_divisor);
+			LOG(("  cpu '%s': %d (%d cycles)\n", exec.device().tag(), delta, exec.m_cycles_running));
+
+			// if we're not suspended, actually execute
+			if (exec.m_suspend == 0)
+			{
+				// the profiler keeps a single global stack, so only use it on the main thread
+				if (!m_parallel_active)
+					g_profiler.start(exec.m_profiler, exec.device().tag(), &exec.device());
+
+				// note that this global variable cycles_stolen can be modified
+				// via the call to cpu_execute
+				exec.m_cycles_stolen = 0;
+				if (m_parallel_active)
+					s_parallel_executing = &exec;
+				else
+					m_executing_device = &exec;
+				*exec.m_icountptr = exec.m_cycles_running;
+				if (!call_debugger)
+					exec.run();
+				else
+				{
+					exec.debugger_start_cpu_hook(target);
+					exec.run();
+					exec.debugger_stop_cpu_hook();
+				}
+
+				// adjust for any cycles we took back
+				assert(ran >= *exec.m_icountptr);
+				ran -= *exec.m_icountptr;
+				assert(ran >= exec.m_cycles_stolen);
+				ran -= exec.m_cycles_stolen;
+				if (!m_parallel_active)
+					g_profiler.stop();
+			}
+
+			// account for these cycles
+			exec.m_totalcycles += ran;
+			exec.m_stats_timeslices++;
+			exec.m_stats_cycles += ran;
+
+			// update the local time for this CPU
+			attotime deltatime;
+			if (ran < exec.m_cycles_per_second)
+				deltatime = attotime(0, exec.m_attoseconds_per_cycle * ran);
+			else
+			{
+				u32 remainder;
+				s32 secs = divu_64x32_rem(ran, exec.m_cycles_per_second, &remainder);
+				deltatime = attotime(secs, u64(remainder) * exec.m_attoseconds_per_cycle);
+			}
+			assert(deltatime >= attotime::zero);
+			exec.m_localtime += deltatime;
+			LOG(("         %d ran, %d total, time = %s\n", ran, s32(exec.m_totalcycles), exec.m_localtime.as_string(PRECISION)));
+
+			// if the new local CPU time is less than our target, move the target up, but not before the base
+			if (exec.m_localtime < target)
+			{
+				target = std::max(exec.m_localtime, m_basetime);
+				LOG(("         (new target)\n"));
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  execute_parallel_groups - run all parallel
+//  groups concurrently up to the target time and
+//  join before returning; the target is pulled
+//  back to the earliest time any group reached
+//-------------------------------------------------
+
+void device_scheduler::execute_parallel_groups(attotime &target)
+{
+	for (parallel_group &group : m_parallel_groups)
+		group.m_target = target;
+
+	// kick off every group and wait for all of them at the quantum boundary
+	m_parallel_active = true;
+	osd_work_item_queue_multiple(m_parallel_queue, parallel_group_execute, m_parallel_groups.size(), &m_parallel_groups[0], sizeof(m_parallel_groups[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(m_parallel_queue, osd_ticks_per_second() * 100);
+	m_parallel_active = false;
+
+	// the serial devices that follow see the same target they would have seen
+	for (parallel_group &group : m_parallel_groups)
+		if (group.m_target < target)
+			target = group.m_target;
+}
+
+
+//-------------------------------------------------
+//  parallel_group_execute - work queue callback
+//  that runs the devices of one group in order
+//-------------------------------------------------
+
+void *device_scheduler::parallel_group_execute(void *param, int threadid)
+{
+	parallel_group &group = *reinterpret_cast<parallel_group *>(param);
+	for (device_execute_interface *exec : group.m_devices)
+		group.m_scheduler->execute_device(*exec, group.m_target, false);
+	s_parallel_executing = nullptr;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  parallel_executing_device - return the device
+//  executing on the calling thread while parallel
+//  groups are running
+//-------------------------------------------------
+
+device_execute_interface *device_scheduler::parallel_executing_device()
+{
+	return s_parallel_executing;
 }
 
 
@@ -542,8 +652,9 @@ void device_scheduler::timeslice()
 
 void device_scheduler::abort_timeslice()
 {
-	if (m_executing_device != nullptr)
-		m_executing_device->abort_timeslice();
+	device_execute_interface *const exec = currently_executing();
+	if (exec != nullptr)
+		exec->abort_timeslice();
 }
 
 
@@ -579,6 +690,13 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 	if (timeslice_time.seconds() > 0)
 		return;
 	add_scheduling_quantum(timeslice_time, boost_duration);
+
+	if (m_stats_enabled)
+	{
+		m_stats_boosts++;
+		if (!boost_duration.is_never())
+			m_stats_boost_time += boost_duration;
+	}
 }
 
 
@@ -589,7 +707,7 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 
 emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *ptr)
 {
-	return &m_timer_allocator.alloc()->init(machine(), callback, ptr, false);
+	return &timer_allocate().init(machine(), callback, ptr, false);
 }
 
 
@@ -601,7 +719,7 @@ emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *
 
 void device_scheduler::timer_set(const attotime &duration, timer_expired_delegate callback, int param, void *ptr)
 {
-	m_timer_allocator.alloc()->init(machine(), callback, ptr, true).adjust(duration, param);
+	timer_allocate().init(machine(), callback, ptr, true).adjust(duration, param);
 }
 
 
@@ -612,7 +730,7 @@ void device_scheduler::timer_set(const attotime &duration, timer_expired_delegat
 
 emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, void *ptr)
 {
-	return &m_timer_allocator.alloc()->init(device, id, ptr, false);
+	return &timer_allocate().init(device, id, ptr, false);
 }
 
 
@@ -624,7 +742,7 @@ emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, v
 
 void device_scheduler::timer_set(const attotime &duration, device_t &device, device_timer_id id, int param, void *ptr)
 {
-	m_timer_allocator.alloc()->init(device, id, ptr, true).adjust(duration, param);
+	timer_allocate().init(device, id, ptr, true).adjust(duration, param);
 }
 
 
@@ -671,24 +789,23 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != nullptr)
+	// take the timers in their current order and empty the heap
+	std::vector<emu_timer *> ordered(m_timer_heap);
+	std::sort(ordered.begin(), ordered.end(), [] (const emu_timer *a, const emu_timer *b) { return timer_heap_before(*a, *b); });
+	std::vector<emu_timer *> private_list;
+	for (emu_timer *timer : ordered)
 	{
-		emu_timer &timer = *m_timer_list;
-
 		// temporary timers go away entirely (except our special never-expiring one)
-		if (timer.m_temporary && !timer.expire().is_never())
-			m_timer_allocator.reclaim(timer.release());
+		if (timer->m_temporary && !timer->expire().is_never())
+			m_timer_allocator.reclaim(timer->release());
 
 		// permanent ones get added to our private list
 		else
-			private_list.append(timer_list_remove(timer));
+			private_list.push_back(&timer_list_remove(*timer));
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != nullptr)
+	// now re-insert them in their old order; this effectively re-sorts them by time
+	for (emu_timer *timer : private_list)
 		timer_list_insert(*timer);
 
 	m_suspend_changes_pending = true;
@@ -811,85 +928,220 @@ void device_scheduler::rebuild_execute_list()
 
 	// append the suspend list to the end of the active list
 	*active_tailptr = suspend_list;
+
+	// regroup the devices that may run concurrently
+	rebuild_parallel_groups();
 }
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  rebuild_parallel_groups - collect devices that
+//  opted into parallel execution into per-group
+//  lists, preserving execute list order
 //-------------------------------------------------
 
-emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+void device_scheduler::rebuild_parallel_groups()
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
+	m_parallel_groups.clear();
 
-	// loop over the timer list
-	emu_timer *prevtimer = nullptr;
-	for (emu_timer *curtimer = m_timer_list; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
+	// the debugger expects to see one device at a time
+	if (machine().debug_flags & DEBUG_FLAG_ENABLED)
+		return;
+
+	for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+		if (exec->m_parallel_group != 0)
 		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
+			auto group = std::find_if(m_parallel_groups.begin(), m_parallel_groups.end(), [exec] (const parallel_group &g) { return g.m_devices.front()->m_parallel_group == exec->m_parallel_group; });
+			if (group == m_parallel_groups.end())
+				group = m_parallel_groups.insert(m_parallel_groups.end(), parallel_group{ this, { }, attotime::zero });
+			group->m_devices.push_back(exec);
+		}
 
-			if (curtimer->m_prev != nullptr)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
+	// a single group gains nothing from running on another thread
+	if (m_parallel_groups.size() < 2)
+	{
+		m_parallel_groups.clear();
+		return;
+	}
 
-			curtimer->m_prev = &timer;
-			return timer;
-		}
+	if (m_parallel_queue == nullptr)
+		m_parallel_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_before - return true if timer a
+//  fires before timer b; timers expiring at the
+//  same time fire in the order they were queued
+//-------------------------------------------------
+
+inline bool device_scheduler::timer_heap_before(const emu_timer &a, const emu_timer &b)
+{
+	if (a.m_heap_expire != b.m_heap_expire)
+		return a.m_heap_expire < b.m_heap_expire;
+	return a.m_sequence < b.m_sequence;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_up - move a heap entry towards
+//  the root until its parent fires first
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_up(u32 index)
+{
+	emu_timer *const timer = m_timer_heap[index];
+	while (index > 0)
+	{
+		u32 const parent = (index - 1) >> 1;
+		if (!timer_heap_before(*timer, *m_timer_heap[parent]))
+			break;
+		m_timer_heap[index] = m_timer_heap[parent];
+		m_timer_heap[index]->m_heap_index = index;
+		index = parent;
 	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
 
-	// need to insert after the last one
-	if (prevtimer != nullptr)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
 
-	timer.m_prev = prevtimer;
-	timer.m_next = nullptr;
+//-------------------------------------------------
+//  timer_heap_sift_down - move a heap entry away
+//  from the root until both children fire later
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_down(u32 index)
+{
+	u32 const count = m_timer_heap.size();
+	emu_timer *const timer = m_timer_heap[index];
+	while (true)
+	{
+		u32 child = (index << 1) + 1;
+		if (child >= count)
+			break;
+		if ((child + 1) < count && timer_heap_before(*m_timer_heap[child + 1], *m_timer_heap[child]))
+			child++;
+		if (!timer_heap_before(*m_timer_heap[child], *timer))
+			break;
+		m_timer_heap[index] = m_timer_heap[child];
+		m_timer_heap[index]->m_heap_index = index;
+		index = child;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
+//-------------------------------------------------
+//  timer_list_insert - insert a new timer into
+//  the heap at the appropriate location
+//-------------------------------------------------
+
+emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+{
+	// devices in parallel groups may get here concurrently
+	std::unique_lock<std::mutex> lock(m_parallel_lock, std::defer_lock);
+	if (m_parallel_active)
+		lock.lock();
+
+	// disabled timers sort to the end
+	assert(timer.m_heap_index == ~u32(0));
+	timer.m_heap_expire = timer.m_enabled ? timer.m_expire : attotime::never;
+	timer.m_sequence = m_timer_sequence++;
+
+	// add at the bottom and let it rise into place
+	m_timer_heap.push_back(&timer);
+	timer_heap_sift_up(m_timer_heap.size() - 1);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  heap
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
-	// remove it from the list
-	if (timer.m_prev != nullptr)
-		timer.m_prev->m_next = timer.m_next;
-	else
-		m_timer_list = timer.m_next;
+	// devices in parallel groups may get here concurrently
+	std::unique_lock<std::mutex> lock(m_parallel_lock, std::defer_lock);
+	if (m_parallel_active)
+		lock.lock();
+
+	// move the last entry into the hole and restore the heap order around it
+	u32 const index = timer.m_heap_index;
+	assert(index < m_timer_heap.size() && m_timer_heap[index] == &timer);
+	emu_timer *const last = m_timer_heap.back();
+	m_timer_heap.pop_back();
+	if (last != &timer)
+	{
+		m_timer_heap[index] = last;
+		last->m_heap_index = index;
+		if (index > 0 && timer_heap_before(*last, *m_timer_heap[(index - 1) >> 1]))
+			timer_heap_sift_up(index);
+		else
+			timer_heap_sift_down(index);
+	}
+
+	timer.m_heap_index = ~u32(0);
+	return timer;
+}
+
 
-	if (timer.m_next != nullptr)
-		timer.m_next->m_prev = timer.m_prev;
+//-------------------------------------------------
+//  timer_list_reschedule - move a timer to the
+//  right place after its expiry time or enabled
+//  state changed; it is ordered after any timers
+//  already queued for the same time, exactly as
+//  if it had been removed and re-inserted
+//-------------------------------------------------
 
+emu_timer &device_scheduler::timer_list_reschedule(emu_timer &timer)
+{
+	// devices in parallel groups may get here concurrently
+	std::unique_lock<std::mutex> lock(m_parallel_lock, std::defer_lock);
+	if (m_parallel_active)
+		lock.lock();
+
+	u32 const index = timer.m_heap_index;
+	assert(index < m_timer_heap.size() && m_timer_heap[index] == &timer);
+	timer.m_heap_expire = timer.m_enabled ? timer.m_expire : attotime::never;
+	timer.m_sequence = m_timer_sequence++;
+	if (index > 0 && timer_heap_before(timer, *m_timer_heap[(index - 1) >> 1]))
+		timer_heap_sift_up(index);
+	else
+		timer_heap_sift_down(index);
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_allocate - allocate a timer, which may
+//  be requested by devices in parallel groups
+//-------------------------------------------------
+
+emu_timer &device_scheduler::timer_allocate()
+{
+	std::unique_lock<std::mutex> lock(m_parallel_lock, std::defer_lock);
+	if (m_parallel_active)
+		lock.lock();
+	return *m_timer_allocator.alloc();
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION)));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), first_timer()->m_expire.as_string(PRECISION)));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (first_timer()->m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *first_timer();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -902,7 +1154,8 @@ inline void device_scheduler::execute_timers()
 		// call the callback
 		if (was_enabled)
 		{
-			g_profiler.start(PROFILER_TIMER_CALLBACK);
+			g_profiler.start(PROFILER_TIMER_CALLBACK, (timer.m_device != nullptr) ? timer.m_device->tag() : timer.m_callback.name());
+			osd_ticks_t const start = m_stats_enabled ? osd_ticks() : 0;
 
 			if (timer.m_device != nullptr)
 			{
@@ -915,6 +1168,14 @@ inline void device_scheduler::execute_timers()
 				timer.m_callback(timer.m_ptr, timer.m_param);
 			}
 
+			if (m_stats_enabled)
+			{
+				// device timers are keyed by device and ID, everything else by callback name
+				timer_counters &counters = (timer.m_device != nullptr) ? m_stats_device_timers[std::make_pair(timer.m_device, timer.m_id)] : m_stats_callback_timers[timer.m_callback.name()];
+				counters.m_fired++;
+				counters.m_ticks += osd_ticks() - start;
+			}
+
 			g_profiler.stop();
 		}
 
@@ -981,6 +1242,149 @@ void device_scheduler::add_scheduling_quantum(const attotime &quantum, const att
 }
 
 
+//-------------------------------------------------
+//  set_statistics_enabled - start or stop
+//  collecting scheduler statistics
+//-------------------------------------------------
+
+void device_scheduler::set_statistics_enabled(bool enable)
+{
+	if (enable != m_stats_enabled)
+	{
+		m_stats_enabled = enable;
+		reset_statistics();
+	}
+}
+
+
+//-------------------------------------------------
+//  reset_statistics - clear all scheduler
+//  statistics counters
+//-------------------------------------------------
+
+void device_scheduler::reset_statistics()
+{
+	m_stats_start = time();
+	m_stats_timeslices = 0;
+	m_stats_boosts = 0;
+	m_stats_boost_time = attotime::zero;
+	m_stats_timer_ticks = 0;
+	m_stats_device_timers.clear();
+	m_stats_callback_timers.clear();
+
+	for (device_execute_interface &exec : execute_interface_iterator(machine().root_device()))
+	{
+		exec.m_stats_timeslices = 0;
+		exec.m_stats_cycles = 0;
+		exec.m_stats_aborts = 0;
+		exec.m_stats_idle_skips = 0;
+		exec.m_stats_idle_cycles = 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  device_statistics - return the counters for
+//  every executing device
+//-------------------------------------------------
+
+std::vector<device_scheduler::device_stats> device_scheduler::device_statistics() const
+{
+	std::vector<device_stats> result;
+	device_statistics(result);
+	return result;
+}
+
+// refill a caller's vector, which won't allocate once it has grown to fit
+void device_scheduler::device_statistics(std::vector<device_stats> &result) const
+{
+	result.clear();
+	for (device_execute_interface &exec : execute_interface_iterator(machine().root_device()))
+		result.push_back(device_stats{ &exec, exec.m_stats_timeslices, exec.m_stats_cycles, exec.m_stats_aborts, exec.m_stats_idle_skips, exec.m_stats_idle_cycles });
+}
+
+
+//-------------------------------------------------
+//  timer_statistics - return the timer counters
+//  merged by callback name, busiest first
+//-------------------------------------------------
+
+std::vector<device_scheduler::timer_stats> device_scheduler::timer_statistics() const
+{
+	// callback names may come from several string literals, so merge by text
+	std::map<std::string, timer_counters> merged;
+	for (auto const &entry : m_stats_device_timers)
+	{
+		timer_counters &dest = merged[string_format("%s/%d", entry.first.first->tag(), entry.first.second)];
+		dest.m_fired += entry.second.m_fired;
+		dest.m_ticks += entry.second.m_ticks;
+	}
+	for (auto const &entry : m_stats_callback_timers)
+	{
+		timer_counters &dest = merged[entry.first ? entry.first : "unnamed"];
+		dest.m_fired += entry.second.m_fired;
+		dest.m_ticks += entry.second.m_ticks;
+	}
+
+	std::vector<timer_stats> result;
+	for (auto const &entry : merged)
+		result.push_back(timer_stats{ entry.first, entry.second.m_fired, entry.second.m_ticks });
+	std::stable_sort(result.begin(), result.end(), [] (const timer_stats &a, const timer_stats &b) { return a.fired > b.fired; });
+	return result;
+}
+
+
+//-------------------------------------------------
+//  statistics_text - summarise the statistics
+//  for display in the profiler overlay
+//-------------------------------------------------
+
+std::string device_scheduler::statistics_text() const
+{
+	if (!m_stats_enabled)
+		return std::string();
+
+	// rates are per emulated second
+	double const elapsed = statistics_elapsed().as_double();
+	if (elapsed <= 0.0)
+		return std::string();
+	double const ticks_per_second = double(osd_ticks_per_second());
+
+	std::ostringstream stream;
+	util::stream_format(stream, "Timeslices: %.0f/s  Boosts: %.0f/s (%.2f%%)\n",
+			double(m_stats_timeslices) / elapsed,
+			double(m_stats_boosts) / elapsed,
+			100.0 * m_stats_boost_time.as_double() / elapsed);
+	util::stream_format(stream, "Timer execution: %.2fms/s\n", 1000.0 * double(m_stats_timer_ticks) / ticks_per_second / elapsed);
+
+	for (const device_stats &exec : device_statistics())
+		if (exec.timeslices != 0)
+			util::stream_format(stream, "'%s' %.0f cycles/slice  %.0f aborts/s\n",
+					exec.device->device().tag(),
+					double(exec.cycles) / double(exec.timeslices),
+					double(exec.aborts) / elapsed);
+	for (const device_stats &exec : device_statistics())
+		if (exec.idle_skips != 0)
+			util::stream_format(stream, "'%s' idle: %.0f skips/s  %.1f%% of cycles\n",
+					exec.device->device().tag(),
+					double(exec.idle_skips) / elapsed,
+					100.0 * double(exec.idle_cycles) / double(exec.cycles + exec.idle_cycles));
+
+	// only the busiest timers are interesting
+	int count = 0;
+	for (const timer_stats &timer : timer_statistics())
+	{
+		if (count++ == 8)
+			break;
+		util::stream_format(stream, "%.0f/s %.3fms/s %s\n",
+				double(timer.fired) / elapsed,
+				1000.0 * double(timer.host_ticks) / ticks_per_second / elapsed,
+				timer.name);
+	}
+	return stream.str();
+}
+
+
 //-------------------------------------------------
 //  dump_timers - dump the current timer state
 //-------------------------------------------------
@@ -989,7 +1393,9 @@ void device_scheduler::dump_timers() const
 {
 	machine().logerror("=============================================\n");
 	machine().logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = first_timer(); timer != nullptr; timer = timer->next())
+	std::vector<emu_timer *> sorted(m_timer_heap);
+	std::sort(sorted.begin(), sorted.end(), [] (const emu_timer *a, const emu_timer *b) { return timer_heap_before(*a, *b); });
+	for (emu_timer *timer : sorted)
 		timer->dump();
 	machine().logerror("=============================================\n");
 }
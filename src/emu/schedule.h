@@ -17,6 +17,11 @@
 #ifndef MAME_EMU_SCHEDULE_H
 #define MAME_EMU_SCHEDULE_H
 
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
 
 //**************************************************************************
 //  MACROS
@@ -63,7 +68,6 @@ class emu_timer
 
 public:
 	// getters
-	emu_timer *next() const { return m_next; }
 	running_machine &machine() const { assert(m_machine != nullptr); return *m_machine; }
 	bool enabled() const { return m_enabled; }
 	int param() const { return m_param; }
@@ -86,14 +90,17 @@ public:
 
 private:
 	// internal helpers
+	emu_timer *next() const { return m_next; }
 	void register_save();
 	void schedule_next_period();
 	void dump() const;
 
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the allocator's free list
+	u32                 m_heap_index;   // position in the scheduler's timer heap
+	u64                 m_sequence;     // insertion order, used to break ties between equal expiry times
+	attotime            m_heap_expire;  // expiry time the heap is ordered by (never if disabled)
 	timer_expired_delegate m_callback;  // callback function
 	s32                 m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -115,6 +122,25 @@ class device_scheduler
 	friend class emu_timer;
 
 public:
+	// per-device scheduling statistics
+	struct device_stats
+	{
+		device_execute_interface *  device;                 // device these counters belong to
+		u64                         timeslices;             // number of timeslices the device executed in
+		u64                         cycles;                 // cycles actually executed
+		u64                         aborts;                 // timeslices cut short by abort_timeslice()
+		u64                         idle_skips;             // idle loops fast-forwarded
+		u64                         idle_cycles;            // cycles skipped in idle loops
+	};
+
+	// per-callback timer statistics
+	struct timer_stats
+	{
+		std::string                 name;                   // callback name or device tag/id
+		u64                         fired;                  // number of times the callback ran
+		osd_ticks_t                 host_ticks;             // host time spent in the callback
+	};
+
 	// construction/destruction
 	device_scheduler(running_machine &machine);
 	~device_scheduler();
@@ -122,8 +148,8 @@ public:
 	// getters
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
-	emu_timer *first_timer() const { return m_timer_list; }
-	device_execute_interface *currently_executing() const { return m_executing_device; }
+	emu_timer *first_timer() const { return m_timer_heap.front(); }
+	device_execute_interface *currently_executing() const { return m_parallel_active ? parallel_executing_device() : m_executing_device; }
 	bool can_save() const;
 
 	// execution
@@ -142,6 +168,20 @@ public:
 	emu_timer *timer_alloc(device_t &device, device_timer_id id = 0, void *ptr = nullptr);
 	void timer_set(const attotime &duration, device_t &device, device_timer_id id = 0, int param = 0, void *ptr = nullptr);
 
+	// instrumentation
+	bool statistics_enabled() const { return m_stats_enabled; }
+	void set_statistics_enabled(bool enable);
+	void reset_statistics();
+	attotime statistics_elapsed() const { return m_stats_enabled ? (time() - m_stats_start) : attotime::zero; }
+	u64 statistics_timeslices() const { return m_stats_timeslices; }
+	u64 statistics_boosts() const { return m_stats_boosts; }
+	attotime statistics_boost_time() const { return m_stats_boost_time; }
+	osd_ticks_t statistics_timer_ticks() const { return m_stats_timer_ticks; }
+	std::vector<device_stats> device_statistics() const;
+	void device_statistics(std::vector<device_stats> &result) const;
+	std::vector<timer_stats> timer_statistics() const;
+	std::string statistics_text() const;
+
 	// debugging
 	void dump_timers() const;
 
@@ -159,10 +199,20 @@ private:
 	void rebuild_execute_list();
 	void apply_suspend_changes();
 	void add_scheduling_quantum(const attotime &quantum, const attotime &duration);
+	void execute_device(device_execute_interface &exec, attotime &target, bool call_debugger);
+	void execute_parallel_groups(attotime &target);
+	void rebuild_parallel_groups();
+	static void *parallel_group_execute(void *param, int threadid);
+	static device_execute_interface *parallel_executing_device();
 
 	// timer helpers
+	emu_timer &timer_allocate();
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	emu_timer &timer_list_reschedule(emu_timer &timer);
+	void timer_heap_sift_up(u32 index);
+	void timer_heap_sift_down(u32 index);
+	static bool timer_heap_before(const emu_timer &a, const emu_timer &b);
 	void execute_timers();
 
 	// internal state
@@ -171,8 +221,9 @@ private:
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// heap of active timers
+	std::vector<emu_timer *>    m_timer_heap;               // binary min-heap ordered by expiry, then insertion
+	u64                         m_timer_sequence;           // next insertion sequence number
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
@@ -197,6 +248,33 @@ private:
 	simple_list<quantum_slot>   m_quantum_list;             // list of active quanta
 	fixed_allocator<quantum_slot> m_quantum_allocator;      // allocator for quanta
 	attoseconds_t               m_quantum_minimum;          // duration of minimum quantum
+
+	// parallel execution groups
+	struct parallel_group
+	{
+		device_scheduler *      m_scheduler;                // owning scheduler
+		std::vector<device_execute_interface *> m_devices;  // devices in execution order
+		attotime                m_target;                   // target time in, reached time out
+	};
+	std::vector<parallel_group> m_parallel_groups;          // groups run concurrently (empty if serial)
+	osd_work_queue *            m_parallel_queue;           // work queue for executing groups
+	bool                        m_parallel_active;          // true while groups are executing
+	std::mutex                  m_parallel_lock;            // serialises timer list access from groups
+
+	// instrumentation
+	struct timer_counters
+	{
+		u64                     m_fired;                    // number of times the callback ran
+		osd_ticks_t             m_ticks;                    // host time spent in the callback
+	};
+	bool                        m_stats_enabled;            // are statistics being collected?
+	attotime                    m_stats_start;              // emulated time collection (re)started
+	u64                         m_stats_timeslices;         // number of scheduler passes
+	u64                         m_stats_boosts;             // number of boost_interleave() requests
+	attotime                    m_stats_boost_time;         // total requested boost duration
+	osd_ticks_t                 m_stats_timer_ticks;        // host time spent in execute_timers()
+	std::map<std::pair<device_t *, device_timer_id>, timer_counters> m_stats_device_timers; // per device timer counters
+	std::map<const char *, timer_counters> m_stats_callback_timers; // per callback name counters
 };
 
 
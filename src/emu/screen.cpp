@@ -15,6 +15,7 @@
 
 #include <nanosvg/src/nanosvg.h>
 #include <nanosvg/src/nanosvgrast.h>
+#include <atomic>
 #include <set>
 
 //**************************************************************************
@@ -562,6 +563,8 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 	, m_palette(*this, finder_base::DUMMY_TAG)
 	, m_video_attributes(0)
 	, m_svg_region(nullptr)
+	, m_parallel_update(false)
+	, m_batched_update(false)
 	, m_container(nullptr)
 	, m_width(100)
 	, m_height(100)
@@ -586,10 +589,21 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 	, m_scanline_timer(nullptr)
 	, m_frame_number(0)
 	, m_partial_updates_this_frame(0)
+	, m_batched_partial_scan(-1)
+	, m_coalesced_this_frame(0)
+	, m_stat_frames(0)
+	, m_stat_partial_updates(0)
+	, m_stat_coalesced(0)
+	, m_bands(1)
+	, m_full_frame_update(false)
+	, m_band_update_active(false)
+	, m_band_queue(nullptr)
 {
 	m_unique_id = m_id_counter;
 	m_id_counter++;
 	memset(m_texture, 0, sizeof(m_texture));
+	std::fill(std::begin(m_bitmap_allocator), std::end(m_bitmap_allocator), nullptr);
+	std::fill(std::begin(m_bitmap_memory), std::end(m_bitmap_memory), nullptr);
 }
 
 
@@ -599,6 +613,11 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 
 screen_device::~screen_device()
 {
+	if (m_band_queue != nullptr)
+		osd_work_queue_free(m_band_queue);
+	for (int i = 0; i < 2; i++)
+		if (m_bitmap_memory[i] != nullptr)
+			m_bitmap_allocator[i]->release(m_bitmap_memory[i]);
 }
 
 
@@ -757,10 +776,10 @@ void screen_device::device_start()
 	// svg is RGB32 too, and doesn't have any update method
 	texture_format texformat = !m_screen_update_ind16.isnull() ? TEXFORMAT_PALETTE16 : TEXFORMAT_RGB32;
 
-	for (auto & elem : m_bitmap)
+	for (int i = 0; i < 2; i++)
 	{
-		elem.set_format(format(), texformat);
-		register_screen_bitmap(elem);
+		m_bitmap[i].set_format(format(), texformat);
+		resize_screen_bitmap(i, width(), height());
 	}
 	register_screen_bitmap(m_priority);
 
@@ -824,6 +843,7 @@ void screen_device::device_start()
 	save_item(NAME(m_visarea.max_x));
 	save_item(NAME(m_visarea.max_y));
 	save_item(NAME(m_last_partial_scan));
+	save_item(NAME(m_batched_partial_scan));
 	save_item(NAME(m_frame_period));
 	save_item(NAME(m_brightness));
 	save_item(NAME(m_scantime));
@@ -836,6 +856,11 @@ void screen_device::device_start()
 		logerror("%s: Deprecated legacy Old Style screen configured (MCFG_SCREEN_VBLANK_TIME), please use MCFG_SCREEN_RAW_PARAMS instead.\n",this->tag());
 
 	m_is_primary_screen = (this == screen_device_iterator(machine().root_device()).first());
+
+	// full-frame updates can be split into bands rendered on worker threads
+	m_bands = std::max(machine().options().render_bands(), 1);
+	if (m_bands > 1)
+		m_band_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 }
 
 
@@ -1025,18 +1050,63 @@ void screen_device::realloc_screen_bitmaps()
 	// reize all registered screen bitmaps
 	for (auto &item : m_auto_bitmap_list)
 		item->m_bitmap.resize(effwidth, effheight);
+	resize_screen_bitmap(0, effwidth, effheight);
+	resize_screen_bitmap(1, effwidth, effheight);
 
 	// re-set up textures
-	if (m_palette)
-	{
-		m_bitmap[0].set_palette(m_palette->palette());
-		m_bitmap[1].set_palette(m_palette->palette());
-	}
 	m_texture[0]->set_bitmap(m_bitmap[0], m_visarea, m_bitmap[0].texformat());
 	m_texture[1]->set_bitmap(m_bitmap[1], m_visarea, m_bitmap[1].texformat());
 }
 
 
+//-------------------------------------------------
+//  resize_screen_bitmap - resize one of the
+//  bitmaps the screen is drawn into, using
+//  memory from the OSD renderer if it offers any
+//-------------------------------------------------
+
+void screen_device::resize_screen_bitmap(int index, s32 width, s32 height)
+{
+	screen_bitmap &bitmap = m_bitmap[index];
+	render_bitmap_allocator *const allocator = machine().render().screen_allocator();
+
+	// provided memory is only swapped for a new block when the size changes
+	if (m_bitmap_memory[index] == nullptr || m_bitmap_allocator[index] != allocator || width != bitmap.width() || height != bitmap.height())
+	{
+		if (m_bitmap_memory[index] != nullptr)
+		{
+			bitmap.set_palette(nullptr);
+			bitmap.wrap(nullptr, 0, 0, 0);
+			m_bitmap_allocator[index]->release(m_bitmap_memory[index]);
+			m_bitmap_memory[index] = nullptr;
+			m_bitmap_allocator[index] = nullptr;
+		}
+
+		// rows are kept to multiples of 64 bytes for the GPU's benefit
+		if (allocator != nullptr && width > 0 && height > 0)
+		{
+			s32 const rowalign = 64 / (bitmap.bpp() / 8);
+			s32 const rowpixels = (width + rowalign - 1) & ~(rowalign - 1);
+			size_t const bytes = size_t(rowpixels) * height * (bitmap.bpp() / 8);
+			void *const memory = allocator->allocate(bitmap.texformat(), bytes);
+			if (memory != nullptr)
+			{
+				memset(memory, 0, bytes);
+				bitmap.wrap(memory, width, height, rowpixels);
+				m_bitmap_memory[index] = memory;
+				m_bitmap_allocator[index] = allocator;
+			}
+		}
+	}
+
+	// otherwise the bitmap has its own memory
+	if (m_bitmap_memory[index] == nullptr)
+		bitmap.resize(width, height);
+	if (m_palette)
+		bitmap.set_palette(m_palette->palette());
+}
+
+
 //-------------------------------------------------
 //  set_visible_area - just set the visible area
 //-------------------------------------------------
@@ -1056,6 +1126,54 @@ void screen_device::set_visible_area(int min_x, int max_x, int min_y, int max_y)
 //-----------------------------------------------*/
 
 bool screen_device::update_partial(int scanline)
+{
+	// batched screens only note how far to draw, until the driver says the video state is changing or the frame ends
+	if (m_batched_update && (scanline < m_visarea.bottom()))
+	{
+		if (scanline < m_last_partial_scan)
+			return false;
+		if (m_batched_partial_scan >= 0)
+			m_coalesced_this_frame++;
+		m_batched_partial_scan = (std::max)(m_batched_partial_scan, s32(scanline));
+		return true;
+	}
+
+	// anything batched is drawn along with this
+	if (m_batched_partial_scan >= 0)
+	{
+		if (m_batched_partial_scan >= scanline)
+			m_coalesced_this_frame++;
+		scanline = (std::max)(scanline, m_batched_partial_scan);
+		m_batched_partial_scan = -1;
+	}
+	return draw_partial(scanline);
+}
+
+
+//-------------------------------------------------
+//  video_state_changed - called by drivers with
+//  batched updates before anything that affects
+//  how the screen is drawn changes, to draw the
+//  scanlines asked for so far
+//-------------------------------------------------
+
+void screen_device::video_state_changed()
+{
+	if (m_batched_partial_scan >= 0)
+	{
+		s32 const scanline = m_batched_partial_scan;
+		m_batched_partial_scan = -1;
+		draw_partial(scanline);
+	}
+}
+
+
+//-------------------------------------------------
+//  draw_partial - draw from the last scanline up
+//  to and including the specified scanline
+//-------------------------------------------------
+
+bool screen_device::draw_partial(int scanline)
 {
 	LOG_PARTIAL_UPDATES(("Partial: update_partial(%s, %d): ", tag(), scanline));
 
@@ -1104,13 +1222,34 @@ bool screen_device::update_partial(int scanline)
 	u32 flags;
 	if (m_type != SCREEN_TYPE_SVG)
 	{
+		// only an update covering the whole visible area can be split into bands
 		screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
-		switch (curbitmap.format())
+		m_full_frame_update = (clip == m_visarea) && (m_partial_updates_this_frame == 0);
+		if (m_full_frame_update && m_parallel_update && (draw_bands() > 1) && !g_profiler.enabled())
 		{
-			default:
-			case BITMAP_FORMAT_IND16:   flags = m_screen_update_ind16(*this, curbitmap.as_ind16(), clip);   break;
-			case BITMAP_FORMAT_RGB32:   flags = m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);   break;
+			// the driver has said its update only touches the rows it is given
+			std::atomic<u32> bandflags(UPDATE_HAS_NOT_CHANGED);
+			m_band_update_active = true;
+			draw_in_bands(clip, [this, &curbitmap, &bandflags] (const rectangle &band)
+			{
+				u32 const result = (curbitmap.format() == BITMAP_FORMAT_RGB32)
+						? m_screen_update_rgb32(*this, curbitmap.as_rgb32(), band)
+						: m_screen_update_ind16(*this, curbitmap.as_ind16(), band);
+				bandflags &= result;
+			});
+			m_band_update_active = false;
+			flags = bandflags;
 		}
+		else
+		{
+			switch (curbitmap.format())
+			{
+				default:
+				case BITMAP_FORMAT_IND16:   flags = m_screen_update_ind16(*this, curbitmap.as_ind16(), clip);   break;
+				case BITMAP_FORMAT_RGB32:   flags = m_screen_update_rgb32(*this, curbitmap.as_rgb32(), clip);   break;
+			}
+		}
+		m_full_frame_update = false;
 	}
 	else
 	{
@@ -1129,6 +1268,71 @@ bool screen_device::update_partial(int scanline)
 }
 
 
+//-------------------------------------------------
+//  draw_bands - return the number of bands a
+//  draw made now may be split into
+//-------------------------------------------------
+
+int screen_device::draw_bands() const
+{
+	// mid-frame partial updates stay serial, as do draws already running in a band
+	if (!m_full_frame_update || m_band_update_active)
+		return 1;
+	return m_bands;
+}
+
+
+//-------------------------------------------------
+//  draw_in_bands - split a cliprect into
+//  horizontal bands and draw them concurrently,
+//  or draw it directly if banding is not allowed
+//-------------------------------------------------
+
+namespace {
+
+struct draw_band
+{
+	const std::function<void (const rectangle &)> *draw;
+	rectangle cliprect;
+};
+
+} // anonymous namespace
+
+void *screen_device::draw_band_callback(void *param, int threadid)
+{
+	draw_band &band = *reinterpret_cast<draw_band *>(param);
+	(*band.draw)(band.cliprect);
+	return nullptr;
+}
+
+void screen_device::draw_in_bands(const rectangle &cliprect, const std::function<void (const rectangle &)> &draw)
+{
+	// bands shorter than this cost more to dispatch than they save
+	static constexpr int MIN_BAND_HEIGHT = 16;
+
+	int const count = std::min(draw_bands(), cliprect.height() / MIN_BAND_HEIGHT);
+	if (count < 2)
+	{
+		draw(cliprect);
+		return;
+	}
+
+	// divide the rows as evenly as possible; each band owns its rows of the bitmap and priority bitmap
+	std::vector<draw_band> bands(count);
+	for (int band = 0; band < count; band++)
+	{
+		bands[band].draw = &draw;
+		bands[band].cliprect = cliprect;
+		bands[band].cliprect.sety(
+				cliprect.top() + cliprect.height() * band / count,
+				cliprect.top() + cliprect.height() * (band + 1) / count - 1);
+	}
+
+	osd_work_item_queue_multiple(m_band_queue, draw_band_callback, count, &bands[0], sizeof(bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(m_band_queue, osd_ticks_per_second() * 100);
+}
+
+
 //-------------------------------------------------
 //  update_now - perform an update from the last
 //  beam position up to the current beam position
@@ -1136,6 +1340,9 @@ bool screen_device::update_partial(int scanline)
 
 void screen_device::update_now()
 {
+	// beam-accurate updates can't be batched
+	video_state_changed();
+
 	// these two checks only apply if we're allowed to skip frames
 	if (!(m_video_attributes & VIDEO_ALWAYS_UPDATE))
 	{
@@ -1258,13 +1465,47 @@ void screen_device::update_now()
 
 void screen_device::reset_partial_updates()
 {
+	// whatever was asked for last frame still gets drawn
+	video_state_changed();
+
+	// count the frame for the profiler
+	m_stat_frames++;
+	m_stat_partial_updates += m_partial_updates_this_frame;
+	m_stat_coalesced += m_coalesced_this_frame;
+
 	m_last_partial_scan = 0;
 	m_partial_scan_hpos = 0;
 	m_partial_updates_this_frame = 0;
+	m_batched_partial_scan = -1;
+	m_coalesced_this_frame = 0;
 	m_scanline0_timer->adjust(time_until_pos(0));
 }
 
 
+//-------------------------------------------------
+//  partial_update_text - describe how many partial
+//  updates there have been per frame since the
+//  last call
+//-------------------------------------------------
+
+std::string screen_device::partial_update_text()
+{
+	std::string result;
+	if (m_stat_frames > 0 && (m_stat_partial_updates > m_stat_frames || m_stat_coalesced > 0))
+	{
+		result = util::string_format("'%s': %.1f partial updates/frame", tag(), double(m_stat_partial_updates) / double(m_stat_frames));
+		if (m_batched_update)
+			result.append(util::string_format(", %.1f coalesced", double(m_stat_coalesced) / double(m_stat_frames)));
+		result.append("\n");
+	}
+
+	m_stat_frames = 0;
+	m_stat_partial_updates = 0;
+	m_stat_coalesced = 0;
+	return result;
+}
+
+
 //-------------------------------------------------
 //  pixel - returns the RGB value of the specified
 //  pixel location
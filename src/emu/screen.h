@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <functional>
 #include <utility>
 
 
@@ -110,6 +111,15 @@ public:
 
 	// resizing
 	void resize(int width, int height) { live().resize(width, height); }
+	void wrap(void *base, int width, int height, int rowpixels)
+	{
+		switch (m_format)
+		{
+			case BITMAP_FORMAT_IND16:   m_ind16.wrap(reinterpret_cast<u16 *>(base), width, height, rowpixels);  break;
+			case BITMAP_FORMAT_RGB32:   m_rgb32.wrap(reinterpret_cast<u32 *>(base), width, height, rowpixels);  break;
+			default:                    break;
+		}
+	}
 
 	// conversion
 	operator bitmap_t &() { return live(); }
@@ -263,6 +273,8 @@ public:
 	void set_video_attributes(u32 flags) { m_video_attributes = flags; }
 	void set_color(rgb_t color) { m_color = color; }
 	void set_svg_region(const char *region) { m_svg_region = region; }
+	void set_parallel_update(bool parallel) { m_parallel_update = parallel; }
+	void set_batched_update(bool batched) { m_batched_update = batched; }
 
 	// information getters
 	render_container &container() const { assert(m_container != nullptr); return *m_container; }
@@ -301,6 +313,13 @@ public:
 	bool update_partial(int scanline);
 	void update_now();
 	void reset_partial_updates();
+	void video_state_changed();
+	std::string partial_update_text();
+
+	// band-parallel rendering
+	bool in_band_update() const { return m_band_update_active; }
+	int draw_bands() const;
+	void draw_in_bands(const rectangle &cliprect, const std::function<void (const rectangle &)> &draw);
 
 	// additional helpers
 	void register_vblank_callback(vblank_state_delegate vblank_callback);
@@ -339,10 +358,13 @@ private:
 	// internal helpers
 	void set_container(render_container &container) { m_container = &container; }
 	void realloc_screen_bitmaps();
+	void resize_screen_bitmap(int index, s32 width, s32 height);
 	void vblank_begin();
 	void vblank_end();
 	void finalize_burnin();
 	void load_effect_overlay(const char *filename);
+	static void *draw_band_callback(void *param, int threadid);
+	bool draw_partial(int scanline);
 
 	// inline configuration data
 	screen_type_enum    m_type;                     // type of screen
@@ -360,6 +382,8 @@ private:
 	optional_device<device_palette_interface> m_palette;      // our palette
 	u32                 m_video_attributes;         // flags describing the video system
 	const char *        m_svg_region;               // the region in which the svg data is in
+	bool                m_parallel_update;          // screen update may be called concurrently for disjoint bands
+	bool                m_batched_update;           // partial updates wait for video_state_changed() or the end of the frame
 
 	// internal state
 	render_container *  m_container;                // pointer to our container
@@ -373,6 +397,8 @@ private:
 	texture_format      m_texformat;                // texture format
 	render_texture *    m_texture[2];               // 2x textures for the screen bitmap
 	screen_bitmap       m_bitmap[2];                // 2x bitmaps for rendering
+	render_bitmap_allocator *m_bitmap_allocator[2]; // where the memory behind each bitmap came from, if it isn't its own
+	void *              m_bitmap_memory[2];         // memory provided by the OSD renderer
 	bitmap_ind8         m_priority;                 // priority bitmap
 	bitmap_ind64        m_burnin;                   // burn-in bitmap
 	u8                  m_curbitmap;                // current bitmap index
@@ -398,6 +424,17 @@ private:
 	emu_timer *         m_scanline_timer;           // scanline timer
 	u64                 m_frame_number;             // the current frame number
 	u32                 m_partial_updates_this_frame;// partial update counter this frame
+	s32                 m_batched_partial_scan;     // last scanline asked for but not yet drawn, or -1
+	u32                 m_coalesced_this_frame;     // partial updates folded into a later one this frame
+	u32                 m_stat_frames;              // frames since the statistics were last reported
+	u64                 m_stat_partial_updates;     // partial updates drawn in those frames
+	u64                 m_stat_coalesced;           // partial updates coalesced in those frames
+
+	// band-parallel rendering
+	int                 m_bands;                    // number of bands to split full-frame updates into
+	bool                m_full_frame_update;        // a full-frame update is in progress
+	bool                m_band_update_active;       // screen update is running in bands on worker threads
+	osd_work_queue *    m_band_queue;               // work queue for rendering bands
 
 	bool                m_is_primary_screen;
 
@@ -566,5 +603,9 @@ typedef device_type_iterator<screen_device> screen_device_iterator;
 	downcast<screen_device &>(*device).set_video_attributes(_flags);
 #define MCFG_SCREEN_COLOR(_color) \
 	downcast<screen_device &>(*device).set_color(_color);
+#define MCFG_SCREEN_PARALLEL_UPDATE() \
+	downcast<screen_device &>(*device).set_parallel_update(true);
+#define MCFG_SCREEN_BATCHED_UPDATE() \
+	downcast<screen_device &>(*device).set_batched_update(true);
 
 #endif // MAME_EMU_SCREEN_H
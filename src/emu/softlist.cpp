@@ -827,6 +827,220 @@ void softlist_parser::parse_soft_end(const char *tagname)
 }
 
 
+//**************************************************************************
+//  SOFTWARE LIST CACHE
+//**************************************************************************
+
+namespace {
+
+// little-endian writer for the cache image
+class cache_writer
+{
+public:
+	cache_writer(std::vector<u8> &data) : m_data(data) { }
+
+	void u32_value(u32 value)
+	{
+		for (int shift = 0; shift < 32; shift += 8)
+			m_data.push_back(u8(value >> shift));
+	}
+
+	void u64_value(u64 value)
+	{
+		u32_value(u32(value));
+		u32_value(u32(value >> 32));
+	}
+
+	void string(const std::string &value)
+	{
+		u32_value(value.length());
+		m_data.insert(m_data.end(), value.begin(), value.end());
+	}
+
+	void features(const std::list<feature_list_item> &list)
+	{
+		u32_value(list.size());
+		for (const feature_list_item &item : list)
+		{
+			string(item.name());
+			string(item.value());
+		}
+	}
+
+private:
+	std::vector<u8> &m_data;
+};
+
+
+// bounds-checked reader matching cache_writer; any overrun poisons the reader
+class cache_reader
+{
+public:
+	cache_reader(const std::vector<u8> &data) : m_data(data), m_offset(0), m_ok(true) { }
+
+	bool ok() const { return m_ok; }
+	bool done() const { return m_ok && (m_offset == m_data.size()); }
+
+	u32 u32_value()
+	{
+		if (!check(4))
+			return 0;
+		u32 const result = u32(m_data[m_offset]) | (u32(m_data[m_offset + 1]) << 8) | (u32(m_data[m_offset + 2]) << 16) | (u32(m_data[m_offset + 3]) << 24);
+		m_offset += 4;
+		return result;
+	}
+
+	u64 u64_value()
+	{
+		u64 const low = u32_value();
+		return low | (u64(u32_value()) << 32);
+	}
+
+	std::string string()
+	{
+		u32 const length = u32_value();
+		if (!check(length))
+			return std::string();
+		std::string result(reinterpret_cast<const char *>(&m_data[m_offset]), length);
+		m_offset += length;
+		return result;
+	}
+
+	void features(std::list<feature_list_item> &list)
+	{
+		for (u32 count = u32_value(); m_ok && count; count--)
+		{
+			std::string name = string();
+			std::string value = string();
+			list.emplace_back(std::move(name), std::move(value));
+		}
+	}
+
+private:
+	bool check(std::size_t length)
+	{
+		if (m_ok && ((m_data.size() - m_offset) < length))
+			m_ok = false;
+		return m_ok;
+	}
+
+	const std::vector<u8> &m_data;
+	std::size_t m_offset;
+	bool m_ok;
+};
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  read - rebuild a parsed list from a cache
+//  image, returning false if the image is
+//  damaged or stale
+//-------------------------------------------------
+
+bool softlist_cache::read(const std::vector<u8> &data, u64 size, s64 modified, std::string &description, std::list<software_info> &infolist)
+{
+	cache_reader reader(data);
+	if ((reader.u32_value() != MAGIC) || (reader.u32_value() != VERSION))
+		return false;
+	if ((reader.u64_value() != size) || (s64(reader.u64_value()) != modified) || !reader.ok())
+		return false;
+
+	std::string listdesc = reader.string();
+	std::list<software_info> list;
+	for (u32 infocount = reader.u32_value(); reader.ok() && infocount; infocount--)
+	{
+		std::string shortname = reader.string();
+		std::string parentname = reader.string();
+		list.emplace_back(std::move(shortname), std::move(parentname), std::string());
+		software_info &info(list.back());
+		info.m_supported = reader.u32_value();
+		info.m_longname = reader.string();
+		info.m_year = reader.string();
+		info.m_publisher = reader.string();
+		reader.features(info.m_other_info);
+		reader.features(info.m_shared_info);
+
+		for (u32 partcount = reader.u32_value(); reader.ok() && partcount; partcount--)
+		{
+			std::string partname = reader.string();
+			std::string interface = reader.string();
+			info.m_partdata.emplace_back(info, std::move(partname), std::move(interface));
+			software_part &part(info.m_partdata.back());
+			reader.features(part.m_featurelist);
+
+			u32 const romcount = reader.u32_value();
+			if (reader.ok())
+				part.m_romdata.reserve(std::min<u32>(romcount, data.size()));
+			for (u32 romnum = 0; reader.ok() && (romnum < romcount); romnum++)
+			{
+				std::string romname = reader.string();
+				std::string hashdata = reader.string();
+				u32 const offset = reader.u32_value();
+				u32 const length = reader.u32_value();
+				u32 const flags = reader.u32_value();
+				part.m_romdata.emplace_back(std::move(romname), std::move(hashdata), offset, length, flags);
+			}
+		}
+	}
+
+	// only hand over a complete image
+	if (!reader.done())
+		return false;
+	description = std::move(listdesc);
+	infolist = std::move(list);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  write - serialise a parsed list into a cache
+//  image
+//-------------------------------------------------
+
+void softlist_cache::write(std::vector<u8> &data, u64 size, s64 modified, const std::string &description, const std::list<software_info> &infolist)
+{
+	data.clear();
+	cache_writer writer(data);
+	writer.u32_value(MAGIC);
+	writer.u32_value(VERSION);
+	writer.u64_value(size);
+	writer.u64_value(modified);
+
+	writer.string(description);
+	writer.u32_value(infolist.size());
+	for (const software_info &info : infolist)
+	{
+		writer.string(info.shortname());
+		writer.string(info.parentname());
+		writer.u32_value(info.supported());
+		writer.string(info.longname());
+		writer.string(info.year());
+		writer.string(info.publisher());
+		writer.features(info.other_info());
+		writer.features(info.shared_info());
+
+		writer.u32_value(info.parts().size());
+		for (const software_part &part : info.parts())
+		{
+			writer.string(part.name());
+			writer.string(part.interface());
+			writer.features(part.featurelist());
+
+			writer.u32_value(part.romdata().size());
+			for (const rom_entry &rom : part.romdata())
+			{
+				writer.string(rom.name());
+				writer.string(rom.hashdata());
+				writer.u32_value(rom.get_offset());
+				writer.u32_value(rom.get_length());
+				writer.u32_value(rom.get_flags());
+			}
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  software_name_parse - helper that splits a
 //  software identifier (software_list:software:part)
@@ -19,6 +19,7 @@
 #include "corefile.h"
 
 #include <list>
+#include <vector>
 
 
 //**************************************************************************
@@ -67,6 +68,7 @@ private:
 class software_part
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 
 public:
 	// construction/destruction
@@ -105,6 +107,7 @@ private:
 class software_info
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 
 public:
 	// construction/destruction
@@ -207,6 +210,22 @@ private:
 };
 
 
+// ======================> softlist_cache
+
+// binary image of a parsed software list, stamped with the size and
+// modification time of the XML it was built from
+class softlist_cache
+{
+public:
+	static bool read(const std::vector<u8> &data, u64 size, s64 modified, std::string &description, std::list<software_info> &infolist);
+	static void write(std::vector<u8> &data, u64 size, s64 modified, const std::string &description, const std::list<software_info> &infolist);
+
+private:
+	static const u32 MAGIC = 0x534c4331; // 'SLC1'
+	static const u32 VERSION = 1;
+};
+
+
 // ----- Helpers -----
 
 // parses a software identifier (e.g. - 'apple2e:agentusa:flop1') into its constituent parts (returns false if cannot parse)
@@ -86,7 +86,8 @@ software_list_device::software_list_device(const machine_config &mconfig, const
 	m_filter(nullptr),
 	m_parsed(false),
 	m_file(mconfig.options().hash_path(), OPEN_FLAG_READ),
-	m_description("")
+	m_description(""),
+	m_crc_indexed(false)
 {
 }
 
@@ -176,6 +177,9 @@ void software_list_device::release()
 	m_description.clear();
 	m_errors.clear();
 	m_infolist.clear();
+	m_name_index.clear();
+	m_crc_index.clear();
+	m_crc_indexed = false;
 }
 
 
@@ -251,16 +255,22 @@ const software_info *software_list_device::find(const std::string &look_for)
 
 	const bool iswild = look_for.find_first_of("*?") != std::string::npos;
 
-	// find a match (will cause a parse if needed when calling get_info)
+	// plain names go straight to the index (will cause a parse if needed when calling get_info)
 	const auto &info_list = get_info();
+	if (!iswild)
+	{
+		std::string name(look_for);
+		auto const found = m_name_index.find(strmakelower(name));
+		return (found != m_name_index.end()) ? found->second : nullptr;
+	}
+
+	// otherwise scan for a wildcard match
 	auto iter = std::find_if(
 		info_list.begin(),
 		info_list.end(),
 		[&](const software_info &info)
 	{
-		const char *shortname = info.shortname().c_str();
-		return (iswild && core_strwildcmp(look_for.c_str(), shortname) == 0)
-			|| core_stricmp(look_for.c_str(), shortname) == 0;
+		return core_strwildcmp(look_for.c_str(), info.shortname().c_str()) == 0;
 	});
 
 	return iter != info_list.end()
@@ -286,20 +296,109 @@ void software_list_device::parse()
 	osd_file::error filerr = m_file.open(m_list_name.c_str(), ".xml");
 	if (filerr == osd_file::error::NONE)
 	{
-		// parse if no error
-		std::ostringstream errs;
-		softlist_parser parser(m_file, m_file.filename(), m_description, m_infolist, errs);
+		// the cache is only good for the exact XML it was built from
+		u64 const size = m_file.size();
+		s64 modified = 0;
+		auto const stat = osd_stat(m_file.fullpath());
+		if (stat)
+			modified = std::chrono::duration_cast<std::chrono::seconds>(stat->last_modified.time_since_epoch()).count();
+
+		// parse if there's no usable cache
+		if (!load_cache(size, modified))
+		{
+			std::ostringstream errs;
+			softlist_parser parser(m_file, m_file.filename(), m_description, m_infolist, errs);
+			m_errors = errs.str();
+			if (m_errors.empty())
+				save_cache(size, modified);
+		}
 		m_file.close();
-		m_errors = errs.str();
 	}
 	else
 		m_errors = string_format("Error opening file: %s\n", filename());
 
+	// index by name for find
+	for (const software_info &info : m_infolist)
+	{
+		std::string name(info.shortname());
+		m_name_index.emplace(strmakelower(name), &info);
+	}
+
 	// indicate that we've been parsed
 	m_parsed = true;
 }
 
 
+//-------------------------------------------------
+//  load_cache - try to fill in our list from the
+//  binary cache in the configuration directory
+//-------------------------------------------------
+
+bool software_list_device::load_cache(u64 size, s64 modified)
+{
+	std::string const cachedir(mconfig().options().softlist_cache());
+	if (cachedir.empty())
+		return false;
+
+	emu_file file(mconfig().options().cfg_directory(), OPEN_FLAG_READ);
+	if (file.open(cachedir + PATH_SEPARATOR + m_list_name, ".slc") != osd_file::error::NONE)
+		return false;
+
+	std::vector<u8> data(file.size());
+	if (!data.empty() && (file.read(&data[0], data.size()) != data.size()))
+		return false;
+	return softlist_cache::read(data, size, modified, m_description, m_infolist);
+}
+
+
+//-------------------------------------------------
+//  save_cache - write our freshly parsed list to
+//  the binary cache
+//-------------------------------------------------
+
+void software_list_device::save_cache(u64 size, s64 modified)
+{
+	std::string const cachedir(mconfig().options().softlist_cache());
+	if (cachedir.empty())
+		return;
+
+	emu_file file(mconfig().options().cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(cachedir + PATH_SEPARATOR + m_list_name, ".slc") != osd_file::error::NONE)
+		return;
+
+	std::vector<u8> data;
+	softlist_cache::write(data, size, modified, m_description, m_infolist);
+	file.write(&data[0], data.size());
+}
+
+
+//-------------------------------------------------
+//  find_by_crc - find ROM entries with the given
+//  CRC, building the index on first use
+//-------------------------------------------------
+
+std::pair<software_list_device::crc_map::const_iterator, software_list_device::crc_map::const_iterator> software_list_device::find_by_crc(u32 crc)
+{
+	if (!m_crc_indexed)
+	{
+		for (const software_info &info : get_info())
+		{
+			for (const software_part &part : info.parts())
+			{
+				for (const rom_entry &rom : part.romdata())
+				{
+					u32 romcrc;
+					if (ROMENTRY_ISFILE(&rom) && util::hash_collection(rom.hashdata().c_str()).crc(romcrc))
+						m_crc_index.emplace(romcrc, crc_match{ &info, &rom });
+				}
+			}
+		}
+		m_crc_indexed = true;
+	}
+	return m_crc_index.equal_range(crc);
+}
+
+
 //-------------------------------------------------
 //  is_compatible - determine if we are compatible
 //  with the given software_list_device
@@ -16,6 +16,8 @@
 
 #include "softlist.h"
 
+#include <unordered_map>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -131,6 +133,14 @@ class software_list_device : public device_t
 	friend class softlist_parser;
 
 public:
+	// a ROM entry found by CRC, along with the software it belongs to
+	struct crc_match
+	{
+		const software_info *   info;
+		const rom_entry *       rom;
+	};
+	typedef std::unordered_multimap<u32, crc_match> crc_map;
+
 	// construction/destruction
 	software_list_device(const machine_config &mconfig, const char *tag, device_t *owner, u32 clock = 0);
 
@@ -154,6 +164,7 @@ public:
 
 	// operations
 	const software_info *find(const std::string &look_for);
+	std::pair<crc_map::const_iterator, crc_map::const_iterator> find_by_crc(u32 crc);
 	void find_approx_matches(const std::string &name, int matches, const software_info **list, const char *interface);
 	void release();
 	software_compatibility is_compatible(const software_part &part) const;
@@ -172,6 +183,8 @@ protected:
 private:
 	// internal helpers
 	void parse();
+	bool load_cache(u64 size, s64 modified);
+	void save_cache(u64 size, s64 modified);
 	void internal_validity_check(validity_checker &valid) ATTR_COLD;
 
 	// configuration state
@@ -185,6 +198,9 @@ private:
 	std::string                 m_description;
 	std::string                 m_errors;
 	std::list<software_info>    m_infolist;
+	std::unordered_map<std::string, const software_info *> m_name_index;
+	crc_map                     m_crc_index;
+	bool                        m_crc_indexed;
 };
 
 
@@ -15,6 +15,17 @@
 #include "config.h"
 #include "wavwrite.h"
 
+#include <numeric>
+#include <unordered_map>
+
+// the final mix has an SSE2 path under the same conditions as rgbutil.h
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define SOUND_USE_SSE2      1
+#else
+#define SOUND_USE_SSE2      0
+#endif
+
 
 
 //**************************************************************************
@@ -65,7 +76,11 @@ sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample
 		m_output_sampindex(0),
 		m_output_update_sampindex(0),
 		m_output_base_sampindex(0),
-		m_callback(std::move(callback))
+		m_callback(std::move(callback)),
+		m_idle(false),
+		m_idle_samples(0),
+		m_active_samples(0),
+		m_active_ticks(0)
 {
 	// get the device's sound interface
 	device_sound_interface *sound;
@@ -251,6 +266,7 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	// update the dependent info
 	if (input.m_source != nullptr)
 		input.m_source->m_dependents++;
+	m_device.machine().sound().m_update_groups_dirty = true;
 
 	// update sample rates now that we know the input
 	recompute_sample_rate_data();
@@ -289,12 +305,15 @@ void sound_stream::update()
 	if (update_sampindex <= m_output_sampindex)
 		return;
 
-	// generate samples to get us up to the appropriate time
-	g_profiler.start(PROFILER_SOUND);
+	// generate samples to get us up to the appropriate time; the profiler isn't safe to use from the update groups
+	bool const profile = !m_device.machine().sound().m_parallel_active;
+	if (profile)
+		g_profiler.start(PROFILER_SOUND);
 	assert(m_output_sampindex - m_output_base_sampindex >= 0);
 	assert(update_sampindex - m_output_base_sampindex <= m_output_bufalloc);
 	generate_samples(update_sampindex - m_output_sampindex);
-	g_profiler.stop();
+	if (profile)
+		g_profiler.stop();
 
 	// remember this info for next time
 	m_output_sampindex = update_sampindex;
@@ -526,6 +545,11 @@ void sound_stream::recompute_sample_rate_data()
 			else if (input.m_source->m_stream->m_sample_rate == m_sample_rate)
 				latency = 0;
 
+			// a filter bank reads ahead by half its width
+			input.m_resampler = m_device.machine().sound().resampler(input.m_source->m_stream->m_sample_rate, m_sample_rate);
+			if (input.m_resampler != nullptr)
+				latency += input.m_resampler->lookahead() * new_attosecs_per_sample;
+
 			// we generally don't want to tweak the latency, so we just keep the greatest
 			// one we've computed thus far
 			input.m_latency_attoseconds = std::max(input.m_latency_attoseconds, latency);
@@ -534,6 +558,7 @@ void sound_stream::recompute_sample_rate_data()
 		else
 		{
 			input.m_latency_attoseconds = 0;
+			input.m_resampler = nullptr;
 		}
 	}
 
@@ -608,6 +633,9 @@ void sound_stream::allocate_output_buffers()
 
 void sound_stream::postload()
 {
+	// the restored device state may be playing
+	m_idle = false;
+
 	// recompute the same rate information
 	recompute_sample_rate_data();
 
@@ -637,6 +665,16 @@ void sound_stream::generate_samples(int samples)
 	VPRINTF(("generate_samples(%p, %d)\n", (void *) this, samples));
 	assert(samples > 0);
 
+	// an idle stream repeats its last output without looking at its inputs
+	if (m_idle)
+	{
+		s32 const position = m_output_sampindex - m_output_base_sampindex;
+		for (stream_output &output : m_output)
+			std::fill_n(&output.m_buffer[position], samples, (position > 0) ? output.m_buffer[position - 1] : 0);
+		m_idle_samples += samples;
+		return;
+	}
+
 	// ensure all inputs are up to date and generate resampled data
 	for (unsigned int inputnum = 0; inputnum < m_input.size(); inputnum++)
 	{
@@ -668,7 +706,10 @@ void sound_stream::generate_samples(int samples)
 
 	// run the callback
 	VPRINTF(("  callback(%p, %d)\n", (void *)this, samples));
+	osd_ticks_t const start = osd_ticks();
 	m_callback(*this, inputs, outputs, samples);
+	m_active_ticks += osd_ticks() - start;
+	m_active_samples += samples;
 	VPRINTF(("  callback done\n"));
 }
 
@@ -716,78 +757,11 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, u32
 	// compute the stepping fraction
 	u32 step = (u64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
 
-	// if we have equal sample rates, we just need to copy
-	if (step == FRAC_ONE)
-	{
-		while (numsamples--)
-		{
-			// compute the sample
-			s64 sample = *source++;
-			*dest++ = (sample * gain) >> 8;
-		}
-	}
-
-	// input is undersampled: point sample except where our sample period covers a boundary
-	else if (step < FRAC_ONE)
-	{
-		while (numsamples != 0)
-		{
-			// fill in with point samples until we hit a boundary
-			int nextfrac;
-			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
-			{
-				*dest++ = (source[0] * gain) >> 8;
-				basefrac = nextfrac;
-			}
-
-			// if we're done, we're done
-			if (s32(numsamples--) < 0)
-				break;
-
-			// compute starting and ending fractional positions
-			int startfrac = basefrac >> (FRAC_BITS - 12);
-			int endfrac = nextfrac >> (FRAC_BITS - 12);
-
-			// blend between the two samples accordingly
-			s64 sample = (s64(source[0]) * (0x1000 - startfrac) + s64(source[1]) * (endfrac - 0x1000)) / (endfrac - startfrac);
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac = nextfrac & FRAC_MASK;
-			source++;
-		}
-	}
-
-	// input is oversampled: sum the energy
+	// the filter bank also needs history from before the first sample
+	if (input.m_resampler != nullptr && basesample - s32(input.m_resampler->history()) >= input_stream.m_output_base_sampindex)
+		input.m_resampler->resample(source, basefrac, step, dest, numsamples, gain);
 	else
-	{
-		// use 8 bits to allow some extra headroom
-		int smallstep = step >> (FRAC_BITS - 8);
-		while (numsamples--)
-		{
-			s64 remainder = smallstep;
-			int tpos = 0;
-
-			// compute the sample
-			s64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
-			s64 sample = s64(source[tpos++]) * scale;
-			remainder -= scale;
-			while (remainder > 0x100)
-			{
-				sample += s64(source[tpos++]) * s64(0x100);
-				remainder -= 0x100;
-			}
-			sample += s64(source[tpos]) * remainder;
-			sample /= smallstep;
-
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac += step;
-			source += basefrac >> FRAC_BITS;
-			basefrac &= FRAC_MASK;
-		}
-	}
+		sound_resampler::resample_linear(source, basefrac, step, dest, numsamples, gain);
 
 	return &input.m_resample[0];
 }
@@ -805,6 +779,7 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, u32
 sound_stream::stream_input::stream_input()
 	: m_source(nullptr),
 		m_latency_attoseconds(0),
+		m_resampler(nullptr),
 		m_gain(0x100),
 		m_user_gain(0x100)
 {
@@ -847,9 +822,14 @@ sound_manager::sound_manager(running_machine &machine)
 		m_muted(0),
 		m_attenuation(0),
 		m_nosound_mode(machine.osd().no_sound()),
+		m_output_suppressed(false),
 		m_wavfile(nullptr),
+		m_sinc_resampling(!strcmp(machine.options().resampler(), "sinc")),
 		m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds()),
-		m_last_update(attotime::zero)
+		m_last_update(attotime::zero),
+		m_update_queue(nullptr),
+		m_update_groups_dirty(true),
+		m_parallel_active(false)
 {
 	// get filename for WAV file or AVI file if specified
 	const char *wavfile = machine.options().wav_write();
@@ -859,6 +839,9 @@ sound_manager::sound_manager(running_machine &machine)
 	if (m_nosound_mode && wavfile[0] == 0 && avifile[0] == 0)
 		machine.m_sample_rate = 11025;
 
+	if (!m_sinc_resampling && strcmp(machine.options().resampler(), "linear"))
+		osd_printf_warning("Unknown -resampler %s, using linear\n", machine.options().resampler());
+
 	// count the mixers
 #if VERBOSE
 	mixer_interface_iterator iter(machine.root_device());
@@ -871,6 +854,7 @@ sound_manager::sound_manager(running_machine &machine)
 	machine.add_notifier(MACHINE_NOTIFY_RESUME, machine_notify_delegate(&sound_manager::resume, this));
 	machine.add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(&sound_manager::reset, this));
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&sound_manager::stop_recording, this));
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&sound_manager::log_idle_stats, this));
 
 	// register global states
 	machine.save().save_item(NAME(m_last_update));
@@ -890,6 +874,8 @@ sound_manager::sound_manager(running_machine &machine)
 
 sound_manager::~sound_manager()
 {
+	if (m_update_queue != nullptr)
+		osd_work_queue_free(m_update_queue);
 }
 
 
@@ -919,6 +905,28 @@ void sound_manager::stop_recording()
 }
 
 
+//-------------------------------------------------
+//  log_idle_stats - report the samples each
+//  stream didn't have to generate, and roughly
+//  the time that saved
+//-------------------------------------------------
+
+void sound_manager::log_idle_stats()
+{
+	for (auto &stream : m_stream_list)
+		if (stream->m_idle_samples != 0)
+		{
+			double const per_sample = stream->m_active_samples ? double(stream->m_active_ticks) / double(stream->m_active_samples) : 0.0;
+			double const saved = per_sample * double(stream->m_idle_samples) * 1000.0 / double(osd_ticks_per_second());
+			osd_printf_verbose("Sound stream %s: %u%% of %u samples idle, about %.1f ms saved\n",
+					stream->device().tag(),
+					unsigned(stream->m_idle_samples * 100 / (stream->m_idle_samples + stream->m_active_samples)),
+					unsigned(stream->m_idle_samples + stream->m_active_samples),
+					saved);
+		}
+}
+
+
 //-------------------------------------------------
 //  stream_alloc - allocate a new stream
 //-------------------------------------------------
@@ -926,10 +934,30 @@ void sound_manager::stop_recording()
 sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback)
 {
 	m_stream_list.push_back(std::make_unique<sound_stream>(device, inputs, outputs, sample_rate, callback));
+	m_update_groups_dirty = true;
 	return m_stream_list.back().get();
 }
 
 
+//-------------------------------------------------
+//  resampler - return the filter bank for
+//  converting between two rates, shared by every
+//  input doing the same conversion, or nullptr
+//  to use linear conversion
+//-------------------------------------------------
+
+const sound_resampler *sound_manager::resampler(u32 source_rate, u32 dest_rate)
+{
+	if (!m_sinc_resampling || source_rate == dest_rate)
+		return nullptr;
+
+	std::unique_ptr<sound_resampler> &bank = m_resamplers[std::make_pair(source_rate, dest_rate)];
+	if (!bank)
+		bank = std::make_unique<sound_resampler>(source_rate, dest_rate);
+	return bank.get();
+}
+
+
 //-------------------------------------------------
 //  set_attenuation - set the global volume
 //-------------------------------------------------
@@ -1088,6 +1116,17 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.start(PROFILER_SOUND);
 
+	// bring the independent parts of the stream graph up to date concurrently
+	if (m_update_groups_dirty)
+		rebuild_update_groups();
+	if (!m_update_groups.empty())
+	{
+		m_parallel_active = true;
+		osd_work_item_queue_multiple(m_update_queue, update_group_callback, m_update_groups.size(), &m_update_groups[0], sizeof(m_update_groups[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(m_update_queue, osd_ticks_per_second() * 100);
+		m_parallel_active = false;
+	}
+
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
 	for (speaker_device &speaker : speaker_device_iterator(machine().root_device()))
@@ -1097,8 +1136,22 @@ void sound_manager::update(void *ptr, int param)
 	u32 finalmix_step = machine().video().speed_factor();
 	u32 finalmix_offset = 0;
 	s16 *finalmix = &m_finalmix[0];
-	int sample;
-	for (sample = m_finalmix_leftover; sample < samples_this_update * 1000; sample += finalmix_step)
+	int sample = m_finalmix_leftover;
+#if SOUND_USE_SSE2
+	// at normal speed every sample goes out, so clamp and interleave four pairs at a time
+	if (finalmix_step == 1000 && sample == 0)
+	{
+		for ( ; sample + 4 <= samples_this_update; sample += 4)
+		{
+			__m128i const left = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&m_leftmix[sample]));
+			__m128i const right = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&m_rightmix[sample]));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&finalmix[finalmix_offset]), _mm_packs_epi32(_mm_unpacklo_epi32(left, right), _mm_unpackhi_epi32(left, right)));
+			finalmix_offset += 8;
+		}
+		sample *= 1000;
+	}
+#endif
+	for ( ; sample < samples_this_update * 1000; sample += finalmix_step)
 	{
 		int sampindex = sample / 1000;
 
@@ -1121,7 +1174,7 @@ void sound_manager::update(void *ptr, int param)
 	m_finalmix_leftover = sample - samples_this_update * 1000;
 
 	// play the result
-	if (finalmix_offset > 0)
+	if (finalmix_offset > 0 && !m_output_suppressed)
 	{
 		if (!m_nosound_mode)
 			machine().osd().update_audio_stream(finalmix, finalmix_offset / 2);
@@ -1153,3 +1206,95 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.stop();
 }
+
+
+//-------------------------------------------------
+//  rebuild_update_groups - split the streams
+//  that feed the final mix into groups that
+//  share no devices or connections
+//-------------------------------------------------
+
+void sound_manager::rebuild_update_groups()
+{
+	m_update_groups.clear();
+	m_update_groups_dirty = false;
+
+	// the debugger expects to see one device at a time
+	if (machine().debug_flags & DEBUG_FLAG_ENABLED)
+		return;
+
+	std::unordered_map<sound_stream const *, size_t> index;
+	for (size_t i = 0; i < m_stream_list.size(); i++)
+		index.emplace(m_stream_list[i].get(), i);
+
+	// mixers only sum their inputs, so they and anything fed from one are left for the final mix
+	std::vector<bool> final(m_stream_list.size(), false);
+	for (device_mixer_interface &mixer : mixer_interface_iterator(machine().root_device()))
+		if (mixer.mixer_stream() != nullptr)
+			final[index[mixer.mixer_stream()]] = true;
+	for (bool changed = true; changed; )
+	{
+		changed = false;
+		for (size_t i = 0; i < m_stream_list.size(); i++)
+			if (!final[i])
+				for (sound_stream::stream_input const &input : m_stream_list[i]->m_input)
+					if (input.m_source != nullptr && final[index[input.m_source->m_stream]])
+					{
+						final[i] = true;
+						changed = true;
+						break;
+					}
+	}
+
+	// join streams of the same device and streams connected to each other
+	std::vector<size_t> parent(m_stream_list.size());
+	std::iota(parent.begin(), parent.end(), 0);
+	auto const find = [&parent] (size_t i) { while (parent[i] != i) i = parent[i] = parent[parent[i]]; return i; };
+	std::unordered_map<device_t const *, size_t> device_stream;
+	for (size_t i = 0; i < m_stream_list.size(); i++)
+	{
+		if (final[i])
+			continue;
+		auto const found = device_stream.emplace(&m_stream_list[i]->device(), i);
+		if (!found.second)
+			parent[find(i)] = find(found.first->second);
+		for (sound_stream::stream_input const &input : m_stream_list[i]->m_input)
+			if (input.m_source != nullptr)
+				parent[find(i)] = find(index[input.m_source->m_stream]);
+	}
+
+	std::unordered_map<size_t, size_t> group_index;
+	for (size_t i = 0; i < m_stream_list.size(); i++)
+		if (!final[i])
+		{
+			auto const group = group_index.emplace(find(i), m_update_groups.size());
+			if (group.second)
+				m_update_groups.emplace_back();
+			m_update_groups[group.first->second].m_streams.push_back(m_stream_list[i].get());
+		}
+
+	// a single group gains nothing from running on another thread
+	if (m_update_groups.size() < 2)
+	{
+		m_update_groups.clear();
+		return;
+	}
+
+	if (m_update_queue == nullptr)
+		m_update_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+}
+
+
+//-------------------------------------------------
+//  update_group_callback - work queue callback
+//  that brings the streams of one group up to
+//  the current time
+//-------------------------------------------------
+
+void *sound_manager::update_group_callback(void *param, int threadid)
+{
+	update_group &group = *reinterpret_cast<update_group *>(param);
+	for (sound_stream *stream : group.m_streams)
+		stream->update();
+	return nullptr;
+}
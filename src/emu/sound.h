@@ -80,15 +80,16 @@ class sound_stream
 		stream_output *     m_source;               // pointer to the sound_output for this source
 		std::vector<stream_sample_t> m_resample;  // buffer for resampling to the stream's sample rate
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
+		const sound_resampler *m_resampler;     // filter bank for converting from the source, or nullptr for linear
 		s16               m_gain;                 // gain to apply to this input
 		s16               m_user_gain;            // user-controlled gain to apply to this input
 	};
 
 	// constants
 	static constexpr int OUTPUT_BUFFER_UPDATES  = 5;
-	static constexpr u32 FRAC_BITS              = 22;
-	static constexpr u32 FRAC_ONE               = 1 << FRAC_BITS;
-	static constexpr u32 FRAC_MASK              = FRAC_ONE - 1;
+	static constexpr u32 FRAC_BITS              = sound_resampler::FRAC_BITS;
+	static constexpr u32 FRAC_ONE               = sound_resampler::FRAC_ONE;
+	static constexpr u32 FRAC_MASK              = sound_resampler::FRAC_MASK;
 
 public:
 	// construction/destruction
@@ -114,6 +115,12 @@ public:
 	void update();
 	const stream_sample_t *output_since_last_update(int outputnum, int &numsamples);
 
+	// idle streams hold their last output without calling back until woken, typically by
+	// the update callback when nothing is playing and by register writes that start a sound
+	bool idle() const { return m_idle; }
+	void set_idle() { m_idle = true; }
+	void wake() { update(); m_idle = false; }
+
 	// timing
 	void set_sample_rate(int sample_rate);
 	void set_user_gain(int inputnum, float gain);
@@ -167,6 +174,12 @@ private:
 
 	// callback information
 	stream_update_delegate  m_callback;                   // callback function
+
+	// idle information
+	bool                m_idle;                       // output holds still, callback isn't called
+	u64                 m_idle_samples;               // samples filled while idle
+	u64                 m_active_samples;             // samples generated by the callback
+	osd_ticks_t         m_active_ticks;               // time spent in the callback
 };
 
 
@@ -201,6 +214,7 @@ public:
 
 	// stream creation
 	sound_stream *stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback = stream_update_delegate());
+	const sound_resampler *resampler(u32 source_rate, u32 dest_rate);
 
 	// global controls
 	void start_recording();
@@ -210,6 +224,8 @@ public:
 	void debugger_mute(bool turn_off = true) { mute(turn_off, MUTE_REASON_DEBUGGER); }
 	void system_mute(bool turn_off = true) { mute(turn_off, MUTE_REASON_SYSTEM); }
 	void system_enable(bool turn_on = true) { mute(!turn_on, MUTE_REASON_SYSTEM); }
+	void set_output_suppressed(bool suppressed = true) { m_output_suppressed = suppressed; }
+	void flush() { update(); }
 
 	// user gain controls
 	bool indexed_mixer_input(int index, mixer_input &info) const;
@@ -222,8 +238,11 @@ private:
 	void resume();
 	void config_load(config_type cfg_type, util::xml::data_node const *parentnode);
 	void config_save(config_type cfg_type, util::xml::data_node *parentnode);
+	void log_idle_stats();
 
 	void update(void *ptr = nullptr, s32 param = 0);
+	void rebuild_update_groups();
+	static void *update_group_callback(void *param, int threadid);
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
@@ -237,13 +256,26 @@ private:
 	u8                  m_muted;
 	int                 m_attenuation;
 	int                 m_nosound_mode;
+	bool                m_output_suppressed;    // mix as usual but discard the result (run-ahead)
 
 	wav_file *          m_wavfile;
 
 	// streams data
 	std::vector<std::unique_ptr<sound_stream>> m_stream_list;    // list of streams
+	std::map<std::pair<u32, u32>, std::unique_ptr<sound_resampler>> m_resamplers; // filter banks, by source and destination rate
+	bool                m_sinc_resampling;      // convert rates through windowed-sinc filter banks
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
 	attotime            m_last_update;          // last update time
+
+	// parts of the stream graph that don't feed each other, updated concurrently ahead of the final mix
+	struct update_group
+	{
+		std::vector<sound_stream *> m_streams;  // streams of every device in the group
+	};
+	std::vector<update_group> m_update_groups;  // groups updated concurrently (empty if serial)
+	osd_work_queue *    m_update_queue;         // work queue for updating groups
+	bool                m_update_groups_dirty;  // true if streams were added or rewired
+	bool                m_parallel_active;      // true while groups are updating
 };
 
 
@@ -11,6 +11,14 @@
 #include "emu.h"
 #include "screen.h"
 
+// the scanline rasterizers have SSE2 paths under the same conditions as rgbutil.h
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define TILEMAP_USE_SSE2    1
+#else
+#define TILEMAP_USE_SSE2    0
+#endif
+
 
 //**************************************************************************
 //  INLINE FUNCTIONS
@@ -96,6 +104,143 @@ inline bool tilemap_t::gfx_elements_changed()
 }
 
 
+//**************************************************************************
+//  SIMD HELPERS
+//**************************************************************************
+
+// each helper handles as many whole vectors as fit in count and returns the
+// number of pixels done; the caller finishes the remainder with scalar code
+namespace {
+
+#if TILEMAP_USE_SSE2
+
+//-------------------------------------------------
+//  simd_priority - update priority for 16 pixels
+//  at a time
+//-------------------------------------------------
+
+inline int simd_priority(int count, u8 *pri, u32 pcode)
+{
+	const __m128i andmask = _mm_set1_epi8(s8(pcode >> 8));
+	const __m128i ormask = _mm_set1_epi8(s8(pcode));
+	int i = 0;
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pri[i]));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&pri[i]), _mm_or_si128(_mm_and_si128(p, andmask), ormask));
+	}
+	return i;
+}
+
+
+//-------------------------------------------------
+//  simd_masked_priority - update priority for 16
+//  pixels at a time where the mask matches
+//-------------------------------------------------
+
+inline int simd_masked_priority(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode)
+{
+	const __m128i maskvec = _mm_set1_epi8(s8(mask));
+	const __m128i valuevec = _mm_set1_epi8(s8(value));
+	const __m128i andmask = _mm_set1_epi8(s8(pcode >> 8));
+	const __m128i ormask = _mm_set1_epi8(s8(pcode));
+	int i = 0;
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i sel = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&maskptr[i])), maskvec), valuevec);
+		if (_mm_movemask_epi8(sel) == 0)
+			continue;
+		__m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pri[i]));
+		__m128i updated = _mm_or_si128(_mm_and_si128(p, andmask), ormask);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&pri[i]), _mm_or_si128(_mm_and_si128(sel, updated), _mm_andnot_si128(sel, p)));
+	}
+	return i;
+}
+
+
+//-------------------------------------------------
+//  simd_copy_ind16 - copy 8 pixels at a time,
+//  adding a palette offset
+//-------------------------------------------------
+
+inline int simd_copy_ind16(u16 *dest, const u16 *source, int count, int pal)
+{
+	const __m128i palvec = _mm_set1_epi16(s16(pal));
+	int i = 0;
+	for ( ; i + 8 <= count; i += 8)
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i]), _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[i])), palvec));
+	return i;
+}
+
+
+//-------------------------------------------------
+//  simd_masked_ind16 - copy 16 pixels at a time
+//  where the mask matches, adding a palette
+//  offset and optionally updating priority
+//-------------------------------------------------
+
+inline int simd_masked_ind16(u16 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode, bool setpri)
+{
+	const __m128i maskvec = _mm_set1_epi8(s8(mask));
+	const __m128i valuevec = _mm_set1_epi8(s8(value));
+	const __m128i andmask = _mm_set1_epi8(s8(pcode >> 8));
+	const __m128i ormask = _mm_set1_epi8(s8(pcode));
+	const __m128i palvec = _mm_set1_epi16(s16(pcode >> 16));
+	int i = 0;
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i sel = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&maskptr[i])), maskvec), valuevec);
+		int const bits = _mm_movemask_epi8(sel);
+		if (bits == 0)
+			continue;
+
+		// widen the byte selection to cover each half of the 16-bit pixels
+		__m128i sel0 = _mm_unpacklo_epi8(sel, sel);
+		__m128i sel1 = _mm_unpackhi_epi8(sel, sel);
+		__m128i src0 = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[i])), palvec);
+		__m128i src1 = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[i + 8])), palvec);
+		if (bits != 0xffff)
+		{
+			src0 = _mm_or_si128(_mm_and_si128(sel0, src0), _mm_andnot_si128(sel0, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&dest[i]))));
+			src1 = _mm_or_si128(_mm_and_si128(sel1, src1), _mm_andnot_si128(sel1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&dest[i + 8]))));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i]), src0);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i + 8]), src1);
+
+		if (setpri)
+		{
+			__m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pri[i]));
+			__m128i updated = _mm_or_si128(_mm_and_si128(p, andmask), ormask);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&pri[i]), _mm_or_si128(_mm_and_si128(sel, updated), _mm_andnot_si128(sel, p)));
+		}
+	}
+	return i;
+}
+
+
+//-------------------------------------------------
+//  simd_mask_bits - return a bit per pixel for
+//  the next 16 pixels that match the mask
+//-------------------------------------------------
+
+inline int simd_mask_bits(const u8 *maskptr, int mask, int value)
+{
+	__m128i m = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(maskptr)), _mm_set1_epi8(s8(mask)));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(m, _mm_set1_epi8(s8(value))));
+}
+
+#else
+
+inline int simd_priority(int count, u8 *pri, u32 pcode) { return 0; }
+inline int simd_masked_priority(const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode) { return 0; }
+inline int simd_copy_ind16(u16 *dest, const u16 *source, int count, int pal) { return 0; }
+inline int simd_masked_ind16(u16 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, u8 *pri, u32 pcode, bool setpri) { return 0; }
+
+#endif
+
+} // anonymous namespace
+
+
 //**************************************************************************
 //  SCANLINE RASTERIZERS
 //**************************************************************************
@@ -112,7 +257,7 @@ inline void tilemap_t::scanline_draw_opaque_null(int count, u8 *pri, u32 pcode)
 		return;
 
 	// update priority across the scanline
-	for (int i = 0; i < count; i++)
+	for (int i = simd_priority(count, pri, pcode); i < count; i++)
 		pri[i] = (pri[i] & (pcode >> 8)) | pcode;
 }
 
@@ -129,7 +274,7 @@ inline void tilemap_t::scanline_draw_masked_null(const u8 *maskptr, int mask, in
 		return;
 
 	// update priority across the scanline, checking the mask
-	for (int i = 0; i < count; i++)
+	for (int i = simd_masked_priority(maskptr, mask, value, count, pri, pcode); i < count; i++)
 		if ((maskptr[i] & mask) == value)
 			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
 }
@@ -155,24 +300,23 @@ inline void tilemap_t::scanline_draw_opaque_ind16(u16 *dest, const u16 *source,
 			return;
 
 		// update priority across the scanline
-		for (int i = 0; i < count; i++)
+		for (int i = simd_priority(count, pri, pcode); i < count; i++)
 			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
 	}
 
 	// priority case
 	else if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
-		{
+		for (int i = simd_copy_ind16(dest, source, count, pal); i < count; i++)
 			dest[i] = source[i] + pal;
+		for (int i = simd_priority(count, pri, pcode); i < count; i++)
 			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
 	}
 
 	// no priority case
 	else
 	{
-		for (int i = 0; i < count; i++)
+		for (int i = simd_copy_ind16(dest, source, count, pal); i < count; i++)
 			dest[i] = source[i] + pal;
 	}
 }
@@ -190,7 +334,7 @@ inline void tilemap_t::scanline_draw_masked_ind16(u16 *dest, const u16 *source,
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
+		for (int i = simd_masked_ind16(dest, source, maskptr, mask, value, count, pri, pcode, true); i < count; i++)
 			if ((maskptr[i] & mask) == value)
 			{
 				dest[i] = source[i] + pal;
@@ -201,7 +345,7 @@ inline void tilemap_t::scanline_draw_masked_ind16(u16 *dest, const u16 *source,
 	// no priority case
 	else
 	{
-		for (int i = 0; i < count; i++)
+		for (int i = simd_masked_ind16(dest, source, maskptr, mask, value, count, pri, pcode, false); i < count; i++)
 			if ((maskptr[i] & mask) == value)
 				dest[i] = source[i] + pal;
 	}
@@ -218,21 +362,15 @@ inline void tilemap_t::scanline_draw_opaque_rgb32(u32 *dest, const u16 *source,
 {
 	const rgb_t *clut = &pens[pcode >> 16];
 
+	// the palette lookup can't be vectorised, but the priority update can
+	for (int i = 0; i < count; i++)
+		dest[i] = clut[source[i]];
+
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = clut[source[i]];
+		for (int i = simd_priority(count, pri, pcode); i < count; i++)
 			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = clut[source[i]];
 	}
 }
 
@@ -245,11 +383,33 @@ inline void tilemap_t::scanline_draw_opaque_rgb32(u32 *dest, const u16 *source,
 inline void tilemap_t::scanline_draw_masked_rgb32(u32 *dest, const u16 *source, const u8 *maskptr, int mask, int value, int count, const rgb_t *pens, u8 *pri, u32 pcode)
 {
 	const rgb_t *clut = &pens[pcode >> 16];
+	int i = 0;
+
+#if TILEMAP_USE_SSE2
+	// test the mask 16 pixels at a time, skipping fully transparent groups
+	for ( ; i + 16 <= count; i += 16)
+	{
+		int const bits = simd_mask_bits(&maskptr[i], mask, value);
+		if (bits == 0xffff)
+		{
+			for (int j = i; j < i + 16; j++)
+				dest[j] = clut[source[j]];
+		}
+		else if (bits != 0)
+		{
+			for (int j = 0; j < 16; j++)
+				if (BIT(bits, j))
+					dest[i + j] = clut[source[i + j]];
+		}
+	}
+	if ((pcode & 0xffff) != 0xff00)
+		simd_masked_priority(maskptr, mask, value, i, pri, pcode);
+#endif
 
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 			{
 				dest[i] = clut[source[i]];
@@ -260,7 +420,7 @@ inline void tilemap_t::scanline_draw_masked_rgb32(u32 *dest, const u16 *source,
 	// no priority case
 	else
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 				dest[i] = clut[source[i]];
 	}
@@ -276,21 +436,14 @@ inline void tilemap_t::scanline_draw_opaque_rgb32_alpha(u32 *dest, const u16 *so
 {
 	const rgb_t *clut = &pens[pcode >> 16];
 
+	for (int i = 0; i < count; i++)
+		dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+		for (int i = simd_priority(count, pri, pcode); i < count; i++)
 			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
 	}
 }
 
@@ -305,23 +458,16 @@ inline void tilemap_t::scanline_draw_masked_rgb32_alpha(u32 *dest, const u16 *so
 {
 	const rgb_t *clut = &pens[pcode >> 16];
 
+	for (int i = 0; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
+		for (int i = simd_masked_priority(maskptr, mask, value, count, pri, pcode); i < count; i++)
 			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
 				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
 	}
 }
 
@@ -408,6 +554,11 @@ tilemap_t &tilemap_t::init(tilemap_manager &manager, device_gfx_interface &decod
 	for (int group = 0; group < TILEMAP_NUM_GROUPS; group++)
 		map_pens_to_layer(group, 0, 0, TILEMAP_PIXEL_LAYER0);
 
+	// reset statistics
+	m_tiles_updated = 0;
+	m_tiles_updated_last = 0;
+	m_stats_frame = 0;
+
 	// save relevant state
 	int instance = manager.alloc_instance();
 	machine().save().save_item(m_device, "tilemap", nullptr, instance, NAME(m_enable));
@@ -437,6 +588,54 @@ tilemap_t::~tilemap_t()
 }
 
 
+//-------------------------------------------------
+//  track_share - dirty tiles automatically when
+//  the given share is written through an address
+//  space
+//-------------------------------------------------
+
+void tilemap_t::track_share(const char *tag, u32 bytes_per_entry, offs_t byteoffset)
+{
+	assert(bytes_per_entry != 0);
+
+	// pages no bigger than an entry, so a write dirties only the tiles it touches
+	u8 page_bits = 0;
+	while ((u32(2) << page_bits) <= bytes_per_entry)
+		page_bits++;
+
+	memory_dirty_map *map = machine().memory().track_share(tag, page_bits);
+	if (map == nullptr)
+		throw emu_fatalerror("Tilemap can't track writes to non-existent share '%s'!", tag);
+	m_tracked.push_back(tracked_share{ map, byteoffset, bytes_per_entry, map->checkpoint() });
+}
+
+
+//-------------------------------------------------
+//  apply_tracked_writes - dirty the tiles for
+//  every entry written in a tracked share since
+//  we last looked
+//-------------------------------------------------
+
+void tilemap_t::apply_tracked_writes()
+{
+	for (tracked_share &tracked : m_tracked)
+	{
+		tracked.map->for_each_dirty(tracked.since, [this, &tracked] (size_t start, size_t length)
+		{
+			// clip the run to the part of the share we map
+			size_t const end = start + length;
+			if (end <= tracked.byteoffset)
+				return;
+			start = std::max<size_t>(start, tracked.byteoffset) - tracked.byteoffset;
+			size_t const last = (end - 1 - tracked.byteoffset) / tracked.bytes_per_entry;
+			for (size_t memindex = start / tracked.bytes_per_entry; (memindex <= last) && (memindex < m_memory_to_logical.size()); memindex++)
+				mark_tile_dirty(memindex);
+		});
+		tracked.since = tracked.map->checkpoint();
+	}
+}
+
+
 //-------------------------------------------------
 //  mark_tile_dirty - mark a single tile dirty
 //  based on its memory index
@@ -704,12 +903,35 @@ inline void tilemap_t::realize_all_dirty_tiles()
 	}
 }
 
+//-------------------------------------------------
+//  count_frame - start a new count of updated
+//  tiles on the first draw of each frame
+//-------------------------------------------------
+
+void tilemap_t::count_frame(screen_device &screen)
+{
+	// parallel bands of one update all belong to the frame already being counted
+	if (screen.in_band_update() || (screen.frame_number() == m_stats_frame))
+		return;
+
+	m_tiles_updated_last = m_tiles_updated;
+	m_tiles_updated = 0;
+	m_stats_frame = screen.frame_number();
+}
+
+
 //-------------------------------------------------
 //  pixmap_update - update the entire pixmap
 //-------------------------------------------------
 
 void tilemap_t::pixmap_update()
 {
+	// band-parallel draws may get here from several threads at once
+	std::lock_guard<std::mutex> lock(m_update_lock);
+
+	// pick up writes to tracked shares
+	apply_tracked_writes();
+
 	// if the graphics changed, we need to mark everything dirty
 	if (gfx_elements_changed())
 		mark_all_dirty();
@@ -744,6 +966,7 @@ g_profiler.stop();
 void tilemap_t::tile_update(logical_index logindex, u32 col, u32 row)
 {
 g_profiler.start(PROFILER_TILEMAP_UPDATE);
+	m_tiles_updated++;
 
 	// call the get info callback for the associated memory index
 	tilemap_memory_index memindex = m_logical_to_memory[logindex];
@@ -944,13 +1167,49 @@ void tilemap_t::draw_common(screen_device &screen, _BitmapClass &dest, const rec
 		return;
 
 g_profiler.start(PROFILER_TILEMAP_DRAW);
+	count_frame(screen);
+
 	// configure the blit parameters based on the input parameters
 	blit_parameters blit;
 	configure_blit_parameters(blit, screen.priority(), cliprect, flags, priority, priority_mask);
 
-	// flush the dirty state to all tiles as appropriate
-	realize_all_dirty_tiles();
+	// full-frame draws can be split into bands once every tile is up to date,
+	// since the bands then only read the pixmap and own their rows of the
+	// destination and priority bitmaps
+	if (screen.draw_bands() > 1)
+	{
+		pixmap_update();
+		screen.draw_in_bands(blit.cliprect, [this, &screen, &dest, &blit] (const rectangle &band)
+		{
+			blit_parameters bandblit = blit;
+			bandblit.cliprect = band;
+			draw_scrolled(screen, dest, bandblit);
+		});
+	}
+	else
+	{
+		// a band of a parallel screen update mustn't update tiles as it draws
+		if (screen.in_band_update())
+			pixmap_update();
+		else
+		{
+			apply_tracked_writes();
+			realize_all_dirty_tiles();
+		}
+		draw_scrolled(screen, dest, blit);
+	}
+g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  draw_scrolled - draw every scrolled instance
+//  of the tilemap that falls in the cliprect
+//-------------------------------------------------
 
+template<class _BitmapClass>
+void tilemap_t::draw_scrolled(screen_device &screen, _BitmapClass &dest, blit_parameters blit)
+{
 	// flip the tilemap around the center of the visible area
 	rectangle visarea = screen.visible_area();
 	u32 width = visarea.left() + visarea.right() + 1;
@@ -1039,7 +1298,6 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 			}
 		}
 	}
-g_profiler.stop();
 }
 
 void tilemap_t::draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask)
@@ -1079,6 +1337,8 @@ void tilemap_t::draw_roz_common(screen_device &screen, _BitmapClass &dest, const
 	}
 
 g_profiler.start(PROFILER_TILEMAP_DRAW_ROZ);
+	count_frame(screen);
+
 	// configure the blit parameters
 	blit_parameters blit;
 	configure_blit_parameters(blit, screen.priority(), cliprect, flags, priority, priority_mask);
@@ -1086,8 +1346,20 @@ g_profiler.start(PROFILER_TILEMAP_DRAW_ROZ);
 	// get the full pixmap for the tilemap
 	pixmap();
 
-	// then do the roz copy
-	draw_roz_core(screen, dest, blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
+	// then do the roz copy, in bands if this is a full-frame draw
+	if (screen.draw_bands() > 1)
+	{
+		screen.draw_in_bands(blit.cliprect, [&] (const rectangle &band)
+		{
+			blit_parameters bandblit = blit;
+			bandblit.cliprect = band;
+			draw_roz_core(screen, dest, bandblit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
+		});
+	}
+	else
+	{
+		draw_roz_core(screen, dest, blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
+	}
 g_profiler.stop();
 }
 
@@ -1343,6 +1615,22 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 				const u8 *maskptr = &m_flagsmap.pix8(cy);
 				typename _BitmapClass::pixel_t *dest = &destbitmap.pix(sy, sx);
 
+				// without zoom this is a straight masked copy, so use the scanline rasterizers
+				if (incxx == (1 << 16))
+				{
+					const int count = std::min<int>(ex - x + 1, (widthshifted - cx + 0xffff) >> 16);
+					const rgb_t *pens = m_palette->palette()->entry_list_adjusted();
+					const u16 *source0 = &src[cx >> 16];
+					const u8 *mask0 = &maskptr[cx >> 16];
+					if (sizeof(*dest) == 2)
+						scanline_draw_masked_ind16(reinterpret_cast<u16 *>(dest), source0, mask0, mask, value, count, pri, priority);
+					else if (sizeof(*dest) == 4 && alpha >= 0xff)
+						scanline_draw_masked_rgb32(reinterpret_cast<u32 *>(dest), source0, mask0, mask, value, count, pens, pri, priority);
+					else if (sizeof(*dest) == 4)
+						scanline_draw_masked_rgb32_alpha(reinterpret_cast<u32 *>(dest), source0, mask0, mask, value, count, pens, pri, priority, alpha);
+					x = ex + 1;
+				}
+
 				// loop over columns
 				while (x <= ex && cx < widthshifted)
 				{
@@ -1618,7 +1906,8 @@ tilemap_device::tilemap_device(const machine_config &mconfig, const char *tag, d
 		m_num_columns(64),
 		m_num_rows(64),
 		m_transparent_pen_set(false),
-		m_transparent_pen(0)
+		m_transparent_pen(0),
+		m_track_writes(false)
 {
 }
 
@@ -1727,13 +2016,21 @@ void tilemap_device::device_start()
 	if (share != nullptr)
 	{
 		m_basemem.set(*share, m_bytes_per_entry);
+		if (m_track_writes)
+			track_share(tag(), m_bytes_per_entry);
 
 		// look for an extension entry
 		std::string tag_ext = std::string(tag()).append("_ext");
 		share = memshare(tag_ext.c_str());
 		if (share != nullptr)
+		{
 			m_extmem.set(*share, m_bytes_per_entry);
+			if (m_track_writes)
+				track_share(tag_ext.c_str(), m_bytes_per_entry);
+		}
 	}
+	else if (m_track_writes)
+		throw emu_fatalerror("Tilemap device '%s' tracks writes but has no share!", tag());
 
 	// configure the device and set the pen
 	if (m_transparent_pen_set)
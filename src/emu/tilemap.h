@@ -307,6 +307,8 @@
 #ifndef MAME_EMU_TILEMAP_H
 #define MAME_EMU_TILEMAP_H
 
+#include <mutex>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -387,6 +389,8 @@ enum tilemap_standard_mapper
 	downcast<tilemap_device &>(*device).set_tile_size(_width, _height);
 #define MCFG_TILEMAP_TRANSPARENT_PEN(_pen) \
 	downcast<tilemap_device &>(*device).set_configured_transparent_pen(_pen);
+#define MCFG_TILEMAP_TRACK_WRITES() \
+	downcast<tilemap_device &>(*device).set_track_writes(true);
 
 // common cases
 #define MCFG_TILEMAP_ADD_STANDARD(_tag, _gfxtag, _bytes_per_entry, _class, _method, _tilewidth, _tileheight, _mapper, _columns, _rows) \
@@ -517,6 +521,7 @@ public:
 	bitmap_ind8 &flagsmap() { pixmap_update(); return m_flagsmap; }
 	u8 *tile_flags() { pixmap_update(); return &m_tileflags[0]; }
 	tilemap_memory_index memory_index(u32 col, u32 row) { return m_mapper(col, row, m_cols, m_rows); }
+	u32 tiles_updated() const { return m_tiles_updated_last; }
 	void get_info_debug(u32 col, u32 row, u8 &gfxnum, u32 &code, u32 &color);
 
 	// setters
@@ -537,6 +542,7 @@ public:
 	// dirtying
 	void mark_tile_dirty(tilemap_memory_index memindex);
 	void mark_all_dirty() { m_all_tiles_dirty = true; m_all_tiles_clean = false; }
+	void track_share(const char *tag, u32 bytes_per_entry, offs_t byteoffset = 0);
 
 	// pen mapping
 	void map_pens_to_layer(int group, pen_t pen, pen_t mask, u8 layermask);
@@ -605,6 +611,8 @@ private:
 	void mappings_create();
 	void mappings_update();
 	void realize_all_dirty_tiles();
+	void apply_tracked_writes();
+	void count_frame(screen_device &screen);
 
 	// internal drawing
 	void pixmap_update();
@@ -613,6 +621,7 @@ private:
 	u8 tile_apply_bitmask(const u8 *maskdata, u32 x0, u32 y0, u8 category, u8 flags);
 	void configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &priority_bitmap, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask);
+	template<class _BitmapClass> void draw_scrolled(screen_device &screen, _BitmapClass &dest, blit_parameters blit);
 	template<class _BitmapClass> void draw_roz_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
 	template<class _BitmapClass> void draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
@@ -641,6 +650,16 @@ private:
 	tilemap_get_info_delegate   m_tile_get_info;        // callback to get information about a tile
 	tile_data                   m_tileinfo;             // structure to hold the data for a tile
 
+	// shares whose writes dirty tiles automatically
+	struct tracked_share
+	{
+		memory_dirty_map *      map;                    // the share's dirty map
+		offs_t                  byteoffset;             // byte offset of memory index 0 within the share
+		u32                     bytes_per_entry;        // bytes per memory index
+		u32                     since;                  // dirty map checkpoint of our last look
+	};
+	std::vector<tracked_share>  m_tracked;              // list of tracked shares
+
 	// global tilemap states
 	bool                        m_enable;               // true if we are enabled
 	u8                          m_attributes;           // global attributes (flipx/y)
@@ -649,6 +668,7 @@ private:
 	u32                         m_palette_offset;       // palette offset
 	u32                         m_gfx_used;             // bitmask of gfx items used
 	u32                         m_gfx_dirtyseq[MAX_GFX_ELEMENTS]; // dirtyseq values from last check
+	std::mutex                  m_update_lock;          // serialises pixmap updates from band-parallel draws
 
 	// scroll information
 	u32                         m_scrollrows;           // number of independently scrolled rows
@@ -667,6 +687,11 @@ private:
 	bitmap_ind8                 m_flagsmap;             // per-pixel flags
 	std::vector<u8>             m_tileflags;            // per-tile flags
 	u8                          m_pen_to_flags[MAX_PEN_TO_FLAGS * TILEMAP_NUM_GROUPS]; // mapping of pens to flags
+
+	// statistics
+	u32                         m_tiles_updated;        // tiles rendered so far this frame
+	u32                         m_tiles_updated_last;   // tiles rendered during the last frame
+	u64                         m_stats_frame;          // screen frame the running count belongs to
 };
 
 
@@ -768,6 +793,7 @@ public:
 	}
 	void set_tile_size(u16 width, u16 height) { m_tile_width = width; m_tile_height = height; }
 	void set_configured_transparent_pen(pen_t pen) { m_transparent_pen_set = true; m_transparent_pen = pen; }
+	void set_track_writes(bool track) { m_track_writes = track; }
 
 	// getters
 	memory_array &basemem() { return m_basemem; }
@@ -809,6 +835,7 @@ private:
 	u32                         m_num_rows;
 	bool                        m_transparent_pen_set;
 	pen_t                       m_transparent_pen;
+	bool                        m_track_writes;
 
 	// optional memory info
 	memory_array                m_basemem;              // info about base memory
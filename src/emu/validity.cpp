@@ -16,6 +16,7 @@
 #include "video/rgbutil.h"
 
 #include <ctype.h>
+#include <mutex>
 #include <type_traits>
 #include <typeinfo>
 
@@ -24,6 +25,33 @@
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+// everything shared by the workers of a parallel check
+struct validity_checker::parallel_work
+{
+	std::vector<const game_driver *>                  m_drivers;      // drivers to check, in output order
+	std::vector<std::vector<std::string>>             m_duplicates;   // per-driver duplicate name/description errors
+	std::vector<driver_result>                        m_results;      // per-driver results
+	std::mutex                                        m_lock;         // protects the checker pools
+	std::vector<std::unique_ptr<validity_checker>>    m_checkers;     // every worker checker
+	std::vector<validity_checker *>                   m_idle;         // worker checkers not in use
+	validity_checker *                                m_owner;        // checker that started the work
+};
+
+// a single work item
+struct validity_checker::parallel_item
+{
+	parallel_work *     m_work;
+	size_t              m_index;
+};
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// worker checker running on this thread; output raised here is routed to it
+static thread_local validity_checker *s_worker_checker = nullptr;
+
 //**************************************************************************
 //  INLINE FUNCTIONS
 //**************************************************************************
@@ -69,6 +97,24 @@ inline u64 validity_checker::random_u64() { return u64(random_u32()) ^ (u64(rand
 
 
 
+//-------------------------------------------------
+//  already_checked - return true if the string
+//  was already registered this pass, registering
+//  it otherwise
+//-------------------------------------------------
+
+bool validity_checker::already_checked(const char *string)
+{
+	// workers register with the checker that started the pass, so each item is still checked once
+	if (m_pass_owner != nullptr)
+	{
+		std::lock_guard<std::mutex> guard(m_pass_owner->m_checked_lock);
+		return !m_pass_owner->m_already_checked.insert(string).second;
+	}
+	return !m_already_checked.insert(string).second;
+}
+
+
 //-------------------------------------------------
 //  validate_tag - ensure that the given tag
 //  meets the general requirements
@@ -130,6 +176,7 @@ void validity_checker::validate_tag(const char *tag)
 
 validity_checker::validity_checker(emu_options &options)
 	: m_drivlist(options)
+	, m_options(options)
 	, m_errors(0)
 	, m_warnings(0)
 	, m_print_verbose(options.verbose())
@@ -138,6 +185,10 @@ validity_checker::validity_checker(emu_options &options)
 	, m_current_device(nullptr)
 	, m_current_ioport(nullptr)
 	, m_validate_all(false)
+	, m_parallel(false)
+	, m_buffer_output(false)
+	, m_duplicate_errors(nullptr)
+	, m_pass_owner(nullptr)
 {
 	// pre-populate the defstr map with all the default strings
 	for (int strnum = 1; strnum < INPUT_STRING_COUNT; strnum++)
@@ -219,15 +270,16 @@ bool validity_checker::check_all_matching(const char *string)
 
 	// then iterate over all drivers and check them
 	m_drivlist.reset();
-	bool validated_any = false;
+	std::vector<const game_driver *> drivers;
 	while (m_drivlist.next())
-	{
 		if (m_drivlist.matches(string, m_drivlist.driver().name))
-		{
-			validate_one(m_drivlist.driver());
-			validated_any = true;
-		}
-	}
+			drivers.push_back(&m_drivlist.driver());
+	bool const validated_any = !drivers.empty();
+	if (m_parallel && drivers.size() > 1)
+		validate_parallel(drivers);
+	else
+		for (const game_driver *driver : drivers)
+			validate_one(*driver);
 
 	// validate devices
 	if (!string)
@@ -254,7 +306,17 @@ void validity_checker::validate_begin()
 {
 	// take over error and warning outputs
 	osd_output::push(this);
+	validate_reset();
+}
+
+
+//-------------------------------------------------
+//  validate_reset - reset our internal state for
+//  a new pass
+//-------------------------------------------------
 
+void validity_checker::validate_reset()
+{
 	// reset all our maps
 	m_names_map.clear();
 	m_descriptions_map.clear();
@@ -344,6 +406,129 @@ void validity_checker::validate_one(const game_driver &driver)
 }
 
 
+//-------------------------------------------------
+//  validate_parallel - check drivers on worker
+//  threads and report them in the given order
+//-------------------------------------------------
+
+void validity_checker::validate_parallel(const std::vector<const game_driver *> &drivers)
+{
+	parallel_work work;
+	work.m_drivers = drivers;
+	work.m_duplicates.resize(drivers.size());
+	work.m_results.resize(drivers.size());
+	work.m_owner = this;
+
+	// duplicate names and descriptions depend on driver order, so find them up front
+	for (size_t index = 0; index < drivers.size(); index++)
+		check_duplicate_names(*drivers[index], work.m_duplicates[index]);
+
+	osd_work_queue *const queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	std::vector<parallel_item> items(drivers.size());
+	for (size_t index = 0; index < drivers.size(); index++)
+		items[index] = parallel_item{ &work, index };
+
+	if (queue != nullptr)
+	{
+		osd_work_item_queue_multiple(queue, parallel_callback, items.size(), &items[0], sizeof(items[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10)) { }
+		osd_work_queue_free(queue);
+	}
+	else
+	{
+		for (parallel_item &item : items)
+			parallel_callback(&item, 0);
+	}
+
+	// merge the results in driver order
+	for (driver_result &result : work.m_results)
+	{
+		m_errors += result.m_errors;
+		m_warnings += result.m_warnings;
+		if (!result.m_output.empty())
+			output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "%s", result.m_output.c_str());
+	}
+}
+
+
+//-------------------------------------------------
+//  parallel_callback - check a single driver on a
+//  worker thread with a checker of its own
+//-------------------------------------------------
+
+void *validity_checker::parallel_callback(void *param, int threadid)
+{
+	parallel_item &item = *reinterpret_cast<parallel_item *>(param);
+	parallel_work &work = *item.m_work;
+
+	// borrow an idle checker, or make a new one
+	validity_checker *checker = nullptr;
+	{
+		std::lock_guard<std::mutex> guard(work.m_lock);
+		if (!work.m_idle.empty())
+		{
+			checker = work.m_idle.back();
+			work.m_idle.pop_back();
+		}
+	}
+	if (checker == nullptr)
+	{
+		auto created = std::make_unique<validity_checker>(work.m_owner->m_options);
+		created->m_print_verbose = work.m_owner->m_print_verbose;
+		created->m_validate_all = work.m_owner->m_validate_all;
+		created->m_buffer_output = true;
+		created->m_pass_owner = work.m_owner;
+		created->validate_reset();
+		checker = created.get();
+		std::lock_guard<std::mutex> guard(work.m_lock);
+		work.m_checkers.push_back(std::move(created));
+	}
+
+	// check the driver, keeping track of what this one added
+	s_worker_checker = checker;
+	checker->m_duplicate_errors = &work.m_duplicates[item.m_index];
+	int const start_errors = checker->m_errors;
+	int const start_warnings = checker->m_warnings;
+	checker->m_output_buffer.clear();
+	checker->validate_one(*work.m_drivers[item.m_index]);
+
+	driver_result &result = work.m_results[item.m_index];
+	result.m_errors = checker->m_errors - start_errors;
+	result.m_warnings = checker->m_warnings - start_warnings;
+	result.m_output = std::move(checker->m_output_buffer);
+	checker->m_duplicate_errors = nullptr;
+	s_worker_checker = nullptr;
+
+	// and give it back
+	std::lock_guard<std::mutex> guard(work.m_lock);
+	work.m_idle.push_back(checker);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  check_duplicate_names - look for drivers that
+//  reuse an earlier driver's name or description
+//-------------------------------------------------
+
+void validity_checker::check_duplicate_names(const game_driver &driver, std::vector<std::string> &errors)
+{
+	// check for duplicate names
+	if (!m_names_map.insert(std::make_pair(driver.name, &driver)).second)
+	{
+		const game_driver *match = m_names_map.find(driver.name)->second;
+		errors.push_back(string_format("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()).c_str(), match->name));
+	}
+
+	// check for duplicate descriptions
+	if (!m_descriptions_map.insert(std::make_pair(driver.type.fullname(), &driver)).second)
+	{
+		const game_driver *match = m_descriptions_map.find(driver.type.fullname())->second;
+		errors.push_back(string_format("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()).c_str(), match->name));
+	}
+}
+
+
 //-------------------------------------------------
 //  validate_core - validate core internal systems
 //-------------------------------------------------
@@ -1402,19 +1587,12 @@ void validity_checker::validate_rgb()
 
 void validity_checker::validate_driver()
 {
-	// check for duplicate names
-	if (!m_names_map.insert(std::make_pair(m_current_driver->name, m_current_driver)).second)
-	{
-		const game_driver *match = m_names_map.find(m_current_driver->name)->second;
-		osd_printf_error("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()).c_str(), match->name);
-	}
-
-	// check for duplicate descriptions
-	if (!m_descriptions_map.insert(std::make_pair(m_current_driver->type.fullname(), m_current_driver)).second)
-	{
-		const game_driver *match = m_descriptions_map.find(m_current_driver->type.fullname())->second;
-		osd_printf_error("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()).c_str(), match->name);
-	}
+	// check for duplicate names and descriptions, unless that was done up front
+	std::vector<std::string> duplicates;
+	if (m_duplicate_errors == nullptr)
+		check_duplicate_names(*m_current_driver, duplicates);
+	for (const std::string &error : m_duplicate_errors ? *m_duplicate_errors : duplicates)
+		osd_printf_error("%s", error.c_str());
 
 	// determine if we are a clone
 	bool is_clone = (strcmp(m_current_driver->parent, "0") != 0);
@@ -2172,6 +2350,13 @@ void validity_checker::build_output_prefix(std::string &str)
 
 void validity_checker::output_callback(osd_output_channel channel, const char *msg, va_list args)
 {
+	// messages raised on a parallel worker belong to the driver that worker is checking
+	if (s_worker_checker != nullptr && s_worker_checker != this)
+	{
+		s_worker_checker->output_callback(channel, msg, args);
+		return;
+	}
+
 	std::string output;
 	switch (channel)
 	{
@@ -2212,7 +2397,10 @@ void validity_checker::output_callback(osd_output_channel channel, const char *m
 		break;
 
 	default:
-		chain_output(channel, msg, args);
+		if (m_buffer_output)
+			strcatvprintf(m_output_buffer, msg, args);
+		else
+			chain_output(channel, msg, args);
 		break;
 	}
 }
@@ -2229,7 +2417,10 @@ void validity_checker::output_via_delegate(osd_output_channel channel, const cha
 
 	// call through to the delegate with the proper parameters
 	va_start(argptr, format);
-	chain_output(channel, format, argptr);
+	if (m_buffer_output)
+		strcatvprintf(m_output_buffer, format, argptr);
+	else
+		chain_output(channel, format, argptr);
 	va_end(argptr);
 }
 
@@ -36,6 +36,7 @@ public:
 	// setter
 	void set_verbose(bool verbose) { m_print_verbose = verbose; }
 	void set_validate_all(bool all) { m_validate_all = all; }
+	void set_parallel(bool parallel) { m_parallel = parallel; }
 
 	// operations
 	void check_driver(const game_driver &driver);
@@ -47,7 +48,7 @@ public:
 	int region_length(const char *tag) { auto i = m_region_map.find(tag); return i == m_region_map.end() ? 0 : i->second; }
 
 	// generic registry of already-checked stuff
-	bool already_checked(const char *string) { return !m_already_checked.insert(string).second; }
+	bool already_checked(const char *string);
 
 	// osd_output interface
 
@@ -59,14 +60,28 @@ private:
 	typedef std::unordered_map<std::string,const game_driver *> game_driver_map;
 	typedef std::unordered_map<std::string,uintptr_t> int_map;
 
+	// parallel checking state
+	struct parallel_work;
+	struct parallel_item;
+	struct driver_result
+	{
+		int                 m_errors = 0;
+		int                 m_warnings = 0;
+		std::string         m_output;
+	};
+
 	// internal helpers
 	const char *ioport_string_from_index(u32 index);
 	int get_defstr_index(const char *string, bool suppress_error = false);
 
 	// core helpers
 	void validate_begin();
+	void validate_reset();
 	void validate_end();
 	void validate_one(const game_driver &driver);
+	void validate_parallel(const std::vector<const game_driver *> &drivers);
+	static void *parallel_callback(void *param, int threadid);
+	void check_duplicate_names(const game_driver &driver, std::vector<std::string> &errors);
 
 	// internal sub-checks
 	void validate_core();
@@ -95,7 +110,8 @@ private:
 	// internal driver list
 	driver_enumerator       m_drivlist;
 
-	// blank options for use during validation
+	// options we were created with, and blank options for use during validation
+	emu_options &           m_options;
 	emu_options             m_blank_options;
 
 	// error tracking
@@ -120,6 +136,14 @@ private:
 	int_map                 m_region_map;
 	std::unordered_set<std::string>   m_already_checked;
 	bool                    m_validate_all;
+
+	// parallel checking
+	bool                    m_parallel;             // check drivers on worker threads
+	bool                    m_buffer_output;        // collect output in m_output_buffer instead of passing it on
+	std::string             m_output_buffer;
+	const std::vector<std::string> *m_duplicate_errors; // name/description duplicates found up front, or nullptr
+	validity_checker *      m_pass_owner;           // checker whose pass a worker is part of, or nullptr
+	std::mutex              m_checked_lock;         // guards m_already_checked while workers share it
 };
 
 #endif // MAME_EMU_VALIDITY_H
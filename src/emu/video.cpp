@@ -87,7 +87,7 @@ video_manager::video_manager(running_machine &machine)
 	, m_overall_valid_counter(0)
 	, m_throttled(machine.options().throttle())
 	, m_throttle_rate(1.0f)
-	, m_syncrefresh(machine.options().sync_refresh()) // MAMEFX
+	, m_syncrefresh(machine.options().sync_refresh() && !machine.options().vrr()) // MAMEFX
 	, m_fastforward(false)
 	, m_seconds_to_run(machine.options().seconds_to_run())
 	, m_auto_frameskip(machine.options().auto_frameskip())
@@ -97,11 +97,23 @@ video_manager::video_manager(running_machine &machine)
 	, m_frameskip_counter(0)
 	, m_frameskip_adjust(0)
 	, m_skipping_this_frame(false)
+	, m_output_suppressed(false)
+	, m_frame_update_count(0)
 	, m_average_oversleep(0)
+	, m_frame_pacing(machine.options().frame_pacing())
+	, m_pacing_valid(false)
+	, m_pacing_frame_start(0)
+	, m_pacing_last_present(0)
+	, m_pacing_cost(0)
+	, m_pacing_frames(0)
+	, m_pacing_missed(0)
+	, m_pacing_latency_total(0)
+	, m_pacing_latency_max(0)
 	, m_snap_target(nullptr)
 	, m_snap_native(true)
 	, m_snap_width(0)
 	, m_snap_height(0)
+	, m_snap_error(PNGERR_NONE)
 	, m_timecode_enabled(false)
 	, m_timecode_write(false)
 	, m_timecode_text("")
@@ -173,6 +185,9 @@ video_manager::video_manager(running_machine &machine)
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
 
+	// snapshots are written like movie frames, from a copy on a worker thread
+	m_snap_writer = std::make_unique<movie_writer>((std::max)(machine.options().movie_queue(), 0));
+
 	// start recording movie if specified
 	const char *filename = machine.options().mng_write();
 	if (filename[0] != 0)
@@ -223,6 +238,11 @@ void video_manager::set_frameskip(int frameskip)
 
 void video_manager::frame_update(bool from_debugger)
 {
+	// speculative run-ahead frames are only counted: nothing is drawn, throttled or polled
+	m_frame_update_count++;
+	if (m_output_suppressed && !from_debugger)
+		return;
+
 	// only render sound and video if we're in the running phase
 	machine_phase const phase = machine().phase();
 	bool skipped_it = m_skipping_this_frame;
@@ -244,8 +264,11 @@ void video_manager::frame_update(bool from_debugger)
 
 	// if we're throttling, synchronize before rendering
 	attotime current_time = machine().time();
+	bool const paced = !from_debugger && !skipped_it && pacing_active();
+	osd_ticks_t const work_end = paced ? osd_ticks() : 0;
 	if (!from_debugger && !skipped_it && effective_throttle())
 		update_throttle(current_time);
+	osd_ticks_t const present_start = paced ? osd_ticks() : 0;
 
 	// ask the OSD to update
 	g_profiler.start(PROFILER_BLIT);
@@ -254,6 +277,16 @@ void video_manager::frame_update(bool from_debugger)
 
 	emulator_info::periodic_check();
 
+	// hold off starting the next frame, and reading its inputs, until the last moment
+	if (paced)
+		pace_frame(work_end, present_start);
+	else
+		m_pacing_valid = false;
+
+	// gather input events now, so anything that arrived while we were waiting
+	// is seen by the frame that's about to start
+	machine().osd().input_update();
+
 	// perform tasks for this frame
 	if (!from_debugger)
 		machine().call_notifiers(MACHINE_NOTIFY_FRAME);
@@ -316,6 +349,17 @@ std::string video_manager::speed_text()
 	if (partials > 1)
 		util::stream_format(str, "\n%d partial updates", partials);
 
+	// and what run-ahead costs
+	if (machine().runahead_frames() > 0)
+		util::stream_format(str, "\nrun-ahead %d: %.2f ms", machine().runahead_frames(), machine().runahead_cost() * 1000.0);
+
+	// and how well frames are being paced
+	if (m_frame_pacing && m_pacing_frames > 0)
+	{
+		double const ms_per_tick = 1000.0 / double(osd_ticks_per_second());
+		util::stream_format(str, "\npacing: %u late, latency %.2f ms", m_pacing_missed, double(m_pacing_latency_total) * ms_per_tick / double(m_pacing_frames));
+	}
+
 	return str.str();
 }
 
@@ -349,6 +393,60 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  save_snapshot - save a snapshot to the given
+//  file, which is written and closed on the
+//  snapshot writer thread
+//-------------------------------------------------
+
+void video_manager::save_snapshot(screen_device *screen, std::unique_ptr<emu_file> &&file)
+{
+	// validate
+	assert(!m_snap_native || screen != nullptr);
+	report_snapshot_error();
+
+	// create the bitmap to pass in
+	create_snapshot_bitmap(screen);
+
+	// the text and palette have to be taken now, like the bitmap
+	std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+	std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().type.fullname());
+	std::vector<rgb_t> palette;
+	if (screen != nullptr && screen->has_palette())
+		palette.assign(screen->palette().palette()->entry_list_adjusted(), screen->palette().palette()->entry_list_adjusted() + screen->palette().entries());
+
+	// the writer copies the bitmap, and the rest happens on its thread
+	std::shared_ptr<emu_file> const target(std::move(file));
+	m_snap_writer->queue_frame(m_snap_bitmap,
+			[this, target, text1 = std::move(text1), text2 = std::move(text2), palette = std::move(palette)] (bitmap_rgb32 &snapshot)
+			{
+				png_info pnginfo;
+				pnginfo.add_text("Software", text1.c_str());
+				pnginfo.add_text("System", text2.c_str());
+				png_error const error = png_write_bitmap(*target, &pnginfo, snapshot, palette.size(), palette.empty() ? nullptr : palette.data());
+				target->close();
+				if (error != PNGERR_NONE)
+					m_snap_error = error;
+
+				// keep the writer going for the next snapshot
+				return true;
+			});
+}
+
+
+//-------------------------------------------------
+//  report_snapshot_error - log a failure from the
+//  snapshot writer thread
+//-------------------------------------------------
+
+void video_manager::report_snapshot_error()
+{
+	int const error = m_snap_error.exchange(PNGERR_NONE);
+	if (error != PNGERR_NONE)
+		osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", error);
+}
+
+
 //-------------------------------------------------
 //  save_active_screen_snapshots - save a
 //  snapshot of all active screens
@@ -363,20 +461,20 @@ void video_manager::save_active_screen_snapshots()
 		for (screen_device &screen : screen_device_iterator(machine().root_device()))
 			if (machine().render().is_live(screen))
 			{
-				emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-				osd_file::error filerr = open_next(file, "png");
+				auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+				osd_file::error filerr = open_next(*file, "png");
 				if (filerr == osd_file::error::NONE)
-					save_snapshot(&screen, file);
+					save_snapshot(&screen, std::move(file));
 			}
 	}
 
 	// otherwise, just write a single snapshot
 	else
 	{
-		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		osd_file::error filerr = open_next(file, "png");
+		auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		osd_file::error filerr = open_next(*file, "png");
 		if (filerr == osd_file::error::NONE)
-			save_snapshot(nullptr, file);
+			save_snapshot(nullptr, std::move(file));
 	}
 }
 
@@ -468,6 +566,7 @@ void video_manager::begin_recording_mng(const char *name, uint32_t index, screen
 
 		// compute the frame time
 		info.m_mng_frame_period = attotime::from_hz(rate);
+		info.m_mng_writer = std::make_unique<movie_writer>((std::max)(machine().options().movie_queue(), 0));
 	}
 	else
 	{
@@ -549,6 +648,7 @@ void video_manager::begin_recording_avi(const char *name, uint32_t index, screen
 			osd_printf_error("Error creating AVI: %s\n", avi_file::error_string(avierr));
 			return end_recording_avi(index);
 		}
+		avi_info.m_avi_writer = std::make_unique<movie_writer>((std::max)(machine().options().movie_queue(), 0));
 	}
 }
 
@@ -617,6 +717,13 @@ void video_manager::end_recording_avi(uint32_t index)
 	avi_info_t &info = m_avis[index];
 	if (info.m_avi_file)
 	{
+		// let the writer finish before closing the file
+		if (info.m_avi_writer)
+		{
+			info.m_avi_writer->flush();
+			report_movie_writer("AVI", *info.m_avi_writer);
+			info.m_avi_writer.reset();
+		}
 		info.m_avi_file.reset();
 
 		// reset the state
@@ -633,6 +740,13 @@ void video_manager::end_recording_mng(uint32_t index)
 	mng_info_t &info = m_mngs[index];
 	if (info.m_mng_file != nullptr)
 	{
+		// let the writer finish before closing the file
+		if (info.m_mng_writer)
+		{
+			info.m_mng_writer->flush();
+			report_movie_writer("MNG", *info.m_mng_writer);
+			info.m_mng_writer.reset();
+		}
 		mng_capture_stop(*info.m_mng_file);
 		info.m_mng_file.reset();
 
@@ -669,11 +783,19 @@ void video_manager::add_sound_to_avi_recording(const s16 *sound, int numsamples,
 	{
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_file::error avierr = info.m_avi_file->append_sound_samples(0, sound + 0, numsamples, 1);
-		if (avierr == avi_file::error::NONE)
-			avierr = info.m_avi_file->append_sound_samples(1, sound + 1, numsamples, 1);
-		if (avierr != avi_file::error::NONE)
+		// write the samples; the writer may get to them later, so it gets its own copy
+		avi_file &file = *info.m_avi_file;
+		std::vector<s16> samples(sound, sound + numsamples * 2);
+		info.m_avi_writer->queue(
+				[&file, samples = std::move(samples)] ()
+				{
+					u32 const count = samples.size() / 2;
+					avi_file::error avierr = file.append_sound_samples(0, samples.data() + 0, count, 1);
+					if (avierr == avi_file::error::NONE)
+						avierr = file.append_sound_samples(1, samples.data() + 1, count, 1);
+					return avierr == avi_file::error::NONE;
+				});
+		if (info.m_avi_writer->failed())
 			end_recording_avi(index);
 
 		g_profiler.stop();
@@ -699,6 +821,10 @@ void video_manager::exit()
 			break;
 	}
 
+	// finish writing any snapshots
+	m_snap_writer->flush();
+	report_snapshot_error();
+
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
@@ -710,6 +836,13 @@ void video_manager::exit()
 		double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
 		double final_emu_time = m_overall_emutime.as_double();
 		osd_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds());
+
+		if (m_frame_pacing && m_pacing_frames > 0)
+		{
+			double const ms_per_tick = 1000.0 / double(tps);
+			osd_printf_info("Frame pacing: %u of %u frames late, input-to-present latency %.2f ms average, %.2f ms worst\n",
+					m_pacing_missed, m_pacing_frames, double(m_pacing_latency_total) * ms_per_tick / double(m_pacing_frames), double(m_pacing_latency_max) * ms_per_tick);
+		}
 	}
 }
 
@@ -1085,6 +1218,88 @@ osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 }
 
 
+//-------------------------------------------------
+//  pacing_active - return true if this frame's
+//  start should be scheduled just in time
+//-------------------------------------------------
+
+bool video_manager::pacing_active() const
+{
+	return m_frame_pacing && effective_throttle() && !machine().paused() && machine().phase() == machine_phase::RUNNING;
+}
+
+
+//-------------------------------------------------
+//  pacing_period - return the real time one
+//  frame of the first screen should take, in
+//  osd_ticks, or 0 if there's nothing to pace
+//-------------------------------------------------
+
+osd_ticks_t video_manager::pacing_period() const
+{
+	screen_device *const screen = screen_device_iterator(machine().root_device()).first();
+	if (screen == nullptr || screen->frame_period().attoseconds() == 0 || m_speed == 0)
+		return 0;
+
+	// with -syncrefresh the speed has been adjusted so this matches the host refresh
+	double const seconds = screen->frame_period().as_double() * 1000.0 / double(m_speed) / double(m_throttle_rate);
+	return osd_ticks_t(seconds * double(osd_ticks_per_second()));
+}
+
+
+//-------------------------------------------------
+//  pace_frame - measure the frame just presented
+//  and delay the start of the next one so that it
+//  is ready just before its deadline
+//-------------------------------------------------
+
+void video_manager::pace_frame(osd_ticks_t work_end, osd_ticks_t present_start)
+{
+	osd_ticks_t const period = pacing_period();
+	osd_ticks_t const present_end = osd_ticks();
+	if (period == 0)
+	{
+		m_pacing_valid = false;
+		return;
+	}
+
+	if (m_pacing_valid)
+	{
+		// the cost is emulation plus drawing; with -syncrefresh the OSD update also waits
+		// for vblank, so it can't be told apart from drawing and is left to the margin below
+		osd_ticks_t cost = work_end - m_pacing_frame_start;
+		if (!m_syncrefresh)
+			cost += present_end - present_start;
+
+		// track a decaying peak, so one slow frame backs off at once and recovery is gradual
+		if (cost > m_pacing_cost)
+			m_pacing_cost = cost;
+		else
+			m_pacing_cost -= (m_pacing_cost - cost) / 32;
+
+		// a frame presented more than an eighth of a period late missed its deadline
+		m_pacing_frames++;
+		if (present_end - m_pacing_last_present > period + period / 8)
+			m_pacing_missed++;
+
+		// inputs were read when the frame started
+		osd_ticks_t const latency = present_end - m_pacing_frame_start;
+		m_pacing_latency_total += latency;
+		m_pacing_latency_max = (std::max)(m_pacing_latency_max, latency);
+	}
+
+	// start the next frame as late as the recent cost allows, keeping some in hand
+	// (more with -syncrefresh, where drawing isn't part of the measured cost)
+	osd_ticks_t const budget = m_pacing_cost + (m_syncrefresh ? period / 4 : period / 10);
+	if (m_pacing_valid && budget < period)
+		throttle_until_ticks(present_end + period - budget);
+
+	m_pacing_last_present = present_end;
+	m_pacing_frame_start = osd_ticks();
+	m_pacing_valid = true;
+}
+
+
 //-------------------------------------------------
 //  update_frameskip - update frameskipping
 //  counters and periodically update autoframeskip
@@ -1235,11 +1450,14 @@ void video_manager::recompute_speed(const attotime &emutime)
 	// if we're past the "time-to-execute" requested, signal an exit
 	if (m_seconds_to_run > 1 && emutime.seconds() >= m_seconds_to_run) // MAMEFX
 	{
-		// create a final screenshot
-		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		osd_file::error filerr = file.open(machine().basename(), PATH_SEPARATOR "final.png");
-		if (filerr == osd_file::error::NONE)
-			save_snapshot(nullptr, file);
+		// create a final screenshot, unless we're only here for the timing
+		if (!*machine().options().bench_report())
+		{
+			auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+			osd_file::error filerr = file->open(machine().basename(), PATH_SEPARATOR "final.png");
+			if (filerr == osd_file::error::NONE)
+				save_snapshot(nullptr, std::move(file));
+		}
 
 		//printf("Scheduled exit at %f\n", emutime.as_double());
 		// schedule our demise
@@ -1283,9 +1501,9 @@ void video_manager::create_snapshot_bitmap(screen_device *screen)
 	render_primitive_list &primlist = m_snap_target->get_primitives();
 	primlist.acquire_lock();
 	if (machine().options().snap_bilinear())
-		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), machine().render().work_queue(), machine().render().work_bands());
 	else
-		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), machine().render().work_queue(), machine().render().work_bands());
 	primlist.release_lock();
 }
 
@@ -1445,19 +1663,22 @@ void video_manager::record_frame()
 		if ((index < m_avis.size()) && m_avis[index].m_avi_file)
 		{
 			avi_info_t &avi_info = m_avis[index];
+			avi_file &file = *avi_info.m_avi_file;
 
 			// loop until we hit the right time
 			while (avi_info.m_avi_next_frame_time <= curtime)
 			{
-				// write the next frame
-				avi_file::error avierr = avi_info.m_avi_file->append_video_frame(m_snap_bitmap);
-				if (avierr != avi_file::error::NONE)
+				// stop if an earlier write failed
+				if (avi_info.m_avi_writer->failed())
 				{
-					g_profiler.stop(); // FIXME: double exit if this happens?
 					end_recording_avi(index);
 					break;
 				}
 
+				// write the next frame
+				avi_info.m_avi_writer->queue_frame(m_snap_bitmap,
+						[&file] (bitmap_rgb32 &frame) { return file.append_video_frame(frame) == avi_file::error::NONE; });
+
 				// advance time
 				avi_info.m_avi_next_frame_time += avi_info.m_avi_frame_period;
 				avi_info.m_avi_frame++;
@@ -1469,30 +1690,44 @@ void video_manager::record_frame()
 		{
 			mng_info_t &mng_info = m_mngs[index];
 
+			emu_file &file = *mng_info.m_mng_file;
+
 			// loop until we hit the right time
 			while (mng_info.m_mng_next_frame_time <= curtime)
 			{
+				// stop if an earlier write failed
+				if (mng_info.m_mng_writer->failed())
+				{
+					end_recording_mng(index);
+					break;
+				}
+
 				// set up the text fields in the movie info
-				png_info pnginfo;
+				std::string text1, text2;
 				if (mng_info.m_mng_frame == 0)
 				{
-					std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
-					std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().type.fullname());
-					pnginfo.add_text("Software", text1.c_str());
-					pnginfo.add_text("System", text2.c_str());
+					text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+					text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().type.fullname());
 				}
 
-				// write the next frame
+				// the palette can change before the writer gets to the frame, so take a copy
 				screen_device *screen = iter.current();
-				const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
-				int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
-				png_error error = mng_capture_frame(*mng_info.m_mng_file, pnginfo, m_snap_bitmap, entries, palette);
-				if (error != PNGERR_NONE)
-				{
-					g_profiler.stop(); // FIXME: double exit if this happens?
-					end_recording_mng(index);
-					break;
-				}
+				std::vector<rgb_t> palette;
+				if (screen != nullptr && screen->has_palette())
+					palette.assign(screen->palette().palette()->entry_list_adjusted(), screen->palette().palette()->entry_list_adjusted() + screen->palette().entries());
+
+				// write the next frame
+				mng_info.m_mng_writer->queue_frame(m_snap_bitmap,
+						[&file, text1 = std::move(text1), text2 = std::move(text2), palette = std::move(palette)] (bitmap_rgb32 &frame)
+						{
+							png_info pnginfo;
+							if (!text1.empty())
+							{
+								pnginfo.add_text("Software", text1.c_str());
+								pnginfo.add_text("System", text2.c_str());
+							}
+							return mng_capture_frame(file, pnginfo, frame, palette.size(), palette.empty() ? nullptr : palette.data()) == PNGERR_NONE;
+						});
 
 				// advance time
 				mng_info.m_mng_next_frame_time += mng_info.m_mng_frame_period;
@@ -1509,6 +1744,186 @@ void video_manager::record_frame()
 	g_profiler.stop();
 }
 
+//-------------------------------------------------
+//  report_movie_writer - log how often a movie
+//  writer held up emulation
+//-------------------------------------------------
+
+void video_manager::report_movie_writer(const char *format, const movie_writer &writer) const
+{
+	osd_printf_verbose("%s recording: %u frames, %u waited for the writer (%.2f ms in total)\n",
+			format, writer.frames(), writer.stalls(), double(writer.stall_ticks()) * 1000.0 / double(osd_ticks_per_second()));
+}
+
+
+//-------------------------------------------------
+//  movie_writer - constructor
+//-------------------------------------------------
+
+video_manager::movie_writer::movie_writer(u32 depth)
+	: m_queue(depth ? osd_work_queue_alloc(WORK_QUEUE_FLAG_IO) : nullptr)
+	, m_depth(depth)
+	, m_frames_in_flight(0)
+	, m_failed(false)
+	, m_frames(0)
+	, m_stalls(0)
+	, m_stall_ticks(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~movie_writer - destructor
+//-------------------------------------------------
+
+video_manager::movie_writer::~movie_writer()
+{
+	flush();
+	if (m_queue)
+		osd_work_queue_free(m_queue);
+}
+
+
+//-------------------------------------------------
+//  queue_frame - copy a frame and queue its
+//  encoder, waiting for room if need be
+//-------------------------------------------------
+
+void video_manager::movie_writer::queue_frame(bitmap_rgb32 &bitmap, std::function<bool (bitmap_rgb32 &)> &&encode)
+{
+	m_frames++;
+
+	// without a queue, encode straight from the caller's bitmap
+	if (!m_queue)
+	{
+		if (!m_failed && !encode(bitmap))
+			m_failed = true;
+		return;
+	}
+
+	// drop finished jobs, then wait for the oldest until there's room
+	while (!m_jobs.empty() && retire_oldest(0)) { }
+	if (m_frames_in_flight >= m_depth)
+	{
+		osd_ticks_t const start = osd_ticks();
+		m_stalls++;
+		while (m_frames_in_flight >= m_depth && retire_oldest(osd_ticks_per_second() * 100)) { }
+		m_stall_ticks += osd_ticks() - start;
+	}
+
+	// take a spare copy, or make one
+	std::unique_ptr<bitmap_rgb32> copy;
+	{
+		std::lock_guard<std::mutex> lock(m_pool_lock);
+		if (!m_pool.empty())
+		{
+			copy = std::move(m_pool.back());
+			m_pool.pop_back();
+		}
+	}
+	if (!copy)
+		copy = std::make_unique<bitmap_rgb32>();
+	if (copy->width() != bitmap.width() || copy->height() != bitmap.height())
+		copy->allocate(bitmap.width(), bitmap.height());
+	copybitmap(*copy, bitmap, 0, 0, 0, 0, bitmap.cliprect());
+
+	// encode it on the writer thread, then hand the copy back for reuse
+	bitmap_rgb32 *const frame = copy.release();
+	add_job(
+			[this, frame, encode = std::move(encode)] ()
+			{
+				bool const result = encode(*frame);
+				std::lock_guard<std::mutex> lock(m_pool_lock);
+				m_pool.emplace_back(frame);
+				return result;
+			},
+			true);
+}
+
+
+//-------------------------------------------------
+//  queue - queue other work in order with the
+//  frames
+//-------------------------------------------------
+
+void video_manager::movie_writer::queue(std::function<bool ()> &&work)
+{
+	if (!m_queue)
+	{
+		if (!m_failed && !work())
+			m_failed = true;
+		return;
+	}
+
+	while (!m_jobs.empty() && retire_oldest(0)) { }
+	add_job(std::move(work), false);
+}
+
+
+//-------------------------------------------------
+//  flush - wait for everything queued so far
+//-------------------------------------------------
+
+void video_manager::movie_writer::flush()
+{
+	while (!m_jobs.empty() && retire_oldest(osd_ticks_per_second() * 100)) { }
+}
+
+
+//-------------------------------------------------
+//  add_job - queue a job on the I/O queue, which
+//  runs them one at a time in order
+//-------------------------------------------------
+
+void video_manager::movie_writer::add_job(std::function<bool ()> &&work, bool frame)
+{
+	m_jobs.emplace_back(std::make_unique<job>(*this, std::move(work), frame));
+	job &added = *m_jobs.back();
+	if (frame)
+		m_frames_in_flight++;
+	added.m_item = osd_work_item_queue(m_queue, work_callback, &added, 0);
+	if (!added.m_item)
+	{
+		// couldn't queue it, so do it here
+		work_callback(&added, 0);
+	}
+}
+
+
+//-------------------------------------------------
+//  retire_oldest - release the oldest job once it
+//  has finished; returns false if it hasn't
+//-------------------------------------------------
+
+bool video_manager::movie_writer::retire_oldest(osd_ticks_t timeout)
+{
+	job &oldest = *m_jobs.front();
+	if (oldest.m_item)
+	{
+		if (!osd_work_item_wait(oldest.m_item, timeout))
+			return false;
+		osd_work_item_release(oldest.m_item);
+	}
+	if (oldest.m_frame)
+		m_frames_in_flight--;
+	m_jobs.pop_front();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  work_callback - run a job on the writer thread
+//-------------------------------------------------
+
+void *video_manager::movie_writer::work_callback(void *param, int threadid)
+{
+	job &work = *reinterpret_cast<job *>(param);
+	if (!work.m_owner.m_failed && !work.m_work())
+		work.m_owner.m_failed = true;
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  toggle_throttle
 //-------------------------------------------------
@@ -19,6 +19,11 @@
 
 #include "aviio.h"
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -52,7 +57,9 @@ public:
 
 	// getters
 	running_machine &machine() const { return m_machine; }
-	bool skip_this_frame() const { return m_skipping_this_frame; }
+	bool skip_this_frame() const { return m_skipping_this_frame || m_output_suppressed; }
+	bool output_suppressed() const { return m_output_suppressed; }
+	u64 frame_update_count() const { return m_frame_update_count; }
 	int speed_factor() const { return m_speed; }
 	int frameskip() const { return m_auto_frameskip ? -1 : m_frameskip_level; }
 	bool throttled() const { return m_throttled; }
@@ -67,6 +74,7 @@ public:
 	void set_throttle_rate(float throttle_rate) { m_throttle_rate = throttle_rate; }
 	void set_fastforward(bool ffwd = true) { m_fastforward = ffwd; }
 	void set_output_changed() { m_output_changed = true; }
+	void set_output_suppressed(bool suppressed = true) { m_output_suppressed = suppressed; }
 
 	// misc
 	void toggle_throttle();
@@ -84,6 +92,7 @@ public:
 
 	// snapshots
 	void save_snapshot(screen_device *screen, emu_file &file);
+	void save_snapshot(screen_device *screen, std::unique_ptr<emu_file> &&file);
 	void save_active_screen_snapshots();
 	void save_input_timecode();
 
@@ -108,6 +117,8 @@ public:
 	std::string &timecode_total_text(std::string &str);
 
 private:
+	class movie_writer;
+
 	// internal helpers
 	void exit();
 	void screenless_update_callback(void *ptr, int param);
@@ -127,9 +138,16 @@ private:
 	void update_refresh_speed();
 	void recompute_speed(const attotime &emutime);
 
+	// frame pacing helpers
+	bool pacing_active() const;
+	osd_ticks_t pacing_period() const;
+	void pace_frame(osd_ticks_t work_end, osd_ticks_t present_start);
+
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
 	void record_frame();
+	void report_movie_writer(const char *format, const movie_writer &writer) const;
+	void report_snapshot_error();
 
 	// internal state
 	running_machine &   m_machine;                  // reference to our machine
@@ -170,8 +188,21 @@ private:
 	u8                  m_frameskip_counter;        // counter that counts through the frameskip steps
 	s8                  m_frameskip_adjust;
 	bool                m_skipping_this_frame;      // flag: true if we are skipping the current frame
+	bool                m_output_suppressed;        // flag: true if frames are neither drawn nor presented (run-ahead)
+	u64                 m_frame_update_count;       // number of frame updates so far, not saved
 	osd_ticks_t         m_average_oversleep;        // average number of ticks the OSD oversleeps
 
+	// frame pacing
+	bool                m_frame_pacing;             // flag: true if frame starts are delayed to just before they're needed
+	bool                m_pacing_valid;             // flag: true if the last frame was paced, so its times can be measured
+	osd_ticks_t         m_pacing_frame_start;       // osd_ticks when this frame's inputs were read and emulation began
+	osd_ticks_t         m_pacing_last_present;      // osd_ticks when the last frame was presented
+	osd_ticks_t         m_pacing_cost;              // recent peak ticks from frame start to ready to present
+	u32                 m_pacing_frames;            // number of paced frames measured
+	u32                 m_pacing_missed;            // number of those presented more than 1/8 frame late
+	osd_ticks_t         m_pacing_latency_total;     // summed input-to-present latency, in ticks
+	osd_ticks_t         m_pacing_latency_max;       // worst input-to-present latency, in ticks
+
 	// snapshot stuff
 	render_target *     m_snap_target;              // screen shapshot target
 	bitmap_rgb32        m_snap_bitmap;              // screen snapshot bitmap
@@ -179,6 +210,57 @@ private:
 	s32                 m_snap_width;               // width of snapshots (0 == auto)
 	s32                 m_snap_height;              // height of snapshots (0 == auto)
 
+	// movie recording - encodes and writes in order on a worker thread
+	class movie_writer
+	{
+	public:
+		movie_writer(u32 depth);
+		~movie_writer();
+
+		// getters
+		bool failed() const { return m_failed; }
+		u32 frames() const { return m_frames; }
+		u32 stalls() const { return m_stalls; }
+		osd_ticks_t stall_ticks() const { return m_stall_ticks; }
+
+		// queue a copy of a frame for its encoder, waiting if too many are already queued
+		void queue_frame(bitmap_rgb32 &bitmap, std::function<bool (bitmap_rgb32 &)> &&encode);
+
+		// queue anything else that has to be written in order with the frames
+		void queue(std::function<bool ()> &&work);
+
+		// wait for everything queued so far
+		void flush();
+
+	private:
+		struct job
+		{
+			job(movie_writer &owner, std::function<bool ()> &&work, bool frame) : m_owner(owner), m_work(std::move(work)), m_frame(frame), m_item(nullptr) { }
+
+			movie_writer &          m_owner;
+			std::function<bool ()>  m_work;
+			bool                    m_frame;
+			osd_work_item *         m_item;
+		};
+
+		static void *work_callback(void *param, int threadid);
+		void add_job(std::function<bool ()> &&work, bool frame);
+		bool retire_oldest(osd_ticks_t timeout);
+
+		osd_work_queue *                    m_queue;            // I/O queue, or nullptr to write synchronously
+		u32                                 m_depth;            // maximum frames in flight
+		std::deque<std::unique_ptr<job> >   m_jobs;             // queued jobs, oldest first
+		u32                                 m_frames_in_flight; // frames among them
+		std::mutex                          m_pool_lock;        // guards m_pool
+		std::vector<std::unique_ptr<bitmap_rgb32> > m_pool;     // frame copies free for reuse
+		std::atomic<bool>                   m_failed;           // a write has failed
+		u32                                 m_frames;           // frames queued
+		u32                                 m_stalls;           // frames that had to wait for room
+		osd_ticks_t                         m_stall_ticks;      // time spent waiting
+	};
+	std::unique_ptr<movie_writer> m_snap_writer;    // writes snapshots off the emulation thread
+	std::atomic<int>    m_snap_error;               // last error from the snapshot writer
+
 	// movie recording - MNG
 	class mng_info_t
 	{
@@ -189,6 +271,7 @@ private:
 			, m_mng_frame(0) { }
 
 		std::unique_ptr<emu_file> m_mng_file;              // handle to the open movie file
+		std::unique_ptr<movie_writer> m_mng_writer;        // writer for the movie file
 		attotime            m_mng_frame_period;         // period of a single movie frame
 		attotime            m_mng_next_frame_time;      // time of next frame
 		u32                 m_mng_frame;                // current movie frame number
@@ -206,6 +289,7 @@ private:
 			, m_avi_frame(0) { }
 
 		avi_file::ptr       m_avi_file;                 // handle to the open movie file
+		std::unique_ptr<movie_writer> m_avi_writer;     // writer for the movie file
 		attotime            m_avi_frame_period;         // period of a single movie frame
 		attotime            m_avi_next_frame_time;      // time of next frame
 		u32                 m_avi_frame;                // current movie frame number
@@ -11,7 +11,7 @@
 #include "emu.h"
 
 
-#if !(defined(__ALTIVEC__) || ((!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)))
+#if !(defined(__ALTIVEC__) || ((!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)) || ((!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__ARM_NEON) || defined(__ARM_NEON__))))
 
 #include "rgbgen.h"
 
@@ -115,4 +115,4 @@ void rgbaint_t::scale2_add_and_clamp(const rgbaint_t& scale, const rgbaint_t& ot
 	if (u32(m_b) > 255) { m_b = (m_b < 0) ? 0 : 255; }
 }
 
-#endif // !defined(__ALTIVEC__)
+#endif // !defined(__ALTIVEC__) && !defined(__ARM_NEON)
@@ -0,0 +1,32 @@
+// license:BSD-3-Clause
+// copyright-holders:Vas Crabb, Ryan Holtz
+/***************************************************************************
+
+    rgbneon.cpp
+
+    NEON optimised RGB utilities.
+
+***************************************************************************/
+
+#include "emu.h"
+
+#if !defined(__ALTIVEC__) && !((!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)) && (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+
+#include "rgbneon.h"
+
+/***************************************************************************
+    HIGHER LEVEL OPERATIONS
+***************************************************************************/
+
+void rgbaint_t::blend(const rgbaint_t& other, u8 factor)
+{
+	m_value = vshrq_n_s32(vmlaq_n_s32(vmulq_n_s32(m_value, factor), other.m_value, 256 - factor), 8);
+}
+
+void rgbaint_t::scale_and_clamp(const rgbaint_t& scale)
+{
+	m_value = vshrq_n_s32(vmulq_s32(m_value, scale.m_value), 8);
+	clamp_to_uint8();
+}
+
+#endif // defined(__ARM_NEON) || defined(__ARM_NEON__)
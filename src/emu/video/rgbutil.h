@@ -18,6 +18,8 @@
 #include "rgbsse.h"
 #elif defined(__ALTIVEC__)
 #include "rgbvmx.h"
+#elif (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include "rgbneon.h"
 #else
 #include "rgbgen.h"
 #endif
@@ -13,10 +13,13 @@
 #include "audit.h"
 #include "chd.h"
 #include "drivenum.h"
+#include "mame.h"
 #include "romload.h"
 #include "sound/samples.h"
 #include "softlist_dev.h"
 
+#include "osdcore.h"
+
 
 //**************************************************************************
 //  CORE FUNCTIONS
@@ -30,6 +33,7 @@ media_auditor::media_auditor(const driver_enumerator &enumerator)
 	: m_enumerator(enumerator)
 	, m_validation(AUDIT_VALIDATE_FULL)
 	, m_searchpath(nullptr)
+	, m_file_cache(nullptr)
 {
 }
 
@@ -472,10 +476,29 @@ media_auditor::audit_record &media_auditor::audit_one_rom(const rom_entry *rom)
 	// find the file and checksum it, getting the file length along the way
 	emu_file file(m_enumerator.options().media_path(), OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD);
 	file.set_restrict_to_mediapath(true);
+	machine_manager *const manager = mame_machine_manager::instance();
+	if (manager)
+		file.set_hash_cache(&manager->romhash_cache(m_enumerator.options()));
 	path_iterator path(m_searchpath);
 	std::string curpath;
 	while (path.next(curpath, record.name()))
 	{
+		// files outside the driver's own set belong to parents, BIOSes and devices and are worth sharing
+		bool const shared = m_file_cache && (m_enumerator.current() >= 0) && curpath.compare(0, curpath.find_first_of(*PATH_SEPARATOR), m_enumerator.driver().name);
+		if (shared)
+		{
+			bool found;
+			util::hash_collection hashes;
+			u64 length;
+			if (m_file_cache->find(curpath, has_crc, crc, m_validation, found, hashes, length))
+			{
+				if (!found)
+					continue;
+				record.set_actual(std::move(hashes), length);
+				break;
+			}
+		}
+
 		// open the file if we can
 		osd_file::error filerr;
 		if (has_crc)
@@ -487,8 +510,14 @@ media_auditor::audit_record &media_auditor::audit_one_rom(const rom_entry *rom)
 		if (filerr == osd_file::error::NONE)
 		{
 			record.set_actual(file.hashes(m_validation), file.size());
+			if (shared)
+				m_file_cache->add(curpath, has_crc, crc, m_validation, true, record.actual_hashes(), record.actual_length());
 			break;
 		}
+		else if (shared)
+		{
+			m_file_cache->add(curpath, has_crc, crc, m_validation, false, util::hash_collection(), 0);
+		}
 	}
 
 	// compute the final status
@@ -645,3 +674,146 @@ media_auditor::audit_record::audit_record(const char *name, media_type type)
 	, m_shared_device(nullptr)
 {
 }
+
+
+//-------------------------------------------------
+//  file_cache::find - look up the result of an
+//  earlier search for a file
+//-------------------------------------------------
+
+bool media_auditor::file_cache::find(const std::string &path, bool has_crc, u32 crc, const char *validation, bool &found, util::hash_collection &hashes, u64 &length)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	auto const result = m_results.find(make_key(path, has_crc, crc, validation));
+	if (result == m_results.end())
+		return false;
+
+	found = result->second.found;
+	hashes = result->second.hashes;
+	length = result->second.length;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  file_cache::add - remember the result of
+//  searching for a file
+//-------------------------------------------------
+
+void media_auditor::file_cache::add(const std::string &path, bool has_crc, u32 crc, const char *validation, bool found, const util::hash_collection &hashes, u64 length)
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_results.emplace(make_key(path, has_crc, crc, validation), result{ found, length, hashes });
+}
+
+
+//-------------------------------------------------
+//  file_cache::make_key - build the key for a
+//  file search
+//-------------------------------------------------
+
+std::string media_auditor::file_cache::make_key(const std::string &path, bool has_crc, u32 crc, const char *validation)
+{
+	return has_crc
+			? util::string_format("%s\t%08x\t%s", path, crc, validation)
+			: util::string_format("%s\t\t%s", path, validation);
+}
+
+
+//**************************************************************************
+//  PARALLEL MEDIA AUDITOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  parallel_media_auditor - constructor
+//-------------------------------------------------
+
+parallel_media_auditor::parallel_media_auditor(emu_options &options)
+	: m_options(options)
+	, m_validation(AUDIT_VALIDATE_FULL)
+{
+}
+
+
+//-------------------------------------------------
+//  ~parallel_media_auditor - destructor
+//-------------------------------------------------
+
+parallel_media_auditor::~parallel_media_auditor()
+{
+}
+
+
+//-------------------------------------------------
+//  audit_media - audit the media for each of the
+//  given drivers, one work item per driver
+//-------------------------------------------------
+
+void parallel_media_auditor::audit_media(const std::vector<std::size_t> &drivers, result_delegate &&delegate, const char *validation)
+{
+	m_delegate = std::move(delegate);
+	m_validation = validation;
+
+	std::vector<work_item> items(drivers.size());
+	for (std::size_t index = 0; index < drivers.size(); index++)
+		items[index] = work_item{ this, drivers[index] };
+
+	osd_work_queue *const queue = items.empty() ? nullptr : osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_IO);
+	if (queue != nullptr)
+	{
+		osd_work_item_queue_multiple(queue, work_callback, items.size(), &items[0], sizeof(items[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10)) { }
+		osd_work_queue_free(queue);
+	}
+	else
+	{
+		for (work_item &item : items)
+			work_callback(&item, 0);
+	}
+
+	// keep what was learned even if something goes wrong later
+	machine_manager *const manager = mame_machine_manager::instance();
+	if (manager)
+		manager->romhash_cache(m_options).save();
+
+	m_delegate = nullptr;
+}
+
+
+//-------------------------------------------------
+//  work_callback - audit a single driver on a
+//  worker thread with an enumerator of its own
+//-------------------------------------------------
+
+void *parallel_media_auditor::work_callback(void *param, int threadid)
+{
+	work_item &item = *reinterpret_cast<work_item *>(param);
+	parallel_media_auditor &owner = *item.m_owner;
+
+	// borrow an idle enumerator, or make a new one
+	driver_enumerator *enumerator = nullptr;
+	{
+		std::lock_guard<std::mutex> guard(owner.m_lock);
+		if (!owner.m_idle.empty())
+		{
+			enumerator = owner.m_idle.back();
+			owner.m_idle.pop_back();
+		}
+		else
+		{
+			owner.m_enumerators.emplace_back(std::make_unique<driver_enumerator>(owner.m_options));
+			enumerator = owner.m_enumerators.back().get();
+		}
+	}
+
+	// audit the driver and report it
+	enumerator->set_current(item.m_driver);
+	media_auditor auditor(*enumerator);
+	auditor.set_file_cache(&owner.m_file_cache);
+	media_auditor::summary const summary = auditor.audit_media(owner.m_validation);
+	owner.m_delegate(item.m_driver, auditor, summary);
+
+	std::lock_guard<std::mutex> guard(owner.m_lock);
+	owner.m_idle.push_back(enumerator);
+	return nullptr;
+}
@@ -15,9 +15,14 @@
 
 #include "hash.h"
 
+#include <functional>
 #include <iosfwd>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 
@@ -147,6 +152,28 @@ public:
 		util::hash_collection     m_hashes;               // actual hash information
 		device_t *          m_shared_device;        // device that shares the rom
 	};
+	// results of looking for files, shared between auditors
+	class file_cache
+	{
+	public:
+		// main interface
+		bool find(const std::string &path, bool has_crc, u32 crc, const char *validation, bool &found, util::hash_collection &hashes, u64 &length);
+		void add(const std::string &path, bool has_crc, u32 crc, const char *validation, bool found, const util::hash_collection &hashes, u64 length);
+
+	private:
+		struct result
+		{
+			bool                    found;
+			u64                     length;
+			util::hash_collection   hashes;
+		};
+
+		static std::string make_key(const std::string &path, bool has_crc, u32 crc, const char *validation);
+
+		std::mutex                                  m_mutex;
+		std::unordered_map<std::string, result>     m_results;
+	};
+
 	using record_list = std::list<audit_record>;
 
 	// construction/destruction
@@ -155,6 +182,9 @@ public:
 	// getters
 	const record_list &records() const { return m_record_list; }
 
+	// setters
+	void set_file_cache(file_cache *cache) { m_file_cache = cache; }
+
 	// audit operations
 	summary audit_media(const char *validation = AUDIT_VALIDATE_FULL);
 	summary audit_device(device_t &device, const char *validation = AUDIT_VALIDATE_FULL);
@@ -176,6 +206,44 @@ private:
 	const driver_enumerator &   m_enumerator;
 	const char *                m_validation;
 	const char *                m_searchpath;
+	file_cache *                m_file_cache;
+};
+
+
+// ======================> parallel_media_auditor
+
+// audits the media for many drivers at once on worker threads
+class parallel_media_auditor
+{
+public:
+	// called on a worker thread as each driver finishes
+	using result_delegate = std::function<void (std::size_t driver, media_auditor &auditor, media_auditor::summary summary)>;
+
+	// construction/destruction
+	parallel_media_auditor(emu_options &options);
+	~parallel_media_auditor();
+
+	// audit the given drivers, returning once all have been reported
+	void audit_media(const std::vector<std::size_t> &drivers, result_delegate &&delegate, const char *validation = AUDIT_VALIDATE_FULL);
+
+private:
+	// a single work item
+	struct work_item
+	{
+		parallel_media_auditor *    m_owner;
+		std::size_t                 m_driver;
+	};
+
+	static void *work_callback(void *param, int threadid);
+
+	// internal state
+	emu_options &                                       m_options;
+	media_auditor::file_cache                           m_file_cache;   // files shared between drivers
+	std::mutex                                          m_lock;         // protects the enumerator pools
+	std::vector<std::unique_ptr<driver_enumerator>>     m_enumerators;  // every worker enumerator
+	std::vector<driver_enumerator *>                    m_idle;         // worker enumerators not in use
+	result_delegate                                     m_delegate;
+	const char *                                        m_validation;
 };
 
 
@@ -1002,6 +1002,7 @@ bool cheat_entry::set_state(script_state newstate)
 		execute_off_script();
 	else if ((newstate == SCRIPT_STATE_ON) || (newstate == SCRIPT_STATE_RUN))
 		execute_on_script();
+	m_manager.cheat_state_changed();
 
 	return true;
 }
@@ -1142,6 +1143,7 @@ void cheat_manager::reload()
 		return;
 
 	// free everything
+	m_running.clear();
 	m_cheatlist.clear();
 
 	// reset state
@@ -1356,6 +1358,21 @@ uint64_t cheat_manager::execute_tobcd(symbol_table &table, int params, const uin
 }
 
 
+//-------------------------------------------------
+//  cheat_state_changed - rebuild the list of
+//  cheats to run each frame, in file order, so
+//  that idle cheats cost nothing
+//-------------------------------------------------
+
+void cheat_manager::cheat_state_changed()
+{
+	m_running.clear();
+	for (auto &cheat : m_cheatlist)
+		if ((cheat->state() == SCRIPT_STATE_RUN) && cheat->has_run_script())
+			m_running.push_back(cheat.get());
+}
+
+
 //-------------------------------------------------
 //  frame_update - per-frame callback
 //-------------------------------------------------
@@ -1370,7 +1387,7 @@ void cheat_manager::frame_update()
 		elem.clear();
 
 	// iterate over running cheats and execute them
-	for (auto &cheat : m_cheatlist)
+	for (cheat_entry *cheat : m_running)
 		cheat->frame_update();
 
 	// increment the frame counter
@@ -322,6 +322,9 @@ public:
 	bool save_all(const char *filename);
 	void render_text(mame_ui_manager &mui, render_container &container);
 
+	// notifications
+	void cheat_state_changed();
+
 	// output helpers
 	std::string &get_output_string(int row, ui::text_layout::text_justify justify);
 
@@ -338,6 +341,7 @@ private:
 	// internal state
 	running_machine &                           m_machine;      // reference to our machine
 	std::vector<std::unique_ptr<cheat_entry>>   m_cheatlist;    // cheat list
+	std::vector<cheat_entry *>                  m_running;      // cheats with a run script to execute each frame
 	uint64_t                                    m_framecount;   // frame count
 	std::vector<std::string>                    m_output;       // array of output strings
 	std::vector<ui::text_layout::text_justify>  m_justify;      // justification for each string
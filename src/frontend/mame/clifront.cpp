@@ -25,6 +25,7 @@
 #include "media_ident.h"
 
 #include "osdepend.h"
+#include "osdsync.h"
 #include "softlist_dev.h"
 
 #include "ui/moptions.h"
@@ -32,7 +33,11 @@
 #include "pluginopts.h"
 
 #include <algorithm>
+#include <mutex>
 #include <new>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
 #include <ctype.h>
 
 
@@ -51,6 +56,7 @@
 
 // frontend commands
 #define CLICOMMAND_LISTXML              "listxml"
+#define CLICOMMAND_LISTJSON             "listjson"
 #define CLICOMMAND_LISTFULL             "listfull"
 #define CLICOMMAND_LISTSOURCE           "listsource"
 #define CLICOMMAND_LISTCLONES           "listclones"
@@ -68,9 +74,11 @@
 #define CLICOMMAND_VERIFYSOFTWARE       "verifysoftware"
 #define CLICOMMAND_GETSOFTLIST          "getsoftlist"
 #define CLICOMMAND_VERIFYSOFTLIST       "verifysoftlist"
+#define CLICOMMAND_BENCHMARK            "benchmark"
 
 // command options
 #define CLIOPTION_DTD                   "dtd"
+#define CLIOPTION_BENCH_JOBS            "bench_jobs"
 
 
 namespace {
@@ -94,6 +102,7 @@ const options_entry cli_option_entries[] =
 	/* frontend commands */
 	{ nullptr,                              nullptr,   OPTION_HEADER,     "FRONTEND COMMANDS" },
 	{ CLICOMMAND_LISTXML        ";lx",      "0",       OPTION_COMMAND,    "all available info on driver in XML format" },
+	{ CLICOMMAND_LISTJSON       ";lj",      "0",       OPTION_COMMAND,    "all available info on driver in JsonML format" },
 	{ CLICOMMAND_LISTFULL       ";ll",      "0",       OPTION_COMMAND,    "short name, full name" },
 	{ CLICOMMAND_LISTSOURCE     ";ls",      "0",       OPTION_COMMAND,    "driver sourcefile" },
 	{ CLICOMMAND_LISTCLONES     ";lc",      "0",       OPTION_COMMAND,    "show clones" },
@@ -111,18 +120,19 @@ const options_entry cli_option_entries[] =
 	{ CLICOMMAND_VERIFYSOFTWARE ";vsoft",   "0",       OPTION_COMMAND,    "verify known software for the system" },
 	{ CLICOMMAND_GETSOFTLIST    ";glist",   "0",       OPTION_COMMAND,    "retrieve software list by name" },
 	{ CLICOMMAND_VERIFYSOFTLIST ";vlist",   "0",       OPTION_COMMAND,    "verify software list by name" },
+	{ CLICOMMAND_BENCHMARK,                 "0",       OPTION_COMMAND,    "run systems headless for -str seconds and report timings as JSON" },
 
 	{ nullptr,                              nullptr,   OPTION_HEADER,     "FRONTEND COMMAND OPTIONS" },
 	{ CLIOPTION_DTD,                        "1",       OPTION_BOOLEAN,    "include DTD in XML output" },
+	{ CLIOPTION_BENCH_JOBS,                 "0",       OPTION_INTEGER,    "number of -benchmark systems to run at once (0 = one per core)" },
 	{ nullptr }
 };
 
 
 void print_summary(
-		const media_auditor &auditor, media_auditor::summary summary, bool record_none_needed,
+		const char *details, media_auditor::summary summary, bool record_none_needed,
 		const char *type, const char *name, const char *parent,
-		unsigned &correct, unsigned &incorrect, unsigned &notfound,
-		util::ovectorstream &buffer)
+		unsigned &correct, unsigned &incorrect, unsigned &notfound)
 {
 	if (summary == media_auditor::NOTFOUND)
 	{
@@ -132,11 +142,7 @@ void print_summary(
 	else if (record_none_needed || (summary != media_auditor::NONE_NEEDED))
 	{
 		// output the summary of the audit
-		buffer.clear();
-		buffer.seekp(0);
-		auditor.summarize(name, &buffer);
-		buffer.put('\0');
-		osd_printf_info("%s", &buffer.vec()[0]);
+		osd_printf_info("%s", details);
 
 		// output the name of the driver and its parent
 		osd_printf_info("%sset %s ", type, name);
@@ -171,6 +177,21 @@ void print_summary(
 	}
 }
 
+
+void print_summary(
+		const media_auditor &auditor, media_auditor::summary summary, bool record_none_needed,
+		const char *type, const char *name, const char *parent,
+		unsigned &correct, unsigned &incorrect, unsigned &notfound,
+		util::ovectorstream &buffer)
+{
+	buffer.clear();
+	buffer.seekp(0);
+	if ((summary != media_auditor::NOTFOUND) && (record_none_needed || (summary != media_auditor::NONE_NEEDED)))
+		auditor.summarize(name, &buffer);
+	buffer.put('\0');
+	print_summary(&buffer.vec()[0], summary, record_none_needed, type, name, parent, correct, incorrect, notfound);
+}
+
 } // anonymous namespace
 
 
@@ -342,6 +363,18 @@ void cli_frontend::listxml(const std::vector<std::string> &args)
 }
 
 
+//-------------------------------------------------
+//  listjson - output the -listxml data for one or
+//  more games as JsonML
+//-------------------------------------------------
+
+void cli_frontend::listjson(const std::vector<std::string> &args)
+{
+	info_xml_creator creator(m_options, false, true);
+	creator.output(stdout, args);
+}
+
+
 //-------------------------------------------------
 //  listfull - output the name and description of
 //  one or more games
@@ -992,23 +1025,14 @@ void cli_frontend::verifyroms(const std::vector<std::string> &args)
 	unsigned incorrect = 0;
 	unsigned notfound = 0;
 
-	// iterate over drivers
+	// find the drivers to audit
 	driver_enumerator drivlist(m_options);
-	media_auditor auditor(drivlist);
-	util::ovectorstream summary_string;
+	std::vector<std::size_t> drivers;
 	while (drivlist.next())
 	{
 		if (included(drivlist.driver().name))
 		{
-			// audit the ROMs in this set
-			media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
-
-			auto const clone_of = drivlist.clone();
-			print_summary(
-					auditor, summary, true,
-					"rom", drivlist.driver().name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
-					correct, incorrect, notfound,
-					summary_string);
+			drivers.emplace_back(drivlist.current());
 
 			// if it wasn't a wildcard, there can only be one
 			if (!iswild)
@@ -1016,6 +1040,55 @@ void cli_frontend::verifyroms(const std::vector<std::string> &args)
 		}
 	}
 
+	// audit the ROMs in these sets on worker threads, printing results in order as they become available
+	struct driver_audit
+	{
+		bool done = false;
+		media_auditor::summary summary = media_auditor::NOTFOUND;
+		std::string details;
+	};
+	std::vector<driver_audit> results(drivers.size());
+	std::unordered_map<std::size_t, std::size_t> positions;
+	for (std::size_t position = 0; position < drivers.size(); position++)
+		positions.emplace(drivers[position], position);
+	std::mutex print_lock;
+	std::size_t printed = 0;
+	auto const print_ready = [&] ()
+	{
+		for ( ; (printed < results.size()) && results[printed].done; printed++)
+		{
+			driver_audit &result(results[printed]);
+			game_driver const &driver(driver_list::driver(drivers[printed]));
+			auto const clone_of = driver_list::clone(drivers[printed]);
+			print_summary(
+					result.details.c_str(), result.summary, true,
+					"rom", driver.name, (clone_of >= 0) ? driver_list::driver(clone_of).name : nullptr,
+					correct, incorrect, notfound);
+			result.details.clear();
+		}
+	};
+	parallel_media_auditor(m_options).audit_media(
+			drivers,
+			[&] (std::size_t driver, media_auditor &auditor, media_auditor::summary summary)
+			{
+				driver_audit &result(results[positions.at(driver)]);
+				result.summary = summary;
+				if (summary != media_auditor::NOTFOUND)
+				{
+					std::ostringstream details;
+					auditor.summarize(driver_list::driver(driver).name, &details);
+					result.details = details.str();
+				}
+
+				std::lock_guard<std::mutex> guard(print_lock);
+				result.done = true;
+				print_ready();
+			},
+			AUDIT_VALIDATE_FAST);
+
+	media_auditor auditor(drivlist);
+	util::ovectorstream summary_string;
+
 	if (iswild || !matchcount)
 	{
 		machine_config config(GAME_NAME(___empty), m_options);
@@ -1560,6 +1633,107 @@ void cli_frontend::romident(const std::vector<std::string> &args)
 }
 
 
+//-------------------------------------------------
+//  benchmark - run each system headless and
+//  unthrottled for a fixed emulated time, and
+//  print their -bench_report summaries as one
+//  JSON array
+//-------------------------------------------------
+
+void cli_frontend::benchmark(const std::vector<std::string> &args)
+{
+	// each argument is a system name, optionally with an input file to play back
+	struct bench_run
+	{
+		std::string system;
+		std::string playback;
+		std::string report;
+	};
+	std::vector<bench_run> runs;
+	for (const std::string &arg : args)
+	{
+		std::string::size_type const comma = arg.find(',');
+		bench_run run;
+		run.system = arg.substr(0, comma);
+		if (comma != std::string::npos)
+			run.playback = arg.substr(comma + 1);
+		if (driver_list::find(run.system.c_str()) < 0)
+			throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "Unknown system '%s'", run.system.c_str());
+		run.report = util::string_format("benchmark-%d-%u.json", osd_getpid(), unsigned(runs.size()));
+		runs.emplace_back(std::move(run));
+	}
+
+	// nothing drawn, heard, saved or waited for
+	m_options.set_value("video", "none", OPTION_PRIORITY_MAXIMUM);
+	m_options.set_value("sound", "none", OPTION_PRIORITY_MAXIMUM);
+	m_options.set_value(OPTION_THROTTLE, "0", OPTION_PRIORITY_MAXIMUM);
+	m_options.set_value(OPTION_NVRAM_SAVE, "0", OPTION_PRIORITY_MAXIMUM);
+	m_options.set_value(OPTION_SKIP_GAMEINFO, "1", OPTION_PRIORITY_MAXIMUM);
+	if (m_options.seconds_to_run() < 2)
+		m_options.set_value(OPTION_SECONDS_TO_RUN, 60, OPTION_PRIORITY_MAXIMUM);
+
+	mame_machine_manager *manager = mame_machine_manager::instance();
+	manager->start_luaengine();
+	auto const execute = [this, manager] (const bench_run &run)
+	{
+		m_options.set_system_name(run.system);
+		m_options.set_value(OPTION_PLAYBACK, run.playback, OPTION_PRIORITY_MAXIMUM);
+		m_options.set_value(OPTION_BENCH_REPORT, run.report, OPTION_PRIORITY_MAXIMUM);
+		try
+		{
+			return manager->execute() == EMU_ERR_NONE;
+		}
+		catch (emu_fatalerror &fatal)
+		{
+			osd_printf_error("%s: %s\n", run.system.c_str(), fatal.string());
+			return false;
+		}
+	};
+
+	// with more than one job, split into that many processes that each take every Nth system
+	int jobs = m_options.int_value(CLIOPTION_BENCH_JOBS);
+	if (jobs <= 0)
+		jobs = std::max(1U, std::thread::hardware_concurrency());
+	jobs = std::min<int>(jobs, runs.size());
+	int const instance = (jobs > 1) ? osd_fork_instances(jobs) : OSD_FORK_UNSUPPORTED;
+	if (instance >= 0)
+	{
+		// a copy only runs its share; the original collects the reports
+		for (size_t index = instance; index < runs.size(); index += jobs)
+			if (!execute(runs[index]))
+				m_result = EMU_ERR_FATALERROR;
+		return;
+	}
+	if (instance == OSD_FORK_UNSUPPORTED)
+	{
+		for (const bench_run &run : runs)
+			if (!execute(run))
+				m_result = EMU_ERR_FATALERROR;
+	}
+	else if (instance == OSD_FORK_FAILED)
+	{
+		m_result = EMU_ERR_FATALERROR;
+	}
+
+	// gather the reports in the order given; a run that failed has none
+	printf("[");
+	for (size_t index = 0; index < runs.size(); index++)
+	{
+		std::vector<u8> report;
+		if (util::core_file::load(runs[index].report, report) == osd_file::error::NONE && !report.empty())
+		{
+			printf("%s%.*s", index ? ",\n" : "\n", int(report.size()), reinterpret_cast<const char *>(&report[0]));
+			osd_file::remove(runs[index].report);
+		}
+		else
+		{
+			printf("%s{\"system\":\"%s\",\"error\":\"no report\"}", index ? ",\n" : "\n", runs[index].system.c_str());
+		}
+	}
+	printf("\n]\n");
+}
+
+
 //-------------------------------------------------
 //  find_command
 //-------------------------------------------------
@@ -1569,6 +1743,7 @@ const cli_frontend::info_command_struct *cli_frontend::find_command(const std::s
 	static const info_command_struct s_info_commands[] =
 	{
 		{ CLICOMMAND_LISTXML,           0, -1, &cli_frontend::listxml,          "[pattern] ..." },
+		{ CLICOMMAND_LISTJSON,          0, -1, &cli_frontend::listjson,         "[pattern] ..." },
 		{ CLICOMMAND_LISTFULL,          0, -1, &cli_frontend::listfull,         "[pattern] ..." },
 		{ CLICOMMAND_LISTSOURCE,        0,  1, &cli_frontend::listsource,       "[system name]" },
 		{ CLICOMMAND_LISTCLONES,        0,  1, &cli_frontend::listclones,       "[system name]" },
@@ -1585,7 +1760,8 @@ const cli_frontend::info_command_struct *cli_frontend::find_command(const std::s
 		{ CLICOMMAND_VERIFYSOFTWARE,    0,  1, &cli_frontend::verifysoftware,   "[system name|*]" },
 		{ CLICOMMAND_ROMIDENT,          1,  1, &cli_frontend::romident,         "(file or directory path)" },
 		{ CLICOMMAND_GETSOFTLIST,       0,  1, &cli_frontend::getsoftlist,      "[system name|*]" },
-		{ CLICOMMAND_VERIFYSOFTLIST,    0,  1, &cli_frontend::verifysoftlist,   "[system name|*]" }
+		{ CLICOMMAND_VERIFYSOFTLIST,    0,  1, &cli_frontend::verifysoftlist,   "[system name|*]" },
+		{ CLICOMMAND_BENCHMARK,         1, -1, &cli_frontend::benchmark,        "(system name[,input file]) ..." }
 	};
 
 	for (const auto &info_command : s_info_commands)
@@ -1624,6 +1800,7 @@ void cli_frontend::execute_commands(const char *exename)
 	{
 		validity_checker valid(m_options);
 		valid.set_validate_all(true);
+		valid.set_parallel(true);
 		const char *sysname = m_options.command_arguments().empty() ? nullptr : m_options.command_arguments()[0].c_str();
 		bool result = valid.check_all_matching(sysname);
 		if (!result)
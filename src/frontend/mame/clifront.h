@@ -48,6 +48,7 @@ private:
 
 	// commands
 	void listxml(const std::vector<std::string> &args);
+	void listjson(const std::vector<std::string> &args);
 	void listfull(const std::vector<std::string> &args);
 	void listsource(const std::vector<std::string> &args);
 	void listclones(const std::vector<std::string> &args);
@@ -65,6 +66,7 @@ private:
 	void romident(const std::vector<std::string> &args);
 	void getsoftlist(const std::vector<std::string> &args);
 	void verifysoftlist(const std::vector<std::string> &args);
+	void benchmark(const std::vector<std::string> &args);
 
 	// internal helpers
 	void execute_commands(const char *exename);
@@ -25,15 +25,44 @@
 
 #include "xmlfile.h"
 
+#include <algorithm>
+#include <cstdarg>
 #include <ctype.h>
 #include <cstring>
 #include <map>
+#include <mutex>
 
 
 #define XML_ROOT    "mame"
 #define XML_TOP     "machine"
 
 
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// everything shared by the workers describing machines and devices
+struct info_xml_creator::parallel_work
+{
+	std::mutex                                      m_lock;         // protects the creator pools
+	std::vector<std::unique_ptr<info_xml_creator>>  m_creators;     // every worker creator
+	std::vector<info_xml_creator *>                 m_idle;         // worker creators not in use
+	info_xml_creator *                              m_owner;        // creator that started the work
+};
+
+// a single machine or device to describe
+struct info_xml_creator::parallel_item
+{
+	parallel_work *                     m_work = nullptr;
+	int                                 m_driver = -1;          // driver index, or -1 for a device
+	std::add_pointer_t<device_type>     m_device = nullptr;     // device type when not a driver
+	bool                                m_collect = false;      // whether to gather the device types a driver uses
+	device_type_set                     m_devtypes;             // device types the driver uses
+	std::string                         m_output;               // finished output
+};
+
+
+
 //**************************************************************************
 //  GLOBAL VARIABLES
 //**************************************************************************
@@ -211,9 +240,18 @@ const char info_xml_creator::s_dtd_string[] =
 //  info_xml_creator - constructor
 //-------------------------------------------------
 
-info_xml_creator::info_xml_creator(emu_options const &options, bool dtd)
-	: m_output(nullptr)
-	, m_dtd(dtd)
+info_xml_creator::info_xml_creator(emu_options const &options, bool dtd, bool json)
+	: m_dtd(dtd)
+	, m_json(json)
+{
+}
+
+
+//-------------------------------------------------
+//  ~info_xml_creator - destructor
+//-------------------------------------------------
+
+info_xml_creator::~info_xml_creator()
 {
 }
 
@@ -225,8 +263,6 @@ info_xml_creator::info_xml_creator(emu_options const &options, bool dtd)
 
 void info_xml_creator::output(FILE *out, std::vector<std::string> const &patterns)
 {
-	m_output = out;
-
 	std::unique_ptr<device_type_set> devfilter(patterns.empty() ? nullptr : new device_type_set);
 
 	// track which patterns match machines
@@ -257,18 +293,14 @@ void info_xml_creator::output(FILE *out, std::vector<std::string> const &pattern
 		return result;
 	};
 
-	// iterate through the drivers, outputting one at a time
-	bool first = true;
+	// find the drivers to output
+	std::vector<parallel_item> items;
 	while (drivlist.next())
 	{
 		if (included(drivlist.driver().name))
 		{
-			if (first)
-			{
-				output_header();
-				first = false;
-			}
-			output_one(drivlist, devfilter.get());
+			items.emplace_back();
+			items.back().m_driver = drivlist.current();
 
 			// stop looking if we found everything specified
 			if (!patterns.empty() && exact_matches == patterns.size())
@@ -276,7 +308,7 @@ void info_xml_creator::output(FILE *out, std::vector<std::string> const &pattern
 		}
 	}
 
-	// iterate through the device types if not everything matches a driver
+	// look through the device types if not everything matches a driver
 	if (!patterns.empty() && exact_matches != patterns.size())
 	{
 		for (device_type type : registered_device_types)
@@ -290,19 +322,17 @@ void info_xml_creator::output(FILE *out, std::vector<std::string> const &pattern
 		}
 	}
 
-	// output devices (both devices with roms and slot devices)
-	if (!devfilter || !devfilter->empty())
+	// output the drivers, then the devices (both devices with roms and slot devices)
+	bool const any = !items.empty() || !devfilter || !devfilter->empty();
+	if (any)
 	{
-		if (first)
-		{
-			output_header();
-			first = false;
-		}
-		output_devices(devfilter.get());
-	}
-
-	if (!first)
+		output_header();
+		flush_output(out);
+		output_parallel(out, items, devfilter.get());
+		output_devices(out, devfilter.get());
 		output_footer();
+		flush_output(out);
+	}
 
 	// throw an error if there were unmatched patterns
 	auto it = matched.begin();
@@ -323,21 +353,301 @@ void info_xml_creator::output(FILE *out, std::vector<std::string> const &pattern
 
 void info_xml_creator::output(FILE *out, driver_enumerator &drivlist, bool nodevices)
 {
-	m_output = out;
-
 	device_type_set devfilter;
 
 	output_header();
+	flush_output(out);
 
-	// iterate through the drivers, outputting one at a time
+	// output the drivers
+	std::vector<parallel_item> items;
 	while (drivlist.next())
-		output_one(drivlist, &devfilter);
+	{
+		items.emplace_back();
+		items.back().m_driver = drivlist.current();
+	}
+	output_parallel(out, items, &devfilter);
 
 	// output devices (both devices with roms and slot devices)
 	if (!nodevices)
-		output_devices(&devfilter);
+		output_devices(out, &devfilter);
 
 	output_footer();
+	flush_output(out);
+}
+
+
+//-------------------------------------------------
+//  output_parallel - describe machines or devices
+//  on worker threads, writing them out in order
+//  a window at a time
+//-------------------------------------------------
+
+void info_xml_creator::output_parallel(FILE *out, std::vector<parallel_item> &items, device_type_set *devtypes)
+{
+	parallel_work work;
+	work.m_owner = this;
+	for (parallel_item &item : items)
+	{
+		item.m_work = &work;
+		item.m_collect = devtypes != nullptr;
+	}
+
+	osd_work_queue *const queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	for (std::size_t start = 0; start < items.size(); start += PARALLEL_WINDOW)
+	{
+		std::size_t const count = (std::min)(items.size() - start, PARALLEL_WINDOW);
+		if (queue != nullptr)
+		{
+			osd_work_item_queue_multiple(queue, parallel_callback, count, &items[start], sizeof(items[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10)) { }
+		}
+		else
+		{
+			for (std::size_t index = start; index < start + count; index++)
+				parallel_callback(&items[index], 0);
+		}
+
+		// write the window and drop it
+		for (std::size_t index = start; index < start + count; index++)
+		{
+			parallel_item &item = items[index];
+			fwrite(item.m_output.c_str(), 1, item.m_output.length(), out);
+			std::string().swap(item.m_output);
+			if (devtypes)
+				devtypes->insert(item.m_devtypes.begin(), item.m_devtypes.end());
+			device_type_set().swap(item.m_devtypes);
+		}
+	}
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
+}
+
+
+//-------------------------------------------------
+//  parallel_callback - describe a single machine
+//  or device with a creator of its own
+//-------------------------------------------------
+
+void *info_xml_creator::parallel_callback(void *param, int threadid)
+{
+	parallel_item &item = *reinterpret_cast<parallel_item *>(param);
+	parallel_work &work = *item.m_work;
+
+	// borrow an idle creator, or make a new one
+	info_xml_creator *creator = nullptr;
+	{
+		std::lock_guard<std::mutex> guard(work.m_lock);
+		if (!work.m_idle.empty())
+		{
+			creator = work.m_idle.back();
+			work.m_idle.pop_back();
+		}
+	}
+	if (creator == nullptr)
+	{
+		auto created = std::make_unique<info_xml_creator>(work.m_owner->m_lookup_options, work.m_owner->m_dtd, work.m_owner->m_json);
+		creator = created.get();
+		std::lock_guard<std::mutex> guard(work.m_lock);
+		work.m_creators.push_back(std::move(created));
+	}
+
+	// describe the driver or device
+	creator->m_output.clear();
+	if (item.m_driver >= 0)
+	{
+		driver_enumerator drivlist(creator->m_lookup_options);
+		drivlist.set_current(item.m_driver);
+		creator->output_one(drivlist, item.m_collect ? &item.m_devtypes : nullptr);
+	}
+	else
+	{
+		creator->output_device(*item.m_device);
+	}
+
+	// JSON is converted here too, so the writer only has to copy
+	if (creator->m_json)
+		append_jsonml(item.m_output, creator->m_output);
+	else
+		item.m_output = creator->m_output;
+
+	// and give it back
+	std::lock_guard<std::mutex> guard(work.m_lock);
+	work.m_idle.push_back(creator);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  out_format - append formatted text to the
+//  output buffer
+//-------------------------------------------------
+
+void info_xml_creator::out_format(const char *format, ...)
+{
+	va_list args, retry;
+	va_start(args, format);
+	va_copy(retry, args);
+
+	// most lines fit on the stack; the rest are formatted again at full length
+	char buffer[256];
+	int const length = vsnprintf(buffer, sizeof(buffer), format, args);
+	if (length >= int(sizeof(buffer)))
+	{
+		std::size_t const offset = m_output.length();
+		m_output.resize(offset + length + 1);
+		vsnprintf(&m_output[offset], length + 1, format, retry);
+		m_output.resize(offset + length);
+	}
+	else if (length > 0)
+	{
+		m_output.append(buffer, length);
+	}
+	va_end(retry);
+	va_end(args);
+}
+
+
+//-------------------------------------------------
+//  out_attribute - append an attribute, escaping
+//  its value
+//-------------------------------------------------
+
+void info_xml_creator::out_attribute(const char *name, const char *value)
+{
+	m_output.append(1, ' ').append(name).append("=\"");
+	for ( ; value && *value; value++)
+	{
+		switch (*value)
+		{
+			case '\"': m_output.append("&quot;"); break;
+			case '&':  m_output.append("&amp;"); break;
+			case '<':  m_output.append("&lt;"); break;
+			case '>':  m_output.append("&gt;"); break;
+			default:   m_output.append(1, *value); break;
+		}
+	}
+	m_output.append(1, '"');
+}
+
+
+//-------------------------------------------------
+//  flush_output - write out and clear the output
+//  buffer
+//-------------------------------------------------
+
+void info_xml_creator::flush_output(FILE *out)
+{
+	fwrite(m_output.c_str(), 1, m_output.length(), out);
+	m_output.clear();
+}
+
+
+//-------------------------------------------------
+//  append_jsonml - convert generated XML to
+//  JsonML, where an element is an array of its
+//  name, an object of its attributes and its
+//  children; every element and text node gets a
+//  leading comma, since one always precedes it
+//-------------------------------------------------
+
+void info_xml_creator::append_jsonml(std::string &dest, std::string const &xml)
+{
+	// append a string, decoding the entities we generate and escaping for JSON
+	auto const append_string = [&dest] (char const *start, char const *end)
+	{
+		static constexpr std::pair<char const *, char> entities[] = {
+				{ "&quot;", '"' }, { "&amp;", '&' }, { "&lt;", '<' }, { "&gt;", '>' } };
+
+		dest.append(1, '"');
+		while (start < end)
+		{
+			char ch = *start++;
+			if (ch == '&')
+			{
+				for (auto const &entity : entities)
+				{
+					std::size_t const length = strlen(entity.first);
+					if ((std::size_t(end - start) >= length - 1) && !strncmp(start - 1, entity.first, length))
+					{
+						ch = entity.second;
+						start += length - 1;
+						break;
+					}
+				}
+			}
+			if (ch == '"' || ch == '\\')
+				dest.append(1, '\\').append(1, ch);
+			else if (u8(ch) < 0x20)
+				dest.append(util::string_format("\\u%04x", u8(ch)));
+			else
+				dest.append(1, ch);
+		}
+		dest.append(1, '"');
+	};
+
+	char const *cur = xml.c_str();
+	char const *const end = cur + xml.length();
+	while (cur < end)
+	{
+		if (*cur != '<')
+		{
+			// text; whitespace between tags is dropped
+			char const *const start = cur;
+			while (cur < end && *cur != '<')
+				cur++;
+			char const *const first = std::find_if(start, cur, [] (char ch) { return !isspace(u8(ch)); });
+			if (first != cur)
+			{
+				dest.append(1, ',');
+				append_string(start, cur);
+			}
+		}
+		else if (cur[1] == '/')
+		{
+			// closing tag
+			cur = std::find(cur, end, '>') + 1;
+			dest.append(1, ']');
+		}
+		else
+		{
+			// opening tag and its attributes
+			char const *name = ++cur;
+			while (cur < end && !isspace(u8(*cur)) && *cur != '>' && *cur != '/')
+				cur++;
+			dest.append(",[");
+			append_string(name, cur);
+
+			bool first = true;
+			while (true)
+			{
+				while (cur < end && isspace(u8(*cur)))
+					cur++;
+				if (cur >= end || *cur == '>' || *cur == '/')
+					break;
+				name = cur;
+				cur = std::find(cur, end, '=');
+				dest.append(first ? ",{" : ",");
+				first = false;
+				append_string(name, cur);
+				dest.append(1, ':');
+				char const *const value = cur + 2;
+				cur = std::find(value, end, '"');
+				append_string(value, cur);
+				cur++;
+			}
+			if (!first)
+				dest.append(1, '}');
+
+			// self-closing tags have no children
+			if (cur < end && *cur == '/')
+			{
+				dest.append(1, ']');
+				cur++;
+			}
+			cur++;
+		}
+	}
+	dest.append(1, '\n');
 }
 
 
@@ -348,19 +658,19 @@ void info_xml_creator::output(FILE *out, driver_enumerator &drivlist, bool nodev
 
 void info_xml_creator::output_header()
 {
-	if (m_dtd)
+	if (m_dtd && !m_json)
 	{
 		// output the DTD
-		fprintf(m_output, "<?xml version=\"1.0\"?>\n");
+		out("<?xml version=\"1.0\"?>\n");
 		std::string dtd(s_dtd_string);
 		strreplace(dtd, "__XML_ROOT__", XML_ROOT);
 		strreplace(dtd, "__XML_TOP__", XML_TOP);
 
-		fprintf(m_output, "%s\n\n", dtd.c_str());
+		out_format("%s\n\n", dtd.c_str());
 	}
 
 	// top-level tag
-	fprintf(m_output, "<%s build=\"%s\" debug=\""
+	out_format("<%s build=\"%s\" debug=\""
 #ifdef MAME_DEBUG
 			"yes"
 #else
@@ -370,6 +680,15 @@ void info_xml_creator::output_header()
 			XML_ROOT,
 			util::xml::normalize_string(emulator_info::get_build_version()),
 			CONFIG_VERSION);
+
+	// the root element has nothing before it, so it doesn't take a comma
+	if (m_json)
+	{
+		std::string xml;
+		xml.swap(m_output);
+		append_jsonml(m_output, xml);
+		m_output.erase(0, 1);
+	}
 }
 
 
@@ -380,7 +699,10 @@ void info_xml_creator::output_header()
 void info_xml_creator::output_footer()
 {
 	// close the top level tag
-	fprintf(m_output, "</%s>\n", XML_ROOT);
+	if (m_json)
+		out("]\n");
+	else
+		out_format("</%s>\n", XML_ROOT);
 }
 
 
@@ -440,43 +762,43 @@ void info_xml_creator::output_one(driver_enumerator &drivlist, device_type_set *
 	}
 
 	// print the header and the machine name
-	fprintf(m_output, "\t<%s name=\"%s\"", XML_TOP, util::xml::normalize_string(driver.name));
+	out_format("\t<%s name=\"%s\"", XML_TOP, util::xml::normalize_string(driver.name));
 
 	// strip away any path information from the source_file and output it
 	const char *start = strrchr(driver.type.source(), '/');
 	if (!start)
 		start = strrchr(driver.type.source(), '\\');
 	start = start ? (start + 1) : driver.type.source();
-	fprintf(m_output, " sourcefile=\"%s\"", util::xml::normalize_string(start));
+	out_attribute("sourcefile", start);
 
 	// append bios and runnable flags
 	if (driver.flags & machine_flags::IS_BIOS_ROOT)
-		fprintf(m_output, " isbios=\"yes\"");
+		out(" isbios=\"yes\"");
 	if (driver.flags & machine_flags::MECHANICAL)
-		fprintf(m_output, " ismechanical=\"yes\"");
+		out(" ismechanical=\"yes\"");
 
 	// display clone information
 	int clone_of = drivlist.find(driver.parent);
 	if (clone_of != -1 && !(drivlist.driver(clone_of).flags & machine_flags::IS_BIOS_ROOT))
-		fprintf(m_output, " cloneof=\"%s\"", util::xml::normalize_string(drivlist.driver(clone_of).name));
+		out_attribute("cloneof", drivlist.driver(clone_of).name);
 	if (clone_of != -1)
-		fprintf(m_output, " romof=\"%s\"", util::xml::normalize_string(drivlist.driver(clone_of).name));
+		out_attribute("romof", drivlist.driver(clone_of).name);
 
 	// display sample information and close the game tag
 	output_sampleof(config->root_device());
-	fprintf(m_output, ">\n");
+	out(">\n");
 
 	// output game description
 	if (driver.type.fullname() != nullptr)
-		fprintf(m_output, "\t\t<description>%s</description>\n", util::xml::normalize_string(driver.type.fullname()));
+		out_format("\t\t<description>%s</description>\n", util::xml::normalize_string(driver.type.fullname()));
 
 	// print the year only if is a number or another allowed character (? or +)
 	if (driver.year != nullptr && strspn(driver.year, "0123456789?+") == strlen(driver.year))
-		fprintf(m_output, "\t\t<year>%s</year>\n", util::xml::normalize_string(driver.year));
+		out_format("\t\t<year>%s</year>\n", util::xml::normalize_string(driver.year));
 
 	// print the manufacturer information
 	if (driver.manufacturer != nullptr)
-		fprintf(m_output, "\t\t<manufacturer>%s</manufacturer>\n", util::xml::normalize_string(driver.manufacturer));
+		out_format("\t\t<manufacturer>%s</manufacturer>\n", util::xml::normalize_string(driver.manufacturer));
 
 	// now print various additional information
 	output_bios(config->root_device());
@@ -499,7 +821,7 @@ void info_xml_creator::output_one(driver_enumerator &drivlist, device_type_set *
 	output_ramoptions(config->root_device());
 
 	// close the topmost tag
-	fprintf(m_output, "\t</%s>\n", XML_TOP);
+	out_format("\t</%s>\n", XML_TOP);
 }
 
 
@@ -538,12 +860,12 @@ void info_xml_creator::output_one_device(machine_config &config, device_t &devic
 			}
 
 	// start to output info
-	fprintf(m_output, "\t<%s name=\"%s\"", XML_TOP, util::xml::normalize_string(device.shortname()));
+	out_format("\t<%s name=\"%s\"", XML_TOP, util::xml::normalize_string(device.shortname()));
 	std::string src(device.source());
 	strreplace(src,"../", "");
-	fprintf(m_output, " sourcefile=\"%s\" isdevice=\"yes\" runnable=\"no\"", util::xml::normalize_string(src.c_str()));
+	out_format(" sourcefile=\"%s\" isdevice=\"yes\" runnable=\"no\"", util::xml::normalize_string(src.c_str()));
 	output_sampleof(device);
-	fprintf(m_output, ">\n\t\t<description>%s</description>\n", util::xml::normalize_string(device.name()));
+	out_format(">\n\t\t<description>%s</description>\n", util::xml::normalize_string(device.name()));
 
 	output_bios(device);
 	output_rom(nullptr, device);
@@ -564,49 +886,65 @@ void info_xml_creator::output_one_device(machine_config &config, device_t &devic
 	output_features(device.type(), overall_unemulated, overall_imperfect);
 	output_images(device, devtag);
 	output_slots(config, device, devtag, nullptr);
-	fprintf(m_output, "\t</%s>\n", XML_TOP);
+	out_format("\t</%s>\n", XML_TOP);
 }
 
 
 //-------------------------------------------------
-//  output_devices - print the XML info for
-//  registered device types
+//  output_device - print the XML info for a
+//  device type, added to an otherwise empty
+//  machine
 //-------------------------------------------------
 
-void info_xml_creator::output_devices(device_type_set const *filter)
+void info_xml_creator::output_device(device_type type)
 {
 	// get config for empty machine
-	machine_config config(GAME_NAME(___empty), m_lookup_options);
+	if (!m_device_config)
+		m_device_config = std::make_unique<machine_config>(GAME_NAME(___empty), m_lookup_options);
+	machine_config &config(*m_device_config);
 
-	auto const action = [this, &config] (device_type type)
-			{
-				// add it at the root of the machine config
-				device_t *dev;
-				{
-					machine_config::token const tok(config.begin_configuration(config.root_device()));
-					dev = config.device_add("_tmp", type, 0);
-				}
+	// add it at the root of the machine config
+	device_t *dev;
+	{
+		machine_config::token const tok(config.begin_configuration(config.root_device()));
+		dev = config.device_add("_tmp", type, 0);
+	}
 
-				// notify this device and all its subdevices that they are now configured
-				for (device_t &device : device_iterator(*dev))
-					if (!device.configured())
-						device.config_complete();
+	// notify this device and all its subdevices that they are now configured
+	for (device_t &device : device_iterator(*dev))
+		if (!device.configured())
+			device.config_complete();
 
-				// print details and remove it
-				output_one_device(config, *dev, dev->tag());
-				machine_config::token const tok(config.begin_configuration(config.root_device()));
-				config.device_remove("_tmp");
-			};
+	// print details and remove it
+	output_one_device(config, *dev, dev->tag());
+	machine_config::token const tok(config.begin_configuration(config.root_device()));
+	config.device_remove("_tmp");
+}
 
+
+//-------------------------------------------------
+//  output_devices - print the XML info for
+//  registered device types
+//-------------------------------------------------
+
+void info_xml_creator::output_devices(FILE *out, device_type_set const *filter)
+{
 	// run through devices
+	std::vector<parallel_item> items;
+	auto const add = [&items] (device_type type)
+			{
+				items.emplace_back();
+				items.back().m_device = &type;
+			};
 	if (filter)
 	{
-		for (std::add_pointer_t<device_type> type : *filter) action(*type);
+		for (std::add_pointer_t<device_type> type : *filter) add(*type);
 	}
 	else
 	{
-		for (device_type type : registered_device_types) action(type);
+		for (device_type type : registered_device_types) add(type);
 	}
+	output_parallel(out, items, nullptr);
 }
 
 
@@ -619,7 +957,7 @@ void info_xml_creator::output_device_refs(device_t &root)
 {
 	for (device_t &device : device_iterator(root))
 		if (&device != &root)
-			fprintf(m_output, "\t\t<device_ref name=\"%s\"/>\n", util::xml::normalize_string(device.shortname()));
+			out_format("\t\t<device_ref name=\"%s\"/>\n", util::xml::normalize_string(device.shortname()));
 }
 
 
@@ -636,7 +974,7 @@ void info_xml_creator::output_sampleof(device_t &device)
 		samples_iterator sampiter(samples);
 		if (sampiter.altbasename() != nullptr)
 		{
-			fprintf(m_output, " sampleof=\"%s\"", util::xml::normalize_string(sampiter.altbasename()));
+			out_attribute("sampleof", sampiter.altbasename());
 
 			// must stop here, as there can only be one attribute of the same name
 			return;
@@ -663,12 +1001,12 @@ void info_xml_creator::output_bios(device_t const &device)
 	for (romload::system_bios const &bios : romload::entries(device.rom_region()).get_system_bioses())
 	{
 		// output extracted name and descriptions
-		fprintf(m_output, "\t\t<biosset");
-		fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(bios.get_name()));
-		fprintf(m_output, " description=\"%s\"", util::xml::normalize_string(bios.get_description()));
+		out("\t\t<biosset");
+		out_attribute("name", bios.get_name());
+		out_attribute("description", bios.get_description());
 		if (defaultname && !std::strcmp(defaultname, bios.get_name()))
-			fprintf(m_output, " default=\"yes\"");
-		fprintf(m_output, "/>\n");
+			out(" default=\"yes\"");
+		out("/>\n");
 	}
 }
 
@@ -761,44 +1099,44 @@ void info_xml_creator::output_rom(driver_enumerator *drivlist, device_t &device)
 			char const *const merge_name((do_merge_name && !hashes.flag(util::hash_collection::FLAG_NO_DUMP)) ? get_merge_name(*drivlist, hashes) : nullptr);
 
 			// opening tag
-			fprintf(m_output, is_disk ? "\t\t<disk" : "\t\t<rom");
+			out_format(is_disk ? "\t\t<disk" : "\t\t<rom");
 
 			// add name, merge, bios, and size tags */
 			char const *const name(rom->name);
 			if (name && name[0])
-				fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(name));
+				out_attribute("name", name);
 			if (merge_name)
-				fprintf(m_output, " merge=\"%s\"", util::xml::normalize_string(merge_name));
+				out_attribute("merge", merge_name);
 			if (bios_name)
-				fprintf(m_output, " bios=\"%s\"", util::xml::normalize_string(bios_name));
+				out_attribute("bios", bios_name);
 			if (!is_disk)
-				fprintf(m_output, " size=\"%u\"", rom_file_size(rom));
+				out_format(" size=\"%u\"", rom_file_size(rom));
 
 			// dump checksum information only if there is a known dump
 			if (!hashes.flag(util::hash_collection::FLAG_NO_DUMP))
-				fprintf(m_output, " %s", hashes.attribute_string().c_str()); // iterate over hash function types and print m_output their values
+				out_format(" %s", hashes.attribute_string().c_str()); // iterate over hash function types and print m_output their values
 			else
-				fprintf(m_output, " status=\"nodump\"");
+				out(" status=\"nodump\"");
 
 			// append a region name
-			fprintf(m_output, " region=\"%s\"", region->name);
+			out_format(" region=\"%s\"", region->name);
 
 			if (!is_disk)
 			{
 				// for non-disk entries, print offset
-				fprintf(m_output, " offset=\"%x\"", ROM_GETOFFSET(rom));
+				out_format(" offset=\"%x\"", ROM_GETOFFSET(rom));
 			}
 			else
 			{
 				// for disk entries, add the disk index
-				fprintf(m_output, " index=\"%x\" writable=\"%s\"", DISK_GETINDEX(rom), DISK_ISREADONLY(rom) ? "no" : "yes");
+				out_format(" index=\"%x\" writable=\"%s\"", DISK_GETINDEX(rom), DISK_ISREADONLY(rom) ? "no" : "yes");
 			}
 
 			// add optional flag
 			if (ROM_ISOPTIONAL(rom))
-				fprintf(m_output, " optional=\"yes\"");
+				out(" optional=\"yes\"");
 
-			fprintf(m_output, "/>\n");
+			out("/>\n");
 		}
 		bios_scanned = true;
 	}
@@ -824,7 +1162,7 @@ void info_xml_creator::output_sample(device_t &device)
 				continue;
 
 			// output the sample name
-			fprintf(m_output, "\t\t<sample name=\"%s\"/>\n", util::xml::normalize_string(samplename));
+			out_format("\t\t<sample name=\"%s\"/>\n", util::xml::normalize_string(samplename));
 		}
 	}
 }
@@ -845,12 +1183,12 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(exec.device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"cpu\"");
-			fprintf(m_output, " tag=\"%s\"", util::xml::normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(exec.device().name()));
-			fprintf(m_output, " clock=\"%d\"", exec.device().clock());
-			fprintf(m_output, "/>\n");
+			out("\t\t<chip");
+			out(" type=\"cpu\"");
+			out_attribute("tag", newtag.c_str());
+			out_attribute("name", exec.device().name());
+			out_format(" clock=\"%d\"", exec.device().clock());
+			out("/>\n");
 		}
 	}
 
@@ -862,13 +1200,13 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(sound.device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"audio\"");
-			fprintf(m_output, " tag=\"%s\"", util::xml::normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(sound.device().name()));
+			out("\t\t<chip");
+			out(" type=\"audio\"");
+			out_attribute("tag", newtag.c_str());
+			out_attribute("name", sound.device().name());
 			if (sound.device().clock() != 0)
-				fprintf(m_output, " clock=\"%d\"", sound.device().clock());
-			fprintf(m_output, "/>\n");
+				out_format(" clock=\"%d\"", sound.device().clock());
+			out("/>\n");
 		}
 	}
 }
@@ -889,43 +1227,43 @@ void info_xml_creator::output_display(device_t &device, machine_flags::type cons
 			std::string newtag(screendev.tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<display tag=\"%s\"", util::xml::normalize_string(newtag.c_str()));
+			out_format("\t\t<display tag=\"%s\"", util::xml::normalize_string(newtag.c_str()));
 
 			switch (screendev.screen_type())
 			{
-				case SCREEN_TYPE_RASTER:    fprintf(m_output, " type=\"raster\"");  break;
-				case SCREEN_TYPE_VECTOR:    fprintf(m_output, " type=\"vector\"");  break;
-				case SCREEN_TYPE_LCD:       fprintf(m_output, " type=\"lcd\"");     break;
-				case SCREEN_TYPE_SVG:       fprintf(m_output, " type=\"svg\"");     break;
-				default:                    fprintf(m_output, " type=\"unknown\""); break;
+				case SCREEN_TYPE_RASTER:    out(" type=\"raster\"");  break;
+				case SCREEN_TYPE_VECTOR:    out(" type=\"vector\"");  break;
+				case SCREEN_TYPE_LCD:       out(" type=\"lcd\"");     break;
+				case SCREEN_TYPE_SVG:       out(" type=\"svg\"");     break;
+				default:                    out(" type=\"unknown\""); break;
 			}
 
 			// output the orientation as a string
 			switch (screendev.orientation())
 			{
 			case ORIENTATION_FLIP_X:
-				fprintf(m_output, " rotate=\"0\" flipx=\"yes\"");
+				out(" rotate=\"0\" flipx=\"yes\"");
 				break;
 			case ORIENTATION_FLIP_Y:
-				fprintf(m_output, " rotate=\"180\" flipx=\"yes\"");
+				out(" rotate=\"180\" flipx=\"yes\"");
 				break;
 			case ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-				fprintf(m_output, " rotate=\"180\"");
+				out(" rotate=\"180\"");
 				break;
 			case ORIENTATION_SWAP_XY:
-				fprintf(m_output, " rotate=\"90\" flipx=\"yes\"");
+				out(" rotate=\"90\" flipx=\"yes\"");
 				break;
 			case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X:
-				fprintf(m_output, " rotate=\"90\"");
+				out(" rotate=\"90\"");
 				break;
 			case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_Y:
-				fprintf(m_output, " rotate=\"270\"");
+				out(" rotate=\"270\"");
 				break;
 			case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-				fprintf(m_output, " rotate=\"270\" flipx=\"yes\"");
+				out(" rotate=\"270\" flipx=\"yes\"");
 				break;
 			default:
-				fprintf(m_output, " rotate=\"0\"");
+				out(" rotate=\"0\"");
 				break;
 			}
 
@@ -933,12 +1271,12 @@ void info_xml_creator::output_display(device_t &device, machine_flags::type cons
 			if (screendev.screen_type() != SCREEN_TYPE_VECTOR)
 			{
 				const rectangle &visarea = screendev.visible_area();
-				fprintf(m_output, " width=\"%d\"", visarea.width());
-				fprintf(m_output, " height=\"%d\"", visarea.height());
+				out_format(" width=\"%d\"", visarea.width());
+				out_format(" height=\"%d\"", visarea.height());
 			}
 
 			// output refresh rate
-			fprintf(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev.refresh_attoseconds()));
+			out_format(" refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev.refresh_attoseconds()));
 
 			// output raw video parameters only for games that are not vector
 			// and had raw parameters specified
@@ -946,15 +1284,15 @@ void info_xml_creator::output_display(device_t &device, machine_flags::type cons
 			{
 				int pixclock = screendev.width() * screendev.height() * ATTOSECONDS_TO_HZ(screendev.refresh_attoseconds());
 
-				fprintf(m_output, " pixclock=\"%d\"", pixclock);
-				fprintf(m_output, " htotal=\"%d\"", screendev.width());
-				fprintf(m_output, " hbend=\"%d\"", screendev.visible_area().min_x);
-				fprintf(m_output, " hbstart=\"%d\"", screendev.visible_area().max_x+1);
-				fprintf(m_output, " vtotal=\"%d\"", screendev.height());
-				fprintf(m_output, " vbend=\"%d\"", screendev.visible_area().min_y);
-				fprintf(m_output, " vbstart=\"%d\"", screendev.visible_area().max_y+1);
+				out_format(" pixclock=\"%d\"", pixclock);
+				out_format(" htotal=\"%d\"", screendev.width());
+				out_format(" hbend=\"%d\"", screendev.visible_area().min_x);
+				out_format(" hbstart=\"%d\"", screendev.visible_area().max_x+1);
+				out_format(" vtotal=\"%d\"", screendev.height());
+				out_format(" vbend=\"%d\"", screendev.visible_area().min_y);
+				out_format(" vbstart=\"%d\"", screendev.visible_area().max_y+1);
 			}
-			fprintf(m_output, " />\n");
+			out(" />\n");
 		}
 	}
 }
@@ -975,7 +1313,7 @@ void info_xml_creator::output_sound(device_t &device)
 	if (snditer.first() == nullptr)
 		speakers = 0;
 
-	fprintf(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
+	out_format("\t\t<sound channels=\"%d\"/>\n", speakers);
 }
 
 
@@ -987,7 +1325,7 @@ void info_xml_creator::output_sound(device_t &device)
 void info_xml_creator::output_ioport_condition(const ioport_condition &condition, unsigned indent)
 {
 	for (unsigned i = 0; indent > i; ++i)
-		fprintf(m_output, "\t");
+		out("\t");
 
 	char const *rel(nullptr);
 	switch (condition.condition())
@@ -1001,7 +1339,7 @@ void info_xml_creator::output_ioport_condition(const ioport_condition &condition
 	case ioport_condition::NOTLESSTHAN:     rel = "ge"; break;
 	}
 
-	fprintf(m_output,"<condition tag=\"%s\" mask=\"%u\" relation=\"%s\" value=\"%u\"/>\n", util::xml::normalize_string(condition.tag()), condition.mask(), rel, condition.value());
+	out_format("<condition tag=\"%s\" mask=\"%u\" relation=\"%s\" value=\"%u\"/>\n", util::xml::normalize_string(condition.tag()), condition.mask(), rel, condition.value());
 }
 
 //-------------------------------------------------
@@ -1403,15 +1741,15 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 
 	// Output the input info
 	// First basic info
-	fprintf(m_output, "\t\t<input");
-	fprintf(m_output, " players=\"%d\"", nplayer);
+	out("\t\t<input");
+	out_format(" players=\"%d\"", nplayer);
 	if (ncoin != 0)
-		fprintf(m_output, " coins=\"%d\"", ncoin);
+		out_format(" coins=\"%d\"", ncoin);
 	if (service)
-		fprintf(m_output, " service=\"yes\"");
+		out(" service=\"yes\"");
 	if (tilt)
-		fprintf(m_output, " tilt=\"yes\"");
-	fprintf(m_output, ">\n");
+		out(" tilt=\"yes\"");
+	out(">\n");
 
 	// Then controller specific ones
 	for (auto & elem : control_info)
@@ -1420,25 +1758,25 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 			//printf("type %s - player %d - buttons %d\n", elem.type, elem.player, elem.nbuttons);
 			if (elem.analog)
 			{
-				fprintf(m_output, "\t\t\t<control type=\"%s\"", util::xml::normalize_string(elem.type));
+				out_format("\t\t\t<control type=\"%s\"", util::xml::normalize_string(elem.type));
 				if (nplayer > 1)
-					fprintf(m_output, " player=\"%d\"", elem.player);
+					out_format(" player=\"%d\"", elem.player);
 				if (elem.nbuttons > 0)
 				{
-					fprintf(m_output, " buttons=\"%d\"", strcmp(elem.type, "stick") ? elem.nbuttons : elem.maxbuttons);
+					out_format(" buttons=\"%d\"", strcmp(elem.type, "stick") ? elem.nbuttons : elem.maxbuttons);
 					if (elem.reqbuttons < elem.nbuttons)
-						fprintf(m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
+						out_format(" reqbuttons=\"%d\"", elem.reqbuttons);
 				}
 				if (elem.min != 0 || elem.max != 0)
-					fprintf(m_output, " minimum=\"%d\" maximum=\"%d\"", elem.min, elem.max);
+					out_format(" minimum=\"%d\" maximum=\"%d\"", elem.min, elem.max);
 				if (elem.sensitivity != 0)
-					fprintf(m_output, " sensitivity=\"%d\"", elem.sensitivity);
+					out_format(" sensitivity=\"%d\"", elem.sensitivity);
 				if (elem.keydelta != 0)
-					fprintf(m_output, " keydelta=\"%d\"", elem.keydelta);
+					out_format(" keydelta=\"%d\"", elem.keydelta);
 				if (elem.reverse)
-					fprintf(m_output, " reverse=\"yes\"");
+					out(" reverse=\"yes\"");
 
-				fprintf(m_output, "/>\n");
+				out("/>\n");
 			}
 			else
 			{
@@ -1446,14 +1784,14 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 				if (elem.helper[0] == 0 && elem.helper[1] != 0) { elem.helper[0] = elem.helper[1]; elem.helper[1] = 0; }
 				if (elem.helper[1] == 0 && elem.helper[2] != 0) { elem.helper[1] = elem.helper[2]; elem.helper[2] = 0; }
 				const char *joys = (elem.helper[2] != 0) ? "triple" : (elem.helper[1] != 0) ? "double" : "";
-				fprintf(m_output, "\t\t\t<control type=\"%s%s\"", joys, util::xml::normalize_string(elem.type));
+				out_format("\t\t\t<control type=\"%s%s\"", joys, util::xml::normalize_string(elem.type));
 				if (nplayer > 1)
-					fprintf(m_output, " player=\"%d\"", elem.player);
+					out_format(" player=\"%d\"", elem.player);
 				if (elem.nbuttons > 0)
 				{
-					fprintf(m_output, " buttons=\"%d\"", strcmp(elem.type, "joy") ? elem.nbuttons : elem.maxbuttons);
+					out_format(" buttons=\"%d\"", strcmp(elem.type, "joy") ? elem.nbuttons : elem.maxbuttons);
 					if (elem.reqbuttons < elem.nbuttons)
-						fprintf(m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
+						out_format(" reqbuttons=\"%d\"", elem.reqbuttons);
 				}
 				for (int lp = 0; lp < 3 && elem.helper[lp] != 0; lp++)
 				{
@@ -1488,13 +1826,13 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 							ways = "strange2";
 							break;
 					}
-					fprintf(m_output, " ways%s=\"%s\"", plural, ways);
+					out_format(" ways%s=\"%s\"", plural, ways);
 				}
-				fprintf(m_output, "/>\n");
+				out("/>\n");
 			}
 		}
 
-	fprintf(m_output, "\t\t</input>\n");
+	out("\t\t</input>\n");
 }
 
 
@@ -1516,39 +1854,39 @@ void info_xml_creator::output_switches(const ioport_list &portlist, const char *
 				// output the switch name information
 				std::string const normalized_field_name(util::xml::normalize_string(field.name()));
 				std::string const normalized_newtag(util::xml::normalize_string(newtag.c_str()));
-				fprintf(m_output, "\t\t<%s name=\"%s\" tag=\"%s\" mask=\"%u\">\n", outertag, normalized_field_name.c_str(), normalized_newtag.c_str(), field.mask());
+				out_format("\t\t<%s name=\"%s\" tag=\"%s\" mask=\"%u\">\n", outertag, normalized_field_name.c_str(), normalized_newtag.c_str(), field.mask());
 				if (!field.condition().none())
 					output_ioport_condition(field.condition(), 3);
 
 				// loop over locations
 				for (ioport_diplocation const &diploc : field.diplocations())
 				{
-					fprintf(m_output, "\t\t\t<%s name=\"%s\" number=\"%u\"", loctag, util::xml::normalize_string(diploc.name()), diploc.number());
+					out_format("\t\t\t<%s name=\"%s\" number=\"%u\"", loctag, util::xml::normalize_string(diploc.name()), diploc.number());
 					if (diploc.inverted())
-						fprintf(m_output, " inverted=\"yes\"");
-					fprintf(m_output, "/>\n");
+						out(" inverted=\"yes\"");
+					out("/>\n");
 				}
 
 				// loop over settings
 				for (ioport_setting const &setting : field.settings())
 				{
-					fprintf(m_output, "\t\t\t<%s name=\"%s\" value=\"%u\"", innertag, util::xml::normalize_string(setting.name()), setting.value());
+					out_format("\t\t\t<%s name=\"%s\" value=\"%u\"", innertag, util::xml::normalize_string(setting.name()), setting.value());
 					if (setting.value() == field.defvalue())
-						fprintf(m_output, " default=\"yes\"");
+						out(" default=\"yes\"");
 					if (setting.condition().none())
 					{
-						fprintf(m_output, "/>\n");
+						out("/>\n");
 					}
 					else
 					{
-						fprintf(m_output, ">\n");
+						out(">\n");
 						output_ioport_condition(setting.condition(), 4);
-						fprintf(m_output, "\t\t\t</%s>\n", innertag);
+						out_format("\t\t\t</%s>\n", innertag);
 					}
 				}
 
 				// terminate the switch entry
-				fprintf(m_output, "\t\t</%s>\n", outertag);
+				out_format("\t\t</%s>\n", outertag);
 			}
 }
 
@@ -1561,13 +1899,13 @@ void info_xml_creator::output_ports(const ioport_list &portlist)
 	// cycle through ports
 	for (auto &port : portlist)
 	{
-		fprintf(m_output,"\t\t<port tag=\"%s\">\n", util::xml::normalize_string(port.second->tag()));
+		out_format("\t\t<port tag=\"%s\">\n", util::xml::normalize_string(port.second->tag()));
 		for (ioport_field const &field : port.second->fields())
 		{
 			if (field.is_analog())
-				fprintf(m_output,"\t\t\t<analog mask=\"%u\"/>\n", field.mask());
+				out_format("\t\t\t<analog mask=\"%u\"/>\n", field.mask());
 		}
-		fprintf(m_output,"\t\t</port>\n");
+		out("\t\t</port>\n");
 	}
 
 }
@@ -1584,7 +1922,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 		for (ioport_field const &field : port.second->fields())
 			if (field.type() == IPT_ADJUSTER)
 			{
-				fprintf(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", util::xml::normalize_string(field.name()), field.defvalue());
+				out_format("\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", util::xml::normalize_string(field.name()), field.defvalue());
 			}
 }
 
@@ -1595,7 +1933,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 
 void info_xml_creator::output_driver(game_driver const &driver, device_t::feature_type unemulated, device_t::feature_type imperfect)
 {
-	fprintf(m_output, "\t\t<driver");
+	out("\t\t<driver");
 
 	/*
 	The status entry is an hint for frontend authors to select working
@@ -1612,26 +1950,26 @@ void info_xml_creator::output_driver(game_driver const &driver, device_t::featur
 	bool const imperfect_preliminary((unemulated | imperfect) & device_t::feature::PROTECTION);
 
 	if (machine_preliminary || unemulated_preliminary || imperfect_preliminary)
-		fprintf(m_output, " status=\"preliminary\"");
+		out(" status=\"preliminary\"");
 	else if (imperfect)
-		fprintf(m_output, " status=\"imperfect\"");
+		out(" status=\"imperfect\"");
 	else
-		fprintf(m_output, " status=\"good\"");
+		out(" status=\"good\"");
 
 	if (flags & machine_flags::NOT_WORKING)
-		fprintf(m_output, " emulation=\"preliminary\"");
+		out(" emulation=\"preliminary\"");
 	else
-		fprintf(m_output, " emulation=\"good\"");
+		out(" emulation=\"good\"");
 
 	if (flags & machine_flags::NO_COCKTAIL)
-		fprintf(m_output, " cocktail=\"preliminary\"");
+		out(" cocktail=\"preliminary\"");
 
 	if (flags & machine_flags::SUPPORTS_SAVE)
-		fprintf(m_output, " savestate=\"supported\"");
+		out(" savestate=\"supported\"");
 	else
-		fprintf(m_output, " savestate=\"unsupported\"");
+		out(" savestate=\"unsupported\"");
 
-	fprintf(m_output, "/>\n");
+	out("/>\n");
 }
 
 
@@ -1663,21 +2001,21 @@ void info_xml_creator::output_features(device_type type, device_t::feature_type
 	{
 		if (flags & feature.first)
 		{
-			fprintf(m_output, "\t\t<feature type=\"%s\"", feature.second);
+			out_format("\t\t<feature type=\"%s\"", feature.second);
 			if (type.unemulated_features() & feature.first)
 			{
-				fprintf(m_output, " status=\"unemulated\"");
+				out(" status=\"unemulated\"");
 			}
 			else
 			{
 				if (type.imperfect_features() & feature.first)
-					fprintf(m_output, " status=\"imperfect\"");
+					out(" status=\"imperfect\"");
 				if (unemulated & feature.first)
-					fprintf(m_output, " overall=\"unemulated\"");
+					out(" overall=\"unemulated\"");
 				else if ((~type.imperfect_features() & imperfect) & feature.first)
-					fprintf(m_output, " overall=\"imperfect\"");
+					out(" overall=\"imperfect\"");
 			}
-			fprintf(m_output, "/>\n");
+			out("/>\n");
 		}
 	}
 }
@@ -1699,46 +2037,46 @@ void info_xml_creator::output_images(device_t &device, const char *root_tag)
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<device type=\"%s\"", util::xml::normalize_string(imagedev.image_type_name()));
+			out_format("\t\t<device type=\"%s\"", util::xml::normalize_string(imagedev.image_type_name()));
 
 			// does this device have a tag?
 			if (imagedev.device().tag())
-				fprintf(m_output, " tag=\"%s\"", util::xml::normalize_string(newtag.c_str()));
+				out_attribute("tag", newtag.c_str());
 
 			// is this device available as media switch?
 			if (!loadable)
-				fprintf(m_output, " fixed_image=\"1\"");
+				out(" fixed_image=\"1\"");
 
 			// is this device mandatory?
 			if (imagedev.must_be_loaded())
-				fprintf(m_output, " mandatory=\"1\"");
+				out(" mandatory=\"1\"");
 
 			if (imagedev.image_interface() && imagedev.image_interface()[0])
-				fprintf(m_output, " interface=\"%s\"", util::xml::normalize_string(imagedev.image_interface()));
+				out_attribute("interface", imagedev.image_interface());
 
 			// close the XML tag
-			fprintf(m_output, ">\n");
+			out(">\n");
 
 			if (loadable)
 			{
 				const char *name = imagedev.instance_name().c_str();
 				const char *shortname = imagedev.brief_instance_name().c_str();
 
-				fprintf(m_output, "\t\t\t<instance");
-				fprintf(m_output, " name=\"%s\"", util::xml::normalize_string(name));
-				fprintf(m_output, " briefname=\"%s\"", util::xml::normalize_string(shortname));
-				fprintf(m_output, "/>\n");
+				out("\t\t\t<instance");
+				out_attribute("name", name);
+				out_attribute("briefname", shortname);
+				out("/>\n");
 
 				std::string extensions(imagedev.file_extensions());
 
 				char *ext = strtok((char *)extensions.c_str(), ",");
 				while (ext != nullptr)
 				{
-					fprintf(m_output, "\t\t\t<extension name=\"%s\"/>\n", util::xml::normalize_string(ext));
+					out_format("\t\t\t<extension name=\"%s\"/>\n", util::xml::normalize_string(ext));
 					ext = strtok(nullptr, ",");
 				}
 			}
-			fprintf(m_output, "\t\t</device>\n");
+			out("\t\t</device>\n");
 		}
 	}
 }
@@ -1763,7 +2101,7 @@ void info_xml_creator::output_slots(machine_config &config, device_t &device, co
 
 			// print m_output device type
 			if (listed)
-				fprintf(m_output, "\t\t<slot name=\"%s\">\n", util::xml::normalize_string(newtag.c_str()));
+				out_format("\t\t<slot name=\"%s\">\n", util::xml::normalize_string(newtag.c_str()));
 
 			for (auto &option : slot.option_list())
 			{
@@ -1778,11 +2116,11 @@ void info_xml_creator::output_slots(machine_config &config, device_t &device, co
 
 					if (listed && option.second->selectable())
 					{
-						fprintf(m_output, "\t\t\t<slotoption name=\"%s\"", util::xml::normalize_string(option.second->name()));
-						fprintf(m_output, " devname=\"%s\"", util::xml::normalize_string(dev->shortname()));
+						out_format("\t\t\t<slotoption name=\"%s\"", util::xml::normalize_string(option.second->name()));
+						out_attribute("devname", dev->shortname());
 						if (slot.default_option() != nullptr && strcmp(slot.default_option(), option.second->name())==0)
-							fprintf(m_output, " default=\"yes\"");
-						fprintf(m_output, "/>\n");
+							out(" default=\"yes\"");
+						out("/>\n");
 					}
 
 					config.device_remove("_dummy");
@@ -1790,7 +2128,7 @@ void info_xml_creator::output_slots(machine_config &config, device_t &device, co
 			}
 
 			if (listed)
-				fprintf(m_output, "\t\t</slot>\n");
+				out("\t\t</slot>\n");
 		}
 	}
 }
@@ -1805,10 +2143,10 @@ void info_xml_creator::output_software_list(device_t &root)
 {
 	for (const software_list_device &swlist : software_list_device_iterator(root))
 	{
-		fprintf(m_output, "\t\t<softwarelist name=\"%s\" status=\"%s\"", util::xml::normalize_string(swlist.list_name().c_str()), (swlist.list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
+		out_format("\t\t<softwarelist name=\"%s\" status=\"%s\"", util::xml::normalize_string(swlist.list_name().c_str()), (swlist.list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
 		if (swlist.filter())
-			fprintf(m_output, " filter=\"%s\"", util::xml::normalize_string(swlist.filter()));
-		fprintf(m_output, "/>\n");
+			out_attribute("filter", swlist.filter());
+		out("/>\n");
 	}
 }
 
@@ -1833,15 +2171,15 @@ void info_xml_creator::output_ramoptions(device_t &root)
 				{
 					assert(!havedefault);
 					havedefault = true;
-					fprintf(m_output, "\t\t<ramoption name=\"%s\" default=\"yes\">%u</ramoption>\n", util::xml::normalize_string(option.first.c_str()), option.second);
+					out_format("\t\t<ramoption name=\"%s\" default=\"yes\">%u</ramoption>\n", util::xml::normalize_string(option.first.c_str()), option.second);
 				}
 				else
 				{
-					fprintf(m_output, "\t\t<ramoption name=\"%s\">%u</ramoption>\n", util::xml::normalize_string(option.first.c_str()), option.second);
+					out_format("\t\t<ramoption name=\"%s\">%u</ramoption>\n", util::xml::normalize_string(option.first.c_str()), option.second);
 				}
 			}
 			if (!havedefault)
-				fprintf(m_output, "\t\t<ramoption name=\"%s\" default=\"yes\">%u</ramoption>\n", ram.default_size_string(), defsize);
+				out_format("\t\t<ramoption name=\"%s\" default=\"yes\">%u</ramoption>\n", ram.default_size_string(), defsize);
 			break;
 		}
 	}
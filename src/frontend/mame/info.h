@@ -15,6 +15,8 @@
 
 #include "emuopts.h"
 
+#include <memory>
+#include <string>
 #include <type_traits>
 #include <unordered_set>
 #include <vector>
@@ -32,7 +34,8 @@ class info_xml_creator
 {
 public:
 	// construction/destruction
-	info_xml_creator(emu_options const &options, bool dtd = true);
+	info_xml_creator(emu_options const &options, bool dtd = true, bool json = false);
+	~info_xml_creator();
 
 	// output
 	void output(FILE *out, std::vector<std::string> const &patterns);
@@ -41,7 +44,23 @@ public:
 private:
 	typedef std::unordered_set<std::add_pointer_t<device_type> > device_type_set;
 
+	struct parallel_work;
+	struct parallel_item;
+
+	// machines and devices are described on worker threads, then written in order
+	static constexpr std::size_t PARALLEL_WINDOW = 256;
+
+	// output buffering
+	void out(const char *text) { m_output.append(text); }
+	void out_format(const char *format, ...) ATTR_PRINTF(2,3);
+	void out_attribute(const char *name, const char *value);
+	void flush_output(FILE *out);
+	static void append_jsonml(std::string &dest, std::string const &xml);
+
 	// internal helper
+	void output_parallel(FILE *out, std::vector<parallel_item> &items, device_type_set *devtypes);
+	static void *parallel_callback(void *param, int threadid);
+
 	void output_header();
 	void output_footer();
 
@@ -67,16 +86,19 @@ private:
 	void output_ramoptions(device_t &root);
 
 	void output_one_device(machine_config &config, device_t &device, const char *devtag);
-	void output_devices(device_type_set const *filter);
+	void output_device(device_type type);
+	void output_devices(FILE *out, device_type_set const *filter);
 
 	const char *get_merge_name(driver_enumerator &drivlist, util::hash_collection const &romhashes);
 
 	// internal state
-	FILE *          m_output; // FIXME: this is not reentrancy-safe
+	std::string     m_output;
 	emu_options     m_lookup_options;
+	std::unique_ptr<machine_config> m_device_config;
 
 	static const char s_dtd_string[];
 	bool m_dtd;
+	bool m_json;
 };
 
 #endif // MAME_FRONTEND_MAME_INFO_H
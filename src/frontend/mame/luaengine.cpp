@@ -442,6 +442,27 @@ void lua_engine::addr_space::direct_mem_write(offs_t address, T val)
 	}
 }
 
+//-------------------------------------------------
+//  sized_read - read an unsigned value of the
+//  given width in bits, for the bulk readers
+//-------------------------------------------------
+
+u64 lua_engine::addr_space::sized_read(offs_t address, int width)
+{
+	switch(width) {
+		case 8:
+			return mem_read<uint8_t>(address);
+		case 16:
+			return mem_read<uint16_t>(address);
+		case 32:
+			return mem_read<uint32_t>(address);
+		case 64:
+			return mem_read<uint64_t>(address);
+		default:
+			return 0;
+	}
+}
+
 //-------------------------------------------------
 //  region_read - templated region readers for <sign>,<size>
 //  -> manager:machine():memory().regions[":maincpu"]:read_i8(0xC000)
@@ -639,6 +660,7 @@ bool lua_engine::execute_function(const char *id)
 	sol::object functable = sol().registry()[id];
 	if(functable.is<sol::table>())
 	{
+		osd_ticks_t const start = osd_ticks();
 		for(auto &func : functable.as<sol::table>())
 		{
 			if(func.second.is<sol::protected_function>())
@@ -651,11 +673,43 @@ bool lua_engine::execute_function(const char *id)
 				}
 			}
 		}
+		callback_stats &stats = m_callback_stats[id];
+		stats.calls++;
+		stats.ticks += osd_ticks() - start;
 		return true;
 	}
 	return false;
 }
 
+//-------------------------------------------------
+//  run_watches - read every watched address set
+//  and hand each one to its callback as a single
+//  table, reusing the table from frame to frame
+//-------------------------------------------------
+
+void lua_engine::run_watches()
+{
+	if(m_watches.empty())
+		return;
+
+	osd_ticks_t const start = osd_ticks();
+	for(frame_watch &watch : m_watches)
+	{
+		addr_space sp(*watch.space, watch.space->device().memory());
+		for(size_t i = 0; i < watch.addresses.size(); i++)
+			watch.values[i + 1] = sp.sized_read(watch.addresses[i], watch.width);
+		auto ret = watch.callback(watch.values);
+		if(!ret.valid())
+		{
+			sol::error err = ret;
+			osd_printf_error("[LUA ERROR] in watch callback: %s\n", err.what());
+		}
+	}
+	callback_stats &stats = m_callback_stats["LUA_ON_WATCH"];
+	stats.calls++;
+	stats.ticks += osd_ticks() - start;
+}
+
 void lua_engine::register_function(sol::function func, const char *id)
 {
 	sol::object functable = sol().registry()[id];
@@ -678,6 +732,9 @@ void lua_engine::on_machine_start()
 void lua_engine::on_machine_stop()
 {
 	execute_function("LUA_ON_STOP");
+
+	// watches point into this machine's address spaces
+	m_watches.clear();
 }
 
 void lua_engine::on_machine_pause()
@@ -695,8 +752,29 @@ void lua_engine::on_machine_frame()
 	execute_function("LUA_ON_FRAME");
 }
 
+void lua_engine::on_machine_save_complete()
+{
+	sol::object functable = sol().registry()["LUA_ON_STATE_SAVED"];
+	if(functable.is<sol::table>())
+	{
+		for(auto &func : functable.as<sol::table>())
+		{
+			if(func.second.is<sol::protected_function>())
+			{
+				auto ret = (func.second.as<sol::protected_function>())(machine().last_save_file(), machine().last_save_error() == STATERR_NONE);
+				if(!ret.valid())
+				{
+					sol::error err = ret;
+					osd_printf_error("[LUA ERROR] in on_machine_save_complete: %s\n", err.what());
+				}
+			}
+		}
+	}
+}
+
 void lua_engine::on_frame_done()
 {
+	run_watches();
 	execute_function("LUA_ON_FRAME_DONE");
 }
 
@@ -713,6 +791,7 @@ void lua_engine::attach_notifiers()
 	machine().add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(&lua_engine::on_machine_pause, this));
 	machine().add_notifier(MACHINE_NOTIFY_RESUME, machine_notify_delegate(&lua_engine::on_machine_resume, this));
 	machine().add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&lua_engine::on_machine_frame, this));
+	machine().add_notifier(MACHINE_NOTIFY_SAVE_COMPLETE, machine_notify_delegate(&lua_engine::on_machine_save_complete, this));
 }
 
 //-------------------------------------------------
@@ -740,6 +819,10 @@ void lua_engine::initialize()
  * emu.register_frame(callback) - callback at end of frame
  * emu.register_frame_done(callback) - callback after frame is drawn to screen (for overlays)
  * emu.register_periodic(callback) - periodic callback while program is running
+ * emu.register_state_saved(callback) - callback(filename, success) once a state file has been written
+ * emu.register_watch(space, addresses, width, callback) - callback(values) after each frame is drawn, with
+ *   the width-bit value at each address in the table, read natively in one pass
+ * emu.callback_stats() - table of hook name -> { calls, seconds } spent in script callbacks
  * emu.register_menu(event_callback, populate_callback, name) - callbacks for plugin menu
  * emu.print_verbose(str) -- output to stderr at verbose level
  * emu.print_error(str) -- output to stderr at error level
@@ -757,6 +840,7 @@ void lua_engine::initialize()
 	emu["softname"] = [this]() { return machine().options().software_name(); };
 	emu["keypost"] = [this](const char *keys){ machine().ioport().natkeyboard().post_utf8(keys); };
 	emu["time"] = [this](){ return machine().time().as_double(); };
+	emu["instance"] = [this](){ return machine().instance(); };
 	emu["start"] = [this](const char *driver) {
 			int i = driver_list::find(driver);
 			if (i != -1)
@@ -776,6 +860,31 @@ void lua_engine::initialize()
 	emu["register_frame"] = [this](sol::function func){ register_function(func, "LUA_ON_FRAME"); };
 	emu["register_frame_done"] = [this](sol::function func){ register_function(func, "LUA_ON_FRAME_DONE"); };
 	emu["register_periodic"] = [this](sol::function func){ register_function(func, "LUA_ON_PERIODIC"); };
+	emu["register_state_saved"] = [this](sol::function func){ register_function(func, "LUA_ON_STATE_SAVED"); };
+	emu["register_watch"] = [this](addr_space &sp, sol::table addresses, int width, sol::protected_function func) {
+			if(width != 8 && width != 16 && width != 32 && width != 64)
+				luaL_error(m_lua_state, "register_watch: width must be 8, 16, 32 or 64");
+			frame_watch watch;
+			watch.space = &sp.space;
+			watch.width = width;
+			watch.callback = func;
+			for(auto &entry : addresses)
+				if(entry.second.is<offs_t>())
+					watch.addresses.push_back(entry.second.as<offs_t>());
+			watch.values = sol().create_table(watch.addresses.size(), 0);
+			m_watches.emplace_back(std::move(watch));
+		};
+	emu["callback_stats"] = [this]() {
+			sol::table table = sol().create_table();
+			for(auto &stats : m_callback_stats)
+			{
+				sol::table entry = sol().create_table();
+				entry["calls"] = stats.second.calls;
+				entry["seconds"] = double(stats.second.ticks) / double(osd_ticks_per_second());
+				table[stats.first] = entry;
+			}
+			return table;
+		};
 	emu["register_menu"] = [this](sol::function cb, sol::function pop, const std::string &name) {
 			std::string cbfield = "menu_cb_" + name;
 			std::string popfield = "menu_pop_" + name;
@@ -1153,6 +1262,7 @@ void lua_engine::initialize()
  * machine:output() - get output_manager
  * machine:input() - get input_manager
  * machine:uiinput() - get ui_input_manager
+ * machine:scheduler() - get device_scheduler
  * machine.paused - get paused state
  * machine.devices[] - get device table
  * machine.screens[] - get screens table
@@ -1177,6 +1287,7 @@ void lua_engine::initialize()
 			"outputs", &running_machine::output,
 			"input", &running_machine::input,
 			"uiinput", &running_machine::ui_input,
+			"scheduler", &running_machine::scheduler,
 			"debugger", [this](running_machine &m) -> sol::object {
 					if(!(m.debug_flags & DEBUG_FLAG_ENABLED))
 						return sol::make_object(sol(), sol::nil);
@@ -1455,6 +1566,43 @@ void lua_engine::initialize()
 			"write_direct_u32", &addr_space::direct_mem_write<uint32_t>,
 			"write_direct_i64", &addr_space::direct_mem_write<int64_t>,
 			"write_direct_u64", &addr_space::direct_mem_write<uint64_t>,
+			"read_range", [](addr_space &sp, offs_t first, offs_t last, int width, sol::object step) {
+					// packed in the host's byte order, like string.unpack("=I2") etc. expects
+					std::string result;
+					offs_t const inc = step.is<offs_t>() ? std::max<offs_t>(step.as<offs_t>(), 1) : 1;
+					int const bytes = width / 8;
+					if((width != 8 && width != 16 && width != 32 && width != 64) || last < first)
+						return result;
+					result.reserve(size_t((last - first) / inc + 1) * bytes);
+					for(offs_t address = first; address <= last; address += inc)
+					{
+						u64 const value = sp.sized_read(address, width);
+						switch(width)
+						{
+							case 8: { u8 v = value; result.append(reinterpret_cast<const char *>(&v), 1); break; }
+							case 16: { u16 v = value; result.append(reinterpret_cast<const char *>(&v), 2); break; }
+							case 32: { u32 v = value; result.append(reinterpret_cast<const char *>(&v), 4); break; }
+							case 64: result.append(reinterpret_cast<const char *>(&value), 8); break;
+						}
+						if(address + inc < address)
+							break;
+					}
+					return result;
+				},
+			"read_values", [this](addr_space &sp, offs_t first, offs_t last, int width, sol::object step) {
+					offs_t const inc = step.is<offs_t>() ? std::max<offs_t>(step.as<offs_t>(), 1) : 1;
+					sol::table values = sol().create_table();
+					if((width != 8 && width != 16 && width != 32 && width != 64) || last < first)
+						return values;
+					int index = 1;
+					for(offs_t address = first; address <= last; address += inc)
+					{
+						values[index++] = sp.sized_read(address, width);
+						if(address + inc < address)
+							break;
+					}
+					return values;
+				},
 			"name", sol::property([](addr_space &sp) { return sp.space.name(); }),
 			"shift", sol::property([](addr_space &sp) { return sp.space.addr_shift(); }),
 			"index", sol::property([](addr_space &sp) { return sp.space.spacenum(); }),
@@ -1471,6 +1619,23 @@ void lua_engine::initialize()
 						map.add(mapentry);
 					}
 					return map;
+				}),
+			"heatmap", sol::property([this](addr_space &sp) {
+					sol::table heatmap = sol().create_table();
+#ifdef MAME_MEMORY_HEATMAP
+					for (memory_heatmap::handler_stats const &stats : sp.space.heatmap().handlers())
+					{
+						sol::table entry = sol().create_table();
+						entry["name"] = stats.name;
+						entry["offset"] = stats.start;
+						entry["endoff"] = stats.end;
+						entry["count"] = stats.count;
+						entry["ns"] = memory_heatmap::ticks_to_ns(stats.ticks);
+						entry["write"] = stats.write;
+						heatmap.add(entry);
+					}
+#endif
+					return heatmap;
 				}));
 
 /* machine:ioport()
@@ -1572,6 +1737,54 @@ void lua_engine::initialize()
 			"add", &parameters_manager::add,
 			"lookup", &parameters_manager::lookup);
 
+/* machine:scheduler() - device_scheduler
+ * scheduler:time() - current emulated time in seconds
+ * scheduler:reset_statistics() - clear all counters
+ * scheduler:devices()[] - per-device table of timeslices, cycles, aborts, idle_skips and idle_cycles
+ * scheduler:timers()[] - per-callback table of fired count and host_seconds
+ * scheduler.statistics - collect statistics (also enabled by the profiler overlay)
+ * scheduler.elapsed - emulated seconds covered by the counters
+ * scheduler.timeslices - number of scheduler passes
+ * scheduler.boosts - number of boost_interleave requests
+ * scheduler.boost_time - total requested boost duration in seconds
+ * scheduler.timer_host_seconds - host time spent executing timers
+ */
+
+	sol().registry().new_usertype<device_scheduler>("scheduler", "new", sol::no_constructor,
+			"time", [](device_scheduler &sched) { return sched.time().as_double(); },
+			"reset_statistics", &device_scheduler::reset_statistics,
+			"devices", [this](device_scheduler &sched) {
+					sol::table table = sol().create_table();
+					for (const device_scheduler::device_stats &stats : sched.device_statistics())
+					{
+						sol::table entry = sol().create_table();
+						entry["timeslices"] = stats.timeslices;
+						entry["cycles"] = stats.cycles;
+						entry["aborts"] = stats.aborts;
+						entry["idle_skips"] = stats.idle_skips;
+						entry["idle_cycles"] = stats.idle_cycles;
+						table[stats.device->device().tag()] = entry;
+					}
+					return table;
+				},
+			"timers", [this](device_scheduler &sched) {
+					sol::table table = sol().create_table();
+					for (const device_scheduler::timer_stats &stats : sched.timer_statistics())
+					{
+						sol::table entry = sol().create_table();
+						entry["fired"] = stats.fired;
+						entry["host_seconds"] = double(stats.host_ticks) / double(osd_ticks_per_second());
+						table[stats.name] = entry;
+					}
+					return table;
+				},
+			"statistics", sol::property(&device_scheduler::statistics_enabled, &device_scheduler::set_statistics_enabled),
+			"elapsed", sol::property([](device_scheduler &sched) { return sched.statistics_elapsed().as_double(); }),
+			"timeslices", sol::property(&device_scheduler::statistics_timeslices),
+			"boosts", sol::property(&device_scheduler::statistics_boosts),
+			"boost_time", sol::property([](device_scheduler &sched) { return sched.statistics_boost_time().as_double(); }),
+			"timer_host_seconds", sol::property([](device_scheduler &sched) { return double(sched.statistics_timer_ticks()) / double(osd_ticks_per_second()); }));
+
 /* machine:video()
  * video:begin_recording([opt] filename) - start recording to filename if given or default
  * video:end_recording() - stop recording
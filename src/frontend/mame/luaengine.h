@@ -123,6 +123,9 @@ private:
 	void on_machine_pause();
 	void on_machine_resume();
 	void on_machine_frame();
+	void on_machine_save_complete();
+
+	void run_watches();
 
 	void resume(void *ptr, int nparam);
 	void register_function(sol::function func, const char *id);
@@ -138,6 +141,7 @@ private:
 		template<typename T> void log_mem_write(offs_t address, T val);
 		template<typename T> T direct_mem_read(offs_t address);
 		template<typename T> void direct_mem_write(offs_t address, T val);
+		u64 sized_read(offs_t address, int width);
 
 		address_space &space;
 		device_memory_interface &dev;
@@ -154,6 +158,26 @@ private:
 		unsigned int count;
 	};
 
+	// a set of addresses read natively at the end of each frame
+	struct frame_watch
+	{
+		address_space *space;
+		std::vector<offs_t> addresses;
+		int width;
+		sol::protected_function callback;
+		sol::table values;
+	};
+
+	// time spent in each kind of script callback
+	struct callback_stats
+	{
+		u64 calls;
+		osd_ticks_t ticks;
+	};
+
+	std::vector<frame_watch> m_watches;
+	std::map<std::string, callback_stats> m_callback_stats;
+
 	void close();
 
 	void run(sol::load_result res);
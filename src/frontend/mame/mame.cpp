@@ -301,6 +301,13 @@ void mame_machine_manager::ui_initialize(running_machine& machine)
 	m_ui->display_startup_screens(m_firstrun);
 }
 
+void mame_machine_manager::instance_started(running_machine& machine)
+{
+	// each instance gets its own go at the script, which can tell them apart with emu.instance()
+	if (strlen(options().fork_script()) != 0)
+		m_lua->load_script(options().fork_script());
+}
+
 void mame_machine_manager::create_custom(running_machine& machine)
 {
 	// start the inifile manager
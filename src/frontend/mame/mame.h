@@ -56,6 +56,8 @@ public:
 
 	virtual void ui_initialize(running_machine& machine) override;
 
+	virtual void instance_started(running_machine& machine) override;
+
 	/* execute as configured by the OPTION_SYSTEMNAME option on the specified options */
 	int execute();
 	void start_luaengine();
@@ -358,19 +358,48 @@ void media_identifier::match_hashes(std::vector<file_info> &info)
 		{
 			if (listnames.insert(swlistdev.list_name()).second)
 			{
-				for (software_info const &swinfo : swlistdev.get_info())
+				// files with a CRC can be looked up directly
+				bool scan = false;
+				for (file_info &file : info)
 				{
-					for (software_part const &part : swinfo.parts())
+					u32 crc;
+					if (file.hashes().crc(crc))
 					{
-						for (rom_entry const *region = part.romdata().data(); region; region = rom_next_region(region))
+						auto const found = swlistdev.find_by_crc(crc);
+						for (auto it = found.first; it != found.second; ++it)
 						{
-							for (rom_entry const *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
+							util::hash_collection romhashes(ROM_GETHASHDATA(it->second.rom));
+							if (!romhashes.flag(util::hash_collection::FLAG_NO_DUMP))
+								file.match(swlistdev.list_name(), *it->second.info, *it->second.rom, romhashes);
+						}
+					}
+					else
+					{
+						scan = true;
+					}
+				}
+
+				// anything else (e.g. CHDs, which only have SHA-1) needs a full scan
+				if (scan)
+				{
+					for (software_info const &swinfo : swlistdev.get_info())
+					{
+						for (software_part const &part : swinfo.parts())
+						{
+							for (rom_entry const *region = part.romdata().data(); region; region = rom_next_region(region))
 							{
-								util::hash_collection romhashes(ROM_GETHASHDATA(rom));
-								if (!romhashes.flag(util::hash_collection::FLAG_NO_DUMP))
+								for (rom_entry const *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
 								{
-									for (file_info &file : info)
-										file.match(swlistdev.list_name(), swinfo, *rom, romhashes);
+									util::hash_collection romhashes(ROM_GETHASHDATA(rom));
+									if (!romhashes.flag(util::hash_collection::FLAG_NO_DUMP))
+									{
+										for (file_info &file : info)
+										{
+											u32 crc;
+											if (!file.hashes().crc(crc))
+												file.match(swlistdev.list_name(), swinfo, *rom, romhashes);
+										}
+									}
 								}
 							}
 						}
@@ -187,38 +187,52 @@ void menu_audit::handle()
 
 void menu_audit::audit_fast()
 {
+	std::vector<std::size_t> drivers;
+	std::vector<ui_system_info *> targets(driver_list::total(), nullptr);
 	for (ui_system_info &info : m_availablesorted)
 	{
 		if (!info.available)
 		{
-			m_current.store(info.driver);
-			driver_enumerator enumerator(machine().options(), info.driver->name);
-			enumerator.next();
-			media_auditor auditor(enumerator);
-			media_auditor::summary const summary(auditor.audit_media(AUDIT_VALIDATE_FAST));
-			info.available = (summary == media_auditor::CORRECT) || (summary == media_auditor::BEST_AVAILABLE) || (summary == media_auditor::NONE_NEEDED);
-
-			// if everything looks good, include the driver
-			info.available = (summary == media_auditor::CORRECT) || (summary == media_auditor::BEST_AVAILABLE) || (summary == media_auditor::NONE_NEEDED);
-			++m_audited;
+			int const index(driver_list::find(*info.driver));
+			drivers.emplace_back(index);
+			targets[index] = &info;
 		}
 	}
+
+	parallel_media_auditor(machine().options()).audit_media(
+			drivers,
+			[this, &targets] (std::size_t driver, media_auditor &auditor, media_auditor::summary summary)
+			{
+				// if everything looks good, include the driver
+				m_current.store(&driver_list::driver(driver));
+				targets[driver]->available = (summary == media_auditor::CORRECT) || (summary == media_auditor::BEST_AVAILABLE) || (summary == media_auditor::NONE_NEEDED);
+				++m_audited;
+			},
+			AUDIT_VALIDATE_FAST);
 }
 
 void menu_audit::audit_all()
 {
-	m_availablesorted.clear();
+	std::vector<std::size_t> drivers;
 	driver_enumerator enumerator(machine().options());
-	media_auditor auditor(enumerator);
 	while (enumerator.next())
-	{
-		m_current.store(&enumerator.driver());
-		media_auditor::summary const summary(auditor.audit_media(AUDIT_VALIDATE_FAST));
+		drivers.emplace_back(enumerator.current());
 
-		// if everything looks good, include the driver
-		m_availablesorted.emplace_back(enumerator.driver(), (summary == media_auditor::CORRECT) || (summary == media_auditor::BEST_AVAILABLE) || (summary == media_auditor::NONE_NEEDED));
-		++m_audited;
-	}
+	std::vector<char> available(driver_list::total(), 0);
+	parallel_media_auditor(machine().options()).audit_media(
+			drivers,
+			[this, &available] (std::size_t driver, media_auditor &auditor, media_auditor::summary summary)
+			{
+				// if everything looks good, include the driver
+				m_current.store(&driver_list::driver(driver));
+				available[driver] = (summary == media_auditor::CORRECT) || (summary == media_auditor::BEST_AVAILABLE) || (summary == media_auditor::NONE_NEEDED);
+				++m_audited;
+			},
+			AUDIT_VALIDATE_FAST);
+
+	m_availablesorted.clear();
+	for (std::size_t driver : drivers)
+		m_availablesorted.emplace_back(driver_list::driver(driver), available[driver] != 0);
 
 	// sort
 	std::stable_sort(
@@ -31,6 +31,7 @@
 #include "uiinput.h"
 #include "luaengine.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iterator>
 
@@ -56,6 +57,9 @@ menu_select_game::menu_select_game(mame_ui_manager &mui, render_container &conta
 	// load drivers cache
 	init_sorted_list();
 
+	// build the search index while the rest of the menu loads
+	m_searchthread = std::thread([this] () { build_search_keys(); });
+
 	// check if there are available icons
 	ui_globals::has_icons = false;
 	file_enumerator path(moptions.icons_directory());
@@ -130,6 +134,9 @@ menu_select_game::menu_select_game(mame_ui_manager &mui, render_container &conta
 
 menu_select_game::~menu_select_game()
 {
+	if (m_searchthread.joinable())
+		m_searchthread.join();
+
 	std::string error_string, last_driver;
 	game_driver const *driver;
 	ui_software_info const *swinfo;
@@ -372,6 +379,8 @@ void menu_select_game::populate(float &customtop, float &custombottom)
 				m_displaylist = m_availsortedlist;
 			else
 				it->second->apply(m_availsortedlist.begin(), m_availsortedlist.end(), std::back_inserter(m_displaylist));
+			m_searchcandidates.clear();
+			m_searchquery.clear();
 
 			// iterate over entries
 			int curitem = 0;
@@ -791,36 +800,62 @@ void menu_select_game::change_info_pane(int delta)
 
 void menu_select_game::populate_search()
 {
-	// allocate memory to track the penalty value
-	std::vector<int> penalty(VISIBLE_GAMES_IN_SEARCH, 9999);
-	int index = 0;
-	for (; index < m_displaylist.size(); ++index)
-	{
-		// pick the best match between driver name and description
-		int curpenalty = fuzzy_substring(m_search, m_displaylist[index].driver->type.fullname());
-		int tmp = fuzzy_substring(m_search, m_displaylist[index].driver->name);
-		curpenalty = std::min(curpenalty, tmp);
+	// the index is normally ready long before the first key press
+	if (m_searchthread.joinable())
+		m_searchthread.join();
 
-		// insert into the sorted table of matches
-		for (int matchnum = VISIBLE_GAMES_IN_SEARCH - 1; matchnum >= 0; --matchnum)
-		{
-			// stop if we're worse than the current entry
-			if (curpenalty >= penalty[matchnum])
-				break;
+	std::string needle(m_search);
+	strmakelower(needle);
 
-			// as long as this isn't the last entry, bump this one down
-			if (matchnum < VISIBLE_GAMES_IN_SEARCH - 1)
+	// penalties never drop as the search string grows, so the last ones remain lower bounds when extending it
+	if (m_searchcandidates.empty())
+	{
+		m_searchcandidates.reserve(m_displaylist.size());
+		for (ui_system_info const &info : m_displaylist)
+			m_searchcandidates.push_back(search_candidate{ info.driver, &m_searchkeys[driver_list::find(*info.driver)], m_searchcandidates.size(), 0 });
+	}
+	else if (needle.compare(0, m_searchquery.size(), m_searchquery))
+	{
+		for (search_candidate &candidate : m_searchcandidates)
+			candidate.penalty = 0;
+	}
+	m_searchquery = needle;
+
+	// visit the most promising candidates first, falling back to display order
+	auto const better(
+			[] (search_candidate const *a, search_candidate const *b)
 			{
-				penalty[matchnum + 1] = penalty[matchnum];
-				m_searchlist[matchnum + 1] = m_searchlist[matchnum];
-			}
+				return (a->penalty < b->penalty) || ((a->penalty == b->penalty) && (a->position < b->position));
+			});
+	std::sort(
+			m_searchcandidates.begin(),
+			m_searchcandidates.end(),
+			[&better] (search_candidate const &a, search_candidate const &b) { return better(&a, &b); });
+
+	std::vector<search_candidate *> matches;
+	matches.reserve(VISIBLE_GAMES_IN_SEARCH + 1);
+	for (search_candidate &candidate : m_searchcandidates)
+	{
+		// stop once nothing left can displace the worst match
+		if ((matches.size() == VISIBLE_GAMES_IN_SEARCH) && (candidate.penalty > matches.back()->penalty))
+			break;
 
-			m_searchlist[matchnum] = m_displaylist[index].driver;
-			penalty[matchnum] = curpenalty;
-		}
+		// pick the best match between description, driver name, manufacturer and year
+		if (candidate.key->info.find(needle) != std::string::npos)
+			candidate.penalty = 0;
+		else
+			candidate.penalty = std::min(fuzzy_substring_lower(needle, candidate.key->description), fuzzy_substring_lower(needle, candidate.key->name));
+
+		// insert into the sorted table of matches
+		matches.insert(std::upper_bound(matches.begin(), matches.end(), &candidate, better), &candidate);
+		if (matches.size() > VISIBLE_GAMES_IN_SEARCH)
+			matches.pop_back();
 	}
 
-	(index < VISIBLE_GAMES_IN_SEARCH) ? m_searchlist[index] = nullptr : m_searchlist[VISIBLE_GAMES_IN_SEARCH] = nullptr;
+	for (std::size_t index = 0; index < matches.size(); ++index)
+		m_searchlist[index] = matches[index]->driver;
+	m_searchlist[matches.size()] = nullptr;
+
 	uint32_t flags_ui = FLAG_LEFT_ARROW | FLAG_RIGHT_ARROW;
 	for (int curitem = 0; m_searchlist[curitem]; ++curitem)
 	{
@@ -836,6 +871,26 @@ void menu_select_game::populate_search()
 	}
 }
 
+//-------------------------------------------------
+//  build lowercased search text for all systems
+//-------------------------------------------------
+
+void menu_select_game::build_search_keys()
+{
+	m_searchkeys.resize(driver_list::total());
+	for (std::size_t index = 0; index < m_searchkeys.size(); ++index)
+	{
+		game_driver const &driver(driver_list::driver(index));
+		search_key &key(m_searchkeys[index]);
+		key.description = driver.type.fullname();
+		key.name = driver.name;
+		key.info = std::string(driver.manufacturer) + ' ' + driver.year;
+		strmakelower(key.description);
+		strmakelower(key.name);
+		strmakelower(key.info);
+	}
+}
+
 //-------------------------------------------------
 //  generate general info
 //-------------------------------------------------
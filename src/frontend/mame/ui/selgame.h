@@ -15,6 +15,8 @@
 #include "ui/selmenu.h"
 #include "ui/utils.h"
 
+#include <thread>
+
 
 class media_auditor;
 
@@ -47,6 +49,28 @@ private:
 
 	const game_driver *m_searchlist[VISIBLE_GAMES_IN_SEARCH + 1];
 
+	// lowercased text matched against the search string, indexed like driver_list
+	struct search_key
+	{
+		std::string description;
+		std::string name;
+		std::string info;       // manufacturer and year
+	};
+
+	// display list entry with a lower bound on its penalty for m_searchquery
+	struct search_candidate
+	{
+		game_driver const *driver;
+		search_key const *key;
+		std::size_t position;
+		int penalty;
+	};
+
+	std::thread m_searchthread;
+	std::vector<search_key> m_searchkeys;
+	std::vector<search_candidate> m_searchcandidates;
+	std::string m_searchquery;
+
 	virtual void populate(float &customtop, float &custombottom) override;
 	virtual void handle() override;
 
@@ -75,6 +99,7 @@ private:
 
 	bool isfavorite() const;
 	void populate_search();
+	void build_search_keys();
 	void init_sorted_list();
 	bool load_available_machines();
 	void load_custom_filters();
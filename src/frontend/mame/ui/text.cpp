@@ -82,11 +82,13 @@ CORE IMPLEMENTATION
 //  ctor
 //-------------------------------------------------
 
-text_layout::text_layout(render_font &font, float xscale, float yscale, float width, text_layout::text_justify justify, text_layout::word_wrapping wrap)
-	: m_font(font)
+text_layout::text_layout(render_font &font, float xscale, float yscale, float width, text_layout::text_justify justify, text_layout::word_wrapping wrap, frame_arena *arena)
+	: m_arena(arena)
+	, m_font(font)
 	, m_xscale(xscale), m_yscale(yscale)
 	, m_width(width)
 	, m_justify(justify), m_wrap(wrap)
+	, m_lines(frame_arena_allocator<std::unique_ptr<line, line_deleter>>(arena))
 	, m_current_line(nullptr), m_last_break(0), m_text_position(0), m_truncating(false)
 {
 	invalidate_calculated_actual_width();
@@ -98,7 +100,8 @@ text_layout::text_layout(render_font &font, float xscale, float yscale, float wi
 //-------------------------------------------------
 
 text_layout::text_layout(text_layout &&that)
-	: m_font(that.m_font)
+	: m_arena(that.m_arena)
+	, m_font(that.m_font)
 	, m_xscale(that.m_xscale), m_yscale(that.m_yscale)
 	, m_width(that.m_width), m_calculated_actual_width(that.m_calculated_actual_width)
 	, m_justify(that.m_justify), m_wrap(that.m_wrap)
@@ -295,7 +298,11 @@ float text_layout::actual_height() const
 void text_layout::start_new_line(text_layout::text_justify justify, float height)
 {
 	// create a new line
-	std::unique_ptr<line> new_line(global_alloc_clear<line>(*this, justify, actual_height(), height * yscale()));
+	std::unique_ptr<line, line_deleter> new_line(
+			m_arena
+				? new (m_arena->allocate(sizeof(line), alignof(line))) line(*this, justify, actual_height(), height * yscale(), m_arena)
+				: global_alloc_clear<line>(*this, justify, actual_height(), height * yscale(), m_arena),
+			line_deleter{ m_arena });
 
 	// update the current line
 	m_current_line = new_line.get();
@@ -514,8 +521,9 @@ void text_layout::emit(render_container &container, float x, float y)
 //  line::ctor
 //-------------------------------------------------
 
-text_layout::line::line(text_layout &layout, text_justify justify, float yoffset, float height)
-	: m_layout(layout), m_justify(justify), m_yoffset(yoffset), m_width(0.0), m_height(height)
+text_layout::line::line(text_layout &layout, text_justify justify, float yoffset, float height, frame_arena *arena)
+	: m_characters(frame_arena_allocator<positioned_char>(arena))
+	, m_layout(layout), m_justify(justify), m_yoffset(yoffset), m_width(0.0), m_height(height)
 {
 }
 
@@ -13,6 +13,7 @@
 #ifndef MAME_FRONTEND_UI_TEXT_H
 #define MAME_FRONTEND_UI_TEXT_H
 
+#include "emualloc.h"
 #include "palette.h"
 #include "unicode.h"
 
@@ -43,8 +44,8 @@ public:
 		WORD
 	};
 
-	// ctor/dtor
-	text_layout(render_font &font, float xscale, float yscale, float width, text_justify justify, word_wrapping wrap);
+	// ctor/dtor; a layout given an arena must not outlive the arena's next reset
+	text_layout(render_font &font, float xscale, float yscale, float width, text_justify justify, word_wrapping wrap, frame_arena *arena = nullptr);
 	text_layout(text_layout &&that);
 	~text_layout();
 
@@ -110,7 +111,7 @@ private:
 	class line
 	{
 	public:
-		line(text_layout &layout, text_justify justify, float yoffset, float height);
+		line(text_layout &layout, text_justify justify, float yoffset, float height, frame_arena *arena);
 
 		// methods
 		void add_character(char32_t ch, const char_style &style, const source_info &source);
@@ -127,7 +128,7 @@ private:
 		positioned_char &character(size_t index) { return m_characters[index]; }
 
 	private:
-		std::vector<positioned_char> m_characters;
+		std::vector<positioned_char, frame_arena_allocator<positioned_char>> m_characters;
 		text_layout &m_layout;
 		text_justify m_justify;
 		float m_yoffset;
@@ -135,7 +136,15 @@ private:
 		float m_height;
 	};
 
+	// lines live in the arena when there is one, so only run the destructor
+	struct line_deleter
+	{
+		frame_arena *arena;
+		void operator()(line *l) const { if (arena) l->~line(); else global_free(l); }
+	};
+
 	// instance variables
+	frame_arena *m_arena;
 	render_font &m_font;
 	float m_xscale;
 	float m_yscale;
@@ -143,7 +152,7 @@ private:
 	mutable float m_calculated_actual_width;
 	text_justify m_justify;
 	word_wrapping m_wrap;
-	std::vector<std::unique_ptr<line>> m_lines;
+	std::vector<std::unique_ptr<line, line_deleter>, frame_arena_allocator<std::unique_ptr<line, line_deleter>>> m_lines;
 	line *m_current_line;
 	size_t m_last_break;
 	size_t m_text_position;
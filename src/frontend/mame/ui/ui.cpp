@@ -395,6 +395,7 @@ void mame_ui_manager::update_and_render(render_container &container)
 {
 	// always start clean
 	container.empty();
+	m_frame_arena.reset();
 
 	// if we're paused, dim the whole screen
 	if (machine().phase() >= machine_phase::RESET && (single_step() || machine().paused()))
@@ -574,8 +575,11 @@ void mame_ui_manager::draw_text(render_container &container, const char *buf, fl
 
 void mame_ui_manager::draw_text_full(render_container &container, const char *origs, float x, float y, float origwrapwidth, ui::text_layout::text_justify justify, ui::text_layout::word_wrapping wrap, draw_mode draw, rgb_t fgcolor, rgb_t bgcolor, float *totalwidth, float *totalheight, float text_size)
 {
-	// create the layout
-	auto layout = create_layout(container, origwrapwidth, justify, wrap);
+	// create the layout; it's gone before we return, so it can live in the frame arena
+	float const yscale = get_line_height();
+	float const xscale = yscale * machine().render().ui_aspect(&container);
+	frame_arena *const arena = (m_frame_arena.used() < FRAME_ARENA_LIMIT) ? &m_frame_arena : nullptr;
+	ui::text_layout layout(*get_font(), xscale, yscale, origwrapwidth, justify, wrap, arena);
 
 	// append text to it
 	layout.add_text(
@@ -712,7 +716,8 @@ bool mame_ui_manager::show_fps_counter()
 void mame_ui_manager::set_show_profiler(bool show)
 {
 	m_show_profiler = show;
-	g_profiler.enable(show);
+	g_profiler.enable(show || *machine().options().profile_flamegraph());
+	machine().scheduler().set_statistics_enabled(show);
 }
 
 
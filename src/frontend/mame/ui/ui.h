@@ -234,6 +234,9 @@ public:
 	virtual void menu_reset() override;
 
 private:
+	// transient layouts stop using the arena past this size and go to the heap
+	static constexpr size_t FRAME_ARENA_LIMIT = 4 << 20;
+
 	// instance variables
 	render_font *           m_font;
 	std::function<uint32_t (render_container &)> m_handler_callback;
@@ -252,6 +255,7 @@ private:
 	ui_options              m_ui_options;
 
 	std::unique_ptr<ui::machine_info> m_machine_info;
+	frame_arena             m_frame_arena;          // scratch for layouts that die within a frame
 
 	// static variables
 	static std::string      messagebox_text;
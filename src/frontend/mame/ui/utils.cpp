@@ -1787,22 +1787,29 @@ std::vector<std::string> tokenize(const std::string &text, char sep)
 //-------------------------------------------------
 
 int fuzzy_substring(std::string s_needle, std::string s_haystack)
+{
+	strmakelower(s_needle);
+	strmakelower(s_haystack);
+	return fuzzy_substring_lower(s_needle, s_haystack);
+}
+
+//-------------------------------------------------
+//  as above, for strings already in lower case
+//-------------------------------------------------
+
+int fuzzy_substring_lower(std::string const &s_needle, std::string const &s_haystack)
 {
 	if (s_needle.empty())
 		return s_haystack.size();
 	if (s_haystack.empty())
 		return s_needle.size();
 
-	strmakelower(s_needle);
-	strmakelower(s_haystack);
-
-	if (s_needle == s_haystack)
-		return 0;
 	if (s_haystack.find(s_needle) != std::string::npos)
 		return 0;
 
-	auto *row1 = global_alloc_array_clear<int>(s_haystack.size() + 2);
-	auto *row2 = global_alloc_array_clear<int>(s_haystack.size() + 2);
+	std::vector<int> rows((s_haystack.size() + 2) * 2, 0);
+	int *row1 = &rows[0];
+	int *row2 = row1 + s_haystack.size() + 2;
 
 	for (int i = 0; i < s_needle.size(); ++i)
 	{
@@ -1826,11 +1833,7 @@ int fuzzy_substring(std::string s_needle, std::string s_haystack)
 		if (*first < *smallest)
 			smallest = first;
 
-	int rv = *smallest;
-	global_free_array(row1);
-	global_free_array(row2);
-
-	return rv;
+	return *smallest;
 }
 
 //-------------------------------------------------
@@ -354,6 +354,7 @@ struct main_filters
 
 // GLOBAL FUNCTIONS
 int fuzzy_substring(std::string needle, std::string haystack);
+int fuzzy_substring_lower(std::string const &needle, std::string const &haystack);
 char* chartrimcarriage(char str[]);
 const char* strensure(const char* s);
 int getprecisionchr(const char* s);
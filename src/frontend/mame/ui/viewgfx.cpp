@@ -1125,7 +1125,7 @@ static void tilemap_handler(mame_ui_manager &mui, render_container &container, u
 							int(gfxnum), code, color);
 	}
 	else
-		util::stream_format(title_buf, " %dx%d OFFS %d,%d", tilemap->width(), tilemap->height(), state.tilemap.xoffs, state.tilemap.yoffs);
+		util::stream_format(title_buf, " %dx%d OFFS %d,%d UPD %d", tilemap->width(), tilemap->height(), state.tilemap.xoffs, state.tilemap.yoffs, tilemap->tiles_updated());
 
 	if (state.tilemap.flags != TILEMAP_DRAW_ALL_CATEGORIES)
 		util::stream_format(title_buf, " CAT %d", state.tilemap.flags);
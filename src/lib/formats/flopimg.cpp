@@ -900,6 +900,10 @@ floppy_image::floppy_image(int _tracks, int _heads, uint32_t _form_factor)
 	form_factor = _form_factor;
 	variant = 0;
 
+	deferred_loading = false;
+	use_count = 0;
+	cached_tracks = 0;
+
 	track_array.resize(tracks*4+1);
 	for(int i=0; i<tracks*4+1; i++)
 		track_array[i].resize(heads);
@@ -909,6 +913,73 @@ floppy_image::~floppy_image()
 {
 }
 
+void floppy_image::defer_track(int track, int head, int subtrack)
+{
+	assert(track < tracks && head < heads && tsource);
+	track_info &info = track_array[track*4+subtrack][head];
+	info.cell_data.clear();
+	info.write_splice = 0;
+	info.state = TRACK_PENDING;
+	info.dirty = false;
+}
+
+void floppy_image::load_track(int track, int head, int subtrack)
+{
+	// Make room by dropping the least recently used clean track, it
+	// can be generated again if needed
+	if(cached_tracks >= TRACK_CACHE_SIZE) {
+		track_info *victim = nullptr;
+		for(auto &t : track_array)
+			for(auto &h : t)
+				if(h.state == TRACK_CACHED && !h.dirty && (!victim || h.last_use < victim->last_use))
+					victim = &h;
+		if(victim) {
+			std::vector<uint32_t>().swap(victim->cell_data);
+			victim->write_splice = 0;
+			victim->state = TRACK_PENDING;
+			cached_tracks--;
+		}
+	}
+
+	track_info &info = track_array[track*4+subtrack][head];
+	info.state = TRACK_CACHED;
+	info.last_use = ++use_count;
+	cached_tracks++;
+	tsource->generate(this, track, head, subtrack);
+}
+
+void floppy_image::load_all_tracks()
+{
+	if(!tsource)
+		return;
+	// Pin everything first so that nothing gets evicted on the way
+	for(auto &t : track_array)
+		for(auto &h : t)
+			if(h.state == TRACK_CACHED)
+				h.state = TRACK_RESIDENT;
+	cached_tracks = 0;
+
+	for(int i=0; i<tracks*4+1; i++)
+		for(int j=0; j<heads; j++) {
+			track_info &info = track_array[i][j];
+			if(info.state == TRACK_PENDING) {
+				info.state = TRACK_RESIDENT;
+				tsource->generate(this, i >> 2, j, i & 3);
+			}
+		}
+	tsource.reset();
+}
+
+bool floppy_image::write_back_tracks()
+{
+	if(!tsource || !tsource->write_back(this))
+		return false;
+	for(auto &t : track_array)
+		for(auto &h : t)
+			h.dirty = false;
+	return true;
+}
+
 void floppy_image::get_maximal_geometry(int &_tracks, int &_heads) const
 {
 	_tracks = tracks;
@@ -921,7 +992,7 @@ void floppy_image::get_actual_geometry(int &_tracks, int &_heads)
 
 	while(maxt >= 0) {
 		for(int i=0; i<=maxh; i++)
-			if(!track_array[maxt][i].cell_data.empty())
+			if(track_present(maxt, i))
 				goto track_done;
 		maxt--;
 	}
@@ -929,7 +1000,7 @@ void floppy_image::get_actual_geometry(int &_tracks, int &_heads)
 	if(maxt >= 0)
 		while(maxh >= 0) {
 			for(int i=0; i<=maxt; i++)
-				if(!track_array[i][maxh].cell_data.empty())
+				if(track_present(i, maxh))
 					goto head_done;
 			maxh--;
 		}
@@ -943,7 +1014,7 @@ int floppy_image::get_resolution() const
 	int mask = 0;
 	for(int i=0; i<=(tracks-1)*4; i++)
 		for(int j=0; j<heads; j++)
-			if(!track_array[i][j].cell_data.empty())
+			if(track_present(i, j))
 				mask |= 1 << (i & 3);
 	if(mask & 0xa)
 		return 2;
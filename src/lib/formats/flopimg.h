@@ -16,6 +16,8 @@
 #include "opresolv.h"
 #include "coretmpl.h"
 
+#include <memory>
+
 #ifndef LOG_FORMATS
 #define LOG_FORMATS if (0) printf
 #endif
@@ -710,6 +712,25 @@ public:
 		M2FM = 0x4D32464D  //!< "M2FM", modified modified frequency modulation
 	};
 
+	//! Source of tracks that are generated on first access rather
+	//! than when the image is loaded.
+	class track_source
+	{
+	public:
+		virtual ~track_source() = default;
+
+		//! Generate a track into the image through get_buffer().
+		virtual void generate(floppy_image *image, int track, int head, int subtrack) = 0;
+
+		//! Write the modified tracks back to the file the tracks
+		//! come from, in place.
+		//! @return true on success, false if the whole image must be saved instead.
+		virtual bool write_back(floppy_image *image) { return false; }
+	};
+
+	//! Number of generated tracks kept when tracks come from a track_source
+	enum { TRACK_CACHE_SIZE = 32 };
+
 	// construction/destruction
 
 
@@ -735,7 +756,39 @@ public:
 	  @param head head number
 	  @return a pointer to the data buffer for this track and head
 	*/
-	std::vector<uint32_t> &get_buffer(int track, int head, int subtrack = 0) { assert(track < tracks && head < heads); return track_array[track*4+subtrack][head].cell_data; }
+	std::vector<uint32_t> &get_buffer(int track, int head, int subtrack = 0) {
+		assert(track < tracks && head < heads);
+		track_info &info = track_array[track*4+subtrack][head];
+		if(info.state == TRACK_PENDING)
+			load_track(track, head, subtrack);
+		else
+			info.last_use = ++use_count;
+		return info.cell_data;
+	}
+
+	//! Allow formats to defer track generation with set_track_source().
+	//! Only worth it when the image source stays readable for the
+	//! lifetime of the floppy_image, as it does for a mounted image.
+	void enable_deferred_loading() { deferred_loading = true; }
+	//! @return true if formats may defer track generation.
+	bool deferred_loading_enabled() const { return deferred_loading; }
+
+	//! Install the source for deferred tracks, replacing any previous one.
+	void set_track_source(std::unique_ptr<track_source> &&source) { tsource = std::move(source); }
+	//! @return true if some tracks come from a track source.
+	bool has_track_source() const { return bool(tsource); }
+	//! Mark a track as generated by the track source on first access.
+	void defer_track(int track, int head, int subtrack = 0);
+	//! Generate every deferred track and drop the track source.
+	void load_all_tracks();
+
+	//! Note that a track was modified, so it is kept in memory until written back.
+	void mark_track_dirty(int track, int head, int subtrack = 0) { assert(track < tracks && head < heads); track_array[track*4+subtrack][head].dirty = true; }
+	//! @return true if the track was modified since the last write back.
+	bool track_is_dirty(int track, int head, int subtrack = 0) const { assert(track < tracks && head < heads); return track_array[track*4+subtrack][head].dirty; }
+	//! Write back modified tracks through the track source.
+	//! @return true on success, false if the whole image must be saved instead.
+	bool write_back_tracks();
 
 	//! Sets the write splice position.
 	//! The "track splice" information indicates where to start writing
@@ -768,6 +821,12 @@ public:
 	static const char *get_variant_name(uint32_t form_factor, uint32_t variant);
 
 private:
+	enum {
+		TRACK_RESIDENT, //!< Track data lives in cell_data for good
+		TRACK_PENDING,  //!< Track will be generated on first access
+		TRACK_CACHED    //!< Track was generated and may be dropped again when clean
+	};
+
 	int tracks, heads;
 
 	uint32_t form_factor, variant;
@@ -775,13 +834,24 @@ private:
 	struct track_info {
 		std::vector<uint32_t> cell_data;
 		uint32_t write_splice;
+		uint64_t last_use;
+		uint8_t state;
+		bool dirty;
 
-		track_info() { write_splice = 0; }
+		track_info() { write_splice = 0; last_use = 0; state = TRACK_RESIDENT; dirty = false; }
 	};
 
 	// track number multiplied by 4 then head
 	// last array size may be bigger than actual track size
 	std::vector<std::vector<track_info> > track_array;
+
+	bool deferred_loading;
+	std::unique_ptr<track_source> tsource;
+	uint64_t use_count;
+	int cached_tracks;
+
+	void load_track(int track, int head, int subtrack);
+	bool track_present(int track, int head) const { return !track_array[track][head].cell_data.empty() || track_array[track][head].state == TRACK_PENDING; }
 };
 
 #endif /* FLOPIMG_H */
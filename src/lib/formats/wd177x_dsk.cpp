@@ -206,25 +206,73 @@ bool wd177x_format::load(io_generic *io, uint32_t form_factor, floppy_image *ima
 	desc[end_gap_index + 1].p2 = remaining_size & 15;
 	desc[end_gap_index + 1].p1 >>= 16-(remaining_size & 15);
 
-	int track_size = compute_track_size(f);
+	if(image->deferred_loading_enabled()) {
+		// Generate each track when the drive first gets to it
+		image->set_track_source(std::make_unique<deferred_tracks>(*this, *io, f, desc, total_size));
+		for(int track=0; track < f.track_count; track++)
+			for(int head=0; head < f.head_count; head++)
+				image->defer_track(track, head);
+	} else {
+		for(int track=0; track < f.track_count; track++)
+			for(int head=0; head < f.head_count; head++)
+				load_track(io, f, desc, total_size, track, head, image);
+	}
+
+	image->set_variant(f.variant);
 
+	return true;
+}
+
+void wd177x_format::load_track(io_generic *io, const format &f, desc_e *desc, int total_size, int track, int head, floppy_image *image)
+{
 	uint8_t sectdata[40*512];
 	desc_s sectors[40];
 
-	for(int track=0; track < f.track_count; track++)
-		for(int head=0; head < f.head_count; head++) {
-			if (f.encoding == floppy_image::FM)
-				desc[14].p1 = get_track_dam_fm(f, head, track);
-			else
-				desc[16].p1 = get_track_dam_mfm(f, head, track);
-
-			build_sector_description(f, sectdata, sectors, track, head);
-			io_generic_read(io, sectdata, get_image_offset(f, head, track), track_size);
-			generate_track(desc, track, head, sectors, f.sector_count, total_size, image);
-		}
+	if (f.encoding == floppy_image::FM)
+		desc[14].p1 = get_track_dam_fm(f, head, track);
+	else
+		desc[16].p1 = get_track_dam_mfm(f, head, track);
 
-	image->set_variant(f.variant);
+	build_sector_description(f, sectdata, sectors, track, head);
+	io_generic_read(io, sectdata, get_image_offset(f, head, track), compute_track_size(f));
+	generate_track(desc, track, head, sectors, f.sector_count, total_size, image);
+}
+
+void wd177x_format::save_track(io_generic *io, const format &f, int track, int head, floppy_image *image)
+{
+	uint8_t sectdata[40*512];
+	desc_s sectors[40];
 
+	build_sector_description(f, sectdata, sectors, track, head);
+	extract_sectors(image, f, sectors, track, head);
+	io_generic_write(io, sectdata, get_image_offset(f, head, track), compute_track_size(f));
+}
+
+/*
+    Deferred track source.  The description is copied since the one
+    returned by get_desc_fm/get_desc_mfm is shared between images.
+    Modified tracks are written back in place, the layout being fixed.
+*/
+wd177x_format::deferred_tracks::deferred_tracks(wd177x_format &format, const io_generic &io, const wd177x_format::format &f, const desc_e *desc, int total_size)
+	: m_format(format), m_io(io), m_f(f), m_total_size(total_size)
+{
+	do
+		m_desc.push_back(*desc);
+	while((desc++)->type != END);
+}
+
+void wd177x_format::deferred_tracks::generate(floppy_image *image, int track, int head, int subtrack)
+{
+	if(subtrack == 0)
+		m_format.load_track(&m_io, m_f, &m_desc[0], m_total_size, track, head, image);
+}
+
+bool wd177x_format::deferred_tracks::write_back(floppy_image *image)
+{
+	for(int track=0; track < m_f.track_count; track++)
+		for(int head=0; head < m_f.head_count; head++)
+			if(image->track_is_dirty(track, head))
+				m_format.save_track(&m_io, m_f, track, head, image);
 	return true;
 }
 
@@ -336,17 +384,10 @@ bool wd177x_format::save(io_generic *io, floppy_image *image)
 
 
 	const format &f = formats[chosen_candidate];
-	int track_size = compute_track_size(f);
-
-	uint8_t sectdata[40*512];
-	desc_s sectors[40];
 
 	for(int track=0; track < f.track_count; track++)
-		for(int head=0; head < f.head_count; head++) {
-			build_sector_description(f, sectdata, sectors, track, head);
-			extract_sectors(image, f, sectors, track, head);
-			io_generic_write(io, sectdata, get_image_offset(f, head, track), track_size);
-		}
+		for(int head=0; head < f.head_count; head++)
+			save_track(io, f, track, head, image);
 
 	return true;
 }
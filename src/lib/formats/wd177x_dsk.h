@@ -58,6 +58,24 @@ protected:
 	virtual void build_sector_description(const format &d, uint8_t *sectdata, desc_s *sectors, int track, int head) const;
 	void check_compatibility(floppy_image *image, std::vector<int> &candidates);
 	void extract_sectors(floppy_image *image, const format &f, desc_s *sdesc, int track, int head);
+	void load_track(io_generic *io, const format &f, desc_e *desc, int total_size, int track, int head, floppy_image *image);
+	void save_track(io_generic *io, const format &f, int track, int head, floppy_image *image);
+
+	class deferred_tracks : public floppy_image::track_source
+	{
+	public:
+		deferred_tracks(wd177x_format &format, const io_generic &io, const wd177x_format::format &f, const desc_e *desc, int total_size);
+
+		virtual void generate(floppy_image *image, int track, int head, int subtrack) override;
+		virtual bool write_back(floppy_image *image) override;
+
+	private:
+		wd177x_format &m_format;
+		io_generic m_io;
+		const wd177x_format::format &m_f;
+		std::vector<desc_e> m_desc;
+		int m_total_size;
+	};
 };
 
 #endif /* WD177X_DSK_H */
@@ -28,6 +28,7 @@ namespace netlist
 	{
 		NETLIB_CONSTRUCTOR(netlistparams)
 		, m_use_deactivate(*this, "USE_DEACTIVATE", 0)
+		, m_tt_merge(*this, "TT_MERGE", 0)     // merge truthtable clusters with up to this many inputs, 0 = off
 		{
 		}
 		NETLIB_UPDATEI() { }
@@ -35,6 +36,7 @@ namespace netlist
 		//NETLIB_UPDATE_PARAMI() { }
 	public:
 		param_logic_t m_use_deactivate;
+		param_int_t m_tt_merge;
 	};
 
 	// -----------------------------------------------------------------------------
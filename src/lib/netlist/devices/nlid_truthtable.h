@@ -107,6 +107,22 @@ namespace netlist
 			for (auto &q : m_Q)
 				if (q.has_net() && q.net().num_cons() > 0)
 					m_active++;
+			/* nothing listens: sleep for good. With m_ign clear the
+			 * start-up update won't wake the inputs either.
+			 */
+			if (m_active == 0 && m_NI >= m_min_devices_for_deactivate && this->get_hint_deactivate())
+				for (auto &i : m_I)
+					i.inactivate();
+		}
+
+		bool deactivate_is_free() override
+		{
+			if (m_NI < m_min_devices_for_deactivate)
+				return false;
+			for (auto &q : m_Q)
+				if (q.has_net() && q.net().num_cons() > 0)
+					return false;
+			return true;
 		}
 
 		NETLIB_UPDATEI()
@@ -0,0 +1,1142 @@
+// generated by "nltool -c static" - do not edit
+#include "netlist/plib/pdynlib.h"
+
+/* solver doesn't support static compile */
+
+extern "C" void nl_gcr_174c06bf71ec1512_29(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+
+{
+
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+double m_A19 = m_A[19];
+double m_A20 = m_A[20];
+double m_A21 = m_A[21];
+double m_A22 = m_A[22];
+double m_A23 = m_A[23];
+double m_A24 = m_A[24];
+double m_A25 = m_A[25];
+double m_A26 = m_A[26];
+double m_A27 = m_A[27];
+double m_A28 = m_A[28];
+const double f0 = 1.0 / m_A0;
+	const double f0_1 = -f0 * m_A2;
+	m_A3 += m_A1 * f0_1;
+	RHS[1] += f0_1 * RHS[0];
+const double f1 = 1.0 / m_A3;
+	const double f1_2 = -f1 * m_A5;
+	m_A7 += m_A4 * f1_2;
+	RHS[2] += f1_2 * RHS[1];
+	const double f1_3 = -f1 * m_A8;
+	m_A10 += m_A4 * f1_3;
+	RHS[3] += f1_3 * RHS[1];
+const double f2 = 1.0 / m_A6;
+	const double f2_3 = -f2 * m_A9;
+	m_A10 += m_A7 * f2_3;
+	RHS[3] += f2_3 * RHS[2];
+const double f3 = 1.0 / m_A10;
+	const double f3_4 = -f3 * m_A12;
+	m_A13 += m_A11 * f3_4;
+	RHS[4] += f3_4 * RHS[3];
+const double f4 = 1.0 / m_A13;
+	const double f4_8 = -f4 * m_A25;
+	m_A28 += m_A14 * f4_8;
+	RHS[8] += f4_8 * RHS[4];
+const double f5 = 1.0 / m_A15;
+	const double f5_7 = -f5 * m_A21;
+	m_A22 += m_A16 * f5_7;
+	m_A23 += m_A17 * f5_7;
+	RHS[7] += f5_7 * RHS[5];
+const double f6 = 1.0 / m_A18;
+	const double f6_7 = -f6 * m_A22;
+	m_A23 += m_A19 * f6_7;
+	m_A24 += m_A20 * f6_7;
+	RHS[7] += f6_7 * RHS[6];
+	const double f6_8 = -f6 * m_A26;
+	m_A27 += m_A19 * f6_8;
+	m_A28 += m_A20 * f6_8;
+	RHS[8] += f6_8 * RHS[6];
+const double f7 = 1.0 / m_A23;
+	const double f7_8 = -f7 * m_A27;
+	m_A28 += m_A24 * f7_8;
+	RHS[8] += f7_8 * RHS[7];
+	V[8] = RHS[8] / m_A28;
+	double tmp7 = 0.0;
+	tmp7 += m_A24 * V[8];
+	V[7] = (RHS[7] - tmp7) / m_A23;
+	double tmp6 = 0.0;
+	tmp6 += m_A19 * V[7];
+	tmp6 += m_A20 * V[8];
+	V[6] = (RHS[6] - tmp6) / m_A18;
+	double tmp5 = 0.0;
+	tmp5 += m_A16 * V[6];
+	tmp5 += m_A17 * V[7];
+	V[5] = (RHS[5] - tmp5) / m_A15;
+	double tmp4 = 0.0;
+	tmp4 += m_A14 * V[8];
+	V[4] = (RHS[4] - tmp4) / m_A13;
+	double tmp3 = 0.0;
+	tmp3 += m_A11 * V[4];
+	V[3] = (RHS[3] - tmp3) / m_A10;
+	double tmp2 = 0.0;
+	tmp2 += m_A7 * V[3];
+	V[2] = (RHS[2] - tmp2) / m_A6;
+	double tmp1 = 0.0;
+	tmp1 += m_A4 * V[3];
+	V[1] = (RHS[1] - tmp1) / m_A3;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[1];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+extern "C" void nl_gcr_197479fc90048992_22(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+
+{
+
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+double m_A19 = m_A[19];
+double m_A20 = m_A[20];
+double m_A21 = m_A[21];
+const double f0 = 1.0 / m_A0;
+	const double f0_7 = -f0 * m_A16;
+	m_A21 += m_A1 * f0_7;
+	RHS[7] += f0_7 * RHS[0];
+const double f1 = 1.0 / m_A2;
+	const double f1_7 = -f1 * m_A17;
+	m_A21 += m_A3 * f1_7;
+	RHS[7] += f1_7 * RHS[1];
+const double f2 = 1.0 / m_A4;
+	const double f2_7 = -f2 * m_A18;
+	m_A21 += m_A5 * f2_7;
+	RHS[7] += f2_7 * RHS[2];
+const double f3 = 1.0 / m_A6;
+	const double f3_7 = -f3 * m_A19;
+	m_A21 += m_A7 * f3_7;
+	RHS[7] += f3_7 * RHS[3];
+const double f4 = 1.0 / m_A8;
+	const double f4_5 = -f4 * m_A10;
+	m_A11 += m_A9 * f4_5;
+	RHS[5] += f4_5 * RHS[4];
+const double f5 = 1.0 / m_A11;
+	const double f5_6 = -f5 * m_A13;
+	m_A14 += m_A12 * f5_6;
+	RHS[6] += f5_6 * RHS[5];
+const double f6 = 1.0 / m_A14;
+	const double f6_7 = -f6 * m_A20;
+	m_A21 += m_A15 * f6_7;
+	RHS[7] += f6_7 * RHS[6];
+	V[7] = RHS[7] / m_A21;
+	double tmp6 = 0.0;
+	tmp6 += m_A15 * V[7];
+	V[6] = (RHS[6] - tmp6) / m_A14;
+	double tmp5 = 0.0;
+	tmp5 += m_A12 * V[6];
+	V[5] = (RHS[5] - tmp5) / m_A11;
+	double tmp4 = 0.0;
+	tmp4 += m_A9 * V[5];
+	V[4] = (RHS[4] - tmp4) / m_A8;
+	double tmp3 = 0.0;
+	tmp3 += m_A7 * V[7];
+	V[3] = (RHS[3] - tmp3) / m_A6;
+	double tmp2 = 0.0;
+	tmp2 += m_A5 * V[7];
+	V[2] = (RHS[2] - tmp2) / m_A4;
+	double tmp1 = 0.0;
+	tmp1 += m_A3 * V[7];
+	V[1] = (RHS[1] - tmp1) / m_A2;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[7];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+extern "C" void nl_gcr_4db4829abfb8425e_160(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+
+{
+
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+double m_A19 = m_A[19];
+double m_A20 = m_A[20];
+double m_A21 = m_A[21];
+double m_A22 = m_A[22];
+double m_A23 = m_A[23];
+double m_A24 = m_A[24];
+double m_A25 = m_A[25];
+double m_A26 = m_A[26];
+double m_A27 = m_A[27];
+double m_A28 = m_A[28];
+double m_A29 = m_A[29];
+double m_A30 = m_A[30];
+double m_A31 = m_A[31];
+double m_A32 = m_A[32];
+double m_A33 = m_A[33];
+double m_A34 = m_A[34];
+double m_A35 = m_A[35];
+double m_A36 = m_A[36];
+double m_A37 = m_A[37];
+double m_A38 = m_A[38];
+double m_A39 = m_A[39];
+double m_A40 = m_A[40];
+double m_A41 = m_A[41];
+double m_A42 = m_A[42];
+double m_A43 = m_A[43];
+double m_A44 = m_A[44];
+double m_A45 = m_A[45];
+double m_A46 = m_A[46];
+double m_A47 = m_A[47];
+double m_A48 = m_A[48];
+double m_A49 = m_A[49];
+double m_A50 = m_A[50];
+double m_A51 = m_A[51];
+double m_A52 = m_A[52];
+double m_A53 = m_A[53];
+double m_A54 = m_A[54];
+double m_A55 = m_A[55];
+double m_A56 = m_A[56];
+double m_A57 = m_A[57];
+double m_A58 = m_A[58];
+double m_A59 = m_A[59];
+double m_A60 = m_A[60];
+double m_A61 = m_A[61];
+double m_A62 = m_A[62];
+double m_A63 = m_A[63];
+double m_A64 = m_A[64];
+double m_A65 = m_A[65];
+double m_A66 = m_A[66];
+double m_A67 = m_A[67];
+double m_A68 = m_A[68];
+double m_A69 = m_A[69];
+double m_A70 = m_A[70];
+double m_A71 = m_A[71];
+double m_A72 = m_A[72];
+double m_A73 = m_A[73];
+double m_A74 = m_A[74];
+double m_A75 = m_A[75];
+double m_A76 = m_A[76];
+double m_A77 = m_A[77];
+double m_A78 = m_A[78];
+double m_A79 = m_A[79];
+double m_A80 = m_A[80];
+double m_A81 = m_A[81];
+double m_A82 = m_A[82];
+double m_A83 = m_A[83];
+double m_A84 = m_A[84];
+double m_A85 = m_A[85];
+double m_A86 = m_A[86];
+double m_A87 = m_A[87];
+double m_A88 = m_A[88];
+double m_A89 = m_A[89];
+double m_A90 = m_A[90];
+double m_A91 = m_A[91];
+double m_A92 = m_A[92];
+double m_A93 = m_A[93];
+double m_A94 = m_A[94];
+double m_A95 = m_A[95];
+double m_A96 = m_A[96];
+double m_A97 = m_A[97];
+double m_A98 = m_A[98];
+double m_A99 = m_A[99];
+double m_A100 = m_A[100];
+double m_A101 = m_A[101];
+double m_A102 = m_A[102];
+double m_A103 = m_A[103];
+double m_A104 = m_A[104];
+double m_A105 = m_A[105];
+double m_A106 = m_A[106];
+double m_A107 = m_A[107];
+double m_A108 = m_A[108];
+double m_A109 = m_A[109];
+double m_A110 = m_A[110];
+double m_A111 = m_A[111];
+double m_A112 = m_A[112];
+double m_A113 = m_A[113];
+double m_A114 = m_A[114];
+double m_A115 = m_A[115];
+double m_A116 = m_A[116];
+double m_A117 = m_A[117];
+double m_A118 = m_A[118];
+double m_A119 = m_A[119];
+double m_A120 = m_A[120];
+double m_A121 = m_A[121];
+double m_A122 = m_A[122];
+double m_A123 = m_A[123];
+double m_A124 = m_A[124];
+double m_A125 = m_A[125];
+double m_A126 = m_A[126];
+double m_A127 = m_A[127];
+double m_A128 = m_A[128];
+double m_A129 = m_A[129];
+double m_A130 = m_A[130];
+double m_A131 = m_A[131];
+double m_A132 = m_A[132];
+double m_A133 = m_A[133];
+double m_A134 = m_A[134];
+double m_A135 = m_A[135];
+double m_A136 = m_A[136];
+double m_A137 = m_A[137];
+double m_A138 = m_A[138];
+double m_A139 = m_A[139];
+double m_A140 = m_A[140];
+double m_A141 = m_A[141];
+double m_A142 = m_A[142];
+double m_A143 = m_A[143];
+double m_A144 = m_A[144];
+double m_A145 = m_A[145];
+double m_A146 = m_A[146];
+double m_A147 = m_A[147];
+double m_A148 = m_A[148];
+double m_A149 = m_A[149];
+double m_A150 = m_A[150];
+double m_A151 = m_A[151];
+double m_A152 = m_A[152];
+double m_A153 = m_A[153];
+double m_A154 = m_A[154];
+double m_A155 = m_A[155];
+double m_A156 = m_A[156];
+double m_A157 = m_A[157];
+double m_A158 = m_A[158];
+double m_A159 = m_A[159];
+const double f0 = 1.0 / m_A0;
+	const double f0_35 = -f0 * m_A105;
+	m_A106 += m_A1 * f0_35;
+	RHS[35] += f0_35 * RHS[0];
+const double f1 = 1.0 / m_A2;
+	const double f1_37 = -f1 * m_A112;
+	m_A115 += m_A3 * f1_37;
+	RHS[37] += f1_37 * RHS[1];
+const double f2 = 1.0 / m_A4;
+	const double f2_15 = -f2 * m_A38;
+	m_A39 += m_A5 * f2_15;
+	RHS[15] += f2_15 * RHS[2];
+const double f3 = 1.0 / m_A6;
+	const double f3_7 = -f3 * m_A14;
+	m_A15 += m_A7 * f3_7;
+	RHS[7] += f3_7 * RHS[3];
+const double f4 = 1.0 / m_A8;
+	const double f4_11 = -f4 * m_A26;
+	m_A27 += m_A9 * f4_11;
+	RHS[11] += f4_11 * RHS[4];
+const double f5 = 1.0 / m_A10;
+	const double f5_16 = -f5 * m_A41;
+	m_A42 += m_A11 * f5_16;
+	RHS[16] += f5_16 * RHS[5];
+const double f6 = 1.0 / m_A12;
+	const double f6_17 = -f6 * m_A44;
+	m_A45 += m_A13 * f6_17;
+	RHS[17] += f6_17 * RHS[6];
+const double f7 = 1.0 / m_A15;
+	const double f7_8 = -f7 * m_A17;
+	m_A18 += m_A16 * f7_8;
+	RHS[8] += f7_8 * RHS[7];
+const double f8 = 1.0 / m_A18;
+	const double f8_9 = -f8 * m_A20;
+	m_A21 += m_A19 * f8_9;
+	RHS[9] += f8_9 * RHS[8];
+const double f9 = 1.0 / m_A21;
+	const double f9_10 = -f9 * m_A23;
+	m_A24 += m_A22 * f9_10;
+	RHS[10] += f9_10 * RHS[9];
+const double f10 = 1.0 / m_A24;
+	const double f10_19 = -f10 * m_A50;
+	m_A51 += m_A25 * f10_19;
+	RHS[19] += f10_19 * RHS[10];
+const double f11 = 1.0 / m_A27;
+	const double f11_12 = -f11 * m_A29;
+	m_A30 += m_A28 * f11_12;
+	RHS[12] += f11_12 * RHS[11];
+const double f12 = 1.0 / m_A30;
+	const double f12_13 = -f12 * m_A32;
+	m_A33 += m_A31 * f12_13;
+	RHS[13] += f12_13 * RHS[12];
+const double f13 = 1.0 / m_A33;
+	const double f13_14 = -f13 * m_A35;
+	m_A36 += m_A34 * f13_14;
+	RHS[14] += f13_14 * RHS[13];
+const double f14 = 1.0 / m_A36;
+	const double f14_18 = -f14 * m_A47;
+	m_A48 += m_A37 * f14_18;
+	RHS[18] += f14_18 * RHS[14];
+const double f15 = 1.0 / m_A39;
+	const double f15_41 = -f15 * m_A142;
+	m_A147 += m_A40 * f15_41;
+	RHS[41] += f15_41 * RHS[15];
+const double f16 = 1.0 / m_A42;
+	const double f16_40 = -f16 * m_A130;
+	m_A139 += m_A43 * f16_40;
+	RHS[40] += f16_40 * RHS[16];
+const double f17 = 1.0 / m_A45;
+	const double f17_40 = -f17 * m_A131;
+	m_A139 += m_A46 * f17_40;
+	RHS[40] += f17_40 * RHS[17];
+const double f18 = 1.0 / m_A48;
+	const double f18_42 = -f18 * m_A149;
+	m_A159 += m_A49 * f18_42;
+	RHS[42] += f18_42 * RHS[18];
+const double f19 = 1.0 / m_A51;
+	const double f19_42 = -f19 * m_A150;
+	m_A159 += m_A52 * f19_42;
+	RHS[42] += f19_42 * RHS[19];
+const double f20 = 1.0 / m_A53;
+	const double f20_27 = -f20 * m_A75;
+	m_A77 += m_A54 * f20_27;
+	RHS[27] += f20_27 * RHS[20];
+	const double f20_41 = -f20 * m_A143;
+	m_A147 += m_A54 * f20_41;
+	RHS[41] += f20_41 * RHS[20];
+const double f21 = 1.0 / m_A55;
+	const double f21_32 = -f21 * m_A90;
+	m_A92 += m_A56 * f21_32;
+	m_A93 += m_A57 * f21_32;
+	RHS[32] += f21_32 * RHS[21];
+	const double f21_33 = -f21 * m_A95;
+	m_A97 += m_A56 * f21_33;
+	m_A98 += m_A57 * f21_33;
+	RHS[33] += f21_33 * RHS[21];
+const double f22 = 1.0 / m_A58;
+	const double f22_39 = -f22 * m_A123;
+	m_A127 += m_A59 * f22_39;
+	m_A128 += m_A60 * f22_39;
+	RHS[39] += f22_39 * RHS[22];
+	const double f22_40 = -f22 * m_A132;
+	m_A138 += m_A59 * f22_40;
+	m_A139 += m_A60 * f22_40;
+	RHS[40] += f22_40 * RHS[22];
+const double f23 = 1.0 / m_A61;
+	const double f23_38 = -f23 * m_A117;
+	m_A120 += m_A62 * f23_38;
+	m_A122 += m_A63 * f23_38;
+	RHS[38] += f23_38 * RHS[23];
+	const double f23_41 = -f23 * m_A144;
+	m_A145 += m_A62 * f23_41;
+	m_A147 += m_A63 * f23_41;
+	RHS[41] += f23_41 * RHS[23];
+const double f24 = 1.0 / m_A64;
+	const double f24_25 = -f24 * m_A67;
+	m_A68 += m_A65 * f24_25;
+	m_A70 += m_A66 * f24_25;
+	RHS[25] += f24_25 * RHS[24];
+	const double f24_42 = -f24 * m_A151;
+	m_A152 += m_A65 * f24_42;
+	m_A159 += m_A66 * f24_42;
+	RHS[42] += f24_42 * RHS[24];
+const double f25 = 1.0 / m_A68;
+	const double f25_26 = -f25 * m_A71;
+	m_A72 += m_A69 * f25_26;
+	m_A74 += m_A70 * f25_26;
+	RHS[26] += f25_26 * RHS[25];
+	const double f25_42 = -f25 * m_A152;
+	m_A153 += m_A69 * f25_42;
+	m_A159 += m_A70 * f25_42;
+	RHS[42] += f25_42 * RHS[25];
+const double f26 = 1.0 / m_A72;
+	const double f26_42 = -f26 * m_A153;
+	m_A154 += m_A73 * f26_42;
+	m_A159 += m_A74 * f26_42;
+	RHS[42] += f26_42 * RHS[26];
+const double f27 = 1.0 / m_A76;
+	const double f27_42 = -f27 * m_A154;
+	m_A158 += m_A77 * f27_42;
+	RHS[42] += f27_42 * RHS[27];
+const double f28 = 1.0 / m_A78;
+	const double f28_39 = -f28 * m_A124;
+	m_A125 += m_A79 * f28_39;
+	m_A127 += m_A80 * f28_39;
+	RHS[39] += f28_39 * RHS[28];
+const double f29 = 1.0 / m_A81;
+	const double f29_34 = -f29 * m_A101;
+	m_A102 += m_A82 * f29_34;
+	m_A103 += m_A83 * f29_34;
+	RHS[34] += f29_34 * RHS[29];
+	const double f29_39 = -f29 * m_A125;
+	m_A126 += m_A82 * f29_39;
+	m_A127 += m_A83 * f29_39;
+	RHS[39] += f29_39 * RHS[29];
+const double f30 = 1.0 / m_A84;
+	const double f30_32 = -f30 * m_A91;
+	m_A92 += m_A85 * f30_32;
+	m_A94 += m_A86 * f30_32;
+	RHS[32] += f30_32 * RHS[30];
+	const double f30_40 = -f30 * m_A133;
+	m_A134 += m_A85 * f30_40;
+	m_A139 += m_A86 * f30_40;
+	RHS[40] += f30_40 * RHS[30];
+const double f31 = 1.0 / m_A87;
+	const double f31_33 = -f31 * m_A96;
+	m_A98 += m_A88 * f31_33;
+	m_A99 += m_A89 * f31_33;
+	RHS[33] += f31_33 * RHS[31];
+	const double f31_38 = -f31 * m_A118;
+	m_A119 += m_A88 * f31_38;
+	m_A120 += m_A89 * f31_38;
+	RHS[38] += f31_38 * RHS[31];
+const double f32 = 1.0 / m_A92;
+	const double f32_33 = -f32 * m_A97;
+	m_A98 += m_A93 * f32_33;
+	m_A100 += m_A94 * f32_33;
+	RHS[33] += f32_33 * RHS[32];
+	const double f32_40 = -f32 * m_A134;
+	m_A135 += m_A93 * f32_40;
+	m_A139 += m_A94 * f32_40;
+	RHS[40] += f32_40 * RHS[32];
+const double f33 = 1.0 / m_A98;
+	const double f33_38 = -f33 * m_A119;
+	m_A120 += m_A99 * f33_38;
+	m_A121 += m_A100 * f33_38;
+	RHS[38] += f33_38 * RHS[33];
+	const double f33_40 = -f33 * m_A135;
+	m_A137 += m_A99 * f33_40;
+	m_A139 += m_A100 * f33_40;
+	RHS[40] += f33_40 * RHS[33];
+const double f34 = 1.0 / m_A102;
+	const double f34_39 = -f34 * m_A126;
+	m_A127 += m_A103 * f34_39;
+	m_A129 += m_A104 * f34_39;
+	RHS[39] += f34_39 * RHS[34];
+	const double f34_42 = -f34 * m_A155;
+	m_A156 += m_A103 * f34_42;
+	m_A159 += m_A104 * f34_42;
+	RHS[42] += f34_42 * RHS[34];
+const double f35 = 1.0 / m_A106;
+	const double f35_37 = -f35 * m_A113;
+	m_A114 += m_A107 * f35_37;
+	m_A115 += m_A108 * f35_37;
+	RHS[37] += f35_37 * RHS[35];
+const double f36 = 1.0 / m_A109;
+	const double f36_37 = -f36 * m_A114;
+	m_A115 += m_A110 * f36_37;
+	m_A116 += m_A111 * f36_37;
+	RHS[37] += f36_37 * RHS[36];
+const double f37 = 1.0 / m_A115;
+	const double f37_40 = -f37 * m_A136;
+	m_A139 += m_A116 * f37_40;
+	RHS[40] += f37_40 * RHS[37];
+const double f38 = 1.0 / m_A120;
+	const double f38_40 = -f38 * m_A137;
+	m_A139 += m_A121 * f38_40;
+	m_A140 += m_A122 * f38_40;
+	RHS[40] += f38_40 * RHS[38];
+	const double f38_41 = -f38 * m_A145;
+	m_A146 += m_A121 * f38_41;
+	m_A147 += m_A122 * f38_41;
+	RHS[41] += f38_41 * RHS[38];
+const double f39 = 1.0 / m_A127;
+	const double f39_40 = -f39 * m_A138;
+	m_A139 += m_A128 * f39_40;
+	m_A141 += m_A129 * f39_40;
+	RHS[40] += f39_40 * RHS[39];
+	const double f39_42 = -f39 * m_A156;
+	m_A157 += m_A128 * f39_42;
+	m_A159 += m_A129 * f39_42;
+	RHS[42] += f39_42 * RHS[39];
+const double f40 = 1.0 / m_A139;
+	const double f40_41 = -f40 * m_A146;
+	m_A147 += m_A140 * f40_41;
+	m_A148 += m_A141 * f40_41;
+	RHS[41] += f40_41 * RHS[40];
+	const double f40_42 = -f40 * m_A157;
+	m_A158 += m_A140 * f40_42;
+	m_A159 += m_A141 * f40_42;
+	RHS[42] += f40_42 * RHS[40];
+const double f41 = 1.0 / m_A147;
+	const double f41_42 = -f41 * m_A158;
+	m_A159 += m_A148 * f41_42;
+	RHS[42] += f41_42 * RHS[41];
+	V[42] = RHS[42] / m_A159;
+	double tmp41 = 0.0;
+	tmp41 += m_A148 * V[42];
+	V[41] = (RHS[41] - tmp41) / m_A147;
+	double tmp40 = 0.0;
+	tmp40 += m_A140 * V[41];
+	tmp40 += m_A141 * V[42];
+	V[40] = (RHS[40] - tmp40) / m_A139;
+	double tmp39 = 0.0;
+	tmp39 += m_A128 * V[40];
+	tmp39 += m_A129 * V[42];
+	V[39] = (RHS[39] - tmp39) / m_A127;
+	double tmp38 = 0.0;
+	tmp38 += m_A121 * V[40];
+	tmp38 += m_A122 * V[41];
+	V[38] = (RHS[38] - tmp38) / m_A120;
+	double tmp37 = 0.0;
+	tmp37 += m_A116 * V[40];
+	V[37] = (RHS[37] - tmp37) / m_A115;
+	double tmp36 = 0.0;
+	tmp36 += m_A110 * V[37];
+	tmp36 += m_A111 * V[40];
+	V[36] = (RHS[36] - tmp36) / m_A109;
+	double tmp35 = 0.0;
+	tmp35 += m_A107 * V[36];
+	tmp35 += m_A108 * V[37];
+	V[35] = (RHS[35] - tmp35) / m_A106;
+	double tmp34 = 0.0;
+	tmp34 += m_A103 * V[39];
+	tmp34 += m_A104 * V[42];
+	V[34] = (RHS[34] - tmp34) / m_A102;
+	double tmp33 = 0.0;
+	tmp33 += m_A99 * V[38];
+	tmp33 += m_A100 * V[40];
+	V[33] = (RHS[33] - tmp33) / m_A98;
+	double tmp32 = 0.0;
+	tmp32 += m_A93 * V[33];
+	tmp32 += m_A94 * V[40];
+	V[32] = (RHS[32] - tmp32) / m_A92;
+	double tmp31 = 0.0;
+	tmp31 += m_A88 * V[33];
+	tmp31 += m_A89 * V[38];
+	V[31] = (RHS[31] - tmp31) / m_A87;
+	double tmp30 = 0.0;
+	tmp30 += m_A85 * V[32];
+	tmp30 += m_A86 * V[40];
+	V[30] = (RHS[30] - tmp30) / m_A84;
+	double tmp29 = 0.0;
+	tmp29 += m_A82 * V[34];
+	tmp29 += m_A83 * V[39];
+	V[29] = (RHS[29] - tmp29) / m_A81;
+	double tmp28 = 0.0;
+	tmp28 += m_A79 * V[29];
+	tmp28 += m_A80 * V[39];
+	V[28] = (RHS[28] - tmp28) / m_A78;
+	double tmp27 = 0.0;
+	tmp27 += m_A77 * V[41];
+	V[27] = (RHS[27] - tmp27) / m_A76;
+	double tmp26 = 0.0;
+	tmp26 += m_A73 * V[27];
+	tmp26 += m_A74 * V[42];
+	V[26] = (RHS[26] - tmp26) / m_A72;
+	double tmp25 = 0.0;
+	tmp25 += m_A69 * V[26];
+	tmp25 += m_A70 * V[42];
+	V[25] = (RHS[25] - tmp25) / m_A68;
+	double tmp24 = 0.0;
+	tmp24 += m_A65 * V[25];
+	tmp24 += m_A66 * V[42];
+	V[24] = (RHS[24] - tmp24) / m_A64;
+	double tmp23 = 0.0;
+	tmp23 += m_A62 * V[38];
+	tmp23 += m_A63 * V[41];
+	V[23] = (RHS[23] - tmp23) / m_A61;
+	double tmp22 = 0.0;
+	tmp22 += m_A59 * V[39];
+	tmp22 += m_A60 * V[40];
+	V[22] = (RHS[22] - tmp22) / m_A58;
+	double tmp21 = 0.0;
+	tmp21 += m_A56 * V[32];
+	tmp21 += m_A57 * V[33];
+	V[21] = (RHS[21] - tmp21) / m_A55;
+	double tmp20 = 0.0;
+	tmp20 += m_A54 * V[41];
+	V[20] = (RHS[20] - tmp20) / m_A53;
+	double tmp19 = 0.0;
+	tmp19 += m_A52 * V[42];
+	V[19] = (RHS[19] - tmp19) / m_A51;
+	double tmp18 = 0.0;
+	tmp18 += m_A49 * V[42];
+	V[18] = (RHS[18] - tmp18) / m_A48;
+	double tmp17 = 0.0;
+	tmp17 += m_A46 * V[40];
+	V[17] = (RHS[17] - tmp17) / m_A45;
+	double tmp16 = 0.0;
+	tmp16 += m_A43 * V[40];
+	V[16] = (RHS[16] - tmp16) / m_A42;
+	double tmp15 = 0.0;
+	tmp15 += m_A40 * V[41];
+	V[15] = (RHS[15] - tmp15) / m_A39;
+	double tmp14 = 0.0;
+	tmp14 += m_A37 * V[18];
+	V[14] = (RHS[14] - tmp14) / m_A36;
+	double tmp13 = 0.0;
+	tmp13 += m_A34 * V[14];
+	V[13] = (RHS[13] - tmp13) / m_A33;
+	double tmp12 = 0.0;
+	tmp12 += m_A31 * V[13];
+	V[12] = (RHS[12] - tmp12) / m_A30;
+	double tmp11 = 0.0;
+	tmp11 += m_A28 * V[12];
+	V[11] = (RHS[11] - tmp11) / m_A27;
+	double tmp10 = 0.0;
+	tmp10 += m_A25 * V[19];
+	V[10] = (RHS[10] - tmp10) / m_A24;
+	double tmp9 = 0.0;
+	tmp9 += m_A22 * V[10];
+	V[9] = (RHS[9] - tmp9) / m_A21;
+	double tmp8 = 0.0;
+	tmp8 += m_A19 * V[9];
+	V[8] = (RHS[8] - tmp8) / m_A18;
+	double tmp7 = 0.0;
+	tmp7 += m_A16 * V[8];
+	V[7] = (RHS[7] - tmp7) / m_A15;
+	double tmp6 = 0.0;
+	tmp6 += m_A13 * V[17];
+	V[6] = (RHS[6] - tmp6) / m_A12;
+	double tmp5 = 0.0;
+	tmp5 += m_A11 * V[16];
+	V[5] = (RHS[5] - tmp5) / m_A10;
+	double tmp4 = 0.0;
+	tmp4 += m_A9 * V[11];
+	V[4] = (RHS[4] - tmp4) / m_A8;
+	double tmp3 = 0.0;
+	tmp3 += m_A7 * V[7];
+	V[3] = (RHS[3] - tmp3) / m_A6;
+	double tmp2 = 0.0;
+	tmp2 += m_A5 * V[15];
+	V[2] = (RHS[2] - tmp2) / m_A4;
+	double tmp1 = 0.0;
+	tmp1 += m_A3 * V[37];
+	V[1] = (RHS[1] - tmp1) / m_A2;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[35];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+extern "C" void nl_gcr_70aaccbbf0d44f17_22(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+
+{
+
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+double m_A19 = m_A[19];
+double m_A20 = m_A[20];
+double m_A21 = m_A[21];
+const double f0 = 1.0 / m_A0;
+	const double f0_6 = -f0 * m_A12;
+	m_A13 += m_A1 * f0_6;
+	RHS[6] += f0_6 * RHS[0];
+const double f1 = 1.0 / m_A2;
+	const double f1_7 = -f1 * m_A15;
+	m_A21 += m_A3 * f1_7;
+	RHS[7] += f1_7 * RHS[1];
+const double f2 = 1.0 / m_A4;
+	const double f2_7 = -f2 * m_A16;
+	m_A21 += m_A5 * f2_7;
+	RHS[7] += f2_7 * RHS[2];
+const double f3 = 1.0 / m_A6;
+	const double f3_7 = -f3 * m_A17;
+	m_A21 += m_A7 * f3_7;
+	RHS[7] += f3_7 * RHS[3];
+const double f4 = 1.0 / m_A8;
+	const double f4_7 = -f4 * m_A18;
+	m_A21 += m_A9 * f4_7;
+	RHS[7] += f4_7 * RHS[4];
+const double f5 = 1.0 / m_A10;
+	const double f5_7 = -f5 * m_A19;
+	m_A21 += m_A11 * f5_7;
+	RHS[7] += f5_7 * RHS[5];
+const double f6 = 1.0 / m_A13;
+	const double f6_7 = -f6 * m_A20;
+	m_A21 += m_A14 * f6_7;
+	RHS[7] += f6_7 * RHS[6];
+	V[7] = RHS[7] / m_A21;
+	double tmp6 = 0.0;
+	tmp6 += m_A14 * V[7];
+	V[6] = (RHS[6] - tmp6) / m_A13;
+	double tmp5 = 0.0;
+	tmp5 += m_A11 * V[7];
+	V[5] = (RHS[5] - tmp5) / m_A10;
+	double tmp4 = 0.0;
+	tmp4 += m_A9 * V[7];
+	V[4] = (RHS[4] - tmp4) / m_A8;
+	double tmp3 = 0.0;
+	tmp3 += m_A7 * V[7];
+	V[3] = (RHS[3] - tmp3) / m_A6;
+	double tmp2 = 0.0;
+	tmp2 += m_A5 * V[7];
+	V[2] = (RHS[2] - tmp2) / m_A4;
+	double tmp1 = 0.0;
+	tmp1 += m_A3 * V[7];
+	V[1] = (RHS[1] - tmp1) / m_A2;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[6];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+extern "C" void nl_gcr_72e93cbcec6ddfaf_33(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+
+{
+
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+double m_A19 = m_A[19];
+double m_A20 = m_A[20];
+double m_A21 = m_A[21];
+double m_A22 = m_A[22];
+double m_A23 = m_A[23];
+double m_A24 = m_A[24];
+double m_A25 = m_A[25];
+double m_A26 = m_A[26];
+double m_A27 = m_A[27];
+double m_A28 = m_A[28];
+double m_A29 = m_A[29];
+double m_A30 = m_A[30];
+double m_A31 = m_A[31];
+double m_A32 = m_A[32];
+const double f0 = 1.0 / m_A0;
+	const double f0_1 = -f0 * m_A2;
+	m_A3 += m_A1 * f0_1;
+	RHS[1] += f0_1 * RHS[0];
+const double f1 = 1.0 / m_A3;
+	const double f1_2 = -f1 * m_A5;
+	m_A6 += m_A4 * f1_2;
+	RHS[2] += f1_2 * RHS[1];
+const double f2 = 1.0 / m_A6;
+	const double f2_6 = -f2 * m_A18;
+	m_A20 += m_A7 * f2_6;
+	RHS[6] += f2_6 * RHS[2];
+const double f3 = 1.0 / m_A8;
+	const double f3_4 = -f3 * m_A11;
+	m_A12 += m_A9 * f3_4;
+	m_A14 += m_A10 * f3_4;
+	RHS[4] += f3_4 * RHS[3];
+	const double f3_8 = -f3 * m_A27;
+	m_A28 += m_A9 * f3_8;
+	m_A32 += m_A10 * f3_8;
+	RHS[8] += f3_8 * RHS[3];
+const double f4 = 1.0 / m_A12;
+	const double f4_6 = -f4 * m_A19;
+	m_A20 += m_A13 * f4_6;
+	m_A22 += m_A14 * f4_6;
+	RHS[6] += f4_6 * RHS[4];
+	const double f4_8 = -f4 * m_A28;
+	m_A30 += m_A13 * f4_8;
+	m_A32 += m_A14 * f4_8;
+	RHS[8] += f4_8 * RHS[4];
+const double f5 = 1.0 / m_A15;
+	const double f5_7 = -f5 * m_A23;
+	m_A25 += m_A16 * f5_7;
+	m_A26 += m_A17 * f5_7;
+	RHS[7] += f5_7 * RHS[5];
+	const double f5_8 = -f5 * m_A29;
+	m_A31 += m_A16 * f5_8;
+	m_A32 += m_A17 * f5_8;
+	RHS[8] += f5_8 * RHS[5];
+const double f6 = 1.0 / m_A20;
+	const double f6_7 = -f6 * m_A24;
+	m_A25 += m_A21 * f6_7;
+	m_A26 += m_A22 * f6_7;
+	RHS[7] += f6_7 * RHS[6];
+	const double f6_8 = -f6 * m_A30;
+	m_A31 += m_A21 * f6_8;
+	m_A32 += m_A22 * f6_8;
+	RHS[8] += f6_8 * RHS[6];
+const double f7 = 1.0 / m_A25;
+	const double f7_8 = -f7 * m_A31;
+	m_A32 += m_A26 * f7_8;
+	RHS[8] += f7_8 * RHS[7];
+	V[8] = RHS[8] / m_A32;
+	double tmp7 = 0.0;
+	tmp7 += m_A26 * V[8];
+	V[7] = (RHS[7] - tmp7) / m_A25;
+	double tmp6 = 0.0;
+	tmp6 += m_A21 * V[7];
+	tmp6 += m_A22 * V[8];
+	V[6] = (RHS[6] - tmp6) / m_A20;
+	double tmp5 = 0.0;
+	tmp5 += m_A16 * V[7];
+	tmp5 += m_A17 * V[8];
+	V[5] = (RHS[5] - tmp5) / m_A15;
+	double tmp4 = 0.0;
+	tmp4 += m_A13 * V[6];
+	tmp4 += m_A14 * V[8];
+	V[4] = (RHS[4] - tmp4) / m_A12;
+	double tmp3 = 0.0;
+	tmp3 += m_A9 * V[4];
+	tmp3 += m_A10 * V[8];
+	V[3] = (RHS[3] - tmp3) / m_A8;
+	double tmp2 = 0.0;
+	tmp2 += m_A7 * V[6];
+	V[2] = (RHS[2] - tmp2) / m_A6;
+	double tmp1 = 0.0;
+	tmp1 += m_A4 * V[2];
+	V[1] = (RHS[1] - tmp1) / m_A3;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[1];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+extern "C" void nl_gcr_88fbb67abf0125d4_19(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+
+{
+
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+const double f0 = 1.0 / m_A0;
+	const double f0_1 = -f0 * m_A2;
+	m_A3 += m_A1 * f0_1;
+	RHS[1] += f0_1 * RHS[0];
+const double f1 = 1.0 / m_A3;
+	const double f1_4 = -f1 * m_A11;
+	m_A13 += m_A4 * f1_4;
+	RHS[4] += f1_4 * RHS[1];
+const double f2 = 1.0 / m_A5;
+	const double f2_5 = -f2 * m_A15;
+	m_A16 += m_A6 * f2_5;
+	m_A18 += m_A7 * f2_5;
+	RHS[5] += f2_5 * RHS[2];
+const double f3 = 1.0 / m_A8;
+	const double f3_4 = -f3 * m_A12;
+	m_A13 += m_A9 * f3_4;
+	m_A14 += m_A10 * f3_4;
+	RHS[4] += f3_4 * RHS[3];
+	const double f3_5 = -f3 * m_A16;
+	m_A17 += m_A9 * f3_5;
+	m_A18 += m_A10 * f3_5;
+	RHS[5] += f3_5 * RHS[3];
+const double f4 = 1.0 / m_A13;
+	const double f4_5 = -f4 * m_A17;
+	m_A18 += m_A14 * f4_5;
+	RHS[5] += f4_5 * RHS[4];
+	V[5] = RHS[5] / m_A18;
+	double tmp4 = 0.0;
+	tmp4 += m_A14 * V[5];
+	V[4] = (RHS[4] - tmp4) / m_A13;
+	double tmp3 = 0.0;
+	tmp3 += m_A9 * V[4];
+	tmp3 += m_A10 * V[5];
+	V[3] = (RHS[3] - tmp3) / m_A8;
+	double tmp2 = 0.0;
+	tmp2 += m_A6 * V[3];
+	tmp2 += m_A7 * V[5];
+	V[2] = (RHS[2] - tmp2) / m_A5;
+	double tmp1 = 0.0;
+	tmp1 += m_A4 * V[4];
+	V[1] = (RHS[1] - tmp1) / m_A3;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[1];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+extern "C" void nl_gcr_e6a6d740c7375e0b_34(double * __restrict m_A, double * __restrict RHS, double * __restrict V)
+
+{
+
+double m_A0 = m_A[0];
+double m_A1 = m_A[1];
+double m_A2 = m_A[2];
+double m_A3 = m_A[3];
+double m_A4 = m_A[4];
+double m_A5 = m_A[5];
+double m_A6 = m_A[6];
+double m_A7 = m_A[7];
+double m_A8 = m_A[8];
+double m_A9 = m_A[9];
+double m_A10 = m_A[10];
+double m_A11 = m_A[11];
+double m_A12 = m_A[12];
+double m_A13 = m_A[13];
+double m_A14 = m_A[14];
+double m_A15 = m_A[15];
+double m_A16 = m_A[16];
+double m_A17 = m_A[17];
+double m_A18 = m_A[18];
+double m_A19 = m_A[19];
+double m_A20 = m_A[20];
+double m_A21 = m_A[21];
+double m_A22 = m_A[22];
+double m_A23 = m_A[23];
+double m_A24 = m_A[24];
+double m_A25 = m_A[25];
+double m_A26 = m_A[26];
+double m_A27 = m_A[27];
+double m_A28 = m_A[28];
+double m_A29 = m_A[29];
+double m_A30 = m_A[30];
+double m_A31 = m_A[31];
+double m_A32 = m_A[32];
+double m_A33 = m_A[33];
+const double f0 = 1.0 / m_A0;
+	const double f0_4 = -f0 * m_A10;
+	m_A12 += m_A1 * f0_4;
+	RHS[4] += f0_4 * RHS[0];
+const double f1 = 1.0 / m_A2;
+	const double f1_2 = -f1 * m_A4;
+	m_A5 += m_A3 * f1_2;
+	RHS[2] += f1_2 * RHS[1];
+const double f2 = 1.0 / m_A5;
+	const double f2_3 = -f2 * m_A7;
+	m_A8 += m_A6 * f2_3;
+	RHS[3] += f2_3 * RHS[2];
+const double f3 = 1.0 / m_A8;
+	const double f3_4 = -f3 * m_A11;
+	m_A12 += m_A9 * f3_4;
+	RHS[4] += f3_4 * RHS[3];
+const double f4 = 1.0 / m_A12;
+	const double f4_7 = -f4 * m_A20;
+	m_A22 += m_A13 * f4_7;
+	RHS[7] += f4_7 * RHS[4];
+const double f5 = 1.0 / m_A14;
+	const double f5_7 = -f5 * m_A21;
+	m_A22 += m_A15 * f5_7;
+	m_A24 += m_A16 * f5_7;
+	RHS[7] += f5_7 * RHS[5];
+	const double f5_9 = -f5 * m_A29;
+	m_A31 += m_A15 * f5_9;
+	m_A33 += m_A16 * f5_9;
+	RHS[9] += f5_9 * RHS[5];
+const double f6 = 1.0 / m_A17;
+	const double f6_8 = -f6 * m_A25;
+	m_A27 += m_A18 * f6_8;
+	m_A28 += m_A19 * f6_8;
+	RHS[8] += f6_8 * RHS[6];
+	const double f6_9 = -f6 * m_A30;
+	m_A32 += m_A18 * f6_9;
+	m_A33 += m_A19 * f6_9;
+	RHS[9] += f6_9 * RHS[6];
+const double f7 = 1.0 / m_A22;
+	const double f7_8 = -f7 * m_A26;
+	m_A27 += m_A23 * f7_8;
+	m_A28 += m_A24 * f7_8;
+	RHS[8] += f7_8 * RHS[7];
+	const double f7_9 = -f7 * m_A31;
+	m_A32 += m_A23 * f7_9;
+	m_A33 += m_A24 * f7_9;
+	RHS[9] += f7_9 * RHS[7];
+const double f8 = 1.0 / m_A27;
+	const double f8_9 = -f8 * m_A32;
+	m_A33 += m_A28 * f8_9;
+	RHS[9] += f8_9 * RHS[8];
+	V[9] = RHS[9] / m_A33;
+	double tmp8 = 0.0;
+	tmp8 += m_A28 * V[9];
+	V[8] = (RHS[8] - tmp8) / m_A27;
+	double tmp7 = 0.0;
+	tmp7 += m_A23 * V[8];
+	tmp7 += m_A24 * V[9];
+	V[7] = (RHS[7] - tmp7) / m_A22;
+	double tmp6 = 0.0;
+	tmp6 += m_A18 * V[8];
+	tmp6 += m_A19 * V[9];
+	V[6] = (RHS[6] - tmp6) / m_A17;
+	double tmp5 = 0.0;
+	tmp5 += m_A15 * V[7];
+	tmp5 += m_A16 * V[9];
+	V[5] = (RHS[5] - tmp5) / m_A14;
+	double tmp4 = 0.0;
+	tmp4 += m_A13 * V[7];
+	V[4] = (RHS[4] - tmp4) / m_A12;
+	double tmp3 = 0.0;
+	tmp3 += m_A9 * V[4];
+	V[3] = (RHS[3] - tmp3) / m_A8;
+	double tmp2 = 0.0;
+	tmp2 += m_A6 * V[3];
+	V[2] = (RHS[2] - tmp2) / m_A5;
+	double tmp1 = 0.0;
+	tmp1 += m_A3 * V[2];
+	V[1] = (RHS[1] - tmp1) / m_A2;
+	double tmp0 = 0.0;
+	tmp0 += m_A1 * V[4];
+	V[0] = (RHS[0] - tmp0) / m_A0;
+}
+
+extern const plib::dynlib_static_sym nl_static_solver_syms[];
+const plib::dynlib_static_sym nl_static_solver_syms[] = {
+	{"nl_gcr_174c06bf71ec1512_29", reinterpret_cast<void *>(&nl_gcr_174c06bf71ec1512_29)},
+	{"nl_gcr_197479fc90048992_22", reinterpret_cast<void *>(&nl_gcr_197479fc90048992_22)},
+	{"nl_gcr_4db4829abfb8425e_160", reinterpret_cast<void *>(&nl_gcr_4db4829abfb8425e_160)},
+	{"nl_gcr_70aaccbbf0d44f17_22", reinterpret_cast<void *>(&nl_gcr_70aaccbbf0d44f17_22)},
+	{"nl_gcr_72e93cbcec6ddfaf_33", reinterpret_cast<void *>(&nl_gcr_72e93cbcec6ddfaf_33)},
+	{"nl_gcr_88fbb67abf0125d4_19", reinterpret_cast<void *>(&nl_gcr_88fbb67abf0125d4_19)},
+	{"nl_gcr_e6a6d740c7375e0b_34", reinterpret_cast<void *>(&nl_gcr_e6a6d740c7375e0b_34)},
+	{nullptr, nullptr}
+};
@@ -15,6 +15,7 @@
 
 #include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 namespace netlist
 {
@@ -30,6 +31,35 @@ namespace netlist
 	using nperfcount_t = plib::chrono::counter<false>;
 #endif
 
+	/*! Runtime statistics of one matrix solver.
+	 *  Unlike the above these are always kept; see netlist_t::stats().
+	 */
+	struct solver_stats_t
+	{
+		pstring name;
+		std::size_t nets;
+		uint_least64_t calls;            /*!< solves of a new time step */
+		uint_least64_t calculations;     /*!< linear systems solved */
+		uint_least64_t newton_raphson;   /*!< Newton-Raphson iterations */
+		uint_least64_t nr_fails;         /*!< NR_LOOPS exceeded, solve rescheduled */
+		uint_least64_t iterative_total;  /*!< Gauss-Seidel/SOR/GMRES iterations */
+		uint_least64_t iterative_fail;   /*!< iterative solves that didn't converge */
+		uint_least64_t iterative_stagnated; /*!< of these, given up early as stagnating */
+		uint_least64_t timestep_changes; /*!< dynamic time step changed */
+		double host_time;                /*!< seconds spent solving */
+	};
+
+	/*! Runtime statistics of a netlist, see netlist_t::stats(). */
+	struct netlist_stats_t
+	{
+		uint_least64_t queue_pushes;
+		uint_least64_t queue_pops;
+		uint_least64_t net_updates;      /*!< queue entries processed */
+		uint_least64_t device_updates;   /*!< input notifications delivered */
+		double host_time;                /*!< seconds spent in process_queue */
+		std::vector<solver_stats_t> solvers;
+	};
+
 	//============================================================
 	//  Types needed by various includes
 	//============================================================
@@ -21,6 +21,7 @@
 #include <cstring>
 #include <cmath>
 #include <limits>
+#include <map>
 
 namespace netlist
 {
@@ -171,8 +172,8 @@ void detail::queue_t::on_pre_save()
 	netlist().log().debug("current time {1} qsize {2}\n", netlist().time().as_double(), m_qsize);
 	for (std::size_t i = 0; i < m_qsize; i++ )
 	{
-		m_times[i] =  this->listptr()[i].m_exec_time.as_raw();
-		m_net_ids[i] = netlist().find_net_id(this->listptr()[i].m_object);
+		m_times[i] =  (*this)[i].m_exec_time.as_raw();
+		m_net_ids[i] = netlist().find_net_id((*this)[i].m_object);
 	}
 }
 
@@ -248,6 +249,7 @@ netlist_t::netlist_t(const pstring &aname)
 	, m_name(aname)
 	, m_log(*this)
 	, m_lib(nullptr)
+	, m_static_solver_syms(nullptr)
 	, m_state()
 {
 	state().save_item(this, static_cast<plib::state_manager_t::callback_t &>(m_queue), "m_queue");
@@ -306,6 +308,7 @@ void netlist_t::start()
 				|| setup().factory().is_class<devices::NETLIB_NAME(netlistparams)>(e.second))
 		{
 			auto dev = plib::owned_ptr<device_t>(e.second->Create(*this, e.first));
+			m_device_family[dev.get()] = e.second->name();
 			register_dev(std::move(dev));
 		}
 	}
@@ -315,6 +318,9 @@ void netlist_t::start()
 	m_solver = get_single_device<devices::NETLIB_NAME(solver)>("solver");
 	m_params = get_single_device<devices::NETLIB_NAME(netlistparams)>("parameter");
 
+	if (m_params->m_tt_merge() > 0)
+		setup().merge_truthtables(static_cast<std::size_t>(m_params->m_tt_merge()));
+
 	/* create devices */
 
 	log().debug("Creating devices ...\n");
@@ -332,10 +338,16 @@ void netlist_t::start()
 	m_mainclock = get_single_device<devices::NETLIB_NAME(mainclock)>("mainclock");
 
 	bool use_deactivate = (m_params->m_use_deactivate() ? true : false);
+	std::size_t auto_deactivate = 0;
 
+	/* Without USE_DEACTIVATE, devices still deactivate where the
+	 * analysis shows it can't cost anything. HINT_NO_DEACTIVATE
+	 * overrides either.
+	 */
 	for (auto &d : m_devices)
 	{
-		if (use_deactivate)
+		bool hint = use_deactivate || d->deactivate_is_free();
+		if (hint)
 		{
 			auto p = setup().m_param_values.find(d->name() + ".HINT_NO_DEACTIVATE");
 			if (p != setup().m_param_values.end())
@@ -345,15 +357,20 @@ void netlist_t::start()
 				auto v = p->second.as_double(&error);
 				if (error || std::abs(v - std::floor(v)) > 1e-6 )
 					log().fatal(MF_1_HND_VAL_NOT_SUPPORTED, p->second);
-				d->set_hint_deactivate(v == 0.0);
+				hint = (v == 0.0);
 			}
+			if (hint && !use_deactivate)
+				auto_deactivate++;
 		}
-		else
-			d->set_hint_deactivate(false);
+		d->set_hint_deactivate(hint);
 	}
+	if (auto_deactivate > 0)
+		log().verbose("{1} devices deactivated by analysis", auto_deactivate);
 
 	pstring libpath = plib::util::environment("NL_BOOSTLIB", plib::util::buildpath({".", "nlboost.so"}));
 	m_lib = plib::make_unique<plib::dynlib>(libpath);
+	if (!m_lib->isLoaded() && m_static_solver_syms != nullptr)
+		m_lib = plib::make_unique<plib::dynlib>(m_static_solver_syms);
 
 	/* resolve inputs */
 	setup().resolve_inputs();
@@ -531,6 +548,7 @@ void netlist_t::process_queue(const netlist_time &delta) NL_NOEXCEPT
 
 	m_queue.push(detail::queue_t::entry_t(stop, nullptr));
 
+	m_stat_host_time.start();
 	m_stat_mainloop.start();
 
 	if (m_mainclock == nullptr)
@@ -577,6 +595,33 @@ void netlist_t::process_queue(const netlist_time &delta) NL_NOEXCEPT
 		mc_net.set_time(mc_time);
 	}
 	m_stat_mainloop.stop();
+	m_stat_host_time.stop();
+}
+
+netlist_stats_t netlist_t::stats() const
+{
+	netlist_stats_t s;
+	s.queue_pushes = m_queue.pushes();
+	s.queue_pops = m_queue.pops();
+	s.net_updates = m_perf_out_processed();
+	s.device_updates = 0;
+	for (auto &d : m_devices)
+		s.device_updates += d->m_stat_call_count();
+	s.host_time = m_stat_host_time.as_seconds();
+	if (m_solver != nullptr)
+		m_solver->stats(s.solvers);
+	return s;
+}
+
+void netlist_t::reset_stats()
+{
+	m_queue.reset_stats();
+	m_perf_out_processed.reset();
+	for (auto &d : m_devices)
+		d->m_stat_call_count.reset();
+	m_stat_host_time.reset();
+	if (m_solver != nullptr)
+		m_solver->reset_stats();
 }
 
 void netlist_t::print_stats() const
@@ -617,8 +662,8 @@ void netlist_t::print_stats() const
 				* static_cast<nperftime_t::type>(total_count)
 				/ static_cast<nperftime_t::type>(200000);
 
-		log().verbose("Queue Pushes   {1:15}", queue().m_prof_call());
-		log().verbose("Queue Moves    {1:15}", queue().m_prof_sortmove());
+		log().verbose("Queue Pushes   {1:15}", queue().prof_call());
+		log().verbose("Queue Moves    {1:15}", queue().prof_sortmove());
 
 		log().verbose("Total loop     {1:15}", m_stat_mainloop());
 		/* Only one serialization should be counted in total time */
@@ -628,7 +673,7 @@ void netlist_t::print_stats() const
 		log().verbose("Take the next lines with a grain of salt. They depend on the measurement implementation.");
 		log().verbose("Total overhead {1:15}", total_overhead);
 		nperftime_t::type overhead_per_pop = (m_stat_mainloop()-2*total_overhead - (total_time - total_overhead))
-				/ static_cast<nperftime_t::type>(queue().m_prof_call());
+				/ static_cast<nperftime_t::type>(queue().prof_call());
 		log().verbose("Overhead per pop  {1:11}", overhead_per_pop );
 		log().verbose("");
 		for (auto &entry : m_devices)
@@ -636,6 +681,21 @@ void netlist_t::print_stats() const
 			if (entry->m_stat_inc_active() > 3 * entry->m_stat_total_time.count())
 				log().verbose("HINT({}, NO_DEACTIVATE)", entry->name());
 		}
+
+		/* updates saved by inactive inputs, per device family */
+		std::map<pstring, std::pair<uint_least64_t, uint_least64_t>> families;
+		for (auto &entry : m_devices)
+		{
+			auto f = m_device_family.find(entry.get());
+			auto &fam = families[f != m_device_family.end() ? f->second : pstring("(internal)")];
+			fam.first += entry->m_stat_suppressed();
+			fam.second += entry->m_stat_call_count();
+		}
+		log().verbose("");
+		log().verbose("Family                   suppressed    delivered");
+		for (auto &fam : families)
+			if (fam.second.first > 0)
+				log().verbose("{1:20} {2:14} {3:12}", fam.first, fam.second.first, fam.second.second);
 	}
 }
 
@@ -869,10 +929,12 @@ void detail::net_t::update_devs() NL_NOEXCEPT
 		case core_terminal_t::STATE_INP_HL:
 			m_cur_Q = m_new_Q;
 			process(core_terminal_t::STATE_INP_HL | core_terminal_t::STATE_INP_ACTIVE);
+			count_suppressed();
 			break;
 		case core_terminal_t::STATE_INP_LH:
 			m_cur_Q = m_new_Q;
 			process(core_terminal_t::STATE_INP_LH | core_terminal_t::STATE_INP_ACTIVE);
+			count_suppressed();
 			break;
 		default:
 			break;
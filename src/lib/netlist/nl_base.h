@@ -740,6 +740,8 @@ namespace netlist
 		void inc_active(core_terminal_t &term) NL_NOEXCEPT;
 		void dec_active(core_terminal_t &term) NL_NOEXCEPT;
 
+		void count_suppressed() NL_NOEXCEPT;
+
 		/* setup stuff */
 
 		void add_terminal(core_terminal_t &terminal);
@@ -1095,8 +1097,9 @@ namespace netlist
 
 		/* stats */
 		nperftime_t  m_stat_total_time;
-		nperfcount_t m_stat_call_count;
+		plib::chrono::counter<true> m_stat_call_count;  /* always counted, see netlist_t::stats() */
 		nperfcount_t m_stat_inc_active;
+		nperfcount_t m_stat_suppressed;  /* input updates not delivered because the input was inactive */
 
 
 	protected:
@@ -1120,6 +1123,8 @@ namespace netlist
 		virtual void update_param() {}
 		virtual bool is_dynamic() const { return false; }
 		virtual bool is_timestep() const { return false; }
+		/* setup-time analysis: deactivation can only save work here, e.g. no output drives anything */
+		virtual bool deactivate_is_free() { return false; }
 		virtual bool needs_update_after_param_change() const { return false; }
 
 	private:
@@ -1298,6 +1303,13 @@ namespace netlist
 
 		plib::dynlib &lib() { return *m_lib; }
 
+		/* solvers compiled into the executable by "nltool -c static", used when NL_BOOSTLIB doesn't load */
+		void set_static_solver_lib(const plib::dynlib_static_sym *syms) { m_static_solver_syms = syms; }
+
+		/* runtime statistics since start or the last reset_stats() */
+		netlist_stats_t stats() const;
+		void reset_stats();
+
 		// FIXME: find something better
 		/* sole use is to manage lifetime of net objects */
 		std::vector<plib::owned_ptr<detail::net_t>> m_nets;
@@ -1336,14 +1348,17 @@ namespace netlist
 		std::unique_ptr<setup_t>            m_setup;
 		plib::plog_base<netlist_t, NL_DEBUG>           m_log;
 		std::unique_ptr<plib::dynlib>       m_lib; // external lib needs to be loaded as long as netlist exists
+		const plib::dynlib_static_sym *     m_static_solver_syms;
 
 		plib::state_manager_t               m_state;
 
 		// performance
 		nperftime_t     m_stat_mainloop;
-		nperfcount_t    m_perf_out_processed;
+		plib::chrono::counter<true> m_perf_out_processed;
+		plib::chrono::timer<plib::chrono::fast_ticks, true> m_stat_host_time;
 
 		std::vector<plib::owned_ptr<core_device_t>> m_devices;
+		std::unordered_map<const core_device_t *, pstring> m_device_family; /* factory name, for statistics */
 };
 
 	// -----------------------------------------------------------------------------
@@ -1416,16 +1431,26 @@ namespace netlist
 		}
 	}
 
+	inline void detail::net_t::count_suppressed() NL_NOEXCEPT
+	{
+		if (nperfcount_t::enabled)
+			for (auto & term : m_core_terms)
+				if (term->state() == logic_t::STATE_INP_PASSIVE)
+					term->device().m_stat_suppressed.inc();
+	}
+
 	inline void detail::net_t::push_to_queue(const netlist_time &delay) NL_NOEXCEPT
 	{
 		if ((num_cons() != 0))
 		{
 			if (is_queued())
-				netlist().queue().remove(this);
+				netlist().queue().remove(queue_t::entry_t(m_time, this));
 			m_time = netlist().time() + delay;
 			m_in_queue = (m_active > 0) ? QS_QUEUED : QS_DELAYED_DUE_TO_INACTIVE;    /* queued ? */
 			if (m_in_queue == QS_QUEUED)
 				netlist().queue().push(queue_t::entry_t(m_time, this));
+			else
+				count_suppressed();
 		}
 	}
 
@@ -25,11 +25,12 @@
  * Set to 1 to compile netlist with memory allocations from a
  * linear memory pool. This is based of the assumption that
  * due to enhanced locality there will be less cache misses.
- * Your mileage may vary.
- * This will cause crashes on OSX and thus is ignored on OSX.
+ * Devices and nets, which are created in netlist order, then
+ * sit next to each other and to the devices they connect.
+ * Set to 0 to use the global operator new for every object.
  *
  */
-#define USE_MEMPOOL                 (0)
+#define USE_MEMPOOL                 (1)
 
 /*
  * FIXME: Using truthtable is a lot slower than the explicit device
@@ -39,6 +39,8 @@
 // nld_solver.cpp
 
 #define MF_1_UNKNOWN_SOLVER_TYPE                "Unknown solver type: {1}"
+#define MF_1_UNKNOWN_SOLVER_PRECISION           "Unknown solver precision: {1}"
+#define MF_1_UNKNOWN_PRECONDITIONER             "Unknown preconditioner: {1}"
 #define MF_1_NETGROUP_SIZE_EXCEEDED_1           "Encountered netgroup with > {1} nets"
 
 #define MW_1_NO_SPECIFIC_SOLVER                 "No specific solver found for netlist of size {1}"
@@ -17,17 +17,20 @@
 #include "plib/ptypes.h"
 
 #include <atomic>
+#include <cstdint>
 #include <thread>
 #include <mutex>
 #include <algorithm>
+#include <limits>
 #include <utility>
+#include <vector>
 
 // ----------------------------------------------------------------------------------------
 // timed queue
 // ----------------------------------------------------------------------------------------
 
 /*
- * Use -DUSE_HEAP=1 to use stdc++ heap functions instead of linear processing.
+ * Use -DUSE_HEAP=1 to default to the stdc++ heap functions instead of linear processing.
  *
  * This slows down processing by about 25% on a Kaby Lake.
  */
@@ -99,14 +102,15 @@ namespace netlist
 		Element m_object;
 	};
 
-#if !USE_HEAP
-	/* Use TS = true for a threadsafe queue */
+	/* Sorted array, top at the end, with linear insertion.
+	 * Use TS = true for a threadsafe queue
+	 */
 	template <class T, bool TS, class QueueOp = typename T::QueueOp>
-	class timed_queue : plib::nocopyassignmove
+	class timed_queue_linear : plib::nocopyassignmove
 	{
 	public:
 
-		explicit timed_queue(const std::size_t list_size)
+		explicit timed_queue_linear(const std::size_t list_size)
 		: m_list(list_size)
 		{
 			clear();
@@ -204,9 +208,10 @@ namespace netlist
 		nperfcount_t m_prof_sortmove;
 		nperfcount_t m_prof_call;
 	};
-#else
+
+	/* Binary heap using the stdc++ heap functions */
 	template <class T, bool TS, class QueueOp = typename T::QueueOp>
-	class timed_queue : plib::nocopyassignmove
+	class timed_queue_heap : plib::nocopyassignmove
 	{
 	public:
 
@@ -215,13 +220,13 @@ namespace netlist
 			constexpr bool operator()(const T &a, const T &b) const { return QueueOp::less(b,a); }
 		};
 
-		explicit timed_queue(const std::size_t list_size)
+		explicit timed_queue_heap(const std::size_t list_size)
 		: m_list(list_size)
 		{
 			clear();
 		}
 
-		constexpr std::size_t capacity() const noexcept { return m_list.capacity(); }
+		constexpr std::size_t capacity() const noexcept { return m_list.size(); }
 		constexpr bool empty() const noexcept { return &m_list[0] == m_end; }
 
 		void push(T &&e) noexcept
@@ -277,14 +282,13 @@ namespace netlist
 		void clear()
 		{
 			tqlock lck(m_lock);
-			m_list.clear();
 			m_end = &m_list[0];
 		}
 
 		// save state support & mame disasm
 
 		constexpr const T *listptr() const { return &m_list[0]; }
-		constexpr std::size_t size() const noexcept { return m_list.size(); }
+		constexpr std::size_t size() const noexcept { return static_cast<std::size_t>(m_end - &m_list[0]); }
 		constexpr const T & operator[](const std::size_t index) const { return m_list[ 0 + index]; }
 	private:
 		using tqmutex = pspin_mutex<TS>;
@@ -299,7 +303,508 @@ namespace netlist
 		nperfcount_t m_prof_sortmove;
 		nperfcount_t m_prof_call;
 	};
-#endif
+
+	/* Calendar queue: event times hash into a ring of buckets, each a short
+	 * list sorted like the linear queue. The bucket count follows the queue
+	 * size and the bucket width follows the spacing of the events popped,
+	 * so push, pop and removing a queued net touch one bucket on average.
+	 *
+	 * Entries with equal times come out in the same order as from the
+	 * linear queue.
+	 */
+	template <class T, bool TS, class QueueOp = typename T::QueueOp>
+	class timed_queue_calendar : plib::nocopyassignmove
+	{
+	public:
+		static constexpr std::size_t MIN_BUCKETS = 64;       /* a power of two, and whole words of m_used */
+		static constexpr unsigned INITIAL_SHIFT = 4;       /* 16 time units per bucket */
+		static constexpr unsigned MAX_SHIFT = 40;
+		static constexpr std::size_t RETUNE_INTERVAL = 4096;  /* pop times between bucket width checks */
+
+		explicit timed_queue_calendar(const std::size_t list_size)
+		: m_buckets(MIN_BUCKETS)
+		, m_used(MIN_BUCKETS / 64, 0)
+		, m_mask(MIN_BUCKETS - 1)
+		, m_shift(INITIAL_SHIFT)
+		, m_size(0)
+		, m_base(0)
+		, m_cur(0)
+		, m_top(NO_TOP)
+		, m_never(QueueOp::never())
+		, m_retune_count(0)
+		, m_retune_start(0)
+		, m_last_pop(0)
+		{
+			for (auto &b : m_buckets)
+				b.reserve(list_size / MIN_BUCKETS + 1);
+		}
+
+		std::size_t capacity() const noexcept { return std::numeric_limits<std::size_t>::max(); }
+		bool empty() const noexcept { return m_size == 0; }
+
+		void push(T &&e) noexcept
+		{
+			/* Lock */
+			tqlock lck(m_lock);
+			const raw_t t = time_of(e);
+			if (m_size == 0 || t < m_base)
+				start_at(t);
+			const std::size_t i = bucket_of(t);
+			insert(i, std::move(e), false);
+			++m_size;
+			/* equal times pop newest first, so the new entry becomes top */
+			if (m_top != NO_TOP && t <= time_of(m_buckets[m_top].back()))
+				m_top = i;
+			m_prof_call.inc();
+			if (m_size > 2 * m_buckets.size())
+				rebuild(2 * m_buckets.size(), m_shift);
+		}
+
+		void pop() noexcept
+		{
+			if (m_top == NO_TOP)
+				find_top();
+			const raw_t t = time_of(m_buckets[m_top].back());
+			if (m_buckets[m_top].size() == 1)
+				mark(m_top, false);
+			m_buckets[m_top].pop_back();
+			m_top = NO_TOP;
+			--m_size;
+
+			/* events popped at the same time count once */
+			if (m_retune_count == 0)
+			{
+				m_retune_start = t;
+				m_retune_count = 1;
+			}
+			else if (t != m_last_pop && ++m_retune_count >= RETUNE_INTERVAL)
+				retune(t);
+			m_last_pop = t;
+
+			if (m_size < m_buckets.size() / 4 && m_buckets.size() > MIN_BUCKETS)
+				rebuild(m_buckets.size() / 2, m_shift);
+		}
+
+		const T &top() const noexcept
+		{
+			if (m_top == NO_TOP)
+			{
+				if (m_size == 0)
+					return m_never;
+				find_top();
+			}
+			return m_buckets[m_top].back();
+		}
+
+		/* nets are queued with their own time, so only their bucket is searched */
+		void remove(const T &elem) noexcept
+		{
+			/* Lock */
+			tqlock lck(m_lock);
+			if (!remove_from(bucket_of(time_of(elem)), elem))
+				remove_any(elem);
+		}
+
+		template <class R>
+		void remove(const R &elem) noexcept
+		{
+			/* Lock */
+			tqlock lck(m_lock);
+			remove_any(elem);
+		}
+
+		void retime(const T &elem) noexcept
+		{
+			/* Lock */
+			tqlock lck(m_lock);
+			/* the entry retimed is the end of the current time slice, so search forward from now */
+			for (std::size_t n = 0; n <= m_mask; n++)
+				if (remove_from((m_cur + n) & m_mask, elem))
+				{
+					const raw_t t = time_of(elem);
+					if (m_size == 0 || t < m_base)
+						start_at(t);
+					/* unlike a new entry, a retimed one goes behind those with the same time */
+					insert(bucket_of(t), T(elem), true);
+					++m_size;
+					return;
+				}
+		}
+
+		void clear()
+		{
+			tqlock lck(m_lock);
+			for (auto &b : m_buckets)
+				b.clear();
+			std::fill(m_used.begin(), m_used.end(), 0);
+			m_size = 0;
+			m_base = 0;
+			m_cur = 0;
+			m_top = NO_TOP;
+			m_retune_count = 0;
+		}
+
+		// save state support & mame disasm; entries are in bucket order, not time order
+
+		std::size_t size() const noexcept { return m_size; }
+		const T & operator[](std::size_t index) const noexcept
+		{
+			for (auto &b : m_buckets)
+			{
+				if (index < b.size())
+					return b[index];
+				index -= b.size();
+			}
+			return m_never;
+		}
+
+	private:
+		using tqmutex = pspin_mutex<TS>;
+		using tqlock = std::lock_guard<tqmutex>;
+		using raw_t = decltype(std::declval<T>().m_exec_time.as_raw());
+		using bucket_t = std::vector<T>;
+
+		static constexpr std::size_t NO_TOP = ~static_cast<std::size_t>(0);
+
+		static raw_t time_of(const T &e) noexcept { return e.m_exec_time.as_raw(); }
+		std::size_t bucket_of(const raw_t t) const noexcept { return static_cast<std::size_t>(t >> m_shift) & m_mask; }
+		raw_t width() const noexcept { return static_cast<raw_t>(1) << m_shift; }
+
+		/* scanning for the top starts at the bucket holding t */
+		void start_at(const raw_t t) const noexcept
+		{
+			m_base = t & ~(width() - 1);
+			m_cur = bucket_of(t);
+			m_top = NO_TOP;
+		}
+
+		/* sorted with the top at the end; late puts an entry behind those with the same time */
+		void insert(const std::size_t bucket, T &&e, bool late) noexcept
+		{
+			bucket_t &b = m_buckets[bucket];
+			mark(bucket, true);
+			b.emplace_back();
+			auto i = b.end() - 1;
+			for (; i != b.begin() && (late ? !QueueOp::less(e, *(i - 1)) : QueueOp::less(*(i - 1), e)); --i)
+			{
+				*i = std::move(*(i - 1));
+				m_prof_sortmove.inc();
+			}
+			*i = std::move(e);
+		}
+
+		template <class R>
+		bool remove_from(const std::size_t bucket, const R &elem) noexcept
+		{
+			bucket_t &b = m_buckets[bucket];
+			for (auto i = b.end(); i != b.begin(); )
+			{
+				--i;
+				if (QueueOp::equal(*i, elem))
+				{
+					b.erase(i);
+					if (b.empty())
+						mark(bucket, false);
+					--m_size;
+					m_top = NO_TOP;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		template <class R>
+		void remove_any(const R &elem) noexcept
+		{
+			for (std::size_t i = 0; i <= m_mask; i++)
+				if (remove_from(i, elem))
+					return;
+		}
+
+		void mark(const std::size_t bucket, const bool used) noexcept
+		{
+			const std::uint64_t bit = static_cast<std::uint64_t>(1) << (bucket & 63);
+			if (used)
+				m_used[bucket >> 6] |= bit;
+			else
+				m_used[bucket >> 6] &= ~bit;
+		}
+
+		static unsigned lowest_bit(const std::uint64_t w) noexcept
+		{
+			/* de Bruijn lookup of the lowest bit set */
+			static constexpr unsigned char table[64] =
+			{
+				 0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+				62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+				63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+				46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+			};
+			return table[((w & (~w + 1)) * UINT64_C(0x03f79d71b4cb0a89)) >> 58];
+		}
+
+		/* first bucket in use at or after i, wrapping round; the queue must not be empty */
+		std::size_t next_used(const std::size_t i) const noexcept
+		{
+			const std::size_t words = m_used.size();
+			std::size_t word = i >> 6;
+			std::uint64_t w = m_used[word] & (~static_cast<std::uint64_t>(0) << (i & 63));
+			for (std::size_t n = 0; w == 0 && n < words; n++)
+			{
+				word = (word + 1 == words) ? 0 : word + 1;
+				w = m_used[word];
+			}
+			return (word << 6) + lowest_bit(w);
+		}
+
+		/* walk the buckets in use a year ahead of the scan position, then fall back to a direct search */
+		void find_top() const noexcept
+		{
+			std::size_t travelled = 0;
+			while (true)
+			{
+				const std::size_t i = next_used(m_cur);
+				const std::size_t skip = (i - m_cur) & m_mask;
+				travelled += skip;
+				if (travelled > m_mask)
+					break;
+				m_cur = i;
+				m_base += static_cast<raw_t>(skip) << m_shift;
+				if (time_of(m_buckets[i].back()) < m_base + width())
+				{
+					m_top = i;
+					return;
+				}
+				/* everything here is a year or more ahead */
+				if (++travelled > m_mask)
+					break;
+				m_cur = (i + 1) & m_mask;
+				m_base += width();
+			}
+
+			std::size_t best = NO_TOP;
+			for (std::size_t word = 0; word < m_used.size(); word++)
+				for (std::uint64_t w = m_used[word]; w != 0; w &= w - 1)
+				{
+					const std::size_t i = (word << 6) + lowest_bit(w);
+					if (best == NO_TOP || QueueOp::less(m_buckets[i].back(), m_buckets[best].back()))
+						best = i;
+				}
+			start_at(time_of(m_buckets[best].back()));
+			m_top = best;
+		}
+
+		/* aim for a few events per bucket width along the time axis */
+		void retune(const raw_t t) noexcept
+		{
+			const raw_t gap = (t > m_retune_start) ? (t - m_retune_start) / static_cast<raw_t>(m_retune_count) : 0;
+			m_retune_count = 0;
+			unsigned shift = 0;
+			while (shift < MAX_SHIFT && (static_cast<raw_t>(1) << shift) < 4 * gap)
+				shift++;
+			if (shift != m_shift)
+				rebuild(m_buckets.size(), shift);
+		}
+
+		void rebuild(const std::size_t buckets, const unsigned shift) noexcept
+		{
+			std::vector<bucket_t> old(buckets);
+			std::swap(old, m_buckets);
+			m_used.assign(buckets / 64, 0);
+			m_mask = buckets - 1;
+			m_shift = shift;
+			const raw_t base = m_base;
+			start_at(base);
+			/* oldest first within each bucket keeps the order of equal times */
+			for (auto &b : old)
+				for (auto &e : b)
+				{
+					const raw_t t = time_of(e);
+					insert(bucket_of(t), std::move(e), false);
+				}
+		}
+
+		tqmutex m_lock;
+		std::vector<bucket_t> m_buckets;
+		std::vector<std::uint64_t> m_used;  /* a bit per bucket holding entries */
+		std::size_t m_mask;
+		unsigned m_shift;                   /* log2 of the bucket width */
+		std::size_t m_size;
+		mutable raw_t m_base;               /* start time of the bucket at m_cur; no entry is earlier */
+		mutable std::size_t m_cur;
+		mutable std::size_t m_top;          /* bucket holding the top, if known */
+		const T m_never;
+		std::size_t m_retune_count;
+		raw_t m_retune_start;
+		raw_t m_last_pop;
+
+	public:
+		// profiling
+		nperfcount_t m_prof_sortmove;
+		nperfcount_t m_prof_call;
+	};
+
+	/* The queue used by the netlist. The implementation can be picked at run
+	 * time, before the queue is first used, to compare them:
+	 *
+	 * LINEAR   the sorted array above, the default
+	 * HEAP     the stdc++ heap, the default with -DUSE_HEAP=1
+	 * CALENDAR the calendar queue
+	 */
+	enum class queue_type
+	{
+		LINEAR,
+		HEAP,
+		CALENDAR
+	};
+
+	template <class T, bool TS, class QueueOp = typename T::QueueOp>
+	class timed_queue : plib::nocopyassignmove
+	{
+	public:
+
+		explicit timed_queue(const std::size_t list_size)
+		: m_type(USE_HEAP ? queue_type::HEAP : queue_type::LINEAR)
+		, m_linear(list_size)
+		, m_heap(list_size)
+		, m_calendar(list_size)
+		{
+		}
+
+		queue_type type() const noexcept { return m_type; }
+		void set_type(const queue_type type)
+		{
+			clear();
+			m_type = type;
+		}
+
+		std::size_t capacity() const noexcept
+		{
+			switch (m_type)
+			{
+				case queue_type::LINEAR: return m_linear.capacity();
+				case queue_type::HEAP: return m_heap.capacity();
+				default: return m_calendar.capacity();
+			}
+		}
+
+		bool empty() const noexcept
+		{
+			switch (m_type)
+			{
+				case queue_type::LINEAR: return m_linear.empty();
+				case queue_type::HEAP: return m_heap.empty();
+				default: return m_calendar.empty();
+			}
+		}
+
+		void push(T &&e) noexcept
+		{
+			m_stat_push.inc();
+			switch (m_type)
+			{
+				case queue_type::LINEAR: m_linear.push(std::move(e)); break;
+				case queue_type::HEAP: m_heap.push(std::move(e)); break;
+				default: m_calendar.push(std::move(e)); break;
+			}
+		}
+
+		void pop() noexcept
+		{
+			m_stat_pop.inc();
+			switch (m_type)
+			{
+				case queue_type::LINEAR: m_linear.pop(); break;
+				case queue_type::HEAP: m_heap.pop(); break;
+				default: m_calendar.pop(); break;
+			}
+		}
+
+		const T &top() const noexcept
+		{
+			switch (m_type)
+			{
+				case queue_type::LINEAR: return m_linear.top();
+				case queue_type::HEAP: return m_heap.top();
+				default: return m_calendar.top();
+			}
+		}
+
+		template <class R>
+		void remove(const R &elem) noexcept
+		{
+			switch (m_type)
+			{
+				case queue_type::LINEAR: m_linear.remove(elem); break;
+				case queue_type::HEAP: m_heap.remove(elem); break;
+				default: m_calendar.remove(elem); break;
+			}
+		}
+
+		void retime(const T &elem) noexcept
+		{
+			switch (m_type)
+			{
+				case queue_type::LINEAR: m_linear.retime(elem); break;
+				case queue_type::HEAP: m_heap.retime(elem); break;
+				default: m_calendar.retime(elem); break;
+			}
+		}
+
+		void clear()
+		{
+			m_linear.clear();
+			m_heap.clear();
+			m_calendar.clear();
+		}
+
+		// save state support & mame disasm
+
+		std::size_t size() const noexcept
+		{
+			switch (m_type)
+			{
+				case queue_type::LINEAR: return m_linear.size();
+				case queue_type::HEAP: return m_heap.size();
+				default: return m_calendar.size();
+			}
+		}
+
+		const T & operator[](const std::size_t index) const noexcept
+		{
+			switch (m_type)
+			{
+				case queue_type::LINEAR: return m_linear[index];
+				case queue_type::HEAP: return m_heap[index];
+				default: return m_calendar[index];
+			}
+		}
+
+		// profiling
+
+		nperfcount_t::type prof_call() const noexcept
+		{
+			return m_linear.m_prof_call() + m_heap.m_prof_call() + m_calendar.m_prof_call();
+		}
+
+		nperfcount_t::type prof_sortmove() const noexcept
+		{
+			return m_linear.m_prof_sortmove() + m_heap.m_prof_sortmove() + m_calendar.m_prof_sortmove();
+		}
+
+		/* always counted, see netlist_t::stats() */
+		uint_least64_t pushes() const noexcept { return m_stat_push(); }
+		uint_least64_t pops() const noexcept { return m_stat_pop(); }
+		void reset_stats() noexcept { m_stat_push.reset(); m_stat_pop.reset(); }
+
+	private:
+		plib::chrono::counter<true> m_stat_push;
+		plib::chrono::counter<true> m_stat_pop;
+		queue_type m_type;
+		timed_queue_linear<T, TS, QueueOp> m_linear;
+		timed_queue_heap<T, TS, QueueOp> m_heap;
+		timed_queue_calendar<T, TS, QueueOp> m_calendar;
+	};
 }
 
 #endif /* NLLISTS_H_ */
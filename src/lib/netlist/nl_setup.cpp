@@ -17,6 +17,8 @@
 #include "solver/nld_solver.h"
 #include "devices/nlid_truthtable.h"
 
+#include <unordered_set>
+
 // ----------------------------------------------------------------------------------------
 // setup_t
 // ----------------------------------------------------------------------------------------
@@ -68,6 +70,7 @@ void setup_t::namespace_pop()
 
 void setup_t::register_lib_entry(const pstring &name, const pstring &sourcefile)
 {
+	m_lib_entries.push_back(std::pair<pstring, pstring>(name, sourcefile));
 	factory().register_device(plib::make_unique_base<factory::element_t, factory::library_element_t>(*this, name, name, "", sourcefile));
 }
 
@@ -925,9 +928,463 @@ const logic_family_desc_t *setup_t::family_from_model(const pstring &model)
 
 void setup_t::tt_factory_create(tt_desc &desc, const pstring &sourcefile)
 {
+	m_tt_descs.push_back(std::pair<tt_desc, pstring>(desc, sourcefile));
 	devices::tt_factory_create(*this, desc, sourcefile);
 }
 
+// ----------------------------------------------------------------------------------------
+// Truthtable merging
+// ----------------------------------------------------------------------------------------
+
+namespace
+{
+	constexpr std::size_t npos = plib::container::npos;
+
+	/* a combinational truthtable device with its table expanded */
+	struct tt_gate_t
+	{
+		std::size_t dev;                        /* index into m_device_factory */
+		const devices::netlist_base_factory_truthtable_t *f;
+		std::vector<pstring> inputs;
+		std::vector<pstring> outputs;
+		std::vector<uint_least64_t> out;        /* output bits by input state */
+		std::vector<unsigned> delay;            /* ns, by input state and output */
+		std::vector<std::size_t> in_net;
+		std::vector<std::size_t> out_net;       /* npos if not connected */
+		std::size_t cluster;
+	};
+
+	struct tt_net_t
+	{
+		std::vector<pstring> terms;
+		std::size_t drivers = 0;                /* outputs of candidate gates */
+		std::size_t driver = npos;
+		std::vector<std::size_t> consumers;     /* candidate gates with an input here */
+		bool foreign = false;                   /* any other terminal */
+	};
+
+	struct tt_cluster_t
+	{
+		std::vector<std::size_t> members;       /* in evaluation order */
+		std::vector<std::size_t> in_nets;
+		std::vector<std::size_t> out_nets;
+	};
+
+	pstring join(const std::vector<pstring> &elems)
+	{
+		pstring ret("");
+		for (std::size_t i = 0; i < elems.size(); i++)
+		{
+			if (i > 0)
+				ret += ",";
+			ret += elems[i];
+		}
+		return ret;
+	}
+
+	/* expand the TT_LINEs the way truthtable_parser does; false for anything sequential or odd */
+	bool tt_expand(tt_gate_t &g)
+	{
+		const std::vector<pstring> &desc = g.f->m_desc;
+		std::vector<pstring> io(plib::psplit(desc[0], "|"));
+		if (io.size() != 2)
+			return false;
+		for (auto &s : plib::psplit(io[0], ","))
+			g.inputs.push_back(s.trim());
+		for (auto &s : plib::psplit(io[1], ","))
+			g.outputs.push_back(s.trim());
+		for (auto &s : g.inputs)
+			if (s.startsWith("_"))
+				return false;
+
+		const std::size_t ni = g.inputs.size();
+		const std::size_t no = g.outputs.size();
+		const std::size_t size = static_cast<std::size_t>(1) << ni;
+		std::vector<bool> set(size, false);
+		g.out.resize(size, 0);
+		g.delay.resize(size * no, 0);
+
+		for (std::size_t l = 1; l < desc.size() && !desc[l].equals(""); l++)
+		{
+			std::vector<pstring> line(plib::psplit(desc[l], "|"));
+			if (line.size() != 3)
+				return false;
+			std::vector<pstring> in(plib::psplit(line[0], ","));
+			std::vector<pstring> out(plib::psplit(line[1], ","));
+			std::vector<pstring> times(plib::psplit(line[2], ","));
+			if (in.size() != ni || out.size() != no || times.size() != no)
+				return false;
+
+			uint_least64_t val = 0;
+			for (std::size_t j = 0; j < no; j++)
+				if (out[j].trim().equals("1"))
+					val |= static_cast<uint_least64_t>(1) << j;
+				else if (!out[j].trim().equals("0"))
+					return false;
+
+			for (std::size_t s = 0; s < size; s++)
+			{
+				bool match = true;
+				for (std::size_t i = 0; i < ni && match; i++)
+				{
+					const pstring v = in[i].trim();
+					match = v.equals("X") || v.equals(((s >> i) & 1) ? "1" : "0");
+				}
+				if (!match)
+					continue;
+				set[s] = true;
+				g.out[s] = val;
+				for (std::size_t j = 0; j < no; j++)
+					g.delay[s * no + j] = static_cast<unsigned>(times[j].trim().as_long());
+			}
+		}
+		return std::find(set.begin(), set.end(), false) == set.end();
+	}
+}
+
+void setup_t::merge_truthtables(std::size_t max_inputs)
+{
+	static constexpr std::size_t MAX_OUTPUTS = 8;   /* tt_factory_create limits */
+	static constexpr std::size_t MAX_INPUTS = 12;
+	static constexpr std::size_t MAX_DELAYS = 15;   /* nld_truthtable_t timing slots */
+
+	max_inputs = std::min(max_inputs, MAX_INPUTS);
+
+	/* candidates and their pins */
+
+	struct pin_t { std::size_t gate; std::size_t pin; bool output; };
+	std::vector<tt_gate_t> gates;
+	std::unordered_map<pstring, pin_t> pins;
+
+	for (std::size_t d = 0; d < m_device_factory.size(); d++)
+	{
+		auto f = dynamic_cast<const devices::netlist_base_factory_truthtable_t *>(m_device_factory[d].second);
+		if (f == nullptr)
+			continue;
+		tt_gate_t g;
+		g.dev = d;
+		g.f = f;
+		g.cluster = gates.size();
+		if (!tt_expand(g))
+			continue;
+		const pstring &name = m_device_factory[d].first;
+		for (std::size_t i = 0; i < g.inputs.size(); i++)
+			pins.insert({name + "." + g.inputs[i], pin_t{gates.size(), i, false}});
+		for (std::size_t i = 0; i < g.outputs.size(); i++)
+			pins.insert({name + "." + g.outputs[i], pin_t{gates.size(), i, true}});
+		gates.push_back(std::move(g));
+	}
+	if (gates.size() < 2)
+		return;
+
+	/* nets, as the links will make them */
+
+	std::unordered_map<pstring, std::size_t> term_id;
+	std::vector<pstring> term_name;
+	std::vector<std::size_t> parent;
+
+	auto find = [&parent](std::size_t x)
+	{
+		while (parent[x] != x)
+			x = parent[x] = parent[parent[x]];
+		return x;
+	};
+	auto id = [&](const pstring &name_in)
+	{
+		pstring name = resolve_alias(name_in);
+		/* find_terminal looks for "name.Q" as well */
+		if (pins.find(name) == pins.end() && pins.find(name + ".Q") != pins.end())
+			name = name + ".Q";
+		auto p = term_id.insert({name, term_name.size()});
+		if (p.second)
+		{
+			term_name.push_back(name);
+			parent.push_back(parent.size());
+		}
+		return p.first->second;
+	};
+
+	for (auto &l : m_links)
+	{
+		const std::size_t a = find(id(l.first));
+		const std::size_t b = find(id(l.second));
+		parent[a] = b;
+	}
+
+	std::vector<std::size_t> net_of(term_name.size());
+	std::vector<tt_net_t> nets;
+	{
+		std::unordered_map<std::size_t, std::size_t> root_net;
+		for (std::size_t t = 0; t < term_name.size(); t++)
+		{
+			auto p = root_net.insert({find(t), nets.size()});
+			if (p.second)
+				nets.emplace_back();
+			net_of[t] = p.first->second;
+			nets[net_of[t]].terms.push_back(term_name[t]);
+		}
+	}
+
+	std::vector<bool> candidate(gates.size(), true);
+	for (auto &g : gates)
+	{
+		const pstring &name = m_device_factory[g.dev].first;
+		for (auto &pin : g.inputs)
+		{
+			auto t = term_id.find(name + "." + pin);
+			g.in_net.push_back(t == term_id.end() ? npos : net_of[t->second]);
+		}
+		for (auto &pin : g.outputs)
+		{
+			auto t = term_id.find(name + "." + pin);
+			g.out_net.push_back(t == term_id.end() ? npos : net_of[t->second]);
+		}
+		/* leave unconnected inputs to resolve_inputs to complain about */
+		if (std::find(g.in_net.begin(), g.in_net.end(), npos) != g.in_net.end())
+			candidate[g.cluster] = false;
+	}
+
+	for (auto &n : nets)
+		for (auto &t : n.terms)
+		{
+			auto p = pins.find(t);
+			if (p == pins.end() || !candidate[p->second.gate])
+				n.foreign = true;
+			else if (p->second.output)
+			{
+				n.drivers++;
+				n.driver = p->second.gate;
+			}
+			else if (!plib::container::contains(n.consumers, p->second.gate))
+				n.consumers.push_back(p->second.gate);
+		}
+
+	/* clusters */
+
+	auto root = [&gates](std::size_t g)
+	{
+		while (gates[g].cluster != g)
+			g = gates[g].cluster = gates[gates[g].cluster].cluster;
+		return g;
+	};
+
+	std::vector<bool> member(gates.size(), false);
+
+	/* inputs, outputs and evaluation order of the gates flagged in member, false if not combinational */
+	auto build = [&](tt_cluster_t &c, const std::vector<std::size_t> &members)
+	{
+		c.in_nets.clear();
+		c.out_nets.clear();
+		c.members.clear();
+		for (auto g : members)
+		{
+			for (auto n : gates[g].in_net)
+				if ((nets[n].drivers != 1 || !member[nets[n].driver]) && !plib::container::contains(c.in_nets, n))
+					c.in_nets.push_back(n);
+			for (auto n : gates[g].out_net)
+			{
+				if (n == npos)
+					continue;
+				if (nets[n].drivers != 1)
+					return false;
+				bool external = nets[n].foreign;
+				for (auto cg : nets[n].consumers)
+					external = external || !member[cg];
+				if (external)
+					c.out_nets.push_back(n);
+			}
+		}
+		/* Kahn: a gate is ready once all gates driving it are placed */
+		std::vector<std::size_t> pending(members);
+		while (!pending.empty())
+		{
+			auto ready = std::find_if(pending.begin(), pending.end(), [&](std::size_t g)
+			{
+				for (auto n : gates[g].in_net)
+					if (nets[n].drivers == 1 && member[nets[n].driver]
+							&& !plib::container::contains(c.members, nets[n].driver))
+						return false;
+				return true;
+			});
+			if (ready == pending.end())
+				return false;
+			c.members.push_back(*ready);
+			pending.erase(ready);
+		}
+		return c.in_nets.size() <= max_inputs && c.out_nets.size() >= 1 && c.out_nets.size() <= MAX_OUTPUTS;
+	};
+
+	auto members_of = [&](const std::vector<std::size_t> &roots)
+	{
+		std::vector<std::size_t> ret;
+		for (std::size_t g = 0; g < gates.size(); g++)
+		{
+			member[g] = plib::container::contains(roots, root(g));
+			if (member[g])
+				ret.push_back(g);
+		}
+		return ret;
+	};
+
+	/* grow clusters greedily along the nets between candidate gates */
+	for (auto &n : nets)
+	{
+		if (n.drivers != 1 || n.consumers.empty())
+			continue;
+		std::vector<std::size_t> roots;
+		roots.push_back(root(n.driver));
+		for (auto g : n.consumers)
+			if (gates[g].f->m_family == gates[n.driver].f->m_family && !plib::container::contains(roots, root(g)))
+				roots.push_back(root(g));
+		if (roots.size() < 2)
+			continue;
+		tt_cluster_t c;
+		if (build(c, members_of(roots)))
+			for (auto r : roots)
+				gates[r].cluster = roots[0];
+	}
+
+	/* synthesise a truthtable for every cluster */
+
+	std::vector<tt_cluster_t> clusters;
+	std::vector<pstring> cluster_dev;
+	std::vector<std::size_t> gate_cluster(gates.size(), npos);
+	std::vector<int> val(nets.size(), 0);
+	std::vector<unsigned> arrival(nets.size(), 0);
+
+	for (std::size_t r = 0; r < gates.size(); r++)
+	{
+		if (root(r) != r)
+			continue;
+		std::vector<std::size_t> members(members_of(std::vector<std::size_t>(1, r)));
+		tt_cluster_t c;
+		if (members.size() < 2 || !build(c, members))
+			continue;
+
+		const std::size_t ni = c.in_nets.size();
+		const std::size_t no = c.out_nets.size();
+		std::vector<pstring> inames, onames;
+		for (std::size_t i = 0; i < ni; i++)
+			inames.push_back(plib::pfmt("I{1}")(i + 1));
+		for (std::size_t i = 0; i < no; i++)
+			onames.push_back(plib::pfmt("Q{1}")(i + 1));
+
+		std::vector<pstring> desc;
+		desc.push_back(join(inames) + "|" + join(onames));
+		std::vector<unsigned> delays;
+		for (std::size_t s = 0; s < (static_cast<std::size_t>(1) << ni); s++)
+		{
+			std::vector<pstring> ins, outs, times;
+			for (std::size_t i = 0; i < ni; i++)
+			{
+				val[c.in_nets[i]] = (s >> i) & 1;
+				arrival[c.in_nets[i]] = 0;
+				ins.push_back(val[c.in_nets[i]] ? "1" : "0");
+			}
+			/* each gate switches the maximum path delay after its inputs */
+			for (auto g : c.members)
+			{
+				const tt_gate_t &gt = gates[g];
+				std::size_t state = 0;
+				unsigned t = 0;
+				for (std::size_t i = 0; i < gt.in_net.size(); i++)
+				{
+					state |= static_cast<std::size_t>(val[gt.in_net[i]]) << i;
+					t = std::max(t, arrival[gt.in_net[i]]);
+				}
+				for (std::size_t j = 0; j < gt.out_net.size(); j++)
+					if (gt.out_net[j] != npos)
+					{
+						val[gt.out_net[j]] = (gt.out[state] >> j) & 1;
+						arrival[gt.out_net[j]] = t + gt.delay[state * gt.out_net.size() + j];
+					}
+			}
+			for (auto n : c.out_nets)
+			{
+				outs.push_back(val[n] ? "1" : "0");
+				times.push_back(plib::pfmt("{1}")(arrival[n]));
+				if (!plib::container::contains(delays, arrival[n]))
+					delays.push_back(arrival[n]);
+			}
+			desc.push_back(join(ins) + "|" + join(outs) + "|" + join(times));
+		}
+		if (delays.size() > MAX_DELAYS)
+		{
+			log().verbose("Not merging {1} truthtables: {2} different delays", members.size(), delays.size());
+			continue;
+		}
+
+		tt_desc d;
+		d.name = plib::pfmt("TTMERGE_{1}")(clusters.size());
+		d.classname = d.name;
+		d.ni = ni;
+		d.no = no;
+		d.def_param = "";
+		d.desc = desc;
+		devices::tt_factory_create(*this, d, "merge_truthtables");
+		auto f = dynamic_cast<devices::netlist_base_factory_truthtable_t *>(factory().factory_by_name(d.name));
+		f->m_family = gates[r].f->m_family;
+
+		pstring devname = plib::pfmt("ttmerge_{1}")(clusters.size());
+		log().verbose("Merging {1} truthtables with {2} inputs and {3} outputs into {4}", members.size(), ni, no, devname);
+		for (auto g : members)
+			gate_cluster[g] = clusters.size();
+		clusters.push_back(c);
+		cluster_dev.push_back(devname);
+	}
+
+	if (clusters.empty())
+		return;
+
+	/* replace the gates and move their links over to the merged devices, in the original order */
+
+	std::vector<bool> removed(m_device_factory.size(), false);
+	for (std::size_t g = 0; g < gates.size(); g++)
+		if (gate_cluster[g] != npos)
+			removed[gates[g].dev] = true;
+
+	/* the pin taking over a terminal, "" if it disappears with an internal net */
+	auto relink = [&](const pstring &name) -> pstring
+	{
+		const std::size_t t = id(name);
+		auto p = pins.find(term_name[t]);
+		if (p == pins.end() || gate_cluster[p->second.gate] == npos)
+			return name;
+		const std::size_t c = gate_cluster[p->second.gate];
+		/* an input on a net the cluster drives stands for its output */
+		std::size_t i = plib::container::indexof(clusters[c].out_nets, net_of[t]);
+		if (i != npos)
+			return plib::pfmt("{1}.Q{2}")(cluster_dev[c])(i + 1);
+		i = plib::container::indexof(clusters[c].in_nets, net_of[t]);
+		if (i != npos)
+			return plib::pfmt("{1}.I{2}")(cluster_dev[c])(i + 1);
+		return pstring("");
+	};
+
+	/* gates sharing an input now share a pin, and an input must not be linked to a rail twice */
+	std::vector<link_t> links;
+	std::unordered_set<pstring> seen;
+	for (auto &l : m_links)
+	{
+		const pstring t1 = relink(l.first);
+		const pstring t2 = relink(l.second);
+		if (t1.equals("") || t2.equals("") || t1.equals(t2))
+			continue;
+		if (seen.insert(t1 + " " + t2).second && seen.insert(t2 + " " + t1).second)
+			links.push_back(link_t(t1, t2));
+	}
+	m_links = std::move(links);
+
+	std::vector<std::pair<pstring, factory::element_t *>> devs;
+	for (std::size_t d = 0; d < m_device_factory.size(); d++)
+		if (!removed[d])
+			devs.push_back(m_device_factory[d]);
+	for (std::size_t c = 0; c < clusters.size(); c++)
+		devs.push_back(std::pair<pstring, factory::element_t *>(cluster_dev[c],
+				factory().factory_by_name(plib::pfmt("TTMERGE_{1}")(c))));
+	m_device_factory = std::move(devs);
+}
+
 
 // ----------------------------------------------------------------------------------------
 // Sources
@@ -979,6 +1436,179 @@ void setup_t::register_define(pstring defstr)
 		register_define(defstr, "1");
 }
 
+// ----------------------------------------------------------------------------------------
+// Cache
+// ----------------------------------------------------------------------------------------
+
+static constexpr unsigned CACHE_MAGIC = 0x434c4e00; // "\0NLC"
+static constexpr unsigned CACHE_VERSION = 1;        // bump whenever the layout below changes
+
+static void write_map(plib::pbinary_writer &w, const std::unordered_map<pstring, pstring> &map)
+{
+	w.write(map.size());
+	for (auto &e : map)
+	{
+		w.write(e.first);
+		w.write(e.second);
+	}
+}
+
+static void read_map(plib::pbinary_reader &r, std::unordered_map<pstring, pstring> &map)
+{
+	std::size_t n = 0;
+	r.read(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		pstring k, v;
+		r.read(k);
+		r.read(v);
+		map[k] = v;
+	}
+}
+
+void setup_t::save_cache(plib::postream &strm, const pstring &key) const
+{
+	plib::pbinary_writer w(strm);
+
+	w.write(CACHE_MAGIC);
+	w.write(CACHE_VERSION);
+	w.write(key);
+
+	w.write(m_lib_entries.size());
+	for (auto &e : m_lib_entries)
+	{
+		w.write(e.first);
+		w.write(e.second);
+	}
+
+	/* truthtable families refer to models */
+	write_map(w, m_models);
+
+	w.write(m_tt_descs.size());
+	for (auto &e : m_tt_descs)
+	{
+		const tt_desc &d = e.first;
+		w.write(d.name);
+		w.write(d.classname);
+		w.write(d.ni);
+		w.write(d.no);
+		w.write(d.def_param);
+		w.write(d.desc.size());
+		for (auto &l : d.desc)
+			w.write(l);
+		w.write(d.family);
+		w.write(e.second);
+	}
+
+	write_map(w, m_alias);
+	write_map(w, m_param_values);
+
+	w.write(m_links.size());
+	for (auto &l : m_links)
+	{
+		w.write(l.first);
+		w.write(l.second);
+	}
+
+	w.write(m_device_factory.size());
+	for (auto &e : m_device_factory)
+	{
+		w.write(e.first);
+		w.write(e.second->name());
+	}
+
+	w.write(m_frontier_cnt);
+}
+
+bool setup_t::load_cache(plib::pistream &strm, const pstring &key)
+{
+	plib::pbinary_reader r(strm);
+
+	unsigned magic = 0;
+	unsigned version = 0;
+	pstring ckey;
+	r.read(magic);
+	r.read(version);
+	if (magic != CACHE_MAGIC || version != CACHE_VERSION)
+		return false;
+	r.read(ckey);
+	if (ckey != key)
+		return false;
+
+	/* the cache starts with what the base netlist registered in the
+	 * constructor, in the same order; skip what this setup already has
+	 */
+	const std::size_t base_lib = m_lib_entries.size();
+	const std::size_t base_tt = m_tt_descs.size();
+	const std::size_t base_links = m_links.size();
+	const std::size_t base_devs = m_device_factory.size();
+
+	std::size_t n = 0;
+	r.read(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		pstring name, sourcefile;
+		r.read(name);
+		r.read(sourcefile);
+		if (i >= base_lib)
+			register_lib_entry(name, sourcefile);
+	}
+
+	read_map(r, m_models);
+
+	r.read(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		tt_desc d;
+		pstring sourcefile;
+		std::size_t lines = 0;
+		r.read(d.name);
+		r.read(d.classname);
+		r.read(d.ni);
+		r.read(d.no);
+		r.read(d.def_param);
+		r.read(lines);
+		d.desc.resize(lines);
+		for (auto &l : d.desc)
+			r.read(l);
+		r.read(d.family);
+		r.read(sourcefile);
+		if (i >= base_tt)
+			tt_factory_create(d, sourcefile);
+	}
+
+	read_map(r, m_alias);
+	read_map(r, m_param_values);
+
+	r.read(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		pstring sin, sout;
+		r.read(sin);
+		r.read(sout);
+		if (i >= base_links)
+			m_links.push_back(link_t(sin, sout));
+	}
+
+	/* library entries were expanded when the cache was written, so no macro_actions here */
+	r.read(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		pstring name, classname;
+		r.read(name);
+		r.read(classname);
+		if (i < base_devs)
+			continue;
+		auto f = factory().factory_by_name(classname);
+		if (f == nullptr)
+			log().fatal(MF_1_CLASS_1_NOT_FOUND, classname);
+		m_device_factory.push_back(std::pair<pstring, factory::element_t *>(name, f));
+	}
+
+	r.read(m_frontier_cnt);
+	return true;
+}
+
 // ----------------------------------------------------------------------------------------
 // base sources
 // ----------------------------------------------------------------------------------------
@@ -271,6 +271,17 @@ namespace netlist
 		void register_define(pstring def, pstring val) { m_defines.push_back(plib::ppreprocessor::define_t(def, val)); }
 		void register_define(pstring defstr);
 
+		/* binary cache of what include() registered
+		 *
+		 * Saves devices, parameters, links, aliases, models, truthtables and
+		 * library entries. load_cache() rebuilds them without parsing if the
+		 * cache was written with the same key, else returns false and leaves
+		 * the setup untouched. Call it on a fresh setup in place of include().
+		 */
+
+		void save_cache(plib::postream &strm, const pstring &key) const;
+		bool load_cache(plib::pistream &strm, const pstring &key);
+
 		factory::list_t &factory() { return m_factory; }
 		const factory::list_t &factory() const { return m_factory; }
 
@@ -285,6 +296,11 @@ namespace netlist
 
 		void tt_factory_create(tt_desc &desc, const pstring &sourcefile);
 
+		/* replace clusters of combinational truthtables with up to max_inputs
+		 * inputs by one truthtable each, see NETLIST.TT_MERGE
+		 */
+		void merge_truthtables(std::size_t max_inputs);
+
 		/* helper - also used by nltool */
 		const pstring resolve_alias(const pstring &name) const;
 
@@ -328,6 +344,10 @@ namespace netlist
 		source_t::list_t                            m_sources;
 		std::vector<plib::ppreprocessor::define_t>  m_defines;
 
+		/* recorded for save_cache */
+		std::vector<std::pair<tt_desc, pstring>>    m_tt_descs;
+		std::vector<std::pair<pstring, pstring>>    m_lib_entries;
+
 		unsigned m_proxy_cnt;
 		unsigned m_frontier_cnt;
 };
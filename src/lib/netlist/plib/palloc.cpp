@@ -18,7 +18,7 @@ namespace plib {
 //============================================================
 
 mempool::mempool(size_t min_alloc, size_t min_align)
-: m_min_alloc(min_alloc), m_min_align(min_align)
+: m_min_alloc(min_alloc), m_min_align(min_align), m_current(0)
 {
 }
 mempool::~mempool()
@@ -34,15 +34,22 @@ mempool::~mempool()
 	m_blocks.clear();
 }
 
-size_t mempool::new_block()
+size_t mempool::new_block(size_t size)
 {
-	block b;
-	b.data = static_cast<char *>(::operator new(m_min_alloc));
+	/* slots of released oversized blocks are reused */
+	size_t bn = 0;
+	while (bn < m_blocks.size() && m_blocks[bn].data != nullptr)
+		bn++;
+	if (bn == m_blocks.size())
+		m_blocks.push_back(block());
+
+	block &b = m_blocks[bn];
+	b.data = static_cast<char *>(::operator new(size));
 	b.cur_ptr = b.data;
-	b.m_free = m_min_alloc;
+	b.m_size = size;
+	b.m_free = size;
 	b.m_num_alloc = 0;
-	m_blocks.push_back(b);
-	return m_blocks.size() - 1;
+	return bn;
 }
 
 size_t mempool::mininfosize()
@@ -58,48 +65,62 @@ size_t mempool::mininfosize()
 
 void *mempool::alloc(size_t size)
 {
+	std::lock_guard<std::mutex> lock(m_lock);
+
 	size_t rs = (size + mininfosize() + m_min_align - 1) & ~(m_min_align - 1);
-	for (size_t bn=0; bn < m_blocks.size(); bn++)
-	{
-		auto &b = m_blocks[bn];
-		if (b.m_free > rs)
-		{
-			b.m_free -= rs;
-			b.m_num_alloc++;
-			auto i = reinterpret_cast<info *>(b.cur_ptr);
-			i->m_block = bn;
-			auto ret = reinterpret_cast<void *>(b.cur_ptr + mininfosize());
-			b.cur_ptr += rs;
-			return ret;
-		}
-	}
+	size_t bn;
+
+	if (rs > m_min_alloc)
+		bn = new_block(rs);
+	else if (m_current < m_blocks.size() && m_blocks[m_current].m_free >= rs)
+		bn = m_current;
+	else
 	{
-		size_t bn = new_block();
-		auto &b = m_blocks[bn];
-		b.m_num_alloc = 1;
-		b.m_free = m_min_alloc - rs;
-		auto i = reinterpret_cast<info *>(b.cur_ptr);
-		i->m_block = bn;
-		auto ret = reinterpret_cast<void *>(b.cur_ptr + mininfosize());
-		b.cur_ptr += rs;
-		return ret;
+		/* an emptied block before a new one */
+		bn = 0;
+		while (bn < m_blocks.size() && !(m_blocks[bn].m_num_alloc == 0 && m_blocks[bn].m_size == m_min_alloc))
+			bn++;
+		if (bn == m_blocks.size())
+			bn = new_block(m_min_alloc);
+		m_current = bn;
 	}
+
+	auto &b = m_blocks[bn];
+	b.m_free -= rs;
+	b.m_num_alloc++;
+	auto i = reinterpret_cast<info *>(b.cur_ptr);
+	i->m_block = bn;
+	auto ret = reinterpret_cast<void *>(b.cur_ptr + mininfosize());
+	b.cur_ptr += rs;
+	return ret;
 }
 
 void mempool::free(void *ptr)
 {
+	std::lock_guard<std::mutex> lock(m_lock);
+
 	auto p = reinterpret_cast<char *>(ptr);
 
 	auto i = reinterpret_cast<info *>(p - mininfosize());
 	block *b = &m_blocks[i->m_block];
 	if (b->m_num_alloc == 0)
+	{
 		fprintf(stderr, "Argh .. double free\n");
-	else
+		return;
+	}
+	if (--b->m_num_alloc == 0)
 	{
-		//b->m_free = m_min_alloc;
-		//b->cur_ptr = b->data;
+		if (b->m_size == m_min_alloc)
+		{
+			b->cur_ptr = b->data;
+			b->m_free = b->m_size;
+		}
+		else
+		{
+			::operator delete(b->data);
+			*b = block();
+		}
 	}
-	b->m_num_alloc--;
 }
 
 }
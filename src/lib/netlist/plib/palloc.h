@@ -10,8 +10,9 @@
 
 #include "pstring.h"
 
-#include <vector>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace plib {
 
@@ -139,19 +140,25 @@ private:
 	bool m_is_owned;
 };
 
+/* Objects are bump allocated from blocks of min_alloc bytes, so things
+ * created together end up next to each other. A block is reused once
+ * everything in it has been freed; larger requests get a block of their
+ * own, which is released on the last free.
+ */
 class mempool
 {
 private:
 	struct block
 	{
-		block() : m_num_alloc(0), m_free(0), cur_ptr(nullptr), data(nullptr) { }
+		block() : m_num_alloc(0), m_size(0), m_free(0), cur_ptr(nullptr), data(nullptr) { }
 		std::size_t m_num_alloc;
+		std::size_t m_size;
 		std::size_t m_free;
 		char *cur_ptr;
 		char *data;
 	};
 
-	size_t new_block();
+	size_t new_block(size_t size);
 	size_t mininfosize();
 
 	struct info
@@ -162,8 +169,10 @@ private:
 
 	size_t m_min_alloc;
 	size_t m_min_align;
+	size_t m_current;
 
 	std::vector<block> m_blocks;
+	std::mutex m_lock;
 
 public:
 	mempool(size_t min_alloc, size_t min_align);
@@ -59,7 +59,7 @@ WCHAR *wstring_from_utf8(const char *utf8string)
 
 namespace plib {
 dynlib::dynlib(const pstring libname)
-: m_isLoaded(false), m_lib(nullptr)
+: m_isLoaded(false), m_lib(nullptr), m_syms(nullptr)
 {
 #ifdef _WIN32
 	//fprintf(stderr, "win: loading <%s>\n", libname.c_str());
@@ -89,7 +89,7 @@ dynlib::dynlib(const pstring libname)
 	}
 
 dynlib::dynlib(const pstring path, const pstring libname)
-: m_isLoaded(false), m_lib(nullptr)
+: m_isLoaded(false), m_lib(nullptr), m_syms(nullptr)
 {
 	//  printf("win: loading <%s>\n", libname.c_str());
 #ifdef _WIN32
@@ -122,6 +122,11 @@ dynlib::dynlib(const pstring path, const pstring libname)
 #endif
 }
 
+dynlib::dynlib(const dynlib_static_sym *syms)
+: m_isLoaded(true), m_lib(nullptr), m_syms(syms)
+{
+}
+
 dynlib::~dynlib()
 {
 	if (m_lib != nullptr)
@@ -141,6 +146,13 @@ bool dynlib::isLoaded() const
 
 void *dynlib::getsym_p(const pstring name)
 {
+	if (m_syms != nullptr)
+	{
+		for (const dynlib_static_sym *p = m_syms; p->name != nullptr; p++)
+			if (name == pstring(p->name, pstring::UTF8))
+				return p->addr;
+		return nullptr;
+	}
 #ifdef _WIN32
 	return (void *) GetProcAddress((HMODULE) m_lib, name.c_str());
 #else
@@ -14,11 +14,20 @@ namespace plib {
 // pdynlib: dynamic loading of libraries  ...
 // ----------------------------------------------------------------------------------------
 
+/* a symbol linked into the executable; tables of these end with a nullptr name */
+struct dynlib_static_sym
+{
+	const char *name;
+	void *addr;
+};
+
 class dynlib
 {
 public:
 	explicit dynlib(const pstring libname);
 	dynlib(const pstring path, const pstring libname);
+	/* resolve symbols from a table instead of a shared library */
+	explicit dynlib(const dynlib_static_sym *syms);
 	~dynlib();
 
 	bool isLoaded() const;
@@ -33,6 +42,7 @@ private:
 
 	bool m_isLoaded;
 	void *m_lib;
+	const dynlib_static_sym *m_syms;
 };
 
 template <typename R, typename... Args>
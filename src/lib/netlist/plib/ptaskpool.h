@@ -0,0 +1,149 @@
+// license:GPL-2.0+
+// copyright-holders:Couriersud
+/*
+ * ptaskpool.h
+ *
+ * A persistent pool of worker threads for running a handful of jobs in
+ * lock step, many thousand times a second.
+ *
+ * run() hands every thread, the caller included, its lane number and
+ * returns once all lanes are done. Between runs the workers spin for a
+ * while before blocking, so back to back runs don't pay for a wakeup.
+ */
+
+#ifndef PTASKPOOL_H_
+#define PTASKPOOL_H_
+
+#include "pconfig.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace plib {
+
+class task_pool
+{
+public:
+	/* number of yields a worker waits for the next run before blocking */
+	static constexpr unsigned SPIN_COUNT = 20000;
+
+	explicit task_pool(std::size_t threads)
+	: m_generation(0), m_pending(0), m_sleepers(0), m_exit(false), m_job(nullptr)
+	{
+		for (std::size_t lane = 1; lane < threads; lane++)
+			m_workers.emplace_back(&task_pool::worker, this, lane);
+	}
+
+	~task_pool()
+	{
+		m_exit = true;
+		wake();
+		for (auto &t : m_workers)
+			t.join();
+	}
+
+	/* the caller counts as lane 0 */
+	std::size_t threads() const { return m_workers.size() + 1; }
+
+	/* what hardware_concurrency() says, but at least 1 */
+	static std::size_t max_threads()
+	{
+		const std::size_t n = std::thread::hardware_concurrency();
+		return n ? n : 1;
+	}
+
+	/* call job(lane) once for every lane, concurrently; any exception is rethrown here */
+	void run(const std::function<void(std::size_t)> &job)
+	{
+		m_job = &job;
+		m_error = nullptr;
+		m_pending.store(m_workers.size(), std::memory_order_relaxed);
+		wake();
+
+		try
+		{
+			job(0);
+		}
+		catch (...)
+		{
+			set_error(std::current_exception());
+		}
+
+		while (m_pending.load(std::memory_order_acquire) != 0)
+			std::this_thread::yield();
+
+		if (m_error)
+			std::rethrow_exception(m_error);
+	}
+
+private:
+	void wake()
+	{
+		m_generation.fetch_add(1, std::memory_order_seq_cst);
+		if (m_sleepers.load(std::memory_order_seq_cst) != 0)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_wakeup.notify_all();
+		}
+	}
+
+	void set_error(std::exception_ptr e)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_error)
+			m_error = e;
+	}
+
+	void worker(std::size_t lane)
+	{
+		std::size_t seen = 0;
+		while (true)
+		{
+			std::size_t gen;
+			for (unsigned spins = 0; (gen = m_generation.load(std::memory_order_seq_cst)) == seen; spins++)
+			{
+				if (spins < SPIN_COUNT)
+					std::this_thread::yield();
+				else
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+					m_wakeup.wait(lock, [this, seen] { return m_generation.load(std::memory_order_seq_cst) != seen; });
+					m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+				}
+			}
+			seen = gen;
+			if (m_exit)
+				return;
+
+			try
+			{
+				(*m_job)(lane);
+			}
+			catch (...)
+			{
+				set_error(std::current_exception());
+			}
+			m_pending.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	std::vector<std::thread> m_workers;
+	std::atomic<std::size_t> m_generation;
+	std::atomic<std::size_t> m_pending;
+	std::atomic<std::size_t> m_sleepers;
+	std::atomic<bool> m_exit;
+	const std::function<void(std::size_t)> *m_job;
+	std::exception_ptr m_error;
+	std::mutex m_mutex;
+	std::condition_variable m_wakeup;
+};
+
+}
+
+#endif /* PTASKPOOL_H_ */
@@ -15,15 +15,22 @@
 #include "netlist/tools/nl_convert.h"
 #include "netlist/solver/nld_solver.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
+/* generated/static_solvers.cpp */
+extern const plib::dynlib_static_sym nl_static_solver_syms[];
+
+class netlist_tool_t;
+
 class tool_app_t : public plib::app
 {
 public:
 	tool_app_t() :
 		plib::app(),
 		opt_grp1(*this,     "General options",              "The following options apply to all commands."),
-		opt_cmd (*this,     "c", "cmd",         "run",      "run:convert:listdevices:static:header:docheader", "run|convert|listdevices|static|header"),
+		opt_cmd (*this,     "c", "cmd",         "run",      "run:compare:benchmark:convert:listdevices:static:header:docheader", "run|compare|benchmark|convert|listdevices|static|header"),
 		opt_file(*this,     "f", "file",        "-",        "file to process (default is stdin)"),
 		opt_defines(*this,  "D", "define",                  "predefine value as macro, e.g. -Dname=value. If '=value' is omitted predefine it as 1. This option may be specified repeatedly."),
 		opt_rfolders(*this, "r", "rom",                     "where to look for data files"),
@@ -32,20 +39,27 @@ public:
 		opt_version(*this,  "",  "version",                 "display version and exit"),
 		opt_help(*this,     "h", "help",                    "display help and exit"),
 		opt_grp2(*this,     "Options for run and static commands",   "These options apply to run and static commands."),
-		opt_name(*this,     "n", "name",        "",         "the netlist in file specified by ""-f"" option to run; default is first one"),
-		opt_grp3(*this,     "Options for run command",      "These options are only used by the run command."),
+		opt_name(*this,     "n", "name",        "",         "the netlist in file specified by ""-f"" option to run; default is first one. static accepts a comma separated list"),
+		opt_cache(*this,    "",  "cache",       "",         "binary cache of the parsed netlist; written on the first run and used while source, name, defines and nltool binary stay the same"),
+		opt_grp3(*this,     "Options for run, compare and benchmark commands", "These options are only used by the run, compare and benchmark commands."),
 		opt_ttr (*this,     "t", "time_to_run", 1.0,        "time to run the emulation (seconds)"),
-		opt_logs(*this,     "l", "log" ,                    "define terminal to log. This option may be specified repeatedly."),
+		opt_logs(*this,     "l", "log" ,                    "define terminal to log. compare reports the error on these terminals. This option may be specified repeatedly."),
 		opt_inp(*this,      "i", "input",       "",         "input file to process (default is none)"),
 		opt_loadstate(*this,"",  "loadstate",   "",         "load state from file and continue from there"),
 		opt_savestate(*this,"",  "savestate",   "",         "save state to file at end of run"),
+		opt_queue(*this,    "",  "queue",       "linear",   "linear:heap:calendar", "event queue implementation: linear,heap,calendar"),
+		opt_repeat(*this,   "",  "repeat",      5,          "number of timed runs for benchmark"),
+		opt_precision(*this, "", "precision",   "double",   "double:float:mixed", "precision of the MAT_CR solvers; compare runs this against double"),
+		opt_ttmerge(*this,  "",  "ttmerge",     0,          "merge combinational truthtables into ones with up to this many inputs; compare runs this against unmerged gates"),
 		opt_grp4(*this,     "Options for convert command",  "These options are only used by the convert command."),
 		opt_type(*this,     "y", "type",        "spice",    "spice:eagle:rinf", "type of file to be converted: spice,eagle,rinf"),
 
 		opt_ex1(*this,     "nltool -c run -t 3.5 -f nl_examples/cdelay.c -n cap_delay",
 				"Run netlist \"cap_delay\" from file nl_examples/cdelay.c for 3.5 seconds"),
 		opt_ex2(*this,     "nltool --cmd=listdevices",
-				"List all known devices.")
+				"List all known devices."),
+		opt_ex3(*this,     "nltool -c compare --precision=mixed -t 5 -f src/mame/audio/nl_kidniki.cpp -l R26.1",
+				"Run kidniki with mixed precision solvers next to the double ones and report the error on R26.1")
 		{}
 
 	plib::option_group  opt_grp1;
@@ -59,22 +73,31 @@ public:
 	plib::option_bool   opt_help;
 	plib::option_group  opt_grp2;
 	plib::option_str    opt_name;
+	plib::option_str    opt_cache;
 	plib::option_group  opt_grp3;
 	plib::option_double opt_ttr;
 	plib::option_vec    opt_logs;
 	plib::option_str    opt_inp;
 	plib::option_str    opt_loadstate;
 	plib::option_str    opt_savestate;
+	plib::option_str_limit opt_queue;
+	plib::option_long   opt_repeat;
+	plib::option_str_limit opt_precision;
+	plib::option_long   opt_ttmerge;
 	plib::option_group  opt_grp4;
 	plib::option_str_limit opt_type;
 	plib::option_example opt_ex1;
 	plib::option_example opt_ex2;
+	plib::option_example opt_ex3;
 
 	int execute();
 	pstring usage();
 
 private:
+	void configure(netlist_tool_t &nt);
 	void run();
+	void compare();
+	void benchmark();
 	void static_compile();
 
 	void mac_out(const pstring &s, const bool cont = true);
@@ -141,12 +164,28 @@ public:
 	{
 	}
 
+	/* empty disables the cache */
+	void set_cache_file(const pstring &cache_file) { m_cache_file = cache_file; }
+
+	/* applied to every solver device once the netlist is read */
+	void set_solver_param(const pstring &param, const pstring &value)
+	{
+		m_solver_params.push_back(std::pair<pstring, pstring>(param, value));
+	}
+
+	/* applied once the netlist is read, e.g. NETLIST.TT_MERGE */
+	void set_param(const pstring &param, const pstring &value)
+	{
+		m_netlist_params.push_back(std::pair<pstring, pstring>(param, value));
+	}
+
 	virtual ~netlist_tool_t() override
 	{
 	}
 
 	void init()
 	{
+		set_static_solver_lib(nl_static_solver_syms);
 	}
 
 	void read_netlist(const pstring &filename, const pstring &name,
@@ -164,7 +203,26 @@ public:
 
 		setup().register_source(plib::make_unique_base<netlist::source_t,
 				netlist::source_file_t>(setup(), filename));
-		setup().include(name);
+
+		if (m_cache_file == "" || filename == "-")
+			setup().include(name);
+		else
+		{
+			const pstring key = cache_key(filename, name, defines);
+			if (!load_cache(key))
+			{
+				setup().include(name);
+				plib::pofilestream strm(m_cache_file);
+				setup().save_cache(strm, key);
+			}
+		}
+
+		for (auto & e : setup().m_device_factory)
+			if (setup().factory().is_class<netlist::devices::NETLIB_NAME(solver)>(e.second))
+				for (auto & p : m_solver_params)
+					setup().register_param(e.first + "." + p.first, p.second);
+		for (auto & p : m_netlist_params)
+			setup().register_param(p.first, p.second);
 		log_setup(logs);
 
 		// start devices
@@ -173,6 +231,42 @@ public:
 		this->reset();
 	}
 
+	/* source contents, the netlist picked and the defines, tied to this build
+	 * because the netlist libraries are compiled in
+	 */
+	static pstring cache_key(const pstring &filename, const pstring &name,
+			const std::vector<pstring> &defines)
+	{
+		plib::pifilestream istrm(filename);
+		plib::pomemstream ostrm;
+		ostrm.write(istrm);
+
+		std::uint64_t hash = 14695981039346656037ULL;
+		for (std::size_t i = 0; i < ostrm.size(); i++)
+			hash = (hash ^ static_cast<unsigned char>(ostrm.memory()[i])) * 1099511628211ULL;
+
+		pstring key = plib::pfmt("{1:x}:{2}:{3}")(hash)(__DATE__ " " __TIME__)(name);
+		for (auto & d : defines)
+			key += ":" + d;
+		return key;
+	}
+
+	bool load_cache(const pstring &key)
+	{
+		try
+		{
+			plib::pifilestream strm(m_cache_file);
+			if (!setup().load_cache(strm, key))
+				return false;
+			log().verbose("Netlist read from cache {1}\n", m_cache_file);
+			return true;
+		}
+		catch (const plib::file_open_e &)
+		{
+			return false;
+		}
+	}
+
 	void log_setup(const std::vector<pstring> &logs)
 	{
 		log().debug("Creating dynamic logs ...\n");
@@ -237,6 +331,9 @@ protected:
 
 private:
 	tool_app_t &m_app;
+	std::vector<std::pair<pstring, pstring>> m_solver_params;
+	std::vector<std::pair<pstring, pstring>> m_netlist_params;
+	pstring m_cache_file;
 };
 
 void netlist_tool_t::vlog(const plib::plog_level &l, const pstring &ls) const
@@ -306,6 +403,33 @@ static std::vector<input_t> read_input(const netlist::setup_t &setup, pstring fn
 	return ret;
 }
 
+void tool_app_t::configure(netlist_tool_t &nt)
+{
+	nt.init();
+
+	if (!opt_verb())
+		nt.log().verbose.set_enabled(false);
+	if (opt_quiet())
+		nt.log().warning.set_enabled(false);
+
+	if (opt_queue.was_specified())
+	{
+		if (opt_queue() == "heap")
+			nt.queue().set_type(netlist::queue_type::HEAP);
+		else if (opt_queue() == "calendar")
+			nt.queue().set_type(netlist::queue_type::CALENDAR);
+		else
+			nt.queue().set_type(netlist::queue_type::LINEAR);
+	}
+
+	if (opt_precision.was_specified())
+		nt.set_solver_param("PRECISION", opt_precision().ucase());
+	if (opt_ttmerge.was_specified())
+		nt.set_param("NETLIST.TT_MERGE", plib::pfmt("{1}")(opt_ttmerge()));
+
+	nt.set_cache_file(opt_cache());
+}
+
 void tool_app_t::run()
 {
 	plib::chrono::timer<plib::chrono::system_ticks> t;
@@ -314,12 +438,7 @@ void tool_app_t::run()
 	netlist_tool_t nt(*this, "netlist");
 	//plib::perftime_t<plib::exact_ticks> t;
 
-	nt.init();
-
-	if (!opt_verb())
-		nt.log().verbose.set_enabled(false);
-	if (opt_quiet())
-		nt.log().warning.set_enabled(false);
+	configure(nt);
 
 	nt.read_netlist(opt_file(), opt_name(),
 			opt_logs(),
@@ -388,31 +507,181 @@ void tool_app_t::run()
 			(ttr - nlt).as_double() / emutime * 100.0);
 }
 
+/* run the netlist twice in lock step, once with double solvers and unmerged
+ * truthtables, and report how far the logged terminals of the --precision
+ * and --ttmerge run stray from it. Logic terminals count differing samples.
+ */
+void tool_app_t::compare()
+{
+	static constexpr double SAMPLE_RATE = 48000.0;
+
+	netlist_tool_t ref(*this, "reference");
+	netlist_tool_t tst(*this, "test");
+
+	configure(ref);
+	configure(tst);
+	ref.set_solver_param("PRECISION", "DOUBLE");
+	ref.set_param("NETLIST.TT_MERGE", "0");
+
+	/* no LOG devices: both netlists would write the same files */
+	std::vector<pstring> nologs;
+	ref.read_netlist(opt_file(), opt_name(), nologs, opt_defines(), opt_rfolders());
+	tst.read_netlist(opt_file(), opt_name(), nologs, opt_defines(), opt_rfolders());
+
+	struct probe_t
+	{
+		pstring name;
+		const netlist::detail::net_t *ref;
+		const netlist::detail::net_t *tst;
+		double max_err;
+		double sum_sq;
+	};
+	std::vector<probe_t> probes;
+
+	auto find_net = [](netlist_tool_t &nt, const pstring &name)
+	{
+		auto t = nt.setup().m_terminals.find(nt.setup().resolve_alias(name));
+		if (t == nt.setup().m_terminals.end())
+			throw netlist::nl_exception(plib::pfmt("terminal {1} not found\n")(name));
+		return &t->second->net();
+	};
+	auto value = [](const netlist::detail::net_t *net)
+	{
+		if (net->is_analog())
+			return static_cast<const netlist::analog_net_t *>(net)->Q_Analog();
+		return static_cast<double>(static_cast<const netlist::logic_net_t *>(net)->Q());
+	};
+
+	for (auto & l : opt_logs())
+		probes.push_back(probe_t{l, find_net(ref, l), find_net(tst, l), 0.0, 0.0});
+
+	plib::chrono::timer<plib::chrono::system_ticks> tref, ttst;
+	const netlist::netlist_time ttr = netlist::netlist_time::from_double(opt_ttr());
+	const netlist::netlist_time dt = netlist::netlist_time::from_double(1.0 / SAMPLE_RATE);
+	std::size_t samples = 0;
+
+	pout("runnning ...\n");
+
+	for (netlist::netlist_time t = ref.time(); t < ttr; t += dt)
+	{
+		tref.start();
+		ref.process_queue(dt);
+		tref.stop();
+		ttst.start();
+		tst.process_queue(dt);
+		ttst.stop();
+
+		for (auto & p : probes)
+		{
+			const double e = std::abs(value(p.tst) - value(p.ref));
+			p.max_err = std::max(p.max_err, e);
+			p.sum_sq += e * e;
+		}
+		samples++;
+	}
+
+	ref.stop();
+	tst.stop();
+
+	pout("{1} samples at {2:.0f} Hz, reference {3:f} s, {4} ttmerge {5} {6:f} s real time\n",
+			samples, SAMPLE_RATE, tref.as_seconds(), opt_precision(), opt_ttmerge(), ttst.as_seconds());
+	for (auto & p : probes)
+		if (p.ref->is_analog())
+			pout("{1}: max error {2:.3e} V, rms error {3:.3e} V\n", p.name, p.max_err,
+					std::sqrt(p.sum_sq / static_cast<double>(std::max<std::size_t>(samples, 1))));
+		else
+			pout("{1}: {2} of {3} samples differ\n", p.name, static_cast<std::size_t>(p.sum_sq), samples);
+}
+
+/* time --repeat runs of a fresh netlist, then show the statistics of
+ * the last one
+ */
+void tool_app_t::benchmark()
+{
+	const netlist::netlist_time ttr = netlist::netlist_time::from_double(opt_ttr());
+	const std::size_t repeat = static_cast<std::size_t>(std::max(opt_repeat(), 1L));
+	std::vector<double> times;
+	netlist::netlist_stats_t stats{};
+
+	for (std::size_t pass = 0; pass < repeat; pass++)
+	{
+		netlist_tool_t nt(*this, "netlist");
+
+		configure(nt);
+		nt.read_netlist(opt_file(), opt_name(), std::vector<pstring>(), opt_defines(), opt_rfolders());
+		nt.reset_stats();
+
+		plib::chrono::timer<plib::chrono::system_ticks> t;
+		t.start();
+		nt.process_queue(ttr);
+		t.stop();
+
+		times.push_back(t.as_seconds());
+		pout("run {1}: {2:f} seconds\n", pass + 1, times.back());
+		if (pass + 1 == repeat)
+			stats = nt.stats();
+		nt.stop();
+	}
+
+	std::sort(times.begin(), times.end());
+	const double median = times[times.size() / 2];
+	pout("{1:f} seconds emulation: min {2:f} median {3:f} max {4:f} ==> {5:5.2f}%\n",
+			ttr.as_double(), times.front(), median, times.back(), ttr.as_double() / median * 100.0);
+
+	pout("queue pushes {1}, pops {2}, net updates {3}, device updates {4}, {5:f} seconds in queue\n",
+			stats.queue_pushes, stats.queue_pops, stats.net_updates, stats.device_updates, stats.host_time);
+	for (auto & s : stats.solvers)
+	{
+		pout("{1}: {2} nets, {3} calls, {4} solves, {5} NR loops ({6} fails), {7} iterations ({8} fails, {9} stagnated), {10} time step changes, {11:f} seconds\n",
+				s.name, s.nets, s.calls, s.calculations, s.newton_raphson, s.nr_fails,
+				s.iterative_total, s.iterative_fail, s.iterative_stagnated, s.timestep_changes, s.host_time);
+	}
+}
+
 void tool_app_t::static_compile()
 {
-	netlist_tool_t nt(*this, "netlist");
+	/* several netlists may be given; solvers they share are only emitted once */
+	std::map<pstring, pstring> mp;
+	std::vector<pstring> names = plib::psplit(opt_name(), ",");
+	if (names.empty())
+		names.push_back("");
 
-	nt.init();
+	for (auto &name : names)
+	{
+		netlist_tool_t nt(*this, "netlist");
 
-	nt.log().verbose.set_enabled(false);
-	nt.log().warning.set_enabled(false);
+		nt.init();
 
-	nt.read_netlist(opt_file(), opt_name(),
-			opt_logs(),
-			opt_defines(), opt_rfolders());
+		nt.log().verbose.set_enabled(false);
+		nt.log().warning.set_enabled(false);
+
+		nt.read_netlist(opt_file(), name,
+				opt_logs(),
+				opt_defines(), opt_rfolders());
+
+		nt.solver()->create_solver_code(mp);
+
+		nt.stop();
+	}
 
 	plib::putf8_writer w(pout_strm);
-	std::map<pstring, pstring> mp;
 
-	nt.solver()->create_solver_code(mp);
+	w.write("// generated by \"nltool -c static\" - do not edit\n");
+	w.write("#include \"netlist/plib/pdynlib.h\"\n\n");
 
 	for (auto &e : mp)
 	{
 		w.write(e.second);
 	}
 
-	nt.stop();
-
+	/* the table netlist_t::set_static_solver_lib looks solvers up in */
+	w.write("extern const plib::dynlib_static_sym nl_static_solver_syms[];\n");
+	w.write("const plib::dynlib_static_sym nl_static_solver_syms[] = {\n");
+	for (auto &e : mp)
+		if (e.first != "")
+			w.write(plib::pfmt("\t{\"{1}\", reinterpret_cast<void *>(&{2})},\n")(e.first)(e.first));
+	w.write("\t{nullptr, nullptr}\n");
+	w.write("};\n");
 }
 
 void tool_app_t::mac_out(const pstring &s, const bool cont)
@@ -710,6 +979,10 @@ int tool_app_t::execute()
 			listdevices();
 		else if (cmd == "run")
 			run();
+		else if (cmd == "compare")
+			compare();
+		else if (cmd == "benchmark")
+			benchmark();
 		else if (cmd == "static")
 			static_compile();
 		else if (cmd == "header")
@@ -25,6 +25,15 @@ terms_for_net_t::terms_for_net_t()
 	, m_DD_n_m_1(0.0)
 	, m_h_n_m_1(1e-9)
 {
+	use_vectors();
+}
+
+void terms_for_net_t::use_vectors()
+{
+	m_gtp = m_gt.data();
+	m_gop = m_go.data();
+	m_Idrp = m_Idr.data();
+	m_connected_net_Vp = m_connected_net_V.data();
 }
 
 void terms_for_net_t::clear()
@@ -35,6 +44,7 @@ void terms_for_net_t::clear()
 	m_go.clear();
 	m_Idr.clear();
 	m_connected_net_V.clear();
+	use_vectors();
 }
 
 void terms_for_net_t::add(terminal_t *term, int net_other, bool sorted)
@@ -50,6 +60,7 @@ void terms_for_net_t::add(terminal_t *term, int net_other, bool sorted)
 				plib::container::insert_at(m_go, i, 0.0);
 				plib::container::insert_at(m_Idr, i, 0.0);
 				plib::container::insert_at(m_connected_net_V, i, nullptr);
+				use_vectors();
 				return;
 			}
 		}
@@ -59,17 +70,32 @@ void terms_for_net_t::add(terminal_t *term, int net_other, bool sorted)
 	m_go.push_back(0.0);
 	m_Idr.push_back(0.0);
 	m_connected_net_V.push_back(nullptr);
+	use_vectors();
 }
 
 void terms_for_net_t::set_pointers()
 {
 	for (unsigned i = 0; i < count(); i++)
 	{
-		m_terms[i]->set_ptrs(&m_gt[i], &m_go[i], &m_Idr[i]);
-		m_connected_net_V[i] = m_terms[i]->m_otherterm->net().Q_Analog_state_ptr();
+		m_terms[i]->set_ptrs(&m_gtp[i], &m_gop[i], &m_Idrp[i]);
+		m_connected_net_Vp[i] = m_terms[i]->m_otherterm->net().Q_Analog_state_ptr();
 	}
 }
 
+void terms_for_net_t::set_storage(nl_double *gt, nl_double *go, nl_double *Idr, nl_double **connected_net_V)
+{
+	std::copy(m_gtp, m_gtp + count(), gt);
+	std::copy(m_gop, m_gop + count(), go);
+	std::copy(m_Idrp, m_Idrp + count(), Idr);
+	std::copy(m_connected_net_Vp, m_connected_net_Vp + count(), connected_net_V);
+	m_gtp = gt;
+	m_gop = go;
+	m_Idrp = Idr;
+	m_connected_net_Vp = connected_net_V;
+	for (unsigned i = 0; i < count(); i++)
+		m_terms[i]->set_ptrs(&m_gtp[i], &m_gop[i], &m_Idrp[i]);
+}
+
 // ----------------------------------------------------------------------------------------
 // matrix_solver
 // ----------------------------------------------------------------------------------------
@@ -83,6 +109,10 @@ matrix_solver_t::matrix_solver_t(netlist_t &anetlist, const pstring &name,
 	, m_stat_vsolver_calls(*this, "m_stat_vsolver_calls", 0)
 	, m_iterative_fail(*this, "m_iterative_fail", 0)
 	, m_iterative_total(*this, "m_iterative_total", 0)
+	, m_iterative_stagnated(0)
+	, m_stat_nr_fails(0)
+	, m_stat_timestep_changes(0)
+	, m_stat_last_timestep(netlist_time::zero())
 	, m_last_step(*this, "m_last_step", netlist_time::zero())
 	, m_fb_sync(*this, "FB_sync")
 	, m_Q_sync(*this, "Q_sync")
@@ -230,12 +260,35 @@ void matrix_solver_t::setup_matrix()
 				}
 			}
 
-		for (auto &term : m_terms)
+		update_net_indices();
+	}
+
+	/* Larger groups converted from schematics are often sparse enough that
+	 * eliminating the nets with the fewest connections first produces far
+	 * less fill-in than the ascending order. The pivot order is decided once
+	 * here; the solvers reuse the resulting pattern for every solve.
+	 */
+	if (m_sort == MIN_FILL && iN > 2)
+	{
+		std::vector<std::size_t> ascending(iN);
+		for (std::size_t k = 0; k < iN; k++)
+			ascending[k] = k;
+		const std::vector<std::size_t> order = min_degree_order();
+		const std::size_t ops_asc = elimination_ops(ascending);
+		const std::size_t ops_md = elimination_ops(order);
+		log().verbose("{1}: {2} ops ascending, {3} ops minimum degree", name(), ops_asc, ops_md);
+		if (ops_md < ops_asc)
 		{
-			int *other = term->connected_net_idx();
-			for (unsigned i = 0; i < term->count(); i++)
-				if (other[i] != -1)
-					other[i] = get_net_idx(&term->terms()[i]->m_otherterm->net());
+			std::vector<std::unique_ptr<terms_for_net_t>> terms;
+			std::vector<analog_net_t *> nets;
+			for (auto k : order)
+			{
+				terms.push_back(std::move(m_terms[k]));
+				nets.push_back(m_nets[k]);
+			}
+			m_terms = std::move(terms);
+			m_nets = std::move(nets);
+			update_net_indices();
 		}
 	}
 
@@ -337,6 +390,8 @@ void matrix_solver_t::setup_matrix()
 			log().verbose("{1}", line);
 		}
 
+	layout_terms();
+
 	/*
 	 * save states
 	 */
@@ -358,6 +413,31 @@ void matrix_solver_t::setup_matrix()
 	plib::pfree_array(touched);
 }
 
+/* The solve loops walk net by net through gt, go, Idr and the connected
+ * voltages. Each terms_for_net_t keeps them in vectors of its own, all
+ * over the heap; put them in one block in the order they are walked.
+ */
+void matrix_solver_t::layout_terms()
+{
+	std::size_t total = 0;
+	for (auto &t : m_terms)
+		total += t->count();
+
+	m_term_data.assign(3 * total, 0.0);
+	m_term_net_V.assign(total, nullptr);
+
+	std::size_t p = 0;
+	std::size_t pv = 0;
+	for (auto &t : m_terms)
+	{
+		const std::size_t n = t->count();
+		nl_double *d = m_term_data.data() + p;
+		t->set_storage(d, d + n, d + 2 * n, m_term_net_V.data() + pv);
+		p += 3 * n;
+		pv += n;
+	}
+}
+
 void matrix_solver_t::update_inputs()
 {
 	// avoid recursive calls. Inputs are updated outside this call
@@ -425,6 +505,7 @@ void matrix_solver_t::solve_base()
 		// reschedule ....
 		if (this_resched > 1 && !m_Q_sync.net().is_queued())
 		{
+			m_stat_nr_fails++;
 			log().warning(MW_1_NEWTON_LOOPS_EXCEEDED_ON_NET_1, this->name());
 			m_Q_sync.net().toggle_and_push_to_queue(m_params.m_nr_recalc_delay);
 		}
@@ -445,15 +526,118 @@ const netlist_time matrix_solver_t::solve()
 	if (delta < netlist_time::quantum())
 		return netlist_time::zero();
 
+	m_stat_host_time.start();
+
 	/* update all terminals for new time step */
 	m_last_step = now;
 	step(delta);
 	solve_base();
 	const netlist_time next_time_step = compute_next_timestep(delta.as_double());
 
+	m_stat_host_time.stop();
 	return next_time_step;
 }
 
+void matrix_solver_t::update_net_indices()
+{
+	for (auto &term : m_terms)
+	{
+		int *other = term->connected_net_idx();
+		for (unsigned i = 0; i < term->count(); i++)
+			if (other[i] != -1)
+				other[i] = get_net_idx(&term->terms()[i]->m_otherterm->net());
+	}
+}
+
+/* Minimum degree on the (symmetric) connection graph: repeatedly pick the
+ * net with the fewest uneliminated neighbours, ties going to the lower
+ * index, and connect its neighbours to each other as elimination would.
+ */
+std::vector<std::size_t> matrix_solver_t::min_degree_order() const
+{
+	const std::size_t iN = m_terms.size();
+	std::vector<std::vector<bool>> adj(iN, std::vector<bool>(iN, false));
+	for (std::size_t k = 0; k < iN; k++)
+	{
+		const int *other = m_terms[k]->connected_net_idx();
+		for (std::size_t i = 0; i < m_terms[k]->m_railstart; i++)
+		{
+			const auto j = static_cast<std::size_t>(other[i]);
+			if (j != k)
+				adj[k][j] = adj[j][k] = true;
+		}
+	}
+
+	std::vector<bool> done(iN, false);
+	std::vector<std::size_t> order;
+	for (std::size_t step = 0; step < iN; step++)
+	{
+		std::size_t best = iN;
+		std::size_t best_degree = iN;
+		for (std::size_t k = 0; k < iN; k++)
+		{
+			if (done[k])
+				continue;
+			std::size_t degree = 0;
+			for (std::size_t j = 0; j < iN; j++)
+				if (adj[k][j] && !done[j])
+					degree++;
+			if (degree < best_degree)
+			{
+				best = k;
+				best_degree = degree;
+			}
+		}
+		done[best] = true;
+		order.push_back(best);
+		for (std::size_t i = 0; i < iN; i++)
+			if (adj[best][i] && !done[i])
+				for (std::size_t j = 0; j < iN; j++)
+					if (adj[best][j] && !done[j] && i != j)
+						adj[i][j] = true;
+	}
+	return order;
+}
+
+/* operations Gaussian elimination needs with the nets in the given order,
+ * counted the same way as m_ops in setup_matrix
+ */
+std::size_t matrix_solver_t::elimination_ops(const std::vector<std::size_t> &order) const
+{
+	const std::size_t iN = order.size();
+	std::vector<std::size_t> pos(iN);
+	for (std::size_t k = 0; k < iN; k++)
+		pos[order[k]] = k;
+
+	std::vector<std::vector<bool>> touched(iN, std::vector<bool>(iN, false));
+	for (std::size_t k = 0; k < iN; k++)
+	{
+		const std::size_t row = pos[k];
+		const int *other = m_terms[k]->connected_net_idx();
+		touched[row][row] = true;
+		for (std::size_t i = 0; i < m_terms[k]->m_railstart; i++)
+			touched[row][pos[static_cast<std::size_t>(other[i])]] = true;
+	}
+
+	std::size_t ops = 0;
+	for (std::size_t k = 0; k < iN; k++)
+	{
+		ops++;
+		for (std::size_t row = k + 1; row < iN; row++)
+			if (touched[row][k])
+			{
+				ops++;
+				for (std::size_t col = k + 1; col < iN; col++)
+					if (touched[k][col])
+					{
+						touched[row][col] = true;
+						ops += 2;
+					}
+			}
+	}
+	return ops;
+}
+
 int matrix_solver_t::get_net_idx(detail::net_t *net)
 {
 	for (std::size_t k = 0; k < m_nets.size(); k++)
@@ -525,7 +709,43 @@ netlist_time matrix_solver_t::compute_next_timestep(const double cur_ts)
 	/*
 	 * FIXME: Factor 2 below is important. Without, we get timing issues. This must be a bug elsewhere.
 	 */
-	return std::max(netlist_time::from_double(new_solver_timestep), netlist_time::quantum() * 2);
+	const netlist_time ts = std::max(netlist_time::from_double(new_solver_timestep), netlist_time::quantum() * 2);
+	if (m_params.m_dynamic_ts && ts != m_stat_last_timestep)
+	{
+		m_stat_timestep_changes++;
+		m_stat_last_timestep = ts;
+	}
+	return ts;
+}
+
+solver_stats_t matrix_solver_t::stats() const
+{
+	solver_stats_t s;
+	s.name = name();
+	s.nets = m_nets.size();
+	s.calls = static_cast<uint_least64_t>(m_stat_vsolver_calls);
+	s.calculations = static_cast<uint_least64_t>(m_stat_calculations);
+	s.newton_raphson = static_cast<uint_least64_t>(m_stat_newton_raphson);
+	s.nr_fails = m_stat_nr_fails;
+	s.iterative_total = static_cast<uint_least64_t>(m_iterative_total);
+	s.iterative_fail = static_cast<uint_least64_t>(m_iterative_fail);
+	s.iterative_stagnated = m_iterative_stagnated;
+	s.timestep_changes = m_stat_timestep_changes;
+	s.host_time = m_stat_host_time.as_seconds();
+	return s;
+}
+
+void matrix_solver_t::reset_stats()
+{
+	m_stat_vsolver_calls = 0;
+	m_stat_calculations = 0;
+	m_stat_newton_raphson = 0;
+	m_stat_nr_fails = 0;
+	m_iterative_total = 0;
+	m_iterative_fail = 0;
+	m_iterative_stagnated = 0;
+	m_stat_timestep_changes = 0;
+	m_stat_host_time.reset();
 }
 
 
@@ -548,6 +768,8 @@ void matrix_solver_t::log_stats()
 				100.0 * static_cast<double>(this->m_iterative_fail)
 					/ static_cast<double>(this->m_stat_calculations),
 				static_cast<double>(this->m_iterative_total) / static_cast<double>(this->m_stat_calculations));
+		if (this->m_iterative_stagnated != 0)
+			log().verbose("       {1:10} stagnated", this->m_iterative_stagnated);
 	}
 }
 
@@ -31,6 +31,11 @@ namespace netlist
 		unsigned m_nr_loops;
 		netlist_time m_nr_recalc_delay;
 		bool m_log_stats;
+
+		/* GMRES preconditioner, and fill level for PRECOND_ILU */
+		enum precond_t { PRECOND_NONE, PRECOND_JACOBI, PRECOND_ILU };
+		precond_t m_precond;
+		unsigned m_ilu_fill;
 	};
 
 
@@ -47,12 +52,14 @@ public:
 
 	inline terminal_t **terms() { return m_terms.data(); }
 	inline int *connected_net_idx() { return m_connected_net_idx.data(); }
-	inline nl_double *gt() { return m_gt.data(); }
-	inline nl_double *go() { return m_go.data(); }
-	inline nl_double *Idr() { return m_Idr.data(); }
-	inline nl_double * const *connected_net_V() const { return m_connected_net_V.data(); }
+	inline nl_double *gt() { return m_gtp; }
+	inline nl_double *go() { return m_gop; }
+	inline nl_double *Idr() { return m_Idrp; }
+	inline nl_double * const *connected_net_V() const { return m_connected_net_Vp; }
 
 	void set_pointers();
+	/* move the per terminal data to count() sized arrays owned by the solver */
+	void set_storage(nl_double *gt, nl_double *go, nl_double *Idr, nl_double **connected_net_V);
 
 	std::size_t m_railstart;
 
@@ -73,6 +80,13 @@ private:
 	std::vector<nl_double *> m_connected_net_V;
 	std::vector<terminal_t *> m_terms;
 
+	/* where the above live now, see set_storage */
+	void use_vectors();
+	nl_double *m_gtp;
+	nl_double *m_gop;
+	nl_double *m_Idrp;
+	nl_double **m_connected_net_Vp;
+
 };
 
 class proxied_analog_output_t : public analog_output_t
@@ -98,7 +112,8 @@ public:
 	{
 		NOSORT,
 		ASCENDING,
-		DESCENDING
+		DESCENDING,
+		MIN_FILL        /* ascending, or minimum degree if that needs fewer operations */
 	};
 
 	virtual ~matrix_solver_t() override;
@@ -142,6 +157,9 @@ public:
 	/* return number of floating point operations for solve */
 	std::size_t ops() { return m_ops; }
 
+	solver_stats_t stats() const;
+	void reset_stats();
+
 protected:
 
 	matrix_solver_t(netlist_t &anetlist, const pstring &name,
@@ -179,9 +197,20 @@ protected:
 	state_var<int> m_stat_vsolver_calls;
 	state_var<int> m_iterative_fail;
 	state_var<int> m_iterative_total;
+	uint_least64_t m_iterative_stagnated; /* runtime only */
 
 private:
 
+	/* terminal data of all nets, net by net in solve order, see layout_terms() */
+	std::vector<nl_double> m_term_data;
+	std::vector<nl_double *> m_term_net_V;
+
+	/* runtime only, not part of the saved state */
+	uint_least64_t m_stat_nr_fails;
+	uint_least64_t m_stat_timestep_changes;
+	netlist_time m_stat_last_timestep;
+	plib::chrono::timer<plib::chrono::fast_ticks, true> m_stat_host_time;
+
 	state_var<netlist_time> m_last_step;
 	std::vector<core_device_t *> m_step_devices;
 	std::vector<core_device_t *> m_dynamic_devices;
@@ -191,6 +220,10 @@ private:
 
 	/* calculate matrix */
 	void setup_matrix();
+	void layout_terms();
+	void update_net_indices();
+	std::vector<std::size_t> min_degree_order() const;
+	std::size_t elimination_ops(const std::vector<std::size_t> &order) const;
 
 	void step(const netlist_time &delta);
 
@@ -5,12 +5,24 @@
  *
  * Gaussian elimination using compressed row format.
  *
+ * Nets are put in minimum degree order when that needs fewer operations
+ * (see matrix_solver_t::MIN_FILL), so the fill-in stays small on large
+ * sparse groups.
+ *
+ * FT is the type the matrix is stored and eliminated in. With float the
+ * solver can refine each solution against the double system: the
+ * residual is taken from the terms in double and corrected through the
+ * float factors, which are kept in place of the eliminated entries.
+ *
  */
 
 #ifndef NLD_MS_GCR_H_
 #define NLD_MS_GCR_H_
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 
 #include "../plib/pdynlib.h"
 #include "mat_cr.h"
@@ -23,15 +35,16 @@ namespace netlist
 {
 	namespace devices
 	{
-template <std::size_t m_N, std::size_t storage_N>
+template <std::size_t m_N, std::size_t storage_N, typename FT = nl_double>
 class matrix_solver_GCR_t: public matrix_solver_t
 {
 public:
 
 	matrix_solver_GCR_t(netlist_t &anetlist, const pstring &name,
-			const solver_parameters_t *params, const std::size_t size)
-		: matrix_solver_t(anetlist, name, matrix_solver_t::ASCENDING, params)
+			const solver_parameters_t *params, const std::size_t size, const bool refine = false)
+		: matrix_solver_t(anetlist, name, matrix_solver_t::MIN_FILL, params)
 		, m_dim(size)
+		, m_refine(refine)
 		, mat(size)
 		, m_proc()
 		{
@@ -50,8 +63,14 @@ public:
 
 private:
 
+	/* refinement steps after a float solve; most converge after the first */
+	static constexpr unsigned REFINE_LOOPS = 3;
+
 	//typedef typename mat_cr_t<storage_N>::type mattype;
-	typedef typename mat_cr_t<storage_N>::index_type mattype;
+	typedef typename mat_cr_t<storage_N, uint16_t, FT>::index_type mattype;
+
+	void back_substitute(const FT * RESTRICT RHS, FT * RESTRICT V);
+	void refine(const FT * RESTRICT V0, nl_double * RESTRICT V);
 
 	void csc_private(plib::putf8_fmt_writer &strm);
 
@@ -60,11 +79,17 @@ private:
 	pstring static_compile_name();
 
 	const std::size_t m_dim;
+	const bool m_refine;
 	std::vector<unsigned> m_term_cr[storage_N];
-	mat_cr_t<storage_N> mat;
+	std::vector<unsigned> m_lower;          /* position of (j, i) for each j in m_nzbd of i, in elimination order */
+	mat_cr_t<storage_N, uint16_t, FT> mat;
+
+	/* the double system as built, for the residual when refining */
+	nl_double m_RHS_d[storage_N];
+	nl_double m_gtot_d[storage_N];
 
 	//extsolver m_proc;
-	plib::dynproc<void, double * RESTRICT, double * RESTRICT, double * RESTRICT> m_proc;
+	plib::dynproc<void, FT * RESTRICT, FT * RESTRICT, FT * RESTRICT> m_proc;
 
 };
 
@@ -72,8 +97,8 @@ private:
 // matrix_solver - GCR
 // ----------------------------------------------------------------------------------------
 
-template <std::size_t m_N, std::size_t storage_N>
-void matrix_solver_GCR_t<m_N, storage_N>::vsetup(analog_net_t::list_t &nets)
+template <std::size_t m_N, std::size_t storage_N, typename FT>
+void matrix_solver_GCR_t<m_N, storage_N, FT>::vsetup(analog_net_t::list_t &nets)
 {
 	setup_base(nets);
 
@@ -146,12 +171,23 @@ void matrix_solver_GCR_t<m_N, storage_N>::vsetup(analog_net_t::list_t &nets)
 	mat.ia[iN] = nz;
 	mat.nz_num = nz;
 
+	m_lower.clear();
+	for (std::size_t i = 0; i < iN - 1; i++)
+		for (std::size_t j : this->m_terms[i]->m_nzbd)
+		{
+			std::size_t pj = mat.ia[j];
+			while (mat.ja[pj] < i)
+				pj++;
+			m_lower.push_back(static_cast<unsigned>(pj));
+		}
+
 	this->log().verbose("Ops: {1}  Occupancy ratio: {2}\n", ops,
 			static_cast<double>(nz) / static_cast<double>(iN * iN));
 
 	// FIXME: Move me
 
-	if (netlist().lib().isLoaded())
+	/* generated solvers are double only */
+	if (std::is_same<FT, double>::value && netlist().lib().isLoaded())
 	{
 		pstring symname = static_compile_name();
 #if 0
@@ -171,8 +207,8 @@ void matrix_solver_GCR_t<m_N, storage_N>::vsetup(analog_net_t::list_t &nets)
 
 }
 #if 0
-template <std::size_t m_N, std::size_t storage_N>
-void matrix_solver_GCR_t<m_N, storage_N>::csc_private(plib::putf8_fmt_writer &strm)
+template <std::size_t m_N, std::size_t storage_N, typename FT>
+void matrix_solver_GCR_t<m_N, storage_N, FT>::csc_private(plib::putf8_fmt_writer &strm)
 {
 	const std::size_t iN = N();
 	for (std::size_t i = 0; i < iN - 1; i++)
@@ -230,8 +266,8 @@ void matrix_solver_GCR_t<m_N, storage_N>::csc_private(plib::putf8_fmt_writer &st
 	}
 }
 #else
-template <std::size_t m_N, std::size_t storage_N>
-void matrix_solver_GCR_t<m_N, storage_N>::csc_private(plib::putf8_fmt_writer &strm)
+template <std::size_t m_N, std::size_t storage_N, typename FT>
+void matrix_solver_GCR_t<m_N, storage_N, FT>::csc_private(plib::putf8_fmt_writer &strm)
 {
 	const std::size_t iN = N();
 
@@ -294,8 +330,8 @@ void matrix_solver_GCR_t<m_N, storage_N>::csc_private(plib::putf8_fmt_writer &st
 }
 #endif
 
-template <std::size_t m_N, std::size_t storage_N>
-pstring matrix_solver_GCR_t<m_N, storage_N>::static_compile_name()
+template <std::size_t m_N, std::size_t storage_N, typename FT>
+pstring matrix_solver_GCR_t<m_N, storage_N, FT>::static_compile_name()
 {
 	plib::postringstream t;
 	plib::putf8_fmt_writer w(t);
@@ -305,9 +341,12 @@ pstring matrix_solver_GCR_t<m_N, storage_N>::static_compile_name()
 	return plib::pfmt("nl_gcr_{1:x}_{2}")(h( t.str() ))(mat.nz_num);
 }
 
-template <std::size_t m_N, std::size_t storage_N>
-std::pair<pstring, pstring> matrix_solver_GCR_t<m_N, storage_N>::create_solver_code()
+template <std::size_t m_N, std::size_t storage_N, typename FT>
+std::pair<pstring, pstring> matrix_solver_GCR_t<m_N, storage_N, FT>::create_solver_code()
 {
+	if (!std::is_same<FT, double>::value)
+		return matrix_solver_t::create_solver_code();
+
 	plib::postringstream t;
 	plib::putf8_fmt_writer strm(t);
 	pstring name = static_compile_name();
@@ -320,13 +359,82 @@ std::pair<pstring, pstring> matrix_solver_GCR_t<m_N, storage_N>::create_solver_c
 }
 
 
-template <std::size_t m_N, std::size_t storage_N>
-unsigned matrix_solver_GCR_t<m_N, storage_N>::vsolve_non_dynamic(const bool newton_raphson)
+template <std::size_t m_N, std::size_t storage_N, typename FT>
+void matrix_solver_GCR_t<m_N, storage_N, FT>::back_substitute(const FT * RESTRICT RHS, FT * RESTRICT V)
+{
+	const std::size_t iN = this->N();
+
+	/* row n-1 */
+	V[iN - 1] = RHS[iN - 1] / mat.A[mat.diag[iN - 1]];
+
+	for (std::size_t j = iN - 1; j-- > 0;)
+	{
+		//__builtin_prefetch(&new_V[j-1], 1);
+		//if (j>0)__builtin_prefetch(&m_A[mat.diag[j-1]], 0);
+		FT tmp = 0;
+		auto jdiag = mat.diag[j];
+		const std::size_t e = mat.ia[j+1];
+		for (std::size_t pk = jdiag + 1; pk < e; pk++)
+		{
+			tmp += mat.A[pk] * V[mat.ja[pk]];
+		}
+		V[j] = (RHS[j] - tmp) / mat.A[jdiag];
+	}
+}
+
+template <std::size_t m_N, std::size_t storage_N, typename FT>
+void matrix_solver_GCR_t<m_N, storage_N, FT>::refine(const FT * RESTRICT V0, nl_double * RESTRICT V)
+{
+	const std::size_t iN = this->N();
+
+	for (std::size_t k = 0; k < iN; k++)
+		V[k] = V0[k];
+
+	for (unsigned loop = 0; loop < REFINE_LOOPS; loop++)
+	{
+		/* r = RHS - A * V in double, straight from the terms */
+		FT r[storage_N];
+		FT d[storage_N];
+
+		for (std::size_t k = 0; k < iN; k++)
+		{
+			terms_for_net_t *t = this->m_terms[k].get();
+			const std::size_t railstart = t->m_railstart;
+			const nl_double * const RESTRICT go = t->go();
+			const int * const RESTRICT net_other = t->connected_net_idx();
+
+			nl_double res = m_RHS_d[k] - m_gtot_d[k] * V[k];
+			for (std::size_t i = 0; i < railstart; i++)
+				res += go[i] * V[net_other[i]];
+			r[k] = static_cast<FT>(res);
+		}
+
+		/* replay the elimination on r with the stored factors */
+		const unsigned *lower = m_lower.data();
+		for (std::size_t i = 0; i < iN - 1; i++)
+			for (std::size_t j : this->m_terms[i]->m_nzbd)
+				r[j] += mat.A[*lower++] * r[i];
+
+		back_substitute(r, d);
+
+		nl_double cerr = 0.0;
+		for (std::size_t k = 0; k < iN; k++)
+		{
+			V[k] += d[k];
+			cerr = std::max(cerr, static_cast<nl_double>(std::abs(d[k])));
+		}
+		if (cerr <= this->m_params.m_accuracy)
+			break;
+	}
+}
+
+template <std::size_t m_N, std::size_t storage_N, typename FT>
+unsigned matrix_solver_GCR_t<m_N, storage_N, FT>::vsolve_non_dynamic(const bool newton_raphson)
 {
 	const std::size_t iN = this->N();
 
-	nl_double RHS[storage_N];
-	nl_double new_V[storage_N];
+	FT RHS[storage_N];
+	FT new_V[storage_N];
 
 	mat.set_scalar(0.0);
 
@@ -344,27 +452,8 @@ unsigned matrix_solver_GCR_t<m_N, storage_N>::vsolve_non_dynamic(const bool newt
 		const nl_double * const * RESTRICT other_cur_analog = t->connected_net_V();
 		const unsigned * const RESTRICT tcr = m_term_cr[k].data();
 
-#if 0
-		for (std::size_t i = 0; i < term_count; i++)
-		{
-			gtot_t += gt[i];
-			RHS_t += Idr[i];
-		}
-
-		for (std::size_t i = railstart; i < term_count; i++)
-			RHS_t += go[i] * *other_cur_analog[i];
-
-		RHS[k] = RHS_t;
-
-		// add diagonal element
-		mat.A[mat.diag[k]] = gtot_t;
-
-		for (std::size_t i = 0; i < railstart; i++)
-			mat.A[tcr[i]] -= go[i];
-	}
-#else
 		for (std::size_t i = 0; i < railstart; i++)
-			mat.A[tcr[i]] -= go[i];
+			mat.A[tcr[i]] -= static_cast<FT>(go[i]);
 
 		for (std::size_t i = 0; i < railstart; i++)
 		{
@@ -378,10 +467,14 @@ unsigned matrix_solver_GCR_t<m_N, storage_N>::vsolve_non_dynamic(const bool newt
 			gtot_t += gt[i];
 		}
 
-		RHS[k] = RHS_t;
-		mat.A[mat.diag[k]] += gtot_t;
+		RHS[k] = static_cast<FT>(RHS_t);
+		mat.A[mat.diag[k]] += static_cast<FT>(gtot_t);
+		if (m_refine)
+		{
+			m_RHS_d[k] = RHS_t;
+			m_gtot_d[k] = gtot_t;
+		}
 	}
-#endif
 	mat.ia[iN] = static_cast<mattype>(mat.nz_num);
 
 	/* now solve it */
@@ -401,7 +494,7 @@ unsigned matrix_solver_GCR_t<m_N, storage_N>::vsolve_non_dynamic(const bool newt
 			if (nzbd.size() > 0)
 			{
 				std::size_t pi = mat.diag[i];
-				const nl_double f = 1.0 / mat.A[pi++];
+				const FT f = 1.0 / mat.A[pi++];
 				const std::size_t piie = mat.ia[i+1];
 
 				for (std::size_t j : nzbd) // for (std::size_t j = i + 1; j < iN; j++)
@@ -413,7 +506,9 @@ unsigned matrix_solver_GCR_t<m_N, storage_N>::vsolve_non_dynamic(const bool newt
 					while (mat.ja[pj] < i)
 						pj++;
 
-					const nl_double f1 = - mat.A[pj++] * f;
+					/* (j, i) isn't read again, so it keeps the factor for refine() */
+					const FT f1 = - mat.A[pj] * f;
+					mat.A[pj++] = f1;
 
 					// subtract row i from j */
 					for (std::size_t pii = pi; pii<piie; )
@@ -429,30 +524,29 @@ unsigned matrix_solver_GCR_t<m_N, storage_N>::vsolve_non_dynamic(const bool newt
 		/* backward substitution
 		 *
 		 */
+		back_substitute(RHS, new_V);
+	}
 
-		/* row n-1 */
-		new_V[iN - 1] = RHS[iN - 1] / mat.A[mat.diag[iN - 1]];
+	this->m_stat_calculations++;
 
-		for (std::size_t j = iN - 1; j-- > 0;)
-		{
-			//__builtin_prefetch(&new_V[j-1], 1);
-			//if (j>0)__builtin_prefetch(&m_A[mat.diag[j-1]], 0);
-			double tmp = 0;
-			auto jdiag = mat.diag[j];
-			const std::size_t e = mat.ia[j+1];
-			for (std::size_t pk = jdiag + 1; pk < e; pk++)
-			{
-				tmp += mat.A[pk] * new_V[mat.ja[pk]];
-			}
-			new_V[j] = (RHS[j] - tmp) / mat.A[jdiag];
-		}
+	if (m_refine)
+	{
+		nl_double V[storage_N];
+		refine(new_V, V);
+		const nl_double err = (newton_raphson ? delta(V) : 0.0);
+		store(V);
+		return (err > this->m_params.m_accuracy) ? 2 : 1;
 	}
 
-	this->m_stat_calculations++;
+	/* float can't resolve steps much below its epsilon, so don't wait for Newton-Raphson to */
+	nl_double accuracy = this->m_params.m_accuracy;
+	if (!std::is_same<FT, double>::value)
+		for (std::size_t k = 0; k < iN; k++)
+			accuracy = std::max(accuracy, 4.0 * std::numeric_limits<FT>::epsilon() * std::abs(new_V[k]));
 
 	const nl_double err = (newton_raphson ? delta(new_V) : 0.0);
 	store(new_V);
-	return (err > this->m_params.m_accuracy) ? 2 : 1;
+	return (err > accuracy) ? 2 : 1;
 }
 
 	} //namespace devices
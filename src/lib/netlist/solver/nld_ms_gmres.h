@@ -1,11 +1,13 @@
 // license:GPL-2.0+
 // copyright-holders:Couriersud
 /*
- * nld_ms_sor.h
+ * nld_ms_gmres.h
  *
- * Generic successive over relaxation solver.
+ * Restarted GMRES solver.
  *
- * Fow w==1 we will do the classic Gauss-Seidel approach
+ * Preconditioned by ILU(k) on the compressed row matrix, fill level ILU_FILL,
+ * or Jacobi, see GMRES_PRECOND. Starts from the last solution and falls back
+ * to the direct solver if it doesn't converge or stagnates.
  *
  */
 
@@ -13,6 +15,7 @@
 #define NLD_MS_GMRES_H_
 
 #include <algorithm>
+#include <vector>
 
 #include "mat_cr.h"
 #include "nld_ms_direct.h"
@@ -30,7 +33,6 @@ public:
 
 	matrix_solver_GMRES_t(netlist_t &anetlist, const pstring &name, const solver_parameters_t *params, const std::size_t size)
 		: matrix_solver_direct_t<m_N, storage_N>(anetlist, name, matrix_solver_t::ASCENDING, params, size)
-		, m_use_iLU_preconditioning(true)
 		, m_use_more_precise_stop_condition(false)
 		, m_accuracy_mult(1.0)
 		, mat(size)
@@ -46,20 +48,39 @@ public:
 
 private:
 
+	/* a restart that reduces the residual by less than this gives up */
+	static constexpr nl_double STAGNATION_RATIO = 0.9;
+
 	//typedef typename mat_cr_t<storage_N>::type mattype;
 	typedef typename mat_cr_t<storage_N>::index_type mattype;
 
+	void precondition(nl_double * RESTRICT r)
+	{
+		switch (this->m_params.m_precond)
+		{
+			case solver_parameters_t::PRECOND_ILU:
+				mat.solveLUx(m_LU, r);
+				break;
+			case solver_parameters_t::PRECOND_JACOBI:
+				for (std::size_t k = 0; k < this->N(); k++)
+					r[k] *= m_inv_diag[k];
+				break;
+			case solver_parameters_t::PRECOND_NONE:
+				break;
+		}
+	}
+
 	unsigned solve_ilu_gmres(nl_double (& RESTRICT x)[storage_N], const nl_double (& RESTRICT rhs)[storage_N], const unsigned restart_max, std::size_t mr, nl_double accuracy);
 
 	std::vector<unsigned> m_term_cr[storage_N];
 
-	bool m_use_iLU_preconditioning;
 	bool m_use_more_precise_stop_condition;
 	nl_double m_accuracy_mult; // FXIME: Save state
 
 	mat_cr_t<storage_N> mat;
 
 	nl_double m_LU[storage_N * storage_N];
+	nl_double m_inv_diag[storage_N];
 
 	nl_double m_c[storage_N + 1];  /* mr + 1 */
 	nl_double m_g[storage_N + 1];  /* mr + 1 */
@@ -81,16 +102,40 @@ void matrix_solver_GMRES_t<m_N, storage_N>::vsetup(analog_net_t::list_t &nets)
 
 	mattype nz = 0;
 	const std::size_t iN = this->N();
+	const unsigned fill = (this->m_params.m_precond == solver_parameters_t::PRECOND_ILU) ? this->m_params.m_ilu_fill : 0;
+
+	/* symbolic ILU(fill): the matrix elements have level 0, eliminating (i,k)
+	 * with row k fills in (i,j) at level(i,k) + level(k,j) + 1.
+	 * Elements up to the fill level become part of the matrix, as zeros.
+	 */
+	const unsigned none = ~0u;
+	std::vector<std::vector<unsigned>> level(iN, std::vector<unsigned>(iN, none));
+
+	for (std::size_t k=0; k<iN; k++)
+		for (auto &j : this->m_terms[k]->m_nz)
+			level[k][j] = 0;
+
+	for (std::size_t i = 1; i < iN; i++)
+		for (std::size_t k = 0; k < i; k++)
+			if (level[i][k] != none)
+				for (std::size_t j = k + 1; j < iN; j++)
+					if (level[k][j] != none)
+					{
+						const unsigned l = level[i][k] + level[k][j] + 1;
+						if (l <= fill && l < level[i][j])
+							level[i][j] = l;
+					}
 
 	for (std::size_t k=0; k<iN; k++)
 	{
-		terms_for_net_t * RESTRICT row = this->m_terms[k].get();
 		mat.ia[k] = nz;
 
-		for (std::size_t j=0; j<row->m_nz.size(); j++)
+		for (std::size_t j=0; j<iN; j++)
 		{
-			mat.ja[nz] = static_cast<mattype>(row->m_nz[j]);
-			if (row->m_nz[j] == k)
+			if (level[k][j] == none)
+				continue;
+			mat.ja[nz] = static_cast<mattype>(j);
+			if (j == k)
 				mat.diag[k] = nz;
 			nz++;
 		}
@@ -175,6 +220,7 @@ unsigned matrix_solver_GMRES_t<m_N, storage_N>::vsolve_non_dynamic(const bool ne
 	if (iN > 3 )
 		mr = static_cast<unsigned>(std::sqrt(iN) * 2.0);
 	unsigned iter = std::max(1u, this->m_params.m_gs_loops);
+	/* new_V holds the last solution, a good start */
 	unsigned gsl = solve_ilu_gmres(new_V, RHS, iter, mr, accuracy);
 	unsigned failed = mr * iter;
 
@@ -234,8 +280,11 @@ unsigned matrix_solver_GMRES_t<m_N, storage_N>::solve_ilu_gmres (nl_double (& RE
 
 	if (mr > n) mr = n;
 
-	if (m_use_iLU_preconditioning)
+	if (this->m_params.m_precond == solver_parameters_t::PRECOND_ILU)
 		mat.incomplete_LU_factorization(m_LU);
+	else if (this->m_params.m_precond == solver_parameters_t::PRECOND_JACOBI)
+		for (std::size_t k = 0; k < n; k++)
+			m_inv_diag[k] = NL_FCONST(1.0) / mat.A[mat.diag[k]];
 
 	if (m_use_more_precise_stop_condition)
 	{
@@ -255,7 +304,7 @@ unsigned matrix_solver_GMRES_t<m_N, storage_N>::solve_ilu_gmres (nl_double (& RE
 		vec_set(n, accuracy, t);
 		mat.mult_vec(t, Ax);
 
-		mat.solveLUx(m_LU, Ax);
+		precondition(Ax);
 
 		const nl_double rho_to_accuracy = std::sqrt(vec_mult2(n, Ax)) / accuracy;
 
@@ -264,6 +313,8 @@ unsigned matrix_solver_GMRES_t<m_N, storage_N>::solve_ilu_gmres (nl_double (& RE
 	else
 		rho_delta = accuracy * std::sqrt(n) * m_accuracy_mult;
 
+	nl_double rho_last = 0.0;
+
 	for (unsigned itr = 0; itr < restart_max; itr++)
 	{
 		std::size_t last_k = mr;
@@ -276,16 +327,21 @@ unsigned matrix_solver_GMRES_t<m_N, storage_N>::solve_ilu_gmres (nl_double (& RE
 
 		vec_sub(n, rhs, Ax, residual);
 
-		if (m_use_iLU_preconditioning)
-		{
-			mat.solveLUx(m_LU, residual);
-		}
+		precondition(residual);
 
 		rho = std::sqrt(vec_mult2(n, residual));
 
 		if (rho < rho_delta)
 			return itr_used + 1;
 
+		/* restarting won't help much either, leave it to the direct solver */
+		if (itr > 0 && rho > STAGNATION_RATIO * rho_last)
+		{
+			this->m_iterative_stagnated++;
+			return restart_max * static_cast<unsigned>(mr);
+		}
+		rho_last = rho;
+
 		vec_set(mr+1, NL_FCONST(0.0), m_g);
 		m_g[0] = rho;
 
@@ -300,8 +356,7 @@ unsigned matrix_solver_GMRES_t<m_N, storage_N>::solve_ilu_gmres (nl_double (& RE
 
 			mat.mult_vec(m_v[k], m_v[k1]);
 
-			if (m_use_iLU_preconditioning)
-				mat.solveLUx(m_LU, m_v[k1]);
+			precondition(m_v[k1]);
 
 			for (std::size_t j = 0; j <= k; j++)
 			{
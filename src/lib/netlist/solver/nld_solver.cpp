@@ -33,11 +33,10 @@
 
 #include <algorithm>
 #include <cmath>  // <<= needed by windows build
+#include <numeric>
 
 #include "../nl_lists.h"
 
-#include "../plib/pomp.h"
-
 #include "../nl_factory.h"
 
 #include "nld_solver.h"
@@ -78,6 +77,65 @@ void NETLIB_NAME(solver)::stop()
 {
 	for (std::size_t i = 0; i < m_mat_solvers.size(); i++)
 		m_mat_solvers[i]->log_stats();
+
+	if (m_pool && m_log_stats())
+		for (std::size_t lane = 0; lane < m_lanes.size(); lane++)
+		{
+			log().verbose("Solver thread {1}:", lane);
+			for (auto i : m_lanes[lane])
+				log().verbose("       {1}", m_mat_solvers[i]->name());
+		}
+	m_pool = nullptr;
+}
+
+/*
+ * With PARALLEL > 1 the solvers run on a persistent pool of threads.
+ * Every BALANCE_INTERVAL steps they are reassigned from the time each
+ * took since the last assignment, most expensive first onto the least
+ * loaded thread. Solvers too cheap to repay the handoff stay on the
+ * calling thread, and if nothing is left for the others the pool isn't
+ * woken at all. Until the first assignment everything runs on the
+ * caller.
+ */
+
+void NETLIB_NAME(solver)::balance_lanes()
+{
+	std::vector<std::size_t> order(m_mat_solvers.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) { return m_cost[a] > m_cost[b]; });
+
+	const double min_cost = static_cast<double>(plib::chrono::fast_ticks::per_second()) * 1e-9 * MIN_PARALLEL_NS * BALANCE_INTERVAL;
+	std::vector<plib::chrono::fast_ticks::type> load(m_lanes.size(), 0);
+	for (auto &lane : m_lanes)
+		lane.clear();
+
+	m_use_pool = false;
+	for (auto i : order)
+	{
+		std::size_t lane = 0;
+		if (static_cast<double>(m_cost[i]) >= min_cost)
+			lane = static_cast<std::size_t>(std::min_element(load.begin(), load.end()) - load.begin());
+		m_lanes[lane].push_back(i);
+		load[lane] += m_cost[i];
+		m_use_pool = m_use_pool || lane != 0;
+	}
+
+	std::fill(m_cost.begin(), m_cost.end(), 0);
+	m_balance_countdown = BALANCE_INTERVAL;
+}
+
+void NETLIB_NAME(solver)::solve_lane(std::size_t lane, bool force_solve)
+{
+	for (auto i : m_lanes[lane])
+	{
+		auto &solver = m_mat_solvers[i];
+		if (solver->has_timestep_devices() || force_solve)
+		{
+			const auto start = plib::chrono::fast_ticks::start();
+			ATTR_UNUSED const netlist_time ts = solver->solve();
+			m_cost[i] += plib::chrono::fast_ticks::stop() - start;
+		}
+	}
 }
 
 NETLIB_NAME(solver)::~NETLIB_NAME(solver)()
@@ -93,17 +151,14 @@ NETLIB_UPDATE(solver)
 	/* FIXME: Needs a more elegant solution */
 	bool force_solve = (netlist().time() < netlist_time::from_double(2 * m_params.m_max_timestep));
 
-	std::size_t nthreads = std::min(m_parallel(), plib::omp::get_max_threads());
-	std::size_t t_cnt = 0;
-	int solv[128];
-	for (int i = 0; i <  m_mat_solvers.size(); i++)
-		if (m_mat_solvers[i]->has_timestep_devices() || force_solve)
-			solv[t_cnt++] = i;
-
-	if (nthreads > 1 && t_cnt > 1)
+	if (m_pool)
 	{
-		plib::omp::set_num_threads(nthreads);
-		plib::omp::for_static(0, t_cnt, [this, &solv](int i) { ATTR_UNUSED const netlist_time ts = this->m_mat_solvers[solv[i]]->solve(); });
+		if (--m_balance_countdown == 0)
+			balance_lanes();
+		if (m_use_pool)
+			m_pool->run([this, force_solve](std::size_t lane) { this->solve_lane(lane, force_solve); });
+		else
+			solve_lane(0, force_solve);
 	}
 	else
 		for (auto & solver : m_mat_solvers)
@@ -142,7 +197,19 @@ std::unique_ptr<matrix_solver_t> NETLIB_NAME(solver)::create_solver(std::size_t
 		if (size > 0) // GCR always outperforms MAT solver
 		{
 			typedef matrix_solver_GCR_t<m_N,storage_N> solver_mat;
-			return plib::make_unique<solver_mat>(netlist(), solvername, &m_params, size);
+			typedef matrix_solver_GCR_t<m_N,storage_N,float> solver_mat_float;
+
+			if (pstring("DOUBLE").equals(m_precision()))
+				return plib::make_unique<solver_mat>(netlist(), solvername, &m_params, size);
+			else if (pstring("FLOAT").equals(m_precision()))
+				return plib::make_unique<solver_mat_float>(netlist(), solvername, &m_params, size, false);
+			else if (pstring("MIXED").equals(m_precision()))
+				return plib::make_unique<solver_mat_float>(netlist(), solvername, &m_params, size, true);
+			else
+			{
+				log().fatal(MF_1_UNKNOWN_SOLVER_PRECISION, m_precision());
+				return nullptr;
+			}
 		}
 		else
 		{
@@ -250,6 +317,16 @@ void NETLIB_NAME(solver)::post_start()
 	m_params.m_dynamic_lte = m_dynamic_lte();
 	m_params.m_gs_sor = m_gs_sor();
 
+	if (pstring("NONE").equals(m_gmres_precond()))
+		m_params.m_precond = solver_parameters_t::PRECOND_NONE;
+	else if (pstring("JACOBI").equals(m_gmres_precond()))
+		m_params.m_precond = solver_parameters_t::PRECOND_JACOBI;
+	else if (pstring("ILU").equals(m_gmres_precond()))
+		m_params.m_precond = solver_parameters_t::PRECOND_ILU;
+	else
+		log().fatal(MF_1_UNKNOWN_PRECONDITIONER, m_gmres_precond());
+	m_params.m_ilu_fill = static_cast<unsigned>(std::max(m_ilu_fill(), 0));
+
 	m_params.m_min_timestep = m_dynamic_min_ts();
 	m_params.m_dynamic_ts = (m_dynamic_ts() == 1 ? true : false);
 	m_params.m_max_timestep = netlist_time::from_double(1.0 / m_freq()).as_double();
@@ -406,6 +483,20 @@ void NETLIB_NAME(solver)::post_start()
 
 		m_mat_solvers.push_back(std::move(ms));
 	}
+
+	/* everything starts on the calling thread, to be spread out once there are timings */
+	const std::size_t nthreads = std::min({ static_cast<std::size_t>(std::max(m_parallel(), 1)), plib::task_pool::max_threads(), m_mat_solvers.size() });
+	if (nthreads > 1)
+	{
+		m_pool = plib::make_unique<plib::task_pool>(nthreads);
+		m_lanes.assign(nthreads, std::vector<std::size_t>());
+		for (std::size_t i = 0; i < m_mat_solvers.size(); i++)
+			m_lanes[0].push_back(i);
+		m_cost.assign(m_mat_solvers.size(), 0);
+		m_balance_countdown = BALANCE_INTERVAL;
+		m_use_pool = false;
+		log().verbose("Solver running on up to {1} threads", nthreads);
+	}
 }
 
 void NETLIB_NAME(solver)::create_solver_code(std::map<pstring, pstring> &mp)
@@ -417,6 +508,18 @@ void NETLIB_NAME(solver)::create_solver_code(std::map<pstring, pstring> &mp)
 	}
 }
 
+void NETLIB_NAME(solver)::stats(std::vector<solver_stats_t> &s) const
+{
+	for (auto & ms : m_mat_solvers)
+		s.push_back(ms->stats());
+}
+
+void NETLIB_NAME(solver)::reset_stats()
+{
+	for (auto & ms : m_mat_solvers)
+		ms->reset_stats();
+}
+
 	NETLIB_DEVICE_IMPL(solver)
 
 	} //namespace devices
@@ -11,7 +11,9 @@
 #include <map>
 
 #include "../nl_base.h"
+#include "../plib/pchrono.h"
 #include "../plib/pstream.h"
+#include "../plib/ptaskpool.h"
 #include "nld_matrix_solver.h"
 
 //#define ATTR_ALIGNED(N) __attribute__((aligned(N)))
@@ -40,8 +42,11 @@ NETLIB_OBJECT(solver)
 	/* iteration parameters */
 	, m_gs_sor(*this, "SOR_FACTOR", 1.059)
 	, m_method(*this, "METHOD", "MAT_CR")
+	, m_precision(*this, "PRECISION", "DOUBLE")    // DOUBLE, FLOAT or MIXED - MAT_CR only
 	, m_accuracy(*this, "ACCURACY", 1e-7)
 	, m_gs_loops(*this, "GS_LOOPS",9)              // Gauss-Seidel loops
+	, m_gmres_precond(*this, "GMRES_PRECOND", "ILU") // NONE, JACOBI or ILU
+	, m_ilu_fill(*this, "ILU_FILL", 0)             // fill level of ILU preconditioner
 
 	/* general parameters */
 	, m_gmin(*this, "GMIN", NETLIST_GMIN_DEFAULT)
@@ -57,6 +62,8 @@ NETLIB_OBJECT(solver)
 
 	, m_log_stats(*this, "LOG_STATS", 0)   // log statistics on shutdown
 	, m_params()
+	, m_balance_countdown(0)
+	, m_use_pool(false)
 	{
 		// internal staff
 
@@ -72,6 +79,10 @@ NETLIB_OBJECT(solver)
 
 	void create_solver_code(std::map<pstring, pstring> &mp);
 
+	/* runtime statistics of the matrix solvers */
+	void stats(std::vector<solver_stats_t> &s) const;
+	void reset_stats();
+
 	NETLIB_UPDATEI();
 	NETLIB_RESETI();
 	// NETLIB_UPDATE_PARAMI();
@@ -83,8 +94,11 @@ protected:
 	param_double_t m_freq;
 	param_double_t m_gs_sor;
 	param_str_t m_method;
+	param_str_t m_precision;
 	param_double_t m_accuracy;
 	param_int_t m_gs_loops;
+	param_str_t m_gmres_precond;
+	param_int_t m_ilu_fill;
 	param_double_t m_gmin;
 	param_logic_t  m_pivot;
 	param_int_t m_nr_loops;
@@ -99,8 +113,21 @@ protected:
 	std::vector<std::unique_ptr<matrix_solver_t>> m_mat_solvers;
 private:
 
+	/* PARALLEL: steps between reassignments, and the cost per step below which a solver isn't worth handing off */
+	static constexpr unsigned BALANCE_INTERVAL = 4096;
+	static constexpr unsigned MIN_PARALLEL_NS = 1000;
+
+	void balance_lanes();
+	void solve_lane(std::size_t lane, bool force_solve);
+
 	solver_parameters_t m_params;
 
+	std::unique_ptr<plib::task_pool> m_pool;
+	std::vector<std::vector<std::size_t>> m_lanes;          // solvers run by each pool thread, lane 0 being the caller
+	std::vector<plib::chrono::fast_ticks::type> m_cost;     // ticks spent in each solver since the last balance
+	unsigned m_balance_countdown;
+	bool m_use_pool;                                        // some lane besides 0 has work
+
 	template <std::size_t m_N, std::size_t storage_N>
 	std::unique_ptr<matrix_solver_t> create_solver(std::size_t size, const pstring &solvername);
 };
@@ -711,6 +711,77 @@ void avhuff_decoder::configure(const avhuff_decompress_config &config)
 	m_config.metadata = config.metadata;
 }
 
+/**
+ * @fn  avhuff_error avhuff_decoder::copy_raw_data(const uint8_t *source, uint32_t length, const avhuff_decompress_config &config)
+ *
+ * @brief   -------------------------------------------------
+ *            copy_raw_data - copy an already decoded raw stream, as produced by decode_data
+ *            with a destination buffer, into the targets of a decompression configuration
+ *          -------------------------------------------------.
+ *
+ * @param   source  Source for the.
+ * @param   length  The length.
+ * @param   config  The configuration.
+ *
+ * @return  An avhuff_error.
+ */
+
+avhuff_error avhuff_decoder::copy_raw_data(const uint8_t *source, uint32_t length, const avhuff_decompress_config &config)
+{
+	// validate the header and the sizes
+	if (length < 12 || source[0] != 'c' || source[1] != 'h' || source[2] != 'a' || source[3] != 'v')
+		return AVHERR_INVALID_DATA;
+	uint32_t metasize = source[4];
+	uint32_t channels = source[5];
+	uint32_t samples = (source[6] << 8) + source[7];
+	uint32_t width = (source[8] << 8) + source[9];
+	uint32_t height = ((source[10] << 8) + source[11]) & 0x7fff;
+	if (channels > ARRAY_LENGTH(config.audio) || avhuff_encoder::raw_data_size(source) > length)
+		return AVHERR_INVALID_DATA;
+
+	// verify against the targets
+	if (config.video.valid() && (config.video.width() < width || config.video.height() < height))
+		return AVHERR_VIDEO_TOO_LARGE;
+	for (int chnum = 0; chnum < channels; chnum++)
+		if (config.audio[chnum] != nullptr && config.maxsamples < samples)
+			return AVHERR_AUDIO_TOO_LARGE;
+	if (config.metadata != nullptr && config.maxmetalength < metasize)
+		return AVHERR_METADATA_TOO_LARGE;
+
+	// set the output values
+	if (config.actsamples != nullptr)
+		*config.actsamples = samples;
+	if (config.actmetalength != nullptr)
+		*config.actmetalength = metasize;
+
+	// copy the metadata
+	source += 12;
+	if (config.metadata != nullptr)
+		memcpy(config.metadata, source, metasize);
+	source += metasize;
+
+	// the raw stream is big-endian; convert the audio to native
+	for (int chnum = 0; chnum < channels; chnum++)
+	{
+		int16_t *dest = config.audio[chnum];
+		if (dest != nullptr)
+			for (uint32_t sampnum = 0; sampnum < samples; sampnum++)
+				dest[sampnum] = (source[sampnum * 2] << 8) | source[sampnum * 2 + 1];
+		source += 2 * samples;
+	}
+
+	// and likewise the video
+	if (config.video.valid())
+		for (uint32_t y = 0; y < height; y++)
+		{
+			uint16_t *dest = &config.video.pix(y);
+			for (uint32_t x = 0; x < width; x++)
+				dest[x] = (source[x * 2] << 8) | source[x * 2 + 1];
+			source += 2 * width;
+		}
+	return AVHERR_NONE;
+}
+
 /**
  * @fn  avhuff_error avhuff_decoder::decode_data(const uint8_t *source, uint32_t complength, uint8_t *dest)
  *
@@ -152,6 +152,9 @@ public:
 	// encode/decode
 	avhuff_error decode_data(const uint8_t *source, uint32_t complength, uint8_t *dest);
 
+	// static helpers
+	static avhuff_error copy_raw_data(const uint8_t *source, uint32_t length, const avhuff_decompress_config &config);
+
 private:
 	// delta-RLE Huffman decoder
 	class deltarle_decoder
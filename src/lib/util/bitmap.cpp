@@ -275,6 +275,7 @@ void bitmap_t::reset()
 	// delete any existing stuff
 	set_palette(nullptr);
 	m_alloc.reset();
+	m_allocbytes = 0;
 	m_base = nullptr;
 
 	// reset all fields
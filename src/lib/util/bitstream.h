@@ -38,8 +38,11 @@ public:
 	uint32_t flush();
 
 private:
+	// internal helpers
+	void refill();
+
 	// internal state
-	uint32_t          m_buffer;       // current bit accumulator
+	uint64_t          m_buffer;       // current bit accumulator
 	int             m_bits;         // number of bits in the accumulator
 	const uint8_t *   m_read;         // read pointer
 	uint32_t          m_doffset;      // byte offset within the data
@@ -102,18 +105,42 @@ inline uint32_t bitstream_in::peek(int numbits)
 
 	// fetch data if we need more
 	if (numbits > m_bits)
+		refill();
+
+	// return the data
+	return uint32_t(m_buffer >> (64 - numbits));
+}
+
+
+//-------------------------------------------------
+//  refill - top up the accumulator to at least
+//  57 bits
+//-------------------------------------------------
+
+inline void bitstream_in::refill()
+{
+	// away from the end, load eight bytes at once; any bits past the whole bytes we
+	// count are the start of the next byte, which the next refill ORs in again
+	if (m_doffset + 8 <= m_dlength)
 	{
-		while (m_bits <= 24)
-		{
-			if (m_doffset < m_dlength)
-				m_buffer |= m_read[m_doffset] << (24 - m_bits);
-			m_doffset++;
-			m_bits += 8;
-		}
+		const uint8_t *src = &m_read[m_doffset];
+		uint64_t data = (uint64_t(src[0]) << 56) | (uint64_t(src[1]) << 48) | (uint64_t(src[2]) << 40) | (uint64_t(src[3]) << 32) |
+				(uint64_t(src[4]) << 24) | (uint64_t(src[5]) << 16) | (uint64_t(src[6]) << 8) | uint64_t(src[7]);
+		m_buffer |= data >> m_bits;
+		int bytes = (63 - m_bits) >> 3;
+		m_doffset += bytes;
+		m_bits += bytes * 8;
+		return;
 	}
 
-	// return the data
-	return m_buffer >> (32 - numbits);
+	// near the end, go a byte at a time and pad with zeroes
+	while (m_bits <= 56)
+	{
+		if (m_doffset < m_dlength)
+			m_buffer |= uint64_t(m_read[m_doffset]) << (56 - m_bits);
+		m_doffset++;
+		m_bits += 8;
+	}
 }
 
 
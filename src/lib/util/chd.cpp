@@ -20,7 +20,9 @@
 #include <time.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <list>
 #include <new>
+#include <unordered_map>
 #include "eminline.h"
 
 
@@ -119,6 +121,172 @@ struct chd_file::metadata_hash
 };
 
 
+// ======================> hunk_decoder
+
+// decompressors and compressed data scratch for decoding hunks on one thread
+struct chd_file::hunk_decoder
+{
+	chd_decompressor *      decompressor[4];    // one per compression slot
+	std::vector<uint8_t>    compressed;         // compressed data of the hunk being decoded
+};
+
+
+// ======================> hunk_batch
+
+// one work item's share of a read_hunks call
+struct chd_file::hunk_batch
+{
+	chd_file *              chd;            // CHD being read
+	uint32_t                hunknum;        // first hunk of the batch
+	uint32_t                count;          // hunks in the batch
+	uint8_t *               dest;           // where the first hunk goes
+	chd_error               err;            // result of the batch
+};
+
+
+// ======================> chd_hunk_cache
+
+// LRU cache of decompressed hunks, shared by all open CHDs and kept under a memory budget
+class chd_hunk_cache
+{
+public:
+	static const uint64_t DEFAULT_BUDGET = 32 * 1024 * 1024;
+	static const uint32_t DEFAULT_READAHEAD = 4;
+
+	chd_hunk_cache()
+		: m_budget(DEFAULT_BUDGET),
+			m_readahead(DEFAULT_READAHEAD)
+	{
+		memset(&m_stats, 0, sizeof(m_stats));
+	}
+
+	static chd_hunk_cache &instance()
+	{
+		static chd_hunk_cache cache;
+		return cache;
+	}
+
+	// getters
+	uint32_t readahead() const { return m_readahead; }
+	uint64_t budget() const { return m_budget; }
+	chd_cache_stats stats() { std::lock_guard<std::mutex> lock(m_mutex); return m_stats; }
+
+	// setters
+	void set_readahead(uint32_t hunks) { m_readahead = hunks; }
+	void set_budget(uint64_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_budget = bytes;
+		trim();
+	}
+
+	// copy part of a cached hunk out and make it the most recently used
+	bool fetch(const chd_file *chd, uint32_t hunknum, void *dest, uint32_t offset, uint32_t length)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto found = m_index.find(key(chd, hunknum));
+		if (found == m_index.end())
+		{
+			m_stats.misses++;
+			return false;
+		}
+		entry &e = *found->second;
+		memcpy(dest, &e.data[offset], length);
+		m_stats.hits++;
+		if (e.prefetched)
+		{
+			m_stats.prefetch_hits++;
+			e.prefetched = false;
+		}
+		m_lru.splice(m_lru.begin(), m_lru, found->second);
+		return true;
+	}
+
+	bool contains(const chd_file *chd, uint32_t hunknum)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_index.find(key(chd, hunknum)) != m_index.end();
+	}
+
+	void insert(const chd_file *chd, uint32_t hunknum, std::vector<uint8_t> &&data, bool prefetched)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (data.size() > m_budget || m_index.find(key(chd, hunknum)) != m_index.end())
+			return;
+		if (prefetched)
+			m_stats.prefetched++;
+		m_stats.bytes += data.size();
+		m_lru.push_front(entry{ chd, hunknum, std::move(data), prefetched });
+		m_index.emplace(key(chd, hunknum), m_lru.begin());
+		trim();
+	}
+
+	// drop a hunk that has been written
+	void invalidate(const chd_file *chd, uint32_t hunknum)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto found = m_index.find(key(chd, hunknum));
+		if (found != m_index.end())
+			remove(found->second);
+	}
+
+	// drop everything belonging to a CHD that is closing
+	void purge(const chd_file *chd)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto it = m_lru.begin(); it != m_lru.end(); )
+			if (it->chd == chd)
+				remove(it++);
+			else
+				++it;
+	}
+
+private:
+	struct entry
+	{
+		const chd_file *        chd;
+		uint32_t                hunknum;
+		std::vector<uint8_t>    data;
+		bool                    prefetched;     // brought in by readahead and not used yet
+	};
+
+	struct entry_key
+	{
+		const chd_file *        chd;
+		uint32_t                hunknum;
+		bool operator==(const entry_key &rhs) const { return chd == rhs.chd && hunknum == rhs.hunknum; }
+	};
+
+	struct entry_key_hash
+	{
+		size_t operator()(const entry_key &k) const { return std::hash<const chd_file *>()(k.chd) ^ (size_t(k.hunknum) * 0x9e3779b1U); }
+	};
+
+	static entry_key key(const chd_file *chd, uint32_t hunknum) { return entry_key{ chd, hunknum }; }
+
+	// internal helpers; the caller holds the lock
+	void remove(std::list<entry>::iterator it)
+	{
+		m_stats.bytes -= it->data.size();
+		m_index.erase(key(it->chd, it->hunknum));
+		m_lru.erase(it);
+	}
+
+	void trim()
+	{
+		while (m_stats.bytes > m_budget && !m_lru.empty())
+			remove(std::prev(m_lru.end()));
+	}
+
+	std::mutex              m_mutex;        // guards everything below
+	uint64_t                m_budget;       // most hunk data to hold, in bytes
+	std::atomic<uint32_t>   m_readahead;    // hunks to prefetch after a sequential read
+	std::list<entry>        m_lru;          // most recently used first
+	std::unordered_map<entry_key, std::list<entry>::iterator, entry_key_hash> m_index;
+	chd_cache_stats         m_stats;
+};
+
+
 
 //**************************************************************************
 //  INLINE FUNCTIONS
@@ -189,7 +357,15 @@ inline void chd_file::file_read(uint64_t offset, void *dest, uint32_t length)
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
 
-	// seek and read
+	// a mapped file is just a copy away
+	if (m_mapped != nullptr && offset <= m_mappedbytes && length <= m_mappedbytes - offset)
+	{
+		memcpy(dest, m_mapped + offset, length);
+		return;
+	}
+
+	// seek and read; hunk decoders on other threads share the file position
+	std::lock_guard<std::mutex> lock(m_file_lock);
 	m_file->seek(offset, SEEK_SET);
 	uint32_t count = m_file->read(dest, length);
 	if (count != length)
@@ -289,7 +465,11 @@ inline uint8_t chd_file::bits_for_value(uint64_t value)
 
 chd_file::chd_file()
 	: m_file(nullptr),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_decode_queue(nullptr),
+		m_prefetch_cancel(false),
+		m_prefetch_queue(nullptr),
+		m_prefetch_item(nullptr)
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
@@ -801,6 +981,10 @@ chd_error chd_file::open(util::core_file &file, bool writeable, chd_file *parent
 
 void chd_file::close()
 {
+	// stop reading ahead and forget our cached hunks before the file goes away
+	cancel_prefetch();
+	chd_hunk_cache::instance().purge(this);
+
 	// reset file characteristics
 	if (m_owns_file && m_file)
 		delete m_file;
@@ -808,6 +992,9 @@ void chd_file::close()
 	m_owns_file = false;
 	m_allow_reads = false;
 	m_allow_writes = false;
+	m_writeable = false;
+	m_mapped = nullptr;
+	m_mappedbytes = 0;
 
 	// reset core parameters from the header
 	m_version = HEADER_VERSION;
@@ -840,10 +1027,25 @@ void chd_file::close()
 		elem = nullptr;
 	}
 	m_compressed.clear();
+	for (hunk_decoder *decoder : m_decoders)
+	{
+		for (auto & elem : decoder->decompressor)
+			delete elem;
+		delete decoder;
+	}
+	m_decoders.clear();
+	if (m_decode_queue != nullptr)
+	{
+		osd_work_queue_free(m_decode_queue);
+		m_decode_queue = nullptr;
+	}
 
 	// reset caching
 	m_cache.clear();
-	m_cachehunk = ~0;
+	m_lasthunk = ~0;
+	m_sequential = 0;
+	m_prefetch_start = 0;
+	m_prefetch_count = 0;
 }
 
 /**
@@ -870,6 +1072,29 @@ void chd_file::close()
  */
 
 chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
+{
+	// readahead may be using the file and decompressors on another thread
+	std::lock_guard<std::recursive_mutex> lock(m_hunk_lock);
+	return decode_hunk(hunknum, buffer, m_decompressor, m_compressed);
+}
+
+/**
+ * @fn  chd_error chd_file::decode_hunk(uint32_t hunknum, void *buffer, chd_decompressor *const *decompressor, std::vector<uint8_t> &compbuf)
+ *
+ * @brief   -------------------------------------------------
+ *            decode_hunk - read a single hunk using the given decompressors and compressed
+ *            data buffer, which belong to the calling thread
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum                 The hunknum.
+ * @param [in,out]  buffer          If non-null, the buffer.
+ * @param   decompressor            The decompressors, one per compression slot.
+ * @param [in,out]  compbuf         Scratch for the compressed data.
+ *
+ * @return  A chd_error.
+ */
+
+chd_error chd_file::decode_hunk(uint32_t hunknum, void *buffer, chd_decompressor *const *decompressor, std::vector<uint8_t> &compbuf)
 {
 	// wrap this for clean reporting
 	try
@@ -900,8 +1125,8 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 				{
 					case V34_MAP_ENTRY_TYPE_COMPRESSED:
 						blocklen = be_read(&rawmap[12], 2) + (rawmap[14] << 16);
-						file_read(blockoffs, &m_compressed[0], blocklen);
-						m_decompressor[0]->decompress(&m_compressed[0], blocklen, dest, m_hunkbytes);
+						file_read(blockoffs, &compbuf[0], blocklen);
+						decompressor[0]->decompress(&compbuf[0], blocklen, dest, m_hunkbytes);
 						if (!(rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC) && dest != nullptr && util::crc32_creator::simple(dest, m_hunkbytes) != blockcrc)
 							throw CHDERR_DECOMPRESSION_ERROR;
 						return CHDERR_NONE;
@@ -921,7 +1146,7 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 						return CHDERR_NONE;
 
 					case V34_MAP_ENTRY_TYPE_SELF_HUNK:
-						return read_hunk(blockoffs, dest);
+						return decode_hunk(blockoffs, dest, decompressor, compbuf);
 
 					case V34_MAP_ENTRY_TYPE_PARENT_HUNK:
 						if (m_parent_missing)
@@ -959,11 +1184,11 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 					case COMPRESSION_TYPE_1:
 					case COMPRESSION_TYPE_2:
 					case COMPRESSION_TYPE_3:
-						file_read(blockoffs, &m_compressed[0], blocklen);
-						m_decompressor[rawmap[0]]->decompress(&m_compressed[0], blocklen, dest, m_hunkbytes);
-						if (!m_decompressor[rawmap[0]]->lossy() && dest != nullptr && util::crc16_creator::simple(dest, m_hunkbytes) != blockcrc)
+						file_read(blockoffs, &compbuf[0], blocklen);
+						decompressor[rawmap[0]]->decompress(&compbuf[0], blocklen, dest, m_hunkbytes);
+						if (!decompressor[rawmap[0]]->lossy() && dest != nullptr && util::crc16_creator::simple(dest, m_hunkbytes) != blockcrc)
 							throw CHDERR_DECOMPRESSION_ERROR;
-						if (m_decompressor[rawmap[0]]->lossy() && util::crc16_creator::simple(&m_compressed[0], blocklen) != blockcrc)
+						if (decompressor[rawmap[0]]->lossy() && util::crc16_creator::simple(&compbuf[0], blocklen) != blockcrc)
 							throw CHDERR_DECOMPRESSION_ERROR;
 						return CHDERR_NONE;
 
@@ -974,7 +1199,7 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 						return CHDERR_NONE;
 
 					case COMPRESSION_SELF:
-						return read_hunk(blockoffs, dest);
+						return decode_hunk(blockoffs, dest, decompressor, compbuf);
 
 					case COMPRESSION_PARENT:
 						if (m_parent_missing)
@@ -995,6 +1220,142 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 	}
 }
 
+/**
+ * @fn  chd_error chd_file::read_hunks(uint32_t hunknum, uint32_t count, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunks - read a run of hunks into consecutive buffers, decompressing them
+ *            on all processors; each thread gets decompressors of its own, without any
+ *            codec_configure settings, so this suits raw data only
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The first hunknum.
+ * @param   count           Number of hunks.
+ * @param [in,out]  buffer  Room for count hunks.
+ *
+ * @return  A chd_error.
+ */
+
+chd_error chd_file::read_hunks(uint32_t hunknum, uint32_t count, void *buffer)
+{
+	if (m_file == nullptr)
+		return CHDERR_NOT_OPEN;
+	if (uint64_t(hunknum) + count > m_hunkcount)
+		return CHDERR_HUNK_OUT_OF_RANGE;
+
+	// uncompressed data is just copied, and a single hunk isn't worth splitting
+	uint8_t *dest = reinterpret_cast<uint8_t *>(buffer);
+	if (compressed() && count > 1 && m_decode_queue == nullptr)
+		m_decode_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (!compressed() || count <= 1 || m_decode_queue == nullptr)
+	{
+		for (uint32_t index = 0; index < count; index++)
+		{
+			chd_error err = read_hunk(hunknum + index, dest + uint64_t(index) * m_hunkbytes);
+			if (err != CHDERR_NONE)
+				return err;
+		}
+		return CHDERR_NONE;
+	}
+
+	// split into plenty of batches so threads finishing early pick up more
+	uint32_t const batches = std::min<uint32_t>(count, 64);
+	std::vector<hunk_batch> batch(batches);
+	for (uint32_t index = 0; index < batches; index++)
+	{
+		uint32_t const first = uint64_t(count) * index / batches;
+		uint32_t const last = uint64_t(count) * (index + 1) / batches;
+		batch[index] = hunk_batch{ this, hunknum + first, last - first, dest + uint64_t(first) * m_hunkbytes, CHDERR_NONE };
+	}
+	osd_work_item_queue_multiple(m_decode_queue, read_hunks_static, batches, &batch[0], sizeof(batch[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(m_decode_queue, osd_ticks_per_second())) { }
+
+	for (hunk_batch &done : batch)
+		if (done.err != CHDERR_NONE)
+			return done.err;
+	return CHDERR_NONE;
+}
+
+/**
+ * @fn  void *chd_file::read_hunks_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunks_static - work item callback that decodes one batch of a read_hunks
+ *            call with an idle decoder, making one if there is none
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   If non-null, the hunk_batch.
+ * @param   threadid        The threadid.
+ *
+ * @return  null.
+ */
+
+void *chd_file::read_hunks_static(void *param, int threadid)
+{
+	hunk_batch &batch = *reinterpret_cast<hunk_batch *>(param);
+	chd_file &chd = *batch.chd;
+
+	hunk_decoder *decoder = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(chd.m_decoder_lock);
+		if (!chd.m_decoders.empty())
+		{
+			decoder = chd.m_decoders.back();
+			chd.m_decoders.pop_back();
+		}
+	}
+	if (decoder == nullptr)
+	{
+		decoder = new hunk_decoder;
+		for (int decompnum = 0; decompnum < ARRAY_LENGTH(decoder->decompressor); decompnum++)
+			decoder->decompressor[decompnum] = chd_codec_list::new_decompressor(chd.m_compression[decompnum], chd);
+		decoder->compressed.resize(chd.m_hunkbytes);
+	}
+
+	for (uint32_t index = 0; index < batch.count && batch.err == CHDERR_NONE; index++)
+		batch.err = chd.decode_hunk(batch.hunknum + index, batch.dest + uint64_t(index) * chd.m_hunkbytes, decoder->decompressor, decoder->compressed);
+
+	std::lock_guard<std::mutex> lock(chd.m_decoder_lock);
+	chd.m_decoders.push_back(decoder);
+	return nullptr;
+}
+
+/**
+ * @fn  chd_error chd_file::preload(uint32_t hunknum, uint32_t count)
+ *
+ * @brief   -------------------------------------------------
+ *            preload - decompress a run of hunks on all processors into the hunk cache, for
+ *            readers that go through read_bytes a piece of a hunk at a time; limited to half
+ *            the cache budget so the start of the run is still there when it is read
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The first hunknum.
+ * @param   count   Number of hunks.
+ *
+ * @return  A chd_error.
+ */
+
+chd_error chd_file::preload(uint32_t hunknum, uint32_t count)
+{
+	chd_hunk_cache &cache = chd_hunk_cache::instance();
+	if (!compressed() || hunknum >= m_hunkcount)
+		return CHDERR_NONE;
+	count = std::min<uint64_t>({ count, m_hunkcount - hunknum, cache.budget() / 2 / m_hunkbytes });
+	if (count == 0)
+		return CHDERR_NONE;
+
+	std::vector<uint8_t> data(uint64_t(count) * m_hunkbytes);
+	chd_error err = read_hunks(hunknum, count, &data[0]);
+	if (err != CHDERR_NONE)
+		return err;
+	for (uint32_t index = 0; index < count; index++)
+	{
+		const uint8_t *start = &data[uint64_t(index) * m_hunkbytes];
+		cache.insert(this, hunknum + index, std::vector<uint8_t>(start, start + m_hunkbytes), true);
+	}
+	return CHDERR_NONE;
+}
+
 /**
  * @fn  chd_error chd_file::write_hunk(uint32_t hunknum, const void *buffer)
  *
@@ -1016,6 +1377,9 @@ chd_error chd_file::read_hunk(uint32_t hunknum, void *buffer)
 
 chd_error chd_file::write_hunk(uint32_t hunknum, const void *buffer)
 {
+	// keep readahead from caching the old contents behind our back
+	std::lock_guard<std::recursive_mutex> lock(m_hunk_lock);
+
 	// wrap this for clean reporting
 	try
 	{
@@ -1062,15 +1426,14 @@ chd_error chd_file::write_hunk(uint32_t hunknum, const void *buffer)
 			// write the map entry back
 			be_write(rawmap, rawentry, 4);
 			file_write(m_mapoffset + hunknum * 4, rawmap, 4);
-
-			// update the cached hunk if we just wrote it
-			if (hunknum == m_cachehunk && buffer != &m_cache[0])
-				memcpy(&m_cache[0], buffer, m_hunkbytes);
 		}
 
 		// otherwise, just overwrite
 		else
 			file_write(uint64_t(rawentry) * uint64_t(m_hunkbytes), buffer, m_hunkbytes);
+
+		// any cached copy is stale now
+		chd_hunk_cache::instance().invalidate(this, hunknum);
 		return CHDERR_NONE;
 	}
 
@@ -1123,8 +1486,8 @@ chd_error chd_file::write_units(uint64_t unitnum, const void *buffer, uint32_t c
  * @fn  chd_error chd_file::read_bytes(uint64_t offset, void *buffer, uint32_t bytes)
  *
  * @brief   -------------------------------------------------
- *            read_bytes - read from the CHD at a byte level, using the cache to handle partial
- *            hunks
+ *            read_bytes - read from the CHD at a byte level, using the shared hunk cache to
+ *            handle partial hunks and reading ahead when access is sequential
  *          -------------------------------------------------.
  *
  * @param   offset          The offset.
@@ -1140,44 +1503,101 @@ chd_error chd_file::read_bytes(uint64_t offset, void *buffer, uint32_t bytes)
 	uint32_t first_hunk = offset / m_hunkbytes;
 	uint32_t last_hunk = (offset + bytes - 1) / m_hunkbytes;
 	uint8_t *dest = reinterpret_cast<uint8_t *>(buffer);
+	chd_hunk_cache &cache = chd_hunk_cache::instance();
 	for (uint32_t curhunk = first_hunk; curhunk <= last_hunk; curhunk++)
 	{
 		// determine start/end boundaries
 		uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
+		uint32_t length = endoffs + 1 - startoffs;
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
-		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
-			err = read_hunk(curhunk, dest);
+		// hunks stored as-is in a mapped file need neither the cache nor readahead
+		const uint8_t *mapped = (m_mapped != nullptr) ? mapped_hunk(curhunk) : nullptr;
+		if (mapped != nullptr)
+		{
+			memcpy(dest, mapped + startoffs, length);
+			dest += length;
+			continue;
+		}
 
-		// otherwise, read from the cache
-		else
+		// everything comes from the cache if it's there
+		chd_error err = CHDERR_NONE;
+		if (!cache.fetch(this, curhunk, dest, startoffs, length))
 		{
-			if (curhunk != m_cachehunk)
+			// if it's a full block, just read directly from disk
+			if (length == m_hunkbytes)
+				err = read_hunk(curhunk, dest);
+
+			// otherwise, decompress into the cache, unless readahead got there while we waited
+			else
 			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
+				std::lock_guard<std::recursive_mutex> lock(m_hunk_lock);
+				if (!cache.contains(this, curhunk))
+				{
+					std::vector<uint8_t> data(m_hunkbytes);
+					err = read_hunk(curhunk, &data[0]);
+					if (err != CHDERR_NONE)
+						return err;
+					memcpy(dest, &data[startoffs], length);
+					cache.insert(this, curhunk, std::move(data), false);
+				}
+				else
+					cache.fetch(this, curhunk, dest, startoffs, length);
 			}
-			memcpy(dest, &m_cache[startoffs], endoffs + 1 - startoffs);
 		}
 
 		// handle errors and advance
 		if (err != CHDERR_NONE)
 			return err;
-		dest += endoffs + 1 - startoffs;
+		dest += length;
+
+		// two hunks in a row is a stream; start fetching what comes next
+		std::lock_guard<std::recursive_mutex> lock(m_hunk_lock);
+		if (curhunk == m_lasthunk + 1)
+			m_sequential++;
+		else if (curhunk != m_lasthunk)
+			m_sequential = 0;
+		m_lasthunk = curhunk;
+		if (m_sequential != 0)
+			prefetch(curhunk + 1);
 	}
 	return CHDERR_NONE;
 }
 
+/**
+ * @fn  const uint8_t *chd_file::mapped_hunk(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            mapped_hunk - return a pointer to a hunk's data inside the mapped file, for
+ *            uncompressed v5 CHDs opened read-only; nullptr if the hunk isn't stored there
+ *            (not mapped, not yet written, or held in a parent that can't map it either)
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  null if it fails, else a pointer to m_hunkbytes bytes of hunk data.
+ */
+
+const uint8_t *chd_file::mapped_hunk(uint32_t hunknum)
+{
+	if (m_mapped == nullptr || m_version < 5 || compressed() || hunknum >= m_hunkcount)
+		return nullptr;
+
+	// a zero offset means the hunk comes from the parent, if there is one
+	uint64_t blockoffs = uint64_t(be_read(&m_rawmap[m_mapentrybytes * hunknum], 4)) * uint64_t(m_hunkbytes);
+	if (blockoffs == 0)
+		return (m_parent != nullptr) ? m_parent->mapped_hunk(hunknum) : nullptr;
+	if (blockoffs > m_mappedbytes || m_hunkbytes > m_mappedbytes - blockoffs)
+		return nullptr;
+	return m_mapped + blockoffs;
+}
+
 /**
  * @fn  chd_error chd_file::write_bytes(uint64_t offset, const void *buffer, uint32_t bytes)
  *
  * @brief   -------------------------------------------------
- *            write_bytes - write to the CHD at a byte level, using the cache to handle partial
- *            hunks
+ *            write_bytes - write to the CHD at a byte level, reading the rest of partial hunks
+ *            first
  *          -------------------------------------------------.
  *
  * @param   offset  The offset.
@@ -1199,21 +1619,17 @@ chd_error chd_file::write_bytes(uint64_t offset, const void *buffer, uint32_t by
 		uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just write directly to disk unless it's the cached hunk
+		// if it's a full block, just write directly to disk
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1)
 			err = write_hunk(curhunk, source);
 
-		// otherwise, write from the cache
+		// otherwise, merge into the current contents in the scratch hunk
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
+			err = read_bytes(uint64_t(curhunk) * uint64_t(m_hunkbytes), &m_cache[0], m_hunkbytes);
+			if (err != CHDERR_NONE)
+				return err;
 			memcpy(&m_cache[startoffs], source, endoffs + 1 - startoffs);
 			err = write_hunk(curhunk, &m_cache[0]);
 		}
@@ -1693,12 +2109,157 @@ const char *chd_file::error_string(chd_error err)
 	}
 }
 
+/**
+ * @fn  void chd_file::set_cache_budget(uint64_t bytes)
+ *
+ * @brief   -------------------------------------------------
+ *            set_cache_budget - set how much decompressed hunk data all open CHDs may keep
+ *            cached between them
+ *          -------------------------------------------------.
+ *
+ * @param   bytes   The budget in bytes.
+ */
+
+void chd_file::set_cache_budget(uint64_t bytes)
+{
+	chd_hunk_cache::instance().set_budget(bytes);
+}
+
+/**
+ * @fn  void chd_file::set_readahead(uint32_t hunks)
+ *
+ * @brief   -------------------------------------------------
+ *            set_readahead - set how many hunks to decompress ahead of sequential reads; 0
+ *            turns readahead off
+ *          -------------------------------------------------.
+ *
+ * @param   hunks   The number of hunks.
+ */
+
+void chd_file::set_readahead(uint32_t hunks)
+{
+	chd_hunk_cache::instance().set_readahead(hunks);
+}
+
+/**
+ * @fn  chd_cache_stats chd_file::cache_stats()
+ *
+ * @brief   -------------------------------------------------
+ *            cache_stats - return the hunk cache counters
+ *          -------------------------------------------------.
+ *
+ * @return  A chd_cache_stats.
+ */
+
+chd_cache_stats chd_file::cache_stats()
+{
+	return chd_hunk_cache::instance().stats();
+}
+
 
 
 //**************************************************************************
 //  INTERNAL HELPERS
 //**************************************************************************
 
+/**
+ * @fn  void chd_file::prefetch(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            prefetch - start decompressing the hunks from hunknum on into the cache on a work
+ *            queue; called with m_hunk_lock held
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The first hunk to fetch.
+ */
+
+void chd_file::prefetch(uint32_t hunknum)
+{
+	// stop at the end of the file
+	chd_hunk_cache &cache = chd_hunk_cache::instance();
+	uint32_t count = (hunknum < m_hunkcount) ? std::min(cache.readahead(), m_hunkcount - hunknum) : 0;
+	if (count == 0)
+		return;
+
+	// one job at a time; one still running is ahead of the reader anyway
+	if (m_prefetch_item != nullptr)
+	{
+		if (!osd_work_item_wait(m_prefetch_item, 0))
+			return;
+		osd_work_item_release(m_prefetch_item);
+		m_prefetch_item = nullptr;
+	}
+
+	// nothing to do if the end of the window is already there
+	if (cache.contains(this, hunknum + count - 1))
+		return;
+
+	if (m_prefetch_queue == nullptr)
+		m_prefetch_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (m_prefetch_queue == nullptr)
+		return;
+
+	m_prefetch_start = hunknum;
+	m_prefetch_count = count;
+	m_prefetch_cancel = false;
+	m_prefetch_item = osd_work_item_queue(m_prefetch_queue, prefetch_static, this, 0);
+}
+
+/**
+ * @fn  void chd_file::cancel_prefetch()
+ *
+ * @brief   -------------------------------------------------
+ *            cancel_prefetch - stop any readahead job, wait for it and free its queue
+ *          -------------------------------------------------.
+ */
+
+void chd_file::cancel_prefetch()
+{
+	if (m_prefetch_item != nullptr)
+	{
+		m_prefetch_cancel = true;
+		while (!osd_work_item_wait(m_prefetch_item, osd_ticks_per_second())) { }
+		osd_work_item_release(m_prefetch_item);
+		m_prefetch_item = nullptr;
+	}
+	if (m_prefetch_queue != nullptr)
+	{
+		osd_work_queue_free(m_prefetch_queue);
+		m_prefetch_queue = nullptr;
+	}
+}
+
+/**
+ * @fn  void *chd_file::prefetch_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            prefetch_static - work item callback that decompresses the readahead window
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   If non-null, the chd_file.
+ * @param   threadid        The threadid.
+ *
+ * @return  null.
+ */
+
+void *chd_file::prefetch_static(void *param, int threadid)
+{
+	chd_file &chd = *reinterpret_cast<chd_file *>(param);
+	chd_hunk_cache &cache = chd_hunk_cache::instance();
+	for (uint32_t hunknum = chd.m_prefetch_start; hunknum < chd.m_prefetch_start + chd.m_prefetch_count && !chd.m_prefetch_cancel; hunknum++)
+	{
+		// one hunk per lock, so the reader never waits long behind us
+		std::lock_guard<std::recursive_mutex> lock(chd.m_hunk_lock);
+		if (cache.contains(&chd, hunknum))
+			continue;
+		std::vector<uint8_t> data(chd.m_hunkbytes);
+		if (chd.read_hunk(hunknum, &data[0]) != CHDERR_NONE)
+			break;
+		cache.insert(&chd, hunknum, std::move(data), true);
+	}
+	return nullptr;
+}
+
 /**
  * @fn  uint32_t chd_file::guess_unitbytes()
  *
@@ -2320,6 +2881,7 @@ chd_error chd_file::create_common()
 		// writes are obviously permitted; reads only if uncompressed
 		m_allow_writes = true;
 		m_allow_reads = !compressed();
+		m_writeable = true;
 
 		// write out the map (if not compressed)
 		if (!compressed())
@@ -2385,6 +2947,15 @@ chd_error chd_file::open_common(bool writeable)
 		// reads are always permitted
 		m_allow_reads = true;
 
+		// files we won't write are read straight out of a mapping when the OS offers one;
+		// mixing writes with a mapping isn't coherent everywhere
+		if (!writeable)
+		{
+			m_mapped = reinterpret_cast<const uint8_t *>(m_file->map());
+			if (m_mapped != nullptr)
+				m_mappedbytes = m_file->size();
+		}
+
 		// read the raw header
 		uint8_t rawheader[MAX_HEADER_SIZE];
 		file_read(0, rawheader, sizeof(rawheader));
@@ -2411,6 +2982,7 @@ chd_error chd_file::open_common(bool writeable)
 
 		if (writeable && !m_allow_writes)
 			throw CHDERR_FILE_NOT_WRITEABLE;
+		m_writeable = writeable;
 
 		// make sure we have a parent if we need one (and don't if we don't)
 		if (parentsha1 != util::sha1_t::null)
@@ -2751,7 +3323,8 @@ int CLIB_DECL chd_file::metadata_hash_compare(const void *elem1, const void *ele
  */
 
 chd_file_compressor::chd_file_compressor()
-	: m_walking_parent(false),
+	: m_adaptive(false),
+		m_walking_parent(false),
 		m_total_in(0),
 		m_total_out(0),
 		m_read_queue(nullptr),
@@ -2763,6 +3336,7 @@ chd_file_compressor::chd_file_compressor()
 {
 	// zap arrays
 	memset(m_codecs, 0, sizeof(m_codecs));
+	memset(&m_stats, 0, sizeof(m_stats));
 
 	// allocate work queues
 	m_read_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
@@ -2807,6 +3381,9 @@ void chd_file_compressor::compress_begin()
 	// reset our maps
 	m_parent_map.reset();
 	m_current_map.reset();
+	for (auto &elem : m_fill_hunk)
+		elem = hashmap::NOT_FOUND;
+	memset(&m_stats, 0, sizeof(m_stats));
 
 	// reset read state
 	m_read_queue_offset = 0;
@@ -2831,6 +3408,7 @@ void chd_file_compressor::compress_begin()
 	{
 		delete elem;
 		elem = new chd_compressor_group(*this, m_compression);
+		elem->set_adaptive(m_adaptive);
 	}
 
 	// reset write state
@@ -2923,11 +3501,21 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 		// for compressing, process the result
 		else do
 		{
+			// hunks filled with a single byte value are copies of the first such hunk written
+			if (item.m_fill != -1 && m_fill_hunk[item.m_fill] != hashmap::NOT_FOUND)
+			{
+				hunk_copy_from_self(item.m_hunknum, m_fill_hunk[item.m_fill]);
+				m_stats.self++;
+				m_stats.filled++;
+				break;
+			}
+
 			// first see if the hunk is in the parent or self maps
 			uint64_t selfhunk = m_current_map.find(item.m_hash[0].m_crc16, item.m_hash[0].m_sha1);
 			if (selfhunk != hashmap::NOT_FOUND)
 			{
 				hunk_copy_from_self(item.m_hunknum, selfhunk);
+				m_stats.self++;
 				break;
 			}
 
@@ -2938,6 +3526,7 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 				if (parentunit != hashmap::NOT_FOUND)
 				{
 					hunk_copy_from_parent(item.m_hunknum, parentunit);
+					m_stats.parent++;
 					break;
 				}
 			}
@@ -2946,6 +3535,12 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 			hunk_write_compressed(item.m_hunknum, item.m_compression, item.m_compressed, item.m_complen, item.m_hash[0].m_crc16);
 			m_total_out += item.m_complen;
 			m_current_map.add(item.m_hunknum, item.m_hash[0].m_crc16, item.m_hash[0].m_sha1);
+			if (item.m_fill != -1)
+				m_fill_hunk[item.m_fill] = item.m_hunknum;
+			if (item.m_compression == -1)
+				m_stats.uncompressed++;
+			else
+				m_stats.compressed++;
 		} while (0);
 
 		// reset the item and advance
@@ -3071,6 +3666,18 @@ void chd_file_compressor::async_compress_hunk(work_item &item, int threadid)
 	assert(threadid < ARRAY_LENGTH(m_codecs));
 	item.m_codecs = m_codecs[threadid];
 
+	// a hunk filled with a byte value that's already been written needs neither hashing nor compressing
+	item.m_fill = -1;
+	if (compressed() && !memcmp(item.m_data, item.m_data + 1, hunk_bytes() - 1))
+	{
+		item.m_fill = item.m_data[0];
+		if (m_fill_hunk[item.m_fill] != hashmap::NOT_FOUND)
+		{
+			item.m_status = WS_COMPLETE;
+			return;
+		}
+	}
+
 	// compute CRC-16 and SHA-1 hashes
 	item.m_hash[0].m_crc16 = util::crc16_creator::simple(item.m_data, hunk_bytes());
 	item.m_hash[0].m_sha1 = util::sha1_creator::simple(item.m_data, hunk_bytes());
@@ -3182,6 +3789,31 @@ void chd_file_compressor::async_read()
 
 
 
+/**
+ * @fn  chd_file_compressor::compress_stats chd_file_compressor::compression_stats() const
+ *
+ * @brief   -------------------------------------------------
+ *            compression_stats - return statistics gathered by the last compression
+ *          -------------------------------------------------.
+ *
+ * @return  The statistics.
+ */
+
+chd_file_compressor::compress_stats chd_file_compressor::compression_stats() const
+{
+	compress_stats result = m_stats;
+	for (auto const &elem : m_codecs)
+		if (elem != nullptr)
+		{
+			result.codec_trials += elem->codec_trials();
+			result.codec_skips += elem->codec_skips();
+			result.incompressible += elem->incompressible_hunks();
+		}
+	return result;
+}
+
+
+
 //**************************************************************************
 //  CHD COMPRESSOR HASHMAP
 //**************************************************************************
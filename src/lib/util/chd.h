@@ -22,6 +22,7 @@
 #include "hashing.h"
 #include "chdcodec.h"
 #include <atomic>
+#include <mutex>
 
 /***************************************************************************
 
@@ -283,6 +284,19 @@ enum chd_error
 class chd_codec;
 
 
+// ======================> chd_cache_stats
+
+// counters for the hunk cache shared by all open CHDs
+struct chd_cache_stats
+{
+	uint64_t                hits;               // partial reads served from the cache
+	uint64_t                misses;             // partial reads that had to decompress
+	uint64_t                prefetched;         // hunks decompressed by readahead
+	uint64_t                prefetch_hits;      // hits on hunks brought in by readahead
+	uint64_t                bytes;              // hunk data currently held
+};
+
+
 // ======================> chd_file
 
 // core file class
@@ -308,6 +322,7 @@ public:
 
 	// getters
 	bool opened() const { return (m_file != nullptr); }
+	bool writeable() const { return m_writeable; }
 	uint32_t version() const { return m_version; }
 	uint64_t logical_bytes() const { return m_logicalbytes; }
 	uint32_t hunk_bytes() const { return m_hunkbytes; }
@@ -346,6 +361,9 @@ public:
 	chd_error write_units(uint64_t unitnum, const void *buffer, uint32_t count = 1);
 	chd_error read_bytes(uint64_t offset, void *buffer, uint32_t bytes);
 	chd_error write_bytes(uint64_t offset, const void *buffer, uint32_t bytes);
+	const uint8_t *mapped_hunk(uint32_t hunknum);
+	chd_error read_hunks(uint32_t hunknum, uint32_t count, void *buffer);
+	chd_error preload(uint32_t hunknum, uint32_t count);
 
 	// metadata management
 	chd_error read_metadata(chd_metadata_tag searchtag, uint32_t searchindex, std::string &output);
@@ -367,9 +385,16 @@ public:
 	// static helpers
 	static const char *error_string(chd_error err);
 
+	// hunk cache shared by all open CHDs
+	static void set_cache_budget(uint64_t bytes);
+	static void set_readahead(uint32_t hunks);
+	static chd_cache_stats cache_stats();
+
 private:
 	struct metadata_entry;
 	struct metadata_hash;
+	struct hunk_decoder;
+	struct hunk_batch;
 
 	// inline helpers
 	uint64_t be_read(const uint8_t *base, int numbytes);
@@ -399,12 +424,20 @@ private:
 	void metadata_set_previous_next(uint64_t prevoffset, uint64_t nextoffset);
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
+	void prefetch(uint32_t hunknum);
+	void cancel_prefetch();
+	static void *prefetch_static(void *param, int threadid);
+	chd_error decode_hunk(uint32_t hunknum, void *buffer, chd_decompressor *const *decompressor, std::vector<uint8_t> &compbuf);
+	static void *read_hunks_static(void *param, int threadid);
 
 	// file characteristics
 	util::core_file *       m_file;             // handle to the open core file
 	bool                    m_owns_file;        // flag indicating if this file should be closed on chd_close()
 	bool                    m_allow_reads;      // permit reads from this CHD?
 	bool                    m_allow_writes;     // permit writes to this CHD?
+	bool                    m_writeable;        // created, or opened for writing?
+	const uint8_t *         m_mapped;           // the whole file mapped into memory, if opened read-only
+	uint64_t                m_mappedbytes;      // size of the mapping
 
 	// core parameters from the header
 	uint32_t                  m_version;          // version of the header
@@ -433,10 +466,21 @@ private:
 	// compression management
 	chd_decompressor *      m_decompressor[4];  // array of decompression codecs
 	std::vector<uint8_t>          m_compressed;       // temporary buffer for compressed data
+	std::mutex              m_file_lock;        // serialises reads of the file between hunk decoders
+	std::mutex              m_decoder_lock;     // guards the idle decoder list
+	std::vector<hunk_decoder *> m_decoders;     // idle decoders for read_hunks, one per thread it has used
+	osd_work_queue *        m_decode_queue;     // read_hunks work queue, created on first use
 
 	// caching
-	std::vector<uint8_t>          m_cache;            // single-hunk cache for partial reads/writes
-	uint32_t                  m_cachehunk;        // which hunk is in the cache?
+	std::vector<uint8_t>          m_cache;            // scratch hunk for partial writes
+	std::recursive_mutex    m_hunk_lock;        // held while reading a hunk, readahead reads on another thread
+	uint32_t                  m_lasthunk;         // last hunk read_bytes touched
+	uint32_t                  m_sequential;       // consecutive hunks read in a row
+	uint32_t                  m_prefetch_start;   // first hunk the readahead job fetches
+	uint32_t                  m_prefetch_count;   // number of hunks it fetches
+	std::atomic<bool>       m_prefetch_cancel;  // tells the readahead job to stop early
+	osd_work_queue *        m_prefetch_queue;   // readahead queue, created on first use
+	osd_work_item *         m_prefetch_item;    // outstanding readahead job, if any
 };
 
 
@@ -450,9 +494,24 @@ public:
 	chd_file_compressor();
 	virtual ~chd_file_compressor();
 
+	// statistics gathered during compression
+	struct compress_stats
+	{
+		uint64_t            compressed;         // hunks written with a codec
+		uint64_t            uncompressed;       // hunks written as-is
+		uint64_t            self;               // hunks copied from an earlier hunk
+		uint64_t            filled;             // of those, hunks found to repeat a single byte
+		uint64_t            parent;             // hunks copied from the parent
+		uint64_t            codec_trials;       // codec attempts made
+		uint64_t            codec_skips;        // codec attempts skipped by adaptive prediction
+		uint64_t            incompressible;     // hunks not offered to any codec by adaptive mode
+	};
+
 	// compression management
+	void set_adaptive_compression(bool adaptive) { m_adaptive = adaptive; }
 	void compress_begin();
 	chd_error compress_continue(double &progress, double &ratio);
+	compress_stats compression_stats() const;
 
 protected:
 	// required override: read more data
@@ -527,6 +586,7 @@ private:
 			, m_compressed(nullptr)
 			, m_complen(0)
 			, m_compression(0)
+			, m_fill(-1)
 			, m_codecs(nullptr)
 		{ }
 
@@ -540,6 +600,7 @@ private:
 		uint8_t *             m_compressed;       // pointer to the compressed data
 		uint32_t              m_complen;          // compressed data length
 		int8_t                m_compression;      // type of compression used
+		int16_t               m_fill;             // byte value filling the whole hunk, or -1
 		chd_compressor_group *m_codecs;         // codec instance
 		std::vector<hash_pair> m_hash;        // array of hashes
 	};
@@ -553,6 +614,7 @@ private:
 	void async_read();
 
 	// current compression status
+	bool                    m_adaptive;         // let the codec groups predict the best codec?
 	bool                    m_walking_parent;   // are we building the parent map?
 	uint64_t                  m_total_in;         // total bytes in
 	uint64_t                  m_total_out;        // total bytes out
@@ -561,6 +623,10 @@ private:
 	// hash lookup maps
 	hashmap                 m_parent_map;       // hash map for parent
 	hashmap                 m_current_map;      // hash map for current
+	std::atomic<uint64_t>   m_fill_hunk[256];   // first hunk written for each single-byte fill
+
+	// statistics
+	compress_stats          m_stats;            // hunk counts gathered while writing
 
 	// read I/O thread
 	osd_work_queue *        m_read_queue;       // work queue for reading
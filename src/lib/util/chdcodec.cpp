@@ -18,7 +18,12 @@
 #include <zlib.h>
 #include "lzma/C/LzmaEnc.h"
 #include "lzma/C/LzmaDec.h"
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
 #include <new>
+#include <algorithm>
+#include <cmath>
 
 
 //**************************************************************************
@@ -159,6 +164,46 @@ private:
 };
 
 
+#ifdef USE_ZSTD
+// ======================> chd_zstd_compressor
+
+// Zstandard compressor
+class chd_zstd_compressor : public chd_compressor
+{
+public:
+	// construction/destruction
+	chd_zstd_compressor(chd_file &chd, uint32_t hunkbytes, bool lossy);
+	~chd_zstd_compressor();
+
+	// core functionality
+	virtual uint32_t compress(const uint8_t *src, uint32_t srclen, uint8_t *dest) override;
+
+private:
+	// internal state
+	ZSTD_CCtx *             m_context;
+};
+
+
+// ======================> chd_zstd_decompressor
+
+// Zstandard decompressor
+class chd_zstd_decompressor : public chd_decompressor
+{
+public:
+	// construction/destruction
+	chd_zstd_decompressor(chd_file &chd, uint32_t hunkbytes, bool lossy);
+	~chd_zstd_decompressor();
+
+	// core functionality
+	virtual void decompress(const uint8_t *src, uint32_t complen, uint8_t *dest, uint32_t destlen) override;
+
+private:
+	// internal state
+	ZSTD_DCtx *             m_context;
+};
+#endif
+
+
 // ======================> chd_huffman_compressor
 
 // Huffman compressor
@@ -468,11 +513,17 @@ const chd_codec_list::codec_entry chd_codec_list::s_codec_list[] =
 	{ CHD_CODEC_LZMA,       false,  "LZMA",                 &chd_codec_list::construct_compressor<chd_lzma_compressor>,     &chd_codec_list::construct_decompressor<chd_lzma_decompressor> },
 	{ CHD_CODEC_HUFFMAN,    false,  "Huffman",              &chd_codec_list::construct_compressor<chd_huffman_compressor>,  &chd_codec_list::construct_decompressor<chd_huffman_decompressor> },
 	{ CHD_CODEC_FLAC,       false,  "FLAC",                 &chd_codec_list::construct_compressor<chd_flac_compressor>,     &chd_codec_list::construct_decompressor<chd_flac_decompressor> },
+#ifdef USE_ZSTD
+	{ CHD_CODEC_ZSTD,       false,  "Zstandard",            &chd_codec_list::construct_compressor<chd_zstd_compressor>,     &chd_codec_list::construct_decompressor<chd_zstd_decompressor> },
+#endif
 
 	// general codecs with CD frontend
 	{ CHD_CODEC_CD_ZLIB,    false,  "CD Deflate",           &chd_codec_list::construct_compressor<chd_cd_compressor<chd_zlib_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_zlib_decompressor, chd_zlib_decompressor> > },
 	{ CHD_CODEC_CD_LZMA,    false,  "CD LZMA",              &chd_codec_list::construct_compressor<chd_cd_compressor<chd_lzma_compressor, chd_zlib_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_lzma_decompressor, chd_zlib_decompressor> > },
 	{ CHD_CODEC_CD_FLAC,    false,  "CD FLAC",              &chd_codec_list::construct_compressor<chd_cd_flac_compressor>,  &chd_codec_list::construct_decompressor<chd_cd_flac_decompressor> },
+#ifdef USE_ZSTD
+	{ CHD_CODEC_CD_ZSTD,    false,  "CD Zstandard",         &chd_codec_list::construct_compressor<chd_cd_compressor<chd_zstd_compressor, chd_zstd_compressor> >,        &chd_codec_list::construct_decompressor<chd_cd_decompressor<chd_zstd_decompressor, chd_zstd_decompressor> > },
+#endif
 
 	// A/V codecs
 	{ CHD_CODEC_AVHUFF,     false,  "A/V Huffman",          &chd_codec_list::construct_compressor<chd_avhuff_compressor>,   &chd_codec_list::construct_decompressor<chd_avhuff_decompressor> },
@@ -616,11 +667,19 @@ const chd_codec_list::codec_entry *chd_codec_list::find_in_list(chd_codec_type t
 
 chd_compressor_group::chd_compressor_group(chd_file &chd, uint32_t compressor_list[4])
 	: m_hunkbytes(chd.hunk_bytes()),
-		m_compress_test(m_hunkbytes)
+		m_compress_test(m_hunkbytes),
+		m_adaptive(false),
+		m_hunks(0),
+		m_trials(0),
+		m_skips(0),
+		m_incompressible(0)
 #if CHDCODEC_VERIFY_COMPRESSION
 		,m_decompressed(m_hunkbytes)
 #endif
 {
+	memset(m_score, 0, sizeof(m_score));
+	memset(m_margin, 0, sizeof(m_margin));
+
 	// verify the compression types and initialize the codecs
 	for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
 	{
@@ -663,47 +722,58 @@ int8_t chd_compressor_group::find_best_compressor(const uint8_t *src, uint8_t *c
 	// determine best compression technique
 	complen = m_hunkbytes;
 	int8_t compression = -1;
-	for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
-		if (m_compressor[codecnum] != nullptr)
-		{
-			// attempt to compress, swallowing errors
-			try
+	uint32_t compbytes[4] = { 0, 0, 0, 0 };
+
+	if (!m_adaptive)
+	{
+		for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
+			if (m_compressor[codecnum] != nullptr)
+				try_compressor(codecnum, src, compressed, complen, compression, compbytes[codecnum]);
+	}
+
+	// in adaptive mode, data that looks like noise is stored as-is
+	else if (looks_incompressible(src))
+		m_incompressible++;
+
+	// otherwise try the predicted winner first, then only the codecs that have
+	// recently come close to it; every 16th hunk races them all to keep the
+	// statistics honest
+	else
+	{
+		int predicted = -1;
+		for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
+			if (m_compressor[codecnum] != nullptr && (predicted == -1 || m_score[codecnum] > m_score[predicted]))
+				predicted = codecnum;
+		bool const race = ((m_hunks++ & 15) == 0);
+
+		bool tried[4] = { false, false, false, false };
+		if (predicted != -1)
+			tried[predicted] = try_compressor(predicted, src, compressed, complen, compression, compbytes[predicted]);
+		for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
+			if (m_compressor[codecnum] != nullptr && codecnum != predicted)
 			{
-				// if this is the best one, copy the data into the permanent buffer
-				uint32_t compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, &m_compress_test[0]);
-#if CHDCODEC_VERIFY_COMPRESSION
-				try
-				{
-					memset(m_decompressed, 0, m_hunkbytes);
-					m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
-				}
-				catch (...)
-				{
-				}
+				// skip codecs that have been more than 3% behind the winner lately
+				if (!race && m_margin[codecnum] > 256 + 8)
+					m_skips++;
+				else
+					tried[codecnum] = try_compressor(codecnum, src, compressed, complen, compression, compbytes[codecnum]);
+			}
 
-				if (memcmp(src, m_decompressed, m_hunkbytes) != 0)
-				{
-					compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, m_compress_test);
-					try
-					{
-						m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
-					}
-					catch (...)
-					{
-						memset(m_decompressed, 0, m_hunkbytes);
-					}
-				}
-printf("   codec%d=%d bytes            \n", codecnum, compbytes);
-#endif
-				if (compbytes < complen)
+		// update the predictions from what we learned
+		if (compression != -1)
+		{
+			for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
+			{
+				m_score[codecnum] -= m_score[codecnum] >> 3;
+				if (tried[codecnum])
 				{
-					compression = codecnum;
-					complen = compbytes;
-					memcpy(compressed, &m_compress_test[0], compbytes);
+					uint32_t const margin = uint64_t(compbytes[codecnum]) * 256 / std::max<uint32_t>(complen, 1);
+					m_margin[codecnum] = (m_margin[codecnum] * 3 + margin) / 4;
 				}
 			}
-			catch (...) { }
+			m_score[compression] += 256;
 		}
+	}
 
 	// if the best is none, copy it over
 	if (compression == -1)
@@ -712,6 +782,79 @@ printf("   codec%d=%d bytes            \n", codecnum, compbytes);
 }
 
 
+//-------------------------------------------------
+//  try_compressor - compress with a single codec,
+//  keeping the result if it's the best so far
+//-------------------------------------------------
+
+bool chd_compressor_group::try_compressor(int codecnum, const uint8_t *src, uint8_t *compressed, uint32_t &complen, int8_t &compression, uint32_t &compbytes)
+{
+	// attempt to compress, swallowing errors
+	m_trials++;
+	try
+	{
+		// if this is the best one, copy the data into the permanent buffer
+		compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, &m_compress_test[0]);
+#if CHDCODEC_VERIFY_COMPRESSION
+		try
+		{
+			memset(m_decompressed, 0, m_hunkbytes);
+			m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
+		}
+		catch (...)
+		{
+		}
+
+		if (memcmp(src, m_decompressed, m_hunkbytes) != 0)
+		{
+			compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, m_compress_test);
+			try
+			{
+				m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
+			}
+			catch (...)
+			{
+				memset(m_decompressed, 0, m_hunkbytes);
+			}
+		}
+printf("   codec%d=%d bytes            \n", codecnum, compbytes);
+#endif
+		if (compbytes < complen)
+		{
+			compression = codecnum;
+			complen = compbytes;
+			memcpy(compressed, &m_compress_test[0], compbytes);
+		}
+		return true;
+	}
+	catch (...) { }
+	return false;
+}
+
+
+//-------------------------------------------------
+//  looks_incompressible - estimate the order-0
+//  entropy of a hunk and report whether it's too
+//  close to 8 bits per byte to be worth compressing
+//-------------------------------------------------
+
+bool chd_compressor_group::looks_incompressible(const uint8_t *src) const
+{
+	// small hunks don't give a meaningful estimate
+	if (m_hunkbytes < 4096)
+		return false;
+
+	uint32_t histogram[256] = { 0 };
+	for (uint32_t bytenum = 0; bytenum < m_hunkbytes; bytenum++)
+		histogram[src[bytenum]]++;
+
+	double bits = 0.0;
+	for (uint32_t count : histogram)
+		if (count != 0)
+			bits -= double(count) * log2(double(count) / double(m_hunkbytes));
+	return bits >= 7.99 * double(m_hunkbytes);
+}
+
 
 //**************************************************************************
 //  ZLIB ALLOCATOR HELPER
@@ -1193,6 +1336,101 @@ void chd_lzma_decompressor::decompress(const uint8_t *src, uint32_t complen, uin
 
 
 
+#ifdef USE_ZSTD
+//**************************************************************************
+//  ZSTANDARD COMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_compressor - constructor
+//-------------------------------------------------
+
+chd_zstd_compressor::chd_zstd_compressor(chd_file &chd, uint32_t hunkbytes, bool lossy)
+	: chd_compressor(chd, hunkbytes, lossy),
+		m_context(ZSTD_createCCtx())
+{
+	if (m_context == nullptr)
+		throw std::bad_alloc();
+
+	// hunks are small; the content size field and checksum would only cost bytes
+	if (ZSTD_isError(ZSTD_CCtx_setParameter(m_context, ZSTD_c_compressionLevel, ZSTD_maxCLevel())) ||
+		ZSTD_isError(ZSTD_CCtx_setParameter(m_context, ZSTD_c_contentSizeFlag, 0)) ||
+		ZSTD_isError(ZSTD_CCtx_setParameter(m_context, ZSTD_c_checksumFlag, 0)))
+	{
+		ZSTD_freeCCtx(m_context);
+		throw CHDERR_CODEC_ERROR;
+	}
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_compressor - destructor
+//-------------------------------------------------
+
+chd_zstd_compressor::~chd_zstd_compressor()
+{
+	ZSTD_freeCCtx(m_context);
+}
+
+
+//-------------------------------------------------
+//  compress - compress data using the Zstandard
+//  codec
+//-------------------------------------------------
+
+uint32_t chd_zstd_compressor::compress(const uint8_t *src, uint32_t srclen, uint8_t *dest)
+{
+	// a destination no bigger than the source makes zstd fail rather than expand
+	size_t complen = ZSTD_compress2(m_context, dest, srclen, src, srclen);
+	if (ZSTD_isError(complen) || complen >= srclen)
+		throw CHDERR_COMPRESSION_ERROR;
+	return complen;
+}
+
+
+
+//**************************************************************************
+//  ZSTANDARD DECOMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_decompressor - constructor
+//-------------------------------------------------
+
+chd_zstd_decompressor::chd_zstd_decompressor(chd_file &chd, uint32_t hunkbytes, bool lossy)
+	: chd_decompressor(chd, hunkbytes, lossy),
+		m_context(ZSTD_createDCtx())
+{
+	if (m_context == nullptr)
+		throw std::bad_alloc();
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_decompressor - destructor
+//-------------------------------------------------
+
+chd_zstd_decompressor::~chd_zstd_decompressor()
+{
+	ZSTD_freeDCtx(m_context);
+}
+
+
+//-------------------------------------------------
+//  decompress - decompress data using the
+//  Zstandard codec
+//-------------------------------------------------
+
+void chd_zstd_decompressor::decompress(const uint8_t *src, uint32_t complen, uint8_t *dest, uint32_t destlen)
+{
+	size_t result = ZSTD_decompressDCtx(m_context, dest, destlen, src, complen);
+	if (ZSTD_isError(result) || result != destlen)
+		throw CHDERR_DECOMPRESSION_ERROR;
+}
+#endif // USE_ZSTD
+
+
+
 //**************************************************************************
 //  HUFFMAN COMPRESSOR
 //**************************************************************************
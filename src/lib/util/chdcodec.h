@@ -150,11 +150,30 @@ public:
 	// find the best compressor
 	int8_t find_best_compressor(const uint8_t *src, uint8_t *compressed, uint32_t &complen);
 
+	// adaptive mode: predict the winner from recent hunks rather than always trying every codec
+	void set_adaptive(bool adaptive) { m_adaptive = adaptive; }
+
+	// statistics
+	uint64_t codec_trials() const { return m_trials; }
+	uint64_t codec_skips() const { return m_skips; }
+	uint64_t incompressible_hunks() const { return m_incompressible; }
+
 private:
+	// internal helpers
+	bool looks_incompressible(const uint8_t *src) const;
+	bool try_compressor(int codecnum, const uint8_t *src, uint8_t *compressed, uint32_t &complen, int8_t &compression, uint32_t &compbytes);
+
 	// internal state
 	uint32_t                  m_hunkbytes;        // number of bytes in a hunk
 	chd_compressor *        m_compressor[4];    // array of active codecs
 	std::vector<uint8_t>          m_compress_test;    // test buffer for compression
+	bool                    m_adaptive;         // predict the best codec?
+	uint32_t                  m_hunks;            // hunks seen, for scheduling full races
+	uint32_t                  m_score[4];         // decaying win count for each codec
+	uint32_t                  m_margin[4];        // decaying size relative to the winner, in 1/256ths
+	uint64_t                  m_trials;           // number of codec attempts made
+	uint64_t                  m_skips;            // number of codec attempts skipped by prediction
+	uint64_t                  m_incompressible;   // number of hunks stored without trying any codec
 #if CHDCODEC_VERIFY_COMPRESSION
 	chd_decompressor *      m_decompressor[4];  // array of active codecs
 	std::vector<uint8_t>          m_decompressed;     // verification buffer
@@ -175,11 +194,13 @@ const chd_codec_type CHD_CODEC_ZLIB         = CHD_MAKE_TAG('z','l','i','b');
 const chd_codec_type CHD_CODEC_LZMA         = CHD_MAKE_TAG('l','z','m','a');
 const chd_codec_type CHD_CODEC_HUFFMAN      = CHD_MAKE_TAG('h','u','f','f');
 const chd_codec_type CHD_CODEC_FLAC         = CHD_MAKE_TAG('f','l','a','c');
+const chd_codec_type CHD_CODEC_ZSTD         = CHD_MAKE_TAG('z','s','t','d');
 
 // general codecs with CD frontend
 const chd_codec_type CHD_CODEC_CD_ZLIB      = CHD_MAKE_TAG('c','d','z','l');
 const chd_codec_type CHD_CODEC_CD_LZMA      = CHD_MAKE_TAG('c','d','l','z');
 const chd_codec_type CHD_CODEC_CD_FLAC      = CHD_MAKE_TAG('c','d','f','l');
+const chd_codec_type CHD_CODEC_CD_ZSTD      = CHD_MAKE_TAG('c','d','z','s');
 
 // A/V codecs
 const chd_codec_type CHD_CODEC_AVHUFF       = CHD_MAKE_TAG('a','v','h','u');
@@ -155,6 +155,7 @@ public:
 	virtual int ungetc(int c) override { return m_file.ungetc(c); }
 	virtual char *gets(char *s, int n) override { return m_file.gets(s, n); }
 	virtual const void *buffer() override { return m_file.buffer(); }
+	virtual const void *map() override { return m_file.map(); }
 
 	virtual std::uint32_t write(const void *buffer, std::uint32_t length) override { return m_file.write(buffer, length); }
 	virtual int puts(const char *s) override { return m_file.puts(s); }
@@ -241,6 +242,7 @@ public:
 
 	virtual std::uint32_t read(void *buffer, std::uint32_t length) override;
 	virtual void const *buffer() override { return m_data; }
+	virtual void const *map() override { return m_data; }
 
 	virtual std::uint32_t write(void const *buffer, std::uint32_t length) override { return 0; }
 	virtual osd_file::error truncate(std::uint64_t offset) override;
@@ -299,6 +301,8 @@ public:
 		: core_in_memory_file(openmode, length)
 		, m_file(std::move(file))
 		, m_zdata()
+		, m_mapped(nullptr)
+		, m_maptried(false)
 		, m_bufferbase(0)
 		, m_bufferbytes(0)
 	{
@@ -311,6 +315,7 @@ public:
 
 	virtual std::uint32_t read(void *buffer, std::uint32_t length) override;
 	virtual void const *buffer() override;
+	virtual void const *map() override;
 
 	virtual std::uint32_t write(void const *buffer, std::uint32_t length) override;
 	virtual osd_file::error truncate(std::uint64_t offset) override;
@@ -321,13 +326,17 @@ protected:
 	bool is_buffered() const { return (offset() >= m_bufferbase) && (offset() < (m_bufferbase + m_bufferbytes)); }
 
 private:
-	static constexpr std::size_t FILE_BUFFER_SIZE = 512;
+	static constexpr std::size_t FILE_BUFFER_SIZE = 4096;
+	static constexpr std::uint64_t MAP_THRESHOLD = 1 << 20;
 
+	std::uint8_t const *read_mapping();
 	osd_file::error osd_or_zlib_read(void *buffer, std::uint64_t offset, std::uint32_t length, std::uint32_t &actual);
 	osd_file::error osd_or_zlib_write(void const *buffer, std::uint64_t offset, std::uint32_t length, std::uint32_t &actual);
 
 	osd_file::ptr   m_file;                     // OSD file handle
 	zlib_data::ptr  m_zdata;                    // compression data
+	std::uint8_t const *m_mapped;               // read-only mapping of the whole file
+	bool            m_maptried;                 // have we tried to map it yet?
 	std::uint64_t   m_bufferbase;               // base offset of internal buffer
 	std::uint32_t   m_bufferbytes;              // bytes currently loaded into buffer
 	std::uint8_t    m_buffer[FILE_BUFFER_SIZE]; // buffer data
@@ -835,6 +844,16 @@ std::uint32_t core_osd_file::read(void *buffer, std::uint32_t length)
 	// flush any buffered char
 	clear_putback();
 
+	// large read-only files are copied straight out of a mapping, so small
+	// reads don't each cost a system call
+	std::uint8_t const *const mapped = read_mapping();
+	if (mapped)
+	{
+		auto const bytes_read = safe_buffer_copy(mapped, std::size_t(offset()), std::size_t(size()), buffer, 0, length);
+		add_offset(bytes_read);
+		return bytes_read;
+	}
+
 	std::uint32_t bytes_read = 0;
 
 	// if we're within the buffer, consume that first
@@ -884,21 +903,65 @@ void const *core_osd_file::buffer()
 		void *buf = allocate();
 		if (!buf) return nullptr;
 
-		// read the file
+		// read the file, or copy it if it's already mapped
 		std::uint32_t read_length = 0;
-		auto const filerr = osd_or_zlib_read(buf, 0, length(), read_length);
+		osd_file::error filerr = osd_file::error::NONE;
+		if (m_mapped && !m_zdata)
+		{
+			std::memcpy(buf, m_mapped, length());
+			read_length = length();
+		}
+		else
+		{
+			filerr = osd_or_zlib_read(buf, 0, length(), read_length);
+		}
 		if ((filerr != osd_file::error::NONE) || (read_length != length()))
 			purge();
 		else
 		{
 			// close the file because we don't need it anymore
 			m_file.reset();
+			m_mapped = nullptr;
 		}
 	}
 	return core_in_memory_file::buffer();
 }
 
 
+/*-------------------------------------------------
+    map - return a pointer to the file data
+    without reading it, if the OSD can map it
+-------------------------------------------------*/
+
+void const *core_osd_file::map()
+{
+	// data already in RAM is as good as a mapping; compressed data can't be mapped
+	if (is_loaded())
+		return core_in_memory_file::buffer();
+	if (!m_file || m_zdata || !length())
+		return nullptr;
+	return m_file->map(length());
+}
+
+
+/*-------------------------------------------------
+    read_mapping - map a large file opened for
+    reading only on first use; returns nullptr if
+    reads should go through the OSD file
+-------------------------------------------------*/
+
+std::uint8_t const *core_osd_file::read_mapping()
+{
+	if (!m_maptried)
+	{
+		m_maptried = true;
+		if (!write_access() && (length() >= MAP_THRESHOLD))
+			m_mapped = reinterpret_cast<std::uint8_t const *>(m_file->map(length()));
+	}
+	return m_zdata ? nullptr : m_mapped;
+}
+
+
 /*-------------------------------------------------
     write - write to a file
 -------------------------------------------------*/
@@ -99,6 +99,11 @@ public:
 	// this function may cause the full file data to be read
 	virtual const void *buffer() = 0;
 
+	// get a pointer to the full file data without reading it, or nullptr if the
+	// file can't be mapped; it stays valid until the file is closed, and later
+	// writes may not show through
+	virtual const void *map() = 0;
+
 	// open a file with the specified filename, read it into memory, and return a pointer
 	static osd_file::error load(std::string const &filename, void **data, std::uint32_t &length);
 	static osd_file::error load(std::string const &filename, std::vector<uint8_t> &data);
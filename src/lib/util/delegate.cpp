@@ -77,3 +77,37 @@ delegate_generic_function delegate_mfp::convert_to_generic(delegate_generic_clas
 }
 
 #endif
+
+
+
+#if (USE_DELEGATE_TYPE == DELEGATE_TYPE_MSVC)
+
+//-------------------------------------------------
+//  adjust_this_pointer - apply the this delta
+//  and, for classes of unknown inheritance, the
+//  virtual base displacement to the object
+//-------------------------------------------------
+
+void delegate_mfp::adjust_this_pointer(delegate_generic_class *&object) const
+{
+	std::uint8_t *byteptr = reinterpret_cast<std::uint8_t *>(object);
+
+	// the virtual base table offset is relative to the virtual base table pointer
+	if ((sizeof(unknown_base_equiv) == m_size) && m_vt_index)
+	{
+		std::uint8_t *const vbptr = byteptr + m_vptr_offs;
+		std::uint8_t const *const vbtable = *reinterpret_cast<std::uint8_t const *const *>(vbptr);
+		byteptr = vbptr + *reinterpret_cast<int const *>(vbtable + m_vt_index);
+	}
+
+	// then the non-virtual part
+	if (sizeof(single_base_equiv) < m_size)
+		byteptr += m_this_delta;
+
+#if defined(LOG_DELEGATES)
+	printf("Calculated this = %p\n", reinterpret_cast<void *>(byteptr));
+#endif
+	object = reinterpret_cast<delegate_generic_class *>(byteptr);
+}
+
+#endif
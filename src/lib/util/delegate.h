@@ -69,7 +69,17 @@
 
     Cons:
         * requires internal knowledge of the member function pointer
-        * only works for GCC (for now; MSVC info is also readily available)
+        * only works for GCC/clang and for MSVC on x64 and AArch64, where
+          the object is passed as an ordinary first argument
+
+    The MSVC flavour decodes MSVC's member function pointer layouts
+    (single, multiple and unknown inheritance); pointers to members of
+    classes using virtual inheritance can't be told apart from multiple
+    inheritance by size on 64-bit targets and aren't supported.
+
+    Delegates wrapping a std::function are called through a stub with
+    the function object as the object pointer, so every kind of
+    delegate is invoked with a single indirect call.
 
 ***************************************************************************/
 
@@ -79,6 +89,7 @@
 #pragma once
 
 // standard C++ includes
+#include <cassert>
 #include <cstring>
 #include <typeinfo>
 #include <utility>
@@ -108,7 +119,7 @@
 		#define MEMBER_ABI
 		#define HAS_DIFFERENT_ABI 0
 	#endif
-#elif defined(_MSC_VER) && defined (_M_X64)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
 #define MEMBER_ABI
 #define HAS_DIFFERENT_ABI 0
 #define USE_DELEGATE_TYPE DELEGATE_TYPE_MSVC
@@ -332,35 +343,44 @@ private:
 #elif (USE_DELEGATE_TYPE == DELEGATE_TYPE_MSVC)
 
 // ======================> delegate_mfp
-const int SINGLE_MEMFUNCPTR_SIZE = sizeof(void (delegate_generic_class::*)());
 
-// struct describing the contents of a member function pointer
+// struct describing the contents of a member function pointer; MSVC
+// uses the smallest layout that can describe the class:
+//   single inheritance:    { code }
+//   multiple inheritance:  { code, this delta }
+//   unknown inheritance:   { code, this delta, vbptr offset, vbtable offset }
+// the code pointer is either the function or a thunk that fetches the
+// right virtual function, so it's always safe to call directly
 class delegate_mfp
 {
+	struct single_base_equiv { delegate_generic_function fptr; };
+	struct multi_base_equiv { delegate_generic_function fptr; int thisdisp; };
+	struct unknown_base_equiv { delegate_generic_function fptr; int thisdisp, vptrdisp, vtdisp; };
+
 public:
 	// default constructor
 	delegate_mfp()
-		: m_function(0), m_this_delta(0), m_dummy1(0), m_dummy2(0), m_size(0)
+		: m_function(0), m_this_delta(0), m_vptr_offs(0), m_vt_index(0), m_size(0)
 	{
 	}
 
 	// copy constructor
 	delegate_mfp(const delegate_mfp &src)
-		: m_function(src.m_function), m_this_delta(0), m_dummy1(0), m_dummy2(0), m_size(0)
+		: m_function(src.m_function), m_this_delta(src.m_this_delta), m_vptr_offs(src.m_vptr_offs), m_vt_index(src.m_vt_index), m_size(src.m_size)
 	{
 	}
 
 	// construct from any member function pointer
 	template<typename _MemberFunctionType, class _MemberFunctionClass, typename _ReturnType, typename _StaticFunctionType>
 	delegate_mfp(_MemberFunctionType mfp, _MemberFunctionClass *, _ReturnType *, _StaticFunctionType)
+		: m_function(0), m_this_delta(0), m_vptr_offs(0), m_vt_index(0), m_size(sizeof(mfp))
 	{
-		//assert(sizeof(mfp) == 12 || sizeof(mfp) == 16);
-		m_size = sizeof(mfp);
+		static_assert(sizeof(mfp) <= sizeof(unknown_base_equiv), "Unsupported member function pointer size");
 		*reinterpret_cast<_MemberFunctionType *>(this) = mfp;
 	}
 
 	// comparison helpers
-	bool operator==(const delegate_mfp &rhs) const { return (m_function == rhs.m_function); }
+	bool operator==(const delegate_mfp &rhs) const { return (m_function == rhs.m_function) && (m_this_delta == rhs.m_this_delta) && (m_vptr_offs == rhs.m_vptr_offs) && (m_vt_index == rhs.m_vt_index); }
 	bool isnull() const { return (m_function == 0); }
 
 	// getters
@@ -371,24 +391,20 @@ public:
 	void update_after_bind(_FunctionType &funcptr, delegate_generic_class *&object)
 	{
 		funcptr = reinterpret_cast<_FunctionType>(m_function);
-		if (m_size == SINGLE_MEMFUNCPTR_SIZE + sizeof(int))
-			object = reinterpret_cast<delegate_generic_class *>(reinterpret_cast<std::uint8_t *>(object) + m_this_delta);
+		adjust_this_pointer(object);
 	}
 
 private:
-	// extract the generic function and adjust the object pointer
-	delegate_generic_function convert_to_generic(delegate_generic_class *&object) const;
+	// apply whatever adjustments the layout calls for to the object pointer
+	void adjust_this_pointer(delegate_generic_class *&object) const;
 
-	// actual state
-	uintptr_t               m_function;         // first item can be one of two things:
-												//    if even, it's a pointer to the function
-												//    if odd, it's the byte offset into the vtable
+	// actual state, laid out to overlay the largest member function pointer
+	uintptr_t               m_function;         // function or virtual call thunk
 	int                     m_this_delta;       // delta to apply to the 'this' pointer
+	int                     m_vptr_offs;        // offset of the virtual base table pointer
+	int                     m_vt_index;         // offset into the virtual base table
 
-	int                     m_dummy1;
-	int                     m_dummy2;
-
-	int                     m_size;
+	int                     m_size;             // size of the original member function pointer
 };
 
 #endif
@@ -435,7 +451,7 @@ public:
 			m_raw_mfp(src.m_raw_mfp),
 			m_std_func(src.m_std_func)
 	{
-		bind(src.object());
+		copy_binding(src);
 	}
 
 	// copy constructor with late bind
@@ -499,7 +515,7 @@ public:
 		bind(reinterpret_cast<delegate_generic_class *>(object));
 	}
 
-	// construct from static reference function with object reference
+	// construct from std::function
 	delegate_base(functional_type funcptr)
 		: m_function(nullptr),
 		m_object(nullptr),
@@ -507,7 +523,7 @@ public:
 		m_raw_function(nullptr),
 		m_std_func(funcptr)
 	{
-
+		bind(nullptr);
 	}
 
 	// copy operator
@@ -522,7 +538,7 @@ public:
 			m_raw_mfp = src.m_raw_mfp;
 			m_std_func = src.m_std_func;
 
-			bind(src.object());
+			copy_binding(src);
 		}
 		return *this;
 	}
@@ -538,8 +554,6 @@ public:
 	_ReturnType operator()(Params... args) const {
 		if (is_mfp() && (HAS_DIFFERENT_ABI))
 			return (*reinterpret_cast<generic_member_func>(m_function)) (m_object, std::forward<Params>(args)...);
-		else if (m_std_func)
-			return m_std_func(std::forward<Params>(args)...);
 		else
 			return (*m_function) (m_object, std::forward<Params>(args)...);
 	}
@@ -556,7 +570,7 @@ public:
 
 protected:
 	// return the actual object (not the one we use for calling)
-	delegate_generic_class *object() const { return is_mfp() ? m_raw_mfp.real_object(m_object) : m_object; }
+	delegate_generic_class *object() const { return m_std_func ? nullptr : is_mfp() ? m_raw_mfp.real_object(m_object) : m_object; }
 
 	// late binding function
 	using late_bind_func = delegate_generic_class*(*)(delegate_late_bind &object);
@@ -572,9 +586,40 @@ protected:
 		return reinterpret_cast<delegate_generic_class *>(result);
 	}
 
+	// take over another delegate's binding; the object pointer of a
+	// resolved member function has already had the this adjustment
+	// applied, so only bindings that point back into the delegate
+	// itself need redoing
+	void copy_binding(const delegate_base &src)
+	{
+		if (m_std_func || (is_mfp() && (USE_DELEGATE_TYPE == DELEGATE_TYPE_COMPATIBLE)))
+		{
+			bind(src.object());
+		}
+		else
+		{
+			m_object = src.m_object;
+			m_function = src.m_function;
+		}
+	}
+
+	// stub for calling std::function targets with the same signature as everything else
+	static _ReturnType std_func_stub(delegate_generic_class *object, Params... args)
+	{
+		return (*reinterpret_cast<const functional_type *>(object))(std::forward<Params>(args)...);
+	}
+
 	// bind the actual object
 	void bind(delegate_generic_class *object)
 	{
+		// std::function targets are their own object
+		if (m_std_func)
+		{
+			m_object = reinterpret_cast<delegate_generic_class *>(&m_std_func);
+			m_function = &std_func_stub;
+			return;
+		}
+
 		m_object = object;
 
 		// if we're wrapping a member function pointer, handle special stuff
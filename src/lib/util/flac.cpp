@@ -281,6 +281,7 @@ flac_decoder::flac_decoder()
 		m_sample_rate(0),
 		m_channels(0),
 		m_bits_per_sample(0),
+		m_block_size(0),
 		m_compressed_offset(0),
 		m_compressed_start(nullptr),
 		m_compressed_length(0),
@@ -300,6 +301,7 @@ flac_decoder::flac_decoder()
 flac_decoder::flac_decoder(const void *buffer, uint32_t length, const void *buffer2, uint32_t length2)
 	: m_decoder(FLAC__stream_decoder_new()),
 		m_file(nullptr),
+		m_block_size(0),
 		m_compressed_offset(0),
 		m_compressed_start(reinterpret_cast<const FLAC__byte *>(buffer)),
 		m_compressed_length(length),
@@ -317,6 +319,7 @@ flac_decoder::flac_decoder(const void *buffer, uint32_t length, const void *buff
 flac_decoder::flac_decoder(util::core_file &file)
 	: m_decoder(FLAC__stream_decoder_new()),
 		m_file(&file),
+		m_block_size(0),
 		m_compressed_offset(0),
 		m_compressed_start(nullptr),
 		m_compressed_length(0),
@@ -563,6 +566,7 @@ void flac_decoder::metadata_callback_static(const FLAC__StreamDecoder *decoder,
 	fldecoder->m_sample_rate = metadata->data.stream_info.sample_rate;
 	fldecoder->m_bits_per_sample = metadata->data.stream_info.bits_per_sample;
 	fldecoder->m_channels = metadata->data.stream_info.channels;
+	fldecoder->m_block_size = (metadata->data.stream_info.min_blocksize == metadata->data.stream_info.max_blocksize) ? metadata->data.stream_info.max_blocksize : 0;
 }
 
 
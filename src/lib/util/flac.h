@@ -96,6 +96,7 @@ public:
 	uint32_t sample_rate() const { return m_sample_rate; }
 	uint8_t channels() const { return m_channels; }
 	uint8_t bits_per_sample() const { return m_bits_per_sample; }
+	uint32_t block_size() const { return m_block_size; }
 	uint32_t total_samples() const { return FLAC__stream_decoder_get_total_samples(m_decoder); }
 	FLAC__StreamDecoderState state() const { return FLAC__stream_decoder_get_state(m_decoder); }
 	const char *state_string() const { return FLAC__stream_decoder_get_resolved_state_string(m_decoder); }
@@ -129,6 +130,7 @@ private:
 	uint32_t                m_sample_rate;          // decoded sample rate
 	uint8_t                 m_channels;             // decoded number of channels
 	uint8_t                 m_bits_per_sample;      // decoded bits per sample
+	uint32_t                m_block_size;           // fixed block size, or 0 if it varies
 	uint32_t                m_compressed_offset;    // current offset in compressed data
 	const FLAC__byte *      m_compressed_start;     // start of compressed data
 	uint32_t                m_compressed_length;    // length of compressed data
@@ -14,19 +14,119 @@
 
 #include <stdlib.h>
 
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
 
 /***************************************************************************
     TYPE DEFINITIONS
 ***************************************************************************/
 
+typedef std::map<uint32_t, std::vector<uint8_t>> sector_map;
+
 struct hard_disk_file
 {
 	chd_file *          chd;                /* CHD file */
 	hard_disk_info      info;               /* hard disk info */
+
+	/* write-back cache; the caller's reads and writes go through the maps, and
+	   the CHD is only written while flushing, possibly on a work queue thread */
+	uint32_t            cache_limit;        /* dirty bytes held before a flush starts; 0 writes straight through */
+	uint32_t            dirty_bytes;        /* bytes of sector data in dirty */
+	sector_map          dirty;              /* sectors written since the last flush started */
+	sector_map          flushing;           /* sectors the flush in progress is writing */
+	std::mutex          cache_lock;         /* guards the maps against the flush thread */
+	std::mutex          chd_lock;           /* guards the CHD against the flush thread */
+	osd_work_queue *    flush_queue;        /* queue for flushing in the background */
+	osd_work_item *     flush_item;         /* flush in progress, if any */
+	bool                flush_error;        /* a flush failed to write a sector */
 };
 
 
 
+/***************************************************************************
+    WRITE-BACK CACHE
+***************************************************************************/
+
+/*-------------------------------------------------
+    flush_sectors - write the sectors being
+    flushed to the CHD, in runs of consecutive
+    sectors; may run on a work queue thread
+-------------------------------------------------*/
+
+static void *flush_sectors(void *param, int threadid)
+{
+	hard_disk_file *file = (hard_disk_file *)param;
+	uint32_t const sectorbytes = file->info.sectorbytes;
+	std::vector<uint8_t> run;
+	bool error = false;
+
+	/* nothing else modifies the map until the flush is done, so it can be walked unlocked */
+	for (auto it = file->flushing.begin(); it != file->flushing.end(); )
+	{
+		uint32_t const first = it->first;
+		uint32_t next = first;
+		run.clear();
+		for ( ; it != file->flushing.end() && it->first == next && run.size() < 64 * 1024; ++it, ++next)
+			run.insert(run.end(), it->second.begin(), it->second.end());
+
+		std::lock_guard<std::mutex> lock(file->chd_lock);
+		if (file->chd->write_bytes(uint64_t(first) * sectorbytes, &run[0], run.size()) != CHDERR_NONE)
+			error = true;
+	}
+
+	std::lock_guard<std::mutex> lock(file->cache_lock);
+	file->flushing.clear();
+	file->flush_error |= error;
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    wait_for_flush - wait until a background
+    flush is done
+-------------------------------------------------*/
+
+static void wait_for_flush(hard_disk_file *file)
+{
+	if (file->flush_item != nullptr)
+	{
+		while (!osd_work_item_wait(file->flush_item, osd_ticks_per_second())) { }
+		osd_work_item_release(file->flush_item);
+		file->flush_item = nullptr;
+	}
+}
+
+
+/*-------------------------------------------------
+    start_flush - hand everything dirty to a
+    flush, in the background if asked to and a
+    work queue is available
+-------------------------------------------------*/
+
+static void start_flush(hard_disk_file *file, bool async)
+{
+	wait_for_flush(file);
+	{
+		std::lock_guard<std::mutex> lock(file->cache_lock);
+		if (file->dirty.empty())
+			return;
+		file->flushing.swap(file->dirty);
+		file->dirty_bytes = 0;
+	}
+
+	if (async && file->flush_queue == nullptr)
+		file->flush_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (async && file->flush_queue != nullptr)
+		file->flush_item = osd_work_item_queue(file->flush_queue, flush_sectors, file, 0);
+	else
+		flush_sectors(file, 0);
+}
+
+
+
 /***************************************************************************
     CORE IMPLEMENTATION
 ***************************************************************************/
@@ -57,7 +157,7 @@ hard_disk_file *hard_disk_open(chd_file *chd)
 		return nullptr;
 
 	/* allocate memory for the hard disk file */
-	file = (hard_disk_file *)malloc(sizeof(hard_disk_file));
+	file = new (std::nothrow) hard_disk_file();
 	if (file == nullptr)
 		return nullptr;
 
@@ -67,6 +167,11 @@ hard_disk_file *hard_disk_open(chd_file *chd)
 	file->info.heads = heads;
 	file->info.sectors = sectors;
 	file->info.sectorbytes = sectorbytes;
+	file->cache_limit = 0;
+	file->dirty_bytes = 0;
+	file->flush_queue = nullptr;
+	file->flush_item = nullptr;
+	file->flush_error = false;
 	return file;
 }
 
@@ -77,7 +182,11 @@ hard_disk_file *hard_disk_open(chd_file *chd)
 
 void hard_disk_close(hard_disk_file *file)
 {
-	free(file);
+	/* write out anything still cached */
+	hard_disk_flush(file);
+	if (file->flush_queue != nullptr)
+		osd_work_queue_free(file->flush_queue);
+	delete file;
 }
 
 
@@ -132,6 +241,21 @@ hard_disk_info *hard_disk_get_info(hard_disk_file *file)
 
 uint32_t hard_disk_read(hard_disk_file *file, uint32_t lbasector, void *buffer)
 {
+	/* sectors not yet flushed, or being flushed, are newer than the CHD */
+	{
+		std::lock_guard<std::mutex> lock(file->cache_lock);
+		for (const sector_map *map : { &file->dirty, &file->flushing })
+		{
+			auto found = map->find(lbasector);
+			if (found != map->end())
+			{
+				memcpy(buffer, &found->second[0], file->info.sectorbytes);
+				return 1;
+			}
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(file->chd_lock);
 	chd_error err = file->chd->read_units(lbasector, buffer);
 	return (err == CHDERR_NONE);
 }
@@ -156,6 +280,112 @@ uint32_t hard_disk_read(hard_disk_file *file, uint32_t lbasector, void *buffer)
 
 uint32_t hard_disk_write(hard_disk_file *file, uint32_t lbasector, const void *buffer)
 {
-	chd_error err = file->chd->write_units(lbasector, buffer);
-	return (err == CHDERR_NONE);
+	/* without a cache, write straight through */
+	if (file->cache_limit == 0)
+	{
+		std::lock_guard<std::mutex> lock(file->chd_lock);
+		chd_error err = file->chd->write_units(lbasector, buffer);
+		return (err == CHDERR_NONE);
+	}
+
+	/* otherwise, hold on to it until a flush; errors show up there */
+	bool full;
+	{
+		std::lock_guard<std::mutex> lock(file->cache_lock);
+		std::vector<uint8_t> &sector = file->dirty[lbasector];
+		if (sector.empty())
+		{
+			sector.resize(file->info.sectorbytes);
+			file->dirty_bytes += file->info.sectorbytes;
+		}
+		memcpy(&sector[0], buffer, file->info.sectorbytes);
+		full = file->dirty_bytes >= file->cache_limit;
+	}
+	if (full)
+		start_flush(file, true);
+	return 1;
+}
+
+
+/*-------------------------------------------------
+    hard_disk_set_write_cache - hold up to the
+    given number of bytes of writes in memory,
+    or write straight through if zero
+-------------------------------------------------*/
+
+/**
+ * @fn  void hard_disk_set_write_cache(hard_disk_file *file, uint32_t maxbytes)
+ *
+ * @brief   Hard disk set write cache.
+ *
+ * @param [in,out]  file    If non-null, the file.
+ * @param   maxbytes        The most dirty sector data to hold before flushing; 0 disables the cache.
+ */
+
+void hard_disk_set_write_cache(hard_disk_file *file, uint32_t maxbytes)
+{
+	/* writes to a read-only CHD must keep failing up front */
+	if (!file->chd->writeable())
+		maxbytes = 0;
+	if (maxbytes == 0)
+		hard_disk_flush(file);
+	file->cache_limit = maxbytes;
+}
+
+
+/*-------------------------------------------------
+    hard_disk_flush - write cached sectors to the
+    CHD, waiting for them unless asked not to
+-------------------------------------------------*/
+
+/**
+ * @fn  bool hard_disk_flush(hard_disk_file *file, bool wait)
+ *
+ * @brief   Hard disk flush.
+ *
+ * @param [in,out]  file    If non-null, the file.
+ * @param   wait            true to return only once everything is written.
+ *
+ * @return  false if any flush since the last check failed to write.
+ */
+
+bool hard_disk_flush(hard_disk_file *file, bool wait)
+{
+	start_flush(file, !wait);
+	if (wait)
+		wait_for_flush(file);
+
+	std::lock_guard<std::mutex> lock(file->cache_lock);
+	bool const ok = !file->flush_error;
+	file->flush_error = false;
+	return ok;
+}
+
+
+/*-------------------------------------------------
+    hard_disk_map - point at a sector in a
+    mapped uncompressed CHD without copying it
+-------------------------------------------------*/
+
+/**
+ * @fn  const void *hard_disk_map(hard_disk_file *file, uint32_t lbasector)
+ *
+ * @brief   Hard disk map.
+ *
+ * @param [in,out]  file    If non-null, the file.
+ * @param   lbasector       The lbasector.
+ *
+ * @return  null if the sector isn't mapped (read it with hard_disk_read instead), else a pointer to it.
+ */
+
+const void *hard_disk_map(hard_disk_file *file, uint32_t lbasector)
+{
+	uint32_t const sectorbytes = file->info.sectorbytes;
+	uint32_t const hunkbytes = file->chd->hunk_bytes();
+	if (sectorbytes == 0 || hunkbytes % sectorbytes != 0)
+		return nullptr;
+
+	uint32_t const perhunk = hunkbytes / sectorbytes;
+	const uint8_t *hunk = file->chd->mapped_hunk(lbasector / perhunk);
+	return (hunk != nullptr) ? (hunk + (lbasector % perhunk) * sectorbytes) : nullptr;
 }
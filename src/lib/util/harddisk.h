@@ -46,4 +46,8 @@ hard_disk_info *hard_disk_get_info(hard_disk_file *file);
 uint32_t hard_disk_read(hard_disk_file *file, uint32_t lbasector, void *buffer);
 uint32_t hard_disk_write(hard_disk_file *file, uint32_t lbasector, const void *buffer);
 
+void hard_disk_set_write_cache(hard_disk_file *file, uint32_t maxbytes);
+bool hard_disk_flush(hard_disk_file *file, bool wait = true);
+const void *hard_disk_map(hard_disk_file *file, uint32_t lbasector);
+
 #endif // MAME_UTIL_HARDDISK_H
@@ -12,6 +12,7 @@
 
 #include "hash.h"
 #include "hashing.h"
+#include <algorithm>
 #include <ctype.h>
 
 
@@ -30,6 +31,9 @@ char const *const hash_collection::HASH_TYPES_ALL = "RS";
 char const hash_collection::FLAG_NO_DUMP;
 char const hash_collection::FLAG_BAD_DUMP;
 
+// bytes fed to each hash in turn when computing several at once
+static constexpr uint32_t HASH_CHUNK_SIZE = 16 * 1024;
+
 
 
 //**************************************************************************
@@ -366,6 +370,21 @@ void hash_collection::buffer(const uint8_t *data, uint32_t length)
 {
 	assert(m_creator != nullptr);
 
+	// with both hashes active, make a single pass over the buffer so each chunk is
+	// still in cache for the SHA-1 after the CRC has read it
+	if (m_creator->m_doing_crc32 && m_creator->m_doing_sha1)
+	{
+		while (length != 0)
+		{
+			uint32_t const chunk = (std::min<uint32_t>)(length, HASH_CHUNK_SIZE);
+			m_creator->m_crc32_creator.append(data, chunk);
+			m_creator->m_sha1_creator.append(data, chunk);
+			data += chunk;
+			length -= chunk;
+		}
+		return;
+	}
+
 	// append to each active hash
 	if (m_creator->m_doing_crc32)
 		m_creator->m_crc32_creator.append(data, length);
@@ -10,9 +10,33 @@
 
 #include "hashing.h"
 #include <zlib.h>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
+// CRC-32 can use carry-less multiplication on x86, checked for at runtime, or the ARMv8 CRC instructions if the compiler targets them
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#define HASHING_USE_CLMUL       1
+#define HASHING_CLMUL_TARGET    __attribute__((target("pclmul,sse4.1")))
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+#include <intrin.h>
+#define HASHING_USE_CLMUL       1
+#define HASHING_CLMUL_TARGET
+#else
+#define HASHING_USE_CLMUL       0
+#endif
+
+#if !HASHING_USE_CLMUL && defined(__ARM_FEATURE_CRC32) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_acle.h>
+#define HASHING_USE_ARMV8_CRC   1
+#else
+#define HASHING_USE_ARMV8_CRC   0
+#endif
+
 
 namespace util {
 //**************************************************************************
@@ -26,6 +50,137 @@ const sha1_t sha1_t::null = { { 0 } };
 
 
 
+//**************************************************************************
+//  CRC-32 ACCELERATION
+//**************************************************************************
+
+namespace {
+
+#if HASHING_USE_CLMUL
+
+//-------------------------------------------------
+//  have_clmul - whether the CPU has PCLMULQDQ
+//  and SSE4.1
+//-------------------------------------------------
+
+bool have_clmul()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 1);
+	unsigned const ecx = info[2];
+#else
+	unsigned eax, ebx, ecx = 0, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return false;
+#endif
+	return (ecx & (1U << 1)) && (ecx & (1U << 19));
+}
+
+
+//-------------------------------------------------
+//  crc32_clmul - fold the data four lanes at a
+//  time with carry-less multiplies, then reduce;
+//  the length must be a multiple of 16 and at
+//  least 64, and the CRC is not inverted
+//-------------------------------------------------
+
+HASHING_CLMUL_TARGET uint32_t crc32_clmul(uint32_t crc, const uint8_t *data, std::size_t length)
+{
+	// x^n mod P for the fold distances, and the Barrett constants, bit-reflected
+	alignas(16) static const uint64_t k1k2[2] = { 0x0154442bd4, 0x01c6e41596 };
+	alignas(16) static const uint64_t k3k4[2] = { 0x01751997d0, 0x00ccaa009e };
+	alignas(16) static const uint64_t k5k0[2] = { 0x0163cd6124, 0x0000000000 };
+	alignas(16) static const uint64_t poly[2] = { 0x01db710641, 0x01f7011641 };
+
+	__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00));
+	__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10));
+	__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20));
+	__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(int(crc)));
+	__m128i k = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+	data += 64;
+	length -= 64;
+
+	// fold 64 bytes at a time
+	for ( ; length >= 64; data += 64, length -= 64)
+	{
+		__m128i const x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+		__m128i const x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+		__m128i const x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+		__m128i const x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30)));
+	}
+
+	// fold the four lanes into one, then whatever 16-byte blocks remain
+	k = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+	__m128i const *const rest[3] = { &x2, &x3, &x4 };
+	for (__m128i const *next : rest)
+	{
+		__m128i const lo = _mm_clmulepi64_si128(x1, k, 0x00);
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), *next), lo);
+	}
+	for ( ; length >= 16; data += 16, length -= 16)
+	{
+		__m128i const lo = _mm_clmulepi64_si128(x1, k, 0x00);
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data))), lo);
+	}
+
+	// fold 128 bits to 64
+	__m128i const mask = _mm_setr_epi32(~0, 0, ~0, 0);
+	x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+	k = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x00), x2);
+
+	// Barrett reduction to 32 bits
+	k = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+	x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x10);
+	x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), k, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+	return uint32_t(_mm_extract_epi32(x1, 1));
+}
+
+#endif // HASHING_USE_CLMUL
+
+
+#if HASHING_USE_ARMV8_CRC
+
+//-------------------------------------------------
+//  crc32_armv8 - eight bytes per instruction once
+//  the pointer is aligned
+//-------------------------------------------------
+
+uint32_t crc32_armv8(uint32_t crc, const uint8_t *data, std::size_t length)
+{
+	crc = ~crc;
+	for ( ; length && (uintptr_t(data) & 7); length--)
+		crc = __crc32b(crc, *data++);
+	for ( ; length >= 8; data += 8, length -= 8)
+	{
+		uint64_t value;
+		std::memcpy(&value, data, sizeof(value));
+		crc = __crc32d(crc, value);
+	}
+	for ( ; length; length--)
+		crc = __crc32b(crc, *data++);
+	return ~crc;
+}
+
+#endif // HASHING_USE_ARMV8_CRC
+
+} // anonymous namespace
+
+
+
 //**************************************************************************
 //  INLINE FUNCTIONS
 //**************************************************************************
@@ -186,7 +341,24 @@ std::string crc32_t::as_string() const
 
 void crc32_creator::append(const void *data, uint32_t length)
 {
-	m_accum.m_raw = crc32(m_accum, reinterpret_cast<const Bytef *>(data), length);
+	auto const *bytes = reinterpret_cast<const uint8_t *>(data);
+
+#if HASHING_USE_ARMV8_CRC
+	m_accum.m_raw = crc32_armv8(m_accum.m_raw, bytes, length);
+#else
+#if HASHING_USE_CLMUL
+	// fold whole 16-byte blocks, leaving zlib to finish off the tail
+	static bool const clmul = have_clmul();
+	if (clmul && (length >= 64))
+	{
+		uint32_t const bulk = length & ~uint32_t(15);
+		m_accum.m_raw = ~crc32_clmul(~m_accum.m_raw, bytes, bulk);
+		bytes += bulk;
+		length -= bulk;
+	}
+#endif
+	m_accum.m_raw = crc32(m_accum, reinterpret_cast<const Bytef *>(bytes), length);
+#endif
 }
 
 
@@ -121,12 +121,14 @@
 //  decoding context
 //-------------------------------------------------
 
-huffman_context_base::huffman_context_base(int numcodes, int maxbits, lookup_value *lookup, uint32_t *histo, node_t *nodes)
+huffman_context_base::huffman_context_base(int numcodes, int maxbits, lookup_value *lookup, uint32_t *histo, node_t *nodes, multi_value *multi)
 	: m_numcodes(numcodes),
 		m_maxbits(maxbits),
 		m_prevdata(0),
 		m_rleremaining(0),
 		m_lookup(lookup),
+		m_multi(multi),
+		m_multi_valid(false),
 		m_datahisto(histo),
 		m_huffnode(nodes)
 {
@@ -652,6 +654,9 @@ huffman_error huffman_context_base::assign_canonical_codes()
 
 void huffman_context_base::build_lookup_table()
 {
+	// the multi-symbol table is rebuilt on demand
+	m_multi_valid = false;
+
 	// iterate over all codes
 	for (int curcode = 0; curcode < m_numcodes; curcode++)
 	{
@@ -673,6 +678,42 @@ void huffman_context_base::build_lookup_table()
 }
 
 
+//-------------------------------------------------
+//  build_multi_table - build a lookup table that
+//  resolves as many whole codes as fit in
+//  MULTI_BITS bits of input
+//-------------------------------------------------
+
+void huffman_context_base::build_multi_table()
+{
+	for (uint32_t index = 0; index < (1 << MULTI_BITS); index++)
+	{
+		multi_value &entry = m_multi[index];
+		entry.m_count = entry.m_numbits = 0;
+
+		// the remaining bits are left-aligned in a field of width 'bitsleft'
+		uint32_t bits = index;
+		int bitsleft = MULTI_BITS;
+		while (entry.m_count < MULTI_MAX_SYMBOLS)
+		{
+			// look up the code at the top of the remaining bits
+			uint32_t lookupindex = (bitsleft >= m_maxbits) ? (bits >> (bitsleft - m_maxbits)) : (bits << (m_maxbits - bitsleft));
+			lookup_value lookup = m_lookup[lookupindex];
+			int numbits = lookup & 0x1f;
+
+			// stop if it's invalid or runs past the bits we have
+			if (numbits == 0 || numbits > bitsleft)
+				break;
+			entry.m_symbol[entry.m_count++] = lookup >> 5;
+			entry.m_numbits += numbits;
+			bitsleft -= numbits;
+			bits &= (1 << bitsleft) - 1;
+		}
+	}
+	m_multi_valid = true;
+}
+
+
 
 //**************************************************************************
 //  8-BIT ENCODER
@@ -754,8 +795,7 @@ huffman_error huffman_8bit_decoder::decode(const uint8_t *source, uint32_t sleng
 		return err;
 
 	// then decode the data
-	for (uint32_t cur = 0; cur < dlength; cur++)
-		dest[cur] = decode_one(bitbuf);
+	decode_block(bitbuf, dest, dlength);
 	bitbuf.flush();
 	return bitbuf.overflow() ? HUFFERR_INPUT_BUFFER_TOO_SMALL : HUFFERR_NONE;
 }
@@ -46,6 +46,18 @@ class huffman_context_base
 protected:
 	typedef uint16_t lookup_value;
 
+	// the multi-symbol table is indexed by this many bits, and resolves up to this many symbols
+	static constexpr int MULTI_BITS = 11;
+	static constexpr int MULTI_MAX_SYMBOLS = 3;
+
+	// an entry in the multi-symbol table; a zero count means the first code is too long
+	struct multi_value
+	{
+		uint16_t              m_symbol[MULTI_MAX_SYMBOLS]; // decoded symbols
+		uint8_t               m_count;                // number of symbols decoded
+		uint8_t               m_numbits;              // total bits used by those symbols
+	};
+
 	// a node in the huffman tree
 	struct node_t
 	{
@@ -57,7 +69,7 @@ protected:
 	};
 
 	// construction/destruction
-	huffman_context_base(int numcodes, int maxbits, lookup_value *lookup, uint32_t *histo, node_t *nodes);
+	huffman_context_base(int numcodes, int maxbits, lookup_value *lookup, uint32_t *histo, node_t *nodes, multi_value *multi = nullptr);
 
 	// tree creation
 	huffman_error compute_tree_from_histo();
@@ -76,6 +88,7 @@ protected:
 	int build_tree(uint32_t totaldata, uint32_t totalweight);
 	huffman_error assign_canonical_codes();
 	void build_lookup_table();
+	void build_multi_table();
 
 protected:
 	// internal state
@@ -84,6 +97,8 @@ protected:
 	uint8_t                   m_prevdata;             // value of the previous data (for delta-RLE encoding)
 	int                     m_rleremaining;         // number of RLE bytes remaining (for delta-RLE encoding)
 	lookup_value *          m_lookup;               // pointer to the lookup table
+	multi_value *           m_multi;                // pointer to the multi-symbol lookup table
+	bool                    m_multi_valid;          // whether the multi-symbol table matches the tree
 	uint32_t *                m_datahisto;            // histogram of data values
 	node_t *                m_huffnode;             // array of nodes
 };
@@ -126,11 +141,14 @@ class huffman_decoder : public huffman_context_base
 public:
 	// pass through to the underlying constructor
 	huffman_decoder()
-		: huffman_context_base(_NumCodes, _MaxBits, m_lookup_array, nullptr, m_huffnode_array) { }
+		: huffman_context_base(_NumCodes, _MaxBits, m_lookup_array, nullptr, m_huffnode_array, m_multi_array) { }
 
 	// single item operations
 	uint32_t decode_one(bitstream_in &bitbuf);
 
+	// bulk operations
+	template<typename _OutputType> void decode_block(bitstream_in &bitbuf, _OutputType *dest, uint32_t count);
+
 	// expose tree import
 	using huffman_context_base::import_tree_rle;
 	using huffman_context_base::import_tree_huffman;
@@ -139,6 +157,7 @@ private:
 	// array versions of the info we need
 	node_t                  m_huffnode_array[_NumCodes];
 	lookup_value            m_lookup_array[1 << _MaxBits];
+	multi_value             m_multi_array[1 << MULTI_BITS];
 };
 
 
@@ -219,4 +238,46 @@ inline uint32_t huffman_decoder<_NumCodes, _MaxBits>::decode_one(bitstream_in &b
 	return lookup >> 5;
 }
 
+
+//-------------------------------------------------
+//  decode_block - decode a run of codes from the
+//  huffman stream, several at a time where the
+//  codes are short
+//-------------------------------------------------
+
+template<int _NumCodes, int _MaxBits>
+template<typename _OutputType>
+inline void huffman_decoder<_NumCodes, _MaxBits>::decode_block(bitstream_in &bitbuf, _OutputType *dest, uint32_t count)
+{
+	// short runs don't pay for building the multi-symbol table
+	if (count >= (2 << MULTI_BITS))
+	{
+		if (!m_multi_valid)
+			build_multi_table();
+
+		// stop while there's still room for a full entry's worth of symbols
+		while (count >= MULTI_MAX_SYMBOLS)
+		{
+			const multi_value &entry = m_multi[bitbuf.peek(MULTI_BITS)];
+			if (entry.m_count == 0)
+			{
+				*dest++ = decode_one(bitbuf);
+				count--;
+			}
+			else
+			{
+				bitbuf.remove(entry.m_numbits);
+				for (int index = 0; index < MULTI_MAX_SYMBOLS; index++)
+					dest[index] = entry.m_symbol[index];
+				dest += entry.m_count;
+				count -= entry.m_count;
+			}
+		}
+	}
+
+	// finish one at a time
+	while (count-- != 0)
+		*dest++ = decode_one(bitbuf);
+}
+
 #endif // MAME_UTIL_HUFFMAN_H
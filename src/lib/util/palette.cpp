@@ -15,6 +15,13 @@
 #include <math.h>
 #include <algorithm>
 
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define PALETTE_USE_SSE2 1
+#else
+#define PALETTE_USE_SSE2 0
+#endif
+
 
 //**************************************************************************
 //  INLINE FUNCTIONS
@@ -27,11 +34,19 @@
 
 inline rgb_t palette_t::adjust_palette_entry(rgb_t entry, float brightness, float contrast, const uint8_t *gamma_map)
 {
+#if PALETTE_USE_SSE2
+	// all three channels at once; truncation and saturation match the scalar clamp
+	__m128 const channels = _mm_set_ps(0.0f, float(gamma_map[entry.r()]), float(gamma_map[entry.g()]), float(gamma_map[entry.b()]));
+	__m128i const result = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(channels, _mm_set1_ps(contrast)), _mm_set1_ps(brightness)));
+	__m128i const packed = _mm_packus_epi16(_mm_packs_epi32(result, result), _mm_setzero_si128());
+	return rgb_t((uint32_t(entry.a()) << 24) | (uint32_t(_mm_cvtsi128_si32(packed)) & 0x00ffffff));
+#else
 	int r = rgb_t::clamp(float(gamma_map[entry.r()]) * contrast + brightness);
 	int g = rgb_t::clamp(float(gamma_map[entry.g()]) * contrast + brightness);
 	int b = rgb_t::clamp(float(gamma_map[entry.b()]) * contrast + brightness);
 	int a = entry.a();
 	return rgb_t(a,r,g,b);
+#endif
 }
 
 
@@ -289,8 +304,7 @@ void palette_t::set_brightness(float brightness)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
-		for (int index = 0; index < m_numcolors; index++)
-			update_adjusted_color(groupnum, index);
+		update_adjusted_range(groupnum, 0, m_numcolors);
 }
 
 
@@ -308,8 +322,7 @@ void palette_t::set_contrast(float contrast)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
-		for (int index = 0; index < m_numcolors; index++)
-			update_adjusted_color(groupnum, index);
+		update_adjusted_range(groupnum, 0, m_numcolors);
 }
 
 
@@ -336,8 +349,7 @@ void palette_t::set_gamma(float gamma)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
-		for (int index = 0; index < m_numcolors; index++)
-			update_adjusted_color(groupnum, index);
+		update_adjusted_range(groupnum, 0, m_numcolors);
 }
 
 
@@ -363,6 +375,37 @@ void palette_t::entry_set_color(uint32_t index, rgb_t rgb)
 }
 
 
+//-------------------------------------------------
+//  entry_set_colors - set the raw RGB colors for
+//  a range of palette indices
+//-------------------------------------------------
+
+void palette_t::entry_set_colors(uint32_t start, const rgb_t *colors, uint32_t count)
+{
+	assert(start + count <= m_numcolors);
+
+	// store the new colors, noting the span that actually changed
+	uint32_t first = count, last = 0;
+	for (uint32_t index = 0; index < count; index++)
+	{
+		if (m_entry_color[start + index] != colors[index])
+		{
+			m_entry_color[start + index] = colors[index];
+			first = std::min(first, index);
+			last = index;
+		}
+	}
+
+	// if unchanged, ignore
+	if (first == count)
+		return;
+
+	// update the changed span across all groups
+	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
+		update_adjusted_range(groupnum, start + first, last + 1 - first);
+}
+
+
 //-------------------------------------------------
 //  entry_set_red_level - set the red level for a
 //  given palette index
@@ -471,8 +514,7 @@ void palette_t::group_set_brightness(uint32_t group, float brightness)
 	m_group_bright[group] = brightness;
 
 	// update across all colors
-	for (int index = 0; index < m_numcolors; index++)
-		update_adjusted_color(group, index);
+	update_adjusted_range(group, 0, m_numcolors);
 }
 
 
@@ -493,8 +535,7 @@ void palette_t::group_set_contrast(uint32_t group, float contrast)
 	m_group_contrast[group] = contrast;
 
 	// update across all colors
-	for (int index = 0; index < m_numcolors; index++)
-		update_adjusted_color(group, index);
+	update_adjusted_range(group, 0, m_numcolors);
 }
 
 
@@ -570,3 +611,36 @@ void palette_t::update_adjusted_color(uint32_t group, uint32_t index)
 	for (palette_client *client = m_client_list; client != nullptr; client = client->next())
 		client->mark_dirty(finalindex);
 }
+
+
+//-------------------------------------------------
+//  update_adjusted_range - update a span of
+//  color indices within one group
+//-------------------------------------------------
+
+void palette_t::update_adjusted_range(uint32_t group, uint32_t start, uint32_t count)
+{
+	// the group terms are the same for every color
+	float const brightness = m_group_bright[group] + m_brightness;
+	float const group_contrast = m_group_contrast[group];
+	uint32_t const groupbase = group * m_numcolors;
+
+	for (uint32_t index = start; index < start + count; index++)
+	{
+		// compute the adjusted value
+		rgb_t adjusted = adjust_palette_entry(m_entry_color[index], brightness, group_contrast * m_entry_contrast[index] * m_contrast, m_gamma_map);
+
+		// if not different, ignore
+		uint32_t finalindex = groupbase + index;
+		if (m_adjusted_color[finalindex] == adjusted)
+			continue;
+
+		// otherwise, modify the adjusted color array
+		m_adjusted_color[finalindex] = adjusted;
+		m_adjusted_rgb15[finalindex] = adjusted.as_rgb15();
+
+		// mark dirty in all clients
+		for (palette_client *client = m_client_list; client != nullptr; client = client->next())
+			client->mark_dirty(finalindex);
+	}
+}
@@ -171,6 +171,7 @@ public:
 
 	// entry setters
 	void entry_set_color(uint32_t index, rgb_t rgb);
+	void entry_set_colors(uint32_t start, const rgb_t *colors, uint32_t count);
 	void entry_set_red_level(uint32_t index, uint8_t level);
 	void entry_set_green_level(uint32_t index, uint8_t level);
 	void entry_set_blue_level(uint32_t index, uint8_t level);
@@ -196,6 +197,7 @@ private:
 	// internal helpers
 	rgb_t adjust_palette_entry(rgb_t entry, float brightness, float contrast, const uint8_t *gamma_map);
 	void update_adjusted_color(uint32_t group, uint32_t index);
+	void update_adjusted_range(uint32_t group, uint32_t start, uint32_t count);
 
 	// internal state
 	uint32_t          m_refcount;                   // reference count on the palette
@@ -4,7 +4,7 @@
 
     png.c
 
-    PNG reading functions.
+    PNG reading and writing functions.
 
 ***************************************************************************/
 
@@ -24,6 +24,13 @@
 #include <math.h>
 #include <stdlib.h>
 
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define PNG_USE_SSE2 1
+#else
+#define PNG_USE_SSE2 0
+#endif
+
 
 
 /***************************************************************************
@@ -911,88 +918,351 @@ static png_error write_chunk(util::core_file &fp, const uint8_t *data, uint32_t
 
 
 /*-------------------------------------------------
-    write_deflated_chunk - write an in-memory
-    chunk to the given file by deflating it
+    image encoding - the image is filtered and
+    deflated in bands of rows; big images are done
+    on a work queue, with one zlib stream stitched
+    together from the bands' raw deflate output
 -------------------------------------------------*/
 
-static png_error write_deflated_chunk(util::core_file &fp, uint8_t *data, uint32_t type, uint32_t length)
+namespace {
+
+constexpr uint32_t ENCODE_BAND_BYTES = 256 * 1024;      // aim for bands of about this much image data
+constexpr uint32_t ENCODE_MAX_BANDS = 32;               // but never split into more than this
+constexpr uint32_t DEFLATE_WINDOW = 32768;              // bytes of history a deflate stream can refer back to
+
+struct encode_band
 {
-	uint64_t lengthpos = fp.tell();
-	uint8_t tempbuff[8192];
-	uint32_t zlength = 0;
-	z_stream stream;
-	uint32_t crc;
-	int zerr;
+	const uint8_t *         source;         // unfiltered rows, each after a zero filter byte
+	uint8_t *               filtered;       // where the filtered rows go
+	const uint8_t *         zero_row;       // stands in for the row above the first
+	uint32_t                first_row;      // first row in this band
+	uint32_t                rows;           // number of rows in this band
+	uint32_t                rowbytes;       // bytes per row, not counting the filter byte
+	uint32_t                bpp;            // bytes per complete pixel
+	bool                    last;           // true for the band that finishes the stream
+	std::vector<uint8_t>    output;         // raw deflate data
+	uint32_t                adler;          // Adler-32 of this band's filtered data
+	png_error               error;          // result
+};
 
-	/* stuff the length/type into the buffer */
-	put_32bit(tempbuff + 0, length);
-	put_32bit(tempbuff + 4, type);
-	crc = crc32(0, tempbuff + 4, 4);
 
-	/* write that data */
-	if (fp.write(tempbuff, 8) != 8)
-		return PNGERR_FILE_ERROR;
+/*-------------------------------------------------
+    filter_cost - sum of absolute values of the
+    bytes as signed, the usual heuristic for which
+    filter will compress best
+-------------------------------------------------*/
 
-	/* initialize the stream */
-	memset(&stream, 0, sizeof(stream));
-	stream.next_in = data;
-	stream.avail_in = length;
-	zerr = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
-	if (zerr != Z_OK)
-		return PNGERR_COMPRESS_ERROR;
+uint32_t filter_cost(const uint8_t *data, uint32_t length)
+{
+	uint32_t cost = 0;
+	uint32_t i = 0;
+#if PNG_USE_SSE2
+	__m128i const zero = _mm_setzero_si128();
+	__m128i sum = zero;
+	for ( ; (i + 16) <= length; i += 16)
+	{
+		__m128i const v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+		sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_min_epu8(v, _mm_sub_epi8(zero, v)), zero));
+	}
+	cost = _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+#endif
+	for ( ; i < length; i++)
+		cost += (data[i] < 0x80) ? data[i] : (0x100 - data[i]);
+	return cost;
+}
 
-	/* now loop until we run out of data */
-	for ( ; ; )
+
+/*-------------------------------------------------
+    filter_row_* - apply one filter type to a row
+-------------------------------------------------*/
+
+void filter_row_sub(uint8_t *dst, const uint8_t *cur, uint32_t length, uint32_t bpp)
+{
+	uint32_t i = 0;
+	for ( ; i < bpp; i++)
+		dst[i] = cur[i];
+#if PNG_USE_SSE2
+	for ( ; (i + 16) <= length; i += 16)
 	{
-		/* compress this chunk */
-		stream.next_out = tempbuff;
-		stream.avail_out = sizeof(tempbuff);
-		zerr = deflate(&stream, Z_FINISH);
+		__m128i const x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur + i));
+		__m128i const a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur + i - bpp));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_sub_epi8(x, a));
+	}
+#endif
+	for ( ; i < length; i++)
+		dst[i] = cur[i] - cur[i - bpp];
+}
+
+void filter_row_up(uint8_t *dst, const uint8_t *cur, const uint8_t *prev, uint32_t length)
+{
+	uint32_t i = 0;
+#if PNG_USE_SSE2
+	for ( ; (i + 16) <= length; i += 16)
+	{
+		__m128i const x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur + i));
+		__m128i const b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_sub_epi8(x, b));
+	}
+#endif
+	for ( ; i < length; i++)
+		dst[i] = cur[i] - prev[i];
+}
+
+void filter_row_avg(uint8_t *dst, const uint8_t *cur, const uint8_t *prev, uint32_t length, uint32_t bpp)
+{
+	uint32_t i = 0;
+	for ( ; i < bpp; i++)
+		dst[i] = cur[i] - (prev[i] >> 1);
+#if PNG_USE_SSE2
+	__m128i const one = _mm_set1_epi8(1);
+	for ( ; (i + 16) <= length; i += 16)
+	{
+		// _mm_avg_epu8 rounds up, so take off the carry to get the filter's floor
+		__m128i const x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur + i));
+		__m128i const a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur + i - bpp));
+		__m128i const b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev + i));
+		__m128i const avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_sub_epi8(x, avg));
+	}
+#endif
+	for ( ; i < length; i++)
+		dst[i] = cur[i] - ((cur[i - bpp] + prev[i]) >> 1);
+}
+
+void filter_row_paeth(uint8_t *dst, const uint8_t *cur, const uint8_t *prev, uint32_t length, uint32_t bpp)
+{
+	uint32_t i = 0;
+	for ( ; i < bpp; i++)
+		dst[i] = cur[i] - prev[i];
+	for ( ; i < length; i++)
+	{
+		int const a = cur[i - bpp], b = prev[i], c = prev[i - bpp];
+		int const pa = std::abs(b - c), pb = std::abs(a - c), pc = std::abs(a + b - 2 * c);
+		dst[i] = cur[i] - (((pa <= pb) && (pa <= pc)) ? a : (pb <= pc) ? b : c);
+	}
+}
+
+
+/*-------------------------------------------------
+    filter_band - pick the cheapest filter for
+    each row of a band
+-------------------------------------------------*/
+
+void *filter_band(void *param, int threadid)
+{
+	encode_band &band = *reinterpret_cast<encode_band *>(param);
+	uint32_t const stride = band.rowbytes + 1;
 
-		/* if there's data to write, do it */
-		if (stream.avail_out < sizeof(tempbuff))
+	std::unique_ptr<uint8_t []> scratch;
+	try { scratch.reset(new uint8_t [4 * band.rowbytes]); }
+	catch (std::bad_alloc const &) { band.error = PNGERR_OUT_OF_MEMORY; return nullptr; }
+	uint8_t *const candidate[4] = { &scratch[0], &scratch[band.rowbytes], &scratch[2 * band.rowbytes], &scratch[3 * band.rowbytes] };
+
+	for (uint32_t row = band.first_row; row < band.first_row + band.rows; row++)
+	{
+		const uint8_t *const cur = band.source + row * stride + 1;
+		const uint8_t *const prev = row ? (cur - stride) : band.zero_row;
+		uint8_t *const dst = band.filtered + row * stride;
+
+		filter_row_sub(candidate[0], cur, band.rowbytes, band.bpp);
+		filter_row_up(candidate[1], cur, prev, band.rowbytes);
+		filter_row_avg(candidate[2], cur, prev, band.rowbytes, band.bpp);
+		filter_row_paeth(candidate[3], cur, prev, band.rowbytes, band.bpp);
+
+		// start with no filter and take anything cheaper
+		const uint8_t *best = cur;
+		uint8_t besttype = PNG_PF_None;
+		uint32_t bestcost = filter_cost(cur, band.rowbytes);
+		for (int type = 0; type < 4; type++)
 		{
-			int bytes = sizeof(tempbuff) - stream.avail_out;
-			if (fp.write(tempbuff, bytes) != bytes)
+			uint32_t const cost = filter_cost(candidate[type], band.rowbytes);
+			if (cost < bestcost)
 			{
-				deflateEnd(&stream);
-				return PNGERR_FILE_ERROR;
+				best = candidate[type];
+				besttype = PNG_PF_Sub + type;
+				bestcost = cost;
 			}
-			crc = crc32(crc, tempbuff, bytes);
-			zlength += bytes;
 		}
 
-		/* stop at the end of the stream */
-		if (zerr == Z_STREAM_END)
-			break;
+		dst[0] = besttype;
+		std::copy_n(best, band.rowbytes, dst + 1);
+	}
+
+	band.error = PNGERR_NONE;
+	return nullptr;
+}
+
 
-		/* other errors are fatal */
-		if (zerr != Z_OK)
+/*-------------------------------------------------
+    deflate_band - compress a band of filtered
+    rows to raw deflate data, primed with the end
+    of the previous band so little ratio is lost
+-------------------------------------------------*/
+
+void *deflate_band(void *param, int threadid)
+{
+	encode_band &band = *reinterpret_cast<encode_band *>(param);
+	uint32_t const stride = band.rowbytes + 1;
+	uint8_t *const data = band.filtered + band.first_row * stride;
+	uint32_t const length = band.rows * stride;
+	z_stream stream;
+	int zerr;
+
+	band.error = PNGERR_COMPRESS_ERROR;
+	band.adler = adler32(adler32(0, nullptr, 0), data, length);
+
+	memset(&stream, 0, sizeof(stream));
+	zerr = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+	if (zerr != Z_OK)
+		return nullptr;
+	if (band.first_row)
+	{
+		uint32_t const history = (std::min)(band.first_row * stride, DEFLATE_WINDOW);
+		if (deflateSetDictionary(&stream, data - history, history) != Z_OK)
+		{
+			deflateEnd(&stream);
+			return nullptr;
+		}
+	}
+
+	// all but the last band end on a byte boundary with a sync flush, so they can be joined
+	try { band.output.resize(deflateBound(&stream, length) + 16); }
+	catch (std::bad_alloc const &) { deflateEnd(&stream); band.error = PNGERR_OUT_OF_MEMORY; return nullptr; }
+	stream.next_in = data;
+	stream.avail_in = length;
+	stream.next_out = &band.output[0];
+	stream.avail_out = band.output.size();
+	int const flush = band.last ? Z_FINISH : Z_SYNC_FLUSH;
+	for ( ; ; )
+	{
+		zerr = deflate(&stream, flush);
+		if (band.last ? (zerr == Z_STREAM_END) : (((zerr == Z_OK) || (zerr == Z_BUF_ERROR)) && stream.avail_out))
+			break;
+		if ((zerr != Z_OK) && (zerr != Z_BUF_ERROR))
 		{
 			deflateEnd(&stream);
-			return PNGERR_COMPRESS_ERROR;
+			return nullptr;
 		}
+
+		// out of room, which deflateBound should make rare
+		size_t const used = band.output.size() - stream.avail_out;
+		try { band.output.resize(band.output.size() * 2); }
+		catch (std::bad_alloc const &) { deflateEnd(&stream); band.error = PNGERR_OUT_OF_MEMORY; return nullptr; }
+		stream.next_out = &band.output[used];
+		stream.avail_out = band.output.size() - used;
 	}
+	band.output.resize(band.output.size() - stream.avail_out);
 
-	/* clean up deflater(maus) */
+	// a stream that was only flushed reports a data error on the way out
 	zerr = deflateEnd(&stream);
-	if (zerr != Z_OK)
-		return PNGERR_COMPRESS_ERROR;
+	if ((zerr == Z_OK) || (!band.last && (zerr == Z_DATA_ERROR)))
+		band.error = PNGERR_NONE;
+	return nullptr;
+}
 
-	/* write the CRC */
-	put_32bit(tempbuff, crc);
-	if (fp.write(tempbuff, 4) != 4)
-		return PNGERR_FILE_ERROR;
 
-	/* seek back and update the length */
-	fp.seek(lengthpos, SEEK_SET);
-	put_32bit(tempbuff + 0, zlength);
-	if (fp.write(tempbuff, 4) != 4)
-		return PNGERR_FILE_ERROR;
+/*-------------------------------------------------
+    run_bands - run a callback for every band,
+    on the work queue if there is one
+-------------------------------------------------*/
 
-	/* return to the end */
-	fp.seek(lengthpos + 8 + zlength + 4, SEEK_SET);
-	return PNGERR_NONE;
+void run_bands(osd_work_queue *queue, osd_work_callback callback, std::vector<encode_band> &bands)
+{
+	if (queue && osd_work_item_queue_multiple(queue, callback, bands.size(), &bands[0], sizeof(bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE))
+		osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+	else
+		for (encode_band &band : bands)
+			(*callback)(&band, 0);
+}
+
+} // anonymous namespace
+
+
+/*-------------------------------------------------
+    write_image_chunk - filter and deflate the
+    image in a png_info, and write it as a single
+    IDAT chunk
+-------------------------------------------------*/
+
+static png_error write_image_chunk(util::core_file &fp, png_info &pnginfo)
+{
+	uint32_t const rowbytes = compute_rowbytes(pnginfo);
+	uint32_t const stride = rowbytes + 1;
+	uint32_t const length = pnginfo.height * stride;
+
+	// split into bands, and only bother with threads if there's more than one
+	uint32_t const bandcount = (std::max<uint32_t>)((std::min)((std::min)(length / ENCODE_BAND_BYTES, ENCODE_MAX_BANDS), pnginfo.height), 1);
+	osd_work_queue *const queue = (bandcount > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+
+	// palettized images compress best unfiltered; anything else gets a filter per row
+	bool const filter = (pnginfo.color_type != 3) && (pnginfo.bit_depth >= 8);
+	std::vector<uint8_t> filtered;
+	std::vector<uint8_t> zero_row;
+	if (filter)
+	{
+		try
+		{
+			filtered.resize(length);
+			zero_row.resize(rowbytes, 0);
+		}
+		catch (std::bad_alloc const &)
+		{
+			if (queue)
+				osd_work_queue_free(queue);
+			return PNGERR_OUT_OF_MEMORY;
+		}
+	}
+
+	std::vector<encode_band> bands(bandcount);
+	for (uint32_t index = 0; index < bandcount; index++)
+	{
+		encode_band &band = bands[index];
+		band.source = pnginfo.image.get();
+		band.filtered = filter ? filtered.data() : pnginfo.image.get();
+		band.zero_row = zero_row.data();
+		band.first_row = uint64_t(pnginfo.height) * index / bandcount;
+		band.rows = uint32_t(uint64_t(pnginfo.height) * (index + 1) / bandcount) - band.first_row;
+		band.rowbytes = rowbytes;
+		band.bpp = (std::max)(samples[pnginfo.color_type] * pnginfo.bit_depth / 8, 1);
+		band.last = (index == (bandcount - 1));
+		band.error = PNGERR_NONE;
+	}
+
+	// every band has to be filtered before any can use the one before as history
+	if (filter)
+		run_bands(queue, filter_band, bands);
+	for (encode_band const &band : bands)
+		if (band.error != PNGERR_NONE)
+		{
+			if (queue)
+				osd_work_queue_free(queue);
+			return band.error;
+		}
+	run_bands(queue, deflate_band, bands);
+	if (queue)
+		osd_work_queue_free(queue);
+
+	// stitch the bands into one zlib stream
+	size_t total = 2 + 4;
+	uint32_t adler = 0;
+	for (encode_band const &band : bands)
+	{
+		if (band.error != PNGERR_NONE)
+			return band.error;
+		adler = (&band == &bands[0]) ? band.adler : adler32_combine(adler, band.adler, band.rows * stride);
+		total += band.output.size();
+	}
+	std::vector<uint8_t> zdata;
+	try { zdata.reserve(total); }
+	catch (std::bad_alloc const &) { return PNGERR_OUT_OF_MEMORY; }
+	zdata.push_back(0x78);
+	zdata.push_back(0x9c);
+	for (encode_band const &band : bands)
+		zdata.insert(zdata.end(), band.output.begin(), band.output.end());
+	zdata.resize(total);
+	put_32bit(&zdata[total - 4], adler);
+
+	return write_chunk(fp, &zdata[0], PNG_CN_IDAT, total);
 }
 
 
@@ -1152,8 +1422,6 @@ static png_error write_png_stream(util::core_file &fp, png_info &pnginfo, const
 	if (error != PNGERR_NONE)
 		return error;
 
-	// if we wanted to get clever and do filtering, we would do it here
-
 	// write the IHDR chunk
 	put_32bit(tempbuff + 0, pnginfo.width);
 	put_32bit(tempbuff + 4, pnginfo.height);
@@ -1172,8 +1440,8 @@ static png_error write_png_stream(util::core_file &fp, png_info &pnginfo, const
 	if (error != PNGERR_NONE)
 		return error;
 
-	// write a single IDAT chunk */
-	error = write_deflated_chunk(fp, pnginfo.image.get(), PNG_CN_IDAT, pnginfo.height * (compute_rowbytes(pnginfo) + 1));
+	// filter, compress and write a single IDAT chunk
+	error = write_image_chunk(fp, pnginfo);
 	if (error != PNGERR_NONE)
 		return error;
 
@@ -31,6 +31,29 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* Whole blocks can go through the SHA extensions: on x86 when the CPU
+   reports them, on ARMv8 when the compiler targets them */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA1_USE_SHANI      1
+#define SHA1_SHANI_TARGET   __attribute__((target("sha,ssse3,sse4.1")))
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#define SHA1_USE_SHANI      1
+#define SHA1_SHANI_TARGET
+#else
+#define SHA1_USE_SHANI      0
+#endif
+
+#if !SHA1_USE_SHANI && defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2))
+#include <arm_neon.h>
+#define SHA1_USE_ARMV8      1
+#else
+#define SHA1_USE_ARMV8      0
+#endif
+
 static unsigned int READ_UINT32(const uint8_t* data)
 {
 	return ((uint32_t)data[0] << 24) |
@@ -293,6 +316,192 @@ sha1_block(struct sha1_ctx *ctx, const uint8_t *block)
 	sha1_transform(ctx->digest, data);
 }
 
+#if SHA1_USE_SHANI
+
+/**
+ * @fn  static int sha1_have_shani(void)
+ *
+ * @brief   Whether the CPU has the SHA extensions, SSSE3 and SSE4.1.
+ */
+
+static int
+sha1_have_shani(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+	return 0;
+	__cpuid(info, 1);
+	unsigned const ecx = info[2];
+	__cpuidex(info, 7, 0);
+	unsigned const ebx = info[1];
+#else
+	unsigned eax, ebx, ecx, edx, leaf7;
+	if (__get_cpuid_max(0, NULL) < 7)
+	return 0;
+	__cpuid_count(7, 0, eax, leaf7, ecx, edx);
+	__cpuid(1, eax, ebx, ecx, edx);
+	ebx = leaf7;
+#endif
+	return (ebx & (1U << 29)) && (ecx & (1U << 9)) && (ecx & (1U << 19));
+}
+
+/* One group of four rounds.  The message schedule runs three groups
+   ahead: msg1 starts W[i+3], the XOR adds W[i] to W[i+2], and msg2
+   finishes W[i+1], each in the slot the oldest words have left. */
+#define SHA1_SHANI_GROUP(i, f, ecur, enext) \
+	do { \
+		if (i) ecur = _mm_sha1nexte_epu32(ecur, msg[(i) & 3]); \
+		else ecur = _mm_add_epi32(ecur, msg[0]); \
+		enext = abcd; \
+		if ((i) >= 3 && (i) <= 18) msg[((i) + 1) & 3] = _mm_sha1msg2_epu32(msg[((i) + 1) & 3], msg[(i) & 3]); \
+		abcd = _mm_sha1rnds4_epu32(abcd, ecur, f); \
+		if ((i) >= 1 && (i) <= 16) msg[((i) + 3) & 3] = _mm_sha1msg1_epu32(msg[((i) + 3) & 3], msg[(i) & 3]); \
+		if ((i) >= 2 && (i) <= 17) msg[((i) + 2) & 3] = _mm_xor_si128(msg[((i) + 2) & 3], msg[(i) & 3]); \
+	} while (0)
+
+/**
+ * @fn  static void sha1_blocks_shani(uint32_t *state, const uint8_t *data, unsigned blocks)
+ *
+ * @brief   Sha 1 transform of whole blocks using the SHA extensions.
+ *
+ * @param [in,out]  state   The state.
+ * @param   data            The blocks.
+ * @param   blocks          Number of blocks.
+ */
+
+SHA1_SHANI_TARGET static void
+sha1_blocks_shani(uint32_t *state, const uint8_t *data, unsigned blocks)
+{
+	/* byte swap each word and put W[0] in the top lane */
+	const __m128i order = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+	__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)state), 0x1b);
+	__m128i e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+	__m128i e1;
+	__m128i msg[4];
+
+	for ( ; blocks; blocks--, data += SHA1_DATA_SIZE)
+	{
+		const __m128i abcd_save = abcd;
+		const __m128i e_save = e0;
+		int i;
+
+		for (i = 0; i < 4; i++)
+		msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16 * i)), order);
+
+		SHA1_SHANI_GROUP( 0, 0, e0, e1); SHA1_SHANI_GROUP( 1, 0, e1, e0);
+		SHA1_SHANI_GROUP( 2, 0, e0, e1); SHA1_SHANI_GROUP( 3, 0, e1, e0);
+		SHA1_SHANI_GROUP( 4, 0, e0, e1); SHA1_SHANI_GROUP( 5, 1, e1, e0);
+		SHA1_SHANI_GROUP( 6, 1, e0, e1); SHA1_SHANI_GROUP( 7, 1, e1, e0);
+		SHA1_SHANI_GROUP( 8, 1, e0, e1); SHA1_SHANI_GROUP( 9, 1, e1, e0);
+		SHA1_SHANI_GROUP(10, 2, e0, e1); SHA1_SHANI_GROUP(11, 2, e1, e0);
+		SHA1_SHANI_GROUP(12, 2, e0, e1); SHA1_SHANI_GROUP(13, 2, e1, e0);
+		SHA1_SHANI_GROUP(14, 2, e0, e1); SHA1_SHANI_GROUP(15, 3, e1, e0);
+		SHA1_SHANI_GROUP(16, 3, e0, e1); SHA1_SHANI_GROUP(17, 3, e1, e0);
+		SHA1_SHANI_GROUP(18, 3, e0, e1); SHA1_SHANI_GROUP(19, 3, e1, e0);
+
+		/* e0 now holds A from before the last group, which rotates into E */
+		e0 = _mm_sha1nexte_epu32(e0, e_save);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+	}
+
+	_mm_storeu_si128((__m128i *)state, _mm_shuffle_epi32(abcd, 0x1b));
+	state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+#undef SHA1_SHANI_GROUP
+
+#endif /* SHA1_USE_SHANI */
+
+#if SHA1_USE_ARMV8
+
+/**
+ * @fn  static void sha1_blocks_armv8(uint32_t *state, const uint8_t *data, unsigned blocks)
+ *
+ * @brief   Sha 1 transform of whole blocks using the ARMv8 crypto extensions.
+ *
+ * @param [in,out]  state   The state.
+ * @param   data            The blocks.
+ * @param   blocks          Number of blocks.
+ */
+
+static void
+sha1_blocks_armv8(uint32_t *state, const uint8_t *data, unsigned blocks)
+{
+	static const uint32_t k[4] = { 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6 };
+	uint32x4_t abcd = vld1q_u32(state);
+	uint32_t e = state[4];
+	uint32x4_t msg[4];
+
+	for ( ; blocks; blocks--, data += SHA1_DATA_SIZE)
+	{
+		const uint32x4_t abcd_save = abcd;
+		const uint32_t e_save = e;
+		int i;
+
+		for (i = 0; i < 4; i++)
+		msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+		for (i = 0; i < 20; i++)
+		{
+			const uint32x4_t wk = vaddq_u32(msg[i & 3], vdupq_n_u32(k[i / 5]));
+			const uint32_t enext = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+			if (i < 5)
+			abcd = vsha1cq_u32(abcd, e, wk);
+			else if (i < 10 || i >= 15)
+			abcd = vsha1pq_u32(abcd, e, wk);
+			else
+			abcd = vsha1mq_u32(abcd, e, wk);
+			e = enext;
+
+			/* W[i+4] replaces W[i] once the rounds using it are done */
+			if (i < 16)
+			msg[i & 3] = vsha1su1q_u32(vsha1su0q_u32(msg[i & 3], msg[(i + 1) & 3], msg[(i + 2) & 3]), msg[(i + 3) & 3]);
+		}
+
+		abcd = vaddq_u32(abcd, abcd_save);
+		e += e_save;
+	}
+
+	vst1q_u32(state, abcd);
+	state[4] = e;
+}
+
+#endif /* SHA1_USE_ARMV8 */
+
+/**
+ * @fn  static void sha1_blocks(struct sha1_ctx *ctx, const uint8_t *data, unsigned blocks)
+ *
+ * @brief   Sha 1 whole blocks, with the SHA extensions when available.
+ *
+ * @param [in,out]  ctx If non-null, the context.
+ * @param   data        The blocks.
+ * @param   blocks      Number of blocks.
+ */
+
+static void
+sha1_blocks(struct sha1_ctx *ctx, const uint8_t *data, unsigned blocks)
+{
+#if SHA1_USE_SHANI
+	static const int shani = sha1_have_shani();
+	if (shani)
+	{
+		if ((ctx->count_low += blocks) < blocks)
+		++ctx->count_high;
+		sha1_blocks_shani(ctx->digest, data, blocks);
+		return;
+	}
+#elif SHA1_USE_ARMV8
+	if ((ctx->count_low += blocks) < blocks)
+	++ctx->count_high;
+	sha1_blocks_armv8(ctx->digest, data, blocks);
+	return;
+#endif
+	for ( ; blocks; blocks--, data += SHA1_DATA_SIZE)
+	sha1_block(ctx, data);
+}
+
 /**
  * @fn  void sha1_update(struct sha1_ctx *ctx, unsigned length, const uint8_t *buffer)
  *
@@ -319,16 +528,17 @@ sha1_update(struct sha1_ctx *ctx,
 		else
 	{
 		memcpy(ctx->block + ctx->index, buffer, left);
-		sha1_block(ctx, ctx->block);
+		sha1_blocks(ctx, ctx->block, 1);
 		buffer += left;
 		length -= left;
 	}
 	}
-	while (length >= SHA1_DATA_SIZE)
+	if (length >= SHA1_DATA_SIZE)
 	{
-		sha1_block(ctx, buffer);
-		buffer += SHA1_DATA_SIZE;
-		length -= SHA1_DATA_SIZE;
+		unsigned blocks = length / SHA1_DATA_SIZE;
+		sha1_blocks(ctx, buffer, blocks);
+		buffer += blocks * SHA1_DATA_SIZE;
+		length -= blocks * SHA1_DATA_SIZE;
 	}
 	ctx->index = length;
 	if (length)
@@ -22,15 +22,17 @@
 #include "lzma/C/7zTypes.h"
 
 #include <algorithm>
-#include <array>
 #include <cassert>
+#include <cctype>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <list>
 #include <mutex>
 #include <ratio>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -99,8 +101,8 @@ public:
 
 	virtual ~m7z_file_impl()
 	{
-		if (m_out_buffer)
-			IAlloc_Free(&m_alloc_imp, m_out_buffer);
+		for (solid_block const &block : m_blocks)
+			IAlloc_Free(&m_alloc_imp, block.buffer);
 		if (m_inited)
 			SzArEx_Free(&m_db, &m_alloc_imp);
 	}
@@ -108,13 +110,13 @@ public:
 	static ptr find_cached(const std::string &filename)
 	{
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); cachenum++)
+		for (auto it = s_cache.begin(); s_cache.end() != it; ++it)
 		{
-			// if we have a valid entry and it matches our filename, use it and remove from the cache
-			if (s_cache[cachenum] && (filename == s_cache[cachenum]->m_filename))
+			// if it matches our filename, use it and remove from the cache
+			if (filename == (*it)->m_filename)
 			{
-				ptr result;
-				std::swap(s_cache[cachenum], result);
+				ptr result(std::move(*it));
+				s_cache.erase(it);
 				osd_printf_verbose("un7z: found %s in cache\n", filename.c_str());
 				return result;
 			}
@@ -126,7 +128,13 @@ public:
 	{
 		// clear call cache entries
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); s_cache[cachenum++].reset()) { }
+		s_cache.clear();
+	}
+	static void set_cache_size(std::size_t count)
+	{
+		std::lock_guard<std::mutex> guard(s_cache_mutex);
+		s_cache_size = count;
+		trim_cache();
 	}
 
 	archive_file::error initialize();
@@ -168,11 +176,42 @@ private:
 			bool matchcrc,
 			bool matchname,
 			bool partialpath);
+	bool matches(
+			int i,
+			std::uint32_t search_crc,
+			const std::string &search_filename,
+			bool matchcrc,
+			bool matchname,
+			bool partialpath) const;
+	void select(int i);
 	void make_utf8_name(int index);
 	void set_curr_modified();
+	void trim_blocks(std::size_t limit);
+	static void trim_cache();
+
+	// search indexes are keyed on the part of the name after the last slash, folded to lowercase
+	static std::string name_key(const std::string &name)
+	{
+		std::string result(name.substr(name.find_last_of('/') + 1));
+		for (char &ch : result)
+			ch = char(std::tolower(std::uint8_t(ch)));
+		return result;
+	}
+
+	// a decompressed solid block, kept so files can be extracted from it without decoding it again
+	struct solid_block
+	{
+		UInt32                              index;
+		Byte *                              buffer;
+		std::size_t                         size;
+	};
 
-	static constexpr std::size_t            CACHE_SIZE = 8;
-	static std::array<ptr, CACHE_SIZE>      s_cache;
+	typedef std::unordered_map<std::uint32_t, std::vector<int> > crc_index;
+	typedef std::unordered_map<std::string, std::vector<int> > name_index;
+
+	static constexpr std::size_t            BLOCK_CACHE_BYTES = 64 * 1024 * 1024; // decompressed solid blocks kept per open archive
+	static std::list<ptr>                   s_cache;        // most recently closed first
+	static std::size_t                      s_cache_size;   // number of closed files to keep
 	static std::mutex                       s_cache_mutex;
 
 	const std::string                       m_filename;             // copy of _7Z filename (for caching)
@@ -188,6 +227,10 @@ private:
 	std::vector<char32_t>               m_uchar_buf;
 	std::vector<char>                       m_utf8_buf;
 
+	std::vector<std::string>                m_names;                // UTF-8 names of all files
+	crc_index                               m_crc_index;            // files by CRC, in archive order
+	name_index                              m_name_index;           // files by name key, in archive order
+
 	CFileInStream                           m_archive_stream;
 	CLookToRead                             m_look_stream;
 	CSzArEx                                 m_db;
@@ -196,9 +239,7 @@ private:
 	bool                                    m_inited;
 
 	// cached stuff for solid blocks
-	UInt32                                  m_block_index;
-	Byte *                                  m_out_buffer;
-	std::size_t                             m_out_buffer_size;
+	std::vector<solid_block>                m_blocks;               // most recently used first
 
 };
 
@@ -243,7 +284,8 @@ private:
     GLOBAL VARIABLES
 ***************************************************************************/
 
-std::array<m7z_file_impl::ptr, m7z_file_impl::CACHE_SIZE> m7z_file_impl::s_cache;
+std::list<m7z_file_impl::ptr> m7z_file_impl::s_cache;
+std::size_t m7z_file_impl::s_cache_size = 8;
 std::mutex m7z_file_impl::s_cache_mutex;
 
 
@@ -292,9 +334,7 @@ m7z_file_impl::m7z_file_impl(const std::string &filename)
 	, m_uchar_buf(128)
 	, m_utf8_buf(512)
 	, m_inited(false)
-	, m_block_index(0)
-	, m_out_buffer(nullptr)
-	, m_out_buffer_size(0)
+	, m_blocks()
 {
 	m_alloc_imp.Alloc = &SzAlloc;
 	m_alloc_imp.Free = &SzFree;
@@ -333,6 +373,28 @@ archive_file::error m7z_file_impl::initialize()
 		}
 	}
 
+	// convert the names and index them once, rather than on every search
+	try
+	{
+		m_names.reserve(m_db.NumFiles);
+		for (int i = 0; i < m_db.NumFiles; i++)
+		{
+			make_utf8_name(i);
+			m_names.emplace_back(&m_utf8_buf[0]);
+			if (!SzArEx_IsDir(&m_db, i))
+			{
+				if (SzBitArray_Check(m_db.CRCs.Defs, i))
+					m_crc_index[m_db.CRCs.Vals[i]].push_back(i);
+				m_name_index[name_key(m_names.back())].push_back(i);
+			}
+		}
+	}
+	catch (...)
+	{
+		osd_printf_error("un7z: %s failed to allocate memory for file index\n", m_filename.c_str());
+		return archive_file::error::OUT_OF_MEMORY;
+	}
+
 	return archive_file::error::NONE;
 }
 
@@ -350,25 +412,49 @@ void m7z_file_impl::close(ptr &&archive)
 	osd_printf_verbose("un7z: closing archive file %s and sending to cache\n", archive->m_filename.c_str());
 	archive->m_archive_stream.osdfile.reset();
 
-	// find the first nullptr entry in the cache
+	// keep only the most recent solid block while we sit in the cache
+	archive->trim_blocks(0);
+
+	// place us at the top and free whatever falls off the bottom
 	std::lock_guard<std::mutex> guard(s_cache_mutex);
-	std::size_t cachenum;
-	for (cachenum = 0; cachenum < s_cache.size(); cachenum++)
-		if (!s_cache[cachenum])
-			break;
+	s_cache.emplace_front(std::move(archive));
+	trim_cache();
+}
 
-	// if no room left in the cache, free the bottommost entry
-	if (cachenum == s_cache.size())
+
+/*-------------------------------------------------
+    trim_cache - free the least recently used
+    entries beyond the cache size (caller must
+    hold the cache lock)
+-------------------------------------------------*/
+
+void m7z_file_impl::trim_cache()
+{
+	while (s_cache.size() > s_cache_size)
 	{
-		cachenum--;
-		osd_printf_verbose("un7z: removing %s from cache to make space\n", s_cache[cachenum]->m_filename.c_str());
-		s_cache[cachenum].reset();
+		osd_printf_verbose("un7z: removing %s from cache to make space\n", s_cache.back()->m_filename.c_str());
+		s_cache.pop_back();
 	}
+}
+
 
-	// move everyone else down and place us at the top
-	for ( ; cachenum > 0; cachenum--)
-		s_cache[cachenum] = std::move(s_cache[cachenum - 1]);
-	s_cache[0] = std::move(archive);
+/*-------------------------------------------------
+    trim_blocks - free the least recently used
+    solid blocks until the rest fit in the limit,
+    always keeping the most recent one
+-------------------------------------------------*/
+
+void m7z_file_impl::trim_blocks(std::size_t limit)
+{
+	std::size_t total(0);
+	for (solid_block const &block : m_blocks)
+		total += block.size;
+	while ((m_blocks.size() > 1) && (total > limit))
+	{
+		total -= m_blocks.back().size;
+		IAlloc_Free(&m_alloc_imp, m_blocks.back().buffer);
+		m_blocks.pop_back();
+	}
 }
 
 
@@ -404,13 +490,35 @@ archive_file::error m7z_file_impl::decompress(void *buffer, std::uint32_t length
 		osd_printf_verbose("un7z: reopened archive file %s\n", m_filename.c_str());
 	}
 
+	// take the file's solid block out of the cache if we have it, so it isn't decoded again
+	UInt32 const folder(m_db.FileToFolder[m_curr_file_idx]);
+	auto const cached(std::find_if(m_blocks.begin(), m_blocks.end(), [folder] (solid_block const &block) { return block.index == folder; }));
+	solid_block block{ folder, nullptr, 0 };
+	if (m_blocks.end() != cached)
+	{
+		block = *cached;
+		m_blocks.erase(cached);
+	}
+
 	std::size_t offset(0);
 	std::size_t out_size_processed(0);
 	SRes const res = SzArEx_Extract(
 			&m_db, &m_look_stream.s, m_curr_file_idx,           // requested file
-			&m_block_index, &m_out_buffer, &m_out_buffer_size,  // solid block caching
+			&block.index, &block.buffer, &block.size,           // solid block caching
 			&offset, &out_size_processed,                       // data size/offset
 			&m_alloc_imp, &m_alloc_temp_imp);                   // allocator helpers
+
+	// put it back at the head of the cache, dropping old blocks if it's getting too big
+	if ((res == SZ_OK) && block.buffer)
+	{
+		m_blocks.insert(m_blocks.begin(), block);
+		trim_blocks(BLOCK_CACHE_BYTES);
+	}
+	else if (block.buffer)
+	{
+		IAlloc_Free(&m_alloc_imp, block.buffer);
+	}
+
 	if (res != SZ_OK)
 	{
 		osd_printf_error("un7z: error decompressing %s from %s (%d)\n", m_curr_name.c_str(), m_filename.c_str(), int(res));
@@ -424,7 +532,8 @@ archive_file::error m7z_file_impl::decompress(void *buffer, std::uint32_t length
 	}
 
 	// copy to destination buffer
-	std::memcpy(buffer, m_out_buffer + offset, (std::min<std::size_t>)(length, out_size_processed));
+	if (out_size_processed)
+		std::memcpy(buffer, block.buffer + offset, (std::min<std::size_t>)(length, out_size_processed));
 	return archive_file::error::NONE;
 }
 
@@ -437,30 +546,38 @@ int m7z_file_impl::search(
 		bool matchname,
 		bool partialpath)
 {
-	for ( ; i < m_db.NumFiles; i++)
-	{
-		make_utf8_name(i);
-		bool const is_dir(SzArEx_IsDir(&m_db, i));
-		const std::uint64_t size(SzArEx_GetFileSize(&m_db, i));
-		const std::uint32_t crc(m_db.CRCs.Vals[i]);
-		const bool crcmatch(SzBitArray_Check(m_db.CRCs.Defs, i) && (crc == search_crc));
-		auto const partialoffset(m_utf8_buf.size() - 1 - search_filename.length());
-		bool const partialpossible((m_utf8_buf.size() > (search_filename.length() + 1)) && (m_utf8_buf[partialoffset - 1] == '/'));
-		const bool namematch(
-				!core_stricmp(search_filename.c_str(), &m_utf8_buf[0]) ||
-				(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), &m_utf8_buf[partialoffset])));
-
-		const bool found = ((!matchcrc && !matchname) || !is_dir) && (!matchcrc || crcmatch) && (!matchname || namematch);
-		if (found)
+	// plain iteration visits everything, directories included
+	std::vector<int> const *candidates(nullptr);
+	if (matchname)
+	{
+		auto const found(m_name_index.find(name_key(search_filename)));
+		if (m_name_index.end() == found)
+			return -1;
+		candidates = &found->second;
+	}
+	else if (matchcrc)
+	{
+		auto const found(m_crc_index.find(search_crc));
+		if (m_crc_index.end() == found)
+			return -1;
+		candidates = &found->second;
+	}
+	else if (i < m_db.NumFiles)
+	{
+		select(i);
+		return i;
+	}
+	else
+	{
+		return -1;
+	}
+
+	for (auto it = std::lower_bound(candidates->begin(), candidates->end(), i); candidates->end() != it; ++it)
+	{
+		if (matches(*it, search_crc, search_filename, matchcrc, matchname, partialpath))
 		{
-			m_curr_file_idx = i;
-			m_curr_is_dir = is_dir;
-			m_curr_name = &m_utf8_buf[0];
-			m_curr_length = size;
-			set_curr_modified();
-			m_curr_crc = crc;
-
-			return i;
+			select(*it);
+			return *it;
 		}
 	}
 
@@ -468,6 +585,37 @@ int m7z_file_impl::search(
 }
 
 
+bool m7z_file_impl::matches(
+		int i,
+		std::uint32_t search_crc,
+		const std::string &search_filename,
+		bool matchcrc,
+		bool matchname,
+		bool partialpath) const
+{
+	std::string const &name(m_names[i]);
+	const bool crcmatch(SzBitArray_Check(m_db.CRCs.Defs, i) && (m_db.CRCs.Vals[i] == search_crc));
+	auto const partialoffset(name.length() - search_filename.length());
+	bool const partialpossible((name.length() > search_filename.length()) && (name[partialoffset - 1] == '/'));
+	const bool namematch(
+			!core_stricmp(search_filename.c_str(), name.c_str()) ||
+			(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), name.c_str() + partialoffset)));
+
+	return (!matchcrc || crcmatch) && (!matchname || namematch);
+}
+
+
+void m7z_file_impl::select(int i)
+{
+	m_curr_file_idx = i;
+	m_curr_is_dir = SzArEx_IsDir(&m_db, i);
+	m_curr_name = m_names[i];
+	m_curr_length = SzArEx_GetFileSize(&m_db, i);
+	set_curr_modified();
+	m_curr_crc = m_db.CRCs.Vals[i];
+}
+
+
 void m7z_file_impl::make_utf8_name(int index)
 {
 	std::size_t len, out_pos;
@@ -570,4 +718,11 @@ void m7z_file_cache_clear()
 	m7z_file_impl::cache_clear();
 }
 
+
+void m7z_file_cache_size(std::size_t count)
+{
+	// trampoline called from unzip.cpp, as above
+	m7z_file_impl::set_cache_size(count);
+}
+
 } // namespace util
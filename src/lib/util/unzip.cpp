@@ -22,12 +22,15 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cctype>
 #include <chrono>
 #include <cstring>
 #include <cstdlib>
 #include <ctime>
+#include <list>
 #include <mutex>
 #include <ratio>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -48,7 +51,9 @@ public:
 		, m_file()
 		, m_length(0)
 		, m_ecd()
-		, m_cd()
+		, m_entries()
+		, m_crc_index()
+		, m_name_index()
 		, m_cd_pos(0)
 		, m_header()
 		, m_curr_is_dir(false)
@@ -60,13 +65,13 @@ public:
 	static ptr find_cached(const std::string &filename)
 	{
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); cachenum++)
+		for (auto it = s_cache.begin(); s_cache.end() != it; ++it)
 		{
-			// if we have a valid entry and it matches our filename, use it and remove from the cache
-			if (s_cache[cachenum] && (filename == s_cache[cachenum]->m_filename))
+			// if it matches our filename, use it and remove from the cache
+			if (filename == (*it)->m_filename)
 			{
-				ptr result;
-				std::swap(s_cache[cachenum], result);
+				ptr result(std::move(*it));
+				s_cache.erase(it);
 				osd_printf_verbose("unzip: found %s in cache\n", filename.c_str());
 				return result;
 			}
@@ -78,7 +83,13 @@ public:
 	{
 		// clear call cache entries
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); s_cache[cachenum++].reset()) { }
+		s_cache.clear();
+	}
+	static void set_cache_size(std::size_t count)
+	{
+		std::lock_guard<std::mutex> guard(s_cache_mutex);
+		s_cache_size = count;
+		trim_cache();
 	}
 
 	archive_file::error initialize()
@@ -106,7 +117,8 @@ public:
 		}
 
 		// allocate memory for the central directory
-		try { m_cd.resize(std::size_t(m_ecd.cd_size)); }
+		std::vector<std::uint8_t> cd;
+		try { cd.resize(std::size_t(m_ecd.cd_size)); }
 		catch (...)
 		{
 			osd_printf_error("unzip: %s failed to allocate memory for central directory\n", m_filename.c_str());
@@ -120,7 +132,7 @@ public:
 		{
 			std::uint32_t const chunk(std::uint32_t((std::min<std::uint64_t>)(std::numeric_limits<std::uint32_t>::max(), cd_remaining)));
 			std::uint32_t read_length(0);
-			auto const filerr = m_file->read(&m_cd[cd_offs], m_ecd.cd_start_disk_offset + cd_offs, chunk, read_length);
+			auto const filerr = m_file->read(&cd[cd_offs], m_ecd.cd_start_disk_offset + cd_offs, chunk, read_length);
 			if (filerr != osd_file::error::NONE)
 			{
 				osd_printf_error("unzip: %s error reading central directory (%d)\n", m_filename.c_str(), int(filerr));
@@ -136,6 +148,14 @@ public:
 		}
 		osd_printf_verbose("unzip: read %s central directory\n", m_filename.c_str());
 
+		// decode it once, so reopening from the cache and searching don't have to
+		try { parse_cd(cd); }
+		catch (...)
+		{
+			osd_printf_error("unzip: %s failed to allocate memory for central directory\n", m_filename.c_str());
+			return archive_file::error::OUT_OF_MEMORY;
+		}
+
 		return archive_file::error::NONE;
 	}
 
@@ -188,6 +208,17 @@ private:
 	zip_file_impl &operator=(zip_file_impl &&) = delete;
 
 	int search(std::uint32_t search_crc, const std::string &search_filename, bool matchcrc, bool matchname, bool partialpath);
+	void parse_cd(std::vector<std::uint8_t> const &cd);
+	static void trim_cache();
+
+	// search indexes are keyed on the part of the name after the last slash, folded to lowercase
+	static std::string name_key(const std::string &name)
+	{
+		std::string result(name.substr(name.find_last_of('/') + 1));
+		for (char &ch : result)
+			ch = char(std::tolower(std::uint8_t(ch)));
+		return result;
+	}
 
 	archive_file::error reopen()
 	{
@@ -253,6 +284,13 @@ private:
 		mutable bool                                    modified_cached;
 	};
 
+	// central directory entry, decoded when the archive is opened
+	struct cd_entry
+	{
+		file_header                                     header;
+		bool                                            is_dir;
+	};
+
 	// contains extracted end of central directory information
 	struct ecd
 	{
@@ -264,9 +302,12 @@ private:
 		std::uint64_t   cd_start_disk_offset;   // offset of start of central directory with respect to the starting disk number
 	};
 
+	typedef std::unordered_map<std::uint32_t, std::vector<std::size_t> > crc_index;
+	typedef std::unordered_map<std::string, std::vector<std::size_t> > name_index;
+
 	static constexpr std::size_t        DECOMPRESS_BUFSIZE = 16384;
-	static constexpr std::size_t        CACHE_SIZE = 8; // number of open files to cache
-	static std::array<ptr, CACHE_SIZE>  s_cache;
+	static std::list<ptr>               s_cache;        // most recently closed first
+	static std::size_t                  s_cache_size;   // number of closed files to keep
 	static std::mutex                   s_cache_mutex;
 
 	const std::string           m_filename;                 // copy of ZIP filename (for caching)
@@ -275,8 +316,10 @@ private:
 
 	ecd                         m_ecd;                      // end of central directory
 
-	std::vector<std::uint8_t>   m_cd;                       // central directory raw data
-	std::uint32_t               m_cd_pos;                   // position in central directory
+	std::vector<cd_entry>       m_entries;                  // central directory
+	crc_index                   m_crc_index;                // entries by CRC, in directory order
+	name_index                  m_name_index;               // entries by name key, in directory order
+	std::size_t                 m_cd_pos;                   // next entry to search from
 	file_header                 m_header;                   // current file header
 	bool                        m_curr_is_dir;              // current file is directory
 
@@ -652,7 +695,8 @@ private:
     GLOBAL VARIABLES
 ***************************************************************************/
 
-std::array<zip_file_impl::ptr, zip_file_impl::CACHE_SIZE> zip_file_impl::s_cache;
+std::list<zip_file_impl::ptr> zip_file_impl::s_cache;
+std::size_t zip_file_impl::s_cache_size = 8;
 std::mutex zip_file_impl::s_cache_mutex;
 
 
@@ -670,69 +714,69 @@ void zip_file_impl::close(ptr &&zip)
 	osd_printf_verbose("unzip: closing archive file %s and sending to cache\n", zip->m_filename.c_str());
 	zip->m_file.reset();
 
-	// find the first nullptr entry in the cache
+	// place us at the top and free whatever falls off the bottom
 	std::lock_guard<std::mutex> guard(s_cache_mutex);
-	std::size_t cachenum;
-	for (cachenum = 0; cachenum < s_cache.size(); cachenum++)
-		if (!s_cache[cachenum])
-			break;
+	s_cache.emplace_front(std::move(zip));
+	trim_cache();
+}
 
-	// if no room left in the cache, free the bottommost entry
-	if (cachenum == s_cache.size())
+
+/*-------------------------------------------------
+    trim_cache - free the least recently used
+    entries beyond the cache size (caller must
+    hold the cache lock)
+-------------------------------------------------*/
+
+void zip_file_impl::trim_cache()
+{
+	while (s_cache.size() > s_cache_size)
 	{
-		cachenum--;
-		osd_printf_verbose("unzip: removing %s from cache to make space\n", s_cache[cachenum]->m_filename.c_str());
-		s_cache[cachenum].reset();
+		osd_printf_verbose("unzip: removing %s from cache to make space\n", s_cache.back()->m_filename.c_str());
+		s_cache.pop_back();
 	}
-
-	// move everyone else down and place us at the top
-	for ( ; cachenum > 0; cachenum--)
-		s_cache[cachenum] = std::move(s_cache[cachenum - 1]);
-	s_cache[0] = std::move(zip);
 }
 
 
-/***************************************************************************
-    CONTAINED FILE ACCESS
-***************************************************************************/
-
 /*-------------------------------------------------
-    zip_file_search - return the next matching
-    entry in the ZIP
+    parse_cd - decode the central directory and
+    index the entries by CRC and name
 -------------------------------------------------*/
 
-int zip_file_impl::search(std::uint32_t search_crc, const std::string &search_filename, bool matchcrc, bool matchname, bool partialpath)
+void zip_file_impl::parse_cd(std::vector<std::uint8_t> const &cd)
 {
-	// if we're at or past the end, we're done
-	while ((m_cd_pos + central_dir_entry_reader::minimum_length()) <= m_ecd.cd_size)
+	std::size_t cd_pos(0);
+
+	// stop at the end or the first damaged entry, as searching always has
+	while ((cd_pos + central_dir_entry_reader::minimum_length()) <= m_ecd.cd_size)
 	{
 		// make sure we have enough data
-		central_dir_entry_reader const reader(&m_cd[0] + m_cd_pos);
-		if (!reader.signature_correct() || ((m_cd_pos + reader.total_length()) > m_ecd.cd_size))
+		central_dir_entry_reader const reader(&cd[0] + cd_pos);
+		if (!reader.signature_correct() || ((cd_pos + reader.total_length()) > m_ecd.cd_size))
 			break;
 
 		// extract file header info
-		m_header.version_created     = reader.version_created();
-		m_header.version_needed      = reader.version_needed();
-		m_header.bit_flag            = reader.general_flag();
-		m_header.compression         = reader.compression_method();
-		m_header.crc                 = reader.crc32();
-		m_header.compressed_length   = reader.compressed_size();
-		m_header.uncompressed_length = reader.uncompressed_size();
-		m_header.start_disk_number   = reader.start_disk();
-		m_header.local_header_offset = reader.header_offset();
+		file_header header;
+		header.version_created     = reader.version_created();
+		header.version_needed      = reader.version_needed();
+		header.bit_flag            = reader.general_flag();
+		header.compression         = reader.compression_method();
+		header.crc                 = reader.crc32();
+		header.compressed_length   = reader.compressed_size();
+		header.uncompressed_length = reader.uncompressed_size();
+		header.start_disk_number   = reader.start_disk();
+		header.local_header_offset = reader.header_offset();
 
 		// don't immediately decode DOS timestamp - it's expensive
-		m_header.modified_date       = reader.modified_date();
-		m_header.modified_time       = reader.modified_time();
-		m_header.modified_cached     = false;
+		header.modified_date       = reader.modified_date();
+		header.modified_time       = reader.modified_time();
+		header.modified_cached     = false;
 
 		// advance the position
-		m_cd_pos += reader.total_length();
+		cd_pos += reader.total_length();
 
 		// copy the filename
-		bool is_utf8(general_flag_reader(m_header.bit_flag).utf8_encoding());
-		reader.file_name(m_header.file_name);
+		bool is_utf8(general_flag_reader(header.bit_flag).utf8_encoding());
+		reader.file_name(header.file_name);
 
 		// walk the extra data
 		for (auto extra = reader.extra_field(); extra.length_sufficient(); extra = extra.next())
@@ -743,10 +787,10 @@ int zip_file_impl::search(std::uint32_t search_crc, const std::string &search_fi
 				zip64_ext_info_reader const ext64(reader, extra);
 				if (extra.data_size() >= ext64.total_length())
 				{
-					m_header.compressed_length   = ext64.compressed_size();
-					m_header.uncompressed_length = ext64.uncompressed_size();
-					m_header.start_disk_number   = ext64.start_disk();
-					m_header.local_header_offset = ext64.header_offset();
+					header.compressed_length   = ext64.compressed_size();
+					header.uncompressed_length = ext64.uncompressed_size();
+					header.start_disk_number   = ext64.start_disk();
+					header.local_header_offset = ext64.header_offset();
 				}
 			}
 
@@ -756,12 +800,12 @@ int zip_file_impl::search(std::uint32_t search_crc, const std::string &search_fi
 				utf8_path_reader const utf8path(extra);
 				if (utf8path.version() == 1)
 				{
-					auto const addr(m_header.file_name.empty() ? nullptr : &m_header.file_name[0]);
-					auto const length(m_header.file_name.empty() ? 0 : m_header.file_name.length() * sizeof(m_header.file_name[0]));
+					auto const addr(header.file_name.empty() ? nullptr : &header.file_name[0]);
+					auto const length(header.file_name.empty() ? 0 : header.file_name.length() * sizeof(header.file_name[0]));
 					auto const crc(crc32_creator::simple(addr, length));
 					if (utf8path.name_crc32() == crc.m_raw)
 					{
-						utf8path.unicode_name(m_header.file_name);
+						utf8path.unicode_name(header.file_name);
 						is_utf8 = true;
 					}
 				}
@@ -777,8 +821,8 @@ int zip_file_impl::search(std::uint32_t search_crc, const std::string &search_fi
 					{
 						ntfs_times_reader const times(tag);
 						ntfs_duration const ticks(times.mtime());
-						m_header.modified = system_clock_time_point_from_ntfs_duration(ticks);
-						m_header.modified_cached = true;
+						header.modified = system_clock_time_point_from_ntfs_duration(ticks);
+						header.modified_cached = true;
 					}
 				}
 			}
@@ -787,21 +831,79 @@ int zip_file_impl::search(std::uint32_t search_crc, const std::string &search_fi
 		// FIXME: if (!is_utf8) convert filename to UTF8 (assume CP437 or something)
 
 		// chop off trailing slash for directory entries
-		bool const is_dir(!m_header.file_name.empty() && (m_header.file_name.back() == '/'));
-		if (is_dir) m_header.file_name.resize(m_header.file_name.length() - 1);
+		bool const is_dir(!header.file_name.empty() && (header.file_name.back() == '/'));
+		if (is_dir) header.file_name.resize(header.file_name.length() - 1);
+
+		// add to the indexes - directories are only found by iterating
+		std::size_t const index(m_entries.size());
+		if (!is_dir)
+		{
+			m_crc_index[header.crc].push_back(index);
+			m_name_index[name_key(header.file_name)].push_back(index);
+		}
+		m_entries.emplace_back(cd_entry{ std::move(header), is_dir });
+	}
+}
+
+
+
+/***************************************************************************
+    CONTAINED FILE ACCESS
+***************************************************************************/
+
+/*-------------------------------------------------
+    zip_file_search - return the next matching
+    entry in the ZIP
+-------------------------------------------------*/
+
+int zip_file_impl::search(std::uint32_t search_crc, const std::string &search_filename, bool matchcrc, bool matchname, bool partialpath)
+{
+	// plain iteration visits everything, directories included
+	std::vector<std::size_t> const *candidates(nullptr);
+	if (matchname)
+	{
+		auto const found(m_name_index.find(name_key(search_filename)));
+		if (m_name_index.end() == found)
+			return -1;
+		candidates = &found->second;
+	}
+	else if (matchcrc)
+	{
+		auto const found(m_crc_index.find(search_crc));
+		if (m_crc_index.end() == found)
+			return -1;
+		candidates = &found->second;
+	}
+	else if (m_cd_pos < m_entries.size())
+	{
+		m_header = m_entries[m_cd_pos].header;
+		m_curr_is_dir = m_entries[m_cd_pos].is_dir;
+		m_cd_pos++;
+		return 0;
+	}
+	else
+	{
+		return -1;
+	}
+
+	for (auto it = std::lower_bound(candidates->begin(), candidates->end(), m_cd_pos); candidates->end() != it; ++it)
+	{
+		cd_entry const &entry(m_entries[*it]);
+		file_header const &header(entry.header);
 
 		// check to see if it matches query
-		bool const crcmatch(search_crc == m_header.crc);
-		auto const partialoffset(m_header.file_name.length() - search_filename.length());
-		bool const partialpossible((m_header.file_name.length() > search_filename.length()) && (m_header.file_name[partialoffset - 1] == '/'));
+		bool const crcmatch(search_crc == header.crc);
+		auto const partialoffset(header.file_name.length() - search_filename.length());
+		bool const partialpossible((header.file_name.length() > search_filename.length()) && (header.file_name[partialoffset - 1] == '/'));
 		const bool namematch(
-				!core_stricmp(search_filename.c_str(), m_header.file_name.c_str()) ||
-				(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), m_header.file_name.c_str() + partialoffset)));
+				!core_stricmp(search_filename.c_str(), header.file_name.c_str()) ||
+				(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), header.file_name.c_str() + partialoffset)));
 
-		bool const found = ((!matchcrc && !matchname) || !is_dir) && (!matchcrc || crcmatch) && (!matchname || namematch);
-		if (found)
+		if ((!matchcrc || crcmatch) && (!matchname || namematch))
 		{
-			m_curr_is_dir = is_dir;
+			m_header = header;
+			m_curr_is_dir = entry.is_dir;
+			m_cd_pos = *it + 1;
 			return 0;
 		}
 	}
@@ -1427,6 +1529,7 @@ archive_file::error zip_file_impl::decompress_data_type_14(std::uint64_t offset,
 ***************************************************************************/
 
 void m7z_file_cache_clear();
+void m7z_file_cache_size(std::size_t count);
 
 
 
@@ -1480,6 +1583,18 @@ void archive_file::cache_clear()
 }
 
 
+/*-------------------------------------------------
+    set_cache_size - set how many closed archives
+    of each type are kept for reopening
+-------------------------------------------------*/
+
+void archive_file::set_cache_size(std::size_t count)
+{
+	zip_file_impl::set_cache_size(count);
+	m7z_file_cache_size(count);
+}
+
+
 archive_file::~archive_file()
 {
 }
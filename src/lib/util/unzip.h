@@ -62,6 +62,9 @@ public:
 	// clear out all open files from the cache
 	static void cache_clear();
 
+	// set how many recently closed archives of each type are kept open
+	static void set_cache_size(std::size_t count);
+
 
 	/* ----- contained file access ----- */
 
@@ -719,7 +719,7 @@ void data_node::set_attribute_float(const char *name, float value)
 
 const char *normalize_string(const char *string)
 {
-	static char buffer[1024];
+	static thread_local char buffer[1024];
 	char *d = &buffer[0];
 
 	if (string != nullptr)
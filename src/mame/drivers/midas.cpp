@@ -128,12 +128,10 @@ uint32_t midas_state::screen_update_midas(screen_device &screen, bitmap_rgb32 &b
 	// fill with background color first
 	bitmap.fill(0x0, cliprect);
 
+	m_sprgen->draw_sprite_lines(bitmap, cliprect);
+
 	for (int line = cliprect.min_y; line <= cliprect.max_y ; line++)
-	{
-		m_sprgen->parse_sprites(line);
-		m_sprgen->draw_sprites(bitmap, line);
 		m_sprgen->draw_fixed_layer(bitmap, line);
-	}
 
 	return 0;
 }
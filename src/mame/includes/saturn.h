@@ -119,6 +119,7 @@ protected:
 		uint8_t     exsyfg;
 		int       old_crmd;
 		int       old_tvmd;
+		uint32_t    render_serial;  // bumped by anything that changes the composite
 	}m_vdp2;
 
 	required_device<sh2_device> m_maincpu;
@@ -334,6 +335,19 @@ protected:
 	void stv_vdp2_exit ( void );
 	int stv_vdp2_start ( void );
 
+	/* composite lines kept in m_tmpbitmap, reused while nothing they depend on is written */
+	struct stv_vdp2_line_cache
+	{
+		uint32_t serial;        // render_serial the line was drawn at, 0 if stale
+		int32_t  top;           // cliprect it was drawn with
+		int32_t  left;
+		int32_t  right;
+	};
+	std::vector<stv_vdp2_line_cache> m_vdp2_line_cache;
+	void stv_vdp2_render_dirty( void );
+	bool stv_vdp2_lines_cached( const rectangle &cliprect );
+	void stv_vdp2_cache_lines( const rectangle &cliprect );
+
 	uint8_t m_vdpdebug_roz;
 
 	struct stv_vdp2_tilemap_capabilities
@@ -158,6 +158,7 @@ public:
 	void jump(int address);
 	void process(int address, vertex_nv *in, vertex_nv *out, int count);
 	int status();
+	bool writes_constants(int address);
 private:
 	void initialize_outputs();
 	void initialize_temps();
@@ -195,7 +196,7 @@ offset in ramht+4 contains in the lower 16 bits the offset in RAMIN divided by 1
 objects have methods used to do drawing
 most methods set parameters, others actually draw
 */
-class nv2a_renderer : public poly_manager<double, nvidia_object_data, 13, 8192>
+class nv2a_renderer : public poly_manager<float, nvidia_object_data, 13, 8192>
 {
 public:
 	enum class VERTEX_PARAMETER {
@@ -375,10 +376,10 @@ public:
 
 	struct nv2avertex_t : public vertex_t
 	{
-		double w;
+		float w;
 	};
 
-	nv2a_renderer(running_machine &machine) : poly_manager<double, nvidia_object_data, 13, 8192>(machine)
+	nv2a_renderer(running_machine &machine) : poly_manager<float, nvidia_object_data, 13, 8192>(machine)
 	{
 		memset(channel, 0, sizeof(channel));
 		memset(pfifo, 0, sizeof(pfifo));
@@ -443,6 +444,10 @@ public:
 		depthbuffer = nullptr;
 		displayedtarget = nullptr;
 		puller_waiting = 0;
+		vertexprogram.serial = 0;
+		vertexprogram.checked_serial = ~0U;
+		vertexprogram.writes_constants = true;
+		vertex_queue = nullptr;
 		debug_grab_texttype = -1;
 		debug_grab_textfile = nullptr;
 		enable_waitvblank = true;
@@ -453,6 +458,11 @@ public:
 		for (int n = 0; n < 16; n++)
 			persistvertexattr.attribute[n].fv[3] = 1;
 	}
+	~nv2a_renderer()
+	{
+		if (vertex_queue != nullptr)
+			osd_work_queue_free(vertex_queue);
+	}
 	DECLARE_READ32_MEMBER(geforce_r);
 	DECLARE_WRITE32_MEMBER(geforce_w);
 	DECLARE_WRITE_LINE_MEMBER(vblank_callback);
@@ -512,6 +522,9 @@ public:
 	int read_vertices_0x180x(address_space & space, vertex_nv *destination, uint32_t address, int limit);
 	int read_vertices_0x1810(address_space & space, vertex_nv *destination, int offset, int limit);
 	int read_vertices_0x1818(address_space & space, vertex_nv *destination, uint32_t address, int limit);
+	bool vertex_program_writes_constants();
+	static void *vertex_batch_callback(void *param, int threadid);
+	void run_vertex_program(vertex_nv *source, vertex_nv *destination, int count);
 	void convert_vertices_poly(vertex_nv *source, nv2avertex_t *destination, int count);
 	void assemble_primitive(vertex_nv *source, int count, render_delegate &renderspans);
 	int clip_triangle_w(nv2avertex_t *vi[3], nv2avertex_t *vo);
@@ -602,6 +615,8 @@ public:
 	int vertex_accumulated;
 	vertex_nv vertex_software[1024+2]; // vertex attributes sent by the software to the 3d accelerator
 	nv2avertex_t vertex_xy[1024+2]; // vertex attributes computed by the 3d accelerator
+	vertex_nv vertex_processed[1024+2]; // output of the vertex program for a batch of vertices
+	nv2avertex_t vertex_converted[1024+2]; // a batch of vertices ready to be assembled into primitives
 	vertex_nv persistvertexattr; // persistent vertex attributes
 	render_delegate render_spans_callback;
 
@@ -748,7 +763,25 @@ public:
 		int start_instruction;
 		int upload_parameter_index;
 		int upload_parameter_component;
+		uint32_t serial; // bumped whenever the program, its start or its constants change
+		uint32_t checked_serial;
+		bool writes_constants;
 	} vertexprogram;
+	// long batches of vertices go through the vertex program on the worker threads
+	enum { VERTEX_BATCH_SIZE = 32 };
+	struct vertex_batch {
+		nv2a_renderer *renderer;
+		vertex_nv *source;
+		vertex_nv *destination;
+		int count;
+	};
+	struct vertex_worker {
+		std::unique_ptr<vertex_program_simulator> exec;
+		uint32_t serial;
+	};
+	osd_work_queue *vertex_queue;
+	vertex_batch vertex_batches[(1024 + 2 + VERTEX_BATCH_SIZE - 1) / VERTEX_BATCH_SIZE];
+	vertex_worker vertex_workers[WORK_MAX_THREADS + 1];
 	int vertex_pipeline;
 	int enabled_vertex_attributes;
 	int vertex_attribute_words[16];
@@ -997,6 +997,9 @@ uint32_t hng64_state::screen_update_hng64(screen_device &screen, bitmap_rgb32 &b
 	{
 		int x, y;
 
+		// Finish any polygons still being rasterized
+		m_poly_renderer->wait("screen update");
+
 		// Blit the color buffer into the primary bitmap
 		for (y = cliprect.min_y; y <= cliprect.max_y; y++)
 		{
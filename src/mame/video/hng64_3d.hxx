@@ -482,6 +482,25 @@ void hng64_state::recoverPolygonBlock(const uint16_t* packet, int& numPolys)
 	//if (threeDPointer[14] & 0x0001) tdColor |= 0x0000ff00;
 	//if (threeDPointer[14] & 0x0000) tdColor |= 0x000000ff;
 
+	// Perform the world transformations...
+	// The camera and object matrices are fixed for the whole block, so this is done once rather than per polygon
+	// Note: fatfurwa's helicopter tracking in scene 3 of its intro shows one of these matrices isn't quite correct
+	setIdentity(m_modelViewMatrix);
+	if (!m_samsho64_3d_hack)
+	{
+		// The sams64 games transform the geometry in front of a stationary camera.
+		// This is fine in sams64_2, since it never calls the 'camera transformation' function
+		// (thus using the identity matrix for this transform), but sams64 calls the
+		// camera transformation function with rotation values.
+		// It remains to be seen what those might do...
+		matmul4(m_modelViewMatrix, m_modelViewMatrix, m_cameraMatrix);
+	}
+	matmul4(m_modelViewMatrix, m_modelViewMatrix, objectMatrix);
+
+	const bool applyLighting = (packet[1] & 0x0008) && m_lightStrength > 0.0f;
+	if (applyLighting)
+		normalize(m_lightVector);
+
 	// For all 4 polygon chunks
 	for (int k = 0; k < 4; k++)
 	{
@@ -760,30 +779,14 @@ void hng64_state::recoverPolygonBlock(const uint16_t* packet, int& numPolys)
 			////////////////////////////////////
 			// Project and clip               //
 			////////////////////////////////////
-			// Perform the world transformations...
-			// TODO: We can eliminate this step with a matrix stack (maybe necessary?)
-			// Note: fatfurwa's helicopter tracking in scene 3 of its intro shows one of these matrices isn't quite correct
-			setIdentity(m_modelViewMatrix);
-			if (!m_samsho64_3d_hack)
-			{
-				// The sams64 games transform the geometry in front of a stationary camera.
-				// This is fine in sams64_2, since it never calls the 'camera transformation' function
-				// (thus using the identity matrix for this transform), but sams64 calls the
-				// camera transformation function with rotation values.
-				// It remains to be seen what those might do...
-				matmul4(m_modelViewMatrix, m_modelViewMatrix, m_cameraMatrix);
-			}
-			matmul4(m_modelViewMatrix, m_modelViewMatrix, objectMatrix);
-
 			// LIGHTING
-			if (packet[1] & 0x0008 && m_lightStrength > 0.0f)
+			if (applyLighting)
 			{
 				for (int v = 0; v < 3; v++)
 				{
 					float transformedNormal[4];
 					vecmatmul4(transformedNormal, objectMatrix, currentPoly.vert[v].normal);
 					normalize(transformedNormal);
-					normalize(m_lightVector);
 
 					float intensity = vecDotProduct(transformedNormal, m_lightVector) * -1.0f;
 					intensity = (intensity <= 0.0f) ? (0.0f) : (intensity);
@@ -813,7 +816,9 @@ void hng64_state::recoverPolygonBlock(const uint16_t* packet, int& numPolys)
 			float cullNorm[4];
 
 			// Cast a ray out of the camera towards the polygon's point in eyespace.
-			vecmatmul4(cullRay, m_modelViewMatrix, currentPoly.vert[0].worldCoords);
+			float eyeRay[4];
+			vecmatmul4(eyeRay, m_modelViewMatrix, currentPoly.vert[0].worldCoords);
+			memcpy(cullRay, eyeRay, sizeof(cullRay));
 			normalize(cullRay);
 
 			// Dot product that with the normal to see if you're negative...
@@ -826,8 +831,7 @@ void hng64_state::recoverPolygonBlock(const uint16_t* packet, int& numPolys)
 				currentPoly.visible = 0;
 
 			// BEHIND-THE-CAMERA CULL //
-			vecmatmul4(cullRay, m_modelViewMatrix, currentPoly.vert[0].worldCoords);
-			if (cullRay[2] > 0.0f)              // Camera is pointing down -Z
+			if (eyeRay[2] > 0.0f)               // Camera is pointing down -Z
 			{
 				currentPoly.visible = 0;
 			}
@@ -1003,11 +1007,15 @@ void hng64_state::hng64_command3d(const uint16_t* packet)
 			m_poly_renderer->drawShaded(&m_polys[i]);
 		}
 	}
-	m_poly_renderer->wait();
+
+	// Rasterization keeps running on the work queue; the buffers are only synchronized when cleared or displayed
 }
 
 void hng64_state::clear3d()
 {
+	// Let any queued polygons finish before their buffers are cleared
+	m_poly_renderer->wait("clear3d");
+
 	// Reset the buffers...
 	const rectangle& visarea = m_screen->visible_area();
 	for (int i = 0; i < (visarea.max_x)*(visarea.max_y); i++)
@@ -1345,6 +1353,13 @@ void hng64_poly_renderer::drawShaded(polygon *p)
 		p->vert[j].texCoords[1]  = p->vert[j].texCoords[1] * p->vert[j].clipCoords[3];
 	}
 
+	// The triangles of the fan all share the same render data
+	hng64_poly_data& renderData = object_data_alloc();
+	renderData = rOptions;
+
+	const rectangle& visibleArea = m_state.m_screen->visible_area();
+	render_delegate callback(&hng64_poly_renderer::render_scanline, this);
+
 	// Rasterize the triangles
 	for (int j = 1; j < p->n-1; j++)
 	{
@@ -1384,11 +1399,6 @@ void hng64_poly_renderer::drawShaded(polygon *p)
 		pVert[2].p[5] = pvjp1.texCoords[0];
 		pVert[2].p[6] = pvjp1.texCoords[1];
 
-		// Pass the render data into the rasterizer
-		hng64_poly_data& renderData = object_data_alloc();
-		renderData = rOptions;
-
-		const rectangle& visibleArea = m_state.m_screen->visible_area();
-		render_triangle(visibleArea, render_delegate(&hng64_poly_renderer::render_scanline, this), 7, pVert[0], pVert[1], pVert[2]);
+		render_triangle(visibleArea, callback, 7, pVert[0], pVert[1], pVert[2]);
 	}
 }
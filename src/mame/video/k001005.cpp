@@ -74,6 +74,13 @@ k001005_renderer::k001005_renderer(device_t &parent, screen_device &screen, devi
 	parent.save_item(NAME(m_fog_b));
 	parent.save_item(NAME(m_far_z));
 
+	m_geometry_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+}
+
+k001005_renderer::~k001005_renderer()
+{
+	if (m_geometry_queue != nullptr)
+		osd_work_queue_free(m_geometry_queue);
 }
 
 void k001005_renderer::reset()
@@ -148,8 +155,6 @@ void k001005_renderer::render_polygons()
 
 	int index = 0;
 
-	float fog_density = 1.5f;
-
 	render_delegate rd_scan_2d = render_delegate(&k001005_renderer::draw_scanline_2d, this);
 	render_delegate rd_scan_tex2d = render_delegate(&k001005_renderer::draw_scanline_2d_tex, this);
 	render_delegate rd_scan = render_delegate(&k001005_renderer::draw_scanline, this);
@@ -191,7 +196,7 @@ void k001005_renderer::render_polygons()
 
 			int tex_x, tex_y;
 			uint32_t color = 0;
-			k001005_polydata &extra = object_data_alloc();
+			k001005_polydata extra = { 0 };
 
 			uint32_t header = fifo[index++];
 
@@ -231,10 +236,6 @@ void k001005_renderer::render_polygons()
 				v[vert_num].p[POLY_U] = tu * v[vert_num].p[POLY_W];
 				v[vert_num].p[POLY_V] = tv * v[vert_num].p[POLY_W];
 				v[vert_num].p[POLY_BRI] = brightness;
-				v[vert_num].p[POLY_FOG] = (1.0f / (exp( ((v[vert_num].p[POLY_Z] * fog_density) / m_far_z) * ((v[vert_num].p[POLY_Z] * fog_density) / m_far_z) ))) * 65536.0f;
-				//v[vert_num].p[POLY_FOG] = (1.0f / (exp( ((v[vert_num].p[POLY_Z] * fog_density) / far_z) ))) * 65536.0f;
-				if (v[vert_num].p[POLY_FOG] < 0.0f) v[vert_num].p[POLY_FOG] = 0.0f;
-				if (v[vert_num].p[POLY_FOG] > 65536.0f) v[vert_num].p[POLY_FOG] = 65536.0f;
 				vert_num++;
 			}
 			while (!last_vertex);
@@ -294,7 +295,7 @@ void k001005_renderer::render_polygons()
 					vertex3 = &v[2];
 				}
 
-				render_triangle(m_cliprect, rd_scan_tex, 6, *vertex1, *vertex2, *vertex3);
+				queue_triangle(m_cliprect, rd_scan_tex, 6, true, extra, *vertex1, *vertex2, *vertex3);
 
 				memcpy(&m_prev_v[1], vertex1, sizeof(vertex_t));
 				memcpy(&m_prev_v[2], vertex2, sizeof(vertex_t));
@@ -331,8 +332,8 @@ void k001005_renderer::render_polygons()
 					vertex4 = &v[3];
 				}
 
-				render_triangle(visarea, rd_scan_tex, 6, *vertex1, *vertex2, *vertex3);
-				render_triangle(visarea, rd_scan_tex, 6, *vertex3, *vertex4, *vertex1);
+				queue_triangle(visarea, rd_scan_tex, 6, true, extra, *vertex1, *vertex2, *vertex3);
+				queue_triangle(visarea, rd_scan_tex, 6, true, extra, *vertex3, *vertex4, *vertex1);
 
 				memcpy(&m_prev_v[0], vertex1, sizeof(vertex_t));
 				memcpy(&m_prev_v[1], vertex2, sizeof(vertex_t));
@@ -342,7 +343,7 @@ void k001005_renderer::render_polygons()
 
 			while ((fifo[index] & 0xffffff00) != 0x80000000 && index < m_3dfifo_ptr)
 			{
-				k001005_polydata &extra = object_data_alloc();
+				k001005_polydata extra = { 0 };
 				int new_verts = 0;
 
 				memcpy(&v[0], &m_prev_v[2], sizeof(vertex_t));
@@ -384,10 +385,6 @@ void k001005_renderer::render_polygons()
 					v[vert_num].p[POLY_U] = tu * v[vert_num].p[POLY_W];
 					v[vert_num].p[POLY_V] = tv * v[vert_num].p[POLY_W];
 					v[vert_num].p[POLY_BRI] = brightness;
-					v[vert_num].p[POLY_FOG] = (1.0f / (exp( ((v[vert_num].p[POLY_Z] * fog_density) / m_far_z) * ((v[vert_num].p[POLY_Z] * fog_density) / m_far_z) ))) * 65536.0f;
-					//v[vert_num].p[POLY_FOG] = (1.0f / (exp( ((v[vert_num].p[POLY_Z] * fog_density) / far_z) ))) * 65536.0f;
-					if (v[vert_num].p[POLY_FOG] < 0.0f) v[vert_num].p[POLY_FOG] = 0.0f;
-					if (v[vert_num].p[POLY_FOG] > 65536.0f) v[vert_num].p[POLY_FOG] = 65536.0f;
 
 					vert_num++;
 					new_verts++;
@@ -419,7 +416,7 @@ void k001005_renderer::render_polygons()
 
 				if (new_verts == 1)
 				{
-					render_triangle(visarea, rd_scan_tex, 6, v[0], v[1], v[2]);
+					queue_triangle(visarea, rd_scan_tex, 6, true, extra, v[0], v[1], v[2]);
 
 					memcpy(&m_prev_v[1], &v[0], sizeof(vertex_t));
 					memcpy(&m_prev_v[2], &v[1], sizeof(vertex_t));
@@ -427,8 +424,8 @@ void k001005_renderer::render_polygons()
 				}
 				else if (new_verts == 2)
 				{
-					render_triangle(visarea, rd_scan_tex, 6, v[0], v[1], v[2]);
-					render_triangle(visarea, rd_scan_tex, 6, v[2], v[3], v[0]);
+					queue_triangle(visarea, rd_scan_tex, 6, true, extra, v[0], v[1], v[2]);
+					queue_triangle(visarea, rd_scan_tex, 6, true, extra, v[2], v[3], v[0]);
 
 					memcpy(&m_prev_v[0], &v[0], sizeof(vertex_t));
 					memcpy(&m_prev_v[1], &v[1], sizeof(vertex_t));
@@ -441,7 +438,7 @@ void k001005_renderer::render_polygons()
 		{
 			// no texture, Z
 
-			k001005_polydata &extra = object_data_alloc();
+			k001005_polydata extra = { 0 };
 			uint32_t color;
 			int r, g, b, a;
 
@@ -468,10 +465,6 @@ void k001005_renderer::render_polygons()
 				v[vert_num].y = ((float)(-y) / 16.0f) + 192.0f + 8;
 				v[vert_num].p[POLY_Z] = *(float*)(&z);
 				v[vert_num].p[POLY_BRI] = brightness;
-				v[vert_num].p[POLY_FOG] = (1.0f / (exp( ((v[vert_num].p[POLY_Z] * fog_density) / m_far_z) * ((v[vert_num].p[POLY_Z] * fog_density) / m_far_z) ))) * 65536.0f;
-				//v[vert_num].p[POLY_FOG] = (1.0f / (exp( ((v[vert_num].p[POLY_Z] * fog_density) / far_z) ))) * 65536.0f;
-				if (v[vert_num].p[POLY_FOG] < 0.0f) v[vert_num].p[POLY_FOG] = 0.0f;
-				if (v[vert_num].p[POLY_FOG] > 65536.0f) v[vert_num].p[POLY_FOG] = 65536.0f;
 				vert_num++;
 			}
 			while (!last_vertex);
@@ -516,7 +509,7 @@ void k001005_renderer::render_polygons()
 					vertex3 = &v[2];
 				}
 
-				render_triangle(visarea, rd_scan, 3, *vertex1, *vertex2, *vertex3);
+				queue_triangle(visarea, rd_scan, 3, true, extra, *vertex1, *vertex2, *vertex3);
 
 				memcpy(&m_prev_v[1], vertex1, sizeof(vertex_t));
 				memcpy(&m_prev_v[2], vertex2, sizeof(vertex_t));
@@ -553,8 +546,8 @@ void k001005_renderer::render_polygons()
 					vertex4 = &v[3];
 				}
 
-				render_triangle(visarea, rd_scan, 3, *vertex1, *vertex2, *vertex3);
-				render_triangle(visarea, rd_scan, 3, *vertex3, *vertex4, *vertex1);
+				queue_triangle(visarea, rd_scan, 3, true, extra, *vertex1, *vertex2, *vertex3);
+				queue_triangle(visarea, rd_scan, 3, true, extra, *vertex3, *vertex4, *vertex1);
 
 				memcpy(&m_prev_v[0], vertex1, sizeof(vertex_t));
 				memcpy(&m_prev_v[1], vertex2, sizeof(vertex_t));
@@ -592,10 +585,6 @@ void k001005_renderer::render_polygons()
 					v[vert_num].y = ((float)(-y) / 16.0f) + 192.0f + 8;
 					v[vert_num].p[POLY_Z] = *(float*)(&z);
 					v[vert_num].p[POLY_BRI] = brightness;
-					v[vert_num].p[POLY_FOG] = (1.0f / (exp( ((v[vert_num].p[POLY_Z] * fog_density) / m_far_z) * ((v[vert_num].p[POLY_Z] * fog_density) / m_far_z) ))) * 65536.0f;
-					//v[vert_num].p[POLY_FOG] = (1.0f / (exp( ((v[vert_num].p[POLY_Z] * fog_density) / far_z) ))) * 65536.0f;
-					if (v[vert_num].p[POLY_FOG] < 0.0f) v[vert_num].p[POLY_FOG] = 0.0f;
-					if (v[vert_num].p[POLY_FOG] > 65536.0f) v[vert_num].p[POLY_FOG] = 65536.0f;
 
 					vert_num++;
 					new_verts++;
@@ -623,7 +612,7 @@ void k001005_renderer::render_polygons()
 
 				if (new_verts == 1)
 				{
-					render_triangle(visarea, rd_scan, 3, v[0], v[1], v[2]);
+					queue_triangle(visarea, rd_scan, 3, true, extra, v[0], v[1], v[2]);
 
 					memcpy(&m_prev_v[1], &v[0], sizeof(vertex_t));
 					memcpy(&m_prev_v[2], &v[1], sizeof(vertex_t));
@@ -631,8 +620,8 @@ void k001005_renderer::render_polygons()
 				}
 				else if (new_verts == 2)
 				{
-					render_triangle(visarea, rd_scan, 3, v[0], v[1], v[2]);
-					render_triangle(visarea, rd_scan, 3, v[2], v[3], v[0]);
+					queue_triangle(visarea, rd_scan, 3, true, extra, v[0], v[1], v[2]);
+					queue_triangle(visarea, rd_scan, 3, true, extra, v[2], v[3], v[0]);
 
 					memcpy(&m_prev_v[0], &v[0], sizeof(vertex_t));
 					memcpy(&m_prev_v[1], &v[1], sizeof(vertex_t));
@@ -645,7 +634,7 @@ void k001005_renderer::render_polygons()
 		{
 			// no texture, no Z
 
-			k001005_polydata &extra = object_data_alloc();
+			k001005_polydata extra = { 0 };
 			int r, g, b, a;
 			uint32_t color;
 
@@ -685,12 +674,12 @@ void k001005_renderer::render_polygons()
 
 			if (poly_type == 0)
 			{
-				render_triangle(visarea, rd_scan_2d, 0, v[0], v[1], v[2]);
+				queue_triangle(visarea, rd_scan_2d, 0, false, extra, v[0], v[1], v[2]);
 			}
 			else
 			{
-				render_triangle(visarea, rd_scan_2d, 0, v[0], v[1], v[2]);
-				render_triangle(visarea, rd_scan_2d, 0, v[2], v[3], v[0]);
+				queue_triangle(visarea, rd_scan_2d, 0, false, extra, v[0], v[1], v[2]);
+				queue_triangle(visarea, rd_scan_2d, 0, false, extra, v[2], v[3], v[0]);
 			}
 		}
 		else if (cmd == 0x8000008b)
@@ -698,7 +687,7 @@ void k001005_renderer::render_polygons()
 			// texture, no Z
 
 			int tex_x, tex_y;
-			k001005_polydata &extra = object_data_alloc();
+			k001005_polydata extra = { 0 };
 			int r, g, b, a;
 			uint32_t color = 0;
 
@@ -774,19 +763,19 @@ void k001005_renderer::render_polygons()
 
 			if (poly_type == 0)
 			{
-				render_triangle(visarea, rd_scan_tex2d, 5, v[0], v[1], v[2]);
+				queue_triangle(visarea, rd_scan_tex2d, 5, false, extra, v[0], v[1], v[2]);
 			}
 			else
 			{
-				render_triangle(visarea, rd_scan_tex2d, 5, v[0], v[1], v[2]);
-				render_triangle(visarea, rd_scan_tex2d, 5, v[2], v[3], v[0]);
+				queue_triangle(visarea, rd_scan_tex2d, 5, false, extra, v[0], v[1], v[2]);
+				queue_triangle(visarea, rd_scan_tex2d, 5, false, extra, v[2], v[3], v[0]);
 			}
 		}
 		else if (cmd == 0x80000121 || cmd == 0x80000126)
 		{
 			// no texture, color gouraud, Z
 
-			k001005_polydata &extra = object_data_alloc();
+			k001005_polydata extra = { 0 };
 			uint32_t color;
 
 			int last_vertex = 0;
@@ -827,12 +816,12 @@ void k001005_renderer::render_polygons()
 
 			if (poly_type == 0)
 			{
-				render_triangle(visarea, rd_scan_gour_blend, 6, v[0], v[1], v[2]);
+				queue_triangle(visarea, rd_scan_gour_blend, 6, false, extra, v[0], v[1], v[2]);
 			}
 			else
 			{
-				render_triangle(visarea, rd_scan_gour_blend, 6, v[0], v[1], v[2]);
-				render_triangle(visarea, rd_scan_gour_blend, 6, v[2], v[3], v[0]);
+				queue_triangle(visarea, rd_scan_gour_blend, 6, false, extra, v[0], v[1], v[2]);
+				queue_triangle(visarea, rd_scan_gour_blend, 6, false, extra, v[2], v[3], v[0]);
 			}
 
 			// TODO: can this poly type form strips?
@@ -874,10 +863,99 @@ void k001005_renderer::render_polygons()
 
 	m_3dfifo_ptr = 0;
 
+	render_geometry();
 	wait();
 }
 
 
+void k001005_renderer::queue_triangle(const rectangle &cliprect, const render_delegate &callback, int paramcount, bool fog, const k001005_polydata &extra, const vertex_t &v1, const vertex_t &v2, const vertex_t &v3)
+{
+	// strips share their object data, so only keep a new copy when it changes
+	if (m_triangle_objects.empty() || memcmp(&m_triangle_objects.back(), &extra, sizeof(extra)) != 0)
+		m_triangle_objects.push_back(extra);
+
+	m_triangles.emplace_back();
+	geometry_triangle &tri = m_triangles.back();
+	tri.v[0] = v1;
+	tri.v[1] = v2;
+	tri.v[2] = v3;
+	tri.cliprect = &cliprect;
+	tri.callback = &callback;
+	tri.paramcount = paramcount;
+	tri.object = m_triangle_objects.size() - 1;
+	tri.fog = fog;
+}
+
+float k001005_renderer::vertex_fog(float z) const
+{
+	float fog_density = 1.5f;
+
+	float fog = (1.0f / (exp( ((z * fog_density) / m_far_z) * ((z * fog_density) / m_far_z) ))) * 65536.0f;
+	//float fog = (1.0f / (exp( ((z * fog_density) / far_z) ))) * 65536.0f;
+	if (fog < 0.0f) fog = 0.0f;
+	if (fog > 65536.0f) fog = 65536.0f;
+	return fog;
+}
+
+void k001005_renderer::compute_fog(int first, int count)
+{
+	for (int i = first; i < first + count; i++)
+	{
+		geometry_triangle &tri = m_triangles[i];
+		if (tri.fog)
+		{
+			for (vertex_t &v : tri.v)
+				v.p[POLY_FOG] = vertex_fog(v.p[POLY_Z]);
+		}
+	}
+}
+
+void *k001005_renderer::geometry_batch_callback(void *param, int threadid)
+{
+	geometry_batch *batch = (geometry_batch *)param;
+	batch->renderer->compute_fog(batch->first, batch->count);
+	return nullptr;
+}
+
+void k001005_renderer::render_geometry()
+{
+	int count = m_triangles.size();
+
+	// the per-vertex fog is the expensive part of setup, so large batches are spread over the workers
+	if ((m_geometry_queue != nullptr) && (count > GEOMETRY_BATCH_SIZE))
+	{
+		int batches = (count + GEOMETRY_BATCH_SIZE - 1) / GEOMETRY_BATCH_SIZE;
+		m_geometry_batches.resize(batches);
+		for (int b = 0; b < batches; b++)
+		{
+			geometry_batch &batch = m_geometry_batches[b];
+			batch.renderer = this;
+			batch.first = b * GEOMETRY_BATCH_SIZE;
+			batch.count = std::min(count - batch.first, int(GEOMETRY_BATCH_SIZE));
+		}
+		osd_work_item_queue_multiple(m_geometry_queue, geometry_batch_callback, batches, &m_geometry_batches[0], sizeof(geometry_batch), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(m_geometry_queue, osd_ticks_per_second() * 100);
+	}
+	else
+		compute_fog(0, count);
+
+	// submit in FIFO order so rasterization matches the serial path
+	int object = -1;
+	for (geometry_triangle &tri : m_triangles)
+	{
+		if (tri.object != object)
+		{
+			object = tri.object;
+			object_data_alloc() = m_triangle_objects[object];
+		}
+		render_triangle(*tri.cliprect, *tri.callback, tri.paramcount, tri.v[0], tri.v[1], tri.v[2]);
+	}
+
+	m_triangles.clear();
+	m_triangle_objects.clear();
+}
+
+
 void k001005_renderer::draw_scanline_2d(int32_t scanline, const extent_t &extent, const k001005_polydata &extradata, int threadid)
 {
 	uint32_t *fb = &m_fb[m_fb_page]->pix32(scanline);
@@ -46,6 +46,7 @@ class k001005_renderer : public poly_manager<float, k001005_polydata, 8, 50000>
 {
 public:
 	k001005_renderer(device_t &parent, screen_device &screen, device_t *k001006);
+	~k001005_renderer();
 
 	void reset();
 	void push_data(uint32_t data);
@@ -73,6 +74,37 @@ public:
 	static constexpr int POLY_B = 5;
 
 private:
+	// triangles are decoded in one pass and submitted in FIFO order after their fog is filled in
+	static constexpr int GEOMETRY_BATCH_SIZE = 256;
+
+	struct geometry_triangle
+	{
+		vertex_t v[3];
+		const rectangle *cliprect;
+		const render_delegate *callback;
+		int paramcount;
+		int object;                 // index into m_triangle_objects
+		bool fog;                   // vertices need POLY_FOG computed from POLY_Z
+	};
+
+	struct geometry_batch
+	{
+		k001005_renderer *renderer;
+		int first;
+		int count;
+	};
+
+	void queue_triangle(const rectangle &cliprect, const render_delegate &callback, int paramcount, bool fog, const k001005_polydata &extra, const vertex_t &v1, const vertex_t &v2, const vertex_t &v3);
+	float vertex_fog(float z) const;
+	void compute_fog(int first, int count);
+	void render_geometry();
+	static void *geometry_batch_callback(void *param, int threadid);
+
+	std::vector<geometry_triangle> m_triangles;
+	std::vector<k001005_polydata> m_triangle_objects;
+	std::vector<geometry_batch> m_geometry_batches;
+	osd_work_queue *m_geometry_queue;
+
 	std::unique_ptr<bitmap_rgb32> m_fb[2];
 	std::unique_ptr<bitmap_ind32> m_zb;
 	rectangle m_cliprect;
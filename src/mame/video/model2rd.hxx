@@ -158,19 +158,21 @@ void MODEL2_FUNC_NAME(int32_t scanline, const extent_t& extent, const m2_poly_ex
 
 	for(x = extent.startx; x < extent.stopx; x++, uoz += duoz, voz += dvoz, ooz += dooz)
 	{
-		float z = recip_approx(ooz) * 256.0f;
-		int32_t u = uoz * z;
-		int32_t v = voz * z;
 		int  tr, tg, tb;
 		uint16_t  t;
 		uint8_t luma;
 		int u2;
 		int v2;
 
+		/* skip the checkered-out pixels before paying for the divide */
 #if defined(MODEL2_CHECKER)
 		if ( ((x^scanline) & 1) == 0 )
 			continue;
 #endif
+		float z = recip_approx(ooz) * 256.0f;
+		int32_t u = uoz * z;
+		int32_t v = voz * z;
+
 		u2 = (u >> 8) & tex_x_mask;
 		v2 = (v >> 8) & tex_y_mask;
 
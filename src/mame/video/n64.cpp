@@ -994,7 +994,6 @@ bool n64_rdp::z_compare(uint32_t zcurpixel, uint32_t dzcurpixel, uint32_t sz, ui
 		rawdzmem = 0xf;
 	}
 
-	userdata->m_dzpix_enc = dz_compress(dzpix & 0xffff);
 	userdata->m_shift_a = CLAMP(userdata->m_dzpix_enc - rawdzmem, 0, 4);
 	userdata->m_shift_b = CLAMP(rawdzmem - userdata->m_dzpix_enc, 0, 4);
 
@@ -3508,6 +3507,53 @@ inline void n64_rdp::fill_pixel(uint32_t curpixel, const rdp_poly_state &object)
 	}
 }
 
+// true if an input holds the same value for the whole span: everything but the texels, shade, noise, LOD and the first cycle's output
+bool n64_rdp::color_input_is_constant(const color_t* input, const rdp_span_aux* userdata) const
+{
+	return input != &userdata->m_combined_color && input != &userdata->m_combined_alpha &&
+			input != &userdata->m_texel0_color && input != &userdata->m_texel0_alpha &&
+			input != &userdata->m_texel1_color && input != &userdata->m_texel1_alpha &&
+			input != &userdata->m_shade_color && input != &userdata->m_shade_alpha &&
+			input != &userdata->m_noise_color && input != &userdata->m_lod_fraction;
+}
+
+bool n64_rdp::combiner_is_constant(int32_t cycle, const rdp_span_aux* userdata) const
+{
+	const color_inputs_t& inputs = userdata->m_color_inputs;
+	return color_input_is_constant(inputs.combiner_rgbsub_a[cycle], userdata) && color_input_is_constant(inputs.combiner_rgbsub_b[cycle], userdata) &&
+			color_input_is_constant(inputs.combiner_rgbmul[cycle], userdata) && color_input_is_constant(inputs.combiner_rgbadd[cycle], userdata) &&
+			color_input_is_constant(inputs.combiner_alphasub_a[cycle], userdata) && color_input_is_constant(inputs.combiner_alphasub_b[cycle], userdata) &&
+			color_input_is_constant(inputs.combiner_alphamul[cycle], userdata) && color_input_is_constant(inputs.combiner_alphaadd[cycle], userdata);
+}
+
+// one cycle of the color combiner, (A - B) * C + D
+inline void n64_rdp::combine_cycle(rgbaint_t& out, int32_t cycle, rdp_span_aux* userdata)
+{
+	const color_inputs_t& inputs = userdata->m_color_inputs;
+
+	out.set(*inputs.combiner_rgbsub_a[cycle]);
+	rgbaint_t rgbsub_b(*inputs.combiner_rgbsub_b[cycle]);
+	rgbaint_t rgbmul(*inputs.combiner_rgbmul[cycle]);
+	rgbaint_t rgbadd(*inputs.combiner_rgbadd[cycle]);
+
+	out.merge_alpha(*inputs.combiner_alphasub_a[cycle]);
+	rgbsub_b.merge_alpha(*inputs.combiner_alphasub_b[cycle]);
+	rgbmul.merge_alpha(*inputs.combiner_alphamul[cycle]);
+	rgbadd.merge_alpha(*inputs.combiner_alphaadd[cycle]);
+
+	out.sign_extend(0x180, 0xfffffe00);
+	rgbsub_b.sign_extend(0x180, 0xfffffe00);
+	rgbadd.sign_extend(0x180, 0xfffffe00);
+
+	rgbadd.shl_imm(8);
+	out.sub(rgbsub_b);
+	out.mul(rgbmul);
+	out.add(rgbadd);
+	out.add_imm(0x0080);
+	out.sra_imm(8);
+	out.clamp_and_clear(0xfffffe00);
+}
+
 void n64_rdp::span_draw_1cycle(int32_t scanline, const extent_t &extent, const rdp_poly_state &object, int32_t threadid)
 {
 	assert(object.m_misc_state.m_fb_size >= 2 && object.m_misc_state.m_fb_size < 4);
@@ -3610,6 +3656,13 @@ void n64_rdp::span_draw_1cycle(int32_t scanline, const extent_t &extent, const r
 		tc_div_no_perspective(s.w >> 16, t.w >> 16, w.w >> 16, &sss, &sst);
 	}
 
+	// these only depend on the span, not on the pixel
+	userdata->m_dzpix_enc = dz_compress(dzpix & 0xffff);
+
+	const bool constant_combine = combiner_is_constant(1, userdata);
+	rgbaint_t combined;
+	bool combined_ready = false;
+
 	userdata->m_start_span = true;
 	for (int32_t j = 0; j <= length; j++)
 	{
@@ -3637,29 +3690,13 @@ void n64_rdp::span_draw_1cycle(int32_t scanline, const extent_t &extent, const r
 			const uint8_t noise = machine().rand() << 3; // Not accurate
 			userdata->m_noise_color.set(0, noise, noise, noise);
 
-			rgbaint_t rgbsub_a(*userdata->m_color_inputs.combiner_rgbsub_a[1]);
-			rgbaint_t rgbsub_b(*userdata->m_color_inputs.combiner_rgbsub_b[1]);
-			rgbaint_t rgbmul(*userdata->m_color_inputs.combiner_rgbmul[1]);
-			rgbaint_t rgbadd(*userdata->m_color_inputs.combiner_rgbadd[1]);
-
-			rgbsub_a.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_a[1]);
-			rgbsub_b.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_b[1]);
-			rgbmul.merge_alpha(*userdata->m_color_inputs.combiner_alphamul[1]);
-			rgbadd.merge_alpha(*userdata->m_color_inputs.combiner_alphaadd[1]);
-
-			rgbsub_a.sign_extend(0x180, 0xfffffe00);
-			rgbsub_b.sign_extend(0x180, 0xfffffe00);
-			rgbadd.sign_extend(0x180, 0xfffffe00);
-
-			rgbadd.shl_imm(8);
-			rgbsub_a.sub(rgbsub_b);
-			rgbsub_a.mul(rgbmul);
-			rgbsub_a.add(rgbadd);
-			rgbsub_a.add_imm(0x0080);
-			rgbsub_a.sra_imm(8);
-			rgbsub_a.clamp_and_clear(0xfffffe00);
+			if (!combined_ready)
+			{
+				combine_cycle(combined, 1, userdata);
+				combined_ready = constant_combine;
+			}
 
-			userdata->m_pixel_color = rgbsub_a;
+			userdata->m_pixel_color = combined;
 
 			//Alpha coverage combiner
 			userdata->m_pixel_color.set_a(get_alpha_cvg(userdata->m_pixel_color.get_a(), userdata, object));
@@ -3821,6 +3858,15 @@ void n64_rdp::span_draw_2cycle(int32_t scanline, const extent_t &extent, const r
 		tc_div_no_perspective(s.w >> 16, t.w >> 16, w.w >> 16, &sss, &sst);
 	}
 
+	// these only depend on the span, not on the pixel
+	userdata->m_dzpix_enc = dz_compress(dzpix & 0xffff);
+
+	const bool constant_combine0 = combiner_is_constant(0, userdata);
+	const bool constant_combine1 = combiner_is_constant(1, userdata);
+	rgbaint_t combined0, combined1;
+	bool combined0_ready = false;
+	bool combined1_ready = false;
+
 	userdata->m_start_span = true;
 	for (int32_t j = 0; j <= length; j++)
 	{
@@ -3864,30 +3910,13 @@ void n64_rdp::span_draw_2cycle(int32_t scanline, const extent_t &extent, const r
 			const uint8_t noise = machine().rand() << 3; // Not accurate
 			userdata->m_noise_color.set(0, noise, noise, noise);
 
-			rgbaint_t rgbsub_a(*userdata->m_color_inputs.combiner_rgbsub_a[0]);
-			rgbaint_t rgbsub_b(*userdata->m_color_inputs.combiner_rgbsub_b[0]);
-			rgbaint_t rgbmul(*userdata->m_color_inputs.combiner_rgbmul[0]);
-			rgbaint_t rgbadd(*userdata->m_color_inputs.combiner_rgbadd[0]);
-
-			rgbsub_a.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_a[0]);
-			rgbsub_b.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_b[0]);
-			rgbmul.merge_alpha(*userdata->m_color_inputs.combiner_alphamul[0]);
-			rgbadd.merge_alpha(*userdata->m_color_inputs.combiner_alphaadd[0]);
-
-			rgbsub_a.sign_extend(0x180, 0xfffffe00);
-			rgbsub_b.sign_extend(0x180, 0xfffffe00);
-			rgbadd.sign_extend(0x180, 0xfffffe00);
-
-			rgbadd.shl_imm(8);
-			rgbsub_a.sub(rgbsub_b);
-			rgbsub_a.mul(rgbmul);
-
-			rgbsub_a.add(rgbadd);
-			rgbsub_a.add_imm(0x0080);
-			rgbsub_a.sra_imm(8);
-			rgbsub_a.clamp_and_clear(0xfffffe00);
+			if (!combined0_ready)
+			{
+				combine_cycle(combined0, 0, userdata);
+				combined0_ready = constant_combine0;
+			}
 
-			userdata->m_combined_color.set(rgbsub_a);
+			userdata->m_combined_color.set(combined0);
 			userdata->m_texel0_color.set(userdata->m_texel1_color);
 			userdata->m_texel1_color.set(userdata->m_next_texel_color);
 
@@ -3896,29 +3925,13 @@ void n64_rdp::span_draw_2cycle(int32_t scanline, const extent_t &extent, const r
 			userdata->m_texel0_alpha.set(userdata->m_texel1_alpha);
 			userdata->m_texel1_alpha.set(userdata->m_next_texel_alpha);
 
-			rgbsub_a.set(*userdata->m_color_inputs.combiner_rgbsub_a[1]);
-			rgbsub_b.set(*userdata->m_color_inputs.combiner_rgbsub_b[1]);
-			rgbmul.set(*userdata->m_color_inputs.combiner_rgbmul[1]);
-			rgbadd.set(*userdata->m_color_inputs.combiner_rgbadd[1]);
-
-			rgbsub_a.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_a[1]);
-			rgbsub_b.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_b[1]);
-			rgbmul.merge_alpha(*userdata->m_color_inputs.combiner_alphamul[1]);
-			rgbadd.merge_alpha(*userdata->m_color_inputs.combiner_alphaadd[1]);
-
-			rgbsub_a.sign_extend(0x180, 0xfffffe00);
-			rgbsub_b.sign_extend(0x180, 0xfffffe00);
-			rgbadd.sign_extend(0x180, 0xfffffe00);
-
-			rgbadd.shl_imm(8);
-			rgbsub_a.sub(rgbsub_b);
-			rgbsub_a.mul(rgbmul);
-			rgbsub_a.add(rgbadd);
-			rgbsub_a.add_imm(0x0080);
-			rgbsub_a.sra_imm(8);
-			rgbsub_a.clamp_and_clear(0xfffffe00);
-
-			userdata->m_pixel_color.set(rgbsub_a);
+			if (!combined1_ready)
+			{
+				combine_cycle(combined1, 1, userdata);
+				combined1_ready = constant_combine1;
+			}
+
+			userdata->m_pixel_color.set(combined1);
 
 			//Alpha coverage combiner
 			userdata->m_pixel_color.set_a(get_alpha_cvg(userdata->m_pixel_color.get_a(), userdata, object));
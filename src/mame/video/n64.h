@@ -264,6 +264,9 @@ public:
 	void        cmd_set_color_image(uint64_t w1);
 
 	void        rgbaz_clip(int32_t sr, int32_t sg, int32_t sb, int32_t sa, int32_t* sz, rdp_span_aux* userdata);
+	bool        color_input_is_constant(const color_t* input, const rdp_span_aux* userdata) const;
+	bool        combiner_is_constant(int32_t cycle, const rdp_span_aux* userdata) const;
+	void        combine_cycle(rgbaint_t& out, int32_t cycle, rdp_span_aux* userdata);
 	void        rgbaz_correct_triangle(int32_t offx, int32_t offy, int32_t* r, int32_t* g, int32_t* b, int32_t* a, int32_t* z, rdp_span_aux* userdata, const rdp_poly_state &object);
 
 	void        triangle(bool shade, bool texture, bool zbuffer);
@@ -26,6 +26,8 @@ void namcos22_renderer::init()
 
 
 // poly scanline callbacks
+// Super and ZFog are fixed per quad, so each combination gets its own inner loop
+template <bool Super, bool ZFog>
 void namcos22_renderer::renderscanline_uvi_full(int32_t scanline, const extent_t &extent, const namcos22_object_data &extra, int threadid)
 {
 	float z = extent.param[0].start;
@@ -41,10 +43,9 @@ void namcos22_renderer::renderscanline_uvi_full(int32_t scanline, const extent_t
 	const u8 *czram = extra.czram;
 	int cz_adjust = extra.cz_adjust;
 	int cz_sdelta = extra.cz_sdelta;
-	int zfog_enabled = extra.zfog_enabled;
 	int fogfactor = 0xff - extra.fogfactor;
 	int fadefactor = 0xff - extra.fadefactor;
-	int alphafactor = 0xff - m_state.m_poly_translucency;
+	int alphafactor = 0xff - extra.alpha;
 	rgbaint_t fogcolor = extra.fogcolor;
 	rgbaint_t fadecolor = extra.fadecolor;
 	rgbaint_t polycolor = extra.polycolor;
@@ -75,7 +76,7 @@ void namcos22_renderer::renderscanline_uvi_full(int32_t scanline, const extent_t
 	// slight differences between super and non-super, do the branch here for optimization
 	// normal: no alpha, shading after fog, global fader
 	// super:  2 faders, alpha, shading before fog
-	if (m_state.m_is_ss22)
+	if (Super)
 	{
 		for (int x = extent.startx; x < extent.stopx; x++)
 		{
@@ -93,7 +94,7 @@ void namcos22_renderer::renderscanline_uvi_full(int32_t scanline, const extent_t
 			rgb.scale_imm_and_clamp(shade << 2);
 
 			// per-z distance fogging
-			if (zfog_enabled)
+			if (ZFog)
 			{
 				int cz = ooz + cz_adjust;
 				// discard low byte and clamp to 0-1fff
@@ -149,7 +150,7 @@ void namcos22_renderer::renderscanline_uvi_full(int32_t scanline, const extent_t
 			rgbaint_t rgb(pens[pen >> penshift & penmask]);
 
 			// per-z distance fogging
-			if (zfog_enabled)
+			if (ZFog)
 			{
 				int cz = ooz + cz_adjust;
 				// discard low byte and clamp to 0-1fff
@@ -303,6 +304,7 @@ void namcos22_renderer::poly3d_drawquad(screen_device &screen, bitmap_rgb32 &bit
 	extra.zfog_enabled = 0;
 	extra.fadefactor = 0;
 	extra.fogfactor = 0;
+	extra.alpha = m_state.m_poly_translucency;
 
 	extra.pens = &m_state.m_palette->pen((color & 0x7f) << 8);
 	extra.primap = &screen.priority();
@@ -390,7 +392,12 @@ void namcos22_renderer::poly3d_drawquad(screen_device &screen, bitmap_rgb32 &bit
 		}
 	}
 
-	render_triangle_fan(m_cliprect, render_delegate(&namcos22_renderer::renderscanline_uvi_full, this), 4, clipverts, clipv);
+	render_delegate callback;
+	if (m_state.m_is_ss22)
+		callback = extra.zfog_enabled ? render_delegate(&namcos22_renderer::renderscanline_uvi_full<true, true>, this) : render_delegate(&namcos22_renderer::renderscanline_uvi_full<true, false>, this);
+	else
+		callback = extra.zfog_enabled ? render_delegate(&namcos22_renderer::renderscanline_uvi_full<false, true>, this) : render_delegate(&namcos22_renderer::renderscanline_uvi_full<false, false>, this);
+	render_triangle_fan(m_cliprect, callback, 4, clipverts, clipv);
 }
 
 
@@ -161,12 +161,10 @@ uint32_t neogeo_base_state::screen_update(screen_device &screen, bitmap_rgb32 &b
 	// fill with background color first
 	bitmap.fill(*m_bg_pen, cliprect);
 
+	m_sprgen->draw_sprite_lines(bitmap, cliprect);
+
 	for (int line = cliprect.min_y; line <= cliprect.max_y ; line++)
-	{
-		m_sprgen->parse_sprites(line);
-		m_sprgen->draw_sprites(bitmap, line);
 		m_sprgen->draw_fixed_layer(bitmap, line);
-	}
 
 	return 0;
 }
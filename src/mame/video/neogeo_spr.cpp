@@ -271,7 +271,6 @@ inline void neosprite_base_device::draw_fixed_layer_2pixels(uint32_t*&pixel_addr
  *
  *************************************/
 
-#define MAX_SPRITES_PER_SCREEN    (381)
 #define MAX_SPRITES_PER_LINE      (192)
 
 
@@ -296,6 +295,27 @@ static const int zoom_x_tables[][16] =
 	{ 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1 }
 };
 
+/* the same tables as the source pixels drawn, in order - zoom level n draws n + 1 of them */
+static const uint8_t zoom_x_steps[][16] =
+{
+	{ 8 },
+	{ 4,8 },
+	{ 4,8,12 },
+	{ 2,4,8,12 },
+	{ 2,4,8,12,14 },
+	{ 2,4,6,8,12,14 },
+	{ 2,4,6,8,10,12,14 },
+	{ 0,2,4,6,8,10,12,14 },
+	{ 0,2,4,6,8,9,10,12,14 },
+	{ 0,2,3,4,6,8,9,10,12,14 },
+	{ 0,2,3,4,6,8,9,10,12,14,15 },
+	{ 0,2,3,4,6,7,8,9,10,12,14,15 },
+	{ 0,2,3,4,6,7,8,9,10,12,13,14,15 },
+	{ 0,1,2,3,4,6,7,8,9,10,12,13,14,15 },
+	{ 0,1,2,3,4,6,7,8,9,10,11,12,13,14,15 },
+	{ 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 }
+};
+
 
 
 inline bool neosprite_base_device::sprite_on_scanline(int scanline, int y, int rows)
@@ -446,22 +466,7 @@ void neosprite_base_device::draw_sprites(bitmap_rgb32 &bitmap, int scanline)
 			/* draw the line - no wrap-around */
 			if (x <= 0x01f0)
 			{
-				int i;
-
-				uint32_t *pixel_addr = &bitmap.pix32(scanline, x + NEOGEO_HBEND);
-
-				for (i = 0; i < 0x10; i++)
-				{
-					if (*zoom_x_table)
-					{
-						draw_pixel(gfx_base, pixel_addr, line_pens);
-
-						pixel_addr++;
-					}
-
-					zoom_x_table++;
-					gfx_base += x_inc;
-				}
+				draw_sprite_line(gfx_base, x_inc, zoom_x, &bitmap.pix32(scanline, x + NEOGEO_HBEND), line_pens);
 			}
 			/* wrap-around */
 			else
@@ -496,11 +501,70 @@ void neosprite_base_device::draw_sprites(bitmap_rgb32 &bitmap, int scanline)
 }
 
 
-void neosprite_base_device::parse_sprites(int scanline)
+void neosprite_base_device::draw_sprite_line(int gfx_base, int x_inc, int zoom_x, uint32_t *pixel_addr, const pen_t *line_pens)
+{
+	const int *zoom_x_table = zoom_x_tables[zoom_x];
+
+	for (int i = 0; i < 0x10; i++)
+	{
+		if (*zoom_x_table)
+		{
+			draw_pixel(gfx_base, pixel_addr, line_pens);
+
+			pixel_addr++;
+		}
+
+		zoom_x_table++;
+		gfx_base += x_inc;
+	}
+}
+
+
+void neosprite_base_device::draw_sprite_lines(bitmap_rgb32 &bitmap, const rectangle &cliprect)
+{
+	/* sprite RAM can only change between updates, so the chained positions are worked out once for all the lines */
+	cache_sprite_positions();
+
+	for (int line = cliprect.min_y; line <= cliprect.max_y; line++)
+	{
+		parse_cached_sprites(line);
+		draw_sprites(bitmap, line);
+	}
+}
+
+
+void neosprite_base_device::cache_sprite_positions()
 {
-	uint16_t sprite_number;
 	int y = 0;
 	int rows = 0;
+
+	for (int sprite_number = 0; sprite_number < MAX_SPRITES_PER_SCREEN; sprite_number++)
+	{
+		uint16_t y_control = m_videoram_drawsource[0x8200 | sprite_number];
+
+		/* if not chained, get Y position and height, otherwise use previous values */
+		if (~y_control & 0x40)
+		{
+			y = 0x200 - (y_control >> 7);
+			rows = y_control & 0x3f;
+		}
+
+		m_sprite_y[sprite_number] = y;
+		m_sprite_rows[sprite_number] = rows;
+	}
+}
+
+
+void neosprite_base_device::parse_sprites(int scanline)
+{
+	cache_sprite_positions();
+	parse_cached_sprites(scanline);
+}
+
+
+void neosprite_base_device::parse_cached_sprites(int scanline)
+{
+	uint16_t sprite_number;
 	uint16_t *sprite_list;
 
 	int active_sprite_count = 0;
@@ -514,20 +578,13 @@ void neosprite_base_device::parse_sprites(int scanline)
 	/* scan all sprites */
 	for (sprite_number = 0; sprite_number < MAX_SPRITES_PER_SCREEN; sprite_number++)
 	{
-		uint16_t y_control = m_videoram_drawsource[0x8200 | sprite_number];
-
-		/* if not chained, get Y position and height, otherwise use previous values */
-		if (~y_control & 0x40)
-		{
-			y = 0x200 - (y_control >> 7);
-			rows = y_control & 0x3f;
-		}
+		int rows = m_sprite_rows[sprite_number];
 
 		/* skip sprites with 0 rows */
 		if (rows == 0)
 			continue;
 
-		if (!sprite_on_scanline(scanline, y, rows))
+		if (!sprite_on_scanline(scanline, m_sprite_y[sprite_number], rows))
 			continue;
 
 		/* sprite is on this scanline, add it to active list */
@@ -767,6 +824,32 @@ inline void neosprite_optimized_device::draw_pixel(int romaddr, uint32_t* dst, c
 		*dst = line_pens[gfx];
 }
 
+void neosprite_optimized_device::draw_sprite_line(int gfx_base, int x_inc, int zoom_x, uint32_t *pixel_addr, const pen_t *line_pens)
+{
+	const uint8_t *src = &m_spritegfx8[gfx_base];
+	const uint8_t *steps = zoom_x_steps[zoom_x];
+
+	/* the pixels are already decoded to a byte each, so only the dropped columns need skipping */
+	if (x_inc > 0)
+	{
+		for (int i = 0; i <= zoom_x; i++)
+		{
+			const uint8_t gfx = src[steps[i]];
+			if (gfx)
+				pixel_addr[i] = line_pens[gfx];
+		}
+	}
+	else
+	{
+		for (int i = 0; i <= zoom_x; i++)
+		{
+			const uint8_t gfx = src[-steps[i]];
+			if (gfx)
+				pixel_addr[i] = line_pens[gfx];
+		}
+	}
+}
+
 
 /*********************************************************************************************************************************/
 /* MIDAS specific sprite handling                                                                                                */
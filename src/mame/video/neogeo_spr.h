@@ -42,7 +42,9 @@ public:
 	void neogeo_set_fixed_layer_source(uint8_t data);
 	inline bool sprite_on_scanline(int scanline, int y, int rows);
 	virtual void draw_pixel(int romaddr, uint32_t* dst, const pen_t *line_pens) = 0;
+	virtual void draw_sprite_line(int gfx_base, int x_inc, int zoom_x, uint32_t *pixel_addr, const pen_t *line_pens);
 	void draw_sprites(bitmap_rgb32 &bitmap, int scanline);
+	void draw_sprite_lines(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 	void parse_sprites(int scanline);
 	void create_sprite_line_timer();
 	void start_sprite_line_timer();
@@ -82,6 +84,8 @@ public:
 	int m_bppshift; // 4 for 4bpp gfx (NeoGeo) 8 for 8bpp gfx (Midas)
 
 protected:
+	static constexpr int MAX_SPRITES_PER_SCREEN = 381;
+
 	neosprite_base_device(
 			const machine_config &mconfig,
 			device_type type,
@@ -92,11 +96,16 @@ protected:
 	virtual void device_start() override;
 	virtual void device_reset() override;
 	uint32_t get_region_mask(uint8_t* rgn, uint32_t rgn_size);
+	void cache_sprite_positions();
+	void parse_cached_sprites(int scanline);
 	uint8_t* m_region_sprites; uint32_t m_region_sprites_size;
 	uint8_t* m_region_fixed; uint32_t m_region_fixed_size;
 	memory_region* m_region_fixedbios;
 	screen_device* m_screen;
 	const pen_t   *m_pens;
+
+	int16_t m_sprite_y[MAX_SPRITES_PER_SCREEN];     // resolved Y position of each sprite, chains included
+	uint8_t m_sprite_rows[MAX_SPRITES_PER_SCREEN];  // resolved height of each sprite
 };
 
 
@@ -119,6 +128,7 @@ public:
 	virtual void optimize_sprite_data() override;
 	virtual void set_optimized_sprite_data(uint8_t* sprdata, uint32_t mask) override;
 	virtual void draw_pixel(int romaddr, uint32_t* dst, const pen_t *line_pens) override;
+	virtual void draw_sprite_line(int gfx_base, int x_inc, int zoom_x, uint32_t *pixel_addr, const pen_t *line_pens) override;
 	std::vector<uint8_t> m_sprite_gfx;
 	uint8_t* m_spritegfx8;
 
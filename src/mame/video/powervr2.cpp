@@ -1005,7 +1005,7 @@ WRITE32_MEMBER( powervr2_device::startrender_w )
 			rectangle clip(0, 1023, 0, 1023);
 
 			// we've got a request to draw, so, draw to the accumulation buffer!
-			// this should really be done for each tile!
+			// this is done a row of tiles at a time on the worker threads, and is finished before the copy below
 			render_to_accumulation_buffer(*fake_accumulationbuffer_bitmap,clip);
 
 			/* copy the tiles to the framebuffer (really the rendering should be in this loop too) */
@@ -2362,7 +2362,7 @@ inline uint32_t powervr2_device::sample_textured(texinfo *ti, float u, float v,
 }
 
 template <powervr2_device::pix_sample_fn sample_fn, int group_no>
-inline void powervr2_device::render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int y, float xl, float xr, float ul, float ur, float vl, float vr, float wl, float wr, float const bl_in[4], float const br_in[4], float const offl_in[4], float const offr_in[4])
+inline void powervr2_device::render_hline(bitmap_rgb32 &bitmap, const rectangle &clip, texinfo *ti, int y, float xl, float xr, float ul, float ur, float vl, float vr, float wl, float wr, float const bl_in[4], float const br_in[4], float const offl_in[4], float const offr_in[4])
 {
 	int idx;
 	int xxl, xxr;
@@ -2372,7 +2372,7 @@ inline void powervr2_device::render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int
 
 	float bl[4], offl[4];
 
-	if(xr < 0 || xl >= 640)
+	if(xr < clip.min_x || xl >= clip.max_x + 1)
 		return;
 
 	xxl = round(xl);
@@ -2405,10 +2405,10 @@ inline void powervr2_device::render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int
 		(offr_in[3] - offl[3]) * dx_recip
 	};
 
-	if(xxl < 0)
-		xxl = 0;
-	if(xxr > 640)
-		xxr = 640;
+	if(xxl < clip.min_x)
+		xxl = clip.min_x;
+	if(xxr > clip.max_x + 1)
+		xxr = clip.max_x + 1;
 
 	// Target the pixel center
 	ddx = xxl + 0.5f - xl;
@@ -2456,7 +2456,7 @@ inline void powervr2_device::render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int
 }
 
 template <powervr2_device::pix_sample_fn sample_fn, int group_no>
-inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
+inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, const rectangle &clip, texinfo *ti,
 									float y0, float y1,
 									float xl, float xr,
 									float ul, float ur,
@@ -2475,10 +2475,10 @@ inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
 	float dy;
 	int yy0, yy1;
 
-	if(y1 <= 0)
+	if(y1 <= clip.min_y)
 		return;
-	if(y1 > 480)
-		y1 = 480;
+	if(y1 > clip.max_y + 1)
+		y1 = clip.max_y + 1;
 
 	float bl[4], br[4], offl[4], offr[4];
 	memcpy(bl, bl_in, sizeof(bl));
@@ -2533,8 +2533,11 @@ inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
 		offr[idx] += dy * dordy[idx];
 	}
 
+	// lines above the clip are still stepped through from the top of
+	// the span, so every band interpolates exactly as a full frame would
 	while(yy0 < yy1) {
-		render_hline<sample_fn, group_no>(bitmap, ti, yy0, xl, xr, ul, ur, vl, vr, wl, wr, bl, br, offl, offr);
+		if(yy0 >= clip.min_y)
+			render_hline<sample_fn, group_no>(bitmap, clip, ti, yy0, xl, xr, ul, ur, vl, vr, wl, wr, bl, br, offl, offr);
 
 		xl += dxldy;
 		xr += dxrdy;
@@ -2587,13 +2590,13 @@ void powervr2_device::sort_vertices(const vert *v, int *i0, int *i1, int *i2)
 
 
 template <powervr2_device::pix_sample_fn sample_fn, int group_no>
-inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v0, const vert *v1, const vert *v2)
+inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, const rectangle &clip, texinfo *ti, const vert *v0, const vert *v1, const vert *v2)
 {
 	float dy01, dy02, dy12;
 
 	float dx01dy, dx02dy, dx12dy, du01dy, du02dy, du12dy, dv01dy, dv02dy, dv12dy, dw01dy, dw02dy, dw12dy;
 
-	if(v0->y >= 480 || v2->y < 0)
+	if(v0->y >= clip.max_y + 1 || v2->y < clip.min_y)
 		return;
 
 	float db01[4] = {
@@ -2705,15 +2708,15 @@ inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti
 			return;
 
 		if(v1->x > v0->x)
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, v0->b, v1->b, v0->o, v1->o, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy);
+			render_span<sample_fn, group_no>(bitmap, clip, ti, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, v0->b, v1->b, v0->o, v1->o, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy);
 		else
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, v1->b, v0->b, v1->o, v0->o, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy);
+			render_span<sample_fn, group_no>(bitmap, clip, ti, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, v1->b, v0->b, v1->o, v0->o, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy);
 
 	} else if(!dy12) {
 		if(v2->x > v1->x)
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy);
+			render_span<sample_fn, group_no>(bitmap, clip, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy);
 		else
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy);
+			render_span<sample_fn, group_no>(bitmap, clip, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy);
 
 	} else {
 			float idk_b[4] = {
@@ -2729,17 +2732,17 @@ inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti
 				v0->o[3] + do02dy[3] * dy01
 			};
 		if(dx01dy < dx02dy) {
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y,
+			render_span<sample_fn, group_no>(bitmap, clip, ti, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o,
 						dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy);
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y,
+			render_span<sample_fn, group_no>(bitmap, clip, ti, v1->y, v2->y,
 						v1->x, v0->x + dx02dy*dy01, v1->u, v0->u + du02dy*dy01, v1->v, v0->v + dv02dy*dy01, v1->w, v0->w + dw02dy*dy01, v1->b, idk_b, v1->o, idk_o,
 						dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy);
 		} else {
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y,
+			render_span<sample_fn, group_no>(bitmap, clip, ti, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o,
 						dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy);
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y,
+			render_span<sample_fn, group_no>(bitmap, clip, ti, v1->y, v2->y,
 						v0->x + dx02dy*dy01, v1->x, v0->u + du02dy*dy01, v1->u, v0->v + dv02dy*dy01, v1->v, v0->w + dw02dy*dy01, v1->w, idk_b, v1->b, idk_o, v1->o,
 						dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy);
 		}
@@ -2747,7 +2750,7 @@ inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti
 }
 
 template <int group_no>
-void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v)
+void powervr2_device::render_tri(bitmap_rgb32 &bitmap, const rectangle &clip, texinfo *ti, const vert *v)
 {
 	int i0, i1, i2;
 
@@ -2760,16 +2763,16 @@ void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *
 		if (bilinear) {
 			switch (ti->tsinstruction) {
 			case 0:
-				render_tri_sorted<&powervr2_device::sample_textured<0,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<0,true>, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 				break;
 			case 1:
-				render_tri_sorted<&powervr2_device::sample_textured<1,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<1,true>, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 				break;
 			case 2:
-				render_tri_sorted<&powervr2_device::sample_textured<2,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<2,true>, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 				break;
 			case 3:
-				render_tri_sorted<&powervr2_device::sample_textured<3,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<3,true>, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 				break;
 			default:
 				/*
@@ -2777,21 +2780,21 @@ void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *
 				 * AND'd with 3
 				 */
 				logerror("%s - tsinstruction is 0x%08x\n", (unsigned)ti->tsinstruction);
-				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 			}
 		} else {
 			switch (ti->tsinstruction) {
 			case 0:
-				render_tri_sorted<&powervr2_device::sample_textured<0,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<0,false>, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 				break;
 			case 1:
-				render_tri_sorted<&powervr2_device::sample_textured<1,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<1,false>, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 				break;
 			case 2:
-				render_tri_sorted<&powervr2_device::sample_textured<2,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<2,false>, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 				break;
 			case 3:
-				render_tri_sorted<&powervr2_device::sample_textured<3,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<3,false>, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 				break;
 			default:
 				/*
@@ -2799,11 +2802,11 @@ void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *
 				 * AND'd with 3
 				 */
 				logerror("%s - tsinstruction is 0x%08x\n", (unsigned)ti->tsinstruction);
-				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 			}
 		}
 	} else {
-			render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+			render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, clip, ti, v+i0, v+i1, v+i2);
 	}
 }
 
@@ -2837,37 +2840,97 @@ void powervr2_device::render_group_to_accumulation_buffer(bitmap_rgb32 &bitmap,c
 		if(ev == -1)
 			continue;
 
-		for(i=sv; i <= ev; i++)
+		for(i=sv; i <= ev-2; i++)
+		{
+			if (!(debug_dip_status&0x2))
+				render_tri<group_no>(bitmap, cliprect, &ts->ti, grab[rs].verts + i);
+
+		}
+	}
+}
+
+// scales the texture coordinates of a group by the texture size and w, once before any band is drawn
+template <int group_no>
+void powervr2_device::setup_group_for_render()
+{
+	int rs=renderselect;
+
+	struct poly_group *grp = grab[rs].groups + group_no;
+
+	int ns=grp->strips_size;
+
+	for (int cs=0;cs < ns;cs++)
+	{
+		strip *ts = &grp->strips[cs];
+		int sv = ts->svert;
+		int ev = ts->evert;
+		if(ev == -1)
+			continue;
+
+		for(int i=sv; i <= ev; i++)
 		{
 			vert *tv = grab[rs].verts + i;
 			tv->u = tv->u * ts->ti.sizex * tv->w;
 			tv->v = tv->v * ts->ti.sizey * tv->w;
 		}
+	}
+}
 
-		for(i=sv; i <= ev-2; i++)
-		{
-			if (!(debug_dip_status&0x2))
-				render_tri<group_no>(bitmap, &ts->ti, grab[rs].verts + i);
+// clears and draws one band of the accumulation buffer; bands don't share any pixels, so they can be drawn in any order
+void powervr2_device::render_band_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect)
+{
+	bitmap.fill(render_bgcolor, cliprect);
 
-		}
-	}
+	rectangle clip(0, 639, 0, 479);
+	clip &= cliprect;
+	if (clip.empty())
+		return;
+
+	for (int y = clip.min_y; y <= clip.max_y; y++)
+		memset(&wbuffer[y][clip.min_x], 0x00, clip.width() * sizeof(wbuffer[0][0]));
+
+	// TODO: modifier volumes
+	render_group_to_accumulation_buffer<DISPLAY_LIST_OPAQUE>(bitmap, clip);
+	render_group_to_accumulation_buffer<DISPLAY_LIST_TRANS>(bitmap, clip);
+	render_group_to_accumulation_buffer<DISPLAY_LIST_PUNCH_THROUGH>(bitmap, clip);
+}
+
+void *powervr2_device::render_band_callback(void *param, int threadid)
+{
+	render_band *band = (render_band *)param;
+	band->pvr->render_band_to_accumulation_buffer(*band->bitmap, band->clip);
+	return nullptr;
 }
 
 void powervr2_device::render_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect) {
 	if (renderselect < 0)
 		return;
 
-	memset(wbuffer, 0x00, sizeof(wbuffer));
-
 	dc_state *state = machine().driver_data<dc_state>();
 	address_space &space = state->m_maincpu->space(AS_PROGRAM);
-	uint32_t c=space.read_dword(0x05000000+((isp_backgnd_t & 0xfffff8)>>1)+(3+3)*4);
-	bitmap.fill(c, cliprect);
+	render_bgcolor=space.read_dword(0x05000000+((isp_backgnd_t & 0xfffff8)>>1)+(3+3)*4);
 
-	// TODO: modifier volumes
-	render_group_to_accumulation_buffer<DISPLAY_LIST_OPAQUE>(bitmap, cliprect);
-	render_group_to_accumulation_buffer<DISPLAY_LIST_TRANS>(bitmap, cliprect);
-	render_group_to_accumulation_buffer<DISPLAY_LIST_PUNCH_THROUGH>(bitmap, cliprect);
+	setup_group_for_render<DISPLAY_LIST_OPAQUE>();
+	setup_group_for_render<DISPLAY_LIST_TRANS>();
+	setup_group_for_render<DISPLAY_LIST_PUNCH_THROUGH>();
+
+	// split the frame into rows of 32x32 tiles and draw them on the worker threads
+	render_bands.resize((cliprect.height() + RENDER_BAND_HEIGHT - 1) / RENDER_BAND_HEIGHT);
+	for (int b = 0; b < int(render_bands.size()); b++)
+	{
+		render_band &band = render_bands[b];
+		band.pvr = this;
+		band.bitmap = &bitmap;
+		band.clip.set(cliprect.min_x, cliprect.max_x, cliprect.min_y + b * RENDER_BAND_HEIGHT, std::min(cliprect.min_y + (b + 1) * RENDER_BAND_HEIGHT - 1, cliprect.max_y));
+		if (render_queue != nullptr)
+			osd_work_item_queue(render_queue, render_band_callback, &band, WORK_ITEM_FLAG_AUTO_RELEASE);
+		else
+			render_band_to_accumulation_buffer(bitmap, band.clip);
+	}
+
+	// the framebuffer copy that follows needs every tile finished
+	if (render_queue != nullptr)
+		osd_work_queue_wait(render_queue, osd_ticks_per_second() * 100);
 
 	grab[renderselect].busy=0;
 }
@@ -4028,6 +4091,8 @@ void powervr2_device::device_start()
 	endofrender_timer_video = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(powervr2_device::endofrender_video),this));
 
 	fake_accumulationbuffer_bitmap = std::make_unique<bitmap_rgb32>(2048,2048);
+	render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	render_bgcolor = 0;
 
 	softreset = 0;
 	param_base = 0;
@@ -4144,6 +4209,13 @@ void powervr2_device::device_start()
 	save_item(NAME(next_y));
 }
 
+void powervr2_device::device_stop()
+{
+	if (render_queue != nullptr)
+		osd_work_queue_free(render_queue);
+	render_queue = nullptr;
+}
+
 void powervr2_device::device_reset()
 {
 	softreset =                 0x00000007;
@@ -55,6 +55,17 @@ public:
 	//  our implementation is not currently tile based, and thus the accumulation buffer is screen sized
 	std::unique_ptr<bitmap_rgb32> fake_accumulationbuffer_bitmap;
 
+	// the accumulation buffer is drawn in rows of 32x32 tiles spread over the worker threads
+	enum { RENDER_BAND_HEIGHT = 32 };
+	struct render_band {
+		powervr2_device *pvr;
+		bitmap_rgb32 *bitmap;
+		rectangle clip;
+	};
+	osd_work_queue *render_queue;
+	std::vector<render_band> render_bands;
+	uint32_t render_bgcolor;
+
 	/*
 	 * Per-polygon base and offset colors.  These are scaled by per-vertex
 	 * weights.
@@ -342,6 +353,7 @@ public:
 
 protected:
 	virtual void device_start() override;
+	virtual void device_stop() override;
 	virtual void device_reset() override;
 
 private:
@@ -498,7 +510,7 @@ private:
 	void tex_get_info(texinfo *t);
 
 	template <pix_sample_fn sample_fn, int group_no>
-		inline void render_hline(bitmap_rgb32 &bitmap, texinfo *ti,
+		inline void render_hline(bitmap_rgb32 &bitmap, const rectangle &clip, texinfo *ti,
 									int y, float xl, float xr,
 									float ul, float ur, float vl, float vr,
 									float wl, float wr,
@@ -506,7 +518,7 @@ private:
 									float const offl[4], float const offr[4]);
 
 	template <pix_sample_fn sample_fn, int group_no>
-		inline void render_span(bitmap_rgb32 &bitmap, texinfo *ti,
+		inline void render_span(bitmap_rgb32 &bitmap, const rectangle &clip, texinfo *ti,
 								float y0, float y1,
 								float xl, float xr,
 								float ul, float ur,
@@ -522,16 +534,22 @@ private:
 								float const doldy[4], float const dordy[4]);
 
 	template <pix_sample_fn sample_fn, int group_no>
-		inline void render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti,
+		inline void render_tri_sorted(bitmap_rgb32 &bitmap, const rectangle &clip, texinfo *ti,
 										const vert *v0,
 										const vert *v1, const vert *v2);
 
 	template <int group_no>
-		void render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v);
+		void render_tri(bitmap_rgb32 &bitmap, const rectangle &clip, texinfo *ti, const vert *v);
 
 	template <int group_no>
 		void render_group_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 
+	template <int group_no>
+		void setup_group_for_render();
+
+	void render_band_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect);
+	static void *render_band_callback(void *param, int threadid);
+
 	void sort_vertices(const vert *v, int *i0, int *i1, int *i2);
 	void render_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 	void pvr_accumulationbuffer_to_framebuffer(address_space &space, int x, int y);
@@ -670,6 +670,22 @@ int vertex_program_simulator::status()
 	return ip;
 }
 
+bool vertex_program_simulator::writes_constants(int address)
+{
+	for (int a = address; a < 256; a++) {
+		instruction::decoded *d = &op[a].d;
+
+		// a partly uploaded instruction is decoded again at every step, assume the worst
+		if (op[a].modified)
+			return true;
+		if ((d->VecOperation > 0) && (d->VecOperation != VecARL) && (d->OutputWriteMask != 0) && (d->MultiplexerControl == 0) && !d->OutputSelect)
+			return true;
+		if (d->EndOfProgram)
+			return false;
+	}
+	return true;
+}
+
 void vertex_program_simulator::initialize_outputs()
 {
 	for (int n = 0; n < 16; n++) {
@@ -1955,12 +1971,12 @@ void nv2a_renderer::render_color(int32_t scanline, const extent_t &extent, const
 		int ca, cr, cg, cb;
 		int xp = extent.startx + x; // x coordinate of current pixel
 
-		cb = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_B].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_B].dpdx))*255.0f;
-		cg = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_G].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_G].dpdx))*255.0f;
-		cr = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_R].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_R].dpdx))*255.0f;
-		ca = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_A].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_A].dpdx))*255.0f;
+		cb = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_B].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_B].dpdx))*255.0f;
+		cg = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_G].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_G].dpdx))*255.0f;
+		cr = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_R].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_R].dpdx))*255.0f;
+		ca = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_A].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_A].dpdx))*255.0f;
 		a8r8g8b8 = (ca << 24) + (cr << 16) + (cg << 8) + cb; // pixel color obtained by interpolating the colors of the vertices
-		z = (extent.param[(int)VERTEX_PARAMETER::PARAM_Z].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_Z].dpdx);
+		z = (extent.param[(int)VERTEX_PARAMETER::PARAM_Z].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_Z].dpdx);
 		write_pixel(xp, scanline, a8r8g8b8, z);
 		x--;
 	}
@@ -1989,15 +2005,15 @@ void nv2a_renderer::render_texture_simple(int32_t scanline, const extent_t &exte
 		int xp = extent.startx + x; // x coordinate of current pixel
 
 		if (objectdata.data->texture[0].rectangle == false) {
-			up = (extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U].dpdx)*(double)(objectdata.data->texture[0].sizeu - 1); // x coordinate of texel in texture
-			vp = (extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V].dpdx)*(double)(objectdata.data->texture[0].sizev - 1); // y coordinate of texel in texture
+			up = (extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U].dpdx)*(float)(objectdata.data->texture[0].sizeu - 1); // x coordinate of texel in texture
+			vp = (extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V].dpdx)*(float)(objectdata.data->texture[0].sizev - 1); // y coordinate of texel in texture
 		} else
 		{
-			up = extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U].dpdx; // x coordinate of texel in texture
-			vp = extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V].dpdx; // y coordinate of texel in texture
+			up = extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U].dpdx; // x coordinate of texel in texture
+			vp = extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V].dpdx; // y coordinate of texel in texture
 		}
 		a8r8g8b8 = texture_get_texel(0, up, vp);
-		z = (extent.param[(int)VERTEX_PARAMETER::PARAM_Z].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_Z].dpdx);
+		z = (extent.param[(int)VERTEX_PARAMETER::PARAM_Z].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_Z].dpdx);
 		write_pixel(xp, scanline, a8r8g8b8, z);
 		x--;
 	}
@@ -2029,22 +2045,22 @@ void nv2a_renderer::render_register_combiners(int32_t scanline, const extent_t &
 		xp = extent.startx + x;
 		// 1: fetch data
 		// 1.1: interpolated color from vertices
-		cb = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_B].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_B].dpdx))*255.0f;
-		cg = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_G].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_G].dpdx))*255.0f;
-		cr = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_R].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_R].dpdx))*255.0f;
-		ca = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_A].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_A].dpdx))*255.0f;
+		cb = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_B].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_B].dpdx))*255.0f;
+		cg = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_G].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_G].dpdx))*255.0f;
+		cr = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_R].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_R].dpdx))*255.0f;
+		ca = ((extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_A].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_COLOR_A].dpdx))*255.0f;
 		color[0] = (ca << 24) + (cr << 16) + (cg << 8) + cb; // pixel color obtained by interpolating the colors of the vertices
 		color[1] = 0; // lighting not yet
 		// 1.2: color for each of the 4 possible textures
 		for (n = 0; n < 4; n++) {
 			if (texture[n].enabled) {
 				if (texture[n].rectangle == false) {
-					up = (extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U + n * 2].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U + n * 2].dpdx)*(double)(objectdata.data->texture[n].sizeu - 1);
-					vp = (extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V + n * 2].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V + n * 2].dpdx)*(double)(objectdata.data->texture[n].sizev - 1);
+					up = (extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U + n * 2].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U + n * 2].dpdx)*(float)(objectdata.data->texture[n].sizeu - 1);
+					vp = (extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V + n * 2].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V + n * 2].dpdx)*(float)(objectdata.data->texture[n].sizev - 1);
 				} else
 				{
-					up = extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U + n * 2].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U + n * 2].dpdx;
-					vp = extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V + n * 2].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V + n * 2].dpdx;
+					up = extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U + n * 2].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_U + n * 2].dpdx;
+					vp = extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V + n * 2].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_TEXTURE0_V + n * 2].dpdx;
 				}
 				color[n + 2] = texture_get_texel(n, up, vp);
 			}
@@ -2070,7 +2086,7 @@ void nv2a_renderer::render_register_combiners(int32_t scanline, const extent_t &
 		combiner_final_output();
 		a8r8g8b8 = combiner_float_argb8(combiner.output);
 		// 3: write pixel
-		z = (extent.param[(int)VERTEX_PARAMETER::PARAM_Z].start + (double)x*extent.param[(int)VERTEX_PARAMETER::PARAM_Z].dpdx);
+		z = (extent.param[(int)VERTEX_PARAMETER::PARAM_Z].start + (float)x*extent.param[(int)VERTEX_PARAMETER::PARAM_Z].dpdx);
 		write_pixel(xp, scanline, a8r8g8b8, z);
 		x--;
 	}
@@ -2463,9 +2479,56 @@ void nv2a_renderer::compute_supersample_factors(float &horizontal, float &vertic
 	vertical = my;
 }
 
+bool nv2a_renderer::vertex_program_writes_constants()
+{
+	if (vertexprogram.checked_serial != vertexprogram.serial) {
+		vertexprogram.checked_serial = vertexprogram.serial;
+		vertexprogram.writes_constants = vertexprogram.exec.writes_constants(vertexprogram.start_instruction);
+	}
+	return vertexprogram.writes_constants;
+}
+
+void *nv2a_renderer::vertex_batch_callback(void *param, int threadid)
+{
+	vertex_batch *batch = (vertex_batch *)param;
+	nv2a_renderer *renderer = batch->renderer;
+	vertex_worker &worker = renderer->vertex_workers[threadid];
+
+	// each thread runs its own copy of the program, refreshed whenever the program or its constants change
+	if (!worker.exec)
+		worker.exec = std::make_unique<vertex_program_simulator>(renderer->vertexprogram.exec);
+	else if (worker.serial != renderer->vertexprogram.serial)
+		*worker.exec = renderer->vertexprogram.exec;
+	worker.serial = renderer->vertexprogram.serial;
+	worker.exec->process(renderer->vertexprogram.start_instruction, batch->source, batch->destination, batch->count);
+	return nullptr;
+}
+
+void nv2a_renderer::run_vertex_program(vertex_nv *source, vertex_nv *destination, int count)
+{
+	// a program that writes constants makes each vertex depend on the ones before it, so it stays on this thread
+	if ((vertex_queue == nullptr) || (count <= VERTEX_BATCH_SIZE) || vertex_program_writes_constants()) {
+		vertexprogram.exec.process(vertexprogram.start_instruction, source, destination, count);
+		if (vertex_program_writes_constants())
+			vertexprogram.serial++;
+		return;
+	}
+
+	int b = 0;
+	for (int first = 0; first < count; first += VERTEX_BATCH_SIZE) {
+		vertex_batch &batch = vertex_batches[b++];
+		batch.renderer = this;
+		batch.source = source + first;
+		batch.destination = destination + first;
+		batch.count = std::min(count - first, (int)VERTEX_BATCH_SIZE);
+		osd_work_item_queue(vertex_queue, vertex_batch_callback, &batch, WORK_ITEM_FLAG_AUTO_RELEASE);
+	}
+	osd_work_queue_wait(vertex_queue, osd_ticks_per_second() * 100);
+}
+
 void nv2a_renderer::convert_vertices_poly(vertex_nv *source, nv2avertex_t *destination, int count)
 {
-	vertex_nv vert[4];
+	vertex_nv *vert = vertex_processed;
 	int m, u;
 	float v[4];
 
@@ -2495,13 +2558,13 @@ void nv2a_renderer::convert_vertices_poly(vertex_nv *source, nv2avertex_t *desti
 	else {
 		// vertex program
 		// run vertex program
-		vertexprogram.exec.process(vertexprogram.start_instruction, source, vert, count);
+		run_vertex_program(source, vert, count);
 		// the output of the vertex program has the perspective divide, viewport scale and offset already applied
 		// copy data for poly.c
 		for (m = 0; m < count; m++) {
 			destination[m].w = vert[m].attribute[0].fv[3];
-			destination[m].x = (vert[m].attribute[0].fv[0] - 0.53125) * supersample_factor_x;
-			destination[m].y = (vert[m].attribute[0].fv[1] - 0.53125) * supersample_factor_y;
+			destination[m].x = (vert[m].attribute[0].fv[0] - 0.53125f) * supersample_factor_x;
+			destination[m].y = (vert[m].attribute[0].fv[1] - 0.53125f) * supersample_factor_y;
 			for (u = (int)VERTEX_PARAMETER::PARAM_COLOR_B; u <= (int)VERTEX_PARAMETER::PARAM_COLOR_A; u++) // 0=b 1=g 2=r 3=a
 				destination[m].p[u] = vert[m].attribute[3].fv[u];
 			for (u = 0; u < 4; u++) {
@@ -2766,9 +2829,9 @@ int nv2a_renderer::clip_triangle_w(nv2avertex_t *vi[3], nv2avertex_t *vo)
 {
 	int idx_prev, idx_curr;
 	int neg_prev, neg_curr;
-	double tfactor;
+	float tfactor;
 	int idx;
-	const double wthreshold = 0.000001;
+	const float wthreshold = 0.000001f;
 
 	idx_prev = 2;
 	idx_curr = 0;
@@ -2825,8 +2888,8 @@ uint32_t nv2a_renderer::render_triangle_clipping(const rectangle &cliprect, rend
 	{
 		for (int n = 0; n < 3; n++)
 		{
-			vi[n]->x = (vi[n]->x / (double)supersample_factor_x)*vi[n]->w;
-			vi[n]->y = (vi[n]->y / (double)supersample_factor_y)*vi[n]->w;
+			vi[n]->x = (vi[n]->x / supersample_factor_x)*vi[n]->w;
+			vi[n]->y = (vi[n]->y / supersample_factor_y)*vi[n]->w;
 			vi[n]->p[(int)VERTEX_PARAMETER::PARAM_Z] = vi[n]->p[(int)VERTEX_PARAMETER::PARAM_Z] * vi[n]->w;
 		}
 	} else
@@ -2850,8 +2913,8 @@ uint32_t nv2a_renderer::render_triangle_clipping(const rectangle &cliprect, rend
 	{
 		for (int n = 0; n < nv; n++)
 		{
-			vo[n].x = vo[n].x*(double)supersample_factor_x / vo[n].w;
-			vo[n].y = vo[n].y*(double)supersample_factor_y / vo[n].w;
+			vo[n].x = vo[n].x*supersample_factor_x / vo[n].w;
+			vo[n].y = vo[n].y*supersample_factor_y / vo[n].w;
 			vo[n].p[(int)VERTEX_PARAMETER::PARAM_Z] = vo[n].p[(int)VERTEX_PARAMETER::PARAM_Z] / vo[n].w;
 		}
 	} else
@@ -2877,9 +2940,13 @@ void nv2a_renderer::assemble_primitive(vertex_nv *source, int count, render_dele
 {
 	uint32_t pc = primitives_count;
 
+	// transform the whole batch first, nothing below changes the state it depends on
+	convert_vertices_poly(source, vertex_converted, count);
+	nv2avertex_t *converted = vertex_converted;
+
 	for (; count > 0; count--) {
 		if (primitive_type == NV2A_BEGIN_END::QUADS) {
-			convert_vertices_poly(source, vertex_xy + vertex_count + vertex_accumulated, 1);
+			vertex_xy[vertex_count + vertex_accumulated] = *converted;
 			vertex_accumulated++;
 			if (vertex_accumulated == 4) {
 				primitives_count++;
@@ -2891,7 +2958,7 @@ void nv2a_renderer::assemble_primitive(vertex_nv *source, int count, render_dele
 			}
 		}
 		else if (primitive_type == NV2A_BEGIN_END::TRIANGLES) {
-			convert_vertices_poly(source, vertex_xy + vertex_count + vertex_accumulated, 1);
+			vertex_xy[vertex_count + vertex_accumulated] = *converted;
 			vertex_accumulated++;
 			if (vertex_accumulated == 3) {
 				primitives_count++;
@@ -2904,12 +2971,12 @@ void nv2a_renderer::assemble_primitive(vertex_nv *source, int count, render_dele
 		else if (primitive_type == NV2A_BEGIN_END::TRIANGLE_FAN) {
 			if (vertex_accumulated == 0)
 			{
-				convert_vertices_poly(source, vertex_xy + 1024, 1);
+				vertex_xy[1024] = *converted;
 				vertex_accumulated = 1;
 			}
 			else if (vertex_accumulated == 1)
 			{
-				convert_vertices_poly(source, vertex_xy, 1);
+				vertex_xy[0] = *converted;
 				vertex_accumulated = 2;
 				vertex_count = 1;
 			}
@@ -2918,7 +2985,7 @@ void nv2a_renderer::assemble_primitive(vertex_nv *source, int count, render_dele
 				primitives_count++;
 				// if software sends the vertices 0 1 2 3 4 5 6
 				// hardware will draw triangles made by (0,1,2) (0,2,3) (0,3,4) (0,4,5) (0,5,6)
-				convert_vertices_poly(source, vertex_xy + vertex_count, 1);
+				vertex_xy[vertex_count] = *converted;
 				render_triangle_clipping(limits_rendertarget, renderspans, 5 + 4 * 2, vertex_xy[1024], vertex_xy[(vertex_count - 1) & 1023], vertex_xy[vertex_count]);
 				vertex_count = (vertex_count + 1) & 1023;
 				wait();
@@ -2927,12 +2994,12 @@ void nv2a_renderer::assemble_primitive(vertex_nv *source, int count, render_dele
 		else if (primitive_type == NV2A_BEGIN_END::TRIANGLE_STRIP) {
 			if (vertex_accumulated == 0)
 			{
-				convert_vertices_poly(source, vertex_xy, 1);
+				vertex_xy[0] = *converted;
 				vertex_accumulated = 1;
 			}
 			else if (vertex_accumulated == 1)
 			{
-				convert_vertices_poly(source, vertex_xy + 1, 1);
+				vertex_xy[1] = *converted;
 				vertex_accumulated = 2;
 				vertex_count = 2;
 			}
@@ -2941,7 +3008,7 @@ void nv2a_renderer::assemble_primitive(vertex_nv *source, int count, render_dele
 				primitives_count++;
 				// if software sends the vertices 0 1 2 3 4 5 6
 				// hardware will draw triangles made by (0,1,2) (1,3,2) (2,3,4) (3,5,4) (4,5,6)
-				convert_vertices_poly(source, vertex_xy + vertex_count, 1);
+				vertex_xy[vertex_count] = *converted;
 				if ((vertex_count & 1) == 0)
 					render_triangle_clipping(limits_rendertarget, renderspans, 5 + 4 * 2, vertex_xy[(vertex_count - 2) & 1023], vertex_xy[(vertex_count - 1) & 1023], vertex_xy[vertex_count]);
 				else
@@ -2953,18 +3020,18 @@ void nv2a_renderer::assemble_primitive(vertex_nv *source, int count, render_dele
 		else if (primitive_type == NV2A_BEGIN_END::QUAD_STRIP) {
 			if (vertex_accumulated == 0)
 			{
-				convert_vertices_poly(source, vertex_xy, 1);
+				vertex_xy[0] = *converted;
 				vertex_accumulated = 1;
 			}
 			else if (vertex_accumulated == 1)
 			{
-				convert_vertices_poly(source, vertex_xy + 1, 1);
+				vertex_xy[1] = *converted;
 				vertex_accumulated = 2;
 				vertex_count = 0;
 			}
 			else
 			{
-				convert_vertices_poly(source, vertex_xy + ((vertex_count + vertex_accumulated) & 1023), 1);
+				vertex_xy[(vertex_count + vertex_accumulated) & 1023] = *converted;
 				vertex_accumulated++;
 				if (vertex_accumulated == 4)
 				{
@@ -2983,7 +3050,7 @@ void nv2a_renderer::assemble_primitive(vertex_nv *source, int count, render_dele
 				machine().logerror("Unsupported primitive %d\n", int(primitive_type));
 			vertex_count++;
 		}
-		source++;
+		converted++;
 	}
 	primitives_total_count += primitives_count - pc;
 }
@@ -3069,10 +3136,13 @@ int nv2a_renderer::geforce_exec_method(address_space & space, uint32_t chanel, u
 #ifdef LOG_NV2A
 		printf("vertex %d %d\n\r", offset, count);
 #endif
-		for (n = 0; n <= count; n++) {
-			read_vertices_0x1810(space, vertex_software + vertex_first, n + offset, 1);
-			assemble_primitive(vertex_software + vertex_first, 1, render_spans_callback);
-			vertex_first = (vertex_first + 1) & 1023;
+		// read and assemble as many at once as fit before the end of the vertex buffer
+		for (n = 0; n <= count; ) {
+			int batch = std::min<int>(count + 1 - n, 1024 - vertex_first);
+			read_vertices_0x1810(space, vertex_software + vertex_first, n + offset, batch);
+			assemble_primitive(vertex_software + vertex_first, batch, render_spans_callback);
+			vertex_first = (vertex_first + batch) & 1023;
+			n += batch;
 		}
 		countlen--;
 	}
@@ -3665,6 +3735,7 @@ int nv2a_renderer::geforce_exec_method(address_space & space, uint32_t chanel, u
 		*(uint32_t *)(&matrix.translate[maddress]) = data;
 		// set corresponding vertex shader constant too
 		vertexprogram.exec.c_constant[59].iv(maddress, data); // constant -37
+		vertexprogram.serial++;
 #ifdef LOG_NV2A
 		if (maddress == 3)
 			machine().logerror("viewport translate = {%f %f %f %f}\n", matrix.translate[0], matrix.translate[1], matrix.translate[2], matrix.translate[3]);
@@ -3677,6 +3748,7 @@ int nv2a_renderer::geforce_exec_method(address_space & space, uint32_t chanel, u
 		*(uint32_t *)(&matrix.scale[maddress]) = data;
 		// set corresponding vertex shader constant too
 		vertexprogram.exec.c_constant[58].iv(maddress, data); // constant -38
+		vertexprogram.serial++;
 #ifdef LOG_NV2A
 		if (maddress == 3)
 			machine().logerror("viewport scale = {%f %f %f %f}\n", matrix.scale[0], matrix.scale[1], matrix.scale[2], matrix.scale[3]);
@@ -3706,6 +3778,7 @@ int nv2a_renderer::geforce_exec_method(address_space & space, uint32_t chanel, u
 		//machine().logerror("VP_START_FROM_ID %d\n",data);
 		vertexprogram.instructions = vertexprogram.upload_instruction_index;
 		vertexprogram.start_instruction = data;
+		vertexprogram.serial++;
 		countlen--;
 	}
 	if (maddress == 0x1ea4) {
@@ -3719,6 +3792,7 @@ int nv2a_renderer::geforce_exec_method(address_space & space, uint32_t chanel, u
 		if (vertexprogram.upload_instruction_index < 256) {
 			vertexprogram.exec.op[vertexprogram.upload_instruction_index].i[vertexprogram.upload_instruction_component] = data;
 			vertexprogram.exec.op[vertexprogram.upload_instruction_index].modified |= (1 << vertexprogram.upload_instruction_component);
+			vertexprogram.serial++;
 		}
 		else
 			machine().logerror("Need to increase size of vertexprogram.instruction to %d\n\r", vertexprogram.upload_instruction_index);
@@ -3736,6 +3810,7 @@ int nv2a_renderer::geforce_exec_method(address_space & space, uint32_t chanel, u
 		//machine().logerror("VP_UPLOAD_CONST\n");
 		if (vertexprogram.upload_parameter_index < 192) {
 			vertexprogram.exec.c_constant[vertexprogram.upload_parameter_index].iv(vertexprogram.upload_parameter_component, data);
+			vertexprogram.serial++;
 		}
 		else
 			machine().logerror("Need to increase size of vertexprogram.parameter to %d\n\r", vertexprogram.upload_parameter_index);
@@ -4858,4 +4933,5 @@ void nv2a_renderer::start(address_space *cpu_space)
 	topmempointer = basemempointer + 512 * 1024 * 1024 - 1;
 	puller_timer = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(nv2a_renderer::puller_timer_work), this), (void *)"NV2A Puller Timer");
 	puller_timer->enable(false);
+	vertex_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 }
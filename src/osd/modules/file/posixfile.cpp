@@ -51,7 +51,11 @@
 
 #include <fcntl.h>
 #include <limits.h>
+#include <limits>
 #include <sys/stat.h>
+#if !defined(WIN32)
+#include <sys/mman.h>
+#endif
 #include <stdlib.h>
 #include <unistd.h>
 
@@ -79,13 +83,17 @@ public:
 	posix_osd_file& operator=(posix_osd_file const &) = delete;
 	posix_osd_file& operator=(posix_osd_file &&) = delete;
 
-	posix_osd_file(int fd) : m_fd(fd)
+	posix_osd_file(int fd) : m_fd(fd), m_mapping(nullptr), m_mapped(0)
 	{
 		assert(m_fd >= 0);
 	}
 
 	virtual ~posix_osd_file() override
 	{
+#if !defined(WIN32)
+		if (m_mapping)
+			::munmap(m_mapping, size_t(m_mapped));
+#endif
 		::close(m_fd);
 	}
 
@@ -153,8 +161,26 @@ public:
 		return error::NONE;
 	}
 
+	virtual void const *map(std::uint64_t length) override
+	{
+#if !defined(WIN32)
+		if (!m_mapping && length && (length <= std::numeric_limits<size_t>::max()))
+		{
+			void *const data = ::mmap(nullptr, size_t(length), PROT_READ, MAP_SHARED, m_fd, 0);
+			if (data != MAP_FAILED)
+			{
+				m_mapping = data;
+				m_mapped = length;
+			}
+		}
+#endif
+		return (m_mapping && (length <= m_mapped)) ? m_mapping : nullptr;
+	}
+
 private:
 	int m_fd;
+	void *m_mapping;
+	std::uint64_t m_mapped;
 };
 
 
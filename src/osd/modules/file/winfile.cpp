@@ -43,7 +43,7 @@ public:
 	win_osd_file& operator=(win_osd_file const &) = delete;
 	win_osd_file& operator=(win_osd_file &&) = delete;
 
-	win_osd_file(HANDLE handle) : m_handle(handle)
+	win_osd_file(HANDLE handle) : m_handle(handle), m_mapping(nullptr), m_view(nullptr), m_mapped(0)
 	{
 		assert(m_handle);
 		assert(INVALID_HANDLE_VALUE != m_handle);
@@ -51,6 +51,10 @@ public:
 
 	virtual ~win_osd_file() override
 	{
+		if (m_view)
+			UnmapViewOfFile(m_view);
+		if (m_mapping)
+			CloseHandle(m_mapping);
 		FlushFileBuffers(m_handle);
 		CloseHandle(m_handle);
 	}
@@ -110,8 +114,34 @@ public:
 		return error::NONE;
 	}
 
+	virtual void const *map(std::uint64_t length) override
+	{
+		if (!m_view && length && (length <= SIZE_T(~SIZE_T(0))))
+		{
+			HANDLE const mapping = CreateFileMapping(m_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping)
+			{
+				void *const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, SIZE_T(length));
+				if (view)
+				{
+					m_mapping = mapping;
+					m_view = view;
+					m_mapped = length;
+				}
+				else
+				{
+					CloseHandle(mapping);
+				}
+			}
+		}
+		return (m_view && (length <= m_mapped)) ? m_view : nullptr;
+	}
+
 private:
 	HANDLE m_handle;
+	HANDLE m_mapping;
+	void *m_view;
+	std::uint64_t m_mapped;
 };
 
 
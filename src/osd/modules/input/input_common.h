@@ -240,22 +240,33 @@ public:
 //  event_based_device
 //============================================================
 
-#define DEFAULT_EVENT_QUEUE_SIZE 20
+// deep enough that deferred releases don't push presses out of the queue
+#define DEFAULT_EVENT_QUEUE_SIZE 64
 
 template <class TEvent>
 class event_based_device : public device_info
 {
 private:
 	std::queue<TEvent>   m_event_queue;
+	std::uint32_t        m_poll_count;
 
 protected:
 	std::mutex           m_device_lock;
 
 	virtual void process_event(TEvent &ev) = 0;
 
+	// return true to leave this event, and everything queued after it, for
+	// the next poll; used so a press and release arriving between two polls
+	// are both seen, rather than cancelling each other out
+	virtual bool defer_event(TEvent &ev) { return false; }
+
+	// identifies the poll in progress, for comparing against in defer_event
+	std::uint32_t poll_count() const { return m_poll_count; }
+
 public:
 	event_based_device(running_machine &machine, const char *name, const char *id, input_device_class deviceclass, input_module &module)
 		: device_info(machine, name, id, deviceclass, module)
+		, m_poll_count(0)
 	{
 	}
 
@@ -273,11 +284,14 @@ public:
 	void virtual poll() override
 	{
 		std::lock_guard<std::mutex> scope_lock(m_device_lock);
+		m_poll_count++;
 
-		// Process each event until the queue is empty
+		// Process each event until the queue is empty or one has to wait
 		while (!m_event_queue.empty())
 		{
 			TEvent &next_event = m_event_queue.front();
+			if (defer_event(next_event))
+				break;
 			process_event(next_event);
 			m_event_queue.pop();
 		}
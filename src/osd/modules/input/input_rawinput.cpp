@@ -307,7 +307,8 @@ public:
 
 	rawinput_keyboard_device(running_machine& machine, const char *name, const char *id, input_module& module)
 		: rawinput_device(machine, name, id, DEVICE_CLASS_KEYBOARD, module),
-			keyboard({{0}})
+			keyboard({{0}}),
+			m_press_poll{ 0 }
 	{
 	}
 
@@ -316,18 +317,34 @@ public:
 		memset(&keyboard, 0, sizeof(keyboard));
 	}
 
+	bool defer_event(RAWINPUT &rawinput) override
+	{
+		// hold back the release of a key that went down during this poll
+		return (rawinput.data.keyboard.Flags & RI_KEY_BREAK) && (m_press_poll[scancode(rawinput)] == poll_count());
+	}
+
 	void process_event(RAWINPUT &rawinput) override
 	{
 		// determine the full DIK-compatible scancode
-		uint8_t scancode = (rawinput.data.keyboard.MakeCode & 0x7f) | ((rawinput.data.keyboard.Flags & RI_KEY_E0) ? 0x80 : 0x00);
+		uint8_t const code = scancode(rawinput);
 
 		// scancode 0xaa is a special shift code we need to ignore
-		if (scancode == 0xaa)
+		if (code == 0xaa)
 			return;
 
 		// set or clear the key
-		keyboard.state[scancode] = (rawinput.data.keyboard.Flags & RI_KEY_BREAK) ? 0x00 : 0x80;
+		keyboard.state[code] = (rawinput.data.keyboard.Flags & RI_KEY_BREAK) ? 0x00 : 0x80;
+		if (!(rawinput.data.keyboard.Flags & RI_KEY_BREAK))
+			m_press_poll[code] = poll_count();
+	}
+
+private:
+	static uint8_t scancode(RAWINPUT const &rawinput)
+	{
+		return (rawinput.data.keyboard.MakeCode & 0x7f) | ((rawinput.data.keyboard.Flags & RI_KEY_E0) ? 0x80 : 0x00);
 	}
+
+	std::uint32_t m_press_poll[MAX_KEYS];   // poll in which each key last went down
 };
 
 //============================================================
@@ -134,16 +134,24 @@ public:
 
 	sdl_keyboard_device(running_machine &machine, const char *name, const char *id, input_module &module)
 		: sdl_device(machine, name, id, DEVICE_CLASS_KEYBOARD, module),
-		keyboard({{0}})
+		keyboard({{0}}),
+		m_press_poll{ 0 }
 	{
 	}
 
+	bool defer_event(SDL_Event &sdlevent) override
+	{
+		// hold back the release of a key that went down during this poll
+		return (sdlevent.type == SDL_KEYUP) && (m_press_poll[OSD_SDL_INDEX_KEYSYM(&sdlevent.key.keysym)] == poll_count());
+	}
+
 	void process_event(SDL_Event &sdlevent) override
 	{
 		switch (sdlevent.type)
 		{
 		case SDL_KEYDOWN:
 			keyboard.state[OSD_SDL_INDEX_KEYSYM(&sdlevent.key.keysym)] = 0x80;
+			m_press_poll[OSD_SDL_INDEX_KEYSYM(&sdlevent.key.keysym)] = poll_count();
 			if (sdlevent.key.keysym.sym < 0x20)
 				machine().ui_input().push_char_event(osd_common_t::s_window_list.front()->target(), sdlevent.key.keysym.sym);
 			break;
@@ -184,6 +192,9 @@ public:
 	{
 		memset(&keyboard.state, 0, sizeof(keyboard.state));
 	}
+
+private:
+	std::uint32_t m_press_poll[ARRAY_LENGTH(keyboard_state::state)];   // poll in which each key last went down
 };
 
 //============================================================
@@ -16,6 +16,7 @@
 #ifndef __OSDLIB__
 #define __OSDLIB__
 
+#include <cstddef>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -96,6 +97,29 @@ protected:
 	virtual generic_fptr_t get_symbol_address(char const *symbol) = 0;
 };
 
+/*-----------------------------------------------------------------------------
+    shared_memory: a named region of memory other processes can map
+
+    Notes:
+        - Supports Mac OS X, Unix and Windows desktop applications
+        - The region is created, or truncated to the requested size if it
+          already exists, and zero filled; it is removed when the object
+          is destroyed
+-----------------------------------------------------------------------------*/
+
+class shared_memory
+{
+public:
+	typedef std::unique_ptr<shared_memory> ptr;
+
+	static ptr create(std::string const &name, std::size_t size);
+
+	virtual ~shared_memory() { };
+
+	virtual void *data() const = 0;
+	virtual std::size_t size() const = 0;
+};
+
 } // namespace osd
 
 //=========================================================================================================
@@ -13,6 +13,8 @@
 #include <sys/mman.h>
 #include <sys/sysctl.h>
 #include <sys/types.h>
+#include <sys/resource.h>
+#include <fcntl.h>
 #include <signal.h>
 #include <dlfcn.h>
 
@@ -87,6 +89,36 @@ void osd_free_executable(void *ptr, size_t size)
 #endif
 }
 
+//============================================================
+//  osd_alloc_large
+//
+//  maps "size" bytes of zeroed memory, asking for
+//  superpages if requested
+//============================================================
+
+void *osd_alloc_large(size_t size, bool huge)
+{
+	void *result = MAP_FAILED;
+#if defined(VM_FLAGS_SUPERPAGE_SIZE_ANY)
+	if (huge)
+		result = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_ANON|MAP_PRIVATE, VM_FLAGS_SUPERPAGE_SIZE_ANY, 0);
+#endif
+	if (result == MAP_FAILED)
+		result = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_ANON|MAP_PRIVATE, -1, 0);
+	return (result == MAP_FAILED) ? nullptr : result;
+}
+
+//============================================================
+//  osd_free_large
+//
+//  frees memory allocated with osd_alloc_large
+//============================================================
+
+void osd_free_large(void *ptr, size_t size)
+{
+	munmap(ptr, size);
+}
+
 //============================================================
 //  osd_break_into_debugger
 //============================================================
@@ -199,6 +231,18 @@ int osd_getpid(void)
 	return getpid();
 }
 
+//============================================================
+//  osd_get_peak_memory
+//============================================================
+
+uint64_t osd_get_peak_memory(void)
+{
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+	return uint64_t(usage.ru_maxrss);
+}
+
 //============================================================
 //  dynamic_module_posix_impl
 //============================================================
@@ -264,4 +308,56 @@ dynamic_module::ptr dynamic_module::open(std::vector<std::string> &&names)
 	return std::make_unique<dynamic_module_posix_impl>(names);
 }
 
+//============================================================
+//  shared_memory_posix_impl
+//============================================================
+
+class shared_memory_posix_impl : public shared_memory
+{
+public:
+	shared_memory_posix_impl(std::string &&name, void *data, std::size_t size)
+		: m_name(std::move(name))
+		, m_data(data)
+		, m_size(size)
+	{
+	}
+
+	virtual ~shared_memory_posix_impl() override
+	{
+		munmap(m_data, m_size);
+		shm_unlink(m_name.c_str());
+	}
+
+	virtual void *data() const override { return m_data; }
+	virtual std::size_t size() const override { return m_size; }
+
+private:
+	std::string m_name;
+	void *      m_data;
+	std::size_t m_size;
+};
+
+shared_memory::ptr shared_memory::create(std::string const &name, std::size_t size)
+{
+	// POSIX names need a leading slash and no others
+	std::string fullname = (name[0] == '/') ? name : ('/' + name);
+
+	int const fd = shm_open(fullname.c_str(), O_RDWR | O_CREAT, 0600);
+	if (fd < 0)
+		return nullptr;
+
+	// truncating to nothing first clears anything left from an earlier run
+	void *data = MAP_FAILED;
+	if (ftruncate(fd, 0) == 0 && ftruncate(fd, size) == 0)
+		data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		shm_unlink(fullname.c_str());
+		return nullptr;
+	}
+
+	return std::make_unique<shared_memory_posix_impl>(std::move(fullname), data, size);
+}
+
 } // namespace osd
@@ -112,6 +112,30 @@ void osd_free_executable(void *ptr, size_t size)
 }
 
 
+//============================================================
+//  osd_alloc_large
+//
+//  allocates "size" bytes of zeroed memory
+//============================================================
+
+void *osd_alloc_large(size_t size, bool huge)
+{
+	return calloc(size, 1);
+}
+
+
+//============================================================
+//  osd_free_large
+//
+//  frees memory allocated with osd_alloc_large
+//============================================================
+
+void osd_free_large(void *ptr, size_t size)
+{
+	free(ptr);
+}
+
+
 //============================================================
 //  osd_break_into_debugger
 //============================================================
@@ -185,3 +209,25 @@ int osd_getpid(void)
 	return GetCurrentProcessId();
 }
 
+//============================================================
+//  osd_get_peak_memory
+//============================================================
+
+uint64_t osd_get_peak_memory(void)
+{
+	return 0;
+}
+
+//============================================================
+//  shared_memory
+//============================================================
+
+namespace osd {
+
+shared_memory::ptr shared_memory::create(std::string const &name, std::size_t size)
+{
+	// not available to Windows Store applications
+	return nullptr;
+}
+
+} // namespace osd
@@ -10,6 +10,7 @@
 
 #include <windows.h>
 #include <mmsystem.h>
+#include <psapi.h>
 
 #include <stdlib.h>
 #ifndef _MSC_VER
@@ -107,6 +108,37 @@ void osd_free_executable(void *ptr, size_t size)
 }
 
 
+//============================================================
+//  osd_alloc_large
+//
+//  commits "size" bytes of zeroed memory, using large pages
+//  if requested and the process is allowed to lock them
+//============================================================
+
+void *osd_alloc_large(size_t size, bool huge)
+{
+	void *result = nullptr;
+	SIZE_T const large = huge ? GetLargePageMinimum() : 0;
+	if (large != 0)
+		result = VirtualAlloc(nullptr, (size + large - 1) & ~(large - 1), MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+	if (result == nullptr)
+		result = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	return result;
+}
+
+
+//============================================================
+//  osd_free_large
+//
+//  frees memory allocated with osd_alloc_large
+//============================================================
+
+void osd_free_large(void *ptr, size_t size)
+{
+	VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
+
 //============================================================
 //  osd_break_into_debugger
 //============================================================
@@ -217,6 +249,23 @@ int osd_getpid(void)
 	return GetCurrentProcessId();
 }
 
+//============================================================
+//  osd_get_peak_memory
+//============================================================
+
+uint64_t osd_get_peak_memory(void)
+{
+	// the psapi call is exported from kernel32 from Windows 7 on
+	typedef BOOL (WINAPI *get_process_memory_info_fn)(HANDLE, PPROCESS_MEMORY_COUNTERS, DWORD);
+	static osd::dynamic_module::ptr const kernel32 = osd::dynamic_module::open({ "kernel32.dll" });
+	static get_process_memory_info_fn const get_process_memory_info = kernel32->bind<get_process_memory_info_fn>("K32GetProcessMemoryInfo");
+
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!get_process_memory_info || !get_process_memory_info(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.PeakWorkingSetSize;
+}
+
 //============================================================
 //  osd_dynamic_bind
 //============================================================
@@ -291,4 +340,60 @@ dynamic_module::ptr dynamic_module::open(std::vector<std::string> &&names)
 	return std::make_unique<dynamic_module_win32_impl>(names);
 }
 
+//============================================================
+//  shared_memory_win32_impl
+//============================================================
+
+class shared_memory_win32_impl : public shared_memory
+{
+public:
+	shared_memory_win32_impl(HANDLE mapping, void *data, std::size_t size)
+		: m_mapping(mapping)
+		, m_data(data)
+		, m_size(size)
+	{
+	}
+
+	virtual ~shared_memory_win32_impl() override
+	{
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+	}
+
+	virtual void *data() const override { return m_data; }
+	virtual std::size_t size() const override { return m_size; }
+
+private:
+	HANDLE      m_mapping;
+	void *      m_data;
+	std::size_t m_size;
+};
+
+shared_memory::ptr shared_memory::create(std::string const &name, std::size_t size)
+{
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+	// backed by the paging file, and gone once every process has closed it
+	osd::text::tstring tempstr = osd::text::to_tstring(name);
+	HANDLE const mapping = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, DWORD(uint64_t(size) >> 32), DWORD(size), tempstr.c_str());
+	if (mapping == nullptr)
+		return nullptr;
+	bool const existed = (GetLastError() == ERROR_ALREADY_EXISTS);
+
+	void *const data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if (data == nullptr)
+	{
+		CloseHandle(mapping);
+		return nullptr;
+	}
+
+	// a consumer may have opened it first
+	if (existed)
+		memset(data, 0, size);
+
+	return std::make_unique<shared_memory_win32_impl>(mapping, data, size);
+#else
+	return nullptr;
+#endif
+}
+
 } // namespace osd
@@ -12,6 +12,8 @@
 #include "emu.h"
 #include "osdepend.h"
 #include "modules/lib/osdobj_common.h"
+#include "osdsync.h"
+#include "modules/render/shmpublish.h"
 
 const options_entry osd_options::s_option_entries[] =
 {
@@ -47,6 +49,12 @@ const options_entry osd_options::s_option_entries[] =
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD PERFORMANCE OPTIONS" },
 	{ OSDOPTION_NUMPROCESSORS ";np",          OSDOPTVAL_AUTO,   OPTION_STRING,    "number of processors; this overrides the number the system reports" },
 	{ OSDOPTION_BENCH,                        "0",              OPTION_INTEGER,   "benchmark for the given number of emulated seconds; implies -video none -sound none -nothrottle" },
+	{ OSDOPTION_CPU_MAIN,                     OSDOPTVAL_AUTO,   OPTION_STRING,    "processors to run the emulation thread on, e.g. 0-3,8" },
+	{ OSDOPTION_CPU_RENDER,                   OSDOPTVAL_AUTO,   OPTION_STRING,    "processors to run window render threads on" },
+	{ OSDOPTION_CPU_WORKERS,                  OSDOPTVAL_AUTO,   OPTION_STRING,    "processors to run work queue threads on" },
+	{ OSDOPTION_CPU_IO,                       OSDOPTVAL_AUTO,   OPTION_STRING,    "processors to run I/O work queue threads on" },
+	{ OSDOPTION_CPU_PARTITION,                OSDOPTVAL_AUTO,   OPTION_STRING,    "share of the processors for this instance as index/count, e.g. 0/2; split by socket and cache first" },
+	{ OSDOPTION_IO_PRIORITY "(-1-1)",         "1",              OPTION_INTEGER,   "priority of I/O work queue threads relative to the emulation thread; range from -1 to 1" },
 
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD VIDEO OPTIONS" },
 // OS X can be trusted to have working hardware OpenGL, so default to it on for the best user experience
@@ -128,6 +136,13 @@ const options_entry osd_options::s_option_entries[] =
 	{ OSDOPTION_SOUND,                        OSDOPTVAL_AUTO,   OPTION_STRING,    "sound output method: " },
 	{ OSDOPTION_AUDIO_LATENCY "(1-5)",        "2",              OPTION_INTEGER,   "set audio latency (increase to reduce glitches, decrease for responsiveness)" },
 
+	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD SHARED MEMORY OUTPUT OPTIONS" },
+	{ OSDOPTION_SHM,                          "",               OPTION_STRING,    "publish rendered frames and mixed audio to the named shared memory region" },
+	{ OSDOPTION_SHM_SIZE,                     OSDOPTVAL_AUTO,   OPTION_STRING,    "size of published frames, as <width>x<height> (auto for the native size)" },
+	{ OSDOPTION_SHM_FORMAT,                   "rgb32",          OPTION_STRING,    "pixel format of published frames: rgb32 or rgb565" },
+	{ OSDOPTION_SHM_FRAMES "(1-16)",          "3",              OPTION_INTEGER,   "number of published frames kept in shared memory" },
+	{ OSDOPTION_SHM_LOCKSTEP,                 "0",              OPTION_BOOLEAN,   "wait after each frame until the shared memory reader requests the next" },
+
 #ifndef NO_USE_PORTAUDIO
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "PORTAUDIO OPTIONS" },
 	{ OSDOPTION_PA_API,                       OSDOPTVAL_NONE,   OPTION_STRING,    "PortAudio API" },
@@ -154,6 +169,7 @@ const options_entry osd_options::s_option_entries[] =
 	{ OSDOPTION_BGFX_PATH,                    "bgfx",            OPTION_STRING, "path to BGFX-related files" },
 	{ OSDOPTION_BGFX_BACKEND,                 "auto",            OPTION_STRING, "BGFX backend to use (d3d9, d3d11, metal, opengl, gles)" },
 	{ OSDOPTION_BGFX_DEBUG,                   "0",               OPTION_BOOLEAN, "enable BGFX debugging statistics" },
+	{ OSDOPTION_BGFX_PROFILE,                 "0",               OPTION_BOOLEAN, "overlay the GPU time of each BGFX screen chain pass" },
 	{ OSDOPTION_BGFX_SCREEN_CHAINS,           "default",         OPTION_STRING, "comma-delimited list of screen chain JSON names, colon-delimited per-window" },
 	{ OSDOPTION_BGFX_SHADOW_MASK,             "slot-mask.png",   OPTION_STRING, "shadow mask texture name" },
 	{ OSDOPTION_BGFX_LUT,                     "",                OPTION_STRING, "LUT texture name" },
@@ -459,6 +475,14 @@ void osd_common_t::init(running_machine &machine)
 		m_watchdog = std::make_unique<osd_watchdog>();
 		m_watchdog->setTimeout(watchdog_timeout);
 	}
+
+	// set up shared memory output if requested
+	if (options.shm()[0] != 0)
+	{
+		m_shm_publisher = std::make_unique<shm_publisher>(machine, options);
+		if (!m_shm_publisher->valid())
+			m_shm_publisher.reset();
+	}
 }
 
 
@@ -481,6 +505,9 @@ void osd_common_t::update(bool skip_redraw)
 
 	update_slider_list();
 
+	if (m_shm_publisher)
+		m_shm_publisher->frame(skip_redraw);
+
 }
 
 
@@ -535,6 +562,9 @@ void osd_common_t::update_audio_stream(const int16_t *buffer, int samples_this_f
 	// output at the configured sample_rate.
 	//
 	m_sound->update_audio_stream(m_machine->video().throttled(), buffer,samples_this_frame);
+
+	if (m_shm_publisher)
+		m_shm_publisher->audio(buffer, samples_this_frame);
 }
 
 
@@ -643,6 +673,20 @@ static void output_notifier_callback(const char *outname, int32_t value, void *p
 
 void osd_common_t::init_subsystems()
 {
+	// place threads before any of them get created
+	static const struct { osd_thread_class cls; const char *name; } thread_classes[] = {
+		{ OSD_THREAD_MAIN,   OSDOPTION_CPU_MAIN },
+		{ OSD_THREAD_RENDER, OSDOPTION_CPU_RENDER },
+		{ OSD_THREAD_WORKER, OSDOPTION_CPU_WORKERS },
+		{ OSD_THREAD_IO,     OSDOPTION_CPU_IO } };
+	if (!osd_thread_set_partition(options().cpu_partition()))
+		osd_printf_warning("Invalid %s value %s, using all processors\n", OSDOPTION_CPU_PARTITION, options().cpu_partition());
+	for (auto const &thread_class : thread_classes)
+		if (!osd_thread_class_set_processors(thread_class.cls, options().value(thread_class.name)))
+			osd_printf_warning("Invalid %s value %s, ignoring\n", thread_class.name, options().value(thread_class.name));
+	osd_thread_set_io_priority(options().io_priority());
+	osd_thread_apply_class(nullptr, OSD_THREAD_MAIN);
+
 	// monitors have to be initialized before video init
 	m_monitor_module = select_module_options<monitor_module *>(options(), OSD_MONITOR_PROVIDER);
 	assert(m_monitor_module != nullptr);
@@ -697,7 +741,8 @@ bool osd_common_t::window_init()
 
 bool osd_common_t::no_sound()
 {
-	return (strcmp(options().sound(),"none")==0) ? true : false;
+	// shared memory output still wants the mix, even with nothing to play it
+	return (strcmp(options().sound(),"none")==0 && options().shm()[0] == 0) ? true : false;
 }
 
 void osd_common_t::video_register()
@@ -744,6 +789,7 @@ void osd_common_t::window_exit()
 
 void osd_common_t::osd_exit()
 {
+	m_shm_publisher.reset();
 	m_mod_man.exit();
 
 	exit_subsystems();
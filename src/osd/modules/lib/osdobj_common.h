@@ -43,6 +43,12 @@
 
 #define OSDOPTION_NUMPROCESSORS         "numprocessors"
 #define OSDOPTION_BENCH                 "bench"
+#define OSDOPTION_CPU_MAIN              "cpu_main"
+#define OSDOPTION_CPU_RENDER            "cpu_render"
+#define OSDOPTION_CPU_WORKERS           "cpu_workers"
+#define OSDOPTION_CPU_IO                "cpu_io"
+#define OSDOPTION_CPU_PARTITION         "cpu_partition"
+#define OSDOPTION_IO_PRIORITY           "io_priority"
 
 #define OSDOPTION_VIDEO                 "video"
 #define OSDOPTION_NUMSCREENS            "numscreens"
@@ -74,6 +80,12 @@
 #define OSDOPTION_SOUND                 "sound"
 #define OSDOPTION_AUDIO_LATENCY         "audio_latency"
 
+#define OSDOPTION_SHM                   "shm"
+#define OSDOPTION_SHM_SIZE              "shm_size"
+#define OSDOPTION_SHM_FORMAT            "shm_format"
+#define OSDOPTION_SHM_FRAMES            "shm_frames"
+#define OSDOPTION_SHM_LOCKSTEP          "shm_lockstep"
+
 #define OSDOPTION_PA_API                "pa_api"
 #define OSDOPTION_PA_DEVICE             "pa_device"
 #define OSDOPTION_PA_LATENCY            "pa_latency"
@@ -87,6 +99,7 @@
 #define OSDOPTION_BGFX_PATH             "bgfx_path"
 #define OSDOPTION_BGFX_BACKEND          "bgfx_backend"
 #define OSDOPTION_BGFX_DEBUG            "bgfx_debug"
+#define OSDOPTION_BGFX_PROFILE          "bgfx_profile"
 #define OSDOPTION_BGFX_SCREEN_CHAINS    "bgfx_screen_chains"
 #define OSDOPTION_BGFX_SHADOW_MASK      "bgfx_shadow_mask"
 #define OSDOPTION_BGFX_LUT              "bgfx_lut"
@@ -114,6 +127,12 @@ public:
 	// performance options
 	const char *numprocessors() const { return value(OSDOPTION_NUMPROCESSORS); }
 	int bench() const { return int_value(OSDOPTION_BENCH); }
+	const char *cpu_main() const { return value(OSDOPTION_CPU_MAIN); }
+	const char *cpu_render() const { return value(OSDOPTION_CPU_RENDER); }
+	const char *cpu_workers() const { return value(OSDOPTION_CPU_WORKERS); }
+	const char *cpu_io() const { return value(OSDOPTION_CPU_IO); }
+	const char *cpu_partition() const { return value(OSDOPTION_CPU_PARTITION); }
+	int io_priority() const { return int_value(OSDOPTION_IO_PRIORITY); }
 
 	// video options
 	const char *video() const { return value(OSDOPTION_VIDEO); }
@@ -155,6 +174,13 @@ public:
 	const char *sound() const { return value(OSDOPTION_SOUND); }
 	int audio_latency() const { return int_value(OSDOPTION_AUDIO_LATENCY); }
 
+	// shared memory output options
+	const char *shm() const { return value(OSDOPTION_SHM); }
+	const char *shm_size() const { return value(OSDOPTION_SHM_SIZE); }
+	const char *shm_format() const { return value(OSDOPTION_SHM_FORMAT); }
+	int shm_frames() const { return int_value(OSDOPTION_SHM_FRAMES); }
+	bool shm_lockstep() const { return bool_value(OSDOPTION_SHM_LOCKSTEP); }
+
 	// CoreAudio specific options
 	const char *audio_output() const { return value(OSDOPTION_AUDIO_OUTPUT); }
 	const char *audio_effect(int index) const { return value(string_format("%s%d", OSDOPTION_AUDIO_EFFECT, index).c_str()); }
@@ -163,6 +189,7 @@ public:
 	const char *bgfx_path() const { return value(OSDOPTION_BGFX_PATH); }
 	const char *bgfx_backend() const { return value(OSDOPTION_BGFX_BACKEND); }
 	bool bgfx_debug() const { return bool_value(OSDOPTION_BGFX_DEBUG); }
+	bool bgfx_profile() const { return bool_value(OSDOPTION_BGFX_PROFILE); }
 	const char *bgfx_screen_chains() const { return value(OSDOPTION_BGFX_SCREEN_CHAINS); }
 	const char *bgfx_shadow_mask() const { return value(OSDOPTION_BGFX_SHADOW_MASK); }
 	const char *bgfx_lut() const { return value(OSDOPTION_BGFX_LUT); }
@@ -178,6 +205,7 @@ public:
 
 // ======================> osd_interface
 class osd_window;
+class shm_publisher;
 
 // description of the currently-running machine
 class osd_common_t : public osd_interface, osd_output
@@ -301,6 +329,7 @@ protected:
 	output_module*  m_output;
 	monitor_module* m_monitor_module;
 	std::unique_ptr<osd_watchdog> m_watchdog;
+	std::unique_ptr<shm_publisher> m_shm_publisher;
 	std::vector<ui::menu_item> m_sliders;
 
 private:
@@ -8,6 +8,7 @@
 #else
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <net/if.h>
 #include <errno.h>
@@ -60,6 +61,9 @@ public:
 	void set_mac(const char *mac) override;
 protected:
 	int recv_dev(uint8_t **buf) override;
+#if !defined(WIN32)
+	bool wait_dev(int timeout_ms) override;
+#endif
 private:
 #if defined(WIN32)
 	HANDLE m_handle = INVALID_HANDLE_VALUE;
@@ -97,6 +101,7 @@ netdev_tap::netdev_tap(const char *name, class device_network_interface *ifdev,
 	osd_printf_verbose("netdev_tap: network up!\n");
 	strncpy(m_ifname, ifr.ifr_name, 10);
 	fcntl(m_fd, F_SETFL, O_NONBLOCK);
+	start_receive_thread();
 #elif defined(WIN32)
 	std::wstring device_path(L"" USERMODEDEVICEDIR);
 	device_path.append(wstring_from_utf8(name));
@@ -129,7 +134,9 @@ netdev_tap::~netdev_tap()
 		CloseHandle(m_handle);
 	}
 #else
-	close(m_fd);
+	stop_receive_thread();
+	if (m_fd != -1)
+		close(m_fd);
 #endif
 }
 
@@ -333,6 +340,15 @@ int netdev_tap::recv_dev(uint8_t **buf)
 	*buf = m_buf;
 	return (len == -1)?0:len;
 }
+
+bool netdev_tap::wait_dev(int timeout_ms)
+{
+	struct pollfd pfd;
+	pfd.fd = m_fd;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	return ::poll(&pfd, 1, timeout_ms) > 0;
+}
 #endif
 
 static CREATE_NETDEV(create_tap)
@@ -285,6 +285,7 @@ struct osd_video_config
 	// SDL - options
 	//============================================================
 	int                 novideo;                // don't draw, for pure CPU benchmarking
+	int                 renderqueue;            // frames queued for the render thread, 0 = none
 
 	int                 centerh;
 	int                 centerv;
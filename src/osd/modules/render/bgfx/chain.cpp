@@ -22,6 +22,8 @@
 
 #include "chain.h"
 
+#include <set>
+
 bgfx_chain::bgfx_chain(std::string name, std::string author, bool transform, target_manager& targets, std::vector<bgfx_slider*> sliders, std::vector<bgfx_parameter*> params, std::vector<bgfx_chain_entry*> entries, std::vector<bgfx_target*> target_list, std::uint32_t screen_index)
 	: m_name(name)
 	, m_author(author)
@@ -30,6 +32,7 @@ bgfx_chain::bgfx_chain(std::string name, std::string author, bool transform, tar
 	, m_sliders(sliders)
 	, m_params(params)
 	, m_entries(entries)
+	, m_dirty(true)
 	, m_target_list(target_list)
 	, m_current_time(0)
 	, m_screen_index(screen_index)
@@ -101,14 +104,16 @@ void bgfx_chain::process(render_primitive* prim, int view, int screen, texture_m
 		screen_offset_y = -screen_container.yoffset();
 	}
 
+	if (sliders_changed() || m_dirty)
+	{
+		optimize();
+	}
+
 	int current_view = view;
-	for (bgfx_chain_entry* entry : m_entries)
+	for (bgfx_chain_entry* entry : m_active_entries)
 	{
-		if (!entry->skip())
-		{
-			entry->submit(current_view, prim, textures, screen_count, screen_width, screen_height, screen_scale_x, screen_scale_y, screen_offset_x, screen_offset_y, rotation_type, swap_xy, blend, screen);
-			current_view++;
-		}
+		entry->submit(current_view, prim, textures, screen_count, screen_width, screen_height, screen_scale_x, screen_scale_y, screen_offset_x, screen_offset_y, rotation_type, swap_xy, blend, screen);
+		current_view++;
 	}
 
 	m_current_time = bx::getHPCounter();
@@ -125,16 +130,79 @@ void bgfx_chain::process(render_primitive* prim, int view, int screen, texture_m
 	}
 }
 
-uint32_t bgfx_chain::applicable_passes()
+bool bgfx_chain::sliders_changed()
 {
-	int applicable_passes = 0;
+	bool changed = m_slider_values.size() != m_sliders.size();
+	m_slider_values.resize(m_sliders.size());
+	for (size_t i = 0; i < m_sliders.size(); i++)
+	{
+		if (m_slider_values[i] != m_sliders[i]->value())
+		{
+			m_slider_values[i] = m_sliders[i]->value();
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+void bgfx_chain::optimize()
+{
+	// Evaluate the suppressors once per slider change rather than every frame
+	std::vector<bgfx_chain_entry*> enabled;
 	for (bgfx_chain_entry* entry : m_entries)
 	{
 		if (!entry->skip())
 		{
-			applicable_passes++;
+			enabled.push_back(entry);
 		}
 	}
 
-	return applicable_passes;
+	// Work back from the final output, dropping any pass whose target no enabled pass reads.
+	// Targets are kept across frames, so an earlier reader (e.g. phosphor feedback) counts too.
+	std::set<std::string> needed;
+	needed.insert("output");
+	std::vector<bool> keep(enabled.size(), false);
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (size_t i = 0; i < enabled.size(); i++)
+		{
+			if (keep[i])
+			{
+				continue;
+			}
+
+			const std::string output = enabled[i]->output();
+			if (m_target_map.find(output) == m_target_map.end() || needed.find(output) != needed.end())
+			{
+				keep[i] = true;
+				changed = true;
+				for (bgfx_input_pair* input : enabled[i]->inputs())
+				{
+					needed.insert(input->texture());
+				}
+			}
+		}
+	}
+
+	m_active_entries.clear();
+	for (size_t i = 0; i < enabled.size(); i++)
+	{
+		if (keep[i])
+		{
+			m_active_entries.push_back(enabled[i]);
+		}
+	}
+	m_dirty = false;
+}
+
+uint32_t bgfx_chain::applicable_passes()
+{
+	if (sliders_changed() || m_dirty)
+	{
+		optimize();
+	}
+
+	return m_active_entries.size();
 }
@@ -33,6 +33,7 @@ public:
 
 	void process(render_primitive* prim, int view, int screen, texture_manager& textures, osd_window &window, uint64_t blend = 0L);
 	void repopulate_targets();
+	void invalidate() { m_dirty = true; }
 
 	// Getters
 	std::vector<bgfx_slider*>& sliders() { return m_sliders; }
@@ -41,6 +42,9 @@ public:
 	bool transform() { return m_transform; }
 
 private:
+	bool sliders_changed();
+	void optimize();
+
 	std::string                         m_name;
 	std::string                         m_author;
 	bool                                m_transform;
@@ -48,6 +52,9 @@ private:
 	std::vector<bgfx_slider*>           m_sliders;
 	std::vector<bgfx_parameter*>        m_params;
 	std::vector<bgfx_chain_entry*>      m_entries;
+	std::vector<bgfx_chain_entry*>      m_active_entries;
+	std::vector<float>                  m_slider_values;
+	bool                                m_dirty;
 	std::vector<bgfx_target*>           m_target_list;
 	std::vector<std::string>            m_target_names;
 	std::map<std::string, bgfx_target*> m_target_map;
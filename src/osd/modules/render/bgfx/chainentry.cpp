@@ -81,6 +81,7 @@ void bgfx_chain_entry::submit(int view, render_primitive* prim, texture_manager&
 		}
 	}
 
+	bgfx::setViewName(view, m_name.c_str());
 	m_effect->submit(view, blend);
 
 	if (m_targets.target(screen, m_output) != nullptr)
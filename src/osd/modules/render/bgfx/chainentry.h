@@ -41,6 +41,7 @@ public:
 
 	// Getters
 	std::string name() const { return m_name; }
+	std::string output() const { return m_output; }
 	std::vector<bgfx_input_pair*>& inputs() { return m_inputs; }
 	bool skip();
 
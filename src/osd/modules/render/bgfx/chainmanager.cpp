@@ -54,6 +54,11 @@ chain_manager::chain_manager(running_machine& machine, osd_options& options, tex
 chain_manager::~chain_manager()
 {
 	destroy_chains();
+
+	for (screen_texture &screen : m_screen_textures)
+	{
+		delete screen.texture;
+	}
 }
 
 void chain_manager::refresh_available_chains()
@@ -276,6 +281,17 @@ void chain_manager::reload_chains()
 	load_chains();
 }
 
+void chain_manager::invalidate_chains()
+{
+	for (bgfx_chain* chain : m_screen_chains)
+	{
+		if (chain != nullptr)
+		{
+			chain->invalidate();
+		}
+	}
+}
+
 bgfx_chain* chain_manager::screen_chain(uint32_t screen)
 {
 	if (screen >= m_screen_chains.size())
@@ -293,11 +309,8 @@ void chain_manager::process_screen_quad(uint32_t view, uint32_t screen, render_p
 	uint16_t tex_width(prim->texture.width);
 	uint16_t tex_height(prim->texture.height);
 
-	const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(prim->flags & PRIMFLAG_TEXFORMAT_MASK,
-		tex_width, tex_height, prim->texture.rowpixels, prim->texture.palette, prim->texture.base);
-
 	std::string full_name = "screen" + std::to_string(screen);
-	bgfx_texture *texture = new bgfx_texture(full_name, bgfx::TextureFormat::RGBA8, tex_width, tex_height, mem, BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP | BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT | BGFX_SAMPLER_MIP_POINT);
+	bgfx_texture *texture = update_screen_texture(screen, prim);
 	m_textures.add_provider(full_name, texture);
 
 	const bool any_targets_rebuilt = m_targets.update_target_sizes(screen, tex_width, tex_height, TARGET_STYLE_GUEST);
@@ -317,7 +330,56 @@ void chain_manager::process_screen_quad(uint32_t view, uint32_t screen, render_p
 	view += chain->applicable_passes();
 
 	m_textures.add_provider(full_name, nullptr);
-	delete texture;
+}
+
+bgfx_texture* chain_manager::update_screen_texture(uint32_t screen, render_primitive* prim)
+{
+	if (screen >= m_screen_textures.size())
+	{
+		m_screen_textures.resize(screen + 1, { nullptr, ~0ULL, 0 });
+	}
+	screen_texture &current = m_screen_textures[screen];
+
+	const uint32_t format = prim->flags & PRIMFLAG_TEXFORMAT_MASK;
+	const uint16_t tex_width(prim->texture.width);
+	const uint16_t tex_height(prim->texture.height);
+
+	// a screen drawn straight into our memory goes up without a copy, as long as its undefined alpha isn't blended
+	const bool by_reference = PRIMFLAG_GET_BLENDMODE(prim->flags) == BLENDMODE_NONE
+		&& bgfx_util::in_screen_memory(format, tex_width, tex_height, prim->texture.rowpixels, prim->texture.palette, prim->texture.base);
+	const bgfx::TextureFormat::Enum dst_format = by_reference ? bgfx::TextureFormat::BGRA8 : bgfx_util::mame_texture_format(format, prim->texture.palette);
+	bool upload = current.unique_id != prim->texture.unique_id || current.seqid != prim->texture.seqid;
+
+	// keep the texture as long as its size and format hold, and only upload when the contents change
+	if (current.texture == nullptr || current.texture->width() != tex_width || current.texture->height() != tex_height || current.texture->format() != dst_format)
+	{
+		delete current.texture;
+		if (by_reference)
+		{
+			current.texture = new bgfx_texture("screen" + std::to_string(screen), dst_format, tex_width, tex_height, BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP | BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT | BGFX_SAMPLER_MIP_POINT, nullptr);
+			upload = true;
+		}
+		else
+		{
+			const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(dst_format, format,
+				tex_width, tex_height, prim->texture.rowpixels, prim->texture.palette, prim->texture.base);
+			current.texture = new bgfx_texture("screen" + std::to_string(screen), dst_format, tex_width, tex_height, mem, BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP | BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT | BGFX_SAMPLER_MIP_POINT);
+			upload = false;
+		}
+	}
+
+	if (upload && by_reference)
+	{
+		current.texture->update(bgfx_util::reference_screen_memory(tex_width, tex_height, prim->texture.rowpixels, prim->texture.base), prim->texture.rowpixels * 4);
+	}
+	else if (upload)
+	{
+		current.texture->update(bgfx_util::mame_texture_data_to_bgfx_texture_data(dst_format, format,
+			tex_width, tex_height, prim->texture.rowpixels, prim->texture.palette, prim->texture.base));
+	}
+	current.unique_id = prim->texture.unique_id;
+	current.seqid = prim->texture.seqid;
+	return current.texture;
 }
 
 std::vector<render_primitive*> chain_manager::count_screens(render_primitive* prim)
@@ -71,6 +71,7 @@ public:
 
 	// Setters
 	void restore_slider_settings(int32_t id, std::vector<std::vector<float>>& settings);
+	void invalidate_chains();
 
 private:
 	void load_chains();
@@ -91,6 +92,15 @@ private:
 
 	std::vector<render_primitive*> count_screens(render_primitive* prim);
 	void process_screen_quad(uint32_t view, uint32_t screen, render_primitive* prim, osd_window &window);
+	bgfx_texture* update_screen_texture(uint32_t screen, render_primitive* prim);
+
+	// the texture each screen was last uploaded to, kept across frames
+	struct screen_texture
+	{
+		bgfx_texture*   texture;
+		uint64_t        unique_id;
+		uint32_t        seqid;
+	};
 
 	running_machine&            m_machine;
 	osd_options&                m_options;
@@ -106,6 +116,7 @@ private:
 	std::vector<ui::menu_item>  m_selection_sliders;
 	std::vector<std::unique_ptr<slider_state>> m_core_sliders;
 	std::vector<int32_t>        m_current_chain;
+	std::vector<screen_texture> m_screen_textures;
 
 	static const uint32_t       CHAIN_NONE;
 };
@@ -47,3 +47,8 @@ bgfx_texture::~bgfx_texture()
 {
 	bgfx::destroy(m_texture);
 }
+
+void bgfx_texture::update(const bgfx::Memory* data, uint16_t pitch)
+{
+	bgfx::updateTexture2D(m_texture, 0, 0, 0, 0, m_width, m_height, data, pitch);
+}
@@ -24,6 +24,9 @@ public:
 	bgfx_texture(std::string name, bgfx::TextureFormat::Enum format, uint16_t width, uint16_t height, const bgfx::Memory* data, uint32_t flags = BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP);
 	virtual ~bgfx_texture();
 
+	// replace the contents with data of the same size and format
+	void update(const bgfx::Memory* data, uint16_t pitch = UINT16_MAX);
+
 	// Getters
 	std::string name() const { return m_name; }
 	bgfx::TextureFormat::Enum format() const { return m_format; }
@@ -93,6 +93,7 @@ bgfx_texture* texture_manager::create_png_texture(std::string path, std::string
 bgfx::TextureHandle texture_manager::create_or_update_mame_texture(uint32_t format, int width, int height
 	, int rowpixels, const rgb_t *palette, void *base, uint32_t seqid, uint32_t flags, uint64_t key, uint64_t old_key)
 {
+	const bgfx::TextureFormat::Enum dst_format = bgfx_util::mame_texture_format(format, palette);
 	bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
 	if (old_key != ~0ULL)
 	{
@@ -103,26 +104,27 @@ bgfx::TextureHandle texture_manager::create_or_update_mame_texture(uint32_t form
 			if (handle.idx == bgfx::kInvalidHandle)
 				return handle;
 
-			if (iter->second.width == width && iter->second.height == height)
+			if (iter->second.width == width && iter->second.height == height && iter->second.format == dst_format)
 			{
 				// Size matches, so let's just swap the old handle into the new location
-				m_mame_textures[key] = { handle, seqid, width, height };
-				m_mame_textures[old_key] = { BGFX_INVALID_HANDLE, 0, 0, 0 };
+				const uint32_t old_seqid = iter->second.seqid;
+				m_mame_textures[key] = { handle, seqid, width, height, dst_format };
+				m_mame_textures[old_key] = { BGFX_INVALID_HANDLE, 0, 0, 0, dst_format };
 
-				if (iter->second.seqid == seqid)
+				if (old_seqid == seqid)
 				{
 					// Everything matches, just return the existing handle
 					return handle;
 				}
 				else
 				{
-					const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(format, width, height, rowpixels, palette, base);
+					const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(dst_format, format, width, height, rowpixels, palette, base);
 					bgfx::updateTexture2D(handle, 0, 0, 0, 0, (uint16_t)width, (uint16_t)height, mem);
 					return handle;
 				}
 			}
 			bgfx::destroy(handle);
-			m_mame_textures[old_key] = { BGFX_INVALID_HANDLE, 0, 0, 0 };
+			m_mame_textures[old_key] = { BGFX_INVALID_HANDLE, 0, 0, 0, dst_format };
 		}
 	}
 	else
@@ -134,7 +136,7 @@ bgfx::TextureHandle texture_manager::create_or_update_mame_texture(uint32_t form
 			if (handle.idx == bgfx::kInvalidHandle)
 				return handle;
 
-			if (iter->second.width == width && iter->second.height == height)
+			if (iter->second.width == width && iter->second.height == height && iter->second.format == dst_format)
 			{
 				if (iter->second.seqid == seqid)
 				{
@@ -142,7 +144,8 @@ bgfx::TextureHandle texture_manager::create_or_update_mame_texture(uint32_t form
 				}
 				else
 				{
-					const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(format, width, height, rowpixels, palette, base);
+					iter->second.seqid = seqid;
+					const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(dst_format, format, width, height, rowpixels, palette, base);
 					bgfx::updateTexture2D(handle, 0, 0, 0, 0, (uint16_t)width, (uint16_t)height, mem);
 					return handle;
 				}
@@ -151,11 +154,11 @@ bgfx::TextureHandle texture_manager::create_or_update_mame_texture(uint32_t form
 		}
 	}
 
-	const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(format, width, height, rowpixels, palette, base);
-	handle = bgfx::createTexture2D(width, height, false, 1, bgfx::TextureFormat::RGBA8, flags, nullptr);
+	const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(dst_format, format, width, height, rowpixels, palette, base);
+	handle = bgfx::createTexture2D(width, height, false, 1, dst_format, flags, nullptr);
 	bgfx::updateTexture2D(handle, 0, 0, 0, 0, (uint16_t)width, (uint16_t)height, mem);
 
-	m_mame_textures[key] = { handle, seqid, width, height };
+	m_mame_textures[key] = { handle, seqid, width, height, dst_format };
 	return handle;
 }
 
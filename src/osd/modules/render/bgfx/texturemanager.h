@@ -49,6 +49,7 @@ private:
 		uint32_t seqid;
 		int width;
 		int height;
+		bgfx::TextureFormat::Enum format;
 	};
 
 	std::map<std::string, bgfx_texture_handle_provider*> m_textures;
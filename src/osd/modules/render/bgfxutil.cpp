@@ -13,6 +13,131 @@
 
 #include "render.h"
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+namespace {
+
+// Blocks are freed once the screen has given them back and bgfx has finished with every upload
+// that referenced them; bgfx reports the latter from its render thread
+class bgfx_screen_memory : public render_bitmap_allocator
+{
+public:
+	virtual void *allocate(texture_format format, size_t bytes) override
+	{
+#ifdef LSB_FIRST
+		if (format != TEXFORMAT_RGB32)
+			return nullptr;
+
+		auto *const memory = new block{ std::make_unique<uint8_t []>(bytes), bytes, { 1U } };
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_blocks.emplace(memory->data.get(), memory);
+		return memory->data.get();
+#else
+		return nullptr;
+#endif
+	}
+
+	virtual void release(void *memory) override
+	{
+		block *released;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto const found = m_blocks.find(reinterpret_cast<const uint8_t *>(memory));
+			assert(found != m_blocks.end());
+			released = found->second;
+			m_blocks.erase(found);
+		}
+		release_reference(nullptr, released);
+	}
+
+	bool contains(const void *base, size_t size)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return find(base, size) != nullptr;
+	}
+
+	const bgfx::Memory* reference(const void *base, size_t size)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		block *const found = find(base, size);
+		if (found == nullptr)
+			return nullptr;
+
+		found->refs.fetch_add(1, std::memory_order_relaxed);
+		return bgfx::makeRef(base, uint32_t(size), &release_reference, found);
+	}
+
+private:
+	struct block
+	{
+		std::unique_ptr<uint8_t []> data;
+		size_t size;
+		std::atomic<unsigned> refs;
+	};
+
+	block *find(const void *base, size_t size) const
+	{
+		auto const start = reinterpret_cast<const uint8_t *>(base);
+		auto found = m_blocks.upper_bound(start);
+		if (found == m_blocks.begin())
+			return nullptr;
+		--found;
+		return ((start + size) <= (found->first + found->second->size)) ? found->second : nullptr;
+	}
+
+	static void release_reference(void *ptr, void *user_data)
+	{
+		block *const released = reinterpret_cast<block *>(user_data);
+		if (released->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete released;
+	}
+
+	std::mutex m_mutex;
+	std::map<const uint8_t *, block *> m_blocks;
+};
+
+bgfx_screen_memory s_screen_memory;
+
+inline size_t screen_memory_size(int width, int height, int rowpixels)
+{
+	return (size_t(height - 1) * rowpixels + width) * 4;
+}
+
+} // anonymous namespace
+
+
+
+// Unpaletted ARGB32 pixels are already BGRA8 in memory on little-endian hosts, so they can be uploaded
+// without conversion wherever the renderer supports that format; everything else is converted to RGBA8
+bgfx::TextureFormat::Enum bgfx_util::mame_texture_format(uint32_t format, const rgb_t *palette)
+{
+#ifdef LSB_FIRST
+	if (format == PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32) && palette == nullptr && (bgfx::getCaps()->formats[bgfx::TextureFormat::BGRA8] & BGFX_CAPS_FORMAT_TEXTURE_2D))
+		return bgfx::TextureFormat::BGRA8;
+#endif
+	return bgfx::TextureFormat::RGBA8;
+}
+
+const bgfx::Memory* bgfx_util::mame_texture_data_to_bgfx_texture_data(bgfx::TextureFormat::Enum dst_format, uint32_t format, int width, int height, int rowpixels, const rgb_t *palette, void *base)
+{
+	if (dst_format != bgfx::TextureFormat::BGRA8)
+		return mame_texture_data_to_bgfx_texture_data(format, width, height, rowpixels, palette, base);
+
+	// raw pixels: copy the rows straight across, or the whole block when there's no padding
+	const uint32_t* src32 = reinterpret_cast<const uint32_t*>(base);
+	if (rowpixels == width)
+		return bgfx::copy(src32, width * height * 4);
+
+	const bgfx::Memory* mem = bgfx::alloc(width * height * 4);
+	uint32_t* data = reinterpret_cast<uint32_t*>(mem->data);
+	for (int y = 0; y < height; y++)
+		memcpy(data + y * width, src32 + y * rowpixels, width * 4);
+	return mem;
+}
 
 const bgfx::Memory* bgfx_util::mame_texture_data_to_bgfx_texture_data(uint32_t format, int width, int height, int rowpixels, const rgb_t *palette, void *base)
 {
@@ -50,6 +175,26 @@ const bgfx::Memory* bgfx_util::mame_texture_data_to_bgfx_texture_data(uint32_t f
 	return mem;
 }
 
+render_bitmap_allocator &bgfx_util::screen_memory()
+{
+	return s_screen_memory;
+}
+
+// The alpha channel of RGB32 pixels is undefined, so callers must only upload by reference where nothing reads it
+bool bgfx_util::in_screen_memory(uint32_t format, int width, int height, int rowpixels, const rgb_t *palette, const void *base)
+{
+	if (format != PRIMFLAG_TEXFORMAT(TEXFORMAT_RGB32) || palette != nullptr || width <= 0 || height <= 0 || (rowpixels * 4) >= UINT16_MAX)
+		return false;
+	if (!(bgfx::getCaps()->formats[bgfx::TextureFormat::BGRA8] & BGFX_CAPS_FORMAT_TEXTURE_2D))
+		return false;
+	return s_screen_memory.contains(base, screen_memory_size(width, height, rowpixels));
+}
+
+const bgfx::Memory* bgfx_util::reference_screen_memory(int width, int height, int rowpixels, const void *base)
+{
+	return s_screen_memory.reference(base, screen_memory_size(width, height, rowpixels));
+}
+
 uint64_t bgfx_util::get_blend_state(uint32_t blend)
 {
 	switch (blend)
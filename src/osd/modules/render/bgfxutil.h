@@ -7,12 +7,21 @@
 
 #include <bgfx/bgfx.h>
 
+class render_bitmap_allocator;
+
 /* sdl_info is the information about SDL for the current screen */
 class bgfx_util
 {
 public:
+	static bgfx::TextureFormat::Enum mame_texture_format(uint32_t format, const rgb_t *palette);
 	static const bgfx::Memory* mame_texture_data_to_bgfx_texture_data(uint32_t format, int width, int height, int rowpixels, const rgb_t *palette, void *base);
+	static const bgfx::Memory* mame_texture_data_to_bgfx_texture_data(bgfx::TextureFormat::Enum dst_format, uint32_t format, int width, int height, int rowpixels, const rgb_t *palette, void *base);
 	static uint64_t get_blend_state(uint32_t blend);
+
+	// screens drawn into this memory can be uploaded as BGRA8 by reference, with a pitch of rowpixels * 4
+	static render_bitmap_allocator &screen_memory();
+	static bool in_screen_memory(uint32_t format, int width, int height, int rowpixels, const rgb_t *palette, const void *base);
+	static const bgfx::Memory* reference_screen_memory(int width, int height, int rowpixels, const void *base);
 };
 
 #endif // RENDER_BGFX_UTIL
@@ -1,6 +1,13 @@
 // license:BSD-3-Clause
 // copyright-holders:Couriersud
 
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define BLIT13_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define BLIT13_USE_SSE2 0
+#endif
+
 //============================================================
 //  INLINE
 //============================================================
@@ -115,6 +122,104 @@ FUNCTOR(op_yuv16_argb32rot, return pixel_ycc_to_rgb(&src) ; )
 
 FUNCTOR(op_yuv16pal_argb32rot, return pixel_ycc_to_rgb_pal(&src, palbase); )
 
+//============================================================
+//  Line conversions
+//============================================================
+
+template<typename _op, typename _src_type, typename _dest_type>
+inline void texcopy_scalar(const _op &op, _dest_type *dst, const _src_type *src, int count, const rgb_t *palbase)
+{
+	while (count > 0) {
+		*dst++ = op.op(*src++, palbase);
+		count--;
+	}
+}
+
+// palette lookups don't vectorise, so anything without an overload below goes a pixel at a time
+template<typename _op, typename _src_type, typename _dest_type>
+inline void texcopy_line(const _op &op, _dest_type *dst, const _src_type *src, int count, const rgb_t *palbase)
+{
+	texcopy_scalar(op, dst, src, count, palbase);
+}
+
+#if BLIT13_USE_SSE2
+
+inline void texcopy_line(const op_rgb32_argb32<uint32_t, uint32_t> &op, uint32_t *dst, const uint32_t *src, int count, const rgb_t *palbase)
+{
+	const __m128i alpha = _mm_set1_epi32(0xff000000);
+	for ( ; count >= 4; count -= 4, src += 4, dst += 4)
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_loadu_si128((const __m128i *)src), alpha));
+	texcopy_scalar(op, dst, src, count, palbase);
+}
+
+inline void texcopy_line(const op_rgb15_argb32<uint16_t, uint32_t> &op, uint32_t *dst, const uint16_t *src, int count, const rgb_t *palbase)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alpha = _mm_set1_epi32(0xff000000);
+	const __m128i rmask = _mm_set1_epi32(0x7c00);
+	const __m128i gmask = _mm_set1_epi32(0x03e0);
+	const __m128i bmask = _mm_set1_epi32(0x001f);
+	for ( ; count >= 8; count -= 8, src += 8, dst += 8) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)src);
+		for (int half = 0; half < 2; half++) {
+			const __m128i p = half ? _mm_unpackhi_epi16(pixels, zero) : _mm_unpacklo_epi16(pixels, zero);
+			const __m128i b = _mm_and_si128(p, bmask);
+			__m128i result = _mm_or_si128(alpha, _mm_slli_epi32(_mm_and_si128(p, rmask), 9));
+			result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(p, gmask), 6));
+			result = _mm_or_si128(result, _mm_or_si128(_mm_slli_epi32(b, 3), _mm_srli_epi32(b, 2)));
+			_mm_storeu_si128((__m128i *)(dst + half * 4), result);
+		}
+	}
+	texcopy_scalar(op, dst, src, count, palbase);
+}
+
+inline void texcopy_line(const op_rgb15_argb1555<uint16_t, uint16_t> &op, uint16_t *dst, const uint16_t *src, int count, const rgb_t *palbase)
+{
+	const __m128i alpha = _mm_set1_epi16(uint16_t(0x8000));
+	for ( ; count >= 8; count -= 8, src += 8, dst += 8)
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_loadu_si128((const __m128i *)src), alpha));
+	texcopy_scalar(op, dst, src, count, palbase);
+}
+
+inline void texcopy_line(const op_argb32_rgb32<uint32_t, uint32_t> &op, uint32_t *dst, const uint32_t *src, int count, const rgb_t *palbase)
+{
+	// x / 255 == (x + 1 + (x >> 8)) >> 8 for all products of two bytes
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi16(1);
+	const __m128i alpha = _mm_set1_epi32(0xff000000);
+	for ( ; count >= 4; count -= 4, src += 4, dst += 4) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)src);
+		__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+		__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+		lo = _mm_mullo_epi16(lo, _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+		hi = _mm_mullo_epi16(hi, _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+		lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one), _mm_srli_epi16(lo, 8)), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one), _mm_srli_epi16(hi, 8)), 8);
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_packus_epi16(lo, hi), alpha));
+	}
+	texcopy_scalar(op, dst, src, count, palbase);
+}
+
+inline void texcopy_line(const op_yuv16_yvyu<uint32_t, uint32_t> &op, uint32_t *dst, const uint32_t *src, int count, const rgb_t *palbase)
+{
+	for ( ; count >= 4; count -= 4, src += 4, dst += 4) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)src);
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_srli_epi32(pixels, 8), _mm_slli_epi32(pixels, 24)));
+	}
+	texcopy_scalar(op, dst, src, count, palbase);
+}
+
+inline void texcopy_line(const op_yuv16_yuy2<uint32_t, uint32_t> &op, uint32_t *dst, const uint32_t *src, int count, const rgb_t *palbase)
+{
+	for ( ; count >= 4; count -= 4, src += 4, dst += 4) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)src);
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_srli_epi16(pixels, 8), _mm_slli_epi16(pixels, 8)));
+	}
+	texcopy_scalar(op, dst, src, count, palbase);
+}
+
+#endif // BLIT13_USE_SSE2
+
 //============================================================
 //  Copy and rotation
 //============================================================
@@ -138,17 +243,12 @@ struct blit_texcopy : public blit_base
 	void texop(const texture_info *texture, const render_texinfo *texsource) const override
 	{
 		ATTR_UNUSED const rgb_t *palbase = texsource->palette;
-		int x, y;
+		int y;
 		/* loop over Y */
 		for (y = 0; y < texsource->height; y++) {
 			_src_type *src = (_src_type *)texsource->base + y * texsource->rowpixels / (_len_div);
 			_dest_type *dst = (_dest_type *)((uint8_t *)texture->m_pixels + y * texture->m_pitch);
-			x = texsource->width / (_len_div);
-			while (x > 0) {
-				*dst++ = m_op.op(*src, palbase);
-				++src;
-				x--;
-			}
+			texcopy_line(m_op, dst, src, texsource->width / (_len_div), palbase);
 		}
 	}
 private:
@@ -11,10 +11,29 @@
 #ifndef __RENDER_COPYUTIL__
 #define __RENDER_COPYUTIL__
 
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define COPYUTIL_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define COPYUTIL_USE_SSE2 0
+#endif
+
 
 class copy_util
 {
 public:
+#if COPYUTIL_USE_SSE2
+	// exchange the red and blue bytes of four ARGB pixels
+	static inline __m128i swap_red_blue(__m128i pixels)
+	{
+		const __m128i agmask = _mm_set1_epi32(0xff00ff00);
+		const __m128i bytemask = _mm_set1_epi32(0x000000ff);
+		__m128i result = _mm_and_si128(pixels, agmask);
+		result = _mm_or_si128(result, _mm_and_si128(_mm_srli_epi32(pixels, 16), bytemask));
+		return _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(pixels, bytemask), 16));
+	}
+#endif
+
 	static inline void copyline_palette16(uint32_t *dst, const uint16_t *src, int width, const rgb_t *palette)
 	{
 		for (int x = 0; x < width; x++)
@@ -50,7 +69,13 @@ public:
 		// direct case
 		else
 		{
-			for (x = 0; x < width; x++)
+			x = 0;
+#if COPYUTIL_USE_SSE2
+			const __m128i alpha = _mm_set1_epi32(0xff000000);
+			for ( ; x + 4 <= width; x += 4, src += 4, dst += 4)
+				_mm_storeu_si128((__m128i *)dst, _mm_or_si128(swap_red_blue(_mm_loadu_si128((const __m128i *)src)), alpha));
+#endif
+			for ( ; x < width; x++)
 			{
 				rgb_t srcpix = *src++;
 				*dst++ = 0xff000000 | (srcpix.b() << 16) | (srcpix.g() << 8) | srcpix.r();
@@ -74,7 +99,12 @@ public:
 		// direct case
 		else
 		{
-			for (x = 0; x < width; x++)
+			x = 0;
+#if COPYUTIL_USE_SSE2
+			for ( ; x + 4 <= width; x += 4, src += 4, dst += 4)
+				_mm_storeu_si128((__m128i *)dst, swap_red_blue(_mm_loadu_si128((const __m128i *)src)));
+#endif
+			for ( ; x < width; x++)
 			{
 				rgb_t srcpix = *src++;
 				*dst++ = (srcpix.a() << 24) | (srcpix.b() << 16) | (srcpix.g() << 8) | srcpix.r();
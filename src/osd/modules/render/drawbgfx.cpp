@@ -280,7 +280,7 @@ int renderer_bgfx::create()
 		bgfx::init(init);
 		bgfx::reset(m_width[win->m_index], m_height[win->m_index], video_config.waitvsync ? BGFX_RESET_VSYNC : BGFX_RESET_NONE);
 		// Enable debug text.
-		bgfx::setDebug(m_options.bgfx_debug() ? BGFX_DEBUG_STATS : BGFX_DEBUG_TEXT);
+		bgfx::setDebug((m_options.bgfx_debug() ? BGFX_DEBUG_STATS : BGFX_DEBUG_TEXT) | (m_options.bgfx_profile() ? BGFX_DEBUG_PROFILER : 0));
 		m_dimensions = osd_dim(m_width[0], m_height[0]);
 	}
 
@@ -390,6 +390,9 @@ bool renderer_bgfx::init(running_machine &machine)
 		return true;
 	}
 
+	// let screens draw where their frames can be uploaded from without a copy
+	machine.render().set_screen_allocator(&bgfx_util::screen_memory());
+
 	return false;
 }
 
@@ -886,12 +889,36 @@ int renderer_bgfx::draw(int update)
 			update_recording();
 		}
 
+		if (m_options.bgfx_profile())
+		{
+			draw_pass_timings();
+		}
+
 		bgfx::frame();
 	}
 
 	return 0;
 }
 
+//============================================================
+//  draw_pass_timings - overlay the GPU time each view took,
+//  as last reported; chain passes are named after their entry
+//============================================================
+
+void renderer_bgfx::draw_pass_timings()
+{
+	const bgfx::Stats* stats = bgfx::getStats();
+	const double to_ms = (stats->gpuTimerFreq != 0) ? (1000.0 / double(stats->gpuTimerFreq)) : 0.0;
+
+	bgfx::dbgTextClear();
+	bgfx::dbgTextPrintf(0, 0, 0x0f, "GPU %7.3f ms", double(stats->gpuTimeEnd - stats->gpuTimeBegin) * to_ms);
+	for (uint16_t index = 0; index < stats->numViews; index++)
+	{
+		const bgfx::ViewStats& view = stats->viewStats[index];
+		bgfx::dbgTextPrintf(0, index + 1, 0x0f, "%3d %-32.32s %7.3f ms", view.view, view.name, double(view.gpuTimeElapsed) * to_ms);
+	}
+}
+
 void renderer_bgfx::update_recording()
 {
 	bgfx::blit(s_current_view > 0 ? s_current_view - 1 : 0, m_avi_texture, 0, 0, bgfx::getTexture(m_avi_target->target()));
@@ -1238,6 +1265,12 @@ std::vector<ui::menu_item> renderer_bgfx::get_slider_list()
 void renderer_bgfx::set_sliders_dirty()
 {
 	m_sliders_dirty = true;
+
+	// the chains' active passes may have changed too
+	if (m_chains != nullptr)
+	{
+		m_chains->invalidate_chains();
+	}
 }
 
 uint32_t renderer_bgfx::get_window_width(uint32_t index) const {
@@ -86,6 +86,7 @@ private:
 	void vertex(ScreenVertex* vertex, float x, float y, float z, uint32_t rgba, float u, float v);
 	void render_avi_quad();
 	void update_recording();
+	void draw_pass_timings();
 
 	bool update_dimensions();
 
@@ -0,0 +1,242 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+//============================================================
+//
+//  shmpublish.cpp - publishes rendered frames and mixed audio
+//  into shared memory for other processes
+//
+//============================================================
+
+#include "emu.h"
+#include "render.h"
+#include "rendersw.hxx"
+
+#include "shmpublish.h"
+#include "modules/lib/osdobj_common.h"
+
+#include <algorithm>
+#include <thread>
+
+
+namespace {
+
+constexpr std::uint32_t SHM_ALIGN = 64;
+
+inline std::uint32_t shm_align(std::uint64_t value)
+{
+	return std::uint32_t((value + SHM_ALIGN - 1) & ~std::uint64_t(SHM_ALIGN - 1));
+}
+
+typedef software_renderer<u32, 0,0,0, 16,8,0, false, false> shm_renderer_rgb32;
+typedef software_renderer<u32, 0,0,0, 16,8,0, false, true> shm_renderer_rgb32_bilinear;
+typedef software_renderer<u16, 3,2,3, 11,5,0, false, false> shm_renderer_rgb565;
+typedef software_renderer<u16, 3,2,3, 11,5,0, false, true> shm_renderer_rgb565_bilinear;
+
+} // anonymous namespace
+
+
+//============================================================
+//  shm_publisher - constructor
+//============================================================
+
+shm_publisher::shm_publisher(running_machine &machine, osd_options const &options)
+	: m_machine(machine)
+	, m_header(nullptr)
+	, m_target(nullptr)
+	, m_frames(0)
+	, m_samples(0)
+{
+	// a hidden target shows the screens without artwork, like a snapshot
+	m_target = machine.render().target_alloc(nullptr, RENDER_CREATE_HIDDEN);
+	m_target->set_backdrops_enabled(false);
+	m_target->set_overlays_enabled(false);
+	m_target->set_bezels_enabled(false);
+	m_target->set_cpanels_enabled(false);
+	m_target->set_marquees_enabled(false);
+	m_target->set_screen_overlay_enabled(false);
+
+	// the frame size is fixed for the run, so consumers can map it once
+	s32 width, height;
+	if (sscanf(options.shm_size(), "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0)
+		m_target->compute_minimum_size(width, height);
+	m_target->set_bounds(width, height);
+
+	std::uint32_t const format = !strcmp(options.shm_format(), "rgb565") ? SHM_FORMAT_RGB565 : SHM_FORMAT_RGB32;
+	if (format == SHM_FORMAT_RGB32 && strcmp(options.shm_format(), "rgb32"))
+		osd_printf_warning("Unknown -shm_format %s, using rgb32\n", options.shm_format());
+	std::uint32_t const pitch = shm_align(std::uint64_t(width) * ((format == SHM_FORMAT_RGB565) ? 2 : 4));
+	std::uint32_t const slots = (std::max)(options.shm_frames(), 1);
+	std::uint32_t const rate = (std::max)(machine.sample_rate(), 1);
+
+	// lay out the header, frame slots and a second of audio
+	std::uint32_t const frame_offset = shm_align(sizeof(shm_publish_header));
+	std::uint32_t const frame_data = shm_align(sizeof(shm_publish_slot));
+	std::uint32_t const frame_stride = shm_align(std::uint64_t(frame_data) + std::uint64_t(pitch) * height);
+	std::uint64_t const audio_offset = std::uint64_t(frame_offset) + std::uint64_t(frame_stride) * slots;
+	std::uint64_t const size = audio_offset + std::uint64_t(rate) * 2 * sizeof(std::int16_t);
+	if (audio_offset > 0xffffffffU)
+	{
+		osd_printf_error("Shared memory frames too large: %dx%d x %u\n", width, height, slots);
+		return;
+	}
+
+	m_memory = osd::shared_memory::create(options.shm(), size);
+	if (!m_memory)
+	{
+		osd_printf_error("Unable to create shared memory %s (%u bytes)\n", options.shm(), unsigned(size));
+		return;
+	}
+
+	m_header = new (m_memory->data()) shm_publish_header;
+	m_header->version = SHM_PUBLISH_VERSION;
+	m_header->frame_width = width;
+	m_header->frame_height = height;
+	m_header->frame_pitch = pitch;
+	m_header->frame_format = format;
+	m_header->frame_slots = slots;
+	m_header->frame_offset = frame_offset;
+	m_header->frame_stride = frame_stride;
+	m_header->frame_data = frame_data;
+	m_header->audio_rate = rate;
+	m_header->audio_capacity = rate;
+	m_header->audio_offset = std::uint32_t(audio_offset);
+	m_header->lockstep = options.shm_lockstep() ? 1 : 0;
+	m_header->frame_count.store(0, std::memory_order_relaxed);
+	m_header->audio_count.store(0, std::memory_order_relaxed);
+	m_header->frame_request.store(0, std::memory_order_relaxed);
+	m_header->quit.store(0, std::memory_order_relaxed);
+	for (std::uint32_t slot = 0; slot < slots; slot++)
+		new (reinterpret_cast<std::uint8_t *>(m_memory->data()) + frame_offset + std::uint64_t(frame_stride) * slot) shm_publish_slot{ { 0 }, 0, 0 };
+
+	// readers can go once the magic number shows up
+	std::atomic_thread_fence(std::memory_order_release);
+	m_header->magic = SHM_PUBLISH_MAGIC;
+
+	osd_printf_verbose("Publishing %dx%d %s frames and %u Hz audio to shared memory %s%s\n",
+			width, height, (format == SHM_FORMAT_RGB565) ? "rgb565" : "rgb32", rate, options.shm(), m_header->lockstep ? " in lockstep" : "");
+}
+
+
+//============================================================
+//  shm_publisher - destructor
+//============================================================
+
+shm_publisher::~shm_publisher()
+{
+	if (m_target)
+		m_machine.render().target_free(m_target);
+}
+
+
+//============================================================
+//  frame - render the current frame into the next
+//  slot, then wait for the reader in lockstep mode
+//============================================================
+
+void shm_publisher::frame(bool skip_redraw)
+{
+	if (!m_memory || m_machine.paused())
+		return;
+
+	if (m_header->quit.load(std::memory_order_acquire))
+	{
+		m_machine.schedule_exit();
+		return;
+	}
+
+	// skipped frames aren't drawn or counted
+	if (!skip_redraw)
+	{
+		std::uint64_t const number = ++m_frames;
+		std::uint8_t *const base = reinterpret_cast<std::uint8_t *>(m_memory->data()) + m_header->frame_offset + std::uint64_t(m_header->frame_stride) * ((number - 1) % m_header->frame_slots);
+		shm_publish_slot &slot = *reinterpret_cast<shm_publish_slot *>(base);
+		void *const pixels = base + m_header->frame_data;
+
+		slot.sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		// the software renderer draws straight into the slot, converting and scaling on the way
+		attotime const now = m_machine.time();
+		slot.seconds = now.seconds();
+		slot.attoseconds = now.attoseconds();
+		u32 const width = m_header->frame_width, height = m_header->frame_height;
+		bool const bilinear = m_machine.options().snap_bilinear();
+		render_primitive_list &primlist = m_target->get_primitives();
+		primlist.acquire_lock();
+		if (m_header->frame_format == SHM_FORMAT_RGB565)
+		{
+			u32 const rowpixels = m_header->frame_pitch / 2;
+			if (bilinear)
+				shm_renderer_rgb565_bilinear::draw_primitives(primlist, pixels, width, height, rowpixels, m_machine.render().work_queue(), m_machine.render().work_bands());
+			else
+				shm_renderer_rgb565::draw_primitives(primlist, pixels, width, height, rowpixels, m_machine.render().work_queue(), m_machine.render().work_bands());
+		}
+		else
+		{
+			u32 const rowpixels = m_header->frame_pitch / 4;
+			if (bilinear)
+				shm_renderer_rgb32_bilinear::draw_primitives(primlist, pixels, width, height, rowpixels, m_machine.render().work_queue(), m_machine.render().work_bands());
+			else
+				shm_renderer_rgb32::draw_primitives(primlist, pixels, width, height, rowpixels, m_machine.render().work_queue(), m_machine.render().work_bands());
+		}
+		primlist.release_lock();
+
+		slot.sequence.store(number, std::memory_order_release);
+		m_header->frame_count.store(number, std::memory_order_release);
+	}
+
+	if (m_header->lockstep)
+		wait_for_request();
+}
+
+
+//============================================================
+//  audio - append mixed samples to the ring
+//============================================================
+
+void shm_publisher::audio(const int16_t *buffer, int samples_this_frame)
+{
+	if (!m_memory || samples_this_frame <= 0)
+		return;
+
+	// anything older than the ring holds is lost, as it would be behind a reader that fell that far behind
+	std::uint32_t const capacity = m_header->audio_capacity;
+	std::int16_t *const ring = reinterpret_cast<std::int16_t *>(reinterpret_cast<std::uint8_t *>(m_memory->data()) + m_header->audio_offset);
+	std::uint32_t const count = (std::min)(std::uint32_t(samples_this_frame), capacity);
+	buffer += 2 * (samples_this_frame - count);
+	m_samples += samples_this_frame - count;
+
+	std::uint32_t const start = m_samples % capacity;
+	std::uint32_t const first = (std::min)(count, capacity - start);
+	std::copy_n(buffer, 2 * first, ring + 2 * start);
+	std::copy_n(buffer + 2 * first, 2 * (count - first), ring);
+	m_samples += count;
+
+	m_header->audio_count.store(m_samples, std::memory_order_release);
+}
+
+
+//============================================================
+//  wait_for_request - hold emulation until the reader
+//  asks for another frame or to quit
+//============================================================
+
+void shm_publisher::wait_for_request()
+{
+	// spin briefly, since a reader stepping frame by frame usually answers quickly
+	for (int spins = 0; ; spins++)
+	{
+		if (m_header->frame_request.load(std::memory_order_acquire) > m_frames)
+			return;
+		if (m_header->quit.load(std::memory_order_acquire))
+		{
+			m_machine.schedule_exit();
+			return;
+		}
+
+		if (spins < 1000)
+			std::this_thread::yield();
+		else
+			osd_sleep(osd_ticks_per_second() / 1000);
+	}
+}
@@ -0,0 +1,120 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+//============================================================
+//
+//  shmpublish.h - publishes rendered frames and mixed audio
+//  into shared memory for other processes
+//
+//  The region named by -shm holds, in order:
+//    - a shm_publish_header
+//    - header.frame_slots frame slots, each header.frame_stride
+//      bytes apart starting at header.frame_offset: a
+//      shm_publish_slot followed, at header.frame_data, by
+//      frame_height rows of frame_pitch bytes
+//    - a ring of header.audio_capacity stereo pairs of 16-bit
+//      samples at header.audio_offset
+//
+//  Frame N (counting from 1) goes in slot (N - 1) % frame_slots.
+//  A slot's sequence is 0 while it is written, then N; a reader
+//  should copy the pixels and check the sequence is unchanged.
+//  frame_count is raised to N once frame N is complete.
+//
+//  Audio sample pair S goes at ring index S % audio_capacity, and
+//  audio_count is raised once the samples are in place.
+//
+//  With lockstep set, emulation stops after publishing each frame
+//  until the reader raises frame_request above frame_count.  A
+//  reader can set quit to ask the emulator to exit.
+//
+//============================================================
+
+#ifndef MAME_OSD_MODULES_RENDER_SHMPUBLISH_H
+#define MAME_OSD_MODULES_RENDER_SHMPUBLISH_H
+
+#pragma once
+
+#include "modules/lib/osdlib.h"
+
+#include <atomic>
+#include <cstdint>
+
+
+//============================================================
+//  SHARED LAYOUT
+//============================================================
+
+enum : std::uint32_t
+{
+	SHM_PUBLISH_MAGIC = 0x4d53484d, // 'MSHM'
+	SHM_PUBLISH_VERSION = 1
+};
+
+enum : std::uint32_t
+{
+	SHM_FORMAT_RGB32 = 0,   // 32-bit words, 0xXXRRGGBB
+	SHM_FORMAT_RGB565 = 1   // 16-bit words, red in the top bits
+};
+
+struct shm_publish_header
+{
+	std::uint32_t               magic;          // SHM_PUBLISH_MAGIC, written last
+	std::uint32_t               version;        // SHM_PUBLISH_VERSION
+	std::uint32_t               frame_width;    // pixels per row
+	std::uint32_t               frame_height;   // rows per frame
+	std::uint32_t               frame_pitch;    // bytes per row
+	std::uint32_t               frame_format;   // SHM_FORMAT_*
+	std::uint32_t               frame_slots;    // frames kept
+	std::uint32_t               frame_offset;   // offset of the first slot
+	std::uint32_t               frame_stride;   // bytes from one slot to the next
+	std::uint32_t               frame_data;     // offset of the pixels within a slot
+	std::uint32_t               audio_rate;     // samples per second
+	std::uint32_t               audio_capacity; // stereo pairs in the ring
+	std::uint32_t               audio_offset;   // offset of the ring
+	std::uint32_t               lockstep;       // nonzero if emulation waits for frame_request
+	std::atomic<std::uint64_t>  frame_count;    // frames published
+	std::atomic<std::uint64_t>  audio_count;    // stereo pairs published
+	std::atomic<std::uint64_t>  frame_request;  // written by the reader in lockstep mode
+	std::atomic<std::uint32_t>  quit;           // written by the reader to end emulation
+};
+
+struct shm_publish_slot
+{
+	std::atomic<std::uint64_t>  sequence;       // frame number, or 0 while being written
+	std::int64_t                seconds;        // emulated time of the frame
+	std::int64_t                attoseconds;
+};
+
+
+//============================================================
+//  TYPE DEFINITIONS
+//============================================================
+
+class osd_options;
+class render_target;
+class running_machine;
+
+class shm_publisher
+{
+public:
+	shm_publisher(running_machine &machine, osd_options const &options);
+	~shm_publisher();
+
+	// getters
+	bool valid() const { return m_memory != nullptr; }
+
+	// called once per frame and for each batch of mixed audio
+	void frame(bool skip_redraw);
+	void audio(const int16_t *buffer, int samples_this_frame);
+
+private:
+	void wait_for_request();
+
+	running_machine &           m_machine;
+	osd::shared_memory::ptr     m_memory;
+	shm_publish_header *        m_header;
+	render_target *             m_target;
+	std::uint64_t               m_frames;
+	std::uint64_t               m_samples;
+};
+
+#endif // MAME_OSD_MODULES_RENDER_SHMPUBLISH_H
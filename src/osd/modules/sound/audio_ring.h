@@ -0,0 +1,202 @@
+// license:BSD-3-Clause
+// copyright-holders:MAME contributors
+//============================================================
+//
+//  audio_ring.h - lock-free stereo sample ring shared by the
+//  sound modules, with adaptive latency and rate control
+//
+//  One thread writes (emulation, through update_audio_stream)
+//  and one reads (the audio callback).  The writer aims to keep
+//  a target number of frames queued: it stretches or squeezes
+//  each batch by up to RATE_CONTROL_RANGE so the fill drifts
+//  back to the target instead of clicking, raises the target
+//  when the reader runs dry and lowers it again after a stretch
+//  with plenty to spare.
+//
+//============================================================
+
+#ifndef MAME_OSD_MODULES_SOUND_AUDIO_RING_H
+#define MAME_OSD_MODULES_SOUND_AUDIO_RING_H
+
+#pragma once
+
+#include "osdcomm.h"
+#include "osdcore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+
+//============================================================
+//  TYPE DEFINITIONS
+//============================================================
+
+class audio_ring
+{
+public:
+	// largest speed change used to steer the fill, and how long the fill must stay high before the target drops
+	static constexpr double RATE_CONTROL_RANGE = 0.005;
+	static constexpr int STABLE_SECONDS = 5;
+
+	// construction; latencies are in frames
+	audio_ring(int sample_rate, u32 target, u32 min_target, u32 max_target)
+		: m_sample_rate(sample_rate)
+		, m_min_target(std::max<u32>(min_target, 1))
+		, m_max_target(std::max(max_target, m_min_target))
+		, m_target(std::min(std::max(target, m_min_target), m_max_target))
+		, m_step(std::max<u32>((m_max_target - m_min_target) / 8, sample_rate / 200))
+		, m_read(0)
+		, m_write(0)
+		, m_underflowed(false)
+		, m_started(false)
+		, m_phase(0.0)
+		, m_stable_frames(0)
+		, m_lowest_fill(~u32(0))
+		, m_last_write(0)
+		, m_underflows(0)
+		, m_overflows(0)
+	{
+		// room for the largest target plus a couple of batches on top
+		u32 capacity = 1;
+		while (capacity < 2 * m_max_target + u32(sample_rate) / 10)
+			capacity <<= 1;
+		m_mask = capacity - 1;
+		m_buffer.resize(2 * capacity, 0);
+		m_last[0] = m_last[1] = 0;
+	}
+
+	// getters
+	u32 target() const { return m_target; }
+	u32 fill() const { return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire); }
+	unsigned underflows() const { return m_underflows; }
+	unsigned overflows() const { return m_overflows; }
+
+	//------------------------------------------------------------
+	//  write - queue a batch of stereo frames, resampled
+	//  slightly to steer the fill towards the target
+	//------------------------------------------------------------
+
+	void write(const s16 *data, int frames)
+	{
+		if (frames <= 0)
+			return;
+
+		u32 const read = m_read.load(std::memory_order_acquire);
+		u32 write = m_write.load(std::memory_order_relaxed);
+
+		// running dry after a long gap (a pause, say) isn't the target's fault
+		osd_ticks_t const now = osd_ticks();
+		bool const resumed = (now - m_last_write) > osd_ticks_per_second() / m_sample_rate * m_max_target;
+		m_last_write = now;
+
+		// the first batch and each underflow start from silence at the target fill
+		bool const underflowed = m_underflowed.exchange(false, std::memory_order_acq_rel);
+		if (underflowed || !m_started)
+		{
+			if (underflowed && m_started && !resumed)
+			{
+				m_underflows++;
+				m_target = std::min(m_target + m_step, m_max_target);
+			}
+			u32 const pending = write - read;
+			for (u32 pad = pending; pad < m_target; pad++, write++)
+				m_buffer[2 * (write & m_mask)] = m_buffer[2 * (write & m_mask) + 1] = 0;
+			m_stable_frames = 0;
+			m_lowest_fill = ~u32(0);
+			m_started = true;
+		}
+
+		// lower the target once the fill has stayed well above it for a while
+		u32 const fill = write - read;
+		m_lowest_fill = std::min(m_lowest_fill, fill);
+		m_stable_frames += frames;
+		if (m_stable_frames >= u32(m_sample_rate) * STABLE_SECONDS)
+		{
+			if (m_lowest_fill > m_step && m_target > m_min_target)
+				m_target = std::max(m_target - m_step, m_min_target);
+			m_stable_frames = 0;
+			m_lowest_fill = ~u32(0);
+		}
+
+		// step through the input a little faster when over the target and a little slower under it
+		double const error = (double(fill) - double(m_target)) / double(std::max<u32>(m_target, 1));
+		double const step = 1.0 + std::min(std::max(error * RATE_CONTROL_RANGE, -RATE_CONTROL_RANGE), RATE_CONTROL_RANGE);
+		double position = m_phase;
+		for ( ; position < double(frames); position += step)
+		{
+			if (write - read > m_mask)
+			{
+				m_overflows++;
+				break;
+			}
+
+			// blend towards each input frame from the one before, so batches join smoothly
+			int const index = int(position);
+			double const frac = position - index;
+			s16 const *const next = data + 2 * index;
+			s16 const *const prev = index ? (next - 2) : m_last;
+			u32 const slot = 2 * (write & m_mask);
+			m_buffer[slot + 0] = s16(prev[0] + (next[0] - prev[0]) * frac);
+			m_buffer[slot + 1] = s16(prev[1] + (next[1] - prev[1]) * frac);
+			write++;
+		}
+		m_phase = std::max(position - double(frames), 0.0);
+		m_last[0] = data[2 * frames - 2];
+		m_last[1] = data[2 * frames - 1];
+
+		m_write.store(write, std::memory_order_release);
+	}
+
+	//------------------------------------------------------------
+	//  read - take up to the requested number of frames,
+	//  padding with silence and flagging an underflow if
+	//  the writer hasn't kept up
+	//------------------------------------------------------------
+
+	u32 read(s16 *dest, u32 frames)
+	{
+		u32 const write = m_write.load(std::memory_order_acquire);
+		u32 read = m_read.load(std::memory_order_relaxed);
+		u32 const count = std::min(write - read, frames);
+
+		u32 const first = std::min(count, m_mask + 1 - (read & m_mask));
+		std::memcpy(dest, &m_buffer[2 * (read & m_mask)], first * 2 * sizeof(s16));
+		std::memcpy(dest + 2 * first, &m_buffer[0], (count - first) * 2 * sizeof(s16));
+		m_read.store(read + count, std::memory_order_release);
+
+		if (count < frames)
+		{
+			std::memset(dest + 2 * count, 0, (frames - count) * 2 * sizeof(s16));
+			m_underflowed.store(true, std::memory_order_release);
+		}
+		return count;
+	}
+
+private:
+	int const                   m_sample_rate;
+	u32 const                   m_min_target;
+	u32 const                   m_max_target;
+	u32                         m_target;       // frames the writer aims to keep queued
+	u32 const                   m_step;         // target change on underflow or once stable
+	u32                         m_mask;         // capacity in frames, minus one
+	std::vector<s16>            m_buffer;       // interleaved stereo frames
+
+	// shared between the writer and the reader; the frame counters wrap
+	std::atomic<u32>            m_read;
+	std::atomic<u32>            m_write;
+	std::atomic<bool>           m_underflowed;
+
+	// writer state
+	bool                        m_started;
+	double                      m_phase;        // position of the next output frame within the next batch
+	s16                         m_last[2];      // last frame of the previous batch, for blending
+	u32                         m_stable_frames;
+	u32                         m_lowest_fill;
+	osd_ticks_t                 m_last_write;
+	unsigned                    m_underflows;
+	unsigned                    m_overflows;
+};
+
+#endif // MAME_OSD_MODULES_SOUND_AUDIO_RING_H
@@ -9,6 +9,7 @@
 *******************************************************************c********/
 
 #include "sound_module.h"
+#include "audio_ring.h"
 #include "modules/osdmodule.h"
 
 #ifndef NO_USE_PORTAUDIO
@@ -49,87 +50,6 @@ public:
 	virtual void set_mastervolume(int attenuation) override;
 
 private:
-	// Lock free SPSC ring buffer
-	template <typename T>
-	struct audio_buffer {
-		T*               buf;
-		int              size;
-		int              reserve;
-		std::atomic<int> playpos, writepos;
-
-		audio_buffer(int size, int reserve) : size(size + reserve), reserve(reserve) {
-			playpos = writepos = 0;
-			buf = new T[this->size];
-		}
-
-		~audio_buffer() { delete[] buf; }
-
-		int count() {
-			int diff = writepos - playpos;
-			return diff < 0 ? size + diff : diff;
-		}
-
-		void increment_writepos(int n) {
-			writepos.store((writepos + n) % size);
-		}
-
-		int write(const T* src, int n, int attenuation) {
-			n = std::min<int>(n, size - reserve - count());
-
-			if (writepos + n > size) {
-				att_memcpy(buf + writepos, src, sizeof(T) * (size - writepos), attenuation);
-				att_memcpy(buf, src + (size - writepos), sizeof(T) * (n - (size - writepos)), attenuation);
-			} else {
-				att_memcpy(buf + writepos, src, sizeof(T) * n, attenuation);
-			}
-
-			increment_writepos(n);
-
-			return n;
-		}
-
-		void increment_playpos(int n) {
-			playpos.store((playpos + n) % size);
-		}
-
-		int read(T* dst, int n) {
-			n = std::min<int>(n, count());
-
-			if (playpos + n > size) {
-				std::memcpy(dst, buf + playpos, sizeof(T) * (size - playpos));
-				std::memcpy(dst + (size - playpos), buf, sizeof(T) * (n - (size - playpos)));
-			} else {
-				std::memcpy(dst, buf + playpos, sizeof(T) * n);
-			}
-
-			increment_playpos(n);
-
-			return n;
-		}
-
-		int clear(int n) {
-			n = std::min<int>(n, size - reserve - count());
-
-			if (writepos + n > size) {
-				std::memset(buf + writepos, 0, sizeof(T) * (size - writepos));
-				std::memset(buf, 0, sizeof(T) * (n - (size - writepos)));
-			} else {
-				std::memset(buf + writepos, 0, sizeof(T) * n);
-			}
-
-			increment_writepos(n);
-
-			return n;
-		}
-
-		void att_memcpy(T* dest, const T* data, int n, int attenuation) {
-			int level = powf(10.0, attenuation / 20.0) * 32768;
-			n /= sizeof(T);
-			while (n--)
-				*dest++ = (*data++ * level) >> 15;
-		}
-	};
-
 	enum
 	{
 		LATENCY_MIN = 1,
@@ -150,20 +70,9 @@ private:
 	PaStream*           m_pa_stream;
 	PaError             err;
 
-	int                 m_attenuation;
-
-	audio_buffer<s16>*  m_ab;
+	std::atomic<int>    m_attenuation;
 
-	std::atomic<bool>   m_has_underflowed;
-	std::atomic<bool>   m_has_overflowed;
-	unsigned            m_underflows;
-	unsigned            m_overflows;
-
-	int                 m_skip_threshold; // this many samples in the buffer ~1 second in a row count as an overflow
-	osd_ticks_t         m_osd_ticks;
-	osd_ticks_t         m_skip_threshold_ticks;
-	osd_ticks_t         m_osd_tps;
-	int                 m_buffer_min_ct;
+	audio_ring*         m_ab;               // lock-free queue with adaptive latency
 
 #if LOG_BUFCNT
 	std::stringstream   m_log;
@@ -184,23 +93,9 @@ int sound_pa::init(osd_options const &options)
 		return 0;
 
 	m_attenuation           = options.volume();
-	m_underflows            = 0;
-	m_overflows             = 0;
-	m_has_overflowed        = false;
-	m_has_underflowed       = false;
-	m_osd_ticks             = 0;
-	m_skip_threshold_ticks  = 0;
-	m_osd_tps               = osd_ticks_per_second();
-	m_buffer_min_ct         = INT_MAX;
+	m_ab                    = nullptr;
 	m_audio_latency         = std::min<int>(std::max<int>(m_audio_latency, LATENCY_MIN), LATENCY_MAX);
 
-	try {
-		m_ab = new audio_buffer<s16>(m_sample_rate, 2);
-	} catch (std::bad_alloc&) {
-		osd_printf_error("PortAudio: Unable to allocate audio buffer, sound is disabled\n");
-		goto error;
-	}
-
 	err = Pa_Initialize();
 
 	if (err != paNoError) goto pa_error;
@@ -261,14 +156,29 @@ int sound_pa::init(osd_options const &options)
 	// clamp to a probable figure
 	callback_interval = std::min<double>(callback_interval, 20.0);
 
-	// set the best guess callback interval to allowed count, each audio_latency step > 1 adds 20 ms
-	m_skip_threshold = ((std::max<double>(callback_interval, 10.0) + (m_audio_latency - 1) * 20.0) / 1000.0) * m_sample_rate * 2 + 0.5f;
+	// start from the best guess callback interval, each audio_latency step > 1 adds 20 ms; the ring
+	// grows towards LATENCY_MAX on underflows and falls back to one callback interval when stable
+	{
+		double const interval = std::max<double>(callback_interval, 10.0);
+		u32 const target = ((interval + (m_audio_latency - 1) * 20.0) / 1000.0) * m_sample_rate + 0.5;
+		u32 const min_target = (interval / 1000.0) * m_sample_rate + 0.5;
+		u32 const max_target = ((interval + (LATENCY_MAX - 1) * 20.0) / 1000.0) * m_sample_rate + 0.5;
+
+		try {
+			m_ab = new audio_ring(m_sample_rate, target, min_target, max_target);
+		} catch (std::bad_alloc&) {
+			osd_printf_error("PortAudio: Unable to allocate audio buffer, sound is disabled\n");
+			Pa_CloseStream(m_pa_stream);
+			Pa_Terminate();
+			goto error;
+		}
+	}
 
 	osd_printf_verbose("PortAudio: Using device \"%s\" on API \"%s\"\n", device_info->name, api_info->name);
 	osd_printf_verbose("PortAudio: Sample rate is %0.0f Hz, device output latency is %0.2f ms\n",
 		stream_info->sampleRate, stream_info->outputLatency * 1000.0);
-	osd_printf_verbose("PortAudio: Allowed additional buffering latency is %0.2f ms/%d frames\n",
-		(m_skip_threshold / 2.0) / (m_sample_rate / 1000.0), m_skip_threshold / 2);
+	osd_printf_verbose("PortAudio: Initial additional buffering latency is %0.2f ms/%u frames\n",
+		m_ab->target() / (m_sample_rate / 1000.0), m_ab->target());
 
 	err = Pa_StartStream(m_pa_stream);
 
@@ -278,6 +188,7 @@ int sound_pa::init(osd_options const &options)
 
 pa_error:
 	delete m_ab;
+	m_ab = nullptr;
 	osd_printf_error("PortAudio error: %s\n", Pa_GetErrorText(err));
 	Pa_Terminate();
 error:
@@ -324,47 +235,15 @@ PaDeviceIndex sound_pa::list_get_devidx(const char* api_str, const char* device_
 
 int sound_pa::callback(s16* output_buffer, size_t number_of_samples)
 {
-	int buf_ct = m_ab->count();
+	// an underflow is padded with silence and reported to the writer, which raises the latency
+	m_ab->read(output_buffer, number_of_samples / 2);
 
-	if (buf_ct >= number_of_samples)
+	int const attenuation = m_attenuation.load(std::memory_order_relaxed);
+	if (attenuation)
 	{
-		m_ab->read(output_buffer, number_of_samples);
-
-		// keep track of the minimum buffer count, skip samples adaptively to respect the audio_latency setting
-		buf_ct -= number_of_samples;
-
-		if (buf_ct < m_buffer_min_ct)
-			m_buffer_min_ct = buf_ct;
-
-		// if we are below the threshold, reset the counter
-		if (buf_ct < m_skip_threshold)
-			m_skip_threshold_ticks = m_osd_ticks;
-
-		// if we have been above the set threshold for ~1 second, skip forward
-		if (m_osd_ticks - m_skip_threshold_ticks > m_osd_tps)
-		{
-			int adjust = m_buffer_min_ct - m_skip_threshold / 2;
-
-			// if adjustment is less than two milliseconds, don't bother
-			if (adjust / 2 > sample_rate() / 500) {
-				m_ab->increment_playpos(adjust);
-				m_has_overflowed = true;
-			}
-
-			m_skip_threshold_ticks = m_osd_ticks;
-			m_buffer_min_ct = INT_MAX;
-		}
-	}
-	else
-	{
-		m_ab->read(output_buffer, buf_ct);
-		std::memset(output_buffer + buf_ct, 0, (number_of_samples - buf_ct) * sizeof(s16));
-
-		// if update_audio_stream has been called, note the underflow
-		if (m_osd_ticks)
-			m_has_underflowed = true;
-
-		m_skip_threshold_ticks = m_osd_ticks;
+		int const level = powf(10.0, attenuation / 20.0) * 32768;
+		for (size_t sample = 0; sample < number_of_samples; sample++)
+			output_buffer[sample] = (output_buffer[sample] * level) >> 15;
 	}
 
 	return paContinue;
@@ -377,27 +256,10 @@ void sound_pa::update_audio_stream(bool is_throttled, const s16 *buffer, int sam
 
 #if LOG_BUFCNT
 	if (m_log.good())
-		m_log << m_ab->count() << std::endl;
+		m_log << m_ab->fill() << std::endl;
 #endif
 
-	if (m_has_underflowed)
-	{
-		m_underflows++;
-		// add some silence to prevent immediate underflows
-		m_ab->clear(m_skip_threshold / 4);
-		m_has_underflowed = false;
-	}
-
-	if (m_has_overflowed)
-	{
-		m_overflows++;
-		m_has_overflowed = false;
-	}
-
-	m_ab->write(buffer, samples_this_frame * 2, m_attenuation);
-
-	// for determining buffer overflows, take the sample here instead of in the callback
-	m_osd_ticks = osd_ticks();
+	m_ab->write(buffer, samples_this_frame);
 }
 
 void sound_pa::set_mastervolume(int attenuation)
@@ -431,10 +293,10 @@ void sound_pa::exit()
 
 	Pa_Terminate();
 
-	delete m_ab;
+	if (m_ab->overflows() || m_ab->underflows())
+		osd_printf_verbose("Sound: overflows=%u underflows=%u latency=%u frames\n", m_ab->overflows(), m_ab->underflows(), m_ab->target());
 
-	if (m_overflows || m_underflows)
-		osd_printf_verbose("Sound: overflows=%d underflows=%d\n", m_overflows, m_underflows);
+	delete m_ab;
 }
 
 #else
@@ -9,6 +9,7 @@
 //============================================================
 
 #include "sound_module.h"
+#include "audio_ring.h"
 #include "modules/osdmodule.h"
 
 #if (defined(OSD_SDL) || defined(USE_SDL_SOUND))
@@ -38,23 +39,6 @@ static void sdl_callback(void *userdata, Uint8 *stream, int len);
 //  CLASS
 //============================================================
 
-class ring_buffer
-{
-public:
-	ring_buffer(size_t size);
-	virtual ~ring_buffer();
-
-	size_t data_size();
-	size_t free_size();
-	int append(const void *data, size_t size);
-	int pop(void *data, size_t size);
-
-private:
-	int8_t *buffer;
-	size_t buffer_size;
-	int head, tail;
-};
-
 class sound_sdl : public osd_module, public sound_module
 {
 public:
@@ -68,7 +52,7 @@ public:
 	: osd_module(OSD_SOUND_PROVIDER, "sdl"), sound_module(),
 		stream_in_initialized(0),
 		stream_loop(0),
-		attenuation(0), buf_locked(0), stream_buffer(nullptr), stream_buffer_size(0), buffer_underflows(0), buffer_overflows(0)
+		attenuation(0), stream_buffer(nullptr)
 {
 		sdl_xfer_samples = SDL_XFER_SAMPLES;
 	}
@@ -83,11 +67,8 @@ public:
 	virtual void set_mastervolume(int attenuation) override;
 
 private:
-	int lock_buffer(void);
-	void unlock_buffer(void);
 	void attenuate(int16_t *data, int bytes);
-	void copy_sample_data(bool is_throttled, const int16_t *data, int bytes_to_copy);
-	int sdl_create_buffers(void);
+	int sdl_create_buffers(int audio_latency);
 	void sdl_destroy_buffers(void);
 
 	int sdl_xfer_samples;
@@ -95,16 +76,8 @@ private:
 	int stream_loop;
 	int attenuation;
 
-	int              buf_locked;
-	ring_buffer      *stream_buffer;
-	uint32_t         stream_buffer_size;
-
-
-	// buffer over/underflow counts
-	int              buffer_underflows;
-	int              buffer_overflows;
-
-
+	// lock-free queue between update_audio_stream and the callback
+	audio_ring       *stream_buffer;
 };
 
 
@@ -123,126 +96,6 @@ private:
 static FILE *sound_log;
 
 
-//============================================================
-//  ring_buffer - constructor
-//============================================================
-
-ring_buffer::ring_buffer(size_t size)
-: buffer(global_alloc_array_clear<int8_t>(size + 1)), buffer_size(size + 1), head(0), tail(0)
-{
-	// A size+1 bytes buffer is allocated because it can never be full.
-	// Otherwise the case head == tail couldn't be distinguished between a
-	// full buffer and an empty buffer.
-}
-
-//============================================================
-//  ring_buffer - destructor
-//============================================================
-
-ring_buffer::~ring_buffer()
-{
-	global_free_array(buffer);
-}
-
-//============================================================
-//  ring_buffer::data_size
-//============================================================
-
-size_t ring_buffer::data_size()
-{
-	return (tail - head + buffer_size) % buffer_size;
-}
-
-//============================================================
-//  ring_buffer::free_size
-//============================================================
-
-size_t ring_buffer::free_size() {
-	return (head - tail - 1 + buffer_size) % buffer_size;
-}
-
-//============================================================
-//  ring_buffer::append
-//============================================================
-
-int ring_buffer::append(const void *data, size_t size)
-{
-	int8_t *data8 = (int8_t *)data;
-	size_t sz;
-
-	if (free_size() < size)
-		return -1;
-
-	sz = buffer_size - tail;
-	if (size <= sz)
-		sz = size;
-	else
-		memcpy(buffer, &data8[sz], size - sz);
-
-	memcpy(&buffer[tail], data8, sz);
-	tail = (tail + size) % buffer_size;
-	return 0;
-}
-
-//============================================================
-//  ring_buffer::pop
-//============================================================
-
-int ring_buffer::pop(void *data, size_t size)
-{
-	int8_t *data8 = (int8_t *)data;
-	size_t sz;
-
-	if (data_size() < size)
-		return -1;
-
-	sz = buffer_size - head;
-	if (size <= sz)
-		sz = size;
-	else {
-		memcpy(&data8[sz], buffer, size - sz);
-		memset(buffer, 0, size - sz);
-	}
-
-	memcpy(data8, &buffer[head], sz);
-	memset(&buffer[head], 0, sz);
-	head = (head + size) % buffer_size;
-	return 0;
-}
-
-//============================================================
-//  sound_sdl - destructor
-//============================================================
-
-//============================================================
-//  lock_buffer
-//============================================================
-int sound_sdl::lock_buffer()
-{
-	if (!buf_locked)
-		SDL_LockAudio();
-	buf_locked++;
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "locking\n");
-
-	return 0;
-}
-
-//============================================================
-//  unlock_buffer
-//============================================================
-void sound_sdl::unlock_buffer(void)
-{
-	buf_locked--;
-	if (!buf_locked)
-		SDL_UnlockAudio();
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "unlocking\n");
-
-}
-
 //============================================================
 //  Apply attenuation
 //============================================================
@@ -259,21 +112,6 @@ void sound_sdl::attenuate(int16_t *data, int bytes_to_copy)
 	}
 }
 
-//============================================================
-//  copy_sample_data
-//============================================================
-
-void sound_sdl::copy_sample_data(bool is_throttled, const int16_t *data, int bytes_to_copy)
-{
-	lock_buffer();
-	int err = stream_buffer->append((void *)data, bytes_to_copy);
-	unlock_buffer();
-
-	if (LOG_SOUND && err)
-		fprintf(sound_log, "Late detection of overflow. This shouldn't happen.\n");
-}
-
-
 //============================================================
 //  update_audio_stream
 //============================================================
@@ -284,37 +122,18 @@ void sound_sdl::update_audio_stream(bool is_throttled, const int16_t *buffer, in
 	if (sample_rate() == 0 || stream_buffer == nullptr)
 		return;
 
+	// the ring primes itself with silence at the target latency
+	stream_buffer->write(buffer, samples_this_frame);
 
 	if (!stream_in_initialized)
 	{
-		// Fill in some zeros to prevent an initial buffer underflow
-		int8_t zero = 0;
-		size_t zsize = stream_buffer->free_size() / 2;
-		while (zsize--)
-			stream_buffer->append(&zero, 1);
-
 		// start playing
 		SDL_PauseAudio(0);
 		stream_in_initialized = 1;
 	}
 
-	size_t bytes_this_frame = samples_this_frame * sizeof(*buffer) * 2;
-	size_t free_size = stream_buffer->free_size();
-	size_t data_size = stream_buffer->data_size();
-
-	if (stream_buffer->free_size() < bytes_this_frame) {
-		if (LOG_SOUND)
-			fprintf(sound_log, "Overflow: DS=%zu FS=%zu BTF=%zu\n", data_size, free_size, bytes_this_frame);
-		buffer_overflows++;
-		return;
-	}
-
-	copy_sample_data(is_throttled, buffer, bytes_this_frame);
-
-	size_t nfree_size = stream_buffer->free_size();
-	size_t ndata_size = stream_buffer->data_size();
 	if (LOG_SOUND)
-		fprintf(sound_log, "Appended data: DS=%zu(%zu) FS=%zu(%zu) BTF=%zu\n", data_size, ndata_size, free_size, nfree_size, bytes_this_frame);
+		fprintf(sound_log, "Appended data: frames=%d fill=%u target=%u\n", samples_this_frame, stream_buffer->fill(), stream_buffer->target());
 }
 
 
@@ -343,28 +162,14 @@ void sound_sdl::set_mastervolume(int _attenuation)
 static void sdl_callback(void *userdata, Uint8 *stream, int len)
 {
 	sound_sdl *thiz = (sound_sdl *) userdata;
-	size_t free_size = thiz->stream_buffer->free_size();
-	size_t data_size = thiz->stream_buffer->data_size();
+	u32 const frames = len / (2 * sizeof(int16_t));
 
-	if (data_size < len)
-	{
-		thiz->buffer_underflows++;
-		if (LOG_SOUND)
-			fprintf(sound_log, "Underflow at sdl_callback: DS=%zu FS=%zu Len=%d\n", data_size, free_size, len);
-
-		// Maybe read whatever is left in the stream_buffer anyway?
-		memset(stream, 0, len);
-		return;
-	}
-
-	int err = thiz->stream_buffer->pop((void *)stream, len);
-	if (LOG_SOUND && err)
-		fprintf(sound_log, "Late detection of underflow. This shouldn't happen.\n");
+	// an underflow is padded with silence and reported to the writer, which raises the latency
+	u32 const count = thiz->stream_buffer->read((int16_t *)stream, frames);
+	if (LOG_SOUND && count < frames)
+		fprintf(sound_log, "Underflow at sdl_callback: got %u of %u frames\n", count, frames);
 
 	thiz->attenuate((int16_t *)stream, len);
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "callback: xfer DS=%zu FS=%zu Len=%d\n", data_size, free_size, len);
 }
 
 
@@ -417,14 +222,8 @@ int sound_sdl::init(const osd_options &options)
 		// pin audio latency
 		audio_latency = std::max(std::min(m_audio_latency, MAX_AUDIO_LATENCY), 1);
 
-		// compute the buffer sizes
-		stream_buffer_size = (sample_rate() * 2 * sizeof(int16_t) * (2 + audio_latency)) / 30;
-		stream_buffer_size = (stream_buffer_size / 1024) * 1024;
-		if (stream_buffer_size < 1024)
-			stream_buffer_size = 1024;
-
 		// create the buffers
-		if (sdl_create_buffers())
+		if (sdl_create_buffers(audio_latency))
 			goto cant_create_buffers;
 
 		// set the startup volume
@@ -460,18 +259,15 @@ void sound_sdl::exit()
 
 	SDL_QuitSubSystem(SDL_INIT_AUDIO);
 
-	// kill the buffers
+	// print out over/underflow stats, then kill the buffers
+	if (stream_buffer && (stream_buffer->overflows() || stream_buffer->underflows()))
+		osd_printf_verbose("Sound buffer: overflows=%u underflows=%u latency=%u frames\n", stream_buffer->overflows(), stream_buffer->underflows(), stream_buffer->target());
+	if (LOG_SOUND && stream_buffer)
+		fprintf(sound_log, "Sound buffer: overflows=%u underflows=%u\n", stream_buffer->overflows(), stream_buffer->underflows());
 	sdl_destroy_buffers();
 
-	// print out over/underflow stats
-	if (buffer_overflows || buffer_underflows)
-		osd_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
-
 	if (LOG_SOUND)
-	{
-		fprintf(sound_log, "Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
 		fclose(sound_log);
-	}
 }
 
 
@@ -480,12 +276,16 @@ void sound_sdl::exit()
 //  dsound_create_buffers
 //============================================================
 
-int sound_sdl::sdl_create_buffers(void)
+int sound_sdl::sdl_create_buffers(int audio_latency)
 {
-	osd_printf_verbose("sdl_create_buffers: creating stream buffer of %u bytes\n", stream_buffer_size);
-
-	stream_buffer = new ring_buffer(stream_buffer_size);
-	buf_locked = 0;
+	// -audio_latency picks the starting point, as half of the old (2 + latency) / 30 second buffer;
+	// the ring can drop to two callbacks' worth when stable and grow to the maximum on underflows
+	u32 const target = sample_rate() * (2 + audio_latency) / 60;
+	u32 const min_target = 2 * sdl_xfer_samples;
+	u32 const max_target = std::max<u32>(sample_rate() * (2 + MAX_AUDIO_LATENCY) / 30, min_target);
+	osd_printf_verbose("sdl_create_buffers: targeting %u frames of latency (%u-%u)\n", target, min_target, max_target);
+
+	stream_buffer = new audio_ring(sample_rate(), target, min_target, max_target);
 	return 0;
 }
 
@@ -213,6 +213,29 @@ public:
 	virtual error flush() = 0;
 
 
+	/*-----------------------------------------------------------------------------
+	    osd_file::map: map the start of an open file read-only into memory
+
+	    Parameters:
+
+	        length - number of bytes from the start of the file to map
+
+	    Return value:
+
+	        a pointer to the file data, or nullptr if the file can't be mapped;
+	        the mapping stays valid until the file is closed
+
+	    Notes:
+
+	        Only the first call creates a mapping; later calls return it if it
+	        covers the requested length. Writes made while the file is mapped
+	        may or may not be visible through it, so callers should only map
+	        files they don't write. The default implementation, used for PTYs
+	        and sockets, returns nullptr.
+	-----------------------------------------------------------------------------*/
+	virtual void const *map(std::uint64_t /*length*/) { return nullptr; }
+
+
 	/*-----------------------------------------------------------------------------
 	    osd_file::remove: deletes a file
 
@@ -252,6 +275,15 @@ const char *osd_getenv(const char *name);
 -----------------------------------------------------------------------------*/
 int osd_getpid();
 
+/*-----------------------------------------------------------------------------
+    osd_get_peak_memory: gets the most physical memory the process has used
+
+    Return value:
+
+        peak resident set size in bytes, or 0 if the platform can't tell
+-----------------------------------------------------------------------------*/
+uint64_t osd_get_peak_memory();
+
 /*-----------------------------------------------------------------------------
     osd_get_physical_drive_geometry: if the given path points to a physical
         drive, return the geometry of that drive
@@ -730,6 +762,44 @@ void *osd_alloc_executable(size_t size);
 void osd_free_executable(void *ptr, size_t size);
 
 
+/*-----------------------------------------------------------------------------
+    osd_alloc_large: allocate a large block of zero-filled memory
+
+    Parameters:
+
+        size - the number of bytes to allocate
+
+        huge - true to ask for huge pages where the system can provide them
+
+    Return value:
+
+        a pointer to the allocated memory, or nullptr on failure
+
+    Notes:
+
+        The memory is mapped directly from the system rather than taken from
+        the heap, so pages are zeroed lazily as they are first touched.
+        Huge pages are a hint that may be ignored.
+-----------------------------------------------------------------------------*/
+void *osd_alloc_large(size_t size, bool huge);
+
+
+/*-----------------------------------------------------------------------------
+    osd_free_large: free memory allocated by osd_alloc_large
+
+    Parameters:
+
+        ptr - the pointer returned from osd_alloc_large
+
+        size - the number of bytes originally requested
+
+    Return value:
+
+        None
+-----------------------------------------------------------------------------*/
+void osd_free_large(void *ptr, size_t size);
+
+
 /*-----------------------------------------------------------------------------
     osd_break_into_debugger: break into the hosting system's debugger if one
         is attached
@@ -76,6 +76,7 @@ public:
 
 	// input overridables
 	virtual void customize_input_type_list(simple_list<input_type_entry> &typelist) = 0;
+	virtual void input_update() = 0;            // gather input events; called just before each frame starts
 
 	// video overridables
 	virtual void add_audio_to_recording(const int16_t *buffer, int samples_this_frame) = 0;
@@ -36,6 +36,9 @@ class osd_netdev *open_netdev(int id, class device_network_interface *ifdev, int
 }
 
 osd_netdev::osd_netdev(class device_network_interface *ifdev, int rate)
+	: m_ring_head(0)
+	, m_ring_tail(0)
+	, m_thread_exit(false)
 {
 	m_dev = ifdev;
 	m_timer = ifdev->device().machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(osd_netdev::recv), this));
@@ -44,6 +47,56 @@ osd_netdev::osd_netdev(class device_network_interface *ifdev, int rate)
 
 osd_netdev::~osd_netdev()
 {
+	// derived classes should already have done this, before closing their device
+	stop_receive_thread();
+}
+
+void osd_netdev::start_receive_thread()
+{
+	if (m_thread.joinable())
+		return;
+
+	m_ring = std::make_unique<packet []>(RING_SIZE);
+	m_ring_head = m_ring_tail = 0;
+	m_thread_exit = false;
+	m_thread = std::thread([this] () { receive_thread(); });
+}
+
+void osd_netdev::stop_receive_thread()
+{
+	if (!m_thread.joinable())
+		return;
+
+	m_thread_exit = true;
+	m_thread.join();
+}
+
+void osd_netdev::receive_thread()
+{
+	while (!m_thread_exit)
+	{
+		// if the emulated side isn't keeping up, let the OS queue hold the rest
+		unsigned const head = m_ring_head.load(std::memory_order_relaxed);
+		if (head - m_ring_tail.load(std::memory_order_acquire) >= RING_SIZE)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		// the timeout bounds how long it takes to notice we're being stopped
+		if (!wait_dev(100))
+			continue;
+
+		uint8_t *buf;
+		int const len = recv_dev(&buf);
+		if (len > 0)
+		{
+			packet &slot = m_ring[head & (RING_SIZE - 1)];
+			slot.len = (std::min)(len, MAX_FRAME);
+			memcpy(slot.data, buf, slot.len);
+			m_ring_head.store(head + 1, std::memory_order_release);
+		}
+	}
 }
 
 void osd_netdev::start()
@@ -63,6 +116,19 @@ int osd_netdev::send(uint8_t *buf, int len)
 
 void osd_netdev::recv(void *ptr, int param)
 {
+	// with a receive thread, deliver everything it has queued without touching the OS
+	if (m_thread.joinable())
+	{
+		unsigned tail = m_ring_tail.load(std::memory_order_relaxed);
+		while (m_timer->enabled() && (tail != m_ring_head.load(std::memory_order_acquire)))
+		{
+			packet &slot = m_ring[tail & (RING_SIZE - 1)];
+			m_dev->recv_cb(slot.data, slot.len);
+			m_ring_tail.store(++tail, std::memory_order_release);
+		}
+		return;
+	}
+
 	uint8_t *buf;
 	int len;
 	//const char atalkmac[] = { 0x09, 0x00, 0x07, 0xff, 0xff, 0xff };
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <thread>
+
 class osd_netdev;
 
 #define CREATE_NETDEV(name) class osd_netdev *name(const char *ifname, class device_network_interface *ifdev, int rate)
@@ -35,11 +38,34 @@ public:
 protected:
 	virtual int recv_dev(uint8_t **buf);
 
+	// backends that can block until a packet is ready may hand reception to
+	// a thread that fills a ring, so the timer only copies out what's waiting;
+	// start it once the device is open and stop it before closing it
+	virtual bool wait_dev(int timeout_ms) { return true; }
+	void start_receive_thread();
+	void stop_receive_thread();
+
 private:
+	static constexpr unsigned RING_SIZE = 64;       // must be a power of two
+	static constexpr int MAX_FRAME = 2048;
+
+	struct packet
+	{
+		int len;
+		uint8_t data[MAX_FRAME];
+	};
+
 	void recv(void *ptr, int param);
+	void receive_thread();
 
 	class device_network_interface *m_dev;
 	emu_timer *m_timer;
+
+	std::unique_ptr<packet []> m_ring;
+	std::atomic<unsigned> m_ring_head;              // next slot the thread fills
+	std::atomic<unsigned> m_ring_tail;              // next slot the timer delivers
+	std::atomic<bool> m_thread_exit;
+	std::thread m_thread;
 };
 
 class osd_netdev *open_netdev(int id, class device_network_interface *ifdev, int rate);
@@ -20,7 +20,11 @@
 #include <atomic>
 #include <thread>
 #include <vector>
+#include <deque>
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 // MAME headers
 #include "osdcore.h"
 #include "osdsync.h"
@@ -31,6 +35,22 @@
 #include <pthread.h>
 #endif
 
+#if !defined(OSD_WINDOWS) && !defined(SDLMAME_WIN32) && !defined(SDLMAME_EMSCRIPTEN)
+#define OSD_CAN_FORK    1
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#define OSD_LINUX_AFFINITY      (1)
+#include <pthread.h>
+#include <sched.h>
+#else
+#define OSD_LINUX_AFFINITY      (0)
+#endif
+
 //============================================================
 //  DEBUGGING
 //============================================================
@@ -45,6 +65,7 @@
 #define ENV_WORKQUEUEMAXTHREADS      "OSDWORKQUEUEMAXTHREADS"
 
 #define SPIN_LOOP_TIME          (osd_ticks_per_second() / 10000)
+#define SPIN_LOOP_MIN_TIME      (SPIN_LOOP_TIME / 16)
 
 //============================================================
 //  MACROS
@@ -108,8 +129,10 @@ struct work_thread_info
 	, wakeevent(false, false)  // auto-reset, not signalled
 	, active(0)
 	, id(aid)
+	, spinlimit(SPIN_LOOP_TIME)
 #if KEEP_STATISTICS
 	, itemsdone(0)
+	, itemsstolen(0)
 	, actruntime(0)
 	, runtime(0)
 	, spintime(0)
@@ -122,9 +145,13 @@ struct work_thread_info
 	osd_event           wakeevent;      // wake event for the thread
 	std::atomic<int32_t>  active;         // are we actively processing work?
 	uint32_t              id;
+	std::mutex          itemlock;       // lock for protecting this thread's items
+	std::deque<osd_work_item *> items;  // items queued for this thread; others steal from the back
+	osd_ticks_t         spinlimit;      // how long to spin for more work before sleeping
 
 #if KEEP_STATISTICS
 	int32_t               itemsdone;
+	int32_t               itemsstolen;
 	osd_ticks_t         actruntime;
 	osd_ticks_t         runtime;
 	osd_ticks_t         spintime;
@@ -136,10 +163,10 @@ struct work_thread_info
 struct osd_work_queue
 {
 	osd_work_queue()
-	: list(nullptr)
-	, tailptr(nullptr)
-	, free(nullptr)
+	: free(nullptr)
 	, items(0)
+	, queued(0)
+	, nextthread(0)
 	, livethreads(0)
 	, waiting(0)
 	, exiting(0)
@@ -155,11 +182,11 @@ struct osd_work_queue
 	{
 	}
 
-	std::mutex          lock;           // lock for protecting the queue
-	std::atomic<osd_work_item *> list;  // list of items in the queue
-	osd_work_item ** volatile tailptr;  // pointer to the tail pointer of work items in the queue
+	std::mutex          lock;           // lock for protecting the free list and item events
 	std::atomic<osd_work_item *> free;  // free list of work items
 	std::atomic<int32_t>  items;          // items in the queue
+	std::atomic<int32_t>  queued;         // items in the queue that no thread has picked up yet
+	std::atomic<uint32_t> nextthread;     // thread to hand the next batch of items to
 	std::atomic<int32_t>  livethreads;    // number of live threads
 	std::atomic<int32_t>  waiting;        // is someone waiting on the queue to complete?
 	std::atomic<int32_t>  exiting;        // should the threads exit on their next opportunity?
@@ -207,6 +234,16 @@ struct osd_work_item
 
 int osd_num_processors = 0;
 
+// processors for each class of thread, and for this instance's partition
+static std::mutex s_placement_lock;
+static std::vector<unsigned> s_class_processors[OSD_THREAD_CLASS_COUNT];
+static std::vector<unsigned> s_partition_processors;
+static int s_io_priority = 1;
+
+// every live queue, so they can be quiesced around fork()
+static std::mutex s_queue_list_lock;
+static std::vector<osd_work_queue *> s_queue_list;
+
 //============================================================
 //  FUNCTION PROTOTYPES
 //============================================================
@@ -214,6 +251,7 @@ int osd_num_processors = 0;
 static int effective_num_processors(void);
 static void * worker_thread_entry(void *param);
 static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
+static osd_work_item *worker_thread_next_item(osd_work_queue *queue, work_thread_info *thread);
 static bool queue_has_list_items(osd_work_queue *queue);
 
 //============================================================
@@ -223,8 +261,10 @@ static bool queue_has_list_items(osd_work_queue *queue);
 int thread_adjust_priority(std::thread *thread, int adjust)
 {
 #if defined(OSD_WINDOWS) || defined(SDLMAME_WIN32)
-	if (adjust)
+	if (adjust > 0)
 		SetThreadPriority((HANDLE)thread->native_handle(), THREAD_PRIORITY_ABOVE_NORMAL);
+	else if (adjust < 0)
+		SetThreadPriority((HANDLE)thread->native_handle(), THREAD_PRIORITY_BELOW_NORMAL);
 	else
 		SetThreadPriority((HANDLE)thread->native_handle(), GetThreadPriority(GetCurrentThread()));
 #endif
@@ -261,7 +301,6 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	queue = new osd_work_queue();
 
 	// initialize basic queue members
-	queue->tailptr = (osd_work_item **)&queue->list;
 	queue->flags = flags;
 
 	// determine how many threads to create...
@@ -283,11 +322,12 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	// clamp to the maximum
 	queue->threads = std::min(threadnum, WORK_MAX_THREADS);
 
-	// allocate memory for thread array (+1 to count the calling thread if WORK_QUEUE_FLAG_MULTI)
+	// allocate memory for thread array (+1 to count the calling thread if WORK_QUEUE_FLAG_MULTI,
+	// and always at least one to hold the items when the calling thread does all the work)
 	if (flags & WORK_QUEUE_FLAG_MULTI)
 		allocthreadnum = queue->threads + 1;
 	else
-		allocthreadnum = queue->threads;
+		allocthreadnum = std::max<int>(queue->threads, 1);
 
 #if KEEP_STATISTICS
 	printf("osdprocs: %d effecprocs: %d threads: %d allocthreads: %d osdthreads: %d maxthreads: %d queuethreads: %d\n", osd_num_processors, numprocs, threadnum, allocthreadnum, osdthreadnum, WORK_MAX_THREADS, queue->threads);
@@ -306,12 +346,15 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 		if (thread->handle == nullptr)
 			goto error;
 
-		// set its priority: I/O threads get high priority because they are assumed to be
-		// blocked most of the time; other threads just match the creator's priority
+		// set its priority: I/O threads get high priority by default because they are assumed
+		// to be blocked most of the time; other threads just match the creator's priority
 		if (flags & WORK_QUEUE_FLAG_IO)
-			thread_adjust_priority(thread->handle, 1);
+			thread_adjust_priority(thread->handle, s_io_priority);
 		else
 			thread_adjust_priority(thread->handle, 0);
+
+		// and put it where it belongs
+		osd_thread_apply_class(thread->handle, (flags & WORK_QUEUE_FLAG_IO) ? OSD_THREAD_IO : OSD_THREAD_WORKER);
 	}
 
 	// start a timer going for "waittime" on the main thread
@@ -319,6 +362,11 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	{
 		begin_timing(queue->thread[queue->threads]->waittime);
 	}
+
+	{
+		std::lock_guard<std::mutex> lock(s_queue_list_lock);
+		s_queue_list.push_back(queue);
+	}
 	return queue;
 
 error:
@@ -394,6 +442,13 @@ bool osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 
 void osd_work_queue_free(osd_work_queue *queue)
 {
+	{
+		std::lock_guard<std::mutex> lock(s_queue_list_lock);
+		auto const found = std::find(s_queue_list.begin(), s_queue_list.end(), queue);
+		if (found != s_queue_list.end())
+			s_queue_list.erase(found);
+	}
+
 	// stop the timer for "waittime" on the main thread
 	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
 	{
@@ -427,8 +482,8 @@ void osd_work_queue_free(osd_work_queue *queue)
 	for (work_thread_info *thread : queue->thread)
 	{
 		osd_ticks_t total = thread->runtime + thread->waittime + thread->spintime;
-		printf("Thread %d:  items=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
-				thread->id, thread->itemsdone,
+		printf("Thread %d:  items=%9d stolen=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
+				thread->id, thread->itemsdone, thread->itemsstolen,
 				(double)thread->runtime * 100.0 / (double)total,
 				(double)thread->actruntime * 100.0 / (double)total,
 				(double)thread->spintime * 100.0 / (double)total,
@@ -437,9 +492,17 @@ void osd_work_queue_free(osd_work_queue *queue)
 	}
 #endif
 
-	// free the list
+	// free all items still queued on the threads, then the threads
 	for (auto & th : queue->thread)
+	{
+		for (osd_work_item *item : th->items)
+		{
+			if (item->event != nullptr)
+				delete item->event;
+			delete item;
+		}
 		delete th;
+	}
 	queue->thread.clear();
 
 	// free all items in the free list
@@ -452,16 +515,6 @@ void osd_work_queue_free(osd_work_queue *queue)
 		delete item;
 	}
 
-	// free all items in the active list
-	while (queue->list.load() != nullptr)
-	{
-		osd_work_item *item = (osd_work_item *)queue->list;
-		queue->list = item->next;
-		if (item->event != nullptr)
-			delete item->event;
-		delete item;
-	}
-
 #if KEEP_STATISTICS
 	printf("Items queued   = %9d\n", queue->itemsqueued.load());
 	printf("SetEvent calls = %9d\n", queue->setevents.load());
@@ -480,10 +533,12 @@ void osd_work_queue_free(osd_work_queue *queue)
 
 osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_callback callback, int32_t numitems, void *parambase, int32_t paramstep, uint32_t flags)
 {
-	osd_work_item *itemlist = nullptr, *lastitem = nullptr;
-	osd_work_item **item_tailptr = &itemlist;
+	std::vector<osd_work_item *> itemlist;
+	osd_work_item *lastitem = nullptr;
 	int itemnum;
 
+	itemlist.reserve(numitems);
+
 	// loop over items, building up a local list of work
 	for (itemnum = 0; itemnum < numitems; itemnum++)
 	{
@@ -520,22 +575,35 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 
 		// advance to the next
 		lastitem = item;
-		*item_tailptr = item;
-		item_tailptr = &item->next;
+		itemlist.push_back(item);
 		parambase = (uint8_t *)parambase + paramstep;
 	}
 
-	// enqueue the whole thing within the critical section
-	{
-		std::lock_guard<std::mutex> lock(queue->lock);
-		*queue->tailptr = itemlist;
-		queue->tailptr = item_tailptr;
-	}
-
-	// increment the number of items in the queue
+	// count the items before anyone can pick them up
 	queue->items += numitems;
 	add_to_stat(queue->itemsqueued, numitems);
 
+	// deal the items out to the threads in contiguous runs, starting where the last batch
+	// left off; threads that run dry steal from the others, so this only needs to be roughly fair
+	{
+		uint32_t const numthreads = std::max<uint32_t>(queue->threads, 1);
+		uint32_t const runs = std::min<uint32_t>(numthreads, numitems);
+		uint32_t threadnum = queue->nextthread.fetch_add(runs) % numthreads;
+		int32_t start = 0;
+		for (uint32_t run = 0; run < runs; run++)
+		{
+			int32_t const end = int32_t(uint64_t(numitems) * (run + 1) / runs);
+			work_thread_info *thread = queue->thread[threadnum];
+			{
+				std::lock_guard<std::mutex> lock(thread->itemlock);
+				thread->items.insert(thread->items.end(), itemlist.begin() + start, itemlist.begin() + end);
+			}
+			queue->queued += end - start;
+			start = end;
+			threadnum = (threadnum + 1) % numthreads;
+		}
+	}
+
 	// look for free threads to do the work
 	if (queue->livethreads < queue->threads)
 	{
@@ -637,6 +705,183 @@ void osd_work_item_release(osd_work_item *item)
 }
 
 
+//============================================================
+//  parse_processor_list
+//============================================================
+
+static bool parse_processor_list(const char *spec, std::vector<unsigned> &result)
+{
+	result.clear();
+	if (spec == nullptr || *spec == 0 || strcmp(spec, "auto") == 0)
+		return true;
+
+	// comma-separated processor numbers and ranges
+	const char *pos = spec;
+	while (*pos != 0)
+	{
+		char *end;
+		unsigned long const first = strtoul(pos, &end, 10);
+		if (end == pos)
+			return false;
+		unsigned long last = first;
+		pos = end;
+		if (*pos == '-')
+		{
+			last = strtoul(++pos, &end, 10);
+			if (end == pos || last < first)
+				return false;
+			pos = end;
+		}
+		if (last >= 1024)
+			return false;
+		for (unsigned long cpu = first; cpu <= last; cpu++)
+			result.push_back(unsigned(cpu));
+
+		if (*pos == ',')
+			pos++;
+		else if (*pos != 0)
+			return false;
+	}
+
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return true;
+}
+
+
+//============================================================
+//  ordered_processors - list the processors with
+//  those sharing a socket, then a last-level
+//  cache, next to each other
+//============================================================
+
+static long read_topology_value(unsigned cpu, const char *leaf)
+{
+#if OSD_LINUX_AFFINITY
+	char path[128];
+	snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/%s", cpu, leaf);
+	FILE *file = fopen(path, "r");
+	if (file == nullptr)
+		return -1;
+	long value;
+	if (fscanf(file, "%ld", &value) != 1)
+		value = -1;
+	fclose(file);
+	return value;
+#else
+	return -1;
+#endif
+}
+
+static std::vector<unsigned> ordered_processors()
+{
+	struct processor_info
+	{
+		long package;
+		long cache;
+		unsigned cpu;
+	};
+
+	unsigned const count = std::max(std::thread::hardware_concurrency(), 1U);
+	std::vector<processor_info> info;
+	for (unsigned cpu = 0; cpu < count; cpu++)
+		info.push_back({ read_topology_value(cpu, "topology/physical_package_id"), read_topology_value(cpu, "cache/index3/id"), cpu });
+	std::stable_sort(
+			info.begin(),
+			info.end(),
+			[] (processor_info const &a, processor_info const &b) { return (a.package < b.package) || ((a.package == b.package) && (a.cache < b.cache)); });
+
+	std::vector<unsigned> result;
+	for (processor_info const &entry : info)
+		result.push_back(entry.cpu);
+	return result;
+}
+
+
+//============================================================
+//  osd_thread_class_set_processors
+//============================================================
+
+bool osd_thread_class_set_processors(osd_thread_class cls, const char *spec)
+{
+	std::vector<unsigned> processors;
+	if (!parse_processor_list(spec, processors))
+		return false;
+
+	std::lock_guard<std::mutex> lock(s_placement_lock);
+	s_class_processors[cls] = std::move(processors);
+	return true;
+}
+
+
+//============================================================
+//  osd_thread_set_partition
+//============================================================
+
+bool osd_thread_set_partition(const char *spec)
+{
+	std::vector<unsigned> processors;
+	if (spec != nullptr && *spec != 0 && strcmp(spec, "auto") != 0)
+	{
+		int index, count;
+		char extra;
+		if (sscanf(spec, "%d/%d%c", &index, &count, &extra) != 2 || count < 1 || index < 0 || index >= count)
+			return false;
+
+		std::vector<unsigned> const all = ordered_processors();
+		if (unsigned(count) > all.size())
+			return false;
+		processors.assign(all.begin() + (all.size() * index / count), all.begin() + (all.size() * (index + 1) / count));
+	}
+
+	std::lock_guard<std::mutex> lock(s_placement_lock);
+	s_partition_processors = std::move(processors);
+	return true;
+}
+
+
+//============================================================
+//  osd_thread_set_io_priority
+//============================================================
+
+void osd_thread_set_io_priority(int adjust)
+{
+	s_io_priority = std::max(-1, std::min(adjust, 1));
+}
+
+
+//============================================================
+//  osd_thread_apply_class
+//============================================================
+
+void osd_thread_apply_class(std::thread *thread, osd_thread_class cls)
+{
+	std::vector<unsigned> processors;
+	{
+		std::lock_guard<std::mutex> lock(s_placement_lock);
+		processors = s_class_processors[cls].empty() ? s_partition_processors : s_class_processors[cls];
+	}
+	if (processors.empty())
+		return;
+
+#if (defined(OSD_WINDOWS) || defined(SDLMAME_WIN32)) && !defined(OSD_UWP)
+	DWORD_PTR mask = 0;
+	for (unsigned cpu : processors)
+		if (cpu < sizeof(mask) * 8)
+			mask |= DWORD_PTR(1) << cpu;
+	if (mask != 0)
+		SetThreadAffinityMask(thread ? (HANDLE)thread->native_handle() : GetCurrentThread(), mask);
+#elif OSD_LINUX_AFFINITY
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (unsigned cpu : processors)
+		if (cpu < CPU_SETSIZE)
+			CPU_SET(cpu, &set);
+	pthread_setaffinity_np(thread ? thread->native_handle() : pthread_self(), sizeof(set), &set);
+#endif
+}
+
+
 //============================================================
 //  effective_num_processors
 //============================================================
@@ -703,13 +948,19 @@ static void *worker_thread_entry(void *param)
 			// process as much as we can
 			worker_thread_process(&queue, thread);
 
-			// if we're a high frequency queue, spin for a while before giving up
-			if (queue.flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue.list.load() == nullptr)
+			// if we're a high frequency queue, spin for a while before giving up; the spin
+			// gets longer while it keeps finding work and shorter while it doesn't
+			if (queue.flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue.queued == 0)
 			{
 				// spin for a while looking for more work
 				begin_timing(thread->spintime);
-				spin_while<std::atomic<osd_work_item *>, osd_work_item *>(&queue.list, (osd_work_item *)nullptr, SPIN_LOOP_TIME);
+				spin_while<std::atomic<int32_t>, int32_t>(&queue.queued, 0, thread->spinlimit);
 				end_timing(thread->spintime);
+
+				if (queue.queued != 0)
+					thread->spinlimit = std::min<osd_ticks_t>(thread->spinlimit * 2, SPIN_LOOP_TIME);
+				else
+					thread->spinlimit = std::max<osd_ticks_t>(thread->spinlimit / 2, SPIN_LOOP_MIN_TIME);
 			}
 
 			// if nothing more, release the processor
@@ -740,32 +991,8 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 	// loop until everything is processed
 	while (true)
 	{
-		osd_work_item *item = nullptr;
-
-		bool end_loop = false;
-
-		// use a critical section to synchronize the removal of items
-		{
-			std::lock_guard<std::mutex> lock(queue->lock);
-
-			if (queue->list.load() == nullptr)
-			{
-				end_loop = true;
-			}
-			else
-			{
-				// pull the item from the queue
-				item = (osd_work_item *)queue->list;
-				if (item != nullptr)
-				{
-					queue->list = item->next;
-					if (queue->list.load() == nullptr)
-						queue->tailptr = (osd_work_item **)&queue->list;
-				}
-			}
-		}
-
-		if (end_loop)
+		osd_work_item *item = worker_thread_next_item(queue, thread);
+		if (item == nullptr)
 			break;
 
 		// process non-NULL items
@@ -813,9 +1040,113 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 	end_timing(thread->runtime);
 }
 
+
+
+//============================================================
+//  worker_thread_next_item
+//============================================================
+
+static osd_work_item *worker_thread_next_item(osd_work_queue *queue, work_thread_info *thread)
+{
+	osd_work_item *item = nullptr;
+
+	// take the oldest of our own items first
+	{
+		std::lock_guard<std::mutex> lock(thread->itemlock);
+		if (!thread->items.empty())
+		{
+			item = thread->items.front();
+			thread->items.pop_front();
+		}
+	}
+
+	// otherwise steal the newest item from someone else
+	for (uint32_t offset = 1; !item && (queue->queued != 0) && (offset < queue->thread.size()); offset++)
+	{
+		work_thread_info *victim = queue->thread[(thread->id + offset) % queue->thread.size()];
+		std::lock_guard<std::mutex> lock(victim->itemlock);
+		if (!victim->items.empty())
+		{
+			item = victim->items.back();
+			victim->items.pop_back();
+			add_to_stat(thread->itemsstolen, 1);
+		}
+	}
+
+	if (item != nullptr)
+		--queue->queued;
+	return item;
+}
+
 bool queue_has_list_items(osd_work_queue *queue)
 {
-	std::lock_guard<std::mutex> lock(queue->lock);
-	bool has_list_items = (queue->list.load() != nullptr);
-	return has_list_items;
+	return queue->queued != 0;
+}
+
+
+//============================================================
+//  osd_fork_instances
+//============================================================
+
+int osd_fork_instances(int count)
+{
+#if defined(OSD_CAN_FORK)
+	// hold every lock a worker could be holding, so none is copied mid-use; the
+	// queues are drained first so nothing is left for threads that won't exist
+	std::unique_lock<std::mutex> listlock(s_queue_list_lock);
+	std::vector<std::unique_lock<std::mutex>> locks;
+	for (osd_work_queue *queue : s_queue_list)
+	{
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second()))
+			;
+		locks.emplace_back(queue->lock);
+		for (work_thread_info *thread : queue->thread)
+			locks.emplace_back(thread->itemlock);
+	}
+	std::fflush(nullptr);
+
+	std::vector<pid_t> children;
+	bool failed = false;
+	for (int index = 0; index < count; index++)
+	{
+		pid_t const pid = fork();
+		if (pid == 0)
+		{
+			// only this thread came across, so every queue now runs its items on the
+			// caller; the dead threads' info is abandoned rather than freed, since its
+			// thread object can't be joined and its event may still record a waiter
+			for (osd_work_queue *queue : s_queue_list)
+			{
+				for (uint32_t threadnum = 0; threadnum < queue->threads; threadnum++)
+					queue->thread[threadnum] = new work_thread_info(threadnum, *queue);
+				queue->threads = 0;
+				queue->livethreads = 0;
+			}
+			return index;
+		}
+		else if (pid < 0)
+		{
+			failed = true;
+			break;
+		}
+		children.push_back(pid);
+	}
+
+	// let the original's threads go again while we wait
+	locks.clear();
+	listlock.unlock();
+
+	for (pid_t const child : children)
+	{
+		int status = 0;
+		pid_t result;
+		while (((result = waitpid(child, &status, 0)) < 0) && (errno == EINTR))
+			;
+		if ((result < 0) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+			failed = true;
+	}
+	return failed ? OSD_FORK_FAILED : OSD_FORK_SUCCEEDED;
+#else
+	return OSD_FORK_UNSUPPORTED;
+#endif
 }
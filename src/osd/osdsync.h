@@ -14,6 +14,7 @@
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <thread>
 
 #include "osdcomm.h"
 
@@ -164,4 +165,106 @@ private:
 
 };
 
+/***************************************************************************
+    THREAD PLACEMENT
+***************************************************************************/
+
+// kinds of thread that can be given their own set of processors
+enum osd_thread_class
+{
+	OSD_THREAD_MAIN,        // the emulation thread
+	OSD_THREAD_RENDER,      // window render threads
+	OSD_THREAD_WORKER,      // threads of work queues other than I/O queues
+	OSD_THREAD_IO,          // threads of WORK_QUEUE_FLAG_IO queues
+	OSD_THREAD_CLASS_COUNT
+};
+
+/*-----------------------------------------------------------------------------
+    osd_thread_class_set_processors: set the processors a class of thread
+    may run on
+
+    Parameters:
+
+        cls - the class of thread
+
+        spec - comma-separated processor numbers and ranges, e.g. "0-3,8";
+               "auto" or an empty string leaves it to the partition
+
+    Return value:
+
+        false if the specification could not be parsed
+-----------------------------------------------------------------------------*/
+bool osd_thread_class_set_processors(osd_thread_class cls, const char *spec);
+
+/*-----------------------------------------------------------------------------
+    osd_thread_set_partition: restrict this instance to a share of the
+    processors, used by classes without processors of their own
+
+    Parameters:
+
+        spec - "index/count"; the processors are ordered by socket and
+               shared cache and split into count groups, and this instance
+               takes group index. "auto" or an empty string uses them all.
+
+    Return value:
+
+        false if the specification could not be parsed
+-----------------------------------------------------------------------------*/
+bool osd_thread_set_partition(const char *spec);
+
+/*-----------------------------------------------------------------------------
+    osd_thread_set_io_priority: set the priority adjustment of I/O work
+    queue threads relative to the thread creating the queue
+
+    Parameters:
+
+        adjust - 1 for above, 0 for the same, -1 for below
+-----------------------------------------------------------------------------*/
+void osd_thread_set_io_priority(int adjust);
+
+/*-----------------------------------------------------------------------------
+    osd_thread_apply_class: move a thread onto the processors for its class
+
+    Parameters:
+
+        thread - the thread, or nullptr for the calling thread
+
+        cls - the class of thread
+-----------------------------------------------------------------------------*/
+void osd_thread_apply_class(std::thread *thread, osd_thread_class cls);
+
+
+/***************************************************************************
+    PROCESSES
+***************************************************************************/
+
+// results from osd_fork_instances in the original process
+enum
+{
+	OSD_FORK_UNSUPPORTED = -1,                  // the platform can't fork; nothing happened
+	OSD_FORK_SUCCEEDED = -2,                    // all the copies ran and exited successfully
+	OSD_FORK_FAILED = -3                        // at least one copy failed or couldn't be started
+};
+
+/*-----------------------------------------------------------------------------
+    osd_fork_instances: split the process into copies that each carry on
+    from the point of the call
+
+    Parameters:
+
+        count - the number of copies to make
+
+    Return value:
+
+        in each copy, its index from 0 to count-1; in the original process,
+        which waits for all the copies to exit, one of the OSD_FORK values
+
+    Notes:
+
+        Work queues are drained first. Their threads don't survive the split,
+        so in the copies every queue runs its items on the queueing thread.
+        Other threads the caller started are not carried over either.
+-----------------------------------------------------------------------------*/
+int osd_fork_instances(int count);
+
 #endif // MAME_OSD_OSDSYNC_H
@@ -13,6 +13,7 @@
 
 #define SDLOPTION_INIPATH               "inipath"
 #define SDLOPTION_SDLVIDEOFPS           "sdlvideofps"
+#define SDLOPTION_RENDERQUEUE           "renderqueue"
 #define SDLOPTION_USEALLHEADS           "useallheads"
 #define SDLOPTION_CENTERH               "centerh"
 #define SDLOPTION_CENTERV               "centerv"
@@ -78,6 +79,7 @@ public:
 
 	// performance options
 	bool video_fps() const { return bool_value(SDLOPTION_SDLVIDEOFPS); }
+	int render_queue() const { return int_value(SDLOPTION_RENDERQUEUE); }
 
 	// video options
 	bool centerh() const { return bool_value(SDLOPTION_CENTERH); }
@@ -125,6 +127,7 @@ public:
 
 	// input overridables
 	virtual void customize_input_type_list(simple_list<input_type_entry> &typelist) override;
+	virtual void input_update() override;
 
 	virtual void video_register() override;
 
@@ -81,6 +81,7 @@ const options_entry sdl_options::s_option_entries[] =
 	// performance options
 	{ nullptr,                                nullptr,       OPTION_HEADER,     "SDL PERFORMANCE OPTIONS" },
 	{ SDLOPTION_SDLVIDEOFPS,                  "0",        OPTION_BOOLEAN,    "show sdl video performance" },
+	{ SDLOPTION_RENDERQUEUE,                  "0",        OPTION_INTEGER,    "frames that may wait for each window's render thread (0-2, 0 draws on the emulation thread)" },
 	// video options
 	{ nullptr,                                nullptr,       OPTION_HEADER,     "SDL VIDEO OPTIONS" },
 // OS X can be trusted to have working hardware OpenGL, so default to it on for the best user experience
@@ -109,15 +109,24 @@ void sdl_osd_interface::update(bool skip_redraw)
 //      profiler_mark(PROFILER_END);
 	}
 
-	// poll the joystick values here
-	downcast<sdl_osd_interface&>(machine().osd()).poll_inputs(machine());
-
-	check_osd_inputs(machine());
 	// if we're running, disable some parts of the debugger
 	if ((machine().debug_flags & DEBUG_FLAG_OSD_ENABLED) != 0)
 		debugger_update();
 }
 
+
+//============================================================
+//  input_update
+//============================================================
+
+void sdl_osd_interface::input_update()
+{
+	// poll the joystick values here
+	poll_inputs(machine());
+
+	check_osd_inputs(machine());
+}
+
 //============================================================
 //  check_osd_inputs
 //============================================================
@@ -235,11 +244,25 @@ void sdl_osd_interface::extract_video_config()
 		video_config.mode = VIDEO_MODE_SOFT;
 	}
 
+	// render thread: primitive lists are double-buffered, so more than two frames can't be in flight
+	video_config.renderqueue = options().render_queue();
+	if (video_config.renderqueue < 0 || video_config.renderqueue > 2)
+	{
+		osd_printf_warning("Invalid renderqueue value %d; reverting to 0\n", video_config.renderqueue);
+		video_config.renderqueue = 0;
+	}
+	if (video_config.renderqueue > 0 && video_config.mode == VIDEO_MODE_BGFX)
+	{
+		// BGFX calls are tied to one thread for all windows, and it has its own render thread anyway
+		osd_printf_verbose("BGFX presents from its own thread; ignoring -renderqueue\n");
+		video_config.renderqueue = 0;
+	}
+
 	video_config.switchres     = options().switch_res();
 	video_config.centerh       = options().centerh();
 	video_config.centerv       = options().centerv();
 	video_config.waitvsync     = options().wait_vsync();
-	video_config.syncrefresh   = options().sync_refresh();
+	video_config.syncrefresh   = options().sync_refresh() && !options().vrr();
 	if (!video_config.waitvsync && video_config.syncrefresh)
 	{
 		osd_printf_warning("-syncrefresh specified without -waitvsync. Reverting to -nosyncrefresh\n");
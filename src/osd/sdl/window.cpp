@@ -38,6 +38,7 @@
 #include "modules/render/drawsdl.h"
 #include "modules/render/draw13.h"
 #include "modules/monitor/monitor_common.h"
+#include "osdsync.h"
 #if (USE_OPENGL)
 #include "modules/render/drawogl.h"
 #endif
@@ -296,7 +297,7 @@ void sdl_window_info::toggle_full_screen()
 	// reset UI to main menu
 	machine().ui().menu_reset();
 	// kill off the drawers
-	renderer_reset();
+	run_on_render_thread([this] () { renderer_reset(); });
 	bool is_osx = false;
 #ifdef SDLMAME_MACOSX
 	// FIXME: This is weird behaviour and certainly a bug in SDL
@@ -418,6 +419,13 @@ int sdl_window_info::window_init()
 	// set the specific view
 	set_starting_view(m_index, options.view(), options.view(m_index));
 
+	// the renderer is created, used and destroyed on the render thread, if there is one
+	if (video_config.renderqueue > 0)
+	{
+		m_render_thread = std::thread([this] () { render_thread_main(); });
+		osd_thread_apply_class(&m_render_thread, OSD_THREAD_RENDER);
+	}
+
 	// make the window title
 	if (video_config.numscreens == 1)
 		sprintf(m_title, "%s: %s [%s]", emulator_info::get_appname(), m_machine.system().type.fullname(), m_machine.system().name);
@@ -444,6 +452,9 @@ error:
 
 void sdl_window_info::complete_destroy()
 {
+	// let queued frames finish with the window first
+	run_on_render_thread([] () { });
+
 	// Release pointer grab and hide if needed
 	show_pointer();
 	release_pointer();
@@ -469,6 +480,7 @@ void sdl_window_info::destroy()
 
 	// free the textures etc
 	complete_destroy();
+	stop_render_thread();
 
 	// free the render target, after the textures!
 	machine().render().target_free(m_target);
@@ -593,7 +605,12 @@ void sdl_window_info::update()
 
 		if (m_rendered_event.wait(event_wait_ticks))
 		{
-			const int update = 1;
+			// with a render thread, wait for room in the queue before touching a primitive list it may still be drawing
+			if (m_render_thread.joinable())
+			{
+				std::unique_lock<std::mutex> lock(m_render_mutex);
+				m_render_cond.wait(lock, [this] () { return m_render_tasks.size() <= size_t(video_config.renderqueue); });
+			}
 
 			// ensure the target bounds are up-to-date, and then get the primitives
 
@@ -614,19 +631,17 @@ void sdl_window_info::update()
 					renderer().clear_flags(osd_renderer::FLAG_HAS_VECTOR_SCREEN);
 			}
 
-			m_primlist = &primlist;
-
-			// if no bitmap, just fill
-			if (m_primlist == nullptr)
+			if (m_render_thread.joinable())
 			{
+				// hand the list over and carry on with the next frame
+				std::lock_guard<std::mutex> lock(m_render_mutex);
+				render_primitive_list *const list = &primlist;
+				m_render_tasks.emplace_back([this, list] () { draw_primlist(list); });
+				m_render_cond.notify_all();
 			}
-			// otherwise, render with our drawing system
 			else
 			{
-				if( video_config.perftest )
-					measure_fps(update);
-				else
-					renderer().draw(update);
+				draw_primlist(&primlist);
 			}
 
 			/* all done, ready for next */
@@ -636,6 +651,100 @@ void sdl_window_info::update()
 }
 
 
+//============================================================
+//  draw_primlist
+//  (main or render thread)
+//============================================================
+
+void sdl_window_info::draw_primlist(render_primitive_list *primlist)
+{
+	const int update = 1;
+
+	m_primlist = primlist;
+
+	// if no bitmap, just fill
+	if (m_primlist == nullptr)
+	{
+	}
+	// otherwise, render with our drawing system
+	else
+	{
+		if( video_config.perftest )
+			measure_fps(update);
+		else
+			renderer().draw(update);
+	}
+}
+
+
+//============================================================
+//  render_thread_main
+//  (render thread)
+//============================================================
+
+void sdl_window_info::render_thread_main()
+{
+	std::unique_lock<std::mutex> lock(m_render_mutex);
+	while (true)
+	{
+		m_render_cond.wait(lock, [this] () { return m_render_exit || !m_render_tasks.empty(); });
+		if (m_render_tasks.empty())
+			break;
+
+		// run the task unlocked, but leave it queued so the queue depth counts it
+		std::function<void ()> &task = m_render_tasks.front();
+		lock.unlock();
+		task();
+		lock.lock();
+		m_render_tasks.pop_front();
+		m_render_cond.notify_all();
+	}
+}
+
+
+//============================================================
+//  run_on_render_thread
+//  run a task after any queued frames and wait for it
+//  (main thread)
+//============================================================
+
+void sdl_window_info::run_on_render_thread(std::function<void ()> task)
+{
+	if (!m_render_thread.joinable())
+	{
+		task();
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_render_mutex);
+	m_render_tasks.emplace_back(std::move(task));
+	m_render_cond.notify_all();
+	m_render_cond.wait(lock, [this] () { return m_render_tasks.empty(); });
+}
+
+
+//============================================================
+//  stop_render_thread
+//  (main thread)
+//============================================================
+
+void sdl_window_info::stop_render_thread()
+{
+	if (!m_render_thread.joinable())
+		return;
+
+	// the renderer has to go on the thread that created it
+	run_on_render_thread([this] () { renderer_reset(); });
+
+	{
+		std::lock_guard<std::mutex> lock(m_render_mutex);
+		m_render_exit = true;
+		m_render_cond.notify_all();
+	}
+	m_render_thread.join();
+}
+
+
 //============================================================
 //  set_starting_view
 //  (main thread)
@@ -826,7 +935,9 @@ int sdl_window_info::complete_create()
 		monitor()->update_resolution(temp.width(), temp.height());
 
 	// initialize the drawing backend
-	if (renderer().create())
+	int result = 0;
+	run_on_render_thread([this, &result] () { result = renderer().create(); });
+	if (result)
 		return 1;
 
 	// Make sure we have a consistent state
@@ -1137,6 +1248,7 @@ sdl_window_info::sdl_window_info(
 	, m_windowed_dim(0, 0)
 	, m_rendered_event(0, 1)
 	, m_target(nullptr)
+	, m_render_exit(false)
 	, m_extra_flags(0)
 	, m_machine(a_machine)
 	, m_monitor(a_monitor)
@@ -1156,5 +1268,6 @@ sdl_window_info::sdl_window_info(
 
 sdl_window_info::~sdl_window_info()
 {
+	stop_render_thread();
 	global_free(m_original_mode);
 }
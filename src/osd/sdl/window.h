@@ -16,9 +16,14 @@
 
 #include "modules/osdwindow.h"
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <list>
+#include <mutex>
+#include <thread>
 
 
 //============================================================
@@ -86,6 +91,13 @@ private:
 	osd_event           m_rendered_event;
 	render_target *     m_target;
 
+	// pipelined presentation (-renderqueue)
+	std::thread                         m_render_thread;
+	std::mutex                          m_render_mutex;
+	std::condition_variable             m_render_cond;
+	std::deque<std::function<void ()>>  m_render_tasks;     // front is the one being run
+	bool                                m_render_exit;
+
 	// Original display_mode
 	SDL_DM_Wrapper      *m_original_mode;
 
@@ -116,6 +128,11 @@ private:
 	bool                               m_mouse_hidden;
 
 	void measure_fps(int update);
+	void draw_primlist(render_primitive_list *primlist);
+
+	void render_thread_main();
+	void run_on_render_thread(std::function<void ()> task);
+	void stop_render_thread();
 
 };
 
@@ -103,13 +103,22 @@ void windows_osd_interface::update(bool skip_redraw)
 //      profiler_mark(PROFILER_END);
 	}
 
+	// if we're running, disable some parts of the debugger
+	if ((machine().debug_flags & DEBUG_FLAG_OSD_ENABLED) != 0)
+		debugger_update();
+}
+
+
+//============================================================
+//  input_update
+//============================================================
+
+void windows_osd_interface::input_update()
+{
 	// poll the joystick values here
 	winwindow_process_events(machine(), true, false);
 	poll_input(machine());
 	check_osd_inputs();
-	// if we're running, disable some parts of the debugger
-	if ((machine().debug_flags & DEBUG_FLAG_OSD_ENABLED) != 0)
-		debugger_update();
 }
 
 
@@ -167,7 +176,7 @@ void windows_osd_interface::extract_video_config()
 		video_config.mode = VIDEO_MODE_GDI;
 	}
 	video_config.waitvsync     = options().wait_vsync();
-	video_config.syncrefresh   = options().sync_refresh();
+	video_config.syncrefresh   = options().sync_refresh() && !options().vrr();
 	video_config.triplebuf     = options().triple_buffer();
 	video_config.switchres     = options().switch_res();
 
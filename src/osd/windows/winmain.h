@@ -282,6 +282,7 @@ public:
 
 	// input overrideables
 	virtual void customize_input_type_list(simple_list<input_type_entry> &typelist) override;
+	virtual void input_update() override;
 
 	// video overridables
 	virtual void add_audio_to_recording(const int16_t *buffer, int samples_this_frame) override;
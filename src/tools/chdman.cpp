@@ -26,6 +26,8 @@
 #include <iostream>
 #include <cassert>
 #include <cstring>
+#include <functional>
+#include <future>
 #include <limits>
 #include <memory>
 #include <new>
@@ -104,6 +106,7 @@ const int MODE_GDI = 2;
 #define OPTION_VERBOSE "verbose"
 #define OPTION_FIX "fix"
 #define OPTION_NUMPROCESSORS "numprocessors"
+#define OPTION_ADAPTIVE "adaptive"
 #define OPTION_SIZE "size"
 #define OPTION_TEMPLATE "template"
 
@@ -115,6 +118,7 @@ const int MODE_GDI = 2;
 typedef std::unordered_map<std::string,std::string *> parameters_t;
 
 template <typename Format, typename... Params> static void report_error(int error, Format &&fmt, Params &&...args);
+static chd_error read_chd_bytes(chd_file &chd, uint64_t offset, void *buffer, uint32_t length);
 static void do_info(parameters_t &params);
 static void do_verify(parameters_t &params);
 static void do_create_raw(parameters_t &params);
@@ -154,7 +158,7 @@ struct command_description
 	const char *name;
 	void (*handler)(parameters_t &);
 	const char *description;
-	const char *valid_options[16];
+	const char *valid_options[20];
 };
 
 
@@ -292,7 +296,7 @@ public:
 			return 0;
 		if (offset + length > m_maxoffset)
 			length = m_maxoffset - offset;
-		chd_error err = m_file.read_bytes(offset, dest, length);
+		chd_error err = read_chd_bytes(m_file, offset, dest, length);
 		if (err != CHDERR_NONE)
 			throw err;
 
@@ -589,7 +593,8 @@ static const option_description s_options[] =
 	{ OPTION_INDEX,                 "ix",   true, " <index>: indexed instance of this metadata tag" },
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
-	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression or decompression" },
+	{ OPTION_ADAPTIVE,              "ad",   false, ": predict the best codec from recent hunks and skip hunks that look incompressible (faster, may compress slightly worse)" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -611,7 +616,8 @@ static const command_description s_commands[] =
 	{ COMMAND_VERIFY, do_verify, ": verifies a CHD's integrity",
 		{
 			REQUIRED OPTION_INPUT,
-			OPTION_INPUT_PARENT
+			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -628,7 +634,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_HUNK_SIZE,
 			REQUIRED OPTION_UNIT_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -649,7 +656,8 @@ static const command_description s_commands[] =
 			OPTION_CHS,
 			OPTION_SIZE,
 			OPTION_SECTOR_SIZE,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -661,7 +669,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_INPUT,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -675,7 +684,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_FRAMES,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -688,7 +698,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -701,7 +712,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -712,6 +724,7 @@ static const command_description s_commands[] =
 			OPTION_OUTPUT_FORCE,
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -722,7 +735,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
 			OPTION_INPUT_START_FRAME,
-			OPTION_INPUT_LENGTH_FRAMES
+			OPTION_INPUT_LENGTH_FRAMES,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -739,7 +753,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_HUNKS,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -1188,6 +1203,72 @@ static void parse_numprocessors(const parameters_t &params)
 }
 
 
+//-------------------------------------------------
+//  read_chd_bytes - read from a CHD like
+//  read_bytes, but decompress the whole hunks in
+//  the middle on all processors
+//-------------------------------------------------
+
+static chd_error read_chd_bytes(chd_file &chd, uint64_t offset, void *buffer, uint32_t length)
+{
+	uint8_t *dest = reinterpret_cast<uint8_t *>(buffer);
+	uint32_t const hunkbytes = chd.hunk_bytes();
+
+	// the partial hunk at the start, then all the whole ones, then the partial one at the end
+	uint32_t const lead = (std::min<uint64_t>)((hunkbytes - offset % hunkbytes) % hunkbytes, length);
+	uint32_t const hunks = (length - lead) / hunkbytes;
+	uint32_t const tail = length - lead - hunks * hunkbytes;
+
+	chd_error err = CHDERR_NONE;
+	if (lead != 0)
+		err = chd.read_bytes(offset, dest, lead);
+	if (err == CHDERR_NONE && hunks != 0)
+		err = chd.read_hunks((offset + lead) / hunkbytes, hunks, dest + lead);
+	if (err == CHDERR_NONE && tail != 0)
+		err = chd.read_bytes(offset + length - tail, dest + length - tail, tail);
+	return err;
+}
+
+
+//-------------------------------------------------
+//  read_chd_sequential - read a range of a CHD in
+//  order, handing each buffer to the consumer
+//  while the next one is decompressing
+//-------------------------------------------------
+
+static void read_chd_sequential(chd_file &chd, const std::string &name, uint64_t start, uint64_t end, const std::function<void (uint64_t offset, const uint8_t *data, uint32_t length)> &consume)
+{
+	std::vector<uint8_t> buffer[2];
+	for (auto &elem : buffer)
+		elem.resize((TEMP_BUFFER_SIZE / chd.hunk_bytes()) * chd.hunk_bytes());
+	auto length_at = [&buffer, end] (uint64_t offset) { return uint32_t((std::min<uint64_t>)(buffer[0].size(), end - offset)); };
+	auto read_async = [&chd, &buffer, &length_at] (int index, uint64_t offset)
+	{
+		uint8_t *dest = &buffer[index][0];
+		uint32_t length = length_at(offset);
+		return std::async(std::launch::async, [&chd, offset, dest, length] { return read_chd_bytes(chd, offset, dest, length); });
+	};
+
+	int current = 0;
+	std::future<chd_error> pending;
+	if (start < end)
+		pending = read_async(current, start);
+	for (uint64_t offset = start; offset < end; current ^= 1)
+	{
+		uint32_t length = length_at(offset);
+		chd_error err = pending.get();
+		if (err != CHDERR_NONE)
+			report_error(1, "Error reading CHD file (%s): %s", name.c_str(), chd_file::error_string(err));
+
+		// start on the next buffer before using this one
+		if (offset + length < end)
+			pending = read_async(current ^ 1, offset + length);
+		consume(offset, &buffer[current][0], length);
+		offset += length;
+	}
+}
+
+
 //-------------------------------------------------
 //  compression_string - create a friendly string
 //  describing a set of compressors
@@ -1222,9 +1303,10 @@ static const char *compression_string(std::string &str, chd_codec_type compressi
 //  compress_common - standard compression loop
 //-------------------------------------------------
 
-static void compress_common(chd_file_compressor &chd)
+static void compress_common(chd_file_compressor &chd, const parameters_t &params)
 {
 	// begin compressing
+	chd.set_adaptive_compression(params.find(OPTION_ADAPTIVE) != params.end());
 	chd.compress_begin();
 
 	// loop until done
@@ -1242,6 +1324,17 @@ static void compress_common(chd_file_compressor &chd)
 
 	// final progress update
 	progress(true, "Compression complete ... final ratio = %.1f%%            \n", 100.0 * ratio);
+
+	// summarize where the hunks went
+	chd_file_compressor::compress_stats const stats = chd.compression_stats();
+	if (chd.compressed())
+	{
+		progress(true, "Hunks: %d compressed, %d uncompressed, %d copied (%d repeated fills), %d from parent\n",
+				stats.compressed, stats.uncompressed, stats.self, stats.filled, stats.parent);
+		if (params.find(OPTION_ADAPTIVE) != params.end())
+			progress(true, "Codecs: %d attempts, %d skipped by prediction, %d hunks skipped as incompressible\n",
+					stats.codec_trials, stats.codec_skips, stats.incompressible);
+	}
 }
 
 
@@ -1566,25 +1659,16 @@ static void do_verify(parameters_t &params)
 	if (raw_sha1 == util::sha1_t::null)
 		report_error(0, "No verification to be done; CHD has no checksum");
 
-	// create an array to read into
-	std::vector<uint8_t> buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
+	// process numprocessors
+	parse_numprocessors(params);
 
 	// read all the data and build up an SHA-1
 	util::sha1_creator rawsha1;
-	for (uint64_t offset = 0; offset < input_chd.logical_bytes(); )
+	read_chd_sequential(input_chd, *params.find(OPTION_INPUT)->second, 0, input_chd.logical_bytes(), [&input_chd, &rawsha1] (uint64_t offset, const uint8_t *data, uint32_t length)
 	{
 		progress(false, "Verifying, %.1f%% complete... \r", 100.0 * double(offset) / double(input_chd.logical_bytes()));
-
-		// determine how much to read
-		uint32_t bytes_to_read = (std::min<uint64_t>)(buffer.size(), input_chd.logical_bytes() - offset);
-		chd_error err = input_chd.read_bytes(offset, &buffer[0], bytes_to_read);
-		if (err != CHDERR_NONE)
-			report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->second->c_str(), chd_file::error_string(err));
-
-		// add to the checksum
-		rawsha1.append(&buffer[0], bytes_to_read);
-		offset += bytes_to_read;
-	}
+		rawsha1.append(data, length);
+	});
 	util::sha1_t computed_sha1 = rawsha1.finish();
 
 	// finish up
@@ -1708,7 +1792,7 @@ static void do_create_raw(parameters_t &params)
 			chd->clone_all_metadata(output_parent);
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 	}
 	catch (...)
 	{
@@ -1917,7 +2001,7 @@ static void do_create_hd(parameters_t &params)
 
 		// compress it generically
 		if (input_file)
-			compress_common(*chd);
+			compress_common(*chd, params);
 	}
 	catch (...)
 	{
@@ -2007,7 +2091,7 @@ static void do_create_cd(parameters_t &params)
 			report_error(1, "Error adding CD metadata: %s", chd_file::error_string(err));
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 		delete chd;
 	}
 	catch (...)
@@ -2126,7 +2210,7 @@ static void do_create_ld(parameters_t &params)
 			report_error(1, "Error adding AV metadata: %s\n", chd_file::error_string(err));
 
 		// create the compressor and then run it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 
 		// write the final LD metadata
 		if (info.height == 524/2 || info.height == 624/2)
@@ -2270,7 +2354,7 @@ static void do_copy(parameters_t &params)
 		}
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 		delete chd;
 	}
 	catch (...)
@@ -2307,6 +2391,9 @@ static void do_extract_raw(parameters_t &params)
 	if (output_file_str != params.end())
 		check_existing_output_file(params, output_file_str->second->c_str());
 
+	// process numprocessors
+	parse_numprocessors(params);
+
 	// print some info
 	std::string tempstr;
 	printf("Output File:  %s\n", output_file_str->second->c_str());
@@ -2327,25 +2414,15 @@ static void do_extract_raw(parameters_t &params)
 			report_error(1, "Unable to open file (%s)", output_file_str->second->c_str());
 
 		// copy all data
-		std::vector<uint8_t> buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
-		for (uint64_t offset = input_start; offset < input_end; )
+		read_chd_sequential(input_chd, *params.find(OPTION_INPUT)->second, input_start, input_end, [&] (uint64_t offset, const uint8_t *data, uint32_t length)
 		{
 			progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(offset - input_start) / double(input_end - input_start));
 
-			// determine how much to read
-			uint32_t bytes_to_read = (std::min<uint64_t>)(buffer.size(), input_end - offset);
-			chd_error err = input_chd.read_bytes(offset, &buffer[0], bytes_to_read);
-			if (err != CHDERR_NONE)
-				report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->second->c_str(), chd_file::error_string(err));
-
 			// write to the output
-			uint32_t count = output_file->write(&buffer[0], bytes_to_read);
-			if (count != bytes_to_read)
+			uint32_t count = output_file->write(data, length);
+			if (count != length)
 				report_error(1, "Error writing to file; check disk space (%s)", output_file_str->second->c_str());
-
-			// advance
-			offset += bytes_to_read;
-		}
+		});
 
 		// finish up
 		output_file.reset();
@@ -2404,6 +2481,9 @@ static void do_extract_cd(parameters_t &params)
 
 	check_existing_output_file(params, output_bin_file_str->c_str());
 
+	// process numprocessors
+	parse_numprocessors(params);
+
 	// print some info
 	std::string tempstr;
 	printf("Output TOC:   %s\n", output_file_str->second->c_str());
@@ -2450,6 +2530,12 @@ static void do_extract_cd(parameters_t &params)
 			output_toc_file->printf("%d\n", toc->numtrks);
 		}
 
+		// frames are read a piece of a hunk at a time, so decompress a buffer's worth of hunks ahead
+		// on all processors and let the reads find them in the hunk cache
+		uint32_t const preload_hunks = TEMP_BUFFER_SIZE / input_chd.hunk_bytes();
+		uint32_t preloaded_start = 0, preloaded_end = 0;
+		chd_file::set_cache_budget(2 * uint64_t(preload_hunks) * input_chd.hunk_bytes());
+
 		// iterate over tracks and copy all data
 		uint64_t outputoffs = 0;
 		uint32_t discoffs = 0;
@@ -2508,6 +2594,17 @@ static void do_extract_cd(parameters_t &params)
 			{
 				progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(outputoffs) / double(total_bytes));
 
+				// make sure the hunk holding this frame is on its way
+				uint32_t const hunknum = uint64_t(trackinfo.chdframeofs + frame) * CD_FRAME_SIZE / input_chd.hunk_bytes();
+				if (hunknum < preloaded_start || hunknum >= preloaded_end)
+				{
+					chd_error err = input_chd.preload(hunknum, preload_hunks);
+					if (err != CHDERR_NONE)
+						report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->second->c_str(), chd_file::error_string(err));
+					preloaded_start = hunknum;
+					preloaded_end = hunknum + preload_hunks;
+				}
+
 				// read the data
 				cdrom_read_data(cdrom, cdrom_get_track_start_phys(cdrom, tracknum) + frame, &buffer[bufferoffs], trackinfo.trktype, true);
 
@@ -2631,6 +2728,9 @@ static void do_extract_ld(parameters_t &params)
 	if (output_file_str != params.end())
 		check_existing_output_file(params, output_file_str->second->c_str());
 
+	// process numprocessors
+	parse_numprocessors(params);
+
 	// print some info
 	std::string tempstr;
 	printf("Output File:  %s\n", output_file_str->second->c_str());
@@ -2662,40 +2762,39 @@ static void do_extract_ld(parameters_t &params)
 			avconfig.audio[chnum] = &audio_data[chnum][0];
 		}
 
-		// iterate over frames
+		// decode frames on all processors a buffer at a time, and write them out in order
 		bitmap_yuy16 fullbitmap(width, height * interlace_factor);
-		for (uint64_t framenum = input_start; framenum < input_end; framenum++)
+		uint32_t const hunkbytes = input_chd.hunk_bytes();
+		read_chd_sequential(input_chd, *params.find(OPTION_INPUT)->second, input_start * hunkbytes, input_end * hunkbytes, [&] (uint64_t offset, const uint8_t *data, uint32_t length)
 		{
-			progress(framenum == input_start, "Extracting, %.1f%% complete...  \r", 100.0 * double(framenum - input_start) / double(input_end - input_start));
+			for (uint64_t framenum = offset / hunkbytes; length != 0; framenum++, data += hunkbytes, length -= hunkbytes)
+			{
+				progress(framenum == input_start, "Extracting, %.1f%% complete...  \r", 100.0 * double(framenum - input_start) / double(input_end - input_start));
 
-			// set up the fake bitmap for this frame
-			avconfig.video.wrap(&fullbitmap.pix(framenum % interlace_factor), fullbitmap.width(), fullbitmap.height() / interlace_factor, fullbitmap.rowpixels() * interlace_factor);
-			input_chd.codec_configure(CHD_CODEC_AVHUFF, AVHUFF_CODEC_DECOMPRESS_CONFIG, &avconfig);
+				// set up the fake bitmap for this frame
+				avconfig.video.wrap(&fullbitmap.pix(framenum % interlace_factor), fullbitmap.width(), fullbitmap.height() / interlace_factor, fullbitmap.rowpixels() * interlace_factor);
 
-			// read the hunk into the buffers
-			chd_error err = input_chd.read_hunk(framenum, nullptr);
-			if (err != CHDERR_NONE)
-			{
-				uint64_t filepos = static_cast<util::core_file &>(input_chd).tell();
-				report_error(1, "Error reading hunk %d at offset %d from CHD file (%s): %s\n", framenum, filepos, params.find(OPTION_INPUT)->second->c_str(), chd_file::error_string(err));
-			}
+				// the hunks come out of the parallel decoders as raw streams; unpack into the buffers
+				if (avhuff_decoder::copy_raw_data(data, hunkbytes, avconfig) != AVHERR_NONE)
+					report_error(1, "Error decoding hunk %d from CHD file (%s)\n", framenum, params.find(OPTION_INPUT)->second->c_str());
 
-			// write audio
-			for (int chnum = 0; chnum < channels; chnum++)
-			{
-				avi_file::error avierr = output_file->append_sound_samples(chnum, avconfig.audio[chnum], actsamples, 0);
-				if (avierr != avi_file::error::NONE)
-					report_error(1, "Error writing samples for hunk %d to file (%s): %s\n", framenum, output_file_str->second->c_str(), avi_file::error_string(avierr));
-			}
+				// write audio
+				for (int chnum = 0; chnum < channels; chnum++)
+				{
+					avi_file::error avierr = output_file->append_sound_samples(chnum, avconfig.audio[chnum], actsamples, 0);
+					if (avierr != avi_file::error::NONE)
+						report_error(1, "Error writing samples for hunk %d to file (%s): %s\n", framenum, output_file_str->second->c_str(), avi_file::error_string(avierr));
+				}
 
-			// write video
-			if ((framenum + 1) % interlace_factor == 0)
-			{
-				avi_file::error avierr = output_file->append_video_frame(fullbitmap);
-				if (avierr != avi_file::error::NONE)
-					report_error(1, "Error writing video for hunk %d to file (%s): %s\n", framenum, output_file_str->second->c_str(), avi_file::error_string(avierr));
+				// write video
+				if ((framenum + 1) % interlace_factor == 0)
+				{
+					avi_file::error avierr = output_file->append_video_frame(fullbitmap);
+					if (avierr != avi_file::error::NONE)
+						report_error(1, "Error writing video for hunk %d to file (%s): %s\n", framenum, output_file_str->second->c_str(), avi_file::error_string(avierr));
+				}
 			}
-		}
+		});
 
 		// close and return
 		output_file.reset();
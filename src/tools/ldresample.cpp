@@ -14,6 +14,7 @@
 #include <math.h>
 #include <new>
 #include <assert.h>
+#include <algorithm>
 #include "bitmap.h"
 #include "chd.h"
 #include "avhuff.h"
@@ -38,6 +39,9 @@ const uint32_t SIGNAL_START_DEVIATIONS = 5;
 // number of consecutive entries of signal before we consider that we found it
 const uint32_t MINIMUM_SIGNAL_COUNT = 20;
 
+// number of fields resampled in parallel at a time
+const uint32_t RESAMPLE_BATCH_FIELDS = 32;
+
 
 
 //**************************************************************************
@@ -67,11 +71,8 @@ class chd_resample_compressor : public chd_file_compressor
 {
 public:
 	// construction/destruction
-	chd_resample_compressor(chd_file &source, movie_info &info, int64_t ioffset, int64_t islope)
-		: m_source(source),
-			m_info(info),
-			m_ioffset(ioffset),
-			m_islope(islope) { }
+	chd_resample_compressor(chd_file &source, movie_info &info, int64_t ioffset, int64_t islope);
+	~chd_resample_compressor();
 
 	// read interface
 	virtual uint32_t read_data(void *_dest, uint64_t offset, uint32_t length)
@@ -83,23 +84,43 @@ public:
 		uint32_t endfield = startfield + length / m_source.hunk_bytes();
 		uint8_t *dest = reinterpret_cast<uint8_t *>(_dest);
 
-		for (uint32_t fieldnum = startfield; fieldnum < endfield; fieldnum++)
+		for (uint32_t fieldnum = startfield; fieldnum < endfield; fieldnum += RESAMPLE_BATCH_FIELDS)
 		{
-			generate_one_frame(dest, m_source.hunk_bytes(), fieldnum);
-			dest += m_source.hunk_bytes();
+			uint32_t count = std::min(endfield - fieldnum, RESAMPLE_BATCH_FIELDS);
+			generate_frames(dest, fieldnum, count);
+			dest += count * m_source.hunk_bytes();
 		}
 		return length;
 	}
 
 private:
+	// one field's worth of work for the resampling queue
+	struct frame_job
+	{
+		chd_resample_compressor *   m_owner;
+		movie_info *                m_info;             // scratch buffers for this job
+		uint8_t *                   m_dest;
+		uint32_t                    m_fieldnum;
+	};
+
 	// internal helpers
-	void generate_one_frame(uint8_t *dest, uint32_t datasize, uint32_t fieldnum);
+	void field_range(uint32_t fieldnum, int64_t &dstbegin, int32_t &dstbeginfield, uint32_t &dstbeginoffset, int64_t &dstend, int32_t &dstendfield, uint32_t &dstendoffset) const;
+	void generate_frames(uint8_t *dest, uint32_t firstfield, uint32_t count);
+	static void *generate_frame_static(void *param, int threadid);
+	void generate_one_frame(uint8_t *dest, uint32_t datasize, uint32_t fieldnum, movie_info &info);
+	bool read_raw(uint32_t field, movie_info &info, uint32_t soundoffs);
 
 	// internal state
 	chd_file &                  m_source;
 	movie_info &                m_info;
 	int64_t                       m_ioffset;
 	int64_t                       m_islope;
+	osd_work_queue *            m_queue;            // runs the fields of a batch on all processors
+	std::vector<movie_info>     m_scratch;          // per-job buffers, reused from batch to batch
+	std::vector<frame_job>      m_jobs;
+	std::vector<uint8_t>        m_raw;              // raw source fields covering the current batch
+	uint32_t                    m_raw_first;
+	uint32_t                    m_raw_count;
 };
 
 
@@ -405,17 +426,61 @@ static bool find_edge_near_field(chd_file &srcfile, uint32_t fieldnum, movie_inf
 
 
 //-------------------------------------------------
-//  generate_one_frame - generate a single
-//  resampled frame
+//  chd_resample_compressor - constructor
+//-------------------------------------------------
+
+chd_resample_compressor::chd_resample_compressor(chd_file &source, movie_info &info, int64_t ioffset, int64_t islope)
+	: m_source(source),
+		m_info(info),
+		m_ioffset(ioffset),
+		m_islope(islope),
+		m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI)),
+		m_scratch(RESAMPLE_BATCH_FIELDS),
+		m_jobs(RESAMPLE_BATCH_FIELDS),
+		m_raw_first(0),
+		m_raw_count(0)
+{
+	// each job gets its own copy of the buffers the resampler works in
+	for (movie_info &scratch : m_scratch)
+	{
+		scratch.framerate = info.framerate;
+		scratch.iframerate = info.iframerate;
+		scratch.numfields = info.numfields;
+		scratch.width = info.width;
+		scratch.height = info.height;
+		scratch.samplerate = info.samplerate;
+		scratch.channels = info.channels;
+		scratch.interlaced = info.interlaced;
+		scratch.bitmap.resize(info.width, info.height);
+		scratch.lsound.resize(info.lsound.size());
+		scratch.rsound.resize(info.rsound.size());
+		scratch.samples = 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  ~chd_resample_compressor - destructor
+//-------------------------------------------------
+
+chd_resample_compressor::~chd_resample_compressor()
+{
+	if (m_queue != nullptr)
+		osd_work_queue_free(m_queue);
+}
+
+
+//-------------------------------------------------
+//  field_range - determine the source samples,
+//  as fields and offsets, that map onto a field
+//  of the destination
 //-------------------------------------------------
 
-void chd_resample_compressor::generate_one_frame(uint8_t *dest, uint32_t datasize, uint32_t fieldnum)
+void chd_resample_compressor::field_range(uint32_t fieldnum, int64_t &dstbegin, int32_t &dstbeginfield, uint32_t &dstbeginoffset, int64_t &dstend, int32_t &dstendfield, uint32_t &dstendoffset) const
 {
 	// determine the first field needed to cover this range of samples
 	uint32_t srcbegin = field_to_sample_number(m_info, fieldnum);
-	int64_t dstbegin = (int64_t(srcbegin) << 24) + m_ioffset + m_islope * fieldnum;
-	uint32_t dstbeginoffset;
-	int32_t dstbeginfield;
+	dstbegin = (int64_t(srcbegin) << 24) + m_ioffset + m_islope * fieldnum;
 	if (dstbegin >= 0)
 		dstbeginfield = sample_number_to_field(m_info, dstbegin >> 24, dstbeginoffset);
 	else
@@ -426,9 +491,7 @@ void chd_resample_compressor::generate_one_frame(uint8_t *dest, uint32_t datasiz
 
 	// determine the last field needed to cover this range of samples
 	uint32_t srcend = field_to_sample_number(m_info, fieldnum + 1);
-	int64_t dstend = (int64_t(srcend) << 24) + m_ioffset + m_islope * (fieldnum + 1);
-	uint32_t dstendoffset;
-	int32_t dstendfield;
+	dstend = (int64_t(srcend) << 24) + m_ioffset + m_islope * (fieldnum + 1);
 	if (dstend >= 0)
 		dstendfield = sample_number_to_field(m_info, dstend >> 24, dstendoffset);
 	else
@@ -436,6 +499,106 @@ void chd_resample_compressor::generate_one_frame(uint8_t *dest, uint32_t datasiz
 		dstendfield = -1 - -sample_number_to_field(m_info, -dstend >> 24, dstendoffset);
 		dstendoffset = (field_to_sample_number(m_info, -dstendfield) - field_to_sample_number(m_info, -dstendfield - 1)) - dstendoffset;
 	}
+}
+
+
+//-------------------------------------------------
+//  generate_frames - generate a batch of
+//  resampled frames on all processors
+//-------------------------------------------------
+
+void chd_resample_compressor::generate_frames(uint8_t *dest, uint32_t firstfield, uint32_t count)
+{
+	// find every source field the batch draws on
+	int64_t dstbegin, dstend;
+	int32_t dstbeginfield, dstendfield;
+	uint32_t dstbeginoffset, dstendoffset;
+	int64_t lowfield = firstfield, highfield = firstfield + count - 1;
+	for (uint32_t fieldnum = firstfield; fieldnum < firstfield + count; fieldnum++)
+	{
+		field_range(fieldnum, dstbegin, dstbeginfield, dstbeginoffset, dstend, dstendfield, dstendoffset);
+		lowfield = std::min<int64_t>(lowfield, dstbeginfield);
+		highfield = std::max<int64_t>(highfield, dstendfield);
+	}
+	lowfield = std::max<int64_t>(lowfield, 0);
+	highfield = std::min<int64_t>(highfield, m_source.hunk_count() - 1);
+
+	// decode them all up front; read_hunks spreads the work over all processors
+	m_raw_first = lowfield;
+	m_raw_count = highfield + 1 - lowfield;
+	m_raw.resize(uint64_t(m_raw_count) * m_source.hunk_bytes());
+	chd_error err = m_source.read_hunks(m_raw_first, m_raw_count, &m_raw[0]);
+	if (err != CHDERR_NONE)
+		throw err;
+
+	// then resample and reassemble each field in parallel into its own slot
+	for (uint32_t jobnum = 0; jobnum < count; jobnum++)
+	{
+		frame_job &job = m_jobs[jobnum];
+		job.m_owner = this;
+		job.m_info = &m_scratch[jobnum];
+		job.m_dest = dest + jobnum * m_source.hunk_bytes();
+		job.m_fieldnum = firstfield + jobnum;
+	}
+	osd_work_item_queue_multiple(m_queue, generate_frame_static, count, &m_jobs[0], sizeof(m_jobs[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(m_queue, osd_ticks_per_second())) { }
+}
+
+
+//-------------------------------------------------
+//  generate_frame_static - work item callback
+//  that generates one frame of a batch
+//-------------------------------------------------
+
+void *chd_resample_compressor::generate_frame_static(void *param, int threadid)
+{
+	frame_job &job = *reinterpret_cast<frame_job *>(param);
+	job.m_owner->generate_one_frame(job.m_dest, job.m_owner->m_source.hunk_bytes(), job.m_fieldnum, *job.m_info);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  read_raw - unpack a field of the current batch
+//  into a set of buffers, or silence if it is
+//  off either end of the disc
+//-------------------------------------------------
+
+bool chd_resample_compressor::read_raw(uint32_t field, movie_info &info, uint32_t soundoffs)
+{
+	if (field >= m_raw_first && field - m_raw_first < m_raw_count)
+	{
+		avhuff_decompress_config avconfig;
+		avconfig.video.wrap(info.bitmap, info.bitmap.cliprect());
+		avconfig.maxsamples = info.lsound.size() - soundoffs;
+		avconfig.actsamples = &info.samples;
+		avconfig.audio[0] = &info.lsound[soundoffs];
+		avconfig.audio[1] = &info.rsound[soundoffs];
+		const uint8_t *raw = &m_raw[uint64_t(field - m_raw_first) * m_source.hunk_bytes()];
+		if (avhuff_decoder::copy_raw_data(raw, m_source.hunk_bytes(), avconfig) == AVHERR_NONE)
+			return true;
+	}
+
+	info.samples = field_to_sample_number(info, field + 1) - field_to_sample_number(info, field);
+	memset(&info.lsound[soundoffs], 0, info.samples * sizeof(info.lsound[0]));
+	memset(&info.rsound[soundoffs], 0, info.samples * sizeof(info.rsound[0]));
+	return false;
+}
+
+
+//-------------------------------------------------
+//  generate_one_frame - generate a single
+//  resampled frame
+//-------------------------------------------------
+
+void chd_resample_compressor::generate_one_frame(uint8_t *dest, uint32_t datasize, uint32_t fieldnum, movie_info &info)
+{
+	int64_t dstbegin, dstend;
+	int32_t dstbeginfield, dstendfield;
+	uint32_t dstbeginoffset, dstendoffset;
+	field_range(fieldnum, dstbegin, dstbeginfield, dstbeginoffset, dstend, dstendfield, dstendoffset);
+	uint32_t srcbegin = field_to_sample_number(info, fieldnum);
+	uint32_t srcend = field_to_sample_number(info, fieldnum + 1);
 /*
 printf("%5d: start=%10d (%5d.%03d) end=%10d (%5d.%03d)\n",
         fieldnum,
@@ -447,14 +610,14 @@ printf("%5d: start=%10d (%5d.%03d) end=%10d (%5d.%03d)\n",
 	for (int32_t dstfield = dstbeginfield; dstfield <= dstendfield; dstfield++)
 	{
 		if (dstfield >= 0)
-			read_chd(m_source, dstfield, m_info, dstoffset);
+			read_raw(dstfield, info, dstoffset);
 		else
 		{
-			m_info.samples = field_to_sample_number(m_info, -dstfield) - field_to_sample_number(m_info, -dstfield - 1);
-			memset(&m_info.lsound[dstoffset], 0, m_info.samples * sizeof(m_info.lsound[0]));
-			memset(&m_info.rsound[dstoffset], 0, m_info.samples * sizeof(m_info.rsound[0]));
+			info.samples = field_to_sample_number(info, -dstfield) - field_to_sample_number(info, -dstfield - 1);
+			memset(&info.lsound[dstoffset], 0, info.samples * sizeof(info.lsound[0]));
+			memset(&info.rsound[dstoffset], 0, info.samples * sizeof(info.rsound[0]));
 		}
-		dstoffset += m_info.samples;
+		dstoffset += info.samples;
 	}
 
 	// resample the destination samples to the source
@@ -463,18 +626,18 @@ printf("%5d: start=%10d (%5d.%03d) end=%10d (%5d.%03d)\n",
 	int64_t dststep = (dstend - dstbegin) / int64_t(srcend - srcbegin);
 	for (uint32_t srcoffset = 0; srcoffset < srcend - srcbegin; srcoffset++)
 	{
-		m_info.lsound[srcoffset] = m_info.lsound[(int)(dstoffset + dstbeginoffset + (dstpos >> 24) - (dstbegin >> 24))];
-		m_info.rsound[srcoffset] = m_info.rsound[(int)(dstoffset + dstbeginoffset + (dstpos >> 24) - (dstbegin >> 24))];
+		info.lsound[srcoffset] = info.lsound[(int)(dstoffset + dstbeginoffset + (dstpos >> 24) - (dstbegin >> 24))];
+		info.rsound[srcoffset] = info.rsound[(int)(dstoffset + dstbeginoffset + (dstpos >> 24) - (dstbegin >> 24))];
 		dstpos += dststep;
 	}
 
 	// read the original frame, pointing the sound buffer past where we've calculated
-	read_chd(m_source, fieldnum, m_info, srcend - srcbegin);
+	read_raw(fieldnum, info, srcend - srcbegin);
 
 	// assemble the final frame
 	std::vector<uint8_t> buffer;
-	int16_t *sampledata[2] = { &m_info.lsound[0], &m_info.rsound[0] };
-	avhuff_encoder::assemble_data(buffer, m_info.bitmap, m_info.channels, m_info.samples, sampledata);
+	int16_t *sampledata[2] = { &info.lsound[0], &info.rsound[0] };
+	avhuff_encoder::assemble_data(buffer, info.bitmap, info.channels, info.samples, sampledata);
 	memcpy(dest, &buffer[0], std::min(buffer.size(), size_t(datasize)));
 	if (buffer.size() < datasize)
 		memset(&dest[buffer.size()], 0, datasize - buffer.size());
@@ -162,6 +162,7 @@ using util::BIT;
 #include <stdexcept>
 
 #include <ctype.h>
+#include <zlib.h>
 
 using u8 = util::u8;
 using u16 = util::u16;
@@ -295,6 +296,7 @@ struct options
 	const dasm_table_entry *dasm;
 	uint32_t                skip;
 	uint32_t                count;
+	uint8_t                 trace;
 };
 
 static const dasm_table_entry dasm_table[] =
@@ -901,6 +903,8 @@ static int parse_options(int argc, char *argv[], options *opts)
 				opts->norawbytes = true;
 			else if(tolower((uint8_t)curarg[1]) == 'u')
 				opts->upper = true;
+			else if(tolower((uint8_t)curarg[1]) == 't')
+				opts->trace = true;
 			else
 				goto usage;
 		}
@@ -967,8 +971,8 @@ static int parse_options(int argc, char *argv[], options *opts)
 	if(pending_base || pending_arch || pending_mode || pending_skip || pending_count)
 		goto usage;
 
-	// if no file or no architecture, fail
-	if(opts->filename == nullptr || opts->dasm == nullptr)
+	// if no file or no architecture, fail; traces name their own architecture
+	if(opts->filename == nullptr || (opts->dasm == nullptr && !opts->trace))
 		goto usage;
 	return 0;
 
@@ -976,6 +980,7 @@ usage:
 	printf("Usage: %s <filename> -arch <architecture> [-basepc <pc>] \n", argv[0]);
 	printf("   [-mode <n>] [-norawbytes] [-flipped] [-upper] [-lower]\n");
 	printf("   [-skip <n>] [-count <n>]\n");
+	printf("       %s <filename> -trace [-arch <architecture>] [-upper] [-lower]\n", argv[0]);
 	printf("\n");
 	printf("Supported architectures:");
 	const int colwidth = 1 + std::strlen(std::max_element(std::begin(dasm_table), std::end(dasm_table), [](const dasm_table_entry &a, const dasm_table_entry &b) { return std::strlen(a.name) < std::strlen(b.name); })->name);
@@ -995,6 +1000,200 @@ usage:
 };
 
 
+// Binary trace record types, as written by the debugger's "trace" command with the "binary" flag
+enum : u8 {
+	TRACE_HEADER = 0,
+	TRACE_INSTRUCTION,
+	TRACE_REGISTER,
+	TRACE_READ,
+	TRACE_WRITE,
+	TRACE_LOOPS,
+	TRACE_TEXT
+};
+
+class trace_reader
+{
+public:
+	trace_reader(gzFile file) : file(file), ok(true) {}
+
+	bool good() const { return ok; }
+
+	u64 get(int bytes) {
+		u8 buf[8];
+		if(!read(buf, bytes))
+			return 0;
+		u64 r = 0;
+		for(int i = bytes - 1; i >= 0; i--)
+			r = (r << 8) | buf[i];
+		return r;
+	}
+
+	std::string get_string() {
+		std::string r(get(2), '\0');
+		if(!r.empty() && !read(&r[0], r.size()))
+			r.clear();
+		return r;
+	}
+
+	bool read(void *dest, unsigned length) {
+		if(ok && length && gzread(file, dest, length) != int(length))
+			ok = false;
+		return ok;
+	}
+
+private:
+	gzFile file;
+	bool ok;
+};
+
+static int convert_trace(const options &opts)
+{
+	gzFile file = gzopen(opts.filename, "rb");
+	if(!file) {
+		fprintf(stderr, "Error opening file '%s'\n", opts.filename);
+		return 1;
+	}
+
+	trace_reader reader(file);
+	const dasm_table_entry *entry = nullptr;
+	std::unique_ptr<util::disasm_interface> disasm;
+	std::unique_ptr<unidasm_data_buffer> buffer;
+	int addr_shift = 0;
+	int pc_digits = 8;
+	std::vector<std::pair<std::string, int>> registers;
+	std::string changes;
+
+	auto tf = [&opts](std::string str) -> std::string {
+		if(opts.lower)
+			std::transform(str.begin(), str.end(), str.begin(), [](char c) { return tolower(c); });
+		else if(opts.upper)
+			std::transform(str.begin(), str.end(), str.begin(), [](char c) { return toupper(c); });
+		return str;
+	};
+
+	int type;
+	while((type = gzgetc(file)) >= 0) {
+		switch(type) {
+		case TRACE_HEADER: {
+			char magic[8];
+			if(!reader.read(magic, 8) || memcmp(magic, "MAMETRAC", 8) || reader.get(1) != 1) {
+				fprintf(stderr, "'%s' is not a binary trace file\n", opts.filename);
+				gzclose(file);
+				return 1;
+			}
+			addr_shift = int8_t(reader.get(1));
+			pc_digits = (reader.get(1) + 3) / 4;
+			std::string tag = reader.get_string();
+			std::string shortname = reader.get_string();
+			registers.clear();
+			for(u32 count = reader.get(2); count && reader.good(); count--) {
+				std::string name = reader.get_string();
+				registers.emplace_back(name, reader.get(1));
+			}
+			changes.clear();
+
+			// the device's short name picks the disassembler when -arch isn't given
+			if(opts.dasm)
+				entry = opts.dasm;
+			else {
+				entry = nullptr;
+				for(const auto &arch : dasm_table)
+					if(!core_stricmp(shortname.c_str(), arch.name))
+						entry = &arch;
+				if(!entry) {
+					fprintf(stderr, "No disassembler named '%s', use -arch\n", shortname.c_str());
+					gzclose(file);
+					return 1;
+				}
+			}
+			disasm.reset(entry->alloc());
+			buffer = std::make_unique<unidasm_data_buffer>(disasm.get(), entry);
+			util::stream_format(std::cout, "; %s (%s)\n", tag, shortname);
+			break;
+		}
+
+		case TRACE_INSTRUCTION: {
+			offs_t pc = reader.get(4);
+			std::vector<u8> bytes(reader.get(1));
+			if(!bytes.empty())
+				reader.read(&bytes[0], bytes.size());
+			if(!buffer) {
+				fprintf(stderr, "Trace record before the header\n");
+				gzclose(file);
+				return 1;
+			}
+
+			// registers changed by the previous instruction
+			if(!changes.empty()) {
+				util::stream_format(std::cout, "   %s\n", changes);
+				changes.clear();
+			}
+
+			// the debugger gives wide bus units low byte first
+			if(addr_shift < 0 && entry->endian == be) {
+				int unit = 1 << -addr_shift;
+				for(size_t i = 0; i + unit <= bytes.size(); i += unit)
+					std::reverse(bytes.begin() + i, bytes.begin() + i + unit);
+			}
+			buffer->size = bytes.size();
+			buffer->base_pc = pc;
+			bytes.resize(bytes.size() + 8, 0x00);
+			buffer->data = std::move(bytes);
+
+			std::ostringstream stream;
+			disasm->disassemble(stream, pc, *buffer, *buffer);
+			util::stream_format(std::cout, "%0*x: %s\n", pc_digits, pc, tf(stream.str()));
+			break;
+		}
+
+		case TRACE_REGISTER: {
+			u32 index = reader.get(2);
+			u64 value = reader.get(8);
+			if(index < registers.size())
+				changes += util::string_format(" %s=%0*X", registers[index].first, registers[index].second, value);
+			break;
+		}
+
+		case TRACE_READ:
+		case TRACE_WRITE: {
+			int space = reader.get(1);
+			offs_t address = reader.get(4);
+			u64 data = reader.get(8);
+			u64 mem_mask = reader.get(8);
+			util::stream_format(std::cout, "    %c %d:%0*X = %X & %X\n", type == TRACE_WRITE ? 'W' : 'R', space, pc_digits, address, data, mem_mask);
+			break;
+		}
+
+		case TRACE_LOOPS:
+			util::stream_format(std::cout, "\n   (loops for %d instructions)\n\n", int(reader.get(4)));
+			break;
+
+		case TRACE_TEXT: {
+			std::string text(reader.get(4), '\0');
+			if(!text.empty() && reader.read(&text[0], text.size()))
+				std::cout << text;
+			break;
+		}
+
+		default:
+			fprintf(stderr, "Unknown trace record type %d\n", type);
+			gzclose(file);
+			return 1;
+		}
+
+		if(!reader.good()) {
+			fprintf(stderr, "Trace file '%s' is truncated\n", opts.filename);
+			break;
+		}
+	}
+	if(!changes.empty())
+		util::stream_format(std::cout, "   %s\n", changes);
+
+	gzclose(file);
+	return 0;
+}
+
+
 int main(int argc, char *argv[])
 {
 	// Parse options first
@@ -1002,6 +1201,10 @@ int main(int argc, char *argv[])
 	if(parse_options(argc, argv, &opts))
 		return 1;
 
+	// Binary debugger traces are converted instead
+	if(opts.trace)
+		return convert_trace(opts);
+
 	// Load the file
 	void *data;
 	uint32_t length;
@@ -0,0 +1,93 @@
+#include "catch.hpp"
+
+#include "emucore.h"
+#include "debug/express.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// a table with a variable, a constant, a function and a memory space that logs its accesses
+struct express_test_table
+{
+	express_test_table() : symbols(nullptr)
+	{
+		symbols.add("x", symbol_table::READ_WRITE, &x);
+		symbols.add("limit", 0x40);
+		symbols.add("twice", 1, 1, [this] (symbol_table &table, int numparams, const u64 *paramlist) -> u64 {
+			log.push_back("twice");
+			return paramlist[0] * 2;
+		});
+		symbols.configure_memory(nullptr,
+				[] (void *param, const char *name, expression_space space) { return expression_error::NONE; },
+				[this] (void *param, const char *name, expression_space space, u32 offset, int size, bool disable_se) -> u64 {
+					log.push_back("r" + std::to_string(offset));
+					return offset * 2;
+				},
+				[this] (void *param, const char *name, expression_space space, u32 offset, int size, u64 value, bool disable_se) {
+					log.push_back("w" + std::to_string(offset) + "=" + std::to_string(value));
+				});
+	}
+
+	u64 run(const char *string)
+	{
+		parsed_expression expression(&symbols, string);
+		return expression.execute();
+	}
+
+	u64 x = 0;
+	std::vector<std::string> log;
+	symbol_table symbols;
+};
+
+} // anonymous namespace
+
+
+TEST_CASE("compiled expressions follow operator precedence", "[debug]")
+{
+	// numbers are hexadecimal unless prefixed
+	express_test_table table;
+	REQUIRE(table.run("1+2*3") == 7);
+	REQUIRE(table.run("(1+2)*3") == 9);
+	REQUIRE(table.run("10/3") == 5);
+	REQUIRE(table.run("10%3") == 1);
+	REQUIRE(table.run("1<<4|1") == 17);
+	REQUIRE(table.run("~0") == ~u64(0));
+	REQUIRE(table.run("5!=5") == 0);
+	REQUIRE(table.run("5>3 && 2<1") == 0);
+	REQUIRE(table.run("limit-1") == 0x3f);
+}
+
+TEST_CASE("compiled expressions assign through symbols", "[debug]")
+{
+	express_test_table table;
+	table.x = 5;
+	REQUIRE(table.run("x = x + 3") == 8);
+	REQUIRE(table.x == 8);
+	REQUIRE(table.run("x += 2") == 10);
+	REQUIRE(table.x == 10);
+	REQUIRE(table.run("x++") == 10);
+	REQUIRE(table.x == 11);
+	REQUIRE(table.run("--x") == 10);
+	REQUIRE(table.x == 10);
+}
+
+TEST_CASE("compiled expressions keep the order of side effects", "[debug]")
+{
+	// the token executor reads the right operand of a binary operator first
+	express_test_table table;
+	REQUIRE(table.run("b@10 + b@20") == 0x60);
+	REQUIRE((table.log == std::vector<std::string>{ "r32", "r16" }));
+
+	table.log.clear();
+	REQUIRE(table.run("b@30 = twice(b@10)") == 0x40);
+	REQUIRE((table.log == std::vector<std::string>{ "r16", "twice", "w48=64" }));
+}
+
+TEST_CASE("compiled expressions still divide by zero at run time", "[debug]")
+{
+	express_test_table table;
+	parsed_expression expression(&table.symbols, "x/0");
+	REQUIRE_THROWS_AS(expression.execute(), expression_error);
+}
@@ -0,0 +1,125 @@
+#include "catch.hpp"
+
+#include "delegate.h"
+
+namespace {
+
+struct delegate_test_base
+{
+	virtual ~delegate_test_base() { }
+	virtual int twice(int value) { return value * 2 + m_bias; }
+	int m_bias = 0;
+};
+
+struct delegate_test_other
+{
+	virtual ~delegate_test_other() { }
+	int plus(int value) { return value + m_other; }
+	int m_other = 100;
+};
+
+// second base makes pointers to its members carry a this adjustment
+struct delegate_test_target : delegate_test_base, delegate_test_other, delegate_late_bind
+{
+	virtual int twice(int value) override { return value * 2 + 1; }
+	int thrice(int value) { return value * 3; }
+	int quad(int value) const { return value * 4; }
+};
+
+int delegate_test_static(delegate_test_target *target, int value) { return target->m_other + value; }
+int delegate_test_static_ref(delegate_test_target &target, int value) { return target.m_other - value; }
+
+using test_delegate = delegate<int (int)>;
+
+} // anonymous namespace
+
+TEST_CASE("Delegate bound to a member function", "[util]")
+{
+	delegate_test_target target;
+	test_delegate cb(&delegate_test_target::thrice, &target);
+	REQUIRE(!cb.isnull());
+	REQUIRE(cb.has_object());
+	REQUIRE(cb(5) == 15);
+}
+
+TEST_CASE("Delegate bound to a const member function", "[util]")
+{
+	delegate_test_target target;
+	test_delegate cb(&delegate_test_target::quad, &target);
+	REQUIRE(cb(5) == 20);
+}
+
+TEST_CASE("Delegate bound to a virtual member function", "[util]")
+{
+	delegate_test_target target;
+	test_delegate cb(&delegate_test_base::twice, static_cast<delegate_test_base *>(&target));
+	REQUIRE(cb(5) == 11);
+}
+
+TEST_CASE("Delegate bound to a member of a second base class", "[util]")
+{
+	delegate_test_target target;
+	target.m_other = 7;
+	test_delegate cb(&delegate_test_target::plus, &target);
+	REQUIRE(cb(5) == 12);
+}
+
+TEST_CASE("Delegate bound to static functions", "[util]")
+{
+	delegate_test_target target;
+	target.m_other = 10;
+	test_delegate cb1(&delegate_test_static, &target);
+	test_delegate cb2(&delegate_test_static_ref, &target);
+	REQUIRE(!cb1.is_mfp());
+	REQUIRE(cb1(5) == 15);
+	REQUIRE(cb2(5) == 5);
+}
+
+TEST_CASE("Delegate wrapping a std::function", "[util]")
+{
+	int calls = 0;
+	test_delegate cb(std::function<int (int)>([&calls] (int value) { ++calls; return value - 1; }));
+	REQUIRE(!cb.isnull());
+	REQUIRE(cb.has_object());
+	REQUIRE(cb(5) == 4);
+
+	// copies must call their own function object, not the original's
+	test_delegate copy(cb);
+	test_delegate assigned;
+	assigned = cb;
+	REQUIRE(copy(10) == 9);
+	REQUIRE(assigned(20) == 19);
+	REQUIRE(calls == 3);
+	REQUIRE(copy == cb);
+}
+
+TEST_CASE("Delegate copies keep the bound object and adjustment", "[util]")
+{
+	delegate_test_target target;
+	target.m_other = 3;
+	test_delegate cb(&delegate_test_target::plus, &target);
+	test_delegate copy(cb);
+	test_delegate assigned;
+	REQUIRE(assigned.isnull());
+	assigned = copy;
+	REQUIRE(copy(1) == 4);
+	REQUIRE(assigned(2) == 5);
+	REQUIRE(assigned == cb);
+}
+
+TEST_CASE("Delegate late binding", "[util]")
+{
+	delegate_test_target target1, target2;
+	target1.m_other = 1;
+	target2.m_other = 2;
+	test_delegate unbound(&delegate_test_target::plus, static_cast<delegate_test_target *>(nullptr));
+	REQUIRE(!unbound.has_object());
+
+	test_delegate cb1(unbound, target1);
+	test_delegate cb2(unbound, target2);
+	REQUIRE(cb1(10) == 11);
+	REQUIRE(cb2(10) == 12);
+
+	unbound.late_bind(target2);
+	REQUIRE(unbound(20) == 22);
+}